@@ -14,12 +14,15 @@
 # limitations under the License.
 
 import argparse
+import contextlib
 import json
+import math
 import os
 import pathlib
 import re
 import subprocess
 import sys
+import statistics
 import tempfile
 
 from collections import defaultdict
@@ -86,9 +89,58 @@ def get_retry_name(args, file_name):
     return str(parent_path.parent)
 
 
-def compare_file(args, target_data, baseline_data):
+def get_counters(row):
+    """
+    Returns the user counters of a folly benchmark result row as {name: value}.
+    Rows of benchmarks without counters have no fourth element.
+    """
+    if len(row) < 4 or not row[3]:
+        return {}
+    return {
+        name: counter["value"] if isinstance(counter, dict) else counter
+        for name, counter in row[3].items()
+    }
+
+
+def mann_whitney_p_value(baseline, target):
+    """
+    Returns the two sided p-value of the Mann-Whitney U test of the two lists
+    of samples, using the normal approximation with tie correction, or None if
+    there are too few samples to tell.
+    """
+    n1 = len(baseline)
+    n2 = len(target)
+    if n1 < 3 or n2 < 3:
+        return None
+
+    # Rank the pooled samples, giving ties the average of their ranks.
+    pooled = sorted([(v, 0) for v in baseline] + [(v, 1) for v in target])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        tie_term += (j - i + 1) ** 3 - (j - i + 1)
+        i = j + 1
+
+    rank_sum = sum(r for r, (_, side) in zip(ranks, pooled) if side == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (u - n1 * n2 / 2) / math.sqrt(variance)
+    return math.erfc(abs(z) / math.sqrt(2))
+
+
+def compare_file(args, target_data, baseline_data, summary):
     def preprocess_data(input_map):
-        output_map = defaultdict(dict)
+        output_map = defaultdict(lambda: defaultdict(list))
+        counters_map = defaultdict(lambda: defaultdict(lambda: defaultdict(list)))
         for file_name, data in input_map.items():
             retry = get_retry_name(args, file_name)
             for row in data:
@@ -96,11 +148,15 @@ def compare_file(args, target_data, baseline_data):
                 # the json file.
                 if row[1] == "-":
                     continue
-                output_map[(row[0], row[1])][retry] = row[2]
-        return output_map
+                # Files written by 'run --repetitions' hold one row per
+                # repetition of each benchmark.
+                output_map[(row[0], row[1])][retry].append(row[2])
+                for name, value in get_counters(row).items():
+                    counters_map[(row[0], row[1])][retry][name].append(value)
+        return output_map, counters_map
 
-    baseline_map = preprocess_data(baseline_data)
-    target_map = preprocess_data(target_data)
+    baseline_map, baseline_counters = preprocess_data(baseline_data)
+    target_map, target_counters = preprocess_data(target_data)
 
     passes = []
     faster = []
@@ -115,10 +171,13 @@ def compare_file(args, target_data, baseline_data):
 
         # Iterate over each retry. The first iteration is always the full
         # execution, then optionally a few retries.
-        for retry, target_result in sorted(target_values.items()):
+        for retry, target_samples in sorted(target_values.items()):
             is_last = retry == sorted(target_values.keys())[-1]
             is_first = retry == "."
-            baseline_result = baseline_map[handle][retry]
+            baseline_samples = baseline_map[handle][retry]
+            baseline_result = statistics.median(baseline_samples)
+            target_result = statistics.median(target_samples)
+            p_value = mann_whitney_p_value(baseline_samples, target_samples)
 
             # Calculate delta between baseline and target results.
             if baseline_result == 0 or target_result == 0:
@@ -135,6 +194,16 @@ def compare_file(args, target_data, baseline_data):
                 else:
                     status = color_yellow("✗ Redo")
 
+            # A difference over the threshold that the samples do not show to
+            # be significant is noise.
+            elif (
+                abs(delta) > args.threshold
+                and p_value is not None
+                and p_value >= args.significance
+            ):
+                status = color_yellow("~ Noise")
+                passes.append((handle[0], handle[1], delta))
+
             # If there are no more retries and this exceeded the threshold.
             elif abs(delta) > args.threshold:
                 if delta > 0:
@@ -151,6 +220,36 @@ def compare_file(args, target_data, baseline_data):
             suffix = "({} vs {}) {:+.2f}%".format(
                 fmt_runtime(baseline_result), fmt_runtime(target_result), delta * 100
             )
+            if p_value is not None:
+                suffix += " p={:.3f}".format(p_value)
+            if is_last:
+                summary.append(
+                    {
+                        "file": handle[0],
+                        "benchmark": handle[1],
+                        "retry": retry,
+                        "baseline_ns": baseline_result,
+                        "contender_ns": target_result,
+                        "baseline_samples": baseline_samples,
+                        "contender_samples": target_samples,
+                        "delta": delta,
+                        "p_value": p_value,
+                        "regression": abs(delta) > args.threshold
+                        and delta < 0
+                        and (p_value is None or p_value < args.significance),
+                        "counters": {
+                            name: {
+                                "baseline": statistics.median(
+                                    baseline_counters[handle][retry].get(name, [0])
+                                ),
+                                "contender": statistics.median(values),
+                            }
+                            for name, values in target_counters[handle][
+                                retry
+                            ].items()
+                        },
+                    }
+                )
             bm_handle = get_benchmark_handle(*handle)
 
             # Add retry information.
@@ -202,6 +301,7 @@ def compare(args):
     all_passes = []
     all_faster = []
     all_failures = []
+    summary = []
 
     # Keep track of benchmarks that exceeded the threshold to they can be saved
     # to the rerun_output file.
@@ -220,7 +320,9 @@ def compare(args):
         target_data = read_json_files(contender_path)
         baseline_data = read_json_files(baseline_map[file_name])
 
-        passes, faster, failures = compare_file(args, target_data, baseline_data)
+        passes, faster, failures = compare_file(
+            args, target_data, baseline_data, summary
+        )
         all_passes += passes
         all_faster += faster
         all_failures += failures
@@ -240,6 +342,11 @@ def compare(args):
             if rerun_log:
                 out_file.write(json.dumps(rerun_log, indent=4))
 
+    # Write the machine readable results of the last retry of each benchmark.
+    if args.summary_json_output:
+        with open(args.summary_json_output, "w") as out_file:
+            out_file.write(json.dumps(summary, indent=4))
+
     # Print a nice summary of the results:
     print("Summary ({}% threshold):".format(args.threshold * 100))
     if all_passes:
@@ -285,6 +392,45 @@ def _normalize_path(binary_path: str) -> pathlib.Path:
     return path
 
 
+def parse_cpu_list(cpu_list):
+    """Parses a list of CPUs like '2,4-7' into a set of CPU numbers."""
+    cpus = set()
+    for part in cpu_list.split(","):
+        if "-" in part:
+            first, last = part.split("-")
+            cpus.update(range(int(first), int(last) + 1))
+        else:
+            cpus.add(int(part))
+    return cpus
+
+
+@contextlib.contextmanager
+def performance_governor(cpus):
+    """
+    Sets the frequency scaling governor of 'cpus' to 'performance' for the
+    duration of the context so that the clock does not change with the load.
+    Needs write access to sysfs, usually root. Only warns if not possible.
+    """
+    previous = {}
+    for cpu in sorted(cpus):
+        path = pathlib.Path(
+            f"/sys/devices/system/cpu/cpu{cpu}/cpufreq/scaling_governor"
+        )
+        try:
+            previous[path] = path.read_text().strip()
+            path.write_text("performance")
+        except OSError as e:
+            print(color_yellow(f"WARNING: Cannot set the governor of CPU {cpu}: {e}"))
+    try:
+        yield
+    finally:
+        for path, governor in previous.items():
+            try:
+                path.write_text(governor)
+            except OSError:
+                pass
+
+
 def run_all_benchmarks(
     output_dir,
     binary_path=None,
@@ -293,46 +439,92 @@ def run_all_benchmarks(
     bm_max_secs=None,
     bm_max_trials=None,
     bm_estimate_time=False,
+    repetitions=1,
+    cpu_list=None,
+    pin_frequency=False,
 ):
     if binary_path:
-        binary_path = _normalize_path(binary_path)
+        binary_paths = [_normalize_path(path) for path in binary_path]
     else:
-        binary_path = _default_binary_path()
+        binary_paths = [_default_binary_path()]
 
-    binaries = _find_binaries(binary_path)
+    binaries = [binary for path in binary_paths for binary in _find_binaries(path)]
     output_dir_path = pathlib.Path(output_dir)
     output_dir_path.mkdir(parents=True, exist_ok=True)
 
-    for binary_path in binaries:
-        if binary_filter and not re.search(binary_filter, binary_path.name):
-            continue
-
-        out_path = output_dir_path / f"{binary_path.name}.json"
-        print(f"Executing and dumping results for '{binary_path}' to '{out_path}':")
-        run_command = [
-            binary_path,
-            "--bm_json_verbose",
-            out_path,
-        ]
-
-        if bm_max_secs:
-            run_command.extend(["--bm_max_secs", str(bm_max_secs)])
-
-        if bm_max_trials:
-            run_command.extend(["--bm_max_trials", str(bm_max_trials)])
-
-        if bm_filter:
-            run_command.extend(["--bm_regex", bm_filter])
+    cpus = parse_cpu_list(cpu_list) if cpu_list else None
+    if pin_frequency:
+        governor = performance_governor(cpus or os.sched_getaffinity(0))
+    else:
+        governor = contextlib.nullcontext()
+
+    with governor:
+        for binary_path in binaries:
+            if binary_filter and not re.search(binary_filter, binary_path.name):
+                continue
+            run_benchmark(
+                binary_path,
+                output_dir_path / f"{binary_path.name}.json",
+                bm_filter,
+                bm_max_secs,
+                bm_max_trials,
+                bm_estimate_time,
+                repetitions,
+                cpus,
+            )
 
-        if bm_estimate_time:
-            run_command.append("--bm_estimate_time")
 
-        try:
-            print(run_command)
-            subprocess.run(run_command, check=True)
-        except subprocess.CalledProcessError as e:
-            print(e.stderr.decode("utf-8"))
-            raise e
+def run_benchmark(
+    binary_path,
+    out_path,
+    bm_filter,
+    bm_max_secs,
+    bm_max_trials,
+    bm_estimate_time,
+    repetitions,
+    cpus,
+):
+    """
+    Runs 'binary_path' 'repetitions' times and writes the result rows of all
+    runs to 'out_path', so that the comparison sees the spread of each
+    benchmark. The rows are in the folly --bm_json_verbose format:
+    [file, name, time in ns, {counter: {"value": ..., "type": ...}}].
+    """
+    print(f"Executing and dumping results for '{binary_path}' to '{out_path}':")
+    rows = []
+    for repetition in range(repetitions):
+        with tempfile.NamedTemporaryFile(suffix=".json") as repetition_out:
+            run_command = [
+                binary_path,
+                "--bm_json_verbose",
+                repetition_out.name,
+            ]
+
+            if bm_max_secs:
+                run_command.extend(["--bm_max_secs", str(bm_max_secs)])
+
+            if bm_max_trials:
+                run_command.extend(["--bm_max_trials", str(bm_max_trials)])
+
+            if bm_filter:
+                run_command.extend(["--bm_regex", bm_filter])
+
+            if bm_estimate_time:
+                run_command.append("--bm_estimate_time")
+
+            # Pin the benchmark process, not this script, to 'cpus'.
+            pin = (lambda: os.sched_setaffinity(0, cpus)) if cpus else None
+            try:
+                print(run_command)
+                subprocess.run(run_command, check=True, preexec_fn=pin)
+            except subprocess.CalledProcessError as e:
+                if e.stderr:
+                    print(e.stderr.decode("utf-8"))
+                raise e
+            rows += json.load(repetition_out)
+
+    with open(out_path, "w") as out_file:
+        json.dump(rows, out_file)
 
 
 def upload_results(args):
@@ -408,6 +600,9 @@ def run(args):
         "bm_max_secs": args.bm_max_secs,
         "bm_max_trials": args.bm_max_trials,
         "bm_estimate_time": args.bm_estimate_time,
+        "repetitions": args.repetitions,
+        "cpu_list": args.cpu_list,
+        "pin_frequency": args.pin_frequency,
     }
 
     # In case we only want to rerun failed benchmarks from rerun_json_input.
@@ -443,8 +638,11 @@ def parse_args():
     parser_run.add_argument(
         "--binary_path",
         default=None,
-        help="Directory where benchmark binaries are stored. "
-        "Defaults to release build directory.",
+        action="append",
+        help="Directory where benchmark binaries are stored. Can be given "
+        "more than once to run benchmarks of several directories, e.g. "
+        "velox/exec/benchmarks and velox/vector/benchmarks of the build "
+        "directory. Defaults to release build directory.",
     )
     parser_run.add_argument(
         "--output_path",
@@ -482,6 +680,28 @@ def parse_args():
         action="store_true",
         help="Use folly benchmark --bm_estimate_time flag.",
     )
+    parser_run.add_argument(
+        "--repetitions",
+        default=1,
+        type=int,
+        help="Number of times to run each binary. The results of all runs "
+        "are kept so that 'compare' can tell regressions from noise. "
+        "Use at least 3 for a statistical comparison.",
+    )
+    parser_run.add_argument(
+        "--cpu_list",
+        default=None,
+        help="CPUs to run the benchmarks on, e.g. '2,4-7'. By default the "
+        "benchmarks may run on any CPU.",
+    )
+    parser_run.add_argument(
+        "--pin_frequency",
+        default=False,
+        action="store_true",
+        help="Set the frequency scaling governor of the benchmark CPUs to "
+        "'performance' while running, and restore it afterwards. Requires "
+        "write access to /sys/devices/system/cpu.",
+    )
     parser_run.add_argument(
         "--rerun_json_input",
         default=None,
@@ -528,6 +748,21 @@ def parse_args():
         help="Looks for json files recursively, understanding subdirs as "
         "retries and printing the output accordingly.",
     )
+    parser_compare.add_argument(
+        "--significance",
+        type=float,
+        default=0.05,
+        help="When both sides have at least 3 samples of a benchmark, a "
+        "variation over the threshold is only a failure if the Mann-Whitney "
+        "U test p-value is below this. Default 0.05.",
+    )
+    parser_compare.add_argument(
+        "--summary_json_output",
+        default=None,
+        help="File where the comparison of each benchmark is saved as json: "
+        "median times, samples, delta, p-value, counters and whether it "
+        "is a regression.",
+    )
     parser_compare.add_argument(
         "--do_not_fail",
         default=False,
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <gflags/gflags.h>
+#include <map>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+DECLARE_string(data_path);
+DECLARE_int32(run_query_verbose);
+DECLARE_bool(include_custom_stats);
+DECLARE_bool(include_results);
+DECLARE_int32(num_drivers);
+DECLARE_string(data_format);
+DECLARE_int32(num_splits_per_file);
+DECLARE_int32(cache_gb);
+DECLARE_int32(num_repeats);
+DECLARE_string(test_flags_file);
+
+namespace facebook::velox {
+
+struct RunStats {
+  std::map<std::string, std::string> flags;
+  int64_t micros{0};
+  int64_t rawInputBytes{0};
+  int64_t userNanos{0};
+  int64_t systemNanos{0};
+  std::string output;
+
+  std::string toString(bool detail);
+};
+
+struct ParameterDim {
+  std::string flag;
+  std::vector<std::string> values;
+};
+
+/// Runs query plans over Hive splits of local or remote data files with the
+/// memory, cache and connector settings given by the flags declared above.
+/// Shared by the TPC-H and TPC-DS benchmarks, which supply the plans and
+/// decide in runMain() which query to run.
+class QueryBenchmarkBase {
+ public:
+  virtual ~QueryBenchmarkBase() = default;
+
+  /// Sets up the memory manager, the caches and the Hive connector and
+  /// registers the functions.
+  void initialize();
+
+  void shutdown();
+
+  /// Runs 'plan' FLAGS_num_repeats times and returns the cursor and results
+  /// of the last run, or a nullptr cursor if the query fails.
+  std::pair<std::unique_ptr<exec::test::TaskCursor>, std::vector<RowVectorPtr>>
+  run(const exec::test::TpchPlan& plan);
+
+  /// Runs the folly benchmarks or the query selected by the flags and writes
+  /// the results to 'out'.
+  virtual void runMain(std::ostream& out, RunStats& runStats) = 0;
+
+  /// Runs runMain() for each combination of the flag values in
+  /// FLAGS_test_flags_file and prints the runs sorted by time.
+  void runAllCombinations();
+
+ protected:
+  /// Runs 'plan' once and writes the execution time and the per operator
+  /// statistics of each plan node to 'out'. Exits the process if the query
+  /// fails.
+  void runVerbose(
+      const exec::test::TpchPlan& plan,
+      std::ostream& out,
+      RunStats& runStats);
+
+  void readCombinations();
+
+  void runCombinations(int32_t level);
+
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
+  std::shared_ptr<memory::MemoryAllocator> allocator_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  // Parameter combinations to try. Each element specifies a flag and possible
+  // values. All permutations are tried.
+  std::vector<ParameterDim> parameters_;
+
+  std::vector<RunStats> runStats_;
+};
+
+} // namespace facebook::velox
@@ -33,7 +33,10 @@ namespace {
 class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   explicit DecodedVectorBenchmark(size_t vectorSize)
-      : FunctionBenchmarkBase(), vectorSize_(vectorSize), rows_(vectorSize) {
+      : FunctionBenchmarkBase(),
+        vectorSize_(vectorSize),
+        rows_(vectorSize),
+        gathered_(vectorSize) {
     VectorFuzzer::Options opts;
     opts.vectorSize = vectorSize_;
     opts.nullRatio = 0;
@@ -98,6 +101,17 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     return vectorSize_;
   }
 
+  // Gathers the values of a decoded dictionary vector into a flat buffer and
+  // runs over that.
+  size_t gatheredRunDict() {
+    return gatheredRun(*dictionaryVector_);
+  }
+
+  // Same as above with 5 layers of indirection.
+  size_t gatheredRunDict5Nested() {
+    return gatheredRun(*dictionaryNestedVector_);
+  }
+
   // Measure time to decode a flat vector.
   void decodeFlat() {
     DecodedVector decodedVector(*flatVector_, rows_);
@@ -127,6 +141,19 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     folly::doNotOptimizeAway(sum);
   }
 
+  size_t gatheredRun(const BaseVector& vector) {
+    folly::BenchmarkSuspender suspender;
+    DecodedVector decodedVector(vector, rows_);
+    suspender.dismiss();
+    decodedVector.gatherValues(rows_, gathered_.data());
+    size_t sum = 0;
+    for (auto i = 0; i < vectorSize_; i++) {
+      sum += gathered_[i];
+    }
+    folly::doNotOptimizeAway(sum);
+    return vectorSize_;
+  }
+
   const size_t vectorSize_;
 
   VectorPtr flatVector_;
@@ -135,6 +162,7 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr dictionaryNestedVector_;
 
   SelectivityVector rows_;
+  std::vector<int64_t> gathered_;
 };
 
 std::unique_ptr<DecodedVectorBenchmark> benchmark;
@@ -166,6 +194,14 @@ BENCHMARK(scanDecodedDict5Nested) {
   run([&] { benchmark->decodedRunDict5Nested(); });
 }
 
+BENCHMARK(scanGatheredDict) {
+  run([&] { benchmark->gatheredRunDict(); });
+}
+
+BENCHMARK(scanGatheredDict5Nested) {
+  run([&] { benchmark->gatheredRunDict5Nested(); });
+}
+
 BENCHMARK_DRAW_LINE();
 
 // For those we alwast report total runtime.
@@ -82,7 +82,9 @@ int main(int argc, char** argv) {
       .addBenchmarkSet(
           "substring", vectorMaker.rowVector({"col0"}, {substringInput}))
       .addExpression("substring", R"(like(col0, '%a\_b\_c%', '\'))")
-      .addExpression("strpos", R"(strpos(col0, 'a_b_c') > 0)");
+      .addExpression("strpos", R"(strpos(col0, 'a_b_c') > 0)")
+      .addExpression("substrings", R"(like(col0, '%a\_%b\_%c%', '\'))")
+      .addExpression("substrings_regex", R"(regexp_like(col0, 'a_.*b_.*c'))");
 
   benchmarkBuilder
       .addBenchmarkSet(
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::dwio::common;
+
+std::shared_ptr<TpcdsQueryBuilder> queryBuilder;
+
+class TpcdsBenchmark : public QueryBenchmarkBase {
+ public:
+  void runMain(std::ostream& out, RunStats& runStats) override {
+    if (FLAGS_run_query_verbose == -1) {
+      folly::runBenchmarks();
+    } else {
+      runVerbose(
+          queryBuilder->getQueryPlan(FLAGS_run_query_verbose), out, runStats);
+    }
+  }
+};
+
+TpcdsBenchmark benchmark;
+
+BENCHMARK(q3) {
+  const auto planContext = queryBuilder->getQueryPlan(3);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q7) {
+  const auto planContext = queryBuilder->getQueryPlan(7);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q12) {
+  const auto planContext = queryBuilder->getQueryPlan(12);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q22) {
+  const auto planContext = queryBuilder->getQueryPlan(22);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q27) {
+  const auto planContext = queryBuilder->getQueryPlan(27);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q36) {
+  const auto planContext = queryBuilder->getQueryPlan(36);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q89) {
+  const auto planContext = queryBuilder->getQueryPlan(89);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q98) {
+  const auto planContext = queryBuilder->getQueryPlan(98);
+  benchmark.run(planContext);
+}
+
+int tpcdsBenchmarkMain() {
+  benchmark.initialize();
+  queryBuilder =
+      std::make_shared<TpcdsQueryBuilder>(toFileFormat(FLAGS_data_format));
+  queryBuilder->initialize(FLAGS_data_path);
+  if (FLAGS_test_flags_file.empty()) {
+    RunStats ignore;
+    benchmark.runMain(std::cout, ignore);
+  } else {
+    benchmark.runAllCombinations();
+  }
+  benchmark.shutdown();
+  queryBuilder.reset();
+  return 0;
+}
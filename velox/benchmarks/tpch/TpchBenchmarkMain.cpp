@@ -21,7 +21,7 @@
 
 int main(int argc, char** argv) {
   std::string kUsage(
-      "This program benchmarks TPC-H queries. Run 'velox_tpch_benchmark -helpon=TpchBenchmark' for available options.\n");
+      "This program benchmarks TPC-H queries. Run 'velox_tpch_benchmark -helpon=TpchBenchmark' and '-helpon=QueryBenchmarkBase' for available options.\n");
   gflags::SetUsageMessage(kUsage);
   folly::Init init{&argc, &argv, false};
   tpchBenchmarkMain();
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/memory/SharedArbitrator.h"
+
+DEFINE_int32(num_threads, 16, "The number of concurrent threads");
+DEFINE_int64(
+    num_ops_per_thread,
+    100'000,
+    "The number of memory operations to run per thread");
+DEFINE_int32(
+    pool_depth,
+    4,
+    "The number of aggregate pools between the root and the leaf pools in the "
+    "deep pool hierarchy runs");
+DEFINE_int64(
+    allocator_capacity,
+    32L << 30,
+    "The capacity of the memory allocator in bytes");
+DEFINE_int64(
+    max_thread_bytes,
+    256 << 20,
+    "The cap of the memory allocated by one thread in the allocation runs");
+DEFINE_int32(
+    free_every_n_operations,
+    3,
+    "Frees one of the existing allocations for every N memory operations");
+DEFINE_int64(
+    arbitrator_capacity,
+    4L << 30,
+    "The capacity of the shared arbitrator in the arbitration runs");
+DEFINE_int64(
+    max_query_bytes,
+    1L << 30,
+    "The memory a query accumulates before it frees its memory and returns "
+    "its capacity to the arbitrator in the arbitration runs");
+DEFINE_int64(seed, 99887766, "Seed for the random memory size generator");
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace {
+
+// Returns the wall time of running 'func' in nanoseconds.
+template <typename Func>
+uint64_t timeNanos(Func&& func) {
+  const auto start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Collects operation latencies and reports percentiles over them.
+class LatencyStats {
+ public:
+  void add(uint64_t nanos) {
+    latencies_.push_back(nanos);
+  }
+
+  void merge(LatencyStats&& other) {
+    latencies_.insert(
+        latencies_.end(), other.latencies_.begin(), other.latencies_.end());
+    sorted_ = false;
+  }
+
+  uint64_t count() const {
+    return latencies_.size();
+  }
+
+  // Returns the latency at 'pct' percentile.
+  uint64_t percentile(double pct) {
+    if (latencies_.empty()) {
+      return 0;
+    }
+    if (!sorted_) {
+      std::sort(latencies_.begin(), latencies_.end());
+      sorted_ = true;
+    }
+    const auto index = std::min<size_t>(
+        latencies_.size() - 1, latencies_.size() * pct / 100);
+    return latencies_[index];
+  }
+
+ private:
+  std::vector<uint64_t> latencies_;
+  bool sorted_{false};
+};
+
+struct RunResult {
+  std::string name;
+  uint64_t numOps{0};
+  uint64_t numFailures{0};
+  uint64_t wallNanos{0};
+  // Latencies of the allocation calls.
+  LatencyStats allocateLatencies;
+  // Latencies of the allocation calls which grew the query capacity through
+  // the arbitrator.
+  LatencyStats growLatencies;
+  // Latencies of returning the query capacity to the arbitrator.
+  LatencyStats shrinkLatencies;
+};
+
+struct ThreadResult {
+  uint64_t numOps{0};
+  uint64_t numFailures{0};
+  LatencyStats allocateLatencies;
+  LatencyStats growLatencies;
+  LatencyStats shrinkLatencies;
+};
+
+// Drives allocations and frees of random sizes against one leaf pool.
+class PoolDriver {
+ public:
+  PoolDriver(MemoryPool* pool, uint32_t seed) : pool_(pool) {
+    rng_.seed(seed);
+  }
+
+  ~PoolDriver() {
+    freeAll();
+  }
+
+  // Allocates a random sized buffer and returns the latency of the
+  // allocation.
+  uint64_t allocate(size_t minSize, size_t maxSize) {
+    const size_t size =
+        minSize + folly::Random::rand64(maxSize - minSize + 1, rng_);
+    void* ptr;
+    const auto nanos = timeNanos([&]() { ptr = pool_->allocate(size); });
+    allocations_.emplace_back(ptr, size);
+    allocatedBytes_ += size;
+    return nanos;
+  }
+
+  void freeOne() {
+    if (allocations_.empty()) {
+      return;
+    }
+    // Free in random order to fragment the allocator.
+    const auto index = folly::Random::rand32(allocations_.size(), rng_);
+    std::swap(allocations_[index], allocations_.back());
+    const auto [ptr, size] = allocations_.back();
+    allocations_.pop_back();
+    pool_->free(ptr, size);
+    allocatedBytes_ -= size;
+  }
+
+  void freeAll() {
+    while (!allocations_.empty()) {
+      freeOne();
+    }
+  }
+
+  uint64_t allocatedBytes() const {
+    return allocatedBytes_;
+  }
+
+  bool shouldFree(int64_t iter) const {
+    return iter % FLAGS_free_every_n_operations == 0;
+  }
+
+ private:
+  MemoryPool* const pool_;
+  folly::Random::DefaultGenerator rng_;
+  std::deque<std::pair<void*, size_t>> allocations_;
+  uint64_t allocatedBytes_{0};
+};
+
+std::unique_ptr<MemoryManager> createMemoryManager(bool useMmap) {
+  MemoryManagerOptions options;
+  options.allocatorCapacity = FLAGS_allocator_capacity;
+  options.useMmapAllocator = useMmap;
+  return std::make_unique<MemoryManager>(options);
+}
+
+// Runs 'threadFunc' on FLAGS_num_threads threads and collects the results.
+template <typename ThreadFunc>
+RunResult runThreads(const std::string& name, ThreadFunc threadFunc) {
+  std::vector<ThreadResult> threadResults(FLAGS_num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_num_threads);
+  RunResult result;
+  result.name = name;
+  result.wallNanos = timeNanos([&]() {
+    for (int32_t i = 0; i < FLAGS_num_threads; ++i) {
+      threads.emplace_back(
+          [&, i]() { threadFunc(i, FLAGS_seed + i, threadResults[i]); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+  for (auto& threadResult : threadResults) {
+    result.numOps += threadResult.numOps;
+    result.numFailures += threadResult.numFailures;
+    result.allocateLatencies.merge(std::move(threadResult.allocateLatencies));
+    result.growLatencies.merge(std::move(threadResult.growLatencies));
+    result.shrinkLatencies.merge(std::move(threadResult.shrinkLatencies));
+  }
+  return result;
+}
+
+// Runs a multi-threaded allocate/free mix without arbitration. All the
+// threads allocate from the leaves of one query pool tree, with 'depth'
+// aggregate pools between the root and each leaf.
+RunResult runAllocations(
+    bool useMmap,
+    int32_t depth,
+    size_t minSize,
+    size_t maxSize) {
+  auto manager = createMemoryManager(useMmap);
+  auto root = manager->addRootPool("root");
+  const auto name = fmt::format(
+      "{}Allocate{}To{}Depth{}",
+      useMmap ? "Mmap" : "Malloc",
+      succinctBytes(minSize),
+      succinctBytes(maxSize),
+      depth);
+  return runThreads(
+      name, [&](int32_t threadId, uint32_t seed, ThreadResult& result) {
+        std::shared_ptr<MemoryPool> parent = root;
+        std::vector<std::shared_ptr<MemoryPool>> aggregates;
+        for (int32_t i = 0; i < depth; ++i) {
+          parent = parent->addAggregateChild(
+              fmt::format("aggregate{}.{}", threadId, i));
+          aggregates.push_back(parent);
+        }
+        auto leaf = parent->addLeafChild(fmt::format("leaf{}", threadId));
+        PoolDriver driver(leaf.get(), seed);
+        for (int64_t iter = 0; iter < FLAGS_num_ops_per_thread; ++iter) {
+          if (driver.shouldFree(iter)) {
+            driver.freeOne();
+          }
+          while (driver.allocatedBytes() >= FLAGS_max_thread_bytes) {
+            driver.freeOne();
+          }
+          result.allocateLatencies.add(driver.allocate(minSize, maxSize));
+          ++result.numOps;
+        }
+        driver.freeAll();
+      });
+}
+
+// Runs concurrent queries against the shared arbitrator. Each thread is a
+// query which grows its capacity through allocations until it holds
+// FLAGS_max_query_bytes, then frees its memory and returns the capacity to
+// the arbitrator. Queries which can't get capacity fail, free their memory
+// and start over.
+RunResult runArbitration(bool useMmap, size_t minSize, size_t maxSize) {
+  MemoryManagerOptions options;
+  options.allocatorCapacity = FLAGS_allocator_capacity;
+  options.useMmapAllocator = useMmap;
+  options.arbitratorKind = "SHARED";
+  options.arbitratorCapacity = FLAGS_arbitrator_capacity;
+  options.memoryPoolInitCapacity = 0;
+  options.memoryPoolTransferCapacity = 32 << 20;
+  options.memoryReclaimWaitMs = 1'000;
+  MemoryManager manager(options);
+  auto* arbitrator = manager.arbitrator();
+  const auto name = fmt::format(
+      "{}Arbitration{}To{}",
+      useMmap ? "Mmap" : "Malloc",
+      succinctBytes(minSize),
+      succinctBytes(maxSize));
+  return runThreads(
+      name, [&](int32_t threadId, uint32_t seed, ThreadResult& result) {
+        auto root = manager.addRootPool(
+            fmt::format("query{}", threadId),
+            kMaxMemory,
+            MemoryReclaimer::create());
+        auto leaf = root->addLeafChild("leaf");
+        PoolDriver driver(leaf.get(), seed);
+        auto returnCapacity = [&]() {
+          driver.freeAll();
+          result.shrinkLatencies.add(timeNanos(
+              [&]() { arbitrator->shrinkCapacity(root.get(), 0); }));
+        };
+        for (int64_t iter = 0; iter < FLAGS_num_ops_per_thread; ++iter) {
+          ++result.numOps;
+          if (driver.allocatedBytes() >= FLAGS_max_query_bytes) {
+            returnCapacity();
+          }
+          const auto capacity = root->capacity();
+          try {
+            const auto nanos = driver.allocate(minSize, maxSize);
+            result.allocateLatencies.add(nanos);
+            if (root->capacity() > capacity) {
+              result.growLatencies.add(nanos);
+            }
+          } catch (const VeloxRuntimeError&) {
+            ++result.numFailures;
+            returnCapacity();
+          }
+        }
+        returnCapacity();
+      });
+}
+
+void printResult(RunResult& result) {
+  auto printLatencies = [](const char* label, LatencyStats& stats) {
+    if (stats.count() == 0) {
+      return;
+    }
+    LOG(INFO) << fmt::format(
+        "  {:<10} count {:>10} p50 {:>10} p99 {:>10} max {:>10}",
+        label,
+        stats.count(),
+        succinctNanos(stats.percentile(50)),
+        succinctNanos(stats.percentile(99)),
+        succinctNanos(stats.percentile(100)));
+  };
+  const auto opsPerSec = result.wallNanos == 0
+      ? 0
+      : result.numOps * 1'000'000'000 / result.wallNanos;
+  LOG(INFO) << fmt::format(
+      "{}: {} ops in {}, {} ops/s, {} failures",
+      result.name,
+      result.numOps,
+      succinctNanos(result.wallNanos),
+      opsPerSec,
+      result.numFailures);
+  printLatencies("allocate", result.allocateLatencies);
+  printLatencies("grow", result.growLatencies);
+  printLatencies("shrink", result.shrinkLatencies);
+}
+
+} // namespace
+
+// Reports the throughput and the latency percentiles of concurrent memory
+// allocations across allocators and pool hierarchies, and of the capacity
+// growth through the shared arbitrator under concurrent queries.
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  SharedArbitrator::registerFactory();
+
+  const std::vector<std::pair<size_t, size_t>> sizeRanges = {
+      {128, 3072}, {4 << 10, 1 << 20}, {1 << 20, 8 << 20}};
+  for (const bool useMmap : {false, true}) {
+    for (const auto& [minSize, maxSize] : sizeRanges) {
+      for (const auto depth : {0, FLAGS_pool_depth}) {
+        auto result = runAllocations(useMmap, depth, minSize, maxSize);
+        printResult(result);
+      }
+    }
+  }
+  for (const bool useMmap : {false, true}) {
+    for (const auto& [minSize, maxSize] : sizeRanges) {
+      auto result = runArbitration(useMmap, minSize, maxSize);
+      printResult(result);
+    }
+  }
+  SharedArbitrator::unregisterFactory();
+  return 0;
+}
@@ -54,8 +54,10 @@ class MemoryPoolAllocationBenchMark {
       : type_(type), minSize_(minSize), maxSize_(maxSize) {
     switch (type_) {
       case Type::kMmap:
-        manager_ = std::make_shared<MemoryManager>(
-            MemoryManagerOptions{.alignment = alignment});
+        manager_ = std::make_shared<MemoryManager>(MemoryManagerOptions{
+            .alignment = alignment,
+            .allocatorCapacity = 2 * FLAGS_memory_allocation_bytes,
+            .useMmapAllocator = true});
         break;
       case Type::kStd:
         manager_ = std::make_shared<MemoryManager>(
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -29,7 +30,8 @@ namespace facebook::velox {
 // remaining bits select the word in the filter. With 8 bits per
 // expected entry, we get ~2% false positives. 'hashInput' determines
 // if the value added or checked needs to be hashed. If this is false,
-// we assume that the input is already a 64 bit hash number.
+// we assume that the input is already a 64 bit hash number. Since all bits
+// of a value are in one word, a probe costs at most one cache miss.
 template <typename Allocator = std::allocator<uint64_t>>
 class BloomFilter {
  public:
@@ -61,6 +63,47 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  /// Sets bit i of 'result' to mayContain(hashes[i]) for i < 'numHashes'.
+  /// Leaves the bits of 'result' from 'numHashes' on unchanged. Prefetches
+  /// the words of a block of hashes before testing any of them, so that the
+  /// cache misses of a block overlap, and tests a SIMD batch at a time.
+  /// 'this' must be set.
+  void mayContain(const uint64_t* hashes, int32_t numHashes, uint64_t* result)
+      const {
+    VELOX_DCHECK(isSet());
+    using Batch = xsimd::batch<int64_t>;
+    static_assert(kProbeBlockSize % Batch::size == 0);
+    const auto* bloom = reinterpret_cast<const int64_t*>(bits_.data());
+    const int32_t bloomSize = bits_.size();
+    int32_t indices[kProbeBlockSize];
+    for (int32_t begin = 0; begin < numHashes; begin += kProbeBlockSize) {
+      const auto size = std::min(kProbeBlockSize, numHashes - begin);
+      const auto* blockHashes = hashes + begin;
+      for (auto i = 0; i < size; ++i) {
+        indices[i] = bloomIndex(bloomSize, blockHashes[i]);
+        __builtin_prefetch(bloom + indices[i]);
+      }
+      uint64_t hits = 0;
+      int32_t i = 0;
+      for (; i + Batch::size <= size; i += Batch::size) {
+        const auto hashCodes = Batch::load_unaligned(
+            reinterpret_cast<const int64_t*>(blockHashes + i));
+        const auto masks = bloomMasks(hashCodes);
+        const auto words = simd::gather(bloom, indices + i);
+        hits |= static_cast<uint64_t>(simd::toBitMask((words & masks) == masks))
+            << i;
+      }
+      for (; i < size; ++i) {
+        const auto mask = bloomMask(blockHashes[i]);
+        if ((bloom[indices[i]] & mask) == mask) {
+          hits |= 1UL << i;
+        }
+      }
+      auto& word = result[begin / 64];
+      word = size == 64 ? hits : (word & ~bits::lowMask(size)) | hits;
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -97,6 +140,10 @@ class BloomFilter {
   }
 
  private:
+  // Number of hashes whose words are prefetched together in the batch
+  // mayContain(). This is one word of results.
+  static constexpr int32_t kProbeBlockSize = 64;
+
   // We use 4 independent hash functions by taking 24 bits of
   // the hash code and breaking these up into 4 groups of 6 bits. Each group
   // represents a number between 0 and 63 (2^6-1) and maps to one bit in a
@@ -107,6 +154,16 @@ class BloomFilter {
         (1L << ((hashCode >> 12) & 63)) | (1L << ((hashCode >> 18) & 63));
   }
 
+  // SIMD version of bloomMask() for a batch of hash codes.
+  template <typename Batch>
+  inline static Batch bloomMasks(Batch hashCodes) {
+    const Batch one(1);
+    const Batch low6(63);
+    return (one << (hashCodes & low6)) | (one << ((hashCodes >> 6) & low6)) |
+        (one << ((hashCodes >> 12) & low6)) |
+        (one << ((hashCodes >> 18) & low6));
+  }
+
   // Skip 24 bits used for bloomMask and use the next N bits of the hash code
   // as index. N = log2(bloomSize). bloomSize must be a power of 2.
   inline static uint32_t bloomIndex(uint32_t bloomSize, uint64_t hashCode) {
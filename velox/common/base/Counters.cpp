@@ -35,6 +35,12 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricDriverExecTimeMs, 1'000, 0, 30'000, 50, 90, 99, 100);
 
+  // Tracks the latency of exchange data requests in range of [0, 10s] with 100
+  // buckets and reports P50, P90, P99, and P100. Includes the time a request
+  // waits on the producer for data.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricExchangeDataRequestLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+
   /// ================== Cache Counters =================
 
   // Tracks hive handle generation latency in range of [0, 100s] and reports
@@ -49,6 +55,29 @@ void registerVeloxMetrics() {
       99,
       100);
 
+  // Number of S3 GetObject requests.
+  DEFINE_METRIC(kMetricS3GetObjectCount, facebook::velox::StatType::COUNT);
+
+  // Number of bytes read with S3 GetObject requests.
+  DEFINE_METRIC(kMetricS3GetObjectBytes, facebook::velox::StatType::SUM);
+
+  // Tracks S3 GetObject latency in range of [0, 10s] with 100 buckets and
+  // reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricS3GetObjectLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+
+  // Number of S3 GetObject requests in flight when one is issued. Compared
+  // with 'hive.s3.max-connections' this shows whether the reads line up
+  // behind the connection pool.
+  DEFINE_METRIC(kMetricS3ActiveGetObjects, facebook::velox::StatType::AVG);
+
+  // Number of object store reads that were issued a second time because
+  // they took longer than the learned latency percentile.
+  DEFINE_METRIC(kMetricHedgedReadCount, facebook::velox::StatType::COUNT);
+
+  // Number of hedged reads where the second request finished first.
+  DEFINE_METRIC(kMetricHedgedReadWinCount, facebook::velox::StatType::COUNT);
+
   DEFINE_METRIC(kMetricCacheShrinkCount, facebook::velox::StatType::COUNT);
 
   // Tracks cache shrink latency in range of [0, 100s] with 10 buckets and
@@ -56,6 +85,17 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricCacheShrinkTimeMs, 10'000, 0, 100'000, 50, 90, 99, 100);
 
+  // Tracks the time a reader waits for an AsyncDataCache entry loaded by
+  // another thread in range of [0, 100ms] with 100 buckets and reports P50,
+  // P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricMemoryCacheWaitLatencyUs, 1'000, 0, 100'000, 50, 90, 99, 100);
+
+  // Tracks the latency of synchronous file reads by the readers in range of
+  // [0, 100ms] with 100 buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricStorageReadLatencyUs, 1'000, 0, 100'000, 50, 90, 99, 100);
+
   /// ================== Memory Allocator Counters =================
 
   // Number of bytes currently mapped in MemoryAllocator. These bytes represent
@@ -168,6 +208,11 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryCacheNumAgedOutEntries, facebook::velox::StatType::SUM);
 
+  // Number of new AsyncDataCache entries that the admission policy did not
+  // admit, since last counter retrieval.
+  DEFINE_METRIC(
+      kMetricMemoryCacheNumNotAdmitted, facebook::velox::StatType::SUM);
+
   /// ================== SsdCache Counters ==================
 
   // Number of regions currently cached by SSD.
@@ -243,6 +288,11 @@ void registerVeloxMetrics() {
   // Total number of cache regions evicted.
   DEFINE_METRIC(kMetricSsdCacheRegionsEvicted, facebook::velox::StatType::SUM);
 
+  // Tracks the latency of loading a batch of entries from SSD cache in range
+  // of [0, 10ms] with 100 buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSsdCacheReadLatencyUs, 100, 0, 10'000, 50, 90, 99, 100);
+
   /// ================== Memory Arbitration Counters =================
 
   // The number of arbitration requests.
@@ -356,6 +406,15 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryPoolReservationLeakBytes, facebook::velox::StatType::SUM);
 
+  // The number of background memory reclaim runs that found the memory usage
+  // above the high watermark.
+  DEFINE_METRIC(
+      kMetricMemoryBackgroundReclaimCount, facebook::velox::StatType::COUNT);
+
+  // The memory freed by the background memory reclaim in bytes.
+  DEFINE_METRIC(
+      kMetricMemoryBackgroundReclaimedBytes, facebook::velox::StatType::SUM);
+
   // The distribution of a root memory pool's initial capacity in range of [0,
   // 256MB] with 32 buckets. It is configured to report the capacity at P50,
   // P90, P99, and P100 percentiles.
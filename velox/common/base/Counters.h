@@ -26,6 +26,36 @@ void registerVeloxMetrics();
 constexpr folly::StringPiece kMetricHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
 
+constexpr folly::StringPiece kMetricS3GetObjectCount{
+    "velox.s3_get_object_count"};
+
+constexpr folly::StringPiece kMetricS3GetObjectBytes{
+    "velox.s3_get_object_bytes"};
+
+constexpr folly::StringPiece kMetricS3GetObjectLatencyMs{
+    "velox.s3_get_object_latency_ms"};
+
+constexpr folly::StringPiece kMetricStorageReadLatencyUs{
+    "velox.storage_read_latency_us"};
+
+constexpr folly::StringPiece kMetricExchangeDataRequestLatencyMs{
+    "velox.exchange_data_request_latency_ms"};
+
+constexpr folly::StringPiece kMetricMemoryCacheWaitLatencyUs{
+    "velox.memory_cache_wait_latency_us"};
+
+constexpr folly::StringPiece kMetricSsdCacheReadLatencyUs{
+    "velox.ssd_cache_read_latency_us"};
+
+constexpr folly::StringPiece kMetricS3ActiveGetObjects{
+    "velox.s3_active_get_objects"};
+
+constexpr folly::StringPiece kMetricHedgedReadCount{
+    "velox.hedged_read_count"};
+
+constexpr folly::StringPiece kMetricHedgedReadWinCount{
+    "velox.hedged_read_win_count"};
+
 constexpr folly::StringPiece kMetricCacheShrinkCount{
     "velox.cache_shrink_count"};
 
@@ -70,6 +100,12 @@ constexpr folly::StringPiece kMetricMemoryPoolUsageLeakBytes{
 constexpr folly::StringPiece kMetricMemoryPoolReservationLeakBytes{
     "velox.memory_pool_reservation_leak_bytes"};
 
+constexpr folly::StringPiece kMetricMemoryBackgroundReclaimCount{
+    "velox.memory_background_reclaim_count"};
+
+constexpr folly::StringPiece kMetricMemoryBackgroundReclaimedBytes{
+    "velox.memory_background_reclaimed_bytes"};
+
 constexpr folly::StringPiece kMetricMemoryAllocatorDoubleFreeCount{
     "velox.memory_allocator_double_free_count"};
 
@@ -218,6 +254,9 @@ constexpr folly::StringPiece kMetricMemoryCacheNumAllocClocks{
 constexpr folly::StringPiece kMetricMemoryCacheNumAgedOutEntries{
     "velox.memory_cache_num_aged_out_entries"};
 
+constexpr folly::StringPiece kMetricMemoryCacheNumNotAdmitted{
+    "velox.memory_cache_num_not_admitted"};
+
 constexpr folly::StringPiece kMetricSsdCacheCachedRegions{
     "velox.ssd_cache_cached_regions"};
 
@@ -167,6 +167,8 @@ void PeriodicStatsReporter::reportCacheStats() {
       kMetricMemoryCacheNumAllocClocks, deltaCacheStats.allocClocks);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheNumAgedOutEntries, deltaCacheStats.numAgedOut);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheNumNotAdmitted, deltaCacheStats.numNotAdmitted);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheSumEvictScore, deltaCacheStats.sumEvictScore);
 
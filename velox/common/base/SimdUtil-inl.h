@@ -1436,4 +1436,50 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+inline size_t findSubstring(
+    const char* text,
+    size_t textSize,
+    const char* needle,
+    size_t needleSize,
+    const A&) {
+  if (needleSize == 0) {
+    return 0;
+  }
+  if (needleSize > textSize) {
+    return std::string_view::npos;
+  }
+  if (needleSize == 1) {
+    auto* found = ::memchr(text, needle[0], textSize);
+    return found ? static_cast<const char*>(found) - text
+                 : std::string_view::npos;
+  }
+  using Batch = xsimd::batch<uint8_t, A>;
+  const auto first = Batch::broadcast(static_cast<uint8_t>(needle[0]));
+  const auto last =
+      Batch::broadcast(static_cast<uint8_t>(needle[needleSize - 1]));
+  const auto* data = reinterpret_cast<const uint8_t*>(text);
+  size_t offset = 0;
+  for (; offset + needleSize - 1 + Batch::size <= textSize;
+       offset += Batch::size) {
+    uint64_t candidates = toBitMask(
+        (Batch::load_unaligned(data + offset) == first) &
+        (Batch::load_unaligned(data + offset + needleSize - 1) == last));
+    while (candidates) {
+      const auto position = offset + __builtin_ctzll(candidates);
+      if (::memcmp(text + position + 1, needle + 1, needleSize - 2) == 0) {
+        return position;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  for (; offset + needleSize <= textSize; ++offset) {
+    if (text[offset] == needle[0] &&
+        ::memcmp(text + offset + 1, needle + 1, needleSize - 1) == 0) {
+      return offset;
+    }
+  }
+  return std::string_view::npos;
+}
+
 } // namespace facebook::velox::simd
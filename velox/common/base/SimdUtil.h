@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string_view>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -497,6 +499,19 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of 'needle' of 'needleSize'
+// bytes in 'text' of 'textSize' bytes or std::string_view::npos if there is
+// none. Compares the first and last byte of 'needle' against a SIMD width of
+// candidate positions at a time and only compares the full 'needle' at the
+// positions where both match. Does not read past the end of 'text'.
+template <typename A = xsimd::default_arch>
+inline size_t findSubstring(
+    const char* text,
+    size_t textSize,
+    const char* needle,
+    size_t needleSize,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
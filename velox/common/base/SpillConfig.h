@@ -42,6 +42,10 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// The callback invoked with the bytes of the spill files removed while the
+/// query runs, e.g. the inputs of a spill merge.
+using RemovedSpillBytesCB = std::function<void(uint64_t)>;
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -60,7 +64,10 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _asyncWriteEnabled = false,
+      uint64_t _readPrefetchBytes = 0,
+      uint64_t _mergeMemoryBytes = 0);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -130,7 +137,29 @@ struct SpillConfig {
   /// CompressionKind when spilling, CompressionKind_NONE means no compression.
   common::CompressionKind compressionKind;
 
+  /// If positive and 'compressionKind' is ZSTD, the max size of the ZSTD
+  /// dictionary that each spill writer trains on its first rows.
+  uint32_t compressionDictionaryBytes{0};
+
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true and 'executor' is set, the spill data is written to file on
+  /// 'executor' while the next write buffer is being serialized.
+  bool asyncWriteEnabled{false};
+
+  /// The memory budget in bytes to read ahead the spill files of a sorted
+  /// spill merge on 'executor'. Zero disables read-ahead.
+  uint64_t readPrefetchBytes{0};
+
+  /// The memory budget in bytes for the read buffers of the spill files of a
+  /// sorted spill merge. If the files need more, they are first merged in
+  /// multiple passes into fewer files. Zero means that all files are merged at
+  /// once.
+  uint64_t mergeMemoryBytes{0};
+
+  /// If set, invoked with the bytes of the spill files that are removed before
+  /// the spill directory of the task.
+  RemovedSpillBytesCB removedSpillBytesCb;
 };
 } // namespace facebook::velox::common
@@ -52,7 +52,9 @@ SpillStats::SpillStats(
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
     uint64_t _spillReadTimeUs,
-    uint64_t _spillDeserializationTimeUs)
+    uint64_t _spillDeserializationTimeUs,
+    uint64_t _spillPrefetchHits,
+    uint64_t _spillPrefetchMisses)
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
       spilledBytes(_spilledBytes),
@@ -69,7 +71,9 @@ SpillStats::SpillStats(
       spillReadBytes(_spillReadBytes),
       spillReads(_spillReads),
       spillReadTimeUs(_spillReadTimeUs),
-      spillDeserializationTimeUs(_spillDeserializationTimeUs) {}
+      spillDeserializationTimeUs(_spillDeserializationTimeUs),
+      spillPrefetchHits(_spillPrefetchHits),
+      spillPrefetchMisses(_spillPrefetchMisses) {}
 
 SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillRuns += other.spillRuns;
@@ -89,6 +93,8 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillReads += other.spillReads;
   spillReadTimeUs += other.spillReadTimeUs;
   spillDeserializationTimeUs += other.spillDeserializationTimeUs;
+  spillPrefetchHits += other.spillPrefetchHits;
+  spillPrefetchMisses += other.spillPrefetchMisses;
   return *this;
 }
 
@@ -114,6 +120,8 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillReadTimeUs = spillReadTimeUs - other.spillReadTimeUs;
   result.spillDeserializationTimeUs =
       spillDeserializationTimeUs - other.spillDeserializationTimeUs;
+  result.spillPrefetchHits = spillPrefetchHits - other.spillPrefetchHits;
+  result.spillPrefetchMisses = spillPrefetchMisses - other.spillPrefetchMisses;
   return result;
 }
 
@@ -146,6 +154,8 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillReads);
   UPDATE_COUNTER(spillReadTimeUs);
   UPDATE_COUNTER(spillDeserializationTimeUs);
+  UPDATE_COUNTER(spillPrefetchHits);
+  UPDATE_COUNTER(spillPrefetchMisses);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -185,7 +195,9 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeUs,
-             spillDeserializationTimeUs) ==
+             spillDeserializationTimeUs,
+             spillPrefetchHits,
+             spillPrefetchMisses) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -203,7 +215,9 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeUs,
-             spillDeserializationTimeUs);
+             spillDeserializationTimeUs,
+             other.spillPrefetchHits,
+             other.spillPrefetchMisses);
 }
 
 void SpillStats::reset() {
@@ -224,6 +238,8 @@ void SpillStats::reset() {
   spillReads = 0;
   spillReadTimeUs = 0;
   spillDeserializationTimeUs = 0;
+  spillPrefetchHits = 0;
+  spillPrefetchMisses = 0;
 }
 
 std::string SpillStats::toString() const {
@@ -233,7 +249,8 @@ std::string SpillStats::toString() const {
       "spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] "
       "spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTime[{}] "
-      "spillReadDeserializationTime[{}]",
+      "spillReadDeserializationTime[{}] spillPrefetchHits[{}] "
+      "spillPrefetchMisses[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -250,7 +267,9 @@ std::string SpillStats::toString() const {
       succinctBytes(spillReadBytes),
       spillReads,
       succinctMicros(spillReadTimeUs),
-      succinctMicros(spillDeserializationTimeUs));
+      succinctMicros(spillDeserializationTimeUs),
+      spillPrefetchHits,
+      spillPrefetchMisses);
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
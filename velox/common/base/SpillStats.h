@@ -64,6 +64,11 @@ struct SpillStats {
   uint64_t spillReadTimeUs{0};
   /// The time spent on deserializing rows read from spilled files.
   uint64_t spillDeserializationTimeUs{0};
+  /// The number of spill file reads served by a completed read-ahead.
+  uint64_t spillPrefetchHits{0};
+  /// The number of spill file reads which had to wait for or issue the read
+  /// when read-ahead is enabled.
+  uint64_t spillPrefetchMisses{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -82,7 +87,9 @@ struct SpillStats {
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
       uint64_t _spillReadTimeUs,
-      uint64_t _spillDeserializationTimeUs);
+      uint64_t _spillDeserializationTimeUs,
+      uint64_t _spillPrefetchHits = 0,
+      uint64_t _spillPrefetchMisses = 0);
 
   SpillStats() = default;
 
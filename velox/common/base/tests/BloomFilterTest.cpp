@@ -90,3 +90,30 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batchMayContain) {
+  constexpr int32_t kSize = 1024;
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i * 2));
+  }
+  // Half of the values are in the filter.
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < 2 * kSize; ++i) {
+    hashes.push_back(folly::hasher<int32_t>()(i));
+  }
+  // Sizes with and without partial blocks and SIMD batches.
+  for (auto numHashes : {0, 1, 7, 64, 100, 2 * kSize - 3, 2 * kSize}) {
+    SCOPED_TRACE(numHashes);
+    std::vector<uint64_t> result(bits::nwords(2 * kSize), ~0UL);
+    bloom.mayContain(hashes.data(), numHashes, result.data());
+    for (auto i = 0; i < numHashes; ++i) {
+      EXPECT_EQ(
+          bloom.mayContain(hashes[i]), bits::isBitSet(result.data(), i));
+    }
+    for (auto i = numHashes; i < 2 * kSize; ++i) {
+      EXPECT_TRUE(bits::isBitSet(result.data(), i));
+    }
+  }
+}
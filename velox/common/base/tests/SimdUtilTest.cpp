@@ -453,6 +453,43 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, findSubstring) {
+  auto find = [](std::string_view text, std::string_view needle) {
+    return simd::findSubstring(
+        text.data(), text.size(), needle.data(), needle.size());
+  };
+  auto expectSameAsStd = [&](std::string_view text, std::string_view needle) {
+    EXPECT_EQ(text.find(needle), find(text, needle))
+        << "'" << needle << "' in '" << text << "'";
+  };
+
+  expectSameAsStd("", "");
+  expectSameAsStd("abc", "");
+  expectSameAsStd("", "a");
+  expectSameAsStd("ab", "abc");
+  expectSameAsStd("abc", "c");
+  expectSameAsStd("abc", "bc");
+  expectSameAsStd("abc", "abc");
+  expectSameAsStd("abcabd", "abd");
+
+  // Matches at every position of long texts, including candidates where the
+  // first and last bytes match but the middle does not.
+  std::string text(200, 'a');
+  for (auto i = 0; i < text.size(); i += 7) {
+    text[i] = 'b';
+  }
+  for (auto size = 2; size < 40; ++size) {
+    for (auto start = 0; start + size <= text.size(); start += 3) {
+      expectSameAsStd(text, text.substr(start, size));
+    }
+    expectSameAsStd(text, std::string(size, 'b'));
+    expectSameAsStd(text, "b" + std::string(size, 'a') + "b");
+  }
+  text.back() = 'x';
+  expectSameAsStd(text, "ax");
+  expectSameAsStd(text.substr(0, text.size() - 1), "ax");
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
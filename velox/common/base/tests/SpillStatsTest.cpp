@@ -41,6 +41,8 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spillReads = 10;
   stats1.spillReadTimeUs = 100;
   stats1.spillDeserializationTimeUs = 100;
+  stats1.spillPrefetchHits = 5;
+  stats1.spillPrefetchMisses = 5;
   ASSERT_FALSE(stats1.empty());
   SpillStats stats2;
   stats2.spillRuns = 100;
@@ -60,6 +62,8 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spillReads = 10;
   stats2.spillReadTimeUs = 100;
   stats2.spillDeserializationTimeUs = 100;
+  stats2.spillPrefetchHits = 7;
+  stats2.spillPrefetchMisses = 5;
   ASSERT_TRUE(stats1 < stats2);
   ASSERT_TRUE(stats1 <= stats2);
   ASSERT_FALSE(stats1 > stats2);
@@ -90,6 +94,8 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeUs, 0);
   ASSERT_EQ(delta.spillDeserializationTimeUs, 0);
+  ASSERT_EQ(delta.spillPrefetchHits, 2);
+  ASSERT_EQ(delta.spillPrefetchMisses, 0);
   delta = stats1 - stats2;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
@@ -107,6 +113,8 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeUs, 0);
   ASSERT_EQ(delta.spillDeserializationTimeUs, 0);
+  ASSERT_EQ(delta.spillPrefetchHits, -2);
+  ASSERT_EQ(delta.spillPrefetchMisses, 0);
   stats1.spilledInputBytes = 2060;
   stats1.spilledBytes = 1030;
   stats1.spillReadBytes = 4096;
@@ -127,7 +135,8 @@ TEST(SpillStatsTest, spillStats) {
       "spillSerializationTime[1.03ms] spillWrites[1028] spillFlushTime[1.03ms] "
       "spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
-      "spillReadDeserializationTime[100us]");
+      "spillReadDeserializationTime[100us] spillPrefetchHits[7] "
+      "spillPrefetchMisses[5]");
   ASSERT_EQ(
       fmt::format("{}", stats2),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
@@ -137,5 +146,6 @@ TEST(SpillStatsTest, spillStats) {
       "spillFlushTime[1.03ms] spillWriteTime[1.03ms] "
       "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
-      "spillReadDeserializationTime[100us]");
+      "spillReadDeserializationTime[100us] spillPrefetchHits[7] "
+      "spillPrefetchMisses[5]");
 }
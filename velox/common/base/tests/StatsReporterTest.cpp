@@ -393,6 +393,11 @@ class TestMemoryPool : public memory::MemoryPool {
   Stats stats() const override {
     return Stats();
   }
+
+  std::array<AllocationSiteStats, memory::kNumMemoryAllocationSites>
+  allocationSiteStats() const override {
+    return {};
+  }
 };
 
 TEST_F(PeriodicStatsReporterTest, basic) {
@@ -455,6 +460,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumWaitExclusive.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAllocClocks.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAgedOutEntries.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumNotAdmitted.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheSumEvictScore.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadBytes.str()), 0);
@@ -507,6 +513,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
        .numEvict = 10,
        .numEvictChecks = 10,
        .numWaitExclusive = 10,
+       .numNotAdmitted = 10,
        .numAgedOut = 10,
        .allocClocks = 10,
        .sumEvictScore = 10,
@@ -530,6 +537,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumWaitExclusive.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAllocClocks.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAgedOutEntries.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumNotAdmitted.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheSumEvictScore.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadBytes.str()), 1);
@@ -550,7 +558,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRegionsEvicted.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
-    ASSERT_EQ(counterMap.size(), 50);
+    ASSERT_EQ(counterMap.size(), 51);
   }
 }
 
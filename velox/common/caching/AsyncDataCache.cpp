@@ -43,7 +43,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -69,6 +69,11 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   }
 }
 
+void AsyncDataCacheEntry::setLoadedFromSsd(SsdFile* file, uint64_t offset) {
+  setSsdFile(file, offset);
+  shard_->promoteFromSsd(this);
+}
+
 void AsyncDataCacheEntry::release() {
   VELOX_CHECK_NE(0, numPins_);
   if (numPins_ == kExclusive) {
@@ -154,10 +159,21 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
-    folly::SemiFuture<bool>* wait) {
+    folly::SemiFuture<bool>* wait,
+    int32_t readPct) {
+  // The admission policy is not thread safe, so with a policy every access
+  // takes the exclusive path.
+  if (admissionPolicy_ == nullptr) {
+    auto pin = findShared(key, size);
+    if (!pin.empty()) {
+      return pin;
+    }
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
+  const auto keyHash =
+      admissionPolicy_ ? std::hash<RawFileCacheKey>()(key) : 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -179,6 +195,16 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          // The first use of a prefetched entry belongs to the access that
+          // loaded it. Only later hits count as reuse.
+          if (admissionPolicy_) {
+            admissionPolicy_->recordAccess(keyHash);
+            if (!found->isAdmitted_ &&
+                admissionPolicy_->admit(keyHash, readPct)) {
+              found->isAdmitted_ = true;
+              --numNotAdmittedEntries_;
+            }
+          }
         }
         ++found->numPins_;
         CachePin pin;
@@ -212,6 +238,16 @@ CachePin CacheShard::findOrCreate(
       entries_[index] = std::move(newEntry);
     }
     ++numNew_;
+    if (admissionPolicy_) {
+      admissionPolicy_->recordAccess(keyHash);
+      entryToInit->isAdmitted_ = admissionPolicy_->admit(keyHash, readPct);
+      if (!entryToInit->isAdmitted_) {
+        ++numNotAdmitted_;
+        ++numNotAdmittedEntries_;
+      }
+    } else {
+      entryToInit->isAdmitted_ = true;
+    }
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
@@ -220,8 +256,35 @@ CachePin CacheShard::findOrCreate(
   return initEntry(key, entryToInit);
 }
 
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* found = it->second;
+  if (found->size() < size || found->isPrefetch()) {
+    return CachePin();
+  }
+  // An entry cannot become exclusive while 'mutex_' is held, so the pin is
+  // good if taken from a non-negative count.
+  auto numPins = found->numPins_.load();
+  do {
+    if (numPins < 0) {
+      return CachePin();
+    }
+  } while (!found->numPins_.compare_exchange_weak(numPins, numPins + 1));
+  found->touch();
+  ++eventCounter_;
+  ++numHit_;
+  hitBytes_ += found->size();
+  CachePin pin;
+  pin.setEntry(found);
+  return pin;
+}
+
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -303,7 +366,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -311,6 +374,10 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  if (!entry->isAdmitted_) {
+    entry->isAdmitted_ = true;
+    --numNotAdmittedEntries_;
+  }
   if (!entry->key_.fileNum.hasValue()) {
     return;
   }
@@ -337,6 +404,22 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   entry->size_ = 0;
 }
 
+void CacheShard::promoteFromSsd(AsyncDataCacheEntry* entry) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  ++numSsdHit_;
+  ssdHitBytes_ += entry->size();
+  // An entry that the admission policy did not admit takes no budget.
+  if (!entry->isAdmitted_) {
+    ++numNotPromoted_;
+    return;
+  }
+  if (!cache_->promotionBudget().tryAcquire(entry->size())) {
+    entry->isAdmitted_ = false;
+    ++numNotAdmittedEntries_;
+    ++numNotPromoted_;
+  }
+}
+
 uint64_t CacheShard::evict(
     uint64_t bytesToFree,
     bool evictAllUnpinned,
@@ -344,22 +427,80 @@ uint64_t CacheShard::evict(
     memory::Allocation& acquired) {
   auto* ssdCache = cache_->ssdCache();
   const bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
+  // Saveable entries chosen for eviction are written to SSD instead of being
+  // dropped, unless a write is already in progress.
+  const bool demoteSsdSaveable = ssdCache && !skipSsdSaveable &&
+      !evictAllUnpinned && cache_->tieringOptions().demotionBytesPerSec > 0;
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  std::vector<CachePin> demotions;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
   int32_t evictSaveableSkipped = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
     }
+    // Evicts the entry at 'entryIndex'. Returns true if enough is evicted.
+    auto evictEntry = [&](int32_t entryIndex, int32_t score) {
+      auto& entry = entries_[entryIndex];
+      auto* candidate = entry.get();
+      largeEvicted += candidate->data_.byteSize();
+      if (pagesToAcquire > 0) {
+        const auto candidatePages = candidate->data().numPages();
+        pagesToAcquire = candidatePages > pagesToAcquire
+            ? 0
+            : pagesToAcquire - candidatePages;
+        acquired.appendMove(candidate->data());
+        VELOX_CHECK(candidate->data().empty());
+      } else {
+        toFree.push_back(std::move(candidate->data()));
+      }
+      tinyEvicted += candidate->tinyData_.size();
+      candidate->tinyData_.clear();
+      candidate->tinyData_.shrink_to_fit();
+      candidate->size_ = 0;
+
+      removeEntryLocked(candidate);
+      emptySlots_.push_back(entryIndex);
+      tryAddFreeEntry(std::move(entry));
+      ++numEvict_;
+      if (score > 0) {
+        sumEvictScore_ += score;
+      }
+      return largeEvicted + tinyEvicted > bytesToFree;
+    };
+
+    // Entries that the admission policy did not admit go before any admitted
+    // entry is considered, unless prefetched and not yet used.
+    bool done = false;
+    if (!evictAllUnpinned) {
+      for (auto i = 0; i < size && numNotAdmittedEntries_ > 0; ++i) {
+        const auto entryIndex = notAdmittedHand_++ % size;
+        auto* candidate = entries_[entryIndex].get();
+        ++numEvictChecks_;
+        if (candidate == nullptr || candidate->isAdmitted_ ||
+            candidate->isPrefetch_ || candidate->numPins_ != 0) {
+          continue;
+        }
+        if (skipSsdSaveable && candidate->ssdSaveable()) {
+          ++evictSaveableSkipped;
+          continue;
+        }
+        if (evictEntry(entryIndex, 0)) {
+          done = true;
+          break;
+        }
+      }
+    }
+
     int32_t counter = 0;
     int32_t numChecked = 0;
     auto entryIndex = (clockHand_ % size);
     auto iter = entries_.begin() + entryIndex;
-    while (++counter <= size) {
+    while (!done && ++counter <= size) {
       if (++iter == entries_.end()) {
         iter = entries_.begin();
         entryIndex = 0;
@@ -392,30 +533,17 @@ uint64_t CacheShard::evict(
           ++evictSaveableSkipped;
           continue;
         }
-        largeEvicted += candidate->data_.byteSize();
-        if (pagesToAcquire > 0) {
-          const auto candidatePages = candidate->data().numPages();
-          pagesToAcquire = candidatePages > pagesToAcquire
-              ? 0
-              : pagesToAcquire - candidatePages;
-          acquired.appendMove(candidate->data());
-          VELOX_CHECK(candidate->data().empty());
-        } else {
-          toFree.push_back(std::move(candidate->data()));
-        }
-        tinyEvicted += candidate->tinyData_.size();
-        candidate->tinyData_.clear();
-        candidate->tinyData_.shrink_to_fit();
-        candidate->size_ = 0;
-
-        removeEntryLocked(candidate);
-        emptySlots_.push_back(entryIndex);
-        tryAddFreeEntry(std::move(*iter));
-        ++numEvict_;
-        if (score > 0) {
-          sumEvictScore_ += score;
+        if (demoteSsdSaveable && candidate->ssdSaveable() &&
+            cache_->demotionBudget().tryAcquire(candidate->size())) {
+          // The pin keeps the entry until written. It is evicted by a later
+          // pass once it is backed by SSD.
+          ++candidate->numPins_;
+          CachePin pin;
+          pin.setEntry(candidate);
+          demotions.push_back(std::move(pin));
+          continue;
         }
-        if (largeEvicted + tinyEvicted > bytesToFree) {
+        if (evictEntry(entryIndex, score)) {
           break;
         }
       }
@@ -426,6 +554,9 @@ uint64_t CacheShard::evict(
   freeAllocations(toFree);
   cache_->incrementCachedPages(
       -memory::AllocationTraits::numPages(largeEvicted));
+  if (!demotions.empty()) {
+    cache_->demoteToSsd(std::move(demotions));
+  }
   if (evictSaveableSkipped) {
     VELOX_CHECK_NOT_NULL(ssdCache);
     if (ssdCache->startWrite()) {
@@ -481,7 +612,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -513,13 +644,17 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvict += numEvict_;
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
+  stats.numNotAdmitted += numNotAdmitted_;
+  stats.numSsdHit += numSsdHit_;
+  stats.ssdHitBytes += ssdHitBytes_;
+  stats.numNotPromoted += numNotPromoted_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch. If SSD save is slower
   // than storage read, we must not have a situation where SSD save pins
   // everything and stops reading.
@@ -552,7 +687,7 @@ bool CacheShard::removeFileEntries(
   int64_t pagesRemoved = 0;
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
 
     auto entryIndex = -1;
     for (auto& cacheEntry : entries_) {
@@ -589,6 +724,22 @@ bool CacheShard::removeFileEntries(
   return true;
 }
 
+void CacheShard::appendFileBytes(
+    folly::F14FastMap<uint64_t, CachedFileBytes>& files) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    // Exclusive entries are still loading.
+    if (!entry || !entry->key_.fileNum.hasValue() || entry->isExclusive()) {
+      continue;
+    }
+    auto& bytes = files[entry->key_.fileNum.id()];
+    bytes.ramBytes += entry->size();
+    if (entry->groupId_ != 0) {
+      bytes.groupId = entry->groupId_;
+    }
+  }
+}
+
 CacheStats CacheStats::operator-(CacheStats& other) const {
   CacheStats result;
   result.numHit = numHit - other.numHit;
@@ -597,6 +748,12 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   result.numEvict = numEvict - other.numEvict;
   result.numEvictChecks = numEvictChecks - other.numEvictChecks;
   result.numWaitExclusive = numWaitExclusive - other.numWaitExclusive;
+  result.numNotAdmitted = numNotAdmitted - other.numNotAdmitted;
+  result.numSsdHit = numSsdHit - other.numSsdHit;
+  result.ssdHitBytes = ssdHitBytes - other.ssdHitBytes;
+  result.numNotPromoted = numNotPromoted - other.numNotPromoted;
+  result.numDemoted = numDemoted - other.numDemoted;
+  result.demotedBytes = demotedBytes - other.demotedBytes;
   result.numAgedOut = numAgedOut - other.numAgedOut;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
@@ -607,12 +764,29 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   return result;
 }
 
+double CacheStats::ramHitRatio() const {
+  const auto numLookups = numHit + numNew;
+  return numLookups == 0 ? 0 : static_cast<double>(numHit) / numLookups;
+}
+
+double CacheStats::ssdHitRatio() const {
+  return numNew == 0 ? 0 : static_cast<double>(numSsdHit) / numNew;
+}
+
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheAdmissionPolicyFactory admissionPolicyFactory,
+    const CacheTieringOptions& tieringOptions)
+    : allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      tieringOptions_(tieringOptions),
+      promotionBudget_(tieringOptions_.promotionBytesPerSec),
+      demotionBudget_(tieringOptions_.demotionBytesPerSec),
+      cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this, admissionPolicyFactory ? admissionPolicyFactory() : nullptr));
   }
 }
 
@@ -621,8 +795,14 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheAdmissionPolicyFactory admissionPolicyFactory,
+    const CacheTieringOptions& tieringOptions) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator,
+      std::move(ssdCache),
+      std::move(admissionPolicyFactory),
+      tieringOptions);
   allocator->registerCache(cache);
   return cache;
 }
@@ -660,9 +840,10 @@ void CacheShard::shutdown() {
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
-    folly::SemiFuture<bool>* wait) {
+    folly::SemiFuture<bool>* wait,
+    int32_t readPct) {
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  return shards_[shard]->findOrCreate(key, size, wait, readPct);
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
@@ -865,6 +1046,19 @@ void AsyncDataCache::saveToSsd() {
   ssdCache_->write(std::move(pins));
 }
 
+void AsyncDataCache::demoteToSsd(std::vector<CachePin> pins) {
+  if (!ssdCache_->startWrite()) {
+    return;
+  }
+  uint64_t bytes = 0;
+  for (const auto& pin : pins) {
+    bytes += pin.checkedEntry()->size();
+  }
+  numDemoted_ += pins.size();
+  demotedBytes_ += bytes;
+  ssdCache_->write(std::move(pins));
+}
+
 bool AsyncDataCache::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -886,11 +1080,24 @@ bool AsyncDataCache::removeFileEntries(
   return success;
 }
 
+CacheSummary AsyncDataCache::summary(int32_t maxFiles) const {
+  folly::F14FastMap<uint64_t, CachedFileBytes> files;
+  for (auto& shard : shards_) {
+    shard->appendFileBytes(files);
+  }
+  if (ssdCache_) {
+    ssdCache_->appendFileBytes(files);
+  }
+  return CacheSummary::create(files, maxFiles);
+}
+
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
   for (auto& shard : shards_) {
     shard->updateStats(stats);
   }
+  stats.numDemoted = numDemoted_;
+  stats.demotedBytes = demotedBytes_;
   if (ssdCache_ != nullptr) {
     stats.ssdStats = std::make_shared<SsdCacheStats>(ssdCache_->stats());
   }
@@ -945,7 +1152,21 @@ std::string CacheStats::toString() const {
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
-      << "\n"
+      << "\n";
+  // Cache tiering stats. Only meaningful with an SSD tier.
+  if (ssdStats != nullptr) {
+    out << fmt::format(
+        "Tiering RAM hit ratio: {:.1f}% SSD hit ratio: {:.1f}% SSD hit: {} "
+        "bytes: {} not promoted: {} demoted: {} bytes: {}\n",
+        100 * ramHitRatio(),
+        100 * ssdHitRatio(),
+        numSsdHit,
+        succinctBytes(ssdHitBytes),
+        numNotPromoted,
+        numDemoted,
+        succinctBytes(demotedBytes));
+  }
+  out
       // Cache timing stats.
       << "Alloc Megaclocks " << (allocClocks >> 20);
   return out.str();
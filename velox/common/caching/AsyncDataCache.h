@@ -17,16 +17,22 @@
 #pragma once
 
 #include <deque>
+#include <shared_mutex>
 
 #include <fmt/format.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
+#include <folly/lang/Align.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheAdmissionPolicy.h"
+#include "velox/common/caching/CacheSummary.h"
+#include "velox/common/caching/CacheTiering.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
@@ -62,8 +68,9 @@ inline AccessTime accessTime() {
 }
 
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  // Updated by concurrent hits without synchronization.
+  tsan_atomic<AccessTime> lastUse{0};
+  tsan_atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -231,6 +238,10 @@ class AsyncDataCacheEntry {
     ssdSaveable_ = false;
   }
 
+  /// Sets the SSD file and offset 'this' was just read from and decides if
+  /// 'this' is promoted to stay in RAM. See CacheTieringOptions.
+  void setLoadedFromSsd(SsdFile* file, uint64_t offset);
+
   SsdFile* ssdFile() const {
     return ssdFile_;
   }
@@ -291,7 +302,8 @@ class AsyncDataCacheEntry {
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this from 0 to 1 requires owning shard_->mutex_ in shared or
+  // exclusive mode. Setting this to kExclusive requires exclusive mode.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -299,13 +311,19 @@ class AsyncDataCacheEntry {
   // True if 'this' is speculatively loaded. This is reset on first
   // hit. Allows catching a situation where prefetched entries get
   // evicted before they are hit.
-  bool isPrefetch_{false};
+  tsan_atomic<bool> isPrefetch_{false};
 
   // Sets after first use of a prefetched entry. Cleared by
   // getAndClearFirstUseFlag(). Does not require synchronization since used for
   // statistics only.
   std::atomic<bool> isFirstUse_{false};
 
+  // False if the admission policy of 'shard_' did not admit 'this'. Such an
+  // entry is evicted before any admitted entry once it is not pinned or
+  // waiting for its first use. Set to true by a later hit that the policy
+  // admits. Set inside the shard mutex.
+  bool isAdmitted_{true};
+
   // Group id. Used for deciding if 'this' should be written to SSD.
   uint64_t groupId_{0};
 
@@ -517,6 +535,20 @@ struct CacheStats {
   /// Number of times a user waited for an entry to transit from exclusive to
   /// shared mode.
   int64_t numWaitExclusive{0};
+  /// Number of new entries that the admission policy did not admit.
+  int64_t numNotAdmitted{0};
+  /// Number of new entries read from SSD instead of storage.
+  int64_t numSsdHit{0};
+  /// Sum of sizes of entries counted in 'numSsdHit'.
+  int64_t ssdHitBytes{0};
+  /// Number of entries read from SSD that were not promoted to stay in RAM,
+  /// because the admission policy did not admit them or the promotion budget
+  /// was used up.
+  int64_t numNotPromoted{0};
+  /// Number of entries written to SSD on eviction from RAM.
+  int64_t numDemoted{0};
+  /// Sum of sizes of entries counted in 'numDemoted'.
+  int64_t demotedBytes{0};
   /// Total number of entries that are aged out and beyond TTL.
   int64_t numAgedOut{};
   /// Cumulative clocks spent in allocating or freeing memory for backing cache
@@ -531,22 +563,34 @@ struct CacheStats {
 
   CacheStats operator-(CacheStats& other) const;
 
+  /// Returns the fraction of lookups found in RAM.
+  double ramHitRatio() const;
+
+  /// Returns the fraction of RAM misses read from SSD.
+  double ssdHitRatio() const;
+
   std::string toString() const;
 };
 
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
-/// and other housekeeping.
-class CacheShard {
+/// and other housekeeping. Hits on filled entries hold the mutex in shared
+/// mode, so that concurrent readers of hot entries do not serialize. Inserts,
+/// removals and eviction hold it in exclusive mode.
+class alignas(folly::hardware_destructive_interference_size) CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  explicit CacheShard(
+      AsyncDataCache* cache,
+      std::unique_ptr<CacheAdmissionPolicy> admissionPolicy = nullptr)
+      : cache_(cache), admissionPolicy_(std::move(admissionPolicy)) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
       RawFileCacheKey key,
       uint64_t size,
-      folly::SemiFuture<bool>* readyFuture);
+      folly::SemiFuture<bool>* readyFuture,
+      int32_t readPct = 100);
 
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
@@ -555,7 +599,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -585,6 +629,10 @@ class CacheShard {
   /// Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  /// Records that 'entry' was read from SSD and decides if it is promoted to
+  /// stay in RAM.
+  void promoteFromSsd(AsyncDataCacheEntry* entry);
+
   /// Appends a batch of non-saved SSD savable entries in 'this' to
   /// 'pins'. This may have to be called several times since this keeps
   /// limits on the batch to write at one time. The savable entries
@@ -600,6 +648,10 @@ class CacheShard {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the bytes of the file entries in 'this' to 'files', keyed on file
+  /// id.
+  void appendFileBytes(folly::F14FastMap<uint64_t, CachedFileBytes>& files);
+
   auto& allocClocks() {
     return allocClocks_;
   }
@@ -620,13 +672,24 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Returns a shared pin on the entry for 'key' if it has at least 'size'
+  // bytes and is filled. Holds 'mutex_' in shared mode. Returns an empty pin
+  // if the access needs the exclusive path in findOrCreate(), e.g. for a
+  // miss or the first use of a prefetched entry.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
   AsyncDataCache* const cache_;
+  // Decides which new entries are retained past their first use. nullptr
+  // admits all.
+  const std::unique_ptr<CacheAdmissionPolicy> admissionPolicy_;
 
-  mutable std::mutex mutex_;
+  // Read locks of folly::SharedMutex do not write a shared cache line, which
+  // keeps concurrent hits from contending.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -638,18 +701,30 @@ class CacheShard {
 
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
+  // Index in 'entries_' for the next candidate in the eviction of entries
+  // that were not admitted.
+  uint32_t notAdmittedHand_{0};
+  // Number of entries in 'entries_' with 'isAdmitted_' false.
+  int32_t numNotAdmittedEntries_{0};
   // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  std::atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
   // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  std::atomic<uint64_t> numHit_{0};
   // Cumulative Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
   uint64_t numNew_{0};
+  // Cumulative count of new entries not admitted by 'admissionPolicy_'.
+  uint64_t numNotAdmitted_{0};
+  // Cumulative count and bytes of entries read from SSD.
+  uint64_t numSsdHit_{0};
+  uint64_t ssdHitBytes_{0};
+  // Cumulative count of entries read from SSD and not promoted.
+  uint64_t numNotPromoted_{0};
   // Cumulative count of entries evicted.
   uint64_t numEvict_{0};
   // Cumulative count of entries considered for eviction. This divided by
@@ -667,15 +742,24 @@ class CacheShard {
 
 class AsyncDataCache : public memory::Cache {
  public:
+  /// If 'admissionPolicyFactory' is set, each shard gets a policy from it
+  /// that decides which new entries are retained past their first use.
+  /// Otherwise all entries are retained by recency and frequency of use.
+  /// 'tieringOptions' limit the movement of entries between RAM and
+  /// 'ssdCache'.
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheAdmissionPolicyFactory admissionPolicyFactory = nullptr,
+      const CacheTieringOptions& tieringOptions = {});
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheAdmissionPolicyFactory admissionPolicyFactory = nullptr,
+      const CacheTieringOptions& tieringOptions = {});
 
   static AsyncDataCache* getInstance();
 
@@ -712,11 +796,15 @@ class AsyncDataCache : public memory::Cache {
   /// future that is realized when the pin is no longer exclusive. When
   /// the future is realized, the caller may retry findOrCreate().
   /// runtime error with code kNoCacheSpace if there is no space to create the
-  /// new entry after evicting any unpinned content.
+  /// new entry after evicting any unpinned content. 'readPct' is the
+  /// percentage of references to the stream of 'key' that are actually read,
+  /// as given by ScanTracker::readPct(). The admission policy, if any, may
+  /// hold new entries of seldom read streams to a higher standard.
   CachePin findOrCreate(
       RawFileCacheKey key,
       uint64_t size,
-      folly::SemiFuture<bool>* waitFuture = nullptr);
+      folly::SemiFuture<bool>* waitFuture = nullptr,
+      int32_t readPct = 100);
 
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
@@ -768,14 +856,16 @@ class AsyncDataCache : public memory::Cache {
   // loaded pins. Calls processPin for each exclusive
   // pin. processPin must move its argument if it wants to use it
   // afterwards. sizeFunc(i) returns the size of the ith item in
-  // 'keys'.
-  template <typename SizeFunc, typename ProcessPin>
+  // 'keys'. readPctFunc(i) returns the read percentage of the stream of the
+  // ith item, see findOrCreate().
+  template <typename SizeFunc, typename ProcessPin, typename ReadPctFunc>
   void makePins(
       const std::vector<RawFileCacheKey>& keys,
       SizeFunc sizeFunc,
-      ProcessPin processPin) {
+      ProcessPin processPin,
+      ReadPctFunc readPctFunc) {
     for (auto i = 0; i < keys.size(); ++i) {
-      auto pin = findOrCreate(keys[i], sizeFunc(i), nullptr);
+      auto pin = findOrCreate(keys[i], sizeFunc(i), nullptr, readPctFunc(i));
       if (pin.empty() || pin.checkedEntry()->isShared()) {
         continue;
       }
@@ -783,12 +873,40 @@ class AsyncDataCache : public memory::Cache {
     }
   }
 
+  template <typename SizeFunc, typename ProcessPin>
+  void makePins(
+      const std::vector<RawFileCacheKey>& keys,
+      SizeFunc sizeFunc,
+      ProcessPin processPin) {
+    makePins(keys, sizeFunc, processPin, [](int32_t /*index*/) {
+      return 100;
+    });
+  }
+
   // Drops all unpinned entries. Pins stay valid.
   void testingClear();
 
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
   void saveToSsd();
 
+  const CacheTieringOptions& tieringOptions() const {
+    return tieringOptions_;
+  }
+
+  IoBudget& promotionBudget() {
+    return promotionBudget_;
+  }
+
+  IoBudget& demotionBudget() {
+    return demotionBudget_;
+  }
+
+  // Writes the entries of 'pins' to 'ssdCache_' in the background if no other
+  // write is in progress. The pins are for entries chosen for eviction. If
+  // the write cannot start, they are dropped and the entries stay in RAM
+  // until chosen again.
+  void demoteToSsd(std::vector<CachePin> pins);
+
   tsan_atomic<int32_t>& numSkippedSaves() {
     return numSkippedSaves_;
   }
@@ -801,6 +919,13 @@ class AsyncDataCache : public memory::Cache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Returns the files cached in RAM and SSD with their cached bytes, for
+  /// routing splits to the workers that cache their data. Lists at most
+  /// 'maxFiles' files individually. Takes each shard mutex in turn, so this
+  /// is meant to be polled every few seconds, not per split.
+  CacheSummary summary(
+      int32_t maxFiles = CacheSummary::kDefaultMaxFiles) const;
+
  private:
   static constexpr int32_t kNumShards = 4; // Must be power of 2.
   static constexpr int32_t kShardMask = kNumShards - 1;
@@ -817,6 +942,13 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const CacheTieringOptions tieringOptions_;
+  IoBudget promotionBudget_;
+  IoBudget demotionBudget_;
+  // Cumulative count and bytes of entries written to 'ssdCache_' by
+  // demoteToSsd().
+  std::atomic<uint64_t> numDemoted_{0};
+  std::atomic<uint64_t> demotedBytes_{0};
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAdmissionPolicy.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+namespace {
+// Number of doorkeeper bits per sketch counter in a row.
+constexpr int32_t kDoorkeeperBitsPerCounter = 4;
+
+// The key hashes are also used for picking the shard, so remix them before
+// deriving the sketch positions.
+inline uint64_t mix(uint64_t keyHash) {
+  return folly::hash::twang_mix64(keyHash);
+}
+} // namespace
+
+TinyLfuAdmissionPolicy::TinyLfuAdmissionPolicy(
+    int32_t sampleSize,
+    int32_t minFrequency)
+    : sampleSize_(sampleSize),
+      minFrequency_(minFrequency),
+      rowMask_(bits::nextPowerOfTwo(sampleSize) - 1),
+      doorkeeperMask_((rowMask_ + 1) * kDoorkeeperBitsPerCounter - 1) {
+  VELOX_CHECK_GT(sampleSize_, 0);
+  VELOX_CHECK_GT(minFrequency_, 0);
+  counters_.resize(kNumRows * (rowMask_ + 1));
+  doorkeeper_.resize(bits::nwords(doorkeeperMask_ + 1));
+}
+
+uint64_t TinyLfuAdmissionPolicy::counterIndex(uint64_t mixed, int32_t row)
+    const {
+  // Double hashing with the two halves of 'mixed'. The odd step keeps the
+  // rows from colliding on the same column.
+  const uint64_t step = (mixed >> 32) | 1;
+  return row * (rowMask_ + 1) + ((mixed + row * step) & rowMask_);
+}
+
+uint64_t TinyLfuAdmissionPolicy::doorkeeperBit(uint64_t mixed, int32_t probe)
+    const {
+  return (probe == 0 ? mixed >> 17 : (mixed >> 40) ^ mixed) & doorkeeperMask_;
+}
+
+bool TinyLfuAdmissionPolicy::inDoorkeeper(uint64_t mixed) const {
+  return bits::isBitSet(doorkeeper_.data(), doorkeeperBit(mixed, 0)) &&
+      bits::isBitSet(doorkeeper_.data(), doorkeeperBit(mixed, 1));
+}
+
+void TinyLfuAdmissionPolicy::recordAccess(uint64_t keyHash) {
+  const auto mixed = mix(keyHash);
+  if (!inDoorkeeper(mixed)) {
+    bits::setBit(doorkeeper_.data(), doorkeeperBit(mixed, 0));
+    bits::setBit(doorkeeper_.data(), doorkeeperBit(mixed, 1));
+  } else {
+    // Conservative update: only the smallest counters are incremented since
+    // the larger ones already overcount because of collisions.
+    uint8_t minCount = kMaxCount;
+    for (auto row = 0; row < kNumRows; ++row) {
+      minCount = std::min(minCount, counters_[counterIndex(mixed, row)]);
+    }
+    if (minCount < kMaxCount) {
+      for (auto row = 0; row < kNumRows; ++row) {
+        auto& counter = counters_[counterIndex(mixed, row)];
+        if (counter == minCount) {
+          ++counter;
+        }
+      }
+    }
+  }
+  if (++numAccesses_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t TinyLfuAdmissionPolicy::frequency(uint64_t keyHash) const {
+  const auto mixed = mix(keyHash);
+  uint8_t minCount = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    minCount = std::min(minCount, counters_[counterIndex(mixed, row)]);
+  }
+  // The doorkeeper holds the first access since the last aging.
+  return minCount + (inDoorkeeper(mixed) ? 1 : 0);
+}
+
+bool TinyLfuAdmissionPolicy::admit(uint64_t keyHash, int32_t readPct) {
+  const auto required = minFrequency_ + (readPct < kMinAdmitReadPct ? 1 : 0);
+  return frequency(keyHash) >= required;
+}
+
+void TinyLfuAdmissionPolicy::age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+  numAccesses_ = 0;
+  ++numAgings_;
+}
+
+std::string TinyLfuAdmissionPolicy::toString() const {
+  return fmt::format(
+      "TinyLFU[sample size {} min frequency {} counters {} agings {}]",
+      sampleSize_,
+      minFrequency_,
+      counters_.size(),
+      numAgings_);
+}
+
+} // namespace facebook::velox::cache
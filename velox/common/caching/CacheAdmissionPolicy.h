@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Decides which new entries of AsyncDataCache are retained in RAM past
+/// their first use. An entry that is not admitted is still created and
+/// filled for its reader but it is the first to go when the cache evicts,
+/// unless a later hit admits it. This keeps a large scan that reads each
+/// range once from pushing out data that is read over and over.
+///
+/// Each CacheShard owns its own instance and calls it under the shard
+/// mutex, so implementations need not be thread safe.
+class CacheAdmissionPolicy {
+ public:
+  virtual ~CacheAdmissionPolicy() = default;
+
+  /// Records a use of the entry with key hash 'keyHash'.
+  virtual void recordAccess(uint64_t keyHash) = 0;
+
+  /// Returns true if the entry with key hash 'keyHash' should be retained.
+  /// 'readPct' is the percentage of references to the entry's stream that
+  /// are actually read, as given by ScanTracker, or 100 if not known.
+  virtual bool admit(uint64_t keyHash, int32_t readPct) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// Makes a policy for each CacheShard.
+using CacheAdmissionPolicyFactory =
+    std::function<std::unique_ptr<CacheAdmissionPolicy>()>;
+
+/// TinyLFU admission. Approximates the access frequency of each key with a
+/// count-min sketch of 'kNumRows' rows of saturating counters, fronted by a
+/// doorkeeper bloom filter that absorbs the first access so that keys seen
+/// once do not take sketch counters. Every 'sampleSize' accesses the
+/// counters are halved and the doorkeeper is cleared, so that frequencies
+/// follow changes in the workload. A key is admitted when its estimated
+/// frequency reaches 'minFrequency'. Streams read less than
+/// 'kMinAdmitReadPct' of the time they are referenced need one more access.
+class TinyLfuAdmissionPolicy : public CacheAdmissionPolicy {
+ public:
+  static constexpr int32_t kDefaultSampleSize = 1 << 16;
+  static constexpr int32_t kDefaultMinFrequency = 2;
+  static constexpr int32_t kMinAdmitReadPct = 80;
+
+  explicit TinyLfuAdmissionPolicy(
+      int32_t sampleSize = kDefaultSampleSize,
+      int32_t minFrequency = kDefaultMinFrequency);
+
+  void recordAccess(uint64_t keyHash) override;
+
+  bool admit(uint64_t keyHash, int32_t readPct) override;
+
+  std::string toString() const override;
+
+  /// Returns the estimated number of accesses to 'keyHash' since it was last
+  /// aged out.
+  int32_t frequency(uint64_t keyHash) const;
+
+  /// Returns the number of times the counters have been halved.
+  uint64_t numAgings() const {
+    return numAgings_;
+  }
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Returns the index of the counter for 'mixed' in row 'row'.
+  uint64_t counterIndex(uint64_t mixed, int32_t row) const;
+
+  // Returns the index of doorkeeper bit 'probe' of 'mixed'.
+  uint64_t doorkeeperBit(uint64_t mixed, int32_t probe) const;
+
+  // Returns true if both doorkeeper bits of 'mixed' are set.
+  bool inDoorkeeper(uint64_t mixed) const;
+
+  // Halves all counters and clears the doorkeeper.
+  void age();
+
+  const int32_t sampleSize_;
+  const int32_t minFrequency_;
+  // Number of counters in each row - 1. The row size is a power of 2.
+  const uint64_t rowMask_;
+  // Number of doorkeeper bits - 1.
+  const uint64_t doorkeeperMask_;
+
+  // 'kNumRows' rows of 'rowMask_' + 1 counters.
+  std::vector<uint8_t> counters_;
+  std::vector<uint64_t> doorkeeper_;
+  // Accesses since the last aging.
+  int32_t numAccesses_{0};
+  uint64_t numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheSummary.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+// static
+CacheSummary CacheSummary::create(
+    const folly::F14FastMap<uint64_t, CachedFileBytes>& files,
+    int32_t maxFiles) {
+  CacheSummary summary;
+  summary.numFiles = files.size();
+  summary.fileFilter.reset(std::max<int32_t>(1, files.size()));
+  folly::F14FastMap<uint64_t, uint64_t> groups;
+  std::vector<std::pair<uint64_t, const CachedFileBytes*>> sorted;
+  sorted.reserve(files.size());
+  for (const auto& [fileId, bytes] : files) {
+    summary.ramBytes += bytes.ramBytes;
+    summary.ssdBytes += bytes.ssdBytes;
+    if (bytes.groupId != 0) {
+      groups[bytes.groupId] += bytes.totalBytes();
+    }
+    sorted.emplace_back(fileId, &bytes);
+  }
+
+  const auto numTop = std::min<size_t>(std::max(0, maxFiles), sorted.size());
+  std::partial_sort(
+      sorted.begin(),
+      sorted.begin() + numTop,
+      sorted.end(),
+      [](const auto& left, const auto& right) {
+        return left.second->totalBytes() > right.second->totalBytes();
+      });
+  for (auto i = 0; i < sorted.size(); ++i) {
+    // A file may have been removed from fileIds() after its entries were
+    // counted.
+    auto path = fileIds().string(sorted[i].first);
+    if (path.empty()) {
+      continue;
+    }
+    summary.fileFilter.insert(pathHash(path));
+    if (i < numTop) {
+      const auto& bytes = *sorted[i].second;
+      summary.topFiles.push_back(
+          {std::move(path), bytes.groupId, bytes.ramBytes, bytes.ssdBytes});
+    }
+  }
+
+  summary.groupBytes.assign(groups.begin(), groups.end());
+  std::sort(
+      summary.groupBytes.begin(),
+      summary.groupBytes.end(),
+      [](const auto& left, const auto& right) {
+        return left.second > right.second;
+      });
+  return summary;
+}
+
+// static
+uint64_t CacheSummary::pathHash(std::string_view path) {
+  return XXH64(path.data(), path.size(), 0);
+}
+
+std::string CacheSummary::toString() const {
+  return fmt::format(
+      "CacheSummary[files {} RAM {} SSD {} groups {} top files {}]",
+      numFiles,
+      succinctBytes(ramBytes),
+      succinctBytes(ssdBytes),
+      groupBytes.size(),
+      topFiles.size());
+}
+
+} // namespace facebook::velox::cache
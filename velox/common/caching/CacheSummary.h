@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::cache {
+
+/// Bytes of one file in the RAM and SSD tiers of AsyncDataCache.
+struct CachedFileBytes {
+  /// The file group of the file's RAM entries, 0 if not known.
+  uint64_t groupId{0};
+  uint64_t ramBytes{0};
+  uint64_t ssdBytes{0};
+
+  uint64_t totalBytes() const {
+    return ramBytes + ssdBytes;
+  }
+};
+
+/// Compact description of the files AsyncDataCache holds, for schedulers
+/// that route splits to the workers that have their data cached. Files are
+/// identified by path since the ids in fileIds() are local to the process.
+struct CacheSummary {
+  static constexpr int32_t kDefaultMaxFiles = 1'000;
+
+  struct File {
+    std::string path;
+    uint64_t groupId;
+    uint64_t ramBytes;
+    uint64_t ssdBytes;
+  };
+
+  /// Makes a summary of 'files', a map from file id to its cached bytes. Keeps
+  /// at most 'maxFiles' files in 'topFiles'. All files are in 'fileFilter'.
+  static CacheSummary create(
+      const folly::F14FastMap<uint64_t, CachedFileBytes>& files,
+      int32_t maxFiles);
+
+  /// Returns the hash of 'path' inserted in 'fileFilter'. This is XXH64 with
+  /// seed 0, so that a scheduler can probe the filter without Velox.
+  static uint64_t pathHash(std::string_view path);
+
+  /// Returns false if no entry of 'path' is cached. May return true for a
+  /// file that is not cached.
+  bool mayContain(std::string_view path) const {
+    return fileFilter.isSet() && fileFilter.mayContain(pathHash(path));
+  }
+
+  std::string toString() const;
+
+  /// The files with the most cached bytes, the largest first.
+  std::vector<File> topFiles;
+
+  /// Pairs of file group id and cached bytes, the largest first. A file
+  /// counts towards the group of its RAM entries. Files with entries only on
+  /// SSD are not in any group.
+  std::vector<std::pair<uint64_t, uint64_t>> groupBytes;
+
+  /// Bloom filter of the pathHash() of all cached files.
+  BloomFilter<> fileFilter;
+
+  int64_t numFiles{0};
+  uint64_t ramBytes{0};
+  uint64_t ssdBytes{0};
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheTiering.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::cache {
+
+IoBudget::IoBudget(int64_t bytesPerSec)
+    : bytesPerSec_(bytesPerSec),
+      available_(bytesPerSec),
+      lastRefill_(Clock::now()) {
+  VELOX_CHECK_GE(bytesPerSec_, 0);
+}
+
+bool IoBudget::tryAcquire(int64_t bytes) {
+  if (bytesPerSec_ == kUnlimited) {
+    return true;
+  }
+  if (bytesPerSec_ == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto now = Clock::now();
+  const std::chrono::duration<double> elapsed = now - lastRefill_;
+  lastRefill_ = now;
+  available_ = std::min<double>(
+      bytesPerSec_, available_ + elapsed.count() * bytesPerSec_);
+  // An acquire larger than the whole budget goes through when the budget is
+  // full and leaves it in debt.
+  if (available_ < std::min(bytes, bytesPerSec_)) {
+    return false;
+  }
+  available_ -= bytes;
+  return true;
+}
+
+namespace {
+std::string rateToString(int64_t bytesPerSec) {
+  return bytesPerSec == IoBudget::kUnlimited
+      ? "unlimited"
+      : fmt::format("{}/s", succinctBytes(bytesPerSec));
+}
+} // namespace
+
+std::string CacheTieringOptions::toString() const {
+  return fmt::format(
+      "promotion: {} demotion: {}",
+      rateToString(promotionBytesPerSec),
+      rateToString(demotionBytesPerSec));
+}
+
+} // namespace facebook::velox::cache
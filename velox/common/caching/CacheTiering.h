@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+
+namespace facebook::velox::cache {
+
+/// Limits the bytes moved between cache tiers to 'bytesPerSec'. The budget
+/// refills continuously and accumulates up to one second worth of bytes.
+/// Thread safe.
+class IoBudget {
+ public:
+  static constexpr int64_t kUnlimited = std::numeric_limits<int64_t>::max();
+
+  explicit IoBudget(int64_t bytesPerSec);
+
+  /// Takes 'bytes' from the budget. Returns false and takes nothing if the
+  /// budget has less than 'bytes' left. More than one second worth of bytes
+  /// can be taken from a full budget.
+  bool tryAcquire(int64_t bytes);
+
+  int64_t bytesPerSec() const {
+    return bytesPerSec_;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  const int64_t bytesPerSec_;
+
+  std::mutex mutex_;
+  double available_;
+  Clock::time_point lastRefill_;
+};
+
+/// Controls the movement of entries between the RAM tier of AsyncDataCache
+/// and its SsdCache.
+///
+/// Promotion: an entry read from SSD takes RAM like any new entry and is
+/// retained by the admission policy of the cache, which sees the accesses of
+/// both tiers. Promotion is limited to 'promotionBytesPerSec'. Entries read
+/// from SSD past the budget are used by their reader and are the first to go
+/// when the cache evicts.
+///
+/// Demotion: an entry that qualifies for SSD and is not yet saved is written
+/// to SSD in the background when it is chosen for eviction, instead of being
+/// dropped. It is evicted once written. Demotion is limited to
+/// 'demotionBytesPerSec'. Entries chosen past the budget are dropped as
+/// before.
+struct CacheTieringOptions {
+  int64_t promotionBytesPerSec{IoBudget::kUnlimited};
+  int64_t demotionBytesPerSec{0};
+
+  std::string toString() const;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+namespace facebook::velox::cache {
+
+void FileGroupStats::recordReference(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    uint64_t bytes,
+    int32_t loadQuantum) {
+  std::lock_guard<std::mutex> l(mutex_);
+  const Key key{groupId, trackingId.id()};
+  auto it = data_.find(key);
+  if (it == data_.end()) {
+    if (data_.size() >= kMaxTracked) {
+      ageLocked();
+      if (data_.size() >= kMaxTracked) {
+        return;
+      }
+    }
+    it = data_.emplace(key, TrackingData{}).first;
+  }
+  it->second.incrementReference(bytes, loadQuantum);
+  if (++numReferences_ >= kAgingReferences) {
+    ageLocked();
+  }
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = data_.find(Key{groupId, trackingId.id()});
+  if (it != data_.end()) {
+    it->second.incrementRead(bytes);
+  }
+}
+
+TrackingData FileGroupStats::trackingData(
+    uint64_t groupId,
+    TrackingId trackingId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = data_.find(Key{groupId, trackingId.id()});
+  return it == data_.end() ? TrackingData{} : it->second;
+}
+
+void FileGroupStats::ageLocked() {
+  auto it = data_.begin();
+  while (it != data_.end()) {
+    auto& data = it->second;
+    data.referencedBytes /= 2;
+    data.readBytes /= 2;
+    data.numReferences /= 2;
+    data.numReads /= 2;
+    if (data.numReferences == 0) {
+      it = data_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  numReferences_ = 0;
+}
+
+} // namespace facebook::velox::cache
@@ -16,26 +16,53 @@
 
 #pragma once
 
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+// Access statistics of file groups, e.g. partitions. The reads of each stream
+// of each group are tracked across scans, so that a scan can predict which
+// columns it will read before it has read any. The SSD admission part is a
+// dummy implementation.
 class FileGroupStats {
  public:
-  // Records ScanTracker::recordReference at group level
+  // Maximum number of tracked streams. Past this, the least referenced are
+  // dropped.
+  static constexpr int32_t kMaxTracked = 1 << 16;
+
+  // Number of references after which the counts are halved, so that the
+  // statistics follow changes in the workload.
+  static constexpr int64_t kAgingReferences = 1 << 22;
+
+  // Records ScanTracker::recordReference at group level. 'loadQuantum' is as
+  // in TrackingData::incrementReference.
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      uint64_t bytes,
+      int32_t loadQuantum);
 
   // Records ScanTracker::recordRead at group level
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      uint64_t bytes);
+
+  // Returns the references and reads of 'trackingId' in 'groupId' over the
+  // scans that reported to 'this'.
+  TrackingData trackingData(uint64_t groupId, TrackingId trackingId) const;
+
+  // Returns the number of tracked streams.
+  int32_t numTracked() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return data_.size();
+  }
 
   // Records the existence of a distinct file inside 'groupId'
   void recordFile(
@@ -58,6 +85,17 @@ class FileGroupStats {
   std::string toString(uint64_t /*cacheBytes*/) {
     return "<dummy FileGroupStats>";
   }
+
+ private:
+  using Key = std::pair<uint64_t, int32_t>;
+
+  // Halves the counts and drops the streams that are no longer referenced.
+  void ageLocked();
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<Key, TrackingData> data_;
+  // References since the last aging.
+  int64_t numReferences_{0};
 };
 
 } // namespace facebook::velox::cache
@@ -29,7 +29,7 @@ void ScanTracker::recordReference(
     uint64_t fileId,
     uint64_t groupId) {
   if (fileGroupStats_) {
-    fileGroupStats_->recordReference(fileId, groupId, id, bytes);
+    fileGroupStats_->recordReference(fileId, groupId, id, bytes, loadQuantum_);
   }
   std::lock_guard<std::mutex> l(mutex_);
   data_[id].incrementReference(bytes, loadQuantum_);
@@ -16,6 +16,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
@@ -160,6 +161,48 @@ bool SsdCache::removeFileEntries(
   return success;
 }
 
+uint64_t SsdCache::reserveSpace(uint64_t bytes) {
+  const int32_t numRegions =
+      bits::roundUp(bytes, SsdFile::kRegionSize) / SsdFile::kRegionSize;
+  const int32_t regionsPerShard =
+      bits::roundUp(numRegions, numShards_) / numShards_;
+  int32_t numLent = 0;
+  for (auto i = 0; i < numShards_ && numLent < numRegions; ++i) {
+    numLent += files_[i]->lendRegions(
+        std::min<int32_t>(regionsPerShard, numRegions - numLent));
+  }
+  // Takes the rest from the shards that have more to give.
+  for (auto i = 0; i < numShards_ && numLent < numRegions; ++i) {
+    numLent += files_[i]->lendRegions(numRegions - numLent);
+  }
+  return numLent * SsdFile::kRegionSize;
+}
+
+void SsdCache::releaseSpace(uint64_t bytes) {
+  VELOX_CHECK_EQ(bytes % SsdFile::kRegionSize, 0);
+  int32_t numRegions = bytes / SsdFile::kRegionSize;
+  for (auto i = 0; i < numShards_ && numRegions > 0; ++i) {
+    numRegions -= files_[i]->returnRegions(numRegions);
+  }
+  VELOX_CHECK_EQ(
+      numRegions, 0, "Released more SSD cache space than was reserved");
+}
+
+uint64_t SsdCache::reservedBytes() const {
+  uint64_t numRegions = 0;
+  for (auto& file : files_) {
+    numRegions += file->numLentRegions();
+  }
+  return numRegions * SsdFile::kRegionSize;
+}
+
+void SsdCache::appendFileBytes(
+    folly::F14FastMap<uint64_t, CachedFileBytes>& files) const {
+  for (auto& file : files_) {
+    file->appendFileBytes(files);
+  }
+}
+
 SsdCacheStats SsdCache::stats() const {
   SsdCacheStats stats;
   for (auto& file : files_) {
@@ -72,6 +72,21 @@ class SsdCache {
   /// have returned true.
   void write(std::vector<CachePin> pins);
 
+  /// Takes up to 'bytes' of the cache capacity out of the cache for other
+  /// users of the same devices, e.g. spill, so that the devices need not be
+  /// statically partitioned between the two. The space is taken in
+  /// SsdFile::kRegionSize units spread over the shards, evicting cached
+  /// entries if the shards are full. Returns the number of bytes taken, which
+  /// is 'bytes' rounded up to whole regions or less if the cache cannot give
+  /// up enough space.
+  uint64_t reserveSpace(uint64_t bytes);
+
+  /// Gives back 'bytes' taken by reserveSpace().
+  void releaseSpace(uint64_t bytes);
+
+  /// Returns the number of bytes currently taken by reserveSpace().
+  uint64_t reservedBytes() const;
+
   /// Removes cached entries from all SsdFiles for files in the fileNum set
   /// 'filesToRemove'. If successful, return true, and 'filesRetained' contains
   /// entries that should not be removed, ex., from pinned regions. Otherwise,
@@ -80,6 +95,10 @@ class SsdCache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the bytes of the cached entries to 'files', keyed on file id.
+  void appendFileBytes(
+      folly::F14FastMap<uint64_t, CachedFileBytes>& files) const;
+
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
@@ -17,12 +17,19 @@
 #include "velox/common/caching/SsdFile.h"
 
 #include <folly/Executor.h>
+#include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
+#include <folly/hash/Checksum.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -31,8 +38,10 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <filesystem>
 #include <fstream>
 #include <numeric>
+#include <sstream>
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
@@ -63,6 +72,16 @@ void disableCow(int32_t fd) {
 #endif // linux
 }
 
+template <typename T>
+inline char* asChar(T ptr) {
+  return reinterpret_cast<char*>(ptr);
+}
+
+template <typename T>
+inline const char* asChar(const T* ptr) {
+  return reinterpret_cast<const char*>(ptr);
+}
+
 void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
   if (entry.tinyData() != nullptr) {
     iovecs.push_back({entry.tinyData(), static_cast<size_t>(entry.size())});
@@ -81,6 +100,174 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+// Returns the CRC32C of the data of 'entry'.
+uint32_t entryChecksum(AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return folly::crc32c(
+        reinterpret_cast<const uint8_t*>(entry.tinyData()), entry.size());
+  }
+  const auto& data = entry.data();
+  uint32_t checksum = ~0U;
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    checksum = folly::crc32c(run.data<uint8_t>(), size, checksum);
+    bytesLeft -= size;
+  }
+  return checksum;
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+  out.append(asChar(&value), sizeof(T));
+}
+
+// Size of the tag, size and checksum of a section.
+constexpr size_t kSectionOverhead = 3 * sizeof(uint32_t);
+
+// Checkpoint and log files consist of sections of {uint32_t tag, uint32_t
+// size, 'size' bytes of payload, uint32_t CRC32C of the tag, size and
+// payload}.
+template <typename Tag>
+void appendSection(std::string& out, Tag tag, std::string_view payload) {
+  const auto begin = out.size();
+  appendNumber<uint32_t>(out, static_cast<uint32_t>(tag));
+  appendNumber<uint32_t>(out, payload.size());
+  out.append(payload);
+  appendNumber<uint32_t>(
+      out,
+      folly::crc32c(
+          reinterpret_cast<const uint8_t*>(out.data() + begin),
+          out.size() - begin));
+}
+
+// Appends the number and the name of a file to a kFiles section payload.
+void appendFileName(std::string& out, uint64_t fileNum) {
+  appendNumber(out, fileNum);
+  const auto name = fileIds().string(fileNum);
+  appendNumber<int32_t>(out, name.size());
+  out.append(name);
+}
+
+// Appends an entry to a kEntries section payload.
+void appendEntry(
+    std::string& out,
+    uint64_t fileNum,
+    uint64_t offset,
+    const SsdRun& run) {
+  appendNumber(out, fileNum);
+  appendNumber(out, offset);
+  appendNumber(out, run.bits());
+  appendNumber(out, run.checksum());
+}
+
+// Reads the sections written by appendSection().
+class SectionReader {
+ public:
+  enum class Result { kOk, kEnd, kTruncated, kCorrupt };
+
+  explicit SectionReader(std::string_view data) : data_(data) {}
+
+  // Reads the next section into 'tag' and 'payload'. A section with a bad
+  // checksum is skipped. Nothing can be read after a truncated section.
+  Result next(uint32_t& tag, std::string_view& payload) {
+    if (position_ == data_.size()) {
+      return Result::kEnd;
+    }
+    const auto* begin = data_.data() + position_;
+    const auto available = data_.size() - position_;
+    if (available < kSectionOverhead) {
+      return Result::kTruncated;
+    }
+    uint32_t size;
+    ::memcpy(&tag, begin, sizeof(tag));
+    ::memcpy(&size, begin + sizeof(tag), sizeof(size));
+    if (available - kSectionOverhead < size) {
+      return Result::kTruncated;
+    }
+    const auto checkedSize = 2 * sizeof(uint32_t) + size;
+    uint32_t checksum;
+    ::memcpy(&checksum, begin + checkedSize, sizeof(checksum));
+    position_ += kSectionOverhead + size;
+    if (folly::crc32c(reinterpret_cast<const uint8_t*>(begin), checkedSize) !=
+        checksum) {
+      return Result::kCorrupt;
+    }
+    payload = std::string_view(begin + 2 * sizeof(uint32_t), size);
+    return Result::kOk;
+  }
+
+  // Returns the number of bytes of the sections read so far.
+  size_t position() const {
+    return position_;
+  }
+
+ private:
+  const std::string_view data_;
+  size_t position_{0};
+};
+
+// Reads the fields of a section payload.
+class PayloadReader {
+ public:
+  explicit PayloadReader(std::string_view data) : data_(data) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    ::memcpy(&value, readBytes(sizeof(T)).data(), sizeof(T));
+    return value;
+  }
+
+  std::string_view readBytes(size_t size) {
+    VELOX_CHECK_LE(size, data_.size() - position_, "Truncated section");
+    const auto bytes = data_.substr(position_, size);
+    position_ += size;
+    return bytes;
+  }
+
+  bool atEnd() const {
+    return position_ == data_.size();
+  }
+
+ private:
+  const std::string_view data_;
+  size_t position_{0};
+};
+
+// Reads the {fileNum, name} pairs of a kFiles section into 'idMap'.
+void readFileNames(
+    std::string_view payload,
+    std::unordered_map<uint64_t, StringIdLease>& idMap) {
+  PayloadReader reader(payload);
+  while (!reader.atEnd()) {
+    const auto fileNum = reader.read<uint64_t>();
+    const auto name = reader.readBytes(reader.read<int32_t>());
+    // The file may have a different id on restore.
+    idMap[fileNum] = StringIdLease(fileIds(), name);
+  }
+}
+
+// Calls 'func' with the key and the run of each remaining entry of 'reader'.
+template <typename Func>
+void forEachEntry(
+    PayloadReader& reader,
+    const std::unordered_map<uint64_t, StringIdLease>& idMap,
+    Func func) {
+  while (!reader.atEnd()) {
+    const auto fileNum = reader.read<uint64_t>();
+    const auto offset = reader.read<uint64_t>();
+    const auto bits = reader.read<uint64_t>();
+    const auto checksum = reader.read<uint32_t>();
+    const auto it = idMap.find(fileNum);
+    VELOX_CHECK(it != idMap.end(), "Entry of unnamed file {}", fileNum);
+    func(
+        FileCacheKey{it->second, offset},
+        SsdRun::deserialize(bits, checksum));
+  }
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -166,6 +353,7 @@ SsdFile::SsdFile(
   regionSizes_.resize(maxRegions_, 0);
   erasedRegionSizes_.resize(maxRegions_, 0);
   regionPins_.resize(maxRegions_, 0);
+  unverifiedRegions_.resize(maxRegions_, false);
   if (checkpointEnabled()) {
     initializeCheckpoint();
   }
@@ -239,6 +427,11 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
+  // With io_uring, the coalesced reads are collected and submitted together.
+  auto* ioUring = IoUring::instance();
+  std::vector<IoUring::Request> requests;
+  const auto readStartMicros = getCurrentTimeMicro();
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
@@ -255,11 +448,74 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (ioUring != nullptr) {
+          IoUring::appendReads(fd_, offset, buffers, requests);
+        } else {
+          read(offset, buffers);
+        }
       });
+  if (!requests.empty()) {
+    process::TraceContext trace("SsdFile::read");
+    std::vector<uint64_t> requestBytes;
+    requestBytes.reserve(requests.size());
+    for (const auto& request : requests) {
+      uint64_t bytes = 0;
+      for (const auto& iov : request.iovecs) {
+        bytes += iov.iov_len;
+      }
+      requestBytes.push_back(bytes);
+    }
+    auto results =
+        folly::collectAll(ioUring->submit(std::move(requests))).get();
+    for (auto i = 0; i < results.size(); ++i) {
+      if (results[i].hasException()) {
+        ++stats_.readSsdErrors;
+        results[i].throwIfFailed();
+      }
+      // IoUring resubmits short reads, so a short result is the end of the
+      // file.
+      if (FOLLY_UNLIKELY(results[i].value() != requestBytes[i])) {
+        ++stats_.readSsdErrors;
+        VELOX_FAIL(
+            "IOERR: Short read from SSD cache file {}: {} of {} bytes",
+            fileName_,
+            results[i].value(),
+            requestBytes[i]);
+      }
+    }
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricSsdCacheReadLatencyUs, getCurrentTimeMicro() - readStartMicros);
+
+  // Entries recovered at startup are checked on first read since their data
+  // may not have reached the disk before a crash.
+  std::vector<int32_t> toVerify;
+  {
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    for (auto i = 0; i < ssdPins.size(); ++i) {
+      const auto run = ssdPins[i].run();
+      if (unverifiedRegions_[regionIndex(run.offset())] &&
+          run.size() == pins[i].checkedEntry()->size()) {
+        toVerify.push_back(i);
+      }
+    }
+  }
+  for (const auto i : toVerify) {
+    const auto run = ssdPins[i].run();
+    if (entryChecksum(*pins[i].checkedEntry()) != run.checksum()) {
+      {
+        std::lock_guard<std::shared_mutex> l(mutex_);
+        invalidateRegionLocked(regionIndex(run.offset()));
+      }
+      ++stats_.readSsdErrors;
+      VELOX_FAIL(
+          "IOERR: SSD cache entry at offset {} does not match its checksum",
+          run.offset());
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
-    pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
+    pins[i].checkedEntry()->setLoadedFromSsd(this, ssdPins[i].run().offset());
   }
   return stats;
 }
@@ -273,7 +529,8 @@ void SsdFile::read(
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const std::vector<CachePin>& pins,
-    int32_t begin) {
+    int32_t begin,
+    bool pinSpace) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
   for (;;) {
@@ -299,6 +556,9 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
       // At least some pins got space from this region. If the region is full
       // the next call will get space from another region.
       regionSizes_[region] += toWrite;
+      if (pinSpace) {
+        pinRegionLocked(region * kRegionSize);
+      }
       return std::make_pair<uint64_t, int32_t>(
           region * kRegionSize + offset, toWrite);
     }
@@ -310,7 +570,7 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
 
 bool SsdFile::growOrEvictLocked() {
   process::TraceContext trace("SsdFile::growOrEvictLocked");
-  if (numRegions_ < maxRegions_) {
+  if (numRegions_ < maxRegions_ - numLentGrowth_) {
     const auto newSize = (numRegions_ + 1) * kRegionSize;
     const auto rc = ::ftruncate(fd_, newSize);
     if (rc >= 0) {
@@ -360,9 +620,30 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
     tracker_.regionCleared(region);
     regionSizes_[region] = 0;
     erasedRegionSizes_[region] = 0;
+    unverifiedRegions_[region] = false;
   }
 }
 
+void SsdFile::invalidateRegionLocked(int32_t region) {
+  if (!unverifiedRegions_[region]) {
+    // Another reader has already invalidated the region.
+    return;
+  }
+  unverifiedRegions_[region] = false;
+  auto it = entries_.begin();
+  while (it != entries_.end()) {
+    if (regionIndex(it->second.offset()) == region) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // The region may be pinned by other readers, so it is not made writable
+  // here. All of its space counts as erased.
+  erasedRegionSizes_[region] = regionSizes_[region];
+  logEviction({region});
+}
+
 void SsdFile::write(std::vector<CachePin>& pins) {
   process::TraceContext trace("SsdFile::write");
   // Sorts the pins by their file/offset. In this way what is adjacent in
@@ -373,66 +654,143 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The pins written with one pwritev into the space of one region.
+  struct WriteRun {
+    int32_t begin;
+    int32_t numWritten{0};
+    uint64_t offset;
+    int32_t bytes{0};
+    std::vector<iovec> iovecs;
+  };
+
+  // Adds the pins of 'run' to the cache.
+  auto addWrittenRun = [&](const WriteRun& run) {
+    // With checkpointing, the entries carry checksums so that the entries
+    // recovered after a restart can be verified.
+    std::vector<uint32_t> checksums;
+    if (checkpointEnabled()) {
+      checksums.reserve(run.numWritten);
+      for (auto i = run.begin; i < run.begin + run.numWritten; ++i) {
+        checksums.push_back(entryChecksum(*pins[i].checkedEntry()));
+      }
+    }
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    std::vector<std::pair<FileCacheKey, SsdRun>> written;
+    written.reserve(run.numWritten);
+    auto offset = run.offset;
+    for (auto i = run.begin; i < run.begin + run.numWritten; ++i) {
+      auto* entry = pins[i].checkedEntry();
+      VELOX_CHECK_NULL(entry->ssdFile());
+      entry->setSsdFile(this, offset);
+      const auto size = entry->size();
+      FileCacheKey key = {
+          entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+      const SsdRun ssdRun(
+          offset, size, checksums.empty() ? 0 : checksums[i - run.begin]);
+      entries_[key] = ssdRun;
+      written.emplace_back(std::move(key), ssdRun);
+      if (FLAGS_ssd_verify_write) {
+        verifyWrite(*entry, ssdRun);
+      }
+      offset += size;
+      ++stats_.entriesWritten;
+      stats_.bytesWritten += size;
+      bytesAfterCheckpoint_ += size;
+    }
+    logEntriesLocked(written);
+  };
+
+  auto writeFailed = [&](const WriteRun& run, const std::string& error) {
+    VELOX_SSD_CACHE_LOG(ERROR)
+        << "Failed to write to SSD, file name: " << fileName_
+        << ", fd: " << fd_ << ", size: " << run.iovecs.size()
+        << ", offset: " << run.offset << ", error: " << error;
+    ++stats_.writeSsdErrors;
+  };
+
+  // With io_uring, the space for all the pins is assigned first and the
+  // writes of all the regions are submitted together.
+  auto* ioUring = IoUring::instance();
+  std::vector<WriteRun> pendingRuns;
+  bool dropped = false;
   int32_t storeIndex = 0;
+  // The regions of 'pendingRuns' are pinned until their writes complete.
+  auto unpinPendingRuns = folly::makeGuard([&]() {
+    for (const auto& run : pendingRuns) {
+      unpinRegion(run.offset);
+    }
+  });
   while (storeIndex < pins.size()) {
-    auto space = getSpace(pins, storeIndex);
+    auto space = getSpace(pins, storeIndex, ioUring != nullptr);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
-      return;
+      dropped = true;
+      break;
     }
 
     auto [offset, available] = space.value();
-    int32_t numWritten = 0;
-    int32_t bytes = 0;
-    std::vector<iovec> iovecs;
+    WriteRun run{storeIndex};
+    run.offset = offset;
     for (auto i = storeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
       const auto entrySize = entry->size();
-      if (bytes + entrySize > available) {
+      if (run.bytes + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, iovecs);
-      bytes += entrySize;
-      ++numWritten;
-    }
-    VELOX_CHECK_GE(fileSize_, offset + bytes);
-
-    const auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
-    if (rc != bytes) {
-      VELOX_SSD_CACHE_LOG(ERROR)
-          << "Failed to write to SSD, file name: " << fileName_
-          << ", fd: " << fd_ << ", size: " << iovecs.size()
-          << ", offset: " << offset << ", error code: " << errno
-          << ", error string: " << folly::errnoStr(errno);
-      ++stats_.writeSsdErrors;
+      addEntryToIovecs(*entry, run.iovecs);
+      run.bytes += entrySize;
+      ++run.numWritten;
+    }
+    VELOX_CHECK_GE(fileSize_, offset + run.bytes);
+    storeIndex += run.numWritten;
+
+    if (ioUring != nullptr) {
+      pendingRuns.push_back(std::move(run));
+      continue;
+    }
+    const auto rc =
+        folly::pwritev(fd_, run.iovecs.data(), run.iovecs.size(), offset);
+    if (rc != run.bytes) {
+      writeFailed(
+          run,
+          fmt::format("error code: {}, {}", errno, folly::errnoStr(errno)));
       // If write fails, we return without adding the pins to the cache. The
       // entries are unchanged.
       return;
     }
+    addWrittenRun(run);
+  }
 
-    {
-      std::lock_guard<std::shared_mutex> l(mutex_);
-      for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
-        auto* entry = pins[i].checkedEntry();
-        VELOX_CHECK_NULL(entry->ssdFile());
-        entry->setSsdFile(this, offset);
-        const auto size = entry->size();
-        FileCacheKey key = {
-            entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
-        if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
-        }
-        offset += size;
-        ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
+  if (!pendingRuns.empty()) {
+    process::TraceContext trace("SsdFile::write io_uring");
+    std::vector<IoUring::Request> requests;
+    requests.reserve(pendingRuns.size());
+    for (const auto& run : pendingRuns) {
+      requests.push_back({fd_, true, run.offset, run.iovecs});
+    }
+    auto results =
+        folly::collectAll(ioUring->submit(std::move(requests))).get();
+    // Failed runs are not added to the cache, their entries are unchanged.
+    for (auto i = 0; i < pendingRuns.size(); ++i) {
+      const auto& run = pendingRuns[i];
+      if (results[i].hasException()) {
+        writeFailed(run, results[i].exception().what().toStdString());
+      } else if (results[i].value() != run.bytes) {
+        writeFailed(run, fmt::format("wrote {} bytes", results[i].value()));
+      } else {
+        addWrittenRun(run);
       }
     }
-    storeIndex += numWritten;
+    unpinPendingRuns.dismiss();
+    for (const auto& run : pendingRuns) {
+      unpinRegion(run.offset);
+    }
   }
 
+  if (dropped) {
+    return;
+  }
   if (checkpointEnabled()) {
     checkpoint();
   }
@@ -477,6 +835,16 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+void SsdFile::appendFileBytes(
+    folly::F14FastMap<uint64_t, CachedFileBytes>& files) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    if (key.fileNum.hasValue()) {
+      files[key.fileNum.id()].ssdBytes += run.size();
+    }
+  }
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // semantics.
@@ -498,6 +866,8 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   for (auto pins : regionPins_) {
     stats.numPins += pins;
   }
+  // Lent regions are pinned but not used by readers.
+  stats.numPins -= lentRegions_.size() + numLentGrowth_;
 
   stats.openFileErrors += stats_.openFileErrors;
   stats.openCheckpointErrors += stats_.openCheckpointErrors;
@@ -515,8 +885,14 @@ void SsdFile::testingClear() {
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
-  writableRegions_.resize(numRegions_);
-  std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
+  std::fill(unverifiedRegions_.begin(), unverifiedRegions_.end(), false);
+  writableRegions_.clear();
+  for (auto region = 0; region < numRegions_; ++region) {
+    if (std::find(lentRegions_.begin(), lentRegions_.end(), region) ==
+        lentRegions_.end()) {
+      writableRegions_.push_back(region);
+    }
+  }
   tracker_.testingClear();
 }
 
@@ -533,6 +909,78 @@ void SsdFile::testingDeleteFile() {
   }
 }
 
+int32_t SsdFile::lendRegions(int32_t numRegions) {
+  VELOX_CHECK_GE(numRegions, 0);
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  int32_t numLent = 0;
+  while (numLent < numRegions && numRegions_ < maxRegions_ - numLentGrowth_) {
+    ++numLentGrowth_;
+    ++regionPins_[maxRegions_ - numLentGrowth_];
+    ++numLent;
+  }
+  if (numLent == numRegions) {
+    return numLent;
+  }
+
+  // Regions being written are not lent since writes to them may be in
+  // progress outside of 'mutex_'.
+  auto pins = regionPins_;
+  for (const auto region : writableRegions_) {
+    ++pins[region];
+  }
+  const auto candidates =
+      tracker_.findEvictionCandidates(numRegions - numLent, numRegions_, pins);
+  if (candidates.empty()) {
+    return numLent;
+  }
+  logEviction(candidates);
+  clearRegionEntriesLocked(candidates);
+  stats_.regionsEvicted += candidates.size();
+  for (const auto region : candidates) {
+    ++regionPins_[region];
+    lentRegions_.push_back(region);
+#ifdef linux
+    const auto rc = ::fallocate(
+        fd_,
+        FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+        region * kRegionSize,
+        kRegionSize);
+    if (rc < 0) {
+      VELOX_SSD_CACHE_LOG(WARNING)
+          << "Failed to free the space of lent region " << region << " of "
+          << fileName_ << ": " << folly::errnoStr(errno);
+    }
+#endif // linux
+  }
+  return numLent + candidates.size();
+}
+
+int32_t SsdFile::returnRegions(int32_t numRegions) {
+  VELOX_CHECK_GE(numRegions, 0);
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  int32_t numReturned = 0;
+  while (numReturned < numRegions && !lentRegions_.empty()) {
+    const auto region = lentRegions_.back();
+    lentRegions_.pop_back();
+    --regionPins_[region];
+    writableRegions_.push_back(region);
+    ++numReturned;
+  }
+  while (numReturned < numRegions && numLentGrowth_ > 0) {
+    --regionPins_[maxRegions_ - numLentGrowth_];
+    --numLentGrowth_;
+    ++numReturned;
+  }
+  if (suspended_ && numReturned > 0) {
+    if (writableRegions_.empty()) {
+      growOrEvictLocked();
+    } else {
+      suspended_ = false;
+    }
+  }
+  return numReturned;
+}
+
 bool SsdFile::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -612,11 +1060,55 @@ bool SsdFile::removeFileEntries(
 
 void SsdFile::logEviction(const std::vector<int32_t>& regions) {
   if (checkpointEnabled()) {
-    const int32_t rc = ::write(
-        evictLogFd_, regions.data(), regions.size() * sizeof(regions[0]));
-    if (rc != regions.size() * sizeof(regions[0])) {
-      checkpointError(rc, "Failed to log eviction");
+    auto records = newLogRecordsLocked();
+    std::string payload;
+    for (const auto region : regions) {
+      appendNumber(payload, region);
+    }
+    appendSection(records, SectionTag::kEviction, payload);
+    writeLog(records);
+  }
+}
+
+void SsdFile::logEntriesLocked(
+    const std::vector<std::pair<FileCacheKey, SsdRun>>& entries) {
+  if (!checkpointEnabled() || entries.empty()) {
+    return;
+  }
+  auto records = newLogRecordsLocked();
+  std::string files;
+  std::string payload;
+  for (const auto& [key, run] : entries) {
+    const auto fileNum = key.fileNum.id();
+    if (loggedFileNums_.insert(fileNum).second) {
+      appendFileName(files, fileNum);
     }
+    appendEntry(payload, fileNum, key.offset, run);
+  }
+  if (!files.empty()) {
+    appendSection(records, SectionTag::kFiles, files);
+  }
+  appendSection(records, SectionTag::kEntries, payload);
+  writeLog(records);
+}
+
+std::string SsdFile::newLogRecordsLocked() {
+  std::string records;
+  if (logSegmentPending_) {
+    // File numbers are only valid in the segment that names them.
+    loggedFileNums_.clear();
+    std::string payload;
+    appendNumber(payload, checkpointSequence_);
+    appendSection(records, SectionTag::kHeader, payload);
+    logSegmentPending_ = false;
+  }
+  return records;
+}
+
+void SsdFile::writeLog(const std::string& records) {
+  const auto rc = ::write(evictLogFd_, records.data(), records.size());
+  if (rc != records.size()) {
+    checkpointError(rc, "Failed to write SSD cache log");
   }
 }
 
@@ -636,6 +1128,8 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
   }
 
   checkpointDeleted_ = true;
+  checkpointSequence_ = 0;
+  logSegmentPending_ = true;
   const auto logPath = getEvictLogFilePath();
   int32_t logRc = 0;
   if (!keepLog) {
@@ -659,18 +1153,6 @@ void SsdFile::checkpointError(int32_t rc, const std::string& error) {
   checkpointIntervalBytes_ = 0;
 }
 
-namespace {
-template <typename T>
-inline char* asChar(T ptr) {
-  return reinterpret_cast<char*>(ptr);
-}
-
-template <typename T>
-inline const char* asChar(const T* ptr) {
-  return reinterpret_cast<const char*>(ptr);
-}
-} // namespace
-
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -694,6 +1176,52 @@ void SsdFile::checkpoint(bool force) {
       return rc;
     };
 
+    // The checkpoint replaces the previous one only when complete, so that a
+    // crash while checkpointing leaves the previous checkpoint and its log
+    // usable. The checkpoint file contains the 4 bytes of kCheckpointMagic
+    // followed by the sections:
+    // kHeader: int32_t maxRegions, int32_t numRegions, uint64_t sequence,
+    // regionScores from the 'tracker_',
+    // kFiles: {fileNum, fileName} pairs,
+    // kEntries: int32_t region, {fileNum, offset, SsdRun bits, checksum}
+    // for each region with entries,
+    // kEnd: uint64_t number of entries.
+    const auto sequence = checkpointSequence_ + 1;
+    std::string state(kCheckpointMagic, sizeof(int32_t));
+    std::string payload;
+    appendNumber(payload, maxRegions_);
+    appendNumber(payload, numRegions_);
+    appendNumber(payload, sequence);
+    // Copy the region scores before writing out for tsan.
+    const auto scoresCopy = tracker_.copyScores();
+    payload.append(asChar(scoresCopy.data()), maxRegions_ * sizeof(double));
+    appendSection(state, SectionTag::kHeader, payload);
+
+    payload.clear();
+    std::unordered_set<uint64_t> fileNums;
+    std::vector<std::string> regionEntries(numRegions_);
+    for (const auto& [key, run] : entries_) {
+      const auto fileNum = key.fileNum.id();
+      if (fileNums.insert(fileNum).second) {
+        appendFileName(payload, fileNum);
+      }
+      appendEntry(
+          regionEntries[regionIndex(run.offset())], fileNum, key.offset, run);
+    }
+    appendSection(state, SectionTag::kFiles, payload);
+    for (int32_t region = 0; region < numRegions_; ++region) {
+      if (regionEntries[region].empty()) {
+        continue;
+      }
+      payload.clear();
+      appendNumber(payload, region);
+      payload.append(regionEntries[region]);
+      appendSection(state, SectionTag::kEntries, payload);
+    }
+    payload.clear();
+    appendNumber<uint64_t>(payload, entries_.size());
+    appendSection(state, SectionTag::kEnd, payload);
+
     // We schedule the potentially long fsync of the cache file on another
     // thread of the cache write executor, if available. If there is none, we do
     // the sync on this thread at the end.
@@ -703,88 +1231,64 @@ void SsdFile::checkpoint(bool force) {
       executor_->add([fileSync]() { fileSync->prepare(); });
     }
 
-    std::ofstream state;
-    const auto checkpointPath = getCheckpointFilePath();
+    const auto tempPath = getTempCheckpointFilePath();
+    int32_t checkpointFd = -1;
     try {
-      state.exceptions(std::ofstream::failbit);
-      state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
-      // The checkpoint state file contains:
-      // int32_t The 4 bytes of kCheckpointMagic,
-      // int32_t maxRegions,
-      // int32_t numRegions,
-      // regionScores from the 'tracker_',
-      // {fileId, fileName} pairs,
-      // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
-      // kEndMarker.
-      state.write(kCheckpointMagic, sizeof(int32_t));
-      state.write(asChar(&maxRegions_), sizeof(maxRegions_));
-      state.write(asChar(&numRegions_), sizeof(numRegions_));
-
-      // Copy the region scores before writing out for tsan.
-      const auto scoresCopy = tracker_.copyScores();
-      state.write(asChar(scoresCopy.data()), maxRegions_ * sizeof(uint64_t));
-      std::unordered_set<uint64_t> fileNums;
-      for (const auto& entry : entries_) {
-        const auto fileNum = entry.first.fileNum.id();
-        if (fileNums.insert(fileNum).second) {
-          state.write(asChar(&fileNum), sizeof(fileNum));
-          const auto name = fileIds().string(fileNum);
-          const int32_t length = name.size();
-          state.write(asChar(&length), sizeof(length));
-          state.write(name.data(), length);
-        }
+      checkpointFd = checkRc(
+          ::open(
+              tempPath.c_str(),
+              O_CREAT | O_WRONLY | O_TRUNC,
+              S_IRUSR | S_IWUSR),
+          "Open of checkpoint file");
+      // TODO: add this as file open option after we migrate to use velox
+      // filesystem for ssd file access.
+      if (disableFileCow_) {
+        disableCow(checkpointFd);
       }
-
-      const auto mapMarker = kCheckpointMapMarker;
-      state.write(asChar(&mapMarker), sizeof(mapMarker));
-      for (auto& pair : entries_) {
-        auto id = pair.first.fileNum.id();
-        state.write(asChar(&id), sizeof(id));
-        state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
-        auto offsetAndSize = pair.second.bits();
-        state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      if (folly::writeFull(checkpointFd, state.data(), state.size()) !=
+          static_cast<ssize_t>(state.size())) {
+        ++stats_.writeCheckpointErrors;
+        checkRc(-1, "Write of checkpoint file");
       }
+      checkRc(::fsync(checkpointFd), "Sync of checkpoint file");
+      ::close(checkpointFd);
     } catch (const std::exception& e) {
+      if (checkpointFd >= 0) {
+        ::close(checkpointFd);
+      }
       fileSync->close();
       std::rethrow_exception(std::current_exception());
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
-    // updating checkpoint file.
+    // the checkpoint replaces the previous one.
     const auto fileSyncRc = fileSync->move();
     checkRc(*fileSyncRc, "Sync of cache data file");
 
-    const auto endMarker = kCheckpointEndMarker;
-    state.write(asChar(&endMarker), sizeof(endMarker));
-
-    if (state.bad()) {
-      ++stats_.writeCheckpointErrors;
-      checkRc(-1, "Write of checkpoint file");
-    } else {
-      ++stats_.checkpointsWritten;
-    }
-    state.close();
-
-    // Sync checkpoint data file. ofstream does not have a sync method, so open
-    // as fd and sync that.
-    const auto checkpointFd = checkRc(
-        ::open(checkpointPath.c_str(), O_WRONLY),
-        "Open of checkpoint file for sync");
-    // TODO: add this as file open option after we migrate to use velox
-    // filesystem for ssd file access.
-    if (disableFileCow_) {
-      disableCow(checkpointFd);
-    }
-    VELOX_CHECK_GE(checkpointFd, 0);
-    checkRc(::fsync(checkpointFd), "Sync of checkpoint file");
-    ::close(checkpointFd);
-
-    // NOTE: we shall truncate eviction log after checkpoint file sync
-    // completes so that we never recover from an old checkpoint file without
-    // log evictions. The latter might lead to data consistent issue.
+    const auto checkpointPath = getCheckpointFilePath();
+    checkRc(
+        ::rename(tempPath.c_str(), checkpointPath.c_str()),
+        "Rename of checkpoint file");
+    // Sync the directory so that the rename is durable before the log is
+    // truncated.
+    auto directory = std::filesystem::path(checkpointPath).parent_path();
+    if (directory.empty()) {
+      directory = ".";
+    }
+    const auto directoryFd = checkRc(
+        ::open(directory.c_str(), O_RDONLY), "Open of checkpoint directory");
+    const auto directorySyncRc = ::fsync(directoryFd);
+    ::close(directoryFd);
+    checkRc(directorySyncRc, "Sync of checkpoint directory");
+    ++stats_.checkpointsWritten;
+
+    // NOTE: we shall truncate the log after the checkpoint replaced the
+    // previous one so that we never recover from an old checkpoint without
+    // the log after it. The latter might lead to data consistent issue.
     checkRc(::ftruncate(evictLogFd_, 0), "Truncate of event log");
     checkRc(::fsync(evictLogFd_), "Sync of evict log");
+    checkpointSequence_ = sequence;
+    logSegmentPending_ = true;
   } catch (const std::exception& e) {
     try {
       checkpointError(-1, e.what());
@@ -808,7 +1312,8 @@ void SsdFile::initializeCheckpoint() {
         << "Starting shard " << shardId_ << " without checkpoint";
   }
   const auto logPath = getEvictLogFilePath();
-  evictLogFd_ = ::open(logPath.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  evictLogFd_ =
+      ::open(logPath.c_str(), O_CREAT | O_RDWR | O_APPEND, S_IRUSR | S_IWUSR);
   if (disableFileCow_) {
     disableCow(evictLogFd_);
   }
@@ -822,11 +1327,14 @@ void SsdFile::initializeCheckpoint() {
         folly::errnoStr(errno));
   }
 
+  RecoveredState recovered;
+  recovered.evictedLogIndex.resize(maxRegions_, -1);
   try {
     if (hasCheckpoint) {
-      state.exceptions(std::ifstream::failbit);
-      readCheckpoint(state);
+      readCheckpoint(state, recovered);
     }
+    replayLog(recovered);
+    installRecovered(recovered);
   } catch (const std::exception& e) {
     ++stats_.readCheckpointErrors;
     try {
@@ -856,76 +1364,175 @@ bool SsdFile::testingIsCowDisabled() const {
 #endif // linux
 }
 
-namespace {
-template <typename T>
-T readNumber(std::ifstream& stream) {
-  T data;
-  stream.read(asChar(&data), sizeof(T));
-  return data;
-}
-} // namespace
-
-void SsdFile::readCheckpoint(std::ifstream& state) {
-  char magic[4];
-  state.read(magic, sizeof(magic));
-  VELOX_CHECK_EQ(::strncmp(magic, kCheckpointMagic, 4), 0);
-  const auto maxRegions = readNumber<int32_t>(state);
+void SsdFile::readCheckpoint(
+    std::ifstream& state,
+    RecoveredState& recovered) {
+  std::stringstream buffer;
+  buffer << state.rdbuf();
+  const auto data = buffer.str();
+  VELOX_CHECK_GE(data.size(), sizeof(int32_t), "Truncated checkpoint");
+  VELOX_CHECK_EQ(
+      ::strncmp(data.data(), kCheckpointMagic, 4),
+      0,
+      "Unknown checkpoint format");
+  SectionReader reader(std::string_view(data).substr(sizeof(int32_t)));
+  uint32_t tag;
+  std::string_view payload;
+
+  // The header and the file names are needed for all the regions.
+  VELOX_CHECK(
+      reader.next(tag, payload) == SectionReader::Result::kOk &&
+          tag == static_cast<uint32_t>(SectionTag::kHeader),
+      "Corrupt checkpoint header");
+  PayloadReader header(payload);
+  const auto maxRegions = header.read<int32_t>();
   VELOX_CHECK_EQ(
       maxRegions,
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
-  numRegions_ = readNumber<int32_t>(state);
-  std::vector<double> scores(maxRegions);
-  state.read(asChar(scores.data()), maxRegions_ * sizeof(double));
+  // The number of regions follows from the size of the cache file.
+  header.read<int32_t>();
+  recovered.sequence = header.read<uint64_t>();
+  recovered.scores.resize(maxRegions_);
+  const auto scores = header.readBytes(maxRegions_ * sizeof(double));
+  ::memcpy(recovered.scores.data(), scores.data(), scores.size());
+
+  VELOX_CHECK(
+      reader.next(tag, payload) == SectionReader::Result::kOk &&
+          tag == static_cast<uint32_t>(SectionTag::kFiles),
+      "Corrupt checkpoint file names");
   std::unordered_map<uint64_t, StringIdLease> idMap;
+  readFileNames(payload, idMap);
+
+  bool complete = false;
   for (;;) {
-    const auto id = readNumber<uint64_t>(state);
-    if (id == kCheckpointMapMarker) {
+    const auto result = reader.next(tag, payload);
+    if (result == SectionReader::Result::kEnd ||
+        result == SectionReader::Result::kTruncated) {
       break;
     }
-    std::string name;
-    name.resize(readNumber<int32_t>(state));
-    state.read(name.data(), name.size());
-    auto lease = StringIdLease(fileIds(), name);
-    idMap[id] = std::move(lease);
+    if (result == SectionReader::Result::kCorrupt) {
+      // Only the entries of one region are lost. The region has no entries
+      // and is written to as any other empty region.
+      ++stats_.readCheckpointErrors;
+      VELOX_SSD_CACHE_LOG(WARNING)
+          << "Skipping corrupt region in checkpoint of shard " << shardId_;
+      continue;
+    }
+    if (tag == static_cast<uint32_t>(SectionTag::kEnd)) {
+      complete = true;
+      break;
+    }
+    VELOX_CHECK_EQ(tag, static_cast<uint32_t>(SectionTag::kEntries));
+    PayloadReader entries(payload);
+    const auto region = entries.read<int32_t>();
+    forEachEntry(entries, idMap, [&](FileCacheKey key, SsdRun run) {
+      VELOX_CHECK_EQ(regionIndex(run.offset()), region);
+      recovered.entries[std::move(key)] = RecoveredEntry{run, 0};
+    });
+  }
+  if (!complete) {
+    // The regions read before the truncation are kept.
+    ++stats_.readCheckpointErrors;
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Truncated checkpoint of shard " << shardId_;
   }
+  ++stats_.checkpointsRead;
+}
 
+void SsdFile::replayLog(RecoveredState& recovered) {
   const auto logSize = ::lseek(evictLogFd_, 0, SEEK_END);
-  std::vector<uint32_t> evicted(logSize / sizeof(uint32_t));
-  const auto rc = ::pread(evictLogFd_, evicted.data(), logSize, 0);
-  VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
-  std::unordered_set<uint32_t> evictedMap;
-  for (auto region : evicted) {
-    evictedMap.insert(region);
-  }
-  for (;;) {
-    const uint64_t fileNum = readNumber<uint64_t>(state);
-    if (fileNum == kCheckpointEndMarker) {
+  VELOX_CHECK_GE(logSize, 0, "Failed to seek SSD cache log");
+  std::string data(logSize, '\0');
+  const auto rc = ::pread(evictLogFd_, data.data(), logSize, 0);
+  VELOX_CHECK_EQ(logSize, rc, "Failed to read SSD cache log");
+
+  // A log consists of segments that each start with a header. The file
+  // numbers of a segment are named in its kFiles records. Each kEntries and
+  // kEviction record gets a position so that the entries written before the
+  // eviction of their region can be dropped.
+  SectionReader reader(data);
+  std::unordered_map<uint64_t, StringIdLease> idMap;
+  bool inSegment = false;
+  int32_t logIndex = 0;
+  size_t validSize = 0;
+  uint32_t tag;
+  std::string_view payload;
+  while (reader.next(tag, payload) == SectionReader::Result::kOk) {
+    PayloadReader fields(payload);
+    const auto sectionTag = static_cast<SectionTag>(tag);
+    if (sectionTag == SectionTag::kHeader) {
+      // A segment that follows a different checkpoint does not apply.
+      if (fields.read<uint64_t>() != recovered.sequence) {
+        break;
+      }
+      idMap.clear();
+      inSegment = true;
+    } else if (!inSegment) {
+      break;
+    } else if (sectionTag == SectionTag::kFiles) {
+      readFileNames(payload, idMap);
+    } else if (sectionTag == SectionTag::kEntries) {
+      ++logIndex;
+      forEachEntry(fields, idMap, [&](FileCacheKey key, SsdRun run) {
+        recovered.entries[std::move(key)] = RecoveredEntry{run, logIndex};
+      });
+    } else if (sectionTag == SectionTag::kEviction) {
+      ++logIndex;
+      while (!fields.atEnd()) {
+        const auto region = fields.read<int32_t>();
+        VELOX_CHECK(region >= 0 && region < maxRegions_);
+        recovered.evictedLogIndex[region] = logIndex;
+      }
+    } else {
       break;
     }
-    const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
-      auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
-      FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
+    validSize = reader.position();
+  }
+  if (validSize < data.size()) {
+    // The rest was torn by a crash or follows another checkpoint. New records
+    // are appended after the valid ones.
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Dropping " << data.size() - validSize << " bytes of the log of "
+        << "shard " << shardId_;
+    VELOX_CHECK_EQ(
+        ::ftruncate(evictLogFd_, validSize), 0, "Truncate of SSD cache log");
+  }
+}
+
+void SsdFile::installRecovered(RecoveredState& recovered) {
+  entries_.clear();
+  for (auto& [key, entry] : recovered.entries) {
+    const auto region = regionIndex(entry.run.offset());
+    // Drops entries past the end of the file and entries of regions evicted
+    // after they were written.
+    if (region >= numRegions_ ||
+        entry.logIndex <= recovered.evictedLogIndex[region]) {
+      continue;
     }
+    const auto end =
+        entry.run.offset() - region * kRegionSize + entry.run.size();
+    if (end > kRegionSize) {
+      continue;
+    }
+    regionSizes_[region] = std::max<uint32_t>(regionSizes_[region], end);
+    unverifiedRegions_[region] = true;
+    entries_[key] = entry.run;
   }
-  ++stats_.checkpointsRead;
-  // The state is successfully read. Install the access frequency scores and
-  // evicted regions.
-  VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
-  // Set the writable regions by deduplicated evicted regions.
+  // The regions without entries are writable.
   writableRegions_.clear();
-  for (auto region : evictedMap) {
-    writableRegions_.push_back(region);
+  for (int32_t region = 0; region < numRegions_; ++region) {
+    if (regionSizes_[region] == 0) {
+      writableRegions_.push_back(region);
+    }
+  }
+  if (!recovered.scores.empty()) {
+    VELOX_CHECK_EQ(recovered.scores.size(), tracker_.regionScores().size());
+    tracker_.setRegionScores(recovered.scores);
   }
-  tracker_.setRegionScores(scores);
+  checkpointSequence_ = recovered.sequence;
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} regions with {} free.",
+      "Starting shard {} with {} recovered entries, {} regions with {} free.",
       shardId_,
       entries_.size(),
       numRegions_,
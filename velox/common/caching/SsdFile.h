@@ -29,14 +29,15 @@ namespace facebook::velox::cache {
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
 /// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// Also carries a CRC32C of the data if checkpointing is enabled, 0 otherwise.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : bits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
+  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum = 0)
+      : bits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
@@ -49,9 +50,11 @@ class SsdRun {
 
   void operator=(const SsdRun& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
   }
   void operator=(SsdRun&& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
   }
 
   uint64_t offset() const {
@@ -67,8 +70,20 @@ class SsdRun {
     return bits_;
   }
 
+  uint32_t checksum() const {
+    return checksum_;
+  }
+
+  /// Returns the run serialized as 'bits' and 'checksum'.
+  static SsdRun deserialize(uint64_t bits, uint32_t checksum) {
+    SsdRun run(bits);
+    run.checksum_ = checksum;
+    return run;
+  }
+
  private:
   uint64_t bits_;
+  uint32_t checksum_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -215,6 +230,16 @@ struct SsdCacheStats {
 /// pin count and an read count. Cache replacement takes place region by region,
 /// preferring regions with a smaller read count. Entries do not span regions.
 /// Otherwise entries are consecutive byte ranges inside their region.
+///
+/// If checkpointing is enabled, the index of the file survives a restart. A
+/// checkpoint holds the entries of each region in a section with its own
+/// checksum and is replaced atomically. Between checkpoints, a log records
+/// the written entries and the evicted regions. A restart reads the
+/// checkpoint and replays the log, so only the data written between the last
+/// logged write and the restart is lost. A corrupt region section
+/// invalidates only that region. Entries recovered from a checkpoint are
+/// verified against their data checksum when first read and a mismatch
+/// invalidates their region.
 class SsdFile {
  public:
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -281,6 +306,10 @@ class SsdFile {
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Adds the bytes of the cached entries to 'files', keyed on file id.
+  void appendFileBytes(
+      folly::F14FastMap<uint64_t, CachedFileBytes>& files) const;
+
   /// Remove cached entries of files in the fileNum set 'filesToRemove'. If
   /// successful, return true, and 'filesRetained' contains entries that should
   /// not be removed, ex., from pinned regions. Otherwise, return false and
@@ -289,6 +318,24 @@ class SsdFile {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Takes up to 'numRegions' regions out of the cache for other users of the
+  /// same device, e.g. spill. Capacity the file has not grown into yet is lent
+  /// first. After that, low scoring regions that are neither pinned nor
+  /// writable are evicted and their space is returned to the file system. A
+  /// lent region is not written by the cache until it is returned. Returns the
+  /// number of regions lent, which may be less than 'numRegions'.
+  int32_t lendRegions(int32_t numRegions);
+
+  /// Gives back up to 'numRegions' regions taken by lendRegions(). Returns the
+  /// number of regions returned.
+  int32_t returnRegions(int32_t numRegions);
+
+  /// Returns the number of regions currently lent by lendRegions().
+  int32_t numLentRegions() const {
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    return lentRegions_.size() + numLentGrowth_;
+  }
+
   /// Writes a checkpoint state that can be recovered from. The
   /// checkpoint is serialized on 'mutex_'. If 'force' is false,
   /// rechecks that at least 'checkpointIntervalBytes_' have been
@@ -304,7 +351,8 @@ class SsdFile {
     return fileName_;
   }
 
-  /// Returns the eviction log file path.
+  /// Returns the path of the log of entries written and regions evicted
+  /// since the last checkpoint.
   std::string getEvictLogFilePath() const {
     return fileName_ + kLogExtension;
   }
@@ -333,12 +381,43 @@ class SsdFile {
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
-  // Magic number separating file names from cache entry data in checkpoint
-  // file.
-  static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
-  // Magic number at end of completed checkpoint file.
-  static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
+  static constexpr const char* kCheckpointMagic = "CPT2";
+
+  // Tags of the checksummed sections of checkpoint and log files.
+  enum class SectionTag : uint32_t {
+    // Checkpoint: max regions, number of regions, sequence number and
+    // region scores. Log: the sequence number of the checkpoint the log
+    // follows. Starts a segment of the log with its own file numbers.
+    kHeader = 1,
+    // {fileNum, name} pairs.
+    kFiles = 2,
+    // Checkpoint: the entries of one region. Log: written entries.
+    kEntries = 3,
+    // Log: indices of evicted regions.
+    kEviction = 4,
+    // Checkpoint: end of a complete checkpoint.
+    kEnd = 5,
+  };
+
+  // An entry read from a checkpoint or a log. 'logIndex' is the position of
+  // the log record that wrote it, 0 for the checkpoint.
+  struct RecoveredEntry {
+    SsdRun run;
+    int32_t logIndex;
+  };
+
+  // State read from a checkpoint and its log. Installed into 'this' only
+  // after both are read.
+  struct RecoveredState {
+    // Sequence number of the checkpoint. 0 if there is none.
+    uint64_t sequence{0};
+    // Region scores. Empty if there is no checkpoint.
+    std::vector<double> scores;
+    folly::F14FastMap<FileCacheKey, RecoveredEntry> entries;
+    // Position of the last log record that evicted each region, -1 if none.
+    // Entries written before this are dropped.
+    std::vector<int32_t> evictedLogIndex;
+  };
 
   static constexpr int kMaxErasedSizePct = 50;
 
@@ -351,10 +430,13 @@ class SsdFile {
   // Returns [offset, size] of contiguous space for storing data of a number of
   // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
   // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // multiple calls starting at the first unwritten pin may be needed. If
+  // 'pinSpace' is true, the region of the space is pinned so that it is not
+  // evicted before the caller has written it and called unpinRegion().
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
       const std::vector<CachePin>& pins,
-      int32_t begin);
+      int32_t begin,
+      bool pinSpace = false);
 
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
@@ -370,10 +452,33 @@ class SsdFile {
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
-  // Reads a checkpoint state file and sets 'this' accordingly if read is
-  // successful. Return true for successful read. A failed read deletes the
-  // checkpoint and leaves the log truncated open.
-  void readCheckpoint(std::ifstream& state);
+  // Reads a checkpoint state file into 'recovered'. Throws if the header or
+  // the file names are not readable. A corrupt region section only drops the
+  // entries of that region.
+  void readCheckpoint(std::ifstream& state, RecoveredState& recovered);
+
+  // Applies the log records that follow the checkpoint of 'recovered' to
+  // 'recovered'. Stops at the first torn or corrupt record, which is where a
+  // crash interrupted the log, and truncates the log there.
+  void replayLog(RecoveredState& recovered);
+
+  // Sets the entries, region sizes and scores of 'this' from 'recovered'.
+  void installRecovered(RecoveredState& recovered);
+
+  // Returns the start of a batch of log records. This is a header if the
+  // batch starts a log segment. Caller must hold 'mutex_'.
+  std::string newLogRecordsLocked();
+
+  // Appends 'records' to the log. Turns off checkpointing on error.
+  void writeLog(const std::string& records);
+
+  // Logs that 'entries' have been written. Caller must hold 'mutex_'.
+  void logEntriesLocked(
+      const std::vector<std::pair<FileCacheKey, SsdRun>>& entries);
+
+  // Drops the entries of 'region' after its data was found to not match
+  // their checksums. Caller must hold 'mutex_'.
+  void invalidateRegionLocked(int32_t region);
 
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
@@ -408,6 +513,12 @@ class SsdFile {
     return fileName_ + kCheckpointExtension;
   }
 
+  // Returns the path a new checkpoint is written to before it replaces the
+  // previous one.
+  std::string getTempCheckpointFilePath() const {
+    return getCheckpointFilePath() + ".tmp";
+  }
+
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
 
@@ -450,6 +561,15 @@ class SsdFile {
   // Pin count for each region.
   std::vector<int32_t> regionPins_;
 
+  // Evicted regions taken out of the cache by lendRegions(). Each holds a pin
+  // so that it is neither evicted nor made writable until it is returned.
+  std::vector<int32_t> lentRegions_;
+
+  // Number of regions at the end of the file lent by lendRegions() before the
+  // file grew into them. The file does not grow past 'maxRegions_' -
+  // 'numLentGrowth_'. These regions are pinned as well.
+  int32_t numLentGrowth_{0};
+
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
@@ -475,9 +595,24 @@ class SsdFile {
   // Count of bytes written after last checkpoint.
   std::atomic<uint64_t> bytesAfterCheckpoint_{0};
 
-  // fd for logging evictions.
+  // fd for logging written entries and evictions.
   int32_t evictLogFd_{-1};
 
+  // Sequence number of the last checkpoint. 0 if there is none.
+  uint64_t checkpointSequence_{0};
+
+  // True if the next log write starts a log segment. A segment starts after
+  // every log truncation and after a restart, since file numbers differ
+  // between processes.
+  bool logSegmentPending_{true};
+
+  // File numbers whose names have been logged in the current log segment.
+  folly::F14FastSet<uint64_t> loggedFileNums_;
+
+  // True for regions with entries recovered at startup that have not been
+  // rewritten or verified since. Entries from these are verified when read.
+  std::vector<bool> unverifiedRegions_;
+
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
 };
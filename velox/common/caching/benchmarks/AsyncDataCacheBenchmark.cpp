@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_int32(max_threads, 128, "The largest number of concurrent threads");
+DEFINE_int64(
+    num_hits_per_thread,
+    1'000'000,
+    "The number of cache hits to run per thread");
+DEFINE_int32(num_hot_entries, 64, "The number of entries the threads hit");
+DEFINE_int32(entry_size, 64 << 10, "The size of a cache entry in bytes");
+DEFINE_int64(seed, 99887766, "Seed for picking the entry to hit");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+// Runs 'numThreads' threads that each pin and unpin random hot entries of
+// 'cache'. Returns the wall time in nanoseconds.
+uint64_t runHits(
+    AsyncDataCache& cache,
+    const std::vector<RawFileCacheKey>& keys,
+    int32_t numThreads) {
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  const auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(FLAGS_seed + i);
+      for (int64_t hit = 0; hit < FLAGS_num_hits_per_thread; ++hit) {
+        const auto& key = keys[folly::Random::rand32(keys.size(), rng)];
+        auto pin = cache.findOrCreate(key, FLAGS_entry_size);
+        VELOX_CHECK(!pin.empty() && pin.entry()->isShared());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Measures cache hits on hot entries by a growing number of threads. Hits
+// take the shard mutex in shared mode unless there is an admission policy,
+// which makes every hit take it in exclusive mode.
+void runHitBenchmark(bool exclusive) {
+  const int64_t hotBytes = 1L * FLAGS_num_hot_entries * FLAGS_entry_size;
+  memory::MemoryManagerOptions options;
+  options.allocatorCapacity = std::max<int64_t>(1L << 30, 2 * hotBytes);
+  memory::MemoryManager manager(options);
+  CacheAdmissionPolicyFactory admissionPolicyFactory;
+  if (exclusive) {
+    // Admits on the first access, so that only the locking differs.
+    admissionPolicyFactory = []() {
+      return std::make_unique<TinyLfuAdmissionPolicy>(
+          TinyLfuAdmissionPolicy::kDefaultSampleSize, 1);
+    };
+  }
+  auto cache = AsyncDataCache::create(
+      manager.allocator(), nullptr, std::move(admissionPolicyFactory));
+  StringIdLease file(fileIds(), "async_data_cache_benchmark_file");
+  std::vector<RawFileCacheKey> keys;
+  for (int32_t i = 0; i < FLAGS_num_hot_entries; ++i) {
+    const uint64_t offset = 1UL * i * FLAGS_entry_size;
+    keys.push_back(RawFileCacheKey{file.id(), offset});
+    auto pin = cache->findOrCreate(keys.back(), FLAGS_entry_size);
+    VELOX_CHECK(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared();
+  }
+  for (int32_t numThreads = 1; numThreads <= FLAGS_max_threads;
+       numThreads *= 2) {
+    const auto nanos = runHits(*cache, keys, numThreads);
+    const auto numHits = numThreads * FLAGS_num_hits_per_thread;
+    LOG(INFO) << fmt::format(
+        "{} hits, {} threads: {} hits in {}, {} hits/s",
+        exclusive ? "Exclusive" : "Shared",
+        numThreads,
+        numHits,
+        succinctNanos(nanos),
+        nanos == 0 ? 0 : numHits * 1'000'000'000 / nanos);
+  }
+  cache->shutdown();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  for (const bool exclusive : {false, true}) {
+    runHitBenchmark(exclusive);
+  }
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/Semaphore.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/CacheAdmissionPolicy.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
@@ -92,7 +93,9 @@ class AsyncDataCacheTest : public testing::Test {
   void initializeCache(
       uint64_t maxBytes,
       int64_t ssdBytes = 0,
-      int64_t checkpointIntervalBytes = 0) {
+      int64_t checkpointIntervalBytes = 0,
+      CacheAdmissionPolicyFactory admissionPolicyFactory = nullptr,
+      const CacheTieringOptions& tieringOptions = {}) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -125,7 +128,11 @@ class AsyncDataCacheTest : public testing::Test {
     options.trackDefaultUsage = true;
     manager_ = std::make_unique<memory::MemoryManager>(options);
     allocator_ = static_cast<memory::MmapAllocator*>(manager_->allocator());
-    cache_ = AsyncDataCache::create(allocator_, std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_,
+        std::move(ssdCache),
+        std::move(admissionPolicyFactory),
+        tieringOptions);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -887,6 +894,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       " num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
+      "Tiering RAM hit ratio: 0.0% SSD hit ratio: 0.0% SSD hit: 0 bytes: 0B not promoted: 0 demoted: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n"
       "Backing: Memory Allocator[MMAP total capacity 64.00MB free capacity 64.00MB allocated pages 0 mapped pages 0 external mapped pages 0\n"
@@ -911,6 +919,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       " num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
+      "Tiering RAM hit ratio: 0.0% SSD hit ratio: 0.0% SSD hit: 0 bytes: 0B not promoted: 0 demoted: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n";
   ASSERT_EQ(cache_->toString(false), expectedShortCacheOutput);
@@ -1154,6 +1163,178 @@ DEBUG_ONLY_TEST_F(AsyncDataCacheTest, ttl) {
   EXPECT_EQ(statsTtl.ssdStats->entriesAgedOut, statsT1.ssdStats->entriesCached);
 }
 
+TEST_F(AsyncDataCacheTest, concurrentHits) {
+  constexpr int32_t kNumEntries = 16;
+  constexpr int32_t kEntrySize = 64 << 10;
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumHits = 10'000;
+  initializeCache(32 << 20);
+  const auto fileNum = filenames_[0].id();
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{fileNum, static_cast<uint64_t>(i * kEntrySize)},
+        kEntrySize);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared();
+  }
+  runThreads(kNumThreads, [&](int32_t threadId) {
+    std::vector<CachePin> pins;
+    for (auto i = 0; i < kNumHits; ++i) {
+      const uint64_t offset = ((threadId + i) % kNumEntries) * kEntrySize;
+      auto pin = cache_->findOrCreate(RawFileCacheKey{fileNum, offset}, 1);
+      VELOX_CHECK(pin.entry()->isShared());
+      // Hold a few pins at a time so that the pin counts go above 1.
+      pins.push_back(std::move(pin));
+      if (pins.size() > 3) {
+        pins.clear();
+      }
+    }
+  });
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(kNumThreads * kNumHits, stats.numHit);
+  ASSERT_EQ(kNumEntries, stats.numNew);
+  ASSERT_EQ(0, stats.numShared);
+  ASSERT_EQ(0, stats.numExclusive);
+}
+
+TEST_F(AsyncDataCacheTest, summary) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 512UL << 20;
+  constexpr int32_t kEntrySize = 64 << 10;
+  constexpr uint64_t kGroupId = 11;
+  initializeCache(kRamBytes, kSsdBytes);
+  auto load = [&](uint64_t fileNum, int32_t numEntries) {
+    for (auto i = 0; i < numEntries; ++i) {
+      auto pin = cache_->findOrCreate(
+          RawFileCacheKey{fileNum, static_cast<uint64_t>(i * kEntrySize)},
+          kEntrySize);
+      ASSERT_FALSE(pin.empty());
+      pin.entry()->setGroupId(kGroupId);
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+  load(filenames_[0].id(), 4);
+  load(filenames_[1].id(), 1);
+
+  auto summary = cache_->summary(1);
+  ASSERT_EQ(2, summary.numFiles);
+  ASSERT_EQ(5 * kEntrySize, summary.ramBytes);
+  ASSERT_EQ(0, summary.ssdBytes);
+  ASSERT_EQ(1, summary.topFiles.size());
+  ASSERT_EQ(fileIds().string(filenames_[0].id()), summary.topFiles[0].path);
+  ASSERT_EQ(4 * kEntrySize, summary.topFiles[0].ramBytes);
+  ASSERT_EQ(kGroupId, summary.topFiles[0].groupId);
+  ASSERT_EQ(1, summary.groupBytes.size());
+  ASSERT_EQ(kGroupId, summary.groupBytes[0].first);
+  ASSERT_EQ(5 * kEntrySize, summary.groupBytes[0].second);
+  ASSERT_TRUE(summary.mayContain(fileIds().string(filenames_[0].id())));
+  ASSERT_TRUE(summary.mayContain(fileIds().string(filenames_[1].id())));
+  ASSERT_FALSE(summary.mayContain("not cached"));
+
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd();
+  waitForSsdWriteToFinish(cache_->ssdCache());
+  summary = cache_->summary();
+  ASSERT_EQ(2, summary.topFiles.size());
+  ASSERT_EQ(5 * kEntrySize, summary.ssdBytes);
+  ASSERT_EQ(4 * kEntrySize, summary.topFiles[0].ssdBytes);
+}
+
+TEST_F(AsyncDataCacheTest, admissionPolicy) {
+  constexpr uint64_t kRamBytes = 16 << 20;
+  constexpr int32_t kEntrySize = 64 << 10;
+  constexpr int32_t kNumHot = 16;
+  initializeCache(kRamBytes, 0, 0, []() {
+    return std::make_unique<TinyLfuAdmissionPolicy>();
+  });
+  auto load = [&](uint64_t fileNum, uint64_t offset) {
+    auto pin =
+        cache_->findOrCreate(RawFileCacheKey{fileNum, offset}, kEntrySize);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  // The hot entries are read twice and are admitted on the second read.
+  const auto hotFile = filenames_[0].id();
+  for (auto i = 0; i < kNumHot; ++i) {
+    load(hotFile, i * kEntrySize);
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(kNumHot, stats.numNew);
+  ASSERT_EQ(kNumHot, stats.numNotAdmitted);
+  for (auto i = 0; i < kNumHot; ++i) {
+    load(hotFile, i * kEntrySize);
+  }
+  ASSERT_EQ(kNumHot, cache_->refreshStats().numHit);
+
+  // A scan of 4x the cache size reads every range once. Its entries are not
+  // admitted and go before the hot entries.
+  const auto scanFile = filenames_[1].id();
+  const int32_t numScanEntries = 4 * kRamBytes / kEntrySize;
+  for (auto i = 0; i < numScanEntries; ++i) {
+    load(scanFile, i * kEntrySize);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_EQ(kNumHot + numScanEntries, stats.numNotAdmitted);
+  ASSERT_GT(stats.numEvict, 0);
+  for (auto i = 0; i < kNumHot; ++i) {
+    ASSERT_TRUE(cache_->exists(RawFileCacheKey{hotFile, i * kEntrySize}));
+  }
+}
+
+TEST_F(AsyncDataCacheTest, ioBudget) {
+  IoBudget budget(1000);
+  ASSERT_TRUE(budget.tryAcquire(600));
+  ASSERT_FALSE(budget.tryAcquire(600));
+
+  // A transfer larger than the rate goes through from a full budget and
+  // leaves a debt.
+  IoBudget smallBudget(100);
+  ASSERT_TRUE(smallBudget.tryAcquire(1000));
+  ASSERT_FALSE(smallBudget.tryAcquire(1));
+
+  IoBudget unlimited(IoBudget::kUnlimited);
+  IoBudget disabled(0);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_TRUE(unlimited.tryAcquire(1 << 30));
+    ASSERT_FALSE(disabled.tryAcquire(1));
+  }
+}
+
+TEST_F(AsyncDataCacheTest, tiering) {
+  // Small enough for eviction to start before a periodic SSD save, so that
+  // the evicted entries are all saveable.
+  constexpr uint64_t kRamBytes = 16 << 20;
+  constexpr uint64_t kSsdBytes = 512UL << 20;
+  constexpr int32_t kEntrySize = 1 << 20;
+  // Nothing is promoted from SSD and everything evicted is demoted.
+  initializeCache(kRamBytes, kSsdBytes, 0, nullptr, {0, IoBudget::kUnlimited});
+  const auto fileNum = filenames_[0].id();
+  const int32_t numEntries = 2 * kRamBytes / kEntrySize;
+  for (auto i = 0; i < numEntries; ++i) {
+    Request request(i * kEntrySize, kEntrySize);
+    loadOne(fileNum, request, false);
+    waitForSsdWriteToFinish(cache_->ssdCache());
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numDemoted, 0);
+  ASSERT_GT(stats.demotedBytes, 0);
+  ASSERT_EQ(stats.numSsdHit, 0);
+
+  for (auto i = 0; i < numEntries; ++i) {
+    Request request(i * kEntrySize, kEntrySize);
+    loadOne(fileNum, request, false);
+    waitForSsdWriteToFinish(cache_->ssdCache());
+  }
+  stats = cache_->refreshStats();
+  ASSERT_GT(stats.numSsdHit, 0);
+  ASSERT_EQ(stats.numSsdHit, stats.numNotPromoted);
+  ASSERT_GT(stats.ssdHitRatio(), 0);
+  ASSERT_GT(stats.ramHitRatio(), 0);
+}
+
 TEST_F(AsyncDataCacheTest, shutdown) {
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 64UL << 20;
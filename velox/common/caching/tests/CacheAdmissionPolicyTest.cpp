@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAdmissionPolicy.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+TEST(CacheAdmissionPolicyTest, frequency) {
+  TinyLfuAdmissionPolicy policy(1 << 10);
+  constexpr uint64_t kHash = 0x1234'5678'9abc'def0;
+  EXPECT_EQ(0, policy.frequency(kHash));
+  EXPECT_FALSE(policy.admit(kHash, 100));
+
+  policy.recordAccess(kHash);
+  EXPECT_EQ(1, policy.frequency(kHash));
+  EXPECT_FALSE(policy.admit(kHash, 100));
+
+  policy.recordAccess(kHash);
+  EXPECT_EQ(2, policy.frequency(kHash));
+  EXPECT_TRUE(policy.admit(kHash, 100));
+  // A seldom read stream needs one more access.
+  EXPECT_FALSE(policy.admit(kHash, 10));
+  policy.recordAccess(kHash);
+  EXPECT_TRUE(policy.admit(kHash, 10));
+
+  // The counters saturate.
+  for (auto i = 0; i < 100; ++i) {
+    policy.recordAccess(kHash);
+  }
+  EXPECT_EQ(16, policy.frequency(kHash));
+}
+
+TEST(CacheAdmissionPolicyTest, oneHitWonders) {
+  TinyLfuAdmissionPolicy policy(1 << 16);
+  // Keys accessed once are absorbed by the doorkeeper and are not admitted.
+  int32_t numAdmitted = 0;
+  for (uint64_t i = 0; i < 10'000; ++i) {
+    policy.recordAccess(i * 64);
+    numAdmitted += policy.admit(i * 64, 100);
+  }
+  // Allow for a few false positives of the doorkeeper.
+  EXPECT_LT(numAdmitted, 100);
+
+  for (uint64_t i = 0; i < 1'000; ++i) {
+    policy.recordAccess(i * 64);
+    EXPECT_TRUE(policy.admit(i * 64, 100));
+  }
+}
+
+TEST(CacheAdmissionPolicyTest, aging) {
+  constexpr int32_t kSampleSize = 1 << 10;
+  TinyLfuAdmissionPolicy policy(kSampleSize);
+  constexpr uint64_t kHash = 12345;
+  for (auto i = 0; i < 9; ++i) {
+    policy.recordAccess(kHash);
+  }
+  EXPECT_EQ(9, policy.frequency(kHash));
+  EXPECT_EQ(0, policy.numAgings());
+
+  // Distinct keys up to the sample size halve the counters and clear the
+  // doorkeeper.
+  for (uint64_t i = 1; i <= kSampleSize - 9; ++i) {
+    policy.recordAccess(kHash + i * 1'000'003);
+  }
+  EXPECT_EQ(1, policy.numAgings());
+  const auto frequency = policy.frequency(kHash);
+  EXPECT_GE(frequency, 4);
+  EXPECT_LT(frequency, 9);
+  EXPECT_TRUE(policy.admit(kHash, 100));
+  EXPECT_EQ(
+      "TinyLFU[sample size 1024 min frequency 2 counters 4096 agings 1]",
+      policy.toString());
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+TEST(FileGroupStatsTest, acrossScans) {
+  constexpr uint64_t kFileId = 1;
+  constexpr uint64_t kGroupId = 2;
+  constexpr int32_t kLoadQuantum = 1 << 20;
+  const TrackingId readColumn(10);
+  const TrackingId skippedColumn(20);
+  FileGroupStats stats;
+  {
+    ScanTracker tracker("scan1", nullptr, kLoadQuantum, &stats);
+    for (auto i = 0; i < 4; ++i) {
+      tracker.recordReference(readColumn, 1000, kFileId, kGroupId);
+      tracker.recordRead(readColumn, 1000, kFileId, kGroupId);
+      tracker.recordReference(skippedColumn, 1000, kFileId, kGroupId);
+    }
+  }
+
+  // A new scan has no data of its own but 'stats' has the earlier scan's.
+  ScanTracker tracker("scan2", nullptr, kLoadQuantum, &stats);
+  EXPECT_EQ(0, tracker.trackingData(readColumn).numReferences);
+  auto data = stats.trackingData(kGroupId, readColumn);
+  EXPECT_EQ(4, data.numReferences);
+  EXPECT_EQ(4, data.numReads);
+  EXPECT_EQ(4000, data.readBytes);
+  data = stats.trackingData(kGroupId, skippedColumn);
+  EXPECT_EQ(4, data.numReferences);
+  EXPECT_EQ(0, data.numReads);
+
+  // Other groups are tracked separately.
+  EXPECT_EQ(0, stats.trackingData(kGroupId + 1, readColumn).numReferences);
+  EXPECT_EQ(2, stats.numTracked());
+}
+
+TEST(FileGroupStatsTest, maxTracked) {
+  FileGroupStats stats;
+  for (auto i = 0; i < FileGroupStats::kMaxTracked; ++i) {
+    stats.recordReference(0, i, TrackingId(1), 100, 0);
+  }
+  // The stream of group 0 is referenced twice, so that it survives an aging.
+  stats.recordReference(0, 0, TrackingId(1), 100, 0);
+  EXPECT_EQ(FileGroupStats::kMaxTracked, stats.numTracked());
+
+  // A new stream past the limit ages the counts. The streams referenced once
+  // are dropped.
+  stats.recordReference(0, FileGroupStats::kMaxTracked, TrackingId(1), 100, 0);
+  EXPECT_EQ(2, stats.numTracked());
+  EXPECT_EQ(1, stats.trackingData(0, TrackingId(1)).numReferences);
+  EXPECT_EQ(
+      1,
+      stats.trackingData(FileGroupStats::kMaxTracked, TrackingId(1))
+          .numReferences);
+}
@@ -14,14 +14,17 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <filesystem>
 
 using namespace facebook::velox;
 using namespace facebook::velox::cache;
@@ -258,6 +261,63 @@ class SsdFileTest : public testing::Test {
     return numFound;
   }
 
+  // Writes the entries of 'numRegions' regions and returns them.
+  std::vector<TestEntry> writeRegions(int32_t numRegions) {
+    std::vector<TestEntry> entries;
+    for (auto startOffset = 0;
+         startOffset < numRegions * SsdFile::kRegionSize;
+         startOffset += SsdFile::kRegionSize) {
+      auto pins =
+          makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+      ssdFile_->write(pins);
+      for (auto& pin : pins) {
+        EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+        entries.emplace_back(
+            pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+      }
+    }
+    return entries;
+  }
+
+  // Returns the entries of 'entries' that are in 'region' or, if 'inRegion'
+  // is false, the entries in other regions.
+  static std::vector<TestEntry> regionEntries(
+      const std::vector<TestEntry>& entries,
+      int32_t region,
+      bool inRegion = true) {
+    std::vector<TestEntry> result;
+    for (const auto& entry : entries) {
+      if ((entry.ssdOffset / SsdFile::kRegionSize == region) == inRegion) {
+        result.push_back(entry);
+      }
+    }
+    return result;
+  }
+
+  // Writes 'size' copies of 'byte' to 'path' at 'offset'.
+  static void overwrite(
+      const std::string& path,
+      uint64_t offset,
+      int32_t size,
+      char byte) {
+    const auto fd = ::open(path.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    const std::string data(size, byte);
+    ASSERT_EQ(::pwrite(fd, data.data(), size, offset), size);
+    ::close(fd);
+  }
+
+  // Inverts the byte of 'path' at 'offset'.
+  static void flipByte(const std::string& path, uint64_t offset) {
+    const auto fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    char byte;
+    ASSERT_EQ(::pread(fd, &byte, 1, offset), 1);
+    byte = ~byte;
+    ASSERT_EQ(::pwrite(fd, &byte, 1, offset), 1);
+    ::close(fd);
+  }
+
   std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
 
   std::shared_ptr<AsyncDataCache> cache_;
@@ -427,6 +487,121 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, recoverFromLog) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // No checkpoint is written, so the entries are recovered from the log.
+  const int64_t checkpointIntervalBytes = 4 * kSsdSize;
+  initializeCache(kSsdSize, checkpointIntervalBytes);
+  const auto allEntries = writeRegions(4);
+  EXPECT_EQ(ssdFile_->testingStats().checkpointsWritten, 0);
+
+  // A torn record at the end of the log is dropped.
+  const auto logPath = ssdFile_->getEvictLogFilePath();
+  const auto logSize = std::filesystem::file_size(logPath);
+  overwrite(logPath, logSize, 7, 1);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  EXPECT_EQ(std::filesystem::file_size(logPath), logSize);
+  // The file has the 4 regions written and all are full.
+  EXPECT_EQ(ssdFile_->testingNumWritableRegions(), 0);
+  cache_->testingClear();
+  EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+
+  // Corrupts the data of an entry in region 1. Reading it fails and drops the
+  // entries of region 1. The other regions are not affected.
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  const auto corrupted = regionEntries(allEntries, 1)[0];
+  overwrite(
+      fmt::format("{}/ssdtest", tempDirectory_->getPath()),
+      corrupted.ssdOffset,
+      8,
+      -1);
+  cache_->testingClear();
+  {
+    std::vector<CachePin> pins;
+    pins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileName_.id(), corrupted.key.offset},
+        corrupted.size,
+        nullptr));
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(ssdFile_->find(
+        RawFileCacheKey{fileName_.id(), corrupted.key.offset}));
+    ASSERT_FALSE(ssdPins.back().empty());
+    VELOX_ASSERT_THROW(
+        ssdFile_->load(ssdPins, pins), "does not match its checksum");
+  }
+  EXPECT_EQ(ssdFile_->testingStats().readSsdErrors, 1);
+  cache_->testingClear();
+  EXPECT_EQ(checkEntries(regionEntries(allEntries, 1)), 0);
+  const auto otherEntries = regionEntries(allEntries, 1, false);
+  EXPECT_EQ(checkEntries(otherEntries), otherEntries.size());
+
+  // The invalidation is logged.
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  cache_->testingClear();
+  EXPECT_EQ(checkEntries(allEntries), otherEntries.size());
+}
+
+TEST_F(SsdFileTest, corruptCheckpointRegion) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  const int64_t checkpointIntervalBytes = 4 * kSsdSize;
+  initializeCache(kSsdSize, checkpointIntervalBytes);
+  const auto allEntries = writeRegions(4);
+  ssdFile_->checkpoint(true);
+  EXPECT_EQ(std::filesystem::file_size(ssdFile_->getEvictLogFilePath()), 0);
+
+  // The region sections are in region order and are followed by the 20 byte
+  // end section. Corrupts the checksum of the section of region 3.
+  const auto checkpointPath =
+      fmt::format("{}/ssdtest.cpt", tempDirectory_->getPath());
+  flipByte(checkpointPath, std::filesystem::file_size(checkpointPath) - 21);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  const auto stats = ssdFile_->testingStats();
+  EXPECT_EQ(stats.checkpointsRead, 1);
+  EXPECT_EQ(stats.readCheckpointErrors, 1);
+  // Region 3 has no entries and is written to again.
+  EXPECT_EQ(ssdFile_->testingNumWritableRegions(), 1);
+  cache_->testingClear();
+  EXPECT_EQ(checkEntries(regionEntries(allEntries, 3)), 0);
+  const auto otherEntries = regionEntries(allEntries, 3, false);
+  EXPECT_EQ(checkEntries(otherEntries), otherEntries.size());
+}
+
+TEST_F(SsdFileTest, lendRegions) {
+  constexpr int32_t kNumRegions = 4;
+  initializeCache(kNumRegions * SsdFile::kRegionSize);
+  auto numOnSsd = [&](const std::vector<TestEntry>& entries) {
+    int32_t numFound = 0;
+    for (const auto& entry : entries) {
+      const RawFileCacheKey key{fileName_.id(), entry.key.offset};
+      numFound += !ssdFile_->find(key).empty();
+    }
+    return numFound;
+  };
+
+  // The capacity the file has not grown into is lent first.
+  EXPECT_EQ(ssdFile_->lendRegions(1), 1);
+  EXPECT_EQ(ssdFile_->numLentRegions(), 1);
+  const auto entries = writeRegions(kNumRegions - 1);
+  EXPECT_EQ(numOnSsd(entries), entries.size());
+  auto stats = ssdFile_->testingStats();
+  EXPECT_EQ(stats.regionsCached, kNumRegions - 1);
+  EXPECT_EQ(stats.numPins, 0);
+
+  // The file is full, so more regions are lent by evicting them.
+  const auto numEvicted = ssdFile_->lendRegions(2);
+  EXPECT_GT(numEvicted, 0);
+  EXPECT_LE(numEvicted, 2);
+  EXPECT_EQ(ssdFile_->numLentRegions(), 1 + numEvicted);
+  EXPECT_LT(numOnSsd(entries), entries.size());
+  stats = ssdFile_->testingStats();
+  EXPECT_EQ(stats.regionsEvicted, numEvicted);
+  EXPECT_EQ(stats.numPins, 0);
+
+  EXPECT_EQ(ssdFile_->returnRegions(kNumRegions), 1 + numEvicted);
+  EXPECT_EQ(ssdFile_->numLentRegions(), 0);
+  EXPECT_EQ(ssdFile_->returnRegions(1), 0);
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   LOG(ERROR) << "here";
@@ -18,28 +18,153 @@
 #include "velox/common/base/Exceptions.h"
 
 #include <folly/Conv.h>
+#include <folly/Synchronized.h>
+
+#include <unordered_map>
 
 namespace facebook::velox::common {
+namespace {
 
-std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
+folly::Synchronized<std::unordered_map<int32_t, BlockCodecFactory>>&
+blockCodecFactories() {
+  static folly::Synchronized<std::unordered_map<int32_t, BlockCodecFactory>>
+      factories;
+  return factories;
+}
+
+// Presents a BlockCodec as a folly codec of the same format.
+class BlockCodecAdapter : public folly::io::Codec {
+ public:
+  BlockCodecAdapter(
+      folly::io::CodecType type,
+      std::unique_ptr<BlockCodec> blockCodec)
+      : Codec(type), blockCodec_(std::move(blockCodec)) {}
+
+ private:
+  bool doNeedsUncompressedLength() const override {
+    return true;
+  }
+
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override {
+    return blockCodec_->maxCompressedLength(uncompressedLength);
+  }
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override {
+    const auto input = data->cloneCoalescedAsValue();
+    auto output = folly::IOBuf::create(
+        blockCodec_->maxCompressedLength(input.length()));
+    const auto size = blockCodec_->compress(
+        reinterpret_cast<const char*>(input.data()),
+        input.length(),
+        reinterpret_cast<char*>(output->writableData()),
+        output->capacity());
+    VELOX_CHECK(
+        size.has_value(), "Compressed size exceeds maxCompressedLength()");
+    output->append(size.value());
+    return output;
+  }
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override {
+    VELOX_CHECK(
+        uncompressedLength.has_value(),
+        "Decompressing with a BlockCodec needs the uncompressed length");
+    const auto input = data->cloneCoalescedAsValue();
+    auto output = folly::IOBuf::create(uncompressedLength.value());
+    const auto size = blockCodec_->decompress(
+        reinterpret_cast<const char*>(input.data()),
+        input.length(),
+        reinterpret_cast<char*>(output->writableData()),
+        uncompressedLength.value());
+    VELOX_CHECK_EQ(size, uncompressedLength.value());
+    output->append(size);
+    return output;
+  }
+
+  const std::unique_ptr<BlockCodec> blockCodec_;
+};
+
+folly::io::CodecType toCodecType(CompressionKind kind) {
   switch (static_cast<int32_t>(kind)) {
     case CompressionKind_NONE:
-      return getCodec(folly::io::CodecType::NO_COMPRESSION);
+      return folly::io::CodecType::NO_COMPRESSION;
     case CompressionKind_ZLIB:
-      return getCodec(folly::io::CodecType::ZLIB);
+      return folly::io::CodecType::ZLIB;
     case CompressionKind_SNAPPY:
-      return getCodec(folly::io::CodecType::SNAPPY);
+      return folly::io::CodecType::SNAPPY;
     case CompressionKind_ZSTD:
-      return getCodec(folly::io::CodecType::ZSTD);
+      return folly::io::CodecType::ZSTD;
     case CompressionKind_LZ4:
-      return getCodec(folly::io::CodecType::LZ4);
+      return folly::io::CodecType::LZ4;
     case CompressionKind_GZIP:
-      return getCodec(folly::io::CodecType::GZIP);
+      return folly::io::CodecType::GZIP;
     default:
       VELOX_UNSUPPORTED(
           "Not support {} in folly", compressionKindToString(kind));
   }
 }
+} // namespace
+
+folly::SemiFuture<folly::Unit> BlockCodec::submit(
+    bool compress,
+    folly::Range<Request*> requests) {
+  return folly::makeSemiFutureWith([&]() {
+    for (auto& request : requests) {
+      if (compress) {
+        request.resultSize = this->compress(
+            request.input,
+            request.inputSize,
+            request.output,
+            request.outputSize);
+      } else {
+        request.resultSize = decompress(
+            request.input,
+            request.inputSize,
+            request.output,
+            request.outputSize);
+      }
+    }
+  });
+}
+
+void registerBlockCodecFactory(
+    CompressionKind kind,
+    BlockCodecFactory factory) {
+  blockCodecFactories().withWLock([&](auto& factories) {
+    if (factory == nullptr) {
+      factories.erase(kind);
+    } else {
+      factories[kind] = std::move(factory);
+    }
+  });
+}
+
+std::unique_ptr<BlockCodec> makeBlockCodec(
+    CompressionKind kind,
+    const BlockCodecOptions& options) {
+  BlockCodecFactory factory;
+  blockCodecFactories().withRLock([&](const auto& factories) {
+    auto it = factories.find(kind);
+    if (it != factories.end()) {
+      factory = it->second;
+    }
+  });
+  return factory == nullptr ? nullptr : factory(kind, options);
+}
+
+std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
+  const auto type = toCodecType(kind);
+  if (kind != CompressionKind_NONE) {
+    // The window bits of the folly zlib and gzip codecs.
+    BlockCodecOptions options;
+    options.windowBits = kind == CompressionKind_GZIP ? 31 : 15;
+    if (auto blockCodec = makeBlockCodec(kind, options)) {
+      return std::make_unique<BlockCodecAdapter>(type, std::move(blockCodec));
+    }
+  }
+  return getCodec(type);
+}
 
 CompressionKind codecTypeToCompressionKind(folly::io::CodecType type) {
   switch (type) {
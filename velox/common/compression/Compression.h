@@ -17,7 +17,11 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <folly/Range.h>
 #include <folly/compression/Compression.h>
+#include <folly/futures/Future.h>
+#include <functional>
+#include <optional>
 #include <string>
 
 namespace facebook::velox::common {
@@ -46,6 +50,87 @@ CompressionKind stringToCompressionKind(const std::string& kind);
 
 constexpr uint64_t DEFAULT_COMPRESSION_BLOCK_SIZE = 256 * 1024;
 
+/// Options for making a BlockCodec.
+struct BlockCodecOptions {
+  /// Lets the codec pick its default level.
+  static constexpr int32_t kDefaultLevel = -1;
+
+  int32_t level{kDefaultLevel};
+
+  /// For ZLIB and GZIP, the zlib window bits, which also select the framing:
+  /// negative for raw deflate as in DWRF and ORC, 8 to 15 for the zlib format
+  /// and 16 more for gzip.
+  int32_t windowBits{15};
+};
+
+/// Compresses and decompresses whole blocks in the format of a
+/// CompressionKind. Lets an external library, e.g. a hardware offload like
+/// Intel QAT or IAA, replace the built-in codecs without changing any file or
+/// page format: the output of compress() must be readable by the built-in
+/// codec of the same kind and options, and decompress() must read the output
+/// of the built-in codec. An instance is used by one thread at a time.
+class BlockCodec {
+ public:
+  /// One block of a batch.
+  struct Request {
+    const char* input;
+    uint64_t inputSize;
+    char* output;
+    uint64_t outputSize;
+    /// Set by the codec to the size written to 'output'. Stays std::nullopt if
+    /// a compressed block does not fit in 'outputSize'.
+    std::optional<uint64_t> resultSize;
+  };
+
+  virtual ~BlockCodec() = default;
+
+  /// Returns the largest compressed size of 'inputSize' bytes.
+  virtual uint64_t maxCompressedLength(uint64_t inputSize) const = 0;
+
+  /// Compresses 'inputSize' bytes at 'input' into 'output'. Returns the
+  /// compressed size or std::nullopt if it would exceed 'outputSize'.
+  virtual std::optional<uint64_t> compress(
+      const char* input,
+      uint64_t inputSize,
+      char* output,
+      uint64_t outputSize) = 0;
+
+  /// Decompresses 'inputSize' bytes at 'input' into 'output'. Returns the
+  /// decompressed size. Throws if the input is corrupt or does not fit.
+  virtual uint64_t decompress(
+      const char* input,
+      uint64_t inputSize,
+      char* output,
+      uint64_t outputSize) = 0;
+
+  /// Compresses or, if 'compress' is false, decompresses all of 'requests'.
+  /// The future is fulfilled when all are done. An offload backend overrides
+  /// this to have all the requests in flight at the same time. The default
+  /// runs them one after the other on the caller thread. 'requests' and their
+  /// buffers must stay valid until the future is fulfilled.
+  virtual folly::SemiFuture<folly::Unit> submit(
+      bool compress,
+      folly::Range<Request*> requests);
+};
+
+/// Makes a BlockCodec for 'kind' and 'options', or returns nullptr if it does
+/// not support them, in which case the built-in codec is used.
+using BlockCodecFactory = std::function<std::unique_ptr<BlockCodec>(
+    CompressionKind kind,
+    const BlockCodecOptions& options)>;
+
+/// Registers 'factory' to make the codecs of 'kind' for compressionKindToCodec,
+/// the DWIO compressors and decompressors, and everything built on them like
+/// spilling and the exchange. Replaces the previous factory of 'kind'. A
+/// nullptr factory restores the built-in codec.
+void registerBlockCodecFactory(CompressionKind kind, BlockCodecFactory factory);
+
+/// Returns a codec from the factory registered for 'kind', or nullptr if none
+/// is registered or the factory does not support 'options'.
+std::unique_ptr<BlockCodec> makeBlockCodec(
+    CompressionKind kind,
+    const BlockCodecOptions& options);
+
 } // namespace facebook::velox::common
 
 template <>
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+
+class ZstdDictionaryCodec : public folly::io::Codec {
+ public:
+  explicit ZstdDictionaryCodec(std::shared_ptr<const ZstdDictionary> dictionary)
+      : Codec(folly::io::CodecType::ZSTD),
+        dictionary_(std::move(dictionary)),
+        compressContext_(ZSTD_createCCtx()),
+        decompressContext_(ZSTD_createDCtx()) {
+    VELOX_CHECK_NOT_NULL(compressContext_);
+    VELOX_CHECK_NOT_NULL(decompressContext_);
+  }
+
+  ~ZstdDictionaryCodec() override {
+    ZSTD_freeCCtx(compressContext_);
+    ZSTD_freeDCtx(decompressContext_);
+  }
+
+ private:
+  bool doNeedsUncompressedLength() const override {
+    return true;
+  }
+
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override {
+    return ZSTD_compressBound(uncompressedLength);
+  }
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override {
+    const auto input = data->cloneCoalescedAsValue();
+    auto output = folly::IOBuf::create(ZSTD_compressBound(input.length()));
+    const auto size = ZSTD_compress_usingCDict(
+        compressContext_,
+        output->writableData(),
+        output->capacity(),
+        input.data(),
+        input.length(),
+        dictionary_->compressDict_);
+    VELOX_CHECK(
+        !ZSTD_isError(size),
+        "ZSTD dictionary compression failed: {}",
+        ZSTD_getErrorName(size));
+    output->append(size);
+    return output;
+  }
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override {
+    VELOX_CHECK(
+        uncompressedLength.has_value(),
+        "ZSTD dictionary decompression needs the uncompressed length");
+    const auto input = data->cloneCoalescedAsValue();
+    auto output = folly::IOBuf::create(uncompressedLength.value());
+    const auto size = ZSTD_decompress_usingDDict(
+        decompressContext_,
+        output->writableData(),
+        uncompressedLength.value(),
+        input.data(),
+        input.length(),
+        dictionary_->decompressDict_);
+    VELOX_CHECK(
+        !ZSTD_isError(size),
+        "ZSTD dictionary decompression failed: {}",
+        ZSTD_getErrorName(size));
+    VELOX_CHECK_EQ(size, uncompressedLength.value());
+    output->append(size);
+    return output;
+  }
+
+  const std::shared_ptr<const ZstdDictionary> dictionary_;
+  ZSTD_CCtx* const compressContext_;
+  ZSTD_DCtx* const decompressContext_;
+};
+
+// static
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::train(
+    const std::vector<std::string_view>& samples,
+    size_t maxBytes,
+    int32_t level) {
+  VELOX_CHECK_GT(maxBytes, 0);
+  std::string buffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    buffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+  std::string bytes(maxBytes, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      bytes.data(),
+      bytes.size(),
+      buffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    return nullptr;
+  }
+  bytes.resize(size);
+  return create(std::move(bytes), level);
+}
+
+// static
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::create(
+    std::string bytes,
+    int32_t level) {
+  return std::make_shared<const ZstdDictionary>(std::move(bytes), level);
+}
+
+ZstdDictionary::ZstdDictionary(std::string bytes, int32_t level)
+    : bytes_(std::move(bytes)),
+      id_(ZDICT_getDictID(bytes_.data(), bytes_.size())),
+      compressDict_(ZSTD_createCDict(bytes_.data(), bytes_.size(), level)),
+      decompressDict_(ZSTD_createDDict(bytes_.data(), bytes_.size())) {
+  VELOX_CHECK_NOT_NULL(compressDict_);
+  VELOX_CHECK_NOT_NULL(decompressDict_);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(compressDict_);
+  ZSTD_freeDDict(decompressDict_);
+}
+
+std::unique_ptr<folly::io::Codec> ZstdDictionary::makeCodec() const {
+  return std::make_unique<ZstdDictionaryCodec>(shared_from_this());
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/compression/Compression.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// A trained ZSTD dictionary. Small pages compress poorly on their own since
+/// each has to build up its own history and entropy tables. A dictionary
+/// trained on pages like them gives every page that history up front. The
+/// same dictionary must be used for compressing and decompressing. The ZSTD
+/// frames carry the dictionary id, so decompressing with another dictionary
+/// fails instead of returning garbage.
+class ZstdDictionary : public std::enable_shared_from_this<ZstdDictionary> {
+ public:
+  static constexpr int32_t kDefaultLevel = 3;
+
+  /// Trains a dictionary of at most 'maxBytes' from 'samples'. Returns
+  /// nullptr if ZSTD cannot train one, e.g. because the samples are too few
+  /// or too small. zstd recommends samples of about 100x 'maxBytes' in total.
+  static std::shared_ptr<const ZstdDictionary> train(
+      const std::vector<std::string_view>& samples,
+      size_t maxBytes,
+      int32_t level = kDefaultLevel);
+
+  /// Makes a dictionary from the bytes() of a trained one.
+  static std::shared_ptr<const ZstdDictionary> create(
+      std::string bytes,
+      int32_t level = kDefaultLevel);
+
+  ZstdDictionary(std::string bytes, int32_t level);
+
+  ~ZstdDictionary();
+
+  /// The id recorded in the frames compressed with the dictionary.
+  uint32_t id() const {
+    return id_;
+  }
+
+  /// The dictionary contents, for shipping it to a reader.
+  const std::string& bytes() const {
+    return bytes_;
+  }
+
+  /// Returns a ZSTD codec that compresses and decompresses with this
+  /// dictionary. The codec needs the uncompressed length for decompressing.
+  /// A codec is not thread safe but any number of codecs may share the
+  /// dictionary.
+  std::unique_ptr<folly::io::Codec> makeCodec() const;
+
+ private:
+  friend class ZstdDictionaryCodec;
+
+  const std::string bytes_;
+  const uint32_t id_;
+  ZSTD_CDict_s* const compressDict_;
+  ZSTD_DDict_s* const decompressDict_;
+};
+
+} // namespace facebook::velox::common
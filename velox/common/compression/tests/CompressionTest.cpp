@@ -19,8 +19,54 @@
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 
 namespace facebook::velox::common {
+namespace {
+// Compresses with the folly zstd codec and counts the calls, like an offload
+// backend that produces the standard format.
+class CountingZstdCodec : public BlockCodec {
+ public:
+  explicit CountingZstdCodec(int32_t* numCalls)
+      : numCalls_(numCalls),
+        codec_(folly::io::getCodec(folly::io::CodecType::ZSTD)) {}
+
+  uint64_t maxCompressedLength(uint64_t inputSize) const override {
+    return codec_->maxCompressedLength(inputSize);
+  }
+
+  std::optional<uint64_t> compress(
+      const char* input,
+      uint64_t inputSize,
+      char* output,
+      uint64_t outputSize) override {
+    ++*numCalls_;
+    const auto compressed =
+        codec_->compress(folly::StringPiece(input, inputSize));
+    if (compressed.size() > outputSize) {
+      return std::nullopt;
+    }
+    memcpy(output, compressed.data(), compressed.size());
+    return compressed.size();
+  }
+
+  uint64_t decompress(
+      const char* input,
+      uint64_t inputSize,
+      char* output,
+      uint64_t outputSize) override {
+    ++*numCalls_;
+    const auto data = codec_->uncompress(folly::StringPiece(input, inputSize));
+    VELOX_CHECK_LE(data.size(), outputSize);
+    memcpy(output, data.data(), data.size());
+    return data.size();
+  }
+
+ private:
+  int32_t* const numCalls_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+};
+} // namespace
 
 class CompressionTest : public testing::Test {};
 
@@ -59,4 +105,129 @@ TEST_F(CompressionTest, stringToCompressionKind) {
   VELOX_ASSERT_THROW(
       stringToCompressionKind("bz2"), "Not support compression kind bz2");
 }
+
+TEST_F(CompressionTest, blockCodec) {
+  int32_t numCalls = 0;
+  registerBlockCodecFactory(
+      CompressionKind_ZSTD,
+      [&](CompressionKind /*kind*/, const BlockCodecOptions& options)
+          -> std::unique_ptr<BlockCodec> {
+        // Only supports the default level.
+        if (options.level != BlockCodecOptions::kDefaultLevel) {
+          return nullptr;
+        }
+        return std::make_unique<CountingZstdCodec>(&numCalls);
+      });
+  EXPECT_EQ(nullptr, makeBlockCodec(CompressionKind_ZSTD, {3, 15}));
+  EXPECT_EQ(nullptr, makeBlockCodec(CompressionKind_LZ4, {}));
+
+  std::string data;
+  for (auto i = 0; i < 1'000; ++i) {
+    data += fmt::format("row {} of {};", i % 10, i % 7);
+  }
+  const auto input = folly::IOBuf::copyBuffer(data);
+  const auto builtIn = folly::io::getCodec(folly::io::CodecType::ZSTD);
+
+  // The plugged codec writes and reads the format of the built-in one.
+  auto codec = compressionKindToCodec(CompressionKind_ZSTD);
+  ASSERT_EQ(folly::io::CodecType::ZSTD, codec->type());
+  auto compressed = codec->compress(input.get());
+  EXPECT_EQ(1, numCalls);
+  EXPECT_EQ(
+      data,
+      builtIn->uncompress(compressed.get())->moveToFbString().toStdString());
+  compressed = builtIn->compress(input.get());
+  EXPECT_EQ(
+      data,
+      codec->uncompress(compressed.get(), data.size())
+          ->moveToFbString()
+          .toStdString());
+  EXPECT_EQ(2, numCalls);
+
+  // A batch of compressions and then of decompressions.
+  auto blockCodec = makeBlockCodec(CompressionKind_ZSTD, {});
+  ASSERT_NE(nullptr, blockCodec);
+  std::vector<std::string> compressedBlocks(3);
+  std::vector<BlockCodec::Request> requests;
+  for (auto i = 0; i < 3; ++i) {
+    compressedBlocks[i].resize(blockCodec->maxCompressedLength(data.size()));
+    requests.push_back(
+        {data.data(),
+         data.size() / 3 * (i + 1),
+         compressedBlocks[i].data(),
+         compressedBlocks[i].size(),
+         std::nullopt});
+  }
+  blockCodec->submit(true, folly::range(requests)).wait();
+  EXPECT_EQ(5, numCalls);
+  std::vector<std::string> decompressedBlocks(3);
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_TRUE(requests[i].resultSize.has_value());
+    decompressedBlocks[i].resize(data.size());
+    requests[i] = {
+        compressedBlocks[i].data(),
+        requests[i].resultSize.value(),
+        decompressedBlocks[i].data(),
+        decompressedBlocks[i].size(),
+        std::nullopt};
+  }
+  blockCodec->submit(false, folly::range(requests)).wait();
+  EXPECT_EQ(8, numCalls);
+  for (auto i = 0; i < 3; ++i) {
+    const auto size = data.size() / 3 * (i + 1);
+    ASSERT_EQ(size, requests[i].resultSize.value());
+    EXPECT_EQ(data.substr(0, size), decompressedBlocks[i].substr(0, size));
+  }
+
+  // Unregistering restores the built-in codec.
+  registerBlockCodecFactory(CompressionKind_ZSTD, nullptr);
+  EXPECT_EQ(nullptr, makeBlockCodec(CompressionKind_ZSTD, {}));
+  compressionKindToCodec(CompressionKind_ZSTD)->compress(input.get());
+  EXPECT_EQ(8, numCalls);
+}
+
+TEST_F(CompressionTest, zstdDictionary) {
+  // Small pages of similar rows.
+  auto makePage = [](int32_t seed) {
+    std::string page;
+    for (auto i = 0; i < 20; ++i) {
+      page += fmt::format(
+          "{{\"id\": {}, \"status\": \"{}\", \"region\": \"{}\"}}",
+          seed * 20 + i,
+          (seed + i) % 3 == 0 ? "shipped" : "pending",
+          (seed * i) % 2 == 0 ? "us-east" : "eu-west");
+    }
+    return page;
+  };
+  std::vector<std::string> pages;
+  for (auto i = 0; i < 1'000; ++i) {
+    pages.push_back(makePage(i));
+  }
+  std::vector<std::string_view> samples(pages.begin(), pages.end());
+  auto dictionary = ZstdDictionary::train(samples, 4 << 10);
+  ASSERT_NE(dictionary, nullptr);
+  EXPECT_NE(dictionary->id(), 0);
+  EXPECT_LE(dictionary->bytes().size(), 4 << 10);
+
+  auto codec = dictionary->makeCodec();
+  ASSERT_EQ(folly::io::CodecType::ZSTD, codec->type());
+  auto plainCodec = compressionKindToCodec(CompressionKind_ZSTD);
+  const auto page = makePage(2'000);
+  const auto input = folly::IOBuf::copyBuffer(page);
+  auto compressed = codec->compress(input.get());
+  EXPECT_LT(
+      compressed->computeChainDataLength(),
+      plainCodec->compress(input.get())->computeChainDataLength());
+  auto uncompressed = codec->uncompress(compressed.get(), page.size());
+  EXPECT_EQ(page, uncompressed->moveToFbString().toStdString());
+
+  // A dictionary made from the bytes of another reads the same data.
+  auto copy = ZstdDictionary::create(dictionary->bytes());
+  EXPECT_EQ(dictionary->id(), copy->id());
+  uncompressed = copy->makeCodec()->uncompress(compressed.get(), page.size());
+  EXPECT_EQ(page, uncompressed->moveToFbString().toStdString());
+
+  // Too little data to train on.
+  EXPECT_EQ(nullptr, ZstdDictionary::train({"abc", "abd"}, 4 << 10));
+}
 } // namespace facebook::velox::common
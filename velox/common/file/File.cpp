@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -209,6 +210,32 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto* ioUring = IoUring::instance();
+  if (ioUring == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  std::vector<IoUring::Request> requests;
+  IoUring::appendReads(fd_, offset, buffers, requests);
+  if (requests.empty()) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  return folly::collectAll(ioUring->submit(std::move(requests)))
+      .deferValue([](std::vector<folly::Try<uint64_t>>&& results) {
+        uint64_t totalBytesRead = 0;
+        for (auto& result : results) {
+          totalBytesRead += result.value();
+        }
+        return totalBytesRead;
+      });
+}
+
+bool LocalReadFile::hasPreadvAsync() const {
+  return IoUring::instance() != nullptr;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
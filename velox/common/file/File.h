@@ -247,6 +247,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  /// Submits the read to IoUring::instance() if available. The file must
+  /// outlive the returned future.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
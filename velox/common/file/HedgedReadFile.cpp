@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <algorithm>
+
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox {
+namespace {
+// Hedges the global budget can save up.
+constexpr int32_t kGlobalMaxBurst = 16;
+} // namespace
+
+ReadLatencyTracker::ReadLatencyTracker(int32_t percentile, int32_t numSamples)
+    : percentile_(percentile) {
+  VELOX_CHECK_GT(percentile_, 0);
+  VELOX_CHECK_LE(percentile_, 100);
+  VELOX_CHECK_GE(numSamples, kRecomputeInterval);
+  samples_.resize(numSamples);
+}
+
+void ReadLatencyTracker::record(uint64_t latencyUs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  samples_[numRecorded_ % samples_.size()] = latencyUs;
+  if (++numRecorded_ % kRecomputeInterval != 0) {
+    return;
+  }
+  auto sorted = samples_;
+  sorted.resize(std::min<uint64_t>(numRecorded_, samples_.size()));
+  const auto index =
+      std::min<size_t>(sorted.size() * percentile_ / 100, sorted.size() - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  percentileUs_ = sorted[index];
+}
+
+HedgeBudget::HedgeBudget(int32_t pct, int32_t maxBurst)
+    : pct_(pct), maxTokens_(maxBurst * 100LL), tokens_(0) {
+  VELOX_CHECK_GE(pct_, 0);
+  VELOX_CHECK_LE(pct_, 100);
+  VELOX_CHECK_GT(maxBurst, 0);
+}
+
+// static
+HedgeBudget& HedgeBudget::global() {
+  static HedgeBudget budget(
+      std::clamp(FLAGS_velox_hedged_read_budget_pct, 0, 100), kGlobalMaxBurst);
+  return budget;
+}
+
+void HedgeBudget::recordRead() {
+  if (pct_ == 0) {
+    return;
+  }
+  auto tokens = tokens_.load();
+  while (tokens < maxTokens_ &&
+         !tokens_.compare_exchange_weak(
+             tokens, std::min(maxTokens_, tokens + pct_))) {
+  }
+}
+
+bool HedgeBudget::tryAcquire() {
+  auto tokens = tokens_.load();
+  while (tokens >= 100) {
+    if (tokens_.compare_exchange_weak(tokens, tokens - 100)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> file,
+    folly::Executor* executor,
+    std::shared_ptr<ReadLatencyTracker> tracker,
+    HedgeBudget* budget,
+    const HedgedReadOptions& options)
+    : file_(std::move(file)),
+      executor_(executor),
+      tracker_(std::move(tracker)),
+      budget_(budget),
+      options_(options) {
+  VELOX_CHECK_NOT_NULL(file_);
+  VELOX_CHECK_NOT_NULL(tracker_);
+  VELOX_CHECK_NOT_NULL(budget_);
+}
+
+std::string_view
+HedgedReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  if (!hedgeable(length)) {
+    return file_->pread(offset, length, buf);
+  }
+  const auto result = readHedged(offset, length);
+  memcpy(buf, result->data(), length);
+  return {static_cast<char*>(buf), length};
+}
+
+std::string HedgedReadFile::pread(uint64_t offset, uint64_t length) const {
+  if (!hedgeable(length)) {
+    return file_->pread(offset, length);
+  }
+  return std::move(*readHedged(offset, length));
+}
+
+uint64_t HedgedReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  if (!hedgeable(length)) {
+    return file_->preadv(offset, buffers);
+  }
+  const auto result = readHedged(offset, length);
+  uint64_t resultOffset = 0;
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      memcpy(range.data(), result->data() + resultOffset, range.size());
+    }
+    resultOffset += range.size();
+  }
+  return length;
+}
+
+bool HedgedReadFile::hedgeable(uint64_t length) const {
+  return length > 0 && length <= options_.maxBytes &&
+      (executor_ != nullptr || file_->hasPreadvAsync());
+}
+
+std::shared_ptr<std::string> HedgedReadFile::readHedged(
+    uint64_t offset,
+    uint64_t length) const {
+  auto cancelled = std::make_shared<std::atomic_bool>(false);
+  budget_->recordRead();
+  auto primary = startAttempt(offset, length, cancelled);
+  const auto delayUs = std::max(options_.minDelayUs, tracker_->percentileUs());
+  primary.wait(std::chrono::microseconds(delayUs));
+  if (primary.isReady() || !budget_->tryAcquire()) {
+    return std::move(primary).get();
+  }
+  RECORD_METRIC_VALUE(kMetricHedgedReadCount);
+  std::vector<folly::SemiFuture<std::shared_ptr<std::string>>> attempts;
+  attempts.push_back(std::move(primary));
+  attempts.push_back(startAttempt(offset, length, cancelled));
+  // Fails only if both attempts fail.
+  auto winner =
+      folly::collectAnyWithoutException(attempts.begin(), attempts.end())
+          .get();
+  *cancelled = true;
+  if (winner.first == 1) {
+    RECORD_METRIC_VALUE(kMetricHedgedReadWinCount);
+  }
+  return std::move(winner.second);
+}
+
+folly::SemiFuture<std::shared_ptr<std::string>> HedgedReadFile::startAttempt(
+    uint64_t offset,
+    uint64_t length,
+    std::shared_ptr<std::atomic_bool> cancelled) const {
+  // The attempt holds the file and the tracker, so that a loser can outlive
+  // 'this'.
+  auto file = file_;
+  auto tracker = tracker_;
+  if (file->hasPreadvAsync()) {
+    auto buffer = std::make_shared<std::string>(length, 0);
+    const auto startUs = getCurrentTimeMicro();
+    return file
+        ->preadvAsync(offset, {folly::Range<char*>(buffer->data(), length)})
+        .deferValue([file, tracker, buffer, startUs](uint64_t /*unused*/) {
+          tracker->record(getCurrentTimeMicro() - startUs);
+          return buffer;
+        });
+  }
+  return folly::via(
+             executor_,
+             [file, tracker, offset, length, cancelled]() {
+               VELOX_CHECK(!*cancelled, "Hedged read attempt cancelled");
+               auto buffer = std::make_shared<std::string>(length, 0);
+               uint64_t latencyUs{0};
+               {
+                 MicrosecondTimer timer(&latencyUs);
+                 file->pread(offset, length, buffer->data());
+               }
+               tracker->record(latencyUs);
+               return buffer;
+             })
+      .semi();
+}
+
+} // namespace facebook::velox
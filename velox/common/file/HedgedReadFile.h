@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <folly/Executor.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/file/File.h"
+
+DECLARE_int32(velox_hedged_read_budget_pct);
+
+namespace facebook::velox {
+
+/// Learns the latency after which a read is hedged from the 'percentile' of
+/// the last 'numSamples' read latencies. Shared by the files of a file
+/// system, since the files themselves are short lived. Thread safe.
+class ReadLatencyTracker {
+ public:
+  static constexpr int32_t kDefaultPercentile = 95;
+  static constexpr int32_t kDefaultNumSamples = 1024;
+
+  explicit ReadLatencyTracker(
+      int32_t percentile = kDefaultPercentile,
+      int32_t numSamples = kDefaultNumSamples);
+
+  void record(uint64_t latencyUs);
+
+  /// Returns the latency percentile, or 0 until enough latencies have been
+  /// recorded.
+  uint64_t percentileUs() const {
+    return percentileUs_;
+  }
+
+ private:
+  // Number of records between recomputing 'percentileUs_'.
+  static constexpr int32_t kRecomputeInterval = 64;
+
+  const int32_t percentile_;
+  std::mutex mutex_;
+  // Ring of the last latencies.
+  std::vector<uint64_t> samples_;
+  uint64_t numRecorded_{0};
+  std::atomic<uint64_t> percentileUs_{0};
+};
+
+/// Bounds the hedged reads to a percentage of all reads, so that hedging
+/// does not multiply the load on a store that is slow for everybody. Each
+/// read earns 'pct' hundredths of a hedge and a hedge costs a whole one.
+/// At most 'maxBurst' hedges can be saved up. Thread safe.
+class HedgeBudget {
+ public:
+  HedgeBudget(int32_t pct, int32_t maxBurst);
+
+  /// Returns the process wide budget. Its percentage is
+  /// FLAGS_velox_hedged_read_budget_pct.
+  static HedgeBudget& global();
+
+  void recordRead();
+
+  /// Returns true and takes a hedge from the budget if one is available.
+  bool tryAcquire();
+
+ private:
+  const int32_t pct_;
+  const int64_t maxTokens_;
+  // Hundredths of hedges available.
+  std::atomic<int64_t> tokens_;
+};
+
+struct HedgedReadOptions {
+  /// Reads wait at least this long before they are hedged. Also the delay
+  /// until the tracker knows the latency percentile.
+  uint64_t minDelayUs{20'000};
+  /// Larger reads are not hedged, the duplicate would cost too much.
+  uint64_t maxBytes{16 << 20};
+};
+
+/// Wraps a ReadFile of an object store whose reads have heavy tails. A read
+/// that takes longer than the tracker's latency percentile is issued a
+/// second time and the first result wins. The loser is cancelled if it has
+/// not started yet, otherwise its result is dropped when it completes. Each
+/// attempt reads into its own buffer and the winner is copied to the
+/// caller's, so that a late loser never writes into memory the caller has
+/// reused. Hedging applies to the synchronous reads. The asynchronous reads
+/// are passed through.
+class HedgedReadFile : public ReadFile {
+ public:
+  /// 'executor' runs the attempts of 'file' that is not itself asynchronous.
+  /// 'budget' is usually HedgeBudget::global().
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      folly::Executor* executor,
+      std::shared_ptr<ReadLatencyTracker> tracker,
+      HedgeBudget* budget,
+      const HedgedReadOptions& options = {});
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override;
+
+  std::string pread(uint64_t offset, uint64_t length) const override;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    return file_->preadvAsync(offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return file_->hasPreadvAsync();
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  /// Includes the bytes of the hedges.
+  uint64_t bytesRead() const override {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() override {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+  const std::shared_ptr<ReadFile>& file() const {
+    return file_;
+  }
+
+ private:
+  // Returns true if a read of 'length' bytes is hedged.
+  bool hedgeable(uint64_t length) const;
+
+  // Reads 'length' bytes at 'offset' with hedging and returns the winning
+  // attempt's buffer.
+  std::shared_ptr<std::string> readHedged(uint64_t offset, uint64_t length)
+      const;
+
+  // Starts a read of 'length' bytes at 'offset' into a buffer of its own.
+  // Does nothing if 'cancelled' is set before the read starts.
+  folly::SemiFuture<std::shared_ptr<std::string>> startAttempt(
+      uint64_t offset,
+      uint64_t length,
+      std::shared_ptr<std::atomic_bool> cancelled) const;
+
+  const std::shared_ptr<ReadFile> file_;
+  folly::Executor* const executor_;
+  const std::shared_ptr<ReadLatencyTracker> tracker_;
+  HedgeBudget* const budget_;
+  const HedgedReadOptions options_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <glog/logging.h>
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace facebook::velox {
+namespace {
+constexpr size_t kDroppedBytesSize = 16 << 10;
+
+// Returns the sink for the skipped ranges of reads. Aligned so that it can be
+// read into with O_DIRECT. Never freed since reads in flight may write into
+// it.
+char* droppedBytes() {
+  static char* const bytes =
+      static_cast<char*>(aligned_alloc(4096, kDroppedBytesSize));
+  return bytes;
+}
+} // namespace
+
+#ifdef VELOX_ENABLE_IO_URING
+class IoUring::Impl {
+ public:
+  explicit Impl(int32_t queueDepth) : queueDepth_(queueDepth) {
+    VELOX_CHECK_GT(queueDepth_, 0);
+    const auto rc = io_uring_queue_init(queueDepth_, &ring_, 0);
+    VELOX_CHECK_EQ(
+        rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+    reaper_ = std::thread([this]() { reap(); });
+  }
+
+  ~Impl() {
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      inflightCv_.wait(l, [&]() { return numInflight_ == 0; });
+      // A nop without data tells the reaper to exit.
+      auto* sqe = io_uring_get_sqe(&ring_);
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      submitLocked();
+    }
+    reaper_.join();
+    io_uring_queue_exit(&ring_);
+  }
+
+  void registerBuffers(const std::vector<folly::Range<char*>>& buffers) {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_EQ(
+        numInflight_, 0, "Cannot register io_uring buffers with I/O in flight");
+    if (!registered_.empty()) {
+      io_uring_unregister_buffers(&ring_);
+      registered_.clear();
+    }
+    if (buffers.empty()) {
+      return;
+    }
+    for (const auto& buffer : buffers) {
+      registered_.push_back({buffer.data(), buffer.size()});
+    }
+    const auto rc = io_uring_register_buffers(
+        &ring_, registered_.data(), registered_.size());
+    if (rc < 0) {
+      registered_.clear();
+      VELOX_FAIL("io_uring_register_buffers failed: {}", folly::errnoStr(-rc));
+    }
+  }
+
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      std::vector<Request> requests) {
+    std::vector<folly::SemiFuture<uint64_t>> futures;
+    futures.reserve(requests.size());
+    std::unique_lock<std::mutex> l(mutex_);
+    for (auto& request : requests) {
+      auto pending = std::make_unique<Pending>();
+      pending->request = std::move(request);
+      futures.push_back(pending->promise.getSemiFuture());
+      if (numInflight_ == queueDepth_) {
+        // Start what is queued so far before waiting for completions.
+        submitLocked();
+        inflightCv_.wait(l, [&]() { return numInflight_ < queueDepth_; });
+      }
+      ++numInflight_;
+      queueLocked(std::move(pending));
+    }
+    submitLocked();
+    return futures;
+  }
+
+ private:
+  struct Pending {
+    Request request;
+    // Bytes transferred so far.
+    uint64_t bytes{0};
+    folly::Promise<uint64_t> promise;
+  };
+
+  // Returns the index of the registered buffer that contains 'iov' or -1.
+  int32_t registeredIndex(const iovec& iov) const {
+    const auto* begin = static_cast<const char*>(iov.iov_base);
+    for (auto i = 0; i < registered_.size(); ++i) {
+      const auto* registered =
+          static_cast<const char*>(registered_[i].iov_base);
+      if (begin >= registered &&
+          begin + iov.iov_len <= registered + registered_[i].iov_len) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // Adds 'pending' to the submission queue. The caller accounts it in
+  // 'numInflight_', which bounds the unsubmitted entries, so a free entry is
+  // always available.
+  void queueLocked(std::unique_ptr<Pending> pending) {
+    auto* sqe = io_uring_get_sqe(&ring_);
+    VELOX_CHECK_NOT_NULL(sqe);
+    const auto& request = pending->request;
+    const auto fixedIndex =
+        request.iovecs.size() == 1 ? registeredIndex(request.iovecs[0]) : -1;
+    if (fixedIndex >= 0) {
+      const auto& iov = request.iovecs[0];
+      if (request.write) {
+        io_uring_prep_write_fixed(
+            sqe,
+            request.fd,
+            iov.iov_base,
+            iov.iov_len,
+            request.offset,
+            fixedIndex);
+      } else {
+        io_uring_prep_read_fixed(
+            sqe,
+            request.fd,
+            iov.iov_base,
+            iov.iov_len,
+            request.offset,
+            fixedIndex);
+      }
+    } else if (request.write) {
+      io_uring_prep_writev(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    } else {
+      io_uring_prep_readv(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    }
+    io_uring_sqe_set_data(sqe, pending.release());
+  }
+
+  // Hands the queued entries to the kernel.
+  void submitLocked() {
+    for (;;) {
+      const auto rc = io_uring_submit(&ring_);
+      if (rc >= 0) {
+        return;
+      }
+      VELOX_CHECK(
+          rc == -EINTR || rc == -EAGAIN || rc == -EBUSY,
+          "io_uring_submit failed: {}",
+          folly::errnoStr(-rc));
+      std::this_thread::yield();
+    }
+  }
+
+  void resubmit(std::unique_ptr<Pending> pending) {
+    std::lock_guard<std::mutex> l(mutex_);
+    queueLocked(std::move(pending));
+    submitLocked();
+  }
+
+  // Consumes 'bytes' from the front of 'request'. Returns true if bytes
+  // remain to be transferred.
+  static bool advance(Request& request, uint64_t bytes) {
+    request.offset += bytes;
+    auto& iovecs = request.iovecs;
+    size_t numDone = 0;
+    while (numDone < iovecs.size() && bytes >= iovecs[numDone].iov_len) {
+      bytes -= iovecs[numDone].iov_len;
+      ++numDone;
+    }
+    iovecs.erase(iovecs.begin(), iovecs.begin() + numDone);
+    if (iovecs.empty()) {
+      return false;
+    }
+    iovecs[0].iov_base = static_cast<char*>(iovecs[0].iov_base) + bytes;
+    iovecs[0].iov_len -= bytes;
+    return true;
+  }
+
+  void complete(std::unique_ptr<Pending> pending, int32_t result) {
+    if (result == -EINTR || result == -EAGAIN) {
+      resubmit(std::move(pending));
+      return;
+    }
+    if (result > 0) {
+      pending->bytes += result;
+      if (advance(pending->request, result)) {
+        resubmit(std::move(pending));
+        return;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      --numInflight_;
+    }
+    inflightCv_.notify_all();
+    const auto& request = pending->request;
+    // A read of 0 bytes is the end of the file. A write of 0 bytes with bytes
+    // left is an error.
+    const bool failed =
+        result < 0 || (result == 0 && request.write && !request.iovecs.empty());
+    pending->promise.setTry(folly::makeTryWith([&]() -> uint64_t {
+      VELOX_CHECK(
+          !failed,
+          "io_uring {} of fd {} at offset {} failed: {}",
+          request.write ? "write" : "read",
+          request.fd,
+          request.offset,
+          result < 0 ? folly::errnoStr(-result) : "short write");
+      return pending->bytes;
+    }));
+  }
+
+  void reap() {
+    for (;;) {
+      io_uring_cqe* cqe;
+      const auto rc = io_uring_wait_cqe(&ring_, &cqe);
+      if (rc == -EINTR) {
+        continue;
+      }
+      VELOX_CHECK_EQ(
+          rc, 0, "io_uring_wait_cqe failed: {}", folly::errnoStr(-rc));
+      auto* pending = static_cast<Pending*>(io_uring_cqe_get_data(cqe));
+      const auto result = cqe->res;
+      io_uring_cqe_seen(&ring_, cqe);
+      if (pending == nullptr) {
+        return;
+      }
+      complete(std::unique_ptr<Pending>(pending), result);
+    }
+  }
+
+  const int32_t queueDepth_;
+  io_uring ring_;
+  // Serializes the access to the submission queue and 'registered_'.
+  std::mutex mutex_;
+  std::condition_variable inflightCv_;
+  int32_t numInflight_{0};
+  std::vector<iovec> registered_;
+  std::thread reaper_;
+};
+#else
+class IoUring::Impl {
+ public:
+  explicit Impl(int32_t /*queueDepth*/) {
+    VELOX_UNSUPPORTED("Velox is built without io_uring support");
+  }
+
+  void registerBuffers(const std::vector<folly::Range<char*>>& /*buffers*/) {
+    VELOX_UNREACHABLE();
+  }
+
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      std::vector<Request> /*requests*/) {
+    VELOX_UNREACHABLE();
+  }
+};
+#endif
+
+IoUring::IoUring(int32_t queueDepth)
+    : impl_(std::make_unique<Impl>(queueDepth)) {}
+
+IoUring::~IoUring() = default;
+
+// static
+IoUring* IoUring::instance() {
+#ifdef VELOX_ENABLE_IO_URING
+  static IoUring* const instance = []() -> IoUring* {
+    if (FLAGS_velox_io_uring_queue_depth <= 0) {
+      return nullptr;
+    }
+    try {
+      return new IoUring(FLAGS_velox_io_uring_queue_depth);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available: " << e.what();
+      return nullptr;
+    }
+  }();
+  return instance;
+#else
+  return nullptr;
+#endif
+}
+
+void IoUring::registerBuffers(const std::vector<folly::Range<char*>>& buffers) {
+  impl_->registerBuffers(buffers);
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::submit(
+    std::vector<Request> requests) {
+  return impl_->submit(std::move(requests));
+}
+
+// static
+void IoUring::appendReads(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    std::vector<Request>& requests) {
+  Request request{fd, false, offset, {}};
+  uint64_t requestBytes = 0;
+  auto addIovec = [&](char* data, size_t size) {
+    if (request.iovecs.size() >= IOV_MAX) {
+      const auto nextOffset = request.offset + requestBytes;
+      requests.push_back(std::move(request));
+      request = Request{fd, false, nextOffset, {}};
+      requestBytes = 0;
+    }
+    request.iovecs.push_back({data, size});
+    requestBytes += size;
+  };
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      addIovec(range.data(), range.size());
+      continue;
+    }
+    auto skipSize = range.size();
+    while (skipSize > 0) {
+      const auto bytes = std::min(kDroppedBytesSize, skipSize);
+      addIovec(droppedBytes(), bytes);
+      skipSize -= bytes;
+    }
+  }
+  if (!request.iovecs.empty()) {
+    requests.push_back(std::move(request));
+  }
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+#include <folly/portability/SysUio.h>
+#include <gflags/gflags.h>
+
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+
+/// Asynchronous positional reads and writes through a Linux io_uring
+/// instance. Requests are queued to the submission ring under a mutex and a
+/// dedicated thread reaps the completions and fulfills the futures, so no
+/// executor thread blocks while the I/O is in flight. Short transfers are
+/// resubmitted for the remaining bytes.
+///
+/// Only available if Velox is built with VELOX_ENABLE_IO_URING. Otherwise
+/// instance() returns nullptr and the constructor throws.
+class IoUring {
+ public:
+  /// One readv or writev of 'iovecs' at 'offset' of 'fd'.
+  struct Request {
+    int32_t fd;
+    bool write{false};
+    uint64_t offset;
+    std::vector<iovec> iovecs;
+  };
+
+  /// Creates a ring with 'queueDepth' submission queue entries. At most
+  /// 'queueDepth' requests are in flight at any time, further submissions
+  /// wait for completions.
+  explicit IoUring(int32_t queueDepth);
+
+  ~IoUring();
+
+  /// Returns the process wide instance, or nullptr if io_uring is not
+  /// compiled in, disabled by FLAGS_velox_io_uring_queue_depth being 0 or not
+  /// supported by the kernel.
+  static IoUring* instance();
+
+  /// Registers 'buffers' with the kernel so that requests with a single
+  /// iovec inside one of them are issued as fixed buffer reads and writes,
+  /// which skip pinning the pages on each request. Replaces any previous
+  /// registration. The memory is pinned for as long as it is registered, so
+  /// this is meant for long lived I/O buffers, not for general cache memory.
+  void registerBuffers(const std::vector<folly::Range<char*>>& buffers);
+
+  /// Submits 'requests' with a single system call and returns a future per
+  /// request with the number of bytes transferred. A future fails if its
+  /// request fails. A read stops short only at the end of the file.
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      std::vector<Request> requests);
+
+  /// Appends to 'requests' the reads of 'buffers' from consecutive positions
+  /// of 'fd' starting at 'offset'. A range with nullptr data skips its size
+  /// in the file. Splits the reads so that no request exceeds IOV_MAX
+  /// iovecs.
+  static void appendReads(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      std::vector<Request>& requests);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace facebook::velox
@@ -19,6 +19,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -87,6 +88,14 @@ void readData(ReadFile* readFile, bool checkFileSize = true) {
   ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
   ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
   ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  memset(head, 0, sizeof(head));
+  memset(middle, 0, sizeof(middle));
+  memset(tail, 0, sizeof(tail));
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
 }
 
 // We could templated this test, but that's kinda overkill for how simple it is.
@@ -697,3 +706,81 @@ TEST_F(FaultyFsTest, fileWriteFaultHookInjection) {
     fs_->remove(path2);
   }
 }
+
+TEST(IoUringTest, appendReads) {
+  char data[10];
+  // A gap larger than IOV_MAX skipped-byte iovecs forces a split.
+  const uint64_t gap = (IOV_MAX + 10) * (16 << 10);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data, sizeof(data)),
+      folly::Range<char*>(nullptr, (char*)gap),
+      folly::Range<char*>(data, sizeof(data))};
+  std::vector<IoUring::Request> requests;
+  IoUring::appendReads(3, 100, buffers, requests);
+  ASSERT_EQ(requests.size(), 2);
+  uint64_t offset = 100;
+  for (const auto& request : requests) {
+    ASSERT_EQ(request.fd, 3);
+    ASSERT_FALSE(request.write);
+    ASSERT_EQ(request.offset, offset);
+    ASSERT_LE(request.iovecs.size(), IOV_MAX);
+    for (const auto& iov : request.iovecs) {
+      offset += iov.iov_len;
+    }
+  }
+  ASSERT_EQ(offset, 100 + 2 * sizeof(data) + gap);
+  ASSERT_EQ(requests[0].iovecs[0].iov_base, data);
+  ASSERT_EQ(requests[1].iovecs.back().iov_base, data);
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+TEST(IoUringTest, readWrite) {
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto fd = open(tempFile->getPath().c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  IoUring ioUring(4);
+  constexpr int32_t kNumRequests = 16;
+  constexpr int32_t kSize = 4096;
+  std::vector<std::string> writes;
+  std::vector<IoUring::Request> requests;
+  for (auto i = 0; i < kNumRequests; ++i) {
+    writes.push_back(std::string(kSize, 'a' + i));
+    requests.push_back(
+        {fd,
+         true,
+         static_cast<uint64_t>(i * kSize),
+         {{writes[i].data(), kSize}}});
+  }
+  for (auto& future : ioUring.submit(std::move(requests))) {
+    ASSERT_EQ(std::move(future).get(), kSize);
+  }
+
+  // Reads into a registered buffer are issued as fixed buffer reads. The last
+  // read stops at the end of the file.
+  std::string readBuffer(kNumRequests * kSize + 100, 0);
+  ioUring.registerBuffers(
+      {folly::Range<char*>(readBuffer.data(), readBuffer.size())});
+  requests.clear();
+  for (auto i = 0; i < kNumRequests; ++i) {
+    const auto size = i == kNumRequests - 1 ? kSize + 100 : kSize;
+    requests.push_back(
+        {fd,
+         false,
+         static_cast<uint64_t>(i * kSize),
+         {{readBuffer.data() + i * kSize, static_cast<size_t>(size)}}});
+  }
+  for (auto& future : ioUring.submit(std::move(requests))) {
+    ASSERT_EQ(std::move(future).get(), kSize);
+  }
+  for (auto i = 0; i < kNumRequests; ++i) {
+    ASSERT_EQ(readBuffer.substr(i * kSize, kSize), writes[i]);
+  }
+  ioUring.registerBuffers({});
+
+  requests.clear();
+  requests.push_back({-1, false, 0, {{readBuffer.data(), kSize}}});
+  auto futures = ioUring.submit(std::move(requests));
+  VELOX_ASSERT_THROW(std::move(futures[0]).get(), "io_uring read of fd -1");
+  close(fd);
+}
+#endif
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::velox;
+
+namespace {
+
+// Sleeps for 'delay' in the reads listed in 'slowReads', counting from 0.
+class SlowReadFile : public InMemoryReadFile {
+ public:
+  SlowReadFile(
+      std::string data,
+      std::chrono::milliseconds delay,
+      std::vector<int32_t> slowReads)
+      : InMemoryReadFile(std::move(data)),
+        delay_(delay),
+        slowReads_(std::move(slowReads)) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override {
+    const auto read = numReads_++;
+    if (std::find(slowReads_.begin(), slowReads_.end(), read) !=
+        slowReads_.end()) {
+      std::this_thread::sleep_for(delay_);
+    }
+    return InMemoryReadFile::pread(offset, length, buf);
+  }
+
+  int32_t numReads() const {
+    return numReads_;
+  }
+
+ private:
+  const std::chrono::milliseconds delay_;
+  const std::vector<int32_t> slowReads_;
+  mutable std::atomic<int32_t> numReads_{0};
+};
+
+// Reads asynchronously on 'executor'. Sleeps for 'delay' in the reads
+// listed in 'slowReads', counting from 0.
+class SlowAsyncReadFile : public InMemoryReadFile {
+ public:
+  SlowAsyncReadFile(
+      std::string data,
+      folly::Executor* executor,
+      std::chrono::milliseconds delay,
+      std::vector<int32_t> slowReads)
+      : InMemoryReadFile(std::move(data)),
+        executor_(executor),
+        delay_(delay),
+        slowReads_(std::move(slowReads)) {}
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    const auto read = numAsyncReads_++;
+    const bool slow = std::find(slowReads_.begin(), slowReads_.end(), read) !=
+        slowReads_.end();
+    return folly::via(
+               executor_,
+               [this, offset, buffers, slow]() {
+                 if (slow) {
+                   std::this_thread::sleep_for(delay_);
+                 }
+                 return preadv(offset, buffers);
+               })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
+  }
+
+  int32_t numAsyncReads() const {
+    return numAsyncReads_;
+  }
+
+ private:
+  folly::Executor* const executor_;
+  const std::chrono::milliseconds delay_;
+  const std::vector<int32_t> slowReads_;
+  mutable std::atomic<int32_t> numAsyncReads_{0};
+};
+
+std::string testData() {
+  std::string data(1 << 16, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i % 251;
+  }
+  return data;
+}
+
+class HedgedReadFileTest : public testing::Test {
+ protected:
+  static constexpr HedgedReadOptions kOptions{100'000, 16 << 20};
+
+  folly::CPUThreadPoolExecutor executor_{4};
+  std::shared_ptr<ReadLatencyTracker> tracker_{
+      std::make_shared<ReadLatencyTracker>()};
+};
+
+TEST_F(HedgedReadFileTest, latencyTracker) {
+  ReadLatencyTracker tracker(90, 64);
+  for (auto i = 1; i < 64; ++i) {
+    tracker.record(i);
+  }
+  // The percentile is computed every 64 records.
+  EXPECT_EQ(tracker.percentileUs(), 0);
+  tracker.record(64);
+  EXPECT_EQ(tracker.percentileUs(), 58);
+  // The newer latencies replace the older ones.
+  for (auto i = 0; i < 64; ++i) {
+    tracker.record(1'000);
+  }
+  EXPECT_EQ(tracker.percentileUs(), 1'000);
+}
+
+TEST_F(HedgedReadFileTest, budget) {
+  HedgeBudget budget(50, 2);
+  EXPECT_FALSE(budget.tryAcquire());
+  budget.recordRead();
+  EXPECT_FALSE(budget.tryAcquire());
+  budget.recordRead();
+  EXPECT_TRUE(budget.tryAcquire());
+  EXPECT_FALSE(budget.tryAcquire());
+  // At most 2 hedges are saved up.
+  for (auto i = 0; i < 10; ++i) {
+    budget.recordRead();
+  }
+  EXPECT_TRUE(budget.tryAcquire());
+  EXPECT_TRUE(budget.tryAcquire());
+  EXPECT_FALSE(budget.tryAcquire());
+
+  HedgeBudget disabled(0, 2);
+  disabled.recordRead();
+  EXPECT_FALSE(disabled.tryAcquire());
+}
+
+TEST_F(HedgedReadFileTest, hedge) {
+  const auto data = testData();
+  auto slowFile = std::make_shared<SlowReadFile>(
+      data, std::chrono::milliseconds(2'000), std::vector<int32_t>{0});
+  HedgeBudget budget(100, 10);
+  HedgedReadFile file(slowFile, &executor_, tracker_, &budget, kOptions);
+
+  std::string buffer(1'000, 0);
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(file.pread(100, 1'000, buffer.data()), data.substr(100, 1'000));
+  // The hedge wins without waiting for the slow read.
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::milliseconds(1'500));
+  EXPECT_EQ(slowFile->numReads(), 2);
+
+  std::vector<std::string> parts{std::string(10, 0), std::string(20, 0)};
+  std::vector<folly::Range<char*>> ranges{
+      {parts[0].data(), parts[0].size()},
+      {nullptr, 30},
+      {parts[1].data(), parts[1].size()}};
+  EXPECT_EQ(file.preadv(5, ranges), 60);
+  EXPECT_EQ(parts[0], data.substr(5, 10));
+  EXPECT_EQ(parts[1], data.substr(45, 20));
+  EXPECT_EQ(file.pread(0, 100), data.substr(0, 100));
+  EXPECT_EQ(slowFile->numReads(), 4);
+}
+
+TEST_F(HedgedReadFileTest, asyncFile) {
+  const auto data = testData();
+  auto asyncFile = std::make_shared<SlowAsyncReadFile>(
+      data,
+      &executor_,
+      std::chrono::milliseconds(2'000),
+      std::vector<int32_t>{0});
+  HedgeBudget budget(100, 10);
+  // The attempts go through the file's preadvAsync, no executor is needed.
+  HedgedReadFile file(asyncFile, nullptr, tracker_, &budget, kOptions);
+  ASSERT_TRUE(file.hasPreadvAsync());
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(file.pread(100, 1'000), data.substr(100, 1'000));
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::milliseconds(1'500));
+  EXPECT_EQ(asyncFile->numAsyncReads(), 2);
+
+  // The asynchronous reads are passed through without hedging.
+  std::vector<std::string> parts{std::string(10, 0), std::string(20, 0)};
+  std::vector<folly::Range<char*>> ranges{
+      {parts[0].data(), parts[0].size()},
+      {nullptr, 30},
+      {parts[1].data(), parts[1].size()}};
+  EXPECT_EQ(file.preadvAsync(5, ranges).get(), 60);
+  EXPECT_EQ(parts[0], data.substr(5, 10));
+  EXPECT_EQ(parts[1], data.substr(45, 20));
+  EXPECT_EQ(asyncFile->numAsyncReads(), 3);
+}
+
+TEST_F(HedgedReadFileTest, noBudget) {
+  const auto data = testData();
+  auto slowFile = std::make_shared<SlowReadFile>(
+      data, std::chrono::milliseconds(100), std::vector<int32_t>{0});
+  HedgeBudget budget(0, 10);
+  HedgedReadFile file(slowFile, &executor_, tracker_, &budget, kOptions);
+  EXPECT_EQ(file.pread(0, 1'000), data.substr(0, 1'000));
+  EXPECT_EQ(slowFile->numReads(), 1);
+}
+
+TEST_F(HedgedReadFileTest, notHedgeable) {
+  const auto data = testData();
+  auto slowFile = std::make_shared<SlowReadFile>(
+      data, std::chrono::milliseconds(100), std::vector<int32_t>{0});
+  HedgeBudget budget(100, 10);
+  // Without an executor the reads go straight to the file.
+  HedgedReadFile file(slowFile, nullptr, tracker_, &budget, kOptions);
+  EXPECT_EQ(file.pread(0, 1'000), data.substr(0, 1'000));
+  EXPECT_EQ(slowFile->numReads(), 1);
+
+  HedgedReadFile smallReads(
+      slowFile, &executor_, tracker_, &budget, HedgedReadOptions{1'000, 100});
+  EXPECT_EQ(smallReads.pread(0, 1'000), data.substr(0, 1'000));
+  EXPECT_EQ(slowFile->numReads(), 2);
+}
+
+} // namespace
@@ -143,6 +143,27 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  constexpr size_t kBatchSize = 64;
+  uint32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  for (size_t start = 0; start < hashes.size(); start += kBatchSize) {
+    const auto numHashes = std::min(kBatchSize, hashes.size() - start);
+    const auto* batch = hashes.data() + start;
+    for (auto i = 0; i < numHashes; ++i) {
+      indices[i] = computeIndex(batch[i], indexBitLength_);
+      values[i] = numberOfLeadingZeros(batch[i], indexBitLength_) + 1;
+    }
+    for (auto i = 0; i < numHashes; ++i) {
+      // Same as the first check in insert(), without the overflow lookup.
+      if (values[i] - baseline_ <= getDelta(indices[i])) {
+        continue;
+      }
+      insert(indices[i], values[i]);
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
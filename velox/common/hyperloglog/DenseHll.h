@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include <folly/Range.h>
 #include "velox/common/memory/HashStringAllocator.h"
 
 namespace facebook::velox::common::hll {
@@ -48,6 +49,12 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Same as calling insertHash for each of 'hashes'. Computes the buckets and
+  /// values of a batch of hashes in a loop without dependencies between
+  /// iterations, then updates only the buckets whose value grows. Once the
+  /// HLL is populated, most hashes do not change their bucket.
+  void insertHashes(folly::Range<const uint64_t*> hashes);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +91,32 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+bool SparseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  if (hashes.empty()) {
+    return overLimit();
+  }
+  std::vector<uint32_t> newEntries(hashes.size());
+  for (auto i = 0; i < hashes.size(); ++i) {
+    newEntries[i] = encode(
+        computeIndex(hashes[i], kIndexBitLength),
+        numberOfLeadingZeros(hashes[i], kIndexBitLength));
+  }
+  // The entries sort by index, then by value. Keeps the last, i.e. the
+  // largest, value of each index.
+  std::sort(newEntries.begin(), newEntries.end());
+  size_t numEntries = 0;
+  for (auto entry : newEntries) {
+    if (numEntries > 0 &&
+        decodeIndex(newEntries[numEntries - 1]) == decodeIndex(entry)) {
+      newEntries[numEntries - 1] = entry;
+    } else {
+      newEntries[numEntries++] = entry;
+    }
+  }
+  mergeWith(numEntries, newEntries.data());
+  return overLimit();
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
@@ -236,11 +265,17 @@ void SparseHll::verify() const {
   }
 }
 
-void SparseHll::toDense(DenseHll& denseHll) const {
+namespace {
+void insertToDense(
+    const uint32_t* entries,
+    size_t numEntries,
+    DenseHll& denseHll) {
   auto indexBitLength = denseHll.indexBitLength();
 
-  for (auto i = 0; i < entries_.size(); i++) {
-    auto entry = entries_[i];
+  for (auto i = 0; i < numEntries; i++) {
+    uint32_t entry;
+    // Serialized entries are not necessarily aligned.
+    memcpy(&entry, entries + i, sizeof(entry));
     auto index = entry >> (32 - indexBitLength);
     auto shiftedValue = entry << indexBitLength;
     auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
@@ -256,5 +291,20 @@ void SparseHll::toDense(DenseHll& denseHll) const {
     denseHll.insert(index, zeros + 1);
   }
 }
+} // namespace
+
+void SparseHll::toDense(DenseHll& denseHll) const {
+  insertToDense(entries_.data(), entries_.size(), denseHll);
+}
+
+// static
+void SparseHll::toDense(const char* serialized, DenseHll& denseHll) {
+  auto stream = initializeInputStream(serialized);
+  auto size = stream.read<int16_t>();
+  insertToDense(
+      reinterpret_cast<const uint32_t*>(serialized + stream.offset()),
+      size,
+      denseHll);
+}
 
 } // namespace facebook::velox::common::hll
@@ -40,6 +40,13 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Same as calling insertHash for each of 'hashes'. Sorts the entries of
+  /// 'hashes' and merges them with the existing entries in one pass instead
+  /// of doing a binary search and a vector insert per hash. The memory limit
+  /// is checked only at the end, so a large batch may overshoot it.
+  /// @return True if soft memory limit has been reached.
+  bool insertHashes(folly::Range<const uint64_t*> hashes);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
@@ -65,6 +72,10 @@ class SparseHll {
   /// Merges state into provided instance of DenseHll.
   void toDense(DenseHll& denseHll) const;
 
+  /// Merges the serialized SparseHll 'serialized' into 'denseHll' without
+  /// copying its entries.
+  static void toDense(const char* serialized, DenseHll& denseHll);
+
   /// Returns current memory usage.
   int32_t inMemorySize() const;
 
@@ -30,7 +30,7 @@ uint64_t hashOne(T value) {
   return XXH64(&value, sizeof(value), 0);
 }
 
-// A benchmark for DenseHll::mergeWith(serialized) API.
+// A benchmark for DenseHll::mergeWith(serialized) and insertHash(es) APIs.
 //
 // Measures the time it takes to merge 2 serialized digests using different
 // values for hash bits. Larger values of hash bits corresponds to larger
@@ -43,6 +43,9 @@ class DenseHllBenchmark {
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 1));
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 2));
     }
+    for (int32_t i = 0; i < 1'000'000; ++i) {
+      hashes_.push_back(hashOne(i));
+    }
   }
 
   void run(int hashBits) {
@@ -58,6 +61,25 @@ class DenseHllBenchmark {
     }
   }
 
+  // Inserts 1M hashes one at a time or in one batch.
+  void insert(int hashBits, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    if (batch) {
+      hll.insertHashes(hashes_);
+    } else {
+      for (auto hash : hashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
  private:
   std::string makeSerializedHll(int hashBits, int32_t step) {
     HashStringAllocator allocator(pool_);
@@ -82,6 +104,8 @@ class DenseHllBenchmark {
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
@@ -100,6 +124,24 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(insertHash11) {
+  benchmark->insert(11, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes11) {
+  benchmark->insert(11, true);
+}
+
+BENCHMARK(insertHash16) {
+  benchmark->insert(16, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes16) {
+  benchmark->insert(16, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
@@ -173,6 +173,26 @@ TEST_F(SparseHllTest, mergeWith) {
   testMergeWith({}, sequence(100, 300));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  SparseHll expected{&allocator_};
+  SparseHll sparseHll{&allocator_};
+  std::vector<uint64_t> hashes;
+  // Batches with duplicates within and across batches.
+  for (auto batch = 0; batch < 10; ++batch) {
+    hashes.clear();
+    for (auto i = 0; i < 300; ++i) {
+      hashes.push_back(hashOne((batch * 100 + i) % 1'500));
+      expected.insertHash(hashes.back());
+    }
+    sparseHll.insertHashes(hashes);
+    sparseHll.verify();
+    ASSERT_EQ(serialize(11, sparseHll), serialize(11, expected));
+  }
+
+  sparseHll.setSoftMemoryLimit(4 * 1'000);
+  ASSERT_TRUE(sparseHll.insertHashes({}));
+}
+
 class SparseHllToDenseTest : public ::testing::TestWithParam<int8_t> {
  protected:
   static void SetUpTestCase() {
@@ -223,6 +243,26 @@ TEST_P(SparseHllToDenseTest, testNumberOfZeros) {
   }
 }
 
+TEST_P(SparseHllToDenseTest, serializedToDense) {
+  int8_t indexBitLength = GetParam();
+
+  SparseHll sparseHll{&allocator_};
+  for (int i = 0; i < 1'000; i++) {
+    sparseHll.insertHash(hashOne(i));
+  }
+  DenseHll expectedHll{indexBitLength, &allocator_};
+  sparseHll.toDense(expectedHll);
+
+  auto size = sparseHll.serializedSize();
+  std::string serialized;
+  serialized.resize(size);
+  sparseHll.serialize(indexBitLength, serialized.data());
+
+  DenseHll denseHll{indexBitLength, &allocator_};
+  SparseHll::toDense(serialized.data(), denseHll);
+  ASSERT_EQ(serialize(denseHll), serialize(expectedHll));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     SparseHllToDenseTest,
     SparseHllToDenseTest,
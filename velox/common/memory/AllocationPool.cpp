@@ -39,6 +39,38 @@ folly::Range<char*> AllocationPool::rangeAt(int32_t index) const {
   VELOX_FAIL("Out of range index for rangeAt(): {}", index);
 }
 
+int64_t AllocationPool::hugePageBytes() const {
+  std::vector<folly::Range<char*>> ranges;
+  ranges.reserve(largeAllocations_.size());
+  for (const auto& allocation : largeAllocations_) {
+    ranges.emplace_back(allocation.data<char>(), allocation.size());
+  }
+  return MemoryAllocator::hugePageBytes(ranges);
+}
+
+AllocationPool::AllocationPool(AllocationPool&& other) noexcept
+    : pool_(other.pool_), site_(other.site_) {
+  *this = std::move(other);
+}
+
+AllocationPool& AllocationPool::operator=(AllocationPool&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  clear();
+  pool_ = other.pool_;
+  site_ = other.site_;
+  allocations_ = std::move(other.allocations_);
+  largeAllocations_ = std::move(other.largeAllocations_);
+  startOfRun_ = other.startOfRun_;
+  bytesInRun_ = other.bytesInRun_;
+  currentOffset_ = other.currentOffset_;
+  usedBytes_ = other.usedBytes_;
+  hugePageThreshold_ = other.hugePageThreshold_;
+  other.clear();
+  return *this;
+}
+
 void AllocationPool::clear() {
   allocations_.clear();
   largeAllocations_.clear();
@@ -90,6 +122,10 @@ void AllocationPool::maybeGrowLastAllocation(uint64_t bytesRequested) {
 }
 
 void AllocationPool::newRunImpl(MachinePageCount numPages) {
+  std::optional<ScopedMemoryAllocationSite> siteScope;
+  if (site_.has_value()) {
+    siteScope.emplace(site_.value());
+  }
   if (usedBytes_ >= hugePageThreshold_ ||
       numPages > pool_->sizeClasses().back()) {
     // At least 16 huge pages, no more than kMaxMmapBytes. The next is
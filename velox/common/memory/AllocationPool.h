@@ -29,7 +29,19 @@ class AllocationPool {
  public:
   static constexpr int32_t kMinPages = 16;
 
-  explicit AllocationPool(memory::MemoryPool* pool) : pool_(pool) {}
+  /// If 'site' is set, the memory allocated from 'pool' is attributed to it.
+  /// See ScopedMemoryAllocationSite.
+  explicit AllocationPool(
+      memory::MemoryPool* pool,
+      std::optional<MemoryAllocationSite> site = std::nullopt)
+      : pool_(pool), site_(site) {}
+
+  /// Takes over the allocations of 'other' and leaves 'other' empty.
+  AllocationPool(AllocationPool&& other) noexcept;
+
+  /// Frees the allocations of 'this', takes over the allocations of 'other'
+  /// and leaves 'other' empty.
+  AllocationPool& operator=(AllocationPool&& other) noexcept;
 
   ~AllocationPool() {
     clear();
@@ -86,6 +98,10 @@ class AllocationPool {
     currentOffset_ = offset;
   }
 
+  std::optional<MemoryAllocationSite> allocationSite() const {
+    return site_;
+  }
+
   memory::MemoryPool* pool() const {
     return pool_;
   }
@@ -105,6 +121,10 @@ class AllocationPool {
     hugePageThreshold_ = size;
   }
 
+  /// Returns the bytes of the large allocations that are backed by huge pages.
+  /// See MemoryAllocator::hugePageBytes() for the cost and accuracy.
+  int64_t hugePageBytes() const;
+
   int64_t testingFreeAddressableBytes() const {
     return freeAddressableBytes();
   }
@@ -139,6 +159,7 @@ class AllocationPool {
   void newRunImpl(memory::MachinePageCount numPages);
 
   memory::MemoryPool* pool_;
+  std::optional<MemoryAllocationSite> site_;
   std::vector<memory::Allocation> allocations_;
   std::vector<memory::ContiguousAllocation> largeAllocations_;
 
@@ -86,20 +86,27 @@ HashStringAllocator::~HashStringAllocator() {
 }
 
 void HashStringAllocator::clear() {
-  numFree_ = 0;
-  freeBytes_ = 0;
-  std::fill(std::begin(freeNonEmpty_), std::end(freeNonEmpty_), 0);
+  clearFreeLists();
   for (auto& pair : allocationsFromPool_) {
     pool()->free(pair.first, pair.second);
   }
   allocationsFromPool_.clear();
+  headersFromPool_.clear();
+  pool_.clear();
+}
+
+void HashStringAllocator::clearFreeLists() {
+  numFree_ = 0;
+  freeBytes_ = 0;
+  std::fill(std::begin(freeNonEmpty_), std::end(freeNonEmpty_), 0);
   for (auto i = 0; i < kNumFreeLists; ++i) {
     new (&free_[i]) CompactDoubleList();
   }
-  pool_.clear();
 }
 
 void* HashStringAllocator::allocateFromPool(size_t size) {
+  memory::ScopedMemoryAllocationSite siteScope(
+      memory::MemoryAllocationSite::kStringAllocator);
   auto* ptr = pool()->allocate(size);
   cumulativeBytes_ += size;
   allocationsFromPool_[ptr] = size;
@@ -115,6 +122,7 @@ void HashStringAllocator::freeToPool(void* ptr, size_t size) {
   VELOX_CHECK_EQ(
       size, it->second, "Bad size in HashStringAllocator::freeToPool()");
   allocationsFromPool_.erase(it);
+  headersFromPool_.erase(reinterpret_cast<Header*>(ptr));
   sizeFromPool_ -= size;
   cumulativeBytes_ -= size;
   pool()->free(ptr, size);
@@ -235,18 +243,28 @@ HashStringAllocator::finishWrite(
   return {startPosition_, currentPosition};
 }
 
-void HashStringAllocator::newSlab() {
-  constexpr int32_t kSimdPadding = simd::kPadding - sizeof(Header);
-  const int64_t needed = pool_.allocatedBytes() >= pool_.hugePageThreshold()
+// static
+int64_t HashStringAllocator::nextSlabSize(const memory::AllocationPool& pool) {
+  return pool.allocatedBytes() >= pool.hugePageThreshold()
       ? memory::AllocationTraits::kHugePageSize
       : kUnitSize;
-  auto* run = pool_.allocateFixed(needed);
+}
+
+void HashStringAllocator::newSlab() {
+  free(allocateSlab(pool_));
+}
+
+HashStringAllocator::Header* HashStringAllocator::allocateSlab(
+    memory::AllocationPool& pool) {
+  constexpr int32_t kSimdPadding = simd::kPadding - sizeof(Header);
+  const int64_t needed = nextSlabSize(pool);
+  auto* run = pool.allocateFixed(needed);
   VELOX_CHECK_NOT_NULL(run);
   // We check we got exactly the requested amount. checkConsistency() depends on
   // slabs made here coinciding with ranges from AllocationPool::rangeAt().
   // Sometimes the last range can be several huge pages for severl huge page
   // sized arenas but checkConsistency() can interpret that.
-  VELOX_CHECK_EQ(pool_.freeBytes(), 0);
+  VELOX_CHECK_EQ(pool.freeBytes(), 0);
   const auto available = needed - sizeof(Header) - kSimdPadding;
   VELOX_CHECK_GT(available, 0);
 
@@ -254,9 +272,9 @@ void HashStringAllocator::newSlab() {
   *reinterpret_cast<uint32_t*>(run + available) = Header::kArenaEnd;
   cumulativeBytes_ += available;
 
-  // Add the new memory to the free list: Placement construct a header that
-  // covers the space from start to the end marker and add this to free list.
-  free(new (run) Header(available - sizeof(Header)));
+  // Placement construct a header that covers the space from start to the end
+  // marker.
+  return new (run) Header(available - sizeof(Header));
 }
 
 void HashStringAllocator::newRange(
@@ -355,6 +373,7 @@ HashStringAllocator::Header* HashStringAllocator::allocate(
     auto* header =
         reinterpret_cast<Header*>(allocateFromPool(size + sizeof(Header)));
     new (header) Header(size);
+    headersFromPool_.insert(header);
     return header;
   }
 
@@ -653,6 +672,174 @@ std::string HashStringAllocator::toString() const {
   return out.str();
 }
 
+char* HashStringAllocator::Relocation::relocate(const char* address) const {
+  auto it = std::upper_bound(
+      moves_.begin(),
+      moves_.end(),
+      address,
+      [](const char* ptr, const Move& move) { return ptr < move.from; });
+  if (it == moves_.begin()) {
+    return const_cast<char*>(address);
+  }
+  const auto& move = *(it - 1);
+  if (address >= move.from + move.size) {
+    return const_cast<char*>(address);
+  }
+  return move.to + (address - move.from);
+}
+
+HashStringAllocator::Position HashStringAllocator::Relocation::relocate(
+    const Position& position) const {
+  if (position.header == nullptr) {
+    return position;
+  }
+  auto* header = relocate(position.header);
+  if (position.position == nullptr) {
+    return {header, nullptr};
+  }
+  return {
+      header,
+      header->begin() + (position.position - position.header->begin())};
+}
+
+std::vector<HashStringAllocator::Header*>
+HashStringAllocator::allocatedSlabBlocks() const {
+  static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
+
+  std::vector<Header*> blocks;
+  // Walks the arenas like checkConsistency().
+  for (auto i = 0; i < pool_.numRanges(); ++i) {
+    const auto topRange = pool_.rangeAt(i);
+    const int64_t topRangeSize = topRange.size();
+    for (int64_t subRangeStart = 0; subRangeStart < topRangeSize;
+         subRangeStart += kHugePageSize) {
+      auto* begin = topRange.data() + subRangeStart;
+      auto* end = reinterpret_cast<Header*>(
+          begin + std::min<int64_t>(topRangeSize, kHugePageSize) -
+          simd::kPadding);
+      for (auto* header = reinterpret_cast<Header*>(begin); header != end;
+           header = reinterpret_cast<Header*>(header->end())) {
+        if (!header->isFree()) {
+          blocks.push_back(header);
+        }
+      }
+    }
+  }
+  return blocks;
+}
+
+int64_t HashStringAllocator::compact(
+    const std::function<void(const Relocation&)>& relocateOwners) {
+  VELOX_CHECK_NULL(
+      currentHeader_, "Do not call compact() when a write is in progress");
+  if (freeBytes_ < kUnitSize) {
+    return 0;
+  }
+  const auto retainedBefore = retainedSize();
+  const auto cumulativeBytes = cumulativeBytes_;
+  const auto blocks = allocatedSlabBlocks();
+
+  // A block is placed at the start of the unused tail of a slab if it fills
+  // the tail exactly or leaves space for a minimum size free block.
+  auto fits = [](int64_t tailBytes, int64_t blockBytes) {
+    return tailBytes == blockBytes ||
+        tailBytes >= blockBytes + sizeof(Header) + kMinAlloc;
+  };
+
+  // Copies the blocks to new slabs. Nothing in 'this' is changed until all
+  // the memory is allocated, so that a failed allocation leaves 'this' as it
+  // was.
+  memory::AllocationPool slabs(pool(), pool_.allocationSite());
+  slabs.setHugePageThreshold(pool_.hugePageThreshold());
+  Relocation relocation;
+  // Tails of the new slabs to add to the free lists.
+  std::vector<Header*> tails;
+  // Blocks that do not fit a new slab.
+  std::vector<Header*> largeBlocks;
+  try {
+    relocation.moves_.reserve(blocks.size());
+    Header* tail = nullptr;
+    for (auto* block : blocks) {
+      const int64_t blockBytes = sizeof(Header) + block->size();
+      if (tail != nullptr && !fits(sizeof(Header) + tail->size(), blockBytes)) {
+        tails.push_back(tail);
+        tail = nullptr;
+      }
+      char* to;
+      if (tail == nullptr &&
+          !fits(nextSlabSize(slabs) - simd::kPadding, blockBytes)) {
+        // A block of a huge page slab may not fit a new slab before 'slabs'
+        // reaches the huge page threshold.
+        VELOX_CHECK_GT(block->size(), kMaxAlloc);
+        to = reinterpret_cast<char*>(allocateFromPool(blockBytes));
+        largeBlocks.push_back(reinterpret_cast<Header*>(to));
+      } else {
+        if (tail == nullptr) {
+          tail = allocateSlab(slabs);
+        }
+        to = reinterpret_cast<char*>(tail);
+        const int64_t tailBytes = sizeof(Header) + tail->size();
+        tail = tailBytes == blockBytes
+            ? nullptr
+            : new (to + blockBytes)
+                  Header(tailBytes - blockBytes - sizeof(Header));
+      }
+      memcpy(to, block, blockBytes);
+      reinterpret_cast<Header*>(to)->clearPreviousFree();
+      relocation.moves_.push_back(
+          {reinterpret_cast<char*>(block),
+           to,
+           static_cast<int32_t>(blockBytes)});
+    }
+    if (tail != nullptr) {
+      tails.push_back(tail);
+    }
+    headersFromPool_.reserve(headersFromPool_.size() + largeBlocks.size());
+  } catch (const std::exception&) {
+    for (auto* header : largeBlocks) {
+      freeToPool(header, sizeof(Header) + header->size());
+    }
+    cumulativeBytes_ = cumulativeBytes;
+    throw;
+  }
+
+  std::sort(
+      relocation.moves_.begin(),
+      relocation.moves_.end(),
+      [](const Relocation::Move& left, const Relocation::Move& right) {
+        return left.from < right.from;
+      });
+  for (auto* header : largeBlocks) {
+    headersFromPool_.insert(header);
+  }
+  // The continue pointers of moved blocks and of blocks from the pool may
+  // point to moved blocks.
+  auto relocateContinued = [&](Header* header) {
+    if (header->isContinued()) {
+      auto** next = reinterpret_cast<Header**>(
+          header->end() - Header::kContinuedPtrSize);
+      *next = relocation.relocate(*next);
+    }
+  };
+  for (const auto& move : relocation.moves_) {
+    relocateContinued(reinterpret_cast<Header*>(move.to));
+  }
+  for (auto* header : headersFromPool_) {
+    relocateContinued(header);
+  }
+
+  memory::AllocationPool oldSlabs(std::move(pool_));
+  pool_ = std::move(slabs);
+  clearFreeLists();
+  for (auto* tail : tails) {
+    free(tail);
+  }
+  cumulativeBytes_ = cumulativeBytes;
+  relocateOwners(relocation);
+  oldSlabs.clear();
+  return retainedBefore - retainedSize();
+}
+
 int64_t HashStringAllocator::checkConsistency() const {
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
 
@@ -24,6 +24,7 @@
 #include "velox/type/StringView.h"
 
 #include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
 
 namespace facebook::velox {
 
@@ -174,8 +175,47 @@ class HashStringAllocator : public StreamArena {
     }
   };
 
+  /// Describes where compact() moved the allocated blocks. A moved block keeps
+  /// its size, flags and payload. An address inside a moved block maps to the
+  /// same offset from the start of the new block. Addresses outside of moved
+  /// blocks, e.g. blocks from allocateFromPool(), map to themselves.
+  class Relocation {
+   public:
+    /// Returns the new address of 'address'. 'address' must be a header or
+    /// payload byte of a block, not the end of one.
+    char* relocate(const char* address) const;
+
+    Header* relocate(const Header* header) const {
+      return reinterpret_cast<Header*>(
+          relocate(reinterpret_cast<const char*>(header)));
+    }
+
+    /// Returns 'position' moved together with its block. 'position' may
+    /// point at the end of its block.
+    Position relocate(const Position& position) const;
+
+    /// Returns the number of moved blocks.
+    size_t numMoved() const {
+      return moves_.size();
+    }
+
+   private:
+    friend class HashStringAllocator;
+
+    struct Move {
+      const char* from;
+      char* to;
+      // Bytes covered, including the Header.
+      int32_t size;
+    };
+
+    // Moves sorted on 'from'.
+    std::vector<Move> moves_;
+  };
+
   explicit HashStringAllocator(memory::MemoryPool* pool)
-      : StreamArena(pool), pool_(pool) {}
+      : StreamArena(pool),
+        pool_(pool, memory::MemoryAllocationSite::kStringAllocator) {}
 
   ~HashStringAllocator();
 
@@ -313,6 +353,18 @@ class HashStringAllocator : public StreamArena {
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
+  /// Moves the allocated blocks into newly allocated slabs, packed without
+  /// free space between them, and frees the old slabs. Continue pointers
+  /// between blocks are updated by this. Pointers from outside into the moved
+  /// blocks are updated by 'relocateOwners', which is called after the move
+  /// and before the old slabs are freed, so that owners may still read the old
+  /// locations. Blocks from allocateFromPool() are not moved. The live bytes
+  /// are allocated before the old slabs are freed, so the footprint grows
+  /// temporarily. Does nothing if the free space is under one slab. Returns
+  /// the decrease of retainedSize(). Must not be called while a write is in
+  /// progress.
+  int64_t compact(const std::function<void(const Relocation&)>& relocateOwners);
+
   memory::MemoryPool* pool() const {
     return pool_.pool();
   }
@@ -354,6 +406,19 @@ class HashStringAllocator : public StreamArena {
   // anything yet. Throws if fails to grow.
   void newSlab();
 
+  // Allocates a new standard size slab from 'pool' and returns a single block
+  // that covers it. The block is neither free nor in the free lists.
+  Header* allocateSlab(memory::AllocationPool& pool);
+
+  // Returns the size of the next slab allocated from 'pool'.
+  static int64_t nextSlabSize(const memory::AllocationPool& pool);
+
+  // Resets the free lists and their counters to empty.
+  void clearFreeLists();
+
+  // Returns the allocated, i.e. non-free, blocks in the slabs.
+  std::vector<Header*> allocatedSlabBlocks() const;
+
   void removeFromFreeList(Header* header);
 
   // Allocates a block of specified size. If exactSize is false, the block may
@@ -422,6 +487,10 @@ class HashStringAllocator : public StreamArena {
   // Map from pointer to size for large blocks allocated from pool().
   folly::F14FastMap<void*, size_t> allocationsFromPool_;
 
+  // The blocks in 'allocationsFromPool_' that start with a Header, i.e. come
+  // from allocate(). These may have continue pointers into the slabs.
+  folly::F14FastSet<Header*> headersFromPool_;
+
   // Sum of sizes in 'allocationsFromPool_'.
   int64_t sizeFromPool_{0};
 };
@@ -51,6 +51,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.capacity = options.allocatorCapacity;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numNumaNodes = options.numNumaNodes;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -73,6 +74,8 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
        .globalArbitrationEnabled = options.globalArbitrationEnabled,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
+       .arbitrationPriorityCb = options.arbitrationPriorityCb,
+       .priorityGuaranteedCapacities = options.priorityGuaranteedCapacities,
        .checkUsageLeak = options.checkUsageLeak});
 }
 
@@ -95,10 +98,16 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
     : allocator_{createAllocator(options)},
       poolInitCapacity_(options.memoryPoolInitCapacity),
       arbitrator_(createArbitrator(options)),
+      arbitrationExecutor_(options.arbitrationExecutor),
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
+      trackAllocationSites_(options.trackAllocationSites),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      backgroundReclaimHighWatermarkPct_(
+          options.backgroundReclaimHighWatermarkPct),
+      backgroundReclaimLowWatermarkPct_(
+          options.backgroundReclaimLowWatermarkPct),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -136,9 +145,25 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
   VELOX_CHECK_EQ(
       sharedLeafPools_.size(),
       std::max(1, FLAGS_velox_memory_num_shared_leaf_pools));
+  VELOX_CHECK_LE(
+      backgroundReclaimLowWatermarkPct_, backgroundReclaimHighWatermarkPct_);
+  VELOX_CHECK_LE(backgroundReclaimHighWatermarkPct_, 100);
+  if (options.backgroundReclaimIntervalMs != 0) {
+    const std::chrono::milliseconds interval{
+        options.backgroundReclaimIntervalMs};
+    backgroundReclaimer_.add("background_memory_reclaim", [this, interval]() {
+      try {
+        runBackgroundReclaim();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Background memory reclaim failed: " << e.what();
+      }
+      return interval;
+    });
+  }
 }
 
 MemoryManager::~MemoryManager() {
+  backgroundReclaimer_.stop();
   if (pools_.size() != 0) {
     const auto errMsg = fmt::format(
         "pools_.size() != 0 ({} vs {}). There are unexpected alive memory "
@@ -225,6 +250,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.maxCapacity = maxCapacity;
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
+  options.trackAllocationSites = trackAllocationSites_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
 
   std::unique_lock guard{mutex_};
@@ -274,6 +300,52 @@ uint64_t MemoryManager::shrinkPools(
       getAlivePools(), targetBytes, allowSpill, allowAbort);
 }
 
+uint64_t MemoryManager::runBackgroundReclaim() {
+  const auto exceedsHighWatermark = [&](uint64_t usedBytes, uint64_t capacity) {
+    return usedBytes * 100 > capacity * backgroundReclaimHighWatermarkPct_;
+  };
+  const auto bytesAboveLowWatermark = [&](uint64_t usedBytes,
+                                          uint64_t capacity) {
+    return usedBytes - capacity * backgroundReclaimLowWatermarkPct_ / 100;
+  };
+
+  uint64_t reclaimedBytes{0};
+  bool exceeded{false};
+  // Evicts from the cache first as it is cheaper than spilling.
+  auto* cache = allocator_->cache();
+  const uint64_t allocatorCapacity = allocator_->capacity();
+  if (cache != nullptr && allocatorCapacity != kMaxMemory) {
+    const uint64_t usedBytes = allocator_->totalUsedBytes();
+    if (exceedsHighWatermark(usedBytes, allocatorCapacity)) {
+      exceeded = true;
+      reclaimedBytes +=
+          cache->shrink(bytesAboveLowWatermark(usedBytes, allocatorCapacity));
+    }
+  }
+
+  const uint64_t arbitratorCapacity = arbitrator_->capacity();
+  if (arbitratorCapacity != kMaxMemory) {
+    const auto stats = arbitrator_->stats();
+    const uint64_t freeBytes = std::min(
+        stats.freeCapacityBytes + stats.freeReservedCapacityBytes,
+        arbitratorCapacity);
+    const uint64_t usedBytes = arbitratorCapacity - freeBytes;
+    if (exceedsHighWatermark(usedBytes, arbitratorCapacity)) {
+      exceeded = true;
+      reclaimedBytes += shrinkPools(
+          bytesAboveLowWatermark(usedBytes, arbitratorCapacity),
+          /*allowSpill=*/true,
+          /*allowAbort=*/false);
+    }
+  }
+
+  if (exceeded) {
+    RECORD_METRIC_VALUE(kMetricMemoryBackgroundReclaimCount);
+    RECORD_METRIC_VALUE(kMetricMemoryBackgroundReclaimedBytes, reclaimedBytes);
+  }
+  return reclaimedBytes;
+}
+
 void MemoryManager::dropPool(MemoryPool* pool) {
   VELOX_CHECK_NOT_NULL(pool);
   std::unique_lock guard{mutex_};
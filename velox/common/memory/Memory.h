@@ -24,7 +24,9 @@
 #include <string>
 
 #include <fmt/format.h>
+#include <folly/Executor.h>
 #include <folly/Synchronized.h>
+#include <folly/experimental/ThreadedRepeatingFunctionRunner.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -42,6 +44,7 @@
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_bool(velox_memory_pool_track_allocation_sites);
 DECLARE_bool(velox_enable_memory_usage_track_in_default_memory_pool);
 
 namespace facebook::velox::memory {
@@ -78,6 +81,10 @@ struct MemoryManagerOptions {
   /// testing purpose.
   bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
 
+  /// If true, the memory pools attribute their memory usage to the allocation
+  /// sites set by ScopedMemoryAllocationSite.
+  bool trackAllocationSites{FLAGS_velox_memory_pool_track_allocation_sites};
+
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
@@ -105,6 +112,13 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If greater than 1, MmapAllocator keeps its size classes and MmapArenas per
+  /// NUMA node and serves each thread from the memory of its node. See
+  /// setThreadNumaNode().
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t numNumaNodes{1};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -188,6 +202,42 @@ struct MemoryManagerOptions {
   /// potential deadlock when reclaim memory from the task of the request memory
   /// pool.
   MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
+
+  /// Provided by the query system to assign query memory pools to arbitration
+  /// priority classes. See MemoryArbitrator::Config::arbitrationPriorityCb.
+  MemoryArbitrationPriorityCB arbitrationPriorityCb{nullptr};
+
+  /// The memory capacity guaranteed to a query memory pool by its arbitration
+  /// priority class. See
+  /// MemoryArbitrator::Config::priorityGuaranteedCapacities.
+  std::vector<uint64_t> priorityGuaranteedCapacities{};
+
+  /// If not null, the executor used to run memory reservations requested
+  /// asynchronously by the query operators. A reservation that triggers memory
+  /// arbitration then runs on this executor instead of blocking the driver
+  /// thread, and the driver goes off thread until it finishes. If null, the
+  /// operators always reserve memory synchronously on the driver thread.
+  folly::Executor* arbitrationExecutor{nullptr};
+
+  /// If not zero, the interval in milliseconds to run the background memory
+  /// reclaim. Each run checks the used query memory capacity of the arbitrator
+  /// and the used memory of the allocator against
+  /// 'backgroundReclaimHighWatermarkPct' of their capacities. If the query
+  /// memory capacity exceeds it, the run shrinks the alive query memory pools
+  /// by reclaiming their free capacity first and then spilling from the ones
+  /// with the most reclaimable memory. If the allocator usage exceeds it, the
+  /// run evicts from the allocator's cache. Both reclaim down to
+  /// 'backgroundReclaimLowWatermarkPct', so that the memory allocations are
+  /// less likely to wait for memory arbitration.
+  uint64_t backgroundReclaimIntervalMs{0};
+
+  /// The memory usage as a percentage of the capacity above which the
+  /// background memory reclaim frees memory.
+  uint32_t backgroundReclaimHighWatermarkPct{90};
+
+  /// The memory usage as a percentage of the capacity down to which the
+  /// background memory reclaim frees memory.
+  uint32_t backgroundReclaimLowWatermarkPct{80};
 };
 
 /// 'MemoryManager' is responsible for creating allocator, arbitrator and
@@ -253,6 +303,12 @@ class MemoryManager {
       bool allowSpill = true,
       bool allowAbort = false);
 
+  /// Invoked by the background memory reclaim to free memory if the used query
+  /// memory capacity or the allocator usage exceeds the high watermark. See
+  /// MemoryManagerOptions::backgroundReclaimIntervalMs. The function returns
+  /// the freed memory in bytes.
+  uint64_t runBackgroundReclaim();
+
   /// Default unmanaged leaf pool with no threadsafe stats support. Libraries
   /// using this method can get a pool that is shared with other threads. The
   /// goal is to minimize lock contention while supporting such use cases.
@@ -275,6 +331,16 @@ class MemoryManager {
 
   MemoryArbitrator* arbitrator();
 
+  /// Returns the executor to run the asynchronous memory reservations, or null
+  /// if not configured. See MemoryManagerOptions::arbitrationExecutor.
+  folly::Executor* arbitrationExecutor() const {
+    return arbitrationExecutor_;
+  }
+
+  void testingSetArbitrationExecutor(folly::Executor* executor) {
+    arbitrationExecutor_ = executor;
+  }
+
   /// Returns debug string of this memory manager. If 'detail' is true, it
   /// returns the detailed tree memory usage from all the top level root memory
   /// pools.
@@ -311,10 +377,15 @@ class MemoryManager {
   const uint64_t poolInitCapacity_;
   // If not null, used to arbitrate the memory capacity among 'pools_'.
   const std::unique_ptr<MemoryArbitrator> arbitrator_;
+  // If not null, used to run the asynchronous memory reservations.
+  folly::Executor* arbitrationExecutor_;
   const uint16_t alignment_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const bool trackAllocationSites_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint32_t backgroundReclaimHighWatermarkPct_;
+  const uint32_t backgroundReclaimLowWatermarkPct_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -329,6 +400,9 @@ class MemoryManager {
   mutable folly::SharedMutex mutex_;
   // All user root pools allocated from 'this'.
   std::unordered_map<std::string, std::weak_ptr<MemoryPool>> pools_;
+
+  // Runs the background memory reclaim if it is enabled.
+  folly::ThreadedRepeatingFunctionRunner backgroundReclaimer_;
 };
 
 /// Initializes the process-wide memory manager based on the specified
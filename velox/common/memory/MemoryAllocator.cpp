@@ -18,6 +18,7 @@
 #include "velox/common/memory/MallocAllocator.h"
 
 #include <sys/mman.h>
+#include <fstream>
 #include <iostream>
 #include <numeric>
 
@@ -420,6 +421,90 @@ void MemoryAllocator::useHugePages(
 #endif
 }
 
+// static
+void* MemoryAllocator::mmapContiguous(uint64_t bytes) {
+#ifdef linux
+  constexpr auto kHugePageSize = AllocationTraits::kHugePageSize;
+  if (FLAGS_velox_memory_use_hugepages && bytes >= kHugePageSize) {
+    // Over-map by a huge page and unmap the unaligned head and the tail.
+    auto* data = ::mmap(
+        nullptr,
+        bytes + kHugePageSize,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (data == MAP_FAILED) {
+      return data;
+    }
+    const auto begin = reinterpret_cast<uintptr_t>(data);
+    const auto alignedBegin = bits::roundUp(begin, kHugePageSize);
+    if (alignedBegin > begin) {
+      ::munmap(data, alignedBegin - begin);
+    }
+    const auto tailBytes = kHugePageSize - (alignedBegin - begin);
+    if (tailBytes > 0) {
+      ::munmap(reinterpret_cast<char*>(alignedBegin + bytes), tailBytes);
+    }
+    return reinterpret_cast<void*>(alignedBegin);
+  }
+#endif
+  return ::mmap(
+      nullptr,
+      bytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+}
+
+// static
+uint64_t MemoryAllocator::hugePageBytes(
+    const std::vector<folly::Range<char*>>& ranges) {
+  uint64_t hugePageBytes{0};
+#ifdef linux
+  if (ranges.empty()) {
+    return 0;
+  }
+  uintptr_t maxEnd{0};
+  for (const auto& range : ranges) {
+    maxEnd = std::max(maxEnd, reinterpret_cast<uintptr_t>(range.end()));
+  }
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  // The number of bytes of 'ranges' in the mapping being parsed.
+  uint64_t overlapBytes{0};
+  while (std::getline(smaps, line)) {
+    unsigned long begin;
+    unsigned long end;
+    // Each mapping starts with a "begin-end perms ..." line followed by
+    // "Key: value" lines. The mappings are listed in address order.
+    if (::sscanf(line.c_str(), "%lx-%lx ", &begin, &end) == 2) {
+      if (begin >= maxEnd) {
+        break;
+      }
+      overlapBytes = 0;
+      for (const auto& range : ranges) {
+        const auto rangeBegin = reinterpret_cast<uintptr_t>(range.begin());
+        const auto rangeEnd = reinterpret_cast<uintptr_t>(range.end());
+        if (rangeBegin < end && rangeEnd > begin) {
+          overlapBytes +=
+              std::min<uintptr_t>(rangeEnd, end) - std::max(rangeBegin, begin);
+        }
+      }
+      continue;
+    }
+    unsigned long hugePageKB;
+    if (overlapBytes > 0 &&
+        ::sscanf(line.c_str(), "AnonHugePages: %lu kB", &hugePageKB) == 1) {
+      hugePageBytes += std::min<uint64_t>(hugePageKB << 10, overlapBytes);
+      overlapBytes = 0;
+    }
+  }
+#endif
+  return hugePageBytes;
+}
+
 void MemoryAllocator::setAllocatorFailureMessage(std::string message) {
   allocatorFailureMessage() = std::move(message);
 }
@@ -358,6 +358,13 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   /// Throws if check fails.
   static void alignmentCheck(uint64_t allocateBytes, uint16_t alignmentBytes);
 
+  /// Returns how many bytes of 'ranges' are currently backed by transparent
+  /// huge pages. This reads /proc/self/smaps and is meant for reporting on a
+  /// few large allocations, not for use on hot paths. The result is
+  /// approximate if the kernel merged a range with adjacent mappings. Returns 0
+  /// if huge page usage can't be determined on this platform.
+  static uint64_t hugePageBytes(const std::vector<folly::Range<char*>>& ranges);
+
   /// Causes 'failure' to occur in memory allocation calls. This is a test-only
   /// function for validating error paths which are rare to trigger in unit
   /// test. If 'persistent' is false, then we only inject failure once in the
@@ -476,6 +483,13 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // for the address range.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Maps 'bytes' of anonymous memory for a contiguous allocation. If huge
+  // pages are enabled, mappings of at least one huge page start at a huge page
+  // boundary so that useHugePages() covers the whole range instead of only
+  // the huge pages fully inside an arbitrarily aligned mapping. Returns
+  // MAP_FAILED on failure like ::mmap().
+  static void* mmapContiguous(uint64_t bytes);
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
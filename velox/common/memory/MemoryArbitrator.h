@@ -31,6 +31,10 @@ class MemoryPool;
 
 using MemoryArbitrationStateCheckCB = std::function<void(MemoryPool&)>;
 
+/// Returns the arbitration priority class of a query memory pool. Class 0 is
+/// the highest priority.
+using MemoryArbitrationPriorityCB = std::function<uint32_t(const MemoryPool&)>;
+
 /// The memory arbitrator interface. There is one memory arbitrator object per
 /// memory manager which is responsible for arbitrating memory usage among the
 /// query memory pools for query memory isolation. When a memory pool exceeds
@@ -88,6 +92,21 @@ class MemoryArbitrator {
     /// memory pool.
     MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
 
+    /// Provided by the query system to assign the query memory pools to
+    /// priority classes if not null. Otherwise all the query memory pools are
+    /// in class 0. The memory arbitrator reclaims used memory by spilling or
+    /// aborting from the lowest priority class first, and picks the victim of
+    /// an out of memory abort from the lowest priority class.
+    MemoryArbitrationPriorityCB arbitrationPriorityCb{nullptr};
+
+    /// The memory capacity guaranteed to a query memory pool by its priority
+    /// class, indexed by class. Classes past the end have no guarantee. The
+    /// memory arbitrator does not reclaim a query memory pool below the larger
+    /// of this and 'memoryPoolReservedCapacity' on behalf of another query,
+    /// and does not abort it for another query if its capacity is within the
+    /// guarantee.
+    std::vector<uint64_t> priorityGuaranteedCapacities{};
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -260,6 +279,8 @@ class MemoryArbitrator {
         memoryReclaimWaitMs_(config.memoryReclaimWaitMs),
         globalArbitrationEnabled_(config.globalArbitrationEnabled),
         arbitrationStateCheckCb_(config.arbitrationStateCheckCb),
+        arbitrationPriorityCb_(config.arbitrationPriorityCb),
+        priorityGuaranteedCapacities_(config.priorityGuaranteedCapacities),
         checkUsageLeak_(config.checkUsageLeak) {
     VELOX_CHECK_LE(reservedCapacity_, capacity_);
   }
@@ -271,6 +292,8 @@ class MemoryArbitrator {
   const uint64_t memoryReclaimWaitMs_;
   const bool globalArbitrationEnabled_;
   const MemoryArbitrationStateCheckCB arbitrationStateCheckCb_;
+  const MemoryArbitrationPriorityCB arbitrationPriorityCb_;
+  const std::vector<uint64_t> priorityGuaranteedCapacities_;
   const bool checkUsageLeak_;
 };
 
@@ -161,8 +161,65 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
   }
+#define TRACK_ALLOC_SITE(...)                  \
+  if (FOLLY_UNLIKELY(trackAllocationSites_)) { \
+    recordAllocSite(__VA_ARGS__);              \
+  }
+#define TRACK_FREE_SITE(...)                   \
+  if (FOLLY_UNLIKELY(trackAllocationSites_)) { \
+    recordFreeSite(__VA_ARGS__);               \
+  }
+
+thread_local MemoryAllocationSite allocationSite{MemoryAllocationSite::kOther};
+
+size_t allocationSizeBucket(uint64_t size) {
+  size_t bucket = 0;
+  while (bucket < MemoryPool::kAllocationSizeBucketBytes.size() &&
+         size > MemoryPool::kAllocationSizeBucketBytes[bucket]) {
+    ++bucket;
+  }
+  return bucket;
+}
 } // namespace
 
+std::string_view memoryAllocationSiteName(MemoryAllocationSite site) {
+  switch (site) {
+    case MemoryAllocationSite::kOther:
+      return "other";
+    case MemoryAllocationSite::kRowContainer:
+      return "rowContainer";
+    case MemoryAllocationSite::kStringAllocator:
+      return "stringAllocator";
+    case MemoryAllocationSite::kHashTable:
+      return "hashTable";
+    case MemoryAllocationSite::kOutput:
+      return "output";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// static
+std::string_view MemoryPool::allocationSizeBucketName(size_t bucket) {
+  static const std::array<std::string_view, kNumAllocationSizeBuckets> kNames{
+      "UpTo256B", "UpTo4KB", "UpTo64KB", "UpTo1MB", "UpTo16MB", "Over16MB"};
+  VELOX_CHECK_LT(bucket, kNames.size());
+  return kNames[bucket];
+}
+
+ScopedMemoryAllocationSite::ScopedMemoryAllocationSite(
+    MemoryAllocationSite site)
+    : savedSite_(allocationSite) {
+  allocationSite = site;
+}
+
+ScopedMemoryAllocationSite::~ScopedMemoryAllocationSite() {
+  allocationSite = savedSite_;
+}
+
+MemoryAllocationSite memoryAllocationSite() {
+  return allocationSite;
+}
+
 std::string MemoryPool::Stats::toString() const {
   return fmt::format(
       "currentBytes:{} reservedBytes:{} peakBytes:{} cumulativeBytes:{} numAllocs:{} numFrees:{} numReserves:{} numReleases:{} numShrinks:{} numReclaims:{} numCollisions:{} numCapacityGrowths:{}",
@@ -222,6 +279,7 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
+      trackAllocationSites_(options.trackAllocationSites),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
@@ -434,6 +492,7 @@ MemoryPoolImpl::~MemoryPoolImpl() {
   }
 
   if (isLeaf()) {
+    drainReservationCacheLocked();
     if (usedReservationBytes_ > 0) {
       VELOX_MEM_LOG(ERROR) << "Memory leak (Used memory): " << toString();
       RECORD_METRIC_VALUE(
@@ -467,6 +526,12 @@ MemoryPool::Stats MemoryPoolImpl::stats() const {
   return statsLocked();
 }
 
+std::array<MemoryPool::AllocationSiteStats, kNumMemoryAllocationSites>
+MemoryPoolImpl::allocationSiteStats() const {
+  std::lock_guard<std::mutex> l(allocationSiteMutex_);
+  return allocationSiteStats_;
+}
+
 MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
   Stats stats;
   stats.currentBytes = currentBytesLocked();
@@ -497,6 +562,7 @@ void* MemoryPoolImpl::allocate(int64_t size) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  TRACK_ALLOC_SITE(buffer, size);
   return buffer;
 }
 
@@ -517,6 +583,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  TRACK_ALLOC_SITE(buffer, size);
   return buffer;
 }
 
@@ -537,6 +604,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  TRACK_ALLOC_SITE(newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -548,6 +616,7 @@ void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
+  TRACK_FREE_SITE(p);
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
@@ -565,6 +634,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  TRACK_FREE_SITE(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -585,6 +655,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  TRACK_ALLOC_SITE(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -593,6 +664,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  TRACK_FREE_SITE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -616,6 +688,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  TRACK_FREE_SITE(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -637,6 +710,7 @@ void MemoryPoolImpl::allocateContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  TRACK_ALLOC_SITE(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -646,6 +720,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  TRACK_FREE_SITE(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -672,6 +747,9 @@ void MemoryPoolImpl::growContiguous(
   if (FOLLY_UNLIKELY(debugEnabled_)) {
     recordGrowDbg(allocation.data(), allocation.size());
   }
+  if (FOLLY_UNLIKELY(trackAllocationSites_)) {
+    recordGrowSite(allocation.data(), allocation.size());
+  }
 }
 
 int64_t MemoryPoolImpl::capacity() const {
@@ -701,6 +779,7 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
+          .trackAllocationSites = trackAllocationSites_,
           .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
 }
 
@@ -742,11 +821,16 @@ void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
 void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   VELOX_CHECK(isLeaf());
 
+  if (FOLLY_LIKELY(!reserveOnly) && tryReserveCached(size)) {
+    return;
+  }
+
   int32_t numAttempts = 0;
   int64_t increment = 0;
   for (;; ++numAttempts) {
     {
       std::lock_guard<std::mutex> l(mutex_);
+      drainReservationCacheLocked();
       increment = reservationSizeLocked(size);
       if (increment == 0) {
         if (reserveOnly) {
@@ -757,6 +841,7 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
           maybeUpdatePeakBytesLocked(usedReservationBytes_);
         }
         sanityCheckLocked();
+        refillReservationCacheLocked();
         break;
       }
     }
@@ -783,6 +868,80 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   }
 }
 
+bool MemoryPoolImpl::tryReserveCached(uint64_t size) {
+  uint64_t state = cachedReservation_.load();
+  uint64_t newState;
+  do {
+    const auto cached = cachedBytes(state);
+    if (cached < size) {
+      return false;
+    }
+    newState = cacheState(cached - size, releasableBytes(state) + size);
+  } while (!cachedReservation_.compare_exchange_weak(state, newState));
+
+  // NOTE: the stats are updated without 'mutex_' and might be off under
+  // concurrent updates from the mutex protected path, like the other stats
+  // counters.
+  cumulativeBytes_ += size;
+  maybeUpdatePeakBytesLocked(
+      tsanAtomicValue(usedReservationBytes_) - cachedBytes(newState));
+  return true;
+}
+
+bool MemoryPoolImpl::tryReleaseCached(uint64_t size) {
+  uint64_t state = cachedReservation_.load();
+  uint64_t newState;
+  do {
+    const auto cached = cachedBytes(state);
+    const auto releasable = releasableBytes(state);
+    if ((releasable < size) || (cached + size > kMaxCachedReservationBytes)) {
+      return false;
+    }
+    newState = cacheState(cached + size, releasable - size);
+  } while (!cachedReservation_.compare_exchange_weak(state, newState));
+  return true;
+}
+
+void MemoryPoolImpl::drainReservationCacheLocked() {
+  const auto state = cachedReservation_.exchange(0);
+  usedReservationBytes_ -= cachedBytes(state);
+}
+
+void MemoryPoolImpl::refillReservationCacheLocked() {
+  VELOX_DCHECK_EQ(cachedReservation_.load(), 0);
+  const int64_t releasable = std::min<int64_t>(
+      kMaxReleasableBytes,
+      usedReservationBytes_ - minUsedBytesForReservationLocked());
+  const int64_t cached = std::min<int64_t>(
+      kMaxCachedReservationBytes, reservationBytes_ - usedReservationBytes_);
+  if ((releasable <= 0) && (cached <= 0)) {
+    return;
+  }
+  usedReservationBytes_ += std::max<int64_t>(0, cached);
+  cachedReservation_ = cacheState(
+      std::max<int64_t>(0, cached), std::max<int64_t>(0, releasable));
+}
+
+int64_t MemoryPoolImpl::minUsedBytesForReservationLocked() const {
+  if ((reservationBytes_ == 0) ||
+      (static_cast<int64_t>(quantizedSize(minReservationBytes_)) >=
+       reservationBytes_)) {
+    return 0;
+  }
+  VELOX_DCHECK_EQ(
+      static_cast<int64_t>(quantizedSize(reservationBytes_)),
+      tsanAtomicValue(reservationBytes_));
+  // The reservation was rounded up at the quantization granularity of its own
+  // size range. Dropping a full granule below it shrinks the reservation.
+  int64_t granularity = 8 * kMB;
+  if (reservationBytes_ <= 16 * kMB) {
+    granularity = kMB;
+  } else if (reservationBytes_ <= 64 * kMB) {
+    granularity = 4 * kMB;
+  }
+  return reservationBytes_ - granularity + 1;
+}
+
 bool MemoryPoolImpl::incrementReservationThreadSafe(
     MemoryPool* requestor,
     uint64_t size) {
@@ -871,6 +1030,10 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   VELOX_CHECK(isLeaf());
   VELOX_DCHECK_NOT_NULL(parent_);
 
+  if (FOLLY_LIKELY(!releaseOnly) && tryReleaseCached(size)) {
+    return;
+  }
+
   int64_t freeable = 0;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -880,9 +1043,11 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       if (minReservationBytes_ == 0) {
         return;
       }
+      drainReservationCacheLocked();
       newQuantized = quantizedSize(usedReservationBytes_);
       minReservationBytes_ = 0;
     } else {
+      drainReservationCacheLocked();
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
@@ -893,6 +1058,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       reservationBytes_ = newQuantized;
     }
     sanityCheckLocked();
+    refillReservationCacheLocked();
   }
   if (freeable > 0) {
     toImpl(parent_)->decrementReservation(freeable);
@@ -1193,6 +1359,81 @@ void MemoryPoolImpl::recordGrowDbg(const void* addr, uint64_t newSize) {
   allocResult->second.size = newSize;
 }
 
+void MemoryPoolImpl::recordAllocSite(const void* addr, uint64_t size) {
+  VELOX_CHECK(trackAllocationSites_);
+  if (addr == nullptr) {
+    return;
+  }
+  const auto site = memoryAllocationSite();
+  std::lock_guard<std::mutex> l(allocationSiteMutex_);
+  allocationSites_.emplace(
+      reinterpret_cast<uint64_t>(addr), AllocationSiteRecord{site, size});
+  auto& stats = allocationSiteStats_[static_cast<int32_t>(site)];
+  stats.currentBytes += size;
+  stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
+  ++stats.numAllocs;
+  ++stats.sizeHistogram[allocationSizeBucket(size)];
+}
+
+void MemoryPoolImpl::recordAllocSite(const Allocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordAllocSite(allocation.runAt(0).data(), allocation.byteSize());
+}
+
+void MemoryPoolImpl::recordAllocSite(const ContiguousAllocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordAllocSite(allocation.data(), allocation.size());
+}
+
+void MemoryPoolImpl::recordFreeSite(const void* addr) {
+  VELOX_CHECK(trackAllocationSites_);
+  if (addr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(allocationSiteMutex_);
+  auto it = allocationSites_.find(reinterpret_cast<uint64_t>(addr));
+  if (it == allocationSites_.end()) {
+    return;
+  }
+  allocationSiteStats_[static_cast<int32_t>(it->second.site)].currentBytes -=
+      it->second.size;
+  allocationSites_.erase(it);
+}
+
+void MemoryPoolImpl::recordFreeSite(const Allocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordFreeSite(allocation.runAt(0).data());
+}
+
+void MemoryPoolImpl::recordFreeSite(const ContiguousAllocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordFreeSite(allocation.data());
+}
+
+void MemoryPoolImpl::recordGrowSite(const void* addr, uint64_t newSize) {
+  VELOX_CHECK(trackAllocationSites_);
+  if (addr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(allocationSiteMutex_);
+  auto it = allocationSites_.find(reinterpret_cast<uint64_t>(addr));
+  if (it == allocationSites_.end()) {
+    return;
+  }
+  auto& stats = allocationSiteStats_[static_cast<int32_t>(it->second.site)];
+  stats.currentBytes = stats.currentBytes - it->second.size + newSize;
+  stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
+  it->second.size = newSize;
+}
+
 void MemoryPoolImpl::leakCheckDbg() {
   VELOX_CHECK(debugEnabled_);
   if (debugAllocRecords_.empty()) {
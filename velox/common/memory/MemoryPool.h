@@ -33,6 +33,7 @@
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_bool(velox_memory_pool_track_allocation_sites);
 
 namespace facebook::velox::exec {
 class ParallelMemoryReclaimer;
@@ -64,6 +65,40 @@ constexpr int64_t kMaxMemory = std::numeric_limits<int64_t>::max();
 /// Sets the memory reclaimer to the provided memory pool.
 using SetMemoryReclaimer = std::function<void(MemoryPool*)>;
 
+/// The allocation sites that a memory pool with allocation site tracking
+/// enabled attributes its memory usage to. See ScopedMemoryAllocationSite.
+enum class MemoryAllocationSite : uint8_t {
+  /// The allocations made outside of any allocation site scope.
+  kOther = 0,
+  /// The fixed-width rows of a row container.
+  kRowContainer,
+  /// The variable-width data allocated from a hash string allocator.
+  kStringAllocator,
+  /// The bucket arrays of a hash table.
+  kHashTable,
+  /// The output vectors produced by an operator.
+  kOutput,
+};
+
+constexpr int32_t kNumMemoryAllocationSites = 5;
+
+std::string_view memoryAllocationSiteName(MemoryAllocationSite site);
+
+/// Object used to set/restore the allocation site of the memory allocations
+/// made by the running thread. The scopes can nest and the innermost one takes
+/// effect.
+class ScopedMemoryAllocationSite {
+ public:
+  explicit ScopedMemoryAllocationSite(MemoryAllocationSite site);
+  ~ScopedMemoryAllocationSite();
+
+ private:
+  const MemoryAllocationSite savedSite_;
+};
+
+/// Returns the allocation site set by the running thread.
+MemoryAllocationSite memoryAllocationSite();
+
 /// This class provides the memory allocation interfaces for a query execution.
 /// Each query execution entity creates a dedicated memory pool object. The
 /// memory pool objects from a query are organized as a tree with four levels
@@ -157,6 +192,10 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
 
+    /// If true, a leaf memory pool attributes its memory usage to the
+    /// allocation sites. See allocationSiteStats().
+    bool trackAllocationSites{FLAGS_velox_memory_pool_track_allocation_sites};
+
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
@@ -477,6 +516,40 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Returns the stats of this memory pool.
   virtual Stats stats() const = 0;
 
+  /// The number of allocation size buckets in AllocationSiteStats. Bucket i
+  /// counts the allocations of up to kAllocationSizeBucketBytes[i] bytes and
+  /// larger than the limit of bucket i - 1. The last bucket has no limit.
+  static constexpr int32_t kNumAllocationSizeBuckets = 6;
+  static constexpr std::array<uint64_t, kNumAllocationSizeBuckets - 1>
+      kAllocationSizeBucketBytes{256, 4 << 10, 64 << 10, 1 << 20, 16 << 20};
+
+  /// Returns the name of an allocation size bucket such as 'UpTo4KB'.
+  static std::string_view allocationSizeBucketName(size_t bucket);
+
+  /// The memory usage of a leaf memory pool attributed to an allocation site.
+  struct AllocationSiteStats {
+    /// The current memory usage.
+    uint64_t currentBytes{0};
+    /// The peak memory usage.
+    uint64_t peakBytes{0};
+    /// The number of memory allocations.
+    uint64_t numAllocs{0};
+    /// The number of memory allocations by size.
+    std::array<uint64_t, kNumAllocationSizeBuckets> sizeHistogram{};
+  };
+
+  /// Returns the memory usage of this memory pool by allocation site indexed by
+  /// MemoryAllocationSite. The stats are all zero if allocation site tracking
+  /// is not enabled or this is not a leaf memory pool.
+  virtual std::array<AllocationSiteStats, kNumMemoryAllocationSites>
+  allocationSiteStats() const = 0;
+
+  /// Returns true if this memory pool tracks its memory usage by allocation
+  /// site.
+  bool trackAllocationSites() const {
+    return trackAllocationSites_;
+  }
+
   virtual std::string toString() const = 0;
 
   /// Invoked to generate a descriptive memory usage summary of the entire tree.
@@ -534,6 +607,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool trackUsage_;
   const bool threadSafe_;
   const bool debugEnabled_;
+  const bool trackAllocationSites_;
   const bool coreOnAllocationFailureEnabled_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
@@ -690,6 +764,9 @@ class MemoryPoolImpl : public MemoryPool {
 
   Stats stats() const override;
 
+  std::array<AllocationSiteStats, kNumMemoryAllocationSites>
+  allocationSiteStats() const override;
+
   void testingSetCapacity(int64_t bytes);
 
   void testingSetReservation(int64_t bytes);
@@ -751,13 +828,16 @@ class MemoryPoolImpl : public MemoryPool {
   }
 
   FOLLY_ALWAYS_INLINE int64_t currentBytesLocked() const {
-    return isLeaf() ? usedReservationBytes_ : reservationBytes_;
+    return isLeaf() ? usedReservationBytes_ - cachedReservationBytes()
+                    : reservationBytes_;
   }
 
   FOLLY_ALWAYS_INLINE int64_t availableReservationLocked() const {
-    return !isLeaf()
-        ? 0
-        : std::max<int64_t>(0, reservationBytes_ - usedReservationBytes_);
+    return !isLeaf() ? 0
+                     : std::max<int64_t>(
+                           0,
+                           reservationBytes_ - usedReservationBytes_ +
+                               cachedReservationBytes());
   }
 
   FOLLY_ALWAYS_INLINE int64_t sizeAlign(int64_t size) {
@@ -813,6 +893,60 @@ class MemoryPoolImpl : public MemoryPool {
 
   void reserveThreadSafe(uint64_t size, bool reserveOnly = false);
 
+  // The lock-free reservation cache of a thread-safe leaf memory pool. Under
+  // 'mutex_', the pool moves up to 'kMaxCachedReservationBytes' of its unused
+  // reservation into 'usedReservationBytes_' and records it as cached bytes in
+  // 'cachedReservation_'. Reserving and releasing small sizes then only
+  // updates 'cachedReservation_' with a compare-and-swap, until the cache runs
+  // out or a release would shrink the quantized reservation. Those cases fall
+  // back to the mutex protected path, which drains the cache first. So
+  // 'reservationBytes_' changes exactly as it does without the cache. The
+  // cached bytes are subtracted from the reported used memory.
+  //
+  // The low 32 bits of the packed state are the cached bytes. The high 32 bits
+  // are the releasable bytes, which is how much the used memory can drop
+  // before a release must shrink the reservation.
+  static constexpr uint64_t kMaxCachedReservationBytes = 256 << 10;
+  static constexpr uint64_t kMaxReleasableBytes = 1ULL << 30;
+
+  FOLLY_ALWAYS_INLINE static uint64_t cachedBytes(uint64_t state) {
+    return state & 0xffffffff;
+  }
+
+  FOLLY_ALWAYS_INLINE static uint64_t releasableBytes(uint64_t state) {
+    return state >> 32;
+  }
+
+  FOLLY_ALWAYS_INLINE static uint64_t cacheState(
+      uint64_t cached,
+      uint64_t releasable) {
+    return (releasable << 32) | cached;
+  }
+
+  FOLLY_ALWAYS_INLINE int64_t cachedReservationBytes() const {
+    return cachedBytes(cachedReservation_);
+  }
+
+  // Tries to reserve 'size' bytes from the lock-free reservation cache. Returns
+  // false if the cache doesn't have enough bytes.
+  bool tryReserveCached(uint64_t size);
+
+  // Tries to return 'size' bytes to the lock-free reservation cache. Returns
+  // false if the cache is full or the release has to shrink the reservation.
+  bool tryReleaseCached(uint64_t size);
+
+  // Moves the cached bytes back out of 'usedReservationBytes_' and disables the
+  // cache. Called with 'mutex_' held before updating the reservation counters.
+  void drainReservationCacheLocked();
+
+  // Refills the cache from the unused reservation after the reservation
+  // counters have been updated with 'mutex_' held.
+  void refillReservationCacheLocked();
+
+  // Returns the smallest used memory that does not shrink the quantized
+  // reservation of a leaf memory pool on release.
+  int64_t minUsedBytesForReservationLocked() const;
+
   // Increments the reservation and checks against limits at root tracker. Calls
   // root tracker's 'growCallback_' if it is set and limit exceeded. Should be
   // called without holding 'mutex_'. This function returns true if reservation
@@ -936,7 +1070,8 @@ class MemoryPoolImpl : public MemoryPool {
     }
     out << "used " << succinctBytes(currentBytesLocked()) << " available "
         << succinctBytes(availableReservationLocked());
-    out << " reservation [used " << succinctBytes(usedReservationBytes_)
+    out << " reservation [used "
+        << succinctBytes(usedReservationBytes_ - cachedReservationBytes())
         << ", reserved " << succinctBytes(reservationBytes_) << ", min "
         << succinctBytes(minReservationBytes_);
     out << "] counters [allocs " << numAllocs_ << ", frees " << numFrees_
@@ -981,6 +1116,25 @@ class MemoryPoolImpl : public MemoryPool {
   // Accounts for ContiguousAllocation size change in growContiguous().
   void recordGrowDbg(const void* addr, uint64_t newSize);
 
+  // Invoked to attribute a buffer allocation to the allocation site of the
+  // running thread if allocation site tracking is enabled.
+  void recordAllocSite(const void* addr, uint64_t size);
+
+  void recordAllocSite(const Allocation& allocation);
+
+  void recordAllocSite(const ContiguousAllocation& allocation);
+
+  // Invoked to remove a buffer allocation from the allocation site it has been
+  // attributed to if allocation site tracking is enabled.
+  void recordFreeSite(const void* addr);
+
+  void recordFreeSite(const Allocation& allocation);
+
+  void recordFreeSite(const ContiguousAllocation& allocation);
+
+  // Accounts for ContiguousAllocation size change in growContiguous().
+  void recordGrowSite(const void* addr, uint64_t newSize);
+
   // Invoked by memory pool destructor to detect the sources of leaked memory
   // allocations from the call sites which are still recorded in
   // 'debugAllocRecords_'. If there is no memory leaks, 'debugAllocRecords_'
@@ -1022,9 +1176,13 @@ class MemoryPoolImpl : public MemoryPool {
 
   // The number of used reservation bytes which is maintained at the leaf
   // tracker and protected by mutex for consistent memory reservation/release
-  // decisions.
+  // decisions. This includes the cached bytes in 'cachedReservation_'.
   tsan_atomic<int64_t> usedReservationBytes_{0};
 
+  // The packed lock-free reservation cache state of a thread-safe leaf memory
+  // pool. See 'tryReserveCached()'.
+  std::atomic<uint64_t> cachedReservation_{0};
+
   // Minimum amount of reserved memory in bytes to hold until explicit
   // release().
   tsan_atomic<int64_t> minReservationBytes_{0};
@@ -1060,6 +1218,20 @@ class MemoryPoolImpl : public MemoryPool {
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // Mutex for 'allocationSites_' and 'allocationSiteStats_'.
+  mutable std::mutex allocationSiteMutex_;
+
+  struct AllocationSiteRecord {
+    MemoryAllocationSite site;
+    uint64_t size;
+  };
+
+  // Map from address to the allocation site and size of the allocation.
+  std::unordered_map<uint64_t, AllocationSiteRecord> allocationSites_;
+
+  std::array<AllocationSiteStats, kNumMemoryAllocationSites>
+      allocationSiteStats_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
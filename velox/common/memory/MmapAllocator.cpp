@@ -26,6 +26,7 @@
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
+      numNumaNodes_(std::max(1, options.numNumaNodes)),
       useMmapArena_(options.useMmapArena),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
@@ -35,16 +36,25 @@ MmapAllocator::MmapAllocator(const Options& options)
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+  // Each node's size classes cover the whole capacity, so that any node can
+  // serve any allocation within the capacity.
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    const auto numaNode = numNumaNodes_ == 1 ? kNoNumaNode : node;
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(
+          std::make_unique<SizeClass>(capacity_ / size, size, numaNode));
+    }
   }
 
   if (useMmapArena_) {
     const auto arenaSizeBytes = bits::roundUp(
         AllocationTraits::pageBytes(capacity_) / options.mmapArenaCapacityRatio,
         AllocationTraits::kPageSize);
-    managedArenas_ = std::make_unique<ManagedMmapArenas>(
-        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
+    for (auto node = 0; node < numNumaNodes_; ++node) {
+      managedArenas_.push_back(std::make_unique<ManagedMmapArenas>(
+          std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes),
+          numNumaNodes_ == 1 ? kNoNumaNode : node));
+    }
   }
 }
 
@@ -91,14 +101,16 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
   MachinePageCount newMapsNeeded = 0;
+  const auto firstSizeClass = numaNodeIndex() * sizeClassSizes_.size();
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success =
+              sizeClasses_[firstSizeClass + sizeMix.sizeIndices[i]]->allocate(
+                  sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -194,8 +206,8 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -250,7 +262,8 @@ bool MmapAllocator::allocateContiguousImpl(
     useHugePages(allocation, false);
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      managedArenas_->free(allocation.data(), allocation.maxSize());
+      arenasFor(allocation.data())
+          .free(allocation.data(), allocation.maxSize());
     } else {
       if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
         VELOX_MEM_LOG(ERROR) << "munmap got " << folly::errnoStr(errno)
@@ -327,15 +340,14 @@ bool MmapAllocator::allocateContiguousImpl(
   } else {
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
+      data = managedArenas_[numaNodeIndex()]->allocate(
+          AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapContiguous(AllocationTraits::pageBytes(maxPages));
+      if (numNumaNodes_ > 1 && data != MAP_FAILED && data != nullptr) {
+        bindToNumaNode(
+            data, AllocationTraits::pageBytes(maxPages), numaNodeIndex());
+      }
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -372,7 +384,7 @@ void MmapAllocator::freeContiguousImpl(ContiguousAllocation& allocation) {
   useHugePages(allocation, false);
   if (useMmapArena_) {
     std::lock_guard<std::mutex> l(arenaMutex_);
-    managedArenas_->free(allocation.data(), allocation.maxSize());
+    arenasFor(allocation.data()).free(allocation.data(), allocation.maxSize());
   } else {
     if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
       VELOX_MEM_LOG(ERROR) << "munmap returned " << folly::errnoStr(errno)
@@ -508,10 +520,26 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+ManagedMmapArenas& MmapAllocator::arenasFor(const void* address) {
+  if (managedArenas_.size() == 1) {
+    return *managedArenas_[0];
+  }
+  for (auto& arenas : managedArenas_) {
+    if (arenas->contains(address)) {
+      return *arenas;
+    }
+  }
+  VELOX_FAIL("Address {} is not in any MmapArena", address);
+}
+
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      numaNode_(numaNode),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -537,6 +565,11 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode_ != kNoNumaNode && !bindToNumaNode(ptr, byteSize_, numaNode_)) {
+    VELOX_MEM_LOG(WARNING) << "Could not bind sizeClass " << unitSize_
+                           << " to NUMA node " << numaNode_ << ": "
+                           << folly::errnoStr(errno);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -964,7 +997,11 @@ std::string MmapAllocator::toString() const {
               : succinctBytes(
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_;
+  if (numNumaNodes_ > 1) {
+    out << " NUMA nodes " << numNumaNodes_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
@@ -78,6 +78,12 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If greater than 1, keeps a set of size classes and, with
+    /// 'useMmapArena', of MmapArenas for each of 'numNumaNodes' NUMA nodes.
+    /// The memory of each set is bound to its node and allocations are served
+    /// from the set of currentNumaNode(). The capacity is shared by all nodes.
+    int32_t numNumaNodes = 1;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -157,6 +163,10 @@ class MmapAllocator : public MemoryAllocator {
     return stats;
   }
 
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
   std::string toString() const override;
 
  private:
@@ -166,7 +176,12 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not kNoNumaNode, the address range is bound to
+    // 'numaNode'.
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = kNoNumaNode);
 
     ~SizeClass();
 
@@ -274,6 +289,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // The NUMA node the address range is bound to or kNoNumaNode.
+    const int32_t numaNode_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -370,8 +388,20 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the index of the NUMA node to allocate from for the calling
+  // thread.
+  int32_t numaNodeIndex() const {
+    return numNumaNodes_ == 1 ? 0 : currentNumaNode() % numNumaNodes_;
+  }
+
+  // Returns the arenas containing 'address'.
+  ManagedMmapArenas& arenasFor(const void* address);
+
   const Kind kind_;
 
+  // Number of sets of size classes and arenas, each bound to one NUMA node.
+  const int32_t numNumaNodes_;
+
   // If set true, allocations larger than the largest size class size will be
   // delegated to ManagedMmapArena. Otherwise, a system mmap call will be
   // issued for each such allocation.
@@ -406,6 +436,8 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // The size classes for each NUMA node. The size classes of node 'i' are at
+  // 'i' * sizeClassSizes_.size().
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
@@ -415,9 +447,10 @@ class MmapAllocator : public MemoryAllocator {
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
-  // ManagedMmapArenas, to avoid calling mmap on every allocation.
+  // ManagedMmapArenas, to avoid calling mmap on every allocation. There is one
+  // ManagedMmapArenas per NUMA node.
   std::mutex arenaMutex_;
-  std::unique_ptr<ManagedMmapArenas> managedArenas_;
+  std::vector<std::unique_ptr<ManagedMmapArenas>> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
 };
@@ -25,7 +25,8 @@ uint64_t MmapArena::roundBytes(uint64_t bytes) {
   return bits::nextPowerOfTwo(bytes);
 }
 
-MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
+MmapArena::MmapArena(size_t capacityBytes, int32_t numaNode)
+    : byteSize_(capacityBytes) {
   VELOX_CHECK_EQ(
       byteSize_ % kMinGrainSizeBytes,
       0,
@@ -46,6 +47,10 @@ MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
         capacityBytes);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode != kNoNumaNode && !bindToNumaNode(ptr, byteSize_, numaNode)) {
+    VELOX_MEM_LOG(WARNING) << "Could not bind MmapArena to NUMA node "
+                           << numaNode << ": " << folly::errnoStr(errno);
+  }
   addFreeBlock(reinterpret_cast<uintptr_t>(address_), byteSize_);
   freeBytes_ = byteSize_;
 }
@@ -277,9 +282,11 @@ std::string MmapArena::toString() const {
       freeList_.size());
 }
 
-ManagedMmapArenas::ManagedMmapArenas(uint64_t singleArenaCapacity)
-    : singleArenaCapacity_(singleArenaCapacity) {
-  auto arena = std::make_shared<MmapArena>(singleArenaCapacity);
+ManagedMmapArenas::ManagedMmapArenas(
+    uint64_t singleArenaCapacity,
+    int32_t numaNode)
+    : singleArenaCapacity_(singleArenaCapacity), numaNode_(numaNode) {
+  auto arena = std::make_shared<MmapArena>(singleArenaCapacity, numaNode_);
   arenas_.emplace(reinterpret_cast<uintptr_t>(arena->address()), arena);
   currentArena_ = arena;
 }
@@ -293,12 +300,22 @@ void* ManagedMmapArenas::allocate(uint64_t bytes) {
   // If first allocation fails we create a new MmapArena for another attempt. If
   // it ever fails again then it means requested bytes is larger than a single
   // MmapArena's capacity. No further attempts will happen.
-  auto newArena = std::make_shared<MmapArena>(singleArenaCapacity_);
+  auto newArena = std::make_shared<MmapArena>(singleArenaCapacity_, numaNode_);
   arenas_.emplace(reinterpret_cast<uintptr_t>(newArena->address()), newArena);
   currentArena_ = newArena;
   return currentArena_->allocate(bytes);
 }
 
+bool ManagedMmapArenas::contains(const void* address) const {
+  const auto addressU64 = reinterpret_cast<uintptr_t>(address);
+  auto iter = arenas_.upper_bound(addressU64);
+  if (iter == arenas_.begin()) {
+    return false;
+  }
+  --iter;
+  return addressU64 < iter->first + iter->second->byteSize();
+}
+
 void ManagedMmapArenas::free(void* address, uint64_t bytes) {
   VELOX_CHECK(!arenas_.empty());
   const auto addressU64 = reinterpret_cast<uintptr_t>(address);
@@ -23,6 +23,7 @@
 #include <unordered_set>
 
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/common/memory/Numa.h"
 
 namespace facebook::velox::memory {
 
@@ -36,7 +37,9 @@ class MmapArena {
   /// MmapArena capacity should be multiple of kMinGrainSizeBytes.
   static constexpr uint64_t kMinGrainSizeBytes = 1024 * 1024; // 1M
 
-  explicit MmapArena(size_t capacityBytes);
+  /// If 'numaNode' is not kNoNumaNode, the memory of the arena is bound to
+  /// 'numaNode'.
+  explicit MmapArena(size_t capacityBytes, int32_t numaNode = kNoNumaNode);
   ~MmapArena();
 
   void* allocate(uint64_t bytes);
@@ -124,12 +127,19 @@ class MmapArena {
 /// fragmentation happens.
 class ManagedMmapArenas {
  public:
-  explicit ManagedMmapArenas(uint64_t singleArenaCapacity);
+  /// If 'numaNode' is not kNoNumaNode, the memory of all the arenas is bound to
+  /// 'numaNode'.
+  explicit ManagedMmapArenas(
+      uint64_t singleArenaCapacity,
+      int32_t numaNode = kNoNumaNode);
 
   void* allocate(uint64_t bytes);
 
   void free(void* address, uint64_t bytes);
 
+  /// Returns true if 'address' is in one of the arenas of 'this'.
+  bool contains(const void* address) const;
+
   const std::map<uintptr_t, std::shared_ptr<MmapArena>>& arenas() const {
     return arenas_;
   }
@@ -138,6 +148,9 @@ class ManagedMmapArenas {
   // Capacity in bytes for a single MmapArena managed by this.
   const uint64_t singleArenaCapacity_;
 
+  // The NUMA node the arenas are bound to or kNoNumaNode.
+  const int32_t numaNode_;
+
   // A sorted list of MmapArena by its initial address
   std::map<uintptr_t, std::shared_ptr<MmapArena>> arenas_;
 
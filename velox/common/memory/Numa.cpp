@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/Numa.h"
+
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include <fmt/format.h>
+
+namespace facebook::velox::memory {
+namespace {
+// Memory policy of mbind() that prefers a node. From linux/mempolicy.h.
+constexpr int kMpolPreferred = 1;
+
+thread_local int32_t threadNumaNode = kNoNumaNode;
+
+int32_t countNumaNodes() {
+  int32_t count = 0;
+  while (::access(
+             fmt::format("/sys/devices/system/node/node{}", count).c_str(),
+             F_OK) == 0) {
+    ++count;
+  }
+  return count == 0 ? 1 : count;
+}
+} // namespace
+
+int32_t numNumaNodes() {
+  static const int32_t count = countNumaNodes();
+  return count;
+}
+
+int32_t currentNumaNode() {
+  if (threadNumaNode != kNoNumaNode) {
+    return threadNumaNode;
+  }
+#ifdef __linux__
+  unsigned cpu;
+  unsigned node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+void setThreadNumaNode(int32_t node) {
+  threadNumaNode = node;
+}
+
+bool bindToNumaNode(void* address, size_t bytes, int32_t node) {
+#ifdef __linux__
+  if (node < 0 || node >= 64) {
+    return false;
+  }
+  const unsigned long nodeMask = 1UL << node;
+  return ::syscall(
+             SYS_mbind,
+             address,
+             bytes,
+             kMpolPreferred,
+             &nodeMask,
+             sizeof(nodeMask) * 8,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace facebook::velox::memory
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace facebook::velox::memory {
+
+/// Denotes memory that is not bound to a NUMA node.
+constexpr int32_t kNoNumaNode = -1;
+
+/// Returns the number of NUMA nodes of the host. Returns 1 if the host has no
+/// NUMA information.
+int32_t numNumaNodes();
+
+/// Returns the NUMA node the calling thread should allocate memory from. This
+/// is the node set by setThreadNumaNode() or, if none is set, the node of the
+/// CPU the thread runs on. Returns 0 if the node is unknown.
+int32_t currentNumaNode();
+
+/// Sets the NUMA node memory allocations of the calling thread come from.
+/// Executors that pin their threads to the CPUs of a node set the node of
+/// each thread so that allocations do not depend on where the thread happens
+/// to run. kNoNumaNode reverts to the node of the current CPU.
+void setThreadNumaNode(int32_t node);
+
+/// Sets the memory policy of the 'bytes' bytes at 'address' to prefer 'node'.
+/// Pages that are not yet backed by memory are then allocated on 'node' when
+/// first touched, or on another node if 'node' has no free memory. Returns
+/// false if the policy could not be set.
+bool bindToNumaNode(void* address, size_t bytes, int32_t node);
+
+} // namespace facebook::velox::memory
@@ -78,6 +78,8 @@ void sortCandidatesByReclaimableFreeCapacity(
       &candidates);
 }
 
+// Sorts the lowest priority class first and by reclaimable used capacity
+// within a class.
 void sortCandidatesByReclaimableUsedCapacity(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -85,6 +87,9 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority > rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -93,6 +98,7 @@ void sortCandidatesByReclaimableUsedCapacity(
       &candidates);
 }
 
+// Sorts the lowest priority class first and by usage within a class.
 void sortCandidatesByUsage(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -100,32 +106,43 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority > rhs.priority;
+        }
         return lhs.currentBytes > rhs.currentBytes;
       });
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
-// capacity for comparison including its current capacity and the capacity to
-// grow.
+// Finds the candidate with the largest capacity in the lowest priority class.
+// For 'requestor', the capacity for comparison including its current capacity
+// and the capacity to grow. Candidates for which 'isProtected' returns true are
+// skipped unless they are the requestor.
 const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes,
-    const std::vector<SharedArbitrator::Candidate>& candidates) {
+    const std::vector<SharedArbitrator::Candidate>& candidates,
+    const std::function<bool(const SharedArbitrator::Candidate&)>&
+        isProtected) {
   VELOX_CHECK(!candidates.empty());
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
     const bool isCandidate = candidates[i].pool == requestor;
+    if (!isCandidate && isProtected(candidates[i])) {
+      continue;
+    }
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1 ||
+        candidates[i].priority > candidates[candidateIdx].priority) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
-    if (capacity < maxCapacity) {
+    if (candidates[i].priority < candidates[candidateIdx].priority ||
+        capacity < maxCapacity) {
       continue;
     }
     if (capacity > maxCapacity) {
@@ -153,10 +170,11 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] PRIORITY[{}]]",
       pool->root()->name(),
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
 }
 
 SharedArbitrator::~SharedArbitrator() {
@@ -186,7 +204,8 @@ void SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->currentBytes(),
-         pool.get()});
+         pool.get(),
+         priority(*pool)});
   }
 }
 
@@ -211,7 +230,21 @@ int64_t SharedArbitrator::maxReclaimableCapacity(
   if (isSelfReclaim || (pool.currentBytes() == 0 && pool.peakBytes() != 0)) {
     return pool.capacity();
   }
-  return std::max<int64_t>(0, pool.capacity() - memoryPoolReservedCapacity_);
+  return std::max<int64_t>(0, pool.capacity() - guaranteedCapacity(pool));
+}
+
+uint32_t SharedArbitrator::priority(const MemoryPool& pool) const {
+  return arbitrationPriorityCb_ == nullptr ? 0 : arbitrationPriorityCb_(pool);
+}
+
+uint64_t SharedArbitrator::guaranteedCapacity(const MemoryPool& pool) const {
+  const auto priorityClass = priority(pool);
+  if (priorityClass >= priorityGuaranteedCapacities_.size()) {
+    return memoryPoolReservedCapacity_;
+  }
+  return std::max(
+      memoryPoolReservedCapacity_,
+      priorityGuaranteedCapacities_[priorityClass]);
 }
 
 int64_t SharedArbitrator::reclaimableFreeCapacity(
@@ -542,9 +575,16 @@ bool SharedArbitrator::ensureCapacity(ArbitrationOperation* op) {
 }
 
 bool SharedArbitrator::handleOOM(ArbitrationOperation* op) {
-  MemoryPool* victim = findCandidateWithLargestCapacity(
-                           op->requestRoot, op->targetBytes, op->candidates)
-                           .pool;
+  MemoryPool* victim =
+      findCandidateWithLargestCapacity(
+          op->requestRoot,
+          op->targetBytes,
+          op->candidates,
+          [&](const Candidate& candidate) {
+            return candidate.pool->capacity() <=
+                guaranteedCapacity(*candidate.pool);
+          })
+          .pool;
   if (op->requestRoot == victim) {
     VELOX_MEM_LOG(ERROR)
         << "Requestor memory pool " << op->requestRoot->name()
@@ -686,7 +726,8 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(reclaimedBytes, reclaimTargetBytes);
     if (candidate.reclaimableBytes == 0) {
-      break;
+      // The candidates are sorted by priority class first.
+      continue;
     }
     reclaimedBytes +=
         reclaim(candidate.pool, reclaimTargetBytes - reclaimedBytes, false);
@@ -707,7 +748,14 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(freedBytes, reclaimTargetBytes);
     if (candidate.pool->capacity() == 0) {
-      break;
+      // The candidates are sorted by priority class first.
+      continue;
+    }
+    // The guaranteed capacity protects from the memory requests of the other
+    // queries but not from a shrink request to free up the process memory.
+    if (op->requestRoot != nullptr && candidate.pool != op->requestRoot &&
+        candidate.pool->capacity() <= guaranteedCapacity(*candidate.pool)) {
+      continue;
     }
     try {
       VELOX_MEM_POOL_ABORTED(fmt::format(
@@ -70,6 +70,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t freeBytes{0};
     int64_t currentBytes{0};
     MemoryPool* pool;
+    /// The arbitration priority class. See
+    /// MemoryArbitrator::Config::arbitrationPriorityCb.
+    uint32_t priority{0};
 
     std::string toString() const;
   };
@@ -338,6 +341,14 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   int64_t reclaimableUsedCapacity(const MemoryPool& pool, bool isSelfReclaim)
       const;
 
+  // Returns the arbitration priority class of 'pool'.
+  uint32_t priority(const MemoryPool& pool) const;
+
+  // Returns the capacity that is not reclaimed from 'pool' on behalf of the
+  // other queries. This is the larger of 'memoryPoolReservedCapacity_' and the
+  // guaranteed capacity of the priority class of 'pool'.
+  uint64_t guaranteedCapacity(const MemoryPool& pool) const;
+
   // Returns the minimal amount of memory capacity to grow for 'pool' to have
   // the reserved capacity as specified by 'memoryPoolReservedCapacity_'.
   int64_t minGrowCapacity(const MemoryPool& pool) const;
@@ -320,6 +320,114 @@ TEST_F(HashStringAllocatorTest, mixedMultipart) {
   allocator_->checkConsistency();
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  constexpr int32_t kNumSamples = 2'000;
+  std::vector<Multipart> data(kNumSamples);
+  auto append = [&](Multipart& part, const std::string& chars) {
+    ByteOutputStream stream(allocator_.get());
+    if (part.start.header) {
+      allocator_->extendWrite(part.current, stream);
+    } else {
+      part.start = allocator_->newWrite(stream, chars.size());
+      part.current = part.start;
+    }
+    stream.appendStringView(chars);
+    part.current = allocator_->finishWrite(stream, rand32() % 100).second;
+    part.reference.insert(part.reference.end(), chars.begin(), chars.end());
+  };
+  for (auto count = 0; count < 3; ++count) {
+    for (auto& part : data) {
+      append(part, randomString());
+    }
+  }
+  // A multipart entry with a block from the pool between blocks from the
+  // slabs.
+  Multipart mixed;
+  append(mixed, std::string(25, 'x'));
+  {
+    const std::string extraLongString(5'000, 'y');
+    ByteOutputStream stream(allocator_.get());
+    allocator_->extendWrite(mixed.current, stream);
+    ByteRange range;
+    allocator_->newContiguousRange(extraLongString.size(), &range);
+    stream.setRange(range, 0);
+    stream.appendStringView(extraLongString);
+    mixed.current = allocator_->finishWrite(stream, 0).second;
+    mixed.reference += extraLongString;
+  }
+  append(mixed, std::string(25, 'z'));
+
+  // Free most entries to leave the live data scattered over the slabs.
+  for (auto i = 0; i < kNumSamples; ++i) {
+    if (i % 10 != 0) {
+      checkAndFree(data[i]);
+    }
+  }
+  const auto allocatedBytes = allocator_->checkConsistency();
+  const auto cumulativeBytes = allocator_->cumulativeBytes();
+  const auto retainedSize = allocator_->retainedSize();
+
+  int32_t numRelocations = 0;
+  const auto freedBytes =
+      allocator_->compact([&](const HSA::Relocation& relocation) {
+        ++numRelocations;
+        // The old locations remain readable until the callback returns.
+        for (auto& part : data) {
+          if (part.start.isSet()) {
+            ASSERT_EQ(
+                0,
+                memcmp(
+                    part.start.position,
+                    part.reference.data(),
+                    std::min<size_t>(part.reference.size(), 16)));
+            part.start = relocation.relocate(part.start);
+            part.current = relocation.relocate(part.current);
+          }
+        }
+        mixed.start = relocation.relocate(mixed.start);
+        mixed.current = relocation.relocate(mixed.current);
+      });
+  ASSERT_EQ(1, numRelocations);
+  ASSERT_GT(freedBytes, 0);
+  ASSERT_EQ(retainedSize - freedBytes, allocator_->retainedSize());
+  ASSERT_EQ(allocatedBytes, allocator_->checkConsistency());
+  ASSERT_EQ(cumulativeBytes, allocator_->cumulativeBytes());
+  for (const auto& part : data) {
+    if (part.start.isSet()) {
+      checkMultipart(part);
+    }
+  }
+  checkMultipart(mixed);
+
+  // The relocated positions can be extended and freed.
+  for (auto& part : data) {
+    if (part.start.isSet()) {
+      append(part, randomString());
+      checkMultipart(part);
+    }
+  }
+  allocator_->checkConsistency();
+  for (auto& part : data) {
+    if (part.start.isSet()) {
+      checkAndFree(part);
+    }
+  }
+  checkAndFree(mixed);
+  allocator_->checkEmpty();
+
+  // Compacting an empty allocator frees all the slabs.
+  const auto emptyRetainedSize = allocator_->retainedSize();
+  ASSERT_GT(emptyRetainedSize, 0);
+  ASSERT_EQ(
+      emptyRetainedSize,
+      allocator_->compact([](const HSA::Relocation& relocation) {
+        ASSERT_EQ(0, relocation.numMoved());
+      }));
+  ASSERT_EQ(0, allocator_->retainedSize());
+  // Without free space compaction does nothing.
+  ASSERT_EQ(0, allocator_->compact([](const HSA::Relocation&) { FAIL(); }));
+}
+
 TEST_F(HashStringAllocatorTest, rewrite) {
   ByteOutputStream stream(allocator_.get());
   auto header = allocator_->allocate(5);
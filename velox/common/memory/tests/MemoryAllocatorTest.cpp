@@ -25,6 +25,7 @@
 #include <fmt/format.h>
 #include <folly/Random.h>
 #include <folly/Range.h>
+#include <folly/ScopeGuard.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gmock/gmock-matchers.h>
@@ -475,6 +476,43 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaNodes) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useMmapArena = true;
+  options.numNumaNodes = 2;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(allocator->numNumaNodes(), 2);
+  auto guard = folly::makeGuard([]() { setThreadNumaNode(kNoNumaNode); });
+
+  // Allocations from either node share the capacity and can be freed from any
+  // thread.
+  std::vector<Allocation> allocations(2);
+  std::vector<ContiguousAllocation> contiguousAllocations(2);
+  const auto largeClassPages = allocator->sizeClasses().back();
+  for (auto node = 0; node < 2; ++node) {
+    setThreadNumaNode(node);
+    ASSERT_TRUE(allocator->allocateNonContiguous(100, allocations[node]));
+    ASSERT_TRUE(allocator->allocateContiguous(
+        largeClassPages * 2, nullptr, contiguousAllocations[node]));
+  }
+  ASSERT_EQ(allocator->numAllocated(), 2 * (100 + largeClassPages * 2));
+  ASSERT_TRUE(allocator->checkConsistency());
+  ASSERT_NE(allocations[0].runAt(0).data(), allocations[1].runAt(0).data());
+  ASSERT_THAT(allocator->toString(), testing::HasSubstr("NUMA nodes 2"));
+
+  setThreadNumaNode(kNoNumaNode);
+  for (auto node = 0; node < 2; ++node) {
+    allocator->freeNonContiguous(allocations[node]);
+    allocator->freeContiguous(contiguousAllocations[node]);
+  }
+  ASSERT_EQ(allocator->numAllocated(), 0);
+  ASSERT_TRUE(allocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -1465,6 +1503,33 @@ TEST_P(MemoryAllocatorTest, contiguousAllocation) {
   allocation->clear();
 }
 
+#ifdef linux
+TEST_P(MemoryAllocatorTest, contiguousAllocationHugePageAlignment) {
+  const auto numHugePages = AllocationTraits::numPagesInHugePage();
+  for (const auto numPages :
+       {numHugePages, numHugePages + 1, 8 * numHugePages + 3}) {
+    SCOPED_TRACE(fmt::format("numPages {}", numPages));
+    ContiguousAllocation allocation;
+    ASSERT_TRUE(instance_->allocateContiguous(numPages, nullptr, allocation));
+    ASSERT_EQ(
+        reinterpret_cast<uintptr_t>(allocation.data()) %
+            AllocationTraits::kHugePageSize,
+        0);
+    // All the huge pages that fit into the allocation are usable.
+    ASSERT_EQ(
+        allocation.hugePageRange().value().size(),
+        allocation.size() / AllocationTraits::kHugePageSize *
+            AllocationTraits::kHugePageSize);
+    ::memset(allocation.data(), 1, allocation.size());
+    const auto hugePageBytes = MemoryAllocator::hugePageBytes(
+        {folly::Range<char*>(allocation.data<char>(), allocation.size())});
+    ASSERT_LE(hugePageBytes, allocation.size());
+    instance_->freeContiguous(allocation);
+  }
+  ASSERT_EQ(MemoryAllocator::hugePageBytes({}), 0);
+}
+#endif
+
 TEST_P(MemoryAllocatorTest, allocatorCapacity) {
   const std::vector<size_t> preExistingBytesVec{
       0, kCapacityBytes / 2, kCapacityBytes / 4 * 3};
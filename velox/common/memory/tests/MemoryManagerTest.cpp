@@ -249,6 +249,44 @@ TEST_F(MemoryManagerTest, addPoolWithArbitrator) {
   ASSERT_EQ(aggregationPool->capacity(), initialPoolCapacity);
 }
 
+TEST_F(MemoryManagerTest, backgroundReclaim) {
+  const uint64_t kCapacity = 512L << 20;
+  for (const bool runInBackground : {false, true}) {
+    SCOPED_TRACE(fmt::format("runInBackground {}", runInBackground));
+    MemoryManagerOptions options;
+    options.allocatorCapacity = kCapacity;
+    options.arbitratorKind = arbitratorKind_;
+    options.memoryPoolInitCapacity = kCapacity / 4;
+    options.memoryPoolTransferCapacity = 32L << 20;
+    options.backgroundReclaimHighWatermarkPct = 90;
+    options.backgroundReclaimLowWatermarkPct = 50;
+    options.backgroundReclaimIntervalMs = runInBackground ? 10 : 0;
+    MemoryManager manager{options};
+
+    // The idle root pools take all the arbitrator capacity.
+    std::vector<std::shared_ptr<MemoryPool>> rootPools;
+    for (int i = 0; i < 4; ++i) {
+      rootPools.push_back(manager.addRootPool(
+          fmt::format("backgroundReclaim{}", i),
+          kMaxMemory,
+          MemoryReclaimer::create()));
+    }
+    if (runInBackground) {
+      for (int i = 0; i < 500 &&
+           manager.arbitrator()->stats().freeCapacityBytes < kCapacity / 2;
+           ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    } else {
+      ASSERT_EQ(manager.arbitrator()->stats().freeCapacityBytes, 0);
+      ASSERT_GE(manager.runBackgroundReclaim(), kCapacity / 2);
+    }
+    ASSERT_GE(manager.arbitrator()->stats().freeCapacityBytes, kCapacity / 2);
+    // The usage is below the high watermark.
+    ASSERT_EQ(manager.runBackgroundReclaim(), 0);
+  }
+}
+
 // TODO: remove this test when remove deprecatedDefaultMemoryManager.
 TEST_F(MemoryManagerTest, defaultMemoryManager) {
   auto& managerA = toMemoryManager(deprecatedDefaultMemoryManager());
@@ -2549,6 +2549,77 @@ TEST(MemoryPoolTest, debugMode) {
   EXPECT_EQ(allocRecords.size(), 0);
 }
 
+TEST(MemoryPoolTest, allocationSiteStats) {
+  MemoryManagerOptions options;
+  options.allocatorCapacity = 10 * GB;
+  options.trackAllocationSites = true;
+  MemoryManager manager{options};
+  auto root = manager.addRootPool("allocationSiteStats");
+  auto pool = root->addLeafChild("allocationSiteStats");
+  ASSERT_TRUE(pool->trackAllocationSites());
+  const auto siteStats = [&](MemoryAllocationSite site) {
+    return pool->allocationSiteStats()[static_cast<int32_t>(site)];
+  };
+
+  void* otherBuffer = pool->allocate(128);
+  void* hashTableBuffer{nullptr};
+  Allocation rows;
+  ContiguousAllocation strings;
+  {
+    ScopedMemoryAllocationSite hashTableSite(MemoryAllocationSite::kHashTable);
+    hashTableBuffer = pool->allocate(8 * KB);
+    {
+      ScopedMemoryAllocationSite rowContainerSite(
+          MemoryAllocationSite::kRowContainer);
+      pool->allocateNonContiguous(AllocationTraits::numPages(128 * KB), rows);
+    }
+    ASSERT_EQ(memoryAllocationSite(), MemoryAllocationSite::kHashTable);
+    ScopedMemoryAllocationSite stringSite(
+        MemoryAllocationSite::kStringAllocator);
+    pool->allocateContiguous(
+        AllocationTraits::numPages(2 * MB),
+        strings,
+        AllocationTraits::numPages(4 * MB));
+  }
+  ASSERT_EQ(memoryAllocationSite(), MemoryAllocationSite::kOther);
+
+  auto stats = siteStats(MemoryAllocationSite::kOther);
+  ASSERT_EQ(stats.currentBytes, 128);
+  ASSERT_EQ(stats.numAllocs, 1);
+  ASSERT_EQ(stats.sizeHistogram[0], 1);
+  stats = siteStats(MemoryAllocationSite::kHashTable);
+  ASSERT_EQ(stats.currentBytes, 8 * KB);
+  ASSERT_EQ(stats.sizeHistogram[2], 1);
+  stats = siteStats(MemoryAllocationSite::kRowContainer);
+  ASSERT_EQ(stats.currentBytes, rows.byteSize());
+  ASSERT_EQ(stats.sizeHistogram[3], 1);
+  stats = siteStats(MemoryAllocationSite::kStringAllocator);
+  ASSERT_EQ(stats.currentBytes, 2 * MB);
+  ASSERT_EQ(stats.sizeHistogram[4], 1);
+  ASSERT_EQ(siteStats(MemoryAllocationSite::kOutput).numAllocs, 0);
+
+  // Growing and freeing the allocations update the sites they are attributed
+  // to regardless of the current allocation site.
+  pool->growContiguous(AllocationTraits::numPages(2 * MB), strings);
+  stats = siteStats(MemoryAllocationSite::kStringAllocator);
+  ASSERT_EQ(stats.currentBytes, 4 * MB);
+  ASSERT_EQ(stats.peakBytes, 4 * MB);
+  pool->freeContiguous(strings);
+  pool->freeNonContiguous(rows);
+  pool->free(hashTableBuffer, 8 * KB);
+  pool->free(otherBuffer, 128);
+  for (const auto& stat : pool->allocationSiteStats()) {
+    ASSERT_EQ(stat.currentBytes, 0);
+  }
+  ASSERT_EQ(
+      siteStats(MemoryAllocationSite::kStringAllocator).peakBytes, 4 * MB);
+  ASSERT_EQ(siteStats(MemoryAllocationSite::kHashTable).peakBytes, 8 * KB);
+
+  ASSERT_EQ(
+      memoryAllocationSiteName(MemoryAllocationSite::kHashTable), "hashTable");
+  ASSERT_EQ(MemoryPool::allocationSizeBucketName(1), "UpTo4KB");
+}
+
 TEST(MemoryPoolTest, debugModeWithFilter) {
   constexpr int64_t kMaxMemory = 10 * GB;
   constexpr int64_t kNumIterations = 100;
@@ -3435,6 +3506,76 @@ TEST_P(MemoryPoolTest, quantizedSize) {
   }
 }
 
+TEST_P(MemoryPoolTest, smallAllocationReservation) {
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("smallAllocationReservation");
+  auto leaf = root->addLeafChild(
+      "smallAllocationReservation", isLeafThreadSafe_);
+
+  // The reservation must follow the quantized used memory while small
+  // allocations and frees cross the quantization boundaries.
+  constexpr int64_t kBufferSize = 8 * KB;
+  std::vector<void*> buffers;
+  while (leaf->currentBytes() < 70 * MB) {
+    buffers.push_back(leaf->allocate(kBufferSize));
+    ASSERT_EQ(
+        leaf->reservedBytes(),
+        MemoryPool::quantizedSize(leaf->currentBytes()));
+    ASSERT_EQ(
+        leaf->availableReservation(),
+        leaf->reservedBytes() - leaf->currentBytes());
+  }
+  ASSERT_EQ(leaf->currentBytes(), buffers.size() * kBufferSize);
+  ASSERT_EQ(leaf->peakBytes(), leaf->currentBytes());
+  ASSERT_EQ(leaf->stats().cumulativeBytes, leaf->currentBytes());
+  ASSERT_EQ(root->reservedBytes(), leaf->reservedBytes());
+  while (!buffers.empty()) {
+    leaf->free(buffers.back(), kBufferSize);
+    buffers.pop_back();
+    ASSERT_EQ(leaf->currentBytes(), buffers.size() * kBufferSize);
+    ASSERT_EQ(
+        leaf->reservedBytes(),
+        MemoryPool::quantizedSize(leaf->currentBytes()));
+  }
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // Concurrent small allocations and frees from the same leaf pool.
+  if (!isLeafThreadSafe_) {
+    return;
+  }
+  const int32_t kNumThreads = 8;
+  const int32_t kNumAllocsPerThread = 2'000;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(i);
+      std::vector<std::pair<void*, int64_t>> allocations;
+      for (int32_t j = 0; j < kNumAllocsPerThread; ++j) {
+        if (!allocations.empty() && folly::Random::oneIn(3, rng)) {
+          leaf->free(allocations.back().first, allocations.back().second);
+          allocations.pop_back();
+          continue;
+        }
+        const int64_t size = 1 + folly::Random::rand32(32 * KB, rng);
+        allocations.emplace_back(leaf->allocate(size), size);
+      }
+      for (const auto& [buffer, size] : allocations) {
+        leaf->free(buffer, size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(leaf->currentBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(leaf->availableReservation(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+  ASSERT_EQ(leaf->stats().numAllocs, leaf->stats().numFrees);
+}
+
 namespace {
 class MockMemoryReclaimer : public MemoryReclaimer {
  public:
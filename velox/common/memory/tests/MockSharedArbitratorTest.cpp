@@ -414,7 +414,9 @@ class MockSharedArbitrationTest : public testing::Test {
       uint64_t memoryPoolReserveCapacity = kMemoryPoolReservedCapacity,
       uint64_t memoryPoolTransferCapacity = kMemoryPoolTransferCapacity,
       std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
-      bool globalArtbitrationEnabled = true) {
+      bool globalArtbitrationEnabled = true,
+      MemoryArbitrationPriorityCB arbitrationPriorityCb = nullptr,
+      std::vector<uint64_t> priorityGuaranteedCapacities = {}) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     options.arbitratorReservedCapacity = reservedMemoryCapacity;
@@ -425,6 +427,9 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.globalArbitrationEnabled = globalArtbitrationEnabled;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
+    options.arbitrationPriorityCb = std::move(arbitrationPriorityCb);
+    options.priorityGuaranteedCapacities =
+        std::move(priorityGuaranteedCapacities);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), arbitratorKind);
@@ -632,6 +637,86 @@ TEST_F(MockSharedArbitrationTest, arbitrationFailsTask) {
   growOp->freeAll();
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrationPriority) {
+  // The pools in 'lowPriorityPools' are in priority class 1, the others in 0.
+  auto lowPriorityPools = std::make_shared<std::vector<const MemoryPool*>>();
+  auto priorityCb = [lowPriorityPools](const MemoryPool& pool) -> uint32_t {
+    return std::find(
+               lowPriorityPools->begin(), lowPriorityPools->end(), &pool) !=
+            lowPriorityPools->end()
+        ? 1
+        : 0;
+  };
+
+  for (const bool reclaimable : {true, false}) {
+    SCOPED_TRACE(fmt::format("reclaimable {}", reclaimable));
+    clearTasks();
+    lowPriorityPools->clear();
+    setupMemory(
+        kMemoryCapacity,
+        kReservedMemoryCapacity,
+        kMemoryPoolInitCapacity,
+        kMemoryPoolReservedCapacity,
+        kMemoryPoolTransferCapacity,
+        nullptr,
+        true,
+        priorityCb);
+
+    // Without priorities the larger 'highTask' would be spilled or aborted
+    // first.
+    auto highTask = addTask();
+    auto* highOp = addMemoryOp(highTask, reclaimable);
+    highOp->allocate(256 * MB);
+    auto lowTask = addTask();
+    lowPriorityPools->push_back(lowTask->pool());
+    auto* lowOp = addMemoryOp(lowTask, reclaimable);
+    lowOp->allocate(96 * MB);
+
+    auto requestTask = addTask();
+    auto* requestOp = addMemoryOp(requestTask, false);
+    requestOp->allocate(64 * MB);
+
+    if (reclaimable) {
+      ASSERT_EQ(highOp->reclaimer()->stats().numReclaims, 0);
+      ASSERT_GT(lowOp->reclaimer()->stats().numReclaims, 0);
+    } else {
+      ASSERT_EQ(highTask->error(), nullptr);
+      ASSERT_NE(lowTask->error(), nullptr);
+    }
+    ASSERT_EQ(requestTask->error(), nullptr);
+    highOp->freeAll();
+    lowOp->freeAll();
+    requestOp->freeAll();
+  }
+}
+
+TEST_F(MockSharedArbitrationTest, priorityGuaranteedCapacity) {
+  setupMemory(
+      kMemoryCapacity,
+      kReservedMemoryCapacity,
+      kMemoryPoolInitCapacity,
+      kMemoryPoolReservedCapacity,
+      kMemoryPoolTransferCapacity,
+      nullptr,
+      true,
+      nullptr,
+      {384 * MB});
+
+  auto guaranteedTask = addTask();
+  auto* guaranteedOp = addMemoryOp(guaranteedTask, false);
+  guaranteedOp->allocate(256 * MB);
+
+  // The requestor is the only abort victim since the larger 'guaranteedTask'
+  // is within its guaranteed capacity.
+  auto requestTask = addTask();
+  auto* requestOp = addMemoryOp(requestTask, false);
+  requestOp->allocate(64 * MB);
+  VELOX_ASSERT_THROW(requestOp->allocate(192 * MB), "");
+  ASSERT_EQ(guaranteedTask->error(), nullptr);
+  guaranteedOp->freeAll();
+  requestOp->freeAll();
+}
+
 TEST_F(MockSharedArbitrationTest, shrinkPools) {
   const int64_t memoryCapacity = 32 << 20;
   const int64_t reservedMemoryCapacity = 8 << 20;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <memory>
+
+namespace facebook::velox::process {
+
+std::string HardwareCounters::toString() const {
+  return fmt::format(
+      "count: {}, instructions: {}, cycles: {}, IPC: {:.2f}, cache misses: {}, "
+      "branch misses: {}",
+      count,
+      instructions,
+      cycles,
+      ipc(),
+      cacheMisses,
+      branchMisses);
+}
+
+#ifdef __linux__
+namespace {
+// The events of the group in the order they are read.
+constexpr std::array<uint64_t, 4> kEvents{
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+// Layout of a read of a group with PERF_FORMAT_GROUP.
+struct GroupReadFormat {
+  uint64_t numEvents;
+  uint64_t values[4];
+};
+
+int32_t openEvent(uint64_t config, int32_t groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // Counts the calling thread on whichever CPU it runs.
+  return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+} // namespace
+
+PerfCounters::~PerfCounters() {
+  for (auto fd : fds_) {
+    close(fd);
+  }
+}
+
+// static
+PerfCounters* PerfCounters::forCurrentThread() {
+  static_assert(kEvents.size() == kNumEvents);
+  thread_local std::unique_ptr<PerfCounters> counters = []() {
+    std::array<int32_t, kNumEvents> fds;
+    for (auto i = 0; i < kNumEvents; ++i) {
+      fds[i] = openEvent(kEvents[i], i == 0 ? -1 : fds[0]);
+      if (fds[i] < 0) {
+        LOG_FIRST_N(WARNING, 1) << "Hardware counters are not available: "
+                                << folly::errnoStr(errno);
+        for (auto j = 0; j < i; ++j) {
+          close(fds[j]);
+        }
+        return std::unique_ptr<PerfCounters>();
+      }
+    }
+    return std::unique_ptr<PerfCounters>(new PerfCounters(fds));
+  }();
+  return counters.get();
+}
+
+HardwareCounters PerfCounters::read() const {
+  GroupReadFormat data{};
+  HardwareCounters result;
+  if (::read(fds_[0], &data, sizeof(data)) != sizeof(data)) {
+    return result;
+  }
+  result.instructions = data.values[0];
+  result.cycles = data.values[1];
+  result.cacheMisses = data.values[2];
+  result.branchMisses = data.values[3];
+  return result;
+}
+#else
+PerfCounters::~PerfCounters() = default;
+
+// static
+PerfCounters* PerfCounters::forCurrentThread() {
+  return nullptr;
+}
+
+HardwareCounters PerfCounters::read() const {
+  return HardwareCounters();
+}
+#endif
+
+} // namespace facebook::velox::process
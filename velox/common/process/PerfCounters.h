@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Hardware event counts for a repeating operation, e.g. the addInput calls of
+/// an operator. 'count' is the number of measured calls.
+struct HardwareCounters {
+  uint64_t count{0};
+  uint64_t instructions{0};
+  uint64_t cycles{0};
+  uint64_t cacheMisses{0};
+  uint64_t branchMisses{0};
+
+  void add(const HardwareCounters& other) {
+    count += other.count;
+    instructions += other.instructions;
+    cycles += other.cycles;
+    cacheMisses += other.cacheMisses;
+    branchMisses += other.branchMisses;
+  }
+
+  void clear() {
+    *this = HardwareCounters();
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  /// Returns instructions per cycle or 0 if no cycles were counted.
+  double ipc() const {
+    return cycles == 0 ? 0 : static_cast<double>(instructions) / cycles;
+  }
+
+  std::string toString() const;
+};
+
+/// Counters for instructions, cycles, last level cache misses and branch
+/// misses of the calling thread, read through a perf_event_open group so that
+/// all four are read with one system call. Only user space events are
+/// counted. Available on Linux if the perf_event_paranoid setting allows
+/// counting the events of one's own threads.
+class PerfCounters {
+ public:
+  ~PerfCounters();
+
+  /// Returns the counters of the calling thread, opening them on the first
+  /// call on the thread. Returns nullptr if hardware counters are not
+  /// available, e.g. in a VM or container without PMU access.
+  static PerfCounters* forCurrentThread();
+
+  /// Returns the totals since the counters were opened. 'count' is 0.
+  HardwareCounters read() const;
+
+ private:
+  static constexpr int32_t kNumEvents = 4;
+
+  explicit PerfCounters(const std::array<int32_t, kNumEvents>& fds)
+      : fds_(fds) {}
+
+  // One file descriptor per event. The first one is the group leader.
+  const std::array<int32_t, kNumEvents> fds_;
+};
+
+/// Reads the calling thread's counters at construction and destruction and
+/// passes the difference to 'func'. Must be destroyed on the thread that
+/// constructed it.
+template <typename F>
+class DeltaHardwareCounters {
+ public:
+  DeltaHardwareCounters(PerfCounters* counters, F&& func)
+      : counters_(counters),
+        start_(counters_->read()),
+        func_(std::move(func)) {}
+
+  ~DeltaHardwareCounters() {
+    const auto end = counters_->read();
+    const HardwareCounters delta{
+        1,
+        end.instructions - start_.instructions,
+        end.cycles - start_.cycles,
+        end.cacheMisses - start_.cacheMisses,
+        end.branchMisses - start_.branchMisses};
+    func_(delta);
+  }
+
+ private:
+  PerfCounters* const counters_;
+  const HardwareCounters start_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(PerfCountersTest, add) {
+  HardwareCounters counters;
+  EXPECT_TRUE(counters.empty());
+  EXPECT_EQ(counters.ipc(), 0);
+
+  counters.add({1, 300, 100, 5, 7});
+  counters.add({2, 100, 100, 1, 1});
+  EXPECT_FALSE(counters.empty());
+  EXPECT_EQ(counters.count, 3);
+  EXPECT_EQ(counters.instructions, 400);
+  EXPECT_EQ(counters.cycles, 200);
+  EXPECT_EQ(counters.cacheMisses, 6);
+  EXPECT_EQ(counters.branchMisses, 8);
+  EXPECT_EQ(counters.ipc(), 2);
+  EXPECT_EQ(
+      counters.toString(),
+      "count: 3, instructions: 400, cycles: 200, IPC: 2.00, cache misses: 6, "
+      "branch misses: 8");
+
+  counters.clear();
+  EXPECT_TRUE(counters.empty());
+  EXPECT_EQ(counters.instructions, 0);
+}
+
+TEST(PerfCountersTest, delta) {
+  auto* counters = PerfCounters::forCurrentThread();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  EXPECT_EQ(counters, PerfCounters::forCurrentThread());
+
+  HardwareCounters total;
+  for (auto i = 0; i < 2; ++i) {
+    DeltaHardwareCounters delta(
+        counters, [&](const HardwareCounters& counts) { total.add(counts); });
+    volatile int64_t sum = 0;
+    for (auto j = 0; j < 100'000; ++j) {
+      sum = sum + j;
+    }
+  }
+  EXPECT_EQ(total.count, 2);
+  EXPECT_GT(total.instructions, 200'000);
+  EXPECT_GT(total.cycles, 0);
+
+  // Each thread has its own counters.
+  PerfCounters* otherCounters;
+  std::thread([&]() {
+    otherCounters = PerfCounters::forCurrentThread();
+  }).join();
+  EXPECT_NE(otherCounters, counters);
+}
+
+} // namespace
+} // namespace facebook::velox::process
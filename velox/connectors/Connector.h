@@ -64,6 +64,12 @@ struct ConnectorSplit {
   virtual std::string getFileName() const {
     return "";
   }
+
+  /// Returns the number of bytes the split covers or 0 if not known. Used for
+  /// limiting the bytes of splits being preloaded.
+  virtual uint64_t byteSize() const {
+    return 0;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -175,6 +181,27 @@ class DataSink {
   virtual void abort() = 0;
 };
 
+/// An aggregate that a DataSource may compute from the file statistics of a
+/// split instead of reading its rows. See
+/// DataSource::aggregateFromStatistics().
+struct StatisticsAggregate {
+  enum class Kind {
+    /// count(*). The result is a BIGINT.
+    kCountAll,
+    /// count(column). The result is a BIGINT.
+    kCount,
+    /// min(column). The result has the type of the column.
+    kMin,
+    /// max(column). The result has the type of the column.
+    kMax,
+  };
+
+  Kind kind;
+
+  /// Name of the output column the aggregate is over. Empty for kCountAll.
+  std::string column;
+};
+
 class DataSource {
  public:
   static constexpr int64_t kUnknownRowSize = -1;
@@ -218,6 +245,21 @@ class DataSource {
     return false;
   }
 
+  /// Tells 'this' that no more than 'numRows' more output rows are needed, for
+  /// example because a Limit consumes the output. Applies to the splits added
+  /// after the call. A source may use this to read ahead less.
+  virtual void setRowLimit(uint64_t /*numRows*/) {}
+
+  /// Computes 'aggregates' over all the rows of the split added by addSplit()
+  /// from the file statistics. Returns a single row vector per aggregate with
+  /// the result if all of them are known exactly and the split is then fully
+  /// processed. Returns std::nullopt if not, e.g. because there are filters
+  /// the statistics do not account for, and the split is read with next().
+  virtual std::optional<std::vector<VectorPtr>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& /*aggregates*/) {
+    return std::nullopt;
+  }
+
   /// Initializes this from 'source'. 'source' is effectively moved into 'this'
   /// Adaptation like dynamic filters stay in effect but the parts dealing with
   /// open files, prefetched data etc. are moved. 'source' is freed after the
@@ -390,10 +432,12 @@ class Connector {
   /// Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   /// tracker and different threads will share the same
   /// instance. 'loadQuantum' is the largest single IO for the query
-  /// being tracked.
+  /// being tracked. 'fileGroupStats', if not nullptr, receives the accesses
+  /// of a newly created tracker.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      cache::FileGroupStats* fileGroupStats = nullptr);
 
   virtual folly::Executor* executor() const {
     return nullptr;
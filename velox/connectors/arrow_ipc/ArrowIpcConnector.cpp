@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/arrow_ipc/ArrowIpcConnector.h"
+
+#include <arrow/c/abi.h>
+#include <arrow/c/bridge.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+
+#include "velox/connectors/arrow_ipc/ArrowIpcSocket.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::connector::arrow_ipc {
+
+namespace {
+
+// All batches of an IPC stream have the same schema, so the encodings that
+// Arrow represents as types are not exported.
+const ArrowOptions kExportOptions{
+    .flattenDictionary = true,
+    .flattenConstant = true};
+
+void checkOk(const ::arrow::Status& status) {
+  VELOX_CHECK(status.ok(), "Arrow IPC error: {}", status.ToString());
+}
+
+template <typename T>
+T valueOrThrow(::arrow::Result<T> result) {
+  checkOk(result.status());
+  return std::move(result).ValueUnsafe();
+}
+
+} // namespace
+
+ArrowIpcDataSource::ArrowIpcDataSource(
+    const RowTypePtr& outputType,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    memory::MemoryPool* pool)
+    : outputType_(outputType), pool_(pool) {
+  columnNames_.reserve(outputType_->size());
+  for (const auto& outputName : outputType_->names()) {
+    auto it = columnHandles.find(outputName);
+    VELOX_CHECK(
+        it != columnHandles.end(),
+        "ColumnHandle is missing for output column '{}'",
+        outputName);
+    auto handle = std::dynamic_pointer_cast<ArrowIpcColumnHandle>(it->second);
+    VELOX_CHECK_NOT_NULL(
+        handle,
+        "ColumnHandle must be an instance of ArrowIpcColumnHandle for '{}'",
+        outputName);
+    columnNames_.push_back(handle->name());
+  }
+}
+
+ArrowIpcDataSource::~ArrowIpcDataSource() = default;
+
+void ArrowIpcDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
+  VELOX_CHECK_NULL(
+      currentSplit_,
+      "Previous split has not been processed yet. Call next() to process the split.");
+  currentSplit_ = std::dynamic_pointer_cast<ArrowIpcConnectorSplit>(split);
+  VELOX_CHECK(currentSplit_, "Wrong type of split for ArrowIpcDataSource.");
+}
+
+RowVectorPtr ArrowIpcDataSource::projectOutputColumns(
+    const RowVectorPtr& batch) {
+  const auto& batchType = batch->type()->asRow();
+  std::vector<VectorPtr> children;
+  children.reserve(columnNames_.size());
+  for (auto i = 0; i < columnNames_.size(); ++i) {
+    const auto idx = batchType.getChildIdxIfExists(columnNames_[i]);
+    VELOX_USER_CHECK(
+        idx.has_value(),
+        "Column '{}' not found in Arrow IPC stream from {}",
+        columnNames_[i],
+        currentSplit_->endpoint);
+    const auto& child = batch->childAt(idx.value());
+    VELOX_USER_CHECK(
+        child->type()->equivalent(*outputType_->childAt(i)),
+        "Column '{}' of Arrow IPC stream is {}, expected {}",
+        columnNames_[i],
+        child->type()->toString(),
+        outputType_->childAt(i)->toString());
+    children.push_back(child);
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(), batch->size(), std::move(children));
+}
+
+std::optional<RowVectorPtr> ArrowIpcDataSource::next(
+    uint64_t /*size*/,
+    velox::ContinueFuture& /*future*/) {
+  VELOX_CHECK_NOT_NULL(
+      currentSplit_, "No split to process. Call addSplit() first.");
+  if (reader_ == nullptr) {
+    stream_ = std::make_shared<SocketInputStream>(
+        connectSocket(currentSplit_->endpoint));
+    reader_ =
+        valueOrThrow(::arrow::ipc::RecordBatchStreamReader::Open(stream_));
+  }
+
+  for (;;) {
+    const auto startPosition = valueOrThrow(stream_->Tell());
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    checkOk(reader_->ReadNext(&batch));
+    completedBytes_ += valueOrThrow(stream_->Tell()) - startPosition;
+    if (batch == nullptr) {
+      reader_.reset();
+      checkOk(stream_->Close());
+      stream_.reset();
+      currentSplit_ = nullptr;
+      return nullptr;
+    }
+    if (batch->num_rows() == 0) {
+      continue;
+    }
+
+    // The imported vector owns the Arrow buffers.
+    ArrowArray arrowArray;
+    ArrowSchema arrowSchema;
+    checkOk(::arrow::ExportRecordBatch(*batch, &arrowArray, &arrowSchema));
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        importFromArrowAsOwner(arrowSchema, arrowArray, pool_));
+    VELOX_CHECK_NOT_NULL(vector);
+    completedRows_ += vector->size();
+    return projectOutputColumns(vector);
+  }
+}
+
+ArrowIpcDataSink::ArrowIpcDataSink(
+    RowTypePtr inputType,
+    std::shared_ptr<ArrowIpcInsertTableHandle> insertTableHandle,
+    memory::MemoryPool* pool)
+    : inputType_(std::move(inputType)),
+      insertTableHandle_(std::move(insertTableHandle)),
+      pool_(pool) {
+  VELOX_CHECK_NOT_NULL(insertTableHandle_);
+}
+
+ArrowIpcDataSink::~ArrowIpcDataSink() = default;
+
+void ArrowIpcDataSink::appendData(RowVectorPtr input) {
+  input->loadedVector();
+  ArrowArray arrowArray;
+  ArrowSchema arrowSchema;
+  exportToArrow(input, arrowArray, pool_, kExportOptions);
+  exportToArrow(input, arrowSchema, kExportOptions);
+  auto batch =
+      valueOrThrow(::arrow::ImportRecordBatch(&arrowArray, &arrowSchema));
+
+  if (writer_ == nullptr) {
+    stream_ = std::make_shared<SocketOutputStream>(
+        connectSocket(insertTableHandle_->endpoint()));
+    writer_ = valueOrThrow(
+        ::arrow::ipc::MakeStreamWriter(stream_, batch->schema()));
+  }
+  checkOk(writer_->WriteRecordBatch(*batch));
+  numWrittenBytes_ = valueOrThrow(stream_->Tell());
+}
+
+DataSink::Stats ArrowIpcDataSink::stats() const {
+  Stats stats;
+  stats.numWrittenBytes = numWrittenBytes_;
+  return stats;
+}
+
+std::vector<std::string> ArrowIpcDataSink::close() {
+  if (writer_ != nullptr) {
+    checkOk(writer_->Close());
+    numWrittenBytes_ = valueOrThrow(stream_->Tell());
+    checkOk(stream_->Close());
+    writer_.reset();
+    stream_.reset();
+  }
+  return {};
+}
+
+void ArrowIpcDataSink::abort() {
+  writer_.reset();
+  if (stream_ != nullptr) {
+    (void)stream_->Abort();
+    stream_.reset();
+  }
+}
+
+std::unique_ptr<DataSource> ArrowIpcConnector::createDataSource(
+    const RowTypePtr& outputType,
+    const std::shared_ptr<ConnectorTableHandle>& /*tableHandle*/,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    ConnectorQueryCtx* connectorQueryCtx) {
+  return std::make_unique<ArrowIpcDataSource>(
+      outputType, columnHandles, connectorQueryCtx->memoryPool());
+}
+
+std::unique_ptr<DataSink> ArrowIpcConnector::createDataSink(
+    RowTypePtr inputType,
+    std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
+    ConnectorQueryCtx* connectorQueryCtx,
+    CommitStrategy /*commitStrategy*/) {
+  auto insertTableHandle = std::dynamic_pointer_cast<ArrowIpcInsertTableHandle>(
+      connectorInsertTableHandle);
+  VELOX_CHECK_NOT_NULL(
+      insertTableHandle,
+      "ArrowIpcConnector expects an ArrowIpcInsertTableHandle");
+  return std::make_unique<ArrowIpcDataSink>(
+      std::move(inputType),
+      std::move(insertTableHandle),
+      connectorQueryCtx->memoryPool());
+}
+
+VELOX_REGISTER_CONNECTOR_FACTORY(std::make_shared<ArrowIpcConnectorFactory>())
+
+} // namespace facebook::velox::connector::arrow_ipc
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/arrow_ipc/ArrowIpcConnectorSplit.h"
+
+namespace arrow {
+class RecordBatch;
+namespace io {
+class InputStream;
+class OutputStream;
+} // namespace io
+namespace ipc {
+class RecordBatchReader;
+class RecordBatchWriter;
+} // namespace ipc
+} // namespace arrow
+
+namespace facebook::velox::connector::arrow_ipc {
+
+/// Selects the column with the same name in the record batches.
+class ArrowIpcColumnHandle : public ColumnHandle {
+ public:
+  explicit ArrowIpcColumnHandle(const std::string& name) : name_(name) {}
+
+  const std::string& name() const {
+    return name_;
+  }
+
+ private:
+  const std::string name_;
+};
+
+/// The schema of the streams is given by the record batches, so the table
+/// handle carries no information beyond the connector.
+class ArrowIpcTableHandle : public ConnectorTableHandle {
+ public:
+  explicit ArrowIpcTableHandle(std::string connectorId)
+      : ConnectorTableHandle(std::move(connectorId)) {}
+
+  std::string toString() const override {
+    return "ArrowIpc";
+  }
+};
+
+/// Names the server that receives the written stream.
+class ArrowIpcInsertTableHandle : public ConnectorInsertTableHandle {
+ public:
+  explicit ArrowIpcInsertTableHandle(std::string endpoint)
+      : endpoint_(std::move(endpoint)) {}
+
+  /// host:port of the server.
+  const std::string& endpoint() const {
+    return endpoint_;
+  }
+
+ private:
+  const std::string endpoint_;
+};
+
+class ArrowIpcDataSource : public DataSource {
+ public:
+  ArrowIpcDataSource(
+      const RowTypePtr& outputType,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      memory::MemoryPool* pool);
+
+  ~ArrowIpcDataSource() override;
+
+  void addSplit(std::shared_ptr<ConnectorSplit> split) override;
+
+  void addDynamicFilter(
+      column_index_t /*outputChannel*/,
+      const std::shared_ptr<common::Filter>& /*filter*/) override {
+    VELOX_NYI("Dynamic filters not supported by ArrowIpcConnector.");
+  }
+
+  /// Returns the next record batch of the stream. 'size' is not used, the
+  /// batches are returned as the producer wrote them. Waits for the batch on
+  /// the socket.
+  std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
+      override;
+
+  uint64_t getCompletedRows() override {
+    return completedRows_;
+  }
+
+  uint64_t getCompletedBytes() override {
+    return completedBytes_;
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
+    return {};
+  }
+
+ private:
+  // Selects the output columns of 'batch' by name.
+  RowVectorPtr projectOutputColumns(const RowVectorPtr& batch);
+
+  const RowTypePtr outputType_;
+  memory::MemoryPool* const pool_;
+  // Names of the stream columns that make up 'outputType_'.
+  std::vector<std::string> columnNames_;
+
+  std::shared_ptr<ArrowIpcConnectorSplit> currentSplit_;
+  std::shared_ptr<::arrow::io::InputStream> stream_;
+  std::shared_ptr<::arrow::ipc::RecordBatchReader> reader_;
+
+  uint64_t completedRows_{0};
+  uint64_t completedBytes_{0};
+};
+
+/// Writes the input as one Arrow IPC stream. appendData() blocks until the
+/// batch is written to the socket. Dictionary and constant vectors are
+/// flattened since all batches of a stream have the same schema.
+class ArrowIpcDataSink : public DataSink {
+ public:
+  ArrowIpcDataSink(
+      RowTypePtr inputType,
+      std::shared_ptr<ArrowIpcInsertTableHandle> insertTableHandle,
+      memory::MemoryPool* pool);
+
+  ~ArrowIpcDataSink() override;
+
+  void appendData(RowVectorPtr input) override;
+
+  Stats stats() const override;
+
+  std::vector<std::string> close() override;
+
+  void abort() override;
+
+ private:
+  const RowTypePtr inputType_;
+  const std::shared_ptr<ArrowIpcInsertTableHandle> insertTableHandle_;
+  memory::MemoryPool* const pool_;
+
+  std::shared_ptr<::arrow::io::OutputStream> stream_;
+  std::shared_ptr<::arrow::ipc::RecordBatchWriter> writer_;
+  uint64_t numWrittenBytes_{0};
+};
+
+/// Reads and writes Arrow IPC streams over TCP connections. A scan reads
+/// each split's stream from its endpoint and imports the record batches
+/// through the Arrow bridge, which wraps the Arrow buffers without copying.
+/// A write sends the input as one stream to the endpoint of the insert
+/// handle. Producers and consumers that speak the Arrow IPC streaming format,
+/// e.g. a feature store ingesting query results, can so exchange data with
+/// Velox without going through files.
+class ArrowIpcConnector final : public Connector {
+ public:
+  ArrowIpcConnector(
+      const std::string& id,
+      std::shared_ptr<const Config> /*config*/,
+      folly::Executor* /*executor*/)
+      : Connector(id) {}
+
+  std::unique_ptr<DataSource> createDataSource(
+      const RowTypePtr& outputType,
+      const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      ConnectorQueryCtx* connectorQueryCtx) override final;
+
+  std::unique_ptr<DataSink> createDataSink(
+      RowTypePtr inputType,
+      std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
+      ConnectorQueryCtx* connectorQueryCtx,
+      CommitStrategy commitStrategy) override final;
+};
+
+class ArrowIpcConnectorFactory : public ConnectorFactory {
+ public:
+  static constexpr const char* kArrowIpcConnectorName{"arrow-ipc"};
+
+  ArrowIpcConnectorFactory() : ConnectorFactory(kArrowIpcConnectorName) {}
+
+  explicit ArrowIpcConnectorFactory(const char* connectorName)
+      : ConnectorFactory(connectorName) {}
+
+  std::shared_ptr<Connector> newConnector(
+      const std::string& id,
+      std::shared_ptr<const Config> config,
+      folly::Executor* executor = nullptr) override {
+    return std::make_shared<ArrowIpcConnector>(id, config, executor);
+  }
+};
+
+} // namespace facebook::velox::connector::arrow_ipc
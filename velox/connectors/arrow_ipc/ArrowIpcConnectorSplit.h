@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <fmt/format.h>
+#include "velox/connectors/Connector.h"
+
+namespace facebook::velox::connector::arrow_ipc {
+
+/// One Arrow IPC stream to read. A producer that serves its data from
+/// several endpoints is read in parallel with one split per endpoint.
+struct ArrowIpcConnectorSplit : public connector::ConnectorSplit {
+  ArrowIpcConnectorSplit(const std::string& connectorId, std::string endpoint)
+      : ConnectorSplit(connectorId), endpoint(std::move(endpoint)) {}
+
+  std::string toString() const override {
+    return fmt::format("ArrowIpc: {}", endpoint);
+  }
+
+  // host:port of the server that writes the stream.
+  const std::string endpoint;
+};
+
+} // namespace facebook::velox::connector::arrow_ipc
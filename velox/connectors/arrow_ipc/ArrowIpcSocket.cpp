@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/arrow_ipc/ArrowIpcSocket.h"
+
+#include <arrow/buffer.h>
+#include <folly/SocketAddress.h>
+#include <folly/String.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::arrow_ipc {
+
+int32_t connectSocket(const std::string& endpoint) {
+  folly::SocketAddress address;
+  address.setFromHostPort(endpoint);
+  const auto fd = ::socket(address.getFamily(), SOCK_STREAM, 0);
+  VELOX_CHECK_GE(fd, 0, "Cannot create socket: {}", folly::errnoStr(errno));
+  sockaddr_storage storage;
+  address.getAddress(&storage);
+  if (::connect(
+          fd,
+          reinterpret_cast<const sockaddr*>(&storage),
+          address.getActualSize()) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    VELOX_FAIL("Cannot connect to {}: {}", endpoint, folly::errnoStr(error));
+  }
+  return fd;
+}
+
+SocketInputStream::~SocketInputStream() {
+  (void)Close();
+}
+
+::arrow::Status SocketInputStream::Close() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  return ::arrow::Status::OK();
+}
+
+::arrow::Result<int64_t> SocketInputStream::Read(int64_t nbytes, void* out) {
+  if (fd_ < 0) {
+    return ::arrow::Status::Invalid("Read from closed socket");
+  }
+  int64_t numRead = 0;
+  while (numRead < nbytes) {
+    const auto rc =
+        ::recv(fd_, static_cast<char*>(out) + numRead, nbytes - numRead, 0);
+    if (rc == 0) {
+      break;
+    }
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return ::arrow::Status::IOError(
+          "Socket read failed: ", folly::errnoStr(errno));
+    }
+    numRead += rc;
+  }
+  position_ += numRead;
+  return numRead;
+}
+
+::arrow::Result<std::shared_ptr<::arrow::Buffer>> SocketInputStream::Read(
+    int64_t nbytes) {
+  ARROW_ASSIGN_OR_RAISE(auto buffer, ::arrow::AllocateResizableBuffer(nbytes));
+  ARROW_ASSIGN_OR_RAISE(auto numRead, Read(nbytes, buffer->mutable_data()));
+  if (numRead < nbytes) {
+    ARROW_RETURN_NOT_OK(buffer->Resize(numRead));
+  }
+  return std::shared_ptr<::arrow::Buffer>(std::move(buffer));
+}
+
+SocketOutputStream::~SocketOutputStream() {
+  (void)Abort();
+}
+
+::arrow::Status SocketOutputStream::Close() {
+  if (fd_ >= 0 && ::shutdown(fd_, SHUT_WR) != 0) {
+    const auto error = errno;
+    (void)Abort();
+    return ::arrow::Status::IOError(
+        "Socket shutdown failed: ", folly::errnoStr(error));
+  }
+  return Abort();
+}
+
+::arrow::Status SocketOutputStream::Abort() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  return ::arrow::Status::OK();
+}
+
+::arrow::Status SocketOutputStream::Write(const void* data, int64_t nbytes) {
+  if (fd_ < 0) {
+    return ::arrow::Status::Invalid("Write to closed socket");
+  }
+  int64_t numWritten = 0;
+  while (numWritten < nbytes) {
+    const auto rc = ::send(
+        fd_,
+        static_cast<const char*>(data) + numWritten,
+        nbytes - numWritten,
+        MSG_NOSIGNAL);
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return ::arrow::Status::IOError(
+          "Socket write failed: ", folly::errnoStr(errno));
+    }
+    numWritten += rc;
+  }
+  position_ += numWritten;
+  return ::arrow::Status::OK();
+}
+
+} // namespace facebook::velox::connector::arrow_ipc
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/io/interfaces.h>
+
+#include <string>
+
+namespace facebook::velox::connector::arrow_ipc {
+
+/// Opens a TCP connection to 'endpoint' given as host:port. Returns the
+/// socket descriptor. Throws on failure.
+int32_t connectSocket(const std::string& endpoint);
+
+/// Arrow input stream over a connected stream socket. Read() waits until the
+/// requested bytes arrive or the peer closes its end. Owns the socket.
+class SocketInputStream : public ::arrow::io::InputStream {
+ public:
+  explicit SocketInputStream(int32_t fd) : fd_(fd) {}
+
+  ~SocketInputStream() override;
+
+  ::arrow::Status Close() override;
+
+  bool closed() const override {
+    return fd_ < 0;
+  }
+
+  ::arrow::Result<int64_t> Tell() const override {
+    return position_;
+  }
+
+  ::arrow::Result<int64_t> Read(int64_t nbytes, void* out) override;
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> Read(
+      int64_t nbytes) override;
+
+ private:
+  int32_t fd_;
+  int64_t position_{0};
+};
+
+/// Arrow output stream over a connected stream socket. Close() shuts down the
+/// sending side so that the peer sees the end of the stream. Owns the
+/// socket.
+class SocketOutputStream : public ::arrow::io::OutputStream {
+ public:
+  explicit SocketOutputStream(int32_t fd) : fd_(fd) {}
+
+  ~SocketOutputStream() override;
+
+  ::arrow::Status Close() override;
+
+  ::arrow::Status Abort() override;
+
+  bool closed() const override {
+    return fd_ < 0;
+  }
+
+  ::arrow::Result<int64_t> Tell() const override {
+    return position_;
+  }
+
+  ::arrow::Status Write(const void* data, int64_t nbytes) override;
+
+ private:
+  int32_t fd_;
+  int64_t position_{0};
+};
+
+} // namespace facebook::velox::connector::arrow_ipc
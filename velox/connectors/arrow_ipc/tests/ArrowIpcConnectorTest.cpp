@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/arrow_ipc/ArrowIpcConnector.h"
+
+#include <arpa/inet.h>
+#include <arrow/c/abi.h>
+#include <arrow/c/bridge.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "velox/connectors/arrow_ipc/ArrowIpcSocket.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::connector::arrow_ipc {
+namespace {
+
+using exec::test::AssertQueryBuilder;
+using exec::test::PlanBuilder;
+
+// Accepts one connection on a loopback port and runs 'handler' with the
+// connected socket on a separate thread.
+class TestServer {
+ public:
+  explicit TestServer(std::function<void(int32_t)> handler) {
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    VELOX_CHECK_GE(listenFd_, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    VELOX_CHECK_EQ(
+        ::bind(
+            listenFd_,
+            reinterpret_cast<sockaddr*>(&address),
+            sizeof(address)),
+        0);
+    VELOX_CHECK_EQ(::listen(listenFd_, 1), 0);
+    socklen_t length = sizeof(address);
+    VELOX_CHECK_EQ(
+        ::getsockname(
+            listenFd_, reinterpret_cast<sockaddr*>(&address), &length),
+        0);
+    endpoint_ = fmt::format("127.0.0.1:{}", ntohs(address.sin_port));
+    thread_ = std::thread([this, handler = std::move(handler)]() {
+      handler(::accept(listenFd_, nullptr, nullptr));
+    });
+  }
+
+  ~TestServer() {
+    join();
+    ::close(listenFd_);
+  }
+
+  const std::string& endpoint() const {
+    return endpoint_;
+  }
+
+  void join() {
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+ private:
+  int32_t listenFd_;
+  std::string endpoint_;
+  std::thread thread_;
+};
+
+class ArrowIpcConnectorTest : public exec::test::OperatorTestBase {
+ protected:
+  const std::string kConnectorId = "test-arrow-ipc";
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    connector::registerConnector(
+        connector::getConnectorFactory(
+            ArrowIpcConnectorFactory::kArrowIpcConnectorName)
+            ->newConnector(kConnectorId, std::make_shared<core::MemConfig>()));
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kConnectorId);
+    OperatorTestBase::TearDown();
+  }
+
+  std::shared_ptr<::arrow::RecordBatch> toArrow(const RowVectorPtr& vector) {
+    ArrowArray arrowArray;
+    ArrowSchema arrowSchema;
+    exportToArrow(vector, arrowArray, pool());
+    exportToArrow(vector, arrowSchema);
+    return ::arrow::ImportRecordBatch(&arrowArray, &arrowSchema).ValueOrDie();
+  }
+
+  // Returns a server that writes 'vectors' as one Arrow IPC stream.
+  std::unique_ptr<TestServer> makeServer(
+      const std::vector<RowVectorPtr>& vectors) {
+    std::vector<std::shared_ptr<::arrow::RecordBatch>> batches;
+    for (const auto& vector : vectors) {
+      batches.push_back(toArrow(vector));
+    }
+    return std::make_unique<TestServer>([batches](int32_t fd) {
+      auto stream = std::make_shared<SocketOutputStream>(fd);
+      auto writer =
+          ::arrow::ipc::MakeStreamWriter(stream, batches[0]->schema())
+              .ValueOrDie();
+      for (const auto& batch : batches) {
+        EXPECT_TRUE(writer->WriteRecordBatch(*batch).ok());
+      }
+      EXPECT_TRUE(writer->Close().ok());
+      EXPECT_TRUE(stream->Close().ok());
+    });
+  }
+
+  exec::Split makeSplit(const std::string& endpoint) const {
+    return exec::Split(
+        std::make_shared<ArrowIpcConnectorSplit>(kConnectorId, endpoint));
+  }
+};
+
+TEST_F(ArrowIpcConnectorTest, scan) {
+  auto makeData = [&](int32_t start) {
+    return makeRowVector(
+        {"c0", "c1", "c2"},
+        {
+            makeFlatVector<int64_t>(100, [&](auto row) { return start + row; }),
+            makeFlatVector<std::string>(
+                100,
+                [&](auto row) {
+                  return fmt::format("string value number {}", start + row);
+                }),
+            makeFlatVector<double>(100, [](auto row) { return row * 0.5; }),
+        });
+  };
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 4; ++i) {
+    data.push_back(makeData(i * 100));
+  }
+  // One endpoint per split, read in parallel.
+  auto server1 = makeServer({data[0], data[1]});
+  auto server2 = makeServer({data[2], data[3]});
+
+  auto outputType = ROW({"c1", "c0"}, {VARCHAR(), BIGINT()});
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .connectorId(kConnectorId)
+                  .outputType(outputType)
+                  .tableHandle(
+                      std::make_shared<ArrowIpcTableHandle>(kConnectorId))
+                  .assignments({
+                      {"c0", std::make_shared<ArrowIpcColumnHandle>("c0")},
+                      {"c1", std::make_shared<ArrowIpcColumnHandle>("c1")},
+                  })
+                  .endTableScan()
+                  .planNode();
+
+  auto expected = makeRowVector(
+      {"c1", "c0"},
+      {
+          makeFlatVector<std::string>(
+              400,
+              [](auto row) {
+                return fmt::format("string value number {}", row);
+              }),
+          makeFlatVector<int64_t>(400, [](auto row) { return row; }),
+      });
+  AssertQueryBuilder(plan)
+      .splits({makeSplit(server1->endpoint()), makeSplit(server2->endpoint())})
+      .maxDrivers(2)
+      .assertResults(expected);
+}
+
+TEST_F(ArrowIpcConnectorTest, write) {
+  std::vector<VectorPtr> received;
+  TestServer server([&](int32_t fd) {
+    auto stream = std::make_shared<SocketInputStream>(fd);
+    auto reader =
+        ::arrow::ipc::RecordBatchStreamReader::Open(stream).ValueOrDie();
+    for (;;) {
+      std::shared_ptr<::arrow::RecordBatch> batch;
+      ASSERT_TRUE(reader->ReadNext(&batch).ok());
+      if (batch == nullptr) {
+        break;
+      }
+      ArrowArray arrowArray;
+      ArrowSchema arrowSchema;
+      ASSERT_TRUE(
+          ::arrow::ExportRecordBatch(*batch, &arrowArray, &arrowSchema).ok());
+      received.push_back(
+          importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+    }
+  });
+
+  auto flat = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeNullableFlatVector<std::string>(
+              {"a", std::nullopt, "a string that is not inlined"}),
+      });
+  // Encoded vectors are written with the same schema as flat ones.
+  auto encoded = makeRowVector(
+      {"c0", "c1"},
+      {
+          wrapInDictionary(
+              makeIndices({2, 0}), makeFlatVector<int32_t>({4, 5, 6})),
+          makeConstant<std::string>("constant value", 2),
+      });
+
+  auto sink = std::make_unique<ArrowIpcDataSink>(
+      asRowType(flat->type()),
+      std::make_shared<ArrowIpcInsertTableHandle>(server.endpoint()),
+      pool());
+  sink->appendData(flat);
+  sink->appendData(encoded);
+  EXPECT_TRUE(sink->close().empty());
+  EXPECT_GT(sink->stats().numWrittenBytes, 0);
+  server.join();
+
+  ASSERT_EQ(received.size(), 2);
+  velox::test::assertEqualVectors(flat, received[0]);
+  velox::test::assertEqualVectors(encoded, received[1]);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::arrow_ipc
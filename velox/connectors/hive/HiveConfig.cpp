@@ -65,6 +65,12 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* session) const {
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 100));
 }
 
+uint32_t HiveConfig::maxOpenWriterFiles(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenWriterFilesSession,
+      config_->get<uint32_t>(kMaxOpenWriterFiles, 0));
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -120,6 +126,40 @@ std::optional<uint32_t> HiveConfig::s3MaxConnections() const {
       config_->get<uint32_t>(kS3MaxConnections));
 }
 
+uint64_t HiveConfig::s3ReadChunkSize() const {
+  return toCapacity(
+      config_->get<std::string>(kS3ReadChunkSize, "8MB"),
+      core::CapacityUnit::BYTE);
+}
+
+uint32_t HiveConfig::s3ReadThreads() const {
+  return config_->get<uint32_t>(kS3ReadThreads, 0);
+}
+
+int32_t HiveConfig::s3HedgedReadPercentile() const {
+  return config_->get<int32_t>(kS3HedgedReadPercentile, 0);
+}
+
+uint32_t HiveConfig::s3UploadThreads() const {
+  return config_->get<uint32_t>(kS3UploadThreads, 0);
+}
+
+uint32_t HiveConfig::s3MaxInflightUploadParts() const {
+  return config_->get<uint32_t>(kS3MaxInflightUploadParts, 4);
+}
+
+bool HiveConfig::hdfsShortCircuitRead() const {
+  return config_->get<bool>(kHdfsShortCircuitRead, false);
+}
+
+std::string HiveConfig::hdfsDomainSocketPath() const {
+  return config_->get<std::string>(kHdfsDomainSocketPath, std::string(""));
+}
+
+uint32_t HiveConfig::hdfsReadThreads() const {
+  return config_->get<uint32_t>(kHdfsReadThreads, 0);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -147,6 +187,24 @@ bool HiveConfig::isPartitionPathAsLowerCase(const Config* session) const {
   return session->get<bool>(kPartitionPathAsLowerCaseSession, true);
 }
 
+bool HiveConfig::isParquetBloomFilterEnabled(const Config* session) const {
+  return session->get<bool>(
+      kParquetBloomFilterEnabledSession,
+      config_->get<bool>(kParquetBloomFilterEnabled, true));
+}
+
+bool HiveConfig::isParquetLazyColumnsEnabled(const Config* session) const {
+  return session->get<bool>(
+      kParquetLazyColumnsEnabledSession,
+      config_->get<bool>(kParquetLazyColumnsEnabled, false));
+}
+
+bool HiveConfig::isParquetWriterPageIndexEnabled(const Config* session) const {
+  return session->get<bool>(
+      kParquetWriterPageIndexEnabledSession,
+      config_->get<bool>(kParquetWriterPageIndexEnabled, false));
+}
+
 bool HiveConfig::ignoreMissingFiles(const Config* session) const {
   return session->get<bool>(kIgnoreMissingFilesSession, false);
 }
@@ -175,6 +233,36 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileMetadataCacheSize() const {
+  return toCapacity(
+      config_->get<std::string>(kFileMetadataCacheSize, "0B"),
+      core::CapacityUnit::BYTE);
+}
+
+int32_t HiveConfig::splitDecodeThreads() const {
+  return config_->get<int32_t>(kSplitDecodeThreads, 0);
+}
+
+int32_t HiveConfig::splitDecodeParallelism(const Config* session) const {
+  return session->get<int32_t>(
+      kSplitDecodeParallelismSession,
+      config_->get<int32_t>(kSplitDecodeParallelism, 4));
+}
+
+uint64_t HiveConfig::splitDecodeRangeSize(const Config* session) const {
+  return toCapacity(
+      session->get<std::string>(
+          kSplitDecodeRangeSizeSession,
+          config_->get<std::string>(kSplitDecodeRangeSize, "64MB")),
+      core::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::splitDecodeMaxBufferedBytes() const {
+  return toCapacity(
+      config_->get<std::string>(kSplitDecodeMaxBufferedBytes, "128MB"),
+      core::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::orcWriterMaxStripeSize(const Config* session) const {
   return toCapacity(
       session->get<std::string>(
@@ -204,6 +292,16 @@ uint64_t HiveConfig::orcWriterMinCompressionSize(const Config* session) const {
       config_->get<uint64_t>(kOrcWriterMinCompressionSize, 1024));
 }
 
+int32_t HiveConfig::writerFlushThreads() const {
+  return config_->get<int32_t>(kWriterFlushThreads, 0);
+}
+
+int32_t HiveConfig::orcWriterFlushParallelism(const Config* session) const {
+  return session->get<int32_t>(
+      kOrcWriterFlushParallelismSession,
+      config_->get<int32_t>(kOrcWriterFlushParallelism, 4));
+}
+
 std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
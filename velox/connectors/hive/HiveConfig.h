@@ -51,6 +51,14 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of files a single table writer instance keeps open for a
+  /// non-bucketed partitioned table. Opening one more closes the file of the
+  /// partition written least recently. Later rows for that partition go to a
+  /// new file. 0 means no limit other than 'max-partitions-per-writers'.
+  static constexpr const char* kMaxOpenWriterFiles = "max-open-writer-files";
+  static constexpr const char* kMaxOpenWriterFilesSession =
+      "max_open_writer_files";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -97,6 +105,41 @@ class HiveConfig {
   /// Maximum concurrent TCP connections for a single http client.
   static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
 
+  /// Size of the chunks a large S3 read is split into. The chunks are fetched
+  /// with concurrent ranged GETs.
+  static constexpr const char* kS3ReadChunkSize = "hive.s3.read-chunk-size";
+
+  /// Number of threads of the S3 file system that fetch the chunks of large
+  /// reads. 0 reads each range with a single GET.
+  static constexpr const char* kS3ReadThreads = "hive.s3.read-threads";
+
+  /// Latency percentile of recent reads after which an S3 read is hedged
+  /// with a second GET. 0 disables hedging.
+  static constexpr const char* kS3HedgedReadPercentile =
+      "hive.s3.hedged-read-percentile";
+
+  /// Number of threads of the S3 file system that upload the parts of files
+  /// being written. 0 uploads each part on the writing thread.
+  static constexpr const char* kS3UploadThreads = "hive.s3.upload-threads";
+
+  /// Maximum number of parts of a file that are being uploaded at the same
+  /// time when hive.s3.upload-threads is not 0.
+  static constexpr const char* kS3MaxInflightUploadParts =
+      "hive.s3.max-inflight-upload-parts";
+
+  /// Read HDFS blocks that are on the local datanode directly from the block
+  /// files, which the datanode passes over hive.hdfs.domain-socket-path.
+  static constexpr const char* kHdfsShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// Path of the UNIX domain socket of the local datanode.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// Number of threads of the HDFS file system that run asynchronous reads.
+  /// 0 reads on the calling thread.
+  static constexpr const char* kHdfsReadThreads = "hive.hdfs.read-threads";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -145,6 +188,34 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Budget in encoded footer bytes of the process-wide cache of parsed file
+  /// footers. 0 disables the cache.
+  static constexpr const char* kFileMetadataCacheSize =
+      "file-metadata-cache-size";
+
+  /// Number of threads of the connector-wide pool that decodes the ranges of
+  /// large DWRF and Parquet splits in parallel. 0 decodes each split on the
+  /// driver thread only.
+  static constexpr const char* kSplitDecodeThreads = "split-decode-threads";
+
+  /// Maximum number of ranges of one split decoded at the same time.
+  static constexpr const char* kSplitDecodeParallelism =
+      "split-decode-parallelism";
+  static constexpr const char* kSplitDecodeParallelismSession =
+      "split_decode_parallelism";
+
+  /// Size in bytes of the ranges a split is cut into for parallel decoding.
+  /// Splits not larger than this are decoded on the driver thread.
+  static constexpr const char* kSplitDecodeRangeSize =
+      "split-decode-range-size";
+  static constexpr const char* kSplitDecodeRangeSizeSession =
+      "split_decode_range_size";
+
+  /// Bytes of decoded batches of a split after which the ranges ahead of the
+  /// one being returned stop decoding.
+  static constexpr const char* kSplitDecodeMaxBufferedBytes =
+      "split-decode-max-buffered-bytes";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -178,6 +249,17 @@ class HiveConfig {
   static constexpr const char* kOrcWriterMinCompressionSizeSession =
       "orc_writer_min_compression_size";
 
+  /// Number of threads of the connector-wide pool that encodes and compresses
+  /// the columns of DWRF stripes in parallel when the stripes are flushed. 0
+  /// flushes on the writer thread only.
+  static constexpr const char* kWriterFlushThreads = "writer-flush-threads";
+
+  /// Maximum number of threads that flush the columns of one stripe.
+  static constexpr const char* kOrcWriterFlushParallelism =
+      "hive.orc.writer.flush-parallelism";
+  static constexpr const char* kOrcWriterFlushParallelismSession =
+      "orc_writer_flush_parallelism";
+
   /// Config used to create write files. This config is provided to underlying
   /// file system through hive connector and data sink. The config is free form.
   /// The form should be defined by the underlying file system.
@@ -205,11 +287,34 @@ class HiveConfig {
   static constexpr const char* kParquetWriteTimestampUnitSession =
       "hive.parquet.writer.timestamp_unit";
 
+  /// Whether the Parquet reader uses column chunk bloom filters to skip row
+  /// groups that cannot match an equality or IN filter.
+  static constexpr const char* kParquetBloomFilterEnabled =
+      "hive.parquet.reader.bloom-filter-enabled";
+  static constexpr const char* kParquetBloomFilterEnabledSession =
+      "parquet_bloom_filter_enabled";
+
+  /// Whether the Parquet reader returns the projected columns without filters
+  /// as LazyVectors that decode only the rows downstream operators access.
+  static constexpr const char* kParquetLazyColumnsEnabled =
+      "hive.parquet.reader.lazy-columns-enabled";
+  static constexpr const char* kParquetLazyColumnsEnabledSession =
+      "parquet_lazy_columns_enabled";
+
+  /// Whether the Parquet writer writes the column and offset indexes of the
+  /// column chunks.
+  static constexpr const char* kParquetWriterPageIndexEnabled =
+      "hive.parquet.writer.page-index-enabled";
+  static constexpr const char* kParquetWriterPageIndexEnabledSession =
+      "parquet_writer_page_index_enabled";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* session) const;
 
   uint32_t maxPartitionsPerWriters(const Config* session) const;
 
+  uint32_t maxOpenWriterFiles(const Config* session) const;
+
   bool immutablePartitions() const;
 
   bool s3UseVirtualAddressing() const;
@@ -236,6 +341,22 @@ class HiveConfig {
 
   std::optional<uint32_t> s3MaxConnections() const;
 
+  uint64_t s3ReadChunkSize() const;
+
+  uint32_t s3ReadThreads() const;
+
+  int32_t s3HedgedReadPercentile() const;
+
+  uint32_t s3UploadThreads() const;
+
+  uint32_t s3MaxInflightUploadParts() const;
+
+  bool hdfsShortCircuitRead() const;
+
+  std::string hdfsDomainSocketPath() const;
+
+  uint32_t hdfsReadThreads() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -248,6 +369,12 @@ class HiveConfig {
 
   bool isPartitionPathAsLowerCase(const Config* session) const;
 
+  bool isParquetBloomFilterEnabled(const Config* session) const;
+
+  bool isParquetLazyColumnsEnabled(const Config* session) const;
+
+  bool isParquetWriterPageIndexEnabled(const Config* session) const;
+
   bool ignoreMissingFiles(const Config* session) const;
 
   int64_t maxCoalescedBytes() const;
@@ -262,6 +389,16 @@ class HiveConfig {
 
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileMetadataCacheSize() const;
+
+  int32_t splitDecodeThreads() const;
+
+  int32_t splitDecodeParallelism(const Config* session) const;
+
+  uint64_t splitDecodeRangeSize(const Config* session) const;
+
+  uint64_t splitDecodeMaxBufferedBytes() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   uint64_t orcWriterMaxStripeSize(const Config* session) const;
@@ -272,6 +409,10 @@ class HiveConfig {
 
   uint64_t orcWriterMinCompressionSize(const Config* session) const;
 
+  int32_t writerFlushThreads() const;
+
+  int32_t orcWriterFlushParallelism(const Config* session) const;
+
   std::string writeFileCreateConfig() const;
 
   uint32_t sortWriterMaxOutputRows(const Config* session) const;
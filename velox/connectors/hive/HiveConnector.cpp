@@ -16,11 +16,14 @@
 
 #include "velox/connectors/hive/HiveConnector.h"
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
 #include "velox/common/base/Fs.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 // Meta's buck build system needs this check.
 #ifdef VELOX_ENABLE_GCS
 #include "velox/connectors/hive/storage_adapters/gcs/RegisterGCSFileSystem.h" // @manual
@@ -73,6 +76,20 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (hiveConfig_->fileMetadataCacheSize() > 0) {
+    dwio::common::FileMetadataCache::create(
+        hiveConfig_->fileMetadataCacheSize());
+  }
+  if (hiveConfig_->splitDecodeThreads() > 0) {
+    splitDecodeExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        hiveConfig_->splitDecodeThreads(),
+        std::make_shared<folly::NamedThreadFactory>("HiveSplitDecode"));
+  }
+  if (hiveConfig_->writerFlushThreads() > 0) {
+    writerFlushExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        hiveConfig_->writerFlushThreads(),
+        std::make_shared<folly::NamedThreadFactory>("HiveWriterFlush"));
+  }
 }
 
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
@@ -89,7 +106,8 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       executor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      splitDecodeExecutor_.get());
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -106,7 +124,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      writerFlushExecutor_.get());
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
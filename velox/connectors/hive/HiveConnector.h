@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
@@ -78,6 +80,12 @@ class HiveConnector : public Connector {
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* executor_;
+  // Decodes ranges of large splits in parallel. Set if split-decode-threads
+  // is not 0.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> splitDecodeExecutor_;
+  // Flushes the columns of written stripes in parallel. Set if
+  // writer-flush-threads is not 0.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> writerFlushExecutor_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
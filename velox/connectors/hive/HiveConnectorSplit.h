@@ -85,6 +85,10 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
   }
+
+  uint64_t byteSize() const override {
+    return length == std::numeric_limits<uint64_t>::max() ? 0 : length;
+  }
 };
 
 } // namespace facebook::velox::connector::hive
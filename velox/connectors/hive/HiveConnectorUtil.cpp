@@ -23,6 +23,7 @@
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/DirectBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Reader.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -337,6 +338,40 @@ void filterOutNullMapKeys(const Type& rootType, common::ScanSpec& rootSpec) {
   });
 }
 
+// Returns true if 'subfield' is a key of a map that is reached through struct
+// fields, e.g. m['k'] or s.m[1]. A filter on such a subfield is applied by the
+// map reader and drops the rows of the map's container.
+bool isMapSubscript(
+    const common::Subfield& subfield,
+    const RowTypePtr& rowType,
+    const RowTypePtr& dataColumns) {
+  auto& path = subfield.path();
+  if (path.size() < 2 ||
+      (path.back()->kind() != common::kStringSubscript &&
+       path.back()->kind() != common::kLongSubscript)) {
+    return false;
+  }
+  auto& name = getColumnName(subfield);
+  const Type* type = nullptr;
+  if (auto index = rowType->getChildIdxIfExists(name)) {
+    type = rowType->childAt(*index).get();
+  } else if (dataColumns) {
+    if (auto dataIndex = dataColumns->getChildIdxIfExists(name)) {
+      type = dataColumns->childAt(*dataIndex).get();
+    }
+  }
+  for (auto i = 1; type && i + 1 < path.size(); ++i) {
+    auto* field =
+        dynamic_cast<const common::Subfield::NestedField*>(path[i].get());
+    if (!field || !type->isRow()) {
+      return false;
+    }
+    auto index = type->asRow().getChildIdxIfExists(field->name());
+    type = index ? type->childAt(*index).get() : nullptr;
+  }
+  return type && type->isMap();
+}
+
 } // namespace
 
 std::shared_ptr<common::ScanSpec> makeScanSpec(
@@ -422,6 +457,17 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
         isSynthesizedColumn(name, infoColumns)) {
       continue;
     }
+    if (isMapSubscript(pair.first, rowType, dataColumns)) {
+      auto& path = pair.first.path();
+      std::vector<std::unique_ptr<common::Subfield::PathElement>> mapPath;
+      for (auto i = 0; i + 1 < path.size(); ++i) {
+        mapPath.push_back(path[i]->clone());
+      }
+      auto* mapSpec =
+          spec->getOrCreateChild(common::Subfield(std::move(mapPath)));
+      mapSpec->addMapSubscriptFilter(*path.back(), *pair.second);
+      continue;
+    }
     auto fieldSpec = spec->getOrCreateChild(pair.first);
     fieldSpec->addFilter(*pair.second);
   }
@@ -505,6 +551,12 @@ void configureReaderOptions(
       hiveTableHandle->dataColumns(),
       hiveSplit,
       hiveTableHandle->tableParameters());
+  if (hiveTableHandle->remainingFilter()) {
+    // The remaining filter is evaluated by HiveDataSource after the pushed
+    // down filters. With lazy columns, the columns it does not reference are
+    // decoded only for the rows that pass it.
+    readerOptions.setLazyColumns(true);
+  }
 }
 
 void configureReaderOptions(
@@ -525,6 +577,19 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setReadBloomFilters(
+      hiveConfig->isParquetBloomFilterEnabled(sessionProperties));
+  readerOptions.setLazyColumns(
+      hiveConfig->isParquetLazyColumnsEnabled(sessionProperties));
+  readerOptions.setFileMetadataCache(
+      dwio::common::FileMetadataCache::getInstance());
+  // Tells cached footers of a rewritten file apart.
+  int64_t modificationTime{0};
+  const auto it = hiveSplit->infoColumns.find("$file_modified_time");
+  if (it != hiveSplit->infoColumns.end()) {
+    modificationTime = folly::tryTo<int64_t>(it->second).value_or(0);
+  }
+  readerOptions.setFileModificationTime(modificationTime);
 
   if (readerOptions.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
     VELOX_CHECK(
@@ -657,14 +722,19 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     folly::Executor* executor) {
-  if (connectorQueryCtx->cache()) {
+  if (auto* cache = connectorQueryCtx->cache()) {
+    // The access statistics of the file groups outlive the scan and predict
+    // the columns read by the next scans of the same groups.
+    auto* ssdCache = cache->ssdCache();
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
-        connectorQueryCtx->cache(),
+        cache,
         Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+            connectorQueryCtx->scanId(),
+            readerOpts.loadQuantum(),
+            ssdCache ? &ssdCache->groupStats() : nullptr),
         fileHandle.groupId.id(),
         ioStats,
         executor,
@@ -345,7 +345,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* writerFlushExecutor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -354,6 +355,11 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      maxOpenFiles_(
+          insertTableHandle_->bucketProperty() == nullptr
+              ? hiveConfig_->maxOpenWriterFiles(
+                    connectorQueryCtx->sessionProperties())
+              : 0),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -378,7 +384,8 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      writerFlushExecutor_(writerFlushExecutor) {
   VELOX_USER_CHECK(
       !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
@@ -423,6 +430,7 @@ bool HiveDataSink::canReclaim() const {
 
 void HiveDataSink::appendData(RowVectorPtr input) {
   checkRunning();
+  ++numInputs_;
 
   // Write to unpartitioned table.
   if (!isPartitioned()) {
@@ -613,11 +621,17 @@ void HiveDataSink::closeInternal() {
 
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -626,18 +640,45 @@ void HiveDataSink::closeInternal() {
 
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
-  if (it != writerIndexMap_.end()) {
+  if (it != writerIndexMap_.end() && writers_[it->second] != nullptr) {
+    writerLastInputs_[it->second] = numInputs_;
     return it->second;
   }
   return appendWriter(id);
 }
 
+void HiveDataSink::maybeCloseIdleWriter() {
+  if (maxOpenFiles_ == 0 || numOpenFiles_ < maxOpenFiles_) {
+    return;
+  }
+  std::optional<uint32_t> idleIndex;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] == nullptr || writerLastInputs_[i] == numInputs_) {
+      continue;
+    }
+    if (!idleIndex.has_value() ||
+        writerLastInputs_[i] < writerLastInputs_[idleIndex.value()]) {
+      idleIndex = i;
+    }
+  }
+  if (!idleIndex.has_value()) {
+    return;
+  }
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(idleIndex.value());
+    writers_[idleIndex.value()]->close();
+  }
+  writers_[idleIndex.value()].reset();
+  --numOpenFiles_;
+}
+
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  VELOX_CHECK_LE(writerIndexMap_.size(), writerInfo_.size());
+  maybeCloseIdleWriter();
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -682,11 +723,16 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       hiveConfig_->orcWriterMaxDictionaryMemory(connectorSessionProperties));
   options.parquetWriteTimestampUnit =
       hiveConfig_->parquetWriteTimestampUnit(connectorSessionProperties);
+  options.parquetEnablePageIndex =
+      hiveConfig_->isParquetWriterPageIndexEnabled(connectorSessionProperties);
   options.orcMinCompressionSize = std::optional(
       hiveConfig_->orcWriterMinCompressionSize(connectorSessionProperties));
   options.orcLinearStripeSizeHeuristics =
       std::optional(hiveConfig_->orcWriterLinearStripeSizeHeuristics(
           connectorSessionProperties));
+  options.flushExecutor = writerFlushExecutor_;
+  options.flushParallelism =
+      hiveConfig_->orcWriterFlushParallelism(connectorSessionProperties);
   options.serdeParameters = std::map<std::string, std::string>(
       insertTableHandle_->serdeParameters().begin(),
       insertTableHandle_->serdeParameters().end());
@@ -709,8 +755,10 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
   rawPartitionRows_.emplace_back(nullptr);
+  writerLastInputs_.emplace_back(numInputs_);
+  ++numOpenFiles_;
 
-  writerIndexMap_.emplace(id, writers_.size() - 1);
+  writerIndexMap_[id] = writers_.size() - 1;
   return writerIndexMap_[id];
 }
 
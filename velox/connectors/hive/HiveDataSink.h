@@ -419,7 +419,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* writerFlushExecutor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -525,6 +526,12 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Closes the file of the writer that has gone the longest without input if
+  // 'maxOpenFiles_' files are open. Writers that take rows of the current
+  // input are not closed, so the limit can be exceeded by a single input
+  // with more partitions than 'maxOpenFiles_'.
+  void maybeCloseIdleWriter();
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
@@ -561,6 +568,9 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  // Maximum number of open files. 0 if unlimited. Always 0 for a bucketed
+  // table since its file names are fixed by the bucket ids.
+  const uint32_t maxOpenFiles_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -569,6 +579,8 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  // Executor for flushing the columns of written stripes in parallel.
+  folly::Executor* const writerFlushExecutor_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -582,11 +594,19 @@ class HiveDataSink : public DataSink {
       writerIndexMap_;
 
   // Below are structures for partitions from all inputs. writerInfo_ and
-  // writers_ are both indexed by partitionId.
+  // writers_ are both indexed by partitionId. The writer of a file closed by
+  // maybeCloseIdleWriter() is nullptr. Its partition continues in a new
+  // writer appended at the end.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // The number of the last input that had rows for each writer.
+  std::vector<uint64_t> writerLastInputs_;
+  // The number of inputs so far.
+  uint64_t numInputs_{0};
+  // The number of non-null 'writers_'.
+  uint32_t numOpenFiles_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
@@ -38,12 +38,14 @@ HiveDataSource::HiveDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    folly::Executor* splitDecodeExecutor)
     : pool_(connectorQueryCtx->memoryPool()),
       fileHandleFactory_(fileHandleFactory),
       executor_(executor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
+      splitDecodeExecutor_(splitDecodeExecutor),
       outputType_(outputType),
       expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
   // Column handled keyed on the column alias, the name used in the query.
@@ -113,6 +115,12 @@ HiveDataSource::HiveDataSource(
   if (sampleRate != 1) {
     randomSkip_ = std::make_shared<random::RandomSkipTracker>(sampleRate);
   }
+  filtersOnlyOnPartitionKeys_ = remainingFilter == nullptr && !randomSkip_;
+  for (const auto& [subfield, _] : filters) {
+    if (partitionKeys_.count(getColumnName(subfield)) == 0) {
+      filtersOnlyOnPartitionKeys_ = false;
+    }
+  }
 
   std::vector<common::Subfield> remainingFilterSubfields;
   if (remainingFilter) {
@@ -178,7 +186,8 @@ std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
       ioStats_,
       fileHandleFactory_,
       executor_,
-      scanSpec_);
+      scanSpec_,
+      splitDecodeExecutor_);
 }
 
 void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
@@ -198,6 +207,9 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
+  if (rowLimit_.has_value() && *rowLimit_ <= kMaxRowLimitWithoutReadAhead) {
+    splitReader_->setPrefetchRowGroups(0);
+  }
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_, rowIndexColumn_);
 }
 
@@ -275,11 +287,44 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   return nullptr;
 }
 
+std::optional<std::vector<VectorPtr>> HiveDataSource::aggregateFromStatistics(
+    const std::vector<StatisticsAggregate>& aggregates) {
+  VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
+  if (!filtersOnlyOnPartitionKeys_) {
+    return std::nullopt;
+  }
+
+  // The split reader looks up the statistics by file column name.
+  std::vector<StatisticsAggregate> fileAggregates;
+  fileAggregates.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    auto& fileAggregate = fileAggregates.emplace_back(aggregate);
+    if (aggregate.kind == StatisticsAggregate::Kind::kCountAll) {
+      continue;
+    }
+    const auto channel = outputType_->getChildIdxIfExists(aggregate.column);
+    if (!channel.has_value()) {
+      return std::nullopt;
+    }
+    fileAggregate.column = readerOutputType_->nameOf(channel.value());
+  }
+
+  auto results = splitReader_->aggregateFromStatistics(fileAggregates);
+  if (results.has_value()) {
+    resetSplit();
+  }
+  return results;
+}
+
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
+  if (partitionKeys_.count(fieldSpec.fieldName()) == 0) {
+    filtersOnlyOnPartitionKeys_ = false;
+  }
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
     splitReader_->resetFilterCaches();
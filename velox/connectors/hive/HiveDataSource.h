@@ -44,7 +44,8 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      folly::Executor* splitDecodeExecutor = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -69,6 +70,13 @@ class HiveDataSource : public DataSource {
     return splitReader_ && splitReader_->allPrefetchIssued();
   }
 
+  void setRowLimit(uint64_t numRows) override {
+    rowLimit_ = numRows;
+  }
+
+  std::optional<std::vector<VectorPtr>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& aggregates) override;
+
   void setFromDataSource(std::unique_ptr<DataSource> sourceUnique) override;
 
   int64_t estimatedRowSize() override;
@@ -118,6 +126,8 @@ class HiveDataSource : public DataSource {
   folly::Executor* const executor_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
+  // Executor for decoding splits in parallel, nullptr if not enabled.
+  folly::Executor* const splitDecodeExecutor_;
   std::shared_ptr<io::IoStatistics> ioStats_;
   std::shared_ptr<HiveColumnHandle> rowIndexColumn_;
 
@@ -159,6 +169,18 @@ class HiveDataSource : public DataSource {
   exec::FilterEvalCtx filterEvalCtx_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // A row limit up to this many rows is expected to be met by the first row
+  // group read, so no row groups are read ahead for it.
+  static constexpr uint64_t kMaxRowLimitWithoutReadAhead = 10'000;
+
+  // Output rows still needed, if known. See setRowLimit().
+  std::optional<uint64_t> rowLimit_;
+
+  // True if the rows are filtered at most on partition keys, so that the file
+  // statistics cover the rows of a split that passes the filters. See
+  // aggregateFromStatistics().
+  bool filtersOnlyOnPartitionKeys_{true};
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
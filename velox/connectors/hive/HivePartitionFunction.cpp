@@ -109,12 +109,42 @@ inline uint32_t hashOne<TypeKind::UNKNOWN>(const UnknownValue& /*value*/) {
   VELOX_FAIL("Unknown values cannot be non-NULL");
 }
 
+// Hashes all rows of a flat vector without nulls. The loops have no per-row
+// branches and read the values directly, which lets the compiler vectorize
+// the hashing of fixed-width values and the multiply-add of the mixing.
+template <TypeKind kind>
+void hashFlatNoNulls(
+    const DecodedVector& values,
+    vector_size_t numRows,
+    bool mix,
+    std::vector<uint32_t>& hashes) {
+  const auto* rawValues = values.data<typename TypeTraits<kind>::NativeType>();
+  auto* rawHashes = hashes.data();
+  if (mix) {
+    for (auto i = 0; i < numRows; ++i) {
+      rawHashes[i] = rawHashes[i] * 31 + hashOne<kind>(rawValues[i]);
+    }
+  } else {
+    for (auto i = 0; i < numRows; ++i) {
+      rawHashes[i] = hashOne<kind>(rawValues[i]);
+    }
+  }
+}
+
 template <TypeKind kind>
 void hashPrimitive(
     const DecodedVector& values,
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes) {
+  // Booleans are bit-packed and unknown values are always null.
+  if constexpr (kind != TypeKind::BOOLEAN && kind != TypeKind::UNKNOWN) {
+    if (rows.isAllSelected() && values.isIdentityMapping() &&
+        !values.mayHaveNulls()) {
+      hashFlatNoNulls<kind>(values, rows.size(), mix, hashes);
+      return;
+    }
+  }
   if (rows.isAllSelected()) {
     // The compiler seems to be a little fickle with optimizations.
     // Although rows.applyToSelected should do roughly the same thing, doing
@@ -140,6 +170,22 @@ void hashPrimitive(
   }
 }
 
+// Returns the multiplier for bucketOf().
+uint64_t bucketMultiplier(int numBuckets) {
+  VELOX_CHECK_GT(numBuckets, 0);
+  return std::numeric_limits<uint64_t>::max() / numBuckets + 1;
+}
+
+// Returns 'hash' % 'numBuckets' with a multiplication instead of a division.
+// 'multiplier' is bucketMultiplier('numBuckets'). The result is exact for all
+// 32-bit values of 'hash' and 'numBuckets'. See Lemire, Kaser and Kurz,
+// "Faster Remainder by Direct Computation".
+inline uint32_t
+bucketOf(uint32_t hash, uint64_t multiplier, uint32_t numBuckets) {
+  const uint64_t fraction = multiplier * hash;
+  return (static_cast<__uint128_t>(fraction) * numBuckets) >> 64;
+}
+
 void hashPrecomputed(
     uint32_t precomputedHash,
     vector_size_t numRows,
@@ -462,6 +508,7 @@ HivePartitionFunction::HivePartitionFunction(
     std::vector<column_index_t> keyChannels,
     const std::vector<VectorPtr>& constValues)
     : numBuckets_{numBuckets},
+      bucketMultiplier_{bucketMultiplier(numBuckets)},
       bucketToPartition_{bucketToPartition},
       keyChannels_{std::move(keyChannels)} {
   precomputedHashes_.resize(keyChannels_.size());
@@ -502,12 +549,13 @@ std::optional<uint32_t> HivePartitionFunction::partition(
     // NOTE: if bucket to partition mapping is empty, then we do
     // identical mapping.
     for (auto i = 0; i < numRows; ++i) {
-      partitions[i] = (hashes[i] & kInt32Max) % numBuckets_;
+      partitions[i] =
+          bucketOf(hashes[i] & kInt32Max, bucketMultiplier_, numBuckets_);
     }
   } else {
     for (auto i = 0; i < numRows; ++i) {
-      partitions[i] =
-          bucketToPartition_[((hashes[i] & kInt32Max) % numBuckets_)];
+      partitions[i] = bucketToPartition_[bucketOf(
+          hashes[i] & kInt32Max, bucketMultiplier_, numBuckets_)];
     }
   }
 
@@ -74,6 +74,8 @@ class HivePartitionFunction : public core::PartitionFunction {
   std::vector<uint32_t>& getHashes(size_t poolIndex = 0);
 
   const int numBuckets_;
+  // Multiplier for computing the bucket of a hash without a division.
+  const uint64_t bucketMultiplier_;
   const std::vector<int> bucketToPartition_;
   const std::vector<column_index_t> keyChannels_;
 
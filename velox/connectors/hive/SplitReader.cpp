@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/SplitReader.h"
 
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
@@ -23,7 +24,9 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/ParallelRowReader.h"
 #include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/Statistics.h"
 #include "velox/type/TimestampConversion.h"
 
 namespace facebook::velox::connector::hive {
@@ -58,6 +61,33 @@ VectorPtr newConstantFromString(
         pool, size, false, type, std::move(copy));
   }
 }
+
+template <TypeKind kind>
+VectorPtr newConstantFromStatistics(
+    const TypePtr& type,
+    int64_t value,
+    velox::memory::MemoryPool* pool) {
+  using T = typename TypeTraits<kind>::NativeType;
+  return std::make_shared<ConstantVector<T>>(
+      pool, 1, false, type, static_cast<T>(value));
+}
+
+// Returns true if the integer column statistics give the min and max of
+// 'type'. Decimals are stored differently depending on the file format.
+bool hasIntegerStatistics(const Type& type) {
+  if (type.isDecimal()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 std::unique_ptr<SplitReader> SplitReader::create(
@@ -71,7 +101,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
     const std::shared_ptr<io::IoStatistics>& ioStats,
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec) {
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    folly::Executor* splitDecodeExecutor) {
   //  Create the SplitReader based on hiveSplit->customSplitInfo["table_format"]
   if (hiveSplit->customSplitInfo.count("table_format") > 0 &&
       hiveSplit->customSplitInfo["table_format"] == "hive-iceberg") {
@@ -97,7 +128,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
         ioStats,
         fileHandleFactory,
         executor,
-        scanSpec);
+        scanSpec,
+        splitDecodeExecutor);
   }
 }
 
@@ -112,7 +144,8 @@ SplitReader::SplitReader(
     const std::shared_ptr<io::IoStatistics>& ioStats,
     FileHandleFactory* fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec)
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    folly::Executor* splitDecodeExecutor)
     : hiveSplit_(hiveSplit),
       hiveTableHandle_(hiveTableHandle),
       partitionKeys_(partitionKeys),
@@ -122,11 +155,17 @@ SplitReader::SplitReader(
       ioStats_(ioStats),
       fileHandleFactory_(fileHandleFactory),
       executor_(executor),
+      splitDecodeExecutor_(splitDecodeExecutor),
       pool_(connectorQueryCtx->memoryPool()),
       scanSpec_(scanSpec),
       baseReaderOpts_(connectorQueryCtx->memoryPool()),
       emptySplit_(false) {}
 
+SplitReader::~SplitReader() {
+  // Parallel decode tasks use the members of 'this'.
+  baseRowReader_.reset();
+}
+
 void SplitReader::configureReaderOptions(
     std::shared_ptr<velox::random::RandomSkipTracker> randomSkip) {
   hive::configureReaderOptions(
@@ -161,6 +200,115 @@ uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
   return baseRowReader_->next(size, output, &mutation);
 }
 
+std::optional<std::vector<VectorPtr>> SplitReader::aggregateFromStatistics(
+    const std::vector<StatisticsAggregate>& aggregates) {
+  using Kind = StatisticsAggregate::Kind;
+  if (baseReaderOpts_.randomSkip()) {
+    return std::nullopt;
+  }
+
+  std::vector<VectorPtr> results;
+  results.reserve(aggregates.size());
+  if (emptySplit_) {
+    // No rows, e.g. the partition keys do not pass the filters.
+    for (const auto& aggregate : aggregates) {
+      if (aggregate.kind == Kind::kCountAll || aggregate.kind == Kind::kCount) {
+        results.push_back(BaseVector::createConstant(
+            BIGINT(), variant(static_cast<int64_t>(0)), 1, pool_));
+      } else {
+        results.push_back(BaseVector::createNullConstant(
+            readerOutputType_->findChild(aggregate.column), 1, pool_));
+      }
+    }
+    return results;
+  }
+
+  // The footer has the statistics of the whole file, and the splits of a file
+  // divide its stripes or row groups between them.
+  VELOX_CHECK_NOT_NULL(baseReader_);
+  if (hiveSplit_->start != 0 ||
+      hiveSplit_->length < fileHandle_->file->size()) {
+    return std::nullopt;
+  }
+  const auto numRows = baseReader_->numberOfRows();
+  if (!numRows.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto& fileType = baseReader_->rowType();
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.kind == Kind::kCountAll) {
+      results.push_back(BaseVector::createConstant(
+          BIGINT(), variant(static_cast<int64_t>(numRows.value())), 1, pool_));
+      continue;
+    }
+
+    // Only columns read as stored in the file have matching statistics.
+    const auto& type = readerOutputType_->findChild(aggregate.column);
+    const auto fileIndex = fileType->getChildIdxIfExists(aggregate.column);
+    if (!fileIndex.has_value() || !type->isPrimitiveType() ||
+        !fileType->childAt(fileIndex.value())->equivalent(*type) ||
+        partitionKeys_->count(aggregate.column) > 0 ||
+        hiveSplit_->infoColumns.count(aggregate.column) > 0) {
+      return std::nullopt;
+    }
+    const auto statistics = baseReader_->columnStatistics(
+        baseReader_->typeWithId()->childAt(fileIndex.value())->id());
+    if (statistics == nullptr ||
+        !statistics->getNumberOfValues().has_value()) {
+      return std::nullopt;
+    }
+    const auto numValues = statistics->getNumberOfValues().value();
+    if (aggregate.kind == Kind::kCount) {
+      results.push_back(BaseVector::createConstant(
+          BIGINT(), variant(static_cast<int64_t>(numValues)), 1, pool_));
+      continue;
+    }
+
+    if (numValues == 0) {
+      results.push_back(BaseVector::createNullConstant(type, 1, pool_));
+      continue;
+    }
+    const auto* integerStatistics =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            statistics.get());
+    if (!hasIntegerStatistics(*type) || integerStatistics == nullptr) {
+      return std::nullopt;
+    }
+    const auto value = aggregate.kind == Kind::kMin
+        ? integerStatistics->getMinimum()
+        : integerStatistics->getMaximum();
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+        results.push_back(newConstantFromStatistics<TypeKind::TINYINT>(
+            type, value.value(), pool_));
+        break;
+      case TypeKind::SMALLINT:
+        results.push_back(newConstantFromStatistics<TypeKind::SMALLINT>(
+            type, value.value(), pool_));
+        break;
+      case TypeKind::INTEGER:
+        results.push_back(newConstantFromStatistics<TypeKind::INTEGER>(
+            type, value.value(), pool_));
+        break;
+      case TypeKind::BIGINT:
+        results.push_back(newConstantFromStatistics<TypeKind::BIGINT>(
+            type, value.value(), pool_));
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  // The rows are not read, so the loads the row reader may have started are
+  // not needed.
+  baseRowReader_.reset();
+  return results;
+}
+
 void SplitReader::resetFilterCaches() {
   if (baseRowReader_) {
     baseRowReader_->resetFilterCaches();
@@ -242,6 +390,7 @@ void SplitReader::createReader() {
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandle->uuid.id());
   }
+  fileHandle_ = fileHandle;
   auto baseFileInput = createBufferedInput(
       *fileHandle, baseReaderOpts_, connectorQueryCtx_, ioStats_, executor_);
 
@@ -298,7 +447,67 @@ void SplitReader::createRowReader(
   // NOTE: we firstly reset the finished 'baseRowReader_' of previous split
   // before setting up for the next one to avoid doubling the peak memory usage.
   baseRowReader_.reset();
-  baseRowReader_ = baseReader_->createRowReader(baseRowReaderOpts_);
+  baseRowReader_ = createParallelRowReader();
+  if (!baseRowReader_) {
+    baseRowReader_ = baseReader_->createRowReader(baseRowReaderOpts_);
+  }
+}
+
+std::unique_ptr<dwio::common::RowReader>
+SplitReader::createParallelRowReader() {
+  if (splitDecodeExecutor_ == nullptr || baseReaderOpts_.randomSkip()) {
+    return nullptr;
+  }
+  const auto format = baseReaderOpts_.getFileFormat();
+  if (format != dwio::common::FileFormat::DWRF &&
+      format != dwio::common::FileFormat::ORC &&
+      format != dwio::common::FileFormat::PARQUET) {
+    return nullptr;
+  }
+  const auto* session = connectorQueryCtx_->sessionProperties();
+  const auto parallelism = hiveConfig_->splitDecodeParallelism(session);
+  const auto rangeSize = hiveConfig_->splitDecodeRangeSize(session);
+  const auto fileSize = fileHandle_->file->size();
+  if (parallelism <= 1 || rangeSize == 0 || hiveSplit_->start >= fileSize) {
+    return nullptr;
+  }
+  const auto length =
+      std::min<uint64_t>(hiveSplit_->length, fileSize - hiveSplit_->start);
+  if (length <= rangeSize) {
+    return nullptr;
+  }
+  // Each range has its own Reader since a Reader is not safe to use from
+  // several threads. The footer is cached in the AsyncDataCache or in the
+  // FileMetadataCache if enabled.
+  auto factory = [this](
+                     uint64_t offset,
+                     uint64_t rangeLength,
+                     const std::shared_ptr<common::ScanSpec>& scanSpec) {
+    auto input = createBufferedInput(
+        *fileHandle_,
+        baseReaderOpts_,
+        connectorQueryCtx_,
+        ioStats_,
+        executor_);
+    auto reader =
+        dwio::common::getReaderFactory(baseReaderOpts_.getFileFormat())
+            ->createReader(std::move(input), baseReaderOpts_);
+    auto options = baseRowReaderOpts_;
+    options.range(offset, rangeLength);
+    options.setScanSpec(scanSpec);
+    return reader->createRowReader(options);
+  };
+  dwio::common::ParallelRowReader::Options options;
+  options.executor = splitDecodeExecutor_;
+  options.parallelism = parallelism;
+  options.maxBufferedBytes = hiveConfig_->splitDecodeMaxBufferedBytes();
+  return std::make_unique<dwio::common::ParallelRowReader>(
+      scanSpec_,
+      hiveSplit_->start,
+      length,
+      static_cast<int32_t>(bits::divRoundUp(length, rangeSize)),
+      std::move(factory),
+      options);
 }
 
 void SplitReader::setRowIndexColumn(
@@ -33,6 +33,7 @@ class ScanSpec;
 
 namespace facebook::velox::connector {
 class ConnectorQueryCtx;
+struct StatisticsAggregate;
 } // namespace facebook::velox::connector
 
 namespace facebook::velox::dwio::common {
@@ -65,7 +66,8 @@ class SplitReader {
       const std::shared_ptr<io::IoStatistics>& ioStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      folly::Executor* splitDecodeExecutor = nullptr);
 
   SplitReader(
       const std::shared_ptr<const hive::HiveConnectorSplit>& hiveSplit,
@@ -78,9 +80,10 @@ class SplitReader {
       const std::shared_ptr<io::IoStatistics>& ioStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      folly::Executor* splitDecodeExecutor = nullptr);
 
-  virtual ~SplitReader() = default;
+  virtual ~SplitReader();
 
   void configureReaderOptions(
       std::shared_ptr<random::RandomSkipTracker> randomSkip);
@@ -96,6 +99,14 @@ class SplitReader {
 
   virtual uint64_t next(uint64_t size, VectorPtr& output);
 
+  /// Computes 'aggregates' over the rows of the split from the file footer
+  /// statistics. The columns of 'aggregates' are file column names. Returns
+  /// std::nullopt unless the split covers the whole file and the statistics
+  /// give all the results exactly. The caller makes sure that no filter other
+  /// than on partition keys applies. Must be called after prepareSplit().
+  virtual std::optional<std::vector<VectorPtr>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& aggregates);
+
   void resetFilterCaches();
 
   bool emptySplit() const;
@@ -108,6 +119,12 @@ class SplitReader {
 
   bool allPrefetchIssued() const;
 
+  /// Sets the number of row groups read ahead of the one being read. Must be
+  /// called after configureReaderOptions() and before prepareSplit().
+  void setPrefetchRowGroups(int32_t numRowGroups) {
+    baseReaderOpts_.setPrefetchRowGroups(numRowGroups);
+  }
+
   void setConnectorQueryCtx(const ConnectorQueryCtx* connectorQueryCtx);
 
   std::string toString() const;
@@ -141,6 +158,11 @@ class SplitReader {
       const RowTypePtr& fileType,
       const std::shared_ptr<HiveColumnHandle>& rowIndexColumn);
 
+  // Returns a reader that decodes ranges of the split in parallel on
+  // 'splitDecodeExecutor_' or nullptr if the split is decoded by the caller
+  // of next().
+  std::unique_ptr<dwio::common::RowReader> createParallelRowReader();
+
   void setPartitionValue(
       common::ScanSpec* spec,
       const std::string& partitionKey,
@@ -158,9 +180,11 @@ class SplitReader {
   const std::shared_ptr<io::IoStatistics> ioStats_;
   FileHandleFactory* const fileHandleFactory_;
   folly::Executor* const executor_;
+  folly::Executor* const splitDecodeExecutor_;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<common::ScanSpec> scanSpec_;
+  std::shared_ptr<FileHandle> fileHandle_;
   std::unique_ptr<dwio::common::Reader> baseReader_;
   std::unique_ptr<dwio::common::RowReader> baseRowReader_;
   dwio::common::ReaderOptions baseReaderOpts_;
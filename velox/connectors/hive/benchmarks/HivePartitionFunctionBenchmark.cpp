@@ -65,9 +65,15 @@ class HivePartitionFunctionBenchmark
     addRowVector(MAP(BIGINT(), BOOLEAN()));
     addRowVector(ROW({"a", "b"}, {INTEGER(), DOUBLE()}));
 
+    // Bucketing on several flat columns without nulls, as in bucketed writes.
+    multiKeyRowVector_ =
+        fuzzer.fuzzInputFlatRow(ROW({BIGINT(), INTEGER(), VARCHAR()}));
+
     // Prepare HivePartitionFunction
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
+    multiKeyFunction_ = std::make_unique<HivePartitionFunction>(
+        1024, std::vector<column_index_t>{0, 1, 2});
 
     partitions_.resize(vectorSize);
   }
@@ -82,6 +88,10 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  void runMultiKey() {
+    multiKeyFunction_->partition(*multiKeyRowVector_, partitions_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
@@ -105,6 +115,8 @@ class HivePartitionFunctionBenchmark
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
+  RowVectorPtr multiKeyRowVector_;
+  std::unique_ptr<HivePartitionFunction> multiKeyFunction_;
   std::vector<uint32_t> partitions_;
 };
 
@@ -325,6 +337,16 @@ BENCHMARK_RELATIVE(rowManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::ROW>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiKeyFewRows) {
+  benchmarkFew->runMultiKey();
+}
+
+BENCHMARK(multiKeyManyRows) {
+  benchmarkMany->runMultiKey();
+}
+
 BENCHMARK_DRAW_LINE();
 } // namespace
 
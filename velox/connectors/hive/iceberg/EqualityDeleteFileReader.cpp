@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+constexpr uint64_t kDeleteReadBatchSize = 10'000;
+} // namespace
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    const RowTypePtr& baseOutputType,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : pool_(connectorQueryCtx->memoryPool()),
+      deleteSet_(memory::StlAllocator<RowKey>(*pool_)) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+
+  if (deleteFile.recordCount == 0) {
+    return;
+  }
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  // The schema of the delete file is the one in the file.
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      RowTypePtr{},
+      deleteSplit);
+
+  auto deleteFileHandle =
+      fileHandleFactory->generate(deleteFile.filePath).second;
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.getFileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  const auto& deleteFileType = deleteReader->rowType();
+  VELOX_USER_CHECK_GT(
+      deleteFileType->size(),
+      0,
+      "Iceberg equality delete file {} has no columns",
+      deleteFile.filePath);
+  VELOX_USER_CHECK(
+      deleteFile.equalityFieldIds.empty() ||
+          deleteFile.equalityFieldIds.size() == deleteFileType->size(),
+      "Iceberg equality delete file {} must contain exactly the {} equality columns",
+      deleteFile.filePath,
+      deleteFile.equalityFieldIds.size());
+  for (auto i = 0; i < deleteFileType->size(); ++i) {
+    const auto& name = deleteFileType->nameOf(i);
+    const auto channel = baseOutputType->getChildIdxIfExists(name);
+    if (!channel.has_value()) {
+      VELOX_NYI(
+          "Iceberg equality delete column {} must be read from the base data file",
+          name);
+    }
+    VELOX_USER_CHECK(
+        baseOutputType->childAt(channel.value())
+            ->equivalent(*deleteFileType->childAt(i)),
+        "Iceberg equality delete column {} has type {}, expected {}",
+        name,
+        deleteFileType->childAt(i)->toString(),
+        baseOutputType->childAt(channel.value())->toString());
+    baseChannels_.push_back(channel.value());
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*deleteFileType);
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts,
+      {},
+      scanSpec,
+      nullptr,
+      deleteFileType,
+      deleteSplit);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  deleteRows_ = BaseVector::create<RowVector>(deleteFileType, 0, pool_);
+  VectorPtr batch = BaseVector::create(deleteFileType, 0, pool_);
+  while (deleteRowReader->next(kDeleteReadBatchSize, batch) > 0) {
+    const auto numRows = batch->size();
+    if (numRows == 0) {
+      continue;
+    }
+    batch->loadedVector();
+    const auto offset = deleteRows_->size();
+    deleteRows_->resize(offset + numRows);
+    deleteRows_->copy(batch.get(), offset, 0, numRows);
+  }
+
+  for (const auto& child : deleteRows_->children()) {
+    deleteColumns_.push_back(child.get());
+  }
+  baseColumns_.resize(deleteColumns_.size());
+  deleteSet_.reserve(deleteRows_->size());
+  for (vector_size_t row = 0; row < deleteRows_->size(); ++row) {
+    deleteSet_.insert({&deleteColumns_, row, hashRow(deleteColumns_, row)});
+  }
+}
+
+void EqualityDeleteFileReader::applyDeletes(
+    const RowVector& output,
+    SelectivityVector& rows) {
+  if (deleteSet_.empty()) {
+    return;
+  }
+  for (auto i = 0; i < baseChannels_.size(); ++i) {
+    baseColumns_[i] = output.childAt(baseChannels_[i])->loadedVector();
+  }
+  rows.applyToSelected([&](vector_size_t row) {
+    if (deleteSet_.contains({&baseColumns_, row, hashRow(baseColumns_, row)})) {
+      rows.setValid(row, false);
+    }
+  });
+  rows.updateBounds();
+}
+
+// static
+uint64_t EqualityDeleteFileReader::hashRow(
+    const std::vector<const BaseVector*>& columns,
+    vector_size_t row) {
+  uint64_t hash = columns[0]->hashValueAt(row);
+  for (auto i = 1; i < columns.size(); ++i) {
+    hash = bits::hashMix(hash, columns[i]->hashValueAt(row));
+  }
+  return hash;
+}
+
+bool EqualityDeleteFileReader::RowKeyComparer::operator()(
+    const RowKey& left,
+    const RowKey& right) const {
+  if (left.hash != right.hash) {
+    return false;
+  }
+  for (auto i = 0; i < left.columns->size(); ++i) {
+    if (!(*left.columns)[i]->equalValueAt(
+            (*right.columns)[i], left.row, right.row)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
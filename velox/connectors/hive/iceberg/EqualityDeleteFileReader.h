@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Reads the rows of an equality delete file into a hash set and removes the
+/// rows of the base data file that are equal to any of them. The delete file
+/// must contain exactly the equality columns, under the names of the
+/// corresponding table columns. Null is equal to null. The hash set is
+/// allocated from the connector memory pool.
+class EqualityDeleteFileReader {
+ public:
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      const RowTypePtr& baseOutputType,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Deselects the rows of 'output' that match a row of the delete file.
+  /// 'output' is a batch of the base data file of 'baseOutputType'.
+  void applyDeletes(const RowVector& output, SelectivityVector& rows);
+
+ private:
+  // A row of the delete columns in 'columns'.
+  struct RowKey {
+    const std::vector<const BaseVector*>* columns;
+    vector_size_t row;
+    uint64_t hash;
+  };
+
+  struct RowKeyHasher {
+    size_t operator()(const RowKey& key) const {
+      return key.hash;
+    }
+  };
+
+  struct RowKeyComparer {
+    bool operator()(const RowKey& left, const RowKey& right) const;
+  };
+
+  using RowKeySet = folly::F14FastSet<
+      RowKey,
+      RowKeyHasher,
+      RowKeyComparer,
+      memory::StlAllocator<RowKey>>;
+
+  static uint64_t hashRow(
+      const std::vector<const BaseVector*>& columns,
+      vector_size_t row);
+
+  memory::MemoryPool* const pool_;
+
+  // The channels of the delete columns in the base data file output.
+  std::vector<column_index_t> baseChannels_;
+  // All rows of the delete file.
+  RowVectorPtr deleteRows_;
+  std::vector<const BaseVector*> deleteColumns_;
+  RowKeySet deleteSet_;
+
+  // The delete columns of the current base data file batch.
+  std::vector<const BaseVector*> baseColumns_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
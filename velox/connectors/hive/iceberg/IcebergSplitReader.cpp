@@ -19,6 +19,7 @@
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/exec/OperatorUtils.h"
 
 using namespace facebook::velox::dwio::common;
 
@@ -68,6 +69,7 @@ void IcebergSplitReader::prepareSplit(
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  equalityDeleteFileReaders_.clear();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
@@ -86,6 +88,19 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        equalityDeleteFileReaders_.push_back(
+            std::make_unique<EqualityDeleteFileReader>(
+                deleteFile,
+                readerOutputType_,
+                fileHandleFactory_,
+                connectorQueryCtx_,
+                executor_,
+                hiveConfig_,
+                ioStats_,
+                hiveSplit_->connectorId));
+      }
     } else {
       VELOX_NYI();
     }
@@ -121,7 +136,33 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   auto rowsScanned = baseRowReader_->next(size, output, &mutation);
   baseReadOffset_ += rowsScanned;
 
+  if (!equalityDeleteFileReaders_.empty()) {
+    applyEqualityDeletes(output);
+  }
   return rowsScanned;
 }
 
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  const auto numRows = output->size();
+  if (numRows == 0) {
+    return;
+  }
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(output);
+  VELOX_CHECK_NOT_NULL(rowVector);
+  equalityDeleteRows_.resizeFill(numRows, true);
+  for (auto& reader : equalityDeleteFileReaders_) {
+    reader->applyDeletes(*rowVector, equalityDeleteRows_);
+  }
+  const auto numPassed = equalityDeleteRows_.countSelected();
+  if (numPassed == numRows) {
+    return;
+  }
+  auto indices = allocateIndices(numPassed, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  equalityDeleteRows_.applyToSelected(
+      [&](vector_size_t row) { rawIndices[numIndices++] = row; });
+  output = exec::wrap(numPassed, std::move(indices), rowVector);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
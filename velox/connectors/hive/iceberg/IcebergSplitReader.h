@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -48,7 +49,16 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// The delete files remove rows that the file statistics count.
+  std::optional<std::vector<VectorPtr>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& /*aggregates*/) override {
+    return std::nullopt;
+  }
+
  private:
+  // Removes the rows of 'output' that match a row of an equality delete file.
+  void applyEqualityDeletes(VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -59,5 +69,10 @@ class IcebergSplitReader : public SplitReader {
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
   BufferPtr deleteBitmap_;
+
+  std::vector<std::unique_ptr<EqualityDeleteFileReader>>
+      equalityDeleteFileReaders_;
+  // The rows of the current batch that are not deleted by equality deletes.
+  SelectivityVector equalityDeleteRows_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
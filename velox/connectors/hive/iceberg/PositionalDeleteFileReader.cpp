@@ -16,13 +16,49 @@
 
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/dwio/common/ReaderFactory.h"
 
+DECLARE_int32(velox_iceberg_delete_positions_cache_entries);
+
 namespace facebook::velox::connector::hive::iceberg {
+namespace {
+constexpr uint64_t kDeletePositionsBatchSize = 10'000;
+
+using DeletePositionsCache =
+    SimpleLRUCache<std::string, std::shared_ptr<const std::vector<int64_t>>>;
+
+// Returns the process wide cache of the delete positions of a base file in a
+// delete file, or nullptr if disabled. Iceberg files are never modified, so
+// the paths identify the positions.
+folly::Synchronized<DeletePositionsCache>* deletePositionsCache() {
+  if (FLAGS_velox_iceberg_delete_positions_cache_entries <= 0) {
+    return nullptr;
+  }
+  static auto* const cache = new folly::Synchronized<DeletePositionsCache>(
+      std::in_place, FLAGS_velox_iceberg_delete_positions_cache_entries);
+  return cache;
+}
+
+std::string deletePositionsCacheKey(
+    const IcebergDeleteFile& deleteFile,
+    const std::string& baseFilePath) {
+  // The size and the record count guard against a reused path.
+  return fmt::format(
+      "{}\n{}\n{}\n{}",
+      deleteFile.filePath,
+      deleteFile.fileSizeInBytes,
+      deleteFile.recordCount,
+      baseFilePath);
+}
+} // namespace
 
 PositionalDeleteFileReader::PositionalDeleteFileReader(
     const IcebergDeleteFile& deleteFile,
@@ -56,6 +92,17 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     return;
   }
 
+  auto* cache = deletePositionsCache();
+  const auto cacheKey = cache != nullptr
+      ? deletePositionsCacheKey(deleteFile_, baseFilePath_)
+      : std::string();
+  if (cache != nullptr) {
+    if (auto positions = cache->wlock()->get(cacheKey)) {
+      cachedPositions_ = std::move(positions.value());
+      return;
+    }
+  }
+
   // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
   //  this batch. If not, no need to proceed.
 
@@ -118,6 +165,10 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     ++runtimeStats.skippedSplits;
     runtimeStats.skippedSplitBytes += deleteSplit_->length;
     deleteSplit_.reset();
+    if (cache != nullptr) {
+      cachedPositions_ = std::make_shared<const std::vector<int64_t>>();
+      cache->wlock()->add(cacheKey, cachedPositions_);
+    }
     return;
   }
 
@@ -132,12 +183,60 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
 
   deleteRowReader_.reset();
   deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  if (cache != nullptr) {
+    cachedPositions_ = readAllDeletePositions();
+    cache->wlock()->add(cacheKey, cachedPositions_);
+  }
+}
+
+std::shared_ptr<const std::vector<int64_t>>
+PositionalDeleteFileReader::readAllDeletePositions() {
+  auto positions = std::make_shared<std::vector<int64_t>>();
+  VectorPtr output = BaseVector::create(
+      ROW({posColumn_->name}, {posColumn_->type}), 0, pool_);
+  while (deleteRowReader_->next(kDeletePositionsBatchSize, output) > 0) {
+    if (output->size() == 0) {
+      continue;
+    }
+    output->loadedVector();
+    const auto& positionsVector =
+        std::dynamic_pointer_cast<RowVector>(output)->childAt(0);
+    const auto* rawPositions =
+        positionsVector->as<FlatVector<int64_t>>()->rawValues();
+    positions->insert(
+        positions->end(), rawPositions, rawPositions + output->size());
+  }
+  deleteRowReader_.reset();
+  deleteSplit_.reset();
+  return positions;
+}
+
+void PositionalDeleteFileReader::applyCachedPositions(
+    uint64_t baseReadOffset,
+    uint64_t size,
+    int8_t* deleteBitmap) {
+  const auto& positions = *cachedPositions_;
+  const int64_t offset = splitOffset_ + baseReadOffset;
+  // Skips the positions before the batch, e.g. before the split.
+  auto it = std::lower_bound(
+      positions.begin() + cachedPositionsOffset_, positions.end(), offset);
+  for (; it != positions.end() && *it < offset + size; ++it) {
+    bits::setBit(deleteBitmap, *it - offset);
+  }
+  cachedPositionsOffset_ = it - positions.begin();
+  endOfFile_ = cachedPositionsOffset_ == positions.size();
 }
 
 void PositionalDeleteFileReader::readDeletePositions(
     uint64_t baseReadOffset,
     uint64_t size,
     int8_t* deleteBitmap) {
+  if (cachedPositions_ != nullptr) {
+    applyCachedPositions(baseReadOffset, size, deleteBitmap);
+    return;
+  }
+
   // We are going to read to the row number up to the end of the batch. For the
   // same base file, the deleted rows are in ascending order in the same delete
   // file
@@ -55,6 +55,16 @@ class PositionalDeleteFileReader {
   bool endOfFile();
 
  private:
+  // Reads all the delete positions for 'baseFilePath_' and closes the delete
+  // file.
+  std::shared_ptr<const std::vector<int64_t>> readAllDeletePositions();
+
+  // Sets the bits of 'cachedPositions_' in the batch.
+  void applyCachedPositions(
+      uint64_t baseReadOffset,
+      uint64_t size,
+      int8_t* deleteBitmap);
+
   void updateDeleteBitmap(
       VectorPtr deletePositionsVector,
       uint64_t baseReadOffset,
@@ -80,6 +90,14 @@ class PositionalDeleteFileReader {
   VectorPtr deletePositionsOutput_;
   uint64_t deletePositionsOffset_;
   bool endOfFile_;
+
+  // All the delete positions for 'baseFilePath_' in ascending order if the
+  // delete positions cache is enabled. Shared with the other readers of the
+  // same delete and base files, so that a delete file is read once for all
+  // the splits of a base file.
+  std::shared_ptr<const std::vector<int64_t>> cachedPositions_;
+  // The first position in 'cachedPositions_' not yet applied.
+  size_t cachedPositionsOffset_{0};
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -23,7 +23,11 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
+#include <gflags/gflags.h>
+
+DECLARE_int32(velox_iceberg_delete_positions_cache_entries);
 
 using namespace facebook::velox::exec::test;
 using namespace facebook::velox::exec;
@@ -347,4 +351,50 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, positionalDeletesCache) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  FLAGS_velox_iceberg_delete_positions_cache_entries = 100;
+  SCOPE_EXIT {
+    FLAGS_velox_iceberg_delete_positions_cache_entries = 0;
+  };
+
+  assertPositionalDeletes({{0, 9999, 10000, 19999}});
+  assertPositionalDeletes({makeRandomDeleteRows(rowCount)}, true);
+  assertPositionalDeletes(
+      {makeSequenceRows(rowCount)}, "SELECT * FROM tmp WHERE 1 = 0", false);
+  std::vector<std::vector<int64_t>> deletedRows = {{1}, {2}, {3, 4}};
+  assertPositionalDeletes(deletedRows, getQuery(deletedRows), 10, 2);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto dataFilePaths = writeDataFile(1, rowCount);
+
+  // Two delete files on c0, also with values that are not in the data file.
+  const std::vector<std::vector<int64_t>> deletedValues = {
+      {0, 5, 9999, 30000}, {10000, 19999, -1}};
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  std::vector<IcebergDeleteFile> deleteFiles;
+  for (const auto& values : deletedValues) {
+    deleteFilePaths.push_back(TempFilePath::create());
+    const auto path = deleteFilePaths.back()->getPath();
+    writeToFile(
+        path,
+        makeRowVector({"c0"}, {vectorMaker_.flatVector<int64_t>(values)}));
+    deleteFiles.emplace_back(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        values.size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        std::vector<int32_t>{1});
+  }
+
+  HiveConnectorTestBase::assertQuery(
+      tableScanNode(),
+      {makeIcebergSplit(dataFilePaths[0]->getPath(), deleteFiles)},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 9999, 10000, 19999)",
+      0);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
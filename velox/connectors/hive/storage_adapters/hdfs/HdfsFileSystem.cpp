@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
@@ -25,11 +28,28 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
+    // A null 'config' gets the HiveConfig defaults.
+    const HiveConfig hiveConfig(
+        config != nullptr
+            ? std::make_shared<core::MemConfig>(config->values())
+            : std::make_shared<core::MemConfig>());
+    const auto socketPath = hiveConfig.hdfsDomainSocketPath();
+    VELOX_USER_CHECK(
+        !hiveConfig.hdfsShortCircuitRead() || !socketPath.empty(),
+        "{} requires {}",
+        HiveConfig::kHdfsShortCircuitRead,
+        HiveConfig::kHdfsDomainSocketPath);
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (hiveConfig.hdfsShortCircuitRead()) {
+      // libhdfs3 then reads the blocks of the local datanode from the block
+      // files, whose descriptors the datanode passes over the socket.
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", socketPath.c_str());
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
@@ -37,9 +57,16 @@ class HdfsFileSystem::Impl {
         "Unable to connect to HDFS: {}, got error: {}.",
         endpoint.identity(),
         hdfsGetLastError())
+    if (hiveConfig.hdfsReadThreads() > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          hiveConfig.hdfsReadThreads(),
+          std::make_shared<folly::NamedThreadFactory>("HdfsRead"));
+    }
   }
 
   ~Impl() {
+    // The reads in flight use the client.
+    readExecutor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -52,8 +79,13 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
  private:
   hdfsFS hdfsClient_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -77,7 +109,8 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(), path, impl_->readExecutor());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
@@ -15,13 +15,17 @@
  */
 
 #include "HdfsReadFile.h"
+#include <folly/futures/Future.h>
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
 
 namespace facebook::velox {
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* executor)
+    : hdfsClient_(hdfs), executor_(executor), filePath_(path) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   if (fileInfo_ == nullptr) {
     auto error = hdfsGetLastError();
@@ -69,6 +73,19 @@ std::string HdfsReadFile::pread(uint64_t offset, uint64_t length) const {
   return result;
 }
 
+folly::SemiFuture<uint64_t> HdfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  // Each executor thread reads through its own handle in 'file_'.
+  return folly::via(
+             executor_,
+             [this, offset, buffers]() { return preadv(offset, buffers); })
+      .semi();
+}
+
 uint64_t HdfsReadFile::size() const {
   return fileInfo_->mSize;
 }
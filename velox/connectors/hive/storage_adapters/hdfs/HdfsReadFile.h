@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
 #include "velox/common/file/File.h"
 
@@ -60,7 +61,11 @@ struct HdfsFile {
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  /// Runs preadvAsync on 'executor' if it is not nullptr.
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* executor = nullptr);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -68,6 +73,14 @@ class HdfsReadFile final : public ReadFile {
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -87,6 +100,7 @@ class HdfsReadFile final : public ReadFile {
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
   hdfsFS hdfsClient_;
+  folly::Executor* const executor_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
@@ -15,6 +15,7 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <boost/format.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock-matchers.h>
 #include <hdfs/hdfs.h>
 #include <atomic>
@@ -177,6 +178,41 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, preadvAsync) {
+  struct hdfsBuilder* builder = hdfsNewBuilder();
+  hdfsBuilderSetNameNode(builder, localhost.c_str());
+  hdfsBuilderSetNameNodePort(builder, 7878);
+  auto hdfs = hdfsBuilderConnect(builder);
+  HdfsReadFile syncFile(hdfs, destinationPath);
+  EXPECT_FALSE(syncFile.hasPreadvAsync());
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  HdfsReadFile readFile(hdfs, destinationPath, executor.get());
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+
+  // Reads "abbbb", skips all but the last 'c' and reads "cdd".
+  char head[5];
+  char tail[3];
+  std::vector<folly::Range<char*>> buffers = {
+      {head, sizeof(head)}, {nullptr, kOneMB}, {tail, sizeof(tail)}};
+  ASSERT_EQ(readFile.preadvAsync(4, buffers).get(), kOneMB + 8);
+  EXPECT_EQ(std::string_view(head, sizeof(head)), "abbbb");
+  EXPECT_EQ(std::string_view(tail, sizeof(tail)), "cdd");
+}
+
+TEST_F(HdfsFileSystemTest, shortCircuitReadWithoutSocketPath) {
+  auto config = configurationValues;
+  config["hive.hdfs.short-circuit-read"] = "true";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  VELOX_ASSERT_THROW(
+      filesystems::HdfsFileSystem(
+          memConfig,
+          filesystems::HdfsFileSystem::getServiceEndpoint(
+              fullDestinationPath, memConfig.get())),
+      "hive.hdfs.short-circuit-read requires hive.hdfs.domain-socket-path");
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
   auto hdfsFileSystem =
@@ -15,7 +15,11 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/HedgedReadFile.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -24,7 +28,13 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -70,11 +80,25 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Number of GetObject requests in flight in the process.
+std::atomic<int64_t> numActiveGetObjects{0};
+
+struct S3ReadOptions {
+  // Size of the GetObject requests a large read is split into.
+  uint64_t chunkSize{0};
+  // Runs the chunks of large reads and the asynchronous reads. If nullptr,
+  // each read is a single GetObject on the calling thread.
+  folly::Executor* executor{nullptr};
+};
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      const S3ReadOptions& options = {})
+      : client_(client), options_(options) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -132,16 +156,35 @@ class S3ReadFile final : public ReadFile {
     // TODO: allocate from a memory pool
     std::string result(length, 0);
     preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    copyToRanges(result.data(), buffers);
     return length;
   }
 
+  // Issues the GetObject requests on the read executor, so that no thread
+  // blocks until the copy to 'buffers'. The file must outlive the returned
+  // future.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (options_.executor == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    return readAsync(offset, length, result->data())
+        .deferValue([result, buffers, length](auto&& /*unused*/) {
+          copyToRanges(result->data(), buffers);
+          return static_cast<uint64_t>(length);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return options_.executor != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -165,9 +208,64 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // Copies consecutive ranges of 'data' to the non-gap ranges of 'buffers'.
+  static void copyToRanges(
+      const char* data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t resultOffset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), data + resultOffset, range.size());
+      }
+      resultOffset += range.size();
+    }
+  }
+
+  bool splitRead(uint64_t length) const {
+    return options_.executor != nullptr && options_.chunkSize > 0 &&
+        length > options_.chunkSize;
+  }
+
   // The assumption here is that "position" has space for at least "length"
-  // bytes.
+  // bytes. A read larger than the chunk size is split into concurrent
+  // GetObject requests on the read executor. This thread only waits.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (!splitRead(length)) {
+      getObject(offset, length, position);
+      return;
+    }
+    readAsync(offset, length, position).get();
+  }
+
+  // Reads 'length' bytes at 'offset' into 'position' with GetObject requests
+  // on the read executor. The future is fulfilled when all requests are
+  // done, also if some fail, so that no request writes into 'position' after
+  // the caller sees the error.
+  folly::SemiFuture<folly::Unit>
+  readAsync(uint64_t offset, uint64_t length, char* position) const {
+    std::vector<folly::SemiFuture<folly::Unit>> chunks;
+    const auto chunkSize = splitRead(length) ? options_.chunkSize : length;
+    for (uint64_t chunkOffset = 0; chunkOffset < length;
+         chunkOffset += chunkSize) {
+      const auto chunkLength = std::min(chunkSize, length - chunkOffset);
+      chunks.push_back(
+          folly::via(
+              options_.executor,
+              [this, offset, position, chunkOffset, chunkLength]() {
+                getObject(
+                    offset + chunkOffset, chunkLength, position + chunkOffset);
+              })
+              .semi());
+    }
+    return folly::collectAll(std::move(chunks))
+        .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+          for (auto& result : results) {
+            result.value();
+          }
+        });
+  }
+
+  void getObject(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -179,11 +277,25 @@ class S3ReadFile final : public ReadFile {
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
+    uint64_t latencyUs{0};
+    Aws::S3::Model::GetObjectOutcome outcome;
+    {
+      RECORD_METRIC_VALUE(kMetricS3ActiveGetObjects, ++numActiveGetObjects);
+      SCOPE_EXIT {
+        --numActiveGetObjects;
+      };
+      MicrosecondTimer timer(&latencyUs);
+      outcome = client_->GetObject(request);
+    }
+    RECORD_METRIC_VALUE(kMetricS3GetObjectCount);
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricS3GetObjectLatencyMs, latencyUs / 1000);
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    RECORD_METRIC_VALUE(kMetricS3GetObjectBytes, length);
   }
 
   Aws::S3::S3Client* client_;
+  const S3ReadOptions options_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -221,10 +333,12 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      const S3WriteFile::Options& options)
+      : client_(client), pool_(pool), options_(options) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK_GT(options_.maxInflightParts, 0);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
     currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
     currentPart_->reserve(kPartUploadSize);
@@ -272,10 +386,20 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The parts in flight use the client and the upload state. Their errors
+    // are reported by close().
+    for (auto& part : inflightParts_) {
+      part.wait();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
-    if (data.size() + currentPart_->size() >= kPartUploadSize) {
+    if (options_.executor != nullptr) {
+      appendAsync(data);
+    } else if (data.size() + currentPart_->size() >= kPartUploadSize) {
       upload(data);
     } else {
       // Append to current part.
@@ -297,6 +421,9 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
+    while (!inflightParts_.empty()) {
+      waitForOldestPart();
+    }
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
@@ -366,32 +493,79 @@ class S3WriteFile::Impl {
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
+    // Append ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    uploadState_.completedParts.push_back(
+        uploadPartNumber(part, ++uploadState_.partNumber));
+  }
+
+  // Uploads 'part' as part 'partNumber' and returns its completion. Called
+  // on the upload executor for asynchronous uploads.
+  Aws::S3::Model::CompletedPart uploadPartNumber(
+      const std::string_view part,
+      int64_t partNumber) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    Aws::S3::Model::CompletedPart completedPart;
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(outcome.GetResult().GetETag());
+    return completedPart;
+  }
+
+  // Copies 'data' into 'currentPart_' and hands each part that fills up to
+  // the upload executor.
+  void appendAsync(std::string_view data) {
+    while (!data.empty()) {
+      const auto size = std::min<size_t>(
+          data.size(), kPartUploadSize - currentPart_->size());
+      currentPart_->unsafeAppend(data.data(), size);
+      data.remove_prefix(size);
+      if (currentPart_->size() == kPartUploadSize) {
+        uploadCurrentPartAsync();
+      }
+    }
+  }
 
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
+  // Starts the upload of the full 'currentPart_' on the upload executor and
+  // starts a new part. Waits for the oldest part in flight first if there
+  // are 'maxInflightParts' of them.
+  void uploadCurrentPartAsync() {
+    while (inflightParts_.size() >= options_.maxInflightParts) {
+      waitForOldestPart();
     }
+    const auto partNumber = ++uploadState_.partNumber;
+    std::shared_ptr<dwio::common::DataBuffer<char>> part =
+        std::move(currentPart_);
+    inflightParts_.push_back(
+        folly::via(options_.executor, [this, part, partNumber]() {
+          return uploadPartNumber({part->data(), part->size()}, partNumber);
+        }));
+    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    currentPart_->reserve(kPartUploadSize);
+  }
+
+  // Adds the oldest part in flight to the completed parts, which keeps them
+  // in the order of their part numbers. Throws if its upload failed.
+  void waitForOldestPart() {
+    auto part = std::move(inflightParts_.front());
+    inflightParts_.pop_front();
+    uploadState_.completedParts.push_back(std::move(part).get());
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  const S3WriteFile::Options options_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
+  // The parts being uploaded on 'options_.executor', oldest first.
+  std::deque<folly::Future<Aws::S3::Model::CompletedPart>> inflightParts_;
   std::string bucket_;
   std::string key_;
   size_t fileSize_ = -1;
@@ -400,8 +574,9 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    const Options& options) {
+  impl_ = std::make_shared<Impl>(path, client, pool, options);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -569,10 +744,27 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         hiveConfig_->s3UseVirtualAddressing());
+    if (hiveConfig_->s3ReadThreads() > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          hiveConfig_->s3ReadThreads(),
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+      if (hiveConfig_->s3HedgedReadPercentile() > 0) {
+        latencyTracker_ = std::make_shared<ReadLatencyTracker>(
+            hiveConfig_->s3HedgedReadPercentile());
+      }
+    }
+    if (hiveConfig_->s3UploadThreads() > 0) {
+      uploadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          hiveConfig_->s3UploadThreads(),
+          std::make_shared<folly::NamedThreadFactory>("S3Upload"));
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // The reads and uploads in flight use the client.
+    readExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -647,6 +839,19 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // Returns the tracker of the read latencies if reads are hedged.
+  const std::shared_ptr<ReadLatencyTracker>& latencyTracker() const {
+    return latencyTracker_;
+  }
+
+  S3ReadOptions readOptions() const {
+    return {hiveConfig_->s3ReadChunkSize(), readExecutor_.get()};
+  }
+
+  S3WriteFile::Options writeOptions() const {
+    return {uploadExecutor_.get(), hiveConfig_->s3MaxInflightUploadParts()};
+  }
+
   std::string getLogLevelName() const {
     return getAwsInstance()->getLogLevelName();
   }
@@ -654,6 +859,9 @@ class S3FileSystem::Impl {
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> uploadExecutor_;
+  std::shared_ptr<ReadLatencyTracker> latencyTracker_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -669,8 +877,17 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->readOptions());
   s3file->initialize(options);
+  if (impl_->latencyTracker() != nullptr) {
+    // The attempts run on the read executor through preadvAsync.
+    return std::make_unique<HedgedReadFile>(
+        std::move(s3file),
+        nullptr,
+        impl_->latencyTracker(),
+        &HedgeBudget::global());
+  }
   return s3file;
 }
 
@@ -678,8 +895,8 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file, impl_->s3Client(), options.pool, impl_->writeOptions());
   return s3file;
 }
 
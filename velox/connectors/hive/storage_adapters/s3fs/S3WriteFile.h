@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryPool.h"
 
@@ -42,15 +44,27 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// UploadPart is synchronous during append unless Options::executor is set.
+/// Then full parts are uploaded on the executor while append continues, and
+/// close waits for them before completing the upload.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
+  struct Options {
+    /// Uploads the full parts. If nullptr, the parts are uploaded on the
+    /// appending thread.
+    folly::Executor* executor{nullptr};
+    /// Maximum number of parts being uploaded on 'executor' at the same time.
+    /// Each holds a part sized buffer from the memory pool of the file. An
+    /// append that fills a part waits for the oldest part beyond this limit.
+    uint32_t maxInflightParts{4};
+  };
+
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const Options& options = {});
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -65,7 +79,8 @@ class S3WriteFile : public WriteFile {
   /// Current file size, i.e. the sum of all previous Appends.
   uint64_t size() const override;
 
-  /// Return the number of parts uploaded so far.
+  /// Return the number of parts uploaded so far, including the parts being
+  /// uploaded on Options::executor.
   int numPartsUploaded() const;
 
  protected:
@@ -254,6 +254,90 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, writeFileAsyncAndRead) {
+  const auto bucketName = "writedataasync";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-threads", "4"},
+       {"hive.s3.max-inflight-upload-parts", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // 6 parts of 10MiB and a last part, each part with its own byte value.
+  constexpr uint64_t kPartSize = 10 << 20;
+  constexpr uint64_t kFileSize = 25 * kPartSize / 4;
+  std::string data(kPartSize / 4, 'a');
+  for (int i = 0; i < 25; ++i) {
+    std::fill(data.begin(), data.end(), 'a' + i / 4);
+    writeFile->append(data);
+  }
+  EXPECT_EQ(writeFile->size(), kFileSize);
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 6);
+  // Only a part sized buffer per part in flight and the current part are
+  // held.
+  EXPECT_LE(pool->usedBytes(), 3 * kPartSize + (1 << 20));
+
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 7);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), kFileSize);
+  for (int i = 0; i < 7; ++i) {
+    const std::string expected(1, 'a' + i);
+    const auto partEnd = std::min((i + 1) * kPartSize, kFileSize);
+    EXPECT_EQ(readFile->pread(i * kPartSize, 1), expected);
+    EXPECT_EQ(readFile->pread(partEnd - 1, 1), expected);
+  }
+}
+
+TEST_F(S3FileSystemTest, splitReads) {
+  const char* bucketName = "splitreads";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Reads of more than 64kB are split into concurrent GETs.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-threads", "4"}, {"hive.s3.read-chunk-size", "64kB"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  readData(readFile.get());
+
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  char head[12];
+  char middle[4];
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
+      folly::Range<char*>(middle, sizeof(middle)),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(15 + kOneMB - 500000 - sizeof(head) -
+                            sizeof(middle) - sizeof(tail))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  // A failed GET fails the read and its asynchronous version.
+  std::remove(filename.c_str());
+  VELOX_ASSERT_THROW(
+      readFile->pread(0, readFile->size()), "Failed to get S3 object");
+  VELOX_ASSERT_THROW(
+      readFile->preadvAsync(0, buffers).get(), "Failed to get S3 object");
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
@@ -30,6 +30,7 @@ TEST(HiveConfigTest, defaultConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kError);
   ASSERT_EQ(hiveConfig->maxPartitionsPerWriters(emptySession.get()), 100);
+  ASSERT_EQ(hiveConfig->maxOpenWriterFiles(emptySession.get()), 0);
   ASSERT_EQ(hiveConfig->immutablePartitions(), false);
   ASSERT_EQ(hiveConfig->s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig->s3GetLogLevel(), "FATAL");
@@ -61,6 +62,7 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(
       hiveConfig->sortWriterMaxOutputBytes(emptySession.get()), 10UL << 20);
   ASSERT_EQ(hiveConfig->isPartitionPathAsLowerCase(emptySession.get()), true);
+  ASSERT_EQ(hiveConfig->isParquetBloomFilterEnabled(emptySession.get()), true);
   ASSERT_EQ(hiveConfig->orcWriterMinCompressionSize(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig->orcWriterLinearStripeSizeHeuristics(emptySession.get()),
@@ -152,7 +154,8 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kOrcWriterMinCompressionSizeSession, "512"},
-      {HiveConfig::kOrcWriterLinearStripeSizeHeuristicsSession, "false"}};
+      {HiveConfig::kOrcWriterLinearStripeSizeHeuristicsSession, "false"},
+      {HiveConfig::kParquetBloomFilterEnabledSession, "false"}};
   const auto session = std::make_unique<MemConfig>(sessionOverride);
   ASSERT_EQ(
       hiveConfig->insertExistingPartitionsBehavior(session.get()),
@@ -191,4 +194,5 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_EQ(
       hiveConfig->orcWriterLinearStripeSizeHeuristics(session.get()), false);
   ASSERT_EQ(hiveConfig->orcWriterMinCompressionSize(session.get()), 512);
+  ASSERT_EQ(hiveConfig->isParquetBloomFilterEnabled(session.get()), false);
 }
@@ -463,6 +463,46 @@ TEST_F(HiveConnectorTest, makeScanSpec_prunedMapNonNullMapKey) {
   ASSERT_TRUE(c0->childByName("c0c0")->isConstant());
 }
 
+TEST_F(HiveConnectorTest, makeScanSpec_mapSubscriptFilter) {
+  auto rowType = ROW(
+      {{"c0", MAP(VARCHAR(), BIGINT())},
+       {"c1", ROW({{"c1c0", MAP(BIGINT(), VARCHAR())}})},
+       {"c2", ARRAY(BIGINT())}});
+  SubfieldFilters filters;
+  filters.emplace(Subfield("c0[\"foo\"]"), exec::greaterThan(5));
+  filters.emplace(Subfield("c1.c1c0[3]"), exec::equal("bar"));
+  filters.emplace(Subfield("c1.c1c0[4]"), exec::isNull());
+  auto scanSpec = makeScanSpec(
+      rowType,
+      groupSubfields(makeSubfields({"c0[\"foo\"]", "c1.c1c0[3]", "c2"})),
+      filters,
+      rowType,
+      {},
+      {},
+      nullptr,
+      pool_.get());
+  auto* c0 = scanSpec->childByName("c0");
+  ASSERT_FALSE(c0->filter());
+  ASSERT_TRUE(c0->hasFilter());
+  ASSERT_EQ(c0->mapSubscriptFilters().size(), 1);
+  ASSERT_EQ(std::get<std::string>(c0->mapSubscriptFilters()[0].key), "foo");
+  ASSERT_TRUE(c0->mapSubscriptFilters()[0].filter->testInt64(6));
+  ASSERT_FALSE(c0->mapSubscriptFilters()[0].filter->testInt64(5));
+  // The map values are not filtered.
+  ASSERT_FALSE(c0->childByName(common::ScanSpec::kMapValuesFieldName)
+                   ->hasFilter());
+  auto* c1c0 = scanSpec->childByName("c1")->childByName("c1c0");
+  ASSERT_TRUE(scanSpec->childByName("c1")->hasFilter());
+  auto& c1c0Filters = c1c0->mapSubscriptFilters();
+  ASSERT_EQ(c1c0Filters.size(), 2);
+  ASSERT_TRUE(std::holds_alternative<int64_t>(c1c0Filters[0].key));
+  ASSERT_TRUE(std::holds_alternative<int64_t>(c1c0Filters[1].key));
+  ASSERT_FALSE(scanSpec->childByName("c2")->hasFilter());
+  auto clone = scanSpec->clone();
+  ASSERT_EQ(clone->childByName("c0")->mapSubscriptFilters().size(), 1);
+  ASSERT_TRUE(clone->childByName("c0")->hasFilter());
+}
+
 TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
   auto queryCtx = core::QueryCtx::create();
   exec::SimpleExpressionEvaluator evaluator(queryCtx.get(), pool_.get());
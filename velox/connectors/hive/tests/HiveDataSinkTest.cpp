@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -485,7 +486,8 @@ TEST_F(HiveDataSinkTest, basic) {
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
       "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
-      "spillReadTime[0us] spillReadDeserializationTime[0us]");
+      "spillReadTime[0us] spillReadDeserializationTime[0us] "
+      "spillPrefetchHits[0] spillPrefetchMisses[0]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -568,6 +570,40 @@ TEST_F(HiveDataSinkTest, abort) {
   }
 }
 
+TEST_F(HiveDataSinkTest, maxOpenWriterFiles) {
+  connectorSessionProperties_->setValue(
+      HiveConfig::kMaxOpenWriterFilesSession, "2");
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = createDataSink(
+      rowType,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {"c1"});
+
+  // Partition 0 is idle when partition 2 comes in, so its file is closed and
+  // its last input goes to a new file.
+  for (int32_t partition : {0, 1, 2, 0}) {
+    dataSink->appendData(makeRowVector({
+        makeFlatVector<int64_t>(10, [](auto row) { return row; }),
+        makeConstant(partition, 10),
+    }));
+  }
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), 4);
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, 4);
+  ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), 4);
+  int32_t numPartitionZeroFiles = 0;
+  for (const auto& partition : partitions) {
+    const auto update = folly::parseJson(partition);
+    ASSERT_EQ(update["rowCount"].asInt(), 10);
+    if (update["name"].asString() == "c1=0") {
+      ++numPartitionZeroFiles;
+    }
+  }
+  ASSERT_EQ(numPartitionZeroFiles, 2);
+}
+
 TEST_F(HiveDataSinkTest, memoryReclaim) {
   const int numBatches = 200;
   auto vectors = createVectors(500, 200);
@@ -71,7 +71,10 @@ TpchDataSource::TpchDataSource(
       tpchTableHandle, "TableHandle must be an instance of TpchTableHandle");
   tpchTable_ = tpchTableHandle->getTable();
   scaleFactor_ = tpchTableHandle->getScaleFactor();
-  tpchTableRowCount_ = getRowCount(tpchTable_, scaleFactor_);
+  // Lineitem is generated by order, so its splits divide the orders.
+  tpchTableRowCount_ = getRowCount(
+      tpchTable_ == Table::TBL_LINEITEM ? Table::TBL_ORDERS : tpchTable_,
+      scaleFactor_);
 
   auto tpchTableSchema = getTableSchema(tpchTableHandle->getTable());
   VELOX_CHECK_NOT_NULL(tpchTableSchema, "TpchSchema can't be null.");
@@ -233,6 +233,32 @@ TEST_F(TpchConnectorTest, multipleSplits) {
   }
 }
 
+// Lineitem splits divide the orders, so that each split generates its share
+// of the lineitems.
+TEST_F(TpchConnectorTest, lineitemSplits) {
+  auto plan = PlanBuilder()
+                  .tpchTableScan(
+                      Table::TBL_LINEITEM, {"l_orderkey", "l_linenumber"}, 0.01)
+                  .planNode();
+  auto fullResult = getResults(plan, {makeTpchSplit()});
+  constexpr size_t kTotalParts = 4;
+  std::vector<RowVectorPtr> parts;
+  for (size_t i = 0; i < kTotalParts; ++i) {
+    parts.push_back(getResults(plan, {makeTpchSplit(kTotalParts, i)}));
+    EXPECT_LT(parts.back()->size(), fullResult->size() / 2);
+  }
+  auto output = BaseVector::create<RowVector>(
+      fullResult->type(), fullResult->size(), pool());
+  vector_size_t numRows = 0;
+  for (const auto& part : parts) {
+    ASSERT_LE(numRows + part->size(), fullResult->size());
+    output->copy(part.get(), numRows, 0, part->size());
+    numRows += part->size();
+  }
+  ASSERT_EQ(fullResult->size(), numRows);
+  test::assertEqualVectors(fullResult, output);
+}
+
 // Join nation and region.
 TEST_F(TpchConnectorTest, join) {
   auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
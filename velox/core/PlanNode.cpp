@@ -237,6 +237,154 @@ bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
       queryConfig.aggregationSpillEnabled();
 }
 
+// static
+PlanNodePtr AggregationNode::rewriteDistinctAggregates(
+    const std::shared_ptr<const AggregationNode>& node) {
+  if (!node->isSingle() || node->aggregates().empty() ||
+      !node->preGroupedKeys().empty() || !node->globalGroupingSets().empty()) {
+    return node;
+  }
+
+  // The distinct input columns of each aggregate, sorted by name, and the
+  // index of the set of each aggregate in 'inputSets'.
+  std::vector<std::vector<FieldAccessTypedExprPtr>> inputSets;
+  std::vector<size_t> aggregateSets;
+  for (const auto& aggregate : node->aggregates()) {
+    if (!aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty()) {
+      return node;
+    }
+    std::vector<FieldAccessTypedExprPtr> inputs;
+    for (const auto& input : aggregate.call->inputs()) {
+      if (TypedExprs::isConstant(input)) {
+        continue;
+      }
+      auto field = TypedExprs::asFieldAccess(input);
+      if (field == nullptr || !field->isInputColumn()) {
+        return node;
+      }
+      inputs.push_back(field);
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const auto& x, const auto& y) {
+      return x->name() < y->name();
+    });
+    auto sameName = [](const auto& x, const auto& y) {
+      return x->name() == y->name();
+    };
+    inputs.erase(
+        std::unique(inputs.begin(), inputs.end(), sameName), inputs.end());
+
+    size_t set = 0;
+    for (; set < inputSets.size(); ++set) {
+      if (std::equal(
+              inputs.begin(),
+              inputs.end(),
+              inputSets[set].begin(),
+              inputSets[set].end(),
+              sameName)) {
+        break;
+      }
+    }
+    if (set == inputSets.size()) {
+      inputSets.push_back(std::move(inputs));
+    }
+    aggregateSets.push_back(set);
+  }
+
+  // The grouping keys followed by the aggregate inputs that are not grouping
+  // keys.
+  std::vector<FieldAccessTypedExprPtr> distinctKeys = node->groupingKeys();
+  std::unordered_set<std::string> distinctKeyNames;
+  for (const auto& key : distinctKeys) {
+    distinctKeyNames.insert(key->name());
+  }
+  for (const auto& inputs : inputSets) {
+    for (const auto& input : inputs) {
+      if (distinctKeyNames.insert(input->name()).second) {
+        distinctKeys.push_back(input);
+      }
+    }
+  }
+
+  auto source = node->sources()[0];
+  std::vector<FieldAccessTypedExprPtr> setMasks;
+  if (inputSets.size() > 1) {
+    std::vector<std::string> names;
+    for (const auto& key : distinctKeys) {
+      names.push_back(key->name());
+    }
+    for (auto set = 0; set < inputSets.size(); ++set) {
+      names.push_back(fmt::format("{}_distinct_{}", node->id(), set));
+      setMasks.push_back(
+          std::make_shared<FieldAccessTypedExpr>(BOOLEAN(), names.back()));
+      VELOX_CHECK(
+          !source->outputType()->containsChild(names.back()),
+          "Column name conflicts with a distinct aggregation mask: {}",
+          names.back());
+    }
+
+    std::vector<std::vector<TypedExprPtr>> projections;
+    for (auto set = 0; set < inputSets.size(); ++set) {
+      std::unordered_set<std::string> setNames;
+      for (const auto& input : inputSets[set]) {
+        setNames.insert(input->name());
+      }
+      auto& projection = projections.emplace_back();
+      for (auto i = 0; i < distinctKeys.size(); ++i) {
+        const auto& key = distinctKeys[i];
+        if (i < node->groupingKeys().size() || setNames.count(key->name())) {
+          projection.push_back(key);
+        } else {
+          projection.push_back(std::make_shared<ConstantTypedExpr>(
+              key->type(), variant::null(key->type()->kind())));
+        }
+      }
+      for (auto other = 0; other < inputSets.size(); ++other) {
+        projection.push_back(std::make_shared<ConstantTypedExpr>(
+            BOOLEAN(), variant(other == set)));
+      }
+    }
+    source = std::make_shared<ExpandNode>(
+        fmt::format("{}.expand", node->id()),
+        std::move(projections),
+        std::move(names),
+        source);
+    distinctKeys.insert(distinctKeys.end(), setMasks.begin(), setMasks.end());
+  }
+
+  // Null values of the aggregate inputs are kept for the aggregates to see.
+  // Rows with null grouping keys are dropped by the second aggregation if
+  // 'ignoreNullKeys' is set.
+  auto distinct = std::make_shared<AggregationNode>(
+      fmt::format("{}.distinct", node->id()),
+      Step::kSingle,
+      distinctKeys,
+      std::vector<FieldAccessTypedExprPtr>{},
+      std::vector<std::string>{},
+      std::vector<Aggregate>{},
+      false,
+      std::move(source));
+
+  std::vector<Aggregate> aggregates;
+  for (auto i = 0; i < node->aggregates().size(); ++i) {
+    auto aggregate = node->aggregates()[i];
+    aggregate.distinct = false;
+    if (!setMasks.empty()) {
+      aggregate.mask = setMasks[aggregateSets[i]];
+    }
+    aggregates.push_back(std::move(aggregate));
+  }
+  return std::make_shared<AggregationNode>(
+      node->id(),
+      Step::kSingle,
+      node->groupingKeys(),
+      std::vector<FieldAccessTypedExprPtr>{},
+      node->aggregateNames(),
+      aggregates,
+      node->ignoreNullKeys(),
+      std::move(distinct));
+}
+
 void AggregationNode::addDetails(std::stringstream& stream) const {
   stream << stepName(step_) << " ";
 
@@ -1093,8 +1241,52 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       outputType);
 }
 
+MergeJoinNode::MergeJoinNode(
+    const PlanNodeId& id,
+    JoinType joinType,
+    const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+    const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+    TypedExprPtr filter,
+    PlanNodePtr left,
+    PlanNodePtr right,
+    RowTypePtr outputType,
+    std::optional<Band> band)
+    : AbstractJoinNode(
+          id,
+          joinType,
+          leftKeys,
+          rightKeys,
+          std::move(filter),
+          std::move(left),
+          std::move(right),
+          std::move(outputType)),
+      band_(band) {
+  if (band_.has_value()) {
+    VELOX_USER_CHECK_LE(
+        band_->lower, band_->upper, "Merge join band is empty");
+    const auto kind = leftKeys_.back()->type()->kind();
+    VELOX_USER_CHECK(
+        kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+            kind == TypeKind::INTEGER || kind == TypeKind::BIGINT,
+        "Merge join band key must be an integer: {}",
+        leftKeys_.back()->type()->toString());
+  }
+}
+
+void MergeJoinNode::addDetails(std::stringstream& stream) const {
+  AbstractJoinNode::addDetails(stream);
+  if (band_.has_value()) {
+    stream << ", band: [" << band_->lower << ", " << band_->upper << "]";
+  }
+}
+
 folly::dynamic MergeJoinNode::serialize() const {
-  return serializeBase();
+  auto obj = serializeBase();
+  if (band_.has_value()) {
+    obj["bandLower"] = band_->lower;
+    obj["bandUpper"] = band_->upper;
+  }
+  return obj;
 }
 
 // static
@@ -1112,6 +1304,11 @@ PlanNodePtr MergeJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  std::optional<Band> band;
+  if (obj.count("bandLower")) {
+    band = Band{obj["bandLower"].asInt(), obj["bandUpper"].asInt()};
+  }
+
   return std::make_shared<MergeJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1120,7 +1317,8 @@ PlanNodePtr MergeJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      band);
 }
 
 NestedLoopJoinNode::NestedLoopJoinNode(
@@ -1988,6 +2186,36 @@ PartitionedOutputNode::Kind PartitionedOutputNode::stringToKind(
   }
 }
 
+// static
+std::string PartitionedOutputNode::skewHandlingString(
+    SkewHandling skewHandling) {
+  switch (skewHandling) {
+    case SkewHandling::kNone:
+      return "NONE";
+    case SkewHandling::kSpread:
+      return "SPREAD";
+    case SkewHandling::kReplicate:
+      return "REPLICATE";
+    default:
+      return fmt::format(
+          "INVALID SKEW HANDLING {}", static_cast<int>(skewHandling));
+  }
+}
+
+// static
+PartitionedOutputNode::SkewHandling PartitionedOutputNode::stringToSkewHandling(
+    const std::string& str) {
+  if (str == "NONE") {
+    return SkewHandling::kNone;
+  } else if (str == "SPREAD") {
+    return SkewHandling::kSpread;
+  } else if (str == "REPLICATE") {
+    return SkewHandling::kReplicate;
+  } else {
+    VELOX_FAIL("Unknown skew handling: {}", str);
+  }
+}
+
 void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
   if (kind_ == Kind::kBroadcast) {
     stream << "BROADCAST";
@@ -2007,6 +2235,13 @@ void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
   if (replicateNullsAndAny_) {
     stream << " replicate nulls and any";
   }
+
+  if (skewHandling_ != SkewHandling::kNone) {
+    stream << fmt::format(
+        " skew {} over {} partitions",
+        skewHandlingString(skewHandling_),
+        skewFanout_);
+  }
 }
 
 folly::dynamic PartitionedOutputNode::serialize() const {
@@ -2017,6 +2252,10 @@ folly::dynamic PartitionedOutputNode::serialize() const {
   obj["replicateNullsAndAny"] = replicateNullsAndAny_;
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
   obj["outputType"] = outputType_->serialize();
+  if (skewHandling_ != SkewHandling::kNone) {
+    obj["skewHandling"] = skewHandlingString(skewHandling_);
+    obj["skewFanout"] = skewFanout_;
+  }
   return obj;
 }
 
@@ -2033,7 +2272,11 @@ PlanNodePtr PartitionedOutputNode::create(
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"], context),
       deserializeRowType(obj["outputType"]),
-      deserializeSingleSource(obj, context));
+      deserializeSingleSource(obj, context),
+      obj.count("skewHandling")
+          ? stringToSkewHandling(obj["skewHandling"].asString())
+          : SkewHandling::kNone,
+      obj.count("skewFanout") ? obj["skewFanout"].asInt() : 1);
 }
 
 TopNNode::TopNNode(
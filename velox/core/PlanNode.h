@@ -613,6 +613,28 @@ class AggregationNode : public PlanNode {
 
   bool canSpill(const QueryConfig& queryConfig) const override;
 
+  /// Rewrites a single step aggregation where all aggregates are over
+  /// distinct inputs into a distinct aggregation on the grouping keys and the
+  /// aggregate inputs, followed by the same aggregates without the distinct
+  /// flag. The distinct values then live in the hash table of the first
+  /// aggregation, which can spill, instead of in a set per group and
+  /// aggregate. For example, 'count(distinct c1) GROUP BY c0' becomes
+  /// 'count(c1) GROUP BY c0' over 'GROUP BY c0, c1'.
+  ///
+  /// If the aggregates have different sets of inputs, an ExpandNode makes a
+  /// copy of each input row for each set. A copy has the inputs of its set and
+  /// nulls in place of the other inputs, plus a constant boolean column per
+  /// set that is true for its own set. These columns are grouping keys of the
+  /// distinct aggregation and masks of the aggregates over the set.
+  ///
+  /// The result keeps the id of 'node'. The new nodes get ids '<id>.distinct'
+  /// and '<id>.expand'. Returns 'node' unchanged if it is not a single step
+  /// aggregation, has pre-grouped keys or grouping sets, or has an
+  /// aggregate that is not distinct, is masked, sorts its inputs or has an
+  /// input that is not a column or a constant.
+  static PlanNodePtr rewriteDistinctAggregates(
+      const std::shared_ptr<const AggregationNode>& node);
+
   bool isFinal() const {
     return step_ == Step::kFinal;
   }
@@ -912,7 +934,7 @@ class GroupIdNode : public PlanNode {
     return aggregationInputs_;
   }
 
-  const std::string& groupIdName() {
+  const std::string& groupIdName() const {
     return groupIdName_;
   }
 
@@ -1201,6 +1223,27 @@ class PartitionedOutputNode : public PlanNode {
   static std::string kindString(Kind kind);
   static Kind stringToKind(std::string str);
 
+  /// Handling of partitioning keys with a large share of the rows. Used to
+  /// spread the probe side of a join with skewed keys over several
+  /// destinations while the build side is replicated to all of them.
+  enum class SkewHandling {
+    /// Each row goes to the partition chosen by the partition function.
+    kNone,
+    /// The rows of the keys PartitionedOutput finds to account for a large
+    /// share of its input are spread round-robin over 'skewFanout'
+    /// consecutive partitions starting at the partition of the key. The other
+    /// keys go to their partition.
+    kSpread,
+    /// Each row goes to 'skewFanout' consecutive partitions starting at its
+    /// partition. This makes all the rows of a key available to each
+    /// destination a kSpread input may send the key to. Only valid for joins
+    /// that do not produce unmatched rows of this side, since these would be
+    /// produced by each of the destinations.
+    kReplicate,
+  };
+  static std::string skewHandlingString(SkewHandling skewHandling);
+  static SkewHandling stringToSkewHandling(const std::string& str);
+
   PartitionedOutputNode(
       const PlanNodeId& id,
       Kind kind,
@@ -1209,7 +1252,9 @@ class PartitionedOutputNode : public PlanNode {
       bool replicateNullsAndAny,
       PartitionFunctionSpecPtr partitionFunctionSpec,
       RowTypePtr outputType,
-      PlanNodePtr source)
+      PlanNodePtr source,
+      SkewHandling skewHandling = SkewHandling::kNone,
+      int skewFanout = 1)
       : PlanNode(id),
         kind_(kind),
         sources_{{std::move(source)}},
@@ -1217,7 +1262,9 @@ class PartitionedOutputNode : public PlanNode {
         numPartitions_(numPartitions),
         replicateNullsAndAny_(replicateNullsAndAny),
         partitionFunctionSpec_(std::move(partitionFunctionSpec)),
-        outputType_(std::move(outputType)) {
+        outputType_(std::move(outputType)),
+        skewHandling_(skewHandling),
+        skewFanout_(skewFanout) {
     VELOX_USER_CHECK_GT(numPartitions, 0);
     if (numPartitions == 1) {
       VELOX_USER_CHECK(
@@ -1230,6 +1277,12 @@ class PartitionedOutputNode : public PlanNode {
           "{} partitioning doesn't allow for partitioning keys",
           kindString(kind_));
     }
+    if (skewHandling_ != SkewHandling::kNone) {
+      VELOX_USER_CHECK(
+          !keys_.empty(), "Skew handling requires partitioning keys");
+      VELOX_USER_CHECK_GT(skewFanout_, 1);
+      VELOX_USER_CHECK_LE(skewFanout_, numPartitions_);
+    }
   }
 
   static std::shared_ptr<PartitionedOutputNode> broadcast(
@@ -1329,6 +1382,16 @@ class PartitionedOutputNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  SkewHandling skewHandling() const {
+    return skewHandling_;
+  }
+
+  /// Returns the number of partitions the rows of a skewed key are spread or
+  /// replicated to. 1 if there is no skew handling.
+  int skewFanout() const {
+    return skewFanout_;
+  }
+
   std::string_view name() const override {
     return "PartitionedOutput";
   }
@@ -1347,6 +1410,8 @@ class PartitionedOutputNode : public PlanNode {
   const bool replicateNullsAndAny_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
   const RowTypePtr outputType_;
+  const SkewHandling skewHandling_;
+  const int skewFanout_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -1633,8 +1698,21 @@ class HashJoinNode : public AbstractJoinNode {
 /// sorted on the join keys. A separate pipeline that puts its output into
 /// exec::MergeJoinSource is produced for the right side when generating
 /// exec::Operators.
+///
+/// If 'band' is set, the last pair of join keys is matched on a range instead
+/// of on equality. A left row matches the right rows with the same values of
+/// the other keys where left key BETWEEN right key + band.lower AND right key
+/// + band.upper. The band key must be an integer and the inputs are still
+/// sorted on all the join keys.
 class MergeJoinNode : public AbstractJoinNode {
  public:
+  /// Inclusive bounds of the difference between the last left and right join
+  /// keys.
+  struct Band {
+    int64_t lower;
+    int64_t upper;
+  };
+
   MergeJoinNode(
       const PlanNodeId& id,
       JoinType joinType,
@@ -1643,24 +1721,25 @@ class MergeJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
-      : AbstractJoinNode(
-            id,
-            joinType,
-            leftKeys,
-            rightKeys,
-            std::move(filter),
-            std::move(left),
-            std::move(right),
-            std::move(outputType)) {}
+      RowTypePtr outputType,
+      std::optional<Band> band = std::nullopt);
 
   std::string_view name() const override {
     return "MergeJoin";
   }
 
+  const std::optional<Band>& band() const {
+    return band_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const std::optional<Band> band_;
 };
 
 /// Represents inner/outer nested loop joins. Translates to an
@@ -2274,6 +2353,10 @@ class MarkDistinctNode : public PlanNode {
     return outputType_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return !distinctKeys_.empty() && queryConfig.markDistinctSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "MarkDistinct";
   }
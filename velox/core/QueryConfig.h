@@ -101,11 +101,39 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to collect per-node expression statistics: CPU time, input and
+  /// output rows, input encodings, peeling and allocated bytes. Filter and
+  /// project operators report them as a tree in OperatorStats::exprProfiles.
+  /// False by default. Adds a memory pool stats lookup per node and batch.
+  static constexpr const char* kExprProfileEnabled =
+      "expression.profile_enabled";
+
+  /// Whether calls to functions flagged as expensive in their metadata may
+  /// cache results across batches by the value of their single non-constant
+  /// string argument. The cache of an expression is dropped if its hit rate
+  /// is low. False by default.
+  static constexpr const char* kExprResultCacheEnabled =
+      "expression.result_cache_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count instructions, cycles, cache misses and branch misses of
+  /// the addInput and getOutput calls of individual operators with hardware
+  /// performance counters. Adds two system calls per call. Ignored where
+  /// perf_event_open is not available. False by default.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
+  /// If true, Drivers estimate the number of distinct values in each column
+  /// of the input of the last operator of their pipeline with a HyperLogLog.
+  /// The estimates are reported to TaskListener::onPipelineFinished(). Costs
+  /// hashing every value that crosses a pipeline boundary.
+  static constexpr const char* kPipelineNdvSketchEnabled =
+      "pipeline_ndv_sketch_enabled";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -130,6 +158,26 @@ class QueryConfig {
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// If true, PartitionedOutput serializes dictionary and constant columns as
+  /// Presto DICTIONARY and RLE blocks with one dictionary per page, and
+  /// Exchange returns each page as a separate vector so that the encodings
+  /// survive deserialization.
+  static constexpr const char* kExchangePreserveEncodings =
+      "exchange.preserve_encodings";
+
+  /// If true and shuffle compression is enabled, PartitionedOutput decides for
+  /// each page of each destination whether to compress it. Pages are
+  /// compressed while the destination has pages queued, i.e. the network is
+  /// the bottleneck, or while compression costs less CPU per saved byte than
+  /// 'exchange.adaptive_compression_max_nanos_per_byte'.
+  static constexpr const char* kExchangeAdaptiveCompression =
+      "exchange.adaptive_compression";
+
+  /// The maximum CPU time in nanoseconds spent per byte saved by compression
+  /// for pages to be compressed when the consumer keeps up with the producer.
+  static constexpr const char* kExchangeAdaptiveCompressionMaxNanosPerByte =
+      "exchange.adaptive_compression_max_nanos_per_byte";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -142,6 +190,14 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of input rows after which an abandoned partial aggregation
+  /// aggregates again to sample whether the data has become reducible, e.g.
+  /// for clustered data. The partial aggregation is abandoned again by the
+  /// same rules as before. 0 means an abandoned partial aggregation stays
+  /// abandoned.
+  static constexpr const char* kAbandonPartialAggregationResampleRows =
+      "abandon_partial_aggregation_resample_rows";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -178,6 +234,12 @@ class QueryConfig {
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// If true, a global partial aggregation of count, min and max right after
+  /// a TableScan takes its results for a split from the file statistics when
+  /// the connector can give them exactly, instead of reading the rows.
+  static constexpr const char* kTableScanAggregationFromStatistics =
+      "table_scan_aggregation_from_statistics";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -198,6 +260,13 @@ class QueryConfig {
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
+  /// If true, the hash build loads the spilled partitions that fit in memory
+  /// back into the join table at the end of the build so only the partitions
+  /// left on disk are spilled on the probe side. Only applies if join spilling
+  /// is enabled.
+  static constexpr const char* kHybridJoinSpillEnabled =
+      "hybrid_join_spill_enabled";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
@@ -212,10 +281,20 @@ class QueryConfig {
   static constexpr const char* kRowNumberSpillEnabled =
       "row_number_spill_enabled";
 
+  /// If true, a broadcast output buffer over its size limit spills the pages
+  /// kept only for destinations that have not joined yet. Only applies if
+  /// "spill_enabled" flag is set and the task has a spill directory.
+  static constexpr const char* kBroadcastOutputBufferSpillEnabled =
+      "broadcast_output_buffer_spill_enabled";
+
   /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -244,6 +323,13 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// If positive and the spill compression codec is ZSTD, each spill writer
+  /// trains a ZSTD dictionary of up to this many bytes on the first rows it
+  /// writes and compresses its pages with it. Helps when the spill pages are
+  /// small. 0 disables the dictionary.
+  static constexpr const char* kSpillCompressionDictionaryBytes =
+      "spill_compression_dictionary_bytes";
+
   /// Specifies spill write buffer size in bytes. The spiller tries to buffer
   /// serialized spill data up to the specified size before write to storage
   /// underneath for io efficiency. If it is set to zero, then spill write
@@ -251,6 +337,34 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
+  /// If true, the spiller writes the serialized spill data to disk on the
+  /// spill executor while the next write buffer is being filled. At most one
+  /// write buffer per spill file is in flight. Only applies if the spill
+  /// executor is set.
+  static constexpr const char* kSpillAsyncWriteEnabled =
+      "spill_async_write_enabled";
+
+  /// If true and the process has an SSD cache, the spilled bytes of each task
+  /// are taken out of the SSD cache capacity while the task runs, evicting
+  /// cached entries if needed. The space is given back as spill files are
+  /// removed. This lets spill and the SSD cache share the same local devices
+  /// instead of statically partitioning them.
+  static constexpr const char* kSpillReserveSsdCacheSpace =
+      "spill_reserve_ssd_cache_space";
+
+  /// The memory budget in bytes to read ahead the spill files on the spill
+  /// executor when merging sorted spill runs. If it is zero, then the spill
+  /// files are read on demand.
+  static constexpr const char* kSpillReadPrefetchBytes =
+      "spill_read_prefetch_bytes";
+
+  /// The memory budget in bytes for the read buffers of the spill files merged
+  /// at a time by an order by. If the sorted spill runs need more, they are
+  /// first merged in multiple passes into fewer runs. If it is zero, then all
+  /// the runs are merged at once.
+  static constexpr const char* kSpillMergeMemoryBytes =
+      "spill_merge_memory_bytes";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -316,11 +430,97 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The max size in bytes of the bloom filter pushed down from the hash probe
+  /// into the probe side table scan for an integer join key with too many
+  /// distinct values for a range or value set filter. The bloom filter takes
+  /// about 2 bytes per build side row. 0 disables the bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// If true, the hash probe records the dynamic filters built from the join
+  /// keys in its task even if no upstream operator in the same pipeline can
+  /// accept them, so they can be exported to scans of other tasks. See
+  /// Task::exportedDynamicFilters().
+  static constexpr const char* kHashProbeExportDynamicFilters =
+      "hash_probe_export_dynamic_filters";
+
+  /// The max size in bytes of probe input that a HashProbe operator buffers
+  /// while the build side is still running, so that the probe side pipeline,
+  /// e.g. a scan, overlaps with the build instead of waiting for it. Not used
+  /// if the hash table can produce dynamic filters for upstream operators of
+  /// the probe. 0 disables the buffering.
+  static constexpr const char* kHashProbeEarlyInputMaxBytes =
+      "hash_probe_early_input_max_bytes";
+
+  /// The min number of rows of a hash join probe batch for probing in radix
+  /// partitions by position in the table. Applies to tables of at least twice
+  /// BaseHashTable::kDefaultRadixPartitionBytes. Each partition then probes a
+  /// cache sized region of the table. Larger batches, e.g. with a higher
+  /// preferred_output_batch_rows upstream, make the partitions fuller. 0
+  /// disables the partitioning.
+  static constexpr const char* kHashProbeRadixPartitionMinRows =
+      "hash_probe_radix_partition_min_rows";
+
+  /// If true, a hash join table whose keys map to normalized keys and that
+  /// has no duplicate keys also gets a compact open addressing table of the
+  /// keys and row pointers, which the probes use. A probe that misses then
+  /// takes one cache miss instead of two. Costs 32 bytes per build row.
+  static constexpr const char* kHashJoinCompactTableEnabled =
+      "hash_join_compact_table_enabled";
+
+  /// If > 0, the hash join build pipelines that read directly from a source,
+  /// e.g. a table scan, are started one at a time instead of all at task
+  /// start. When one finishes, further ones start while the query memory plus
+  /// the largest finished build pipeline's peak memory for each running build
+  /// stays under this percentage of the query's max memory capacity. Trades
+  /// some latency for less memory used at once and so for fewer spills. Not
+  /// used if join spilling is enabled, since a spillable build only finishes
+  /// after its probe.
+  static constexpr const char* kHashBuildAdmissionMemoryPct =
+      "hash_build_admission_memory_pct";
+
+  /// The min number of rows for OrderBy to sort the rows in memory in
+  /// parallel on the query executor. The rows are split into runs that are
+  /// sorted concurrently and then merged pairwise. 0 always sorts on the
+  /// driver thread.
+  static constexpr const char* kOrderByParallelSortMinRows =
+      "order_by_parallel_sort_min_rows";
+
+  /// The min average number of rows in the frames of a block of output rows
+  /// for an aggregate window function to compute the frames from a segment
+  /// tree of intermediate results instead of aggregating all rows of each
+  /// frame. Applies to the frames that are not computed incrementally, e.g.
+  /// ROWS BETWEEN 1000 PRECEDING AND CURRENT ROW. 0 disables the segment
+  /// tree.
+  static constexpr const char* kWindowSegmentTreeMinFrameSize =
+      "window_segment_tree_min_frame_size";
+
+  /// The min number of rows in an output block of the Window operator for
+  /// applying its window functions in parallel on the query executor, one
+  /// function per thread. Only applies if there is more than one window
+  /// function. 0 always applies the functions on the driver thread.
+  static constexpr const char* kWindowParallelApplyMinRows =
+      "window_parallel_apply_min_rows";
+
+  /// If true, TopN pushes the first sorting key of its Nth row down to the
+  /// table scan in the same pipeline as a dynamic filter, so that the scan
+  /// skips the splits, row groups and rows that cannot be in the top rows.
+  /// Used for integer and timestamp keys and ascending floating point keys.
+  static constexpr const char* kTopNDynamicFilterPushdownEnabled =
+      "topn_dynamic_filter_pushdown_enabled";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The number of bucket range partitions to rehash a final or single
+  /// aggregation hash table in parallel when it grows. The partitions are
+  /// inserted by the query executor threads. 0 or 1 disables the parallel
+  /// rehash.
+  static constexpr const char* kAggregationParallelBuildPartitions =
+      "aggregation_parallel_build_partitions";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -348,12 +548,41 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum number of bytes of splits preloading at the same time in a Task,
+  /// as given by ConnectorSplit::byteSize(). The limit is shared by all the
+  /// Drivers of a table scan. Set to 0 for no limit.
+  static constexpr const char* kMaxSplitPreloadBytes =
+      "max_split_preload_bytes";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// Comma separated increasing times in ms. Each time the total time the
+  /// Drivers of the query have run on thread passes one of these, its Drivers
+  /// are enqueued with a priority one lower. Executors with multiple
+  /// priorities thus run new queries ahead of long running ones. Hosts may
+  /// set different levels for different resource groups. Empty to enqueue
+  /// all Drivers with the same priority.
+  static constexpr const char* kDriverPriorityLevelsMs =
+      "driver_priority_levels_ms";
+
+  /// Max time in microseconds a Driver waits on thread for the future of a
+  /// blocked operator before it goes off thread. Short waits, e.g. for the
+  /// next exchange page or split, then skip the round trip through the
+  /// executor queue. The thread is not available to other Drivers while
+  /// waiting. If 0, only futures that are already ready are not waited for
+  /// off thread.
+  static constexpr const char* kDriverBlockedWaitUs = "driver_blocked_wait_us";
+
+  /// Number of the latest events kept per Driver for a timeline of its calls
+  /// to operators, time queued on the executor and time blocked, by reason.
+  /// Exported as Chrome trace JSON by Task::toChromeTrace(). 0 disables the
+  /// trace.
+  static constexpr const char* kDriverTraceCapacity = "driver_trace_capacity";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -377,6 +606,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int64_t abandonPartialAggregationResampleRows() const {
+    return get<int64_t>(kAbandonPartialAggregationResampleRows, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -395,6 +628,20 @@ class QueryConfig {
     return get<uint64_t>(kMaxSpillBytes, kDefault);
   }
 
+  /// Returns true if PartitionedOutput keeps dictionary and constant encodings
+  /// in the serialized pages and Exchange returns one vector per page.
+  bool exchangePreserveEncodings() const {
+    return get<bool>(kExchangePreserveEncodings, false);
+  }
+
+  bool exchangeAdaptiveCompression() const {
+    return get<bool>(kExchangeAdaptiveCompression, false);
+  }
+
+  double exchangeAdaptiveCompressionMaxNanosPerByte() const {
+    return get<double>(kExchangeAdaptiveCompressionMaxNanosPerByte, 10.0);
+  }
+
   /// Returns the maximum number of bytes to buffer in PartitionedOutput
   /// operator to avoid creating tiny SerializedPages.
   ///
@@ -448,6 +695,10 @@ class QueryConfig {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  bool tableScanAggregationFromStatistics() const {
+    return get<bool>(kTableScanAggregationFromStatistics, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -503,6 +754,16 @@ class QueryConfig {
     return get<bool>(kJoinSpillEnabled, true);
   }
 
+  bool hybridJoinSpillEnabled() const {
+    return get<bool>(kHybridJoinSpillEnabled, false);
+  }
+
+  /// Returns true if broadcast output buffers can spill. Must also check the
+  /// spillEnabled()!
+  bool broadcastOutputBufferSpillEnabled() const {
+    return get<bool>(kBroadcastOutputBufferSpillEnabled, false);
+  }
+
   /// Returns 'is orderby spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool orderBySpillEnabled() const {
@@ -533,6 +794,10 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -583,11 +848,31 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  uint32_t spillCompressionDictionaryBytes() const {
+    return get<uint32_t>(kSpillCompressionDictionaryBytes, 0);
+  }
+
   uint64_t spillWriteBufferSize() const {
     // The default write buffer size set to 1MB.
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
   }
 
+  bool spillAsyncWriteEnabled() const {
+    return get<bool>(kSpillAsyncWriteEnabled, false);
+  }
+
+  bool spillReserveSsdCacheSpace() const {
+    return get<bool>(kSpillReserveSsdCacheSpace, false);
+  }
+
+  uint64_t spillReadPrefetchBytes() const {
+    return get<uint64_t>(kSpillReadPrefetchBytes, 0);
+  }
+
+  uint64_t spillMergeMemoryBytes() const {
+    return get<uint64_t>(kSpillMergeMemoryBytes, 0);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -657,10 +942,26 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprProfileEnabled() const {
+    return get<bool>(kExprProfileEnabled, false);
+  }
+
+  bool exprResultCacheEnabled() const {
+    return get<bool>(kExprResultCacheEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
+  bool pipelineNdvSketchEnabled() const {
+    return get<bool>(kPipelineNdvSketchEnabled, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -674,10 +975,54 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  bool hashProbeExportDynamicFilters() const {
+    return get<bool>(kHashProbeExportDynamicFilters, false);
+  }
+
+  uint64_t hashProbeEarlyInputMaxBytes() const {
+    return get<uint64_t>(kHashProbeEarlyInputMaxBytes, 0);
+  }
+
+  int32_t hashProbeRadixPartitionMinRows() const {
+    return get<int32_t>(kHashProbeRadixPartitionMinRows, 0);
+  }
+
+  bool hashJoinCompactTableEnabled() const {
+    return get<bool>(kHashJoinCompactTableEnabled, false);
+  }
+
+  int32_t hashBuildAdmissionMemoryPct() const {
+    return get<int32_t>(kHashBuildAdmissionMemoryPct, 0);
+  }
+
+  uint64_t orderByParallelSortMinRows() const {
+    return get<uint64_t>(kOrderByParallelSortMinRows, 1'000'000);
+  }
+
+  uint64_t windowSegmentTreeMinFrameSize() const {
+    return get<uint64_t>(kWindowSegmentTreeMinFrameSize, 64);
+  }
+
+  int32_t windowParallelApplyMinRows() const {
+    return get<int32_t>(kWindowParallelApplyMinRows, 0);
+  }
+
+  bool topNDynamicFilterPushdownEnabled() const {
+    return get<bool>(kTopNDynamicFilterPushdownEnabled, false);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint8_t aggregationParallelBuildPartitions() const {
+    return get<uint8_t>(kAggregationParallelBuildPartitions, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -706,10 +1051,26 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  uint64_t maxSplitPreloadBytes() const {
+    return get<uint64_t>(kMaxSplitPreloadBytes, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint64_t driverBlockedWaitUs() const {
+    return get<uint64_t>(kDriverBlockedWaitUs, 0);
+  }
+
+  int32_t driverTraceCapacity() const {
+    return get<int32_t>(kDriverTraceCapacity, 0);
+  }
+
+  std::string driverPriorityLevelsMs() const {
+    return get<std::string>(kDriverPriorityLevelsMs, "1000,10000,60000");
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
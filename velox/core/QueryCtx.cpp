@@ -175,4 +175,21 @@ void QueryCtx::finishArbitration() {
     promise.setValue();
   }
 }
+
+void ExecCtx::resetScratch() {
+  if (scratchArena_.numRanges() == 0) {
+    return;
+  }
+  const auto reservedBytes = scratchArena_.allocatedBytes();
+  if (!exprEvalCacheEnabled_ || reservedBytes > kMaxRetainedScratchBytes) {
+    scratchArena_.clear();
+    return;
+  }
+  if (scratchArena_.numRanges() == 1) {
+    scratchArena_.setFirstFreeInRun(scratchArena_.rangeAt(0).data());
+    return;
+  }
+  scratchArena_.clear();
+  scratchArena_.newRun(reservedBytes);
+}
 } // namespace facebook::velox::core
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <folly/Executor.h>
+#include <folly/container/F14Map.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/AllocationPool.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
@@ -159,6 +161,18 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Adds 'ms' to the total time the Drivers of the query have run on thread.
+  void addExecTimeMs(uint64_t ms) {
+    execTimeMs_ += ms;
+  }
+
+  /// Returns the total time the Drivers of the query have run on thread. Used
+  /// to pick the priority of the Drivers, see
+  /// QueryConfig::kDriverPriorityLevelsMs.
+  uint64_t execTimeMs() const {
+    return execTimeMs_;
+  }
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -236,6 +250,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  std::atomic<uint64_t> execTimeMs_{0};
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
@@ -254,7 +269,8 @@ class ExecCtx {
             queryCtx->queryConfig().isExpressionEvaluationCacheEnabled()),
         vectorPool_(
             exprEvalCacheEnabled_ ? std::make_unique<VectorPool>(pool)
-                                  : nullptr) {}
+                                  : nullptr),
+        scratchArena_(pool) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -358,7 +374,63 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns 'bytes' of uninitialized memory aligned to 'alignment' from a
+  /// bump-pointer arena. The memory stays valid until the outermost
+  /// ExprSet::eval() on 'this' returns, at which point the whole arena is
+  /// released at once. Meant for scratch that does not escape the evaluation
+  /// of one batch, e.g. per-row offsets computed and consumed by a function.
+  /// Must not back a Buffer that can be referenced by a result vector.
+  char* allocateScratch(uint64_t bytes, int32_t alignment = 1) {
+    return scratchArena_.allocateFixed(bytes, alignment);
+  }
+
+  /// Returns the bytes reserved by the scratch arena, including the memory
+  /// retained across evaluations.
+  int64_t scratchReservedBytes() const {
+    return scratchArena_.allocatedBytes();
+  }
+
+  /// Called by ExprSet::eval() on entry. Calls can nest.
+  void enterEval() {
+    ++evalDepth_;
+  }
+
+  /// Called by ExprSet::eval() on exit. Releases all the scratch memory and
+  /// the batch function state when the outermost evaluation returns.
+  void leaveEval() {
+    VELOX_CHECK_GT(evalDepth_, 0);
+    if (--evalDepth_ == 0) {
+      resetScratch();
+      batchFunctionState_.clear();
+    }
+  }
+
+  /// Returns the slot for state shared by all functions evaluated on this
+  /// thread under 'key', e.g. the address of a static of the function. The
+  /// state lives as long as 'this'.
+  std::shared_ptr<void>& functionState(const void* key) {
+    return functionState_[key];
+  }
+
+  /// Returns the slot for state shared by the functions evaluated over the
+  /// current batch under 'key', e.g. an input vector, so that several
+  /// expressions over the same input can share work. The slots are cleared
+  /// when the outermost ExprSet::eval() returns, so the state may refer to
+  /// the vectors of the batch. Returns nullptr outside of ExprSet::eval().
+  std::shared_ptr<void>* batchFunctionState(const void* key) {
+    return evalDepth_ > 0 ? &batchFunctionState_[key] : nullptr;
+  }
+
  private:
+  // Keeps up to this many bytes of scratch memory across evaluations so that
+  // steady state batches do not allocate from 'pool_'.
+  static constexpr int64_t kMaxRetainedScratchBytes = 256 << 10;
+
+  // Rewinds 'scratchArena_'. If the last evaluation spilled over into several
+  // runs, frees them and preallocates a single run large enough for the next
+  // one.
+  void resetScratch();
+
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
   QueryCtx* const queryCtx_;
@@ -370,6 +442,13 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  // Backs allocateScratch().
+  memory::AllocationPool scratchArena_;
+  // Number of ExprSet::eval() calls in progress on this thread.
+  int32_t evalDepth_{0};
+  // Backs functionState() and batchFunctionState().
+  folly::F14FastMap<const void*, std::shared_ptr<void>> functionState_;
+  folly::F14FastMap<const void*, std::shared_ptr<void>> batchFunctionState_;
 };
 
 } // namespace facebook::velox::core
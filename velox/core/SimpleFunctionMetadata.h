@@ -42,6 +42,14 @@ struct udf_is_deterministic<
     util::detail::void_t<decltype(T::is_deterministic)>>
     : std::integral_constant<bool, T::is_deterministic> {};
 
+// Most UDFs are cheap enough that caching their results does not pay off.
+template <class T, class = void>
+struct udf_is_expensive : std::false_type {};
+
+template <class T>
+struct udf_is_expensive<T, util::detail::void_t<decltype(T::is_expensive)>>
+    : std::integral_constant<bool, T::is_expensive> {};
+
 // Most functions are producing ASCII results for ASCII inputs, but we assume
 // they are not unless specified explicitly.
 template <class T, class = void>
@@ -387,6 +395,7 @@ class ISimpleFunctionMetadata {
   virtual std::string getName() const = 0;
   virtual bool isDeterministic() const = 0;
   virtual bool defaultNullBehavior() const = 0;
+  virtual bool isExpensive() const = 0;
   virtual uint32_t priority() const = 0;
   virtual const std::shared_ptr<exec::FunctionSignature> signature() const = 0;
   virtual const TypePtr& resultPhysicalType() const = 0;
@@ -462,6 +471,10 @@ class SimpleFunctionMetadata : public ISimpleFunctionMetadata {
     return defaultNullBehavior_;
   }
 
+  bool isExpensive() const final {
+    return udf_is_expensive<Fun>();
+  }
+
   static constexpr bool isVariadic() {
     if constexpr (num_args == 0) {
       return false;
@@ -16,6 +16,8 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -187,6 +189,8 @@ void CacheInputStream::loadSync(Region region) {
   // hit.
   ioStats_->incRawBytesRead(hitSize);
   prefetchStarted_ = false;
+  const int32_t readPct =
+      tracker_ && !trackingId_.empty() ? tracker_->readPct(trackingId_) : 100;
   do {
     folly::SemiFuture<bool> wait(false);
     cache::RawFileCacheKey key{fileNum_, region.offset};
@@ -194,7 +198,7 @@ void CacheInputStream::loadSync(Region region) {
       pin_.checkedEntry()->makeEvictable();
     }
     pin_.clear();
-    pin_ = cache_->findOrCreate(key, region.length, &wait);
+    pin_ = cache_->findOrCreate(key, region.length, &wait, readPct);
     if (pin_.empty()) {
       VELOX_CHECK(wait.valid());
       auto& exec = folly::QueuedImmediateExecutor::instance();
@@ -203,6 +207,7 @@ void CacheInputStream::loadSync(Region region) {
         MicrosecondTimer timer(&usec);
         std::move(wait).via(&exec).wait();
       }
+      RECORD_HISTOGRAM_METRIC_VALUE(kMetricMemoryCacheWaitLatencyUs, usec);
       ioStats_->queryThreadIoLatency().increment(usec);
       continue;
     }
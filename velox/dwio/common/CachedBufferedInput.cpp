@@ -180,12 +180,22 @@ void CachedBufferedInput::load(const LogType) {
           request.trackingId.id() == StreamIdentifier::sequentialFile().id_;
       if (!prefetchAnyway && tracker_) {
         trackingData = tracker_->trackingData(request.trackingId);
+        auto* groupStats = tracker_->fileGroupStats();
+        if (trackingData.numReferences < 2 && groupStats) {
+          // The scan has not read the stream yet. Predict from the earlier
+          // scans of the file group, so that the first splits prefetch too.
+          trackingData =
+              groupStats->trackingData(groupId_, request.trackingId);
+        }
       }
-      if (prefetchAnyway || adjustedReadPct(trackingData) >= readPct) {
+      const auto requestReadPct =
+          prefetchAnyway ? 100 : adjustedReadPct(trackingData);
+      if (prefetchAnyway || requestReadPct >= readPct) {
         request.processed = true;
         auto parts = makeRequestParts(
             request, trackingData, options_.loadQuantum(), extraRequests);
         for (auto part : parts) {
+          part->readPct = requestReadPct;
           if (cache_->exists(part->key)) {
             continue;
           }
@@ -396,7 +406,8 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             pin.checkedEntry()->setPrefetch(true);
           }
           pins.push_back(std::move(pin));
-        });
+        },
+        [&](int32_t index) { return requests_[index].readPct; });
     if (pins.empty()) {
       return pins;
     }
@@ -442,7 +453,8 @@ class SsdLoad : public DwioCoalescedLoadBase {
           }
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
-        });
+        },
+        [&](int32_t index) { return requests_[index].readPct; });
     if (pins.empty()) {
       return pins;
     }
@@ -41,6 +41,9 @@ struct CacheRequest {
   cache::RawFileCacheKey key;
   uint64_t size;
   cache::TrackingId trackingId;
+  // Percentage of references to the stream that are read. Used for cache
+  // admission of the loaded entries.
+  int32_t readPct{100};
   cache::CachePin pin;
   cache::SsdPin ssdPin;
 
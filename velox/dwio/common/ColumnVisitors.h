@@ -706,6 +706,56 @@ inline xsimd::batch<int64_t> cvtU32toI64(simd::Batch64<int32_t> values) {
 
 } // namespace detail
 
+/// Sets the filter cache of a dictionary scan to the result of 'filter' for
+/// each entry of 'dictionary', so that DictionaryColumnVisitor and
+/// StringDictionaryColumnVisitor select rows by gathering from the cache
+/// without evaluating the filter for entries they have not seen yet. 'T' is
+/// the data type of the visitor. Numeric entries, and the sizes and prefixes
+/// of string entries, are tested a SIMD batch at a time. This pays off when
+/// most entries occur in the scanned rows, as for a Parquet column chunk,
+/// whose dictionary holds only values that occur in the chunk. The contract
+/// for readers is to call this after setting up the dictionary and its cache
+/// and before visiting rows. Calling it is optional, entries left at kUnknown
+/// are filled in on first use.
+template <typename T, typename TFilter>
+void fillFilterCache(
+    const TFilter& filter,
+    const RawDictionaryState& dictionary,
+    uint8_t* filterCache) {
+  const auto numValues = dictionary.numValues;
+  auto setResult = [&](int32_t index, bool passed) {
+    filterCache[index] =
+        passed ? FilterResult::kSuccess : FilterResult::kFailure;
+  };
+  if constexpr (std::is_same_v<T, folly::StringPiece>) {
+    auto* values = reinterpret_cast<const StringView*>(dictionary.values);
+    std::vector<uint64_t> passed(bits::nwords(numValues));
+    filter.testStringViews(values, numValues, passed.data());
+    for (auto i = 0; i < numValues; ++i) {
+      setResult(i, bits::isBitSet(passed.data(), i));
+    }
+  } else {
+    auto* values = reinterpret_cast<const T*>(dictionary.values);
+    int32_t i = 0;
+    if constexpr (
+        std::is_same_v<T, int64_t> || std::is_same_v<T, int32_t> ||
+        std::is_same_v<T, int16_t> || std::is_same_v<T, double> ||
+        std::is_same_v<T, float>) {
+      constexpr int32_t kWidth = xsimd::batch<T>::size;
+      for (; i + kWidth <= numValues; i += kWidth) {
+        const auto passed = simd::toBitMask(
+            filter.testValues(xsimd::batch<T>::load_unaligned(values + i)));
+        for (auto j = 0; j < kWidth; ++j) {
+          setResult(i + j, passed & (1 << j));
+        }
+      }
+    }
+    for (; i < numValues; ++i) {
+      setResult(i, velox::common::applyFilter(filter, values[i]));
+    }
+  }
+}
+
 template <typename T, typename TFilter, typename ExtractValues, bool isDense>
 class DictionaryColumnVisitor
     : public ColumnVisitor<T, TFilter, ExtractValues, isDense> {
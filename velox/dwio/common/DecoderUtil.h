@@ -42,6 +42,28 @@ inline int32_t firstNullIndex(const uint64_t* nulls, int32_t numRows) {
   return first;
 }
 
+/// Replaces each of the 'size' elements of 'values' with 'base' plus the sum
+/// of the elements up to and including it. Sums wrap around on overflow. The
+/// sums are formed 4 elements at a time so that the running sum is a chain of
+/// one add per 4 elements instead of one per element.
+inline void prefixSum(uint64_t* values, int32_t size, uint64_t base) {
+  int32_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto sum1 = values[i] + values[i + 1];
+    const auto sum2 = sum1 + values[i + 2];
+    const auto sum3 = sum2 + values[i + 3];
+    values[i] += base;
+    values[i + 1] = base + sum1;
+    values[i + 2] = base + sum2;
+    values[i + 3] = base + sum3;
+    base += sum3;
+  }
+  for (; i < size; ++i) {
+    base += values[i];
+    values[i] = base;
+  }
+}
+
 template <typename T, typename Any>
 void scatterDense(
     const Any* data,
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::dwio::common {
+
+std::unique_ptr<FileMetadataCache> FileMetadataCache::instance_;
+
+std::string FileMetadataCacheStats::toString() const {
+  return fmt::format(
+      "File metadata cache: {} entries {} bytes {} lookups {} hits "
+      "{} evictions",
+      numEntries,
+      bytes,
+      numLookups,
+      numHits,
+      numEvictions);
+}
+
+FileMetadataCache::FileMetadataCache(uint64_t maxBytes) : maxBytes_(maxBytes) {
+  VELOX_CHECK_GT(maxBytes_, 0);
+}
+
+// static
+FileMetadataCache* FileMetadataCache::create(uint64_t maxBytes) {
+  if (instance_ == nullptr) {
+    instance_ = std::make_unique<FileMetadataCache>(maxBytes);
+  }
+  return instance_.get();
+}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return instance_.get();
+}
+
+size_t FileMetadataCache::KeyHasher::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      folly::hash::fnv64(key.path),
+      key.fileSize,
+      key.modificationTime,
+      static_cast<int32_t>(key.format));
+}
+
+std::shared_ptr<const void> FileMetadataCache::getInternal(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numLookups;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::put(
+    const Key& key,
+    std::shared_ptr<const void> metadata,
+    uint64_t bytes) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  if (bytes > maxBytes_ / 4) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    stats_.bytes -= it->second->bytes;
+    lru_.erase(it->second);
+    entries_.erase(it);
+  }
+  evictLocked(bytes);
+  lru_.push_front({key, std::move(metadata), bytes});
+  entries_[key] = lru_.begin();
+  stats_.bytes += bytes;
+}
+
+void FileMetadataCache::evictLocked(uint64_t bytes) {
+  while (!lru_.empty() && stats_.bytes + bytes > maxBytes_) {
+    auto& oldest = lru_.back();
+    stats_.bytes -= oldest.bytes;
+    entries_.erase(oldest.key);
+    lru_.pop_back();
+    ++stats_.numEvictions;
+  }
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  stats_.bytes = 0;
+}
+
+FileMetadataCacheStats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+struct FileMetadataCacheStats {
+  uint64_t numEntries{0};
+  // Sum of the encoded sizes of the cached footers.
+  uint64_t bytes{0};
+  uint64_t numLookups{0};
+  uint64_t numHits{0};
+  uint64_t numEvictions{0};
+
+  std::string toString() const;
+};
+
+/// A process-wide cache of parsed file footers, e.g. the DWRF postscript and
+/// footer or the Parquet FileMetaData, so that the splits of the same file in
+/// different queries do not read and parse the footer again. The entries are
+/// immutable and shared by the readers. The budget is in encoded footer bytes
+/// since these are known before parsing. Least recently used entries are
+/// evicted first. Thread safe.
+class FileMetadataCache {
+ public:
+  struct Key {
+    FileFormat format;
+    std::string path;
+    uint64_t fileSize;
+    /// 0 if not known. A rewritten file of the same size is only told apart
+    /// by this.
+    int64_t modificationTime;
+
+    bool operator==(const Key& other) const {
+      return format == other.format && fileSize == other.fileSize &&
+          modificationTime == other.modificationTime && path == other.path;
+    }
+  };
+
+  explicit FileMetadataCache(uint64_t maxBytes);
+
+  /// Creates the process-wide instance with a budget of 'maxBytes'. Returns
+  /// the existing one if already created.
+  static FileMetadataCache* create(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if not created.
+  static FileMetadataCache* getInstance();
+
+  /// Returns the metadata for 'key' or nullptr. T must be the type given to
+  /// put() for 'key.format'.
+  template <typename T>
+  std::shared_ptr<const T> get(const Key& key) {
+    return std::static_pointer_cast<const T>(getInternal(key));
+  }
+
+  /// Adds 'metadata' of 'bytes' encoded bytes for 'key', replacing a previous
+  /// entry. Evicts older entries to stay within the budget. Does nothing if
+  /// 'bytes' alone exceeds a quarter of the budget.
+  void
+  put(const Key& key, std::shared_ptr<const void> metadata, uint64_t bytes);
+
+  void clear();
+
+  FileMetadataCacheStats stats() const;
+
+ private:
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const void> metadata;
+    uint64_t bytes;
+  };
+
+  std::shared_ptr<const void> getInternal(const Key& key);
+
+  void evictLocked(uint64_t bytes);
+
+  static std::unique_ptr<FileMetadataCache> instance_;
+
+  const uint64_t maxBytes_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<Key, std::list<Entry>::iterator, KeyHasher> entries_;
+  FileMetadataCacheStats stats_;
+};
+
+} // namespace facebook::velox::dwio::common
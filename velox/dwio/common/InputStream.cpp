@@ -32,6 +32,8 @@
 #include <string_view>
 #include <type_traits>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -83,9 +85,11 @@ void ReadFileInputStream::read(
   logRead(offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
   std::string_view data_read = readFile_->pread(offset, length, buf);
+  const auto readMicros = getCurrentTimeMicro() - readStartMicros;
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricStorageReadLatencyUs, readMicros);
   if (stats_) {
     stats_->incRawBytesRead(length);
-    stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    stats_->incTotalScanTime(readMicros * 1000);
   }
 
   DWIO_ENSURE_EQ(
@@ -107,7 +111,10 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
+  const auto readStartMicros = getCurrentTimeMicro();
   auto size = readFile_->preadv(offset, buffers);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricStorageReadLatencyUs, getCurrentTimeMicro() - readStartMicros);
   DWIO_ENSURE_EQ(
       size,
       bufferSize,
@@ -147,9 +154,11 @@ void ReadFileInputStream::vread(
   logRead(regions[0].offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
   readFile_->preadv(regions, iobufs);
+  const auto readMicros = getCurrentTimeMicro() - readStartMicros;
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricStorageReadLatencyUs, readMicros);
   if (stats_) {
     stats_->incRawBytesRead(length);
-    stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    stats_->incTotalScanTime(readMicros * 1000);
   }
 }
 
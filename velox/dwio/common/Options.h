@@ -414,6 +414,8 @@ class RowReaderOptions {
   }
 };
 
+class FileMetadataCache;
+
 /**
  * Options for creating a Reader.
  */
@@ -428,8 +430,12 @@ class ReaderOptions : public io::ReaderOptions {
   uint64_t filePreloadThreshold{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase{false};
   bool useColumnNamesForColumnMapping_{false};
+  bool readBloomFilters_{true};
+  bool lazyColumns_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
+  FileMetadataCache* fileMetadataCache_{nullptr};
+  int64_t fileModificationTime_{0};
 
  public:
   static constexpr uint64_t kDefaultFooterEstimatedSize = 1024 * 1024; // 1MB
@@ -457,6 +463,10 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    readBloomFilters_ = other.readBloomFilters_;
+    lazyColumns_ = other.lazyColumns_;
+    fileMetadataCache_ = other.fileMetadataCache_;
+    fileModificationTime_ = other.fileModificationTime_;
     return *this;
   }
 
@@ -470,8 +480,11 @@ class ReaderOptions : public io::ReaderOptions {
         footerEstimatedSize(other.footerEstimatedSize),
         filePreloadThreshold(other.filePreloadThreshold),
         fileColumnNamesReadAsLowerCase(other.fileColumnNamesReadAsLowerCase),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        readBloomFilters_(other.readBloomFilters_),
+        lazyColumns_(other.lazyColumns_),
+        fileMetadataCache_(other.fileMetadataCache_),
+        fileModificationTime_(other.fileModificationTime_) {}
 
   /**
    * Set the format of the file, such as "rc" or "dwrf".  The
@@ -535,6 +548,35 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets whether the bloom filters of filtered columns are read to skip row
+  /// groups. Applies to formats that have bloom filters.
+  ReaderOptions& setReadBloomFilters(bool flag) {
+    readBloomFilters_ = flag;
+    return *this;
+  }
+
+  /// Sets whether the projected top level columns without filters are
+  /// returned as LazyVectors, which decode only the rows that the consumer
+  /// loads. Applies to Parquet. DWRF always returns such LazyVectors.
+  ReaderOptions& setLazyColumns(bool flag) {
+    lazyColumns_ = flag;
+    return *this;
+  }
+
+  /// Sets the cache of parsed footers shared with other readers. nullptr
+  /// reads the footer from the file.
+  ReaderOptions& setFileMetadataCache(FileMetadataCache* cache) {
+    fileMetadataCache_ = cache;
+    return *this;
+  }
+
+  /// Sets the modification time of the file, which tells cached footers of
+  /// a rewritten file apart. 0 if not known.
+  ReaderOptions& setFileModificationTime(int64_t time) {
+    fileModificationTime_ = time;
+    return *this;
+  }
+
   ReaderOptions& setIOExecutor(std::shared_ptr<folly::Executor> executor) {
     ioExecutor_ = std::move(executor);
     return *this;
@@ -595,6 +637,22 @@ class ReaderOptions : public io::ReaderOptions {
     return useColumnNamesForColumnMapping_;
   }
 
+  bool readBloomFilters() const {
+    return readBloomFilters_;
+  }
+
+  bool lazyColumns() const {
+    return lazyColumns_;
+  }
+
+  FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_;
+  }
+
+  int64_t fileModificationTime() const {
+    return fileModificationTime_;
+  }
+
   const std::shared_ptr<random::RandomSkipTracker>& randomSkip() const {
     return randomSkip_;
   }
@@ -614,8 +672,13 @@ struct WriterOptions {
   std::optional<uint64_t> maxStripeSize{std::nullopt};
   std::optional<bool> orcLinearStripeSizeHeuristics{std::nullopt};
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
+  /// If set, the columns of a stripe are flushed on up to 'flushParallelism'
+  /// threads of 'flushExecutor'.
+  folly::Executor* flushExecutor{nullptr};
+  size_t flushParallelism{0};
   std::map<std::string, std::string> serdeParameters;
   std::optional<uint8_t> parquetWriteTimestampUnit;
+  std::optional<bool> parquetEnablePageIndex;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ParallelRowReader.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::dwio::common {
+
+ParallelRowReader::ParallelRowReader(
+    std::shared_ptr<velox::common::ScanSpec> scanSpec,
+    uint64_t offset,
+    uint64_t length,
+    int32_t numRanges,
+    RangeReaderFactory factory,
+    Options options)
+    : scanSpec_(std::move(scanSpec)),
+      factory_(std::move(factory)),
+      options_(options) {
+  VELOX_CHECK_NOT_NULL(options_.executor);
+  VELOX_CHECK_GT(options_.parallelism, 0);
+  VELOX_CHECK_GT(numRanges, 0);
+  const auto rangeSize = bits::divRoundUp(length, numRanges);
+  for (uint64_t rangeOffset = offset; rangeOffset < offset + length;
+       rangeOffset += rangeSize) {
+    auto& range = ranges_.emplace_back();
+    range.offset = rangeOffset;
+    range.length = std::min(rangeSize, offset + length - rangeOffset);
+    range.scanSpec = scanSpec_->clone();
+  }
+}
+
+ParallelRowReader::~ParallelRowReader() {
+  std::unique_lock<std::mutex> l(mutex_);
+  stopLocked(l);
+}
+
+uint64_t ParallelRowReader::next(
+    uint64_t size,
+    velox::VectorPtr& result,
+    const Mutation* mutation) {
+  VELOX_CHECK_NULL(mutation, "ParallelRowReader does not support mutations");
+  batchSize_ = size;
+  std::unique_lock<std::mutex> l(mutex_);
+  for (;;) {
+    if (current_ == ranges_.size()) {
+      return 0;
+    }
+    auto& range = ranges_[current_];
+    if (!range.batches.empty()) {
+      auto batch = std::move(range.batches.front());
+      range.batches.pop_front();
+      bufferedBytes_ -= batch.bytes;
+      range.numReturned += batch.numScanned;
+      scheduleLocked();
+      result = std::move(batch.rows);
+      return batch.numScanned;
+    }
+    if (range.error) {
+      std::rethrow_exception(range.error);
+    }
+    if (range.atEnd) {
+      ++current_;
+      continue;
+    }
+    scheduleLocked();
+    cv_.wait(l);
+  }
+}
+
+void ParallelRowReader::updateRuntimeStats(RuntimeStatistics& stats) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  stats.skippedSplits += stats_.skippedSplits;
+  stats.skippedSplitBytes += stats_.skippedSplitBytes;
+  stats.skippedStrides += stats_.skippedStrides;
+  stats.skippedStripes += stats_.skippedStripes;
+  auto& columnStats = stats.columnReaderStatistics;
+  columnStats.flattenStringDictionaryValues +=
+      stats_.columnReaderStatistics.flattenStringDictionaryValues;
+  columnStats.skippedPages += stats_.columnReaderStatistics.skippedPages;
+  columnStats.skippedStridesByBloomFilter +=
+      stats_.columnReaderStatistics.skippedStridesByBloomFilter;
+}
+
+std::optional<size_t> ParallelRowReader::estimatedRowSize() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return estimatedRowSize_;
+}
+
+void ParallelRowReader::resetFilterCaches() {
+  std::unique_lock<std::mutex> l(mutex_);
+  stopLocked(l);
+  stopping_ = false;
+  // The batches decoded with the old filters may contain rows that the new
+  // filters drop, which is wrong if the filter replaces a join.
+  for (auto i = current_; i < ranges_.size(); ++i) {
+    auto& range = ranges_[i];
+    if (range.error) {
+      continue;
+    }
+    for (auto& batch : range.batches) {
+      bufferedBytes_ -= batch.bytes;
+    }
+    range.batches.clear();
+    releaseReaderLocked(range);
+    range.numToSkip = range.numReturned;
+    range.atEnd = false;
+    range.scanSpec = scanSpec_->clone();
+  }
+}
+
+void ParallelRowReader::scheduleLocked() {
+  for (auto i = current_;
+       i < ranges_.size() && numRunning_ < options_.parallelism;
+       ++i) {
+    auto& range = ranges_[i];
+    if (range.running || range.atEnd || range.error) {
+      continue;
+    }
+    if (shouldPauseLocked(i)) {
+      break;
+    }
+    range.running = true;
+    ++numRunning_;
+    options_.executor->add([this, i]() { decode(i); });
+  }
+}
+
+bool ParallelRowReader::shouldPauseLocked(size_t index) const {
+  if (stopping_) {
+    return true;
+  }
+  // The range being consumed decodes a batch ahead regardless of the limit
+  // so that next() cannot wait for a range that does not decode.
+  const auto& current = ranges_[current_];
+  if (index == current_) {
+    if (current.batches.empty()) {
+      return false;
+    }
+  } else if (
+      !current.running && !current.atEnd && !current.error &&
+      current.batches.empty()) {
+    // Gives the slot to the range being consumed.
+    return true;
+  }
+  return bufferedBytes_ >= options_.maxBufferedBytes;
+}
+
+void ParallelRowReader::stopLocked(std::unique_lock<std::mutex>& lock) {
+  stopping_ = true;
+  cv_.wait(lock, [&]() { return numRunning_ == 0; });
+}
+
+void ParallelRowReader::releaseReaderLocked(Range& range) {
+  if (range.reader) {
+    range.reader->updateRuntimeStats(stats_);
+    range.reader.reset();
+  }
+}
+
+void ParallelRowReader::decode(size_t index) {
+  auto& range = ranges_[index];
+  auto finish = [&]() {
+    range.running = false;
+    --numRunning_;
+    scheduleLocked();
+    // Notify under the mutex since the destructor may run right after.
+    cv_.notify_all();
+  };
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      if (shouldPauseLocked(index)) {
+        finish();
+        return;
+      }
+    }
+    VectorPtr rows;
+    uint64_t numScanned = 0;
+    std::exception_ptr error;
+    try {
+      if (!range.reader) {
+        range.reader = factory_(range.offset, range.length, range.scanSpec);
+        const auto rowSize = range.reader->estimatedRowSize();
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!estimatedRowSize_.has_value()) {
+          estimatedRowSize_ = rowSize;
+        }
+      }
+      while (range.numToSkip > 0) {
+        const auto numSkipped = range.reader->next(
+            std::min<uint64_t>(range.numToSkip, batchSize_), rows);
+        VELOX_CHECK_GT(numSkipped, 0, "Range ends before the skipped rows");
+        range.numToSkip -= numSkipped;
+      }
+      numScanned = range.reader->next(batchSize_, rows);
+      if (numScanned > 0) {
+        rows->loadedVector();
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::unique_lock<std::mutex> l(mutex_);
+    if (error) {
+      range.error = error;
+      finish();
+      return;
+    }
+    if (numScanned == 0) {
+      range.atEnd = true;
+      releaseReaderLocked(range);
+      finish();
+      return;
+    }
+    const auto bytes = rows->retainedSize();
+    range.batches.push_back({numScanned, std::move(rows), bytes});
+    bufferedBytes_ += bytes;
+    cv_.notify_all();
+  }
+}
+
+} // namespace facebook::velox::dwio::common
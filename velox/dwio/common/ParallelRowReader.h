@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ScanSpec.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Decodes the stripes or row groups of a single split on several threads
+/// and returns the rows in file order. The split is cut into byte ranges of
+/// equal size and each range is read by its own RowReader over the stripes
+/// or row groups that start in the range. Each range reader gets a private
+/// copy of the ScanSpec since a reader adapts its ScanSpec while reading.
+///
+/// The ranges are decoded on a shared executor ahead of the consumer, at
+/// most 'parallelism' at a time. The decoded batches are fully loaded so
+/// that they do not depend on the position of their reader. Ranges other
+/// than the one being consumed stop decoding while the batches not yet
+/// returned take 'maxBufferedBytes' or more.
+///
+/// Mutations are not supported. After a filter change notified with
+/// resetFilterCaches(), the batches not yet returned are dropped and the
+/// remaining ranges are read again with a new copy of the ScanSpec,
+/// skipping the rows already returned from the current range.
+class ParallelRowReader : public RowReader {
+ public:
+  /// Makes the reader of the stripes or row groups that start in ['offset',
+  /// 'offset' + 'length') with 'scanSpec'. Called on the executor threads.
+  using RangeReaderFactory = std::function<std::unique_ptr<RowReader>(
+      uint64_t offset,
+      uint64_t length,
+      const std::shared_ptr<velox::common::ScanSpec>& scanSpec)>;
+
+  struct Options {
+    folly::Executor* executor{nullptr};
+    // Maximum number of ranges decoded at the same time.
+    int32_t parallelism{2};
+    // Bytes of decoded batches after which the ranges ahead of the consumer
+    // stop decoding.
+    uint64_t maxBufferedBytes{128 << 20};
+  };
+
+  /// Reads ['offset', 'offset' + 'length') of a file in 'numRanges' ranges.
+  /// 'scanSpec' is the ScanSpec of the scan. It is copied for the range
+  /// readers here and in resetFilterCaches() and is not otherwise accessed.
+  ParallelRowReader(
+      std::shared_ptr<velox::common::ScanSpec> scanSpec,
+      uint64_t offset,
+      uint64_t length,
+      int32_t numRanges,
+      RangeReaderFactory factory,
+      Options options);
+
+  ~ParallelRowReader() override;
+
+  uint64_t next(
+      uint64_t size,
+      velox::VectorPtr& result,
+      const Mutation* mutation = nullptr) override;
+
+  int64_t nextRowNumber() override {
+    VELOX_UNSUPPORTED("ParallelRowReader does not support nextRowNumber");
+  }
+
+  int64_t nextReadSize(uint64_t /*size*/) override {
+    VELOX_UNSUPPORTED("ParallelRowReader does not support nextReadSize");
+  }
+
+  /// Adds the statistics of the range readers that are finished or
+  /// restarted.
+  void updateRuntimeStats(RuntimeStatistics& stats) const override;
+
+  void resetFilterCaches() override;
+
+  /// Returns the estimate of the first range reader made, std::nullopt
+  /// before that.
+  std::optional<size_t> estimatedRowSize() const override;
+
+ private:
+  struct Batch {
+    // Rows scanned in the file for 'rows'.
+    uint64_t numScanned;
+    VectorPtr rows;
+    uint64_t bytes;
+  };
+
+  struct Range {
+    uint64_t offset;
+    uint64_t length;
+    std::shared_ptr<velox::common::ScanSpec> scanSpec;
+    // Accessed only by the decode task of 'this' while 'running' is true.
+    std::unique_ptr<RowReader> reader;
+    std::deque<Batch> batches;
+    // Rows returned by next().
+    uint64_t numReturned{0};
+    // Rows to skip before decoding after a restart.
+    uint64_t numToSkip{0};
+    // True while a decode task is scheduled or running.
+    bool running{false};
+    bool atEnd{false};
+    std::exception_ptr error;
+  };
+
+  // Schedules decode tasks for the ranges from 'current_' on that are not
+  // finished, up to 'parallelism' tasks.
+  void scheduleLocked();
+
+  // Decodes batches of 'ranges_[index]' until the range is finished, the
+  // buffer limit is reached or 'stopping_' is set.
+  void decode(size_t index);
+
+  // Returns true if the decode task of 'ranges_[index]' should pause.
+  bool shouldPauseLocked(size_t index) const;
+
+  // Sets 'stopping_' and waits for the decode tasks to finish.
+  void stopLocked(std::unique_lock<std::mutex>& lock);
+
+  // Adds the statistics of the reader of 'range' to 'stats_' and frees it.
+  void releaseReaderLocked(Range& range);
+
+  const std::shared_ptr<velox::common::ScanSpec> scanSpec_;
+  const RangeReaderFactory factory_;
+  const Options options_;
+  // The size argument of the last next(). Read by the decode tasks.
+  std::atomic<uint64_t> batchSize_{0};
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Range> ranges_;
+  // Index of the range returned by next().
+  size_t current_{0};
+  int32_t numRunning_{0};
+  uint64_t bufferedBytes_{0};
+  bool stopping_{false};
+  std::optional<size_t> estimatedRowSize_;
+  RuntimeStatistics stats_;
+};
+
+} // namespace facebook::velox::dwio::common
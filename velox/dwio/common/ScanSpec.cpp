@@ -115,7 +115,7 @@ bool ScanSpec::hasFilter() const {
   if (hasFilter_.has_value()) {
     return hasFilter_.value();
   }
-  if (!isConstant() && filter_) {
+  if (!isConstant() && (filter_ || !mapSubscriptFilters_.empty())) {
     hasFilter_ = true;
     return true;
   }
@@ -162,6 +162,37 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
   }
 }
 
+std::shared_ptr<ScanSpec> ScanSpec::clone() const {
+  auto copy = std::make_shared<ScanSpec>(fieldName_);
+  copy->subscript_ = subscript_;
+  copy->channel_ = channel_;
+  copy->constantValue_ = constantValue_;
+  copy->projectOut_ = projectOut_;
+  copy->extractValues_ = extractValues_;
+  copy->makeFlat_ = makeFlat_;
+  copy->filter_ = filter_ ? filter_->clone() : nullptr;
+  for (auto& subscriptFilter : mapSubscriptFilters_) {
+    copy->mapSubscriptFilters_.push_back(
+        {subscriptFilter.key, subscriptFilter.filter->clone()});
+  }
+  copy->metadataFilters_ = metadataFilters_;
+  copy->selectivity_ = selectivity_;
+  copy->enableFilterReorder_ = enableFilterReorder_;
+  copy->valueHook_ = valueHook_;
+  copy->isArrayElementOrMapEntry_ = isArrayElementOrMapEntry_;
+  copy->maxArrayElementsCount_ = maxArrayElementsCount_;
+  copy->flatMapFeatureSelection_ = flatMapFeatureSelection_;
+  copy->children_.reserve(children_.size());
+  for (auto& child : children_) {
+    copy->children_.push_back(child->clone());
+    copy->childByFieldName_[child->fieldName_] = copy->children_.back().get();
+  }
+  for (auto* child : stableChildren_) {
+    copy->stableChildren_.push_back(copy->childByName(child->fieldName_));
+  }
+  return copy;
+}
+
 namespace {
 bool testIntFilter(
     common::Filter* filter,
@@ -361,6 +392,11 @@ std::string ScanSpec::toString() const {
     if (filter_) {
       out << " filter " << filter_->toString();
     }
+    for (auto& subscriptFilter : mapSubscriptFilters_) {
+      out << " subscript ";
+      std::visit([&](const auto& key) { out << key; }, subscriptFilter.key);
+      out << " filter " << subscriptFilter.filter->toString();
+    }
     if (isConstant()) {
       out << " constant";
     }
@@ -382,6 +418,31 @@ void ScanSpec::addFilter(const Filter& filter) {
   filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
 }
 
+void ScanSpec::addMapSubscriptFilter(
+    const Subfield::PathElement& subscript,
+    const Filter& filter) {
+  std::variant<int64_t, std::string> key;
+  if (auto* longSubscript =
+          dynamic_cast<const Subfield::LongSubscript*>(&subscript)) {
+    key = longSubscript->index();
+  } else if (
+      auto* stringSubscript =
+          dynamic_cast<const Subfield::StringSubscript*>(&subscript)) {
+    key = stringSubscript->index();
+  } else {
+    VELOX_UNSUPPORTED(
+        "Unsupported map subscript for filter: {}", subscript.toString());
+  }
+  hasFilter_.reset();
+  for (auto& subscriptFilter : mapSubscriptFilters_) {
+    if (subscriptFilter.key == key) {
+      subscriptFilter.filter = subscriptFilter.filter->mergeWith(&filter);
+      return;
+    }
+  }
+  mapSubscriptFilters_.push_back({std::move(key), filter.clone()});
+}
+
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
   auto child = getOrCreateChild(Subfield(name));
   child->setProjectOut(true);
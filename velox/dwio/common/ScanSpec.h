@@ -24,6 +24,7 @@
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/LazyVector.h"
 
+#include <variant>
 #include <vector>
 
 namespace facebook {
@@ -71,6 +72,27 @@ class ScanSpec {
 
   void addFilter(const Filter&);
 
+  // Filter on the value of one key of a map, e.g. m['k'] > 5. A map row
+  // passes if its value at 'key' passes 'filter'. A null map, a missing key
+  // and a null value pass if 'filter' passes nulls. These drop rows of the
+  // map's container, unlike filters on the map's keys and values children.
+  struct MapSubscriptFilter {
+    // The key of a map with integer keys or a map with string keys.
+    std::variant<int64_t, std::string> key;
+    std::unique_ptr<Filter> filter;
+  };
+
+  const std::vector<MapSubscriptFilter>& mapSubscriptFilters() const {
+    return mapSubscriptFilters_;
+  }
+
+  // Adds a filter on the value at 'subscript', which is a StringSubscript or
+  // a LongSubscript, of the map described by 'this'. The filter is merged
+  // with a previous filter on the same key.
+  void addMapSubscriptFilter(
+      const Subfield::PathElement& subscript,
+      const Filter& filter);
+
   void setMaxArrayElementsCount(vector_size_t count) {
     maxArrayElementsCount_ = count;
   }
@@ -282,6 +304,12 @@ class ScanSpec {
   // the ScanSpec tree itself.
   void moveAdaptationFrom(ScanSpec& other);
 
+  // Returns a deep copy of 'this' with copies of the filters and the
+  // adaptation acquired so far. Used for giving readers that run in
+  // parallel their own ScanSpec trees, since a reader mutates its ScanSpec
+  // while reading. The metadata filters and the value hook are shared.
+  std::shared_ptr<ScanSpec> clone() const;
+
   std::string toString() const;
 
   // Add a field to this ScanSpec, with content projected out.
@@ -360,6 +388,9 @@ class ScanSpec {
   bool makeFlat_ = false;
   std::unique_ptr<common::Filter> filter_;
 
+  // Filters on values of given keys if 'this' is a map.
+  std::vector<MapSubscriptFilter> mapSubscriptFilters_;
+
   // Filters that will be only used for row group filtering based on metadata.
   // The conjunctions among these filters are tracked in MetadataFilter, with
   // the pointers to LeafNodes are stored here.  We need to keep these pointers
@@ -307,6 +307,7 @@ void SelectiveMapColumnReader::read(
   }
 
   prepareRead<char>(offset, rows, incomingNulls);
+  subscriptFilteredMap_.clear();
   auto activeRows = applyFilter(rows);
   makeNestedRowSet(activeRows, rows.back());
   if (keyReader_ && elementReader_ && !nestedRows_.empty()) {
@@ -318,10 +319,22 @@ void SelectiveMapColumnReader::read(
   }
   numValues_ = activeRows.size();
   readOffset_ = offset + rows.back() + 1;
+  if (!scanSpec_->mapSubscriptFilters().empty() && !activeRows.empty()) {
+    // The filters look up keys in the maps, so the maps are made first and
+    // the rows that pass are later returned from them.
+    VectorPtr map;
+    getValues(activeRows, &map);
+    subscriptFilteredMap_.filter(
+        *scanSpec_, activeRows, std::move(map), outputRows_);
+  }
 }
 
 void SelectiveMapColumnReader::getValues(RowSet rows, VectorPtr* result) {
   VELOX_DCHECK_NOT_NULL(result);
+  if (subscriptFilteredMap_.hasValues()) {
+    subscriptFilteredMap_.getValues(rows, &memoryPool_, result);
+    return;
+  }
   prepareResult(*result, requestedType_->type(), rows.size(), &memoryPool_);
   auto* resultMap = result->get()->asUnchecked<MapVector>();
   makeOffsetsAndSizes(rows, *resultMap);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/common/SubscriptFilteredMap.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -129,6 +130,10 @@ class SelectiveMapColumnReader : public SelectiveRepeatedColumnReader {
   std::unique_ptr<SelectiveColumnReader> keyReader_;
   std::unique_ptr<SelectiveColumnReader> elementReader_;
   const std::shared_ptr<const dwio::common::TypeWithId> requestedType_;
+
+ private:
+  // Holds the values of the last read() if it applied subscript filters.
+  SubscriptFilteredMap subscriptFilteredMap_;
 };
 
 } // namespace facebook::velox::dwio::common
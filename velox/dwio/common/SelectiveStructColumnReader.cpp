@@ -139,6 +139,10 @@ void SelectiveStructColumnReaderBase::read(
   }
   const uint64_t* structNulls =
       nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
+  VELOX_CHECK(
+      scanSpec_->mapSubscriptFilters().empty(),
+      "Map subscript filters are not supported on struct: {}",
+      scanSpec_->fieldName());
   // a struct reader may have a null/non-null filter
   if (scanSpec_->filter()) {
     auto kind = scanSpec_->filter()->kind();
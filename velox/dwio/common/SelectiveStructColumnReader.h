@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
+#include "velox/dwio/common/SubscriptFilteredMap.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -229,6 +230,8 @@ class SelectiveFlatMapColumnReaderHelper {
   std::vector<const uint64_t*> inMaps_;
   std::vector<uint64_t> columnRowBits_;
   std::vector<BaseVector::CopyRange> copyRanges_;
+  // Holds the values of the last read() if it applied subscript filters.
+  SubscriptFilteredMap subscriptFilteredMap_;
 };
 
 template <typename T, typename KeyNode, typename FormatData>
@@ -239,6 +242,7 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::read(
   reader_.numReads_ = reader_.scanSpec_->newRead();
   reader_.prepareRead<char>(offset, rows, incomingNulls);
   VELOX_DCHECK(!reader_.hasMutation());
+  subscriptFilteredMap_.clear();
   auto activeRows = rows;
   auto* mapNulls = reader_.nullsInReadRange_
       ? reader_.nullsInReadRange_->as<uint64_t>()
@@ -268,6 +272,12 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::read(
   }
   reader_.lazyVectorReadOffset_ = offset;
   reader_.readOffset_ = offset + rows.back() + 1;
+  if (!reader_.scanSpec_->mapSubscriptFilters().empty()) {
+    VectorPtr map;
+    getValues(activeRows, &map);
+    subscriptFilteredMap_.filter(
+        *reader_.scanSpec_, activeRows, std::move(map), reader_.outputRows_);
+  }
 }
 
 template <typename T, typename KeyNode, typename FormatData>
@@ -417,6 +427,10 @@ template <typename T, typename KeyNode, typename FormatData>
 void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::getValues(
     RowSet rows,
     VectorPtr* result) {
+  if (subscriptFilteredMap_.hasValues()) {
+    subscriptFilteredMap_.getValues(rows, &reader_.memoryPool_, result);
+    return;
+  }
   auto& mapResult = prepareResult(*result, rows.size());
   auto* rawOffsets = mapResult.mutableOffsets(rows.size())
                          ->template asMutable<vector_size_t>();
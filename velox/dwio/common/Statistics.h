@@ -523,6 +523,14 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of data pages skipped without decoding because page level
+  // statistics show that no row can pass the filter.
+  int64_t skippedPages{0};
+
+  // Number of strides (row groups) skipped because the bloom filter of a
+  // column shows that no value passing the filter is present.
+  int64_t skippedStridesByBloomFilter{0};
 };
 
 struct RuntimeStatistics {
@@ -535,6 +543,10 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of stripes whose data is not read because the statistics of all
+  // their strides show that no row can pass the filter.
+  int64_t skippedStripes{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
@@ -543,8 +555,12 @@ struct RuntimeStatistics {
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedStripes", RuntimeCounter(skippedStripes)},
         {"flattenStringDictionaryValues",
-         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)},
+        {"skippedPages", RuntimeCounter(columnReaderStatistics.skippedPages)},
+        {"skippedStridesByBloomFilter",
+         RuntimeCounter(columnReaderStatistics.skippedStridesByBloomFilter)}};
   }
 };
 
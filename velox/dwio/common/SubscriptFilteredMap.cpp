@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/SubscriptFilteredMap.h"
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+using MapSubscriptFilter = velox::common::ScanSpec::MapSubscriptFilter;
+
+template <TypeKind kKind>
+bool keyEquals(
+    const MapSubscriptFilter& subscriptFilter,
+    const DecodedVector& keys,
+    vector_size_t index) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  if constexpr (std::is_same_v<T, StringView>) {
+    auto* key = std::get_if<std::string>(&subscriptFilter.key);
+    return key && keys.valueAt<StringView>(index) == StringView(*key);
+  } else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+    auto* key = std::get_if<int64_t>(&subscriptFilter.key);
+    return key && keys.valueAt<T>(index) == *key;
+  } else {
+    VELOX_UNSUPPORTED(
+        "Unsupported map key type for subscript filter: {}",
+        mapTypeKindToName(kKind));
+  }
+}
+
+template <TypeKind kKind>
+bool testValue(
+    const velox::common::Filter& filter,
+    const DecodedVector& values,
+    vector_size_t index) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  if (values.isNullAt(index)) {
+    return filter.testNull();
+  }
+  return velox::common::applyFilter(filter, values.valueAt<T>(index));
+}
+
+} // namespace
+
+void SubscriptFilteredMap::filter(
+    const velox::common::ScanSpec& scanSpec,
+    RowSet rows,
+    VectorPtr map,
+    raw_vector<vector_size_t>& outputRows) {
+  map_ = std::move(map);
+  rows_.resize(rows.size());
+  std::copy(rows.begin(), rows.end(), rows_.begin());
+  auto* mapVector = map_->asUnchecked<MapVector>();
+  keys_.decode(*mapVector->mapKeys());
+  values_.decode(*mapVector->mapValues());
+  const auto keyKind = keys_.base()->typeKind();
+  const auto valueKind = values_.base()->typeKind();
+  auto& subscriptFilters = scanSpec.mapSubscriptFilters();
+  outputRows.resize(rows_.size());
+  vector_size_t numPassed = 0;
+  for (vector_size_t i = 0; i < rows_.size(); ++i) {
+    const auto begin = mapVector->isNullAt(i) ? 0 : mapVector->offsetAt(i);
+    const auto end = mapVector->isNullAt(i) ? 0 : begin + mapVector->sizeAt(i);
+    bool passed = true;
+    for (auto& subscriptFilter : subscriptFilters) {
+      auto entry = begin;
+      while (entry < end &&
+             (keys_.isNullAt(entry) ||
+              !VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+                  keyEquals, keyKind, subscriptFilter, keys_, entry))) {
+        ++entry;
+      }
+      passed = entry < end
+          ? VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+                testValue, valueKind, *subscriptFilter.filter, values_, entry)
+          : subscriptFilter.filter->testNull();
+      if (!passed) {
+        break;
+      }
+    }
+    if (passed) {
+      outputRows[numPassed++] = rows_[i];
+    }
+  }
+  outputRows.resize(numPassed);
+}
+
+void SubscriptFilteredMap::getValues(
+    RowSet rows,
+    memory::MemoryPool* pool,
+    VectorPtr* result) {
+  VELOX_CHECK_NOT_NULL(map_);
+  if (rows.size() == rows_.size()) {
+    *result = map_;
+    return;
+  }
+  auto* mapVector = map_->asUnchecked<MapVector>();
+  auto offsets = allocateOffsets(rows.size(), pool);
+  auto sizes = allocateSizes(rows.size(), pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+  BufferPtr nulls;
+  uint64_t* rawNulls = nullptr;
+  if (mapVector->mayHaveNulls()) {
+    nulls = allocateNulls(rows.size(), pool);
+    rawNulls = nulls->asMutable<uint64_t>();
+  }
+  vector_size_t index = 0;
+  for (vector_size_t i = 0; i < rows.size(); ++i) {
+    while (rows_[index] < rows[i]) {
+      ++index;
+    }
+    VELOX_DCHECK_EQ(rows_[index], rows[i]);
+    rawOffsets[i] = mapVector->offsetAt(index);
+    rawSizes[i] = mapVector->sizeAt(index);
+    if (rawNulls) {
+      bits::setNull(rawNulls, i, mapVector->isNullAt(index));
+    }
+  }
+  *result = std::make_shared<MapVector>(
+      pool,
+      map_->type(),
+      std::move(nulls),
+      rows.size(),
+      std::move(offsets),
+      std::move(sizes),
+      mapVector->mapKeys(),
+      mapVector->mapValues());
+}
+
+} // namespace facebook::velox::dwio::common
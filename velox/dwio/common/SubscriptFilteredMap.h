@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::dwio::common {
+
+using RowSet = folly::Range<const vector_size_t*>;
+
+/// Applies the ScanSpec::mapSubscriptFilters() of a map column reader. The
+/// reader materializes the map for the rows reaching the filters and the
+/// values for the rows that pass are later returned from this map, so that
+/// the readers below the map extract their values once per read.
+class SubscriptFilteredMap {
+ public:
+  /// Takes 'map', which has the values of the map column for 'rows', and
+  /// sets 'outputRows' to the rows passing all subscript filters of
+  /// 'scanSpec'. 'outputRows' may be the storage 'rows' refers to.
+  void filter(
+      const velox::common::ScanSpec& scanSpec,
+      RowSet rows,
+      VectorPtr map,
+      raw_vector<vector_size_t>& outputRows);
+
+  /// True if filter() has been called since the last clear().
+  bool hasValues() const {
+    return map_ != nullptr;
+  }
+
+  /// Sets 'result' to the map values for 'rows', which are a subset of the
+  /// rows given to filter().
+  void getValues(RowSet rows, memory::MemoryPool* pool, VectorPtr* result);
+
+  void clear() {
+    map_.reset();
+  }
+
+ private:
+  VectorPtr map_;
+  // The rows 'map_' has values for.
+  raw_vector<vector_size_t> rows_;
+  DecodedVector keys_;
+  DecodedVector values_;
+};
+
+} // namespace facebook::velox::dwio::common
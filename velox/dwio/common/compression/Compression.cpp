@@ -609,11 +609,80 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+class BlockCodecCompressor : public Compressor {
+ public:
+  explicit BlockCodecCompressor(
+      std::unique_ptr<velox::common::BlockCodec> codec)
+      : Compressor{velox::common::BlockCodecOptions::kDefaultLevel},
+        codec_(std::move(codec)) {}
+
+  uint64_t compress(const void* src, void* dest, uint64_t length) override {
+    // A result of 'length' tells the caller to keep the block uncompressed.
+    return codec_
+        ->compress(
+            static_cast<const char*>(src),
+            length,
+            static_cast<char*>(dest),
+            length)
+        .value_or(length);
+  }
+
+ private:
+  const std::unique_ptr<velox::common::BlockCodec> codec_;
+};
+
+class BlockCodecDecompressor : public Decompressor {
+ public:
+  BlockCodecDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo,
+      std::unique_ptr<velox::common::BlockCodec> codec)
+      : Decompressor{blockSize, streamDebugInfo}, codec_(std::move(codec)) {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    return codec_->decompress(src, srcLength, dest, destLength);
+  }
+
+ private:
+  const std::unique_ptr<velox::common::BlockCodec> codec_;
+};
+
+// Returns the codec registered for 'kind' and 'options', if any. LZ4 and LZO
+// are left to the built-in codecs since their framing depends on
+// 'isHadoopFrameFormat', which BlockCodecOptions does not describe.
+std::unique_ptr<velox::common::BlockCodec> makeBlockCodec(
+    CompressionKind kind,
+    const CompressionOptions& options) {
+  velox::common::BlockCodecOptions codecOptions;
+  switch (kind) {
+    case CompressionKind::CompressionKind_ZLIB:
+    case CompressionKind::CompressionKind_GZIP:
+      codecOptions.level = options.format.zlib.compressionLevel;
+      codecOptions.windowBits = options.format.zlib.windowBits;
+      break;
+    case CompressionKind::CompressionKind_ZSTD:
+      codecOptions.level = options.format.zstd.compressionLevel;
+      break;
+    case CompressionKind::CompressionKind_SNAPPY:
+      break;
+    default:
+      return nullptr;
+  }
+  return velox::common::makeBlockCodec(kind, codecOptions);
+}
+
 } // namespace
 
 std::unique_ptr<Compressor> createCompressor(
     CompressionKind kind,
     const CompressionOptions& options) {
+  if (auto codec = makeBlockCodec(kind, options)) {
+    return std::make_unique<BlockCodecCompressor>(std::move(codec));
+  }
   switch (kind) {
     case CompressionKind::CompressionKind_NONE:
       return nullptr;
@@ -652,6 +721,17 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     bool useRawDecompression,
     size_t compressedLength) {
   std::unique_ptr<Decompressor> decompressor;
+  if (auto codec = makeBlockCodec(kind, options)) {
+    return std::make_unique<PagedInputStream>(
+        std::move(input),
+        pool,
+        std::make_unique<BlockCodecDecompressor>(
+            blockSize, streamDebugInfo, std::move(codec)),
+        decrypter,
+        streamDebugInfo,
+        useRawDecompression,
+        compressedLength);
+  }
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
       if (!decrypter) {
@@ -17,6 +17,7 @@
 #include "velox/dwio/common/DecoderUtil.h"
 #include <folly/Random.h>
 #include "velox/common/base/Nulls.h"
+#include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/type/Filter.h"
 
 #include <gtest/gtest.h>
@@ -234,3 +235,55 @@ TEST_F(DecoderUtilTest, processFixedWithRun) {
     }
   }
 }
+
+TEST_F(DecoderUtilTest, prefixSum) {
+  std::vector<uint64_t> values;
+  for (auto size : {0, 1, 3, 4, 5, 17}) {
+    values.resize(size);
+    for (auto i = 0; i < size; ++i) {
+      values[i] = i == 3 ? -5 : i + 1;
+    }
+    auto expected = values;
+    uint64_t sum = 100;
+    for (auto& value : expected) {
+      sum += value;
+      value = sum;
+    }
+    prefixSum(values.data(), size, 100);
+    EXPECT_EQ(expected, values);
+  }
+}
+
+TEST_F(DecoderUtilTest, fillFilterCache) {
+  constexpr int32_t kSize = 37;
+  std::vector<int32_t> values(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    values[i] = (i * 7) % 50;
+  }
+  RawDictionaryState dictionary{values.data(), kSize};
+  std::vector<uint8_t> cache(kSize, FilterResult::kUnknown);
+  common::BigintRange filter(10, 30, false);
+  fillFilterCache<int32_t>(filter, dictionary, cache.data());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_EQ(
+        values[i] >= 10 && values[i] <= 30 ? FilterResult::kSuccess
+                                           : FilterResult::kFailure,
+        cache[i])
+        << i;
+  }
+
+  std::vector<StringView> strings;
+  for (auto i = 0; i < kSize; ++i) {
+    strings.push_back(StringView(i % 3 == 0 ? "apple" : "pear"));
+  }
+  RawDictionaryState stringDictionary{strings.data(), kSize};
+  std::fill(cache.begin(), cache.end(), FilterResult::kUnknown);
+  common::BytesValues stringFilter({"pear"}, false);
+  fillFilterCache<folly::StringPiece>(
+      stringFilter, stringDictionary, cache.data());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_EQ(
+        i % 3 == 0 ? FilterResult::kFailure : FilterResult::kSuccess, cache[i])
+        << i;
+  }
+}
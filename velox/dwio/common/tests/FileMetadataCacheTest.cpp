@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+FileMetadataCache::Key
+makeKey(const std::string& path, uint64_t size = 100, int64_t time = 0) {
+  return {FileFormat::DWRF, path, size, time};
+}
+
+std::shared_ptr<const std::string> makeMetadata(const std::string& value) {
+  return std::make_shared<const std::string>(value);
+}
+
+TEST(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(1'000);
+  EXPECT_EQ(cache.get<std::string>(makeKey("a")), nullptr);
+  cache.put(makeKey("a"), makeMetadata("footer a"), 100);
+  EXPECT_EQ(*cache.get<std::string>(makeKey("a")), "footer a");
+
+  // A different size, modification time or format is a different file.
+  EXPECT_EQ(cache.get<std::string>(makeKey("a", 101)), nullptr);
+  EXPECT_EQ(cache.get<std::string>(makeKey("a", 100, 1)), nullptr);
+  EXPECT_EQ(
+      cache.get<std::string>({FileFormat::PARQUET, "a", 100, 0}), nullptr);
+
+  cache.put(makeKey("a"), makeMetadata("new footer a"), 200);
+  EXPECT_EQ(*cache.get<std::string>(makeKey("a")), "new footer a");
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_EQ(stats.bytes, 200);
+  EXPECT_EQ(stats.numLookups, 6);
+  EXPECT_EQ(stats.numHits, 2);
+
+  cache.clear();
+  EXPECT_EQ(cache.get<std::string>(makeKey("a")), nullptr);
+  EXPECT_EQ(cache.stats().bytes, 0);
+}
+
+TEST(FileMetadataCacheTest, evict) {
+  FileMetadataCache cache(1'000);
+  for (auto i = 0; i < 4; ++i) {
+    cache.put(makeKey(std::to_string(i)), makeMetadata("footer"), 250);
+  }
+  // A hit makes "0" the most recently used entry.
+  EXPECT_NE(cache.get<std::string>(makeKey("0")), nullptr);
+  cache.put(makeKey("4"), makeMetadata("footer"), 250);
+  EXPECT_NE(cache.get<std::string>(makeKey("0")), nullptr);
+  EXPECT_EQ(cache.get<std::string>(makeKey("1")), nullptr);
+  EXPECT_NE(cache.get<std::string>(makeKey("4")), nullptr);
+  EXPECT_EQ(cache.stats().numEvictions, 1);
+  EXPECT_EQ(cache.stats().bytes, 1'000);
+
+  // An entry larger than a quarter of the budget is not cached.
+  cache.put(makeKey("5"), makeMetadata("footer"), 251);
+  EXPECT_EQ(cache.get<std::string>(makeKey("5")), nullptr);
+  EXPECT_EQ(cache.stats().numEntries, 4);
+}
+
+TEST(FileMetadataCacheTest, sharedWithReaders) {
+  FileMetadataCache cache(1'000);
+  auto metadata = makeMetadata("footer");
+  cache.put(makeKey("a"), metadata, 100);
+  auto cached = cache.get<std::string>(makeKey("a"));
+  EXPECT_EQ(cached.get(), metadata.get());
+  // A reader keeps its metadata after the eviction.
+  cache.clear();
+  metadata.reset();
+  EXPECT_EQ(*cached, "footer");
+}
+
+} // namespace
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ParallelRowReader.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+using namespace facebook::velox::common;
+
+// Returns the rows of ['offset', 'offset' + 'length') with c0 equal to the
+// row number, dropping the rows that fail the filter of c0.
+class TestRangeReader : public RowReader {
+ public:
+  using MakeRows = std::function<VectorPtr(const std::vector<int64_t>&)>;
+
+  TestRangeReader(
+      uint64_t offset,
+      uint64_t length,
+      std::shared_ptr<ScanSpec> scanSpec,
+      MakeRows makeRows)
+      : position_(offset),
+        end_(offset + length),
+        scanSpec_(std::move(scanSpec)),
+        makeRows_(std::move(makeRows)) {}
+
+  uint64_t next(uint64_t size, VectorPtr& result, const Mutation* /*mutation*/)
+      override {
+    const auto numScanned = std::min(size, end_ - position_);
+    if (numScanned == 0) {
+      return 0;
+    }
+    auto* filter = scanSpec_->childByName("c0")->filter();
+    std::vector<int64_t> values;
+    for (auto i = position_; i < position_ + numScanned; ++i) {
+      if (!filter || filter->testInt64(i)) {
+        values.push_back(i);
+      }
+    }
+    position_ += numScanned;
+    result = makeRows_(values);
+    return numScanned;
+  }
+
+  int64_t nextRowNumber() override {
+    return position_;
+  }
+
+  int64_t nextReadSize(uint64_t size) override {
+    return std::min(size, end_ - position_);
+  }
+
+  void updateRuntimeStats(RuntimeStatistics& stats) const override {
+    ++stats.skippedStrides;
+  }
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return 8;
+  }
+
+ private:
+  uint64_t position_;
+  const uint64_t end_;
+  const std::shared_ptr<ScanSpec> scanSpec_;
+  const MakeRows makeRows_;
+};
+
+class ParallelRowReaderTest : public testing::Test,
+                              public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    scanSpec_ = std::make_shared<ScanSpec>("<root>");
+    scanSpec_->addField("c0", 0);
+  }
+
+  std::unique_ptr<ParallelRowReader> makeReader(
+      uint64_t length,
+      int32_t numRanges,
+      uint64_t maxBufferedBytes,
+      int32_t failingRange = -1) {
+    ParallelRowReader::Options options;
+    options.executor = &executor_;
+    options.parallelism = 3;
+    options.maxBufferedBytes = maxBufferedBytes;
+    return std::make_unique<ParallelRowReader>(
+        scanSpec_,
+        0,
+        length,
+        numRanges,
+        [this, length, numRanges, failingRange](
+            uint64_t offset,
+            uint64_t rangeLength,
+            const std::shared_ptr<ScanSpec>& scanSpec)
+            -> std::unique_ptr<RowReader> {
+          VELOX_CHECK_NE(scanSpec.get(), scanSpec_.get());
+          if (failingRange >= 0 &&
+              offset == failingRange * (length / numRanges)) {
+            VELOX_FAIL("Failed range");
+          }
+          return std::make_unique<TestRangeReader>(
+              offset, rangeLength, scanSpec, [this](const auto& values) {
+                return makeRowVector({makeFlatVector<int64_t>(values)});
+              });
+        },
+        options);
+  }
+
+  // Reads batches of 'batchSize' rows until 'maxRows' rows are scanned or the
+  // end. Appends the values to 'values' and returns the scanned rows.
+  uint64_t read(
+      ParallelRowReader& reader,
+      uint64_t batchSize,
+      uint64_t maxRows,
+      std::vector<int64_t>& values) {
+    uint64_t numScanned = 0;
+    while (numScanned < maxRows) {
+      VectorPtr batch;
+      const auto n = reader.next(batchSize, batch);
+      if (n == 0) {
+        break;
+      }
+      numScanned += n;
+      auto* c0 = batch->as<RowVector>()->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < c0->size(); ++i) {
+        values.push_back(c0->valueAt(i));
+      }
+    }
+    return numScanned;
+  }
+
+  folly::CPUThreadPoolExecutor executor_{4};
+  std::shared_ptr<ScanSpec> scanSpec_;
+};
+
+TEST_F(ParallelRowReaderTest, inOrder) {
+  for (auto maxBufferedBytes : {1UL, 1UL << 30}) {
+    SCOPED_TRACE(fmt::format("maxBufferedBytes {}", maxBufferedBytes));
+    auto reader = makeReader(10'000, 7, maxBufferedBytes);
+    std::vector<int64_t> values;
+    ASSERT_EQ(read(*reader, 100, 20'000, values), 10'000);
+    ASSERT_EQ(values.size(), 10'000);
+    for (auto i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(values[i], i);
+    }
+    ASSERT_EQ(reader->estimatedRowSize(), 8);
+    RuntimeStatistics stats;
+    reader->updateRuntimeStats(stats);
+    ASSERT_EQ(stats.skippedStrides, 7);
+  }
+}
+
+TEST_F(ParallelRowReaderTest, resetFilterCaches) {
+  auto reader = makeReader(1'000, 4, 1 << 30);
+  std::vector<int64_t> values;
+  ASSERT_EQ(read(*reader, 50, 100, values), 100);
+  // Let the ranges ahead decode with the old filter.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  scanSpec_->childByName("c0")->setFilter(
+      std::make_unique<BigintRange>(0, 499, false));
+  reader->resetFilterCaches();
+  ASSERT_EQ(read(*reader, 50, 2'000, values), 900);
+  ASSERT_EQ(values.size(), 500);
+  for (auto i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+}
+
+TEST_F(ParallelRowReaderTest, error) {
+  auto reader = makeReader(1'000, 4, 1 << 30, 2);
+  std::vector<int64_t> values;
+  VELOX_ASSERT_THROW(read(*reader, 100, 2'000, values), "Failed range");
+  ASSERT_EQ(values.size(), 500);
+}
+
+TEST_F(ParallelRowReaderTest, destroyWhileDecoding) {
+  auto reader = makeReader(100'000, 10, 1 << 30);
+  std::vector<int64_t> values;
+  ASSERT_EQ(read(*reader, 10, 10, values), 10);
+  reader.reset();
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/common/RLEv2.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
@@ -559,7 +560,19 @@ uint64_t RleDecoderV2<isSigned>::nextDelta(
     uint64_t remaining = (offset + nRead) - pos;
     runRead += readLongs(data, pos, remaining, bitSize, nulls);
 
-    if (deltaBase < 0) {
+    if (!nulls) {
+      auto* deltas = reinterpret_cast<uint64_t*>(data + pos);
+      if (deltaBase < 0) {
+        for (uint64_t i = 0; i < remaining; ++i) {
+          deltas[i] = -deltas[i];
+        }
+      }
+      dwio::common::prefixSum(
+          deltas, remaining, static_cast<uint64_t>(prevValue));
+      if (remaining > 0) {
+        prevValue = data[offset + nRead - 1];
+      }
+    } else if (deltaBase < 0) {
       for (; pos < offset + nRead; ++pos) {
         // skip null positions
         if (nulls && bits::isBitNull(nulls, pos)) {
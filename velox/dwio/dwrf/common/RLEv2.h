@@ -22,6 +22,7 @@
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+#include <folly/lang/Bits.h>
 #include <vector>
 
 namespace facebook::velox::dwrf {
@@ -159,9 +160,14 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
-
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
+    const uint64_t end = offset + len;
+    for (uint64_t i = offset; i < end; i++) {
+      if (bitsLeft == 0 && fb > 0 && fb <= kMaxWordUnpackBits) {
+        i = unpackWords(data, i, end, fb, nulls, ret);
+        if (i == end) {
+          break;
+        }
+      }
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
         continue;
@@ -189,6 +195,55 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Widest value that unpackWords() can extract from a single 64 bit load at
+  // any bit offset.
+  static constexpr uint64_t kMaxWordUnpackBits = 56;
+
+  // Unpacks the 'fb' bit values for the non-null positions from 'begin' to
+  // 'end' of 'data' with a 64 bit load per value instead of a byte at a time.
+  // Must be called at a byte boundary, i.e. with 'bitsLeft' 0. Stops at the
+  // first value that cannot be loaded without reading past 'bufferEnd' and
+  // leaves the rest to readLongs(). Adds the number of values read to
+  // 'numRead' and returns the first position that is not read.
+  uint64_t unpackWords(
+      int64_t* data,
+      uint64_t begin,
+      uint64_t end,
+      uint64_t fb,
+      const uint64_t* nulls,
+      uint64_t& numRead) {
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const uint64_t available =
+        dwio::common::IntDecoder<isSigned>::bufferEnd - bufferStart;
+    if (available < sizeof(uint64_t)) {
+      return begin;
+    }
+    const auto* start = reinterpret_cast<const uint8_t*>(bufferStart);
+    const uint64_t lastLoad = available - sizeof(uint64_t);
+    uint64_t bit = 0;
+    uint64_t i = begin;
+    for (; i < end; ++i) {
+      if (nulls && bits::isBitNull(nulls, i)) {
+        continue;
+      }
+      if ((bit >> 3) > lastLoad) {
+        break;
+      }
+      // The values are packed most significant bit first.
+      const auto word = folly::Endian::big(
+          folly::loadUnaligned<uint64_t>(start + (bit >> 3)));
+      data[i] = static_cast<int64_t>((word << (bit & 7)) >> (64 - fb));
+      bit += fb;
+      ++numRead;
+    }
+    bufferStart += bit >> 3;
+    if (bit & 7) {
+      curByte = static_cast<unsigned char>(*bufferStart++);
+      bitsLeft = 8 - (bit & 7);
+    }
+    return i;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
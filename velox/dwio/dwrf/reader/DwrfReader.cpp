@@ -76,10 +76,23 @@ class DwrfUnit : public LoadUnit {
     return selectiveColumnReader_;
   }
 
+  // Reads the data streams if load() has skipped them.
+  void ensureDataLoaded();
+
+  // True if load() has not read the data streams because the row index shows
+  // that no stride of the stripe can pass the filters.
+  bool dataSkipped() const {
+    return !dataLoaded_;
+  }
+
  private:
   void ensureDecoders();
   void loadDecoders();
 
+  // Returns true if the row index of the stripe is in the stripe metadata
+  // cache and shows that no stride can pass the filters. Reads no data.
+  bool allStridesFiltered();
+
   // Immutables
   const StripeReaderBase& stripeReaderBase_;
   const StrideIndexProvider& strideIndexProvider_;
@@ -91,6 +104,8 @@ class DwrfUnit : public LoadUnit {
 
   // Mutables
   bool preloaded_;
+  bool dataLoaded_{false};
+  std::optional<bool> allStridesFiltered_;
   std::optional<uint64_t> cachedIoSize_;
   std::shared_ptr<StripeReadState> stripeReadState_;
   std::unique_ptr<StripeStreamsImpl> stripeStreams_;
@@ -105,6 +120,8 @@ void DwrfUnit::load() {
 }
 
 void DwrfUnit::unload() {
+  dataLoaded_ = false;
+  allStridesFiltered_.reset();
   cachedIoSize_.reset();
   stripeStreams_.reset();
   columnReader_.reset();
@@ -122,11 +139,39 @@ uint64_t DwrfUnit::getIoSize() {
     return *cachedIoSize_;
   }
   ensureDecoders();
-  cachedIoSize_ =
-      stripeReadState_->stripeMetadata->stripeInput->nextFetchSize();
+  cachedIoSize_ = !preloaded_ && allStridesFiltered()
+      ? 0
+      : stripeReadState_->stripeMetadata->stripeInput->nextFetchSize();
   return *cachedIoSize_;
 }
 
+bool DwrfUnit::allStridesFiltered() {
+  if (allStridesFiltered_.has_value()) {
+    return *allStridesFiltered_;
+  }
+  allStridesFiltered_ = false;
+  const auto& reader = stripeReaderBase_.getReader();
+  const auto strideSize = reader.getFooter().rowIndexStride();
+  const auto& metadataCache = reader.getMetadataCache();
+  if (!selectiveColumnReader_ || strideSize == 0 || !metadataCache ||
+      !metadataCache->has(StripeCacheMode::INDEX, stripeIndex_)) {
+    return false;
+  }
+  // Same evaluation as DwrfRowReader::checkSkipStrides(). The index streams
+  // come from the metadata cache, so this needs no I/O.
+  StatsContext context(reader.getWriterName(), reader.getWriterVersion());
+  DwrfData::FilterRowGroupsResult res;
+  selectiveColumnReader_->filterRowGroups(strideSize, context, res);
+  if (auto& metadataFilter = options_.getMetadataFilter()) {
+    metadataFilter->eval(res.metadataFilterResults, res.filterResult);
+  }
+  const auto numStrides =
+      bits::divRoundUp(stripeInfo_.numberOfRows(), strideSize);
+  allStridesFiltered_ = numStrides > 0 && res.totalCount >= numStrides &&
+      bits::isAllSet(res.filterResult.data(), 0, numStrides);
+  return *allStridesFiltered_;
+}
+
 void DwrfUnit::ensureDecoders() {
   if (columnReader_ || selectiveColumnReader_) {
     return;
@@ -186,13 +231,30 @@ void DwrfUnit::loadDecoders() {
   // during column reader construction
   // if planReads is off which means stripe data loaded as whole
   if (!preloaded_) {
-    VLOG(1) << "[DWRF] Load read plan for stripe " << stripeIndex_;
-    stripeStreams_->loadReadPlan();
+    if (allStridesFiltered()) {
+      VLOG(1) << "[DWRF] Skip reading stripe " << stripeIndex_
+              << " since no stride passes the filters";
+    } else {
+      VLOG(1) << "[DWRF] Load read plan for stripe " << stripeIndex_;
+      stripeStreams_->loadReadPlan();
+      dataLoaded_ = true;
+    }
+  } else {
+    dataLoaded_ = true;
   }
 
   stripeDictionaryCache_ = stripeStreams_->getStripeDictionaryCache();
 }
 
+void DwrfUnit::ensureDataLoaded() {
+  if (dataLoaded_) {
+    return;
+  }
+  VLOG(1) << "[DWRF] Load read plan for skipped stripe " << stripeIndex_;
+  stripeStreams_->loadReadPlan();
+  dataLoaded_ = true;
+}
+
 namespace {
 
 DwrfUnit* castDwrfUnit(LoadUnit* unit) {
@@ -482,6 +544,7 @@ void DwrfRowReader::readNext(
     uint64_t rowsToRead,
     const dwio::common::Mutation* mutation,
     VectorPtr& result) {
+  currentUnit_->ensureDataLoaded();
   if (!getSelectiveColumnReader()) {
     std::optional<std::chrono::steady_clock::time_point> startTime;
     if (decodingTimeCallback_) {
@@ -515,6 +578,7 @@ void DwrfRowReader::readNext(
 }
 
 uint64_t DwrfRowReader::skip(uint64_t numValues) {
+  currentUnit_->ensureDataLoaded();
   if (getSelectiveColumnReader()) {
     return getSelectiveColumnReader()->skip(numValues);
   } else {
@@ -547,6 +611,9 @@ int64_t DwrfRowReader::nextRowNumber() {
       nextRowNumber_ = firstRowOfStripe_[currentStripe_] + currentRowInStripe_;
       return *nextRowNumber_;
     }
+    if (currentUnit_ && currentUnit_->dataSkipped()) {
+      ++skippedStripes_;
+    }
   advanceToNextStripe:
     ++currentStripe_;
     currentRowInStripe_ = 0;
@@ -750,7 +817,9 @@ DwrfReader::DwrfReader(
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
           options.isFileColumnNamesReadAsLowerCase(),
-          options.randomSkip())),
+          options.randomSkip(),
+          options.fileMetadataCache(),
+          options.fileModificationTime())),
       options_(options) {
   // If we are not using column names to map table columns to file columns,
   // then we use indices. In that case we need to ensure the names completely
@@ -72,7 +72,9 @@ class ReaderBase {
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
-      std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr);
+      std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
+      dwio::common::FileMetadataCache* metadataCache = nullptr,
+      int64_t fileModificationTime = 0);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -242,10 +244,20 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the postscript and footer into 'arena_', 'postScript_',
+  // 'footer_' and 'psLength_'. Loads 'readSize' bytes at the end of the file
+  // first, which is the whole file if 'preloadFile'.
+  void readFooter(
+      uint64_t readSize,
+      bool preloadFile,
+      dwio::common::FileFormat fileFormat);
+
   memory::MemoryPool& pool_;
-  std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  // The arena, postscript and footer may be shared with other readers of the
+  // file through the FileMetadataCache.
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  std::shared_ptr<const PostScript> postScript_;
+  std::shared_ptr<const FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
@@ -22,6 +22,7 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include "velox/common/compression/Compression.h"
 
@@ -226,6 +227,83 @@ TEST_P(CompressionTest, compressRandomLetters) {
       memSink, kind_, block, testData, dataSize, *pool_, decrypter_);
 }
 
+// Compresses with the folly zstd codec and counts the calls, like an offload
+// backend that produces the standard format.
+class CountingZstdCodec : public BlockCodec {
+ public:
+  explicit CountingZstdCodec(int32_t* numCalls)
+      : numCalls_(numCalls),
+        codec_(folly::io::getCodec(folly::io::CodecType::ZSTD)) {}
+
+  uint64_t maxCompressedLength(uint64_t inputSize) const override {
+    return codec_->maxCompressedLength(inputSize);
+  }
+
+  std::optional<uint64_t> compress(
+      const char* input,
+      uint64_t inputSize,
+      char* output,
+      uint64_t outputSize) override {
+    ++*numCalls_;
+    const auto compressed =
+        codec_->compress(folly::StringPiece(input, inputSize));
+    if (compressed.size() > outputSize) {
+      return std::nullopt;
+    }
+    memcpy(output, compressed.data(), compressed.size());
+    return compressed.size();
+  }
+
+  uint64_t decompress(
+      const char* input,
+      uint64_t inputSize,
+      char* output,
+      uint64_t outputSize) override {
+    ++*numCalls_;
+    const auto data = codec_->uncompress(folly::StringPiece(input, inputSize));
+    VELOX_CHECK_LE(data.size(), outputSize);
+    memcpy(output, data.data(), data.size());
+    return data.size();
+  }
+
+ private:
+  int32_t* const numCalls_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+};
+
+TEST_P(CompressionTest, blockCodec) {
+  if (kind_ != CompressionKind_ZSTD) {
+    return;
+  }
+  int32_t numCalls = 0;
+  registerBlockCodecFactory(
+      CompressionKind_ZSTD,
+      [&](CompressionKind /*kind*/, const BlockCodecOptions& /*options*/) {
+        return std::make_unique<CountingZstdCodec>(&numCalls);
+      });
+  SCOPE_EXIT {
+    registerBlockCodecFactory(CompressionKind_ZSTD, nullptr);
+  };
+
+  uint64_t block = 1024;
+  constexpr size_t dataSize = 64 * 1024;
+  char testData[dataSize];
+  generateRandomData(testData, dataSize, true);
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData, dataSize, encrypter_);
+  const auto numCompressions = numCalls;
+  EXPECT_GT(numCompressions, 0);
+  decompressAndVerify(
+      memSink, kind_, block, testData, dataSize, *pool_, decrypter_);
+  EXPECT_GT(numCalls, numCompressions);
+
+  // The built-in codec reads what the plugged one wrote.
+  registerBlockCodecFactory(CompressionKind_ZSTD, nullptr);
+  decompressAndVerify(
+      memSink, kind_, block, testData, dataSize, *pool_, decrypter_);
+}
+
 TEST_P(CompressionTest, compressRandomBytes) {
   MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
 
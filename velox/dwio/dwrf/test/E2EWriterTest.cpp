@@ -15,7 +15,9 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
+#include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
@@ -50,6 +52,23 @@ using folly::Random;
 constexpr uint64_t kSizeMB = 1024UL * 1024UL;
 
 namespace {
+// Collects the runtime stats of the writer.
+class TestRuntimeStatWriter : public BaseRuntimeStatWriter {
+ public:
+  explicit TestRuntimeStatWriter(
+      std::unordered_map<std::string, RuntimeMetric>& stats)
+      : stats_{stats} {}
+
+  void addRuntimeStat(const std::string& name, const RuntimeCounter& value)
+      override {
+    stats_.emplace(name, RuntimeMetric(value.unit)).first->second.addValue(
+        value.value);
+  }
+
+ private:
+  std::unordered_map<std::string, RuntimeMetric>& stats_;
+};
+
 class E2EWriterTest : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -1090,6 +1109,57 @@ TEST_F(E2EWriterTest, OverflowLengthIncrements) {
       false);
 }
 
+TEST_F(E2EWriterTest, parallelFlush) {
+  const auto type = ROW({
+      {"int_val", INTEGER()},
+      {"long_val", BIGINT()},
+      {"double_val", DOUBLE()},
+      {"string_val", VARCHAR()},
+      {"array_val", ARRAY(BIGINT())},
+      {"map_val", MAP(INTEGER(), VARCHAR())},
+      {"struct_val", ROW({{"a", BIGINT()}, {"b", VARCHAR()}})},
+  });
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1000,
+          .nullRatio = 0.1,
+          .stringLength = 20,
+          .stringVariableLength = true,
+      },
+      leafPool_.get(),
+      folly::Random::rand32());
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  auto writeFile = [&](folly::Executor* flushExecutor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 64 << 10);
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.flushExecutor = flushExecutor;
+    options.flushParallelism = 4;
+    options.memoryPool = rootPool_.get();
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  // The file does not depend on whether the columns are flushed in parallel.
+  const auto serial = writeFile(nullptr);
+  const auto parallel = writeFile(executor.get());
+  ASSERT_EQ(serial, parallel);
+}
+
 class E2EEncryptionTest : public E2EWriterTest {
  protected:
   E2EEncryptionTest() : E2EWriterTest() {}
@@ -2109,4 +2179,74 @@ TEST_F(E2EWriterTest, memoryReclaimThreshold) {
     writer->close();
   }
 }
+
+TEST_F(E2EWriterTest, memoryReclaimAbandonsDictionaries) {
+  const auto type = ROW({{"string_val", VARCHAR()}});
+
+  // Distinct strings make the dictionary encoding inefficient.
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1000,
+          .nullRatio = 0,
+          .stringLength = 1'000,
+          .stringVariableLength = false,
+      },
+      leafPool_.get());
+  std::vector<VectorPtr> vectors;
+  for (int i = 0; i < 10; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(type));
+  }
+  const common::SpillConfig spillConfig = getSpillConfig(10, 20);
+  auto config = std::make_shared<dwrf::Config>();
+  config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1L << 30);
+  config->set<uint64_t>(dwrf::Config::MAX_DICTIONARY_SIZE, 1L << 30);
+
+  dwrf::WriterOptions options;
+  options.schema = type;
+  options.config = std::move(config);
+  tsan_atomic<bool> nonReclaimableSection{false};
+  options.nonReclaimableSection = &nonReclaimableSection;
+  options.spillConfig = &spillConfig;
+
+  auto writerPool = memory::memoryManager()->addRootPool(
+      "memoryReclaimAbandonsDictionaries",
+      1L << 30,
+      exec::MemoryReclaimer::create());
+  auto dwrfPool = writerPool->addAggregateChild("writer");
+  auto sinkPool =
+      writerPool->addLeafChild("sink", true, exec::MemoryReclaimer::create());
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024, FileSink::Options{.pool = sinkPool.get()});
+  auto* sinkPtr = sink.get();
+  auto writer =
+      std::make_unique<dwrf::Writer>(std::move(sink), options, dwrfPool);
+  {
+    memory::NonReclaimableSectionGuard nonReclaimableGuard(
+        &nonReclaimableSection);
+    for (const auto& vector : vectors) {
+      writer->write(vector);
+    }
+  }
+  auto& context = writer->getContext();
+  const auto dictionaryMemory =
+      context.getMemoryUsage(dwrf::MemoryUsageCategory::DICTIONARY);
+  ASSERT_GT(dictionaryMemory, 0);
+  ASSERT_EQ(context.stripeIndex(), 0);
+
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats;
+  TestRuntimeStatWriter statWriter(runtimeStats);
+  {
+    RuntimeStatWriterScopeGuard statGuard(&statWriter);
+    memory::MemoryReclaimer::Stats stats;
+    writerPool->reclaim(dictionaryMemory / 2, 0, stats);
+    ASSERT_EQ(stats.numNonReclaimableAttempts, 0);
+  }
+  ASSERT_EQ(runtimeStats.at("reclaimAbandonedDictionaryCount").sum, 1);
+  ASSERT_EQ(context.getMemoryUsage(dwrf::MemoryUsageCategory::DICTIONARY), 0);
+
+  writer->close();
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(*sinkPtr, readerOpts);
+  ASSERT_EQ(reader->numberOfRows().value(), 10 * 1000);
+}
 } // namespace
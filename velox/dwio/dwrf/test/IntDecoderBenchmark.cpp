@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+constexpr int32_t kNumValues = 1'000'000;
+constexpr int32_t kRunLength = 512;
+
+void appendBits(
+    std::vector<unsigned char>& out,
+    uint64_t& bit,
+    uint64_t value,
+    uint32_t width) {
+  for (int32_t i = width - 1; i >= 0; --i) {
+    if (bit % 8 == 0) {
+      out.push_back(0);
+    }
+    if ((value >> i) & 1) {
+      out.back() |= 0x80 >> (bit % 8);
+    }
+    ++bit;
+  }
+}
+
+uint32_t encodeBitWidth(uint32_t width) {
+  if (width <= 24) {
+    return width - 1;
+  }
+  return width <= 32 ? 24 + (width - 26) / 2 : 28 + (width - 40) / 8;
+}
+
+// Returns 'kNumValues' unsigned values of 'width' bits in DIRECT runs if
+// 'delta' is false, or in DELTA runs with deltas of 'width' bits otherwise.
+std::vector<unsigned char> encode(uint32_t width, bool delta) {
+  std::vector<unsigned char> out;
+  const auto mask = bits::lowMask(width);
+  uint64_t random = 1;
+  for (auto start = 0; start < kNumValues; start += kRunLength) {
+    out.push_back(
+        (delta ? 0xc0 : 0x40) | (encodeBitWidth(width) << 1) |
+        ((kRunLength - 1) >> 8));
+    out.push_back((kRunLength - 1) & 0xff);
+    auto numPacked = kRunLength;
+    if (delta) {
+      // Unsigned first value 0 and delta base 1 as zigzag varint.
+      out.push_back(0);
+      out.push_back(2);
+      numPacked -= 2;
+    }
+    uint64_t bit = 0;
+    for (auto i = 0; i < numPacked; ++i) {
+      random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+      appendBits(out, bit, (random >> 11) & mask, width);
+    }
+  }
+  return out;
+}
+
+void decode(uint32_t iters, uint32_t width, bool delta) {
+  std::vector<unsigned char> encoded;
+  std::vector<int64_t> values(kRunLength * 2);
+  std::shared_ptr<memory::MemoryPool> pool;
+  BENCHMARK_SUSPEND {
+    encoded = encode(width, delta);
+    pool = memory::memoryManager()->addLeafPool();
+  }
+  for (auto iter = 0; iter < iters; ++iter) {
+    auto decoder = createRleDecoder<false>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            encoded.data(), encoded.size()),
+        RleVersion_2,
+        *pool,
+        true,
+        dwio::common::INT_BYTE_SIZE);
+    for (auto i = 0; i + values.size() <= kNumValues; i += values.size()) {
+      decoder->next(values.data(), values.size(), nullptr);
+    }
+    folly::doNotOptimizeAway(values);
+  }
+}
+
+void decodeDirect(uint32_t iters, uint32_t width) {
+  decode(iters, width, false);
+}
+
+void decodeDelta(uint32_t iters, uint32_t width) {
+  decode(iters, width, true);
+}
+} // namespace
+
+BENCHMARK_PARAM(decodeDirect, 1)
+BENCHMARK_PARAM(decodeDirect, 7)
+BENCHMARK_PARAM(decodeDirect, 12)
+BENCHMARK_PARAM(decodeDirect, 17)
+BENCHMARK_PARAM(decodeDirect, 24)
+BENCHMARK_PARAM(decodeDirect, 32)
+BENCHMARK_PARAM(decodeDirect, 48)
+BENCHMARK_PARAM(decodeDirect, 64)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(decodeDelta, 4)
+BENCHMARK_PARAM(decodeDelta, 12)
+BENCHMARK_PARAM(decodeDelta, 24)
+BENCHMARK_PARAM(decodeDelta, 40)
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
@@ -30,10 +30,12 @@ std::vector<int64_t> decodeRLEv2(
     unsigned long l,
     size_t n,
     size_t count,
-    const uint64_t* nulls = nullptr) {
+    const uint64_t* nulls = nullptr,
+    uint64_t blockSize = 0) {
   auto pool = memory::memoryManager()->addLeafPool();
   std::unique_ptr<dwio::common::IntDecoder<true>> rle = createRleDecoder<true>(
-      std::make_unique<dwio::common::SeekableArrayInputStream>(bytes, l),
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          bytes, l, blockSize),
       RleVersion_2,
       *pool,
       true /* doesn't matter */,
@@ -673,6 +675,174 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+// Appends 'value' to 'out' in 'width' bits, most significant bit first, at
+// bit 'bit' of 'out'.
+void appendBits(
+    std::vector<unsigned char>& out,
+    uint64_t& bit,
+    uint64_t value,
+    uint32_t width) {
+  for (int32_t i = width - 1; i >= 0; --i) {
+    if (bit % 8 == 0) {
+      out.push_back(0);
+    }
+    if ((value >> i) & 1) {
+      out.back() |= 0x80 >> (bit % 8);
+    }
+    ++bit;
+  }
+}
+
+void appendVarint(std::vector<unsigned char>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(0x80 | (value & 0x7f));
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+}
+
+// Returns the 5 bit code of the RLEv2 bit width 'width'.
+uint32_t encodeBitWidth(uint32_t width) {
+  if (width <= 24) {
+    return width - 1;
+  }
+  switch (width) {
+    case 26:
+      return 24;
+    case 28:
+      return 25;
+    case 30:
+      return 26;
+    case 32:
+      return 27;
+    case 40:
+      return 28;
+    case 48:
+      return 29;
+    case 56:
+      return 30;
+    default:
+      VELOX_CHECK_EQ(width, 64);
+      return 31;
+  }
+}
+
+// Encodes 'values' as DIRECT runs of at most 512 values of 'width' bits.
+std::vector<unsigned char> encodeDirect(
+    const std::vector<int64_t>& values,
+    uint32_t width) {
+  std::vector<unsigned char> out;
+  for (size_t start = 0; start < values.size(); start += 512) {
+    const auto length = std::min<size_t>(512, values.size() - start);
+    out.push_back(
+        0x40 | (encodeBitWidth(width) << 1) | ((length - 1) >> 8));
+    out.push_back((length - 1) & 0xff);
+    uint64_t bit = 0;
+    for (auto i = start; i < start + length; ++i) {
+      appendBits(out, bit, zigzag(values[i]), width);
+    }
+  }
+  return out;
+}
+
+// Encodes a DELTA run that starts at 'first' and continues with 'deltaBase'
+// and then with 'deltas' of 'width' bits, subtracted if 'deltaBase' is
+// negative. Returns the encoding and sets 'values' to the decoded values.
+std::vector<unsigned char> encodeDelta(
+    int64_t first,
+    int64_t deltaBase,
+    const std::vector<uint64_t>& deltas,
+    uint32_t width,
+    std::vector<int64_t>& values) {
+  const auto length = deltas.size() + 2;
+  std::vector<unsigned char> out;
+  out.push_back(0xc0 | (encodeBitWidth(width) << 1) | ((length - 1) >> 8));
+  out.push_back((length - 1) & 0xff);
+  appendVarint(out, zigzag(first));
+  appendVarint(out, zigzag(deltaBase));
+  values = {first, first + deltaBase};
+  uint64_t bit = 0;
+  for (auto delta : deltas) {
+    appendBits(out, bit, delta, width);
+    values.push_back(
+        deltaBase < 0 ? values.back() - static_cast<int64_t>(delta)
+                      : values.back() + static_cast<int64_t>(delta));
+  }
+  return out;
+}
+
+TEST_F(RLEv2Test, directAllWidths) {
+  const size_t count = 1000;
+  std::vector<uint64_t> nulls(bits::nwords(count), bits::kNotNull64);
+  for (size_t i = 0; i < count; i += 3) {
+    bits::setNull(nulls.data(), i);
+  }
+  for (uint32_t width :
+       {1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+        17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64}) {
+    SCOPED_TRACE(fmt::format("width {}", width));
+    std::vector<int64_t> values;
+    const auto mask = bits::lowMask(width);
+    for (size_t i = 0; i < count; ++i) {
+      const uint64_t encoded = (i * 0x9e3779b97f4a7c15ULL) & mask;
+      values.push_back((encoded >> 1) ^ -(encoded & 1));
+    }
+    const auto bytes = encodeDirect(values, width);
+    // Reads in batches that end inside bytes and in buffers that end in the
+    // middle of values.
+    for (auto batch : {1, 3, 7, 100, 1000}) {
+      for (auto blockSize : {0, 13}) {
+        checkResults(
+            values,
+            decodeRLEv2(
+                bytes.data(), bytes.size(), batch, count, nullptr, blockSize),
+            batch);
+      }
+    }
+    std::vector<int64_t> nonNulls;
+    for (size_t i = 0; i < count; ++i) {
+      if (!bits::isBitNull(nulls.data(), i)) {
+        nonNulls.push_back(values[i]);
+      }
+    }
+    const auto bytesWithNulls = encodeDirect(nonNulls, width);
+    checkResults(
+        values,
+        decodeRLEv2(
+            bytesWithNulls.data(),
+            bytesWithNulls.size(),
+            7,
+            count,
+            nulls.data()),
+        7,
+        nulls.data());
+  }
+}
+
+TEST_F(RLEv2Test, deltaWideDeltas) {
+  for (auto deltaBase : {7, -7}) {
+    for (uint32_t width : {5, 13, 24, 40}) {
+      SCOPED_TRACE(fmt::format("deltaBase {} width {}", deltaBase, width));
+      std::vector<uint64_t> deltas;
+      for (auto i = 0; i < 510; ++i) {
+        deltas.push_back((i * 0x9e3779b97f4a7c15ULL) & bits::lowMask(width));
+      }
+      std::vector<int64_t> values;
+      const auto bytes = encodeDelta(1000, deltaBase, deltas, width, values);
+      for (auto batch : {1, 5, 100, 512}) {
+        checkResults(
+            values,
+            decodeRLEv2(bytes.data(), bytes.size(), batch, values.size()),
+            batch);
+      }
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
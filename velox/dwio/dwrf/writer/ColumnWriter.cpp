@@ -15,8 +15,12 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+
+#include <deque>
+
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -1613,12 +1617,42 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
+    auto* executor = isRoot() ? context_.flushExecutor() : nullptr;
+    if (executor == nullptr || children_.size() < 2) {
+      for (auto& c : children_) {
+        c->flush(encodingFactory);
+      }
+      return;
     }
+    flushChildrenInParallel(executor, encodingFactory);
   }
 
  private:
+  // Flushes the top level columns on 'executor'. The encodings of each column
+  // are collected separately and added in the order of a serial flush so that
+  // the file does not depend on the parallelism.
+  void flushChildrenInParallel(
+      folly::Executor* executor,
+      const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory) {
+    std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+        childEncodings(children_.size());
+    dwio::common::ParallelFor(
+        executor, 0, children_.size(), context_.flushParallelism())
+        .execute([&](size_t i) {
+          auto& encodings = childEncodings[i];
+          children_[i]->flush(
+              [&](uint32_t nodeId) -> proto::ColumnEncoding& {
+                return encodings.emplace_back(nodeId, proto::ColumnEncoding())
+                    .second;
+              });
+        });
+    for (auto& encodings : childEncodings) {
+      for (auto& [nodeId, encoding] : encodings) {
+        encodingFactory(nodeId).CopyFrom(encoding);
+      }
+    }
+  }
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
@@ -76,6 +76,7 @@ Writer::Writer(
   writerBase_->initContext(options.config, pool, std::move(handler));
 
   auto& context = writerBase_->getContext();
+  context.setFlushExecutor(options.flushExecutor, options.flushParallelism);
   VELOX_CHECK_EQ(
       context.getTotalMemoryUsage(),
       0,
@@ -382,6 +383,23 @@ void Writer::enterLowMemoryMode() {
   }
 }
 
+bool Writer::tryAbandonDictionariesOnReclaim(uint64_t targetBytes) {
+  auto& context = getContext();
+  // The encodings can only be switched in the first stripe. The switch itself
+  // takes memory, so it is only worth it if the dictionaries alone hold
+  // 'targetBytes'.
+  if (context.stripeIndex() != 0 ||
+      context.getMemoryUsage(MemoryUsageCategory::DICTIONARY) < targetBytes) {
+    return false;
+  }
+  if (!writer_->tryAbandonDictionaries(false)) {
+    return false;
+  }
+  addThreadLocalRuntimeStat(
+      "reclaimAbandonedDictionaryCount", RuntimeCounter(1));
+  return true;
+}
+
 void Writer::flushStripe(bool close) {
   auto& context = writerBase_->getContext();
   const int64_t preFlushStreamMemoryUsage =
@@ -560,6 +578,13 @@ void Writer::flushStripe(bool close) {
   addThreadLocalRuntimeStat(
       "stripeSize",
       RuntimeCounter(metrics.stripeSize, RuntimeCounter::Unit::kBytes));
+  if (memory::underMemoryArbitration()) {
+    // Stripes cut short by memory reclaim, to tell them apart from the ones
+    // that reached the flush policy thresholds.
+    addThreadLocalRuntimeStat(
+        "reclaimFlushedStripeSize",
+        RuntimeCounter(metrics.stripeSize, RuntimeCounter::Unit::kBytes));
+  }
   // Add flush overhead and other ratio logging.
   context.metricLogger()->logStripeFlush(metrics);
 
@@ -761,8 +786,20 @@ uint64_t Writer::MemoryReclaimer::reclaim(
 
   auto reclaimBytes = memory::MemoryReclaimer::run(
       [&]() {
+        // Switching the inefficient dictionaries of the first stripe to direct
+        // encoding frees their dictionary memory without cutting the stripe
+        // short. Only flush the stripe if that does not free 'targetBytes'.
+        uint64_t reclaimedBytes{0};
+        if (targetBytes > 0 &&
+            writer_->tryAbandonDictionariesOnReclaim(targetBytes)) {
+          reclaimedBytes = pool->shrink(targetBytes);
+          if (reclaimedBytes >= targetBytes) {
+            return reclaimedBytes;
+          }
+        }
         writer_->flushInternal(false);
-        return pool->shrink(targetBytes);
+        return reclaimedBytes +
+            pool->shrink(targetBytes == 0 ? 0 : targetBytes - reclaimedBytes);
       },
       stats);
   return reclaimBytes;
@@ -802,6 +839,8 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.flushExecutor = options.flushExecutor;
+  dwrfOptions.flushParallelism = options.flushParallelism;
   return dwrfOptions;
 }
 
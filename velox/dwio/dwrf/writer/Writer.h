@@ -47,6 +47,11 @@ struct WriterOptions {
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
+  /// If set, the top level columns of a stripe are encoded and compressed on
+  /// up to 'flushParallelism' threads of 'flushExecutor' when the stripe is
+  /// flushed. Not used for encrypted files.
+  folly::Executor* flushExecutor{nullptr};
+  size_t flushParallelism{0};
   std::function<std::unique_ptr<ColumnWriter>(
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
@@ -196,6 +201,12 @@ class Writer : public dwio::common::Writer {
 
   void flushStripe(bool close);
 
+  // Invoked by memory reclaim before flushing the stripe. Switches the first
+  // stripe dictionaries that are not efficient enough to direct encoding if
+  // the dictionary memory covers 'targetBytes'. Returns true if any encoding
+  // was switched.
+  bool tryAbandonDictionariesOnReclaim(uint64_t targetBytes);
+
   void createRowIndexEntry() {
     writer_->createIndexEntry();
     writerBase_->getContext().resetIndexRowCount();
@@ -17,6 +17,10 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -47,11 +51,15 @@ class WriterContext : public CompressionBufferPool {
 
   ~WriterContext() override;
 
+  // The accessors of 'streams_' lock 'streamsMutex_' because the columns of a
+  // stripe may be flushed in parallel, see setFlushExecutor().
   bool hasStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.find(stream) != streams_.end();
   }
 
   const DataBufferHolder& getStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.at(stream);
   }
 
@@ -71,10 +79,8 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(
-        !hasStream(stream), "Stream already exists: {}", stream.toString());
-
-    streams_.emplace(
+    std::unique_lock<std::mutex> l(streamsMutex_);
+    auto [it, inserted] = streams_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(stream),
         std::forward_as_tuple(
@@ -82,7 +88,9 @@ class WriterContext : public CompressionBufferPool {
             compressionBlockSize(),
             getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
             getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
+    VELOX_CHECK(inserted, "Stream already exists: {}", stream.toString());
+    auto& holder = it->second;
+    l.unlock();
     auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
@@ -143,9 +151,32 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(hasStream(stream));
-    auto& collector = streams_.at(stream);
-    collector.suppress();
+    std::lock_guard<std::mutex> l(streamsMutex_);
+    auto it = streams_.find(stream);
+    VELOX_CHECK(it != streams_.end());
+    it->second.suppress();
+  }
+
+  /// Makes the writer flush the top level columns of a stripe on up to
+  /// 'parallelism' threads of 'executor'. The columns are encoded and their
+  /// streams compressed in parallel. The file content does not depend on the
+  /// parallelism.
+  void setFlushExecutor(folly::Executor* executor, size_t parallelism) {
+    flushExecutor_ = executor;
+    flushParallelism_ = parallelism;
+  }
+
+  /// Returns the executor for flushing columns in parallel if the columns can
+  /// be flushed in parallel, else nullptr. Encrypted columns are flushed on the
+  /// writer thread.
+  folly::Executor* flushExecutor() const {
+    return flushParallelism_ > 1 && !handler_->isEncrypted()
+        ? flushExecutor_
+        : nullptr;
+  }
+
+  size_t flushParallelism() const {
+    return flushParallelism_;
   }
 
   bool isStreamPaged(uint32_t nodeId) const {
@@ -235,6 +266,7 @@ class WriterContext : public CompressionBufferPool {
 
   virtual void removeStreams(
       std::function<bool(const DwrfStreamIdentifier&)> predicate) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     auto it = streams_.begin();
     while (it != streams_.end()) {
       if (predicate(it->first)) {
@@ -249,7 +281,14 @@ class WriterContext : public CompressionBufferPool {
 
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ == nullptr) {
+      // Columns flushing in parallel compress into buffers of their own. There
+      // are at most 'flushParallelism_' of these at a time.
+      VELOX_CHECK_NOT_NULL(flushExecutor_);
+      return std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
   }
@@ -257,8 +296,12 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    // The extra buffers of a parallel flush are freed so that the memory
+    // usage after the flush is the same as for a serial flush.
+    if (compressionBuffer_ == nullptr) {
+      compressionBuffer_ = std::move(buffer);
+    }
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -627,6 +670,7 @@ class WriterContext : public CompressionBufferPool {
       DataBufferHolder,
       dwio::common::StreamIdentifierHash>
       streams_;
+  mutable std::mutex streamsMutex_;
   folly::F14NodeMap<uint32_t, std::unique_ptr<PhysicalSizeAggregator>>
       physicalSizeAggregators_;
   folly::F14FastMap<
@@ -638,6 +682,9 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  std::mutex compressionBufferMutex_;
+  folly::Executor* flushExecutor_{nullptr};
+  size_t flushParallelism_{0};
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Salt for the bit selected in each word of a block.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+inline uint32_t bitInWord(uint32_t key, int32_t word) {
+  return 1U << ((key * kSalt[word]) >> 27);
+}
+} // namespace
+
+BloomFilter::BloomFilter(BufferPtr bitset, int32_t numBytes)
+    : bitset_(std::move(bitset)), numBlocks_(numBytes / kBytesPerBlock) {
+  VELOX_CHECK_GT(numBytes, 0);
+  VELOX_CHECK_EQ(numBytes % kBytesPerBlock, 0);
+  VELOX_CHECK_GE(bitset_->capacity(), numBytes);
+}
+
+// static
+uint64_t BloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+bool BloomFilter::mayContain(uint64_t hash) const {
+  const auto key = static_cast<uint32_t>(hash);
+  const auto* words = block(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if ((words[i] & bitInWord(key, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::insert(uint64_t hash) {
+  const auto key = static_cast<uint32_t>(hash);
+  auto* words = bitset_->asMutable<uint32_t>() +
+      blockIndex(hash) * kWordsPerBlock;
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    words[i] |= bitInWord(key, i);
+  }
+}
+
+bool BloomFilter::testFilter(
+    const common::Filter& filter,
+    thrift::Type::type physicalType) const {
+  // The bloom filter has only the non-null values.
+  if (filter.testNull()) {
+    return true;
+  }
+  auto mayContainBigint = [&](int64_t value) {
+    switch (physicalType) {
+      case thrift::Type::INT32:
+        if (value < std::numeric_limits<int32_t>::min() ||
+            value > std::numeric_limits<int32_t>::max()) {
+          return true;
+        }
+        return mayContain(hash(static_cast<int32_t>(value)));
+      case thrift::Type::INT64:
+        return mayContain(hash(value));
+      default:
+        return true;
+    }
+  };
+  auto mayContainAnyBigint = [&](const std::vector<int64_t>& values) {
+    for (auto value : values) {
+      if (mayContainBigint(value)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      return !range.isSingleValue() || mayContainBigint(range.lower());
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return mayContainAnyBigint(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values());
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return mayContainAnyBigint(
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values());
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      return physicalType != thrift::Type::BYTE_ARRAY ||
+          !range.isSingleValue() || mayContain(hash(range.lower()));
+    }
+    case common::FilterKind::kBytesValues: {
+      if (physicalType != thrift::Type::BYTE_ARRAY) {
+        return true;
+      }
+      for (const auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (mayContain(hash(value))) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block bloom filter of a Parquet column chunk. See
+/// https://github.com/apache/parquet-format/blob/master/BloomFilter.md. The
+/// bitset is made of 32 byte blocks of eight 32 bit words. A value sets one
+/// bit in each word of the block selected by the high half of its XXH64 hash.
+class BloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Makes a filter over 'bitset' of 'numBytes' bytes. 'numBytes' must be a
+  /// positive multiple of kBytesPerBlock.
+  BloomFilter(BufferPtr bitset, int32_t numBytes);
+
+  /// Hashes of values as computed by Parquet writers: XXH64 with seed 0 of
+  /// the PLAIN encoding of the value, without length for BYTE_ARRAY.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+  /// Returns false if a value with 'hash' is definitely not in the filter.
+  bool mayContain(uint64_t hash) const;
+
+  /// Adds a value with 'hash' to the filter.
+  void insert(uint64_t hash);
+
+  /// Returns false if no value stored as 'physicalType' and passing 'filter'
+  /// is in 'this'. Returns true if the filter kind does not enumerate its
+  /// values or if null values may pass.
+  bool testFilter(
+      const common::Filter& filter,
+      thrift::Type::type physicalType) const;
+
+ private:
+  const uint32_t* block(uint64_t hash) const {
+    return bitset_->as<uint32_t>() + blockIndex(hash) * kWordsPerBlock;
+  }
+
+  int64_t blockIndex(uint64_t hash) const {
+    return ((hash >> 32) * numBlocks_) >> 32;
+  }
+
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  BufferPtr bitset_;
+  const int64_t numBlocks_;
+};
+
+} // namespace facebook::velox::parquet
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/DecoderUtil.h"
 
 namespace facebook::velox::parquet {
 
@@ -157,6 +160,53 @@ class DeltaBpDecoder {
         "delta bit width larger than integer bit width");
     deltaBitWidth_ = bitWidth;
     valuesRemainingCurrentMiniBlock_ = valuesPerMiniBlock_;
+    decodeMiniBlock();
+  }
+
+  // Unpacks the deltas of the miniblock at 'bufferStart_' and turns them into
+  // values in 'miniBlockValues_', so that readLong() only has to pick them
+  // up. Decodes no more values than remain in the page, since the padding of
+  // the last miniblock need not be written out.
+  void decodeMiniBlock() {
+    const auto numValues =
+        std::min(valuesPerMiniBlock_, totalValuesRemaining_);
+    miniBlockValues_.resize(numValues);
+    auto* values = miniBlockValues_.data();
+    const auto* data = reinterpret_cast<const uint8_t*>(bufferStart_);
+    const uint64_t width = deltaBitWidth_;
+    if (width == 0) {
+      std::fill(values, values + numValues, 0);
+    } else {
+      const uint64_t miniBlockBytes = bits::nbytes(width * valuesPerMiniBlock_);
+      uint64_t i = 0;
+      uint64_t bit = 0;
+      if (width <= kMaxWordUnpackBits) {
+        // A 64 bit load at the byte of the first bit covers the whole value.
+        const uint64_t mask = bits::lowMask(width);
+        while (i < numValues &&
+               (bit >> 3) + sizeof(uint64_t) <= miniBlockBytes) {
+          const auto word = folly::loadUnaligned<uint64_t>(data + (bit >> 3));
+          values[i++] = (word >> (bit & 7)) & mask;
+          bit += width;
+        }
+      }
+      for (; i < numValues; ++i, bit += width) {
+        values[i] = 0;
+        bits::copyBits(
+            reinterpret_cast<const uint64_t*>(bufferStart_),
+            bit,
+            &values[i],
+            0,
+            width);
+      }
+    }
+    // Addition between minDelta_, packed int and lastValue_ should be treated
+    // as unsigned addition. Overflow is as expected.
+    for (uint64_t i = 0; i < numValues; ++i) {
+      values[i] += static_cast<uint64_t>(minDelta_);
+    }
+    dwio::common::prefixSum(
+        values, numValues, static_cast<uint64_t>(lastValue_));
   }
 
   int64_t readLong() {
@@ -184,19 +234,8 @@ class DeltaBpDecoder {
       }
     }
 
-    uint64_t consumedBits =
-        (valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_) *
-        deltaBitWidth_;
-    bits::copyBits(
-        reinterpret_cast<const uint64_t*>(bufferStart_),
-        consumedBits,
-        reinterpret_cast<uint64_t*>(&value),
-        0,
-        deltaBitWidth_);
-    // Addition between minDelta_, packed int and lastValue_ should be treated
-    // as unsigned addition. Overflow is as expected.
-    value = static_cast<uint64_t>(minDelta_) + static_cast<uint64_t>(value) +
-        static_cast<uint64_t>(lastValue_);
+    const auto index = valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_;
+    value = miniBlockValues_[index];
     lastValue_ = value;
     valuesRemainingCurrentMiniBlock_--;
     totalValuesRemaining_--;
@@ -210,6 +249,10 @@ class DeltaBpDecoder {
   static constexpr int kMaxDeltaBitWidth =
       static_cast<int>(sizeof(int64_t) * 8);
 
+  // Widest delta that decodeMiniBlock() can extract from a single 64 bit
+  // load at any bit offset.
+  static constexpr uint64_t kMaxWordUnpackBits = 57;
+
   const char* bufferStart_;
 
   uint64_t valuesPerBlock_;
@@ -230,6 +273,8 @@ class DeltaBpDecoder {
   uint64_t miniBlockIdx_;
   std::vector<uint8_t> deltaBitWidths_;
   uint64_t deltaBitWidth_;
+  // The values of the current miniblock.
+  std::vector<uint64_t> miniBlockValues_;
 
   int64_t lastValue_;
 };
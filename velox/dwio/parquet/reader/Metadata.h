@@ -21,6 +21,18 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Builds the ColumnStatistics for a column of 'type' from the thrift
+/// 'columnChunkStats' covering 'numRows' rows. Used for both ColumnChunk
+/// statistics and the page level bounds of a ColumnIndex.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRows);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -65,6 +77,29 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the ColumnIndex (page level min/max) location.
+  bool hasColumnIndex() const;
+
+  /// File offset and length of the ColumnIndex of this column chunk.
+  /// Must check for its presence using hasColumnIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// Check the presence of the OffsetIndex (page locations) location.
+  bool hasOffsetIndex() const;
+
+  /// File offset and length of the OffsetIndex of this column chunk.
+  /// Must check for its presence using hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of a bloom filter for this column chunk.
+  bool hasBloomFilterOffset() const;
+
+  /// File offset of the bloom filter header, followed by the bitset.
+  /// Must check for its presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
  private:
   const void* ptr_;
 };
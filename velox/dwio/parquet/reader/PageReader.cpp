@@ -46,10 +46,14 @@ void PageReader::seekToPage(int64_t row) {
 
     switch (pageHeader.type) {
       case thrift::PageType::DATA_PAGE:
-        prepareDataPageV1(pageHeader, row);
+        if (!skipPrunedPage(pageHeader, row)) {
+          prepareDataPageV1(pageHeader, row);
+        }
         break;
       case thrift::PageType::DATA_PAGE_V2:
-        prepareDataPageV2(pageHeader, row);
+        if (!skipPrunedPage(pageHeader, row)) {
+          prepareDataPageV2(pageHeader, row);
+        }
         break;
       case thrift::PageType::DICTIONARY_PAGE:
         if (row == kRepDefOnly) {
@@ -189,6 +193,27 @@ void PageReader::updateRowInfoAfterPageSkipped() {
   }
 }
 
+bool PageReader::skipPrunedPage(const PageHeader& pageHeader, int64_t row) {
+  ++dataPageIndex_;
+  pagePruned_ = row != kRepDefOnly && dataPageIndex_ < prunedPages_.size() &&
+      prunedPages_[dataPageIndex_];
+  if (!pagePruned_) {
+    return false;
+  }
+  // Pruning is only set for top level columns, so the number of values is the
+  // number of rows.
+  numRepDefsInPage_ = pageHeader.type == thrift::PageType::DATA_PAGE
+      ? pageHeader.data_page_header.num_values
+      : pageHeader.data_page_header_v2.num_values;
+  numRowsInPage_ = numRepDefsInPage_;
+  dwio::common::skipBytes(
+      pageHeader.compressed_page_size,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  return true;
+}
+
 void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   VELOX_CHECK(
       pageHeader.type == thrift::PageType::DATA_PAGE &&
@@ -472,6 +497,7 @@ void PageReader::makeFilterCache(dwio::common::ScanState& state) {
       dwio::common::FilterResult::kUnknown,
       state.filterCache.size());
   state.rawState.filterCache = state.filterCache.data();
+  filterCacheFilled_ = false;
 }
 
 namespace {
@@ -526,6 +552,7 @@ void PageReader::preloadRepDefs() {
   bufferStart_ = bufferEnd_ = nullptr;
   rowOfPage_ = 0;
   numRowsInPage_ = 0;
+  dataPageIndex_ = -1;
   pageData_ = nullptr;
 }
 
@@ -665,6 +692,10 @@ void PageReader::skip(int64_t numRows) {
     toSkip -= rowOfPage_ - firstUnvisited_;
   }
   firstUnvisited_ += numRows;
+  if (pagePruned_) {
+    // The values of a pruned page are never decoded.
+    return;
+  }
 
   // Skip nulls
   toSkip = skipNulls(toSkip);
@@ -784,18 +815,27 @@ bool PageReader::rowsForPage(
     bool mayProduceNulls,
     folly::Range<const vector_size_t*>& rows,
     const uint64_t* FOLLY_NULLABLE& nulls) {
-  if (currentVisitorRow_ == numVisitorRows_) {
-    return false;
-  }
-  int32_t numToVisit;
-  // Check if the first row to go to is in the current page. If not, seek to the
-  // page that contains the row.
-  auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
-  if (rowZero >= rowOfPage_ + numRowsInPage_) {
-    seekToPage(rowZero);
-    if (hasChunkRepDefs_) {
-      numLeafNullsConsumed_ = rowOfPage_;
+  for (;;) {
+    if (currentVisitorRow_ == numVisitorRows_) {
+      return false;
+    }
+    // Check if the first row to go to is in the current page. If not, seek to
+    // the page that contains the row.
+    auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
+    if (rowZero >= rowOfPage_ + numRowsInPage_) {
+      seekToPage(rowZero);
+      if (hasChunkRepDefs_) {
+        numLeafNullsConsumed_ = rowOfPage_;
+      }
     }
+    if (!pagePruned_) {
+      break;
+    }
+    // No row on a pruned page passes the filter. The rows on the page are
+    // consumed without decoding.
+    VELOX_CHECK(hasFilter, "Visiting a pruned page without a filter");
+    currentVisitorRow_ += numVisitorRowsOnPage();
+    firstUnvisited_ = visitBase_ + visitorRows_[currentVisitorRow_ - 1] + 1;
   }
   auto& scanState = reader.scanState();
   if (isDictionary()) {
@@ -826,21 +866,7 @@ bool PageReader::rowsForPage(
 
   // Then check how many of the rows to visit are on the same page as the
   // current one.
-  int32_t firstOnNextPage = rowOfPage_ + numRowsInPage_ - visitBase_;
-  if (firstOnNextPage > visitorRows_[numVisitorRows_ - 1]) {
-    // All the remaining rows are on this page.
-    numToVisit = numVisitorRows_ - currentVisitorRow_;
-  } else {
-    // Find the last row in the rows to visit that is on this page.
-    auto rangeLeft = folly::Range<const int32_t*>(
-        visitorRows_ + currentVisitorRow_,
-        numVisitorRows_ - currentVisitorRow_);
-    auto it =
-        std::lower_bound(rangeLeft.begin(), rangeLeft.end(), firstOnNextPage);
-    assert(it != rangeLeft.end());
-    assert(it != rangeLeft.begin());
-    numToVisit = it - (visitorRows_ + currentVisitorRow_);
-  }
+  const int32_t numToVisit = numVisitorRowsOnPage();
   // If the page did not change and this is the first call, we can return a view
   // on the original visitor rows.
   if (rowOfPage_ == initialRowOfPage_ && currentVisitorRow_ == 0) {
@@ -878,6 +904,22 @@ bool PageReader::rowsForPage(
   return true;
 }
 
+int32_t PageReader::numVisitorRowsOnPage() const {
+  int32_t firstOnNextPage = rowOfPage_ + numRowsInPage_ - visitBase_;
+  if (firstOnNextPage > visitorRows_[numVisitorRows_ - 1]) {
+    // All the remaining rows are on this page.
+    return numVisitorRows_ - currentVisitorRow_;
+  }
+  // Find the last row in the rows to visit that is on this page.
+  auto rangeLeft = folly::Range<const int32_t*>(
+      visitorRows_ + currentVisitorRow_, numVisitorRows_ - currentVisitorRow_);
+  auto it =
+      std::lower_bound(rangeLeft.begin(), rangeLeft.end(), firstOnNextPage);
+  assert(it != rangeLeft.end());
+  assert(it != rangeLeft.begin());
+  return it - (visitorRows_ + currentVisitorRow_);
+}
+
 const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
   if (!dictionaryValues_) {
     dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
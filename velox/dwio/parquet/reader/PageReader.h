@@ -137,6 +137,16 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Sets the data pages of the ColumnChunk that cannot have rows passing the
+  /// filter of the column. 'prunedPages' has a flag per data page in file
+  /// order, as given by the OffsetIndex. The data of pruned pages is skipped
+  /// without decompressing and visiting rows on them produces no hits. Only
+  /// applies to top level columns read with a filter.
+  void setPrunedPages(std::vector<bool> prunedPages) {
+    VELOX_CHECK(isTopLevel_);
+    prunedPages_ = std::move(prunedPages);
+  }
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -188,6 +198,15 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // Returns true if the data page with 'pageHeader' is marked in
+  // 'prunedPages_'. In this case sets the row info for the page and skips its
+  // data without decompressing or making a decoder.
+  bool skipPrunedPage(const thrift::PageHeader& pageHeader, int64_t row);
+
+  // Returns the number of rows in 'visitorRows_' starting at
+  // 'currentVisitorRow_' that are on the current page.
+  int32_t numVisitorRowsOnPage() const;
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
@@ -373,6 +392,17 @@ class PageReader {
   // Number of leaf values in each data page of column chunk.
   std::vector<int32_t> numLeavesInPage_;
 
+  // Flag per data page of the column chunk. True if no row in the page can
+  // pass the filter. Set from the page index of the column chunk.
+  std::vector<bool> prunedPages_;
+
+  // Ordinal of the current data page in the column chunk. -1 means before
+  // first data page.
+  int32_t dataPageIndex_{-1};
+
+  // True if the current page is in 'prunedPages_'. Its values are not decoded.
+  bool pagePruned_{false};
+
   // First position in '*levels_' for the range of last decodeRepDefs().
   int32_t repDefBegin_{0};
 
@@ -420,6 +450,9 @@ class PageReader {
 
   // Dictionary contents.
   dwio::common::DictionaryValues dictionary_;
+  // True if the filter cache of the reader holds the filter results for all
+  // entries of 'dictionary_'.
+  bool filterCacheFilled_{false};
   thrift::Encoding::type dictionaryEncoding_;
 
   // Offset of current page's header from start of ColumnChunk.
@@ -518,6 +551,15 @@ void PageReader::readWithVisitor(Visitor& visitor) {
     int32_t numValuesBeforePage = numRowsInReader<hasFilter>(reader);
     visitor.setNumValuesBias(numValuesBeforePage);
     visitor.setRows(pageRows);
+    if constexpr (hasFilter && Visitor::FilterType::deterministic) {
+      if (isDictionary() && !filterCacheFilled_ &&
+          visitor.filter().isDeterministic()) {
+        const auto& state = reader.scanState().rawState;
+        dwio::common::fillFilterCache<typename Visitor::DataType>(
+            visitor.filter(), state.dictionary, state.filterCache);
+        filterCacheFilled_ = true;
+      }
+    }
     callDecoder(nulls, nullsFromFastPath, visitor);
     if (currentVisitorRow_ < numVisitorRows_ || isMultiPage) {
       if (mayProduceNulls) {
@@ -17,13 +17,24 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
 
 namespace facebook::velox::parquet {
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type,
+      metaData_,
+      pool(),
+      &scanSpec,
+      &runtimeStatistics(),
+      bloomFilterSource_);
 }
 
 void ParquetData::filterRowGroups(
@@ -48,6 +59,16 @@ void ParquetData::filterRowGroups(
         bits::setBit(result.filterResult.data(), i);
         continue;
       }
+      // Bloom filters cost I/O, so these are not read for row groups already
+      // excluded by another column.
+      if (scanSpec.filter() && !bits::isBitSet(result.filterResult.data(), i) &&
+          !bloomFilterMatches(i, *scanSpec.filter())) {
+        bits::setBit(result.filterResult.data(), i);
+        if (stats_) {
+          ++stats_->skippedStridesByBloomFilter;
+        }
+        continue;
+      }
       for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
         auto* metadataFilter = scanSpec.metadataFilterAt(j);
         if (!rowGroupMatches(i, metadataFilter)) {
@@ -80,6 +101,77 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  if (!bloomFilterSource_.has_value() || !type_->parquetType_.has_value() ||
+      filter.testNull()) {
+    return true;
+  }
+  auto chunk =
+      fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(type_->column());
+  if (!chunk.hasBloomFilterOffset()) {
+    return true;
+  }
+  const auto rowGroupOffset = getRowGroupRegion(rowGroupId).first;
+  if (rowGroupOffset < bloomFilterSource_->offset ||
+      rowGroupOffset >= bloomFilterSource_->limit) {
+    return true;
+  }
+  auto bloomFilter = readBloomFilter(chunk);
+  if (!bloomFilter) {
+    return true;
+  }
+  return bloomFilter->testFilter(filter, type_->parquetType_.value());
+}
+
+std::unique_ptr<BloomFilter> ParquetData::readBloomFilter(
+    const ColumnChunkMetaDataPtr& chunk) {
+  // The header has no length and is a few bytes. Read a prefix that covers it
+  // and read the rest of the bitset once its size is known.
+  constexpr uint64_t kHeaderReadSize = 256;
+  auto& input = *bloomFilterSource_->input;
+  const uint64_t fileLength = input.getReadFile()->size();
+  const uint64_t offset = chunk.bloomFilterOffset();
+  if (offset >= fileLength) {
+    return nullptr;
+  }
+  const auto prefixSize = std::min(kHeaderReadSize, fileLength - offset);
+  BufferPtr prefix;
+  dwio::common::ensureCapacity<char>(prefix, prefixSize, &pool_);
+  input.read(offset, prefixSize, dwio::common::LogType::BLOCK)
+      ->readFully(prefix->asMutable<char>(), prefixSize);
+
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      prefix->as<char>(), prefixSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const uint64_t headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % BloomFilter::kBytesPerBlock != 0 ||
+      offset + headerSize + header.numBytes > fileLength) {
+    return nullptr;
+  }
+
+  auto bitset = AlignedBuffer::allocate<char>(header.numBytes, &pool_);
+  const auto numInPrefix =
+      std::min<uint64_t>(prefixSize - headerSize, header.numBytes);
+  memcpy(
+      bitset->asMutable<char>(), prefix->as<char>() + headerSize, numInPrefix);
+  if (numInPrefix < header.numBytes) {
+    const auto numLeft = header.numBytes - numInPrefix;
+    input
+        .read(
+            offset + headerSize + numInPrefix,
+            numLeft,
+            dwio::common::LogType::BLOCK)
+        ->readFully(bitset->asMutable<char>() + numInPrefix, numLeft);
+  }
+  return std::make_unique<BloomFilter>(std::move(bitset), header.numBytes);
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -104,6 +196,114 @@ void ParquetData::enqueueRowGroup(
 
   auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+
+  if (usePageIndex(chunk)) {
+    columnIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.columnIndexOffset()),
+         static_cast<uint64_t>(chunk.columnIndexLength())});
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offsetIndexOffset()),
+         static_cast<uint64_t>(chunk.offsetIndexLength())});
+  }
+}
+
+bool ParquetData::usePageIndex(const ColumnChunkMetaDataPtr& chunk) const {
+  // Pages are skipped only for top level columns, where a page boundary is
+  // also a row boundary. A filter that reads only nulls consults the define
+  // levels of every page, so these cannot be skipped either.
+  return scanSpec_ && scanSpec_->filter() && !scanSpec_->readsNullsOnly() &&
+      maxRepeat_ == 0 && maxDefine_ <= 1 && chunk.hasColumnIndex() &&
+      chunk.hasOffsetIndex();
+}
+
+namespace {
+template <typename T>
+void readThrift(
+    dwio::common::SeekableInputStream& stream,
+    int32_t size,
+    BufferPtr& buffer,
+    memory::MemoryPool& pool,
+    T& result) {
+  dwio::common::ensureCapacity<char>(buffer, size, &pool);
+  stream.readFully(buffer->asMutable<char>(), size);
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      buffer->as<char>(), size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  result.read(&protocol);
+}
+} // namespace
+
+std::vector<bool> ParquetData::prunedPages(uint32_t index) {
+  if (index >= columnIndexStreams_.size() || !columnIndexStreams_[index]) {
+    return {};
+  }
+  auto columnIndexStream = std::move(columnIndexStreams_[index]);
+  auto offsetIndexStream = std::move(offsetIndexStreams_[index]);
+  auto* filter = scanSpec_->filter();
+  if (!filter) {
+    return {};
+  }
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto chunk = rowGroup.columnChunk(type_->column());
+  BufferPtr buffer;
+  thrift::ColumnIndex columnIndex;
+  thrift::OffsetIndex offsetIndex;
+  readThrift(
+      *columnIndexStream,
+      chunk.columnIndexLength(),
+      buffer,
+      pool_,
+      columnIndex);
+  readThrift(
+      *offsetIndexStream,
+      chunk.offsetIndexLength(),
+      buffer,
+      pool_,
+      offsetIndex);
+
+  const auto& locations = offsetIndex.page_locations;
+  const int32_t numPages = locations.size();
+  if (numPages == 0 || columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages) {
+    return {};
+  }
+  const bool hasNullCounts = columnIndex.__isset.null_counts &&
+      columnIndex.null_counts.size() == numPages;
+  std::vector<bool> pruned(numPages);
+  int32_t numPruned = 0;
+  for (auto i = 0; i < numPages; ++i) {
+    const int64_t numRows =
+        (i + 1 < numPages ? locations[i + 1].first_row_index
+                          : rowGroup.numRows()) -
+        locations[i].first_row_index;
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(numRows);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (hasNullCounts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type_->type(), numRows);
+    if (!testFilter(filter, columnStats.get(), numRows, type_->type())) {
+      pruned[i] = true;
+      ++numPruned;
+    }
+  }
+  if (numPruned == 0) {
+    return {};
+  }
+  if (stats_) {
+    stats_->skippedPages += numPruned;
+  }
+  return pruned;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -117,6 +317,10 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.compression(),
       metadata.totalCompressedSize());
+  auto pruned = prunedPages(index);
+  if (!pruned.empty()) {
+    reader_->setPrunedPages(std::move(pruned));
+  }
   return dwio::common::PositionProvider(empty);
 }
 
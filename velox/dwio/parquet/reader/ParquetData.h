@@ -30,19 +30,34 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+class BloomFilter;
+
+/// Where to read the bloom filters of column chunks from when filtering row
+/// groups. Bloom filters are only read for the row groups that start in
+/// ['offset', 'limit'), i.e. the row groups of the split being read.
+struct BloomFilterSource {
+  dwio::common::BufferedInput* input;
+  uint64_t offset;
+  uint64_t limit;
+};
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const FileMetaDataPtr metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const FileMetaDataPtr metaData,
+      std::optional<BloomFilterSource> bloomFilterSource = std::nullopt)
+      : FormatParams(pool, stats),
+        metaData_(metaData),
+        bloomFilterSource_(bloomFilterSource) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const FileMetaDataPtr metaData_;
+  const std::optional<BloomFilterSource> bloomFilterSource_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +66,16 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const common::ScanSpec* scanSpec = nullptr,
+      dwio::common::ColumnReaderStatistics* stats = nullptr,
+      std::optional<BloomFilterSource> bloomFilterSource = std::nullopt)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
+        scanSpec_(scanSpec),
+        stats_(stats),
+        bloomFilterSource_(bloomFilterSource),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -191,14 +212,45 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if the bloom filter of the column chunk in 'rowGroupId' shows that
+  /// no value passing 'filter' is present. True if there is no bloom filter,
+  /// 'bloomFilterSource_' is not set or the row group is outside of its range.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  /// Reads the bloom filter of 'chunk'. Returns nullptr if the bloom filter
+  /// uses an unsupported algorithm, hash or compression.
+  std::unique_ptr<BloomFilter> readBloomFilter(
+      const ColumnChunkMetaDataPtr& chunk);
+
+  /// True if the ColumnIndex and OffsetIndex of the column chunk in
+  /// 'rowGroup' should be read to skip data pages that cannot pass the filter
+  /// in 'scanSpec_'.
+  bool usePageIndex(const ColumnChunkMetaDataPtr& chunk) const;
+
+  /// Decodes the page index enqueued for 'index'th row group and returns a
+  /// flag per data page that is set if no row of the page can pass the filter
+  /// in 'scanSpec_'. Returns an empty vector if nothing can be skipped.
+  std::vector<bool> prunedPages(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  // Filter and projection for the column of 'this'. nullptr if not known.
+  const common::ScanSpec* const scanSpec_;
+  dwio::common::ColumnReaderStatistics* const stats_;
+  const std::optional<BloomFilterSource> bloomFilterSource_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Streams for the ColumnIndex and OffsetIndex of this column in each of
+  // 'rowGroups_'. Only enqueued for filtered columns with a page index.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
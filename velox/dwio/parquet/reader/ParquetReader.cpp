@@ -19,6 +19,7 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -68,6 +69,14 @@ class ReaderBase {
     return options_.isFileColumnNamesReadAsLowerCase();
   }
 
+  bool readBloomFilters() const {
+    return options_.readBloomFilters();
+  }
+
+  bool lazyColumns() const {
+    return options_.lazyColumns();
+  }
+
   /// Ensures that streams are enqueued and loading for the row group at
   /// 'currentGroup'. May start loading one or more subsequent groups.
   void scheduleRowGroups(
@@ -113,7 +122,9 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // May be shared with other readers of the file through the
+  // FileMetadataCache.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -145,6 +156,23 @@ void ReaderBase::loadFileMetaData() {
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
 
+  auto* metadataCache = options_.fileMetadataCache();
+  std::optional<dwio::common::FileMetadataCache::Key> cacheKey;
+  if (metadataCache != nullptr) {
+    cacheKey = dwio::common::FileMetadataCache::Key{
+        dwio::common::FileFormat::PARQUET,
+        input_->getReadFile()->getName(),
+        fileLength_,
+        options_.fileModificationTime()};
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(*cacheKey);
+    if (fileMetaData_ != nullptr) {
+      if (preloadFile) {
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
+
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
     stream = input_->loadCompleteFile();
@@ -187,8 +215,12 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = fileMetaData;
+  if (metadataCache != nullptr) {
+    metadataCache->put(*cacheKey, fileMetaData_, footerLength);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -758,8 +790,18 @@ class ParquetRowReader::Impl {
     if (rowGroups_.empty()) {
       return; // TODO
     }
+    std::optional<BloomFilterSource> bloomFilterSource;
+    if (readerBase_->readBloomFilters()) {
+      bloomFilterSource = BloomFilterSource{
+          &readerBase_->bufferedInput(),
+          options_.getOffset(),
+          options_.getLimit()};
+    }
     ParquetParams params(
-        pool_, columnReaderStats_, readerBase_->fileMetaData());
+        pool_,
+        columnReaderStats_,
+        readerBase_->fileMetaData(),
+        bloomFilterSource);
     auto columnSelector = std::make_shared<ColumnSelector>(
         ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
     requestedType_ = columnSelector->getSchemaWithId();
@@ -768,6 +810,10 @@ class ParquetRowReader::Impl {
         readerBase_->schemaWithId(), // Id is schema id
         params,
         *options_.getScanSpec());
+    if (readerBase_->lazyColumns()) {
+      // The top level readers without filters then make LazyVectors.
+      columnReader_->setIsTopLevel();
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -866,6 +912,10 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.columnReaderStatistics.skippedPages +=
+        columnReaderStats_.skippedPages;
+    stats.columnReaderStatistics.skippedStridesByBloomFilter +=
+        columnReaderStats_.skippedStridesByBloomFilter;
   }
 
   void resetFilterCaches() {
@@ -967,6 +1017,94 @@ std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->thriftFileMetaData().num_rows;
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics> ParquetReader::columnStatistics(
+    uint32_t index) const {
+  const ParquetTypeWithId* column = nullptr;
+  for (const auto& child : readerBase_->schemaWithId()->getChildren()) {
+    if (child->id() == index) {
+      column = static_cast<const ParquetTypeWithId*>(child.get());
+      break;
+    }
+  }
+  if (column == nullptr || !column->isLeaf() || column->type()->isDecimal()) {
+    return nullptr;
+  }
+  switch (column->type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+  // Unsigned integers are ordered differently from the signed values they are
+  // read as. The node ids are the indices of the schema elements.
+  const auto& schemaElement =
+      readerBase_->thriftFileMetaData().schema[column->id()];
+  if (schemaElement.__isset.converted_type) {
+    switch (schemaElement.converted_type) {
+      case thrift::ConvertedType::UINT_8:
+      case thrift::ConvertedType::UINT_16:
+      case thrift::ConvertedType::UINT_32:
+      case thrift::ConvertedType::UINT_64:
+        return nullptr;
+      default:
+        break;
+    }
+  }
+  if (schemaElement.__isset.logicalType &&
+      schemaElement.logicalType.__isset.INTEGER &&
+      !schemaElement.logicalType.INTEGER.isSigned) {
+    return nullptr;
+  }
+
+  auto fileMetaData = readerBase_->fileMetaData();
+  uint64_t numValues = 0;
+  bool hasNull = false;
+  std::optional<int64_t> min;
+  std::optional<int64_t> max;
+  // The min and max are unknown if a row group with values does not have
+  // them.
+  bool minMaxKnown = true;
+  for (auto i = 0; i < fileMetaData.numRowGroups(); ++i) {
+    auto rowGroup = fileMetaData.rowGroup(i);
+    auto columnChunk = rowGroup.columnChunk(column->column());
+    if (!columnChunk.hasStatistics()) {
+      return nullptr;
+    }
+    const auto statistics =
+        columnChunk.getColumnStatistics(column->type(), rowGroup.numRows());
+    const auto* integerStatistics =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            statistics.get());
+    if (integerStatistics == nullptr ||
+        !integerStatistics->getNumberOfValues().has_value()) {
+      return nullptr;
+    }
+    const auto rowGroupValues = integerStatistics->getNumberOfValues().value();
+    numValues += rowGroupValues;
+    hasNull |= rowGroupValues < static_cast<uint64_t>(rowGroup.numRows());
+    if (rowGroupValues == 0) {
+      continue;
+    }
+    const auto rowGroupMin = integerStatistics->getMinimum();
+    const auto rowGroupMax = integerStatistics->getMaximum();
+    if (!rowGroupMin.has_value() || !rowGroupMax.has_value()) {
+      minMaxKnown = false;
+      continue;
+    }
+    min = std::min(min.value_or(rowGroupMin.value()), rowGroupMin.value());
+    max = std::max(max.value_or(rowGroupMax.value()), rowGroupMax.value());
+  }
+  if (!minMaxKnown) {
+    min.reset();
+    max.reset();
+  }
+  return std::make_unique<dwio::common::IntegerColumnStatistics>(
+      numValues, hasNull, std::nullopt, std::nullopt, min, max, std::nullopt);
+}
+
 const velox::RowTypePtr& ParquetReader::rowType() const {
   return readerBase_->schema();
 }
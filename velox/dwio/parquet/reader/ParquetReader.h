@@ -90,10 +90,11 @@ class ParquetReader : public dwio::common::Reader {
 
   std::optional<uint64_t> numberOfRows() const override;
 
+  /// Returns the statistics of the top level column with node id 'index',
+  /// merged from the row groups. Only integer columns have them, nullptr is
+  /// returned for the others.
   std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
-      uint32_t index) const override {
-    return nullptr;
-  }
+      uint32_t index) const override;
 
   const velox::RowTypePtr& rowType() const override;
 
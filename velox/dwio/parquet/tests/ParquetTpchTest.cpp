@@ -85,8 +85,6 @@ class ParquetTpchTest : public testing::Test {
 
     for (const auto& table : tpch::tables) {
       auto tableName = toTableName(table);
-      auto tableDirectory =
-          fmt::format("{}/{}", tempDirectory_->getPath(), tableName);
       auto tableSchema = tpch::getTableSchema(table);
       auto columnNames = tableSchema->names();
       auto plan = PlanBuilder()
@@ -99,14 +97,13 @@ class ParquetTpchTest : public testing::Test {
       auto rows =
           AssertQueryBuilder(plan).splits({split}).copyResults(pool.get());
       duckDb_->createTable(tableName.data(), {rows});
-
-      plan = PlanBuilder()
-                 .values({rows})
-                 .tableWrite(tableDirectory, dwio::common::FileFormat::PARQUET)
-                 .planNode();
-
-      AssertQueryBuilder(plan).copyResults(pool.get());
     }
+    writeTpchTables(
+        tempDirectory_->getPath(),
+        dwio::common::FileFormat::PARQUET,
+        0.01,
+        /*numSplits=*/4,
+        /*numDrivers=*/4);
   }
 
   void assertQuery(
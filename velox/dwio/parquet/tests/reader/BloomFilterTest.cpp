@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+class BloomFilterTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool();
+  }
+
+  std::unique_ptr<BloomFilter> makeFilter(int32_t numBytes) {
+    auto bitset = AlignedBuffer::allocate<char>(numBytes, pool_.get());
+    memset(bitset->asMutable<char>(), 0, numBytes);
+    return std::make_unique<BloomFilter>(std::move(bitset), numBytes);
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(BloomFilterTest, noFalseNegatives) {
+  auto filter = makeFilter(1024);
+  for (int64_t i = 0; i < 1'000; i += 2) {
+    filter->insert(BloomFilter::hash(i * 7919));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    const bool mayContain = filter->mayContain(BloomFilter::hash(i * 7919));
+    if (i % 2 == 0) {
+      EXPECT_TRUE(mayContain) << i;
+    } else if (mayContain) {
+      ++numFalsePositives;
+    }
+  }
+  // 500 values in 32 blocks is a dense filter, it must still reject some.
+  EXPECT_LT(numFalsePositives, 500);
+}
+
+TEST_F(BloomFilterTest, bigintFilters) {
+  auto filter = makeFilter(BloomFilter::kBytesPerBlock * 8);
+  for (int64_t value : {10, 20, 30}) {
+    filter->insert(BloomFilter::hash(value));
+  }
+  const auto type = thrift::Type::INT64;
+  EXPECT_TRUE(filter->testFilter(common::BigintRange(20, 20, false), type));
+  EXPECT_FALSE(filter->testFilter(common::BigintRange(25, 25, false), type));
+  // Null passes and nulls are not in the bloom filter.
+  EXPECT_TRUE(filter->testFilter(common::BigintRange(25, 25, true), type));
+  // Ranges are not enumerated.
+  EXPECT_TRUE(filter->testFilter(common::BigintRange(21, 29, false), type));
+
+  EXPECT_TRUE(filter->testFilter(
+      *common::createBigintValues({1, 30, 1'000'000}, false), type));
+  EXPECT_FALSE(filter->testFilter(
+      *common::createBigintValues({1, 2, 1'000'000}, false), type));
+  EXPECT_FALSE(
+      filter->testFilter(*common::createBigintValues({1, 2, 3}, false), type));
+}
+
+TEST_F(BloomFilterTest, intColumn) {
+  auto filter = makeFilter(BloomFilter::kBytesPerBlock * 8);
+  filter->insert(BloomFilter::hash(static_cast<int32_t>(-5)));
+  const auto type = thrift::Type::INT32;
+  EXPECT_TRUE(filter->testFilter(common::BigintRange(-5, -5, false), type));
+  EXPECT_FALSE(filter->testFilter(common::BigintRange(-6, -6, false), type));
+  // Values that do not fit in 32 bits are not hashed.
+  const int64_t large = 1L << 40;
+  EXPECT_TRUE(
+      filter->testFilter(common::BigintRange(large, large, false), type));
+}
+
+TEST_F(BloomFilterTest, bytesFilters) {
+  auto filter = makeFilter(BloomFilter::kBytesPerBlock * 8);
+  for (const std::string value : {"apple", "banana", "cherry"}) {
+    filter->insert(BloomFilter::hash(std::string_view(value)));
+  }
+  const auto type = thrift::Type::BYTE_ARRAY;
+  EXPECT_TRUE(filter->testFilter(
+      common::BytesValues({"banana", "durian"}, false), type));
+  EXPECT_FALSE(filter->testFilter(
+      common::BytesValues({"durian", "elderberry"}, false), type));
+  EXPECT_TRUE(filter->testFilter(
+      common::BytesValues({"durian", "elderberry"}, true), type));
+  EXPECT_TRUE(filter->testFilter(
+      common::BytesRange("cherry", false, false, "cherry", false, false, false),
+      type));
+  EXPECT_FALSE(filter->testFilter(
+      common::BytesRange("durian", false, false, "durian", false, false, false),
+      type));
+  // Other physical types are never pruned.
+  EXPECT_TRUE(filter->testFilter(
+      common::BytesValues({"durian"}, false),
+      thrift::Type::FIXED_LEN_BYTE_ARRAY));
+}
+
+TEST_F(BloomFilterTest, invalidSize) {
+  auto bitset = AlignedBuffer::allocate<char>(100, pool_.get());
+  VELOX_ASSERT_THROW(BloomFilter(bitset, 100), "");
+}
@@ -1128,3 +1128,199 @@ TEST_F(ParquetReaderTest, testEnumType) {
 
   assertReadWithReaderAndExpected(fileSchema, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, pageIndexSkipsPages) {
+  // Sorted values written in many small pages with a page index. A selective
+  // range filter should skip the pages that cannot match.
+  const vector_size_t kSize = 20'000;
+  auto data = makeRowVector(
+      {"a", "b"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; })});
+  auto rowType = asRowType(data->type());
+  auto filePath = tempPath_->getPath() + "/pageIndex.parquet";
+
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.enablePageIndex = true;
+  writerOptions.dataPageSize = 4 * 1024;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("a")->setFilter(
+      std::make_unique<velox::common::BigintRange>(12'345, 12'444, false));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  int64_t numPassed = 0;
+  while (rowReader->next(1'000, result) > 0) {
+    auto* rowVector = result->as<RowVector>();
+    auto* a =
+        rowVector->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+    auto* b =
+        rowVector->childAt(1)->loadedVector()->as<SimpleVector<double>>();
+    for (auto i = 0; i < result->size(); ++i) {
+      ASSERT_EQ(a->valueAt(i), 12'345 + numPassed);
+      ASSERT_EQ(b->valueAt(i), a->valueAt(i) * 0.5);
+      ++numPassed;
+    }
+  }
+  EXPECT_EQ(numPassed, 100);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_GT(stats.columnReaderStatistics.skippedPages, 0);
+}
+
+TEST_F(ParquetReaderTest, bloomFilterFromWriter) {
+  // Each row group has values from the whole range, so only the bloom filters
+  // can skip the row groups that do not have the value.
+  const int32_t kNumRowGroups = 10;
+  const vector_size_t kRowsPerGroup = 1'000;
+  auto makeBatch = [&](int32_t rowGroup) {
+    return makeRowVector(
+        {"a", "s", "b"},
+        {makeFlatVector<int64_t>(
+             kRowsPerGroup,
+             [&](auto row) { return row * kNumRowGroups + rowGroup; }),
+         makeFlatVector<std::string>(
+             kRowsPerGroup,
+             [&](auto row) {
+               return fmt::format("s{}", row * kNumRowGroups + rowGroup);
+             }),
+         makeFlatVector<bool>(kRowsPerGroup, [](auto row) { return row; })});
+  };
+  auto rowType = asRowType(makeBatch(0)->type());
+  auto filePath = tempPath_->getPath() + "/bloomFilter.parquet";
+
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.bloomFilterColumns = {"a", "s", "b"};
+  writerOptions.bloomFilterOptions.ndv = kRowsPerGroup;
+  writerOptions.flushPolicyFactory = [&]() {
+    return std::make_unique<facebook::velox::parquet::DefaultFlushPolicy>(
+        kRowsPerGroup, 1L << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  for (auto i = 0; i < kNumRowGroups; ++i) {
+    writer->write(makeBatch(i));
+  }
+  writer->close();
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), kNumRowGroups);
+  for (auto i = 0; i < kNumRowGroups; ++i) {
+    const auto rowGroup = reader->fileMetaData().rowGroup(i);
+    EXPECT_TRUE(rowGroup.columnChunk(0).hasBloomFilterOffset());
+    EXPECT_TRUE(rowGroup.columnChunk(1).hasBloomFilterOffset());
+    // Booleans have no bloom filter.
+    EXPECT_FALSE(rowGroup.columnChunk(2).hasBloomFilterOffset());
+  }
+
+  auto test = [&](const std::string& column,
+                  std::unique_ptr<velox::common::Filter> filter) {
+    SCOPED_TRACE(column);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName(column)->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    int64_t numPassed = 0;
+    while (rowReader->next(kRowsPerGroup, result) > 0) {
+      auto* rowVector = result->as<RowVector>();
+      auto* a =
+          rowVector->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        ASSERT_EQ(a->valueAt(i), 5'003);
+        ++numPassed;
+      }
+    }
+    EXPECT_EQ(numPassed, 1);
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(
+        stats.columnReaderStatistics.skippedStridesByBloomFilter,
+        kNumRowGroups - 1);
+  };
+  test("a", std::make_unique<velox::common::BigintRange>(5'003, 5'003, false));
+  test(
+      "s",
+      std::make_unique<velox::common::BytesValues>(
+          std::vector<std::string>{"s5003"}, false));
+}
+
+TEST_F(ParquetReaderTest, lazyColumns) {
+  const vector_size_t kSize = 20'000;
+  auto data = makeRowVector(
+      {"a", "b"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; })});
+  auto rowType = asRowType(data->type());
+  auto filePath = tempPath_->getPath() + "/lazyColumns.parquet";
+
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.dataPageSize = 4 * 1024;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  for (auto lazyColumns : {false, true}) {
+    SCOPED_TRACE(fmt::format("lazyColumns {}", lazyColumns));
+    facebook::velox::dwio::common::ReaderOptions readerOptions{
+        leafPool_.get()};
+    readerOptions.setLazyColumns(lazyColumns);
+    auto reader = createReader(filePath, readerOptions);
+    std::vector<std::unique_ptr<velox::common::BigintRange>> ranges;
+    ranges.push_back(
+        std::make_unique<velox::common::BigintRange>(0, 4'999, false));
+    ranges.push_back(
+        std::make_unique<velox::common::BigintRange>(15'000, 19'999, false));
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(
+        std::make_unique<velox::common::BigintMultiRange>(
+            std::move(ranges), false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    int64_t numPassed = 0;
+    int32_t numBatches = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      if (result->size() == 0) {
+        continue;
+      }
+      auto* rowVector = result->as<RowVector>();
+      ASSERT_EQ(rowVector->childAt(1)->isLazy(), lazyColumns);
+      auto* a =
+          rowVector->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      numPassed += result->size();
+      // Leaves every other batch of 'b' unloaded, so that the next load
+      // skips the rows of the batch.
+      if (++numBatches % 2 == 0) {
+        continue;
+      }
+      auto* b =
+          rowVector->childAt(1)->loadedVector()->as<SimpleVector<double>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        ASSERT_EQ(b->valueAt(i), a->valueAt(i) * 0.5);
+      }
+    }
+    EXPECT_EQ(numPassed, 10'000);
+  }
+}
@@ -252,6 +252,34 @@ TEST_F(ParquetTableScanTest, basic) {
       "SELECT max(b), a FROM tmp WHERE a < 3 GROUP BY a");
 }
 
+TEST_F(ParquetTableScanTest, remainingFilter) {
+  loadData(
+      getExampleFilePath("sample.parquet"),
+      ROW({"a", "b"}, {BIGINT(), DOUBLE()}),
+      makeRowVector(
+          {"a", "b"},
+          {
+              makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+              makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+          }));
+
+  // The remaining filter makes the columns it does not reference lazy.
+  assertSelectWithFilter(
+      {"a", "b"}, {}, "a % 3 = 0", "SELECT a, b FROM tmp WHERE a % 3 = 0");
+  assertSelectWithFilter(
+      {"b", "a"},
+      {"a < 15"},
+      "a % 3 = 0 OR a = 1",
+      "SELECT b, a FROM tmp WHERE a < 15 AND (a % 3 = 0 OR a = 1)");
+  assertSelectWithFilter(
+      {"b"},
+      {},
+      "a + b > DOUBLE '30.0'",
+      "SELECT b FROM tmp WHERE a + b > 30.0");
+  assertSelectWithFilter(
+      {"a", "b"}, {}, "a > 100", "SELECT a, b FROM tmp WHERE a > 100");
+}
+
 TEST_F(ParquetTableScanTest, countStar) {
   // sample.parquet holds two columns (a: BIGINT, b: DOUBLE) and
   // 20 rows.
@@ -18,8 +18,8 @@
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include <folly/String.h>
 #include "velox/common/testutil/TestValue.h"
-#include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
 
@@ -30,6 +30,12 @@ using facebook::velox::parquet::arrow::Compression;
 using facebook::velox::parquet::arrow::WriterProperties;
 using facebook::velox::parquet::arrow::arrow::FileWriter;
 
+namespace {
+// Table properties from Hive and Spark for writing bloom filters.
+constexpr const char* kBloomFilterColumnsKey = "parquet.bloom.filter.columns";
+constexpr const char* kBloomFilterFppKey = "parquet.bloom.filter.fpp";
+} // namespace
+
 // Utility for buffering Arrow output with a DataBuffer.
 class ArrowDataBufferSink : public ::arrow::io::OutputStream {
  public:
@@ -140,6 +146,13 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
+  for (const auto& column : options.bloomFilterColumns) {
+    properties =
+        properties->enable_bloom_filter(column, options.bloomFilterOptions);
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
@@ -394,6 +407,21 @@ parquet::WriterOptions getParquetOptions(
     parquetOptions.parquetWriteTimestampUnit =
         options.parquetWriteTimestampUnit.value();
   }
+  if (options.parquetEnablePageIndex.has_value()) {
+    parquetOptions.enablePageIndex = options.parquetEnablePageIndex.value();
+  }
+  // Bloom filters are requested per table like in Hive and Spark.
+  auto it = options.serdeParameters.find(kBloomFilterColumnsKey);
+  if (it != options.serdeParameters.end()) {
+    folly::split(',', it->second, parquetOptions.bloomFilterColumns, true);
+    for (auto& column : parquetOptions.bloomFilterColumns) {
+      column = folly::trimWhitespace(column).str();
+    }
+  }
+  it = options.serdeParameters.find(kBloomFilterFppKey);
+  if (it != options.serdeParameters.end()) {
+    parquetOptions.bloomFilterOptions.fpp = folly::to<double>(it->second);
+  }
   return parquetOptions;
 }
 
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
@@ -90,6 +91,14 @@ struct WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  // Writes the ColumnIndex and OffsetIndex of each column chunk. These allow
+  // readers to skip data pages using page level statistics.
+  bool enablePageIndex = false;
+  // Leaf column paths, e.g. "a" or "s.b", that get a split block bloom filter
+  // in each column chunk. Readers use them to skip row groups on equality and
+  // IN filters.
+  std::vector<std::string> bloomFilterColumns;
+  arrow::BloomFilterOptions bloomFilterOptions;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
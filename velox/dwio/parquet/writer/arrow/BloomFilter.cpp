@@ -27,8 +27,8 @@
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
 #include "velox/dwio/parquet/writer/arrow/ThriftInternal.h"
 #include "velox/dwio/parquet/writer/arrow/generated/parquet_types.h"
-#include "velox/dwio/parquet/writer/arrow/tests/BloomFilter.h"
-#include "velox/dwio/parquet/writer/arrow/tests/XxHasher.h"
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
+#include "velox/dwio/parquet/writer/arrow/XxHasher.h"
 
 namespace facebook::velox::parquet::arrow {
 
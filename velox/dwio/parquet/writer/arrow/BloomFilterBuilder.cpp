@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Adapted from Apache Arrow.
+
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
+
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/dwio/parquet/writer/arrow/Metadata.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+
+namespace facebook::velox::parquet::arrow {
+
+std::unique_ptr<BloomFilterBuilder> BloomFilterBuilder::Make(
+    const SchemaDescriptor* schema,
+    const WriterProperties* properties) {
+  return std::unique_ptr<BloomFilterBuilder>(
+      new BloomFilterBuilder(schema, properties));
+}
+
+BloomFilterBuilder::BloomFilterBuilder(
+    const SchemaDescriptor* schema,
+    const WriterProperties* properties)
+    : schema_(schema), properties_(properties) {}
+
+BloomFilterBuilder::~BloomFilterBuilder() = default;
+
+void BloomFilterBuilder::AppendRowGroup() {
+  if (finished_) {
+    throw ParquetException(
+        "Cannot call AppendRowGroup() to finished BloomFilterBuilder.");
+  }
+  bloom_filters_.emplace_back();
+  bloom_filters_.back().resize(schema_->num_columns());
+}
+
+BloomFilter* BloomFilterBuilder::GetOrCreateBloomFilter(
+    int32_t column_ordinal) {
+  if (finished_ || bloom_filters_.empty()) {
+    throw ParquetException("No row group to add a bloom filter to.");
+  }
+  if (column_ordinal < 0 || column_ordinal >= schema_->num_columns()) {
+    throw ParquetException("Invalid column ordinal: ", column_ordinal);
+  }
+  const auto* descr = schema_->Column(column_ordinal);
+  const auto& options = properties_->bloom_filter_options(descr->path());
+  if (!options.has_value() || descr->physical_type() == Type::BOOLEAN) {
+    return nullptr;
+  }
+  auto& bloom_filter = bloom_filters_.back()[column_ordinal];
+  if (bloom_filter == nullptr) {
+    auto block_split_bloom_filter =
+        std::make_unique<BlockSplitBloomFilter>(properties_->memory_pool());
+    block_split_bloom_filter->Init(BlockSplitBloomFilter::OptimalNumOfBytes(
+        options->ndv, options->fpp));
+    bloom_filter = std::move(block_split_bloom_filter);
+  }
+  return bloom_filter.get();
+}
+
+void BloomFilterBuilder::WriteTo(
+    ::arrow::io::OutputStream* sink,
+    BloomFilterLocation* location) {
+  finished_ = true;
+  for (size_t row_group = 0; row_group < bloom_filters_.size(); ++row_group) {
+    auto& filters = bloom_filters_[row_group];
+    std::vector<std::optional<int64_t>> offsets(filters.size());
+    bool has_filter = false;
+    for (size_t column = 0; column < filters.size(); ++column) {
+      if (filters[column] == nullptr) {
+        continue;
+      }
+      PARQUET_ASSIGN_OR_THROW(offsets[column], sink->Tell());
+      filters[column]->WriteTo(sink);
+      // The bitset is no longer needed after it is written.
+      filters[column].reset();
+      has_filter = true;
+    }
+    if (has_filter) {
+      location->bloom_filter_location.emplace(row_group, std::move(offsets));
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet::arrow
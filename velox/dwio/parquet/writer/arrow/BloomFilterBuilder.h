@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Adapted from Apache Arrow.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "arrow/io/interfaces.h"
+#include "velox/dwio/parquet/writer/arrow/Platform.h"
+
+namespace facebook::velox::parquet::arrow {
+
+class BloomFilter;
+struct BloomFilterLocation;
+class SchemaDescriptor;
+class WriterProperties;
+
+/// \brief Collects the bloom filters of the column chunks of a parquet file
+/// and writes them after the last row group.
+class PARQUET_EXPORT BloomFilterBuilder {
+ public:
+  /// \brief API convenience to create a BloomFilterBuilder.
+  static std::unique_ptr<BloomFilterBuilder> Make(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties);
+
+  /// \brief Start a new row group.
+  void AppendRowGroup();
+
+  /// \brief Get the bloom filter of the column chunk of the current row group.
+  ///
+  /// \param column_ordinal Column ordinal.
+  /// \return The bloom filter or nullptr if the column has no bloom filter. Its
+  /// memory ownership belongs to the BloomFilterBuilder.
+  BloomFilter* GetOrCreateBloomFilter(int32_t column_ordinal);
+
+  /// \brief Serialize the bloom filters and report their offsets.
+  ///
+  /// \param[out] sink The output stream to write the bloom filters.
+  /// \param[out] location The offsets of all bloom filters in sink.
+  void WriteTo(::arrow::io::OutputStream* sink, BloomFilterLocation* location);
+
+  ~BloomFilterBuilder();
+
+ private:
+  BloomFilterBuilder(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties);
+
+  const SchemaDescriptor* schema_;
+  const WriterProperties* properties_;
+  bool finished_{false};
+  // Bloom filters by row group and column ordinal. Null for columns without a
+  // bloom filter.
+  std::vector<std::vector<std::unique_ptr<BloomFilter>>> bloom_filters_;
+};
+
+} // namespace facebook::velox::parquet::arrow
@@ -20,6 +20,7 @@
 
 #include <glog/logging.h>
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <map>
@@ -34,6 +35,7 @@
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
+#include "arrow/util/bit_run_reader.h"
 #include "arrow/util/bit_stream_utils.h"
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_ops.h"
@@ -43,6 +45,7 @@
 #include "arrow/util/rle_encoding.h"
 #include "arrow/util/type_traits.h"
 
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnPage.h"
 #include "velox/dwio/parquet/writer/arrow/Encoding.h"
 #include "velox/dwio/parquet/writer/arrow/Encryption.h"
@@ -1460,13 +1463,15 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
       std::unique_ptr<PageWriter> pager,
       const bool use_dictionary,
       Encoding::type encoding,
-      const WriterProperties* properties)
+      const WriterProperties* properties,
+      BloomFilter* bloom_filter)
       : ColumnWriterImpl(
             metadata,
             std::move(pager),
             use_dictionary,
             encoding,
-            properties) {
+            properties),
+        bloom_filter_(bloom_filter) {
     current_encoder_ = MakeEncoder(
         DType::type_num,
         encoding,
@@ -1954,6 +1959,62 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(values, num_values, num_nulls);
     }
+    UpdateBloomFilter(values, num_values);
+  }
+
+  // Inserts the hashes of 'values' into 'bloom_filter_' if set.
+  void UpdateBloomFilter(const T* values, int64_t num_values) {
+    if constexpr (!std::is_same_v<DType, BooleanType>) {
+      if (bloom_filter_ == nullptr) {
+        return;
+      }
+      constexpr int64_t kHashBatchSize = 256;
+      std::array<uint64_t, kHashBatchSize> hashes;
+      for (int64_t i = 0; i < num_values; i += kHashBatchSize) {
+        const auto batch_size =
+            static_cast<int>(std::min(kHashBatchSize, num_values - i));
+        if constexpr (std::is_same_v<DType, FLBAType>) {
+          bloom_filter_->Hashes(
+              values + i, descr_->type_length(), batch_size, hashes.data());
+        } else {
+          bloom_filter_->Hashes(values + i, batch_size, hashes.data());
+        }
+        bloom_filter_->InsertHashes(hashes.data(), batch_size);
+      }
+    }
+  }
+
+  void UpdateBloomFilterSpaced(
+      const T* values,
+      int64_t num_spaced_values,
+      const uint8_t* valid_bits,
+      int64_t valid_bits_offset) {
+    if (bloom_filter_ == nullptr) {
+      return;
+    }
+    if (valid_bits == nullptr) {
+      UpdateBloomFilter(values, num_spaced_values);
+      return;
+    }
+    ::arrow::internal::VisitSetBitRunsVoid(
+        valid_bits,
+        valid_bits_offset,
+        num_spaced_values,
+        [&](int64_t position, int64_t length) {
+          UpdateBloomFilter(values + position, length);
+        });
+  }
+
+  // Inserts the non-null values of the binary 'values' into 'bloom_filter_'.
+  template <typename ArrayType>
+  void UpdateBinaryBloomFilter(const ArrayType& values) {
+    for (int64_t i = 0; i < values.length(); ++i) {
+      if (values.IsNull(i)) {
+        continue;
+      }
+      const ByteArray value(values.GetView(i));
+      bloom_filter_->InsertHash(bloom_filter_->Hash(&value));
+    }
   }
 
   /// \brief Write values with spaces and update page statistics accordingly.
@@ -1999,7 +2060,11 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
           num_values,
           num_nulls);
     }
+    UpdateBloomFilterSpaced(
+        values, num_spaced_values, valid_bits, valid_bits_offset);
   }
+
+  BloomFilter* const bloom_filter_;
 };
 
 template <typename DType>
@@ -2038,8 +2103,9 @@ Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
         maybe_parent_nulls);
   };
 
+  // The bloom filter is built from the dense values.
   if (!IsDictionaryEncoding(current_encoder_->encoding()) ||
-      !DictionaryDirectWriteSupported(array)) {
+      !DictionaryDirectWriteSupported(array) || bloom_filter_ != nullptr) {
     // No longer dictionary-encoding for whatever reason, maybe we never were
     // or we decided to stop. Note that WriteArrow can be invoked multiple
     // times with both dense and dictionary-encoded versions of the same data
@@ -2733,6 +2799,15 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
       page_statistics_->IncrementNullCount(batch_size - non_null);
       page_statistics_->IncrementNumValues(non_null);
     }
+    if (bloom_filter_ != nullptr) {
+      if (::arrow::is_large_binary_like(data_slice->type_id())) {
+        UpdateBinaryBloomFilter(
+            checked_cast<const ::arrow::LargeBinaryArray&>(*data_slice));
+      } else {
+        UpdateBinaryBloomFilter(
+            checked_cast<const ::arrow::BinaryArray&>(*data_slice));
+      }
+    }
     CommitWriteAndCheckPageLimit(
         batch_size, batch_num_values, batch_size - non_null, check_page);
     CheckDictionarySizeLimit();
@@ -2883,7 +2958,8 @@ Status TypedColumnWriterImpl<FLBAType>::WriteArrowDense(
 std::shared_ptr<ColumnWriter> ColumnWriter::Make(
     ColumnChunkMetaDataBuilder* metadata,
     std::unique_ptr<PageWriter> pager,
-    const WriterProperties* properties) {
+    const WriterProperties* properties,
+    BloomFilter* bloom_filter) {
   const ColumnDescriptor* descr = metadata->descr();
   const bool use_dictionary = properties->dictionary_enabled(descr->path()) &&
       descr->physical_type() != Type::BOOLEAN;
@@ -2905,28 +2981,68 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
       return std::make_shared<TypedColumnWriterImpl<BooleanType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT32:
       return std::make_shared<TypedColumnWriterImpl<Int32Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT64:
       return std::make_shared<TypedColumnWriterImpl<Int64Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT96:
       return std::make_shared<TypedColumnWriterImpl<Int96Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FLOAT:
       return std::make_shared<TypedColumnWriterImpl<FloatType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::DOUBLE:
       return std::make_shared<TypedColumnWriterImpl<DoubleType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<ByteArrayType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<FLBAType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     default:
       ParquetException::NYI("type reader not implemented");
   }
@@ -26,6 +26,7 @@
 
 #include "arrow/util/key_value_metadata.h"
 #include "arrow/util/logging.h"
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
 #include "velox/dwio/parquet/writer/arrow/EncryptionInternal.h"
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
@@ -108,7 +109,8 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
       const WriterProperties* properties,
       bool buffered_row_group = false,
       InternalFileEncryptor* file_encryptor = nullptr,
-      PageIndexBuilder* page_index_builder = nullptr)
+      PageIndexBuilder* page_index_builder = nullptr,
+      BloomFilterBuilder* bloom_filter_builder = nullptr)
       : sink_(std::move(sink)),
         metadata_(metadata),
         properties_(properties),
@@ -120,7 +122,8 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
         num_rows_(0),
         buffered_row_group_(buffered_row_group),
         file_encryptor_(file_encryptor),
-        page_index_builder_(page_index_builder) {
+        page_index_builder_(page_index_builder),
+        bloom_filter_builder_(bloom_filter_builder) {
     if (buffered_row_group) {
       InitColumns();
     } else {
@@ -210,8 +213,11 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
           oi_builder,
           *codec_options);
     }
-    column_writers_[0] =
-        ColumnWriter::Make(col_meta, std::move(pager), properties_);
+    column_writers_[0] = ColumnWriter::Make(
+        col_meta,
+        std::move(pager),
+        properties_,
+        bloom_filter(column_ordinal));
     return column_writers_[0].get();
   }
 
@@ -306,6 +312,13 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   bool buffered_row_group_;
   InternalFileEncryptor* file_encryptor_;
   PageIndexBuilder* page_index_builder_;
+  BloomFilterBuilder* bloom_filter_builder_;
+
+  BloomFilter* bloom_filter(int32_t column_ordinal) {
+    return bloom_filter_builder_
+        ? bloom_filter_builder_->GetOrCreateBloomFilter(column_ordinal)
+        : nullptr;
+  }
 
   void CheckRowsWritten() const {
     // verify when only one column is written at a time
@@ -390,8 +403,11 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
             oi_builder,
             *codec_options);
       }
-      column_writers_.push_back(
-          ColumnWriter::Make(col_meta, std::move(pager), properties_));
+      column_writers_.push_back(ColumnWriter::Make(
+          col_meta,
+          std::move(pager),
+          properties_,
+          bloom_filter(column_ordinal)));
     }
   }
 
@@ -431,6 +447,7 @@ class FileSerializer : public ParquetFileWriter::Contents {
       }
       row_group_writer_.reset();
 
+      WriteBloomFilters();
       WritePageIndex();
 
       // Write magic bytes and metadata
@@ -471,6 +488,9 @@ class FileSerializer : public ParquetFileWriter::Contents {
     if (page_index_builder_) {
       page_index_builder_->AppendRowGroup();
     }
+    if (bloom_filter_builder_) {
+      bloom_filter_builder_->AppendRowGroup();
+    }
     std::unique_ptr<RowGroupWriter::Contents> contents(new RowGroupSerializer(
         sink_,
         rg_metadata,
@@ -478,7 +498,8 @@ class FileSerializer : public ParquetFileWriter::Contents {
         properties_.get(),
         buffered_row_group,
         file_encryptor_.get(),
-        page_index_builder_.get()));
+        page_index_builder_.get(),
+        bloom_filter_builder_.get()));
     row_group_writer_ = std::make_unique<RowGroupWriter>(std::move(contents));
     return row_group_writer_.get();
   }
@@ -563,6 +584,16 @@ class FileSerializer : public ParquetFileWriter::Contents {
     }
   }
 
+  void WriteBloomFilters() {
+    if (bloom_filter_builder_ != nullptr) {
+      // Serialize bloom filters after all row groups have been written and
+      // report their offsets to the file metadata.
+      BloomFilterLocation bloom_filter_location;
+      bloom_filter_builder_->WriteTo(sink_.get(), &bloom_filter_location);
+      metadata_->SetBloomFilterLocation(bloom_filter_location);
+    }
+  }
+
   void WritePageIndex() {
     if (page_index_builder_ != nullptr) {
       if (properties_->file_encryption_properties()) {
@@ -587,6 +618,7 @@ class FileSerializer : public ParquetFileWriter::Contents {
   // Only one of the row group writers is active at a time
   std::unique_ptr<RowGroupWriter> row_group_writer_;
   std::unique_ptr<PageIndexBuilder> page_index_builder_;
+  std::unique_ptr<BloomFilterBuilder> bloom_filter_builder_;
   std::unique_ptr<InternalFileEncryptor> file_encryptor_;
 
   void StartFile() {
@@ -631,6 +663,13 @@ class FileSerializer : public ParquetFileWriter::Contents {
     if (properties_->page_index_enabled()) {
       page_index_builder_ = PageIndexBuilder::Make(&schema_);
     }
+    if (properties_->bloom_filter_enabled()) {
+      if (file_encryption_properties != nullptr) {
+        throw ParquetException("Encryption is not supported with bloom filter");
+      }
+      bloom_filter_builder_ =
+          BloomFilterBuilder::Make(&schema_, properties_.get());
+    }
   }
 };
 
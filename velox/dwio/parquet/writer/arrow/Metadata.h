@@ -561,6 +561,16 @@ struct PageIndexLocation {
   FileIndexLocation offset_index_location;
 };
 
+/// \brief Public struct for location to all bloom filters in a parquet file.
+struct BloomFilterLocation {
+  /// Alias type of bloom filter offsets of a row group. The offset is located
+  /// by column ordinal. If the column does not have a bloom filter, its value
+  /// is set to std::nullopt.
+  using RowGroupBloomFilterLocation = std::vector<std::optional<int64_t>>;
+  /// Row group bloom filter offsets which uses row group ordinal as the key.
+  std::map<size_t, RowGroupBloomFilterLocation> bloom_filter_location;
+};
+
 class PARQUET_EXPORT FileMetaDataBuilder {
  public:
   ARROW_DEPRECATED(
@@ -583,6 +593,9 @@ class PARQUET_EXPORT FileMetaDataBuilder {
   // Update location to all page indexes in the parquet file
   void SetPageIndexLocation(const PageIndexLocation& location);
 
+  // Update location to all bloom filters in the parquet file
+  void SetBloomFilterLocation(const BloomFilterLocation& location);
+
   // Complete the Thrift structure
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata =
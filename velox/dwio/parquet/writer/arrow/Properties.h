@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -220,6 +221,14 @@ static constexpr Compression::type DEFAULT_COMPRESSION_TYPE =
     Compression::UNCOMPRESSED;
 static constexpr bool DEFAULT_IS_PAGE_INDEX_ENABLED = false;
 
+/// Sizing of the split block bloom filter of a column chunk.
+struct PARQUET_EXPORT BloomFilterOptions {
+  /// Expected number of distinct values in a column chunk.
+  int32_t ndv = 1 << 20;
+  /// False positive probability of the filter at 'ndv' distinct values.
+  double fpp = 0.05;
+};
+
 class PARQUET_EXPORT ColumnProperties {
  public:
   ColumnProperties(
@@ -271,6 +280,11 @@ class PARQUET_EXPORT ColumnProperties {
     page_index_enabled_ = page_index_enabled;
   }
 
+  void set_bloom_filter_options(
+      std::optional<BloomFilterOptions> bloom_filter_options) {
+    bloom_filter_options_ = bloom_filter_options;
+  }
+
   Encoding::type encoding() const {
     return encoding_;
   }
@@ -303,6 +317,10 @@ class PARQUET_EXPORT ColumnProperties {
     return page_index_enabled_;
   }
 
+  const std::optional<BloomFilterOptions>& bloom_filter_options() const {
+    return bloom_filter_options_;
+  }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
@@ -311,6 +329,7 @@ class PARQUET_EXPORT ColumnProperties {
   size_t max_stats_size_;
   std::shared_ptr<CodecOptions> codec_options_;
   bool page_index_enabled_;
+  std::optional<BloomFilterOptions> bloom_filter_options_;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -733,6 +752,25 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_write_page_index(path->ToDotString());
     }
 
+    /// Enable writing a split block bloom filter of each column chunk of the
+    /// column specified by `path`. The filters are written after the last row
+    /// group. BOOLEAN columns have no bloom filter. Default disabled.
+    ///
+    /// Please check the link below for more details:
+    /// https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+    Builder* enable_bloom_filter(
+        const std::string& path,
+        const BloomFilterOptions& options = BloomFilterOptions()) {
+      bloom_filter_options_[path] = options;
+      return this;
+    }
+
+    /// Disable writing bloom filters for column specified by `path`.
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_options_[path] = std::nullopt;
+      return this;
+    }
+
     /// \brief Build the WriterProperties with the builder parameters.
     /// \return The WriterProperties defined by the builder.
     std::shared_ptr<WriterProperties> build() {
@@ -757,6 +795,8 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_statistics_enabled(item.second);
       for (const auto& item : page_index_enabled_)
         get(item.first).set_page_index_enabled(item.second);
+      for (const auto& item : bloom_filter_options_)
+        get(item.first).set_bloom_filter_options(item.second);
 
       return std::shared_ptr<WriterProperties>(new WriterProperties(
           pool_,
@@ -801,6 +841,8 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
     std::unordered_map<std::string, bool> page_index_enabled_;
+    std::unordered_map<std::string, std::optional<BloomFilterOptions>>
+        bloom_filter_options_;
   };
 
   inline MemoryPool* memory_pool() const {
@@ -922,6 +964,23 @@ class PARQUET_EXPORT WriterProperties {
     return false;
   }
 
+  const std::optional<BloomFilterOptions>& bloom_filter_options(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_options();
+  }
+
+  bool bloom_filter_enabled() const {
+    if (default_column_properties_.bloom_filter_options().has_value()) {
+      return true;
+    }
+    for (const auto& item : column_properties_) {
+      if (item.second.bloom_filter_options().has_value()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   inline FileEncryptionProperties* file_encryption_properties() const {
     return file_encryption_properties_.get();
   }
@@ -32,12 +32,12 @@
 #include "arrow/testing/gtest_util.h"
 #include "arrow/testing/random.h"
 
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
 #include "velox/dwio/parquet/writer/arrow/Platform.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
-#include "velox/dwio/parquet/writer/arrow/tests/BloomFilter.h"
+#include "velox/dwio/parquet/writer/arrow/XxHasher.h"
 #include "velox/dwio/parquet/writer/arrow/tests/TestUtil.h"
-#include "velox/dwio/parquet/writer/arrow/tests/XxHasher.h"
 
 namespace facebook::velox::parquet::arrow {
 namespace test {
@@ -85,6 +85,19 @@ class Aggregate {
     return false;
   }
 
+  /// Returns true if the accumulators survive HashStringAllocator::compact(),
+  /// i.e. they keep no pointers into the allocator or relocate() updates them.
+  virtual bool supportsRelocation() const {
+    return false;
+  }
+
+  /// Updates the pointers from the accumulators in 'groups' into the allocator
+  /// after HashStringAllocator::compact() moved the blocks as described by
+  /// 'relocation'. Called only if supportsRelocation() is true.
+  virtual void relocate(
+      folly::Range<char**> /*groups*/,
+      const HashStringAllocator::Relocation& /*relocation*/) {}
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
@@ -476,6 +489,12 @@ struct AggregateFunctionMetadata {
   /// True if results of the aggregation depend on the order of inputs. For
   /// example, array_agg is order sensitive while count is not.
   bool orderSensitive{true};
+
+  /// If set, the result of the aggregation over inputs sorted by ORDER BY
+  /// keys depends only on the first 'sortedInputLimit' inputs. For example,
+  /// first(x ORDER BY y) only needs the input with the lowest y. Allows
+  /// keeping only these inputs for each group instead of all of them.
+  std::optional<uint32_t> sortedInputLimit;
 };
 /// Register an aggregate function with the specified name and signatures. If
 /// registerCompanionFunctions is true, also register companion aggregate and
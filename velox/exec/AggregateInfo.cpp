@@ -125,6 +125,9 @@ std::vector<AggregateInfo> toAggregateInfo(
       for (const auto& key : aggregate.sortingKeys) {
         info.sortingKeys.push_back(exprToChannel(key.get(), inputType));
       }
+      if (numSortingKeys > 0) {
+        info.sortedInputLimit = metadata.sortedInputLimit;
+      }
     }
 
     info.output = index;
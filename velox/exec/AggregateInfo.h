@@ -44,6 +44,10 @@ struct AggregateInfo {
   /// Optional list of sorting orders that goes with 'sortingKeys'.
   std::vector<core::SortOrder> sortingOrders;
 
+  /// Optional number of leading inputs in the order of 'sortingKeys' that the
+  /// result depends on, see AggregateFunctionMetadata::sortedInputLimit.
+  std::optional<uint32_t> sortedInputLimit;
+
   /// Boolean indicating whether inputs must be de-duplicated before
   /// aggregating.
   bool distinct{false};
@@ -29,6 +29,14 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Frames that are not handled incrementally and are at least
+// 'window_segment_tree_min_frame_size' rows long on average are computed
+// from a segment tree of intermediate results. Level 0 of the tree has the
+// accumulators of each 'kSegmentTreeFanout' consecutive rows of the
+// partition and each higher level combines 'kSegmentTreeFanout' nodes of the
+// level below. A frame is then the combination of less than
+// 2 * 'kSegmentTreeFanout' rows or nodes per level instead of all its rows.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -39,7 +47,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator,
       const core::QueryConfig& config)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator),
+        segmentTreeMinFrameSize_(config.windowSegmentTreeMinFrameSize()) {
     VELOX_USER_CHECK(
         !ignoreNulls, "Aggregate window functions do not support IGNORE NULLS");
     argTypes_.reserve(args.size());
@@ -66,6 +75,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
         resultType,
         config);
     aggregate_->setAllocator(stringAllocator_);
+    intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
 
     // Aggregate initialization.
     // Row layout is:
@@ -116,6 +126,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.clear();
   }
 
   void apply(
@@ -164,20 +175,45 @@ class AggregateWindowFunction : public exec::WindowFunction {
           resultOffset,
           result);
     } else {
+      const bool segmentTree =
+          useSegmentTree(validRows, rawFrameStarts, rawFrameEnds);
+      if (segmentTree && segmentTree_.empty()) {
+        // Reads the arguments of the whole partition, so must be done before
+        // filling the arguments of this block.
+        buildSegmentTree();
+      }
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
-      simpleAggregation(
-          validRows,
-          frameMetadata.firstRow,
-          frameMetadata.lastRow,
-          rawFrameStarts,
-          rawFrameEnds,
-          resultOffset,
-          result);
+      if (segmentTree) {
+        segmentTreeAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      } else {
+        simpleAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      }
     }
     previousFrameMetadata_ = frameMetadata;
   }
 
  private:
+  // Number of rows or lower level nodes combined in a node of the segment
+  // tree.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // Number of partition rows added to level 0 of the segment tree at a time.
+  static constexpr vector_size_t kSegmentTreeBatchSize =
+      kSegmentTreeFanout * 1'024;
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -345,6 +381,178 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are long enough on average for
+  // the segment tree to pay off.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (segmentTreeMinFrameSize_ == 0 || partition_->partial()) {
+      // The tree covers all rows of the partition.
+      return false;
+    }
+    uint64_t numFrameRows = 0;
+    vector_size_t numFrames = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] + 1 - rawFrameStarts[i];
+      ++numFrames;
+    });
+    return numFrameRows >= segmentTreeMinFrameSize_ * numFrames;
+  }
+
+  // Allocates and initializes 'numGroups' accumulators in 'buffer' and
+  // returns their addresses.
+  std::vector<char*> initializeGroups(
+      vector_size_t numGroups,
+      BufferPtr& buffer) {
+    const auto groupSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    buffer = AlignedBuffer::allocate<char>(numGroups * groupSize, pool_, '\0');
+    auto* rawBuffer = buffer->asMutable<char>();
+    std::vector<char*> groups(numGroups);
+    std::vector<vector_size_t> indices(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups[i] = rawBuffer + i * groupSize;
+      indices[i] = i;
+    }
+    aggregate_->initializeNewGroups(groups.data(), indices);
+    return groups;
+  }
+
+  // Extracts the intermediate results of 'groups' as the next level of the
+  // segment tree and frees the accumulators.
+  void addSegmentTreeLevel(std::vector<char*>& groups) {
+    auto level = BaseVector::create(intermediateType_, groups.size(), pool_);
+    aggregate_->extractAccumulators(groups.data(), groups.size(), &level);
+    aggregate_->destroy(folly::Range(groups.data(), groups.size()));
+    segmentTree_.push_back(std::move(level));
+  }
+
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    vector_size_t numNodes =
+        (numRows + kSegmentTreeFanout - 1) / kSegmentTreeFanout;
+    BufferPtr buffer;
+    auto nodes = initializeGroups(numNodes, buffer);
+    std::vector<char*> groups;
+    SelectivityVector rows;
+    for (vector_size_t begin = 0; begin < numRows;
+         begin += kSegmentTreeBatchSize) {
+      const auto end = std::min(begin + kSegmentTreeBatchSize, numRows);
+      fillArgVectors(begin, end - 1);
+      groups.resize(end - begin);
+      for (auto row = begin; row < end; ++row) {
+        groups[row - begin] = nodes[row / kSegmentTreeFanout];
+      }
+      rows.resizeFill(end - begin);
+      aggregate_->addRawInput(groups.data(), rows, argVectors_, false);
+    }
+    addSegmentTreeLevel(nodes);
+
+    while (numNodes > kSegmentTreeFanout) {
+      const auto numChildren = numNodes;
+      numNodes = (numChildren + kSegmentTreeFanout - 1) / kSegmentTreeFanout;
+      nodes = initializeGroups(numNodes, buffer);
+      groups.resize(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        groups[i] = nodes[i / kSegmentTreeFanout];
+      }
+      rows.resizeFill(numChildren);
+      aggregate_->addIntermediateResults(
+          groups.data(), rows, {segmentTree_.back()}, false);
+      addSegmentTreeLevel(nodes);
+    }
+  }
+
+  // Adds [begin, end) of 'level' of the segment tree to the single group.
+  // Level -1 is the raw input in 'argVectors_', which starts at partition
+  // row 'firstRow'.
+  void addSegment(
+      int32_t level,
+      vector_size_t begin,
+      vector_size_t end,
+      vector_size_t firstRow) {
+    segmentRows_.resizeFill(end - begin);
+    if (level < 0) {
+      for (auto i = 0; i < argVectors_.size(); ++i) {
+        segmentArgs_[i] = argVectors_[i]->slice(begin - firstRow, end - begin);
+      }
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, segmentRows_, segmentArgs_, false);
+    } else {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_,
+          segmentRows_,
+          {segmentTree_[level]->slice(begin, end - begin)},
+          false);
+    }
+  }
+
+  // Aggregates the partition rows [frameStart, frameEnd] into the single
+  // group. The rows at the edges of the frame that do not fill a level 0
+  // node are added from the raw input and the rest from the highest nodes
+  // that cover them. These are added in the order of their rows for the
+  // order sensitive aggregates.
+  void aggregateFrame(
+      vector_size_t frameStart,
+      vector_size_t frameEnd,
+      vector_size_t firstRow) {
+    // The segments right of the middle of the frame, from the lowest level
+    // up. These are added after the higher levels.
+    std::vector<std::tuple<int32_t, vector_size_t, vector_size_t>>
+        rightSegments;
+    vector_size_t begin = frameStart;
+    vector_size_t end = frameEnd + 1;
+    for (int32_t level = -1;; ++level) {
+      const auto leftEnd = bits::roundUp(begin, kSegmentTreeFanout);
+      const auto rightBegin = end / kSegmentTreeFanout * kSegmentTreeFanout;
+      if (level + 1 == segmentTree_.size() ||
+          leftEnd + kSegmentTreeFanout > rightBegin) {
+        // No node of the next level is entirely in the range.
+        addSegment(level, begin, end, firstRow);
+        break;
+      }
+      if (begin < leftEnd) {
+        addSegment(level, begin, leftEnd, firstRow);
+      }
+      if (rightBegin < end) {
+        rightSegments.emplace_back(level, rightBegin, end);
+      }
+      begin = leftEnd / kSegmentTreeFanout;
+      end = rightBegin / kSegmentTreeFanout;
+    }
+    for (auto it = rightSegments.rbegin(); it != rightSegments.rend(); ++it) {
+      const auto [segmentLevel, segmentBegin, segmentEnd] = *it;
+      addSegment(segmentLevel, segmentBegin, segmentEnd, firstRow);
+    }
+  }
+
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    segmentArgs_.resize(argVectors_.size());
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      aggregateFrame(frameStartsVector[i], frameEndsVector[i], minFrame);
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -375,6 +583,20 @@ class AggregateWindowFunction : public exec::WindowFunction {
   std::vector<column_index_t> argIndices_;
   std::vector<VectorPtr> argVectors_;
 
+  // Min average frame size for using the segment tree. 0 disables it.
+  const uint64_t segmentTreeMinFrameSize_;
+
+  TypePtr intermediateType_;
+
+  // Intermediate results of the segment tree of the current partition, from
+  // the bottom level up. Built on first use for the partition.
+  std::vector<VectorPtr> segmentTree_;
+
+  // Selected rows and raw arguments of a segment of a frame. Reused between
+  // segments.
+  SelectivityVector segmentRows_;
+  std::vector<VectorPtr> segmentArgs_;
+
   // This is a single aggregate row needed by the aggregate function for its
   // computation. These values are for the row and its various components.
   BufferPtr singleGroupRowBufferPtr_;
@@ -426,7 +648,10 @@ void registerAggregateWindowFunction(const std::string& name) {
               pool,
               stringAllocator,
               config);
-        });
+        },
+        {.supportsRowsStreaming = true,
+         .ignoresFrame = false,
+         .incrementalFrames = true});
   }
 }
 } // namespace facebook::velox::exec
@@ -15,7 +15,9 @@
  */
 
 #include "Driver.h"
+#include <folly/Conv.h>
 #include <folly/ScopeGuard.h>
+#include <folly/String.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
@@ -26,6 +28,7 @@
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/WorkStealingExecutor.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -158,32 +161,11 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
   if (task->spillDirectory().empty()) {
     return std::nullopt;
   }
-  common::GetSpillDirectoryPathCB getSpillDirPathCb =
-      [this]() -> std::string_view {
-    return task->getOrCreateSpillDirectory();
-  };
-  const auto& spillFilePrefix =
+  // The directory is created on the first spill.
+  auto spillConfig = task->spillConfigTemplate();
+  spillConfig.fileNamePrefix =
       fmt::format("{}_{}_{}", pipelineId, driverId, operatorId);
-  common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb =
-      [this](uint64_t bytes) {
-        task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
-      };
-  return common::SpillConfig(
-      std::move(getSpillDirPathCb),
-      std::move(updateAndCheckSpillLimitCb),
-      spillFilePrefix,
-      queryConfig.maxSpillFileSize(),
-      queryConfig.spillWriteBufferSize(),
-      task->queryCtx()->spillExecutor(),
-      queryConfig.minSpillableReservationPct(),
-      queryConfig.spillableReservationGrowthPct(),
-      queryConfig.spillStartPartitionBit(),
-      queryConfig.spillNumPartitionBits(),
-      queryConfig.maxSpillLevel(),
-      queryConfig.maxSpillRunRows(),
-      queryConfig.writerFlushThresholdBytes(),
-      queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+  return spillConfig;
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -220,6 +202,14 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          if (const auto& trace = driver->trace()) {
+            trace->record(
+                state->operator_->operatorId(),
+                DriverTrace::kBlocked,
+                state->sinceMicros_,
+                getCurrentTimeMicro(),
+                state->reason_);
+          }
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -279,8 +269,35 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  const auto priority = driver->priority();
+  if (auto* workStealing = dynamic_cast<WorkStealingExecutor*>(executor)) {
+    workStealing->add(
+        [driver]() { Driver::run(driver); },
+        priority,
+        driver->lastThreadIndex_);
+  } else if (executor->getNumPriorities() > 1) {
+    executor->addWithPriority([driver]() { Driver::run(driver); }, priority);
+  } else {
+    executor->add([driver]() { Driver::run(driver); });
+  }
+}
+
+int8_t Driver::priority() const {
+  // A Driver whose sink is waited for by other pipelines, e.g. a hash build
+  // with waiting probes, is on the critical path and goes first if the
+  // executor supports priorities.
+  if (operators_.back()->hasWaitingConsumers()) {
+    return folly::Executor::HI_PRI;
+  }
+  // Otherwise the priority decays with the time the query has run.
+  const auto execTimeMs = task()->queryCtx()->execTimeMs();
+  const auto level = std::upper_bound(
+                         priorityLevelsMs_.begin(),
+                         priorityLevelsMs_.end(),
+                         execTimeMs) -
+      priorityLevelsMs_.begin();
+  return folly::Executor::MID_PRI - level;
 }
 
 void Driver::init(
@@ -289,10 +306,38 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  blockedWaitUs_ = ctx_->queryConfig().driverBlockedWaitUs();
+  priorityLevelsMs_ = task()->driverPriorityLevelsMs();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  pipelineProgress_ = &task()->pipelineProgress(ctx_->pipelineId);
+  if (ctx_->queryConfig().pipelineNdvSketchEnabled() &&
+      operators_.size() > 1) {
+    sinkNdvSketchPool_ = task()->addOperatorPool(
+        operators_.back()->planNodeId(),
+        ctx_->splitGroupId,
+        ctx_->pipelineId,
+        ctx_->driverId,
+        "NdvSketch");
+  }
+  const auto traceCapacity = ctx_->queryConfig().driverTraceCapacity();
+  if (traceCapacity > 0) {
+    std::vector<std::string> operatorNames;
+    operatorNames.reserve(operators_.size());
+    for (const auto& op : operators_) {
+      operatorNames.push_back(
+          fmt::format("{}.{}", op->operatorType(), op->planNodeId()));
+    }
+    trace_ = std::make_shared<DriverTrace>(
+        ctx_->pipelineId,
+        ctx_->driverId,
+        std::move(operatorNames),
+        traceCapacity);
+  }
 }
 
 void Driver::initializeOperators() {
@@ -373,6 +418,48 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
   return result;
 }
 
+BlockingReason Driver::isBlocked(Operator* op, ContinueFuture* future) {
+  auto reason = op->isBlocked(future);
+  // A wait that ends while still on thread costs much less than going off
+  // thread and being enqueued again. Ask again while the future is ready. A
+  // yield is not retried, its future is ready and going off thread is the
+  // point of it.
+  for (auto i = 0; i < kMaxOnThreadWaits &&
+       reason != BlockingReason::kNotBlocked &&
+       reason != BlockingReason::kYield;
+       ++i) {
+    if (!future->valid()) {
+      break;
+    }
+    if (!future->isReady()) {
+      if (blockedWaitUs_ == 0) {
+        break;
+      }
+      const auto startMicros = getCurrentTimeMicro();
+      future->wait(std::chrono::microseconds(blockedWaitUs_));
+      if (!future->isReady()) {
+        break;
+      }
+      op->recordBlockingTime(startMicros, reason);
+      if (trace_) {
+        trace_->record(
+            op->operatorId(),
+            DriverTrace::kBlocked,
+            startMicros,
+            getCurrentTimeMicro(),
+            reason);
+      }
+    }
+    if (future->hasException()) {
+      // BlockingState reports the error.
+      break;
+    }
+    *future = ContinueFuture::makeEmpty();
+    reason = op->isBlocked(future);
+  }
+  return reason;
+}
+
 void Driver::enqueueInternal() {
   VELOX_CHECK(!state_.isEnqueued);
   state_.isEnqueued = true;
@@ -388,9 +475,20 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
+    const auto traceStartUs = trace_ ? getCurrentTimeMicro() : 0;          \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
-    auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
+    auto stopGuard = folly::makeGuard([&]() {                              \
+      opCallStatus_.stop();                                                \
+      if (trace_) {                                                        \
+        trace_->record(                                                    \
+            operatorId,                                                    \
+            operatorMethod,                                                \
+            traceStartUs,                                                  \
+            getCurrentTimeMicro(),                                         \
+            BlockingReason::kNotBlocked);                                  \
+      }                                                                    \
+    });                                                                    \
     call;                                                                  \
     recordSilentThrows(*operatorPtr);                                      \
   } catch (const VeloxException&) {                                        \
@@ -490,6 +588,14 @@ StopReason Driver::runInternal(
     RowVectorPtr& result) {
   const auto now = getCurrentTimeMicro();
   const auto queuedTimeUs = now - queueTimeStartUs_;
+  if (trace_ && queueTimeStartUs_ > 0) {
+    trace_->record(
+        curOperatorId_,
+        DriverTrace::kQueued,
+        queueTimeStartUs_,
+        now,
+        BlockingReason::kNotBlocked);
+  }
   // Update the next operator's queueTime.
   StopReason stop =
       closed_ ? StopReason::kTerminate : task()->enter(state_, now);
@@ -585,7 +691,7 @@ StopReason Driver::runInternal(
         }
 
         CALL_OPERATOR(
-            blockingReason_ = op->isBlocked(&future),
+            blockingReason_ = isBlocked(op, &future),
             op,
             curOperatorId_,
             kOpMethodIsBlocked);
@@ -602,7 +708,7 @@ StopReason Driver::runInternal(
           Operator* nextOp = operators_[i + 1].get();
 
           CALL_OPERATOR(
-              blockingReason_ = nextOp->isBlocked(&future),
+              blockingReason_ = isBlocked(nextOp, &future),
               nextOp,
               curOperatorId_ + 1,
               kOpMethodIsBlocked);
@@ -630,10 +736,18 @@ StopReason Driver::runInternal(
                     processLazyTiming(*op, deltaTiming);
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto counters = createDeltaHardwareCounters(
+                  [op](const process::HardwareCounters& delta) {
+                    op->stats().wlock()->getOutputCounters.add(delta);
+                  });
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
-                  intermediateResult = op->getOutput(),
+                  {
+                    memory::ScopedMemoryAllocationSite siteScope(
+                        memory::MemoryAllocationSite::kOutput);
+                    intermediateResult = op->getOutput();
+                  },
                   op,
                   curOperatorId_,
                   kOpMethodGetOutput);
@@ -652,6 +766,10 @@ StopReason Driver::runInternal(
                   lockedStats->addOutputVector(
                       resultBytes, intermediateResult->size());
                 }
+                if (i == 0) {
+                  pipelineProgress_->inputRows.fetch_add(
+                      intermediateResult->size(), std::memory_order_relaxed);
+                }
               }
             }
             pushdownFilters(i);
@@ -661,14 +779,30 @@ StopReason Driver::runInternal(
                     auto selfDelta = processLazyTiming(*nextOp, timing);
                     nextOp->stats().wlock()->addInputTiming.add(selfDelta);
                   });
+              auto counters = createDeltaHardwareCounters(
+                  [nextOp](const process::HardwareCounters& delta) {
+                    nextOp->stats().wlock()->addInputCounters.add(delta);
+                  });
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(
                     resultBytes, intermediateResult->size());
               }
+              if (i + 2 == numOperators) {
+                pipelineProgress_->outputRows.fetch_add(
+                    intermediateResult->size(), std::memory_order_relaxed);
+              }
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
+              if (sinkNdvSketchPool_ != nullptr && i + 2 == numOperators) {
+                if (sinkNdvSketch_ == nullptr) {
+                  sinkNdvSketch_ = std::make_unique<NdvSketch>(
+                      asRowType(intermediateResult->type()),
+                      sinkNdvSketchPool_);
+                }
+                sinkNdvSketch_->add(*intermediateResult);
+              }
 
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
@@ -693,7 +827,7 @@ StopReason Driver::runInternal(
               // not the source, just try to get output from the one
               // before.
               CALL_OPERATOR(
-                  blockingReason_ = op->isBlocked(&future),
+                  blockingReason_ = isBlocked(op, &future),
                   op,
                   curOperatorId_,
                   kOpMethodIsBlocked);
@@ -740,8 +874,16 @@ StopReason Driver::runInternal(
                   auto selfDelta = processLazyTiming(*op, timing);
                   op->stats().wlock()->getOutputTiming.add(selfDelta);
                 });
+            auto counters = createDeltaHardwareCounters(
+                [op](const process::HardwareCounters& delta) {
+                  op->stats().wlock()->getOutputCounters.add(delta);
+                });
             CALL_OPERATOR(
-                result = op->getOutput(),
+                {
+                  memory::ScopedMemoryAllocationSite siteScope(
+                      memory::MemoryAllocationSite::kOutput);
+                  result = op->getOutput();
+                },
                 op,
                 curOperatorId_,
                 kOpMethodGetOutput);
@@ -813,6 +955,10 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  if (auto* workStealing = dynamic_cast<WorkStealingExecutor*>(
+          self->task()->queryCtx()->executor())) {
+    self->lastThreadIndex_ = workStealing->currentThreadIndex();
+  }
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
@@ -882,6 +1028,9 @@ void Driver::closeOperators() {
     stats.numDrivers = 1;
     task()->addOperatorStats(stats);
   }
+  if (sinkNdvSketch_ != nullptr) {
+    task()->addPipelineNdvSketch(ctx_->pipelineId, std::move(sinkNdvSketch_));
+  }
 }
 
 void Driver::updateStats() {
@@ -22,12 +22,15 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/DriverTrace.h"
+#include "velox/exec/NdvSketch.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -36,6 +39,7 @@ class Driver;
 class ExchangeClient;
 class Operator;
 struct OperatorStats;
+struct PipelineProgressCounters;
 class Task;
 
 enum class StopReason {
@@ -392,6 +396,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// time slice limit if set.
   bool shouldYield() const;
 
+  /// Returns the priority for enqueuing 'this' on the executor: HI_PRI if
+  /// other pipelines wait for its sink, otherwise MID_PRI minus the number of
+  /// QueryConfig::kDriverPriorityLevelsMs passed by the query.
+  int8_t priority() const;
+
   /// Checks if the associated query is under memory arbitration or not. The
   /// function returns true if it is and set future which is fulfilled when the
   /// the memory arbiration finishes.
@@ -451,6 +460,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return blockingReason_;
   }
 
+  /// Returns the timeline of 'this' or nullptr if not enabled. See
+  /// QueryConfig::kDriverTraceCapacity.
+  const std::shared_ptr<DriverTrace>& trace() const {
+    return trace_;
+  }
+
   /// Returns the process-wide number of driver cpu yields.
   static std::atomic_uint64_t& yieldCount();
 
@@ -502,6 +517,22 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // If 'trackOperatorHardwareCounters_' is true and the thread's hardware
+  // counters are available, returns an object that passes the counts since
+  // its construction to 'func' upon destruction. Returns null otherwise.
+  template <typename F>
+  std::unique_ptr<process::DeltaHardwareCounters<F>>
+  createDeltaHardwareCounters(F&& func) {
+    if (!trackOperatorHardwareCounters_) {
+      return nullptr;
+    }
+    auto* counters = process::PerfCounters::forCurrentThread();
+    return counters != nullptr
+        ? std::make_unique<process::DeltaHardwareCounters<F>>(
+              counters, std::move(func))
+        : nullptr;
+  }
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -510,11 +541,31 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // but these do not bias the op's timing.
   CpuWallTiming processLazyTiming(Operator& op, const CpuWallTiming& timing);
 
+  // Max number of times isBlocked() waits for a future on thread before the
+  // Driver goes off thread.
+  static constexpr int32_t kMaxOnThreadWaits = 4;
+
+  // Calls op->isBlocked(). If the returned future is ready, or becomes ready
+  // within 'blockedWaitUs_', calls it again instead of going off thread.
+  BlockingReason isBlocked(Operator* op, ContinueFuture* future);
+
   std::unique_ptr<DriverCtx> ctx_;
 
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // Max time in microseconds to wait on thread for the future of a blocked
+  // operator. See QueryConfig::kDriverBlockedWaitUs.
+  uint64_t blockedWaitUs_{0};
+
+  // Index of the WorkStealingExecutor thread that last ran 'this' or -1. The
+  // Driver is enqueued to the same thread to keep its data in cache.
+  int32_t lastThreadIndex_{-1};
+
+  // Query execution times at which the priority of 'this' drops a level. See
+  // QueryConfig::kDriverPriorityLevelsMs.
+  std::vector<uint64_t> priorityLevelsMs_;
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -538,6 +589,22 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorHardwareCounters_{false};
+
+  // Counters of the pipeline of 'this' for Task::progress(). Owned by the
+  // Task.
+  PipelineProgressCounters* pipelineProgress_{nullptr};
+
+  // Set if QueryConfig::kDriverTraceCapacity is not 0. Kept by Task after
+  // 'this' finishes.
+  std::shared_ptr<DriverTrace> trace_;
+
+  // Pool and NDV estimates of the input of the last operator if
+  // QueryConfig::kPipelineNdvSketchEnabled is set. The sketch is made on the
+  // first input and passed to Task at close.
+  memory::MemoryPool* sinkNdvSketchPool_{nullptr};
+  std::unique_ptr<NdvSketch> sinkNdvSketch_;
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
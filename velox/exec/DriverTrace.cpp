@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverTrace.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+DriverTrace::DriverTrace(
+    int32_t pipelineId,
+    int32_t driverId,
+    std::vector<std::string> operatorNames,
+    int32_t capacity)
+    : pipelineId_(pipelineId),
+      driverId_(driverId),
+      operatorNames_(std::move(operatorNames)),
+      capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+void DriverTrace::record(
+    int32_t operatorId,
+    const char* name,
+    uint64_t startUs,
+    uint64_t endUs,
+    BlockingReason reason) {
+  std::lock_guard<std::mutex> l(mutex_);
+  Event event{operatorId, name, startUs, std::max(startUs, endUs), reason};
+  if (events_.size() < capacity_) {
+    events_.push_back(event);
+  } else {
+    events_[numEvents_ % capacity_] = event;
+  }
+  ++numEvents_;
+}
+
+std::vector<DriverTrace::Event> DriverTrace::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < capacity_) {
+    return events_;
+  }
+  std::vector<Event> result;
+  result.reserve(capacity_);
+  const auto oldest = numEvents_ % capacity_;
+  result.insert(result.end(), events_.begin() + oldest, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + oldest);
+  return result;
+}
+
+uint64_t DriverTrace::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numEvents_ - events_.size();
+}
+
+void DriverTrace::appendChromeTrace(folly::dynamic& traceEvents) const {
+  for (const auto& event : events()) {
+    const auto& operatorName =
+        event.operatorId >= 0 && event.operatorId < operatorNames_.size()
+        ? operatorNames_[event.operatorId]
+        : std::string("Driver");
+    folly::dynamic traceEvent = folly::dynamic::object;
+    traceEvent["name"] = fmt::format("{}::{}", operatorName, event.name);
+    traceEvent["cat"] = event.name;
+    traceEvent["ph"] = "X";
+    traceEvent["ts"] = event.startUs;
+    traceEvent["dur"] = event.endUs - event.startUs;
+    traceEvent["pid"] = pipelineId_;
+    traceEvent["tid"] = driverId_;
+    if (event.reason != BlockingReason::kNotBlocked) {
+      traceEvent["args"] = folly::dynamic::object(
+          "reason", blockingReasonToString(event.reason));
+    }
+    traceEvents.push_back(std::move(traceEvent));
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <folly/dynamic.h>
+
+namespace facebook::velox::exec {
+
+enum class BlockingReason;
+
+/// Timeline of one Driver for finding out where its wall time goes: in calls
+/// to its operators, queued on the executor or blocked on the future of an
+/// operator, e.g. for memory arbitration. Keeps the last 'capacity' events
+/// in a ring buffer. Enabled by QueryConfig::kDriverTraceCapacity and
+/// exported for all the Drivers of a Task by Task::toChromeTrace().
+class DriverTrace {
+ public:
+  /// Name of the event for the time between enqueuing a Driver and it
+  /// starting to run.
+  static constexpr const char* kQueued = "queued";
+  /// Name of the event for the time an operator waits for its blocking
+  /// future.
+  static constexpr const char* kBlocked = "blocked";
+
+  struct Event {
+    /// Index of the operator in the Driver.
+    int32_t operatorId;
+    /// One of kOpMethodXxx, kQueued or kBlocked.
+    const char* name;
+    uint64_t startUs;
+    uint64_t endUs;
+    /// Set for kBlocked events.
+    BlockingReason reason;
+  };
+
+  /// 'operatorNames' are the labels of the operators of the Driver by
+  /// operator id.
+  DriverTrace(
+      int32_t pipelineId,
+      int32_t driverId,
+      std::vector<std::string> operatorNames,
+      int32_t capacity);
+
+  /// Records an event, replacing the oldest one if the buffer is full. May be
+  /// called from the thread that unblocks the Driver, so this takes a mutex,
+  /// which is not contended except with a concurrent export.
+  void record(
+      int32_t operatorId,
+      const char* name,
+      uint64_t startUs,
+      uint64_t endUs,
+      BlockingReason reason);
+
+  /// Returns the events in the buffer, oldest first.
+  std::vector<Event> events() const;
+
+  /// Returns the number of events that were overwritten by newer ones.
+  uint64_t numDropped() const;
+
+  /// Appends the events in the buffer to 'traceEvents' as Chrome trace
+  /// complete events. The pipeline is the process id and the Driver is the
+  /// thread id.
+  void appendChromeTrace(folly::dynamic& traceEvents) const;
+
+ private:
+  const int32_t pipelineId_;
+  const int32_t driverId_;
+  const std::vector<std::string> operatorNames_;
+  const int32_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  // Number of events recorded so far. The next event goes to 'events_'
+  // [numEvents_ % capacity_].
+  uint64_t numEvents_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -74,7 +74,8 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
+  const auto maxBytes =
+      getSerde()->supportsAppendInDeserialize() && !preserveEncodings_
       ? preferredOutputBatchBytes_
       : 1;
 
@@ -119,6 +120,16 @@ RowVectorPtr Exchange::getOutput() {
   for (const auto& page : currentPages_) {
     rawInputBytes += page->size();
 
+    if (getSerde()->supportsZeroCopyDeserialize()) {
+      // The result references the page memory, which is shared with the
+      // cloned IOBuf.
+      VELOX_CHECK_EQ(resultOffset, 0);
+      getSerde()->deserializeIOBuf(
+          page->getIOBuf(), pool(), outputType_, &result_, &options_);
+      resultOffset = result_->size();
+      continue;
+    }
+
     auto inputStream = page->prepareStreamForDeserialize();
 
     while (!inputStream.atEnd()) {
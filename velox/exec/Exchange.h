@@ -51,6 +51,8 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        preserveEncodings_{
+            driverCtx->queryConfig().exchangePreserveEncodings()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
@@ -94,6 +96,10 @@ class Exchange : public SourceOperator {
 
   const uint64_t preferredOutputBatchBytes_;
 
+  /// If true, returns each page as a separate vector to keep the dictionary
+  /// and constant encodings of the serialized columns.
+  const bool preserveEncodings_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -150,9 +153,16 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
       future = spec.source->request(spec.maxBytes, kRequestDataMaxWait);
     }
     VELOX_CHECK(future.valid());
+    const auto requestTimeMs = getCurrentTimeMs();
     std::move(future)
         .via(executor_)
-        .thenValue([self, spec = std::move(spec)](auto&& response) {
+        .thenValue([self, spec = std::move(spec), requestTimeMs](
+                       auto&& response) {
+          if (spec.maxBytes != 0) {
+            RECORD_HISTOGRAM_METRIC_VALUE(
+                kMetricExchangeDataRequestLatencyMs,
+                getCurrentTimeMs() - requestTimeMs);
+          }
           std::vector<RequestSpec> requestSpecs;
           {
             std::lock_guard<std::mutex> l(self->queue_->mutex());
@@ -161,12 +171,15 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
             }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
+                int64_t totalBytes = 0;
                 for (auto bytes : response.remainingBytes) {
                   VELOX_CHECK_GT(bytes, 0);
+                  totalBytes += bytes;
                 }
-                self->producingSources_.push(
+                self->addProducingSourceLocked(
                     {std::move(spec.source),
-                     std::move(response.remainingBytes)});
+                     std::move(response.remainingBytes),
+                     totalBytes});
               } else {
                 self->emptySources_.push(std::move(spec.source));
               }
@@ -183,6 +196,22 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   }
 }
 
+void ExchangeClient::addProducingSourceLocked(ProducingSource&& source) {
+  producingBytes_ += source.totalBytes;
+  producingSources_.push_back(std::move(source));
+  std::push_heap(
+      producingSources_.begin(), producingSources_.end(), hasLessBufferedData);
+}
+
+ExchangeClient::ProducingSource ExchangeClient::popProducingSourceLocked() {
+  std::pop_heap(
+      producingSources_.begin(), producingSources_.end(), hasLessBufferedData);
+  auto source = std::move(producingSources_.back());
+  producingSources_.pop_back();
+  producingBytes_ -= source.totalBytes;
+  return source;
+}
+
 std::vector<ExchangeClient::RequestSpec>
 ExchangeClient::pickSourcesToRequestLocked() {
   if (closed_) {
@@ -197,36 +226,42 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+  // Each source gets a share of the space available at this point in
+  // proportion to its buffered data, but at least one page.
+  const double spacePerByte = producingBytes_ > 0
+      ? std::max<double>(0, availableSpace) / producingBytes_
+      : 0;
   while (availableSpace > 0 && !producingSources_.empty()) {
-    auto& source = producingSources_.front().source;
+    const auto& top = producingSources_.front();
+    const int64_t credit = top.totalBytes * spacePerByte;
     int64_t requestBytes = 0;
-    for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+    for (auto bytes : top.remainingBytes) {
+      if (bytes > availableSpace ||
+          (requestBytes > 0 && requestBytes + bytes > credit)) {
         break;
       }
       requestBytes += bytes;
     }
     if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
+      VELOX_CHECK_LT(availableSpace, top.remainingBytes.at(0));
       break;
     }
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    auto producing = popProducingSourceLocked();
+    VELOX_CHECK(producing.source->shouldRequestLocked());
+    requestSpecs.push_back({std::move(producing.source), requestBytes});
+    availableSpace -= requestBytes;
     totalPendingBytes_ += requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
     // We have full capacity but still cannot initiate one single data transfer.
     // Let the transfer happen in this case to avoid getting stuck.
-    auto& source = producingSources_.front().source;
-    auto requestBytes = producingSources_.front().remainingBytes.at(0);
+    auto producing = popProducingSourceLocked();
+    auto requestBytes = producing.remainingBytes.at(0);
     LOG(INFO) << "Requesting large single page " << requestBytes
               << " bytes, exceeding capacity " << maxQueuedBytes_;
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    VELOX_CHECK(producing.source->shouldRequestLocked());
+    requestSpecs.push_back({std::move(producing.source), requestBytes});
     totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
@@ -109,8 +109,28 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Sum of 'remainingBytes'.
+    int64_t totalBytes;
   };
 
+  // Orders 'producingSources_' so that the source with the most buffered data
+  // is at the top of the heap.
+  static bool hasLessBufferedData(
+      const ProducingSource& lhs,
+      const ProducingSource& rhs) {
+    return lhs.totalBytes < rhs.totalBytes;
+  }
+
+  void addProducingSourceLocked(ProducingSource&& source);
+
+  ProducingSource popProducingSourceLocked();
+
+  // Requests data sizes from all sources with no data and data from the
+  // producing sources that fit in the remaining queue budget. The budget is
+  // divided across the producing sources in proportion to their buffered
+  // data, so that many sources transfer at the same time instead of one
+  // source taking the whole budget. Sources with the most buffered data are
+  // requested first to unblock the producers closest to being blocked.
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
   void request(std::vector<RequestSpec>&& requestSpecs);
@@ -130,9 +150,11 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
-  // A queue of sources that have returned non-empty response from the latest
-  // request.
-  std::queue<ProducingSource> producingSources_;
+  // A max-heap ordered by hasLessBufferedData() of sources that have returned
+  // non-empty response from the latest request.
+  std::vector<ProducingSource> producingSources_;
+  // Sum of 'totalBytes' of 'producingSources_'.
+  int64_t producingBytes_{0};
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
 };
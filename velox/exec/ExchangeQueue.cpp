@@ -24,7 +24,7 @@ SerializedPage::SerializedPage(
     : iobuf_(std::move(iobuf)),
       iobufBytes_(chainBytes(*iobuf_.get())),
       numRows_(numRows),
-      onDestructionCb_(onDestructionCb) {
+      onDestructionCb_(std::move(onDestructionCb)) {
   VELOX_CHECK_NOT_NULL(iobuf_);
   for (auto& buf : *iobuf_) {
     int32_t bufSize = buf.size();
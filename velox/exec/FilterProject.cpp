@@ -90,10 +90,21 @@ void FilterProject::initialize() {
       auto fieldIndex = inputType->getChildIdx(field->name());
       distinctFieldIndices.insert(fieldIndex);
     }
+    std::unordered_set<uint32_t> filterFieldIndices;
+    if (hasFilter_) {
+      for (auto field : exprs_->expr(0)->distinctFields()) {
+        filterFieldIndices.insert(inputType->getChildIdx(field->name()));
+      }
+    }
     for (auto identityField : identityProjections_) {
-      if (distinctFieldIndices.find(identityField.inputChannel) !=
-          distinctFieldIndices.end()) {
-        multiplyReferencedFieldIndices_.push_back(identityField.inputChannel);
+      const auto channel = identityField.inputChannel;
+      if (distinctFieldIndices.find(channel) == distinctFieldIndices.end()) {
+        continue;
+      }
+      if (!hasFilter_ || filterFieldIndices.count(channel) > 0) {
+        multiplyReferencedFieldIndices_.push_back(channel);
+      } else {
+        projectedFieldIndices_.push_back(channel);
       }
     }
   }
@@ -167,6 +178,10 @@ RowVectorPtr FilterProject::getOutput() {
     if (!allRowsSelected) {
       rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
     }
+    // The identity projections only need the rows that passed the filter.
+    for (auto fieldIdx : projectedFieldIndices_) {
+      evalCtx.ensureFieldLoaded(fieldIdx, *rows);
+    }
     results = project(*rows, evalCtx);
   }
 
@@ -54,6 +54,9 @@ class FilterProject : public Operator {
   void close() override {
     Operator::close();
     if (exprs_ != nullptr) {
+      if (operatorCtx_->driverCtx()->queryConfig().exprProfileEnabled()) {
+        stats_.wlock()->exprProfiles = exprs_->profile();
+      }
       exprs_->clear();
     } else {
       VELOX_CHECK(!initialized_);
@@ -116,6 +119,12 @@ class FilterProject : public Operator {
   // If c1 is a LazyVector and f(c0) AND g(c1) expression is evaluated first, it
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
+  // If there is a filter, only the fields referenced by the filter are here.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Fields that are an identity projection and are referenced by a project
+  // expression but not by the filter. They are loaded after the filter for
+  // the rows that passed it, which are all the identity projections output.
+  std::vector<column_index_t> projectedFieldIndices_;
 };
 } // namespace facebook::velox::exec
@@ -60,6 +60,10 @@ GroupingSet::GroupingSet(
       isPartial_(isPartial),
       isRawInput_(isRawInput),
       queryConfig_(operatorCtx->task()->queryCtx()->queryConfig()),
+      parallelBuildExecutor_(
+          !isPartial_ && queryConfig_.aggregationParallelBuildPartitions() > 1
+              ? operatorCtx->task()->queryCtx()->executor()
+              : nullptr),
       aggregates_(std::move(aggregates)),
       masks_(extractMaskChannels(aggregates_)),
       ignoreNullKeys_(ignoreNullKeys),
@@ -116,27 +120,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*globalGroupingSets*/ std::vector<vector_size_t>{},
-      /*groupIdColumn*/ std::nullopt,
-      /*spillConfig*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx,
-      /*spillStats_*/ nullptr);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -152,6 +135,64 @@ bool equalKeys(
 
   return true;
 }
+
+// If all the children of 'input' are dictionaries over the same strictly
+// increasing indices that add no nulls, or constants, returns a row vector of
+// the dictionary bases and sets 'rows' to the base rows of the indices. This
+// is the output of a FilterProject for the rows that pass its filter. The
+// hashers and accumulators then read the flat results of the projection
+// directly instead of decoding the dictionary. Returns nullptr otherwise.
+RowVectorPtr peelFilterIndices(
+    const RowVectorPtr& input,
+    SelectivityVector& rows) {
+  if (input->size() == 0 || input->mayHaveNulls()) {
+    return nullptr;
+  }
+  const BaseVector* indicesVector = nullptr;
+  for (const auto& child : input->children()) {
+    if (child->encoding() == VectorEncoding::Simple::CONSTANT) {
+      continue;
+    }
+    if (child->encoding() != VectorEncoding::Simple::DICTIONARY ||
+        child->rawNulls() != nullptr) {
+      return nullptr;
+    }
+    if (indicesVector == nullptr) {
+      indicesVector = child.get();
+    } else if (child->wrapInfo() != indicesVector->wrapInfo()) {
+      return nullptr;
+    }
+  }
+  if (indicesVector == nullptr) {
+    return nullptr;
+  }
+
+  const auto* indices = indicesVector->wrapInfo()->as<vector_size_t>();
+  for (auto i = 1; i < input->size(); ++i) {
+    if (indices[i] <= indices[i - 1]) {
+      return nullptr;
+    }
+  }
+  const auto baseSize = indices[input->size() - 1] + 1;
+  rows.resize(baseSize);
+  rows.clearAll();
+  for (auto i = 0; i < input->size(); ++i) {
+    rows.setValid(indices[i], true);
+  }
+  rows.updateBounds();
+
+  std::vector<VectorPtr> children;
+  children.reserve(input->childrenSize());
+  for (const auto& child : input->children()) {
+    if (child->encoding() == VectorEncoding::Simple::CONSTANT) {
+      children.push_back(BaseVector::wrapInConstant(baseSize, 0, child));
+    } else {
+      children.push_back(child->valueVector());
+    }
+  }
+  return std::make_shared<RowVector>(
+      input->pool(), input->type(), nullptr, baseSize, std::move(children));
+}
 } // namespace
 
 void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
@@ -179,6 +220,13 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
         break;
       }
     }
+  } else if (isPartial_ && !isDistinct()) {
+    if (auto peeled = peelFilterIndices(input, activeRows_)) {
+      // The aggregation pushdown into the reader is only done for all the
+      // rows of the input.
+      addInputForActiveRows(peeled, false);
+      return;
+    }
   }
 
   activeRows_.resize(numRows);
@@ -187,7 +235,7 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
-void GroupingSet::noMoreInput() {
+void GroupingSet::noMoreInput(bool reserveOutput) {
   noMoreInput_ = true;
 
   if (remainingInput_) {
@@ -201,7 +249,9 @@ void GroupingSet::noMoreInput() {
     spill();
   }
 
-  ensureOutputFits();
+  if (reserveOutput) {
+    ensureOutputFits();
+  }
 }
 
 bool GroupingSet::hasSpilled() const {
@@ -236,7 +286,9 @@ void GroupingSet::addInputForActiveRows(
     return;
   }
 
+  removeRepeatedKeys();
   table_->groupProbe(*lookup_);
+  fillRepeatedKeyHits();
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
@@ -292,6 +344,74 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+void GroupingSet::removeRepeatedKeys() {
+  repeatedKeyRows_.clear();
+  if (removeRepeatedDictionaryKeys() ||
+      table_->hashMode() == BaseHashTable::HashMode::kHash) {
+    return;
+  }
+  auto& rows = lookup_->rows;
+  const auto* hashes = lookup_->hashes.data();
+  vector_size_t numRepeated = 0;
+  for (auto i = 1; i < rows.size(); ++i) {
+    numRepeated += hashes[rows[i]] == hashes[rows[i - 1]];
+  }
+  if (numRepeated < rows.size() / 2) {
+    return;
+  }
+  auto previousRow = rows[0];
+  vector_size_t numRows = 1;
+  for (auto i = 1; i < rows.size(); ++i) {
+    const auto row = rows[i];
+    if (hashes[row] == hashes[previousRow]) {
+      repeatedKeyRows_.emplace_back(row, previousRow);
+    } else {
+      rows[numRows++] = row;
+    }
+    previousRow = row;
+  }
+  rows.resize(numRows);
+}
+
+bool GroupingSet::removeRepeatedDictionaryKeys() {
+  if (lookup_->hashers.size() != 1) {
+    return false;
+  }
+  const auto& decoded = lookup_->hashers[0]->decodedVector();
+  auto& rows = lookup_->rows;
+  if (decoded.isIdentityMapping() || decoded.isConstantMapping() ||
+      decoded.base()->size() * 2 > rows.size()) {
+    return false;
+  }
+  constexpr vector_size_t kNoRow = -1;
+  firstDictionaryRows_.assign(decoded.base()->size(), kNoRow);
+  const auto* indices = decoded.indices();
+  // A null that comes from the dictionary does not have a null entry.
+  auto firstNullRow = kNoRow;
+  vector_size_t numRows = 0;
+  for (auto i = 0; i < rows.size(); ++i) {
+    const auto row = rows[i];
+    auto& firstRow = decoded.isNullAt(row) ? firstNullRow
+                                           : firstDictionaryRows_[indices[row]];
+    if (firstRow == kNoRow) {
+      firstRow = row;
+      rows[numRows++] = row;
+    } else {
+      repeatedKeyRows_.emplace_back(row, firstRow);
+    }
+  }
+  rows.resize(numRows);
+  return true;
+}
+
+void GroupingSet::fillRepeatedKeyHits() {
+  // The earlier row of a pair is either probed or filled in before.
+  auto* hits = lookup_->hits.data();
+  for (const auto& [row, previousRow] : repeatedKeyRows_) {
+    hits[row] = hits[previousRow];
+  }
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -361,6 +481,11 @@ void GroupingSet::createHashTable() {
     table_ = HashTable<false>::createForAggregation(
         std::move(hashers_), accumulators(false), &pool_);
   }
+  if (parallelBuildExecutor_ != nullptr) {
+    table_->setParallelGroupByBuild(
+        parallelBuildExecutor_,
+        queryConfig_.aggregationParallelBuildPartitions());
+  }
 
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
@@ -576,6 +701,28 @@ void GroupingSet::addGlobalAggregationInput(
   }
 }
 
+void GroupingSet::addGlobalIntermediateResults(
+    const std::vector<VectorPtr>& intermediates) {
+  VELOX_CHECK(isGlobal_);
+  VELOX_CHECK_EQ(intermediates.size(), aggregates_.size());
+  initializeGlobalAggregation();
+
+  auto* group = lookup_->hits[0];
+  activeRows_.resize(1);
+  activeRows_.setAll();
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    VELOX_CHECK(
+        !aggregate.mask.has_value() && !aggregate.distinct &&
+        aggregate.sortingKeys.empty());
+    VELOX_CHECK_EQ(intermediates[i]->size(), 1);
+    tempVectors_.assign({intermediates[i]});
+    aggregate.function->addSingleGroupIntermediateResults(
+        group, activeRows_, tempVectors_, false);
+  }
+  tempVectors_.clear();
+}
+
 bool GroupingSet::getGlobalAggregationOutput(
     RowContainerIterator& iterator,
     RowVectorPtr& result) {
@@ -798,9 +945,19 @@ void GroupingSet::resetTable() {
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
   VELOX_CHECK(isPartial_);
-  if (!table_ || allocatedBytes() <= maxBytes) {
+  if (!table_) {
     return false;
   }
+  if (allocatedBytes() <= maxBytes) {
+    // The next rehash doubles the table in one step. The new groups of the
+    // last batch are the estimate of how many the next batch adds. A kArray
+    // table is sized by the key ranges and does not grow with the groups.
+    return table_->hashMode() != BaseHashTable::HashMode::kArray &&
+        table_->numDistinct() > 0 &&
+        allocatedBytes() +
+            table_->hashTableSizeIncrease(lookup_->newGroups.size()) >
+        maxBytes;
+  }
   if (table_->hashMode() != BaseHashTable::HashMode::kArray) {
     // Not a kArray table, no rehashing will shrink this.
     return true;
@@ -906,13 +1063,21 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
                << ", reservation: " << succinctBytes(pool_.reservedBytes());
 }
 
-void GroupingSet::ensureOutputFits() {
+uint64_t GroupingSet::outputReservationBytes() const {
   // If spilling has already been triggered on this operator, then we don't need
   // to reserve memory for the output as we can't reclaim much memory from this
   // operator itself. The output processing can reclaim memory from the other
   // operator or query through memory arbitration.
   if (isPartial_ || spillConfig_ == nullptr || hasSpilled() ||
       table_ == nullptr || table_->numDistinct() == 0) {
+    return 0;
+  }
+  return queryConfig_.preferredOutputBatchBytes() * 1.2;
+}
+
+void GroupingSet::ensureOutputFits() {
+  const uint64_t outputBufferSizeToReserve = outputReservationBytes();
+  if (outputBufferSizeToReserve == 0) {
     return;
   }
 
@@ -923,8 +1088,6 @@ void GroupingSet::ensureOutputFits() {
     return;
   }
 
-  const uint64_t outputBufferSizeToReserve =
-      queryConfig_.preferredOutputBatchBytes() * 1.2;
   {
     memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
     if (pool_.maybeReserve(outputBufferSizeToReserve)) {
@@ -954,6 +1117,14 @@ RowTypePtr GroupingSet::makeSpillType() const {
   return ROW(std::move(names), std::move(types));
 }
 
+int64_t GroupingSet::compactRows() {
+  if (table_ == nullptr || sortedAggregations_ != nullptr ||
+      !distinctAggregations_.empty()) {
+    return 0;
+  }
+  return table_->rows()->compactStringAllocator();
+}
+
 void GroupingSet::spill() {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
@@ -1041,7 +1212,11 @@ bool GroupingSet::getOutputWithSpill(
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(&pool_, spillStats_);
+    merge_ = spillPartition.createOrderedReader(
+        &pool_,
+        spillStats_,
+        spillConfig_->executor,
+        spillConfig_->readPrefetchBytes);
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
@@ -1216,9 +1391,22 @@ void GroupingSet::abandonPartialAggregation() {
       &pool_,
       table_->rows()->stringAllocatorShared());
   initializeAggregates(aggregates_, *intermediateRows_, true);
+  // Keeps hashers for a new table in case of resumePartialAggregation().
+  hashers_.clear();
+  for (const auto& hasher : table_->hashers()) {
+    hashers_.push_back(VectorHasher::create(hasher->type(), hasher->channel()));
+  }
+  lookup_.reset();
   table_.reset();
 }
 
+void GroupingSet::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(table_);
+  abandonedPartialAggregation_ = false;
+  intermediateRows_.reset();
+}
+
 namespace {
 // Recursive resize all children.
 
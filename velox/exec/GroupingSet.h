@@ -45,16 +45,21 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
-  void noMoreInput();
+  /// Adds to a global aggregation the intermediate results in 'intermediates',
+  /// one single row vector per aggregate. Applies to aggregates without
+  /// masks, distinct or sorting keys.
+  void addGlobalIntermediateResults(
+      const std::vector<VectorPtr>& intermediates);
+
+  /// Invoked after all the input has been added. If 'reserveOutput' is false,
+  /// the caller reserves outputReservationBytes() before producing output.
+  void noMoreInput(bool reserveOutput = true);
+
+  /// Returns the number of bytes to reserve for output processing, or zero if
+  /// no reservation is needed.
+  uint64_t outputReservationBytes() const;
 
   /// Typically, the output is not available until all input has been added.
   /// However, in case when input is clustered on some of the grouping keys, the
@@ -87,6 +92,9 @@ class GroupingSet {
   /// can free up space and rehashes and returns false if significant
   /// space was recovered. In specific, changing from an array hash
   /// based on value ranges to one based on value ids can save a lot.
+  /// Also returns true if the hash table would have to grow past 'maxBytes'
+  /// to take as many new groups as the last input batch brought. Flushing
+  /// then avoids doubling the table only to flush it right after.
   bool isPartialFull(int64_t maxBytes);
 
   /// Returns the count of the hash table, if any.
@@ -104,6 +112,12 @@ class GroupingSet {
 
   const HashLookup& hashLookup() const;
 
+  /// Frees the fragmented free space of the variable width data of the rows
+  /// without removing rows. Returns the number of bytes freed. Does nothing
+  /// for sorted or distinct aggregates. See
+  /// RowContainer::compactStringAllocator().
+  int64_t compactRows();
+
   /// Spills all the rows in container.
   void spill();
 
@@ -127,6 +141,12 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the bytes of the rows backed by huge pages. See
+  /// BaseHashTable::rowHugePageBytes() for the cost.
+  int64_t rowHugePageBytes() const {
+    return table_ ? table_->rowHugePageBytes() : 0;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -136,6 +156,10 @@ class GroupingSet {
   // non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
 
+  // Goes back to aggregating after abandonPartialAggregation(). The hash
+  // table is made again on the next input.
+  void resumePartialAggregation();
+
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
@@ -161,6 +185,23 @@ class GroupingSet {
 
   void addInputForActiveRows(const RowVectorPtr& input, bool mayPushdown);
 
+  // Removes from 'lookup_->rows' the rows with the same keys as the previous
+  // row if at least half of the rows are like this, as is the case for input
+  // clustered on the grouping keys. These rows are recorded in
+  // 'repeatedKeyRows_' and get the group of the previous row after the probe
+  // in fillRepeatedKeyHits(). Only done if the table is not in kHash mode,
+  // where equal value ids imply equal keys.
+  void removeRepeatedKeys();
+
+  // Removes from 'lookup_->rows' all but the first row of each dictionary
+  // entry if there is a single grouping key that is dictionary encoded with
+  // at most half as many entries as rows. The value ids or hashes of the
+  // entries are already computed once per entry by the VectorHasher, so this
+  // leaves one probe per distinct key. Returns false if not applicable.
+  bool removeRepeatedDictionaryKeys();
+
+  void fillRepeatedKeyHits();
+
   void addRemainingInput();
 
   void initializeGlobalAggregation();
@@ -274,6 +315,10 @@ class GroupingSet {
   const bool isRawInput_;
   const core::QueryConfig& queryConfig_;
 
+  // The executor used to rehash the final or single aggregation hash table in
+  // parallel. Null if the parallel rehash is not enabled.
+  folly::Executor* const parallelBuildExecutor_;
+
   std::vector<AggregateInfo> aggregates_;
   AggregationMasks masks_;
   std::unique_ptr<SortedAggregations> sortedAggregations_;
@@ -306,6 +351,13 @@ class GroupingSet {
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
 
+  // Pairs of a row removed from the probe by removeRepeatedKeys() and an
+  // earlier row in 'lookup_->rows' with the same keys.
+  std::vector<std::pair<vector_size_t, vector_size_t>> repeatedKeyRows_;
+
+  // The first row of each dictionary entry in removeRepeatedDictionaryKeys().
+  std::vector<vector_size_t> firstDictionaryRows_;
+
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
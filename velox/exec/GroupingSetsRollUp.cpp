@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/GroupingSetsRollUp.h"
+
+#include "velox/exec/AggregateFunctionRegistry.h"
+
+namespace facebook::velox::exec {
+
+core::PlanNodePtr rollUpGroupingSets(
+    const std::shared_ptr<const core::AggregationNode>& node) {
+  using Step = core::AggregationNode::Step;
+  if ((!node->isSingle() && node->step() != Step::kPartial) ||
+      !node->preGroupedKeys().empty()) {
+    return node;
+  }
+  auto groupId =
+      std::dynamic_pointer_cast<const core::GroupIdNode>(node->sources()[0]);
+  if (groupId == nullptr) {
+    return node;
+  }
+
+  std::unordered_set<std::string> inputNames;
+  for (const auto& input : groupId->aggregationInputs()) {
+    inputNames.insert(input->name());
+  }
+  // A grouping key is null in the grouping sets without it, so an aggregate
+  // over a grouping key cannot be computed before the expansion.
+  auto isAggregationInput = [&](const core::FieldAccessTypedExprPtr& field) {
+    return field != nullptr && field->isInputColumn() &&
+        inputNames.count(field->name()) > 0;
+  };
+
+  const auto& names = node->aggregateNames();
+  std::vector<core::AggregationNode::Aggregate> partialAggregates;
+  std::vector<core::AggregationNode::Aggregate> aggregates;
+  std::vector<core::FieldAccessTypedExprPtr> intermediateInputs;
+  for (auto i = 0; i < node->aggregates().size(); ++i) {
+    const auto& aggregate = node->aggregates()[i];
+    if (aggregate.distinct || !aggregate.sortingKeys.empty() ||
+        (aggregate.mask != nullptr && !isAggregationInput(aggregate.mask))) {
+      return node;
+    }
+    std::vector<TypePtr> rawInputTypes;
+    for (const auto& input : aggregate.call->inputs()) {
+      if (!core::TypedExprs::isConstant(input) &&
+          !isAggregationInput(core::TypedExprs::asFieldAccess(input))) {
+        return node;
+      }
+      rawInputTypes.push_back(input->type());
+    }
+    const auto& name = aggregate.call->name();
+    const auto intermediateType =
+        resolveAggregateFunction(name, rawInputTypes).second;
+    if (intermediateType == nullptr) {
+      return node;
+    }
+
+    auto& partial = partialAggregates.emplace_back(aggregate);
+    partial.call = std::make_shared<core::CallTypedExpr>(
+        intermediateType, aggregate.call->inputs(), name);
+
+    intermediateInputs.push_back(
+        std::make_shared<core::FieldAccessTypedExpr>(
+            intermediateType, names[i]));
+    auto& merge = aggregates.emplace_back();
+    merge.call = std::make_shared<core::CallTypedExpr>(
+        node->isSingle() ? aggregate.call->type() : intermediateType,
+        std::vector<core::TypedExprPtr>{intermediateInputs.back()},
+        name);
+    merge.rawInputTypes = std::move(rawInputTypes);
+  }
+
+  // The partial aggregation groups on the distinct inputs of the grouping
+  // keys and keeps rows with null keys.
+  std::vector<core::FieldAccessTypedExprPtr> keys;
+  std::unordered_set<std::string> keyNames;
+  for (const auto& info : groupId->groupingKeyInfos()) {
+    if (keyNames.insert(info.input->name()).second) {
+      keys.push_back(info.input);
+    }
+  }
+  for (const auto& name : names) {
+    if (keyNames.count(name) > 0) {
+      return node;
+    }
+  }
+
+  auto partial = std::make_shared<core::AggregationNode>(
+      fmt::format("{}.rollup", node->id()),
+      Step::kPartial,
+      keys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      names,
+      partialAggregates,
+      false,
+      groupId->sources()[0]);
+
+  auto expand = std::make_shared<core::GroupIdNode>(
+      groupId->id(),
+      groupId->groupingSets(),
+      groupId->groupingKeyInfos(),
+      std::move(intermediateInputs),
+      groupId->groupIdName(),
+      std::move(partial));
+
+  return std::make_shared<core::AggregationNode>(
+      node->id(),
+      node->isSingle() ? Step::kFinal : Step::kIntermediate,
+      node->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      names,
+      aggregates,
+      node->globalGroupingSets(),
+      node->groupId(),
+      node->ignoreNullKeys(),
+      std::move(expand));
+}
+
+} // namespace facebook::velox::exec
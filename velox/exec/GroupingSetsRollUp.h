@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Rewrites an aggregation over a GroupIdNode so that the input rows are
+/// aggregated once on all the grouping keys before they are expanded. The
+/// result is a partial aggregation on the distinct inputs of the grouping
+/// keys, then the GroupIdNode over the partial results and then a final or
+/// intermediate aggregation with the keys of 'node'. The GroupIdNode then
+/// makes a copy per grouping set of each group of the finest grouping set
+/// instead of each input row. For example, a CUBE over 3 keys aggregates the
+/// input rows once instead of 8 times.
+///
+/// The result keeps the id of 'node' and the GroupIdNode keeps its id. The
+/// partial aggregation gets id '<id>.rollup'. Returns 'node' unchanged if it is
+/// not a single or partial step aggregation over a GroupIdNode, has
+/// pre-grouped keys or an aggregate that is distinct, sorts its inputs, has an
+/// input or mask that is not an aggregation input of the GroupIdNode or one
+/// that is not a column or a constant. A kSingle 'node' becomes kFinal and a
+/// kPartial one becomes kIntermediate.
+core::PlanNodePtr rollUpGroupingSets(
+    const std::shared_ptr<const core::AggregationNode>& node);
+
+} // namespace facebook::velox::exec
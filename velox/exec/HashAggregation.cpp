@@ -45,6 +45,8 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationResampleRows_(
+          driverCtx->queryConfig().abandonPartialAggregationResampleRows()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -118,11 +120,29 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
       100 * numOutput / numInputRows_ >= abandonPartialAggregationMinPct_;
 }
 
+void HashAggregation::addIntermediateResults(
+    const std::vector<VectorPtr>& intermediates) {
+  VELOX_CHECK(isGlobal_);
+  VELOX_CHECK(!noMoreInput_);
+  groupingSet_->addGlobalIntermediateResults(intermediates);
+}
+
 void HashAggregation::addInput(RowVectorPtr input) {
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
+  if (abandonedPartialAggregation_ &&
+      abandonPartialAggregationResampleRows_ > 0 &&
+      numInputRows_ >= abandonPartialAggregationResampleRows_ && !input_) {
+    // Samples the reduction again. The next flush abandons the partial
+    // aggregation again if the data is still not reducible.
+    groupingSet_->resumePartialAggregation();
+    abandonedPartialAggregation_ = false;
+    numInputRows_ = 0;
+    numOutputRows_ = 0;
+    addRuntimeStat("resumedPartialAggregation", RuntimeCounter(1));
+  }
   if (abandonedPartialAggregation_) {
     input_ = input;
     numInputRows_ += input->size();
@@ -188,6 +208,19 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (hashTableStats.tableHugePageBytes != 0) {
+    runtimeStats[BaseHashTable::kTableHugePageBytes] = RuntimeMetric(
+        hashTableStats.tableHugePageBytes, RuntimeCounter::Unit::kBytes);
+  }
+}
+
+void HashAggregation::recordRowHugePageBytes() {
+  const auto rowHugePageBytes = groupingSet_->rowHugePageBytes();
+  if (rowHugePageBytes != 0) {
+    addRuntimeStat(
+        BaseHashTable::kRowHugePageBytes,
+        RuntimeCounter(rowHugePageBytes, RuntimeCounter::Unit::kBytes));
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -381,12 +414,24 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 
 void HashAggregation::noMoreInput() {
   updateEstimatedOutputRowSize();
-  groupingSet_->noMoreInput();
+  // Defers the output memory reservation to isBlocked() so that the memory
+  // arbitration it might trigger doesn't block the driver thread.
+  outputReservationPending_ =
+      memory::memoryManager()->arbitrationExecutor() != nullptr;
+  groupingSet_->noMoreInput(!outputReservationPending_);
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
 }
 
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (!outputReservationPending_) {
+    return BlockingReason::kNotBlocked;
+  }
+  outputReservationPending_ = false;
+  return reserveMemoryAsync(groupingSet_->outputReservationBytes(), future);
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
@@ -402,6 +447,7 @@ void HashAggregation::reclaim(
   }
 
   updateEstimatedOutputRowSize();
+  recordRowHugePageBytes();
 
   if (noMoreInput_) {
     if (groupingSet_->hasSpilled()) {
@@ -424,8 +470,21 @@ void HashAggregation::reclaim(
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
   } else {
-    // TODO: support fine-grain disk spilling based on 'targetBytes' after
-    // having row container memory compaction support later.
+    // Compacting the variable width data releases the space fragmented by
+    // growing accumulators without losing any rows. Spill only if that does
+    // not reach 'targetBytes'.
+    const auto compactedBytes = groupingSet_->compactRows();
+    if (compactedBytes > 0) {
+      addRuntimeStat(
+          "compactedBytes",
+          RuntimeCounter(compactedBytes, RuntimeCounter::Unit::kBytes));
+      if (targetBytes != 0 &&
+          static_cast<uint64_t>(compactedBytes) >= targetBytes) {
+        pool()->release();
+        return;
+      }
+    }
+    // TODO: support fine-grain disk spilling based on 'targetBytes'.
     groupingSet_->spill();
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
@@ -435,6 +494,9 @@ void HashAggregation::reclaim(
 }
 
 void HashAggregation::close() {
+  if (groupingSet_ != nullptr) {
+    recordRowHugePageBytes();
+  }
   Operator::close();
 
   output_ = nullptr;
@@ -31,6 +31,12 @@ class HashAggregation : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  /// Adds the single row intermediate results in 'intermediates', one per
+  /// aggregate, to a global aggregation. Used by a TableScan right before
+  /// 'this' that takes the results for a split from the file statistics
+  /// instead of producing its rows.
+  void addIntermediateResults(const std::vector<VectorPtr>& intermediates);
+
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
@@ -39,9 +45,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -53,6 +57,10 @@ class HashAggregation : public Operator {
  private:
   void updateRuntimeStats();
 
+  // Reports the huge page coverage of the rows. Called at close and before
+  // spilling, since measuring it reads /proc/self/smaps.
+  void recordRowHugePageBytes();
+
   void prepareOutput(vector_size_t size);
 
   // Invoked to reset partial aggregation state if it was full and has been
@@ -86,6 +94,9 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of input rows after which an abandoned partial aggregation is
+  // tried again. 0 if never.
+  const int64_t abandonPartialAggregationResampleRows_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -98,6 +109,9 @@ class HashAggregation : public Operator {
   bool partialFull_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
+  // True if the output memory reservation has been deferred from noMoreInput()
+  // to isBlocked() to run it on the memory manager's arbitration executor.
+  bool outputReservationPending_{false};
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
 
@@ -64,6 +64,7 @@ HashBuild::HashBuild(
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
       needProbedFlagSpill_{needRightSideJoin(joinType_)},
+      hybridSpillEnabled_{driverCtx->queryConfig().hybridJoinSpillEnabled()},
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
@@ -187,6 +188,14 @@ void HashBuild::setupTable() {
           pool());
     }
   }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (queryConfig.hashJoinCompactTableEnabled()) {
+    table_->enableCompactJoinTable();
+  }
+  if (queryConfig.hashProbeRadixPartitionMinRows() > 0) {
+    table_->setRadixPartitionedProbe(
+        queryConfig.hashProbeRadixPartitionMinRows());
+  }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -737,6 +746,7 @@ bool HashBuild::finishHashBuild() {
   // https://github.com/facebookincubator/velox/issues/3567 is fixed.
   const bool allowParallelJoinBuild =
       !otherTables.empty() && spillPartitions.empty();
+  restoreSpillPartitionsInMemory(spillPartitions);
   CpuWallTiming timing;
   {
     CpuWallTimer cpuWallTimer{timing};
@@ -769,6 +779,110 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+void HashBuild::restoreSpillPartitionsInMemory(
+    SpillPartitionSet& spillPartitions) {
+  if (!hybridSpillEnabled_ || spillPartitions.empty()) {
+    return;
+  }
+
+  // The estimated memory usage of a restored partition in the join table as a
+  // multiple of its in-memory row size. The extra covers the hash table and
+  // the next-row vectors built on top of the row container.
+  constexpr double kTableMemoryFactor = 2.0;
+
+  std::vector<SpillPartitionId> partitionIds;
+  partitionIds.reserve(spillPartitions.size());
+  for (const auto& [id, _] : spillPartitions) {
+    partitionIds.push_back(id);
+  }
+  std::sort(
+      partitionIds.begin(),
+      partitionIds.end(),
+      [&](const SpillPartitionId& lhs, const SpillPartitionId& rhs) {
+        return spillPartitions.at(lhs)->size() <
+            spillPartitions.at(rhs)->size();
+      });
+
+  // Estimates the in-memory size of a spilled partition from the ratio of the
+  // spilled input bytes to the spilled file bytes.
+  double memoryBytesPerSpilledByte{1.0};
+  {
+    const auto lockedStats = spillStats_.rlock();
+    if (lockedStats->spilledBytes != 0 && lockedStats->spilledInputBytes != 0) {
+      memoryBytesPerSpilledByte =
+          static_cast<double>(lockedStats->spilledInputBytes) /
+          lockedStats->spilledBytes;
+    }
+  }
+
+  uint64_t numRestoredPartitions{0};
+  for (const auto& id : partitionIds) {
+    auto it = spillPartitions.find(id);
+    VELOX_CHECK(it != spillPartitions.end());
+    const uint64_t estimatedBytes = it->second->size() *
+        memoryBytesPerSpilledByte * kTableMemoryFactor;
+    if (!pool()->maybeReserve(estimatedBytes)) {
+      break;
+    }
+    auto reader = it->second->createUnorderedReader(pool(), &spillStats_);
+    RowVectorPtr data;
+    while (reader->nextBatch(data)) {
+      addSpilledRows(data);
+    }
+    spillPartitions.erase(it);
+    ++numRestoredPartitions;
+  }
+  if (numRestoredPartitions != 0) {
+    stats_.wlock()->addRuntimeStat(
+        kHybridSpillRestoredPartitions, RuntimeCounter(numRestoredPartitions));
+  }
+}
+
+void HashBuild::addSpilledRows(const RowVectorPtr& data) {
+  activeRows_.resize(data->size());
+  activeRows_.setAll();
+
+  auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->decode(*data->childAt(i), activeRows_);
+  }
+  for (auto i = 0; i < dependentChannels_.size(); ++i) {
+    decoders_[i]->decode(*data->childAt(i + hashers.size()), activeRows_);
+  }
+
+  if (analyzeKeys_ && hashes_.size() < activeRows_.end()) {
+    hashes_.resize(activeRows_.end());
+  }
+  for (auto& hasher : hashers) {
+    if (analyzeKeys_) {
+      hasher->computeValueIds(activeRows_, hashes_);
+      analyzeKeys_ = hasher->mayUseValueIds();
+    }
+  }
+
+  auto rows = table_->rows();
+  FlatVector<bool>* probedFlagVector{nullptr};
+  if (needProbedFlagSpill_) {
+    probedFlagVector =
+        data->childAt(spillProbedFlagChannel_)->asFlatVector<bool>();
+  }
+  activeRows_.applyToSelected([&](auto rowIndex) {
+    char* newRow = rows->newRow();
+    for (auto i = 0; i < hashers.size(); ++i) {
+      rows->store(hashers[i]->decodedVector(), rowIndex, newRow, i);
+    }
+    for (auto i = 0; i < dependentChannels_.size(); ++i) {
+      rows->store(*decoders_[i], rowIndex, newRow, i + hashers.size());
+    }
+    if (probedFlagVector != nullptr) {
+      VELOX_CHECK(!probedFlagVector->isNullAt(rowIndex));
+      if (probedFlagVector->valueAt(rowIndex)) {
+        rows->setProbedFlag(&newRow, 1);
+      }
+    }
+  });
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -905,6 +1019,7 @@ void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
   const auto hashTableStats = table_->stats();
+  const auto rowHugePageBytes = table_->rowHugePageBytes();
   uint64_t asRange;
   uint64_t asDistinct;
   auto lockedStats = stats_.wlock();
@@ -932,6 +1047,15 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  if (hashTableStats.tableHugePageBytes != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kTableHugePageBytes] =
+        RuntimeMetric(
+            hashTableStats.tableHugePageBytes, RuntimeCounter::Unit::kBytes);
+  }
+  if (rowHugePageBytes != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kRowHugePageBytes] =
+        RuntimeMetric(rowHugePageBytes, RuntimeCounter::Unit::kBytes);
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
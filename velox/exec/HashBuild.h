@@ -58,6 +58,11 @@ class HashBuild final : public Operator {
   };
   static std::string stateName(State state);
 
+  /// The number of spilled partitions loaded back into the join table at the
+  /// end of the build in hybrid spill mode.
+  static inline const std::string kHybridSpillRestoredPartitions{
+      "hybridSpillRestoredPartitions"};
+
   HashBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -81,6 +86,10 @@ class HashBuild final : public Operator {
 
   bool isFinished() override;
 
+  bool hasWaitingConsumers() const override {
+    return joinBridge_ != nullptr && joinBridge_->hasWaiters();
+  }
+
   bool canReclaim() const override;
 
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
@@ -202,6 +211,17 @@ class HashBuild final : public Operator {
   // will be added to the joined output.
   void removeInputRowsForAntiJoinFilter();
 
+  // Invoked by the last hash build operator in hybrid spill mode to load the
+  // spilled partitions in 'spillPartitions' that fit in memory back into
+  // 'table_' before building the join table. The partitions are restored from
+  // the smallest one and the restored ones are removed from 'spillPartitions'.
+  // The probe side then only spills the rows of the partitions left on disk.
+  void restoreSpillPartitionsInMemory(SpillPartitionSet& spillPartitions);
+
+  // Invoked to add the rows in 'data' read from a spilled partition with type
+  // of 'spillType_' into 'table_'.
+  void addSpilledRows(const RowVectorPtr& data);
+
   void addRuntimeStats();
 
   // Indicates if this hash build operator is under non-reclaimable state or
@@ -221,6 +241,10 @@ class HashBuild final : public Operator {
   // not.
   const bool needProbedFlagSpill_;
 
+  // If true, the spilled partitions that fit in memory are loaded back into
+  // the join table at the end of the build.
+  const bool hybridSpillEnabled_;
+
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
   bool exceededMaxSpillLevelLimit_{false};
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashProbe.h"
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
@@ -83,6 +84,84 @@ void extractColumns(
   }
 }
 
+template <typename T>
+void addBloomFilterKeys(
+    const BaseHashTable& table,
+    column_index_t keyIndex,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  std::vector<char*> rows(kBatchSize);
+  for (auto* container : table.allRows()) {
+    const auto column = container->columnAt(keyIndex);
+    RowContainerIterator iter;
+    while (const auto numRows =
+               container->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            RowContainer::valueAt<T>(rows[i], column.offset());
+        bloomFilter.insert(
+            common::BigintValuesUsingBloomFilter::hashValue(value));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  }
+}
+
+// Returns a bloom filter over the values of the integer join key at 'keyIndex'
+// in 'table'. Returns null if the key is not of integer type, or if the bloom
+// filter would take more than 'maxBytes'.
+std::unique_ptr<common::Filter> makeBloomFilter(
+    const BaseHashTable& table,
+    column_index_t keyIndex,
+    bool nullAllowed,
+    uint64_t maxBytes) {
+  if (maxBytes == 0) {
+    return nullptr;
+  }
+  uint64_t numRows{0};
+  for (const auto* container : table.allRows()) {
+    numRows += container->numRows();
+  }
+  // BloomFilter::reset() allocates 2 bytes per entry rounded up to a power of
+  // two.
+  if (numRows == 0 || numRows > std::numeric_limits<int32_t>::max() ||
+      bits::nextPowerOfTwo(numRows) * 2 > maxBytes) {
+    return nullptr;
+  }
+
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(numRows);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  switch (table.hashers()[keyIndex]->typeKind()) {
+    case TypeKind::TINYINT:
+      addBloomFilterKeys<int8_t>(table, keyIndex, *bloomFilter, min, max);
+      break;
+    case TypeKind::SMALLINT:
+      addBloomFilterKeys<int16_t>(table, keyIndex, *bloomFilter, min, max);
+      break;
+    case TypeKind::INTEGER:
+      addBloomFilterKeys<int32_t>(table, keyIndex, *bloomFilter, min, max);
+      break;
+    case TypeKind::BIGINT:
+      addBloomFilterKeys<int64_t>(table, keyIndex, *bloomFilter, min, max);
+      break;
+    default:
+      return nullptr;
+  }
+  if (min > max) {
+    // All the keys are null.
+    return nullptr;
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -127,6 +206,12 @@ HashProbe::HashProbe(
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
+      bloomFilterPushdownMaxSize_{
+          driverCtx->queryConfig().hashProbeBloomFilterPushdownMaxSize()},
+      exportDynamicFilters_{
+          driverCtx->queryConfig().hashProbeExportDynamicFilters()},
+      earlyInputMaxBytes_{
+          driverCtx->queryConfig().hashProbeEarlyInputMaxBytes()},
       probeType_(joinNode_->sources()[0]->outputType()),
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
@@ -150,6 +235,10 @@ void HashProbe::initialize() {
 
   VELOX_CHECK_NULL(lookup_);
   lookup_ = std::make_unique<HashLookup>(hashers_);
+  earlyInputAllowed_ = earlyInputMaxBytes_ > 0 &&
+      operatorCtx_->driverCtx()
+          ->driver->canPushdownFilters(this, keyChannels_)
+          .empty();
   auto buildType = joinNode_->sources()[1]->outputType();
   auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
   if (joinNode_->filter()) {
@@ -329,8 +418,9 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData() &&
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       bloomFilterPushdownMaxSize_ > 0)) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -347,14 +437,38 @@ void HashProbe::asyncWaitForHashTable() {
     // nulls on the probe side. Hence, cannot filter these out.
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
+    std::unordered_map<std::string, std::shared_ptr<common::Filter>>
+        exportedFilters;
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      const bool canPushdown = channels.find(keyChannels_[i]) != channels.end();
+      if (!canPushdown && !exportDynamicFilters_) {
+        continue;
+      }
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(nullAllowed);
+      }
+      if (filter == nullptr) {
+        // The join key has too many distinct values for a range or value set
+        // filter. Push down a bloom filter instead if it is small enough.
+        filter = makeBloomFilter(
+            *table_, i, nullAllowed, bloomFilterPushdownMaxSize_);
+        hasBloomDynamicFilters_ |= canPushdown && filter != nullptr;
+      }
+      if (filter == nullptr) {
+        continue;
+      }
+      if (exportDynamicFilters_) {
+        exportedFilters.emplace(
+            probeType_->nameOf(keyChannels_[i]), filter->clone());
+      }
+      if (canPushdown) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
+    operatorCtx_->task()->addExportedDynamicFilters(
+        planNodeId(), std::move(exportedFilters));
   }
 }
 
@@ -499,6 +613,10 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case ProbeOperatorState::kWaitForBuild:
       VELOX_CHECK_NULL(table_);
+      if (future_.valid() && future_.isReady() && earlyInputAllowed_) {
+        // 'this' kept the future while taking early input.
+        future_ = ContinueFuture::makeEmpty();
+      }
       if (!future_.valid()) {
         setRunning();
         asyncWaitForHashTable();
@@ -523,6 +641,10 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
       break;
   }
 
+  // Takes more input until the limit is reached, then waits for the build.
+  if (state_ == ProbeOperatorState::kWaitForBuild && canBufferEarlyInput()) {
+    return BlockingReason::kNotBlocked;
+  }
   if (future_.valid()) {
     VELOX_CHECK(!isRunning());
     *future = std::move(future_);
@@ -534,9 +656,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasBloomDynamicFilters_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -560,6 +684,15 @@ void HashProbe::decodeAndDetectNonNullKeys() {
 }
 
 void HashProbe::addInput(RowVectorPtr input) {
+  if (state_ == ProbeOperatorState::kWaitForBuild) {
+    VELOX_CHECK(canBufferEarlyInput());
+    // Lazy vectors must be loaded before the upstream operator moves on.
+    input->loadedVector();
+    earlyInputBytes_ += input->estimateFlatSize();
+    earlyInputs_.push_back(std::move(input));
+    addRuntimeStat("earlyInputBatches", RuntimeCounter(1));
+    return;
+  }
   if (skipInput_) {
     VELOX_CHECK_NULL(input_);
     return;
@@ -727,6 +860,33 @@ void HashProbe::fillLeftSemiProjectMatchColumn(vector_size_t size) {
   }
 }
 
+bool HashProbe::maybeExtractSharedColumns(vector_size_t size) {
+  // Gives up after this many consecutive batches without enough repeats.
+  constexpr int32_t kMaxUnsharedBatches = 4;
+  // Below this many rows the distinct rows are not worth finding.
+  constexpr vector_size_t kMinRows = 64;
+  // A build side row repeats in the output only if its key has duplicates.
+  if (!table_->hasDuplicateKeys() || tableOutputProjections_.empty() ||
+      size < kMinRows || numUnsharedBatches_ >= kMaxUnsharedBatches) {
+    return false;
+  }
+  if (!sharedRowsExtractor_.prepare(
+          folly::Range<char* const*>(outputTableRows_.data(), size), pool())) {
+    ++numUnsharedBatches_;
+    return false;
+  }
+  numUnsharedBatches_ = 0;
+  for (const auto& projection : tableOutputProjections_) {
+    output_->childAt(projection.outputChannel) = sharedRowsExtractor_.extract(
+        *table_->rows(),
+        projection.inputChannel,
+        outputType_->childAt(projection.outputChannel),
+        pool());
+  }
+  addRuntimeStat("sharedBuildRows", RuntimeCounter(size));
+  return true;
+}
+
 void HashProbe::fillOutput(vector_size_t size) {
   prepareOutput(size);
 
@@ -742,7 +902,7 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
-  } else {
+  } else if (!maybeExtractSharedColumns(size)) {
     extractColumns(
         table_.get(),
         folly::Range<char**>(outputTableRows_.data(), size),
@@ -753,6 +913,15 @@ void HashProbe::fillOutput(vector_size_t size) {
   }
 }
 
+void HashProbe::updateOutputBatchSize(vector_size_t numOut) {
+  // The probe side columns are wrappers of the input and the build side
+  // columns are extracted, so the row width is only known from the output.
+  // Batches only shrink below preferredOutputBatchRows, which is given
+  // explicitly to bound the output of joins that multiply their input.
+  const auto rowSize = output_->estimateFlatSize() / numOut;
+  outputBatchSize_ = std::min(outputBatchRows(), outputBatchRows(rowSize));
+}
+
 RowVectorPtr HashProbe::getBuildSideOutput() {
   outputTableRows_.resize(outputBatchSize_);
   int32_t numOut;
@@ -881,7 +1050,30 @@ void HashProbe::checkStateTransition(ProbeOperatorState state) {
   }
 }
 
+void HashProbe::addEarlyInput() {
+  while (input_ == nullptr && isRunning()) {
+    if (!earlyInputs_.empty()) {
+      auto input = std::move(earlyInputs_.front());
+      earlyInputs_.pop_front();
+      earlyInputBytes_ -= std::min(earlyInputBytes_, input->estimateFlatSize());
+      addInput(std::move(input));
+    } else if (noMoreInputDeferred_) {
+      noMoreInputDeferred_ = false;
+      noMoreInputInternal();
+    } else {
+      break;
+    }
+  }
+}
+
 RowVectorPtr HashProbe::getOutput() {
+  if (state_ == ProbeOperatorState::kWaitForBuild) {
+    return nullptr;
+  }
+  addEarlyInput();
+  if (!isRunning() && !isFinished()) {
+    return nullptr;
+  }
   return getOutputInternal(/*toSpillOutput=*/false);
 }
 
@@ -992,6 +1184,16 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
           }
         }
       }
+    } else if (isLeftSemiFilterJoin(joinType_) && !filter_) {
+      // Only the existence of a match matters and the output has no build
+      // side columns, so the hits are not listed. The table has no
+      // duplicates, see HashBuild::setupTable().
+      for (auto i = 0; i < inputSize; ++i) {
+        if (activeRows_.isValid(i) && lookup_->hits[i]) {
+          mapping[numOut] = i;
+          ++numOut;
+        }
+      }
     } else {
       numOut = table_->listJoinResults(
           results_,
@@ -1031,6 +1233,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
     }
 
     fillOutput(numOut);
+    updateOutputBatchSize(numOut);
 
     if (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide) {
       input_ = nullptr;
@@ -1448,6 +1651,15 @@ void HashProbe::ensureLoadedIfNotAtEnd(column_index_t channel) {
 
 void HashProbe::noMoreInput() {
   Operator::noMoreInput();
+  if (state_ == ProbeOperatorState::kWaitForBuild) {
+    noMoreInputDeferred_ = true;
+    return;
+  }
+  // Drops the early input if the probe finishes without it, e.g. for a null
+  // aware anti join with nulls on the build side.
+  earlyInputs_.clear();
+  earlyInputBytes_ = 0;
+  noMoreInputDeferred_ = false;
   noMoreInputInternal();
 }
 
@@ -1873,6 +2085,7 @@ void HashProbe::close() {
 
   // Free up major memory usage.
   joinBridge_.reset();
+  earlyInputs_.clear();
   inputSpiller_.reset();
   table_.reset();
   outputRowMapping_.reset();
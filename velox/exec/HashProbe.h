@@ -20,6 +20,7 @@
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
+#include "velox/exec/SharedRowsExtractor.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
@@ -39,14 +40,13 @@ class HashProbe : public Operator {
         noMoreSpillInput_ || input_ != nullptr) {
       return false;
     }
-    if (table_) {
-      return true;
+    if (state_ == ProbeOperatorState::kWaitForBuild) {
+      // NOTE: if we can't apply dynamic filtering, then we can start early to
+      // read input even before the hash table has been built.
+      return canBufferEarlyInput();
     }
-    // NOTE: if we can't apply dynamic filtering, then we can start early to
-    // read input even before the hash table has been built.
-    return operatorCtx_->driverCtx()
-        ->driver->canPushdownFilters(this, keyChannels_)
-        .empty();
+    // The input buffered while waiting for the hash table is probed first.
+    return table_ != nullptr && earlyInputs_.empty();
   }
 
   void addInput(RowVectorPtr input) override;
@@ -78,6 +78,18 @@ class HashProbe : public Operator {
 
   void setRunning();
   void checkRunning() const;
+
+  // Returns true if 'this' takes more input while waiting for the hash table.
+  // See QueryConfig::kHashProbeEarlyInputMaxBytes.
+  bool canBufferEarlyInput() const {
+    return earlyInputAllowed_ && !noMoreInput_ &&
+        earlyInputBytes_ < earlyInputMaxBytes_;
+  }
+
+  // Passes the buffered early input to addInput() one vector at a time once
+  // the hash table is there. Finishes the deferred noMoreInput() after the
+  // last vector.
+  void addEarlyInput();
   bool isRunning() const;
 
   // Invoked to wait for the hash table to be built by the hash build operators
@@ -102,6 +114,16 @@ class HashProbe : public Operator {
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
+  // Extracts the build side columns of the first 'size' rows of
+  // 'outputTableRows_' once per distinct row and wraps them in dictionaries
+  // if the rows repeat enough. Returns false if the columns are to be
+  // extracted for each row.
+  bool maybeExtractSharedColumns(vector_size_t size);
+
+  // Sets 'outputBatchSize_' from the average row size of the 'numOut' rows of
+  // 'output_'.
+  void updateOutputBatchSize(vector_size_t numOut);
+
   // Populate 'match' output column for the left semi join project,
   void fillLeftSemiProjectMatchColumn(vector_size_t size);
 
@@ -293,8 +315,10 @@ class HashProbe : public Operator {
 
   //  std::vector<Operator*> findPeerOperators();
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Max number of rows in an output batch. Starts at preferredOutputBatchRows
+  // and shrinks if the output rows are too wide for preferredOutputBatchBytes.
+  // See updateOutputBatchSize().
+  uint32_t outputBatchSize_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -302,6 +326,31 @@ class HashProbe : public Operator {
 
   const bool nullAware_;
 
+  // The max size in bytes of a bloom filter pushed down as a dynamic filter
+  // for a join key with too many distinct values. 0 disables the bloom filter
+  // pushdown.
+  const uint64_t bloomFilterPushdownMaxSize_;
+
+  // If true, records the dynamic filters on all join keys in the task for
+  // export to other tasks. See Task::exportedDynamicFilters().
+  const bool exportDynamicFilters_;
+
+  // See QueryConfig::kHashProbeEarlyInputMaxBytes.
+  const uint64_t earlyInputMaxBytes_;
+
+  // True if 'earlyInputMaxBytes_' is set and the hash table can not produce
+  // dynamic filters for upstream operators, which would be bypassed by the
+  // input read before the table is built. Set in initialize().
+  bool earlyInputAllowed_{false};
+
+  // Probe input received in kWaitForBuild state.
+  std::deque<RowVectorPtr> earlyInputs_;
+  uint64_t earlyInputBytes_{0};
+
+  // True if noMoreInput() was called in kWaitForBuild state. The rest of
+  // noMoreInput() runs after 'earlyInputs_' are probed.
+  bool noMoreInputDeferred_{false};
+
   const RowTypePtr probeType_;
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
@@ -344,6 +393,10 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if any of the generated dynamic filters is a bloom filter. The join
+  // can't be replaced with such a filter as it passes false positives.
+  bool hasBloomDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -421,6 +474,14 @@ class HashProbe : public Operator {
   // Rows of table found by join probe, later filtered by 'filter_'.
   std::vector<char*> outputTableRows_;
 
+  // Extracts the repeating build side rows of a many to many join once. See
+  // maybeExtractSharedColumns().
+  SharedRowsExtractor sharedRowsExtractor_;
+  // Number of consecutive output batches where the build side rows did not
+  // repeat enough for 'sharedRowsExtractor_'. It is not tried anymore after
+  // a few.
+  int32_t numUnsharedBatches_{0};
+
   // Indicates probe-side rows which should produce a NULL in left semi project
   // with filter.
   SelectivityVector leftSemiProjectIsNull_;
@@ -43,6 +43,17 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+int64_t BaseHashTable::rowHugePageBytes() const {
+  int64_t bytes = 0;
+  for (const auto* rowContainer : allRows()) {
+    if (rowContainer->allocatedBytes() >=
+        static_cast<uint64_t>(kMinHugePageStatsBytes)) {
+      bytes += rowContainer->hugePageBytes();
+    }
+  }
+  return bytes;
+}
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -593,42 +604,130 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
+    if (compactSlots_ != nullptr) {
+      compactJoinProbe(lookup);
+      return;
+    }
+    const bool partitioned = maybeRadixPartitionRows(lookup);
     joinNormalizedKeyProbe(lookup);
+    if (partitioned) {
+      std::swap(lookup.rows, lookup.partitionedRows);
+    }
     return;
   }
+  const bool partitioned = maybeRadixPartitionRows(lookup);
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
+  // Each stage runs for a group of probes before the next stage, so that the
+  // bucket and row loads of the group are in flight at the same time. A join
+  // probe does not insert, so the probes of a group are independent. The
+  // group is smaller than for normalized keys since the full key compare
+  // loads more lines per probe.
+  constexpr int32_t kGroupSize = 16;
+  ProbeState states[kGroupSize];
+  for (; probeIndex + kGroupSize <= numProbes; probeIndex += kGroupSize) {
+    for (int32_t i = 0; i < kGroupSize; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, lookup.hashes[row], row);
+    }
+    for (int32_t i = 0; i < kGroupSize; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    for (int32_t i = 0; i < kGroupSize; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
+    states[0].preProbe(*this, lookup.hashes[row], row);
+    states[0].firstProbe(*this, 0);
+    fullProbe<true>(lookup, states[0], false);
+  }
+  if (partitioned) {
+    std::swap(lookup.rows, lookup.partitionedRows);
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::maybeRadixPartitionRows(HashLookup& lookup) {
+  constexpr int32_t kMaxPartitionBits = 8;
+  const auto numRows = lookup.rows.size();
+  const uint64_t tableBytes = capacity_ * tableSlotSize();
+  if (radixPartitionMinRows_ == 0 || numRows < radixPartitionMinRows_ ||
+      tableBytes < 2 * radixPartitionBytes_) {
+    return false;
+  }
+  // Both sizes are powers of 2.
+  const int32_t numPartitionBits = std::min<int32_t>(
+      kMaxPartitionBits,
+      __builtin_ctzll(tableBytes) - __builtin_ctzll(radixPartitionBytes_));
+  const int32_t numPartitions = 1 << numPartitionBits;
+  // The partition is the high bits of the bucket offset.
+  const int32_t shift = sizeBits_ - numPartitionBits;
+  const vector_size_t* rows = lookup.rows.data();
+  const auto* hashes = reinterpret_cast<const int64_t*>(lookup.hashes.data());
+  auto& partitions = lookup.partitions;
+  partitions.resize(numRows);
+
+  constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
+  const auto offsetMask = xsimd::broadcast<int64_t>(bucketOffsetMask_);
+  int32_t i = 0;
+  for (; i + kWidth <= numRows; i += kWidth) {
+    const auto indices = simd::loadGatherIndices<int64_t, int32_t>(rows + i);
+    int64_t partitionWords[kWidth];
+    ((simd::gather(hashes, indices) & offsetMask) >> shift)
+        .store_unaligned(partitionWords);
+    for (auto j = 0; j < kWidth; ++j) {
+      partitions[i + j] = partitionWords[j];
+    }
+  }
+  for (; i < numRows; ++i) {
+    partitions[i] = (hashes[rows[i]] & bucketOffsetMask_) >> shift;
+  }
+
+  std::array<int32_t, 1 << kMaxPartitionBits> starts{};
+  for (i = 0; i < numRows; ++i) {
+    ++starts[partitions[i]];
+  }
+  int32_t start = 0;
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto count = starts[partition];
+    starts[partition] = start;
+    start += count;
+  }
+
+  // Rows go to their partition through a buffer of a cache line per
+  // partition, so that each write to the output is a full line instead of a
+  // scattered write to one of 'numPartitions' places.
+  constexpr int32_t kBufferRows = 64 / sizeof(vector_size_t);
+  alignas(64) vector_size_t buffers[1 << kMaxPartitionBits][kBufferRows];
+  std::array<uint8_t, 1 << kMaxPartitionBits> numBuffered{};
+  auto& partitionedRows = lookup.partitionedRows;
+  partitionedRows.resize(numRows);
+  for (i = 0; i < numRows; ++i) {
+    const auto partition = partitions[i];
+    auto& buffered = numBuffered[partition];
+    buffers[partition][buffered++] = rows[i];
+    if (buffered == kBufferRows) {
+      ::memcpy(
+          partitionedRows.data() + starts[partition],
+          buffers[partition],
+          sizeof(buffers[partition]));
+      starts[partition] += kBufferRows;
+      buffered = 0;
+    }
+  }
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    ::memcpy(
+        partitionedRows.data() + starts[partition],
+        buffers[partition],
+        numBuffered[partition] * sizeof(vector_size_t));
+  }
+  std::swap(lookup.rows, lookup.partitionedRows);
+  return true;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -720,9 +819,24 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   // cache line.
   const auto numPages =
       memory::AllocationTraits::numPages(size * tableSlotSize());
+  memory::ScopedMemoryAllocationSite siteScope(
+      memory::MemoryAllocationSite::kHashTable);
   rows_->pool()->allocateContiguous(numPages, tableAllocation_);
   table_ = tableAllocation_.data<char*>();
   memset(table_, 0, capacity_ * sizeof(char*));
+  // The memset has faulted in the whole table, so its huge page coverage is
+  // known now.
+  tableHugePageBytes_ = byteSize >= kMinHugePageStatsBytes
+      ? memory::MemoryAllocator::hugePageBytes(
+            {folly::Range<char*>(tableAllocation_.data<char>(), byteSize)})
+      : 0;
+}
+
+template <bool ignoreNullKeys>
+HashTableStats HashTable<ignoreNullKeys>::stats() const {
+  HashTableStats stats{capacity_, numRehashes_, numDistinct_, numTombstones_};
+  stats.tableHugePageBytes = table_ != nullptr ? tableHugePageBytes_ : 0;
+  return stats;
 }
 
 template <bool ignoreNullKeys>
@@ -736,6 +850,7 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
   for (auto* rowContainer : allRows()) {
     rowContainer->clear();
   }
+  freeCompactJoinTable();
   if (table_) {
     if (!freeTable) {
       // All modes have 8 bytes per slot.
@@ -869,17 +984,7 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::parallelJoinBuild() {
-  process::TraceContext trace("HashTable::parallelJoinBuild");
-  TestValue::adjust(
-      "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
-  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
-  const uint8_t numPartitions = 1 + otherTables_.size();
-  VELOX_CHECK_GT(
-      capacity_ / numPartitions,
-      minTableSizeForParallelJoinBuild_,
-      "Less than {} entries per partition for parallel build",
-      minTableSizeForParallelJoinBuild_);
+void HashTable<ignoreNullKeys>::setBuildPartitionBounds(uint8_t numPartitions) {
   buildPartitionBounds_.resize(numPartitions + 1);
   // Pad the tail of buildPartitionBounds_ to max int.
   std::fill(
@@ -900,6 +1005,21 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
   }
   buildPartitionBounds_.back() = sizeMask_ + 1;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::parallelJoinBuild() {
+  process::TraceContext trace("HashTable::parallelJoinBuild");
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
+  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
+  const uint8_t numPartitions = 1 + otherTables_.size();
+  VELOX_CHECK_GT(
+      capacity_ / numPartitions,
+      minTableSizeForParallelJoinBuild_,
+      "Less than {} entries per partition for parallel build",
+      minTableSizeForParallelJoinBuild_);
+  setBuildPartitionBounds(numPartitions);
   std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
   std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
   // rowPartitions are used in the async threads, so declare them before the
@@ -1057,6 +1177,124 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setParallelGroupByBuild(
+    folly::Executor* executor,
+    uint8_t numPartitions) {
+  VELOX_CHECK(!isJoinBuild_);
+  VELOX_CHECK_NOT_NULL(executor);
+  buildExecutor_ = executor;
+  numParallelGroupByBuildPartitions_ = numPartitions;
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::canApplyParallelGroupByBuild() const {
+  if (isJoinBuild_ || buildExecutor_ == nullptr) {
+    return false;
+  }
+  if (hashMode_ == HashMode::kArray) {
+    return false;
+  }
+  if (numParallelGroupByBuildPartitions_ <= 1) {
+    return false;
+  }
+  return (capacity_ / numParallelGroupByBuildPartitions_) >=
+      kMinTableSizeForParallelGroupByBuild;
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::parallelGroupByBuild(bool initNormalizedKeys) {
+  process::TraceContext trace("HashTable::parallelGroupByBuild");
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::parallelGroupByBuild", rows_->pool());
+  const uint8_t numPartitions = numParallelGroupByBuildPartitions_;
+  setBuildPartitionBounds(numPartitions);
+
+  // The partitioning step is sequential as there is a single row container. It
+  // also initializes the normalized keys if needed.
+  auto rowPartitions = rows_->createRowPartitions(*rows_->pool());
+  {
+    constexpr int32_t kBatch = 1024;
+    raw_vector<char*> rows(kBatch);
+    raw_vector<uint64_t> hashes(kBatch);
+    raw_vector<uint8_t> partitions(kBatch);
+    RowContainerIterator iter;
+    while (auto numRows = rows_->listRows(
+               &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+      if (!hashRows(
+              folly::Range<char**>(rows.data(), numRows),
+              initNormalizedKeys,
+              hashes)) {
+        return false;
+      }
+      for (auto i = 0; i < numRows; ++i) {
+        partitions[i] = findPartition(
+            bucketOffset(hashes[i]),
+            buildPartitionBounds_.data(),
+            buildPartitionBounds_.size());
+      }
+      rowPartitions->appendPartitions(
+          folly::Range<const uint8_t*>(partitions.data(), numRows));
+    }
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(buildSteps, error, offThreadBuildTiming_, true);
+  });
+
+  // The parallel table building step.
+  std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    buildSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, i, &overflowPerPartition, &rowPartitions]() {
+          buildGroupByPartition(i, *rowPartitions, overflowPerPartition[i]);
+          return std::make_unique<bool>(true);
+        }));
+    VELOX_CHECK(!buildSteps.empty());
+    buildExecutor_->add([step = buildSteps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  syncWorkItems(buildSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  raw_vector<uint64_t> hashes;
+  for (auto& overflows : overflowPerPartition) {
+    hashes.resize(overflows.size());
+    hashRows(
+        folly::Range<char**>(overflows.data(), overflows.size()),
+        false,
+        hashes);
+    insertForGroupBy(overflows.data(), hashes.data(), overflows.size());
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::buildGroupByPartition(
+    uint8_t partition,
+    const RowPartitions& rowPartitions,
+    std::vector<char*>& overflow) {
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> rows(kBatch);
+  raw_vector<uint64_t> hashes(kBatch);
+  TableInsertPartitionInfo partitionInfo{
+      buildPartitionBounds_[partition],
+      buildPartitionBounds_[partition + 1],
+      overflow};
+  RowContainerIterator iter;
+  while (const auto numRows = rows_->listPartitionRows(
+             iter, partition, kBatch, rowPartitions, rows.data())) {
+    hashRows(folly::Range(rows.data(), numRows), false, hashes);
+    insertForGroupBy(rows.data(), hashes.data(), numRows, &partitionInfo);
+  }
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::insertBatch(
     char** groups,
@@ -1078,7 +1316,8 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::insertForGroupBy(
     char** groups,
     uint64_t* hashes,
-    int32_t numGroups) {
+    int32_t numGroups,
+    TableInsertPartitionInfo* partitionInfo) {
   if (hashMode_ == HashMode::kArray) {
     for (auto i = 0; i < numGroups; ++i) {
       auto index = hashes[i];
@@ -1114,6 +1353,13 @@ void HashTable<ignoreNullKeys>::insertForGroupBy(
           break;
         }
         offset = nextBucketOffset(offset);
+        if (partitionInfo != nullptr && !partitionInfo->inRange(offset)) {
+          // The next bucket belongs to another partition which might be built
+          // concurrently, so leave the row to the sequential overflow insert.
+          partitionInfo->addOverflow(groups[i]);
+          inserted = true;
+          break;
+        }
         tagsInTable =
             BaseHashTable::loadTags(reinterpret_cast<uint8_t*>(table_), offset);
       }
@@ -1241,6 +1487,13 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
     parallelJoinBuild();
     return;
   }
+  if (canApplyParallelGroupByBuild()) {
+    if (!parallelGroupByBuild(initNormalizedKeys)) {
+      VELOX_CHECK_NE(hashMode_, HashMode::kHash);
+      setHashMode(HashMode::kHash, 0);
+    }
+    return;
+  }
   raw_vector<uint64_t> hashes;
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
@@ -1271,6 +1524,8 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
+    memory::ScopedMemoryAllocationSite siteScope(
+        memory::MemoryAllocationSite::kHashTable);
     rows_->pool()->allocateContiguous(numPages, tableAllocation_);
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
@@ -1685,6 +1940,90 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
     decideHashMode(0);
   }
   checkHashBitsOverlap(spillInputStartPartitionBit);
+  maybeBuildCompactJoinTable();
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::maybeBuildCompactJoinTable() {
+  freeCompactJoinTable();
+  if (!compactJoinTableEnabled_ || hashMode_ != HashMode::kNormalizedKey ||
+      hasDuplicates_ || numDistinct_ == 0) {
+    return;
+  }
+  // At most half full.
+  const uint64_t numSlots = bits::nextPowerOfTwo(numDistinct_ * 2);
+  memory::ScopedMemoryAllocationSite siteScope(
+      memory::MemoryAllocationSite::kHashTable);
+  rows_->pool()->allocateContiguous(
+      memory::AllocationTraits::numPages(numSlots * sizeof(CompactSlot)),
+      compactAllocation_);
+  compactSlots_ = compactAllocation_.data<CompactSlot>();
+  ::memset(compactSlots_, 0, numSlots * sizeof(CompactSlot));
+  compactSlotMask_ = numSlots - 1;
+
+  // Copies the rows of 'table_', not of the RowContainers, which may hold
+  // rows that are not in the table, e.g. dropped duplicates.
+  for (int64_t bucketOffset = 0; bucketOffset < numBuckets_ * kBucketSize;
+       bucketOffset += kBucketSize) {
+    auto* bucket = bucketAt(bucketOffset);
+    for (auto slot = 0; slot < sizeof(TagVector); ++slot) {
+      // Tags of rows have the high bit set, empties and tombstones do not.
+      if ((bucket->tagAt(slot) & 0x80) == 0) {
+        continue;
+      }
+      char* row = bucket->pointerAt(slot);
+      const auto key = RowContainer::normalizedKey(row);
+      // The same hash as the probe, see populateNormalizedKeys().
+      auto index = mixNormalizedKey(key, sizeBits_) & compactSlotMask_;
+      while (compactSlots_[index].row != nullptr) {
+        index = (index + 1) & compactSlotMask_;
+      }
+      compactSlots_[index] = {static_cast<uint64_t>(key), row};
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::freeCompactJoinTable() {
+  if (compactSlots_ != nullptr) {
+    rows_->pool()->freeContiguous(compactAllocation_);
+    compactSlots_ = nullptr;
+    compactSlotMask_ = 0;
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::compactJoinProbe(HashLookup& lookup) {
+  const auto numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* keys = lookup.normalizedKeys.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  char** hits = lookup.hits.data();
+  // Half full slots of 16 bytes mostly resolve a probe in one cache line, so
+  // prefetching that line ahead covers the latency.
+  constexpr int32_t kPrefetchDistance = 16;
+  for (auto i = 0; i < numProbes; ++i) {
+    if (i + kPrefetchDistance < numProbes) {
+      __builtin_prefetch(
+          compactSlots_ +
+          (hashes[rows[i + kPrefetchDistance]] & compactSlotMask_));
+    }
+    const auto row = rows[i];
+    auto index = hashes[row] & compactSlotMask_;
+    char* hit = nullptr;
+    for (;;) {
+      const auto& slot = compactSlots_[index];
+      if (slot.row == nullptr) {
+        break;
+      }
+      if (slot.normalizedKey == keys[row]) {
+        hit = slot.row;
+        break;
+      }
+      index = (index + 1) & compactSlotMask_;
+    }
+    hits[row] = hit;
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -1699,7 +2038,11 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
   }
   size_t numOut = 0;
   auto maxOut = inputRows.size();
-  while (iter.lastRowIndex < iter.rows->size()) {
+  const auto numRows = iter.rows->size();
+  while (iter.lastRowIndex < numRows) {
+    if (iter.lastDuplicateRowIndex == 0) {
+      prefetchDuplicates(iter, iter.lastRowIndex);
+    }
     auto row = (*iter.rows)[iter.lastRowIndex];
     auto hit = (*iter.hits)[row]; // NOLINT
     if (!hit) {
@@ -1722,9 +2065,9 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
       numOut++;
       iter.lastRowIndex++;
     } else {
-      auto numRows = rows->size();
+      auto numDuplicates = rows->size();
       auto num =
-          std::min(numRows - iter.lastDuplicateRowIndex, maxOut - numOut);
+          std::min(numDuplicates - iter.lastDuplicateRowIndex, maxOut - numOut);
       std::fill_n(inputRows.begin() + numOut, num, row);
       std::memcpy(
           hits.data() + numOut,
@@ -1732,7 +2075,7 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
           num * sizeof(char*));
       iter.lastDuplicateRowIndex += num;
       numOut += num;
-      if (iter.lastDuplicateRowIndex >= numRows) {
+      if (iter.lastDuplicateRowIndex >= numDuplicates) {
         iter.lastDuplicateRowIndex = 0;
         iter.lastRowIndex++;
       }
@@ -1744,6 +2087,31 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
   return numOut;
 }
 
+template <bool ignoreNullKeys>
+inline void HashTable<ignoreNullKeys>::prefetchDuplicates(
+    const JoinResultIterator& iter,
+    int32_t rowIndex) const {
+  // Getting the duplicates of a hit takes a load of the next row slot of the
+  // hit and then of the vector it points to. The first is prefetched
+  // 2 * kPrefetchDistance probe rows ahead and the second kPrefetchDistance
+  // rows ahead, when the slot is expected to be in cache.
+  constexpr int32_t kPrefetchDistance = 8;
+  const auto& rows = *iter.rows;
+  const auto& probeHits = *iter.hits;
+  if (rowIndex + 2 * kPrefetchDistance < rows.size()) {
+    if (auto* hit = probeHits[rows[rowIndex + 2 * kPrefetchDistance]]) {
+      __builtin_prefetch(hit + rows_->nextOffset());
+    }
+  }
+  if (rowIndex + kPrefetchDistance < rows.size()) {
+    if (auto* hit = probeHits[rows[rowIndex + kPrefetchDistance]]) {
+      if (auto* duplicates = rows_->getNextRowVector(hit)) {
+        __builtin_prefetch(duplicates->data());
+      }
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 int32_t HashTable<ignoreNullKeys>::listJoinResultsNoDuplicates(
     JoinResultIterator& iter,
@@ -1942,6 +2310,8 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
     folly::Range<char**> rows,
     uint64_t* hashes) {
   auto numRows = rows.size();
+  // The probes go back to 'table_'.
+  freeCompactJoinTable();
   if (hashMode_ == HashMode::kArray) {
     for (auto i = 0; i < numRows; ++i) {
       DCHECK(hashes[i] < capacity_);
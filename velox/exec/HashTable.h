@@ -95,6 +95,10 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory for the radix partitioned join probe.
+  raw_vector<vector_size_t> partitionedRows;
+  raw_vector<uint16_t> partitions;
 };
 
 struct HashTableStats {
@@ -103,6 +107,9 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Bytes of the table backed by huge pages. Only measured for tables of at
+  /// least BaseHashTable::kMinHugePageStatsBytes.
+  int64_t tableHugePageBytes{0};
 };
 
 class BaseHashTable {
@@ -123,12 +130,26 @@ class BaseHashTable {
 
   static constexpr int8_t kNoSpillInputStartPartitionBit = -1;
 
+  /// The min number of table entries per partition to apply the parallel
+  /// group by table rehash. Below this, the partition fits in the CPU cache
+  /// and a serial rehash is cheaper than the parallel coordination.
+  static constexpr uint64_t kMinTableSizeForParallelGroupByBuild = 64 << 10;
+
   /// The name of the runtime stats collected and reported by operators that use
   /// the HashTable (HashBuild, HashAggregation).
   static inline const std::string kCapacity{"hashtable.capacity"};
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kTableHugePageBytes{
+      "hashtable.tableHugePageBytes"};
+  static inline const std::string kRowHugePageBytes{
+      "hashtable.rowHugePageBytes"};
+
+  /// The min size of a table or row container for reporting its huge page
+  /// coverage. Measuring it reads /proc/self/smaps, which is not worth it for
+  /// small allocations that don't suffer from TLB misses.
+  static constexpr int64_t kMinHugePageStatsBytes = 64 << 20;
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
@@ -267,6 +288,33 @@ class BaseHashTable {
       folly::Executor* executor = nullptr,
       int8_t spillInputStartPartitionBit = kNoSpillInputStartPartitionBit) = 0;
 
+  /// Enables the parallel rehash of a group by hash table. When the table
+  /// grows, its rows are partitioned by ranges of their bucket offsets into
+  /// 'numPartitions' partitions which are inserted in parallel using
+  /// 'executor'. This only applies if the table is not in kArray mode and each
+  /// partition has at least kMinTableSizeForParallelGroupByBuild entries.
+  virtual void setParallelGroupByBuild(
+      folly::Executor* executor,
+      uint8_t numPartitions) = 0;
+
+  /// Makes joinProbe() of at least 'minRows' rows probe the rows in radix
+  /// partitions by their position in the table when the table is larger than
+  /// 2 * 'partitionBytes'. The probes of a partition then fall in a region of
+  /// 'partitionBytes', which stays in cache. 0 'minRows' disables this. See
+  /// QueryConfig::kHashProbeRadixPartitionMinRows.
+  virtual void setRadixPartitionedProbe(
+      int32_t minRows,
+      uint64_t partitionBytes = kDefaultRadixPartitionBytes) = 0;
+
+  /// Default table region of a radix partition of the probe. About the share
+  /// of the last level cache that one core can count on.
+  static constexpr uint64_t kDefaultRadixPartitionBytes = 8 << 20;
+
+  /// Makes prepareJoinTable() also build a compact table of the normalized
+  /// keys and row pointers if the table ends up in kNormalizedKey mode
+  /// without duplicates. See QueryConfig::kHashJoinCompactTableEnabled.
+  virtual void enableCompactJoinTable() = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -287,6 +335,12 @@ class BaseHashTable {
   /// profiling.
   virtual HashTableStats stats() const = 0;
 
+  /// Returns the bytes of the row containers backed by huge pages. Only row
+  /// containers of at least kMinHugePageStatsBytes are measured. This reads
+  /// /proc/self/smaps, so operators call it once, e.g. at close or before
+  /// spilling, not with stats() after every input.
+  int64_t rowHugePageBytes() const;
+
   /// Returns table growth in bytes after adding 'numNewDistinct' distinct
   /// entries. This only concerns the hash table, not the payload rows.
   virtual uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const = 0;
@@ -528,8 +582,10 @@ class HashTable : public BaseHashTable {
 
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
-    // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    // allocated with MemoryAllocator for fixed-width rows and strings, plus
+    // the compact join table if any.
+    return sizeof(char*) * capacity_ + rows_->allocatedBytes() +
+        compactAllocation_.size();
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -544,10 +600,7 @@ class HashTable : public BaseHashTable {
     return numDistinct_;
   }
 
-  HashTableStats stats() const override {
-    return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
-  }
+  HashTableStats stats() const override;
 
   bool hasDuplicateKeys() const override {
     return hasDuplicates_;
@@ -578,6 +631,27 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit =
           kNoSpillInputStartPartitionBit) override;
 
+  void setParallelGroupByBuild(folly::Executor* executor, uint8_t numPartitions)
+      override;
+
+  void setRadixPartitionedProbe(int32_t minRows, uint64_t partitionBytes)
+      override {
+    VELOX_CHECK(isJoinBuild_);
+    VELOX_CHECK(bits::isPowerOfTwo(partitionBytes));
+    radixPartitionMinRows_ = minRows;
+    radixPartitionBytes_ = partitionBytes;
+  }
+
+  void enableCompactJoinTable() override {
+    VELOX_CHECK(isJoinBuild_);
+    compactJoinTableEnabled_ = true;
+  }
+
+  /// Returns true if join probes go to the compact table.
+  bool hasCompactJoinTable() const {
+    return compactSlots_ != nullptr;
+  }
+
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
     if (numDistinct_ + numNewDistinct > rehashSize()) {
       // If rehashed, the table adds size_ entries (i.e. doubles),
@@ -592,10 +666,14 @@ class HashTable : public BaseHashTable {
     // Take the max of max size in array mode and estimated size in non-array
     // mode.
     const uint64_t maxByteSizeInArrayMode = kArrayHashMaxSize * tableSlotSize();
+    const uint64_t compactBytes = compactJoinTableEnabled_
+        ? bits::nextPowerOfTwo(numDistinct * 2) * sizeof(CompactSlot)
+        : 0;
     return bits::roundUp(
         std::max(
             maxByteSizeInArrayMode,
-            newHashTableEntries(numDistinct, 0) * tableSlotSize()),
+            newHashTableEntries(numDistinct, 0) * tableSlotSize()) +
+            compactBytes,
         memory::AllocationTraits::kPageSize);
   }
 
@@ -708,6 +786,11 @@ class HashTable : public BaseHashTable {
 
   void setHashMode(HashMode mode, int32_t numNew) override;
 
+  // Prefetches the duplicate rows of the hits of the probe rows ahead of
+  // 'rowIndex' in 'iter'.
+  void prefetchDuplicates(const JoinResultIterator& iter, int32_t rowIndex)
+      const;
+
   // Fast path for join results when there are no duplicates in the table.
   int32_t listJoinResultsNoDuplicates(
       JoinResultIterator& iter,
@@ -775,8 +858,15 @@ class HashTable : public BaseHashTable {
   // Inserts 'numGroups' entries into 'this'. 'groups' point to
   // contents in a RowContainer owned by 'this'. 'hashes' are the hash
   // numbers or array indices (if kArray mode) for each
-  // group. 'groups' is expected to have no duplicate keys.
-  void insertForGroupBy(char** groups, uint64_t* hashes, int32_t numGroups);
+  // group. 'groups' is expected to have no duplicate keys. If not null,
+  // 'partitionInfo' provides the table partition info for parallel group by
+  // table rehash. A row which can't be inserted within the partition range is
+  // added to the end of 'overflows' in 'partitionInfo' instead.
+  void insertForGroupBy(
+      char** groups,
+      uint64_t* hashes,
+      int32_t numGroups,
+      TableInsertPartitionInfo* partitionInfo = nullptr);
 
   // Checks if we can apply parallel table build optimization for hash join.
   // The function returns true if all of the following conditions:
@@ -797,6 +887,34 @@ class HashTable : public BaseHashTable {
   // else.
   void parallelJoinBuild();
 
+  // Sets 'buildPartitionBounds_' to split the table into 'numPartitions'
+  // ranges of bucket offsets for parallel table build.
+  void setBuildPartitionBounds(uint8_t numPartitions);
+
+  // Checks if we can apply parallel table rehash for group by. The function
+  // returns true if the table is not a join build, is not in kArray mode, and
+  // setParallelGroupByBuild() has been called with more than one partition,
+  // and each partition has at least kMinTableSizeForParallelGroupByBuild
+  // entries.
+  bool canApplyParallelGroupByBuild() const;
+
+  // Rehashes a group by table with 'numParallelGroupByBuildPartitions_'
+  // threads using 'buildExecutor_'. The rows get a partition number assigned
+  // from their bucket offsets first. Then each thread inserts the rows of its
+  // partition. The rows that would overflow past the end of their partition
+  // are inserted sequentially after all else. Returns false if the hash keys
+  // are not mappable via the VectorHashers, in which case the caller must
+  // switch to kHash mode.
+  bool parallelGroupByBuild(bool initNormalizedKeys);
+
+  // Inserts the rows in 'partition' of 'rowPartitions' into 'this'. The rows
+  // that would have gone past the end of the partition are returned in
+  // 'overflow'.
+  void buildGroupByPartition(
+      uint8_t partition,
+      const RowPartitions& rowPartitions,
+      std::vector<char*>& overflow);
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
   // The rows that would have gone past the end of the partition are returned in
   // 'overflow'.
@@ -841,6 +959,21 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Reorders 'lookup.rows' by the radix partition of their hashes if enabled
+  // and applicable, keeping the original rows in 'lookup.partitionedRows'.
+  // Returns true if reordered, in which case the caller swaps the two back
+  // after the probe.
+  bool maybeRadixPartitionRows(HashLookup& lookup);
+
+  // Builds the compact join table if enabled and applicable.
+  void maybeBuildCompactJoinTable();
+
+  // Frees the compact join table.
+  void freeCompactJoinTable();
+
+  // Probes the compact join table with normalized keys.
+  void compactJoinProbe(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -951,6 +1084,29 @@ class HashTable : public BaseHashTable {
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
+  // An entry of the compact join table.
+  struct CompactSlot {
+    uint64_t normalizedKey;
+    // nullptr if the slot is empty.
+    char* row;
+  };
+
+  // Set by setRadixPartitionedProbe().
+  int32_t radixPartitionMinRows_{0};
+  uint64_t radixPartitionBytes_{kDefaultRadixPartitionBytes};
+
+  // Set by enableCompactJoinTable().
+  bool compactJoinTableEnabled_{false};
+  // Open addressing table with linear probing of the normalized keys and
+  // rows of a kNormalizedKey mode join table without duplicates. A probe
+  // compares the key in the slot, so a miss takes one cache miss instead of
+  // one for the tags and one for the row. Kept next to 'table_', which the
+  // other uses of the table need.
+  CompactSlot* compactSlots_{nullptr};
+  memory::ContiguousAllocation compactAllocation_;
+  // Number of compact slots - 1. The number of slots is a power of 2.
+  uint64_t compactSlotMask_{0};
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
@@ -967,6 +1123,8 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Bytes of 'tableAllocation_' backed by huge pages when it was allocated.
+  int64_t tableHugePageBytes_{0};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -996,6 +1154,10 @@ class HashTable : public BaseHashTable {
   // execute the parallel build steps.
   folly::Executor* buildExecutor_{nullptr};
 
+  // The number of partitions for parallel group by table rehash. Set by
+  // setParallelGroupByBuild().
+  uint8_t numParallelGroupByBuildPartitions_{0};
+
   //  Counts parallel build rows. Used for consistency check.
   std::atomic<int64_t> numParallelBuildRows_{0};
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/IntervalJoinIndex.h"
+
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+namespace {
+template <typename T>
+void readValuesTyped(
+    const DecodedVector& decoded,
+    std::vector<int64_t>& values) {
+  for (auto row = 0; row < values.size(); ++row) {
+    values[row] = decoded.isNullAt(row) ? 0 : decoded.valueAt<T>(row);
+  }
+}
+} // namespace
+
+// static
+void IntervalJoinIndex::readValues(
+    const BaseVector& vector,
+    std::vector<int64_t>& values) {
+  DecodedVector decoded(vector);
+  values.resize(vector.size());
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      readValuesTyped<int8_t>(decoded, values);
+      break;
+    case TypeKind::SMALLINT:
+      readValuesTyped<int16_t>(decoded, values);
+      break;
+    case TypeKind::INTEGER:
+      readValuesTyped<int32_t>(decoded, values);
+      break;
+    case TypeKind::BIGINT:
+      readValuesTyped<int64_t>(decoded, values);
+      break;
+    default:
+      VELOX_UNREACHABLE(
+          "Bad interval join key type {}", vector.type()->toString());
+  }
+}
+
+IntervalJoinIndex::IntervalJoinIndex(
+    const RowVector& build,
+    column_index_t lowChannel,
+    column_index_t highChannel) {
+  const auto& lowVector = build.childAt(lowChannel);
+  const auto& highVector = build.childAt(highChannel);
+  std::vector<int64_t> lows;
+  std::vector<int64_t> highs;
+  readValues(*lowVector, lows);
+  readValues(*highVector, highs);
+
+  for (auto row = 0; row < build.size(); ++row) {
+    if (!lowVector->isNullAt(row) && !highVector->isNullAt(row) &&
+        lows[row] <= highs[row]) {
+      rows_.push_back(row);
+    }
+  }
+  std::sort(rows_.begin(), rows_.end(), [&](auto left, auto right) {
+    return lows[left] < lows[right];
+  });
+
+  lows_.reserve(rows_.size());
+  highs_.reserve(rows_.size());
+  maxHighs_.reserve(rows_.size());
+  for (auto row : rows_) {
+    lows_.push_back(lows[row]);
+    highs_.push_back(highs[row]);
+    maxHighs_.push_back(
+        maxHighs_.empty() ? highs[row]
+                          : std::max(maxHighs_.back(), highs[row]));
+  }
+}
+
+} // namespace facebook::velox::exec
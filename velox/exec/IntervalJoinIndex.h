@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Index of the intervals [low, high] given by two integer columns of a
+/// vector of the build side of a nested loop join. Finds the intervals that
+/// contain a probe value, as for a join condition of value BETWEEN low AND
+/// high, with a binary search instead of a comparison with every interval.
+///
+/// The intervals are sorted on 'low'. The intervals with 'low' <= value are
+/// scanned backwards while the maximum 'high' of the intervals up to the
+/// position is >= value, so that disjoint intervals cost O(log(n)) per probe.
+/// Rows with a null bound are not indexed since they match no value.
+class IntervalJoinIndex {
+ public:
+  IntervalJoinIndex(
+      const RowVector& build,
+      column_index_t lowChannel,
+      column_index_t highChannel);
+
+  /// Calls 'onMatch(row)' with the row number in the build vector for each
+  /// interval that contains 'value'. The matches come in the same order on
+  /// every call. Stops and returns false if 'onMatch' returns false.
+  template <typename TOnMatch>
+  bool forEachMatch(int64_t value, TOnMatch onMatch) const {
+    const auto end = std::upper_bound(lows_.begin(), lows_.end(), value);
+    for (auto i = end - lows_.begin() - 1; i >= 0 && maxHighs_[i] >= value;
+         --i) {
+      if (highs_[i] >= value && !onMatch(rows_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  vector_size_t size() const {
+    return rows_.size();
+  }
+
+  /// Reads the integer 'vector' into 'values'. Rows with a null get 0.
+  static void readValues(
+      const BaseVector& vector,
+      std::vector<int64_t>& values);
+
+ private:
+  // The bounds and row numbers of the intervals in ascending order of 'low'.
+  std::vector<int64_t> lows_;
+  std::vector<int64_t> highs_;
+  std::vector<vector_size_t> rows_;
+  // Maximum of 'highs_' up to and including each position.
+  std::vector<int64_t> maxHighs_;
+};
+
+} // namespace facebook::velox::exec
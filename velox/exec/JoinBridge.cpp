@@ -28,6 +28,11 @@ void JoinBridge::start() {
   started_ = true;
 }
 
+bool JoinBridge::hasWaiters() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return !promises_.empty();
+}
+
 void JoinBridge::cancel() {
   std::vector<ContinuePromise> promises;
   {
@@ -31,6 +31,9 @@ class JoinBridge {
   /// happen asynchronously before or after the result has been set.
   void cancel();
 
+  /// Returns true if some activity, e.g. a join probe, waits for the result.
+  bool hasWaiters();
+
  protected:
   static void notify(std::vector<ContinuePromise> promises);
 
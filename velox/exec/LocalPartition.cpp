@@ -57,7 +57,11 @@ std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
 
 void LocalExchangeQueue::addProducer() {
   queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+    // Producers may be added after noMoreProducers() as long as some are
+    // still running, see Task::addDrivers().
+    VELOX_CHECK(
+        !noMoreProducers_ || pendingProducers_ > 0,
+        "addProducer called after all producers finished");
     ++pendingProducers_;
   });
 }
@@ -77,16 +81,15 @@ void LocalExchangeQueue::noMoreProducers() {
 
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
+    int64_t inputBytes,
     ContinueFuture* future) {
-  auto inputBytes = input->estimateFlatSize();
-
   std::vector<ContinuePromise> consumerPromises;
   bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue.push({std::move(input), inputBytes});
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -124,7 +127,8 @@ void LocalExchangeQueue::noMoreData() {
 BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
-    RowVectorPtr* data) {
+    RowVectorPtr* data,
+    int64_t* dataBytes) {
   std::vector<ContinuePromise> memoryPromises;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
@@ -139,11 +143,14 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    *data = std::move(queue.front().vector);
+    const auto bytes = queue.front().bytes;
     queue.pop();
+    if (dataBytes != nullptr) {
+      *dataBytes = bytes;
+    }
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    memoryPromises = memoryManager_->decreaseMemoryUsage(bytes);
 
     return BlockingReason::kNotBlocked;
   });
@@ -152,7 +159,7 @@ BlockingReason LocalExchangeQueue::next(
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<BufferedVector>& queue) const {
   if (closed_) {
     return true;
   }
@@ -174,7 +181,7 @@ void LocalExchangeQueue::close() {
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
 
@@ -220,13 +227,14 @@ BlockingReason LocalExchange::isBlocked(ContinueFuture* future) {
 
 RowVectorPtr LocalExchange::getOutput() {
   RowVectorPtr data;
-  blockingReason_ = queue_->next(&future_, pool(), &data);
+  int64_t dataBytes = 0;
+  blockingReason_ = queue_->next(&future_, pool(), &data, &dataBytes);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
     return nullptr;
   }
   if (data != nullptr) {
     auto lockedStats = stats_.wlock();
-    lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+    lockedStats->addInputVector(dataBytes, data->size());
   }
   return data;
 }
@@ -295,70 +303,73 @@ wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
 }
 } // namespace
 
-void LocalPartition::addInput(RowVectorPtr input) {
-  {
-    auto lockedStats = stats_.wlock();
-    lockedStats->addOutputVector(input->estimateFlatSize(), input->size());
+void LocalPartition::enqueue(
+    LocalExchangeQueue& queue,
+    RowVectorPtr data,
+    int64_t dataBytes) {
+  ContinueFuture future;
+  auto reason = queue.enqueue(std::move(data), dataBytes, &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
   }
+}
 
+void LocalPartition::addInput(RowVectorPtr input) {
   // Lazy vectors must be loaded or processed.
   for (auto& child : input->children()) {
     child->loadedVector();
   }
 
+  // The size is estimated once per input. The queues and the consumers reuse
+  // it instead of walking the columns again for each partition.
+  const int64_t inputBytes = input->estimateFlatSize();
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->addOutputVector(inputBytes, input->size());
+  }
+
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(*queues_[0], std::move(input), inputBytes);
     return;
   }
 
   const auto singlePartition =
       partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(*queues_[singlePartition.value()], std::move(input), inputBytes);
     return;
   }
 
   const auto numInput = input->size();
-  std::vector<vector_size_t> maxIndex(numPartitions_, 0);
+  partitionSizes_.assign(numPartitions_, 0);
   for (auto i = 0; i < numInput; ++i) {
-    ++maxIndex[partitions_[i]];
+    ++partitionSizes_[partitions_[i]];
   }
-  auto indexBuffers = allocateIndexBuffers(maxIndex, pool());
+  auto indexBuffers = allocateIndexBuffers(partitionSizes_, pool());
   auto rawIndices = getRawIndices(indexBuffers);
 
-  std::fill(maxIndex.begin(), maxIndex.end(), 0);
+  std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
   for (auto i = 0; i < numInput; ++i) {
     auto partition = partitions_[i];
-    rawIndices[partition][maxIndex[partition]] = i;
-    ++maxIndex[partition];
+    rawIndices[partition][partitionSizes_[partition]] = i;
+    ++partitionSizes_[partition];
   }
 
   for (auto i = 0; i < numPartitions_; i++) {
-    auto partitionSize = maxIndex[i];
+    auto partitionSize = partitionSizes_[i];
     if (partitionSize == 0) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
-    }
+    // A partition whose rows are all of the input is passed on as is.
+    auto partitionData = partitionSize == numInput
+        ? input
+        : wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
+    enqueue(
+        *queues_[i],
+        std::move(partitionData),
+        inputBytes * partitionSize / numInput);
   }
 }
 
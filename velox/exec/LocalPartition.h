@@ -67,7 +67,12 @@ class LocalExchangeQueue {
   /// Used by a producer to add data. Returning kNotBlocked if can accept more
   /// data. Otherwise returns kWaitForConsumer and sets future that will be
   /// completed when ready to accept more data.
-  BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future);
+  ///
+  /// @param inputBytes The estimated flat size of 'input'. The queue accounts
+  /// for 'input' with this size until it is consumed, so the size is not
+  /// recomputed.
+  BlockingReason
+  enqueue(RowVectorPtr input, int64_t inputBytes, ContinueFuture* future);
 
   /// Called by a producer to indicate that no more data will be added.
   void noMoreData();
@@ -79,8 +84,12 @@ class LocalExchangeQueue {
   /// once there is data to fetch or if all producers report completion.
   ///
   /// @param pool Memory pool used to copy the data before returning.
-  BlockingReason
-  next(ContinueFuture* future, memory::MemoryPool* pool, RowVectorPtr* data);
+  /// @param dataBytes If not null, set to the size 'data' was enqueued with.
+  BlockingReason next(
+      ContinueFuture* future,
+      memory::MemoryPool* pool,
+      RowVectorPtr* data,
+      int64_t* dataBytes = nullptr);
 
   bool isFinished();
 
@@ -89,11 +98,17 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A vector in the queue with the size it was enqueued with.
+  struct BufferedVector {
+    RowVectorPtr vector;
+    int64_t bytes;
+  };
+
+  bool isFinishedLocked(const std::queue<BufferedVector>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<BufferedVector>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -176,11 +191,20 @@ class LocalPartition : public Operator {
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
 
+  // Enqueues 'data' of 'dataBytes' estimated flat size into 'queue' and
+  // records the blocking reason and future if the queue is full.
+  void enqueue(
+      LocalExchangeQueue& queue,
+      RowVectorPtr data,
+      int64_t dataBytes);
+
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
 
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
+  /// Reusable memory for the number of rows in each partition.
+  std::vector<vector_size_t> partitionSizes_;
 };
 
 } // namespace facebook::velox::exec
@@ -403,6 +403,58 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Returns the aggregates of 'node' for TableScan::setStatisticsAggregation(),
+// or std::nullopt if 'node' is not a partial global aggregation of only
+// count, min and max over input columns.
+std::optional<std::vector<connector::StatisticsAggregate>>
+toStatisticsAggregates(const core::AggregationNode& node) {
+  using Kind = connector::StatisticsAggregate::Kind;
+  if (node.step() != core::AggregationNode::Step::kPartial ||
+      !node.groupingKeys().empty() || !node.globalGroupingSets().empty()) {
+    return std::nullopt;
+  }
+  std::vector<connector::StatisticsAggregate> aggregates;
+  for (auto i = 0; i < node.aggregates().size(); ++i) {
+    const auto& aggregate = node.aggregates()[i];
+    if (aggregate.mask != nullptr || aggregate.distinct ||
+        !aggregate.sortingKeys.empty()) {
+      return std::nullopt;
+    }
+    // The function names may have a prefix, e.g. 'presto.default.'.
+    const auto& fullName = aggregate.call->name();
+    const auto name = fullName.substr(fullName.rfind('.') + 1);
+    const auto& inputs = aggregate.call->inputs();
+    // The partial aggregation produces the intermediate results.
+    const auto& intermediateType = node.outputType()->childAt(i);
+    if (name == "count" && inputs.empty()) {
+      if (!intermediateType->equivalent(*BIGINT())) {
+        return std::nullopt;
+      }
+      aggregates.push_back({Kind::kCountAll, ""});
+      continue;
+    }
+    if (inputs.size() != 1) {
+      return std::nullopt;
+    }
+    const auto* field =
+        dynamic_cast<const core::FieldAccessTypedExpr*>(inputs[0].get());
+    if (field == nullptr || !field->isInputColumn()) {
+      return std::nullopt;
+    }
+    if (name == "count" && intermediateType->equivalent(*BIGINT())) {
+      aggregates.push_back({Kind::kCount, field->name()});
+    } else if (
+        (name == "min" || name == "max") &&
+        intermediateType->equivalent(*field->type())) {
+      aggregates.push_back(
+          {name == "min" ? Kind::kMin : Kind::kMax, field->name()});
+    } else {
+      return std::nullopt;
+    }
+  }
+  return aggregates;
+}
+
 } // namespace
 
 std::shared_ptr<Driver> DriverFactory::createDriver(
@@ -450,8 +502,20 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto tableScanNode =
             std::dynamic_pointer_cast<const core::TableScanNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<TableScan>(id, ctx.get(), tableScanNode));
+      auto tableScan =
+          std::make_unique<TableScan>(id, ctx.get(), tableScanNode);
+      if (i < planNodes.size() - 1) {
+        if (auto limitNode = std::dynamic_pointer_cast<const core::LimitNode>(
+                planNodes[i + 1])) {
+          // The Limit takes no more than 'offset' + 'count' rows from the
+          // scan.
+          constexpr auto kMaxRows = std::numeric_limits<int64_t>::max();
+          if (limitNode->count() <= kMaxRows - limitNode->offset()) {
+            tableScan->setRowLimit(limitNode->offset() + limitNode->count());
+          }
+        }
+      }
+      operators.push_back(std::move(tableScan));
     } else if (
         auto tableWriteNode =
             std::dynamic_pointer_cast<const core::TableWriteNode>(planNode)) {
@@ -499,8 +563,24 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
         operators.push_back(std::make_unique<StreamingAggregation>(
             id, ctx.get(), aggregationNode));
       } else {
-        operators.push_back(
-            std::make_unique<HashAggregation>(id, ctx.get(), aggregationNode));
+        auto hashAggregation =
+            std::make_unique<HashAggregation>(id, ctx.get(), aggregationNode);
+        auto* tableScan = operators.empty()
+            ? nullptr
+            : dynamic_cast<TableScan*>(operators.back().get());
+        if (tableScan != nullptr &&
+            ctx->queryConfig().tableScanAggregationFromStatistics()) {
+          if (auto aggregates = toStatisticsAggregates(*aggregationNode)) {
+            // Both operators run on the same driver thread.
+            tableScan->setStatisticsAggregation(
+                std::move(aggregates.value()),
+                [aggregation = hashAggregation.get()](
+                    const std::vector<VectorPtr>& intermediates) {
+                  aggregation->addIntermediateResults(intermediates);
+                });
+          }
+        }
+        operators.push_back(std::move(hashAggregation));
       }
     } else if (
         auto expandNode =
@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -29,7 +30,8 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    // Spilled input is output after all the other input.
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -38,6 +40,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +50,55 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the distinct keys in 'table_' by hash partition and clears
+  // 'table_'. The input received afterwards is spilled to the same
+  // partitions.
+  void spill();
+
+  SpillPartitionNumSet spillHashTable();
+
+  void setupInputSpiller(const SpillPartitionNumSet& spillPartitionSet);
+
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  // Loads the distinct keys of the next spilled partition into 'table_' and
+  // reads the first batch of the spilled input of that partition.
+  void restoreNextSpillPartition();
+
+  // Probes 'table_' with 'input_' to find the distinct rows.
+  void probeInput(uint8_t spillInputStartPartitionBit);
+
+  RowTypePtr inputType_;
+
+  // Hash table of the distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  // The spill partition bits used by both hash table content spill and input
+  // data spill.
+  HashBitRange spillPartitionBits_;
+
+  SpillPartitionSet spillHashTablePartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Used to restore previously spilled input.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
 };
 } // namespace facebook::velox::exec
@@ -21,6 +21,43 @@
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+// Max number of bytes of the normalized keys of a row. The keys after it are
+// compared by value.
+constexpr uint32_t kMaxNormalizedKeySize = 128;
+
+template <typename T>
+void encodeKeyColumn(
+    const DecodedVector& decoded,
+    const prefixsort::PrefixSortEncoder& encoder,
+    vector_size_t numRows,
+    uint32_t entrySize,
+    char* dest) {
+  for (vector_size_t row = 0; row < numRows; ++row, dest += entrySize) {
+    encoder.encode(
+        decoded.isNullAt(row) ? std::nullopt
+                              : std::optional<T>(decoded.valueAt<T>(row)),
+        dest);
+  }
+}
+
+void encodeStringKeyColumn(
+    const DecodedVector& decoded,
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t prefixLength,
+    vector_size_t numRows,
+    uint32_t entrySize,
+    char* dest) {
+  for (vector_size_t row = 0; row < numRows; ++row, dest += entrySize) {
+    encoder.encodeString(
+        decoded.isNullAt(row)
+            ? std::nullopt
+            : std::optional<StringView>(decoded.valueAt<StringView>(row)),
+        dest,
+        prefixLength);
+  }
+}
+} // namespace
 
 Merge::Merge(
     int32_t operatorId,
@@ -53,6 +90,24 @@ Merge::Merge(
             sortingOrders[i].isAscending(),
             false});
   }
+
+  // Normalizes the leading keys up to the first one with a type that has its
+  // own comparison or cannot be normalized.
+  std::vector<TypePtr> keyTypes;
+  std::vector<CompareFlags> keyCompareFlags;
+  for (const auto& [channel, compareFlags] : sortingKeys_) {
+    const auto& type = outputType_->childAt(channel);
+    if (type->providesCustomComparison()) {
+      break;
+    }
+    keyTypes.push_back(type);
+    keyCompareFlags.push_back(compareFlags);
+  }
+  auto keyLayout = PrefixSortLayout::makeSortLayout(
+      keyTypes, keyCompareFlags, kMaxNormalizedKeySize);
+  if (keyLayout.numNormalizedKeys > 0) {
+    keyLayout_.emplace(std::move(keyLayout));
+  }
 }
 
 void Merge::initializeTreeOfLosers() {
@@ -60,7 +115,10 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        keyLayout_.has_value() ? &keyLayout_.value() : nullptr,
+        outputBatchSize_));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -189,21 +247,66 @@ void Merge::close() {
 
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
-  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+  uint32_t firstKey = 0;
+  if (keyLayout_ != nullptr) {
+    if (const auto result = compareNormalizedKeys(otherCursor, firstKey)) {
+      return result < 0;
+    }
+  }
+  return compareKeysFrom(otherCursor, firstKey) < 0;
+}
+
+int32_t SourceStream::compareNormalizedKeys(
+    const SourceStream& other,
+    uint32_t& firstKey) const {
+  const auto entrySize = keyLayout_->normalizedBufferSize;
+  const char* left = normalizedKeys_.data() + currentSourceRow_ * entrySize;
+  const char* right =
+      other.normalizedKeys_.data() + other.currentSourceRow_ * entrySize;
+  // Compares up to the end of each string key first. The bytes after a
+  // string key do not decide the order if the strings are truncated.
+  uint32_t begin = 0;
+  for (const auto key : keyLayout_->stringKeys) {
+    const auto prefixLength = keyLayout_->stringPrefixLengths[key];
+    const auto lengthByte = keyLayout_->prefixOffsets[key] + 1 + prefixLength;
+    const auto end = lengthByte + 1;
+    if (const auto result = memcmp(left + begin, right + begin, end - begin)) {
+      return result;
+    }
+    // The length bytes are equal, so both strings are truncated or none.
+    if (static_cast<uint8_t>(left[lengthByte]) ==
+        keyLayout_->encoders[key].stringTruncatedByte(prefixLength)) {
+      firstKey = key;
+      return 0;
+    }
+    begin = end;
+  }
+  if (const auto result =
+          memcmp(left + begin, right + begin, entrySize - begin)) {
+    return result;
+  }
+  firstKey = keyLayout_->numNormalizedKeys;
+  return 0;
+}
+
+int32_t SourceStream::compareKeysFrom(
+    const SourceStream& other,
+    uint32_t firstKey) const {
+  for (auto i = firstKey; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
     if (auto result = keyColumns_[i]
                           ->compare(
-                              otherCursor.keyColumns_[i],
+                              other.keyColumns_[i],
                               currentSourceRow_,
-                              otherCursor.currentSourceRow_,
+                              other.currentSourceRow_,
                               compareFlags)
                           .value()) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
 }
 
 bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
@@ -263,10 +366,61 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    if (keyLayout_ != nullptr) {
+      encodeKeys();
+    }
   }
   return false;
 }
 
+void SourceStream::encodeKeys() {
+  const auto numRows = data_->size();
+  const auto entrySize = keyLayout_->normalizedBufferSize;
+  // The padding at the end of the entries is never written and stays 0.
+  normalizedKeys_.resize(numRows * entrySize);
+  for (auto i = 0; i < keyLayout_->numNormalizedKeys; ++i) {
+    decodedKey_.decode(*keyColumns_[i]);
+    const auto& encoder = keyLayout_->encoders[i];
+    char* dest = normalizedKeys_.data() + keyLayout_->prefixOffsets[i];
+    switch (keyColumns_[i]->typeKind()) {
+      case TypeKind::INTEGER:
+        encodeKeyColumn<int32_t>(
+            decodedKey_, encoder, numRows, entrySize, dest);
+        break;
+      case TypeKind::BIGINT:
+        encodeKeyColumn<int64_t>(
+            decodedKey_, encoder, numRows, entrySize, dest);
+        break;
+      case TypeKind::REAL:
+        encodeKeyColumn<float>(decodedKey_, encoder, numRows, entrySize, dest);
+        break;
+      case TypeKind::DOUBLE:
+        encodeKeyColumn<double>(
+            decodedKey_, encoder, numRows, entrySize, dest);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeKeyColumn<Timestamp>(
+            decodedKey_, encoder, numRows, entrySize, dest);
+        break;
+      case TypeKind::VARCHAR:
+        [[fallthrough]];
+      case TypeKind::VARBINARY:
+        encodeStringKeyColumn(
+            decodedKey_,
+            encoder,
+            keyLayout_->stringPrefixLengths[i],
+            numRows,
+            entrySize,
+            dest);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected normalized merge key type: {}",
+            keyColumns_[i]->type()->toString());
+    }
+  }
+}
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -17,7 +17,9 @@
 
 #include "velox/exec/Exchange.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/TreeOfLosers.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::exec {
 
@@ -63,6 +65,10 @@ class Merge : public SourceOperator {
 
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
+  /// Layout of the normalized leading sort keys that the streams encode for
+  /// each batch. Not set if the first sort key cannot be normalized.
+  std::optional<PrefixSortLayout> keyLayout_;
+
   /// A list of cursors over batches of ordered source data. One per source.
   /// Aligned with 'sources'.
   std::vector<SourceStream*> streams_;
@@ -87,9 +93,11 @@ class SourceStream final : public MergeStream {
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+      const PrefixSortLayout* keyLayout,
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
+        keyLayout_{keyLayout},
         outputRows_(outputBatchSize, false),
         sourceRows_(outputBatchSize) {
     keyColumns_.reserve(sortingKeys.size());
@@ -134,12 +142,31 @@ class SourceStream final : public MergeStream {
   void copyToOutput(RowVectorPtr& output);
 
  private:
+  // Compares the normalized keys of the current rows of 'this' and 'other'.
+  // Returns the result if the keys decide the order. Otherwise, returns 0
+  // and sets 'firstKey' to the first key to compare by value: the first
+  // string key that is truncated in both rows with equal prefixes, or the
+  // first key that is not normalized.
+  int32_t compareNormalizedKeys(const SourceStream& other, uint32_t& firstKey)
+      const;
+
+  // Compares the current rows of 'this' and 'other' by value from key
+  // 'firstKey' on.
+  int32_t compareKeysFrom(const SourceStream& other, uint32_t firstKey) const;
+
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Fills 'normalizedKeys_' for the rows of 'data_'.
+  void encodeKeys();
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  // Layout of the normalized keys or nullptr if the rows are compared by
+  // value only.
+  const PrefixSortLayout* const keyLayout_;
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -147,6 +174,14 @@ class SourceStream final : public MergeStream {
   /// order as 'sortingKeys_'.
   std::vector<BaseVector*> keyColumns_;
 
+  /// The normalized keys of the rows of 'data_', one entry of
+  /// 'keyLayout_->normalizedBufferSize' bytes per row. Compared with memcmp
+  /// so that most comparisons do not go through the key vectors.
+  std::vector<char> normalizedKeys_;
+
+  /// Reusable decoder of the key columns.
+  DecodedVector decodedKey_;
+
   /// Index of the current row.
   vector_size_t currentSourceRow_{0};
 
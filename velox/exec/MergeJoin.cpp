@@ -33,10 +33,14 @@ MergeJoin::MergeJoin(
       outputBatchSize_{outputBatchRows()},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
-      joinNode_(joinNode) {
+      joinNode_(joinNode),
+      band_(joinNode->band()) {
   VELOX_USER_CHECK(
       joinNode_->isInnerJoin() || joinNode_->isLeftJoin(),
       "Merge join supports only inner and left joins. Other join types are not supported yet.");
+  VELOX_USER_CHECK(
+      !band_.has_value() || joinNode_->filter() == nullptr,
+      "Merge band join does not support a filter");
 }
 
 void MergeJoin::initialize() {
@@ -56,6 +60,11 @@ void MergeJoin::initialize() {
     rightKeys_.push_back(rightType->getChildIdx(key->name()));
   }
 
+  if (band_.has_value()) {
+    leftEquiKeys_.assign(leftKeys_.begin(), leftKeys_.end() - 1);
+    rightEquiKeys_.assign(rightKeys_.begin(), rightKeys_.end() - 1);
+  }
+
   for (auto i = 0; i < leftType->size(); ++i) {
     auto name = leftType->nameOf(i);
     auto outIndex = outputType_->getChildIdxIfExists(name);
@@ -163,9 +172,52 @@ bool MergeJoin::needsInput() const {
   return input_ == nullptr;
 }
 
+namespace {
+template <typename T>
+void readBandValues(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    std::vector<int64_t>& values) {
+  for (auto i = 0; i < size; ++i) {
+    values[i] = decoded.isNullAt(i) ? 0 : decoded.valueAt<T>(i);
+  }
+}
+
+// Reads the integer band key at 'channel' of 'input' into 'values'. Rows with
+// a null key get 0. These rows are skipped by the callers.
+void readBandKey(
+    const RowVectorPtr& input,
+    column_index_t channel,
+    std::vector<int64_t>& values) {
+  const auto& key = input->childAt(channel);
+  DecodedVector decoded(*key);
+  values.resize(input->size());
+  switch (key->typeKind()) {
+    case TypeKind::TINYINT:
+      readBandValues<int8_t>(decoded, input->size(), values);
+      break;
+    case TypeKind::SMALLINT:
+      readBandValues<int16_t>(decoded, input->size(), values);
+      break;
+    case TypeKind::INTEGER:
+      readBandValues<int32_t>(decoded, input->size(), values);
+      break;
+    case TypeKind::BIGINT:
+      readBandValues<int64_t>(decoded, input->size(), values);
+      break;
+    default:
+      VELOX_UNREACHABLE("Bad band key type {}", key->type()->toString());
+  }
+}
+} // namespace
+
 void MergeJoin::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   index_ = 0;
+  if (band_.has_value()) {
+    readBandKey(input_, leftKeys_.back(), leftBandValues_);
+    windowReady_ = false;
+  }
 
   if (leftJoinTracker_) {
     leftJoinTracker_->resetLastVector();
@@ -470,6 +522,8 @@ RowVectorPtr MergeJoin::getOutput() {
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
+          } else if (band_.has_value()) {
+            readBandKey(rightInput_, rightKeys_.back(), rightBandValues_);
           }
         } else {
           noMoreRightInput_ = true;
@@ -482,7 +536,131 @@ RowVectorPtr MergeJoin::getOutput() {
   }
 }
 
+bool MergeJoin::advanceWindow() {
+  // The left row matches the right rows whose band key is in [low, high].
+  const int128_t leftValue = leftBandValues_[index_];
+  const int128_t low = leftValue - band_->upper;
+  const int128_t high = leftValue - band_->lower;
+
+  // The left side is sorted, so the rows dropped here have a smaller key than
+  // all the remaining left rows.
+  while (!window_.empty()) {
+    const auto& row = window_.front();
+    const auto& batch = windowBatches_[row.batch - firstWindowBatch_];
+    const auto result = compareEquiKeys(batch, row.index);
+    if (result < 0 || (result == 0 && row.band >= low)) {
+      break;
+    }
+    window_.pop_front();
+  }
+  while (!windowBatches_.empty() &&
+         (window_.empty() || window_.front().batch > firstWindowBatch_)) {
+    windowBatches_.pop_front();
+    ++firstWindowBatch_;
+  }
+
+  while (rightInput_) {
+    const auto result = compareEquiKeys(rightInput_, rightIndex_);
+    const auto rightValue = rightBandValues_[rightIndex_];
+    if (result < 0 || (result == 0 && rightValue > high)) {
+      return true;
+    }
+    if (result == 0 && rightValue >= low) {
+      if (windowBatches_.empty() || windowBatches_.back() != rightInput_) {
+        // The rows in the window are kept past getting new batches of input.
+        loadColumns(rightInput_, *operatorCtx_->execCtx());
+        windowBatches_.push_back(rightInput_);
+      }
+      window_.push_back(
+          {firstWindowBatch_ + static_cast<int64_t>(windowBatches_.size()) - 1,
+           rightIndex_,
+           rightValue});
+    }
+    rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+    if (rightIndex_ == rightInput_->size()) {
+      rightInput_ = nullptr;
+    }
+  }
+  return noMoreRightInput_;
+}
+
+RowVectorPtr MergeJoin::doGetBandOutput() {
+  for (;;) {
+    if (!input_) {
+      if (noMoreInput_ && output_) {
+        output_->resize(outputSize_);
+        return std::move(output_);
+      }
+      return nullptr;
+    }
+
+    if (!windowReady_) {
+      if (firstNonNull(input_, leftKeys_, index_) != index_) {
+        // A left row with a null key has no match.
+        if (isLeftJoin(joinType_)) {
+          prepareOutput();
+          if (outputSize_ == outputBatchSize_) {
+            return std::move(output_);
+          }
+          addOutputRowForLeftJoin(input_, index_);
+          ++index_;
+        } else {
+          index_ = firstNonNull(input_, leftKeys_, index_);
+        }
+        if (index_ == input_->size()) {
+          input_ = nullptr;
+        }
+        continue;
+      }
+      if (!advanceWindow()) {
+        // Need more input on the right side.
+        return nullptr;
+      }
+      windowReady_ = true;
+      windowCursor_ = 0;
+    }
+
+    if (!isLeftJoin(joinType_) && window_.empty() && noMoreRightInput_ &&
+        !rightInput_) {
+      // No more left rows can match.
+      input_ = nullptr;
+      continue;
+    }
+
+    prepareOutput();
+    if (window_.empty() && isLeftJoin(joinType_)) {
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+      addOutputRowForLeftJoin(input_, index_);
+    }
+    for (; windowCursor_ < window_.size(); ++windowCursor_) {
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+      const auto& row = window_[windowCursor_];
+      addOutputRow(
+          input_,
+          index_,
+          windowBatches_[row.batch - firstWindowBatch_],
+          row.index);
+    }
+
+    windowReady_ = false;
+    if (++index_ == input_->size()) {
+      input_ = nullptr;
+    }
+    if (outputSize_ == outputBatchSize_) {
+      return std::move(output_);
+    }
+  }
+}
+
 RowVectorPtr MergeJoin::doGetOutput() {
+  if (band_.has_value()) {
+    return doGetBandOutput();
+  }
+
   // Check if we ran out of space in the output vector in the middle of the
   // match.
   if (leftMatch_ && leftMatch_->cursor) {
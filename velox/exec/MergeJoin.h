@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #pragma once
+#include <deque>
+
 #include <folly/container/F14Map.h>
 
 #include "velox/exec/MergeSource.h"
@@ -55,6 +57,23 @@ class MergeJoin : public Operator {
 
   RowVectorPtr doGetOutput();
 
+  // Produces the output of a band join. Keeps the right rows that match the
+  // left row at 'index_' in 'window_'. The window slides forward over the
+  // right side as the left side advances.
+  RowVectorPtr doGetBandOutput();
+
+  // Drops the rows that can no longer match from the front of 'window_' and
+  // appends the right rows that match the left row at 'index_'. Returns false
+  // if more right side input is needed.
+  bool advanceWindow();
+
+  // Returns the comparison of the non-band keys of the left row at 'index_'
+  // and 'index' of the right side 'batch'.
+  int32_t compareEquiKeys(const RowVectorPtr& batch, vector_size_t index)
+      const {
+    return compare(leftEquiKeys_, input_, index_, rightEquiKeys_, batch, index);
+  }
+
   static int32_t compare(
       const std::vector<column_index_t>& keys,
       const RowVectorPtr& batch,
@@ -406,6 +425,39 @@ class MergeJoin : public Operator {
   // A future that will be completed when right side input becomes available.
   ContinueFuture futureRightSideInput_{ContinueFuture::makeEmpty()};
 
+  // Set for a band join. The last of 'leftKeys_' and 'rightKeys_' is then the
+  // band key and the other keys are in 'leftEquiKeys_' and 'rightEquiKeys_'.
+  const std::optional<core::MergeJoinNode::Band> band_;
+  std::vector<column_index_t> leftEquiKeys_;
+  std::vector<column_index_t> rightEquiKeys_;
+
+  // Values of the band key of 'input_' and 'rightInput_'.
+  std::vector<int64_t> leftBandValues_;
+  std::vector<int64_t> rightBandValues_;
+
+  // A right row that may match the current left row of a band join. 'batch'
+  // is the sequence number of the row's batch in 'windowBatches_'.
+  struct WindowRow {
+    int64_t batch;
+    vector_size_t index;
+    int64_t band;
+  };
+
+  // The right rows that match the left row at 'index_', in input order. Only
+  // valid if 'windowReady_' is true.
+  std::deque<WindowRow> window_;
+
+  // The right side batches referenced from 'window_'. The first has the
+  // sequence number 'firstWindowBatch_'.
+  std::deque<RowVectorPtr> windowBatches_;
+  int64_t firstWindowBatch_{0};
+
+  // True if 'window_' has been advanced to the left row at 'index_'.
+  bool windowReady_{false};
+
+  // The next row of 'window_' to join with the left row at 'index_'.
+  size_t windowCursor_{0};
+
   // True if all the right side data has been received.
   bool noMoreRightInput_{false};
 };
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/NdvSketch.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/hyperloglog/HllUtils.h"
+
+namespace facebook::velox::exec {
+
+NdvSketch::NdvSketch(RowTypePtr type, memory::MemoryPool* pool)
+    : type_(std::move(type)), allocator_(pool) {
+  const auto indexBitLength = common::hll::toIndexBitLength(
+      common::hll::kDefaultApproxDistinctStandardError);
+  hlls_.reserve(type_->size());
+  for (auto i = 0; i < type_->size(); ++i) {
+    hlls_.push_back(
+        std::make_unique<common::hll::DenseHll>(indexBitLength, &allocator_));
+  }
+}
+
+void NdvSketch::add(const RowVector& input) {
+  VELOX_CHECK_EQ(input.childrenSize(), hlls_.size());
+  for (auto i = 0; i < hlls_.size(); ++i) {
+    const auto* column = input.childAt(i)->loadedVector();
+    auto& hll = *hlls_[i];
+    for (vector_size_t row = 0; row < input.size(); ++row) {
+      if (!column->isNullAt(row)) {
+        // The HLL takes the leading bits of the hash for the bucket, so the
+        // value hashes, which are weak for integers, are mixed first.
+        hll.insertHash(folly::hash::twang_mix64(column->hashValueAt(row)));
+      }
+    }
+  }
+}
+
+void NdvSketch::merge(const NdvSketch& other) {
+  VELOX_CHECK(type_->equivalent(*other.type_));
+  for (auto i = 0; i < hlls_.size(); ++i) {
+    hlls_[i]->mergeWith(*other.hlls_[i]);
+  }
+}
+
+std::unordered_map<std::string, int64_t> NdvSketch::numDistinct() const {
+  std::unordered_map<std::string, int64_t> result;
+  for (auto i = 0; i < hlls_.size(); ++i) {
+    result[type_->nameOf(i)] = hlls_[i]->cardinality();
+  }
+  return result;
+}
+
+} // namespace facebook::velox::exec
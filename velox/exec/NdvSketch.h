@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Estimates the number of distinct values of each column of the vectors
+/// added to it with a HyperLogLog per column. Used for reporting the data at
+/// pipeline boundaries to an external optimizer; see
+/// TaskListener::onPipelineFinished(). Not thread safe.
+class NdvSketch {
+ public:
+  /// Allocates the sketches from 'pool', which must outlive 'this'.
+  NdvSketch(RowTypePtr type, memory::MemoryPool* pool);
+
+  /// Adds the non-null values of each column of 'input'. Loads lazy vectors.
+  void add(const RowVector& input);
+
+  /// Adds the values of 'other', which must be of the same type.
+  void merge(const NdvSketch& other);
+
+  /// Returns the estimated number of distinct non-null values by column name.
+  std::unordered_map<std::string, int64_t> numDistinct() const;
+
+ private:
+  const RowTypePtr type_;
+  HashStringAllocator allocator_;
+  std::vector<std::unique_ptr<common::hll::DenseHll>> hlls_;
+};
+
+} // namespace facebook::velox::exec
@@ -108,7 +108,38 @@ void NestedLoopJoinBuild::noMoreInput() {
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(mergeDataVectors(std::move(dataVectors_)));
+}
+
+std::vector<RowVectorPtr> NestedLoopJoinBuild::mergeDataVectors(
+    std::vector<RowVectorPtr> vectors) {
+  const auto maxBatchRows = outputBatchRows();
+  std::vector<RowVectorPtr> merged;
+  merged.reserve(vectors.size());
+  for (size_t i = 0; i < vectors.size();) {
+    vector_size_t numRows = vectors[i]->size();
+    auto end = i + 1;
+    while (end < vectors.size() &&
+           numRows + vectors[end]->size() <= maxBatchRows) {
+      numRows += vectors[end]->size();
+      ++end;
+    }
+    if (end == i + 1) {
+      merged.push_back(std::move(vectors[i]));
+    } else {
+      auto batch =
+          BaseVector::create<RowVector>(vectors[i]->type(), numRows, pool());
+      vector_size_t offset = 0;
+      for (auto j = i; j < end; ++j) {
+        batch->copy(vectors[j].get(), offset, 0, vectors[j]->size());
+        offset += vectors[j]->size();
+        vectors[j].reset();
+      }
+      merged.push_back(std::move(batch));
+    }
+    i = end;
+  }
+  return merged;
 }
 
 bool NestedLoopJoinBuild::isFinished() {
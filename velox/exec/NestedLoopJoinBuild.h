@@ -59,6 +59,12 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // Concatenates runs of consecutive small vectors of 'vectors' into vectors
+  // of up to outputBatchRows() rows. The probe side evaluates the join
+  // condition on the cross product of a probe batch with one build vector at a
+  // time, so a few large build vectors make for larger and fewer batches.
+  std::vector<RowVectorPtr> mergeDataVectors(std::vector<RowVectorPtr> vectors);
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
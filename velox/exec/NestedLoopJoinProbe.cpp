@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinProbe.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -42,6 +43,68 @@ std::vector<IdentityProjection> extractProjections(
   }
   return projections;
 }
+
+bool isIntegralKind(TypeKind kind) {
+  return kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+      kind == TypeKind::INTEGER || kind == TypeKind::BIGINT;
+}
+
+// Writes to 'buildRows' the rows of 'build' that are greater than 'value' if
+// 'kProbeLess' or less than 'value' otherwise. Returns the number of rows.
+template <typename T, bool kProbeLess>
+vector_size_t compareWithBuild(
+    T value,
+    const T* build,
+    vector_size_t numBuildRows,
+    vector_size_t* buildRows) {
+  constexpr int32_t kWidth = xsimd::batch<T>::size;
+  const auto values = xsimd::broadcast<T>(value);
+  vector_size_t numRows = 0;
+  vector_size_t row = 0;
+  for (; row + kWidth <= numBuildRows; row += kWidth) {
+    const auto data = xsimd::load_unaligned(build + row);
+    uint64_t bits;
+    if constexpr (kProbeLess) {
+      bits = simd::toBitMask(values < data);
+    } else {
+      bits = simd::toBitMask(data < values);
+    }
+    while (bits) {
+      buildRows[numRows++] = row + __builtin_ctzll(bits);
+      bits &= bits - 1;
+    }
+  }
+  for (; row < numBuildRows; ++row) {
+    if (kProbeLess ? value < build[row] : build[row] < value) {
+      buildRows[numRows++] = row;
+    }
+  }
+  return numRows;
+}
+
+template <typename T>
+vector_size_t compareProbeWithBuild(
+    const BaseVector& probe,
+    vector_size_t probeRow,
+    vector_size_t probeCnt,
+    const BaseVector& build,
+    bool probeLess,
+    vector_size_t* probeRows,
+    vector_size_t* buildRows) {
+  const auto* probeValues = probe.asUnchecked<FlatVector<T>>()->rawValues();
+  const auto* buildValues = build.asUnchecked<FlatVector<T>>()->rawValues();
+  vector_size_t numRows = 0;
+  for (auto i = probeRow; i < probeRow + probeCnt; ++i) {
+    const auto numMatches = probeLess
+        ? compareWithBuild<T, true>(
+              probeValues[i], buildValues, build.size(), buildRows + numRows)
+        : compareWithBuild<T, false>(
+              probeValues[i], buildValues, build.size(), buildRows + numRows);
+    std::fill(probeRows + numRows, probeRows + numRows + numMatches, i);
+    numRows += numMatches;
+  }
+  return numRows;
+}
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -129,6 +192,11 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   }
   input_ = std::move(input);
   VELOX_CHECK_EQ(buildIndex_, 0);
+  if (intervalCondition_.has_value()) {
+    IntervalJoinIndex::readValues(
+        *input_->childAt(intervalCondition_->probeChannel),
+        intervalProbeValues_);
+  }
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
@@ -178,8 +246,11 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
+    vector_size_t probeCnt = getNumProbeRows();
     output = doMatch(probeCnt);
+    if (intervalCondition_.has_value()) {
+      probeCnt = intervalNumProbeRows_;
+    }
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
         finishProbeInput();
@@ -230,6 +301,195 @@ void NestedLoopJoinProbe::initializeFilter(
   }
 
   filterInputType_ = ROW(std::move(names), std::move(types));
+  initializeLessThanCondition(probeType, buildType);
+  initializeIntervalCondition(probeType, buildType);
+}
+
+void NestedLoopJoinProbe::initializeIntervalCondition(
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  const auto& expr = joinCondition_->expr(0);
+  if (expr->vectorFunction() == nullptr ||
+      expr->vectorFunction()->getCanonicalName() !=
+          FunctionCanonicalName::kBetween) {
+    return;
+  }
+  VELOX_CHECK_EQ(expr->inputs().size(), 3);
+  std::vector<std::string> names;
+  for (const auto& input : expr->inputs()) {
+    const auto* field = dynamic_cast<const FieldReference*>(input.get());
+    if (field == nullptr || !field->inputs().empty() ||
+        !isIntegralKind(field->type()->kind())) {
+      return;
+    }
+    names.push_back(field->field());
+  }
+  auto probeChannel = probeType->getChildIdxIfExists(names[0]);
+  auto lowChannel = buildType->getChildIdxIfExists(names[1]);
+  auto highChannel = buildType->getChildIdxIfExists(names[2]);
+  if (probeChannel.has_value() && lowChannel.has_value() &&
+      highChannel.has_value()) {
+    intervalCondition_ = {
+        probeChannel.value(), lowChannel.value(), highChannel.value()};
+  }
+}
+
+vector_size_t NestedLoopJoinProbe::evalIntervalCondition(
+    vector_size_t probeCnt) {
+  if (intervalIndices_.empty()) {
+    intervalIndices_.resize(buildVectors_->size());
+  }
+  auto& index = intervalIndices_[buildIndex_];
+  if (index == nullptr) {
+    index = std::make_unique<IntervalJoinIndex>(
+        *buildVectors_.value()[buildIndex_],
+        intervalCondition_->lowChannel,
+        intervalCondition_->highChannel);
+  }
+  intervalProbeRows_.clear();
+  intervalBuildRows_.clear();
+  // Stops at 'outputBatchSize_' matches, possibly within the matches of a
+  // probe row. The next call resumes from that row and skips the matches of
+  // it that are already returned.
+  intervalNumProbeRows_ = probeCnt;
+  const auto skipMatches = std::exchange(intervalSkipMatches_, 0);
+  if (index->size() > 0) {
+    const auto& probe = input_->childAt(intervalCondition_->probeChannel);
+    for (auto row = probeRow_; row < probeRow_ + probeCnt; ++row) {
+      if (intervalProbeRows_.size() >= outputBatchSize_) {
+        intervalNumProbeRows_ = row - probeRow_;
+        break;
+      }
+      if (probe->isNullAt(row)) {
+        continue;
+      }
+      const auto skip = row == probeRow_ ? skipMatches : 0;
+      vector_size_t numRowMatches = 0;
+      const bool allMatched =
+          index->forEachMatch(intervalProbeValues_[row], [&](auto buildRow) {
+            if (intervalProbeRows_.size() >= outputBatchSize_) {
+              return false;
+            }
+            if (numRowMatches++ >= skip) {
+              intervalProbeRows_.push_back(row);
+              intervalBuildRows_.push_back(buildRow);
+            }
+            return true;
+          });
+      if (!allMatched) {
+        intervalNumProbeRows_ = row - probeRow_;
+        intervalSkipMatches_ = numRowMatches;
+        break;
+      }
+    }
+  }
+
+  const vector_size_t numOutputRows = intervalProbeRows_.size();
+  auto rawProbeOutMapping =
+      initializeRowNumberMapping(probeOutMapping_, numOutputRows, pool());
+  auto rawBuildOutMapping =
+      initializeRowNumberMapping(buildOutMapping_, numOutputRows, pool());
+  std::copy(
+      intervalProbeRows_.begin(),
+      intervalProbeRows_.end(),
+      rawProbeOutMapping.begin());
+  std::copy(
+      intervalBuildRows_.begin(),
+      intervalBuildRows_.end(),
+      rawBuildOutMapping.begin());
+  return numOutputRows;
+}
+
+void NestedLoopJoinProbe::initializeLessThanCondition(
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  const auto& expr = joinCondition_->expr(0);
+  if (expr->vectorFunction() == nullptr ||
+      expr->vectorFunction()->getCanonicalName() !=
+          FunctionCanonicalName::kLt) {
+    return;
+  }
+  VELOX_CHECK_EQ(expr->inputs().size(), 2);
+  const auto* left =
+      dynamic_cast<const FieldReference*>(expr->inputs()[0].get());
+  const auto* right =
+      dynamic_cast<const FieldReference*>(expr->inputs()[1].get());
+  if (left == nullptr || right == nullptr || !left->inputs().empty() ||
+      !right->inputs().empty()) {
+    return;
+  }
+  const auto kind = left->type()->kind();
+  if (kind != right->type()->kind() || !isIntegralKind(kind)) {
+    return;
+  }
+  auto leftProbe = probeType->getChildIdxIfExists(left->field());
+  auto rightBuild = buildType->getChildIdxIfExists(right->field());
+  if (leftProbe.has_value() && rightBuild.has_value()) {
+    lessThanCondition_ = {leftProbe.value(), rightBuild.value(), true};
+    return;
+  }
+  auto leftBuild = buildType->getChildIdxIfExists(left->field());
+  auto rightProbe = probeType->getChildIdxIfExists(right->field());
+  if (leftBuild.has_value() && rightProbe.has_value()) {
+    lessThanCondition_ = {rightProbe.value(), leftBuild.value(), false};
+  }
+}
+
+std::optional<vector_size_t> NestedLoopJoinProbe::evalLessThanCondition(
+    vector_size_t probeCnt) {
+  const auto& probe = input_->childAt(lessThanCondition_->probeChannel);
+  const auto& build = buildVectors_.value()[buildIndex_]->childAt(
+      lessThanCondition_->buildChannel);
+  if (!probe->isFlatEncoding() || !build->isFlatEncoding() ||
+      probe->mayHaveNulls() || build->mayHaveNulls()) {
+    return std::nullopt;
+  }
+
+  const vector_size_t maxOutputRows = probeCnt * build->size();
+  auto rawProbeOutMapping =
+      initializeRowNumberMapping(probeOutMapping_, maxOutputRows, pool());
+  auto rawBuildOutMapping =
+      initializeRowNumberMapping(buildOutMapping_, maxOutputRows, pool());
+  switch (probe->typeKind()) {
+    case TypeKind::TINYINT:
+      return compareProbeWithBuild<int8_t>(
+          *probe,
+          probeRow_,
+          probeCnt,
+          *build,
+          lessThanCondition_->probeLess,
+          rawProbeOutMapping.data(),
+          rawBuildOutMapping.data());
+    case TypeKind::SMALLINT:
+      return compareProbeWithBuild<int16_t>(
+          *probe,
+          probeRow_,
+          probeCnt,
+          *build,
+          lessThanCondition_->probeLess,
+          rawProbeOutMapping.data(),
+          rawBuildOutMapping.data());
+    case TypeKind::INTEGER:
+      return compareProbeWithBuild<int32_t>(
+          *probe,
+          probeRow_,
+          probeCnt,
+          *build,
+          lessThanCondition_->probeLess,
+          rawProbeOutMapping.data(),
+          rawBuildOutMapping.data());
+    case TypeKind::BIGINT:
+      return compareProbeWithBuild<int64_t>(
+          *probe,
+          probeRow_,
+          probeCnt,
+          *build,
+          lessThanCondition_->probeLess,
+          rawProbeOutMapping.data(),
+          rawBuildOutMapping.data());
+    default:
+      VELOX_UNREACHABLE();
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getMismatchedOutput(
@@ -346,6 +606,12 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK(!hasProbedAllBuildData());
 
   const auto inputSize = input_->size();
+  if (intervalCondition_.has_value()) {
+    // The index finds the matches without making the cross product, so the
+    // rest of the rows are matched with a build vector at once.
+    // evalIntervalCondition() may stop early to bound the output size.
+    return inputSize - probeRow_;
+  }
   auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
   vector_size_t numProbeRows;
   if (numBuildRows > outputBatchSize_) {
@@ -431,40 +697,17 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
         probeCnt, outputType_, identityProjections_, buildProjections_);
   }
 
-  auto filterInput = getCrossProduct(
-      probeCnt,
-      filterInputType_,
-      filterProbeProjections_,
-      filterBuildProjections_);
-
-  if (filterInputRows_.size() != filterInput->size()) {
-    filterInputRows_.resizeFill(filterInput->size(), true);
-  }
-  VELOX_CHECK(filterInputRows_.isAllSelected());
-
-  std::vector<VectorPtr> filterResult;
-  EvalCtx evalCtx(
-      operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
-  joinCondition_->eval(0, 1, true, filterInputRows_, evalCtx, filterResult);
-  DecodedVector decodedFilterResult;
-  decodedFilterResult.decode(*filterResult[0], filterInputRows_);
-
-  const vector_size_t maxOutputRows = decodedFilterResult.size();
-  auto rawProbeOutMapping =
-      initializeRowNumberMapping(probeOutMapping_, maxOutputRows, pool());
-  auto rawBuildOutMapping =
-      initializeRowNumberMapping(buildOutMapping_, maxOutputRows, pool());
-  auto* probeIndices = probeIndices_->asMutable<vector_size_t>();
-  auto* buildIndices = buildIndices_->asMutable<vector_size_t>();
-  int32_t numOutputRows{0};
-  for (auto i = 0; i < maxOutputRows; ++i) {
-    if (!decodedFilterResult.isNullAt(i) &&
-        decodedFilterResult.valueAt<bool>(i)) {
-      rawProbeOutMapping[numOutputRows] = probeIndices[i];
-      rawBuildOutMapping[numOutputRows] = buildIndices[i];
-      ++numOutputRows;
-    }
+  std::optional<vector_size_t> numMatches;
+  if (intervalCondition_.has_value()) {
+    numMatches = evalIntervalCondition(probeCnt);
+  } else if (lessThanCondition_.has_value()) {
+    numMatches = evalLessThanCondition(probeCnt);
   }
+  const vector_size_t numOutputRows = numMatches.has_value()
+      ? numMatches.value()
+      : evalJoinCondition(probeCnt);
+  auto* rawProbeOutMapping = probeOutMapping_->asMutable<vector_size_t>();
+  auto* rawBuildOutMapping = buildOutMapping_->asMutable<vector_size_t>();
   if (needsProbeMismatch(joinType_)) {
     for (auto i = 0; i < numOutputRows; ++i) {
       probeMatched_.setValid(rawProbeOutMapping[i], true);
@@ -503,4 +746,42 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       std::move(projectedChildren));
 }
 
+vector_size_t NestedLoopJoinProbe::evalJoinCondition(vector_size_t probeCnt) {
+  auto filterInput = getCrossProduct(
+      probeCnt,
+      filterInputType_,
+      filterProbeProjections_,
+      filterBuildProjections_);
+
+  if (filterInputRows_.size() != filterInput->size()) {
+    filterInputRows_.resizeFill(filterInput->size(), true);
+  }
+  VELOX_CHECK(filterInputRows_.isAllSelected());
+
+  std::vector<VectorPtr> filterResult;
+  EvalCtx evalCtx(
+      operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
+  joinCondition_->eval(0, 1, true, filterInputRows_, evalCtx, filterResult);
+  DecodedVector decodedFilterResult;
+  decodedFilterResult.decode(*filterResult[0], filterInputRows_);
+
+  const vector_size_t maxOutputRows = decodedFilterResult.size();
+  auto rawProbeOutMapping =
+      initializeRowNumberMapping(probeOutMapping_, maxOutputRows, pool());
+  auto rawBuildOutMapping =
+      initializeRowNumberMapping(buildOutMapping_, maxOutputRows, pool());
+  auto* probeIndices = probeIndices_->asMutable<vector_size_t>();
+  auto* buildIndices = buildIndices_->asMutable<vector_size_t>();
+  int32_t numOutputRows{0};
+  for (auto i = 0; i < maxOutputRows; ++i) {
+    if (!decodedFilterResult.isNullAt(i) &&
+        decodedFilterResult.valueAt<bool>(i)) {
+      rawProbeOutMapping[numOutputRows] = probeIndices[i];
+      rawBuildOutMapping[numOutputRows] = buildIndices[i];
+      ++numOutputRows;
+    }
+  }
+  return numOutputRows;
+}
+
 } // namespace facebook::velox::exec
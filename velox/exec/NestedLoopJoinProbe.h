@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/exec/IntervalJoinIndex.h"
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
@@ -82,6 +83,35 @@ class NestedLoopJoinProbe : public Operator {
   // buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
+  // Evaluates 'joinCondition_' on the cross product of the next 'probeCnt'
+  // rows of 'input_' and the build vector at 'buildIndex_'. Sets
+  // 'probeOutMapping_' and 'buildOutMapping_' to the matching pairs of rows
+  // and returns their number.
+  vector_size_t evalJoinCondition(vector_size_t probeCnt);
+
+  // Sets 'lessThanCondition_' if 'joinCondition_' compares an integer column
+  // of the probe side with one of the build side.
+  void initializeLessThanCondition(
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Same as evalJoinCondition() for a 'lessThanCondition_'. Compares each
+  // probe row with the build column using SIMD without making the cross
+  // product. Returns std::nullopt if the columns are not flat or have nulls.
+  std::optional<vector_size_t> evalLessThanCondition(vector_size_t probeCnt);
+
+  // Sets 'intervalCondition_' if 'joinCondition_' is an integer probe column
+  // BETWEEN two build columns.
+  void initializeIntervalCondition(
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Same as evalJoinCondition() for an 'intervalCondition_'. Looks up each
+  // probe row in the IntervalJoinIndex of the build vector. Returns at most
+  // 'outputBatchSize_' matches and sets 'intervalNumProbeRows_' and
+  // 'intervalSkipMatches_' to where the next call resumes.
+  vector_size_t evalIntervalCondition(vector_size_t probeCnt);
+
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
   // Returns true if 'buildIndex_' points to the end of 'buildData_'.
   bool advanceProbeRows(vector_size_t probeCnt);
@@ -134,6 +164,36 @@ class NestedLoopJoinProbe : public Operator {
   RowTypePtr filterInputType_;
   SelectivityVector filterInputRows_;
 
+  // A join condition of the form probe < build or build < probe.
+  struct LessThanCondition {
+    column_index_t probeChannel;
+    column_index_t buildChannel;
+    // True for probe < build.
+    bool probeLess;
+  };
+  std::optional<LessThanCondition> lessThanCondition_;
+
+  // A join condition of the form probe BETWEEN build low AND build high.
+  struct IntervalCondition {
+    column_index_t probeChannel;
+    column_index_t lowChannel;
+    column_index_t highChannel;
+  };
+  std::optional<IntervalCondition> intervalCondition_;
+  // The index of each of 'buildVectors_' for 'intervalCondition_'. Made on
+  // first use.
+  std::vector<std::unique_ptr<IntervalJoinIndex>> intervalIndices_;
+  // Values of the probe column of 'intervalCondition_' for 'input_'.
+  std::vector<int64_t> intervalProbeValues_;
+  std::vector<vector_size_t> intervalProbeRows_;
+  std::vector<vector_size_t> intervalBuildRows_;
+  // The number of probe rows whose matches the last evalIntervalCondition()
+  // returned in full.
+  vector_size_t intervalNumProbeRows_{0};
+  // The number of matches of the probe row at 'probeRow_' that were returned
+  // by the last evalIntervalCondition().
+  vector_size_t intervalSkipMatches_{0};
+
   // Probe side state
   // Input row to process on next call to getOutput().
   vector_size_t probeRow_{0};
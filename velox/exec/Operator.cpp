@@ -289,6 +289,81 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recordAllocationSiteStats() {
+  if (!pool()->trackAllocationSites()) {
+    return;
+  }
+  const auto allocationSiteStats = pool()->allocationSiteStats();
+  auto lockedStats = stats_.wlock();
+  for (int32_t i = 0; i < memory::kNumMemoryAllocationSites; ++i) {
+    const auto& siteStats = allocationSiteStats[i];
+    if (siteStats.numAllocs == 0) {
+      continue;
+    }
+    const auto siteName = memory::memoryAllocationSiteName(
+        static_cast<memory::MemoryAllocationSite>(i));
+    lockedStats->addRuntimeStat(
+        fmt::format("{}PeakBytes", siteName),
+        RuntimeCounter(siteStats.peakBytes, RuntimeCounter::Unit::kBytes));
+    lockedStats->addRuntimeStat(
+        fmt::format("{}NumAllocs", siteName),
+        RuntimeCounter(siteStats.numAllocs));
+    for (size_t bucket = 0; bucket < siteStats.sizeHistogram.size();
+         ++bucket) {
+      if (siteStats.sizeHistogram[bucket] == 0) {
+        continue;
+      }
+      lockedStats->addRuntimeStat(
+          fmt::format(
+              "{}Allocs{}",
+              siteName,
+              memory::MemoryPool::allocationSizeBucketName(bucket)),
+          RuntimeCounter(siteStats.sizeHistogram[bucket]));
+    }
+  }
+}
+
+BlockingReason Operator::reserveMemoryAsync(
+    uint64_t bytes,
+    ContinueFuture* future) {
+  auto* executor = memory::memoryManager()->arbitrationExecutor();
+  if (executor == nullptr || bytes == 0 ||
+      static_cast<uint64_t>(pool()->availableReservation()) >= bytes) {
+    return BlockingReason::kNotBlocked;
+  }
+  auto [promise, reserveFuture] = makeVeloxContinuePromiseContract(
+      fmt::format("Operator::reserveMemoryAsync {}", pool()->name()));
+  // Holds the task and memory pool references as the task might be terminated
+  // and the operator closed while the reservation is running.
+  executor->add([task = operatorCtx_->task(),
+                 pool = pool()->shared_from_this(),
+                 bytes,
+                 promise = std::move(promise)]() mutable {
+    try {
+      if (!pool->maybeReserve(bytes)) {
+        LOG(WARNING) << "Failed to reserve " << succinctBytes(bytes)
+                     << " for memory pool " << pool->name()
+                     << ", usage: " << succinctBytes(pool->currentBytes())
+                     << ", reservation: "
+                     << succinctBytes(pool->reservedBytes());
+      }
+    } catch (const std::exception& e) {
+      // The memory pool has been aborted. The driver fails the task when it
+      // resumes.
+      LOG(WARNING) << "Asynchronous memory reservation for " << pool->name()
+                   << " failed: " << e.what();
+    }
+    // Releases the reservation if the operator has been closed by the task
+    // termination while the reservation was running.
+    if (!task->isRunning()) {
+      pool->release();
+    }
+    promise.setValue();
+  });
+  *future = std::move(reserveFuture);
+  return BlockingReason::kWaitForMemory;
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -297,6 +372,10 @@ void Operator::recordSpillStats() {
   lockedStats->spilledRows += lockedSpillStats->spilledRows;
   lockedStats->spilledPartitions += lockedSpillStats->spilledPartitions;
   lockedStats->spilledFiles += lockedSpillStats->spilledFiles;
+  if (lockedSpillStats->spilledBytes != 0 && operatorCtx_->task() != nullptr) {
+    operatorCtx_->task()->addSpilledBytes(
+        planNodeId(), lockedSpillStats->spilledBytes);
+  }
   if (lockedSpillStats->spillFillTimeUs != 0) {
     lockedStats->addRuntimeStat(
         kSpillFillTime,
@@ -394,6 +473,20 @@ void Operator::recordSpillStats() {
                 Timestamp::kNanosecondsInMicrosecond,
             RuntimeCounter::Unit::kNanos});
   }
+
+  if (lockedSpillStats->spillPrefetchHits != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillPrefetchHits,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillPrefetchHits)});
+  }
+
+  if (lockedSpillStats->spillPrefetchMisses != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillPrefetchMisses,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillPrefetchMisses)});
+  }
   lockedSpillStats->reset();
 }
 
@@ -468,11 +561,13 @@ void OperatorStats::add(const OperatorStats& other) {
   rawInputPositions += other.rawInputPositions;
 
   addInputTiming.add(other.addInputTiming);
+  addInputCounters.add(other.addInputCounters);
   inputBytes += other.inputBytes;
   inputPositions += other.inputPositions;
   inputVectors += other.inputVectors;
 
   getOutputTiming.add(other.getOutputTiming);
+  getOutputCounters.add(other.getOutputCounters);
   outputBytes += other.outputBytes;
   outputPositions += other.outputPositions;
   outputVectors += other.outputVectors;
@@ -495,6 +590,8 @@ void OperatorStats::add(const OperatorStats& other) {
     }
   }
 
+  addExprProfiles(exprProfiles, other.exprProfiles);
+
   numDrivers += other.numDrivers;
   spilledInputBytes += other.spilledInputBytes;
   spilledBytes += other.spilledBytes;
@@ -513,10 +610,12 @@ void OperatorStats::clear() {
   rawInputPositions = 0;
 
   addInputTiming.clear();
+  addInputCounters.clear();
   inputBytes = 0;
   inputPositions = 0;
 
   getOutputTiming.clear();
+  getOutputCounters.clear();
   outputBytes = 0;
   outputPositions = 0;
 
@@ -531,6 +630,7 @@ void OperatorStats::clear() {
   memoryStats.clear();
 
   runtimeStats.clear();
+  exprProfiles.clear();
 
   numDrivers = 0;
   spilledInputBytes = 0;
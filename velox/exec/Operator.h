@@ -21,6 +21,7 @@
 #include "velox/exec/Driver.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Spiller.h"
+#include "velox/expression/ExprStats.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
@@ -122,6 +123,10 @@ struct OperatorStats {
 
   CpuWallTiming addInputTiming;
 
+  /// Hardware counts of addInput calls. Populated only if
+  /// QueryConfig::kOperatorTrackHardwareCounters is true.
+  process::HardwareCounters addInputCounters;
+
   /// Bytes of input in terms of retained size of input vectors.
   uint64_t inputBytes = 0;
   uint64_t inputPositions = 0;
@@ -135,6 +140,9 @@ struct OperatorStats {
 
   CpuWallTiming getOutputTiming;
 
+  /// Hardware counts of getOutput calls. See 'addInputCounters'.
+  process::HardwareCounters getOutputCounters;
+
   /// Bytes of output in terms of retained size of vectors.
   uint64_t outputBytes = 0;
   uint64_t outputPositions = 0;
@@ -182,6 +190,11 @@ struct OperatorStats {
 
   std::unordered_map<std::string, RuntimeMetric> runtimeStats;
 
+  /// Per-node statistics of the expressions evaluated by the operator, one
+  /// tree per expression. Populated only if
+  /// QueryConfig::kExprProfileEnabled is true.
+  std::vector<ExprProfile> exprProfiles;
+
   int numDrivers = 0;
 
   OperatorStats() = default;
@@ -347,6 +360,8 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillReadTime{"spillReadWallNanos"};
   static inline const std::string kSpillDeserializationTime{
       "spillDeserializationWallNanos"};
+  static inline const std::string kSpillPrefetchHits{"spillPrefetchHits"};
+  static inline const std::string kSpillPrefetchMisses{"spillPrefetchMisses"};
 
   /// 'operatorId' is the initial index of the 'this' in the Driver's list of
   /// Operators. This is used as in index into OperatorStats arrays in the Task.
@@ -465,10 +480,18 @@ class Operator : public BaseRuntimeStatWriter {
     input_ = nullptr;
     results_.clear();
     recordSpillStats();
+    recordAllocationSiteStats();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
 
+  /// Returns true if Drivers of other pipelines wait for 'this' to produce
+  /// its result, e.g. a join build with waiting probes. Such a sink puts its
+  /// Driver on the critical path, see Driver::enqueue().
+  virtual bool hasWaitingConsumers() const {
+    return false;
+  }
+
   // Returns true if 'this' never has more output rows than input rows.
   virtual bool isFilter() const {
     return false;
@@ -718,6 +741,18 @@ class Operator : public BaseRuntimeStatWriter {
     return spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   }
 
+  /// Invoked by isBlocked() to reserve 'bytes' of memory in this operator's
+  /// memory pool without blocking the driver thread on memory arbitration. The
+  /// reservation runs on the memory manager's arbitration executor. The
+  /// function sets 'future' to be fulfilled when it finishes and returns
+  /// kWaitForMemory. The function returns kNotBlocked without reserving if the
+  /// pool already has 'bytes' of available reservation or there is no
+  /// arbitration executor, in which case the operator reserves synchronously.
+  ///
+  /// NOTE: the reservation might fail, so the operator still needs to handle
+  /// the memory pool running out of reservation after it resumes.
+  BlockingReason reserveMemoryAsync(uint64_t bytes, ContinueFuture* future);
+
   /// Creates output vector from 'input_' and 'results' according to
   /// 'identityProjections_' and 'resultProjections_'. If 'mapping' is set to
   /// nullptr, the children of the output vector will be identical to their
@@ -745,6 +780,10 @@ class Operator : public BaseRuntimeStatWriter {
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
+  /// Invoked to record the memory usage by allocation site in operator stats
+  /// if the operator's memory pool tracks allocation sites.
+  void recordAllocationSiteStats();
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -66,7 +66,9 @@ OrderBy::OrderBy(
       pool(),
       &nonReclaimableSection_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      operatorCtx_->task()->queryCtx()->executor(),
+      driverCtx->queryConfig().orderByParallelSortMinRows());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Task.h"
 
@@ -80,6 +81,101 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+BroadcastBuffer::~BroadcastBuffer() {
+  if (spillFile_ == nullptr) {
+    return;
+  }
+  readFile_.reset();
+  try {
+    spillFile_->close();
+    filesystems::getFileSystem(spillPath_, nullptr)->remove(spillPath_);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to remove broadcast spill file " << spillPath_
+                 << ": " << e.what();
+  }
+}
+
+void BroadcastBuffer::enqueue(std::shared_ptr<SerializedPage> page) {
+  VELOX_CHECK_NOT_NULL(page, "Unexpected null page");
+  VELOX_CHECK(!noMoreData_, "Broadcast buffer has set no more data marker");
+  const auto size = page->size();
+  const auto numRows = page->numRows().value();
+  pages_.push_back({std::move(page), static_cast<int64_t>(size), numRows});
+}
+
+std::shared_ptr<SerializedPage> BroadcastBuffer::page(int64_t index) {
+  VELOX_CHECK_LT(index, pages_.size());
+  auto& entry = pages_[index];
+  if (entry.page != nullptr) {
+    return entry.page;
+  }
+  VELOX_CHECK_GE(entry.spillOffset, 0);
+  if (readFileSize_ < entry.spillOffset + entry.size) {
+    spillFile_->flush();
+    readFile_ = filesystems::getFileSystem(spillPath_, nullptr)
+                    ->openFileForRead(spillPath_);
+    readFileSize_ = readFile_->size();
+    VELOX_CHECK_GE(readFileSize_, entry.spillOffset + entry.size);
+  }
+  auto iobuf = folly::IOBuf::create(entry.size);
+  readFile_->pread(entry.spillOffset, entry.size, iobuf->writableData());
+  iobuf->append(entry.size);
+  entry.page = std::make_shared<SerializedPage>(
+      std::move(iobuf), nullptr, entry.numRows);
+  ++reloadedPages_;
+  reloadedBytes_ += entry.size;
+  return entry.page;
+}
+
+void BroadcastBuffer::getAvailablePageSizes(
+    int64_t index,
+    std::vector<int64_t>& out) const {
+  out.reserve(out.size() + pages_.size() - index);
+  for (auto i = index; i < pages_.size(); ++i) {
+    out.push_back(pages_[i].size);
+  }
+}
+
+std::vector<std::shared_ptr<SerializedPage>> BroadcastBuffer::spill() {
+  VELOX_CHECK(canSpill());
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  for (auto& entry : pages_) {
+    if (entry.page == nullptr || !entry.page.unique()) {
+      continue;
+    }
+    if (entry.spillOffset < 0) {
+      if (spillFile_ == nullptr) {
+        spillPath_ = spillPathFn_();
+        spillFile_ = filesystems::getFileSystem(spillPath_, nullptr)
+                         ->openFileForWrite(spillPath_);
+      }
+      entry.spillOffset = spillFile_->size();
+      spillFile_->append(entry.page->getIOBuf());
+    }
+    spilled.push_back(std::move(entry.page));
+  }
+  return spilled;
+}
+
+std::vector<std::shared_ptr<SerializedPage>> BroadcastBuffer::clear() {
+  std::vector<std::shared_ptr<SerializedPage>> pages;
+  for (auto& entry : pages_) {
+    if (entry.page != nullptr) {
+      pages.push_back(std::move(entry.page));
+    }
+  }
+  pages_.clear();
+  return pages;
+}
+
+std::string BroadcastBuffer::toString() const {
+  return fmt::format(
+      "[BROADCAST_BUFFER PAGES[{}] SPILLED BYTES[{}] NO MORE DATA[{}]]",
+      pages_.size(),
+      spilledBytes(),
+      noMoreData_);
+}
+
 void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
@@ -112,12 +208,16 @@ DestinationBuffer::Data DestinationBuffer::getData(
     int64_t sequence,
     DataAvailableCallback notify,
     DataConsumerActiveCheckCallback activeCheck,
-    ArbitraryBuffer* arbitraryBuffer) {
+    ArbitraryBuffer* arbitraryBuffer,
+    BroadcastBuffer* broadcastBuffer) {
   VELOX_CHECK_GE(
       sequence, sequence_, "Get received for an already acknowledged item");
   if (arbitraryBuffer != nullptr) {
     loadData(arbitraryBuffer, maxBytes);
   }
+  if (replaying_ && broadcastBuffer != nullptr) {
+    loadData(broadcastBuffer, maxBytes);
+  }
 
   if (sequence - sequence_ >= data_.size()) {
     if (sequence - sequence_ > data_.size()) {
@@ -130,6 +230,9 @@ DestinationBuffer::Data DestinationBuffer::getData(
       if (arbitraryBuffer) {
         arbitraryBuffer->getAvailablePageSizes(remainingBytes);
       }
+      if (replaying_ && broadcastBuffer) {
+        broadcastBuffer->getAvailablePageSizes(replayIndex_, remainingBytes);
+      }
       if (!remainingBytes.empty()) {
         return {{}, std::move(remainingBytes), true};
       }
@@ -178,6 +281,9 @@ DestinationBuffer::Data DestinationBuffer::getData(
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
   }
+  if (replaying_ && broadcastBuffer) {
+    broadcastBuffer->getAvailablePageSizes(replayIndex_, remainingBytes);
+  }
   if (data.empty() && remainingBytes.empty() && atEnd) {
     data.push_back(nullptr);
   }
@@ -244,6 +350,34 @@ void DestinationBuffer::loadData(ArbitraryBuffer* buffer, uint64_t maxBytes) {
   }
 }
 
+void DestinationBuffer::maybeLoadData(BroadcastBuffer* buffer) {
+  VELOX_CHECK(replaying_);
+  if (notify_ == nullptr) {
+    return;
+  }
+  loadData(buffer, notifyMaxBytes_);
+}
+
+void DestinationBuffer::loadData(BroadcastBuffer* buffer, uint64_t maxBytes) {
+  uint64_t loadedBytes = 0;
+  while (replaying_) {
+    if (replayIndex_ == buffer->numPages()) {
+      // Caught up. The next pages are enqueued directly.
+      replaying_ = false;
+      if (buffer->hasNoMoreData()) {
+        enqueue(nullptr);
+      }
+      break;
+    }
+    if (loadedBytes >= maxBytes) {
+      break;
+    }
+    auto page = buffer->page(replayIndex_++);
+    loadedBytes += page->size();
+    enqueue(std::move(page));
+  }
+}
+
 std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
     int64_t sequence,
     bool fromGetData) {
@@ -321,6 +455,20 @@ void releaseAfterAcknowledge(
   }
 }
 
+// Returns the function that makes the spill file path of the broadcast buffer
+// of 'task' or null if the broadcast buffer can't spill.
+std::function<std::string()> broadcastSpillPathFn(Task& task) {
+  const auto& config = task.queryCtx()->queryConfig();
+  if (!config.spillEnabled() || !config.broadcastOutputBufferSpillEnabled() ||
+      task.spillDirectory().empty()) {
+    return nullptr;
+  }
+  return [&task]() {
+    return fmt::format(
+        "{}/broadcast_output_buffer", task.getOrCreateSpillDirectory());
+  };
+}
+
 } // namespace
 
 OutputBuffer::OutputBuffer(
@@ -334,6 +482,10 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      broadcastBuffer_(
+          isBroadcast()
+              ? std::make_unique<BroadcastBuffer>(broadcastSpillPathFn(*task_))
+              : nullptr),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -350,6 +502,7 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
     return;
   }
 
+  std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   bool isFinished;
   {
@@ -365,10 +518,11 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
 
     noMoreBuffers_ = true;
     isFinished = isFinishedLocked();
-    updateAfterAcknowledgeLocked(dataToBroadcast_, promises);
+    updateBroadcastBufferLocked(freed);
+    updateAfterAcknowledgeLocked(freed, promises);
   }
 
-  releaseAfterAcknowledge(dataToBroadcast_, promises);
+  releaseAfterAcknowledge(freed, promises);
   if (isFinished) {
     task_->setAllOutputConsumed();
   }
@@ -396,10 +550,9 @@ void OutputBuffer::addOutputBuffersLocked(int numBuffers) {
   for (int32_t i = buffers_.size(); i < numBuffers; ++i) {
     auto buffer = std::make_unique<DestinationBuffer>();
     if (isBroadcast()) {
-      for (const auto& data : dataToBroadcast_) {
-        buffer->enqueue(data);
-      }
-      if (atEnd_) {
+      if (broadcastBuffer_->numPages() > 0) {
+        buffer->startReplay();
+      } else if (atEnd_) {
         buffer->enqueue(nullptr);
       }
     }
@@ -408,6 +561,36 @@ void OutputBuffer::addOutputBuffersLocked(int numBuffers) {
   finishedBufferStats_.resize(numBuffers);
 }
 
+bool OutputBuffer::hasReplayingBuffersLocked() const {
+  for (const auto& buffer : buffers_) {
+    if (buffer != nullptr && buffer->isReplaying()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void OutputBuffer::updateBroadcastBufferLocked(
+    std::vector<std::shared_ptr<SerializedPage>>& freed) {
+  if (broadcastBuffer_ == nullptr) {
+    return;
+  }
+  const auto [reloadedPages, reloadedBytes] = broadcastBuffer_->takeReloaded();
+  if (reloadedPages > 0) {
+    updateTotalBufferedBytesMsLocked();
+    bufferedBytes_ += reloadedBytes;
+    bufferedPages_ += reloadedPages;
+  }
+  if (noMoreBuffers_ && broadcastBuffer_->numPages() > 0 &&
+      !hasReplayingBuffersLocked()) {
+    auto pages = broadcastBuffer_->clear();
+    freed.insert(
+        freed.end(),
+        std::make_move_iterator(pages.begin()),
+        std::make_move_iterator(pages.end()));
+  }
+}
+
 void OutputBuffer::updateStatsWithEnqueuedPageLocked(
     int64_t pageBytes,
     int64_t pageRows) {
@@ -450,6 +633,8 @@ bool OutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -474,6 +659,19 @@ bool OutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
+    if (isBroadcast()) {
+      updateBroadcastBufferLocked(freed);
+      if (bufferedBytes_ > maxSize_ && broadcastBuffer_->canSpill()) {
+        // Spill the pages kept only for the destinations to come.
+        auto spilled = broadcastBuffer_->spill();
+        freed.insert(
+            freed.end(),
+            std::make_move_iterator(spilled.begin()),
+            std::make_move_iterator(spilled.end()));
+      }
+      updateAfterAcknowledgeLocked(freed, promises);
+    }
+
     if (bufferedBytes_ > maxSize_ && future) {
       promises_.emplace_back("OutputBuffer::enqueue");
       *future = promises_.back().getSemiFuture();
@@ -485,6 +683,7 @@ bool OutputBuffer::enqueue(
   for (auto& callback : dataAvailableCallbacks) {
     callback.notify();
   }
+  releaseAfterAcknowledge(freed, promises);
 
   return blocked;
 }
@@ -497,17 +696,21 @@ void OutputBuffer::enqueueBroadcastOutputLocked(
   VELOX_DCHECK(dataAvailableCbs.empty());
 
   std::shared_ptr<SerializedPage> sharedData(data.release());
+  // NOTE: we don't need to add new buffer to 'broadcastBuffer_' if there is no
+  // more output buffers and all of them have caught up.
+  if (!noMoreBuffers_ || hasReplayingBuffersLocked()) {
+    broadcastBuffer_->enqueue(sharedData);
+  }
   for (auto& buffer : buffers_) {
-    if (buffer != nullptr) {
+    if (buffer == nullptr) {
+      continue;
+    }
+    if (buffer->isReplaying()) {
+      buffer->maybeLoadData(broadcastBuffer_.get());
+    } else {
       buffer->enqueue(sharedData);
-      dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
     }
-  }
-
-  // NOTE: we don't need to add new buffer to 'dataToBroadcast_' if there is no
-  // more output buffers.
-  if (!noMoreBuffers_) {
-    dataToBroadcast_.emplace_back(sharedData);
+    dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
   }
 }
 
@@ -569,6 +772,8 @@ void OutputBuffer::noMoreDrivers() {
 
 void OutputBuffer::checkIfDone(bool oneDriverFinished) {
   std::vector<DataAvailable> finished;
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     if (oneDriverFinished) {
@@ -591,12 +796,22 @@ void OutputBuffer::checkIfDone(bool oneDriverFinished) {
         }
       }
     } else {
+      if (isBroadcast()) {
+        broadcastBuffer_->noMoreData();
+      }
       for (auto& buffer : buffers_) {
-        if (buffer != nullptr) {
+        if (buffer == nullptr) {
+          continue;
+        }
+        if (buffer->isReplaying()) {
+          buffer->maybeLoadData(broadcastBuffer_.get());
+        } else {
           buffer->enqueue(nullptr);
-          finished.push_back(buffer->getAndClearNotify());
         }
+        finished.push_back(buffer->getAndClearNotify());
       }
+      updateBroadcastBufferLocked(freed);
+      updateAfterAcknowledgeLocked(freed, promises);
     }
   }
 
@@ -604,6 +819,7 @@ void OutputBuffer::checkIfDone(bool oneDriverFinished) {
   for (auto& notification : finished) {
     notification.notify();
   }
+  releaseAfterAcknowledge(freed, promises);
 }
 
 bool OutputBuffer::isFinished() {
@@ -688,6 +904,7 @@ bool OutputBuffer::deleteResults(int destination) {
     buffers_[destination] = nullptr;
     ++numFinalAcknowledges_;
     isFinished = isFinishedLocked();
+    updateBroadcastBufferLocked(freed);
     updateAfterAcknowledgeLocked(freed, promises);
   }
 
@@ -725,9 +942,15 @@ void OutputBuffer::getData(
     auto* buffer = buffers_[destination].get();
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
-      updateAfterAcknowledgeLocked(freed, promises);
       data = buffer->getData(
-          maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+          maxBytes,
+          sequence,
+          notify,
+          activeCheck,
+          arbitraryBuffer_.get(),
+          broadcastBuffer_.get());
+      updateBroadcastBufferLocked(freed);
+      updateAfterAcknowledgeLocked(freed, promises);
     } else {
       data.data.emplace_back(nullptr);
       data.immediate = true;
@@ -772,6 +995,9 @@ std::string OutputBuffer::toStringLocked() const {
   if (isArbitrary()) {
     out << arbitraryBuffer_->toString();
   }
+  if (isBroadcast()) {
+    out << broadcastBuffer_->toString();
+  }
   out << "]" << std::endl;
   return out.str();
 }
@@ -784,6 +1010,17 @@ bool OutputBuffer::isOverutilized() const {
   return (bufferedBytes_ > (0.5 * maxSize_)) || atEnd_;
 }
 
+int64_t OutputBuffer::bufferedPages(int destination) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!isPartitioned()) {
+    return bufferedPages_;
+  }
+  if (destination >= buffers_.size() || buffers_[destination] == nullptr) {
+    return 0;
+  }
+  return buffers_[destination]->stats().pagesBuffered;
+}
+
 int64_t OutputBuffer::getAverageBufferTimeMsLocked() const {
   if (numOutputBytes_ > 0) {
     return totalBufferedBytesMs_ / numOutputBytes_;
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/file/File.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
@@ -90,6 +91,96 @@ class ArbitraryBuffer {
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
+/// The log of pages enqueued to a broadcast output buffer. It is kept while
+/// destinations may still be added and until all the destinations that joined
+/// late have caught up. A destination that joins after pages have been
+/// enqueued replays the log through its own cursor before it receives pages
+/// directly.
+///
+/// Pages held only by the log, i.e. fetched and acknowledged by all current
+/// destinations, can be spilled to a local file. They are read back when a
+/// late destination replays them.
+///
+/// NOTE: there is only one broadcast buffer per broadcast output buffer. Also,
+/// this class is not thread-safe.
+class BroadcastBuffer {
+ public:
+  /// @param spillPathFn Returns the path of the spill file. Null if the
+  /// buffer can't spill.
+  explicit BroadcastBuffer(std::function<std::string()> spillPathFn = nullptr)
+      : spillPathFn_(std::move(spillPathFn)) {}
+
+  ~BroadcastBuffer();
+
+  int64_t numPages() const {
+    return pages_.size();
+  }
+
+  bool canSpill() const {
+    return spillPathFn_ != nullptr;
+  }
+
+  /// Returns true if no more pages will be enqueued.
+  bool hasNoMoreData() const {
+    return noMoreData_;
+  }
+
+  void noMoreData() {
+    noMoreData_ = true;
+  }
+
+  void enqueue(std::shared_ptr<SerializedPage> page);
+
+  /// Returns the page at 'index'. A spilled page is read back and kept in
+  /// memory until the next spill().
+  std::shared_ptr<SerializedPage> page(int64_t index);
+
+  /// Appends the sizes of the pages from 'index' on to 'out'.
+  void getAvailablePageSizes(int64_t index, std::vector<int64_t>& out) const;
+
+  /// Spills the pages that are held only by this buffer and returns them for
+  /// the caller to free.
+  std::vector<std::shared_ptr<SerializedPage>> spill();
+
+  /// Removes all the pages and returns the ones in memory for the caller to
+  /// free.
+  std::vector<std::shared_ptr<SerializedPage>> clear();
+
+  /// Returns and resets the number of pages and bytes read back from the spill
+  /// file since the last call.
+  std::pair<int64_t, int64_t> takeReloaded() {
+    return {std::exchange(reloadedPages_, 0), std::exchange(reloadedBytes_, 0)};
+  }
+
+  /// Returns the total number of bytes written to the spill file.
+  int64_t spilledBytes() const {
+    return spillFile_ == nullptr ? 0 : spillFile_->size();
+  }
+
+  std::string toString() const;
+
+ private:
+  struct Page {
+    // Null if the page is spilled and not read back.
+    std::shared_ptr<SerializedPage> page;
+    int64_t size;
+    int64_t numRows;
+    // Offset of the page in the spill file or -1 if not written.
+    int64_t spillOffset{-1};
+  };
+
+  const std::function<std::string()> spillPathFn_;
+  std::vector<Page> pages_;
+  bool noMoreData_{false};
+  std::string spillPath_;
+  std::unique_ptr<WriteFile> spillFile_;
+  // Opened again after the spill file grows.
+  std::unique_ptr<ReadFile> readFile_;
+  uint64_t readFileSize_{0};
+  int64_t reloadedPages_{0};
+  int64_t reloadedBytes_{0};
+};
+
 class DestinationBuffer {
  public:
   /// The data transferred by the destination buffer has two phases:
@@ -131,6 +222,27 @@ class DestinationBuffer {
   /// arbitrary buffer on demand.
   void loadData(ArbitraryBuffer* buffer, uint64_t maxBytes);
 
+  /// Makes this destination buffer replay the pages of a broadcast buffer from
+  /// the first one. Used for destinations added after pages have been
+  /// enqueued.
+  void startReplay() {
+    replaying_ = true;
+    replayIndex_ = 0;
+  }
+
+  /// Returns true while this buffer loads pages from the broadcast buffer
+  /// instead of receiving them from enqueue().
+  bool isReplaying() const {
+    return replaying_;
+  }
+
+  /// Same as maybeLoadData() and loadData() above for a replaying destination
+  /// of a broadcast output buffer. Replay stops once all of the pages in
+  /// 'buffer' are loaded.
+  void maybeLoadData(BroadcastBuffer* buffer);
+
+  void loadData(BroadcastBuffer* buffer, uint64_t maxBytes);
+
   struct Data {
     /// The actual data available at this buffer.
     std::vector<std::unique_ptr<folly::IOBuf>> data;
@@ -153,13 +265,15 @@ class DestinationBuffer {
   /// When arbitraryBuffer is provided, and this buffer is not at end (no null
   /// marker received), we append the remaining bytes from arbitraryBuffer in
   /// the result, even the arbitraryBuffer could be shared among multiple
-  /// DestinationBuffers.
+  /// DestinationBuffers. The same applies to 'broadcastBuffer' while this
+  /// buffer is replaying.
   Data getData(
       uint64_t maxBytes,
       int64_t sequence,
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck,
-      ArbitraryBuffer* arbitraryBuffer = nullptr);
+      ArbitraryBuffer* arbitraryBuffer = nullptr,
+      BroadcastBuffer* broadcastBuffer = nullptr);
 
   /// Removes data from the queue and returns removed data. If 'fromGetData' we
   /// do not give a warning for the case where no data is removed, otherwise we
@@ -195,6 +309,10 @@ class DestinationBuffer {
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
   uint64_t notifyMaxBytes_{0};
+  // True while the pages come from the broadcast buffer. 'replayIndex_' is
+  // the index of the next page to load from it.
+  bool replaying_{false};
+  int64_t replayIndex_{0};
   Stats stats_;
 };
 
@@ -321,6 +439,12 @@ class OutputBuffer {
   /// tasks.
   bool isOverutilized() const;
 
+  /// Returns the number of pages queued for 'destination' and not yet
+  /// acknowledged by its consumer. For broadcast and arbitrary buffers this is
+  /// the number of pages queued in the whole buffer since any consumer may
+  /// take them.
+  int64_t bufferedPages(int destination);
+
   /// Gets the Stats of this output buffer.
   Stats stats();
 
@@ -349,9 +473,17 @@ class OutputBuffer {
       std::vector<ContinuePromise>& promises);
 
   /// Given an updated total number of broadcast buffers, add any missing ones
-  /// and enqueue data that has been produced so far (e.g. dataToBroadcast_).
+  /// and make them replay the data that has been produced so far (e.g.
+  /// broadcastBuffer_).
   void addOutputBuffersLocked(int numBuffers);
 
+  bool hasReplayingBuffersLocked() const;
+
+  // Accounts for the pages 'broadcastBuffer_' read back from spill and clears
+  // it into 'freed' once no destination can be added or is replaying.
+  void updateBroadcastBufferLocked(
+      std::vector<std::shared_ptr<SerializedPage>>& freed);
+
   void enqueueBroadcastOutputLocked(
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
@@ -388,6 +520,10 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // Stores the enqueued data to broadcast to destinations that have not yet
+  // been initialized or are still replaying it. Cleared after receiving
+  // no-more-broadcast-buffers signal once all destinations have caught up.
+  const std::unique_ptr<BroadcastBuffer> broadcastBuffer_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -398,11 +534,6 @@ class OutputBuffer {
   // applies for non-partitioned output buffer type.
   bool noMoreBuffers_{false};
 
-  // While noMoreBuffers_ is false, stores the enqueued data to
-  // broadcast to destinations that have not yet been initialized. Cleared
-  // after receiving no-more-broadcast-buffers signal.
-  std::vector<std::shared_ptr<SerializedPage>> dataToBroadcast_;
-
   std::mutex mutex_;
   // Actual data size in 'buffers_'.
   int64_t bufferedBytes_{0};
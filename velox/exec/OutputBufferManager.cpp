@@ -198,6 +198,16 @@ bool OutputBufferManager::isOverutilized(const std::string& taskId) {
   return false;
 }
 
+int64_t OutputBufferManager::bufferedPages(
+    const std::string& taskId,
+    int destination) {
+  auto buffer = getBufferIfExists(taskId);
+  if (buffer != nullptr) {
+    return buffer->bufferedPages(destination);
+  }
+  return 0;
+}
+
 std::optional<OutputBuffer::Stats> OutputBufferManager::stats(
     const std::string& taskId) {
   auto buffer = getBufferIfExists(taskId);
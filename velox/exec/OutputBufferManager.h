@@ -128,6 +128,11 @@ class OutputBufferManager {
   // producers. When the task of this taskId is not found, return false.
   bool isOverutilized(const std::string& taskId);
 
+  // Returns the number of pages queued for 'destination' in the output buffer
+  // of the task of taskId. When the task of this taskId is not found, return
+  // 0.
+  int64_t bufferedPages(const std::string& taskId, int destination);
+
   // Returns nullopt when the specified output buffer doesn't exist.
   std::optional<OutputBuffer::Stats> stats(const std::string& taskId);
 
@@ -15,11 +15,136 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 namespace detail {
+namespace {
+bool hasEncodedColumns(const RowVector& vector) {
+  for (const auto& child : vector.children()) {
+    const auto encoding = child->loadedVector()->encoding();
+    if (encoding == VectorEncoding::Simple::DICTIONARY ||
+        encoding == VectorEncoding::Simple::CONSTANT) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns 'average' updated with 'sample', or 'sample' if there is no average
+// yet. The latest sample has a weight of 'kDecay'.
+double updateAverage(double average, double sample, bool hasAverage) {
+  constexpr double kDecay = 0.25;
+  return hasAverage ? average + kDecay * (sample - average) : sample;
+}
+} // namespace
+
+common::CompressionKind CompressionSelector::nextKind(int64_t queuedPages) {
+  if (kind_ == common::CompressionKind_NONE || !hasCompressedSample_) {
+    return kind_;
+  }
+  if (nanosPerSavedByte_ < kIncompressibleNanosPerByte &&
+      (queuedPages >= kBackpressuredPages ||
+       nanosPerSavedByte_ <= maxNanosPerSavedByte_)) {
+    pagesSinceSample_ = 0;
+    return kind_;
+  }
+  if (++pagesSinceSample_ >= kSampleInterval) {
+    pagesSinceSample_ = 0;
+    return kind_;
+  }
+  return common::CompressionKind_NONE;
+}
+
+void CompressionSelector::recordFlush(
+    common::CompressionKind kind,
+    int64_t compressedInputBytes,
+    int64_t outputBytes,
+    uint64_t cpuNanos) {
+  if (outputBytes <= 0) {
+    return;
+  }
+  if (kind == common::CompressionKind_NONE || compressedInputBytes == 0) {
+    uncompressedNanosPerByte_ = updateAverage(
+        uncompressedNanosPerByte_,
+        static_cast<double>(cpuNanos) / outputBytes,
+        hasUncompressedSample_);
+    hasUncompressedSample_ = true;
+    return;
+  }
+  const int64_t savedBytes = compressedInputBytes - outputBytes;
+  double sample = kIncompressibleNanosPerByte;
+  if (savedBytes > 0) {
+    const double compressionNanos = std::max<double>(
+        0, cpuNanos - uncompressedNanosPerByte_ * compressedInputBytes);
+    sample = compressionNanos / savedBytes;
+  }
+  nanosPerSavedByte_ =
+      updateAverage(nanosPerSavedByte_, sample, hasCompressedSample_);
+  hasCompressedSample_ = true;
+}
+
+void HotKeyTracker::add(const uint64_t* hashes, vector_size_t numRows) {
+  vector_size_t i = 0;
+  while (i < numRows) {
+    // Count runs of the same key with one insert.
+    vector_size_t end = i + 1;
+    while (end < numRows && hashes[end] == hashes[i]) {
+      ++end;
+    }
+    summary_.insert(hashes[i], end - i);
+    i = end;
+  }
+  numRows_ += numRows;
+
+  hotKeys_.clear();
+  if (numRows_ < kMinRows) {
+    return;
+  }
+  for (const auto& [hash, count] : summary_.topK(kCapacity)) {
+    if (count * numPartitions_ < numRows_) {
+      break;
+    }
+    hotKeys_.insert(hash);
+  }
+}
+
+void Destination::selectCompression(OutputBufferManager& bufferManager) {
+  const auto kind = compressionSelector_->nextKind(
+      bufferManager.bufferedPages(taskId_, destination_));
+  if (current_ != nullptr && kind != compressionKind_) {
+    saveSerializerStats();
+    current_.reset();
+  }
+  compressionKind_ = kind;
+}
+
+void Destination::recordFlush(int64_t flushedBytes, uint64_t cpuNanos) {
+  const auto stats = current_->runtimeStats();
+  const auto it = stats.find("compressionInputBytes");
+  const int64_t inputBytes = it == stats.end() ? 0 : it->second.value;
+  compressionSelector_->recordFlush(
+      compressionKind_,
+      inputBytes - compressionInputBytes_,
+      flushedBytes,
+      cpuNanos);
+  compressionInputBytes_ = inputBytes;
+}
+
+void Destination::saveSerializerStats() {
+  for (const auto& [name, counter] : current_->runtimeStats()) {
+    auto it = flushedStats_.find(name);
+    if (it == flushedStats_.end()) {
+      flushedStats_.emplace(name, counter);
+    } else {
+      it->second.value += counter.value;
+    }
+  }
+  compressionInputBytes_ = 0;
+}
+
 BlockingReason Destination::advance(
     uint64_t maxBytes,
     const std::vector<vector_size_t>& sizes,
@@ -34,7 +159,14 @@ BlockingReason Destination::advance(
     return BlockingReason::kNotBlocked;
   }
 
+  if (encodedOutput_ != nullptr && encodedOutput_ != output) {
+    // The dictionary and constant columns of 'output' can't be added to a
+    // page that preserves the encodings of another vector.
+    return flush(bufferManager, bufferReleaseFn, future);
+  }
+
   const auto firstRow = rowIdx_;
+  const bool newPage = rowsInCurrent_ == 0;
   const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
   if (bytesInCurrent_ >= adjustedMaxBytes) {
     return flush(bufferManager, bufferReleaseFn, future);
@@ -51,15 +183,23 @@ BlockingReason Destination::advance(
   }
 
   // Serialize
+  if (compressionSelector_ != nullptr && newPage) {
+    selectCompression(bufferManager);
+  }
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
     serializer::presto::PrestoVectorSerde::PrestoOptions options;
-    options.compressionKind =
-        OutputBufferManager::getInstance().lock()->compressionKind();
+    options.compressionKind = compressionSelector_ != nullptr
+        ? compressionKind_
+        : OutputBufferManager::getInstance().lock()->compressionKind();
     options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    options.preserveEncodings = preserveEncodings_;
     current_->createStreamTree(rowType, rowsInCurrent_, &options);
   }
+  if (preserveEncodings_ && newPage && hasEncodedColumns(*output)) {
+    encodedOutput_ = output;
+  }
   current_->append(
       output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
   // Update output state variable.
@@ -82,17 +222,28 @@ BlockingReason Destination::flush(
 
   // Upper limit of message size with no columns.
   constexpr int32_t kMinMessageSize = 128;
+  // Serdes that deserialize without copying need each page in a single
+  // contiguous range.
+  const int64_t serializedSize =
+      getVectorSerde()->supportsZeroCopyDeserialize()
+      ? current_->maxSerializedSize()
+      : current_->size();
   auto listener = bufferManager.newListener();
   IOBufOutputStream stream(
       *current_->pool(),
       listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
+      std::max<int64_t>(kMinMessageSize, serializedSize));
   const int64_t flushedRows = rowsInCurrent_;
 
+  const uint64_t startNanos =
+      compressionSelector_ != nullptr ? process::threadCpuNanos() : 0;
   current_->flush(&stream);
-  current_->clear();
-
   const int64_t flushedBytes = stream.tellp();
+  if (compressionSelector_ != nullptr) {
+    recordFlush(flushedBytes, process::threadCpuNanos() - startNanos);
+  }
+  current_->clear();
+  encodedOutput_ = nullptr;
 
   bytesInCurrent_ = 0;
   rowsInCurrent_ = 0;
@@ -114,11 +265,14 @@ BlockingReason Destination::flush(
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
   if (current_) {
-    const auto serializerStats = current_->runtimeStats();
-    auto lockedStats = op->stats().wlock();
-    for (auto& pair : serializerStats) {
-      lockedStats->addRuntimeStat(pair.first, pair.second);
-    }
+    saveSerializerStats();
+  }
+  if (flushedStats_.empty()) {
+    return;
+  }
+  auto lockedStats = op->stats().wlock();
+  for (auto& pair : flushedStats_) {
+    lockedStats->addRuntimeStat(pair.first, pair.second);
   }
 }
 
@@ -155,7 +309,17 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(
+          ctx->task->queryCtx()->queryConfig().exchangePreserveEncodings()),
+      adaptiveCompression_(
+          ctx->task->queryCtx()->queryConfig().exchangeAdaptiveCompression()),
+      maxCompressionNanosPerByte_(
+          ctx->task->queryCtx()
+              ->queryConfig()
+              .exchangeAdaptiveCompressionMaxNanosPerByte()),
+      skewHandling_(planNode->skewHandling()),
+      skewFanout_(planNode->skewFanout()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -163,6 +327,16 @@ PartitionedOutput::PartitionedOutput(
     VELOX_USER_CHECK(keyChannels_.empty());
     VELOX_USER_CHECK_NULL(partitionFunction_);
   }
+  if (skewHandling_ == core::PartitionedOutputNode::SkewHandling::kSpread) {
+    const auto& inputType = planNode->inputType();
+    for (const auto channel : keyChannels_) {
+      if (channel != kConstantChannel) {
+        skewHashers_.push_back(
+            VectorHasher::create(inputType->childAt(channel), channel));
+      }
+    }
+    hotKeyTracker_ = std::make_unique<detail::HotKeyTracker>(numDestinations_);
+  }
 }
 
 void PartitionedOutput::initializeInput(RowVectorPtr input) {
@@ -195,12 +369,25 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
 void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
+    const auto compressionKind = bufferManager_.lock()->compressionKind();
     for (int i = 0; i < numDestinations_; ++i) {
+      std::unique_ptr<detail::CompressionSelector> compressionSelector;
+      if (adaptiveCompression_ &&
+          compressionKind != common::CompressionKind_NONE) {
+        compressionSelector = std::make_unique<detail::CompressionSelector>(
+            compressionKind, maxCompressionNanosPerByte_);
+      }
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          preserveEncodings_,
+          std::move(compressionSelector)));
     }
   }
 }
@@ -249,6 +436,17 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
     destinations_[0]->addRows(IndexRange{0, numInput});
   } else {
     auto singlePartition = partitionFunction_->partition(*input_, partitions_);
+    if (skewHandling_ != core::PartitionedOutputNode::SkewHandling::kNone) {
+      if (singlePartition.has_value()) {
+        partitions_.resize(numInput);
+        std::fill(
+            partitions_.begin(), partitions_.end(), singlePartition.value());
+        singlePartition.reset();
+      }
+      if (skewHandling_ == core::PartitionedOutputNode::SkewHandling::kSpread) {
+        spreadHotKeys();
+      }
+    }
     if (replicateNullsAndAny_) {
       collectNullRows();
 
@@ -270,7 +468,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
           if (singlePartition.has_value()) {
             destinations_[singlePartition.value()]->addRow(i);
           } else {
-            destinations_[partitions_[i]]->addRow(i);
+            addRowToPartition(i, partitions_[i]);
           }
         }
       }
@@ -280,13 +478,58 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
             IndexRange{0, numInput});
       } else {
         for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
+          addRowToPartition(i, partitions_[i]);
         }
       }
     }
   }
 }
 
+void PartitionedOutput::spreadHotKeys() {
+  const auto numInput = input_->size();
+  rows_.resize(numInput);
+  rows_.setAll();
+  skewHashes_.resize(numInput);
+  if (skewHashers_.empty()) {
+    // All keys are constant.
+    std::fill(skewHashes_.begin(), skewHashes_.end(), 0);
+  }
+  for (auto i = 0; i < skewHashers_.size(); ++i) {
+    auto& hasher = skewHashers_[i];
+    hasher->decode(*input_->childAt(hasher->channel()), rows_);
+    hasher->hash(rows_, i > 0, skewHashes_);
+  }
+
+  hotKeyTracker_->add(skewHashes_.data(), numInput);
+  if (!hotKeyTracker_->hasHotKeys()) {
+    return;
+  }
+  int64_t numSpreadRows = 0;
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    if (!hotKeyTracker_->isHot(skewHashes_[i])) {
+      continue;
+    }
+    partitions_[i] = (partitions_[i] + nextSpread_) % numDestinations_;
+    nextSpread_ = (nextSpread_ + 1) % skewFanout_;
+    ++numSpreadRows;
+  }
+  if (numSpreadRows > 0) {
+    addRuntimeStat("numSkewSpreadRows", RuntimeCounter(numSpreadRows));
+  }
+}
+
+void PartitionedOutput::addRowToPartition(
+    vector_size_t row,
+    uint32_t partition) {
+  if (skewHandling_ != core::PartitionedOutputNode::SkewHandling::kReplicate) {
+    destinations_[partition]->addRow(row);
+    return;
+  }
+  for (auto i = 0; i < skewFanout_; ++i) {
+    destinations_[(partition + i) % numDestinations_]->addRow(row);
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
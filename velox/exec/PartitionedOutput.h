@@ -16,28 +16,143 @@
 #pragma once
 
 #include <folly/Random.h>
+#include <folly/container/F14Set.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
 
 namespace detail {
+/// Decides for each page of a destination whether to compress it with the
+/// shuffle codec. Compression is worth its CPU cost when pages queue up for
+/// the consumer, i.e. the network or the consumer is the bottleneck, or when it
+/// is cheap relative to the bytes it saves. While pages go out uncompressed,
+/// every kSampleInterval'th page is still compressed to keep the estimate of
+/// the compression cost current.
+class CompressionSelector {
+ public:
+  /// Number of uncompressed pages after which a page is compressed to sample
+  /// the compression cost.
+  static constexpr int32_t kSampleInterval = 16;
+
+  /// Number of pages queued for the destination at which compression is
+  /// used regardless of its CPU cost.
+  static constexpr int64_t kBackpressuredPages = 2;
+
+  /// @param kind The shuffle codec. Pages are either compressed with 'kind'
+  /// or not compressed.
+  /// @param maxNanosPerSavedByte The maximum CPU cost of compression per saved
+  /// byte for compressing pages when there is no backpressure.
+  CompressionSelector(
+      common::CompressionKind kind,
+      double maxNanosPerSavedByte)
+      : kind_(kind), maxNanosPerSavedByte_(maxNanosPerSavedByte) {}
+
+  /// Returns the compression for the next page given the number of pages
+  /// queued for the destination.
+  common::CompressionKind nextKind(int64_t queuedPages);
+
+  /// Records the flush of a page serialized with 'kind'. 'compressedInputBytes'
+  /// is the number of bytes passed to the codec, 'outputBytes' the size of the
+  /// page and 'cpuNanos' the time taken to flush it.
+  void recordFlush(
+      common::CompressionKind kind,
+      int64_t compressedInputBytes,
+      int64_t outputBytes,
+      uint64_t cpuNanos);
+
+  /// Returns the estimated CPU cost of compression per saved byte or nullopt
+  /// if no compressed page has been recorded.
+  std::optional<double> nanosPerSavedByte() const {
+    if (!hasCompressedSample_) {
+      return std::nullopt;
+    }
+    return nanosPerSavedByte_;
+  }
+
+ private:
+  // Cost per saved byte recorded for pages that compression makes no smaller.
+  static constexpr double kIncompressibleNanosPerByte = 1e9;
+
+  const common::CompressionKind kind_;
+  const double maxNanosPerSavedByte_;
+
+  // Running average of flush CPU time per byte for uncompressed pages.
+  double uncompressedNanosPerByte_{0};
+  bool hasUncompressedSample_{false};
+
+  // Running average of the CPU time in excess of an uncompressed flush per
+  // byte saved by compression.
+  double nanosPerSavedByte_{0};
+  bool hasCompressedSample_{false};
+
+  // Number of uncompressed pages since the last compressed page.
+  int32_t pagesSinceSample_{0};
+};
+
+/// Finds the partitioning keys that account for a large share of the input of
+/// a PartitionedOutput. Keeps an approximate count of the most frequent key
+/// hashes. A key is hot if it alone has at least as many rows as a partition
+/// would get on average.
+class HotKeyTracker {
+ public:
+  /// Number of most frequent keys counted.
+  static constexpr int32_t kCapacity = 64;
+
+  /// Number of input rows before any key is considered hot.
+  static constexpr int64_t kMinRows = 10'000;
+
+  explicit HotKeyTracker(int32_t numPartitions)
+      : numPartitions_(numPartitions) {
+    summary_.setCapacity(kCapacity);
+  }
+
+  /// Counts the keys with 'hashes' and updates the set of hot keys.
+  void add(const uint64_t* hashes, vector_size_t numRows);
+
+  bool hasHotKeys() const {
+    return !hotKeys_.empty();
+  }
+
+  bool isHot(uint64_t hash) const {
+    return hotKeys_.contains(hash);
+  }
+
+  int64_t numRows() const {
+    return numRows_;
+  }
+
+ private:
+  const int32_t numPartitions_;
+  functions::ApproxMostFrequentStreamSummary<uint64_t> summary_;
+  int64_t numRows_{0};
+  folly::F14FastSet<uint64_t> hotKeys_;
+};
+
 class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param compressionSelector If set, chooses whether to compress each page.
+  /// Otherwise pages are compressed with OutputBufferManager::compressionKind.
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool preserveEncodings = false,
+      std::unique_ptr<CompressionSelector> compressionSelector = nullptr)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
-        recordEnqueued_(std::move(recordEnqueued)) {
+        recordEnqueued_(std::move(recordEnqueued)),
+        preserveEncodings_(preserveEncodings),
+        compressionSelector_(std::move(compressionSelector)) {
     setTargetSizePct();
   }
 
@@ -102,11 +217,39 @@ class Destination {
     targetNumRows_ = (10'000 * targetSizePct_) / 100;
   }
 
+  // Asks 'compressionSelector_' for the compression of the next page and
+  // resets 'current_' if the compression changes.
+  void selectCompression(OutputBufferManager& bufferManager);
+
+  // Reports the flush of the page in 'current_' to 'compressionSelector_'.
+  void recordFlush(int64_t flushedBytes, uint64_t cpuNanos);
+
+  // Adds the runtime stats of 'current_' to 'flushedStats_'.
+  void saveSerializerStats();
+
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  // If true, serializes dictionary and constant columns with their encodings.
+  // A page then holds rows of a single input vector with such columns.
+  const bool preserveEncodings_;
+  const std::unique_ptr<CompressionSelector> compressionSelector_;
+
+  // The compression of 'current_'. Only used with 'compressionSelector_'.
+  common::CompressionKind compressionKind_{common::CompressionKind_NONE};
+
+  // The value of the 'compressionInputBytes' runtime stat of 'current_' as of
+  // the last flush. Only used with 'compressionSelector_'.
+  int64_t compressionInputBytes_{0};
+
+  // Runtime stats of serializers replaced after a change of compression.
+  std::unordered_map<std::string, RuntimeCounter> flushedStats_;
+
+  // The input vector whose dictionary or constant columns are serialized with
+  // their encodings in 'current_'. Null if 'current_' has no such columns.
+  RowVectorPtr encodedOutput_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -205,6 +348,14 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Moves the rows of hot keys in 'partitions_' to the partitions after their
+  // own in round-robin order. Used with SkewHandling::kSpread.
+  void spreadHotKeys();
+
+  // Adds 'row' to the destination for 'partition' and, with
+  // SkewHandling::kReplicate, to the 'skewFanout_' - 1 destinations after it.
+  void addRowToPartition(vector_size_t row, uint32_t partition);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -219,6 +370,17 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
+  // If true, each destination decides per page whether to compress it.
+  const bool adaptiveCompression_;
+  const double maxCompressionNanosPerByte_;
+  const core::PartitionedOutputNode::SkewHandling skewHandling_;
+  const int skewFanout_;
+  // Hashers for the non-constant keys. Only used with SkewHandling::kSpread.
+  std::vector<std::unique_ptr<VectorHasher>> skewHashers_;
+  std::unique_ptr<detail::HotKeyTracker> hotKeyTracker_;
+  // Offset from its own partition of the partition for the next hot key row.
+  int32_t nextSpread_{0};
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -233,6 +395,7 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  raw_vector<uint64_t> skewHashes_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
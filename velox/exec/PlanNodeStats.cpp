@@ -17,6 +17,8 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/exec/TaskStats.h"
 
+#include <sstream>
+
 namespace facebook::velox::exec {
 
 void PlanNodeStats::add(const OperatorStats& stats) {
@@ -49,6 +51,9 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   cpuWallTiming.add(stats.getOutputTiming);
   cpuWallTiming.add(stats.finishTiming);
 
+  hardwareCounters.add(stats.addInputCounters);
+  hardwareCounters.add(stats.getOutputCounters);
+
   backgroundTiming.add(stats.backgroundTiming);
 
   blockedWallNanos += stats.blockedWallNanos;
@@ -66,6 +71,8 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
     }
   }
 
+  addExprProfiles(exprProfiles, stats.exprProfiles);
+
   // Populating number of drivers for plan nodes with multiple operators is not
   // useful. Each operator could have been executed in different pipelines with
   // different number of drivers.
@@ -101,6 +108,12 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
       << ", Peak memory: " << succinctBytes(peakMemoryBytes)
       << ", Memory allocations: " << numMemoryAllocations;
 
+  if (!hardwareCounters.empty()) {
+    out << ", IPC: " << fmt::format("{:.2f}", hardwareCounters.ipc())
+        << ", Cache misses: " << hardwareCounters.cacheMisses
+        << ", Branch misses: " << hardwareCounters.branchMisses;
+  }
+
   if (numDrivers > 0) {
     out << ", Threads: " << numDrivers;
   }
@@ -160,6 +173,10 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["outputVectors"] = operatorStat.second->outputVectors;
       stat["outputBytes"] = operatorStat.second->outputBytes;
       stat["cpuWallTiming"] = operatorStat.second->cpuWallTiming.toString();
+      if (!operatorStat.second->hardwareCounters.empty()) {
+        stat["hardwareCounters"] =
+            operatorStat.second->hardwareCounters.toString();
+      }
       stat["blockedWallNanos"] = operatorStat.second->blockedWallNanos;
       stat["peakMemoryBytes"] = operatorStat.second->peakMemoryBytes;
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
@@ -208,6 +225,19 @@ void printCustomStats(
     metric.printMetric(stream);
   }
 }
+
+void printExprProfiles(
+    const std::vector<ExprProfile>& profiles,
+    const std::string& indentation,
+    std::ostream& stream) {
+  for (const auto& profile : profiles) {
+    std::istringstream lines(profile.toString(indentation));
+    std::string line;
+    while (std::getline(lines, line)) {
+      stream << std::endl << line;
+    }
+  }
+}
 } // namespace
 
 std::string printPlanWithStats(
@@ -247,6 +277,7 @@ std::string printPlanWithStats(
             printCustomStats(stats.customStats, indentation + "   ", stream);
           }
         }
+        printExprProfiles(stats.exprProfiles, indentation + "   ", stream);
       });
 }
 } // namespace facebook::velox::exec
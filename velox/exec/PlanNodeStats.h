@@ -81,6 +81,11 @@ struct PlanNodeStats {
   /// up.
   CpuWallTiming cpuWallTiming;
 
+  /// Sum of hardware counts of addInput and getOutput calls for all
+  /// corresponding operators. Empty unless
+  /// QueryConfig::kOperatorTrackHardwareCounters is true.
+  process::HardwareCounters hardwareCounters;
+
   /// Sum of CPU, scheduled and wall times spent on background activities
   /// (activities that are not running on driver threads) for all corresponding
   /// operators.
@@ -100,6 +105,9 @@ struct PlanNodeStats {
   /// Operator-specific counters.
   std::unordered_map<std::string, RuntimeMetric> customStats;
 
+  /// Per-node expression statistics. See OperatorStats::exprProfiles.
+  std::vector<ExprProfile> exprProfiles;
+
   /// Breakdown of stats by operator type.
   std::unordered_map<std::string, std::unique_ptr<PlanNodeStats>> operatorStats;
 
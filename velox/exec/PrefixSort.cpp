@@ -26,6 +26,9 @@ namespace {
 // to bitswap32.
 const int32_t kAlignment = 8;
 
+// Number of prefixes sampled to choose between radix sort and quick-sort.
+const int32_t kRadixSortSampleSize = 1024;
+
 template <typename T>
 FOLLY_ALWAYS_INLINE void encodeRowColumn(
     const PrefixSortLayout& prefixSortLayout,
@@ -43,6 +46,26 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  // Holds a string that is stored in multiple pieces.
+  std::string storage;
+  if (!RowContainer::isNullAt(
+          row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = HashStringAllocator::contiguousString(
+        *reinterpret_cast<StringView*>(row + rowColumn.offset()), storage);
+  }
+  prefixSortLayout.encoders[index].encodeString(
+      value,
+      prefix + prefixSortLayout.prefixOffsets[index],
+      prefixSortLayout.stringPrefixLengths[index]);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +95,12 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -115,12 +144,15 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
+  std::vector<uint32_t> stringPrefixLengths;
+  std::vector<uint32_t> stringKeys;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
   // cannot be normalized is encountered.
@@ -128,12 +160,33 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
-    std::optional<uint32_t> encodedSize =
-        PrefixSortEncoder::encodedSize(types[i]->kind());
+    const auto kind = types[i]->kind();
+    if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+      if (maxStringPrefixLength == 0) {
+        break;
+      }
+      // Takes as many more string bytes as make the key end at a multiple of
+      // 'kAlignment'.
+      const uint32_t prefixLength = maxStringPrefixLength +
+          alignmentPadding(
+              normalizedKeySize +
+                  PrefixSortEncoder::encodedStringSize(maxStringPrefixLength),
+              kAlignment);
+      prefixOffsets.push_back(normalizedKeySize);
+      encoders.push_back(
+          {compareFlags[i].ascending, compareFlags[i].nullsFirst});
+      stringPrefixLengths.push_back(prefixLength);
+      stringKeys.push_back(i);
+      normalizedKeySize += PrefixSortEncoder::encodedStringSize(prefixLength);
+      numNormalizedKeys++;
+      continue;
+    }
+    std::optional<uint32_t> encodedSize = PrefixSortEncoder::encodedSize(kind);
     if (encodedSize.has_value()) {
       prefixOffsets.push_back(normalizedKeySize);
       encoders.push_back(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
+      stringPrefixLengths.push_back(0);
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
     } else {
@@ -152,7 +205,9 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numNormalizedKeys < numKeys,
       std::move(prefixOffsets),
       std::move(encoders),
-      padding};
+      padding,
+      std::move(stringPrefixLengths),
+      std::move(stringKeys)};
 }
 
 FOLLY_ALWAYS_INLINE int PrefixSort::compareAllNormalizedKeys(
@@ -163,21 +218,88 @@ FOLLY_ALWAYS_INLINE int PrefixSort::compareAllNormalizedKeys(
 }
 
 int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
-  int result = compareAllNormalizedKeys(left, right);
-  if (result != 0) {
+  // Compares up to the end of each string key first. The bytes after a
+  // string key do not decide the order if the strings are truncated.
+  uint32_t begin = 0;
+  for (const auto key : sortLayout_.stringKeys) {
+    const auto end = sortLayout_.prefixOffsets[key] +
+        PrefixSortEncoder::encodedStringSize(
+            sortLayout_.stringPrefixLengths[key]);
+    const int result = compareByWord(
+        (uint64_t*)(left + begin), (uint64_t*)(right + begin), end - begin);
+    if (result != 0) {
+      return result;
+    }
+    // The length bytes are equal, so both strings are truncated or none.
+    if (isStringTruncated(left, key)) {
+      return compareRowsFromKey(left, right, key);
+    }
+    begin = end;
+  }
+  const int result = compareByWord(
+      (uint64_t*)(left + begin),
+      (uint64_t*)(right + begin),
+      sortLayout_.normalizedBufferSize - begin);
+  if (result != 0 || !sortLayout_.hasNonNormalizedKey) {
     return result;
   }
   // If prefixes are equal, compare the left sort keys with rowContainer.
+  return compareRowsFromKey(left, right, sortLayout_.numNormalizedKeys);
+}
+
+int PrefixSort::compareRowsFromKey(char* left, char* right, uint32_t firstKey) {
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
-    result = rowContainer_->compare(
+  for (auto i = firstKey; i < sortLayout_.numKeys; ++i) {
+    const auto result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
       return result;
     }
   }
-  return result;
+  return 0;
+}
+
+bool PrefixSort::useRadixSort(char* prefixes, uint64_t numRows) const {
+  if (sortLayout_.hasNonNormalizedKey || !sortLayout_.stringKeys.empty() ||
+      numRows < std::max<uint64_t>(radixSortThreshold_, 2)) {
+    return false;
+  }
+  // The bits that differ between the first prefix and any sampled prefix.
+  const auto numWords = sortLayout_.normalizedBufferSize / kAlignment;
+  std::vector<uint64_t> diffs(numWords, 0);
+  const auto* first = reinterpret_cast<uint64_t*>(prefixes);
+  const auto step = std::max<uint64_t>(1, numRows / kRadixSortSampleSize);
+  for (auto row = step; row < numRows; row += step) {
+    const auto* words =
+        reinterpret_cast<uint64_t*>(prefixes + row * sortLayout_.entrySize);
+    for (auto i = 0; i < numWords; ++i) {
+      diffs[i] |= words[i] ^ first[i];
+    }
+  }
+  // The words are byte swapped, so the leading bytes of the key are the high
+  // bytes of each word.
+  uint32_t numCommonBytes = 0;
+  for (auto i = 0; i < numWords; ++i) {
+    if (diffs[i] != 0) {
+      numCommonBytes += __builtin_clzll(diffs[i]) / 8;
+      break;
+    }
+    numCommonBytes += kAlignment;
+  }
+  const auto log2NumRows = 63 - __builtin_clzll(numRows);
+  return numCommonBytes <= log2NumRows / 2;
+}
+
+bool PrefixSort::isStringTruncated(char* prefix, uint32_t keyIndex) const {
+  const auto prefixLength = sortLayout_.stringPrefixLengths[keyIndex];
+  const auto position = sortLayout_.prefixOffsets[keyIndex] + 1 + prefixLength;
+  // The bytes of each word are swapped, see extractRowToPrefix().
+  const auto wordStart = position - position % kAlignment;
+  const auto lengthByte = static_cast<uint8_t>(
+      prefix[wordStart + kAlignment - 1 - position % kAlignment]);
+  return lengthByte ==
+      sortLayout_.encoders[keyIndex].stringTruncatedByte(prefixLength);
 }
 
 PrefixSort::PrefixSort(
@@ -186,7 +308,10 @@ PrefixSort::PrefixSort(
     const std::vector<CompareFlags>& keyCompareFlags,
     const PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
-    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+    : pool_(pool),
+      sortLayout_(sortLayout),
+      rowContainer_(rowContainer),
+      radixSortThreshold_(config.radixSortThreshold) {}
 
 void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; i++) {
@@ -236,10 +361,21 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     const auto start = prefixes;
     const auto end = prefixes + numRows * entrySize;
-    if (sortLayout_.hasNonNormalizedKey) {
+    if (sortLayout_.hasNonNormalizedKey || !sortLayout_.stringKeys.empty()) {
       sortRunner.quickSort(start, end, [&](char* a, char* b) {
         return comparePartNormalizedKeys(a, b);
       });
+    } else if (useRadixSort(prefixes, numRows)) {
+      sortRunner.radixSort(
+          start,
+          end,
+          sortLayout_.normalizedBufferSize,
+          [](char* prefix, uint32_t index) {
+            // The bytes of each word are swapped, see extractRowToPrefix().
+            return static_cast<uint8_t>(
+                prefix[index + kAlignment - 1 - 2 * (index % kAlignment)]);
+          },
+          [&](char* a, char* b) { return compareAllNormalizedKeys(a, b); });
     } else {
       sortRunner.quickSort(start, end, [&](char* a, char* b) {
         return compareAllNormalizedKeys(a, b);
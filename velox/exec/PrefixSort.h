@@ -42,8 +42,22 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }; // namespace detail
 
 struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
+  static constexpr uint32_t kDefaultMaxStringPrefixLength = 16;
+  static constexpr uint32_t kDefaultRadixSortThreshold = 10'000;
+
+  PrefixSortConfig(
+      uint32_t maxNormalizedKeySize,
+      uint32_t threshold = 130,
+      uint32_t maxStringPrefixLength = kDefaultMaxStringPrefixLength,
+      uint32_t radixSortThreshold = kDefaultRadixSortThreshold)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        maxStringPrefixLength(maxStringPrefixLength),
+        radixSortThreshold(radixSortThreshold) {
+    VELOX_CHECK_LE(
+        maxStringPrefixLength,
+        prefixsort::PrefixSortEncoder::kMaxStringPrefixLength);
+  }
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry.
@@ -53,17 +67,26 @@ struct PrefixSortConfig {
   /// The threshold is set to 100 according to the benchmark test results by
   /// default.
   const int64_t threshold;
+
+  /// Number of leading bytes of a VARCHAR or VARBINARY key stored in the
+  /// prefix. 0 stops the normalized keys at the first string key.
+  const uint32_t maxStringPrefixLength;
+
+  /// Min number of rows to sort the prefixes with radix sort instead of
+  /// quick-sort. Only used if all sort keys are fixed width normalized keys
+  /// and a sample of the prefixes does not share too many leading bytes, see
+  /// PrefixSort::useRadixSort().
+  const uint32_t radixSortThreshold;
 };
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 1. normalized keys. A string key stores its leading bytes, see
+/// PrefixSortEncoder::encodeString().
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedKeySize_ + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -96,10 +119,22 @@ struct PrefixSortLayout {
   /// during ‘memcmp’
   const int32_t padding;
 
+  /// Number of string bytes in the prefix for each normalized key, 0 for
+  /// fixed width keys. The bytes of a string key end at a multiple of 8, so
+  /// that the prefix can be compared by word up to the end of a string key.
+  const std::vector<uint32_t> stringPrefixLengths;
+
+  /// Indices of the normalized string keys. A prefix tie at a string key
+  /// that is truncated in both rows is broken by comparing the rows from
+  /// that key on.
+  const std::vector<uint32_t> stringKeys;
+
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength =
+          PrefixSortConfig::kDefaultMaxStringPrefixLength);
 };
 
 class PrefixSort {
@@ -122,31 +157,39 @@ class PrefixSort {
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For strings (Varchar, Varbinary), we store the leading bytes in the
+  /// prefix. Only a tie of two truncated strings falls back to RowContainer`s
+  /// compare from that key on.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
   /// them in the prefix buffer) into the input rows vector.
   ///
   /// @param rows The result of RowContainer::listRows(), assuming that the
-  /// caller (SortBuffer etc.) has already got the result.
+  /// caller (SortBuffer etc.) has already got the result. May also be a
+  /// subset of the rows of 'rowContainer'.
+  /// @param compareFlags The flags of the sort keys, which are the first
+  /// compareFlags.size() keys of 'rowContainer'.
   FOLLY_ALWAYS_INLINE static void sort(
       std::vector<char*>& rows,
       memory::MemoryPool* pool,
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& compareFlags,
       const PrefixSortConfig& config) {
-    if (rowContainer->numRows() < config.threshold) {
+    if (rows.size() < config.threshold) {
       detail::stdSort(rows, rowContainer, compareFlags);
       return;
     }
-    VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
+    const auto& keyTypes = rowContainer->keyTypes();
+    VELOX_DCHECK_LE(compareFlags.size(), keyTypes.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        compareFlags.size() == keyTypes.size()
+            ? keyTypes
+            : std::vector<TypePtr>(
+                  keyTypes.begin(), keyTypes.begin() + compareFlags.size()),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -163,8 +206,21 @@ class PrefixSort {
 
   int compareAllNormalizedKeys(char* left, char* right);
 
+  // Returns true if 'numRows' 'prefixes' should be sorted with radix sort.
+  // Each leading byte that is the same in all prefixes takes a pass over the
+  // prefixes without ordering anything, so radix sort is used only if the
+  // leading bytes shared by a sample of the prefixes are no more than half
+  // of log2(numRows), the depth of quick-sort.
+  bool useRadixSort(char* prefixes, uint64_t numRows) const;
+
   int comparePartNormalizedKeys(char* left, char* right);
 
+  // Compares the keys from 'firstKey' on with RowContainer.
+  int compareRowsFromKey(char* left, char* right, uint32_t firstKey);
+
+  // Returns true if string key 'keyIndex' is truncated in 'prefix'.
+  bool isStringTruncated(char* prefix, uint32_t keyIndex) const;
+
   void extractRowToPrefix(char* row, char* prefix);
 
   // Return the reference of row address ptr for read/write.
@@ -175,5 +231,6 @@ class PrefixSort {
   memory::MemoryPool* const pool_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
+  const uint32_t radixSortThreshold_;
 };
 } // namespace facebook::velox::exec
@@ -65,6 +65,13 @@ Accumulator::Accumulator(Aggregate* aggregate, TypePtr spillType)
         aggregate->destroy(groups);
       }} {
   VELOX_CHECK_NOT_NULL(aggregate);
+  if (aggregate->supportsRelocation()) {
+    relocateFunction_ = [aggregate](
+                            folly::Range<char**> groups,
+                            const HashStringAllocator::Relocation& relocation) {
+      aggregate->relocate(groups, relocation);
+    };
+  }
 }
 
 Accumulator::Accumulator(
@@ -104,6 +111,17 @@ void Accumulator::destroy(folly::Range<char**> groups) {
   destroyFunction_(groups);
 }
 
+bool Accumulator::supportsRelocation() const {
+  return relocateFunction_ != nullptr;
+}
+
+void Accumulator::relocate(
+    folly::Range<char**> groups,
+    const HashStringAllocator::Relocation& relocation) {
+  VELOX_CHECK(supportsRelocation());
+  relocateFunction_(groups, relocation);
+}
+
 const TypePtr& Accumulator::spillType() const {
   return spillType_;
 }
@@ -145,7 +163,7 @@ RowContainer::RowContainer(
       isJoinBuild_(isJoinBuild),
       accumulators_(accumulators),
       hasNormalizedKeys_(hasNormalizedKeys),
-      rows_(pool),
+      rows_(pool, memory::MemoryAllocationSite::kRowContainer),
       stringAllocator_(
           stringAllocator ? stringAllocator
                           : std::make_shared<HashStringAllocator>(pool)) {
@@ -421,6 +439,51 @@ void RowContainer::freeVariableWidthFields(folly::Range<char**> rows) {
   }
 }
 
+int64_t RowContainer::compactStringAllocator() {
+  if (nextOffset_ != 0 || stringAllocator_.use_count() > 1) {
+    return 0;
+  }
+  for (const auto& accumulator : accumulators_) {
+    if (!accumulator.supportsRelocation()) {
+      return 0;
+    }
+  }
+  return stringAllocator_->compact(
+      [&](const HashStringAllocator::Relocation& relocation) {
+        relocateRows(relocation);
+      });
+}
+
+void RowContainer::relocateRows(
+    const HashStringAllocator::Relocation& relocation) {
+  constexpr int32_t kBatch = 1000;
+  std::vector<char*> rows(kBatch);
+
+  RowContainerIterator iter;
+  while (const auto numRows = listRows(&iter, kBatch, rows.data())) {
+    folly::Range<char**> range(rows.data(), numRows);
+    for (auto i = 0; i < types_.size(); ++i) {
+      switch (typeKinds_[i]) {
+        case TypeKind::VARCHAR:
+        case TypeKind::VARBINARY:
+          relocateVariableWidthFieldsAtColumn<StringView>(
+              i, range, relocation);
+          break;
+        case TypeKind::ROW:
+        case TypeKind::ARRAY:
+        case TypeKind::MAP:
+          relocateVariableWidthFieldsAtColumn<std::string_view>(
+              i, range, relocation);
+          break;
+        default:;
+      }
+    }
+    for (auto& accumulator : accumulators_) {
+      accumulator.relocate(range, relocation);
+    }
+  }
+}
+
 void RowContainer::checkConsistency() {
   constexpr int32_t kBatch = 1000;
   std::vector<char*> rows(kBatch);
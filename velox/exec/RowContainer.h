@@ -57,6 +57,14 @@ class Accumulator {
 
   void destroy(folly::Range<char**> groups);
 
+  /// Returns true if relocate() can be called. See
+  /// Aggregate::supportsRelocation().
+  bool supportsRelocation() const;
+
+  void relocate(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocation& relocation);
+
  private:
   const bool isFixedSize_;
   const int32_t fixedSize_;
@@ -65,6 +73,11 @@ class Accumulator {
   const TypePtr spillType_;
   std::function<void(folly::Range<char**>, VectorPtr&)> spillExtractFunction_;
   std::function<void(folly::Range<char**> groups)> destroyFunction_;
+  // Not set if the accumulator does not support relocation.
+  std::function<void(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocation& relocation)>
+      relocateFunction_;
 };
 
 using normalized_key_t = uint64_t;
@@ -660,6 +673,12 @@ class RowContainer {
     return rows_.allocatedBytes() + stringAllocator_->retainedSize();
   }
 
+  /// Returns the bytes of the fixed size row storage backed by huge pages. See
+  /// memory::MemoryAllocator::hugePageBytes() for the cost and accuracy.
+  int64_t hugePageBytes() const {
+    return rows_.hugePageBytes();
+  }
+
   /// Returns the number of fixed size rows that can be allocated without
   /// growing the container and the number of unused bytes of reserved storage
   /// for variable length data.
@@ -683,6 +702,13 @@ class RowContainer {
   /// Frees memory for next row vectors.
   void clearNextRowVectors();
 
+  /// Moves the variable width data into fewer slabs with
+  /// HashStringAllocator::compact() and updates the rows to point to the new
+  /// locations. Does nothing if an accumulator does not support relocation,
+  /// the rows have next row vectors or the string allocator is shared with
+  /// another container. Returns the number of bytes freed.
+  int64_t compactStringAllocator();
+
   int32_t compareRows(
       const char* left,
       const char* right,
@@ -909,6 +935,40 @@ class RowContainer {
     }
   }
 
+  // Number of rows ahead of the current row of a gather whose column is
+  // prefetched. The rows are scattered in the container, so without it each
+  // row is a cache miss.
+  static constexpr int32_t kExtractPrefetchDistance = 16;
+
+  // Prefetches the value at 'offset' of the row 'kExtractPrefetchDistance'
+  // positions after 'index' in 'rows', or in 'rows' indexed by 'rowNumbers'
+  // if 'useRowNumbers'.
+  template <bool useRowNumbers>
+  static FOLLY_ALWAYS_INLINE void prefetchRow(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t index,
+      int32_t offset) {
+    const auto ahead = index + kExtractPrefetchDistance;
+    if (ahead >= numRows) {
+      return;
+    }
+    const char* row;
+    if constexpr (useRowNumbers) {
+      const auto rowNumber = rowNumbers[ahead];
+      if (rowNumber < 0) {
+        return;
+      }
+      row = rows[rowNumber];
+    } else {
+      row = rows[ahead];
+    }
+    if (row != nullptr) {
+      __builtin_prefetch(row + offset);
+    }
+  }
+
   template <bool useRowNumbers, typename T>
   static void extractValuesWithNulls(
       const char* const* rows,
@@ -927,6 +987,7 @@ class RowContainer {
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
     for (int32_t i = 0; i < numRows; ++i) {
+      prefetchRow<useRowNumbers>(rows, rowNumbers, numRows, i, offset);
       const char* row;
       if constexpr (useRowNumbers) {
         auto rowNumber = rowNumbers[i];
@@ -960,7 +1021,14 @@ class RowContainer {
     VELOX_DCHECK_LE(maxRows, result->size());
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
+    // Clears the nulls of the result rows at once. Only missing rows are set
+    // to null below, which allocates the nulls if there are none.
+    if (result->rawNulls()) {
+      bits::fillBits(
+          result->mutableRawNulls(), resultOffset, maxRows, bits::kNotNull);
+    }
     for (int32_t i = 0; i < numRows; ++i) {
+      prefetchRow<useRowNumbers>(rows, rowNumbers, numRows, i, offset);
       const char* row;
       if constexpr (useRowNumbers) {
         auto rowNumber = rowNumbers[i];
@@ -972,7 +1040,6 @@ class RowContainer {
       if (row == nullptr) {
         result->setNull(resultIndex, true);
       } else {
-        result->setNull(resultIndex, false);
         if constexpr (std::is_same_v<T, StringView>) {
           extractString(valueAt<StringView>(row, offset), result, resultIndex);
         } else {
@@ -1226,6 +1293,36 @@ class RowContainer {
   // complex-typed field in 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
 
+  // Updates the variable-width fields at 'columnIndex' of 'rows' after the
+  // string allocator moved the data as described by 'relocation'.
+  template <typename FieldType>
+  void relocateVariableWidthFieldsAtColumn(
+      size_t columnIndex,
+      folly::Range<char**> rows,
+      const HashStringAllocator::Relocation& relocation) {
+    const auto column = columnAt(columnIndex);
+    for (auto row : rows) {
+      if (isNullAt(row, column.nullByte(), column.nullMask())) {
+        continue;
+      }
+      auto& view = valueAt<FieldType>(row, column.offset());
+      if constexpr (std::is_same_v<FieldType, StringView>) {
+        if (view.isInline()) {
+          continue;
+        }
+      } else {
+        if (view.empty()) {
+          continue;
+        }
+      }
+      view = FieldType(relocation.relocate(view.data()), view.size());
+    }
+  }
+
+  // Updates the variable-width fields and accumulators of all rows after the
+  // string allocator moved the data as described by 'relocation'.
+  void relocateRows(const HashStringAllocator::Relocation& relocation);
+
   // Free any aggregates associated with the 'rows'.
   void freeAggregates(folly::Range<char**> rows);
 
@@ -18,6 +18,13 @@
 #include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Min average number of rows in a run of rows with the same partition keys
+// for the input batch to be probed one row per run. Comparing the keys of
+// adjacent rows costs less than hashing and probing but is wasted if the
+// runs are short.
+constexpr int32_t kMinClusteredRunLength = 4;
+} // namespace
 
 RowNumber::RowNumber(
     int32_t operatorId,
@@ -79,6 +86,7 @@ void RowNumber::addInput(RowVectorPtr input) {
     }
 
     SelectivityVector rows(numInput);
+    const bool clustered = clusteredInput_ && selectRunStarts(input, rows);
     table_->prepareForGroupProbe(
         *lookup_,
         input,
@@ -91,11 +99,57 @@ void RowNumber::addInput(RowVectorPtr input) {
     for (auto i : lookup_->newGroups) {
       setNumRows(lookup_->hits[i], 0);
     }
+
+    if (clustered) {
+      // The rows of a run after its first row are in the same partition.
+      auto& hits = lookup_->hits;
+      hits.resize(numInput);
+      for (auto i = 1; i < numInput; ++i) {
+        if (!rows.isValid(i)) {
+          hits[i] = hits[i - 1];
+        }
+      }
+      stats_.wlock()->addRuntimeStat(kNumClusteredBatches, RuntimeCounter(1));
+    }
   }
 
   input_ = std::move(input);
 }
 
+bool RowNumber::selectRunStarts(
+    const RowVectorPtr& input,
+    SelectivityVector& rows) {
+  const auto numInput = input->size();
+  if (numInput == 0) {
+    return false;
+  }
+  const auto maxRuns =
+      std::max<vector_size_t>(1, numInput / kMinClusteredRunLength);
+  std::vector<const BaseVector*> keys;
+  for (const auto& hasher : table_->hashers()) {
+    keys.push_back(input->childAt(hasher->channel())->loadedVector());
+  }
+
+  rows.clearAll();
+  rows.setValid(0, true);
+  vector_size_t numRuns = 1;
+  for (auto i = 1; i < numInput; ++i) {
+    for (const auto* key : keys) {
+      if (!key->equalValueAt(key, i, i - 1)) {
+        if (++numRuns > maxRuns) {
+          clusteredInput_ = false;
+          rows.setAll();
+          return false;
+        }
+        rows.setValid(i, true);
+        break;
+      }
+    }
+  }
+  rows.updateBounds();
+  return true;
+}
+
 void RowNumber::addSpillInput() {
   const auto numInput = input_->size();
   SelectivityVector rows(numInput);
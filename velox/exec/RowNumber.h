@@ -23,6 +23,10 @@ namespace facebook::velox::exec {
 
 class RowNumber : public Operator {
  public:
+  /// Runtime stat with the number of input batches that were probed into the
+  /// hash table one row per run of rows with the same partition keys.
+  static inline const std::string kNumClusteredBatches{"numClusteredBatches"};
+
   RowNumber(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -74,6 +78,13 @@ class RowNumber : public Operator {
 
   void setNumRows(char* partition, int64_t numRows);
 
+  // Selects in 'rows' the first row of each run of consecutive rows of
+  // 'input' with the same partition keys. Returns false and leaves all rows
+  // selected if the runs are too short for probing only their first rows to
+  // pay off. Then the input is taken as not clustered and the runs are not
+  // looked for in later input.
+  bool selectRunStarts(const RowVectorPtr& input, SelectivityVector& rows);
+
   RowVectorPtr getOutputForSinglePartition();
 
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
@@ -87,6 +98,12 @@ class RowNumber : public Operator {
   std::unique_ptr<HashLookup> lookup_;
   int32_t numRowsOffset_;
 
+  // True while the input is clustered on the partition keys, e.g. because it
+  // is sorted by them. Then only the first row of each run of rows with the
+  // same keys is probed into 'table_' and the other rows of the run share
+  // its partition.
+  bool clusteredInput_{true};
+
   // Total number of input rows. Used when there are no partitioning keys and
   // therefore no hash table.
   int64_t numTotalInput_{0};
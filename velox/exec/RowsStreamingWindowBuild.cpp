@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/RowsStreamingWindowBuild.h"
+
+namespace facebook::velox::exec {
+
+RowsStreamingWindowBuild::RowsStreamingWindowBuild(
+    const std::shared_ptr<const core::WindowNode>& windowNode,
+    velox::memory::MemoryPool* pool,
+    const common::SpillConfig* spillConfig,
+    tsan_atomic<bool>* nonReclaimableSection)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+
+void RowsStreamingWindowBuild::addPartitionRows(bool complete) {
+  if (outputPartition_ != nullptr) {
+    // The last partition is being output.
+    if (!inputRows_.empty()) {
+      outputPartition_->addRows(inputRows_);
+    }
+    if (complete) {
+      outputPartition_->setComplete();
+      outputPartition_ = nullptr;
+    }
+  } else if (!inputRows_.empty() || lastPendingOpen_) {
+    if (!lastPendingOpen_) {
+      pendingPartitions_.emplace_back();
+      lastPendingOpen_ = true;
+    }
+    auto& rows = pendingPartitions_.back();
+    rows.insert(rows.end(), inputRows_.begin(), inputRows_.end());
+    lastPendingOpen_ = !complete;
+  }
+  inputRows_.clear();
+}
+
+void RowsStreamingWindowBuild::addInput(RowVectorPtr input) {
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
+  }
+
+  for (auto row = 0; row < input->size(); ++row) {
+    char* newRow = data_->newRow();
+
+    for (auto col = 0; col < input->childrenSize(); ++col) {
+      data_->store(decodedInputVectors_[col], row, newRow, col);
+    }
+
+    if (previousRow_ != nullptr &&
+        compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
+      addPartitionRows(true);
+    }
+
+    inputRows_.push_back(newRow);
+    previousRow_ = newRow;
+  }
+  addPartitionRows(false);
+}
+
+void RowsStreamingWindowBuild::noMoreInput() {
+  addPartitionRows(true);
+}
+
+std::unique_ptr<WindowPartition> RowsStreamingWindowBuild::nextPartition() {
+  VELOX_CHECK(!pendingPartitions_.empty(), "No window partitions available");
+
+  auto partition = std::make_unique<WindowPartition>(
+      data_.get(), inversedInputChannels_, sortKeyInfo_);
+  partition->addRows(pendingPartitions_.front());
+  pendingPartitions_.pop_front();
+  if (pendingPartitions_.empty() && lastPendingOpen_) {
+    outputPartition_ = partition.get();
+    lastPendingOpen_ = false;
+  } else {
+    partition->setComplete();
+  }
+  return partition;
+}
+
+bool RowsStreamingWindowBuild::hasNextPartition() {
+  return !pendingPartitions_.empty();
+}
+
+} // namespace facebook::velox::exec
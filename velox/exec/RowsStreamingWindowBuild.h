@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/exec/WindowBuild.h"
+
+namespace facebook::velox::exec {
+
+/// The RowsStreamingWindowBuild is used when the input data is already sorted
+/// by {partition keys + order by keys} and all window functions compute a row
+/// from the rows up to it, e.g. row_number, rank or aggregates over ROWS frames
+/// that end at the current row. It hands out a partition as soon as it has
+/// rows and keeps adding the later input rows to it. The Window operator
+/// outputs the rows as they arrive and erases the rows that are before all
+/// frames, so the memory does not grow with the size of the partitions.
+class RowsStreamingWindowBuild : public WindowBuild {
+ public:
+  RowsStreamingWindowBuild(
+      const std::shared_ptr<const core::WindowNode>& windowNode,
+      velox::memory::MemoryPool* pool,
+      const common::SpillConfig* spillConfig,
+      tsan_atomic<bool>* nonReclaimableSection);
+
+  void addInput(RowVectorPtr input) override;
+
+  void spill() override {
+    VELOX_UNREACHABLE();
+  }
+
+  std::optional<common::SpillStats> spilledStats() const override {
+    return std::nullopt;
+  }
+
+  void noMoreInput() override;
+
+  bool hasNextPartition() override;
+
+  std::unique_ptr<WindowPartition> nextPartition() override;
+
+  bool needsInput() override {
+    // The Window operator takes new input after it has output all rows.
+    return true;
+  }
+
+ private:
+  // Adds 'inputRows_' to the last partition. 'complete' is true if the
+  // partition has no more rows.
+  void addPartitionRows(bool complete);
+
+  // Holds input rows of the last partition that are not added to it yet.
+  std::vector<char*> inputRows_;
+
+  // Rows of the partitions that are not handed out yet.
+  std::deque<std::vector<char*>> pendingPartitions_;
+
+  // True if the last of 'pendingPartitions_' may get more rows.
+  bool lastPendingOpen_{false};
+
+  // The last partition returned by nextPartition() while it may get more rows.
+  // The WindowPartition is owned by the Window operator.
+  WindowPartition* outputPartition_{nullptr};
+
+  // Used to compare rows based on partitionKeys.
+  char* previousRow_ = nullptr;
+};
+
+} // namespace facebook::velox::exec
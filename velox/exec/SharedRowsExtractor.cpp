@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SharedRowsExtractor.h"
+
+namespace facebook::velox::exec {
+
+bool SharedRowsExtractor::prepare(
+    folly::Range<char* const*> rows,
+    memory::MemoryPool* pool,
+    int32_t maxDistinctPct) {
+  rowIndices_.clear();
+  distinctRows_.clear();
+  numRows_ = rows.size();
+  const auto maxDistinct = rows.size() * maxDistinctPct / 100;
+  indices_ = allocateIndices(rows.size(), pool);
+  auto* rawIndices = indices_->asMutable<vector_size_t>();
+  for (auto i = 0; i < rows.size(); ++i) {
+    const auto [it, inserted] =
+        rowIndices_.try_emplace(rows[i], distinctRows_.size());
+    if (inserted) {
+      if (distinctRows_.size() >= maxDistinct) {
+        return false;
+      }
+      distinctRows_.push_back(rows[i]);
+    }
+    rawIndices[i] = it->second;
+  }
+  return true;
+}
+
+VectorPtr SharedRowsExtractor::extract(
+    RowContainer& container,
+    column_index_t column,
+    const TypePtr& type,
+    memory::MemoryPool* pool) const {
+  auto values = BaseVector::create(type, distinctRows_.size(), pool);
+  container.extractColumn(
+      distinctRows_.data(), distinctRows_.size(), column, values);
+  return BaseVector::wrapInDictionary(
+      nullptr, indices_, numRows_, std::move(values));
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Extracts columns of RowContainer rows where the same row can occur many
+/// times, as the build side rows of a many to many hash join where probe rows
+/// repeat keys. Each distinct row is extracted once into a flat vector that
+/// is wrapped in a dictionary giving the value for each occurrence. The
+/// dictionaries of all the columns share the indices.
+class SharedRowsExtractor {
+ public:
+  static constexpr int32_t kDefaultMaxDistinctPct = 50;
+
+  /// Finds the distinct rows of 'rows'. Returns true if at most
+  /// 'maxDistinctPct' percent of 'rows' are distinct, so that extract() saves
+  /// work. Otherwise, stops early and the rows should be extracted directly.
+  bool prepare(
+      folly::Range<char* const*> rows,
+      memory::MemoryPool* pool,
+      int32_t maxDistinctPct = kDefaultMaxDistinctPct);
+
+  /// Returns the values of 'column' of 'container' for the rows of the last
+  /// successful prepare(). A nullptr row gives a null.
+  VectorPtr extract(
+      RowContainer& container,
+      column_index_t column,
+      const TypePtr& type,
+      memory::MemoryPool* pool) const;
+
+  vector_size_t numDistinct() const {
+    return distinctRows_.size();
+  }
+
+ private:
+  // Maps a row to its position in 'distinctRows_'.
+  folly::F14FastMap<char*, vector_size_t> rowIndices_;
+  std::vector<char*> distinctRows_;
+  // The position in 'distinctRows_' for each row of the last prepare().
+  BufferPtr indices_;
+  vector_size_t numRows_{0};
+};
+
+} // namespace facebook::velox::exec
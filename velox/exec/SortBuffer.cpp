@@ -15,9 +15,97 @@
  */
 
 #include "SortBuffer.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/MemoryReclaimer.h"
 
 namespace facebook::velox::exec {
+namespace {
+// The min number of rows of each run sorted in parallel.
+constexpr size_t kParallelSortMinRunRows = 64 << 10;
+// The max number of runs sorted in parallel.
+constexpr size_t kParallelSortMaxRuns = 16;
+
+// Runs 'tasks' on 'executor' and waits for all of them. A task that has not
+// started when waited for runs on the calling thread. Rethrows the first
+// error after all tasks are done, since they reference the caller's state.
+void runInParallel(
+    std::vector<std::function<void()>> tasks,
+    folly::Executor* executor) {
+  std::vector<std::shared_ptr<AsyncSource<bool>>> sources;
+  sources.reserve(tasks.size());
+  for (auto& task : tasks) {
+    sources.push_back(std::make_shared<AsyncSource<bool>>(
+        [task = std::move(task)]() {
+          task();
+          return std::make_unique<bool>(true);
+        }));
+    executor->add([source = sources.back()]() { source->prepare(); });
+  }
+  std::exception_ptr error;
+  for (auto& source : sources) {
+    try {
+      source->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Sorts 'numRuns' runs of 'rows' in parallel, then merges pairs of runs in
+// parallel until one is left.
+template <typename Compare>
+void parallelSort(
+    std::vector<char*>& rows,
+    size_t numRuns,
+    Compare compare,
+    folly::Executor* executor) {
+  std::vector<size_t> bounds;
+  bounds.reserve(numRuns + 1);
+  for (auto i = 0; i <= numRuns; ++i) {
+    bounds.push_back(rows.size() * i / numRuns);
+  }
+  std::vector<std::function<void()>> tasks;
+  for (auto i = 0; i < numRuns; ++i) {
+    tasks.push_back([&, begin = bounds[i], end = bounds[i + 1]]() {
+      std::sort(rows.begin() + begin, rows.begin() + end, compare);
+    });
+  }
+  runInParallel(std::move(tasks), executor);
+
+  std::vector<char*> buffer(rows.size());
+  auto* source = &rows;
+  auto* target = &buffer;
+  while (bounds.size() > 2) {
+    std::vector<size_t> mergedBounds{0};
+    tasks.clear();
+    for (auto i = 0; i + 1 < bounds.size(); i += 2) {
+      const auto begin = bounds[i];
+      const auto middle = bounds[i + 1];
+      // An odd run at the end is copied.
+      const auto end = i + 2 < bounds.size() ? bounds[i + 2] : middle;
+      tasks.push_back([&, source, target, begin, middle, end]() {
+        std::merge(
+            source->begin() + begin,
+            source->begin() + middle,
+            source->begin() + middle,
+            source->begin() + end,
+            target->begin() + begin,
+            compare);
+      });
+      mergedBounds.push_back(end);
+    }
+    runInParallel(std::move(tasks), executor);
+    std::swap(source, target);
+    bounds = std::move(mergedBounds);
+  }
+  if (source != &rows) {
+    rows.swap(buffer);
+  }
+}
+} // namespace
 
 SortBuffer::SortBuffer(
     const RowTypePtr& input,
@@ -26,13 +114,17 @@ SortBuffer::SortBuffer(
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    folly::Executor* sortExecutor,
+    uint64_t parallelSortMinRows)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      sortExecutor_(sortExecutor),
+      parallelSortMinRows_(parallelSortMinRows) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -95,6 +187,26 @@ void SortBuffer::addInput(const VectorPtr& input) {
   numInputRows_ += allRows.size();
 }
 
+void SortBuffer::sortRows() {
+  const auto compare = [this](const char* leftRow, const char* rightRow) {
+    for (vector_size_t index = 0; index < sortCompareFlags_.size(); ++index) {
+      if (auto result = data_->compare(
+              leftRow, rightRow, index, sortCompareFlags_[index])) {
+        return result < 0;
+      }
+    }
+    return false;
+  };
+  const auto numRuns = std::min(
+      kParallelSortMaxRuns, sortedRows_.size() / kParallelSortMinRunRows);
+  if (sortExecutor_ == nullptr || parallelSortMinRows_ == 0 ||
+      sortedRows_.size() < parallelSortMinRows_ || numRuns < 2) {
+    std::sort(sortedRows_.begin(), sortedRows_.end(), compare);
+    return;
+  }
+  parallelSort(sortedRows_, numRuns, compare, sortExecutor_);
+}
+
 void SortBuffer::noMoreInput() {
   VELOX_CHECK(!noMoreInput_);
   noMoreInput_ = true;
@@ -112,19 +224,7 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    sortRows();
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -324,16 +424,55 @@ void SortBuffer::prepareOutput(uint32_t maxOutputRows) {
 
 void SortBuffer::getOutputWithoutSpill() {
   VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
+  auto* rows = sortedRows_.data() + numOutputRows_;
   for (const auto& columnProjection : columnMap_) {
+    auto& child = output_->childAt(columnProjection.outputChannel);
+    if (columnProjection.inputChannel == 0 &&
+        maybeExtractKeyRuns(rows, output_->size(), child)) {
+      continue;
+    }
     data_->extractColumn(
-        sortedRows_.data() + numOutputRows_,
-        output_->size(),
-        columnProjection.inputChannel,
-        output_->childAt(columnProjection.outputChannel));
+        rows, output_->size(), columnProjection.inputChannel, child);
   }
   numOutputRows_ += output_->size();
 }
 
+bool SortBuffer::maybeExtractKeyRuns(
+    char** rows,
+    vector_size_t size,
+    VectorPtr& result) {
+  // Below this many rows the runs are not worth finding.
+  constexpr vector_size_t kMinRows = 64;
+  // Strings are copied for each row when extracted, so a low cardinality
+  // string key is worth extracting once per run. Fixed width keys are not.
+  const auto kind = result->typeKind();
+  if (size < kMinRows ||
+      (kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY)) {
+    return false;
+  }
+  // The rows are sorted on the leading key, so equal keys are adjacent.
+  keyRunRows_.clear();
+  keyRunRows_.push_back(rows[0]);
+  auto indices = allocateIndices(size, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  rawIndices[0] = 0;
+  for (auto i = 1; i < size; ++i) {
+    if (data_->compare(keyRunRows_.back(), rows[i], 0, sortCompareFlags_[0]) !=
+        0) {
+      if (keyRunRows_.size() * 2 >= size) {
+        return false;
+      }
+      keyRunRows_.push_back(rows[i]);
+    }
+    rawIndices[i] = keyRunRows_.size() - 1;
+  }
+  auto values = BaseVector::create(result->type(), keyRunRows_.size(), pool_);
+  data_->extractColumn(keyRunRows_.data(), keyRunRows_.size(), 0, values);
+  result = BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), size, std::move(values));
+  return true;
+}
+
 void SortBuffer::getOutputWithSpill() {
   VELOX_CHECK_NOT_NULL(spillMerger_);
   VELOX_DCHECK_EQ(sortedRows_.size(), 0);
@@ -341,28 +480,42 @@ void SortBuffer::getOutputWithSpill() {
   int32_t outputRow = 0;
   int32_t outputSize = 0;
   bool isEndOfBatch = false;
+  const SpillMergeStream* previousStream{nullptr};
   while (outputRow + outputSize < output_->size()) {
     SpillMergeStream* stream = spillMerger_->next();
     VELOX_CHECK_NOT_NULL(stream);
-
-    spillSources_[outputSize] = &stream->current();
-    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
-    ++outputSize;
-    if (FOLLY_UNLIKELY(isEndOfBatch)) {
-      // The stream is at end of input batch. Need to copy out the rows before
-      // fetching next batch in 'pop'.
-      gatherCopy(
-          output_.get(),
-          outputRow,
-          outputSize,
-          spillSources_,
-          spillSourceRows_,
-          columnMap_);
-      outputRow += outputSize;
-      outputSize = 0;
+    // A stream that wins twice in a row is likely to hold a run of
+    // consecutive output rows. Its rows are then taken while they are not
+    // greater than the lowest row of the other streams, which needs one
+    // comparison per row instead of one per level of the merge tree.
+    const bool takeRun = stream == previousStream;
+    const SpillMergeStream* limit =
+        takeRun ? spillMerger_->runnerUp() : nullptr;
+    previousStream = stream;
+    for (;;) {
+      spillSources_[outputSize] = &stream->current();
+      spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
+      ++outputSize;
+      if (FOLLY_UNLIKELY(isEndOfBatch)) {
+        // The stream is at end of input batch. Need to copy out the rows
+        // before fetching next batch in 'pop'.
+        gatherCopy(
+            output_.get(),
+            outputRow,
+            outputSize,
+            spillSources_,
+            spillSourceRows_,
+            columnMap_);
+        outputRow += outputSize;
+        outputSize = 0;
+      }
+      // Advance the stream.
+      stream->pop();
+      if (!takeRun || outputRow + outputSize >= output_->size() ||
+          !stream->hasData() || (limit != nullptr && *limit < *stream)) {
+        break;
+      }
     }
-    // Advance the stream.
-    stream->pop();
   }
   VELOX_CHECK_EQ(outputRow + outputSize, output_->size());
 
@@ -381,8 +534,19 @@ void SortBuffer::getOutputWithSpill() {
 
 void SortBuffer::finishSpill() {
   VELOX_CHECK_NULL(spillMerger_);
-  auto spillPartition = spiller_->finishSpill();
-  spillMerger_ = spillPartition.createOrderedReader(pool(), spillStats_);
+  // Each merged file holds a read buffer, so the memory of the merge bounds
+  // the number of files to merge at a time.
+  size_t maxMergeFanIn{0};
+  if (spillConfig_->mergeMemoryBytes != 0) {
+    maxMergeFanIn = std::max<uint64_t>(
+        2, spillConfig_->mergeMemoryBytes / SpillReadFile::kMaxReadBufferSize);
+  }
+  auto spillPartition = spiller_->finishSpill(maxMergeFanIn);
+  spillMerger_ = spillPartition.createOrderedReader(
+      pool(),
+      spillStats_,
+      spillConfig_->executor,
+      spillConfig_->readPrefetchBytes);
 }
 
 } // namespace facebook::velox::exec
@@ -37,7 +37,9 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      folly::Executor* sortExecutor = nullptr,
+      uint64_t parallelSortMinRows = 0);
 
   void addInput(const VectorPtr& input);
 
@@ -68,9 +70,17 @@ class SortBuffer {
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
   void updateEstimatedOutputRowSize();
+  // Sorts 'sortedRows_', in parallel on 'sortExecutor_' if there are enough
+  // rows.
+  void sortRows();
   // Invoked to initialize or reset the reusable output buffer to get output.
   void prepareOutput(uint32_t maxOutputRows);
   void getOutputWithoutSpill();
+  // Extracts the leading sort key of the first 'size' rows of 'rows' into
+  // 'result' as a dictionary with one base value per run of equal keys if it
+  // is a string and the runs are long enough. Returns false if the key is to
+  // be extracted for each row.
+  bool maybeExtractKeyRuns(char** rows, vector_size_t size, VectorPtr& result);
   void getOutputWithSpill();
   // Spill during input stage.
   void spillInput();
@@ -89,6 +99,10 @@ class SortBuffer {
   tsan_atomic<bool>* const nonReclaimableSection_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  // Sorts runs of 'sortedRows_' in parallel if there are at least
+  // 'parallelSortMinRows_' rows.
+  folly::Executor* const sortExecutor_;
+  const uint64_t parallelSortMinRows_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -102,6 +116,9 @@ class SortBuffer {
   // Used to store the input data in row format.
   std::unique_ptr<RowContainer> data_;
   std::vector<char*> sortedRows_;
+  // The first row of each run of equal leading keys in an output batch. See
+  // maybeExtractKeyRuns().
+  std::vector<char*> keyRunRows_;
 
   // The data type of the rows stored in 'data_' and spilled on disk. The
   // sort key columns are stored first then the non-sorted data columns.
@@ -141,8 +141,7 @@ void SortWindowBuild::setupSpiller() {
   VELOX_CHECK_NULL(spiller_);
 
   spiller_ = std::make_unique<Spiller>(
-      // TODO Replace Spiller::Type::kOrderBy.
-      Spiller::Type::kOrderByInput,
+      Spiller::Type::kWindow,
       data_.get(),
       inputType_,
       spillCompareFlags_.size(),
@@ -152,6 +151,16 @@ void SortWindowBuild::setupSpiller() {
 }
 
 void SortWindowBuild::spill() {
+  if (merge_ != nullptr) {
+    // Only the partition being output is in memory.
+    return;
+  }
+
+  if (!partitionStartRows_.empty()) {
+    spillOutput();
+    return;
+  }
+
   if (spiller_ == nullptr) {
     setupSpiller();
   }
@@ -161,6 +170,45 @@ void SortWindowBuild::spill() {
   data_->pool()->release();
 }
 
+void SortWindowBuild::spillOutput() {
+  VELOX_CHECK_NULL(spiller_);
+  const vector_size_t numPartitions = partitionStartRows_.size() - 1;
+  if (currentPartition_ + 1 >= numPartitions) {
+    // The partition being output is the last one. Nothing to spill.
+    return;
+  }
+
+  setupSpiller();
+  // The rows of the partition being output are spilled too so that all the
+  // memory of 'data_' can be freed.
+  const auto firstPartition = std::max<vector_size_t>(currentPartition_, 0);
+  std::vector<char*> spillRows(
+      sortedRows_.begin() + partitionStartRows_[firstPartition],
+      sortedRows_.end());
+  spiller_->spill(spillRows);
+  spillRows.clear();
+  spillRows.shrink_to_fit();
+
+  data_->clear();
+  data_->pool()->release();
+  sortedRows_.clear();
+  sortedRows_.shrink_to_fit();
+  partitionStartRows_.clear();
+  partitionStartRows_.shrink_to_fit();
+
+  auto spillPartition = spiller_->finishSpill();
+  merge_ = spillPartition.createOrderedReader(pool_, spillStats_);
+
+  if (currentPartition_ >= 0) {
+    // Reads back the partition being output.
+    VELOX_CHECK_NOT_NULL(outputPartition_);
+    loadNextPartitionFromSpill();
+    outputPartition_->resetRows(
+        folly::Range(sortedRows_.data(), sortedRows_.size()));
+  }
+  outputPartition_ = nullptr;
+}
+
 // Use double front and back search algorithm to find next partition start row.
 // It is more efficient than linear or binary search.
 // This algorithm is described at
@@ -313,8 +361,10 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   auto partition = folly::Range(
       sortedRows_.data() + partitionStartRows_[currentPartition_],
       partitionSize);
-  return std::make_unique<WindowPartition>(
+  auto windowPartition = std::make_unique<WindowPartition>(
       data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
+  outputPartition_ = windowPartition.get();
+  return windowPartition;
 }
 
 bool SortWindowBuild::hasNextPartition() {
@@ -76,6 +76,11 @@ class SortWindowBuild : public WindowBuild {
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
   void loadNextPartitionFromSpill();
 
+  // Spills the partitions that are not yet fully output after noMoreInput().
+  // Rows of the partition being output are spilled as well and read back
+  // right away, so that 'data_' only holds that partition afterwards.
+  void spillOutput();
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
@@ -109,6 +114,11 @@ class SortWindowBuild : public WindowBuild {
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
 
+  // The last WindowPartition returned by nextPartition() before spilling. Its
+  // rows are reset if they are spilled and read back while it is being output.
+  // The WindowPartition is owned by the Window operator.
+  WindowPartition* outputPartition_{nullptr};
+
   // Spiller for contents of the 'data_'.
   std::unique_ptr<Spiller> spiller_;
 
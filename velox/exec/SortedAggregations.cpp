@@ -15,6 +15,7 @@
  */
 #include "velox/exec/SortedAggregations.h"
 #include "velox/common/base/RawVector.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -58,6 +59,30 @@ struct RowPointers {
     }
   }
 };
+
+/// Stores up to a fixed number of char* pointers to rows in RowContainer. The
+/// rows are a max-heap with the last row in sort order on top.
+struct BoundedRowPointers {
+  HashStringAllocator::Header* header{nullptr};
+  uint32_t size{0};
+
+  char** rows() const {
+    return reinterpret_cast<char**>(header->begin());
+  }
+
+  void free(HashStringAllocator& allocator) {
+    if (header != nullptr) {
+      allocator.free(header);
+      header = nullptr;
+    }
+  }
+
+  void read(folly::Range<char**> result) const {
+    if (size > 0) {
+      std::copy(rows(), rows() + size, result.begin());
+    }
+  }
+};
 } // namespace
 
 SortedAggregations::SortedAggregations(
@@ -86,14 +111,34 @@ SortedAggregations::SortedAggregations(
     }
   }
 
+  // The sorting keys of the first aggregate go right after the group column
+  // so that PrefixSort can sort on these.
+  const auto& firstSortingKeys = aggregates[0]->sortingKeys;
+  const bool bulkSort =
+      std::unordered_set<column_index_t>(
+          firstSortingKeys.begin(), firstSortingKeys.end())
+          .size() == firstSortingKeys.size();
+  std::vector<column_index_t> leadingInputs;
+  if (bulkSort) {
+    leadingInputs = firstSortingKeys;
+    for (auto input : leadingInputs) {
+      allInputs.erase(input);
+    }
+  }
+
   inputMapping_.resize(inputType->size());
 
-  std::vector<TypePtr> types;
-  for (auto input : allInputs) {
+  std::vector<TypePtr> types{BIGINT()};
+  auto addInputColumn = [&](column_index_t input) {
+    inputMapping_[input] = types.size();
     types.push_back(inputType->childAt(input));
-
-    inputMapping_[input] = inputs_.size();
     inputs_.push_back(input);
+  };
+  for (auto input : leadingInputs) {
+    addInputColumn(input);
+  }
+  for (auto input : allInputs) {
+    addInputColumn(input);
   }
 
   inputData_ = std::make_unique<RowContainer>(types, pool);
@@ -107,6 +152,30 @@ SortedAggregations::SortedAggregations(
             .first;
     it->second.push_back(aggregate);
   }
+
+  if (bulkSort) {
+    bulkSortingSpec_ = toSortingSpec(*aggregates[0]);
+    // The order of the groups does not matter.
+    bulkSortCompareFlags_.push_back(CompareFlags());
+    for (const auto& [column, sortOrder] : bulkSortingSpec_.value()) {
+      bulkSortCompareFlags_.push_back(
+          {sortOrder.isNullsFirst(), sortOrder.isAscending(), false});
+    }
+  }
+
+  if (aggregates_.size() == 1) {
+    for (const auto* aggregate : aggregates) {
+      if (!aggregate->sortedInputLimit.has_value() || aggregate->mask) {
+        sortedInputLimit_.reset();
+        break;
+      }
+      sortedInputLimit_ = std::max(
+          sortedInputLimit_.value_or(0), aggregate->sortedInputLimit.value());
+    }
+    if (sortedInputLimit_.has_value()) {
+      VELOX_CHECK_GT(sortedInputLimit_.value(), 0);
+    }
+  }
 }
 
 std::unique_ptr<SortedAggregations> SortedAggregations::create(
@@ -143,7 +212,7 @@ SortedAggregations::SortingSpec SortedAggregations::toSortingSpec(
 Accumulator SortedAggregations::accumulator() const {
   return {
       false,
-      sizeof(RowPointers),
+      std::max(sizeof(RowPointers), sizeof(BoundedRowPointers)),
       false,
       1,
       ARRAY(VARBINARY()),
@@ -152,12 +221,44 @@ Accumulator SortedAggregations::accumulator() const {
       },
       [this](folly::Range<char**> groups) {
         for (auto* group : groups) {
-          auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-          accumulator->free(*allocator_);
+          if (sortedInputLimit_.has_value()) {
+            reinterpret_cast<BoundedRowPointers*>(group + offset_)
+                ->free(*allocator_);
+          } else {
+            reinterpret_cast<RowPointers*>(group + offset_)->free(*allocator_);
+          }
         }
       }};
 }
 
+size_t SortedAggregations::numGroupRows(char* group) const {
+  if (sortedInputLimit_.has_value()) {
+    return reinterpret_cast<BoundedRowPointers*>(group + offset_)->size;
+  }
+  return reinterpret_cast<RowPointers*>(group + offset_)->size;
+}
+
+void SortedAggregations::readGroupRows(char* group, folly::Range<char**> rows)
+    const {
+  if (sortedInputLimit_.has_value()) {
+    reinterpret_cast<BoundedRowPointers*>(group + offset_)->read(rows);
+  } else {
+    reinterpret_cast<RowPointers*>(group + offset_)->read(rows);
+  }
+}
+
+void SortedAggregations::setRowGroup(char* row, char* group) const {
+  const auto column = inputData_->columnAt(kGroupColumn);
+  row[column.nullByte()] &= ~column.nullMask();
+  *reinterpret_cast<int64_t*>(row + column.offset()) =
+      reinterpret_cast<int64_t>(group);
+}
+
+char* SortedAggregations::rowGroup(const char* row) const {
+  return reinterpret_cast<char*>(*reinterpret_cast<const int64_t*>(
+      row + inputData_->columnAt(kGroupColumn).offset()));
+}
+
 void SortedAggregations::extractForSpill(
     folly::Range<char**> groups,
     VectorPtr& result) const {
@@ -171,20 +272,16 @@ void SortedAggregations::extractForSpill(
 
   vector_size_t offset = 0;
   for (auto i = 0; i < groups.size(); ++i) {
-    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
-    rawSizes[i] = accumulator->size;
+    rawSizes[i] = numGroupRows(groups[i]);
     rawOffsets[i] = offset;
-    offset += accumulator->size;
+    offset += rawSizes[i];
   }
 
   std::vector<char*> groupRows(offset);
 
-  offset = 0;
   for (auto i = 0; i < groups.size(); ++i) {
-    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
-    accumulator->read(
-        folly::Range(groupRows.data() + offset, accumulator->size));
-    offset += accumulator->size;
+    readGroupRows(
+        groups[i], folly::Range(groupRows.data() + rawOffsets[i], rawSizes[i]));
   }
 
   auto& elementsVector = arrayVector->elements();
@@ -202,7 +299,11 @@ void SortedAggregations::initializeNewGroups(
     folly::Range<const vector_size_t*> indices) {
   for (auto i : indices) {
     groups[i][nullByte_] |= nullMask_;
-    new (groups[i] + offset_) RowPointers();
+    if (sortedInputLimit_.has_value()) {
+      new (groups[i] + offset_) BoundedRowPointers();
+    } else {
+      new (groups[i] + offset_) RowPointers();
+    }
     groups[i][initializedByte_] |= initializedMask_;
   }
 
@@ -213,45 +314,75 @@ void SortedAggregations::initializeNewGroups(
   }
 }
 
-void SortedAggregations::addInput(char** groups, const RowVectorPtr& input) {
+void SortedAggregations::decodeInputs(const RowVectorPtr& input) {
   for (auto i = 0; i < inputs_.size(); ++i) {
     decodedInputs_[i].decode(*input->childAt(inputs_[i]));
   }
+}
 
-  // Add all the rows into the RowContainer.
-  for (auto row = 0; row < input->size(); ++row) {
-    char* newRow = inputData_->newRow();
+char* SortedAggregations::storeInputRow(vector_size_t row) {
+  char* newRow = inputData_->newRow();
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputData_->store(decodedInputs_[i], row, newRow, i + 1);
+  }
+  return newRow;
+}
 
-    for (auto i = 0; i < inputs_.size(); ++i) {
-      inputData_->store(decodedInputs_[i], row, newRow, i);
-    }
+void SortedAggregations::addInput(char** groups, const RowVectorPtr& input) {
+  decodeInputs(input);
 
-    addNewRow(groups[row], newRow);
+  // Add all the rows into the RowContainer.
+  for (auto row = 0; row < input->size(); ++row) {
+    addNewRow(groups[row], storeInputRow(row));
   }
 }
 
 void SortedAggregations::addNewRow(char* group, char* newRow) {
-  auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
+  setRowGroup(newRow, group);
   RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+  if (sortedInputLimit_.has_value()) {
+    addBoundedRow(group, newRow);
+    return;
+  }
+  auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
   accumulator->append(newRow, *allocator_);
 }
 
+void SortedAggregations::addBoundedRow(char* group, char* newRow) {
+  auto* accumulator = reinterpret_cast<BoundedRowPointers*>(group + offset_);
+  const auto& sortingSpec = aggregates_.begin()->first;
+  auto lessThan = [&](const char* lhs, const char* rhs) {
+    return compareRowsWithKeys(lhs, rhs, sortingSpec);
+  };
+  const auto limit = sortedInputLimit_.value();
+  if (accumulator->header == nullptr) {
+    accumulator->header = allocator_->allocate(limit * sizeof(char*));
+  }
+  auto* rows = accumulator->rows();
+  if (accumulator->size < limit) {
+    rows[accumulator->size++] = newRow;
+    std::push_heap(rows, rows + accumulator->size, lessThan);
+    return;
+  }
+  if (!lessThan(newRow, rows[0])) {
+    inputData_->eraseRows(folly::Range<char**>(&newRow, 1));
+    return;
+  }
+  // Replaces the last row in sort order.
+  std::pop_heap(rows, rows + limit, lessThan);
+  inputData_->eraseRows(folly::Range<char**>(&rows[limit - 1], 1));
+  rows[limit - 1] = newRow;
+  std::push_heap(rows, rows + limit, lessThan);
+}
+
 void SortedAggregations::addSingleGroupInput(
     char* group,
     const RowVectorPtr& input) {
-  for (auto i = 0; i < inputs_.size(); ++i) {
-    decodedInputs_[i].decode(*input->childAt(inputs_[i]));
-  }
+  decodeInputs(input);
 
   // Add all the rows into the RowContainer.
   for (auto row = 0; row < input->size(); ++row) {
-    char* newRow = inputData_->newRow();
-
-    for (auto i = 0; i < inputs_.size(); ++i) {
-      inputData_->store(decodedInputs_[i], row, newRow, i);
-    }
-
-    addNewRow(group, newRow);
+    addNewRow(group, storeInputRow(row));
   }
 }
 
@@ -302,7 +433,7 @@ void SortedAggregations::sortSingleGroup(
 }
 
 vector_size_t SortedAggregations::extractSingleGroup(
-    std::vector<char*>& groupRows,
+    folly::Range<char**> groupRows,
     const AggregateInfo& aggregate,
     std::vector<VectorPtr>& inputVectors) {
   const auto numGroupRows = groupRows.size();
@@ -363,6 +494,41 @@ vector_size_t SortedAggregations::extractSingleGroup(
   return numRows;
 }
 
+void SortedAggregations::addSortedGroupRows(
+    char* group,
+    folly::Range<char**> groupRows,
+    const std::vector<const AggregateInfo*>& aggregates,
+    std::vector<VectorPtr>& inputVectors,
+    SelectivityVector& rows) {
+  size_t firstInputColumn = 0;
+  for (const auto& aggregate : aggregates) {
+    std::vector<VectorPtr> aggregateInputs;
+    aggregateInputs.reserve(aggregate->inputs.size());
+    for (auto i = 0; i < aggregate->inputs.size(); ++i) {
+      aggregateInputs.push_back(std::move(inputVectors[firstInputColumn + i]));
+    }
+
+    // TODO Process group rows in batches to avoid creating very large input
+    // vectors.
+    const auto numRows =
+        extractSingleGroup(groupRows, *aggregate, aggregateInputs);
+    if (numRows == 0) {
+      // Mask must be false for all 'groupRows'.
+      continue;
+    }
+
+    rows.resize(numRows);
+    aggregate->function->addSingleGroupRawInput(
+        group, rows, aggregateInputs, false);
+
+    for (auto i = 0; i < aggregate->inputs.size(); ++i) {
+      inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
+    }
+
+    firstInputColumn += aggregateInputs.size();
+  }
+}
+
 void SortedAggregations::extractValues(
     folly::Range<char**> groups,
     const RowVectorPtr& result) {
@@ -377,45 +543,61 @@ void SortedAggregations::extractValues(
     }
     inputVectors.resize(numInputColumns);
 
-    // For each group, sort inputs, add them to aggregate.
-    for (auto* group : groups) {
-      auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-      if (accumulator->size == 0) {
-        continue;
+    if (bulkSortingSpec_.has_value() && sortingSpec == *bulkSortingSpec_) {
+      // Sorts the rows of all groups together on the group and the sorting
+      // keys, so that the rows of each group are consecutive and sorted.
+      size_t numRows = 0;
+      for (auto* group : groups) {
+        numRows += numGroupRows(group);
       }
-
-      groupRows.resize(accumulator->size);
-      accumulator->read(folly::Range(groupRows.data(), groupRows.size()));
-
-      sortSingleGroup(groupRows, sortingSpec);
-
-      size_t firstInputColumn = 0;
-      for (const auto& aggregate : aggregates) {
-        std::vector<VectorPtr> aggregateInputs;
-        aggregateInputs.reserve(aggregate->inputs.size());
-        for (auto i = 0; i < aggregate->inputs.size(); ++i) {
-          aggregateInputs.push_back(
-              std::move(inputVectors[firstInputColumn + i]));
+      groupRows.resize(numRows);
+      size_t offset = 0;
+      for (auto* group : groups) {
+        const auto numRowsInGroup = numGroupRows(group);
+        readGroupRows(
+            group, folly::Range(groupRows.data() + offset, numRowsInGroup));
+        offset += numRowsInGroup;
+      }
+      PrefixSort::sort(
+          groupRows,
+          inputData_->pool(),
+          inputData_.get(),
+          bulkSortCompareFlags_,
+          PrefixSortConfig(kMaxNormalizedKeySize));
+
+      for (size_t begin = 0; begin < groupRows.size();) {
+        auto* group = rowGroup(groupRows[begin]);
+        auto end = begin + 1;
+        while (end < groupRows.size() && rowGroup(groupRows[end]) == group) {
+          ++end;
         }
-
-        // TODO Process group rows in batches to avoid creating very large input
-        // vectors.
-        const auto numRows =
-            extractSingleGroup(groupRows, *aggregate, aggregateInputs);
+        addSortedGroupRows(
+            group,
+            folly::Range(groupRows.data() + begin, end - begin),
+            aggregates,
+            inputVectors,
+            rows);
+        begin = end;
+      }
+    } else {
+      // For each group, sort inputs, add them to aggregate.
+      for (auto* group : groups) {
+        const auto numRows = numGroupRows(group);
         if (numRows == 0) {
-          // Mask must be false for all 'groupRows'.
           continue;
         }
 
-        rows.resize(numRows);
-        aggregate->function->addSingleGroupRawInput(
-            group, rows, aggregateInputs, false);
+        groupRows.resize(numRows);
+        readGroupRows(group, folly::Range(groupRows.data(), numRows));
 
-        for (auto i = 0; i < aggregate->inputs.size(); ++i) {
-          inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
-        }
+        sortSingleGroup(groupRows, sortingSpec);
 
-        firstInputColumn += aggregateInputs.size();
+        addSortedGroupRows(
+            group,
+            folly::Range(groupRows.data(), numRows),
+            aggregates,
+            inputVectors,
+            rows);
       }
     }
 
@@ -23,7 +23,12 @@
 namespace facebook::velox::exec {
 
 /// Accumulates inputs for aggregations over sorted input, sorts these inputs
-/// and computes aggregates.
+/// and computes aggregates. The rows of the groups to extract are sorted
+/// together with PrefixSort on the group and the sorting keys of the first
+/// aggregate. Aggregates with other sorting keys sort each group separately.
+/// If all the aggregates have the same sorting keys and only need a bounded
+/// number of leading inputs, see AggregateInfo::sortedInputLimit, each group
+/// keeps only these inputs in a heap.
 class SortedAggregations {
  public:
   /// @param aggregates Non-empty list of aggregates that require inputs to be
@@ -86,8 +91,35 @@ class SortedAggregations {
   void clear();
 
  private:
+  // Column of 'inputData_' that holds the group of each row as a BIGINT.
+  static constexpr column_index_t kGroupColumn = 0;
+
+  // Max number of bytes of the normalized keys of a row for PrefixSort.
+  static constexpr uint32_t kMaxNormalizedKeySize = 1'024;
+
+  void decodeInputs(const RowVectorPtr& input);
+
+  // Stores row 'row' of the decoded inputs in a new row of 'inputData_'.
+  char* storeInputRow(vector_size_t row);
+
   void addNewRow(char* group, char* newRow);
 
+  // Adds 'newRow' to the rows of 'group' if it is among the first
+  // 'sortedInputLimit_' rows of the group in sort order. Erases 'newRow' or
+  // the row it displaces.
+  void addBoundedRow(char* group, char* newRow);
+
+  // Returns the number of rows accumulated for 'group'.
+  size_t numGroupRows(char* group) const;
+
+  // Copies the rows accumulated for 'group' to 'rows', which has
+  // numGroupRows(group) elements.
+  void readGroupRows(char* group, folly::Range<char**> rows) const;
+
+  void setRowGroup(char* row, char* group) const;
+
+  char* rowGroup(const char* row) const;
+
   // A list of sorting keys along with sorting orders.
   using SortingSpec = std::vector<std::pair<column_index_t, core::SortOrder>>;
 
@@ -103,10 +135,19 @@ class SortedAggregations {
       const SortingSpec& sortingSpec);
 
   vector_size_t extractSingleGroup(
-      std::vector<char*>& groupRows,
+      folly::Range<char**> groupRows,
       const AggregateInfo& aggregate,
       std::vector<VectorPtr>& inputVectors);
 
+  // Adds the sorted 'groupRows' of 'group' to 'aggregates'. 'inputVectors'
+  // holds reusable input vectors for all of 'aggregates'.
+  void addSortedGroupRows(
+      char* group,
+      folly::Range<char**> groupRows,
+      const std::vector<const AggregateInfo*>& aggregates,
+      std::vector<VectorPtr>& inputVectors,
+      SelectivityVector& rows);
+
   void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
   struct Hash {
@@ -143,15 +184,28 @@ class SortedAggregations {
       F14FastMap<SortingSpec, std::vector<const AggregateInfo*>, Hash, EqualTo>
           aggregates_;
 
-  // Indices of all inputs for all aggregates.
+  // Indices of all inputs for all aggregates. 'inputs_[i]' is stored in
+  // column i + 1 of 'inputData_', after 'kGroupColumn'.
   std::vector<column_index_t> inputs_;
 
   // Stores all input rows for all groups.
   std::unique_ptr<RowContainer> inputData_;
 
-  // Mapping from the input column index to an index into 'inputs_'.
+  // Mapping from the input column index to a column of 'inputData_'.
   std::vector<column_index_t> inputMapping_;
 
+  // The sorting keys whose columns follow 'kGroupColumn' in 'inputData_', so
+  // that the rows of many groups are sorted together with PrefixSort on
+  // 'bulkSortCompareFlags_'. Not set if the sorting keys of the first
+  // aggregate repeat a column.
+  std::optional<SortingSpec> bulkSortingSpec_;
+  std::vector<CompareFlags> bulkSortCompareFlags_;
+
+  // Number of rows to keep for each group if all the aggregates only need a
+  // bounded number of leading inputs. Groups then accumulate
+  // BoundedRowPointers instead of RowPointers.
+  std::optional<uint32_t> sortedInputLimit_;
+
   std::vector<DecodedVector> decodedInputs_;
 
   HashStringAllocator* allocator_;
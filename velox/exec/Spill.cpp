@@ -15,25 +15,145 @@
  */
 
 #include "velox/exec/Spill.h"
+
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+template <typename T>
+FOLLY_ALWAYS_INLINE T
+flatValueAt(const BaseVector& vector, vector_size_t index) {
+  return vector.asUnchecked<FlatVector<T>>()->valueAtFast(index);
+}
+
+// Flips the sign bit so that the unsigned order of the result is the signed
+// order of 'value'.
+FOLLY_ALWAYS_INLINE uint64_t integerPrefix(int64_t value) {
+  return static_cast<uint64_t>(value) ^ (1ULL << 63);
+}
+
+// Orders like SimpleVector::comparePrimitiveAsc: -0 equals 0 and all NaNs are
+// equal and greater than any other value.
+FOLLY_ALWAYS_INLINE uint64_t floatingPointPrefix(double value) {
+  if (std::isnan(value)) {
+    return ~0ULL;
+  }
+  if (value == 0) {
+    value = 0;
+  }
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & (1ULL << 63)) != 0 ? ~bits : bits | (1ULL << 63);
+}
+
+// Returns the first 8 bytes of 'value' as a big endian integer, padded with
+// zeros if 'value' is shorter.
+FOLLY_ALWAYS_INLINE uint64_t stringPrefix(StringView value) {
+  uint64_t bytes = 0;
+  std::memcpy(&bytes, value.data(), std::min<size_t>(value.size(), 8));
+  return folly::Endian::big(bytes);
+}
+} // namespace
+
 void SpillMergeStream::pop() {
+  prefixValid_ = false;
   if (++index_ >= size_) {
     setNextBatch();
   }
 }
 
+bool SpillMergeStream::ensurePrefix() const {
+  if (prefixValid_) {
+    return true;
+  }
+  const auto& key = *rowVector_->childAt(0);
+  if (key.encoding() != VectorEncoding::Simple::FLAT) {
+    return false;
+  }
+  switch (key.typeKind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      prefixComplete_ = true;
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      prefixComplete_ = false;
+      break;
+    default:
+      return false;
+  }
+  prefixNull_ = key.isNullAt(index_);
+  prefix_ = 0;
+  if (!prefixNull_) {
+    switch (key.typeKind()) {
+      case TypeKind::BOOLEAN:
+        prefix_ = flatValueAt<bool>(key, index_);
+        break;
+      case TypeKind::TINYINT:
+        prefix_ = integerPrefix(flatValueAt<int8_t>(key, index_));
+        break;
+      case TypeKind::SMALLINT:
+        prefix_ = integerPrefix(flatValueAt<int16_t>(key, index_));
+        break;
+      case TypeKind::INTEGER:
+        prefix_ = integerPrefix(flatValueAt<int32_t>(key, index_));
+        break;
+      case TypeKind::BIGINT:
+        prefix_ = integerPrefix(flatValueAt<int64_t>(key, index_));
+        break;
+      case TypeKind::REAL:
+        prefix_ = floatingPointPrefix(flatValueAt<float>(key, index_));
+        break;
+      case TypeKind::DOUBLE:
+        prefix_ = floatingPointPrefix(flatValueAt<double>(key, index_));
+        break;
+      default:
+        prefix_ = stringPrefix(flatValueAt<StringView>(key, index_));
+        break;
+    }
+    if (!sortCompareFlags().empty() && !sortCompareFlags()[0].ascending) {
+      prefix_ = ~prefix_;
+    }
+  }
+  prefixValid_ = true;
+  return true;
+}
+
 int32_t SpillMergeStream::compare(const MergeStream& other) const {
   auto& otherStream = static_cast<const SpillMergeStream&>(other);
+  int32_t key = 0;
+  if (ensurePrefix() && otherStream.ensurePrefix()) {
+    if (prefixNull_ != otherStream.prefixNull_) {
+      const bool nullsFirst =
+          sortCompareFlags().empty() || sortCompareFlags()[0].nullsFirst;
+      return prefixNull_ == nullsFirst ? -1 : 1;
+    }
+    if (prefix_ != otherStream.prefix_) {
+      return prefix_ < otherStream.prefix_ ? -1 : 1;
+    }
+    if (prefixComplete_) {
+      // The first keys are equal.
+      if (numSortKeys() <= 1) {
+        return 0;
+      }
+      key = 1;
+    }
+  }
   auto& children = rowVector_->children();
   auto& otherChildren = otherStream.current().children();
-  int32_t key = 0;
   if (sortCompareFlags().empty()) {
     do {
       auto result = children[key]
@@ -76,7 +196,9 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor,
+    uint32_t compressionDictionaryBytes)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -89,6 +211,8 @@ SpillState::SpillState(
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
+      writeExecutor_(writeExecutor),
+      compressionDictionaryBytes_(compressionDictionaryBytes),
       partitionWriters_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(uint32_t partition) {
@@ -132,7 +256,9 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_,
+        compressionDictionaryBytes_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -174,6 +300,151 @@ SpillFiles SpillState::finish(uint32_t partition) {
   return writer->finish();
 }
 
+namespace {
+// Merges the sorted files in 'files' from 'begin' to 'end' into the current
+// file of 'writer' and removes them.
+void mergeSpillFiles(
+    const SpillFiles& files,
+    size_t begin,
+    size_t end,
+    SpillWriter& writer,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* stats) {
+  static constexpr vector_size_t kBatchRows = 1024;
+  {
+    std::vector<std::unique_ptr<SpillMergeStream>> streams;
+    streams.reserve(end - begin);
+    for (auto i = begin; i < end; ++i) {
+      streams.push_back(FileSpillMergeStream::create(
+          SpillReadFile::create(files[i], pool, stats)));
+    }
+    TreeOfLosers<SpillMergeStream> merge(std::move(streams));
+
+    std::vector<const RowVector*> sources(kBatchRows);
+    std::vector<vector_size_t> sourceRows(kBatchRows);
+    RowVectorPtr batch;
+    vector_size_t numBatchRows{0};
+    vector_size_t numSourceRows{0};
+    // Copies the rows in 'sources' to 'batch'.
+    auto copySourceRows = [&]() {
+      if (numSourceRows == 0) {
+        return;
+      }
+      if (batch == nullptr) {
+        batch = BaseVector::create<RowVector>(
+            files[begin].type, kBatchRows, pool);
+      }
+      gatherCopy(batch.get(), numBatchRows, numSourceRows, sources, sourceRows);
+      numBatchRows += numSourceRows;
+      numSourceRows = 0;
+    };
+    auto writeBatch = [&]() {
+      copySourceRows();
+      if (numBatchRows == 0) {
+        return;
+      }
+      batch->resize(numBatchRows);
+      IndexRange range{0, numBatchRows};
+      writer.write(batch, folly::Range<IndexRange*>(&range, 1));
+      batch = nullptr;
+      numBatchRows = 0;
+    };
+
+    const SpillMergeStream* previousStream{nullptr};
+    bool isEndOfBatch{false};
+    while (auto* stream = merge.next()) {
+      // Takes runs from a stream that wins twice in a row like
+      // SortBuffer::getOutputWithSpill().
+      const bool takeRun = stream == previousStream;
+      const SpillMergeStream* limit = takeRun ? merge.runnerUp() : nullptr;
+      previousStream = stream;
+      for (;;) {
+        sources[numSourceRows] = &stream->current();
+        sourceRows[numSourceRows] = stream->currentIndex(&isEndOfBatch);
+        ++numSourceRows;
+        if (numBatchRows + numSourceRows == kBatchRows) {
+          writeBatch();
+        } else if (isEndOfBatch) {
+          // Copies out the rows before 'pop' fetches the next batch.
+          copySourceRows();
+        }
+        stream->pop();
+        if (!takeRun || !stream->hasData() ||
+            (limit != nullptr && *limit < *stream)) {
+          break;
+        }
+      }
+    }
+    writeBatch();
+  }
+  for (auto i = begin; i < end; ++i) {
+    auto fs = filesystems::getFileSystem(files[i].path, nullptr);
+    fs->remove(files[i].path);
+  }
+}
+} // namespace
+
+SpillFiles SpillState::mergeFiles(
+    uint32_t partition,
+    SpillFiles files,
+    size_t maxFanIn,
+    const common::RemovedSpillBytesCB& removedSpillBytesCb) {
+  VELOX_CHECK_GE(maxFanIn, 2);
+  uint64_t removedBytes{0};
+  for (auto pass = 0; files.size() > maxFanIn; ++pass) {
+    VELOX_CHECK_NOT_NULL(
+        getSpillDirPathCb_, "Spill directory callback not specified.");
+    const auto spillDir = getSpillDirPathCb_();
+    // Each merged group is written as a single file, so the target file size
+    // is not limited.
+    SpillWriter writer(
+        files[0].type,
+        numSortKeys_,
+        sortCompareFlags_,
+        compressionKind_,
+        fmt::format(
+            "{}/{}-spill-{}-merge-{}",
+            spillDir,
+            fileNamePrefix_,
+            partition,
+            pass),
+        std::numeric_limits<uint64_t>::max(),
+        writeBufferSize_,
+        fileCreateConfig_,
+        updateAndCheckSpillLimitCb_,
+        pool_,
+        stats_,
+        writeExecutor_,
+        compressionDictionaryBytes_);
+    const auto numGroups = (files.size() + maxFanIn - 1) / maxFanIn;
+    SpillFiles unmergedFiles;
+    size_t begin = 0;
+    for (auto group = 0; group < numGroups; ++group) {
+      const auto end = begin + (files.size() - begin) / (numGroups - group);
+      if (end - begin == 1) {
+        unmergedFiles.push_back(std::move(files[begin]));
+      } else {
+        mergeSpillFiles(files, begin, end, writer, pool_, stats_);
+        writer.finishFile();
+        for (auto i = begin; i < end; ++i) {
+          removedBytes += files[i].size;
+        }
+      }
+      begin = end;
+    }
+    VELOX_CHECK_EQ(begin, files.size());
+    files = writer.finish();
+    files.insert(
+        files.end(),
+        std::make_move_iterator(unmergedFiles.begin()),
+        std::make_move_iterator(unmergedFiles.end()));
+  }
+  if (removedSpillBytesCb != nullptr && removedBytes > 0) {
+    removedSpillBytesCb(removedBytes);
+  }
+  return files;
+}
+
 const SpillPartitionNumSet& SpillState::spilledPartitionSet() const {
   return spilledPartitionSet_;
 }
@@ -257,12 +528,20 @@ SpillPartition::createUnorderedReader(
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* prefetchExecutor,
+    uint64_t prefetchBytes) {
+  std::shared_ptr<SpillPrefetchBudget> prefetchBudget;
+  if (prefetchExecutor != nullptr && prefetchBytes != 0) {
+    prefetchBudget = std::make_shared<SpillPrefetchBudget>(prefetchBytes);
+  } else {
+    prefetchExecutor = nullptr;
+  }
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, pool, spillStats, prefetchExecutor, prefetchBudget)));
   }
   files_.clear();
   // Check if the partition is empty or not.
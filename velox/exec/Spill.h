@@ -49,6 +49,9 @@ class SpillMergeStream : public MergeStream {
     return compare(other) < 0;
   }
 
+  /// Compares the current rows of 'this' and 'other'. The first sort key is
+  /// first compared on a cached normalized prefix, see ensurePrefix(), and the
+  /// full rows are only compared if the prefixes are equal.
   int32_t compare(const MergeStream& other) const override;
 
   void pop();
@@ -110,6 +113,14 @@ class SpillMergeStream : public MergeStream {
     }
   }
 
+  // Sets 'prefix_' and 'prefixNull_' for the first sort key of the current
+  // row if not set yet. The prefix is an unsigned integer that orders like the
+  // key: the sign bit flipped for integers, the sign adjusted bits for floating
+  // point and the first 8 bytes in big endian order for strings, inverted for
+  // a descending key. Returns false if the key has no prefix, e.g. because it
+  // is of a complex type or not flat.
+  bool ensurePrefix() const;
+
   // Current batch of rows.
   RowVectorPtr rowVector_;
 
@@ -125,6 +136,16 @@ class SpillMergeStream : public MergeStream {
 
   // Covers all rows inn 'rowVector_' Set if 'decoded_' is non-empty.
   SelectivityVector rows_;
+
+  // The normalized prefix of the first sort key of the current row and
+  // whether the key is null. Valid if 'prefixValid_' is true. Reset by
+  // pop().
+  mutable uint64_t prefix_{0};
+  mutable bool prefixNull_{false};
+  mutable bool prefixValid_{false};
+  // True if equal prefixes mean equal first sort keys, which is the case for
+  // all but string keys.
+  mutable bool prefixComplete_{false};
 };
 
 // A source of spilled RowVectors coming from a file.
@@ -299,10 +320,15 @@ class SpillPartition {
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'spillStats' is provided to collect the spill stats when reading data from
-  /// spilled files.
+  /// spilled files. If 'prefetchExecutor' is set and 'prefetchBytes' is not
+  /// zero, each spill file is read ahead on 'prefetchExecutor' while the merge
+  /// runs. 'prefetchBytes' caps the total memory used for read-ahead by all
+  /// the files of the reader.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* prefetchExecutor = nullptr,
+      uint64_t prefetchBytes = 0);
 
   std::string toString() const;
 
@@ -326,7 +352,9 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'writeExecutor' is set, the spill files are written
+  /// asynchronously on it. 'compressionDictionaryBytes' is passed to the
+  /// SpillWriter of each partition.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -339,7 +367,9 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr,
+      uint32_t compressionDictionaryBytes = 0);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -398,6 +428,18 @@ class SpillState {
   /// no spilled data.
   SpillFiles finish(uint32_t partition);
 
+  /// Merges the sorted 'files' of 'partition' in groups of up to 'maxFanIn'
+  /// files into new sorted files until at most 'maxFanIn' files are left, so
+  /// that a merge of the returned files does not open more than 'maxFanIn'
+  /// files at a time. Each pass merges all the files into about
+  /// files.size() / 'maxFanIn' files. The merged files are removed, and their
+  /// bytes are passed to 'removedSpillBytesCb' if set.
+  SpillFiles mergeFiles(
+      uint32_t partition,
+      SpillFiles files,
+      size_t maxFanIn,
+      const common::RemovedSpillBytesCB& removedSpillBytesCb = nullptr);
+
   /// Returns the spilled partition number set.
   const SpillPartitionNumSet& spilledPartitionSet() const;
 
@@ -436,6 +478,8 @@ class SpillState {
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint32_t compressionDictionaryBytes_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
@@ -15,6 +15,13 @@
  */
 
 #include "velox/exec/SpillFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <folly/String.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 
@@ -26,19 +33,106 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Size of the samples cut from the serialized rows for training a compression
+// dictionary.
+constexpr size_t kDictionarySampleBytes = 4 << 10;
+
+serializer::presto::PrestoVectorSerde::PrestoOptions makeSerdeOptions(
+    common::CompressionKind compressionKind,
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options{
+      kDefaultUseLosslessTimestamp, compressionKind, true /*nullsFirst*/};
+  options.compressionDictionary = std::move(compressionDictionary);
+  return options;
+}
+
+constexpr std::string_view kLocalFileScheme{"file:"};
+
+// Returns the path of 'path' in the local file system or std::nullopt if it
+// is not a local path.
+std::optional<std::string> localPath(const std::string& path) {
+  if (path.find(kLocalFileScheme) == 0) {
+    return path.substr(kLocalFileScheme.size());
+  }
+  if (path.find('/') == 0) {
+    return path;
+  }
+  return std::nullopt;
+}
 } // namespace
 
+SpillInputStream::~SpillInputStream() {
+  if (prefetch_ != nullptr) {
+    prefetch_->close();
+    prefetchBudget_->release(prefetchReservedBytes_);
+  }
+}
+
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
-  const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+  int32_t readBytes;
+  if (prefetch_ != nullptr) {
+    auto prefetch = std::move(prefetch_);
+    const bool hit = prefetch->hasValue();
+    // NOTE: AsyncSource::move() reads on this thread if the prefetch has not
+    // started on 'prefetchExecutor_' yet.
+    readBytes = *prefetch->move();
+    std::swap(buffer_, prefetchBuffer_);
+    prefetchBudget_->release(prefetchReservedBytes_);
+    prefetchReservedBytes_ = 0;
+    updatePrefetchStats(hit);
+  } else {
+    readBytes = readNext(buffer_);
+    if (prefetchExecutor_ != nullptr) {
+      updatePrefetchStats(false);
+    }
+  }
   setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
+  offset_ += readBytes;
+  maybePrefetch();
+}
+
+uint64_t SpillInputStream::readNext(const BufferPtr& buffer) {
+  const int32_t readBytes = std::min(size_ - offset_, buffer->capacity());
+  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
   uint64_t readTimeUs{0};
   {
     MicrosecondTimer timer{&readTimeUs};
-    file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    file_->pread(offset_, readBytes, buffer->asMutable<char>());
   }
   updateSpillStats(readBytes, readTimeUs);
-  offset_ += readBytes;
+  return readBytes;
+}
+
+void SpillInputStream::maybePrefetch() {
+  VELOX_CHECK_NULL(prefetch_);
+  if (prefetchExecutor_ == nullptr || offset_ >= size_) {
+    prefetchBuffer_ = nullptr;
+    return;
+  }
+  const auto bufferSize = buffer_->capacity();
+  if (!prefetchBudget_->tryReserve(bufferSize)) {
+    // Free the spare buffer when running out of the prefetch budget.
+    prefetchBuffer_ = nullptr;
+    return;
+  }
+  prefetchReservedBytes_ = bufferSize;
+  if (prefetchBuffer_ == nullptr) {
+    prefetchBuffer_ = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  }
+  prefetch_ = std::make_shared<AsyncSource<uint64_t>>([this]() {
+    return std::make_unique<uint64_t>(readNext(prefetchBuffer_));
+  });
+  prefetchExecutor_->add([prefetch = prefetch_]() { prefetch->prepare(); });
+}
+
+void SpillInputStream::updatePrefetchStats(bool hit) const {
+  auto lockedStats = stats_->wlock();
+  if (hit) {
+    ++lockedStats->spillPrefetchHits;
+  } else {
+    ++lockedStats->spillPrefetchMisses;
+  }
 }
 
 void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
@@ -50,6 +144,49 @@ void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
   common::updateGlobalSpillReadStats(readBytes, readTimeUs);
 }
 
+MappedSpillInputStream::MappedSpillInputStream(
+    const std::string& path,
+    uint64_t size,
+    folly::Synchronized<common::SpillStats>* stats)
+    : size_(size), stats_(stats) {
+  VELOX_CHECK_GT(size_, 0, "Empty spill file {}", path);
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+  VELOX_CHECK_GE(
+      fd, 0, "Cannot open spill file {}: {}", path, folly::errnoStr(errno));
+  auto* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  const auto mmapErrno = errno;
+  ::close(fd);
+  VELOX_CHECK(
+      data != MAP_FAILED,
+      "Cannot map spill file {}: {}",
+      path,
+      folly::errnoStr(mmapErrno));
+  data_ = static_cast<uint8_t*>(data);
+  ::madvise(data_, size_, MADV_SEQUENTIAL);
+  next(true);
+}
+
+MappedSpillInputStream::~MappedSpillInputStream() {
+  ::munmap(data_, size_);
+}
+
+void MappedSpillInputStream::next(bool /*throwIfPastEnd*/) {
+  const auto windowBytes = std::min(size_ - offset_, kWindowSize);
+  VELOX_CHECK_LT(0, windowBytes, "Reading past end of spill file");
+  if (offset_ > 0) {
+    // The previous window is consumed. Its pages are reloaded from the file
+    // if touched again.
+    ::madvise(data_ + offset_ - kWindowSize, kWindowSize, MADV_DONTNEED);
+  }
+  setRange({data_ + offset_, static_cast<int32_t>(windowBytes), 0});
+  offset_ += windowBytes;
+
+  auto lockedStats = stats_->wlock();
+  lockedStats->spillReadBytes += windowBytes;
+  ++(lockedStats->spillReads);
+  common::updateGlobalSpillReadStats(windowBytes, 0);
+}
+
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
     uint32_t id,
     const std::string& pathPrefix,
@@ -104,7 +241,9 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    uint32_t compressionDictionaryBytes)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -115,13 +254,22 @@ SpillWriter::SpillWriter(
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor),
+      compressionDictionaryBytes_(compressionDictionaryBytes) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  if (pendingWrite_ != nullptr) {
+    // Make sure the in-flight write is done before the file is destroyed.
+    pendingWrite_->close();
+  }
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
     closeFile();
@@ -136,6 +284,7 @@ SpillWriteFile* SpillWriter::ensureFile() {
 }
 
 void SpillWriter::closeFile() {
+  waitForPendingWrite();
   if (currentFile_ == nullptr) {
     return;
   }
@@ -148,10 +297,39 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .compressionDictionary = compressionDictionary_});
   currentFile_.reset();
 }
 
+void SpillWriter::maybeTrainCompressionDictionary(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  if (compressionDictionaryTrained_ || compressionDictionaryBytes_ == 0 ||
+      compressionKind_ != common::CompressionKind_ZSTD) {
+    return;
+  }
+  compressionDictionaryTrained_ = true;
+  auto options = makeSerdeOptions(common::CompressionKind_NONE, nullptr);
+  VectorStreamGroup group(pool_);
+  group.createStreamTree(asRowType(rows->type()), 1'000, &options);
+  group.append(rows, indices);
+  IOBufOutputStream out(*pool_, nullptr, group.size());
+  group.flush(&out);
+  auto iobuf = out.getIOBuf();
+  const auto bytes = iobuf->coalesce();
+  std::vector<std::string_view> samples;
+  for (size_t offset = 0; offset < bytes.size();
+       offset += kDictionarySampleBytes) {
+    samples.emplace_back(
+        reinterpret_cast<const char*>(bytes.data()) + offset,
+        std::min(kDictionarySampleBytes, bytes.size() - offset));
+  }
+  // Falls back to compressing without a dictionary if the rows are too few.
+  compressionDictionary_ =
+      common::ZstdDictionary::train(samples, compressionDictionaryBytes_);
+}
+
 size_t SpillWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
@@ -161,9 +339,6 @@ uint64_t SpillWriter::flush() {
     return 0;
   }
 
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
-
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
   uint64_t flushTimeUs{0};
@@ -172,19 +347,60 @@ uint64_t SpillWriter::flush() {
     batch_->flush(&out);
   }
   batch_.reset();
+  auto iobuf = out.getIOBuf();
+  const auto writeBytes = iobuf->computeChainDataLength();
+
+  // NOTE: the previous write must complete before choosing the file to write
+  // as the file size decides if a new file is needed.
+  waitForPendingWrite();
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
+
+  if (writeExecutor_ == nullptr) {
+    const auto writtenBytes = writeToFile(file, std::move(iobuf), flushTimeUs);
+    updateAndCheckSpillLimitCb_(writtenBytes);
+    return writtenBytes;
+  }
 
+  updateAndCheckSpillLimitCb_(writeBytes);
+  // NOTE: AsyncSource requires a copyable function so the serialized buffer is
+  // held by a shared pointer.
+  std::shared_ptr<folly::IOBuf> buf = std::move(iobuf);
+  pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+      [this, file, buf = std::move(buf), flushTimeUs]() {
+        return std::make_unique<uint64_t>(writeToFile(
+            file,
+            std::make_unique<folly::IOBuf>(std::move(*buf)),
+            flushTimeUs));
+      });
+  writeExecutor_->add([source = pendingWrite_]() { source->prepare(); });
+  return writeBytes;
+}
+
+uint64_t SpillWriter::writeToFile(
+    SpillWriteFile* file,
+    std::unique_ptr<folly::IOBuf> iobuf,
+    uint64_t flushTimeUs) {
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
     writtenBytes = file->write(std::move(iobuf));
   }
   updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
-  updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+void SpillWriter::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_);
+  // NOTE: AsyncSource::move() runs the write on this thread if it has not
+  // started on 'writeExecutor_' yet.
+  pendingWrite->move();
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
@@ -194,8 +410,8 @@ uint64_t SpillWriter::write(
   {
     MicrosecondTimer timer(&timeUs);
     if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+      maybeTrainCompressionDictionary(rows, indices);
+      auto options = makeSerdeOptions(compressionKind_, compressionDictionary_);
       batch_ = std::make_unique<VectorStreamGroup>(pool_);
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
@@ -284,7 +500,9 @@ std::vector<uint32_t> SpillWriter::testingSpilledFileIds() const {
 std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* prefetchExecutor,
+    std::shared_ptr<SpillPrefetchBudget> prefetchBudget) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -293,8 +511,11 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.compressionDictionary,
       pool,
-      stats));
+      stats,
+      prefetchExecutor,
+      std::move(prefetchBudget)));
 }
 
 SpillReadFile::SpillReadFile(
@@ -305,8 +526,11 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* prefetchExecutor,
+    std::shared_ptr<SpillPrefetchBudget> prefetchBudget)
     : id_(id),
       path_(path),
       size_(size),
@@ -314,20 +538,27 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      readOptions_{
-          kDefaultUseLosslessTimestamp,
-          compressionKind_,
-          true /*nullsFirst*/},
+      readOptions_(
+          makeSerdeOptions(compressionKind_, std::move(compressionDictionary))),
       pool_(pool),
       stats_(stats) {
-  constexpr uint64_t kMaxReadBufferSize =
-      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+  if (FLAGS_velox_spill_read_mmap) {
+    if (const auto local = localPath(path_)) {
+      input_ = std::make_unique<MappedSpillInputStream>(*local, size_, stats_);
+      return;
+    }
+  }
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   auto buffer = AlignedBuffer::allocate<char>(
       std::min<uint64_t>(size_, kMaxReadBufferSize), pool_);
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), std::move(buffer), stats_);
+      std::move(file),
+      std::move(buffer),
+      stats_,
+      prefetchExecutor,
+      std::move(prefetchBudget),
+      pool_);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -17,10 +17,13 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <gflags/gflags.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/TreeOfLosers.h"
@@ -30,6 +33,8 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorStream.h"
 
+DECLARE_bool(velox_spill_read_mmap);
+
 namespace facebook::velox::exec {
 
 /// Represents a spill file for writing the serialized spilled data into a disk
@@ -89,6 +94,8 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// The dictionary the pages are compressed with, if any.
+  std::shared_ptr<const common::ZstdDictionary> compressionDictionary;
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -105,7 +112,13 @@ class SpillWriter {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'writeExecutor' is set, the serialized data is
+  /// written to file on 'writeExecutor' while the next write buffer is filled
+  /// on the caller thread. At most one buffer is being written at a time, so
+  /// the memory held by in-flight writes is bounded by one write buffer.
+  /// If 'compressionDictionaryBytes' is positive and 'compressionKind' is
+  /// ZSTD, a dictionary of up to this size is trained on the rows of the first
+  /// write() and all pages are compressed with it.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -120,7 +133,11 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      uint32_t compressionDictionaryBytes = 0);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -161,10 +178,27 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Trains 'compressionDictionary_' on the serialization of 'rows' at
+  // 'indices' if dictionary compression is on and not tried yet.
+  void maybeTrainCompressionDictionary(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
+  // Writes data from 'batch_' to the current output file. Returns the
+  // serialized size to write. If 'writeExecutor_' is set, the write is
+  // scheduled on it after the previous write has completed.
   uint64_t flush();
 
+  // Writes 'iobuf' to 'file' and updates the write stats. Returns the written
+  // size.
+  uint64_t writeToFile(
+      SpillWriteFile* file,
+      std::unique_ptr<folly::IOBuf> iobuf,
+      uint64_t flushTimeUs);
+
+  // Waits for the in-flight write if any. Rethrows the write error.
+  void waitForPendingWrite();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -191,14 +225,55 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint32_t compressionDictionaryBytes_;
 
   bool finished_{false};
+  bool compressionDictionaryTrained_{false};
+  // Set if the training succeeded.
+  std::shared_ptr<const common::ZstdDictionary> compressionDictionary_;
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // The write to 'currentFile_' running on 'writeExecutor_'.
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
   SpillFiles finishedFiles_;
 };
 
+/// Bounds the memory used to prefetch the spill files which are read
+/// together, e.g. the sorted runs of a spill merge.
+///
+/// NOTE: this object is not thread-safe. It is expected to be used by the spill
+/// file readers of one merge which all run on the same thread.
+class SpillPrefetchBudget {
+ public:
+  explicit SpillPrefetchBudget(uint64_t capacity) : capacity_(capacity) {}
+
+  /// Reserves 'bytes' from the budget. Returns false if there is not enough
+  /// budget left.
+  bool tryReserve(uint64_t bytes) {
+    if (reservedBytes_ + bytes > capacity_) {
+      return false;
+    }
+    reservedBytes_ += bytes;
+    return true;
+  }
+
+  /// Returns 'bytes' reserved by tryReserve() to the budget.
+  void release(uint64_t bytes) {
+    VELOX_CHECK_GE(reservedBytes_, bytes);
+    reservedBytes_ -= bytes;
+  }
+
+  uint64_t reservedBytes() const {
+    return reservedBytes_;
+  }
+
+ private:
+  const uint64_t capacity_;
+  uint64_t reservedBytes_{0};
+};
+
 /// Input stream backed by spill file.
 ///
 /// TODO Usage of ByteInputStream as base class is hacky and just happens to
@@ -206,18 +281,32 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If
+  /// 'prefetchExecutor' is set, the next range of the file is read ahead on
+  /// 'prefetchExecutor' into a second buffer allocated from 'pool' as long as
+  /// 'prefetchBudget' allows.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       BufferPtr buffer,
-      folly::Synchronized<common::SpillStats>* stats)
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* prefetchExecutor = nullptr,
+      std::shared_ptr<SpillPrefetchBudget> prefetchBudget = nullptr,
+      memory::MemoryPool* pool = nullptr)
       : file_(std::move(file)),
         size_(file_->size()),
         buffer_(std::move(buffer)),
-        stats_(stats) {
+        stats_(stats),
+        prefetchExecutor_(prefetchExecutor),
+        prefetchBudget_(std::move(prefetchBudget)),
+        pool_(pool) {
+    VELOX_CHECK(
+        prefetchExecutor_ == nullptr ||
+        (prefetchBudget_ != nullptr && pool_ != nullptr));
     next(true);
   }
 
+  ~SpillInputStream() override;
+
   /// True if all of the file has been read into vectors.
   bool atEnd() const override {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
@@ -225,15 +314,69 @@ class SpillInputStream : public ByteInputStream {
 
  private:
   void updateSpillStats(uint64_t readBytes, uint64_t readTimeUs) const;
+  void updatePrefetchStats(bool hit) const;
   void next(bool throwIfPastEnd) override;
 
+  // Reads the next range of the file starting at 'offset_' into 'buffer'.
+  // Returns the number of bytes read.
+  uint64_t readNext(const BufferPtr& buffer);
+
+  // Starts to read the next range of the file into 'prefetchBuffer_' on
+  // 'prefetchExecutor_' if there is data left and enough prefetch budget.
+  void maybePrefetch();
+
   const std::unique_ptr<ReadFile> file_;
   const uint64_t size_;
-  const BufferPtr buffer_;
+  BufferPtr buffer_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const prefetchExecutor_;
+  const std::shared_ptr<SpillPrefetchBudget> prefetchBudget_;
+  memory::MemoryPool* const pool_;
 
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+
+  // The buffer to read ahead into. It is swapped with 'buffer_' when the
+  // prefetched data is consumed.
+  BufferPtr prefetchBuffer_;
+  // The bytes reserved from 'prefetchBudget_' for the pending prefetch.
+  uint64_t prefetchReservedBytes_{0};
+  // The read running on 'prefetchExecutor_' which returns the number of bytes
+  // read into 'prefetchBuffer_'.
+  std::shared_ptr<AsyncSource<uint64_t>> prefetch_;
+};
+
+/// Reads a local spill file through a read-only memory mapping. The ranges of
+/// the stream point into the mapping, so the bytes are copied once, from the
+/// page cache into the deserialized vectors, and no read buffer is held per
+/// file. The mapping is advanced in windows of 'kWindowSize' and the pages of
+/// a consumed window are dropped. The read time is not known since the pages
+/// are faulted in when deserialized, so it counts as deserialization time.
+class MappedSpillInputStream : public ByteInputStream {
+ public:
+  static constexpr uint64_t kWindowSize = 64 << 20;
+
+  MappedSpillInputStream(
+      const std::string& path,
+      uint64_t size,
+      folly::Synchronized<common::SpillStats>* stats);
+
+  ~MappedSpillInputStream() override;
+
+  /// True if all of the file has been read into vectors.
+  bool atEnd() const override {
+    return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
+  }
+
+ private:
+  void next(bool throwIfPastEnd) override;
+
+  const uint64_t size_;
+  folly::Synchronized<common::SpillStats>* const stats_;
+  uint8_t* data_{nullptr};
+
+  // Offset of the first byte after the current window.
+  uint64_t offset_{0};
 };
 
 /// Represents a spill file for read which turns the serialized spilled data on
@@ -245,10 +388,19 @@ class SpillInputStream : public ByteInputStream {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// The maximum size of the read buffer of a file.
+  static constexpr uint64_t kMaxReadBufferSize =
+      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+
+  /// If 'prefetchExecutor' is set, the file is read ahead on it within
+  /// 'prefetchBudget'. A local file is read with MappedSpillInputStream
+  /// instead if FLAGS_velox_spill_read_mmap is set.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* prefetchExecutor = nullptr,
+      std::shared_ptr<SpillPrefetchBudget> prefetchBudget = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -282,8 +434,11 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      std::shared_ptr<const common::ZstdDictionary> compressionDictionary,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* prefetchExecutor,
+      std::shared_ptr<SpillPrefetchBudget> prefetchBudget);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -300,6 +455,6 @@ class SpillReadFile {
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
-  std::unique_ptr<SpillInputStream> input_;
+  std::unique_ptr<ByteInputStream> input_;
 };
 } // namespace facebook::velox::exec
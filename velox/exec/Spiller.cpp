@@ -55,14 +55,18 @@ Spiller::Spiller(
           std::numeric_limits<uint64_t>::max(),
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->compressionDictionaryBytes,
           spillConfig->executor,
+          spillConfig->asyncWriteEnabled,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
   VELOX_CHECK(
-      type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
+      type_ == Type::kOrderByInput || type_ == Type::kAggregateInput ||
+          type_ == Type::kWindow || type_ == Type::kTopNRowNumber,
       "Unexpected spiller type: {}",
       typeName(type_));
+  removedSpillBytesCb_ = spillConfig->removedSpillBytesCb;
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
   VELOX_CHECK_EQ(state_.targetFileSize(), std::numeric_limits<uint64_t>::max());
 }
@@ -87,7 +91,9 @@ Spiller::Spiller(
           std::numeric_limits<uint64_t>::max(),
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->compressionDictionaryBytes,
           spillConfig->executor,
+          spillConfig->asyncWriteEnabled,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -119,7 +125,9 @@ Spiller::Spiller(
           spillConfig->maxFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->compressionDictionaryBytes,
           spillConfig->executor,
+          spillConfig->asyncWriteEnabled,
           0,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -152,7 +160,9 @@ Spiller::Spiller(
           spillConfig->maxFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->compressionDictionaryBytes,
           spillConfig->executor,
+          spillConfig->asyncWriteEnabled,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
@@ -181,11 +191,16 @@ Spiller::Spiller(
           spillConfig->maxFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->compressionDictionaryBytes,
           spillConfig->executor,
+          spillConfig->asyncWriteEnabled,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
           spillStats) {
-  VELOX_CHECK_EQ(type_, Type::kRowNumber);
+  VELOX_CHECK(
+      type_ == Type::kRowNumber || type_ == Type::kMarkDistinct,
+      "Unexpected spiller type: {}",
+      typeName(type_));
 }
 
 Spiller::Spiller(
@@ -202,7 +217,9 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
+    uint32_t compressionDictionaryBytes,
     folly::Executor* executor,
+    bool asyncWriteEnabled,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
     folly::Synchronized<common::SpillStats>* spillStats)
@@ -226,7 +243,9 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          asyncWriteEnabled ? executor : nullptr,
+          compressionDictionaryBytes) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
@@ -503,8 +522,8 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
 
 bool Spiller::needSort() const {
   return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
-      type_ != Type::kRowNumber && type_ != Type::kAggregateOutput &&
-      type_ != Type::kOrderByOutput;
+      type_ != Type::kRowNumber && type_ != Type::kMarkDistinct &&
+      type_ != Type::kAggregateOutput && type_ != Type::kOrderByOutput;
 }
 
 void Spiller::spill() {
@@ -539,7 +558,10 @@ void Spiller::spill(const RowContainerIterator* startRowIter) {
 
 void Spiller::spill(std::vector<char*>& rows) {
   CHECK_NOT_FINALIZED();
-  VELOX_CHECK_EQ(type_, Type::kOrderByOutput);
+  VELOX_CHECK(
+      type_ == Type::kOrderByOutput || type_ == Type::kWindow,
+      "Unexpected spiller type: {}",
+      typeName(type_));
   VELOX_CHECK(!rows.empty());
 
   markAllPartitionsSpilled();
@@ -567,7 +589,7 @@ void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK(
       type_ == Type::kHashJoinProbe || type_ == Type::kHashJoinBuild ||
-          type_ == Type::kRowNumber,
+          type_ == Type::kRowNumber || type_ == Type::kMarkDistinct,
       "Unexpected spiller type: {}",
       typeName(type_));
   if (FOLLY_UNLIKELY(!state_.isPartitionSpilled(partition))) {
@@ -601,12 +623,17 @@ void Spiller::finishSpill(SpillPartitionSet& partitionSet) {
   }
 }
 
-SpillPartition Spiller::finishSpill() {
+SpillPartition Spiller::finishSpill(size_t maxMergeFanIn) {
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
   VELOX_CHECK(state_.isPartitionSpilled(0));
 
   finalizeSpill();
-  return SpillPartition(SpillPartitionId{bits_.begin(), 0}, state_.finish(0));
+  auto files = state_.finish(0);
+  if (maxMergeFanIn != 0 && needSort() && files.size() > maxMergeFanIn) {
+    files = state_.mergeFiles(
+        0, std::move(files), maxMergeFanIn, removedSpillBytesCb_);
+  }
+  return SpillPartition(SpillPartitionId{bits_.begin(), 0}, std::move(files));
 }
 
 void Spiller::finalizeSpill() {
@@ -680,6 +707,8 @@ void Spiller::fillSpillRun(std::vector<char*>& rows) {
     for (const auto* row : rows) {
       spillRuns_[0].numBytes += container_->rowSize(row);
     }
+    // The window rows are passed in sort key order.
+    spillRuns_[0].sorted = type_ == Type::kWindow;
   }
   updateSpillFillTime(execTimeUs);
 }
@@ -710,6 +739,12 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_OUTPUT";
     case Type::kRowNumber:
       return "ROW_NUMBER";
+    case Type::kWindow:
+      return "WINDOW";
+    case Type::kTopNRowNumber:
+      return "TOPN_ROW_NUMBER";
+    case Type::kMarkDistinct:
+      return "MARK_DISTINCT";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
@@ -41,8 +41,14 @@ class Spiller {
     kOrderByOutput = 5,
     // Used for row number.
     kRowNumber = 6,
+    // Used for window, both before and after the window partitions are built.
+    kWindow = 7,
+    // Used for topN row number.
+    kTopNRowNumber = 8,
+    // Used for mark distinct.
+    kMarkDistinct = 9,
     // Number of spiller types.
-    kNumTypes = 7,
+    kNumTypes = 10,
   };
 
   static std::string typeName(Type);
@@ -52,7 +58,8 @@ class Spiller {
   /// The constructor without specifying hash bits which will only use one
   /// partition by default.
 
-  /// type == Type::kOrderByInput || type == Type::kAggregateInput
+  /// type == Type::kOrderByInput || type == Type::kAggregateInput ||
+  /// type == Type::kWindow || type == Type::kTopNRowNumber
   Spiller(
       Type type,
       RowContainer* container,
@@ -88,7 +95,7 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kRowNumber
+  /// type == Type::kRowNumber || type == Type::kMarkDistinct
   Spiller(
       Type type,
       RowContainer* container,
@@ -114,7 +121,9 @@ class Spiller {
 
   /// Invoked to spill all the rows pointed by rows. This is used by
   /// 'kOrderByOutput' spiller type to spill during the order by
-  /// output processing. Similarly, the spilled rows still stays in the row
+  /// output processing, and by 'kWindow' spiller type to spill the window
+  /// partitions not yet output. 'rows' must be in sort key order for
+  /// 'kWindow'. Similarly, the spilled rows still stays in the row
   /// container. The caller needs to erase them from the row container.
   void spill(std::vector<char*>& rows);
 
@@ -141,8 +150,10 @@ class Spiller {
   /// 'partitionSet' indexed by spill partition id.
   void finishSpill(SpillPartitionSet& partitionSet);
 
-  /// Finishes spilling and expects single partition.
-  SpillPartition finishSpill();
+  /// Finishes spilling and expects single partition. If 'maxMergeFanIn' is not
+  /// zero and there are more sorted files than this, the files are first
+  /// merged into at most 'maxMergeFanIn' files, see SpillState::mergeFiles().
+  SpillPartition finishSpill(size_t maxMergeFanIn = 0);
 
   const SpillState& state() const {
     return state_;
@@ -207,7 +218,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
+      uint32_t compressionDictionaryBytes,
       folly::Executor* executor,
+      bool asyncWriteEnabled,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
@@ -324,6 +337,10 @@ class Spiller {
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  // Invoked with the bytes of the spill files removed by finishSpill() when
+  // it merges them. See common::SpillConfig::removedSpillBytesCb.
+  common::RemovedSpillBytesCB removedSpillBytesCb_;
+
   // True if all rows of spilling partitions are in 'spillRuns_', so
   // that one can start reading these back. This means that the rows
   // that are not written out and deleted will be captured by
@@ -101,6 +101,8 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
+      addInjectedDynamicFilters();
+
       exec::Split split;
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -119,18 +121,7 @@ RowVectorPtr TableScan::getOutput() {
         dynamicFilters_.clear();
         if (dataSource_) {
           curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
-          const auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.emplace(
-                  name, RuntimeMetric(counter.unit));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
+          addDataSourceStats(*stats_.wlock());
         }
         return nullptr;
       }
@@ -161,6 +152,9 @@ RowVectorPtr TableScan::getOutput() {
           dataSource_->addDynamicFilter(entry.first, entry.second);
         }
       }
+      if (const auto remaining = remainingRowLimit()) {
+        dataSource_->setRowLimit(*remaining);
+      }
 
       debugString_ = fmt::format(
           "Split [{}] Task {}",
@@ -188,6 +182,11 @@ RowVectorPtr TableScan::getOutput() {
           return nullptr;
         }
         dataSource_->setFromDataSource(std::move(preparedDataSource));
+        // The split was prepared with the dynamic filters at the time of the
+        // preload. Adds the ones that came or tightened since then.
+        for (const auto& entry : dynamicFilters_) {
+          dataSource_->addDynamicFilter(entry.first, entry.second);
+        }
       } else {
         curStatus_ = "getOutput: adding split";
         const auto addSplitStartMicros = getCurrentTimeMicro();
@@ -202,6 +201,22 @@ RowVectorPtr TableScan::getOutput() {
       curStatus_ = "getOutput: updating stats_.numSplits";
       ++stats_.wlock()->numSplits;
 
+      if (statisticsAggregationSink_ != nullptr) {
+        curStatus_ = "getOutput: dataSource_->aggregateFromStatistics";
+        if (auto results =
+                dataSource_->aggregateFromStatistics(statisticsAggregates_)) {
+          // The consuming aggregation takes the results for the split, its
+          // rows are not read.
+          statisticsAggregationSink_(results.value());
+          stats_.wlock()->addRuntimeStat(
+              "statisticsAggregatedSplits", RuntimeCounter(1));
+          curStatus_ = "getOutput: task->splitFinished";
+          driverCtx_->task->splitFinished(true, currentSplitWeight_);
+          needNewSplit_ = true;
+          continue;
+        }
+      }
+
       curStatus_ = "getOutput: dataSource_->estimatedRowSize";
       const auto estimatedRowSize = dataSource_->estimatedRowSize();
       readBatchSize_ =
@@ -230,6 +245,13 @@ RowVectorPtr TableScan::getOutput() {
           maxReadBatchSize_,
           static_cast<int>(readBatchSize / maxFilteringRatio_));
     }
+    if (const auto remaining = remainingRowLimit()) {
+      // Reads no more than needed for the limit at the selectivity seen so
+      // far, or assuming that all rows pass if nothing was read yet.
+      const double passRatio = maxFilteringRatio_ > 0 ? maxFilteringRatio_ : 1;
+      readBatchSize = std::max<int64_t>(
+          1, std::min<double>(readBatchSize, *remaining / passRatio));
+    }
     curStatus_ = "getOutput: dataSource_->next";
     auto dataOptional = dataSource_->next(readBatchSize, blockingFuture_);
     curStatus_ = "getOutput: checkPreload";
@@ -261,6 +283,17 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          numOutputRows_ += data->size();
+          if (remainingRowLimit() == 0) {
+            // The consuming Limit takes no more rows, so the rest of the
+            // split and the remaining splits are not read.
+            curStatus_ = "getOutput: row limit reached";
+            addDataSourceStats(*lockedStats);
+            dataSource_.reset();
+            noMoreSplits_ = true;
+            dynamicFilters_.clear();
+            driverCtx_->task->splitFinished(true, currentSplitWeight_);
+          }
           return data;
         }
         continue;
@@ -334,6 +367,11 @@ void TableScan::checkPreload() {
       !connector_->supportsSplitPreload()) {
     return;
   }
+  if (const auto remaining = remainingRowLimit();
+      remaining.has_value() && *remaining <= readBatchSize_) {
+    // The split being read probably has the rows still needed.
+    return;
+  }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         maxSplitPreloadPerDriver_;
@@ -357,6 +395,18 @@ void TableScan::setInputFileName(
   driverCtx_->inputFileName = split->getFileName();
 }
 
+void TableScan::addDataSourceStats(OperatorStats& stats) {
+  const auto connectorStats = dataSource_->runtimeStats();
+  for (const auto& [name, counter] : connectorStats) {
+    if (FOLLY_UNLIKELY(stats.runtimeStats.count(name) == 0)) {
+      stats.runtimeStats.emplace(name, RuntimeMetric(counter.unit));
+    } else {
+      VELOX_CHECK_EQ(stats.runtimeStats.at(name).unit, counter.unit);
+    }
+    stats.runtimeStats.at(name).addValue(counter.value);
+  }
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
@@ -368,8 +418,35 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  auto it = dynamicFilters_.find(outputChannel);
+  if (it == dynamicFilters_.end()) {
+    dynamicFilters_.emplace(outputChannel, filter);
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
+void TableScan::addInjectedDynamicFilters() {
+  auto* task = driverCtx_->task.get();
+  const auto version = task->injectedDynamicFiltersVersion();
+  if (version == injectedDynamicFiltersVersion_) {
+    return;
+  }
+  injectedDynamicFiltersVersion_ = version;
+  const auto injected = task->injectedDynamicFilters(planNodeId());
+  for (; numInjectedDynamicFilters_ < injected.size();
+       ++numInjectedDynamicFilters_) {
+    const auto& [producer, filters] = injected[numInjectedDynamicFilters_];
+    for (const auto& [name, filter] : filters) {
+      const auto channel = outputType_->getChildIdxIfExists(name);
+      if (!channel.has_value()) {
+        continue;
+      }
+      addDynamicFilter(producer, channel.value(), filter);
+      addRuntimeStat("dynamicFiltersAccepted", RuntimeCounter(1));
+    }
+  }
+}
+
 } // namespace facebook::velox::exec
@@ -50,6 +50,27 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  /// Makes the scan stop after producing 'rowLimit' rows. Set when a Limit
+  /// right after the scan in the pipeline takes no more. The reads are sized
+  /// to the rows still needed at the selectivity seen so far, splits are not
+  /// preloaded if one batch may be enough and the data source is closed when
+  /// the limit is reached, which cancels its outstanding loads.
+  void setRowLimit(uint64_t rowLimit) {
+    rowLimit_ = rowLimit;
+  }
+
+  /// Makes the scan try to get the results of 'aggregates' for each split
+  /// from the file statistics, see DataSource::aggregateFromStatistics(). The
+  /// results for the splits answered so are passed to 'sink' and their rows
+  /// are not read. Set when a partial global aggregation of 'aggregates' right
+  /// after the scan in the pipeline consumes its output.
+  void setStatisticsAggregation(
+      std::vector<connector::StatisticsAggregate> aggregates,
+      std::function<void(const std::vector<VectorPtr>&)> sink) {
+    statisticsAggregates_ = std::move(aggregates);
+    statisticsAggregationSink_ = std::move(sink);
+  }
+
  private:
   void setInputFileName(std::shared_ptr<connector::ConnectorSplit> split);
   // Checks if this table scan operator needs to yield before processing the
@@ -71,6 +92,23 @@ class TableScan : public SourceOperator {
   // done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Adds the dynamic filters injected into the task for this scan node since
+  // the last call. See Task::addDynamicFilters().
+  void addInjectedDynamicFilters();
+
+  // Adds the runtime stats of 'dataSource_' to 'stats', which are the locked
+  // 'stats_'.
+  void addDataSourceStats(OperatorStats& stats);
+
+  // Returns the rows still needed for 'rowLimit_' or std::nullopt if there is
+  // no limit.
+  std::optional<uint64_t> remainingRowLimit() const {
+    if (!rowLimit_.has_value()) {
+      return std::nullopt;
+    }
+    return *rowLimit_ - std::min(*rowLimit_, numOutputRows_);
+  }
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -88,9 +126,25 @@ class TableScan : public SourceOperator {
   // Dynamic filters to add to the data source when it gets created.
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
+  // The task's injected dynamic filters version seen by the last call to
+  // addInjectedDynamicFilters().
+  uint64_t injectedDynamicFiltersVersion_{0};
+  // Number of injected dynamic filter sets already added.
+  size_t numInjectedDynamicFilters_{0};
 
   int32_t maxPreloadedSplits_{0};
 
+  // Number of output rows after which the scan stops. See setRowLimit().
+  std::optional<uint64_t> rowLimit_;
+
+  // Number of rows returned by getOutput().
+  uint64_t numOutputRows_{0};
+
+  // See setStatisticsAggregation().
+  std::vector<connector::StatisticsAggregate> statisticsAggregates_;
+  std::function<void(const std::vector<VectorPtr>&)>
+      statisticsAggregationSink_{nullptr};
+
   const int32_t maxSplitPreloadPerDriver_{0};
 
   // Callback passed to getSplitOrFuture() for triggering async preload. The
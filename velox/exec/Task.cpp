@@ -16,10 +16,13 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/String.h>
+#include <folly/json.h>
 #include <string>
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/caching/SsdCache.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
@@ -141,6 +144,15 @@ void buildSplitStates(
   }
 }
 
+void collectPlanNodeIds(
+    const core::PlanNode* planNode,
+    std::vector<core::PlanNodeId>& ids) {
+  ids.push_back(planNode->id());
+  for (const auto& child : planNode->sources()) {
+    collectPlanNodeIds(child.get(), ids);
+  }
+}
+
 // Returns a map of ids of source (leaf) plan nodes expecting splits.
 // SplitsState structures are initialized to blank states. Also, checks that
 // plan node IDs are unique and throws if encounters duplicates.
@@ -304,6 +316,13 @@ Task::Task(
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
+
+  std::vector<core::PlanNodeId> nodeIds;
+  collectPlanNodeIds(planFragment_.planNode.get(), nodeIds);
+  nodeProgress_ = std::vector<NodeProgressCounters>(nodeIds.size());
+  for (auto i = 0; i < nodeIds.size(); ++i) {
+    nodeProgress_[i].planNodeId = std::move(nodeIds[i]);
+  }
 }
 
 Task::~Task() {
@@ -322,6 +341,9 @@ Task::~Task() {
   clearStage = "removeSpillDirectoryIfExists";
   removeSpillDirectoryIfExists();
 
+  clearStage = "releaseSsdCacheSpaceForSpill";
+  releaseSsdCacheSpaceForSpill();
+
   // TODO(spershin): Temporary code designed to reveal what causes SIGABRT in
   // jemalloc when destroying some Tasks.
 #define CLEAR(_action_)   \
@@ -334,6 +356,7 @@ Task::~Task() {
   CLEAR(taskCompletionPromises_.clear());
   CLEAR(splitsStates_.clear());
   CLEAR(drivers_.clear());
+  CLEAR(pipelineNdvSketches_.clear());
   CLEAR(driverFactories_.clear());
   CLEAR(onError_ = [](std::exception_ptr) {});
   CLEAR(exchangeClientByPlanNode_.clear());
@@ -399,6 +422,68 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+const common::SpillConfig& Task::spillConfigTemplate() {
+  std::call_once(spillConfigTemplateOnce_, [&]() {
+    const auto& queryConfig = queryCtx_->queryConfig();
+    const bool reserveSsdCacheSpace = queryConfig.spillReserveSsdCacheSpace();
+    spillConfigTemplate_ = common::SpillConfig(
+        [this]() -> std::string_view { return getOrCreateSpillDirectory(); },
+        [this, reserveSsdCacheSpace](uint64_t bytes) {
+          queryCtx_->updateSpilledBytesAndCheckLimit(bytes);
+          if (reserveSsdCacheSpace) {
+            reserveSsdCacheSpaceForSpill(bytes);
+          }
+        },
+        "",
+        queryConfig.maxSpillFileSize(),
+        queryConfig.spillWriteBufferSize(),
+        queryCtx_->spillExecutor(),
+        queryConfig.minSpillableReservationPct(),
+        queryConfig.spillableReservationGrowthPct(),
+        queryConfig.spillStartPartitionBit(),
+        queryConfig.spillNumPartitionBits(),
+        queryConfig.maxSpillLevel(),
+        queryConfig.maxSpillRunRows(),
+        queryConfig.writerFlushThresholdBytes(),
+        queryConfig.spillCompressionKind(),
+        queryConfig.spillFileCreateConfig(),
+        queryConfig.spillAsyncWriteEnabled(),
+        queryConfig.spillReadPrefetchBytes(),
+        queryConfig.spillMergeMemoryBytes());
+    spillConfigTemplate_.compressionDictionaryBytes =
+        queryConfig.spillCompressionDictionaryBytes();
+    if (reserveSsdCacheSpace) {
+      spillConfigTemplate_.removedSpillBytesCb = [this](uint64_t bytes) {
+        releaseSsdCacheSpaceForSpill(bytes);
+      };
+    }
+  });
+  return spillConfigTemplate_;
+}
+
+const std::vector<uint64_t>& Task::driverPriorityLevelsMs() {
+  std::call_once(driverPriorityLevelsOnce_, [&]() {
+    const auto levels = queryCtx_->queryConfig().driverPriorityLevelsMs();
+    if (levels.empty()) {
+      return;
+    }
+    std::vector<folly::StringPiece> parts;
+    folly::split(',', levels, parts);
+    for (const auto& part : parts) {
+      driverPriorityLevelsMs_.push_back(
+          folly::to<uint64_t>(folly::trimWhitespace(part)));
+      VELOX_CHECK(
+          driverPriorityLevelsMs_.size() == 1 ||
+              driverPriorityLevelsMs_.back() >
+                  driverPriorityLevelsMs_[driverPriorityLevelsMs_.size() - 2],
+          "{} must be increasing: {}",
+          core::QueryConfig::kDriverPriorityLevelsMs,
+          levels);
+    }
+  });
+  return driverPriorityLevelsMs_;
+}
+
 void Task::removeSpillDirectoryIfExists() {
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
@@ -412,6 +497,54 @@ void Task::removeSpillDirectoryIfExists() {
   }
 }
 
+void Task::reserveSsdCacheSpaceForSpill(uint64_t bytes) {
+  auto* cache = queryCtx_->cache();
+  auto* ssdCache = cache == nullptr ? nullptr : cache->ssdCache();
+  if (ssdCache == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(ssdSpillSpaceMutex_);
+  ssdSpillBytes_ += bytes;
+  if (ssdSpillBytes_ > ssdSpillReservedBytes_) {
+    ssdSpillReservedBytes_ +=
+        ssdCache->reserveSpace(ssdSpillBytes_ - ssdSpillReservedBytes_);
+  }
+}
+
+void Task::releaseSsdCacheSpaceForSpill(uint64_t bytes) {
+  std::lock_guard<std::mutex> l(ssdSpillSpaceMutex_);
+  ssdSpillBytes_ -= std::min(ssdSpillBytes_, bytes);
+  // The space is reserved in whole regions. Gives back the regions the
+  // remaining spill files do not need.
+  const auto neededBytes =
+      bits::roundUp(ssdSpillBytes_, cache::SsdFile::kRegionSize);
+  if (ssdSpillReservedBytes_ <= neededBytes) {
+    return;
+  }
+  try {
+    queryCtx_->cache()->ssdCache()->releaseSpace(
+        ssdSpillReservedBytes_ - neededBytes);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to release SSD cache space for spill of Task "
+               << taskId() << ": " << e.what();
+  }
+  ssdSpillReservedBytes_ = neededBytes;
+}
+
+void Task::releaseSsdCacheSpaceForSpill() {
+  std::lock_guard<std::mutex> l(ssdSpillSpaceMutex_);
+  if (ssdSpillReservedBytes_ == 0) {
+    return;
+  }
+  try {
+    queryCtx_->cache()->ssdCache()->releaseSpace(ssdSpillReservedBytes_);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to release SSD cache space for spill of Task "
+               << taskId() << ": " << e.what();
+  }
+  ssdSpillReservedBytes_ = 0;
+}
+
 uint64_t Task::driverCpuTimeSliceLimitMs() const {
   return mode_ == Task::ExecutionMode::kSerial
       ? 0
@@ -433,6 +566,9 @@ velox::memory::MemoryPool* Task::getOrAddNodePool(
       fmt::format("node.{}", planNodeId), createNodeReclaimer(false)));
   auto* nodePool = childPools_.back().get();
   nodePools_[planNodeId] = nodePool;
+  if (auto* progress = nodeProgress(planNodeId)) {
+    progress->pool = nodePool;
+  }
   return nodePool;
 }
 
@@ -449,6 +585,11 @@ memory::MemoryPool* Task::getOrAddJoinNodePool(
       fmt::format("node.{}", nodeId), createNodeReclaimer(true)));
   auto* nodePool = childPools_.back().get();
   nodePools_[nodeId] = nodePool;
+  if (splitGroupId == kUngroupedGroupId) {
+    if (auto* progress = nodeProgress(planNodeId)) {
+      progress->pool = nodePool;
+    }
+  }
   return nodePool;
 }
 
@@ -602,6 +743,7 @@ RowVectorPtr Task::next(ContinueFuture* future) {
       taskStats_.pipelineStats.emplace_back(
           factory->inputDriver, factory->outputDriver);
     }
+    initPipelineProgressLocked();
 
     // Create drivers.
     createSplitGroupStateLocked(kUngroupedGroupId);
@@ -752,6 +894,7 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
     taskStats_.pipelineStats.emplace_back(
         factory->inputDriver, factory->outputDriver);
   }
+  initPipelineProgressLocked();
 
   validateGroupedExecutionLeafNodes();
 }
@@ -810,9 +953,10 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
     //
     // We might have first slots taken for grouped execution drivers, so need
     // only to enqueue the ungrouped execution drivers.
+    deferBuildPipelinesLocked();
     for (auto it = drivers_.end() - numDriversUngrouped_; it != drivers_.end();
          ++it) {
-      if (*it) {
+      if (*it && !isDeferredLocked((*it)->driverCtx()->pipelineId)) {
         ++numRunningDrivers_;
         Driver::enqueue(*it);
       }
@@ -826,6 +970,123 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   }
 }
 
+namespace {
+// Returns true if drivers can be added to the pipeline of 'factory' after
+// the start of the task. The source must be a table scan. The other nodes
+// must not rely on a fixed number of drivers, as join builds and probes
+// do for their barriers and local merges do for their sources.
+bool canAddDrivers(const DriverFactory& factory) {
+  const auto& planNodes = factory.planNodes;
+  if (planNodes.empty() ||
+      !std::dynamic_pointer_cast<const core::TableScanNode>(planNodes[0])) {
+    return false;
+  }
+  // The sink is either a local exchange producer for the consumer node or a
+  // partitioned output at the end of 'planNodes'.
+  auto numNodes = planNodes.size();
+  if (std::dynamic_pointer_cast<const core::PartitionedOutputNode>(
+          planNodes.back())) {
+    --numNodes;
+  } else if (!std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+                 factory.consumerNode)) {
+    return false;
+  }
+  for (auto i = 1; i < numNodes; ++i) {
+    const auto& node = planNodes[i];
+    if (!std::dynamic_pointer_cast<const core::FilterNode>(node) &&
+        !std::dynamic_pointer_cast<const core::ProjectNode>(node) &&
+        !std::dynamic_pointer_cast<const core::AggregationNode>(node)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the pipeline of 'factory' can wait for admission. It must
+// be an ungrouped hash join build that does not wait for other pipelines of
+// the task, so that the admitted builds always make progress: the leaf node
+// is a source, e.g. a table scan, and no node is a join probe.
+bool canDeferStart(const DriverFactory& factory) {
+  if (factory.groupedExecution || factory.planNodes.empty() ||
+      !factory.planNodes.front()->sources().empty() ||
+      !std::dynamic_pointer_cast<const core::HashJoinNode>(
+          factory.consumerNode)) {
+    return false;
+  }
+  for (const auto& node : factory.planNodes) {
+    if (std::dynamic_pointer_cast<const core::AbstractJoinNode>(node) ||
+        std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(node)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+uint32_t Task::addDrivers(uint32_t pipelineId, uint32_t numDrivers) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  if (!isRunningLocked() || !isUngroupedExecution() || drivers_.empty() ||
+      pipelineId >= driverFactories_.size()) {
+    return 0;
+  }
+  auto& factory = driverFactories_[pipelineId];
+  if (factory->groupedExecution || !canAddDrivers(*factory)) {
+    return 0;
+  }
+  {
+    auto& splitsState =
+        getPlanNodeSplitsStateLocked(factory->planNodes[0]->id());
+    auto& store = splitsState.groupSplitsStores[kUngroupedGroupId];
+    if (store.noMoreSplits && store.splits.empty()) {
+      return 0;
+    }
+  }
+  // Running drivers of the pipeline keep the local exchange producers and
+  // the output buffer open, so that the new drivers can still join them.
+  // With splits left none of them has finished.
+  const bool hasRunningDrivers =
+      std::any_of(drivers_.begin(), drivers_.end(), [&](const auto& driver) {
+        return driver != nullptr &&
+            driver->driverCtx()->pipelineId == pipelineId;
+      });
+  if (!hasRunningDrivers) {
+    return 0;
+  }
+  auto& splitGroupState = splitGroupStates_[kUngroupedGroupId];
+  numDrivers =
+      std::min(numDrivers, factory->maxDrivers - factory->numDrivers);
+
+  auto self = shared_from_this();
+  for (uint32_t count = 0; count < numDrivers; ++count) {
+    const uint32_t partitionId = factory->numDrivers;
+    auto driver = factory->createDriver(
+        std::make_unique<DriverCtx>(
+            self, partitionId, pipelineId, kUngroupedGroupId, partitionId),
+        getExchangeClientLocked(pipelineId),
+        [self](size_t i) {
+          return i < self->driverFactories_.size()
+              ? self->driverFactories_[i]->numTotalDrivers
+              : 0;
+        });
+    ++factory->numDrivers;
+    ++factory->numTotalDrivers;
+    ++numDriversUngrouped_;
+    ++numTotalDrivers_;
+    ++splitGroupState.numRunningDrivers;
+    if (factory->needsPartitionedOutput() != nullptr) {
+      ++numDriversInPartitionedOutput_;
+      if (auto bufferManager = bufferManager_.lock()) {
+        bufferManager->updateNumDrivers(
+            taskId(), numDriversInPartitionedOutput_);
+      }
+    }
+    drivers_.push_back(driver);
+    ++numRunningDrivers_;
+    Driver::enqueue(driver);
+  }
+  return numDrivers;
+}
+
 void Task::initializePartitionOutput() {
   VELOX_CHECK(
       isRunningLocked(),
@@ -911,6 +1172,10 @@ void Task::resume(std::shared_ptr<Task> self) {
             continue;
           }
           VELOX_CHECK(!driver->isOnThread() && !driver->isTerminated());
+          if (self->isDeferredLocked(driver->driverCtx()->pipelineId)) {
+            // Started by admitBuildPipelinesLocked().
+            continue;
+          }
           if (!driver->state().hasBlockingFuture) {
             if (driver->state().endExecTimeMs != 0) {
               driver->state().totalPauseTimeMs +=
@@ -1090,6 +1355,7 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   bool foundDriver = false;
   bool allFinished = true;
   EventCompletionNotifier stateChangeNotifier;
+  std::optional<PipelineBoundaryStats> finishedPipeline;
   {
     std::lock_guard<std::timed_mutex> taskLock(self->mutex_);
     for (auto& driverPtr : self->drivers_) {
@@ -1104,11 +1370,28 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
       --splitGroupState.numRunningDrivers;
 
       auto pipelineId = driver->driverCtx()->pipelineId;
+      self->pipelineProgress_[pipelineId].numFinishedDrivers.fetch_add(
+          1, std::memory_order_relaxed);
 
       if (self->isOutputPipeline(pipelineId)) {
         ++splitGroupState.numFinishedOutputDrivers;
       }
 
+      if (const auto& trace = driver->trace()) {
+        self->finishedDriverTraces_.push_back(trace);
+      }
+
+      if (!self->driverFactories_[pipelineId]->groupedExecution) {
+        auto& numFinished = self->numFinishedDriversPerPipeline_;
+        numFinished.resize(self->driverFactories_.size());
+        if (++numFinished[pipelineId] ==
+                self->driverFactories_[pipelineId]->numTotalDrivers &&
+            self->state_ == TaskState::kRunning) {
+          finishedPipeline = self->pipelineBoundaryStatsLocked(pipelineId);
+          self->onBuildPipelineFinishedLocked(pipelineId);
+        }
+      }
+
       // Release the driver, note that after this 'driver' is invalid.
       driverPtr = nullptr;
       self->driverClosedLocked();
@@ -1140,6 +1423,10 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   }
   stateChangeNotifier.notify();
 
+  if (finishedPipeline.has_value()) {
+    self->onPipelineFinished(*finishedPipeline);
+  }
+
   if (!foundDriver) {
     LOG(WARNING) << "Trying to remove a Driver twice from its Task";
   }
@@ -1272,6 +1559,7 @@ std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     exec::Split&& split) {
   ++taskStats_.numTotalSplits;
   ++taskStats_.numQueuedSplits;
+  numProgressTotalSplits_.fetch_add(1, std::memory_order_relaxed);
 
   if (split.connectorSplit) {
     VELOX_CHECK_NULL(split.connectorSplit->dataSource);
@@ -1453,6 +1741,55 @@ BlockingReason Task::getSplitOrFuture(
       preload);
 }
 
+void Task::addExportedDynamicFilters(
+    const core::PlanNodeId& joinNodeId,
+    std::unordered_map<std::string, std::shared_ptr<common::Filter>> filters) {
+  if (filters.empty()) {
+    return;
+  }
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  exportedDynamicFilters_.emplace(joinNodeId, std::move(filters));
+}
+
+std::unordered_map<std::string, std::shared_ptr<common::Filter>>
+Task::exportedDynamicFilters(const core::PlanNodeId& joinNodeId) const {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto it = exportedDynamicFilters_.find(joinNodeId);
+  if (it == exportedDynamicFilters_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+void Task::addDynamicFilters(
+    const core::PlanNodeId& scanNodeId,
+    const core::PlanNodeId& producer,
+    const std::unordered_map<std::string, std::shared_ptr<common::Filter>>&
+        filters) {
+  if (filters.empty()) {
+    return;
+  }
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  VELOX_USER_CHECK(
+      getPlanNodeSplitsStateLocked(scanNodeId).sourceIsTableScan,
+      "Dynamic filters can only be added to table scan nodes: {}",
+      scanNodeId);
+  injectedDynamicFilters_[scanNodeId].emplace_back(producer, filters);
+  ++injectedDynamicFiltersVersion_;
+}
+
+std::vector<std::pair<
+    core::PlanNodeId,
+    std::unordered_map<std::string, std::shared_ptr<common::Filter>>>>
+Task::injectedDynamicFilters(const core::PlanNodeId& scanNodeId) const {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto it = injectedDynamicFilters_.find(scanNodeId);
+  if (it == injectedDynamicFilters_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
 BlockingReason Task::getSplitOrFutureLocked(
     bool forTableScan,
     SplitsStore& splitsStore,
@@ -1482,19 +1819,41 @@ exec::Split Task::getSplitLocked(
     const ConnectorSplitPreloadFunc& preload) {
   int32_t readySplitIndex = -1;
   if (maxPreloadSplits > 0) {
-    for (auto i = 0; i < splitsStore.splits.size() && i < maxPreloadSplits;
-         ++i) {
+    const auto maxPreloadBytes =
+        queryCtx_->queryConfig().maxSplitPreloadBytes();
+    const auto depth = maxPreloadSplits + extraPreloadSplits_;
+    // True if the first split was preloading before this call.
+    const bool firstPreloading =
+        splitsStore.splits[0].connectorSplit->dataSource != nullptr;
+    bool allReady = true;
+    for (auto i = 0; i < splitsStore.splits.size() && i < depth; ++i) {
       auto& connectorSplit = splitsStore.splits[i].connectorSplit;
       if (!connectorSplit->dataSource) {
+        if (maxPreloadBytes > 0 && preloadingBytes_ >= maxPreloadBytes) {
+          // The splits after this one get preloaded when the preloading ones
+          // are consumed.
+          break;
+        }
         // Initializes split->dataSource.
         preload(connectorSplit);
         preloadingSplits_.emplace(connectorSplit);
-      } else if (
-          (readySplitIndex == -1) && (connectorSplit->dataSource->hasValue())) {
+        preloadingBytes_ += connectorSplit->byteSize();
+        allReady = false;
+      } else if (!connectorSplit->dataSource->hasValue()) {
+        allReady = false;
+      } else if (readySplitIndex == -1) {
         readySplitIndex = i;
         preloadingSplits_.erase(connectorSplit);
       }
     }
+    // Preloads further ahead while Drivers find their next split still
+    // loading, e.g. because of high storage latency, and less far when all
+    // the preloaded splits are ready.
+    if (firstPreloading && readySplitIndex == -1) {
+      extraPreloadSplits_ = std::min(extraPreloadSplits_ + 1, maxPreloadSplits);
+    } else if (allReady && extraPreloadSplits_ > 0) {
+      --extraPreloadSplits_;
+    }
   }
   if (readySplitIndex == -1) {
     readySplitIndex = 0;
@@ -1502,9 +1861,14 @@ exec::Split Task::getSplitLocked(
   VELOX_CHECK(!splitsStore.splits.empty());
   auto split = std::move(splitsStore.splits[readySplitIndex]);
   splitsStore.splits.erase(splitsStore.splits.begin() + readySplitIndex);
+  if (split.connectorSplit && split.connectorSplit->dataSource) {
+    const auto bytes = split.connectorSplit->byteSize();
+    preloadingBytes_ -= std::min(bytes, preloadingBytes_);
+  }
 
   --taskStats_.numQueuedSplits;
   ++taskStats_.numRunningSplits;
+  numProgressStartedSplits_.fetch_add(1, std::memory_order_relaxed);
   if (forTableScan && split.connectorSplit) {
     --taskStats_.numQueuedTableScanSplits;
     ++taskStats_.numRunningTableScanSplits;
@@ -1524,6 +1888,7 @@ void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   ++taskStats_.numFinishedSplits;
   --taskStats_.numRunningSplits;
+  numProgressFinishedSplits_.fetch_add(1, std::memory_order_relaxed);
   if (fromTableScan) {
     --taskStats_.numRunningTableScanSplits;
     taskStats_.runningTableScanSplitWeights -= splitWeight;
@@ -1540,6 +1905,7 @@ void Task::multipleSplitsFinished(
   std::lock_guard<std::timed_mutex> l(mutex_);
   taskStats_.numFinishedSplits += numSplits;
   taskStats_.numRunningSplits -= numSplits;
+  numProgressFinishedSplits_.fetch_add(numSplits, std::memory_order_relaxed);
   if (fromTableScan) {
     taskStats_.numRunningTableScanSplits -= numSplits;
     taskStats_.runningTableScanSplitWeights -= splitsWeight;
@@ -1853,6 +2219,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       return makeFinishFutureLocked("Task::terminate");
     }
     state_ = terminalState;
+    progressState_ = terminalState;
     VELOX_CHECK_EQ(
         taskStats_.terminationTimeMs,
         0,
@@ -1999,6 +2366,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
     split->dataSource->close();
   }
   preloadingSplits_.clear();
+  preloadingBytes_ = 0;
 
   return makeFinishFuture("Task::terminate");
 }
@@ -2110,6 +2478,79 @@ TaskStats Task::taskStats() const {
   return taskStats;
 }
 
+TaskProgress Task::progress() const {
+  TaskProgress progress;
+  progress.taskId = taskId_;
+  progress.state = progressState_;
+
+  // Reads the finished before the started and the started before the total
+  // splits so that the queued and running counts are not negative.
+  const auto numFinished =
+      numProgressFinishedSplits_.load(std::memory_order_relaxed);
+  const auto numStarted =
+      numProgressStartedSplits_.load(std::memory_order_relaxed);
+  const auto numTotal = numProgressTotalSplits_.load(std::memory_order_relaxed);
+  progress.numTotalSplits = numTotal;
+  progress.numQueuedSplits = std::max(0, numTotal - numStarted);
+  progress.numRunningSplits = std::max(0, numStarted - numFinished);
+  progress.numFinishedSplits = numFinished;
+
+  progress.memoryBytes = pool_->currentBytes();
+
+  const auto numPipelines =
+      numProgressPipelines_.load(std::memory_order_acquire);
+  progress.pipelines.resize(numPipelines);
+  for (auto i = 0; i < numPipelines; ++i) {
+    const auto& counters = pipelineProgress_[i];
+    auto& pipeline = progress.pipelines[i];
+    pipeline.inputRows = counters.inputRows.load(std::memory_order_relaxed);
+    pipeline.outputRows = counters.outputRows.load(std::memory_order_relaxed);
+    pipeline.numTotalDrivers = counters.numTotalDrivers;
+    pipeline.numFinishedDrivers =
+        counters.numFinishedDrivers.load(std::memory_order_relaxed);
+  }
+
+  progress.nodes.resize(nodeProgress_.size());
+  for (auto i = 0; i < nodeProgress_.size(); ++i) {
+    const auto& counters = nodeProgress_[i];
+    auto& node = progress.nodes[i];
+    node.planNodeId = counters.planNodeId;
+    if (const auto* pool = counters.pool.load()) {
+      node.memoryBytes = pool->currentBytes();
+    }
+    node.spilledBytes = counters.spilledBytes.load(std::memory_order_relaxed);
+    progress.spilledBytes += node.spilledBytes;
+  }
+  return progress;
+}
+
+void Task::addSpilledBytes(const core::PlanNodeId& planNodeId, uint64_t bytes) {
+  if (auto* progress = nodeProgress(planNodeId)) {
+    progress->spilledBytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+
+Task::NodeProgressCounters* Task::nodeProgress(
+    const core::PlanNodeId& planNodeId) {
+  for (auto& progress : nodeProgress_) {
+    if (progress.planNodeId == planNodeId) {
+      return &progress;
+    }
+  }
+  return nullptr;
+}
+
+void Task::initPipelineProgressLocked() {
+  VELOX_CHECK_EQ(numProgressPipelines_.load(), 0);
+  pipelineProgress_ =
+      std::make_unique<PipelineProgressCounters[]>(driverFactories_.size());
+  for (auto i = 0; i < driverFactories_.size(); ++i) {
+    pipelineProgress_[i].numTotalDrivers = driverFactories_[i]->numTotalDrivers;
+  }
+  numProgressPipelines_.store(
+      driverFactories_.size(), std::memory_order_release);
+}
+
 bool Task::getLongRunningOpCalls(
     std::chrono::nanoseconds lockTimeout,
     size_t thresholdDurationMs,
@@ -2183,6 +2624,124 @@ Task::DriverCounts Task::driverCounts() const {
   return ret;
 }
 
+void Task::deferBuildPipelinesLocked() {
+  const auto& queryConfig = queryCtx_->queryConfig();
+  if (queryConfig.hashBuildAdmissionMemoryPct() <= 0) {
+    return;
+  }
+  // A spillable build does not finish when its table is published. It waits
+  // for its probe, which may wait for the table of a deferred build.
+  if (queryConfig.spillEnabled() && queryConfig.joinSpillEnabled()) {
+    return;
+  }
+  admissionControlledPipelines_.resize(driverFactories_.size(), false);
+  for (auto i = 0; i < driverFactories_.size(); ++i) {
+    if (!canDeferStart(*driverFactories_[i])) {
+      continue;
+    }
+    admissionControlledPipelines_[i] = true;
+    // The first build starts right away. The others wait for an estimate of
+    // their memory from the finished builds.
+    if (numAdmittedBuildPipelines_ == 0) {
+      ++numAdmittedBuildPipelines_;
+    } else {
+      deferredBuildPipelines_.push_back(i);
+    }
+  }
+}
+
+bool Task::isDeferredLocked(uint32_t pipelineId) const {
+  return std::find(
+             deferredBuildPipelines_.begin(),
+             deferredBuildPipelines_.end(),
+             pipelineId) != deferredBuildPipelines_.end();
+}
+
+void Task::onBuildPipelineFinishedLocked(uint32_t pipelineId) {
+  if (pipelineId >= admissionControlledPipelines_.size() ||
+      !admissionControlledPipelines_[pipelineId]) {
+    return;
+  }
+  VELOX_CHECK_GT(numAdmittedBuildPipelines_, 0);
+  --numAdmittedBuildPipelines_;
+  const auto& operatorStats =
+      taskStats_.pipelineStats[pipelineId].operatorStats;
+  if (!operatorStats.empty()) {
+    // The peak is per driver.
+    const auto& buildStats = operatorStats.back();
+    maxBuildPipelineBytes_ = std::max<uint64_t>(
+        maxBuildPipelineBytes_,
+        buildStats.memoryStats.peakTotalMemoryReservation *
+            driverFactories_[pipelineId]->numDrivers);
+  }
+  admitBuildPipelinesLocked();
+}
+
+void Task::admitBuildPipelinesLocked() {
+  const auto* root = pool_->root();
+  const auto memoryLimit = root->maxCapacity() / 100 *
+      queryCtx_->queryConfig().hashBuildAdmissionMemoryPct();
+  while (!deferredBuildPipelines_.empty()) {
+    // Always keep one build running so that the task makes progress.
+    if (numAdmittedBuildPipelines_ > 0 &&
+        root->reservedBytes() +
+                (numAdmittedBuildPipelines_ + 1) * maxBuildPipelineBytes_ >
+            memoryLimit) {
+      break;
+    }
+    const auto pipelineId = deferredBuildPipelines_.front();
+    deferredBuildPipelines_.pop_front();
+    ++numAdmittedBuildPipelines_;
+    ++taskStats_.numDeferredPipelineStarts;
+    for (auto& driver : drivers_) {
+      if (driver != nullptr && driver->driverCtx()->pipelineId == pipelineId) {
+        ++numRunningDrivers_;
+        Driver::enqueue(driver);
+      }
+    }
+  }
+}
+
+void Task::addPipelineNdvSketch(
+    int32_t pipelineId,
+    std::unique_ptr<NdvSketch> sketch) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  pipelineNdvSketches_.resize(driverFactories_.size());
+  VELOX_CHECK_LT(pipelineId, pipelineNdvSketches_.size());
+  auto& pipelineSketch = pipelineNdvSketches_[pipelineId];
+  if (pipelineSketch == nullptr) {
+    pipelineSketch = std::move(sketch);
+  } else {
+    pipelineSketch->merge(*sketch);
+  }
+}
+
+PipelineBoundaryStats Task::pipelineBoundaryStatsLocked(
+    int32_t pipelineId) const {
+  PipelineBoundaryStats result{
+      pipelineId, "", 0, 0, {}, taskStats_.pipelineStats[pipelineId]};
+  const auto& operatorStats = result.stats.operatorStats;
+  if (!operatorStats.empty()) {
+    const auto& sinkStats = operatorStats.back();
+    result.planNodeId = sinkStats.planNodeId;
+    result.numRows = sinkStats.inputPositions;
+    result.numBytes = sinkStats.inputBytes;
+  }
+  if (pipelineId < pipelineNdvSketches_.size() &&
+      pipelineNdvSketches_[pipelineId] != nullptr) {
+    result.numDistinct = pipelineNdvSketches_[pipelineId]->numDistinct();
+  }
+  return result;
+}
+
+void Task::onPipelineFinished(const PipelineBoundaryStats& stats) {
+  listeners().withRLock([&](auto& listeners) {
+    for (auto& listener : listeners) {
+      listener->onPipelineFinished(uuid_, taskId_, stats);
+    }
+  });
+}
+
 void Task::onTaskCompletion() {
   listeners().withRLock([&](auto& listeners) {
     if (listeners.empty()) {
@@ -2351,6 +2910,24 @@ folly::dynamic Task::toJson() const {
   return obj;
 }
 
+std::string Task::toChromeTrace() const {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  folly::dynamic traceEvents = folly::dynamic::array;
+  for (const auto& trace : finishedDriverTraces_) {
+    trace->appendChromeTrace(traceEvents);
+  }
+  for (const auto& driver : drivers_) {
+    if (driver != nullptr && driver->trace() != nullptr) {
+      driver->trace()->appendChromeTrace(traceEvents);
+    }
+  }
+  folly::dynamic obj = folly::dynamic::object;
+  obj["traceEvents"] = std::move(traceEvents);
+  obj["displayTimeUnit"] = "ms";
+  obj["otherData"] = folly::dynamic::object("taskId", taskId_);
+  return folly::toJson(obj);
+}
+
 std::shared_ptr<MergeSource> Task::addLocalMergeSource(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
@@ -2562,6 +3139,7 @@ void Task::leave(
       if (--numThreads_ == 0) {
         threadFinishPromises = allThreadsFinishedLocked();
       }
+      queryCtx_->addExecTimeMs(state.execTimeMs());
       state.clearThread();
       return;
     }
@@ -2577,6 +3155,7 @@ void Task::leave(
   if (--numThreads_ == 0) {
     threadFinishPromises = allThreadsFinishedLocked();
   }
+  queryCtx_->addExecTimeMs(state.execTimeMs());
   state.clearThread();
 }
 
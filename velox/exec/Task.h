@@ -21,6 +21,7 @@
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Split.h"
+#include "velox/exec/TaskProgress.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
 #include "velox/vector/ComplexVector.h"
@@ -106,6 +107,17 @@ class Task : public std::enable_shared_from_this<Task> {
 
   folly::dynamic toShortJson() const;
 
+  /// Returns the timelines of the Drivers of 'this' as Chrome trace JSON, to
+  /// be opened in chrome://tracing or Perfetto. Includes the finished
+  /// Drivers. Empty unless QueryConfig::kDriverTraceCapacity is set.
+  std::string toChromeTrace() const;
+
+  /// Adds the NDV estimates of a Driver of pipeline 'pipelineId' at close.
+  /// See QueryConfig::kPipelineNdvSketchEnabled.
+  void addPipelineNdvSketch(
+      int32_t pipelineId,
+      std::unique_ptr<NdvSketch> sketch);
+
   /// Returns universally unique identifier of the task.
   const std::string& uuid() const {
     return uuid_;
@@ -163,6 +175,22 @@ class Task : public std::enable_shared_from_this<Task> {
   /// splits groups processed concurrently.
   void start(uint32_t maxDrivers, uint32_t concurrentSplitGroups = 1);
 
+  /// Adds up to 'numDrivers' drivers to running pipeline 'pipelineId', e.g.
+  /// when its drivers are found to spend much of their time blocked on I/O.
+  /// The caller decides when to grow, for example from the blocked and on
+  /// thread times in the task stats. Drivers without more work need not be
+  /// retired, they finish when their source has no more splits. Returns the
+  /// number of drivers added, which is 0 unless:
+  ///  - the task is running with ungrouped execution and has started,
+  ///  - the pipeline starts with a TableScan that has unprocessed splits or
+  ///    may receive more,
+  ///  - the pipeline has only filter, project and aggregation nodes after the
+  ///    scan and ends with a local or partitioned output, none of which
+  ///    depends on a fixed number of peer drivers. The number of drivers
+  ///    stays at most the maximum the local planner allows for the
+  ///    pipeline.
+  uint32_t addDrivers(uint32_t pipelineId, uint32_t numDrivers);
+
   /// If this returns true, this Task supports the single-threaded execution API
   /// next().
   bool supportsSingleThreadedExecution() const;
@@ -283,6 +311,24 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Returns a snapshot of the split, row, memory and spill counters of
+  /// 'this'. Does not take 'mutex_' or the operator stats locks, so that it
+  /// can be polled often for many Tasks. Reads the memory usage of the Task
+  /// and plan node memory pools, which takes their own mutexes briefly.
+  TaskProgress progress() const;
+
+  /// Returns the progress counters of pipeline 'pipelineId' for its Drivers
+  /// to update. Valid once the Drivers are created.
+  PipelineProgressCounters& pipelineProgress(int32_t pipelineId) {
+    VELOX_DCHECK_LT(
+        pipelineId, numProgressPipelines_.load(std::memory_order_acquire));
+    return pipelineProgress_[pipelineId];
+  }
+
+  /// Adds 'bytes' to the spilled bytes of 'planNodeId' reported by
+  /// progress().
+  void addSpilledBytes(const core::PlanNodeId& planNodeId, uint64_t bytes);
+
   /// Information about an operator call that helps debugging stuck calls.
   struct OpCallInfo {
     size_t durationMs;
@@ -413,6 +459,48 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t numSplits,
       int64_t splitsWeight);
 
+  /// Records the dynamic filters produced by hash join 'joinNodeId' so they
+  /// can be exported to other tasks. 'filters' are keyed by probe-side join
+  /// key column name. All probe drivers of a join share the same hash table,
+  /// so only the first set of filters recorded for a join node is kept.
+  void addExportedDynamicFilters(
+      const core::PlanNodeId& joinNodeId,
+      std::unordered_map<std::string, std::shared_ptr<common::Filter>>
+          filters);
+
+  /// Returns the dynamic filters produced by hash join 'joinNodeId' keyed by
+  /// probe-side join key column name, or an empty map if the join has not
+  /// produced any yet. Filters are produced only if
+  /// QueryConfig::hashProbeExportDynamicFilters() is set. A coordinator can
+  /// forward them to scans of other tasks via addDynamicFilters().
+  std::unordered_map<std::string, std::shared_ptr<common::Filter>>
+  exportedDynamicFilters(const core::PlanNodeId& joinNodeId) const;
+
+  /// Injects dynamic filters produced outside of this task, e.g. by a hash
+  /// join running in another task or stage, into table scan 'scanNodeId'.
+  /// 'filters' are keyed by scan output column name. Filters on columns the
+  /// scan does not output are ignored. Filters added for the same column are
+  /// merged. The scan operators pick up the filters before fetching their
+  /// next split. 'producer' is reported in the scan's dynamic filter stats.
+  void addDynamicFilters(
+      const core::PlanNodeId& scanNodeId,
+      const core::PlanNodeId& producer,
+      const std::unordered_map<std::string, std::shared_ptr<common::Filter>>&
+          filters);
+
+  /// Returns the version of the dynamic filters injected via
+  /// addDynamicFilters(). Changes each time new filters are injected.
+  uint64_t injectedDynamicFiltersVersion() const {
+    return injectedDynamicFiltersVersion_;
+  }
+
+  /// Returns the dynamic filters injected into table scan 'scanNodeId' as
+  /// pairs of producer and per column filters.
+  std::vector<std::pair<
+      core::PlanNodeId,
+      std::unordered_map<std::string, std::shared_ptr<common::Filter>>>>
+  injectedDynamicFilters(const core::PlanNodeId& scanNodeId) const;
+
   /// Adds a MergeSource for the specified splitGroupId and planNodeId.
   std::shared_ptr<MergeSource> addLocalMergeSource(
       uint32_t splitGroupId,
@@ -650,6 +738,17 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  /// Returns the spill config with the settings from the query config that
+  /// are the same for all operators of the task. Made on first use so that
+  /// each spillable operator of each driver copies it instead of looking up
+  /// and parsing the settings again. The returned config has no file name
+  /// prefix. Is thread safe.
+  const common::SpillConfig& spillConfigTemplate();
+
+  /// Returns the parsed QueryConfig::kDriverPriorityLevelsMs. Parsed once per
+  /// task. Is thread safe.
+  const std::vector<uint64_t>& driverPriorityLevelsMs();
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -713,6 +812,17 @@ class Task : public std::enable_shared_from_this<Task> {
   // spilling.
   void removeSpillDirectoryIfExists();
 
+  // Takes SSD cache capacity for 'bytes' more spilled bytes if the reserved
+  // space does not cover them. See QueryConfig::kSpillReserveSsdCacheSpace.
+  void reserveSsdCacheSpaceForSpill(uint64_t bytes);
+
+  // Gives back the SSD cache capacity that the spill of this task no longer
+  // needs after spill files of 'bytes' were removed.
+  void releaseSsdCacheSpaceForSpill(uint64_t bytes);
+
+  // Gives back the SSD cache capacity taken for spill by this task.
+  void releaseSsdCacheSpaceForSpill();
+
   // Invoked to initialize the memory pool for this task on creation.
   void initTaskPool();
 
@@ -883,6 +993,28 @@ class Task : public std::enable_shared_from_this<Task> {
   // Notifies listeners that the task is now complete.
   void onTaskCompletion();
 
+  // Returns the stats at the end of pipeline 'pipelineId' once all its
+  // Drivers have finished.
+  PipelineBoundaryStats pipelineBoundaryStatsLocked(int32_t pipelineId) const;
+
+  // Notifies listeners that a pipeline has finished.
+  void onPipelineFinished(const PipelineBoundaryStats& stats);
+
+  // Selects the hash join build pipelines that wait for admission at task
+  // start. See QueryConfig::kHashBuildAdmissionMemoryPct.
+  void deferBuildPipelinesLocked();
+
+  // Returns true if the drivers of 'pipelineId' wait for admission.
+  bool isDeferredLocked(uint32_t pipelineId) const;
+
+  // Updates the memory estimate of a build pipeline from the stats of
+  // 'pipelineId' if it is under admission control and admits the next ones.
+  void onBuildPipelineFinishedLocked(uint32_t pipelineId);
+
+  // Starts the deferred build pipelines that fit in the memory limit, at
+  // least one if no admitted build is running.
+  void admitBuildPipelinesLocked();
+
   // Returns true if all splits are finished processing and there are no more
   // splits coming for the task.
   bool isAllSplitsFinishedLocked();
@@ -1043,6 +1175,27 @@ class Task : public std::enable_shared_from_this<Task> {
   /// to the Task making it a zombie Tasks. This vector is used to keep track of
   /// such drivers to assist debugging zombie Tasks.
   std::vector<std::weak_ptr<Driver>> driversClosedByTask_;
+  /// Timelines of the Drivers that are removed from 'drivers_'. See
+  /// toChromeTrace().
+  std::vector<std::shared_ptr<DriverTrace>> finishedDriverTraces_;
+  /// NDV estimates at the end of each pipeline, merged from the finished
+  /// Drivers. See addPipelineNdvSketch().
+  std::vector<std::unique_ptr<NdvSketch>> pipelineNdvSketches_;
+  /// Number of finished Drivers per pipeline, for telling listeners when a
+  /// pipeline is done.
+  std::vector<uint32_t> numFinishedDriversPerPipeline_;
+  /// True for the pipelines under admission control. See
+  /// QueryConfig::kHashBuildAdmissionMemoryPct.
+  std::vector<bool> admissionControlledPipelines_;
+  /// The pipelines under admission control whose drivers are not started
+  /// yet, in start order.
+  std::deque<uint32_t> deferredBuildPipelines_;
+  /// The number of started and not finished pipelines under admission
+  /// control.
+  uint32_t numAdmittedBuildPipelines_{0};
+  /// The largest peak memory of a finished pipeline under admission control.
+  /// The estimate for the memory of a build pipeline that is not finished.
+  uint64_t maxBuildPipelineBytes_{0};
   /// The total number of running drivers in all pipelines.
   /// This number changes over time as drivers finish their work and maybe new
   /// get created.
@@ -1104,6 +1257,26 @@ class Task : public std::enable_shared_from_this<Task> {
   /// manage splits of the plan nodes that expect splits.
   std::unordered_map<core::PlanNodeId, SplitsState> splitsStates_;
 
+  // Dynamic filters produced by hash joins keyed by join node id and then by
+  // probe-side key column name.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::unordered_map<std::string, std::shared_ptr<common::Filter>>>
+      exportedDynamicFilters_;
+
+  // Dynamic filters injected from outside of the task keyed by table scan node
+  // id. Each entry holds the producer and the filters keyed by column name.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::vector<std::pair<
+          core::PlanNodeId,
+          std::unordered_map<std::string, std::shared_ptr<common::Filter>>>>>
+      injectedDynamicFilters_;
+
+  // Incremented each time dynamic filters are injected. Lets table scans
+  // check for new filters without acquiring 'mutex_'.
+  std::atomic<uint64_t> injectedDynamicFiltersVersion_{0};
+
   // Promises that are fulfilled when the task is completed (terminated).
   std::vector<ContinuePromise> taskCompletionPromises_;
 
@@ -1113,6 +1286,38 @@ class Task : public std::enable_shared_from_this<Task> {
 
   TaskStats taskStats_;
 
+  struct NodeProgressCounters {
+    core::PlanNodeId planNodeId;
+    // Pool of the operators of the node in ungrouped execution. Owned by
+    // 'childPools_'.
+    std::atomic<memory::MemoryPool*> pool{nullptr};
+    std::atomic<uint64_t> spilledBytes{0};
+  };
+
+  // Returns the progress counters of 'planNodeId' or nullptr if it is not a
+  // node of the plan.
+  NodeProgressCounters* nodeProgress(const core::PlanNodeId& planNodeId);
+
+  // Makes 'pipelineProgress_' from 'driverFactories_'.
+  void initPipelineProgressLocked();
+
+  // Counters for progress(). Written along with 'state_' and 'taskStats_'
+  // and read without 'mutex_'. The queued splits are the added ones that
+  // are not started and the running ones are started and not finished.
+  std::atomic<TaskState> progressState_{TaskState::kRunning};
+  std::atomic<int32_t> numProgressTotalSplits_{0};
+  std::atomic<int32_t> numProgressStartedSplits_{0};
+  std::atomic<int32_t> numProgressFinishedSplits_{0};
+
+  // The size of 'pipelineProgress_', stored with release after it is made so
+  // that progress() can read it without 'mutex_'. 0 before the Task starts.
+  std::atomic<int32_t> numProgressPipelines_{0};
+  std::unique_ptr<PipelineProgressCounters[]> pipelineProgress_;
+
+  // One entry per plan node in pre-order of the plan. Made at construction
+  // and not resized after.
+  std::vector<NodeProgressCounters> nodeProgress_;
+
   /// Stores inter-operator state (exchange, bridges) per split group.
   /// During ungrouped execution we use the [0] entry in this vector.
   std::unordered_map<uint32_t, SplitGroupState> splitGroupStates_;
@@ -1152,9 +1357,31 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  std::once_flag spillConfigTemplateOnce_;
+  common::SpillConfig spillConfigTemplate_;
+
+  std::once_flag driverPriorityLevelsOnce_;
+  std::vector<uint64_t> driverPriorityLevelsMs_;
+
+  // Serializes the SSD cache space accounting for spill.
+  std::mutex ssdSpillSpaceMutex_;
+  // Bytes of the spill files of this task that are not removed yet.
+  uint64_t ssdSpillBytes_{0};
+  // SSD cache capacity taken for the spill of this task.
+  uint64_t ssdSpillReservedBytes_{0};
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
+
+  // Bytes of the splits that started preloading and are not yet taken by a
+  // Driver. See QueryConfig::kMaxSplitPreloadBytes.
+  uint64_t preloadingBytes_{0};
+
+  // Number of splits preloaded in addition to the 'maxPreloadSplits' of
+  // getSplitOrFuture(). Goes up to 'maxPreloadSplits' while Drivers find
+  // their next split still preloading.
+  int32_t extraPreloadSplits_{0};
 };
 
 /// Listener invoked on task completion.
@@ -1170,6 +1397,15 @@ class TaskListener {
       TaskState state,
       std::exception_ptr error,
       TaskStats stats) = 0;
+
+  /// Called while the task is running when all the Drivers of an ungrouped
+  /// pipeline have finished, e.g. when the build side of a hash join is
+  /// done. Lets an optimizer adapt the rest of the query, for example to the
+  /// actual size of a join build side.
+  virtual void onPipelineFinished(
+      const std::string& /*taskUuid*/,
+      const std::string& /*taskId*/,
+      const PipelineBoundaryStats& /*stats*/) {}
 };
 
 /// Register a listener to be invoked on task completion. Returns true if
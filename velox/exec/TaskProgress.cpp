@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskProgress.h"
+
+namespace facebook::velox::exec {
+
+folly::dynamic TaskProgress::toJson() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["taskId"] = taskId;
+  obj["state"] = taskStateString(state);
+  obj["numTotalSplits"] = numTotalSplits;
+  obj["numQueuedSplits"] = numQueuedSplits;
+  obj["numRunningSplits"] = numRunningSplits;
+  obj["numFinishedSplits"] = numFinishedSplits;
+  obj["finishedSplitsPct"] = finishedSplitsPct();
+  obj["memoryBytes"] = memoryBytes;
+  obj["spilledBytes"] = spilledBytes;
+
+  folly::dynamic pipelinesObj = folly::dynamic::array;
+  for (const auto& pipeline : pipelines) {
+    folly::dynamic pipelineObj = folly::dynamic::object;
+    pipelineObj["inputRows"] = pipeline.inputRows;
+    pipelineObj["outputRows"] = pipeline.outputRows;
+    pipelineObj["numTotalDrivers"] = pipeline.numTotalDrivers;
+    pipelineObj["numFinishedDrivers"] = pipeline.numFinishedDrivers;
+    pipelinesObj.push_back(std::move(pipelineObj));
+  }
+  obj["pipelines"] = std::move(pipelinesObj);
+
+  folly::dynamic nodesObj = folly::dynamic::array;
+  for (const auto& node : nodes) {
+    folly::dynamic nodeObj = folly::dynamic::object;
+    nodeObj["planNodeId"] = node.planNodeId;
+    nodeObj["memoryBytes"] = node.memoryBytes;
+    nodeObj["spilledBytes"] = node.spilledBytes;
+    nodesObj.push_back(std::move(nodeObj));
+  }
+  obj["nodes"] = std::move(nodesObj);
+  return obj;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <folly/dynamic.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/TaskStructs.h"
+
+namespace facebook::velox::exec {
+
+/// Counters of a pipeline for Task::progress(). Updated by the Drivers of the
+/// pipeline without locks.
+struct PipelineProgressCounters {
+  /// Rows produced by the first operator of the pipeline.
+  std::atomic<uint64_t> inputRows{0};
+  /// Rows added to the last operator of the pipeline.
+  std::atomic<uint64_t> outputRows{0};
+  std::atomic<uint32_t> numFinishedDrivers{0};
+  /// Set before the Drivers are created.
+  uint32_t numTotalDrivers{0};
+};
+
+/// Small snapshot of the progress of a running Task. Unlike TaskStats, making
+/// one does not take the Task mutex or the locks of the operator stats, so
+/// that a host process can poll many Tasks frequently without contending with
+/// the Drivers. The counters are read one at a time, so a snapshot may mix
+/// values from slightly different times. See Task::progress().
+struct TaskProgress {
+  struct Pipeline {
+    uint64_t inputRows{0};
+    uint64_t outputRows{0};
+    uint32_t numTotalDrivers{0};
+    uint32_t numFinishedDrivers{0};
+  };
+
+  struct Node {
+    core::PlanNodeId planNodeId;
+    /// Current memory usage of the operators of the plan node.
+    int64_t memoryBytes{0};
+    /// Bytes spilled by the operators of the plan node. Operators report
+    /// their spilled bytes when they close.
+    uint64_t spilledBytes{0};
+  };
+
+  std::string taskId;
+  TaskState state{TaskState::kRunning};
+
+  int32_t numTotalSplits{0};
+  int32_t numQueuedSplits{0};
+  int32_t numRunningSplits{0};
+  int32_t numFinishedSplits{0};
+
+  /// Current memory usage of the Task.
+  int64_t memoryBytes{0};
+  /// Sum of 'spilledBytes' of 'nodes'.
+  uint64_t spilledBytes{0};
+
+  /// Indexed by pipeline id. Empty until the Task starts.
+  std::vector<Pipeline> pipelines;
+
+  /// One entry per plan node, in pre-order of the plan.
+  std::vector<Node> nodes;
+
+  /// Returns the percentage of the added splits that are finished, or 0 if no
+  /// split was added.
+  double finishedSplitsPct() const {
+    return numTotalSplits == 0 ? 0 : 100.0 * numFinishedSplits / numTotalSplits;
+  }
+
+  /// Returns the snapshot as JSON. The field names are stable.
+  folly::dynamic toJson() const;
+};
+
+} // namespace facebook::velox::exec
@@ -47,6 +47,29 @@ struct PipelineStats {
       : inputPipeline{_inputPipeline}, outputPipeline{_outputPipeline} {}
 };
 
+/// Stats of a pipeline of a running task whose Drivers have all finished,
+/// for adapting the rest of the query. See TaskListener::onPipelineFinished().
+struct PipelineBoundaryStats {
+  int32_t pipelineId;
+
+  /// Plan node of the last operator of the pipeline.
+  core::PlanNodeId planNodeId;
+
+  /// Rows and bytes that crossed the pipeline boundary, i.e. the input of the
+  /// last operator.
+  uint64_t numRows{0};
+  uint64_t numBytes{0};
+
+  /// Estimated number of distinct non-null values of the columns crossing
+  /// the boundary by column name. Empty unless
+  /// QueryConfig::kPipelineNdvSketchEnabled is set.
+  std::unordered_map<std::string, int64_t> numDistinct;
+
+  /// The stats of the operators of the pipeline. Filter selectivities are the
+  /// ratios of output and input rows.
+  PipelineStats stats;
+};
+
 /// Stores execution stats per task.
 struct TaskStats {
   int32_t numTotalSplits{0};
@@ -100,6 +123,9 @@ struct TaskStats {
   uint64_t numRunningDrivers{0};
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
+  /// The number of hash join build pipelines that started after another build
+  /// finished. See QueryConfig::kHashBuildAdmissionMemoryPct.
+  uint32_t numDeferredPipelineStarts{0};
 
   /// Output buffer's memory utilization ratio measured as
   /// current buffer usage / max buffer size
@@ -14,12 +14,103 @@
  * limitations under the License.
  */
 #include <folly/container/F14Map.h>
+#include <numeric>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/TopN.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+bool isIntegralKind(TypeKind kind) {
+  return kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+      kind == TypeKind::INTEGER || kind == TypeKind::BIGINT;
+}
+
+bool isFilterByThresholdKind(TypeKind kind) {
+  return isIntegralKind(kind) || kind == TypeKind::REAL ||
+      kind == TypeKind::DOUBLE || kind == TypeKind::TIMESTAMP;
+}
+
+// Returns true if 'value' goes after 'threshold' in the sort order. False if
+// either is NaN, whose order the comparator decides.
+template <typename T, bool kAscending>
+FOLLY_ALWAYS_INLINE bool goesAfter(const T& value, const T& threshold) {
+  if constexpr (kAscending) {
+    return threshold < value;
+  } else {
+    return value < threshold;
+  }
+}
+
+// Writes to 'rows' the rows of flat 'values' that are null or do not go
+// after 'threshold'. Returns the number of rows.
+template <typename T, bool kAscending>
+vector_size_t filterFlatByThreshold(
+    const T* values,
+    const uint64_t* nulls,
+    vector_size_t numRows,
+    T threshold,
+    vector_size_t* rows) {
+  vector_size_t numPassed = 0;
+  vector_size_t row = 0;
+  if constexpr (std::is_arithmetic_v<T>) {
+    constexpr int32_t kWidth = xsimd::batch<T>::size;
+    const auto thresholds = xsimd::broadcast<T>(threshold);
+    for (; row + kWidth <= numRows; row += kWidth) {
+      const auto data = xsimd::load_unaligned(values + row);
+      uint64_t rejected = kAscending ? simd::toBitMask(thresholds < data)
+                                     : simd::toBitMask(data < thresholds);
+      if (nulls != nullptr) {
+        // 'kWidth' divides 64, so the null flags are in one word.
+        rejected &= nulls[row / 64] >> (row % 64);
+      }
+      uint64_t passed = ~rejected & simd::allSetBitMask<T>();
+      while (passed) {
+        rows[numPassed++] = row + __builtin_ctzll(passed);
+        passed &= passed - 1;
+      }
+    }
+  }
+  for (; row < numRows; ++row) {
+    if ((nulls != nullptr && bits::isBitNull(nulls, row)) ||
+        !goesAfter<T, kAscending>(values[row], threshold)) {
+      rows[numPassed++] = row;
+    }
+  }
+  return numPassed;
+}
+
+// Returns the range of the values that do not go after 'threshold'. Nulls
+// pass if they go before all values.
+std::shared_ptr<common::Filter>
+makeRangeFilter(int64_t threshold, bool ascending, bool nullsFirst) {
+  return std::make_shared<common::BigintRange>(
+      ascending ? std::numeric_limits<int64_t>::min() : threshold,
+      ascending ? threshold : std::numeric_limits<int64_t>::max(),
+      nullsFirst);
+}
+
+std::shared_ptr<common::Filter>
+makeRangeFilter(Timestamp threshold, bool ascending, bool nullsFirst) {
+  return std::make_shared<common::TimestampRange>(
+      ascending ? Timestamp::min() : threshold,
+      ascending ? threshold : Timestamp::max(),
+      nullsFirst);
+}
+
+// Only used for ascending keys. The range filters drop NaN, which goes after
+// all other values.
+template <typename T>
+std::shared_ptr<common::Filter>
+makeRangeFilter(T threshold, bool /*ascending*/, bool nullsFirst) {
+  static_assert(std::is_floating_point_v<T>);
+  return std::make_shared<common::FloatingPointRange<T>>(
+      T(), true, false, threshold, false, false, nullsFirst);
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -31,6 +122,8 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstKeyAscending_(topNNode->sortingOrders()[0].isAscending()),
+      firstKeyNullsFirst_(topNNode->sortingOrders()[0].isNullsFirst()),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -55,6 +148,127 @@ TopN::TopN(
       }
     }
   }
+  canFilterByThreshold_ = isFilterByThresholdKind(
+      outputType_->childAt(sortingKeyColumns_[0])->kind());
+}
+
+void TopN::initialize() {
+  Operator::initialize();
+  const auto channel = sortingKeyColumns_[0];
+  const auto kind = outputType_->childAt(channel)->kind();
+  // Descending floating point keys are not pushed down since NaN goes before
+  // all other values and fails the range filters.
+  const bool isFloatingPoint =
+      kind == TypeKind::REAL || kind == TypeKind::DOUBLE;
+  canPushdownFilter_ =
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .topNDynamicFilterPushdownEnabled() &&
+      isFilterByThresholdKind(kind) &&
+      (!isFloatingPoint || firstKeyAscending_) &&
+      !operatorCtx_->driverCtx()
+           ->driver->canPushdownFilters(this, {channel})
+           .empty();
+}
+
+template <typename T>
+std::optional<T> TopN::threshold() const {
+  const char* topRow = topRows_.top();
+  const auto& column = data_->columnAt(sortingKeyColumns_[0]);
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    return std::nullopt;
+  }
+  return *reinterpret_cast<const T*>(topRow + column.offset());
+}
+
+vector_size_t TopN::filterByThreshold(vector_size_t numRows) {
+  switch (outputType_->childAt(sortingKeyColumns_[0])->kind()) {
+#define FILTER_BY_THRESHOLD(kind, T)                                  \
+  case TypeKind::kind: {                                              \
+    const auto value = threshold<T>();                                \
+    if (value.has_value()) {                                          \
+      return filterByThreshold<T>(numRows, value.value());            \
+    }                                                                 \
+    break;                                                            \
+  }
+    FILTER_BY_THRESHOLD(TINYINT, int8_t)
+    FILTER_BY_THRESHOLD(SMALLINT, int16_t)
+    FILTER_BY_THRESHOLD(INTEGER, int32_t)
+    FILTER_BY_THRESHOLD(BIGINT, int64_t)
+    FILTER_BY_THRESHOLD(REAL, float)
+    FILTER_BY_THRESHOLD(DOUBLE, double)
+    FILTER_BY_THRESHOLD(TIMESTAMP, Timestamp)
+#undef FILTER_BY_THRESHOLD
+    default:
+      VELOX_UNREACHABLE();
+  }
+  // A null top row key goes before or after all values, so the comparator
+  // decides.
+  std::iota(candidateRows_.begin(), candidateRows_.begin() + numRows, 0);
+  return numRows;
+}
+
+template <typename T>
+vector_size_t TopN::filterByThreshold(vector_size_t numRows, T threshold) {
+  auto& decoded = decodedVectors_[sortingKeyColumns_[0]];
+  auto* rows = candidateRows_.data();
+  if (decoded.isIdentityMapping()) {
+    const auto* nulls = decoded.nulls(nullptr);
+    return firstKeyAscending_
+        ? filterFlatByThreshold<T, true>(
+              decoded.data<T>(), nulls, numRows, threshold, rows)
+        : filterFlatByThreshold<T, false>(
+              decoded.data<T>(), nulls, numRows, threshold, rows);
+  }
+  vector_size_t numPassed = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    if (decoded.isNullAt(row)) {
+      rows[numPassed++] = row;
+      continue;
+    }
+    const auto value = decoded.valueAt<T>(row);
+    if (firstKeyAscending_ ? !goesAfter<T, true>(value, threshold)
+                           : !goesAfter<T, false>(value, threshold)) {
+      rows[numPassed++] = row;
+    }
+  }
+  return numPassed;
+}
+
+template <typename T>
+void TopN::pushdownThreshold(std::optional<T> value) {
+  if (!value.has_value() || pushedThreshold_ == Threshold(value.value())) {
+    return;
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(value.value())) {
+      return;
+    }
+  }
+  pushedThreshold_ = value.value();
+  dynamicFilters_[sortingKeyColumns_[0]] =
+      makeRangeFilter(value.value(), firstKeyAscending_, firstKeyNullsFirst_);
+}
+
+void TopN::updateDynamicFilter() {
+  switch (outputType_->childAt(sortingKeyColumns_[0])->kind()) {
+    case TypeKind::TINYINT:
+      return pushdownThreshold<int64_t>(threshold<int8_t>());
+    case TypeKind::SMALLINT:
+      return pushdownThreshold<int64_t>(threshold<int16_t>());
+    case TypeKind::INTEGER:
+      return pushdownThreshold<int64_t>(threshold<int32_t>());
+    case TypeKind::BIGINT:
+      return pushdownThreshold<int64_t>(threshold<int64_t>());
+    case TypeKind::REAL:
+      return pushdownThreshold<float>(threshold<float>());
+    case TypeKind::DOUBLE:
+      return pushdownThreshold<double>(threshold<double>());
+    case TypeKind::TIMESTAMP:
+      return pushdownThreshold<Timestamp>(threshold<Timestamp>());
+    default:
+      VELOX_UNREACHABLE();
+  }
 }
 
 void TopN::addInput(RowVectorPtr input) {
@@ -66,7 +280,7 @@ void TopN::addInput(RowVectorPtr input) {
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
-  for (auto row = 0; row < input->size(); ++row) {
+  const auto addRow = [&](vector_size_t row) {
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -74,7 +288,7 @@ void TopN::addInput(RowVectorPtr input) {
       char* topRow = topRows_.top();
 
       if (!comparator_(decodedVectors_, row, topRow)) {
-        continue;
+        return;
       }
       topRows_.pop();
       // Reuse the topRow's memory.
@@ -90,6 +304,18 @@ void TopN::addInput(RowVectorPtr input) {
     if (hasNonKeyColumn) {
       passedRows[newRow] = row;
     }
+  };
+
+  if (canFilterByThreshold_ && topRows_.size() == count_) {
+    candidateRows_.resize(input->size());
+    const auto numCandidates = filterByThreshold(input->size());
+    for (auto i = 0; i < numCandidates; ++i) {
+      addRow(candidateRows_[i]);
+    }
+  } else {
+    for (auto row = 0; row < input->size(); ++row) {
+      addRow(row);
+    }
   }
 
   if (hasNonKeyColumn && !passedRows.empty()) {
@@ -104,6 +330,10 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (canPushdownFilter_ && topRows_.size() == count_) {
+    updateDynamicFilter();
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <variant>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 
@@ -27,6 +29,8 @@ class TopN : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TopNNode>& topNNode);
 
+  void initialize() override;
+
   bool needsInput() const override {
     return !noMoreInput_;
   }
@@ -44,7 +48,32 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Writes to 'candidateRows_' the first 'numRows' input rows that may go
+  // before the top row. Rejects the rows whose first sorting key goes after
+  // the first sorting key of the top row without comparing them with the row.
+  // Only called if 'topRows_' is full. Returns the number of rows.
+  vector_size_t filterByThreshold(vector_size_t numRows);
+
+  template <typename T>
+  vector_size_t filterByThreshold(vector_size_t numRows, T threshold);
+
+  // Returns the first sorting key of the top row or std::nullopt if null.
+  template <typename T>
+  std::optional<T> threshold() const;
+
+  // Sets a range filter on the first sorting key in 'dynamicFilters_' if the
+  // first sorting key of the top row changed since the last push down.
+  void updateDynamicFilter();
+
+  template <typename T>
+  void pushdownThreshold(std::optional<T> value);
+
+  using Threshold =
+      std::variant<std::monostate, int64_t, float, double, Timestamp>;
+
   const int32_t count_;
+  const bool firstKeyAscending_;
+  const bool firstKeyNullsFirst_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
@@ -68,5 +97,16 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // True if the type of the first sorting key is supported by
+  // filterByThreshold().
+  bool canFilterByThreshold_{false};
+  std::vector<vector_size_t> candidateRows_;
+
+  // True if the first sorting key can be pushed down to the table scan as a
+  // dynamic filter.
+  bool canPushdownFilter_{false};
+  // The first sorting key of the top row at the last push down.
+  Threshold pushedThreshold_;
 };
 } // namespace facebook::velox::exec
@@ -741,8 +741,7 @@ void TopNRowNumber::setupSpiller() {
   VELOX_CHECK(spillConfig_.has_value());
 
   spiller_ = std::make_unique<Spiller>(
-      // TODO Replace Spiller::Type::kOrderBy.
-      Spiller::Type::kOrderByInput,
+      Spiller::Type::kTopNRowNumber,
       data_.get(),
       inputType_,
       spillCompareFlags_.size(),
@@ -123,6 +123,32 @@ class TreeOfLosers {
     return lastIndex_ == kEmpty ? nullptr : streams_[lastIndex_].get();
   }
 
+  /// Returns the stream with the lowest first element among the streams other
+  /// than the one last returned by next(), or nullptr if these are all at end.
+  /// This is the lowest of the losers on the path from the leaf of the last
+  /// returned stream to the root. The caller may take consecutive elements
+  /// from the last returned stream while these are not greater than the first
+  /// element of the returned stream, which costs one comparison per element
+  /// instead of one per level of the tree. The tree stays valid since only the
+  /// last returned stream advances, so next() can be called after this as
+  /// usual.
+  Stream* runnerUp() {
+    if (UNLIKELY(lastIndex_ == kEmpty || values_.empty())) {
+      return nullptr;
+    }
+    TIndex lowest = kEmpty;
+    auto node = firstStream_ + lastIndex_;
+    do {
+      node = parent(node);
+      const auto value = values_[node];
+      if (value != kEmpty &&
+          (lowest == kEmpty || *streams_[value] < *streams_[lowest])) {
+        lowest = value;
+      }
+    } while (node != 0);
+    return lowest == kEmpty ? nullptr : streams_[lowest].get();
+  }
+
   /// Returns the stream with the lowest first element and a flag that is true
   /// if there is another equal value to come from some other stream. The
   /// streams should have ordered unique values when using this function. This
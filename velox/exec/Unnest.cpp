@@ -111,32 +111,42 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
+  const vector_size_t maxOutputSize = outputBatchRows();
 
-  // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
+  // Limit the output batch size to 'maxOutputSize'. A row with more elements
+  // than fit in the batch is split. The batch takes the elements that fit and
+  // the next batch continues from 'nextInputRowElement_', so that a single
+  // row with millions of elements does not make one huge batch.
+  RowRange range{nextInputRow_, 0, nextInputRowElement_, 0};
   vector_size_t numElements = 0;
-  for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
-
-    if (numElements >= maxOutputSize) {
-      break;
-    }
+  for (auto row = nextInputRow_; row < size && numElements < maxOutputSize;
+       ++row) {
+    const auto begin = row == nextInputRow_ ? nextInputRowElement_ : 0;
+    const auto end =
+        std::min(rawMaxSizes_[row], begin + maxOutputSize - numElements);
+    numElements += end - begin;
+    ++range.size;
+    range.lastRowEnd = end;
   }
 
   if (numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextInputRowElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range, numElements);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastRowEnd < rawMaxSizes_[lastRow]) {
+    nextInputRow_ = lastRow;
+    nextInputRowElement_ = range.lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextInputRowElement_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -147,20 +157,27 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements,
     std::vector<VectorPtr>& outputs) {
+  if (range.size == 1) {
+    // All output rows come from the same input row, e.g. a slice of a large
+    // array.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          numElements, range.start, input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
-  vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    std::fill_n(rawRepeatedIndices, end - begin, row);
+    rawRepeatedIndices += end - begin;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
@@ -174,14 +191,13 @@ void Unnest::generateRepeatedColumns(
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   BufferPtr elementIndices = allocateIndices(numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  auto nulls = allocateNulls(numElements, pool());
-  auto rawNulls = nulls->asMutable<uint64_t>();
+  BufferPtr nulls;
+  uint64_t* rawNulls = nullptr;
 
   auto& currentDecoded = unnestDecoded_[channel];
   auto* currentSizes = rawSizes_[channel];
@@ -191,38 +207,57 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-
-    if (!currentDecoded.isNullAt(row)) {
-      const auto offset = currentOffsets[currentIndices[row]];
-      const auto unnestSize = currentSizes[currentIndices[row]];
-
-      if (index != offset || unnestSize < maxSize) {
+  vector_size_t minIndex = std::numeric_limits<vector_size_t>::max();
+  vector_size_t maxIndex = -1;
+  auto setNulls = [&](vector_size_t numNulls) {
+    if (numNulls <= 0) {
+      return;
+    }
+    identityMapping = false;
+    if (rawNulls == nullptr) {
+      nulls = allocateNulls(numElements, pool());
+      rawNulls = nulls->asMutable<uint64_t>();
+    }
+    bits::fillBits(rawNulls, index, index + numNulls, bits::kNull);
+    index += numNulls;
+  };
+
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    if (currentDecoded.isNullAt(row)) {
+      setNulls(end - begin);
+      return;
+    }
+    const auto offset = currentOffsets[currentIndices[row]];
+    const auto unnestEnd = std::min(end, currentSizes[currentIndices[row]]);
+    if (begin < unnestEnd) {
+      if (index > 0 && offset + begin != maxIndex + 1) {
         identityMapping = false;
       }
-
-      for (auto i = 0; i < unnestSize; i++) {
-        rawElementIndices[index++] = offset + i;
-      }
-
-      for (auto i = unnestSize; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
-    } else if (maxSize > 0) {
-      identityMapping = false;
-
-      for (auto i = 0; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
+      minIndex = std::min(minIndex, offset + begin);
+      maxIndex = std::max(maxIndex, offset + unnestEnd - 1);
+      std::iota(
+          rawElementIndices + index,
+          rawElementIndices + index + unnestEnd - begin,
+          offset + begin);
+      index += unnestEnd - begin;
+    }
+    setNulls(end - std::max(begin, unnestEnd));
+  });
+
+  if (!identityMapping && minIndex > 0 && minIndex <= maxIndex) {
+    // Make the indices relative to the slice of the base vector that starts
+    // at 'minIndex'. Null rows point to the first element of the slice.
+    for (auto i = 0; i < numElements; ++i) {
+      rawElementIndices[i] = rawNulls && bits::isBitNull(rawNulls, i)
+          ? 0
+          : rawElementIndices[i] - minIndex;
     }
   }
-  return {elementIndices, nulls, identityMapping};
+  return {elementIndices, nulls, minIndex, maxIndex, identityMapping};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   auto ordinalityVector =
       BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
@@ -230,27 +265,25 @@ VectorPtr Unnest::generateOrdinalityVector(
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
 RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, numElements, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range, numElements);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +305,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range, numElements);
   }
 
   return std::make_shared<RowVector>(
@@ -282,12 +315,17 @@ RowVectorPtr Unnest::generateOutput(
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  if (maxIndex < minIndex) {
+    // All rows are null.
+    return BaseVector::createNullConstant(base->type(), wrapSize, base->pool());
   }
 
-  const auto result =
-      BaseVector::wrapInDictionary(nulls, indices, wrapSize, base);
+  if (identityMapping) {
+    if (minIndex == 0 && wrapSize == base->size()) {
+      return base;
+    }
+    return base->slice(minIndex, wrapSize);
+  }
 
   // Dictionary vectors whose size is much smaller than the size of the
   // 'alphabet' (base vector) create efficiency problems downstream. For
@@ -298,12 +336,22 @@ VectorPtr Unnest::UnnestChannelEncoding::wrap(
   // causes large number of large allocations and wastes a lot of
   // resources.
   //
-  // Make a flat copy of the necessary rows to avoid inefficient downstream
-  // processing.
-  //
-  // TODO A better fix might be to change expression evaluation (and all other
-  // operations) to handle dictionaries with large alphabets efficiently.
-  return BaseVector::copy(*result);
+  // The indices are relative to a zero-copy slice of the referenced range
+  // of the base vector, so the alphabet is about as large as the output when
+  // the elements of consecutive rows are stored together, which is the
+  // common case. Make a flat copy of the necessary rows only if the
+  // referenced elements are spread too far apart.
+  const auto alphabetSize = maxIndex - minIndex + 1;
+  const auto result = BaseVector::wrapInDictionary(
+      nulls,
+      indices,
+      wrapSize,
+      alphabetSize == base->size() ? base
+                                   : base->slice(minIndex, alphabetSize));
+  if (alphabetSize > 2 * wrapSize) {
+    return BaseVector::copy(*result);
+  }
+  return result;
 }
 
 bool Unnest::isFinished() {
@@ -39,27 +39,58 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
+  // The input rows that make one output batch. The elements of the first and
+  // the last row may be split across batches, the other rows are included
+  // in full.
+  struct RowRange {
+    // First input row to include in the output.
+    vector_size_t start;
+    // Number of input rows to include in the output.
+    vector_size_t size;
+    // Index of the first element of row 'start' to include.
+    vector_size_t firstRowStart;
+    // Index one past the last element of row 'start' + 'size' - 1 to
+    // include.
+    vector_size_t lastRowEnd;
+
+    // Invokes 'func(row, begin, end)' for each row with the range [begin,
+    // end) of its elements to include.
+    template <typename F>
+    void forEachRow(const vector_size_t* rawMaxSizes, F func) const {
+      const auto end = start + size;
+      for (auto row = start; row < end; ++row) {
+        func(
+            row,
+            row == start ? firstRowStart : 0,
+            row == end - 1 ? lastRowEnd : rawMaxSizes[row]);
+      }
+    }
+  };
+
+  // Generate output for the elements of the rows in 'range'.
   //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
+  // @param range Input rows and elements to include in the output.
   // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  RowVectorPtr generateOutput(const RowRange& range, vector_size_t outputSize);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
+    // Indices into the range of the base vector starting at 'minIndex'.
     BufferPtr indices;
+    // nullptr if no output row is null.
     BufferPtr nulls;
+    // Smallest and largest index of the referenced elements. 'maxIndex' is
+    // less than 'minIndex' if all output rows are null.
+    vector_size_t minIndex;
+    vector_size_t maxIndex;
+    // True if the output is the elements 'minIndex' ... 'maxIndex' in order
+    // without nulls.
     bool identityMapping;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
@@ -69,14 +100,12 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   // Invoked by generateOutput for the ordinality column.
   VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   const bool withOrdinality_;
@@ -93,5 +122,9 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // Index of the first element of 'nextInputRow_' to process. Non-zero if
+  // the previous output batch ended in the middle of the row.
+  vector_size_t nextInputRowElement_{0};
 };
 } // namespace facebook::velox::exec
@@ -20,12 +20,17 @@ bool VectorHasher::tryMapToRangeSimd(
     const T* values,
     const SelectivityVector& rows,
     uint64_t* result) {
-  bool inRange = true;
   auto allLow = xsimd::broadcast<T>(min_);
   auto allHigh = xsimd::broadcast<T>(max_);
   auto allOne = xsimd::broadcast<T>(1);
   vector_size_t row = rows.begin();
   constexpr int kWidth = xsimd::batch<T>::size;
+  // The first key of a multi-key mapping stores the ids while checking the
+  // range. The later keys and the narrower types check the whole range first
+  // and then add their ids times 'multiplier_' in a separate loop so that the
+  // check does not depend on the stores.
+  const bool storeInCheck =
+      sizeof(T) == sizeof(uint64_t) && multiplier_ == 1;
   for (; row + kWidth <= rows.end(); row += kWidth) {
     auto data = xsimd::load_unaligned(values + row);
     int32_t gtMax = simd::toBitMask(data > allHigh);
@@ -33,32 +38,40 @@ bool VectorHasher::tryMapToRangeSimd(
     // value - (low - 1) doesn't work when low is the lowest possible (e.g.
     // std::numeric_limits<int64_t>::min())
     if constexpr (sizeof(T) == sizeof(uint64_t)) {
-      (data - allLow + allOne).store_unaligned(result + row);
+      if (storeInCheck) {
+        (data - allLow + allOne).store_unaligned(result + row);
+      }
     }
     if ((gtMax | ltMin) != 0) {
-      inRange = false;
-      break;
+      return false;
     }
   }
 
-  if (inRange) {
-    for (; row < rows.end(); row++) {
-      auto value = values[row];
-      if (value > max_ || value < min_) {
-        inRange = false;
-        break;
-      }
-      if constexpr (sizeof(T) == sizeof(uint64_t)) {
-        result[row] = value - min_ + 1;
-      }
+  for (; row < rows.end(); row++) {
+    auto value = values[row];
+    if (value > max_ || value < min_) {
+      return false;
     }
-    if constexpr (sizeof(T) != sizeof(uint64_t)) {
-      for (row = rows.begin(); row < rows.end(); row++) {
-        result[row] = values[row] - min_ + 1;
-      }
+    if (storeInCheck) {
+      result[row] = value - min_ + 1;
+    }
+  }
+  if (storeInCheck) {
+    return true;
+  }
+  const int64_t low = min_;
+  const auto end = rows.end();
+  if (multiplier_ == 1) {
+    for (row = rows.begin(); row < end; row++) {
+      result[row] = values[row] - low + 1;
+    }
+  } else {
+    const auto multiplier = multiplier_;
+    for (row = rows.begin(); row < end; row++) {
+      result[row] += multiplier * (values[row] - low + 1);
     }
   }
-  return inRange;
+  return true;
 }
 
 } // namespace facebook::velox::exec
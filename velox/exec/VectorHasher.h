@@ -442,7 +442,7 @@ class VectorHasher {
     if constexpr (
         std::is_same_v<T, std::int64_t> || std::is_same_v<T, std::int32_t> ||
         std::is_same_v<T, std::int16_t>) {
-      if (rows.isAllSelected() && multiplier_ == 1) {
+      if (rows.isAllSelected()) {
         return tryMapToRangeSimd(values, rows, result);
       }
     }
@@ -14,13 +14,79 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/RowsStreamingWindowBuild.h"
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/StreamingWindowBuild.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns the offset of a k PRECEDING or k FOLLOWING frame bound if it is a
+// constant.
+std::optional<int64_t> constantFrameOffset(const core::TypedExprPtr& value) {
+  auto constant = core::TypedExprs::asConstant(value);
+  if (constant == nullptr || constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return VariantConverter::convert(constant->value(), TypeKind::BIGINT)
+      .value<int64_t>();
+}
+
+// Returns the number of rows before the current output block that the window
+// functions of 'windowNode' read, if all of them can be evaluated over the
+// partitions of a RowsStreamingWindowBuild while their rows arrive. Returns
+// std::nullopt otherwise.
+std::optional<vector_size_t> rowsStreamingRetainedRows(
+    const core::WindowNode& windowNode) {
+  using BoundType = core::WindowNode::BoundType;
+  using WindowType = core::WindowNode::WindowType;
+
+  // The last row of the previous block is compared with the first row of the
+  // next one to find the peers.
+  int64_t numRows = 1;
+  for (const auto& function : windowNode.windowFunctions()) {
+    const auto metadata =
+        getWindowFunctionMetadata(function.functionCall->name());
+    if (!metadata.has_value() || !metadata->supportsRowsStreaming) {
+      return std::nullopt;
+    }
+    const auto& frame = function.frame;
+    if (metadata->ignoresFrame) {
+      // The frame bounds are computed anyway and the k RANGE bounds read the
+      // rows of the frames.
+      if (frame.type == WindowType::kRange &&
+          (frame.startValue || frame.endValue)) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    if (frame.type != WindowType::kRows ||
+        (frame.endType != BoundType::kCurrentRow &&
+         frame.endType != BoundType::kPreceding)) {
+      return std::nullopt;
+    }
+    if (frame.startType == BoundType::kPreceding) {
+      const auto offset = constantFrameOffset(frame.startValue);
+      if (!offset.has_value()) {
+        return std::nullopt;
+      }
+      numRows = std::max(numRows, offset.value());
+    } else if (
+        frame.startType != BoundType::kUnboundedPreceding ||
+        frame.endType != BoundType::kCurrentRow ||
+        !metadata->incrementalFrames) {
+      // The frames from the start of the partition are only computed
+      // without the erased rows if each extends the previous one.
+      return std::nullopt;
+    }
+  }
+  return std::min<int64_t>(numRows, std::numeric_limits<vector_size_t>::max());
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -37,12 +103,20 @@ Window::Window(
       numInputColumns_(windowNode->inputType()->size()),
       windowNode_(windowNode),
       currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      stringAllocator_(pool()),
+      parallelApplyMinRows_(
+          driverCtx->queryConfig().windowParallelApplyMinRows()) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (windowNode->inputsSorted()) {
-    windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    numRetainedRows_ = rowsStreamingRetainedRows(*windowNode);
+    if (numRetainedRows_.has_value()) {
+      windowBuild_ = std::make_unique<RowsStreamingWindowBuild>(
+          windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    } else {
+      windowBuild_ = std::make_unique<StreamingWindowBuild>(
+          windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    }
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
@@ -159,6 +233,16 @@ void Window::createWindowFunctions() {
   VELOX_CHECK(windowFrames_.empty());
 
   const auto& inputType = windowNode_->sources()[0]->outputType();
+  const auto numFunctions = windowNode_->windowFunctions().size();
+  if (parallelApplyMinRows_ > 0 && numFunctions > 1) {
+    parallelApplyExecutor_ = operatorCtx_->task()->queryCtx()->executor();
+  }
+  if (parallelApplyExecutor_ != nullptr) {
+    for (auto i = 0; i < numFunctions; ++i) {
+      functionAllocators_.push_back(
+          std::make_unique<HashStringAllocator>(pool()));
+    }
+  }
   for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
     std::vector<WindowFunctionArg> functionArgs;
     functionArgs.reserve(windowNodeFunction.functionCall->inputs().size());
@@ -179,7 +263,9 @@ void Window::createWindowFunctions() {
         windowNodeFunction.functionCall->type(),
         windowNodeFunction.ignoreNulls,
         operatorCtx_->pool(),
-        &stringAllocator_,
+        functionAllocators_.empty()
+            ? &stringAllocator_
+            : functionAllocators_[windowFunctions_.size()].get(),
         operatorCtx_->driverCtx()->queryConfig()));
 
     windowFrames_.push_back(
@@ -198,17 +284,8 @@ void Window::reclaim(
   VELOX_CHECK(canReclaim());
   VELOX_CHECK(!nonReclaimableSection_);
 
-  if (noMoreInput_) {
-    ++stats.numNonReclaimableAttempts;
-    // TODO Add support for spilling after noMoreInput().
-    LOG(WARNING)
-        << "Can't reclaim from window operator which has started producing output: "
-        << pool()->name()
-        << ", usage: " << succinctBytes(pool()->currentBytes())
-        << ", reservation: " << succinctBytes(pool()->reservedBytes());
-    return;
-  }
-
+  // After noMoreInput(), the window build spills the partitions that are not
+  // yet output and reads them back one at a time.
   windowBuild_->spill();
 }
 
@@ -539,16 +616,11 @@ void Window::getInputColumns(
   }
 }
 
-void Window::callApplyForPartitionRows(
-    vector_size_t startRow,
-    vector_size_t endRow,
+void Window::applyWindowFunctions(
+    vector_size_t numRows,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
-  getInputColumns(startRow, endRow, resultOffset, result);
-
-  computePeerAndFrameBuffers(startRow, endRow);
-  vector_size_t numFuncs = windowFunctions_.size();
-  for (auto w = 0; w < numFuncs; w++) {
+  auto apply = [&](auto w) {
     windowFunctions_[w]->apply(
         peerStartBuffer_,
         peerEndBuffer_,
@@ -557,11 +629,60 @@ void Window::callApplyForPartitionRows(
         validFrames_[w],
         resultOffset,
         result->childAt(numInputColumns_ + w));
+  };
+
+  vector_size_t numFuncs = windowFunctions_.size();
+  if (parallelApplyExecutor_ == nullptr || numRows < parallelApplyMinRows_) {
+    for (auto w = 0; w < numFuncs; w++) {
+      apply(w);
+    }
+    return;
+  }
+
+  // The functions only read the partition and the peer and frame buffers
+  // and each writes its own result column, so these can run concurrently.
+  // The functions that are not started on the executor run on this thread
+  // in move().
+  std::vector<std::shared_ptr<AsyncSource<bool>>> pending;
+  pending.reserve(numFuncs);
+  for (auto w = 0; w < numFuncs; w++) {
+    pending.push_back(std::make_shared<AsyncSource<bool>>([w, &apply]() {
+      apply(w);
+      return std::make_unique<bool>(true);
+    }));
+    parallelApplyExecutor_->add(
+        [source = pending.back()]() { source->prepare(); });
+  }
+  std::exception_ptr error;
+  for (auto& source : pending) {
+    try {
+      source->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
   }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
 
+void Window::callApplyForPartitionRows(
+    vector_size_t startRow,
+    vector_size_t endRow,
+    vector_size_t resultOffset,
+    const RowVectorPtr& result) {
+  getInputColumns(startRow, endRow, resultOffset, result);
+
+  computePeerAndFrameBuffers(startRow, endRow);
   vector_size_t numRows = endRow - startRow;
+  applyWindowFunctions(numRows, resultOffset, result);
+
   numProcessedRows_ += numRows;
   partitionOffset_ += numRows;
+  if (currentPartition_->partial()) {
+    currentPartition_->eraseRowsBefore(
+        partitionOffset_ - numRetainedRows_.value());
+  }
 }
 
 vector_size_t Window::callApplyLoop(
@@ -580,13 +701,19 @@ vector_size_t Window::callApplyLoop(
     if (rowsForCurrentPartition <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
-      callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + rowsForCurrentPartition,
-          resultIndex,
-          result);
+      if (rowsForCurrentPartition > 0) {
+        callApplyForPartitionRows(
+            partitionOffset_,
+            partitionOffset_ + rowsForCurrentPartition,
+            resultIndex,
+            result);
+      }
       resultIndex += rowsForCurrentPartition;
       numOutputRowsLeft -= rowsForCurrentPartition;
+      if (!currentPartition_->complete()) {
+        // The rest of the partial partition is not received yet.
+        break;
+      }
       callResetPartition();
       if (!currentPartition_) {
         // The WindowBuild doesn't have any more partitions to process right
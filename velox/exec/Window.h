@@ -51,7 +51,15 @@ class Window : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && windowBuild_->needsInput();
+    if (noMoreInput_) {
+      return false;
+    }
+    if (numRetainedRows_.has_value()) {
+      // The partitions are output while their rows arrive. Takes new input
+      // once all rows are output, which bounds the rows held in memory.
+      return numProcessedRows_ == numRows_;
+    }
+    return windowBuild_->needsInput();
   }
 
   void noMoreInput() override;
@@ -108,6 +116,13 @@ class Window : public Operator {
   // Updates all the state for the next partition.
   void callResetPartition();
 
+  // Applies the window functions to 'numRows' rows of the current partition
+  // at 'resultOffset' of 'result', in parallel if enabled.
+  void applyWindowFunctions(
+      vector_size_t numRows,
+      vector_size_t resultOffset,
+      const RowVectorPtr& result);
+
   // Computes the result vector for a subset of the current
   // partition rows starting from startRow to endRow. A single partition
   // could span multiple output blocks and a single output block could
@@ -159,6 +174,12 @@ class Window : public Operator {
   // for the processing.
   std::unique_ptr<WindowBuild> windowBuild_;
 
+  // Set if the input is sorted and the window functions are evaluated while
+  // the rows of a partition arrive. The number of rows before the current
+  // output block that are kept for the frames of the functions. The earlier
+  // rows are erased.
+  std::optional<vector_size_t> numRetainedRows_;
+
   // The cached window plan node used for window function initialization. It is
   // reset after the initialization.
   std::shared_ptr<const core::WindowNode> windowNode_;
@@ -171,6 +192,19 @@ class Window : public Operator {
   // buffers.
   HashStringAllocator stringAllocator_;
 
+  // Executor for applying the window functions of an output block in
+  // parallel, nullptr if the functions are applied on the driver thread.
+  folly::Executor* parallelApplyExecutor_{nullptr};
+
+  // Min number of rows in an output block for applying the window functions
+  // in parallel.
+  const vector_size_t parallelApplyMinRows_;
+
+  // Allocators of the window functions when these are applied in parallel,
+  // since HashStringAllocator is not thread safe. Empty if all functions
+  // use 'stringAllocator_'.
+  std::vector<std::unique_ptr<HashStringAllocator>> functionAllocators_;
+
   // Vector of WindowFunction objects required by this operator.
   // WindowFunction is the base API implemented by all the window functions.
   // The functions are ordered by their positions in the output columns.
@@ -44,7 +44,8 @@ class WindowBuild {
   // Adds new input rows to the WindowBuild.
   virtual void addInput(RowVectorPtr input) = 0;
 
-  // Can be called any time before noMoreInput().
+  // Can be called any time. After noMoreInput(), spills the partitions not
+  // yet output. The partition being output stays in memory.
   virtual void spill() = 0;
 
   /// Returns the spiller stats including total bytes and rows spilled so far.
@@ -143,22 +143,49 @@ using WindowFunctionFactory = std::function<std::unique_ptr<WindowFunction>(
     HashStringAllocator* stringAllocator,
     const core::QueryConfig& config)>;
 
+/// Properties of a window function that the Window operator uses to decide
+/// how to evaluate it.
+struct WindowFunctionMetadata {
+  /// True if the result for a row only depends on the rows of its frame when
+  /// the frame ends at or before the row, or on the rows up to the row if
+  /// 'ignoresFrame'. The function does not use the number of rows in the
+  /// partition. Such a function can be evaluated over a partition whose later
+  /// rows have not been received yet and whose rows before the frames of the
+  /// current output block have been erased.
+  bool supportsRowsStreaming{false};
+
+  /// True if the function does not use the frame, e.g. rank.
+  bool ignoresFrame{false};
+
+  /// True if frames that start at the first row of the partition and have
+  /// non-decreasing ends are computed incrementally, without reading the rows
+  /// of the earlier output blocks again, e.g. the aggregates.
+  bool incrementalFrames{false};
+};
+
 /// Register a window function with the specified name and signatures.
 /// Registering a function with the same name a second time overrides the first
 /// registration.
 bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
-    WindowFunctionFactory factory);
+    WindowFunctionFactory factory,
+    const WindowFunctionMetadata& metadata = {});
 
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the metadata of the window function with the specified name.
+/// Returns empty std::optional if function with that name is not found.
+std::optional<WindowFunctionMetadata> getWindowFunctionMetadata(
+    const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowFunctionMetadata metadata;
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
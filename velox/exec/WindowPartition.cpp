@@ -31,11 +31,67 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : data_(data),
+      partial_(true),
+      complete_(false),
+      inputMapping_(inputMapping),
+      sortKeyInfo_(sortKeyInfo) {
+  for (int i = 0; i < inputMapping_.size(); i++) {
+    columns_.emplace_back(data_->columnAt(inputMapping_[i]));
+  }
+}
+
+WindowPartition::~WindowPartition() {
+  if (partial_ && !rows_.empty()) {
+    data_->eraseRows(folly::Range<char**>(rows_.data(), rows_.size()));
+  }
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK(!complete_);
+  rows_.insert(rows_.end(), rows.begin(), rows.end());
+  partition_ = folly::Range<char**>(rows_.data(), rows_.size());
+}
+
+void WindowPartition::eraseRowsBefore(vector_size_t row) {
+  VELOX_CHECK(partial_);
+  const auto numRows = std::min<vector_size_t>(row - startRow_, rows_.size());
+  if (numRows <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range<char**>(rows_.data(), numRows));
+  rows_.erase(rows_.begin(), rows_.begin() + numRows);
+  startRow_ += numRows;
+  partition_ = folly::Range<char**>(rows_.data(), rows_.size());
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  if (startRow_ > 0) {
+    // The row numbers are positions in the whole partition.
+    std::vector<vector_size_t> offsetRowNumbers(
+        rowNumbers.begin(), rowNumbers.end());
+    for (auto& row : offsetRowNumbers) {
+      if (row >= 0) {
+        row -= startRow_;
+      }
+    }
+    RowContainer::extractColumn(
+        partition_.data(),
+        folly::Range(offsetRowNumbers.data(), offsetRowNumbers.size()),
+        columns_[columnIndex],
+        resultOffset,
+        result);
+    return;
+  }
   RowContainer::extractColumn(
       partition_.data(),
       rowNumbers,
@@ -51,7 +107,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -64,7 +120,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -159,10 +215,15 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
     if (i == 0 || i >= peerEnd) {
       // Compute peerStart and peerEnd rows for the first row of the partition
       // or when past the previous peerGroup.
-      peerStart = i;
+      // In a partial partition the previous peer group may continue in the
+      // rows added since. The rows before 'i' may be erased, so the peers are
+      // compared with row 'i'.
+      if (!partial_ || i == 0 || peerCompare(rowAt(i - 1), rowAt(i))) {
+        peerStart = i;
+      }
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(rowAt(i), rowAt(peerEnd))) {
           break;
         }
         peerEnd++;
@@ -192,13 +253,13 @@ vector_size_t WindowPartition::searchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   vector_size_t begin = start;
   vector_size_t finish = end;
   while (finish - begin >= 2) {
     auto mid = (begin + finish) / 2;
     auto compareResult = data_->compare(
-        partition_[mid], current, orderByColumn, frameColumn, flags);
+        rowAt(mid), current, orderByColumn, frameColumn, flags);
 
     if (compareResult >= 0) {
       // Search in the first half of the column.
@@ -221,10 +282,10 @@ vector_size_t WindowPartition::linearSearchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   for (vector_size_t i = start; i < end; ++i) {
     auto compareResult = data_->compare(
-        partition_[i], current, orderByColumn, frameColumn, flags);
+        rowAt(i), current, orderByColumn, frameColumn, flags);
 
     // The bound value was found. Return if firstMatch required.
     // If the last match is required, then we need to find the first row that
@@ -270,7 +331,7 @@ void WindowPartition::updateKRangeFrameBounds(
   for (auto i = 0; i < numRows; i++) {
     auto currentRow = startRow + i;
     bool frameIsNull = RowContainer::isNullAt(
-        partition_[currentRow],
+        rowAt(currentRow),
         frameRowColumn.nullByte(),
         frameRowColumn.nullMask());
 
@@ -287,7 +348,7 @@ void WindowPartition::updateKRangeFrameBounds(
         end = currentRow + 1;
       } else {
         start = currentRow;
-        end = partition_.size();
+        end = numRows();
       }
       rawFrameBounds[i] = searchFrameValue(
           firstMatch,
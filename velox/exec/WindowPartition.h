@@ -42,9 +42,55 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Constructs a partial WindowPartition that is output while its rows are
+  /// added to it. Each row is referred to by its position in the whole
+  /// partition, also after the rows before it are erased. The partition owns
+  /// its rows in 'data' and erases the remaining ones when destroyed.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  ~WindowPartition();
+
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// partition, these are the rows added so far, including the erased ones.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
+  }
+
+  /// Returns true if the partition is partial, i.e. rows are added to it
+  /// while it is output.
+  bool partial() const {
+    return partial_;
+  }
+
+  /// Returns true if all rows of the partition have been added.
+  bool complete() const {
+    return complete_;
+  }
+
+  /// Marks a partial partition as having all its rows.
+  void setComplete() {
+    VELOX_CHECK(partial_);
+    complete_ = true;
+  }
+
+  /// Appends 'rows' to a partial partition.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Erases the rows of a partial partition before position 'row' from the
+  /// RowContainer. These are no longer accessed afterwards.
+  void eraseRowsBefore(vector_size_t row);
+
+  /// Points the partition to a copy of its rows in the same RowContainer. Used
+  /// by the WindowBuild when it spills and reads back the rows of a partition
+  /// that is being output. 'rows' must have the same values in the same order.
+  void resetRows(const folly::Range<char**>& rows) {
+    VELOX_CHECK(!partial_);
+    VELOX_CHECK_EQ(rows.size(), partition_.size());
+    partition_ = rows;
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
@@ -128,6 +174,11 @@ class WindowPartition {
       vector_size_t* rawFrameBounds) const;
 
  private:
+  // Returns the row at position 'row' of the partition.
+  char* rowAt(vector_size_t row) const {
+    return partition_[row - startRow_];
+  }
+
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
   // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
@@ -172,6 +223,20 @@ class WindowPartition {
   // of WindowPartition.
   folly::Range<char**> partition_;
 
+  // True if rows are added to the partition while it is output.
+  const bool partial_{false};
+
+  // False while rows may be added to a partial partition.
+  bool complete_{true};
+
+  // The rows of a partial partition that are not erased. 'partition_' points
+  // to these.
+  std::vector<char*> rows_;
+
+  // Position of the first row of 'partition_' in the partition. Non-zero
+  // after rows of a partial partition are erased.
+  vector_size_t startRow_{0};
+
   // Mapping from window input column -> index in data_. This is required
   // because the WindowBuild reorders data_ to place partition and sort keys
   // before other columns in data_. But the Window Operator and Function code
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <fmt/format.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+struct CurrentThread {
+  const WorkStealingExecutor* executor{nullptr};
+  int32_t index{-1};
+};
+
+thread_local CurrentThread currentThread;
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(
+    int32_t numThreads,
+    int32_t numPriorities)
+    : numPriorities_(numPriorities) {
+  VELOX_CHECK_GT(numThreads, 0);
+  VELOX_CHECK_GE(numPriorities_, 2);
+  VELOX_CHECK_LE(numPriorities_, std::numeric_limits<uint8_t>::max());
+  workers_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_.back()->queues.resize(numPriorities_);
+  }
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i]() { run(i); });
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    stop_ = true;
+  }
+  idleCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+int32_t WorkStealingExecutor::currentThreadIndex() const {
+  return currentThread.executor == this ? currentThread.index : -1;
+}
+
+int32_t WorkStealingExecutor::level(int8_t priority) const {
+  if (priority > folly::Executor::MID_PRI) {
+    return 0;
+  }
+  return std::min<int32_t>(
+      numPriorities_ - 1, 1 + folly::Executor::MID_PRI - priority);
+}
+
+void WorkStealingExecutor::add(
+    folly::Func func,
+    int8_t priority,
+    int32_t threadHint) {
+  int32_t index = threadHint;
+  if (index < 0 || index >= workers_.size()) {
+    index = currentThreadIndex();
+  }
+  if (index < 0) {
+    index = nextWorker_++ % workers_.size();
+  }
+  {
+    auto& worker = *workers_[index];
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.queues[level(priority)].push_back(std::move(func));
+  }
+  ++numPending_;
+  {
+    // Taking the mutex orders the increment of 'numPending_' with the check
+    // of a thread about to wait, so that the notification is not lost.
+    std::lock_guard<std::mutex> l(idleMutex_);
+  }
+  idleCv_.notify_one();
+}
+
+bool WorkStealingExecutor::tryTake(int32_t index, folly::Func& func) {
+  const auto numWorkers = workers_.size();
+  for (auto queueIndex = 0; queueIndex < numPriorities_; ++queueIndex) {
+    {
+      auto& worker = *workers_[index];
+      std::lock_guard<std::mutex> l(worker.mutex);
+      auto& queue = worker.queues[queueIndex];
+      if (!queue.empty()) {
+        func = std::move(queue.front());
+        queue.pop_front();
+        --numPending_;
+        return true;
+      }
+    }
+    for (auto i = 1; i < numWorkers; ++i) {
+      auto& victim = *workers_[(index + i) % numWorkers];
+      std::lock_guard<std::mutex> l(victim.mutex);
+      auto& queue = victim.queues[queueIndex];
+      if (!queue.empty()) {
+        func = std::move(queue.back());
+        queue.pop_back();
+        --numPending_;
+        ++numSteals_;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::run(int32_t index) {
+  folly::setThreadName(fmt::format("Driver{}", index));
+  currentThread = {this, index};
+  for (;;) {
+    folly::Func func;
+    if (tryTake(index, func)) {
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "WorkStealingExecutor task threw: " << e.what();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> l(idleMutex_);
+    if (stop_ && numPending_ == 0) {
+      return;
+    }
+    idleCv_.wait(l, [&]() { return stop_ || numPending_ > 0; });
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/Executor.h>
+
+namespace facebook::velox::exec {
+
+/// Executor for Drivers with a deque per thread and work stealing. A task
+/// added from one of the threads goes to the deque of that thread, so that a
+/// Driver that yields at the end of its time slice stays where its data is
+/// in cache. Callers may also pass the index of a preferred thread, see
+/// Driver::enqueue(). An idle thread takes from the front of its own deque
+/// and otherwise steals from the back of the deques of other threads.
+///
+/// There are 'numPriorities' levels. A thread runs a task of a lower level
+/// only when all the deques are empty at the higher levels. Priorities above
+/// MID_PRI map to the highest level, MID_PRI to the next one and each step
+/// below MID_PRI to one level lower, down to the lowest level. Drivers on
+/// the critical path, e.g. hash build pipelines that probe Drivers wait for,
+/// are added with HI_PRI and the other Drivers with MID_PRI minus the
+/// priority level of their query, see QueryConfig::kDriverPriorityLevelsMs.
+/// So with 2 + n levels, n being the number of priority levels of the
+/// queries, new queries go ahead of those that have run for a long time.
+class WorkStealingExecutor : public folly::Executor {
+ public:
+  explicit WorkStealingExecutor(int32_t numThreads, int32_t numPriorities = 2);
+
+  /// Runs the tasks left in the deques and joins the threads.
+  ~WorkStealingExecutor() override;
+
+  void add(folly::Func func) override {
+    add(std::move(func), folly::Executor::MID_PRI, -1);
+  }
+
+  void addWithPriority(folly::Func func, int8_t priority) override {
+    add(std::move(func), priority, -1);
+  }
+
+  uint8_t getNumPriorities() const override {
+    return numPriorities_;
+  }
+
+  /// Adds 'func' to the deque of thread 'threadHint' if it is a valid index.
+  /// Otherwise adds to the deque of the calling thread if it belongs to
+  /// 'this' and to the deques in round robin order if it does not.
+  void add(folly::Func func, int8_t priority, int32_t threadHint);
+
+  /// Returns the index of the calling thread in 'this' or -1 if the caller
+  /// is not a thread of 'this'.
+  int32_t currentThreadIndex() const;
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  /// Number of tasks run by a thread other than the one they were added to.
+  uint64_t numSteals() const {
+    return numSteals_;
+  }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    // Deques by level, highest first.
+    std::vector<std::deque<folly::Func>> queues;
+    std::thread thread;
+  };
+
+  // Returns the deque index for 'priority'.
+  int32_t level(int8_t priority) const;
+
+  // Takes the next task for thread 'index' into 'func'. Returns false if all
+  // the deques are empty.
+  bool tryTake(int32_t index, folly::Func& func);
+
+  void run(int32_t index);
+
+  const int32_t numPriorities_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<uint32_t> nextWorker_{0};
+  std::atomic<uint64_t> numSteals_{0};
+
+  // Number of tasks in the deques. Idle threads wait on 'idleCv_' until it is
+  // non-zero.
+  std::atomic<int64_t> numPending_{0};
+  std::mutex idleMutex_;
+  std::condition_variable idleCv_;
+  bool stop_{false};
+};
+
+} // namespace facebook::velox::exec
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/core/QueryConfig.h"
@@ -26,7 +27,9 @@
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
+#include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/UnsafeRowSerializer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 DEFINE_int32(width, 16, "Number of parties in shuffle");
@@ -42,6 +45,31 @@ DEFINE_int64(
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
 
+DEFINE_bool(
+    sweep,
+    false,
+    "Runs the remote exchange over all combinations of the sweep_* flags "
+    "instead of the fixed benchmarks");
+DEFINE_string(
+    sweep_parties,
+    "4x4,16x16,4x16,16x4",
+    "Comma-separated producer x consumer task counts");
+DEFINE_string(
+    sweep_data,
+    "narrow10k,flat10k,flat50,deep10k,struct1k",
+    "Comma-separated data sets. narrow and flat are flat rows of 3 and "
+    "flat_batch_mb / 10k bytes, deep and struct are nested types. The suffix "
+    "is the number of rows per batch");
+DEFINE_string(
+    sweep_serdes,
+    "Presto,CompactRow,UnsafeRow",
+    "Comma-separated serde kinds");
+DEFINE_string(
+    sweep_compressions,
+    "none,lz4,zstd",
+    "Comma-separated compression kinds. Only the Presto serde compresses");
+DEFINE_int32(sweep_repeats, 3, "Number of runs per sweep point");
+
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
 /// that 1. shuffles a constant input in each of n workers, sending
@@ -49,6 +77,11 @@ DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
 /// count the rows and send the count to a final single task stage
 /// that returns the sum of the counts. The sum is expected to be n *
 /// number of rows in constant input.
+///
+/// With --sweep, runs the remote exchange for each combination of producer
+/// and consumer counts, data set, serde and compression given by the sweep_*
+/// flags and prints rows/s, bytes/s and PartitionedOutput plus Exchange CPU
+/// time per byte for each.
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -76,6 +109,20 @@ struct Counters {
         succinctNanos(exchangeNanos),
         exchangeRows / exchangeBatches);
   }
+
+  /// Returns rows/s, bytes/s and the CPU time of PartitionedOutput and
+  /// Exchange per byte received.
+  std::string toThroughputString() {
+    if (usec == 0 || bytes == 0) {
+      return "N/A";
+    }
+    const double seconds = usec / 1.0e6;
+    return fmt::format(
+        "{:>12.0f} rows/s {:>10}/s {:>8.2f} cpu ns/byte",
+        rows / seconds,
+        succinctBytes(bytes / seconds),
+        static_cast<double>(repartitionNanos + exchangeNanos) / bytes);
+  }
 };
 
 class ExchangeBenchmark : public VectorTestBase {
@@ -110,6 +157,17 @@ class ExchangeBenchmark : public VectorTestBase {
       int32_t width,
       int32_t taskWidth,
       Counters& counters) {
+    run(vectors, width, width, taskWidth, counters);
+  }
+
+  /// Shuffles 'vectors' from each of 'numProducers' tasks to 'numConsumers'
+  /// tasks.
+  void run(
+      std::vector<RowVectorPtr>& vectors,
+      int32_t numProducers,
+      int32_t numConsumers,
+      int32_t taskWidth,
+      Counters& counters) {
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
@@ -118,11 +176,11 @@ class ExchangeBenchmark : public VectorTestBase {
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
                         .values(vectors, true)
-                        .partitionedOutput({"c0"}, width)
+                        .partitionedOutput({"c0"}, numConsumers)
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
-    for (int32_t counter = 0; counter < width; ++counter) {
+    for (int32_t counter = 0; counter < numProducers; ++counter) {
       auto leafTaskId = makeTaskId(iteration, "leaf", counter);
       leafTaskIds.push_back(leafTaskId);
       auto leafTask = makeTask(leafTaskId, leafPlan, counter);
@@ -139,7 +197,7 @@ class ExchangeBenchmark : public VectorTestBase {
                        .planNode();
 
     std::vector<exec::Split> finalAggSplits;
-    for (int i = 0; i < width; i++) {
+    for (int i = 0; i < numConsumers; i++) {
       auto taskId = makeTaskId(iteration, "final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
@@ -156,7 +214,8 @@ class ExchangeBenchmark : public VectorTestBase {
 
     auto expected =
         makeRowVector({makeFlatVector<int64_t>(1, [&](auto /*row*/) {
-          return vectors.size() * vectors[0]->size() * width * taskWidth;
+          return vectors.size() * vectors[0]->size() * numProducers *
+              taskWidth;
         })});
 
     exec::test::AssertQueryBuilder(plan)
@@ -187,7 +246,8 @@ class ExchangeBenchmark : public VectorTestBase {
     }
 
     counters.bytes += bytes;
-    counters.rows += width * vectors.size() * vectors[0]->size();
+    counters.rows +=
+        numProducers * taskWidth * vectors.size() * vectors[0]->size();
     counters.usec += elapsed;
     counters.repartitionNanos += repartitionNanos;
     counters.exchangeNanos += exchangeNanos;
@@ -344,12 +404,84 @@ int32_t ExchangeBenchmark::iteration_;
 
 std::unique_ptr<ExchangeBenchmark> bm;
 
+std::vector<std::string> splitFlag(const std::string& flag) {
+  std::vector<std::string> values;
+  folly::split(',', flag, values, true);
+  return values;
+}
+
+// Makes 'serdeName' the default serde used by PartitionedOutput and Exchange.
+void setSerde(const std::string& serdeName) {
+  deregisterVectorSerde();
+  if (serdeName == "Presto") {
+    serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  } else if (serdeName == "CompactRow") {
+    serializer::CompactRowVectorSerde::registerVectorSerde();
+  } else if (serdeName == "UnsafeRow") {
+    serializer::spark::UnsafeRowVectorSerde::registerVectorSerde();
+  } else {
+    VELOX_USER_FAIL("Unknown serde: {}", serdeName);
+  }
+}
+
+// Runs the remote exchange for each combination of the sweep_* flags and
+// prints a line per combination.
+void runSweep(
+    const std::unordered_map<std::string, std::vector<RowVectorPtr>*>&
+        dataSets) {
+  auto bufferManager = OutputBufferManager::getInstance().lock();
+  for (const auto& serdeName : splitFlag(FLAGS_sweep_serdes)) {
+    setSerde(serdeName);
+    for (const auto& compression : splitFlag(FLAGS_sweep_compressions)) {
+      const auto compressionKind = common::stringToCompressionKind(compression);
+      if (serdeName != "Presto" &&
+          compressionKind != common::CompressionKind_NONE) {
+        continue;
+      }
+      bufferManager->testingSetCompression(compressionKind);
+      for (const auto& dataName : splitFlag(FLAGS_sweep_data)) {
+        auto it = dataSets.find(dataName);
+        VELOX_USER_CHECK(it != dataSets.end(), "Unknown data: {}", dataName);
+        for (const auto& parties : splitFlag(FLAGS_sweep_parties)) {
+          int32_t numProducers;
+          int32_t numConsumers;
+          VELOX_USER_CHECK_EQ(
+              sscanf(parties.c_str(), "%dx%d", &numProducers, &numConsumers),
+              2,
+              "Bad producers x consumers: {}",
+              parties);
+          Counters counters;
+          for (auto i = 0; i < FLAGS_sweep_repeats; ++i) {
+            bm->run(
+                *it->second,
+                numProducers,
+                numConsumers,
+                FLAGS_task_width,
+                counters);
+          }
+          std::cout << fmt::format(
+                           "{:<10} {:<5} {:<10} {:>3}x{:<3} ",
+                           serdeName,
+                           compression,
+                           dataName,
+                           numProducers,
+                           numConsumers)
+                    << counters.toThroughputString() << std::endl;
+        }
+      }
+    }
+  }
+  bufferManager->testingSetCompression(common::CompressionKind_NONE);
+  setSerde("Presto");
+}
+
 void runBenchmarks() {
   std::vector<RowVectorPtr> flat10k;
   std::vector<RowVectorPtr> deep10k;
   std::vector<RowVectorPtr> flat50;
   std::vector<RowVectorPtr> deep50;
   std::vector<RowVectorPtr> struct1k;
+  std::vector<RowVectorPtr> narrow10k;
 
   Counters flat10kCounters;
   Counters deep10kCounters;
@@ -417,6 +549,22 @@ void runBenchmarks() {
   deep50 = bm->makeRows(deepType, 2000, 50, FLAGS_dict_pct);
   struct1k = bm->makeRows(structType, 100, 1000, FLAGS_dict_pct);
 
+  if (FLAGS_sweep) {
+    narrow10k = bm->makeRows(
+        ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()}),
+        10,
+        10000,
+        FLAGS_dict_pct);
+    runSweep(
+        {{"narrow10k", &narrow10k},
+         {"flat10k", &flat10k},
+         {"flat50", &flat50},
+         {"deep10k", &deep10k},
+         {"deep50", &deep50},
+         {"struct1k", &struct1k}});
+    return;
+  }
+
   folly::addBenchmark(__FILE__, "exchangeFlat10k", [&]() {
     bm->run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
     return 1;
@@ -16,6 +16,7 @@
 
 #include "velox/exec/HashTable.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/SharedRowsExtractor.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 #include <folly/Benchmark.h>
@@ -36,7 +37,8 @@ struct HashTableBenchmarkParams {
   //  -the build & probe row schema,
   //  -the expected hash table size,
   //  -number of probing rows,
-  //  -build key repetition distribution.
+  //  -build key repetition distribution,
+  //  -the number of consecutive probe rows with the same key.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
@@ -44,13 +46,15 @@ struct HashTableBenchmarkParams {
       int64_t probeSize,
       const std::vector<std::pair<int32_t, int32_t>>&
           keyRepeatTimesDistribution,
-      bool runErase)
+      bool runErase,
+      int32_t probeKeyRepeat = 1)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         probeSize{probeSize},
         keyRepeatTimesDistribution{keyRepeatTimesDistribution},
-        runErase{runErase} {
+        runErase{runErase},
+        probeKeyRepeat{probeKeyRepeat} {
     int32_t distSum = 0;
     buildSize = 0;
     buildKeyRepeat.reserve(keyRepeatTimesDistribution.size());
@@ -89,10 +93,17 @@ struct HashTableBenchmarkParams {
       distStr << fmt::format("{}%:{};", dist.first, dist.second);
     }
     title = fmt::format(
-        "{},probe:{},buildDist:{}", modeString, probeSize, distStr.str());
+        "{},table:{},probe:{},buildDist:{}",
+        modeString,
+        hashTableSize,
+        probeSize,
+        distStr.str());
     if (runErase) {
       title += ",withErase";
     }
+    if (probeKeyRepeat > 1) {
+      title += fmt::format(",probeKeyRepeat:{}", probeKeyRepeat);
+    }
   }
 
   // Expected mode.
@@ -113,6 +124,10 @@ struct HashTableBenchmarkParams {
 
   bool runErase;
 
+  // Number of consecutive probe rows with the same key. Above 1, the output
+  // batches repeat build side rows, as in a many to many join.
+  int32_t probeKeyRepeat;
+
   // Title for reporting
   std::string title;
 
@@ -166,6 +181,12 @@ struct HashTableBenchmarkResult {
 
   double eraseClock{0};
 
+  // Time to extract the dependent fields of the listed rows row by row and
+  // once per distinct row with SharedRowsExtractor.
+  double extractClocks{0};
+
+  double sharedExtractClocks{0};
+
   // The mode of the table.
   BaseHashTable::HashMode hashMode;
 
@@ -175,6 +196,8 @@ struct HashTableBenchmarkResult {
     listJoinResultClocks += other.listJoinResultClocks;
     totalClock += other.totalClock;
     eraseClock += other.eraseClock;
+    extractClocks += other.extractClocks;
+    sharedExtractClocks += other.sharedExtractClocks;
   }
 
   std::string toString() const {
@@ -191,6 +214,10 @@ struct HashTableBenchmarkResult {
       out << " eraseClock=" << eraseClock << "("
           << (eraseClock / totalClock * 100) << "%)";
     }
+    if (params.numDependentFields > 0) {
+      out << " extractClocks=" << extractClocks
+          << " sharedExtractClocks=" << sharedExtractClocks;
+    }
     return out.str();
   }
 };
@@ -219,6 +246,8 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     }
     result.buildClocks += buildTime_;
     result.listJoinResultClocks += listJoinResultTime_;
+    result.extractClocks += extractTime_;
+    result.sharedExtractClocks += sharedExtractTime_;
     result.totalClock += totalClock.timeToDropValue();
 
     return result;
@@ -301,7 +330,9 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     std::vector<VectorPtr> children;
     children.push_back(makeFlatVector<int64_t>(
         size,
-        [&](vector_size_t row) { return (sequence + row) % hashTableSize; },
+        [&](vector_size_t row) {
+          return (sequence + row) / params_.probeKeyRepeat % hashTableSize;
+        },
         nullptr));
     sequence += size;
     for (int32_t i = 0; i < params_.numDependentFields; ++i) {
@@ -319,8 +350,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     auto numKeys = hashers.size();
     auto numDependentFields = batch->childrenSize() - numKeys;
 
-    std::vector<DecodedVector> decoders;
-    decoders.reserve(numDependentFields);
+    std::vector<DecodedVector> decoders(numDependentFields);
     SelectivityVector rows(batchSize);
 
     for (auto i = 0; i < batch->childrenSize(); ++i) {
@@ -350,6 +380,9 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
   // Prepare join table.
   void buildTable() {
     std::vector<TypePtr> dependentTypes;
+    for (auto i = 1; i < params_.buildType->size(); ++i) {
+      dependentTypes.push_back(params_.buildType->childAt(i));
+    }
     std::vector<std::unique_ptr<BaseHashTable>> otherTables;
     std::vector<RowVectorPtr> batches;
     makeBuildBatches(batches);
@@ -409,6 +442,8 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     auto numBatch = params_.probeSize / params_.hashTableSize;
     auto batchSize = params_.hashTableSize;
     SelectivityInfo listJoinResultClocks;
+    SelectivityInfo extractClocks;
+    SelectivityInfo sharedExtractClocks;
     BaseHashTable::JoinResultIterator results;
     BufferPtr outputRowMapping;
     auto outputBatchSize = batchSize;
@@ -422,21 +457,60 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
       auto mapping = initializeRowNumberMapping(
           outputRowMapping, outputBatchSize, pool_.get());
       outputTableRows.resize(outputBatchSize);
-      {
-        SelectivityTimer timer(listJoinResultClocks, 0);
-        while (!results.atEnd()) {
-          numJoinListResult += topTable_->listJoinResults(
+      while (!results.atEnd()) {
+        int32_t numOut;
+        {
+          SelectivityTimer timer(listJoinResultClocks, 0);
+          numOut = topTable_->listJoinResults(
               results,
               false,
               mapping,
               folly::Range(outputTableRows.data(), outputTableRows.size()));
         }
+        numJoinListResult += numOut;
+        if (params_.numDependentFields > 0) {
+          extractDependentFields(
+              folly::Range<char* const*>(outputTableRows.data(), numOut),
+              extractClocks,
+              sharedExtractClocks);
+        }
       }
     }
     listJoinResultTime_ = listJoinResultClocks.timeToDropValue();
+    extractTime_ = extractClocks.timeToDropValue();
+    sharedExtractTime_ = sharedExtractClocks.timeToDropValue();
     return numJoinListResult;
   }
 
+  // Extracts the dependent fields of 'rows' with a copy per row and with a
+  // copy per distinct row, as HashProbe does for the build side output.
+  void extractDependentFields(
+      folly::Range<char* const*> rows,
+      SelectivityInfo& extractClocks,
+      SelectivityInfo& sharedExtractClocks) {
+    auto* rowContainer = topTable_->rows();
+    auto extractRows = [&]() {
+      for (auto i = 1; i <= params_.numDependentFields; ++i) {
+        auto result = BaseVector::create(
+            params_.buildType->childAt(i), rows.size(), pool_.get());
+        rowContainer->extractColumn(rows.data(), rows.size(), i, result);
+      }
+    };
+    {
+      SelectivityTimer timer(extractClocks, 0);
+      extractRows();
+    }
+    SelectivityTimer timer(sharedExtractClocks, 0);
+    if (!sharedRowsExtractor_.prepare(rows, pool_.get())) {
+      extractRows();
+      return;
+    }
+    for (auto i = 1; i <= params_.numDependentFields; ++i) {
+      sharedRowsExtractor_.extract(
+          *rowContainer, i, params_.buildType->childAt(i), pool_.get());
+    }
+  }
+
   void eraseTable() {
     auto lookup = std::make_unique<HashLookup>(topTable_->hashers());
     auto batchSize = 10000;
@@ -473,6 +547,9 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
   double buildTime_{0};
   double eraseTime_{0};
   double listJoinResultTime_{0};
+  double extractTime_{0};
+  double sharedExtractTime_{0};
+  SharedRowsExtractor sharedRowsExtractor_;
 };
 
 void combineResults(
@@ -539,6 +616,32 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Tables far larger than the last level cache, where following the
+  // duplicate rows of each hit is bound by memory latency.
+  const auto largeHashTableSize = (32L << 20) - 3;
+  for (auto& dist : std::vector<std::vector<std::pair<int32_t, int32_t>>>{
+           {{20, 5}, {80, 0}}, {{100, 1}}}) {
+    params.emplace_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kHash,
+        keyAndDependentType,
+        largeHashTableSize,
+        probeRowSize,
+        dist,
+        false));
+  }
+
+  // Many to many joins where consecutive probe rows share the key.
+  for (auto probeKeyRepeat : {1, 4, 16}) {
+    params.emplace_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kHash,
+        keyAndDependentType,
+        hashTableSize,
+        probeRowSize,
+        {{100, 5}},
+        false,
+        probeKeyRepeat));
+  }
+
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
       combineResults(results, bm->run(param));
@@ -623,6 +623,18 @@ int main(int argc, char** argv) {
   auto bm = std::make_unique<HashTableBenchmark>();
   std::vector<HashTableBenchmarkRun> results;
 
+  // Two keys with a wide combined range make a kHash mode table, which is
+  // probed through the tags and the full key compare. At 32M rows the table
+  // is far larger than the last level cache, so the probes are bound by
+  // memory latency.
+  auto hashModeParams = [](std::string title, int64_t size, int32_t hitrate) {
+    HashTableBenchmarkParams params(std::move(title), size, hitrate);
+    params.mode = BaseHashTable::HashMode::kHash;
+    params.buildType = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+    params.numKeys = 2;
+    return params;
+  };
+
   std::vector<HashTableBenchmarkParams> params = {
       HashTableBenchmarkParams("Hit10K", 10000, 100),
       HashTableBenchmarkParams("Miss10K", 10000, 5),
@@ -636,7 +648,11 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Hit32M", 32000000, 100),
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
-      HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+      HashTableBenchmarkParams("Hit128M", 128000000, 100),
+
+      hashModeParams("HitHash4M", 4000000, 100),
+      hashModeParams("HitHash32M", 32000000, 100),
+      hashModeParams("MissHash32M", 32000000, 5)};
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
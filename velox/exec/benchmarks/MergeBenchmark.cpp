@@ -20,11 +20,73 @@
 #include <gflags/gflags.h>
 
 #include "velox/exec/TreeOfLosers.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
+namespace {
+/// Runs LocalMerge over 'kNumSources' sorted sources of 'kNumBatches' batches
+/// each, to measure the row comparisons of Merge on normalized keys and keys
+/// compared by value.
+class LocalMergeBenchmark : public test::VectorTestBase {
+ public:
+  static constexpr int32_t kNumSources = 16;
+  static constexpr int32_t kNumBatches = 10;
+  static constexpr vector_size_t kBatchSize = 10'000;
+
+  LocalMergeBenchmark() {
+    const std::string prefix(20, 'x');
+    for (auto source = 0; source < kNumSources; ++source) {
+      std::vector<RowVectorPtr> batches;
+      for (auto batch = 0; batch < kNumBatches; ++batch) {
+        const auto start = (batch * kBatchSize) * kNumSources + source;
+        batches.push_back(makeRowVector({
+            makeFlatVector<int64_t>(
+                kBatchSize,
+                [&](auto row) { return (start + row * kNumSources) / 3; }),
+            makeFlatVector<double>(
+                kBatchSize,
+                [&](auto row) { return (start + row * kNumSources) * 0.5; }),
+            makeFlatVector<std::string>(
+                kBatchSize,
+                [&](auto row) {
+                  return fmt::format(
+                      "{}{:012}", prefix, start + row * kNumSources);
+                }),
+            makeArrayVector<int64_t>(
+                kBatchSize,
+                [](auto /*row*/) { return 1; },
+                [&](auto row) { return start + row * kNumSources; }),
+        }));
+      }
+      sources_.push_back(std::move(batches));
+    }
+  }
+
+  void run(const std::vector<std::string>& keys) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources;
+    for (const auto& batches : sources_) {
+      sources.push_back(
+          PlanBuilder(planNodeIdGenerator).values(batches).planNode());
+    }
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .localMerge(keys, std::move(sources))
+                    .planNode();
+    AssertQueryBuilder(plan).copyResults(pool_.get());
+  }
+
+ private:
+  std::vector<std::vector<RowVectorPtr>> sources_;
+};
+
+std::unique_ptr<LocalMergeBenchmark> localMerge;
+} // namespace
+
 TestData narrow;
 TestData medium;
 TestData wide;
@@ -53,14 +115,34 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK(localMergeBigint) {
+  localMerge->run({"c0", "c1"});
+}
+
+BENCHMARK(localMergeDouble) {
+  localMerge->run({"c1"});
+}
+
+BENCHMARK(localMergeVarchar) {
+  localMerge->run({"c2"});
+}
+
+// The array key is not normalized and compared by value.
+BENCHMARK(localMergeArray) {
+  localMerge->run({"c3"});
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memory::MemoryManager::initialize({});
+  localMerge = std::make_unique<LocalMergeBenchmark>();
   MergeTestBase test;
   test.seed(1);
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
   folly::runBenchmarks();
+  localMerge.reset();
   return 0;
 }
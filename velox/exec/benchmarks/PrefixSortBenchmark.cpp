@@ -137,6 +137,13 @@ static const PrefixSortConfig kStdSortConfig(
     1024,
     std::numeric_limits<int>::max());
 
+// Sorts the prefixes with quick-sort only, to compare with radix sort.
+static const PrefixSortConfig kQuickSortConfig(
+    1024,
+    100,
+    PrefixSortConfig::kDefaultMaxStringPrefixLength,
+    std::numeric_limits<uint32_t>::max());
+
 class PrefixSortBenchmark {
  public:
   PrefixSortBenchmark(memory::MemoryPool* pool) : pool_(pool) {}
@@ -160,6 +167,15 @@ class PrefixSortBenchmark {
         sortedRows, pool_, rowContainer, compareFlags, kStdSortConfig);
   }
 
+  void runPrefixQuickSort(
+      const std::vector<char*>& rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags) {
+    std::vector<char*> sortedRows = rows;
+    PrefixSort::sort(
+        sortedRows, pool_, rowContainer, compareFlags, kQuickSortConfig);
+  }
+
   // Add benchmark manually to avoid writing a lot of BENCHMARK.
   void addBenchmark(
       const std::string& testName,
@@ -167,7 +183,8 @@ class PrefixSortBenchmark {
       const RowTypePtr& rowType,
       int iterations,
       int numKeys,
-      bool testStdSort) {
+      bool testStdSort,
+      bool testQuickSort) {
     auto testCase =
         std::make_unique<TestCase>(pool_, testName, numRows, rowType, numKeys);
     // Add benchmarks for std-sort and prefix-sort.
@@ -200,6 +217,21 @@ class PrefixSortBenchmark {
             }
             return rows.size() * iterations;
           });
+      if (testQuickSort) {
+        folly::addBenchmark(
+            __FILE__,
+            "%PrefixQuickSort",
+            [rows = testCase->rows(),
+             container = testCase->rowContainer(),
+             sortFlags = testCase->compareFlags(),
+             iterations = iterations,
+             this]() {
+              for (auto i = 0; i < iterations; ++i) {
+                runPrefixQuickSort(rows, container, sortFlags);
+              }
+              return rows.size() * iterations;
+            });
+      }
     }
     testCases_.push_back(std::move(testCase));
   }
@@ -211,13 +243,20 @@ class PrefixSortBenchmark {
       const std::vector<RowTypePtr>& rowTypes,
       const std::vector<int>& numKeys,
       int32_t iterations,
-      bool testStdSort = true) {
+      bool testStdSort = true,
+      bool testQuickSort = false) {
     for (auto batchSize : batchSizes) {
       for (auto i = 0; i < rowTypes.size(); ++i) {
         const auto name = fmt::format(
             "{}_{}_{}_{}k", prefix, numKeys[i], keyName, batchSize / 1000.0);
         addBenchmark(
-            name, batchSize, rowTypes[i], iterations, numKeys[i], testStdSort);
+            name,
+            batchSize,
+            rowTypes[i],
+            iterations,
+            numKeys[i],
+            testStdSort,
+            testQuickSort);
       }
     }
   }
@@ -283,6 +322,28 @@ class PrefixSortBenchmark {
     bigint(false, iterations, batchSizes);
   }
 
+  // Compares radix sort with quick-sort of the prefixes.
+  void largeBigintRadixSort() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({BIGINT()}),
+        ROW({BIGINT(), BIGINT()}),
+        ROW({INTEGER(), DOUBLE()}),
+    };
+    std::vector<int> numKeys = {1, 2, 2};
+    benchmark(
+        "radix",
+        "fixed-width",
+        batchSizes,
+        rowTypes,
+        numKeys,
+        iterations,
+        true,
+        true);
+  }
+
   void largeVarchar() {
     const auto iterations = 10;
     const std::vector<vector_size_t> batchSizes = {
@@ -298,6 +359,24 @@ class PrefixSortBenchmark {
         "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
   }
 
+  void largeVarcharTimestamp() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        1'000, 10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({VARCHAR(), TIMESTAMP()}),
+        ROW({VARCHAR(), TIMESTAMP(), BIGINT()}),
+    };
+    std::vector<int> numKeys = {2, 2};
+    benchmark(
+        "payloads",
+        "varchar-timestamp",
+        batchSizes,
+        rowTypes,
+        numKeys,
+        iterations);
+  }
+
  private:
   std::vector<std::unique_ptr<TestCase>> testCases_;
   memory::MemoryPool* pool_;
@@ -316,8 +395,10 @@ int main(int argc, char** argv) {
   bm.smallBigint();
   bm.largeBigint();
   bm.largeBigintWithPayloads();
+  bm.largeBigintRadixSort();
   bm.smallBigintWithPayload();
   bm.largeVarchar();
+  bm.largeVarcharTimestamp();
   folly::runBenchmarks();
 
   return 0;
@@ -17,6 +17,9 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include <algorithm>
+#include <random>
+
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/exec/RowContainer.h"
@@ -213,6 +216,59 @@ void BM_STR_timSort(uint32_t iterations) {
     suspender.rehire();
   }
 }
+
+// Extracts 'numColumns' BIGINT columns of 'numRows' rows in batches of 1024
+// rows, the way operators produce their output from a RowContainer. The rows
+// are visited in random order if 'shuffle', e.g. after sorting or probing.
+void rowContainerExtractBenchmark(
+    uint32_t iterations,
+    int32_t numRows,
+    int32_t numColumns,
+    bool shuffle) {
+  constexpr int32_t kBatchSize = 1024;
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  VectorMaker vectorMaker(pool.get());
+  std::vector<TypePtr> types(numColumns, BIGINT());
+  auto rowContainer =
+      std::make_unique<velox::exec::RowContainer>(types, pool.get());
+  auto vector = vectorMaker.flatVector<int64_t>(
+      numRows,
+      [](auto row) { return row; },
+      [](auto row) { return row % 10 == 0; });
+  DecodedVector decoded(*vector);
+  std::vector<char*> rows(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    rows[row] = rowContainer->newRow();
+    for (auto column = 0; column < numColumns; ++column) {
+      rowContainer->store(decoded, row, rows[row], column);
+    }
+  }
+  if (shuffle) {
+    std::mt19937 rng(1);
+    std::shuffle(rows.begin(), rows.end(), rng);
+  }
+  auto result = BaseVector::create(BIGINT(), kBatchSize, pool.get());
+  for (size_t k = 0; k < iterations; ++k) {
+    suspender.dismiss();
+    for (auto offset = 0; offset < numRows; offset += kBatchSize) {
+      const auto batchSize = std::min(kBatchSize, numRows - offset);
+      for (auto column = 0; column < numColumns; ++column) {
+        rowContainer->extractColumn(
+            rows.data() + offset, batchSize, column, result);
+      }
+    }
+    suspender.rehire();
+  }
+}
+
+void BM_extract_sequential(uint32_t iterations, size_t numRows) {
+  rowContainerExtractBenchmark(iterations, numRows, 4, false);
+}
+
+void BM_extract_shuffled(uint32_t iterations, size_t numRows) {
+  rowContainerExtractBenchmark(iterations, numRows, 4, true);
+}
 } // namespace
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 100k_uni_noseq, 100000);
@@ -230,6 +286,14 @@ BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(BM_STR_stdSort, RealWorldData_stdSort);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_STR_timSort, RealWorldData_timSort);
 BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(BM_extract_sequential, 1m_4_columns, 1'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_extract_shuffled, 1m_4_columns, 1'000'000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(BM_extract_sequential, 10k_4_columns, 10'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_extract_shuffled, 10k_4_columns, 10'000);
+BENCHMARK_DRAW_LINE();
 } // namespace facebook::velox::test
 
 int main(int argc, char** argv) {
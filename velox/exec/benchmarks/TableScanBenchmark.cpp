@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/WriterFactory.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(scan_num_rows, 1'000'000, "Number of rows in each table");
+DEFINE_int32(scan_batch_size, 10'000, "Number of rows in each written vector");
+
+/// Benchmark of TableScan over HiveDataSource. Generates tables with
+/// VectorFuzzer, writes each in DWRF and, if Velox is built with Parquet
+/// support, Parquet, and scans them with filters of different selectivity.
+///
+/// The tables are a combination of:
+/// - 'flat' columns: bigint, low cardinality bigint, varchar, low cardinality
+///   varchar and double, or 'nested' columns: array, map and row.
+/// - No nulls or 20% nulls.
+///
+/// The low cardinality columns have 100 distinct values, so that the writers
+/// pick dictionary encoding for them. Filters are on the first column, c0,
+/// which is uniform in [0, 1M), and pass 100%, 50%, 10% or 1% of the rows.
+/// Each scan runs with and without AsyncDataCache.
+///
+/// Besides the time, each benchmark reports the scan rows and raw input bytes
+/// per iteration and the rows and bytes per second of the TableScan operator.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+constexpr int64_t kFilterRange = 1'000'000;
+
+struct Table {
+  std::string name;
+  dwio::common::FileFormat format;
+  RowTypePtr type;
+  std::shared_ptr<TempDirectoryPath> directory;
+  std::vector<std::string> files;
+};
+
+class TableScanBenchmark : public test::VectorTestBase {
+ public:
+  TableScanBenchmark() {
+    filesystems::registerLocalFileSystem();
+    cache_ =
+        cache::AsyncDataCache::create(memory::memoryManager()->allocator());
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(1);
+    ioExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(8);
+    connector::registerConnector(
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId,
+                std::make_shared<core::MemConfig>(),
+                ioExecutor_.get()));
+  }
+
+  ~TableScanBenchmark() {
+    tables_.clear();
+    ioExecutor_.reset();
+    connector::unregisterConnector(kHiveConnectorId);
+    cache_->shutdown();
+  }
+
+  void addBenchmarks() {
+    const auto flatType =
+        ROW({"c0", "c1", "c2", "c3", "c4"},
+            {BIGINT(), BIGINT(), VARCHAR(), VARCHAR(), DOUBLE()});
+    const auto nestedType =
+        ROW({"c0", "c1", "c2", "c3"},
+            {BIGINT(),
+             ARRAY(BIGINT()),
+             MAP(VARCHAR(), BIGINT()),
+             ROW({"a", "b"}, {BIGINT(), VARCHAR()})});
+
+    for (auto format :
+         {dwio::common::FileFormat::DWRF, dwio::common::FileFormat::PARQUET}) {
+      if (!dwio::common::hasWriterFactory(format)) {
+        LOG(INFO) << "Skipping " << dwio::common::toString(format)
+                  << ", there is no writer";
+        continue;
+      }
+      for (const auto& [columns, type] :
+           {std::make_pair("flat", flatType),
+            std::make_pair("nested", nestedType)}) {
+        // c1 and c3 of 'flatType' are the low cardinality columns.
+        const auto lowCardinalityColumns = type == flatType
+            ? std::vector<column_index_t>{1, 3}
+            : std::vector<column_index_t>{};
+        for (auto nullPct : {0, 20}) {
+          auto* table = makeTable(
+              fmt::format(
+                  "{}_{}_nulls{}",
+                  dwio::common::toString(format),
+                  columns,
+                  nullPct),
+              format,
+              type,
+              lowCardinalityColumns,
+              nullPct / 100.0);
+          for (auto passPct : {100, 50, 10, 1}) {
+            for (auto useCache : {false, true}) {
+              folly::addBenchmark(
+                  __FILE__,
+                  fmt::format(
+                      "{}_pass{}{}",
+                      table->name,
+                      passPct,
+                      useCache ? "_cache" : ""),
+                  [this, table, passPct, useCache](
+                      folly::UserCounters& counters, unsigned n) {
+                    for (unsigned i = 0; i < n; ++i) {
+                      scan(*table, passPct, useCache, counters);
+                    }
+                    return n;
+                  });
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  // Returns 'size' rows of 'type'. c0 is uniform in [0, kFilterRange) and
+  // 'lowCardinalityColumns' repeat 100 distinct values.
+  RowVectorPtr makeBatch(
+      const RowTypePtr& type,
+      vector_size_t size,
+      const std::vector<column_index_t>& lowCardinalityColumns,
+      double nullRatio) {
+    VectorFuzzer::Options options;
+    options.vectorSize = size;
+    options.nullRatio = nullRatio;
+    options.stringLength = 20;
+    options.containerLength = 5;
+    VectorFuzzer fuzzer(options, pool(), folly::Random::rand32(rng_));
+
+    std::vector<VectorPtr> children;
+    children.push_back(makeFlatVector<int64_t>(
+        size,
+        [&](auto /*row*/) {
+          return folly::Random::rand64(rng_) % kFilterRange;
+        },
+        [&](auto /*row*/) {
+          return folly::Random::randDouble01(rng_) < nullRatio;
+        }));
+    for (auto i = 1; i < type->size(); ++i) {
+      const auto& childType = type->childAt(i);
+      const bool lowCardinality = std::find(
+                                      lowCardinalityColumns.begin(),
+                                      lowCardinalityColumns.end(),
+                                      i) != lowCardinalityColumns.end();
+      children.push_back(
+          lowCardinality
+              ? fuzzer.fuzzDictionary(fuzzer.fuzzFlat(childType, 100), size)
+              : fuzzer.fuzzFlat(childType));
+    }
+    return makeRowVector(type->names(), children);
+  }
+
+  Table* makeTable(
+      const std::string& name,
+      dwio::common::FileFormat format,
+      const RowTypePtr& type,
+      const std::vector<column_index_t>& lowCardinalityColumns,
+      double nullRatio) {
+    auto table = std::make_unique<Table>();
+    table->name = name;
+    table->format = format;
+    table->type = type;
+    table->directory = TempDirectoryPath::create();
+
+    std::vector<RowVectorPtr> batches;
+    for (auto row = 0; row < FLAGS_scan_num_rows;
+         row += FLAGS_scan_batch_size) {
+      batches.push_back(makeBatch(
+          type,
+          std::min(FLAGS_scan_batch_size, FLAGS_scan_num_rows - row),
+          lowCardinalityColumns,
+          nullRatio));
+    }
+    AssertQueryBuilder(
+        PlanBuilder()
+            .values(batches)
+            .tableWrite(table->directory->getPath(), format)
+            .planNode())
+        .copyResults(pool());
+    for (const auto& entry :
+         fs::directory_iterator(table->directory->getPath())) {
+      // Skip the writers' hidden and temporary files.
+      if (entry.is_regular_file() &&
+          entry.path().filename().c_str()[0] != '.') {
+        table->files.push_back(entry.path().string());
+      }
+    }
+    tables_.push_back(std::move(table));
+    return tables_.back().get();
+  }
+
+  void scan(
+      const Table& table,
+      int32_t passPct,
+      bool useCache,
+      folly::UserCounters& counters) {
+    std::vector<std::string> filters;
+    if (passPct < 100) {
+      filters.push_back(fmt::format("c0 < {}", kFilterRange / 100 * passPct));
+    }
+    core::PlanNodeId scanNodeId;
+    CursorParameters params;
+    params.planNode = PlanBuilder()
+                          .tableScan(table.type, filters)
+                          .capturePlanNodeId(scanNodeId)
+                          .planNode();
+    params.queryCtx = core::QueryCtx::create(
+        executor_.get(),
+        core::QueryConfig{{}},
+        {},
+        useCache ? cache_.get() : nullptr);
+    params.copyResult = false;
+
+    bool noMoreSplits = false;
+    auto [cursor, results] = readCursor(params, [&](Task* task) {
+      if (noMoreSplits) {
+        return;
+      }
+      for (const auto& file : table.files) {
+        for (auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+                 file, 1, table.format)) {
+          task->addSplit(scanNodeId, Split(std::move(split)));
+        }
+      }
+      task->noMoreSplits(scanNodeId);
+      noMoreSplits = true;
+    });
+    VELOX_CHECK(waitForTaskCompletion(cursor->task().get()));
+
+    const auto planStats = toPlanStats(cursor->task()->taskStats());
+    const auto& scanStats = planStats.at(scanNodeId);
+    const auto seconds = std::max<double>(
+        scanStats.cpuWallTiming.wallNanos / 1'000'000'000.0, 1e-9);
+    // The counters are for a single scan.
+    counters["rows"] = scanStats.outputRows;
+    counters["raw_bytes"] = scanStats.rawInputBytes;
+    counters["rows_per_sec"] = scanStats.outputRows / seconds;
+    counters["raw_bytes_per_sec"] = scanStats.rawInputBytes / seconds;
+  }
+
+  folly::Random::DefaultGenerator rng_{1};
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::vector<std::unique_ptr<Table>> tables_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::MemoryManager::initialize({});
+  TableScanBenchmark benchmark;
+  benchmark.addBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
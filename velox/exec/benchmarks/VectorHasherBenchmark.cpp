@@ -114,6 +114,52 @@ BENCHMARK_RELATIVE(computeValueIdsSmallintWithNulls) {
   benchmarkComputeValueIds<int16_t>(true);
 }
 
+// Packs three range mapped keys into one normalized key. The second and third
+// keys are added to the first with a multiplier.
+template <typename T>
+void benchmarkComputeValueIdsMultiKey() {
+  folly::BenchmarkSuspender suspender;
+  constexpr int32_t kNumKeys = 3;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+  std::vector<VectorPtr> vectors;
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < kNumKeys; ++i) {
+    vectors.push_back(base.vectorMaker().flatVector<T>(
+        size, [i](vector_size_t row) { return (row * (i + 1)) % 17; }));
+    hashers.push_back(
+        std::make_unique<VectorHasher>(CppToType<T>::create(), i));
+  }
+
+  raw_vector<uint64_t> hashes(size);
+  SelectivityVector rows(size);
+  uint64_t multiplier = 1;
+  for (auto i = 0; i < kNumKeys; ++i) {
+    hashers[i]->decode(*vectors[i], rows);
+    hashers[i]->computeValueIds(rows, hashes);
+  }
+  for (auto i = 0; i < kNumKeys; ++i) {
+    multiplier = hashers[i]->enableValueRange(multiplier, 0);
+  }
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    for (auto j = 0; j < kNumKeys; ++j) {
+      hashers[j]->decode(*vectors[j], rows);
+      bool ok = hashers[j]->computeValueIds(rows, hashes);
+      folly::doNotOptimizeAway(ok);
+    }
+  }
+}
+
+BENCHMARK(computeValueIdsBigintMultiKey) {
+  benchmarkComputeValueIdsMultiKey<int64_t>();
+}
+
+BENCHMARK(computeValueIdsIntegerMultiKey) {
+  benchmarkComputeValueIdsMultiKey<int32_t>();
+}
+
 void benchmarkComputeValueIdsForStrings(bool flattenDictionaries) {
   folly::BenchmarkSuspender suspender;
   BenchmarkBase base;
@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 
 #include "velox/common/base/Exceptions.h"
@@ -151,6 +153,12 @@ class PrefixSortRunner {
   static const int kSmallSort = 7;
   static const int kMediumSort = 40;
 
+  // Within radixSort, the buckets with less than kRadixSortMinBucket entries
+  // and the buckets below kRadixSortMaxDepth levels of splits are sorted
+  // with quick-sort. The depth limit bounds the stack use for long keys.
+  static const int kRadixSortMinBucket = 64;
+  static const int kRadixSortMaxDepth = 16;
+
   template <typename TCompare>
   void quickSort(char* start, char* end, TCompare compare) const {
     quickSort(
@@ -159,6 +167,28 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) with an in-place MSD radix sort over
+  /// 'numDigits' byte digits. TDigit is a function : uint8_t digit(char*
+  /// entry, uint32_t index) that returns byte 'index' of the key of 'entry',
+  /// byte 0 being the most significant. The order of the digits must be the
+  /// order of 'compare', which sorts the small buckets.
+  template <typename TDigit, typename TCompare>
+  void radixSort(
+      char* start,
+      char* end,
+      uint32_t numDigits,
+      TDigit digit,
+      TCompare compare) const {
+    radixSort(
+        detail::PrefixSortIterator(start, entrySize_),
+        detail::PrefixSortIterator(end, entrySize_),
+        0,
+        numDigits,
+        0,
+        digit,
+        compare);
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -347,6 +377,76 @@ class PrefixSortRunner {
     }
   }
 
+  // Sort prefix data in range [start, end) from digit 'index' on using
+  // American flag sort, see:
+  // P.M.McIlroy, K.Bostic and M.D.McIlroy’s paper:
+  // "Engineering Radix Sort"
+  // Each level counts the entries in each of the 256 buckets of a digit, then
+  // moves every entry to its bucket by swapping it with the next unplaced
+  // entry of its bucket. The digits that are equal for all entries only take
+  // the counting pass.
+  template <typename TDigit, typename TCompare>
+  void radixSort(
+      const detail::PrefixSortIterator& start,
+      const detail::PrefixSortIterator& end,
+      uint32_t index,
+      uint32_t numDigits,
+      int32_t depth,
+      TDigit digit,
+      TCompare compare) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.")
+    const uint64_t len = end - start;
+    if (len < kRadixSortMinBucket || depth >= kRadixSortMaxDepth) {
+      quickSort(start, end, compare);
+      return;
+    }
+    VELOX_DCHECK_LE(len, std::numeric_limits<uint32_t>::max());
+    // Bucket 'b' of digit 'index' is [bounds[b], bounds[b + 1]).
+    std::array<uint32_t, 257> bounds;
+    for (;; ++index) {
+      if (index == numDigits) {
+        return;
+      }
+      bounds.fill(0);
+      for (auto it = start; it < end; ++it) {
+        ++bounds[digit(*it, index) + 1];
+      }
+      if (bounds[digit(*start, index) + 1] != len) {
+        break;
+      }
+    }
+    for (auto b = 1; b < bounds.size(); ++b) {
+      bounds[b] += bounds[b - 1];
+    }
+    std::array<uint32_t, 256> next;
+    std::copy(bounds.begin(), bounds.end() - 1, next.begin());
+    for (auto b = 0; b < next.size(); ++b) {
+      while (next[b] < bounds[b + 1]) {
+        const auto value = digit(*(start + next[b]), index);
+        if (value == b) {
+          ++next[b];
+        } else {
+          swap(start + next[b], start + next[value]++);
+        }
+      }
+    }
+    if (index + 1 == numDigits) {
+      return;
+    }
+    for (auto b = 0; b < next.size(); ++b) {
+      if (bounds[b + 1] - bounds[b] > 1) {
+        radixSort(
+            start + bounds[b],
+            start + bounds[b + 1],
+            index + 1,
+            numDigits,
+            depth + 1,
+            digit,
+            compare);
+      }
+    }
+  }
+
   const uint64_t entrySize_;
   char* const swapBuffer_;
 };
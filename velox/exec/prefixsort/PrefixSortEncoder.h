@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +35,7 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp). See encodeString() for strings.
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -53,6 +54,55 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encodes the first 'prefixLength' bytes of a string. The first byte is
+  /// the null byte as in encode(). The remaining 'prefixLength' + 1 bytes are
+  /// set by encodeStringNoNulls(), or to '0' if value is null.
+  FOLLY_ALWAYS_INLINE void encodeString(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t prefixLength) const {
+    if (value.has_value()) {
+      dest[0] = nullsFirst_ ? 1 : 0;
+      encodeStringNoNulls(value.value(), dest + 1, prefixLength);
+    } else {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixLength + 1);
+    }
+  }
+
+  /// Writes the first 'prefixLength' bytes of 'value', padded with '0', and a
+  /// length byte. The length byte is the size of 'value', or 'prefixLength' +
+  /// 1 if 'value' is truncated. Strings compare as unsigned bytes, so a
+  /// padded string is less than any longer string with the same bytes, and
+  /// the length byte orders the strings that differ only in trailing '0'
+  /// bytes. Only two truncated strings with the same prefix compare equal
+  /// without being equal, see stringTruncatedByte(). The bits are inverted
+  /// when descending order.
+  FOLLY_ALWAYS_INLINE void encodeStringNoNulls(
+      StringView value,
+      char* dest,
+      uint32_t prefixLength) const {
+    VELOX_DCHECK_LT(prefixLength, kMaxStringPrefixLength + kMaxPadding);
+    const auto size = value.size();
+    const auto numBytes = std::min<uint32_t>(size, prefixLength);
+    std::memcpy(dest, value.data(), numBytes);
+    simd::memset(dest + numBytes, 0, prefixLength - numBytes);
+    dest[prefixLength] = static_cast<char>(
+        size > prefixLength ? prefixLength + 1 : static_cast<uint32_t>(size));
+    if (!ascending_) {
+      for (auto i = 0; i <= prefixLength; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
+  /// Returns the length byte of a string truncated to 'prefixLength'. Never
+  /// 0, which is the length byte of a null.
+  FOLLY_ALWAYS_INLINE uint8_t stringTruncatedByte(uint32_t prefixLength) const {
+    const uint8_t truncated = prefixLength + 1;
+    return ascending_ ? truncated : ~truncated;
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -66,6 +116,17 @@ class PrefixSortEncoder {
     return nullsFirst_;
   }
 
+  /// The maximum number of string bytes in a prefix before the padding for
+  /// alignment. Keeps the length byte of a truncated string from being 0.
+  static constexpr uint32_t kMaxStringPrefixLength = 128;
+  static constexpr uint32_t kMaxPadding = 8;
+
+  /// Returns the encoded size of a string with 'prefixLength' bytes, assume
+  /// nullable.
+  static constexpr uint32_t encodedStringSize(uint32_t prefixLength) {
+    return prefixLength + 2;
+  }
+
   /// @return For supported types, returns the encoded size, assume nullable.
   ///         For not supported types, returns 'std::nullopt'.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
@@ -44,6 +44,22 @@ class PrefixSortAlgorithmBenchmark {
         });
   }
 
+  void runRadixSort(std::vector<int64_t> vec) {
+    char* start = (char*)vec.data();
+    uint32_t entrySize = sizeof(int64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    sortRunner.radixSort(
+        start,
+        start + entrySize * vec.size(),
+        entrySize,
+        [](char* entry, uint32_t index) {
+          return static_cast<uint8_t>(entry[index]);
+        },
+        [&](char* a, char* b) { return memcmp(a, b, 8); });
+  }
+
   std::vector<int64_t> generateTestVector(int32_t size) {
     std::vector<int64_t> randomTestVec(size);
     std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
@@ -70,18 +86,34 @@ BENCHMARK(PrefixSort_algorithm_10k) {
   bm->runQuickSort(data10k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_10k) {
+  bm->runRadixSort(data10k);
+}
+
 BENCHMARK(PrefixSort_algorithm_100k) {
   bm->runQuickSort(data100k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_100k) {
+  bm->runRadixSort(data100k);
+}
+
 BENCHMARK(PrefixSort_algorithm_1000k) {
   bm->runQuickSort(data1000k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_1000k) {
+  bm->runRadixSort(data1000k);
+}
+
 BENCHMARK(PrefixSort_algorithm_10000k) {
   bm->runQuickSort(data10000k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_10000k) {
+  bm->runRadixSort(data10000k);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
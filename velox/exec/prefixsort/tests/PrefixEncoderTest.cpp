@@ -337,6 +337,56 @@ TEST_F(PrefixEncoderTest, compare) {
   testCompare<Timestamp>();
 }
 
+TEST_F(PrefixEncoderTest, encodeString) {
+  constexpr uint32_t kPrefixLength = 4;
+  constexpr auto kEncodedSize =
+      PrefixSortEncoder::encodedStringSize(kPrefixLength);
+  // Strings in ascending order. "abcde" and "abcdf" are equal in the prefix.
+  const std::vector<std::string> values = {
+      "",
+      std::string(1, '\0'),
+      "a",
+      std::string("a\0", 2),
+      "ab",
+      "abc",
+      "abcd",
+      "abcde",
+      "abcdf",
+      "\xff"};
+  for (const auto* encoder :
+       {&ascNullsFirstEncoder_, &descNullsFirstEncoder_}) {
+    std::vector<std::array<char, kEncodedSize>> encoded(values.size());
+    for (auto i = 0; i < values.size(); ++i) {
+      encoder->encodeString(
+          StringView(values[i]), encoded[i].data(), kPrefixLength);
+      ASSERT_EQ(encoded[i][0], 1);
+    }
+    const auto truncatedByte = encoder->stringTruncatedByte(kPrefixLength);
+    for (auto i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(
+          static_cast<uint8_t>(encoded[i][kEncodedSize - 1]) == truncatedByte,
+          values[i].size() > kPrefixLength);
+      for (auto j = i + 1; j < values.size(); ++j) {
+        const auto result =
+            std::memcmp(encoded[i].data(), encoded[j].data(), kEncodedSize);
+        const bool truncatedTie =
+            i == values.size() - 3 && j == values.size() - 2;
+        if (truncatedTie) {
+          ASSERT_EQ(result, 0);
+        } else if (encoder->isAscending()) {
+          ASSERT_LT(result, 0) << values[i] << " " << values[j];
+        } else {
+          ASSERT_GT(result, 0) << values[i] << " " << values[j];
+        }
+      }
+    }
+    std::array<char, kEncodedSize> null;
+    encoder->encodeString(std::nullopt, null.data(), kPrefixLength);
+    ASSERT_EQ(null[0], 0);
+    ASSERT_NE(static_cast<uint8_t>(null[kEncodedSize - 1]), truncatedByte);
+  }
+}
+
 TEST_F(PrefixEncoderTest, fuzzyInteger) {
   testFuzz<TypeKind::INTEGER>();
 }
@@ -55,6 +55,36 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  void testRadixSort(size_t size, uint64_t maxValue) {
+    std::vector<int64_t> data1(size);
+    std::generate(data1.begin(), data1.end(), [&]() {
+      return folly::Random::rand64(maxValue);
+    });
+    std::vector<int64_t> data2 = data1;
+
+    // Sort data1 with radix-sort.
+    {
+      char* start = (char*)data1.data();
+      char* end = start + sizeof(int64_t) * data1.size();
+      uint32_t entrySize = sizeof(int64_t);
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      encodeInPlace(data1);
+      sortRunner.radixSort(
+          start,
+          end,
+          sizeof(int64_t),
+          [](char* entry, uint32_t index) {
+            return static_cast<uint8_t>(entry[index]);
+          },
+          [&](char* a, char* b) { return memcmp(a, b, 8); });
+    }
+
+    std::sort(data2.begin(), data2.end());
+    decodeInPlace(data1);
+    ASSERT_EQ(data1, data2);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +100,16 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  for (const uint64_t maxValue :
+       {std::numeric_limits<uint64_t>::max(), 1UL << 20, 100UL, 1UL}) {
+    SCOPED_TRACE(fmt::format("maxValue {}", maxValue));
+    testRadixSort(PrefixSortRunner::kRadixSortMinBucket - 1, maxValue);
+    testRadixSort(PrefixSortRunner::kRadixSortMinBucket, maxValue);
+    testRadixSort(100'000, maxValue);
+  }
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
@@ -16,6 +16,7 @@
 
 #include <fmt/format.h>
 #include <folly/Math.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <re2/re2.h>
 
 #include "folly/experimental/EventCount.h"
@@ -25,6 +26,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/GroupingSetsRollUp.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -840,6 +842,43 @@ TEST_F(AggregationTest, allKeyTypes) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, partialAggregationOverFilterProject) {
+  // The filter wraps the projected columns in a dictionary with the indices
+  // of the passing rows, which the partial aggregation peels off.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return row * 7 + i; }, nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 3 = 0")
+                  .project({"c0 % 10 AS k", "c1", "c1 * 2 AS d", "1 AS one"})
+                  .partialAggregation(
+                      {"k"}, {"sum(c1)", "max(d)", "count(one)", "count(1)"})
+                  .finalAggregation()
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0 % 10, sum(c1), max(c1 * 2), count(1), count(1) FROM tmp "
+      "WHERE c0 % 3 = 0 GROUP BY 1");
+
+  // All rows pass the filter.
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("c0 >= 0")
+             .project({"c0 % 10 AS k", "c1"})
+             .partialAggregation({"k"}, {"sum(c1)"})
+             .finalAggregation()
+             .planNode();
+  assertQuery(plan, "SELECT c0 % 10, sum(c1) FROM tmp GROUP BY 1");
+}
+
 TEST_F(AggregationTest, partialAggregationMemoryLimit) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -919,6 +958,40 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationFlushBeforeTableGrowth) {
+  constexpr int64_t kMaxBytes = 256 << 10;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    // Keys spread too wide for kArray mode.
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return (i * 1'000 + row) * 1'000'003L; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .config(
+                      QueryConfig::kMaxPartialAggregationMemory,
+                      std::to_string(kMaxBytes))
+                  .config(
+                      QueryConfig::kMaxExtendedPartialAggregationMemory,
+                      std::to_string(kMaxBytes))
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .partialAggregation({"c0"}, {"count(1)"})
+                            .capturePlanNodeId(aggNodeId)
+                            .finalAggregation()
+                            .planNode())
+                  .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+  const auto runtimeStats =
+      toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+  EXPECT_LT(0, runtimeStats.at("flushRowCount").count);
+  // The table is flushed instead of growing past the limit.
+  EXPECT_GE(
+      kMaxBytes,
+      runtimeStats.at(BaseHashTable::kCapacity).max * sizeof(void*));
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -965,6 +1038,52 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationResample) {
+  // Unique keys are followed by keys that are clustered enough for the
+  // partial aggregation to pay off.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+        200, [i](auto row) { return 1'000 + i * 200 + row; })}));
+  }
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(200, [](auto row) { return row % 10; })}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto resampleRows : {0, 300}) {
+    SCOPED_TRACE(fmt::format("resampleRows {}", resampleRows));
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 100)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+            .config(
+                QueryConfig::kAbandonPartialAggregationResampleRows,
+                resampleRows)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+    const auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+    ASSERT_EQ(1, stats.customStats.count("abandonedPartialAggregation"));
+    ASSERT_EQ(
+        resampleRows > 0,
+        stats.customStats.count("resumedPartialAggregation") > 0);
+    // The resampled partial aggregation reduces the clustered keys.
+    if (resampleRows > 0) {
+      ASSERT_LT(stats.outputRows, 4 * 200 + 20 * 200);
+    } else {
+      ASSERT_EQ(stats.outputRows, 4 * 200 + 20 * 200);
+    }
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1176,6 +1295,38 @@ TEST_F(AggregationTest, spillAll) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, asyncOutputMemoryReservation) {
+  auto inputs = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(inputs);
+
+  auto arbitrationExecutor = std::make_unique<folly::CPUThreadPoolExecutor>(1);
+  memory::memoryManager()->testingSetArbitrationExecutor(
+      arbitrationExecutor.get());
+  SCOPE_EXIT {
+    memory::memoryManager()->testingSetArbitrationExecutor(nullptr);
+  };
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation({"c0"}, {"count(1)", "max(c1)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(tempDirectory->getPath())
+                  .config(QueryConfig::kSpillEnabled, true)
+                  .config(QueryConfig::kAggregationSpillEnabled, true)
+                  .assertResults(
+                      "SELECT c0, count(1), max(c1) FROM tmp GROUP BY 1");
+
+  // The output memory reservation has been made off the driver thread.
+  const auto runtimeStats =
+      toPlanStats(task->taskStats()).at(aggrNodeId).customStats;
+  ASSERT_EQ(runtimeStats.at("blockedWaitForMemoryTimes").sum, 1);
+  ASSERT_EQ(task->pool()->availableReservation(), 0);
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1329,6 +1480,110 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, rollUpGroupingSets) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b", "mask"},
+      {
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 11; }, nullEvery(13)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+          makeFlatVector<bool>(size, [](auto row) { return row % 3 == 0; }),
+      });
+  createDuckDbTable({data});
+
+  auto rollUp = [](const std::string& /*id*/, const core::PlanNodePtr& input) {
+    return rollUpGroupingSets(
+        std::dynamic_pointer_cast<const core::AggregationNode>(input));
+  };
+
+  core::PlanNodePtr rolledUp;
+  auto plan =
+      PlanBuilder()
+          .values({data})
+          .groupId(
+              {"k1", "k2"},
+              {{"k1", "k2"}, {"k1"}, {"k2"}, {}},
+              {"a", "b", "mask"})
+          .singleAggregation(
+              {"k1", "k2", "group_id"},
+              {"count(1) as count_1",
+               "sum(a) as sum_a",
+               "max(b) as max_b",
+               "avg(a) as avg_a"},
+              {"", "mask", "", "mask"})
+          .addNode(rollUp)
+          .capturePlanNode(rolledUp)
+          .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+          .planNode();
+  auto aggregation =
+      std::dynamic_pointer_cast<const core::AggregationNode>(rolledUp);
+  ASSERT_TRUE(aggregation->isFinal());
+  auto partial = std::dynamic_pointer_cast<const core::AggregationNode>(
+      rolledUp->sources()[0]->sources()[0]);
+  ASSERT_NE(partial, nullptr);
+  ASSERT_EQ(partial->step(), core::AggregationNode::Step::kPartial);
+  ASSERT_EQ(partial->groupingKeys().size(), 2);
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a) FILTER (WHERE mask), max(b), "
+      "avg(a) FILTER (WHERE mask) FROM tmp GROUP BY CUBE (k1, k2)");
+
+  // The same input column in two grouping keys.
+  plan = PlanBuilder()
+             .values({data})
+             .groupId(
+                 {"k1", "k1 as k3"}, {{"k1", "k3"}, {"k1"}, {"k3"}, {}}, {"b"})
+             .singleAggregation(
+                 {"k1", "k3", "group_id"}, {"max(b) as max_b"})
+             .addNode(rollUp)
+             .capturePlanNode(rolledUp)
+             .project({"k1", "k3", "max_b"})
+             .planNode();
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<const core::AggregationNode>(rolledUp)
+          ->isFinal());
+  assertQuery(
+      plan,
+      "SELECT k1, k3, max(b) FROM (SELECT k1, k1 AS k3, b FROM tmp) "
+      "GROUP BY GROUPING SETS ((k1, k3), (k1), (k3), ())");
+
+  // An aggregate over a grouping key is not rolled up since the key is null
+  // in some of the grouping sets.
+  plan = PlanBuilder()
+             .values({data})
+             .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a"})
+             .singleAggregation(
+                 {"k1", "k2", "group_id"}, {"count(k1) as count_k1"})
+             .addNode(rollUp)
+             .capturePlanNode(rolledUp)
+             .project({"k1", "k2", "count_k1"})
+             .planNode();
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<const core::AggregationNode>(rolledUp)
+          ->isSingle());
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(k1) FROM tmp GROUP BY GROUPING SETS ((k1), (k2))");
+
+  // Empty input produces the rows for the global grouping set.
+  plan = PlanBuilder()
+             .values({data})
+             .filter("a < 0")
+             .groupId({"k1"}, {{"k1"}, {}}, {"b"})
+             .singleAggregation({"k1", "group_id"}, {"count(b) as count_b"})
+             .addNode(rollUp)
+             .project({"count_b"})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT count(b) FROM tmp WHERE a < 0 GROUP BY GROUPING SETS ((k1), ())");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1861,6 +2116,148 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, rewriteDistinctAggregates) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  auto rewrite = [](const core::PlanNodePtr& plan) {
+    auto aggregation =
+        std::dynamic_pointer_cast<const core::AggregationNode>(plan);
+    VELOX_CHECK_NOT_NULL(aggregation);
+    return core::AggregationNode::rewriteDistinctAggregates(aggregation);
+  };
+
+  struct {
+    std::vector<std::string> keys;
+    std::vector<std::string> aggregates;
+    // Number of plan nodes added by the rewrite.
+    int32_t numNewNodes;
+  } testSettings[] = {
+      {{"c1"}, {"count(distinct c0)"}, 1},
+      {{"c1"}, {"count(distinct c0)", "max(distinct c0)"}, 1},
+      {{}, {"count(distinct c0)", "min(distinct c0)"}, 1},
+      {{"c1"}, {"count(distinct c1)"}, 1},
+      {{"c1"}, {"count(distinct c0)", "sum(distinct c2)"}, 2},
+      {{}, {"count(distinct c0)", "count(distinct c2)", "max(distinct c0)"}, 2},
+      {{"c1"}, {"count(distinct c0)", "sum(c2)"}, 0}};
+  for (const auto& testData : testSettings) {
+    const auto sql = fmt::format(
+        "SELECT {}{}{} FROM tmp{}{}",
+        folly::join(", ", testData.keys),
+        testData.keys.empty() ? "" : ", ",
+        folly::join(", ", testData.aggregates),
+        testData.keys.empty() ? "" : " GROUP BY ",
+        folly::join(", ", testData.keys));
+    SCOPED_TRACE(sql);
+
+    const auto original = PlanBuilder()
+                              .values(vectors)
+                              .singleAggregation(
+                                  testData.keys, testData.aggregates)
+                              .planNode();
+    const auto plan = rewrite(original);
+    ASSERT_EQ(plan->id(), original->id());
+    ASSERT_EQ(*plan->outputType(), *original->outputType());
+    auto numNodes = 0;
+    for (auto node = plan; node != original->sources()[0];
+         node = node->sources()[0]) {
+      ++numNodes;
+    }
+    ASSERT_EQ(numNodes - 1, testData.numNewNodes);
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .assertResults(sql);
+    if (testData.numNewNodes > 0) {
+      // The distinct values are spilled by the first aggregation.
+      ASSERT_GT(
+          toPlanStats(task->taskStats())
+              .at(original->id() + ".distinct")
+              .spilledBytes,
+          0);
+    }
+  }
+}
+
+TEST_F(AggregationTest, clusteredKeys) {
+  // Batches with long runs of the same keys, a batch with a null key in the
+  // middle of a run and a batch that is not clustered.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row / 100; }),
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) / 30 % 3; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  vectors.push_back(makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row / 200; }, nullEvery(333)),
+      makeFlatVector<int32_t>(1'000, [](auto /*row*/) { return 1; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  }));
+  vectors.push_back(makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 3; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  }));
+  createDuckDbTable(vectors);
+
+  for (const auto& keys :
+       std::vector<std::vector<std::string>>{{"c0"}, {"c0", "c1"}}) {
+    const auto keysSql = folly::join(", ", keys);
+    SCOPED_TRACE(keysSql);
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation(keys, {"count(1)", "sum(c2)"})
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT {}, count(1), sum(c2) FROM tmp GROUP BY {}",
+            keysSql,
+            keysSql));
+  }
+}
+
+TEST_F(AggregationTest, dictionaryKeys) {
+  // String keys in dictionaries with few entries, including a null entry and
+  // nulls added by the dictionary.
+  auto base = makeNullableFlatVector<std::string>(
+      {"apple", "banana", std::nullopt, "cherry", "a long string value"});
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    const vector_size_t size = 1'000;
+    vectors.push_back(makeRowVector({
+        BaseVector::wrapInDictionary(
+            i % 2 == 0 ? nullptr : makeNulls(size, nullEvery(17)),
+            makeIndices(size, [&](auto row) { return (row * 7 + i) % 5; }),
+            size,
+            base),
+        makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, {"count(1)", "sum(c1)"})
+                  .planNode();
+  assertQuery(plan, "SELECT c0, count(1), sum(c1) FROM tmp GROUP BY c0");
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .partialAggregation({"c0"}, {"count(1)", "sum(c1)"})
+             .finalAggregation()
+             .planNode();
+  assertQuery(plan, "SELECT c0, count(1), sum(c1) FROM tmp GROUP BY c0");
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
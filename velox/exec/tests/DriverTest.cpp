@@ -1055,6 +1055,93 @@ class BlockedNoFutureNodeFactory : public Operator::PlanNodeTranslator {
     return 1;
   }
 };
+
+// Reports being blocked with 'reason' and an already fulfilled future once
+// after each input.
+class ReadyFutureNode : public core::PlanNode {
+ public:
+  ReadyFutureNode(
+      const core::PlanNodeId& id,
+      BlockingReason reason,
+      const core::PlanNodePtr& input)
+      : PlanNode(id), reason_{reason}, sources_{input} {}
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<std::shared_ptr<const PlanNode>>& sources() const override {
+    return sources_;
+  }
+
+  std::string_view name() const override {
+    return "ReadyFuture";
+  }
+
+  BlockingReason reason() const {
+    return reason_;
+  }
+
+ private:
+  void addDetails(std::stringstream& /* stream */) const override {}
+
+  const BlockingReason reason_;
+  std::vector<core::PlanNodePtr> sources_;
+};
+
+class ReadyFutureOperator : public Operator {
+ public:
+  ReadyFutureOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const std::shared_ptr<const ReadyFutureNode>& node)
+      : Operator(ctx, node->outputType(), id, node->id(), "ReadyFuture"),
+        reason_{node->reason()} {}
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override {
+    input_ = std::move(input);
+    blocked_ = true;
+  }
+
+  RowVectorPtr getOutput() override {
+    return std::move(input_);
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (!blocked_) {
+      return BlockingReason::kNotBlocked;
+    }
+    blocked_ = false;
+    *future = folly::makeSemiFuture();
+    return reason_;
+  }
+
+ private:
+  const BlockingReason reason_;
+  bool blocked_{false};
+};
+
+class ReadyFutureNodeFactory : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto readyFutureNode =
+            std::dynamic_pointer_cast<const ReadyFutureNode>(node)) {
+      return std::make_unique<ReadyFutureOperator>(ctx, id, readyFutureNode);
+    }
+    return nullptr;
+  }
+};
 } // namespace
 
 // Use a node for which driver factory would throw on any driver beyond id 0.
@@ -1102,6 +1189,42 @@ TEST_F(DriverTest, blockedNoFuture) {
       "by isBlocked method.");
 }
 
+TEST_F(DriverTest, readyFutureRetriedOnThread) {
+  Operator::registerOperator(std::make_unique<ReadyFutureNodeFactory>());
+
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}));
+  }
+  // A ready future is waited for on thread, except for a yield, which must
+  // take the Driver off thread.
+  for (const auto reason :
+       {BlockingReason::kWaitForConsumer, BlockingReason::kYield}) {
+    SCOPED_TRACE(blockingReasonToString(reason));
+    core::PlanNodeId readyNodeId;
+    auto plan = PlanBuilder()
+                    .values(batches)
+                    .addNode([&](const core::PlanNodeId& id,
+                                 const core::PlanNodePtr& input) {
+                      return std::make_shared<ReadyFutureNode>(
+                          id, reason, input);
+                    })
+                    .capturePlanNodeId(readyNodeId)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan).assertResults(batches);
+
+    const auto stats = toPlanStats(task->taskStats());
+    const auto& runtimeStats = stats.at(readyNodeId).customStats;
+    const auto blockedTimes = fmt::format(
+        "blocked{}Times", blockingReasonToString(reason).substr(1));
+    if (reason == BlockingReason::kYield) {
+      ASSERT_EQ(runtimeStats.at(blockedTimes).sum, batches.size());
+    } else {
+      ASSERT_EQ(runtimeStats.count(blockedTimes), 0);
+    }
+  }
+}
+
 TEST_F(DriverTest, nonVeloxOperatorException) {
   Operator::registerOperator(
       std::make_unique<ThrowNodeFactory>(std::numeric_limits<uint32_t>::max()));
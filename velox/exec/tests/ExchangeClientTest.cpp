@@ -260,6 +260,56 @@ TEST_F(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, unevenSources) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = toSerializedPage(data);
+
+  // Set limit at 4.5 pages. The budget is shared by the sources in proportion
+  // to their buffered data.
+  auto client = std::make_shared<ExchangeClient>(
+      "uneven.sources", 17, page->size() * 4.5, pool(), executor());
+
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+  // Make 5 tasks, one with 10 pages and the rest with 1 page each.
+  std::vector<std::shared_ptr<Task>> tasks;
+  int32_t numPages = 0;
+  for (auto i = 0; i < 5; ++i) {
+    auto taskId = fmt::format("local://uneven{}", i);
+    auto task = makeTask(taskId, plan);
+
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+    const auto taskPages = i == 0 ? 10 : 1;
+    for (auto j = 0; j < taskPages; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    numPages += taskPages;
+
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  fetchPages(*client, numPages);
+
+  const auto stats = client->stats();
+  EXPECT_LE(stats.at("peakBytes").sum, page->size() * 5);
+  EXPECT_EQ(numPages, stats.at("numReceivedPages").sum);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
@@ -25,6 +25,7 @@ using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
 
 using facebook::velox::test::BatchMaker;
+using facebook::velox::test::SimpleVectorLoader;
 
 class FilterProjectTest : public OperatorTestBase {
  protected:
@@ -325,6 +326,43 @@ TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
   assertQuery(plan, "SELECT c0 < 10 AND c1 < 10, c1 FROM tmp");
 }
 
+TEST_F(FilterProjectTest, filterAndProjectIdentityOverLazy) {
+  // A lazy column that is both an identity projection and an input of a
+  // projection, but not of the filter, is loaded only for the rows that pass
+  // the filter.
+  vector_size_t size = 1'000;
+  auto valueAt = [](auto row) -> int32_t { return row; };
+  vector_size_t numLoadedRows = 0;
+  auto lazyVectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAt),
+      std::make_shared<LazyVector>(
+          pool(),
+          INTEGER(),
+          size,
+          std::make_unique<SimpleVectorLoader>([&](RowSet rows) {
+            numLoadedRows += rows.size();
+            return makeFlatVector<int32_t>(rows.back() + 1, valueAt);
+          })),
+  });
+
+  auto vectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAt),
+      makeFlatVector<int32_t>(size, valueAt),
+  });
+  createDuckDbTable({vectors});
+
+  auto plan = PlanBuilder()
+                  .values({lazyVectors})
+                  .filter("c0 % 10 = 0")
+                  .project({"c1", "if(c0 % 20 = 0, c1 + 1, 0)"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c1, CASE WHEN c0 % 20 = 0 THEN c1 + 1 ELSE 0 END FROM tmp "
+      "WHERE c0 % 10 = 0");
+  ASSERT_EQ(numLoadedRows, size / 10);
+}
+
 // Verify the optimization of avoiding copy in null propagation does not break
 // the case when the field is shared between multiple parents.
 TEST_F(FilterProjectTest, nestedFieldReferenceSharedChild) {
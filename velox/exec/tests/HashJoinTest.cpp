@@ -1074,6 +1074,50 @@ DEBUG_ONLY_TEST_P(MultiThreadedHashJoinTest, parallelJoinBuildCheck) {
   ASSERT_EQ(numDrivers_ == 1, !isParallelBuild);
 }
 
+DEBUG_ONLY_TEST_P(MultiThreadedHashJoinTest, earlyProbeInput) {
+  // Slows down the build so that the probe side runs ahead.
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::finishHashBuild",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }));
+  // With a 1 byte limit each probe operator buffers one batch and then waits
+  // for the build. Without a limit it buffers all its input.
+  for (const auto maxBytes : {0, 1, 1 << 30}) {
+    SCOPED_TRACE(fmt::format("maxBytes {}", maxBytes));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(1600, 5)
+        .buildVectors(1500, 5)
+        .referenceQuery(
+            "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t_k0 = u_k0")
+        .config(
+            core::QueryConfig::kHashProbeEarlyInputMaxBytes,
+            std::to_string(maxBytes))
+        .injectSpill(false)
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          int64_t numEarlyInputs = 0;
+          for (const auto& op :
+               task->taskStats().pipelineStats[0].operatorStats) {
+            if (op.operatorType == "HashProbe" &&
+                op.runtimeStats.count("earlyInputBatches") > 0) {
+              numEarlyInputs += op.runtimeStats.at("earlyInputBatches").sum;
+            }
+          }
+          if (maxBytes == 0) {
+            ASSERT_EQ(numEarlyInputs, 0);
+          } else if (maxBytes == 1) {
+            ASSERT_GT(numEarlyInputs, 0);
+            ASSERT_LE(numEarlyInputs, numDrivers_);
+          } else {
+            ASSERT_GT(numEarlyInputs, numDrivers_);
+          }
+        })
+        .run();
+  }
+}
+
 DEBUG_ONLY_TEST_P(
     MultiThreadedHashJoinTest,
     raceBetweenTaskTerminateAndTableBuild) {
@@ -5107,6 +5151,67 @@ TEST_F(HashJoinTest, dynamicFiltersAppliedToPreloadedSplits) {
       .run();
 }
 
+TEST_F(HashJoinTest, bloomDynamicFilter) {
+  const vector_size_t probeSize = 30'000;
+  const vector_size_t buildSize = 2 * VectorHasher::kMaxDistinct;
+  std::vector<RowVectorPtr> probeVectors{makeRowVector(
+      {"p0"},
+      {makeFlatVector<int64_t>(probeSize, [](auto row) { return row; })})};
+  auto tempFile = TempFilePath::create();
+  writeToFile(tempFile->getPath(), probeVectors);
+  createDuckDbTable("p", probeVectors);
+
+  // The build side has too many distinct keys for a value set filter.
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"b0"},
+      {makeFlatVector<int64_t>(buildSize, [](auto row) { return row * 3; })})};
+  createDuckDbTable("b", buildVectors);
+
+  for (const uint64_t maxBloomFilterSize : {0, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("maxBloomFilterSize: {}", maxBloomFilterSize));
+    core::PlanNodeId probeScanId;
+    core::PlanNodeId joinNodeId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto op = PlanBuilder(planNodeIdGenerator)
+                  .tableScan(asRowType(probeVectors[0]->type()))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"p0"},
+                      {"b0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"p0"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(op))
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            std::to_string(maxBloomFilterSize))
+        .injectSpill(false)
+        .inputSplits(
+            {{probeScanId,
+              {exec::Split(makeHiveConnectorSplit(tempFile->getPath()))}}})
+        .referenceQuery("SELECT p.p0 FROM p, b WHERE b.b0 = p.p0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          if (maxBloomFilterSize == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), probeSize);
+            return;
+          }
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // The join must still run as the bloom filter has false positives.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          ASSERT_LT(getInputPositions(task, 1), probeSize / 2);
+        })
+        .run();
+  }
+}
+
 // Verify the size of the join output vectors when projecting build-side
 // variable-width column.
 TEST_F(HashJoinTest, memoryUsage) {
@@ -5246,6 +5351,48 @@ TEST_F(HashJoinTest, spillFileSize) {
   }
 }
 
+TEST_F(HashJoinTest, hybridSpill) {
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .keyTypes({BIGINT()})
+      .probeVectors(100, 3)
+      .buildVectors(100, 3)
+      .referenceQuery(
+          "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0")
+      .config(core::QueryConfig::kSpillStartPartitionBit, "48")
+      .config(core::QueryConfig::kSpillNumPartitionBits, "3")
+      .config(core::QueryConfig::kHybridJoinSpillEnabled, "true")
+      .checkSpillStats(false)
+      .maxSpillLevel(0)
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (!hasSpill) {
+          return;
+        }
+        const auto statsPair = taskSpilledStats(*task);
+        if (statsPair.first.spilledRows == 0) {
+          return;
+        }
+        uint64_t numRestoredPartitions{0};
+        for (auto& pipeline : task->taskStats().pipelineStats) {
+          for (auto& op : pipeline.operatorStats) {
+            if (op.operatorType != "HashBuild") {
+              continue;
+            }
+            auto it =
+                op.runtimeStats.find(HashBuild::kHybridSpillRestoredPartitions);
+            if (it != op.runtimeStats.end()) {
+              numRestoredPartitions += it->second.sum;
+            }
+          }
+        }
+        // The test memory pool has no capacity limit so all the spilled
+        // partitions are loaded back into the join table.
+        ASSERT_GT(numRestoredPartitions, 0);
+        ASSERT_LE(numRestoredPartitions, statsPair.first.spilledPartitions);
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, spillPartitionBitsOverlap) {
   auto builder =
       HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
@@ -6409,6 +6556,102 @@ TEST_F(HashJoinTest, leftJoinWithMissAtEndOfBatch) {
   test("t_k2 > 9");
 }
 
+TEST_F(HashJoinTest, sharedBuildRows) {
+  // Many to many join where each output batch repeats the same few build
+  // rows.
+  auto probeVectors = std::vector<RowVectorPtr>{makeRowVector(
+      {"t_k1", "t_v1"},
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 4; }),
+       makeFlatVector<int32_t>(1'000, [](auto row) { return row; })})};
+  auto buildVectors = std::vector<RowVectorPtr>{makeRowVector(
+      {"u_k1", "u_v1"},
+      {makeFlatVector<int32_t>(40, [](auto row) { return row % 4; }),
+       makeFlatVector<int64_t>(
+           40, [](auto row) { return row; }, nullEvery(7))})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"t_k1"},
+                        {"u_k1"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        {"t_v1", "u_k1", "u_v1"},
+                        joinType)
+                    .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .injectSpill(false)
+        .numDrivers(1)
+        .referenceQuery(fmt::format(
+            "SELECT t_v1, u_k1, u_v1 FROM t {} JOIN u ON t_k1 = u_k1",
+            joinType == core::JoinType::kLeft ? "LEFT" : "INNER"))
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          auto joinStats = task->taskStats()
+                               .pipelineStats.back()
+                               .operatorStats.back()
+                               .runtimeStats;
+          ASSERT_LT(0, joinStats["sharedBuildRows"].sum);
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, wideRowsOutputBatchSize) {
+  constexpr vector_size_t kNumRows = 1'000;
+  constexpr int32_t kNumBatches = 5;
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k1"},
+        {makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; })}));
+  }
+  auto buildVectors = std::vector<RowVectorPtr>{makeRowVector(
+      {"u_k1", "u_v1"},
+      {makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; }),
+       makeFlatVector<std::string>(kNumRows, [](auto row) {
+         return std::string(1'000, 'a' + row % 26);
+       })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values(probeVectors)
+          .hashJoin(
+              {"t_k1"},
+              {"u_k1"},
+              PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode(),
+              "",
+              {"t_k1", "u_v1"})
+          .planNode();
+
+  // About 100 of the 1KB rows fit in 100KB. The first batch has the full
+  // input before the row size is known.
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(plan)
+      .injectSpill(false)
+      .numDrivers(1)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "100000")
+      .referenceQuery("SELECT t_k1, u_v1 FROM t, u WHERE t_k1 = u_k1")
+      .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+        const auto& probeStats =
+            task->taskStats().pipelineStats.back().operatorStats.back();
+        ASSERT_EQ(probeStats.outputPositions, kNumRows * kNumBatches);
+        ASSERT_GE(probeStats.outputVectors, 1 + (kNumBatches * kNumRows) / 150);
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, leftJoinWithMissAtEndOfBatchMultipleBuildMatches) {
   // Tests some cases where the row at the end of an output batch fails the
   // filter and there are multiple matches with the build side..
@@ -137,6 +137,12 @@ class HashTableTest : public testing::TestWithParam<bool>,
       }
       auto table = HashTable<true>::createForJoin(
           std::move(keyHashers), dependentTypes, true, false, 1'000, pool());
+      if (compactJoinTable_) {
+        table->enableCompactJoinTable();
+      }
+      if (radixPartitionBytes_ > 0) {
+        table->setRadixPartitionedProbe(1'000, radixPartitionBytes_);
+      }
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -160,6 +166,16 @@ class HashTableTest : public testing::TestWithParam<bool>,
         estimatedTableSize,
         topTable_->rows()->pool()->currentBytes() - usedMemoryBytes);
     ASSERT_EQ(topTable_->hashMode(), mode);
+    ASSERT_EQ(
+        topTable_->hasCompactJoinTable(),
+        compactJoinTable_ && mode == BaseHashTable::HashMode::kNormalizedKey);
+    if (topTable_->hasCompactJoinTable()) {
+      // The compact table is counted on top of the tags and the rows.
+      ASSERT_GT(
+          topTable_->allocatedBytes(),
+          sizeof(char*) * topTable_->capacity() +
+              topTable_->rows()->allocatedBytes());
+    }
     ASSERT_EQ(topTable_->allRows().size(), numWays);
     uint64_t rowCount{0};
     for (auto* rowContainer : topTable_->allRows()) {
@@ -573,6 +589,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // If true, the join table is made with a compact table for the probes.
+  bool compactJoinTable_{false};
+  // If > 0, join probes are radix partitioned by regions of this size.
+  uint64_t radixPartitionBytes_{0};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -610,6 +630,39 @@ TEST_P(HashTableTest, int2SparseNormalizedMostMiss) {
   testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
 }
 
+TEST_P(HashTableTest, compactJoinTable) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  compactJoinTable_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 10000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, compactJoinTableMostMiss) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 10;
+  compactJoinTable_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  radixPartitionBytes_ = 4 << 10;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 10000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedProbeHashMode) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  radixPartitionBytes_ = 4 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 10000, 2, type, 6);
+}
+
 TEST_P(HashTableTest, structKey) {
   auto type =
       ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
@@ -807,6 +860,37 @@ TEST_P(HashTableTest, groupBySpill) {
   testGroupBySpill(5'000'000, type, 1, 1000, 1000);
 }
 
+TEST_P(HashTableTest, parallelGroupByBuild) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  auto table = createHashTableForAggregation(type, 2);
+  if (executor_ != nullptr) {
+    table->setParallelGroupByBuild(executor_.get(), 4);
+  }
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  constexpr int32_t kBatchSize = 1'000;
+  constexpr int32_t kNumBatches = 1'000;
+  std::vector<RowVectorPtr> batches;
+  makeRows(kBatchSize, kNumBatches, 0, type, batches);
+  std::vector<char*> allInserted;
+  for (const auto& batch : batches) {
+    insertGroups(*batch, *lookup, *table);
+    allInserted.insert(
+        allInserted.end(), lookup->hits.begin(), lookup->hits.end());
+  }
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+  ASSERT_GT(table->stats().numRehashes, 0);
+
+  // All the groups are found after the rehashes.
+  for (auto i = 0; i < batches.size(); ++i) {
+    insertGroups(*batches[i], *lookup, *table);
+    for (auto row = 0; row < kBatchSize; ++row) {
+      ASSERT_EQ(lookup->hits[row], allInserted[i * kBatchSize + row]);
+    }
+  }
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+  table->checkConsistency();
+}
+
 TEST_P(HashTableTest, checkSizeValidation) {
   auto rowType = ROW({"a"}, {BIGINT()});
   auto table = createHashTableForAggregation(rowType, 1);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -540,6 +541,101 @@ TEST_F(MergeJoinTest, nullKeys) {
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
 }
 
+TEST_F(MergeJoinTest, bandJoin) {
+  // Both sides are sorted on (key, ts) and come in several batches so that
+  // the window of right rows spans batches. The first row of each side has a
+  // null key. The left rows with a ts past the end of the right group have no
+  // match.
+  auto makeBatches = [&](const std::vector<std::string>& names,
+                         int32_t numRows,
+                         int32_t batchSize,
+                         int32_t groupSize,
+                         int32_t step) {
+    std::vector<RowVectorPtr> batches;
+    for (auto start = 0; start < numRows; start += batchSize) {
+      batches.push_back(makeRowVector(
+          names,
+          {makeFlatVector<int32_t>(
+               batchSize,
+               [&](auto row) { return (start + row) / groupSize; },
+               [&](auto row) { return start + row == 0; }),
+           makeFlatVector<int64_t>(
+               batchSize,
+               [&](auto row) { return ((start + row) % groupSize) * step; }),
+           makeFlatVector<int32_t>(
+               batchSize, [&](auto row) { return start + row; })}));
+    }
+    return batches;
+  };
+  auto left = makeBatches({"t_k", "t_ts", "t_data"}, 2'000, 100, 400, 3);
+  auto right = makeBatches({"u_k", "u_ts", "u_data"}, 3'000, 70, 500, 2);
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto makePlan = [&](const std::vector<std::string>& leftKeys,
+                      const std::vector<std::string>& rightKeys,
+                      core::JoinType joinType) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values(left)
+        .mergeJoin(
+            leftKeys,
+            rightKeys,
+            PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+            "",
+            {"t_k", "t_ts", "t_data", "u_k", "u_ts", "u_data"},
+            joinType,
+            core::MergeJoinNode::Band{-5, 7})
+        .planNode();
+  };
+
+  for (auto batchSize : {1, 17, 1'024}) {
+    SCOPED_TRACE(fmt::format("batchSize: {}", batchSize));
+    AssertQueryBuilder(
+        makePlan({"t_k", "t_ts"}, {"u_k", "u_ts"}, core::JoinType::kInner),
+        duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kPreferredOutputBatchRows,
+            std::to_string(batchSize))
+        .assertResults(
+            "SELECT * FROM t, u WHERE t_k = u_k "
+            "AND t_ts BETWEEN u_ts - 5 AND u_ts + 7");
+
+    AssertQueryBuilder(
+        makePlan({"t_k", "t_ts"}, {"u_k", "u_ts"}, core::JoinType::kLeft),
+        duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kPreferredOutputBatchRows,
+            std::to_string(batchSize))
+        .assertResults(
+            "SELECT * FROM t LEFT JOIN u ON t_k = u_k "
+            "AND t_ts BETWEEN u_ts - 5 AND u_ts + 7");
+  }
+
+  // The band key alone. Only the first group of each side is sorted on it.
+  left.resize(4);
+  right.resize(7);
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+  AssertQueryBuilder(
+      makePlan({"t_ts"}, {"u_ts"}, core::JoinType::kInner), duckDbQueryRunner_)
+      .assertResults(
+          "SELECT * FROM t, u WHERE t_ts BETWEEN u_ts - 5 AND u_ts + 7");
+
+  VELOX_ASSERT_THROW(
+      PlanBuilder(planNodeIdGenerator)
+          .values(left)
+          .mergeJoin(
+              {"t_ts"},
+              {"u_ts"},
+              PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+              "",
+              {"t_ts", "u_ts"},
+              core::JoinType::kInner,
+              core::MergeJoinNode::Band{1, 0}),
+      "Merge join band is empty");
+}
+
 TEST_F(MergeJoinTest, complexTypedFilter) {
   constexpr vector_size_t size{1000};
 
@@ -152,6 +152,57 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+/// Merges on normalized keys of each type, with strings that are equal in
+/// their normalized prefix and differ after it.
+TEST_F(MergeTest, normalizedKeys) {
+  vector_size_t batchSize = 500;
+  const std::string longPrefix(40, 'x');
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<int32_t>(
+        batchSize, [](auto row) { return row % 7 - 3; }, nullEvery(9));
+    auto c1 = makeFlatVector<std::string>(
+        batchSize,
+        [&](auto row) { return longPrefix + std::to_string(row % 13); },
+        nullEvery(7));
+    auto c2 = makeFlatVector<float>(
+        batchSize, [](auto row) { return (row % 11) * -0.5; }, nullEvery(5));
+    auto c3 = makeFlatVector<std::string>(
+        batchSize, [](auto row) { return std::string(row % 5, 'y'); });
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c1");
+  testSingleKey(vectors, "c2");
+  testSingleKey(vectors, "c3");
+
+  testTwoKeys(vectors, "c0", "c1");
+  testTwoKeys(vectors, "c1", "c0");
+  testTwoKeys(vectors, "c2", "c3");
+}
+
+/// Merges on a string key that is truncated in the normalized keys, followed
+/// by a key in the reverse order of the strings. The bytes of the second key
+/// must not decide the order of strings that differ after their prefix.
+TEST_F(MergeTest, truncatedStringKey) {
+  vector_size_t batchSize = 300;
+  const std::string longPrefix(40, 'x');
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            batchSize,
+            [&](auto row) { return longPrefix + std::to_string(row % 10); }),
+        makeFlatVector<int64_t>(
+            batchSize, [](auto row) { return -(row % 10); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  testTwoKeys(vectors, "c0", "c1");
+}
+
 /// Verifies an edge case where output batch fills up when one of the sources
 /// has only one row left.
 TEST_F(MergeTest, offByOne) {
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
@@ -421,3 +423,132 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, lessThanCondition) {
+  // A condition like t0 < u0 on integers is evaluated with SIMD compares
+  // without making the cross product, unless a column has nulls or is not
+  // flat. Many small build batches are merged into larger ones.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 10; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int32_t>(
+             97, [i](auto row) { return (row * 7 + i) % 101; }),
+         makeFlatVector<int64_t>(97, [](auto row) { return row; })}));
+  }
+  probeVectors.push_back(makeRowVector(
+      {"t0", "t1"},
+      {makeNullableFlatVector<int32_t>({1, std::nullopt, 50, 100}),
+       makeFlatVector<int64_t>({1, 2, 3, 4})}));
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 50; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int32_t>(3, [i](auto row) { return i * 2 + row; }),
+         makeFlatVector<int64_t>(3, [i](auto row) { return i; })}));
+  }
+
+  setProbeType(asRowType(probeVectors[0]->type()));
+  setBuildType(asRowType(buildVectors[0]->type()));
+  setComparisons({"<"});
+  setOutputLayout({"t0", "t1", "u0", "u1"});
+  setQueryStr("SELECT t0, t1, u0, u1 FROM t {0} JOIN u ON t.t0 {1} u.u0");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  setJoinConditionStr("u0 {} t0");
+  setQueryStr("SELECT t0, t1, u0, u1 FROM t {0} JOIN u ON u.u0 {1} t.t0");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
+TEST_F(NestedLoopJoinTest, intervalCondition) {
+  // t0 BETWEEN u0 AND u1 is matched with an index of the build intervals.
+  // Most intervals are disjoint. Some overlap, contain others, are empty or
+  // have a null bound.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             200,
+             [i](auto row) { return (row * 13 + i * 7) % 1'100; },
+             nullEvery(37)),
+         makeFlatVector<int32_t>(200, [](auto row) { return row; })}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 4; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1", "u2"},
+        {makeFlatVector<int64_t>(
+             25,
+             [i](auto row) { return (i * 25 + row) * 10; },
+             nullEvery(11)),
+         makeFlatVector<int64_t>(
+             25,
+             [i](auto row) {
+               const auto low = (i * 25 + row) * 10;
+               if (row % 5 == 0) {
+                 return low + 35;
+               }
+               return row % 7 == 0 ? low - 1 : low + 9;
+             },
+             nullEvery(13)),
+         makeFlatVector<int32_t>(
+             25, [i](auto row) { return i * 25 + row; })}));
+  }
+
+  setProbeType(asRowType(probeVectors[0]->type()));
+  setBuildType(asRowType(buildVectors[0]->type()));
+  setComparisons({"BETWEEN"});
+  setJoinConditionStr("t0 {} u0 AND u1");
+  setOutputLayout({"t0", "t1", "u0", "u1", "u2"});
+  setQueryStr(
+      "SELECT t0, t1, u0, u1, u2 FROM t {0} JOIN u ON t.t0 {1} u.u0 AND u.u1");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
+TEST_F(NestedLoopJoinTest, intervalConditionOutputBatchSize) {
+  // Nested intervals [-i, i]. A probe value v is in 100 - |v| of them, so the
+  // matches of a single probe row span several output batches.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0"},
+        {makeFlatVector<int64_t>(50, [](auto row) { return row - 25; })}));
+  }
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return -row; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row; })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  constexpr int32_t kOutputBatchRows = 7;
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "t0 BETWEEN u0 AND u1",
+                        {"t0", "u0", "u1"},
+                        joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(kOutputBatchRows))
+                    .assertResults(fmt::format(
+                        "SELECT t0, u0, u1 FROM t {} JOIN u "
+                        "ON t.t0 BETWEEN u.u0 AND u.u1",
+                        joinTypeName(joinType)));
+
+    // Each output batch has at most 'kOutputBatchRows' rows.
+    const auto stats = toPlanStats(task->taskStats()).at(joinNodeId);
+    ASSERT_GE(stats.outputVectors * kOutputBatchRows, stats.outputRows);
+  }
+}
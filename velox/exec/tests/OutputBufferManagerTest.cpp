@@ -15,11 +15,13 @@
  */
 #include "velox/exec/OutputBufferManager.h"
 #include <gtest/gtest.h>
+#include <filesystem>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -1144,6 +1146,79 @@ TEST_F(OutputBufferManagerTest, broadcastWithDynamicAddedDestination) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, broadcastSpill) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  const auto pageBytes = makeSerializedPage(rowType_, size)->size();
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  bufferManager_->removeTask(taskId);
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(),
+      core::QueryConfig({
+          {core::QueryConfig::kMaxOutputBufferSize,
+           std::to_string(pageBytes * 3)},
+          {core::QueryConfig::kSpillEnabled, "true"},
+          {core::QueryConfig::kBroadcastOutputBufferSpillEnabled, "true"},
+      }));
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kParallel);
+  task->setSpillDirectory(spillDirectory->getPath());
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kBroadcast, 1, 1);
+
+  // Destination 0 consumes all pages as they come. The pages kept for the
+  // destinations to come are spilled instead of blocking the producer.
+  const int numPages = 10;
+  std::vector<std::unique_ptr<folly::IOBuf>> expectedPages;
+  for (int i = 0; i < numPages; ++i) {
+    auto page = makeSerializedPage(rowType_, size);
+    expectedPages.push_back(page->getIOBuf());
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+    fetchOneAndAck(taskId, 0, i);
+  }
+  ASSERT_LT(getStats(taskId).bufferedPages, numPages);
+  ASSERT_TRUE(std::filesystem::exists(
+      spillDirectory->getPath() + "/broadcast_output_buffer"));
+
+  // A late destination replays all pages, including the spilled ones.
+  std::vector<std::unique_ptr<folly::IOBuf>> pages;
+  ASSERT_TRUE(bufferManager_->getData(
+      taskId,
+      1,
+      std::numeric_limits<uint64_t>::max(),
+      0,
+      [&](std::vector<std::unique_ptr<folly::IOBuf>> result,
+          int64_t /*sequence*/,
+          std::vector<int64_t> /*remainingBytes*/) {
+        pages = std::move(result);
+      }));
+  ASSERT_EQ(pages.size(), numPages);
+  for (int i = 0; i < numPages; ++i) {
+    ASSERT_TRUE(folly::IOBufEqualTo{}(pages[i], expectedPages[i]));
+  }
+  acknowledge(taskId, 1, numPages);
+
+  bufferManager_->updateOutputBuffers(taskId, 2, true);
+  ASSERT_EQ(getStats(taskId).bufferedPages, 0);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, numPages);
+  fetchEndMarker(taskId, 1, numPages);
+  ASSERT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, arbitraryWithDynamicAddedDestination) {
   const vector_size_t size = 100;
   int numDestinations = 5;
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/PartitionedOutput.h"
 #include <gtest/gtest.h>
+#include <numeric>
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -141,4 +143,265 @@ TEST_F(PartitionedOutputTest, flush) {
   EXPECT_EQ(partition1.size(), 2);
 }
 
+TEST_F(PartitionedOutputTest, preserveEncodings) {
+  auto dictionary = makeFlatVector<std::string>(
+      {std::string(100, 'a'), std::string(100, 'b'), std::string(100, 'c')});
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 3; ++i) {
+    inputs.push_back(makeRowVector(
+        {"c0", "c1"},
+        {BaseVector::wrapInDictionary(
+             nullptr,
+             makeIndices(1'000, [i](auto row) { return (row + i) % 3; }),
+             1'000,
+             dictionary),
+         makeConstant<int64_t>(i, 1'000)}));
+  }
+  const auto rowType = asRowType(inputs[0]->type());
+
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .partitionedOutput({}, 1)
+                  .planNode();
+  for (bool preserveEncodings : {false, true}) {
+    SCOPED_TRACE(fmt::format("preserveEncodings: {}", preserveEncodings));
+    const auto taskId = fmt::format(
+        "local://test-partitioned-output-preserve-encodings-{}",
+        preserveEncodings);
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kExchangePreserveEncodings,
+              preserveEncodings ? "true" : "false"}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    auto pages = getAllData(taskId, 0);
+    ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+    // With encodings preserved, each input vector is sent as a separate page.
+    ASSERT_EQ(pages.size(), preserveEncodings ? inputs.size() : 1);
+    std::vector<RowVectorPtr> results;
+    for (auto& page : pages) {
+      SerializedPage serializedPage(std::move(page));
+      auto input = serializedPage.prepareStreamForDeserialize();
+      RowVectorPtr result;
+      getVectorSerde()->deserialize(
+          &input, pool(), rowType, &result, 0, nullptr);
+      const auto expectedEncoding = preserveEncodings
+          ? VectorEncoding::Simple::DICTIONARY
+          : VectorEncoding::Simple::FLAT;
+      ASSERT_EQ(result->childAt(0)->encoding(), expectedEncoding);
+      results.push_back(result);
+    }
+    if (preserveEncodings) {
+      ASSERT_EQ(
+          results[0]->childAt(1)->encoding(),
+          VectorEncoding::Simple::CONSTANT);
+    }
+    assertEqualResults(inputs, results);
+  }
+}
+
+TEST_F(PartitionedOutputTest, compressionSelector) {
+  using detail::CompressionSelector;
+  constexpr auto kLz4 = common::CompressionKind_LZ4;
+  constexpr auto kNone = common::CompressionKind_NONE;
+
+  // Without a codec pages are never compressed.
+  CompressionSelector noCodec(kNone, 10);
+  EXPECT_EQ(noCodec.nextKind(100), kNone);
+
+  // Compression costs 100ns per saved byte on top of the 1ns per byte of an
+  // uncompressed flush.
+  CompressionSelector expensive(kLz4, 10);
+  EXPECT_EQ(expensive.nextKind(0), kLz4);
+  EXPECT_FALSE(expensive.nanosPerSavedByte().has_value());
+  expensive.recordFlush(kNone, 0, 1'000, 1'000);
+  expensive.recordFlush(kLz4, 1'000, 500, 51'000);
+  EXPECT_DOUBLE_EQ(expensive.nanosPerSavedByte().value(), 100);
+  for (auto i = 1; i < CompressionSelector::kSampleInterval; ++i) {
+    EXPECT_EQ(expensive.nextKind(0), kNone);
+  }
+  EXPECT_EQ(expensive.nextKind(0), kLz4);
+  EXPECT_EQ(expensive.nextKind(0), kNone);
+  // Backpressure makes compression worthwhile.
+  EXPECT_EQ(expensive.nextKind(CompressionSelector::kBackpressuredPages), kLz4);
+
+  CompressionSelector cheap(kLz4, 10);
+  cheap.recordFlush(kLz4, 1'000, 500, 2'000);
+  EXPECT_DOUBLE_EQ(cheap.nanosPerSavedByte().value(), 4);
+  EXPECT_EQ(cheap.nextKind(0), kLz4);
+
+  // Incompressible pages are sent uncompressed even with backpressure.
+  CompressionSelector incompressible(kLz4, 10);
+  incompressible.recordFlush(kLz4, 1'000, 1'010, 2'000);
+  EXPECT_EQ(incompressible.nextKind(100), kNone);
+}
+
+TEST_F(PartitionedOutputTest, adaptiveCompression) {
+  auto bufferManager = OutputBufferManager::getInstance().lock();
+  bufferManager->testingSetCompression(common::CompressionKind_LZ4);
+  auto guard = folly::makeGuard([&]() {
+    bufferManager->testingSetCompression(common::CompressionKind_NONE);
+  });
+
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 20; ++i) {
+    inputs.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+         makeFlatVector<std::string>(1'000, [](auto row) {
+           return std::string(50, 'a' + row % 3);
+         })}));
+  }
+  const auto rowType = asRowType(inputs[0]->type());
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .partitionedOutput({}, 1)
+                  .planNode();
+
+  // A zero cost limit sends unloaded destinations mostly uncompressed.
+  const auto taskId = "local://test-partitioned-output-adaptive-compression";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext(
+          {{core::QueryConfig::kExchangeAdaptiveCompression, "true"},
+           {core::QueryConfig::kExchangeAdaptiveCompressionMaxNanosPerByte,
+            "0"}}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  auto pages = getAllData(taskId, 0);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_FALSE(pages.empty());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionKind = common::CompressionKind_LZ4;
+  std::vector<RowVectorPtr> results;
+  for (auto& page : pages) {
+    SerializedPage serializedPage(std::move(page));
+    auto input = serializedPage.prepareStreamForDeserialize();
+    RowVectorPtr result;
+    getVectorSerde()->deserialize(
+        &input, pool(), rowType, &result, 0, &options);
+    results.push_back(result);
+  }
+  assertEqualResults(inputs, results);
+}
+
+TEST_F(PartitionedOutputTest, hotKeyTracker) {
+  using detail::HotKeyTracker;
+  HotKeyTracker tracker(4);
+  // Key 7 has half of the rows, the other keys are unique.
+  std::vector<uint64_t> hashes(HotKeyTracker::kMinRows);
+  for (auto i = 0; i < hashes.size(); ++i) {
+    hashes[i] = i % 2 == 0 ? 7 : 100 + i;
+  }
+  tracker.add(hashes.data(), hashes.size() / 2);
+  // Too few rows to decide.
+  ASSERT_FALSE(tracker.hasHotKeys());
+
+  tracker.add(hashes.data() + hashes.size() / 2, hashes.size() / 2);
+  ASSERT_EQ(tracker.numRows(), HotKeyTracker::kMinRows);
+  ASSERT_TRUE(tracker.hasHotKeys());
+  ASSERT_TRUE(tracker.isHot(7));
+  ASSERT_FALSE(tracker.isHot(101));
+}
+
+TEST_F(PartitionedOutputTest, skewHandling) {
+  using SkewHandling = core::PartitionedOutputNode::SkewHandling;
+  constexpr int kNumPartitions = 4;
+  constexpr int kFanout = 3;
+  // Half of the rows have key 0.
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 10; ++i) {
+    inputs.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(
+             2'000, [](auto row) { return row % 2 == 0 ? 0 : row; }),
+         makeFlatVector<int64_t>(2'000, [i](auto row) { return row + i; })}));
+  }
+  const auto rowType = asRowType(inputs[0]->type());
+  const vector_size_t numInputRows = 10 * 2'000;
+
+  for (auto skewHandling :
+       {SkewHandling::kNone, SkewHandling::kSpread, SkewHandling::kReplicate}) {
+    const auto skewName =
+        core::PartitionedOutputNode::skewHandlingString(skewHandling);
+    SCOPED_TRACE(skewName);
+    PlanBuilder builder;
+    builder.values(inputs);
+    if (skewHandling == SkewHandling::kNone) {
+      builder.partitionedOutput({"c0"}, kNumPartitions);
+    } else {
+      builder.partitionedOutputWithSkew(
+          {"c0"}, kNumPartitions, skewHandling, kFanout);
+    }
+    const auto taskId =
+        fmt::format("local://test-partitioned-output-skew-{}", skewName);
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{builder.planNode()},
+        0,
+        createQueryContext({}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    std::vector<vector_size_t> numRows(kNumPartitions);
+    vector_size_t numKeyRows = 0;
+    std::vector<int32_t> keyPartitions;
+    for (auto partition = 0; partition < kNumPartitions; ++partition) {
+      for (auto& page : getAllData(taskId, partition)) {
+        SerializedPage serializedPage(std::move(page));
+        auto input = serializedPage.prepareStreamForDeserialize();
+        RowVectorPtr result;
+        getVectorSerde()->deserialize(
+            &input, pool(), rowType, &result, 0, nullptr);
+        numRows[partition] += result->size();
+        auto keys = result->childAt(0)->asFlatVector<int64_t>();
+        for (auto i = 0; i < result->size(); ++i) {
+          if (keys->valueAt(i) == 0) {
+            ++numKeyRows;
+            if (keyPartitions.empty() || keyPartitions.back() != partition) {
+              keyPartitions.push_back(partition);
+            }
+          }
+        }
+      }
+    }
+    ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+    const auto totalRows =
+        std::accumulate(numRows.begin(), numRows.end(), vector_size_t{0});
+    switch (skewHandling) {
+      case SkewHandling::kNone:
+        ASSERT_EQ(totalRows, numInputRows);
+        ASSERT_EQ(numKeyRows, numInputRows / 2);
+        ASSERT_EQ(keyPartitions.size(), 1);
+        break;
+      case SkewHandling::kSpread:
+        // The hot key is spread once enough rows were seen to find it.
+        ASSERT_EQ(totalRows, numInputRows);
+        ASSERT_EQ(numKeyRows, numInputRows / 2);
+        ASSERT_EQ(keyPartitions.size(), kFanout);
+        ASSERT_GT(
+            toPlanStats(task->taskStats())
+                .at("1")
+                .customStats.at("numSkewSpreadRows")
+                .sum,
+            0);
+        break;
+      case SkewHandling::kReplicate:
+        ASSERT_EQ(totalRows, numInputRows * kFanout);
+        ASSERT_EQ(numKeyRows, numInputRows / 2 * kFanout);
+        ASSERT_EQ(keyPartitions.size(), kFanout);
+        break;
+    }
+  }
+}
+
 } // namespace facebook::velox::exec::test
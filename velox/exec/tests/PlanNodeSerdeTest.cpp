@@ -300,6 +300,20 @@ TEST_F(PlanNodeSerdeTest, mergeJoin) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({probe})
+             .mergeJoin(
+                 {"t0", "t1"},
+                 {"u0", "u1"},
+                 PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+                 "",
+                 {"t0", "t1", "u2", "t2"},
+                 core::JoinType::kInner,
+                 core::MergeJoinNode::Band{-10, 5})
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, orderBy) {
@@ -331,6 +345,16 @@ TEST_F(PlanNodeSerdeTest, partitionedOutput) {
              .partitionedOutput({"c0"}, 50, {"c1", {"c2"}, "c0"})
              .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .partitionedOutputWithSkew(
+                 {"c0"},
+                 50,
+                 core::PartitionedOutputNode::SkewHandling::kSpread,
+                 4)
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, project) {
@@ -41,7 +41,11 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t maxStringPrefixLength =
+          PrefixSortConfig::kDefaultMaxStringPrefixLength,
+      uint32_t radixSortThreshold =
+          PrefixSortConfig::kDefaultRadixSortThreshold) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -67,7 +71,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         compareFlags,
         {1024,
          // Set threshold to 0 to enable prefix-sort in small dataset.
-         0});
+         0,
+         maxStringPrefixLength,
+         radixSortThreshold});
 
     // Extract data from the RowContainer in order.
     const RowVectorPtr actual =
@@ -240,6 +246,92 @@ TEST_F(PrefixSortTest, fuzz) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings that tie in short prefixes, followed by a timestamp.
+  const auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"abcdefgh_2",
+           "abcdefgh_1",
+           std::nullopt,
+           "abcdefgh_1",
+           "abc",
+           "",
+           "abcdefgh",
+           "abcdefgh_2",
+           std::nullopt,
+           "abcdefgh"}),
+      makeNullableFlatVector<Timestamp>(
+          {Timestamp(1, 0),
+           Timestamp(2, 0),
+           Timestamp(3, 0),
+           Timestamp(1, 0),
+           std::nullopt,
+           Timestamp(5, 0),
+           Timestamp(2, 0),
+           Timestamp(0, 0),
+           Timestamp(1, 0),
+           Timestamp(1, 1)}),
+  });
+  for (const auto maxStringPrefixLength : {0, 1, 3, 8, 9, 16}) {
+    SCOPED_TRACE(fmt::format("prefix length {}", maxStringPrefixLength));
+    testPrefixSort({kAsc, kAsc}, data, maxStringPrefixLength);
+    testPrefixSort({kDesc, kDesc}, data, maxStringPrefixLength);
+    testPrefixSort({kAsc, kDesc}, data, maxStringPrefixLength);
+  }
+
+  const auto layout = PrefixSortLayout::makeSortLayout(
+      {VARCHAR(), TIMESTAMP()}, {kAsc, kAsc}, 1024, 16);
+  EXPECT_EQ(layout.numNormalizedKeys, 2);
+  EXPECT_FALSE(layout.hasNonNormalizedKey);
+  // The string bytes are extended to end the key at 8 bytes.
+  EXPECT_EQ(layout.stringPrefixLengths[0], 22);
+  EXPECT_EQ(layout.prefixOffsets[1], 24);
+  EXPECT_EQ(
+      PrefixSortLayout::makeSortLayout(
+          {VARCHAR(), TIMESTAMP()}, {kAsc, kAsc}, 1024, 0)
+          .numNormalizedKeys,
+      0);
+}
+
+TEST_F(PrefixSortTest, fuzzStringPrefix) {
+  VectorFuzzer fuzzer(
+      {.vectorSize = 10'240, .nullRatio = 0.1, .stringLength = 6}, pool());
+  for (const auto& type : {TIMESTAMP(), BIGINT(), VARCHAR()}) {
+    SCOPED_TRACE(type->toString());
+    auto data = fuzzer.fuzzRow(ROW({VARCHAR(), type}));
+    for (const auto maxStringPrefixLength : {1, 4, 16}) {
+      testPrefixSort({kAsc, kAsc}, data, maxStringPrefixLength);
+      testPrefixSort({kDesc, kAsc}, data, maxStringPrefixLength);
+    }
+  }
+}
+
+TEST_F(PrefixSortTest, fuzzRadixSort) {
+  // Sorts all the prefixes with radix sort if their leading bytes differ.
+  const uint32_t kRadixSortThreshold = 0;
+  const auto kMaxStringPrefixLength =
+      PrefixSortConfig::kDefaultMaxStringPrefixLength;
+  VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
+  for (const auto& rowType :
+       {ROW({BIGINT(), VARCHAR()}),
+        ROW({INTEGER(), SMALLINT()}),
+        ROW({DOUBLE(), BIGINT()}),
+        ROW({TIMESTAMP(), BIGINT()})}) {
+    SCOPED_TRACE(rowType->toString());
+    auto data = fuzzer.fuzzRow(rowType);
+    testPrefixSort({kAsc}, data, kMaxStringPrefixLength, kRadixSortThreshold);
+    testPrefixSort(
+        {kAsc, kDesc}, data, kMaxStringPrefixLength, kRadixSortThreshold);
+    testPrefixSort(
+        {kDesc, kAsc}, data, kMaxStringPrefixLength, kRadixSortThreshold);
+  }
+
+  // Few distinct keys that share their leading bytes.
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      10'240, [](auto row) { return row % 3 == 0 ? row % 7 : -row % 11; })});
+  testPrefixSort({kAsc}, data, kMaxStringPrefixLength, kRadixSortThreshold);
+}
+
 TEST_F(PrefixSortTest, fuzzMulti) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/process/PerfCounters.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -207,9 +208,12 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"          skippedPages        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedSplitBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          skippedSplits       [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedStrides      [ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          skippedStridesByBloomFilter[ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          skippedStripes      [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          storageReadBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
        {"          totalScanTime       [ ]* sum: .+, count: .+, min: .+, max: .+"},
@@ -303,11 +307,54 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"        skippedPages[ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedSplitBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        skippedSplits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedStrides   [ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        skippedStridesByBloomFilter[ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        skippedStripes   [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        storageReadBytes [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, hardwareCounters) {
+  if (process::PerfCounters::forCurrentThread() == nullptr) {
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  auto op = PlanBuilder()
+                .values({data, data})
+                .filter("c0 % 3 = 0")
+                .project({"c0 * 2 as c1"})
+                .planNode();
+
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    std::shared_ptr<exec::Task> task;
+    auto result = AssertQueryBuilder(op)
+                      .config(
+                          core::QueryConfig::kOperatorTrackHardwareCounters,
+                          enabled ? "true" : "false")
+                      .copyResults(pool(), task);
+    ASSERT_EQ(result->size(), 2 * 3'334);
+    ensureTaskCompletion(task.get());
+    const auto planStats = exec::toPlanStats(task->taskStats());
+    const auto& counters = planStats.at(op->id()).hardwareCounters;
+    if (!enabled) {
+      EXPECT_TRUE(counters.empty());
+      EXPECT_EQ(
+          printPlanWithStats(*op, task->taskStats()).find("IPC:"),
+          std::string::npos);
+      continue;
+    }
+    EXPECT_GT(counters.count, 0);
+    EXPECT_GT(counters.instructions, 0);
+    EXPECT_GT(counters.cycles, 0);
+    EXPECT_NE(
+        printPlanWithStats(*op, task->taskStats()).find("IPC:"),
+        std::string::npos);
+  }
+}
@@ -1119,6 +1119,63 @@ TEST_F(RowContainerTest, extractNulls) {
   }
 }
 
+TEST_F(RowContainerTest, extractIntoVectorWithNulls) {
+  constexpr int32_t kNumRows = 100;
+  // Join build keys are not nullable, so the key column has no null flags.
+  auto data = makeRowContainer({BIGINT()}, {BIGINT()});
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 2; }, nullEvery(3)),
+  });
+  std::vector<char*> rows(kNumRows);
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    DecodedVector decoded(*batch->childAt(column));
+    for (auto row = 0; row < kNumRows; ++row) {
+      if (column == 0) {
+        rows[row] = data->newRow();
+      }
+      data->store(decoded, row, rows[row], column);
+    }
+  }
+
+  // The result rows are all null before the extraction.
+  auto result = BaseVector::create(BIGINT(), kNumRows, pool());
+  for (auto row = 0; row < kNumRows; ++row) {
+    result->setNull(row, true);
+  }
+  data->extractColumn(rows.data(), kNumRows, 0, result);
+  assertEqualVectors(batch->childAt(0), result);
+  data->extractColumn(rows.data(), kNumRows, 1, result);
+  assertEqualVectors(batch->childAt(1), result);
+
+  // Negative row numbers are null, the rows before 'resultOffset' are kept.
+  std::vector<vector_size_t> rowNumbers(kNumRows / 2);
+  for (auto i = 0; i < rowNumbers.size(); ++i) {
+    rowNumbers[i] = i % 4 == 0 ? -1 : i;
+  }
+  data->extractColumn(
+      rows.data(),
+      folly::Range(rowNumbers.data(), rowNumbers.size()),
+      0,
+      10,
+      result);
+  ASSERT_EQ(result->size(), 10 + rowNumbers.size());
+  for (auto row = 0; row < result->size(); ++row) {
+    if (row < 10) {
+      ASSERT_EQ(result->isNullAt(row), row % 3 == 0) << row;
+      continue;
+    }
+    const auto rowNumber = rowNumbers[row - 10];
+    if (rowNumber < 0) {
+      ASSERT_TRUE(result->isNullAt(row)) << row;
+    } else {
+      ASSERT_FALSE(result->isNullAt(row)) << row;
+      ASSERT_EQ(result->asFlatVector<int64_t>()->valueAt(row), rowNumber);
+    }
+  }
+}
+
 TEST_F(RowContainerTest, erase) {
   constexpr int32_t kNumRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
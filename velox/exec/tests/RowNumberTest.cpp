@@ -17,6 +17,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/RowNumber.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -190,6 +191,57 @@ TEST_F(RowNumberTest, largeInput) {
   testLimit(5'000);
 }
 
+TEST_F(RowNumberTest, clusteredInput) {
+  // Runs of 1 to 10 rows with the same keys. c0 and c1 change together in
+  // some runs and separately in others. A partition comes back after other
+  // partitions, so its rows continue its row numbers.
+  auto makeData = [&](int32_t start) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (start + row) / 31 % 7; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (start + row) / 10 % 3; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    });
+  };
+  std::vector<RowVectorPtr> data = {makeData(0), makeData(1'000)};
+  createDuckDbTable(data);
+
+  for (auto limit : {1, 5, 20}) {
+    SCOPED_TRACE(fmt::format("limit {}", limit));
+    core::PlanNodeId rowNumberId;
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .rowNumber({"c0", "c1"}, limit)
+                    .capturePlanNodeId(rowNumberId)
+                    .planNode();
+    auto task = assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by c0, c1) as rn FROM tmp) "
+            "WHERE rn <= {}",
+            limit));
+    const auto& stats = toPlanStats(task->taskStats()).at(rowNumberId);
+    ASSERT_EQ(
+        stats.customStats.at(RowNumber::kNumClusteredBatches).sum,
+        data.size());
+  }
+
+  // Input that is not clustered is probed row by row.
+  core::PlanNodeId rowNumberId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .rowNumber({"c2"}, 1)
+                  .capturePlanNodeId(rowNumberId)
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      "SELECT * FROM (SELECT *, row_number() over (partition by c2) as rn FROM tmp) "
+      "WHERE rn <= 1");
+  const auto& stats = toPlanStats(task->taskStats()).at(rowNumberId);
+  ASSERT_EQ(stats.customStats.count(RowNumber::kNumClusteredBatches), 0);
+}
+
 TEST_F(RowNumberTest, spill) {
   std::vector<RowVectorPtr> vectors = createVectors(8, rowType_, fuzzerOpts_);
   createDuckDbTable(vectors);
@@ -148,6 +148,56 @@ TEST_F(SortBufferTest, singleKey) {
   }
 }
 
+TEST_F(SortBufferTest, parallelSort) {
+  // Three runs, so that one run is carried over a merge round.
+  constexpr vector_size_t kNumRows = 200'000;
+  // Specifies the sort columns ["c0", "c1"].
+  sortColumnIndices_ = {0, 1};
+  for (const auto parallelSortMinRows : {0, 1'000}) {
+    SCOPED_TRACE(fmt::format("parallelSortMinRows {}", parallelSortMinRows));
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        nullptr,
+        nullptr,
+        executor_.get(),
+        parallelSortMinRows);
+
+    RowVectorPtr data = makeRowVector(
+        {makeFlatVector<int64_t>(
+             kNumRows, [](auto row) { return (row * 7919) % 1'000; }),
+         makeFlatVector<int32_t>(kNumRows, [](auto row) { return -row; }),
+         makeFlatVector<int16_t>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<float>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<double>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<std::string>(
+             kNumRows, [](auto row) { return std::to_string(row); })});
+
+    sortBuffer->addInput(data);
+    sortBuffer->noMoreInput();
+    vector_size_t numOutputRows = 0;
+    int64_t lastKey = std::numeric_limits<int64_t>::min();
+    int32_t lastSecondKey = std::numeric_limits<int32_t>::min();
+    while (auto output = sortBuffer->getOutput(10'000)) {
+      auto* keys = output->childAt(0)->asFlatVector<int64_t>();
+      auto* secondKeys = output->childAt(1)->asFlatVector<int32_t>();
+      for (auto i = 0; i < output->size(); ++i) {
+        const auto key = keys->valueAt(i);
+        const auto secondKey = secondKeys->valueAt(i);
+        ASSERT_TRUE(
+            key > lastKey || (key == lastKey && secondKey > lastSecondKey));
+        lastKey = key;
+        lastSecondKey = secondKey;
+      }
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, kNumRows);
+  }
+}
+
 TEST_F(SortBufferTest, multipleKeys) {
   auto sortBuffer = std::make_unique<SortBuffer>(
       inputType_,
@@ -176,6 +226,66 @@ TEST_F(SortBufferTest, multipleKeys) {
   ASSERT_EQ(output->childAt(1)->asFlatVector<int32_t>()->valueAt(4), 2);
 }
 
+TEST_F(SortBufferTest, stringKeyRuns) {
+  constexpr vector_size_t kNumRows = 1'000;
+  // Specifies the sort columns ["c5", "c0"].
+  sortColumnIndices_ = {5, 0};
+  // Pairs of the number of distinct keys and whether the leading key is
+  // expected to be extracted once per run.
+  const std::vector<std::pair<int32_t, bool>> testSettings = {
+      {10, true}, {kNumRows, false}};
+  for (const auto& [numDistinct, expectDictionary] : testSettings) {
+    SCOPED_TRACE(fmt::format("numDistinct {}", numDistinct));
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_);
+    auto keyAt = [&](auto row) {
+      return fmt::format("a string key longer than inline {}", row);
+    };
+    sortBuffer->addInput(makeRowVector(
+        {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<int16_t>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<float>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<double>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<std::string>(
+             kNumRows,
+             [&](auto row) { return keyAt(row * 7 % numDistinct); },
+             nullEvery(50))}));
+    sortBuffer->noMoreInput();
+
+    std::vector<std::optional<std::string>> expected;
+    for (auto i = 0; i < kNumRows; ++i) {
+      expected.push_back(
+          i % 50 == 0 ? std::nullopt
+                      : std::optional(keyAt(i * 7 % numDistinct)));
+    }
+    std::sort(expected.begin(), expected.end());
+
+    vector_size_t numOutputRows = 0;
+    while (auto output = sortBuffer->getOutput(500)) {
+      const auto& keys = output->childAt(5);
+      ASSERT_EQ(
+          keys->encoding() == VectorEncoding::Simple::DICTIONARY,
+          expectDictionary);
+      DecodedVector decoded(*keys);
+      for (auto i = 0; i < output->size(); ++i) {
+        const auto& expectedKey = expected[numOutputRows + i];
+        ASSERT_EQ(decoded.isNullAt(i), !expectedKey.has_value()) << i;
+        if (expectedKey.has_value()) {
+          ASSERT_EQ(decoded.valueAt<StringView>(i).str(), expectedKey.value())
+              << i;
+        }
+      }
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, kNumRows);
+  }
+}
+
 // TODO: enable it later with test utility to compare the sorted result.
 TEST_F(SortBufferTest, DISABLED_randomData) {
   struct {
@@ -447,6 +557,92 @@ TEST_F(SortBufferTest, spill) {
   }
 }
 
+TEST_F(SortBufferTest, multiPassSpillMerge) {
+  constexpr int32_t kNumBatches = 7;
+  constexpr vector_size_t kBatchSize = 1'000;
+  // Specifies the sort columns ["c5", "c0"]. The strings share prefixes
+  // longer than the normalized key prefix.
+  sortColumnIndices_ = {5, 0};
+  sortCompareFlags_ = {
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {true, false, false, CompareFlags::NullHandlingMode::kNullAsValue}};
+  // Pairs of the merge fan-in and the expected number of spilled files. A
+  // fan-in of 2 merges 7 files into 4 and then into 2 files, a fan-in of 3
+  // merges them into 3 files.
+  const std::vector<std::pair<int32_t, int32_t>> testSettings = {
+      {0, kNumBatches}, {2, kNumBatches + 5}, {3, kNumBatches + 3}};
+  for (const auto& [maxFanIn, expectedSpilledFiles] : testSettings) {
+    SCOPED_TRACE(fmt::format("maxFanIn {}", maxFanIn));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto spillConfig = common::SpillConfig(
+        [&]() -> const std::string& { return spillDirectory->getPath(); },
+        [&](uint64_t) {},
+        "0.0.0",
+        0,
+        0,
+        executor_.get(),
+        5,
+        10,
+        0,
+        0,
+        0,
+        0,
+        0,
+        "none",
+        "",
+        false,
+        0,
+        maxFanIn * SpillReadFile::kMaxReadBufferSize);
+    folly::Synchronized<common::SpillStats> spillStats;
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        &spillConfig,
+        &spillStats);
+
+    for (auto batch = 0; batch < kNumBatches; ++batch) {
+      const auto offset = batch * kBatchSize;
+      sortBuffer->addInput(makeRowVector(
+          {makeFlatVector<int64_t>(
+               kBatchSize, [&](auto row) { return (offset + row) % 1'001; }),
+           makeFlatVector<int32_t>(kBatchSize, [](auto row) { return row; }),
+           makeFlatVector<int16_t>(kBatchSize, [](auto row) { return row; }),
+           makeFlatVector<float>(kBatchSize, [](auto row) { return row; }),
+           makeFlatVector<double>(kBatchSize, [](auto row) { return row; }),
+           makeFlatVector<std::string>(kBatchSize, [&](auto row) {
+             return fmt::format("common prefix {}", (offset + row) % 37);
+           })}));
+      sortBuffer->spill();
+    }
+    sortBuffer->noMoreInput();
+    ASSERT_EQ(spillStats.rlock()->spilledFiles, expectedSpilledFiles);
+
+    vector_size_t numOutputRows = 0;
+    std::optional<std::string> lastKey;
+    int64_t lastSecondKey;
+    while (auto output = sortBuffer->getOutput(1'000)) {
+      auto* keys = output->childAt(5)->asFlatVector<StringView>();
+      auto* secondKeys = output->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < output->size(); ++i) {
+        const auto key = keys->valueAt(i).str();
+        const auto secondKey = secondKeys->valueAt(i);
+        if (lastKey.has_value()) {
+          ASSERT_TRUE(
+              key > lastKey.value() ||
+              (key == lastKey.value() && secondKey <= lastSecondKey));
+        }
+        lastKey = key;
+        lastSecondKey = secondKey;
+      }
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, kNumBatches * kBatchSize);
+  }
+}
+
 TEST_F(SortBufferTest, emptySpill) {
   const std::shared_ptr<memory::MemoryPool> fuzzerPool =
       memory::memoryManager()->addLeafPool("emptySpillSource");
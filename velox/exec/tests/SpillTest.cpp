@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -403,7 +404,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             "spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] "
             "spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] "
             "maxSpillExceededLimitCount[0] spillReadBytes[{}] spillReads[{}] "
-            "spillReadTime[{}] spillReadDeserializationTime[{}]",
+            "spillReadTime[{}] spillReadDeserializationTime[{}] "
+            "spillPrefetchHits[0] spillPrefetchMisses[0]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -516,6 +518,321 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, mergeFilesRemovedBytes) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  // A target file size of 1 makes a new file for each batch.
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      1,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+  constexpr int32_t kNumFiles = 4;
+  constexpr int32_t kNumRows = 100;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>(kNumRows, [&](auto row) {
+          return row * kNumFiles + i;
+        })}));
+  }
+  auto files = state.finish(0);
+  ASSERT_EQ(files.size(), kNumFiles);
+  uint64_t fileBytes = 0;
+  for (const auto& file : files) {
+    fileBytes += file.size;
+  }
+
+  // One pass merges the 4 files into 2 and removes all 4.
+  uint64_t removedBytes = 0;
+  files = state.mergeFiles(
+      0, std::move(files), 2, [&](uint64_t bytes) { removedBytes += bytes; });
+  ASSERT_EQ(files.size(), 2);
+  ASSERT_EQ(removedBytes, fileBytes);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+  for (auto i = 0; i < kNumFiles * kNumRows; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
+TEST_P(SpillTest, asyncWrite) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const int32_t numPartitions = 4;
+  const int32_t numBatches = 10;
+  const int32_t numRowsPerBatch = 1'000;
+  std::vector<CompareFlags> emptyCompareFlags;
+  for (const int64_t targetFileSize : std::vector<int64_t>{1, kGB}) {
+    SCOPED_TRACE(fmt::format("targetFileSize {}", targetFileSize));
+    spillStats_.wlock()->reset();
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        numPartitions,
+        0,
+        emptyCompareFlags,
+        targetFileSize,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        executor.get());
+    std::vector<std::vector<RowVectorPtr>> batches(numPartitions);
+    for (int32_t partition = 0; partition < numPartitions; ++partition) {
+      state.setPartitionSpilled(partition);
+      for (int32_t i = 0; i < numBatches; ++i) {
+        batches[partition].push_back(makeRowVector({makeFlatVector<int64_t>(
+            numRowsPerBatch, [&](auto row) {
+              return partition * 1'000'000 + i * numRowsPerBatch + row;
+            })}));
+        state.appendToPartition(partition, batches[partition].back());
+      }
+    }
+
+    const auto stats = spillStats_.copy();
+    ASSERT_EQ(stats.spillWrites, numPartitions * numBatches);
+    // NOTE: the last file of each partition is closed on finish.
+    ASSERT_EQ(
+        stats.spilledFiles,
+        targetFileSize == 1 ? numPartitions * (numBatches - 1) : 0);
+    ASSERT_EQ(stats.spilledRows, numPartitions * numBatches * numRowsPerBatch);
+
+    for (int32_t partition = 0; partition < numPartitions; ++partition) {
+      SpillPartition spillPartition(
+          SpillPartitionId{0, partition}, state.finish(partition));
+      auto reader = spillPartition.createUnorderedReader(pool(), &spillStats_);
+      RowVectorPtr result;
+      for (int32_t i = 0; i < numBatches; ++i) {
+        ASSERT_TRUE(reader->nextBatch(result));
+        facebook::velox::test::assertEqualVectors(
+            batches[partition][i], result);
+      }
+      ASSERT_FALSE(reader->nextBatch(result));
+    }
+    ASSERT_GT(spillStats_.rlock()->spilledBytes, 0);
+  }
+}
+
+TEST_P(SpillTest, compressionDictionary) {
+  const int32_t numBatches = 50;
+  std::vector<RowVectorPtr> batches;
+  for (int32_t i = 0; i < numBatches; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(20, [&](auto row) { return i * 20 + row; }),
+        makeFlatVector<std::string>(
+            20,
+            [&](auto row) {
+              return fmt::format(
+                  "customer#{:09} {}",
+                  (i * 20 + row) % 97,
+                  row % 3 == 0 ? "BUILDING" : "AUTOMOBILE");
+            }),
+    }));
+  }
+
+  // Spills 'batches' as small pages and returns the spilled bytes.
+  auto spill = [&](uint32_t dictionaryBytes) {
+    spillStats_.wlock()->reset();
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    std::vector<CompareFlags> emptyCompareFlags;
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        0,
+        emptyCompareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        nullptr,
+        dictionaryBytes);
+    state.setPartitionSpilled(0);
+    // The dictionary is trained on the first write.
+    state.appendToPartition(0, makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [](auto row) {
+              return fmt::format(
+                  "customer#{:09} {}",
+                  row % 97,
+                  row % 3 == 0 ? "BUILDING" : "AUTOMOBILE");
+            }),
+    }));
+    for (const auto& batch : batches) {
+      state.appendToPartition(0, batch);
+    }
+    auto files = state.finish(0);
+    EXPECT_EQ(
+        dictionaryBytes > 0 && compressionKind_ == common::CompressionKind_ZSTD,
+        files.back().compressionDictionary != nullptr);
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+    auto reader = spillPartition.createUnorderedReader(pool(), &spillStats_);
+    RowVectorPtr result;
+    EXPECT_TRUE(reader->nextBatch(result));
+    for (const auto& batch : batches) {
+      EXPECT_TRUE(reader->nextBatch(result));
+      facebook::velox::test::assertEqualVectors(batch, result);
+    }
+    EXPECT_FALSE(reader->nextBatch(result));
+    return spillStats_.rlock()->spilledBytes;
+  };
+
+  const auto plainBytes = spill(0);
+  const auto dictionaryBytes = spill(4 << 10);
+  if (compressionKind_ == common::CompressionKind_ZSTD) {
+    ASSERT_LT(dictionaryBytes, plainBytes);
+  } else {
+    ASSERT_EQ(dictionaryBytes, plainBytes);
+  }
+}
+
+TEST_P(SpillTest, prefetchRead) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  // Write enough rows to each file to need multiple reads with the 1MB read
+  // buffer.
+  const int32_t numFiles = 4;
+  const int32_t numRowsPerFile = 400'000;
+  std::vector<CompareFlags> compareFlags{CompareFlags{}};
+
+  struct {
+    uint64_t prefetchBytes;
+
+    std::string debugString() const {
+      return fmt::format("prefetchBytes {}", prefetchBytes);
+    }
+  } testSettings[] = {{1}, {1 << 20}, {64 << 20}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    spillStats_.wlock()->reset();
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        1,
+        compareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_);
+    state.setPartitionSpilled(0);
+    for (int32_t i = 0; i < numFiles; ++i) {
+      state.appendToPartition(
+          0,
+          makeRowVector({makeFlatVector<int64_t>(
+              numRowsPerFile, [&](auto row) { return row * numFiles + i; })}));
+      state.finishFile(0);
+    }
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+    auto merge = spillPartition.createOrderedReader(
+        pool(), &spillStats_, executor.get(), testData.prefetchBytes);
+    for (int64_t i = 0; i < numFiles * numRowsPerFile; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_EQ(nullptr, merge->next());
+    merge.reset();
+
+    const auto stats = spillStats_.copy();
+    ASSERT_GE(stats.spillReads, numFiles);
+    ASSERT_EQ(
+        stats.spillPrefetchHits + stats.spillPrefetchMisses, stats.spillReads);
+    if (testData.prefetchBytes == 1) {
+      ASSERT_EQ(stats.spillPrefetchHits, 0);
+    }
+  }
+}
+
+TEST_P(SpillTest, mmapRead) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_spill_read_mmap = true;
+  const int32_t numFiles = 3;
+  const int32_t numRowsPerFile = 200'000;
+  std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+  for (int32_t i = 0; i < numFiles; ++i) {
+    state.appendToPartition(
+        0,
+        makeRowVector(
+            {makeFlatVector<int64_t>(
+                 numRowsPerFile, [&](auto row) { return row * numFiles + i; }),
+             makeFlatVector<StringView>(
+                 numRowsPerFile,
+                 [&](auto row) {
+                   return StringView::makeInline(
+                       fmt::format("{}", row * numFiles + i));
+                 },
+                 [](auto row) { return row % 11 == 0; })}));
+    state.finishFile(0);
+  }
+
+  spillStats_.wlock()->reset();
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+  for (int64_t i = 0; i < numFiles * numRowsPerFile; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    const auto index = stream->currentIndex();
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(index));
+    const auto row = i / numFiles;
+    if (row % 11 == 0) {
+      ASSERT_TRUE(stream->decoded(1).isNullAt(index));
+    } else {
+      ASSERT_EQ(
+          fmt::format("{}", i),
+          stream->decoded(1).valueAt<StringView>(index).str());
+    }
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+  merge.reset();
+
+  // Each file fits in one mapping window.
+  const auto stats = spillStats_.copy();
+  ASSERT_EQ(stats.spillReads, numFiles);
+  ASSERT_GT(stats.spillReadBytes, 0);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
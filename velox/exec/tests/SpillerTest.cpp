@@ -143,6 +143,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
             0,
             (type_ == Spiller::Type::kOrderByInput ||
              type_ == Spiller::Type::kOrderByOutput ||
+             type_ == Spiller::Type::kWindow ||
+             type_ == Spiller::Type::kTopNRowNumber ||
              type_ == Spiller::Type::kAggregateOutput ||
              type_ == Spiller::Type::kAggregateInput)
                 ? 0
@@ -546,7 +548,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
           type_, rowType_, hashBits_, &spillConfig, &spillStats_);
     } else if (
         type_ == Spiller::Type::kOrderByInput ||
-        type_ == Spiller::Type::kAggregateInput) {
+        type_ == Spiller::Type::kAggregateInput ||
+        type_ == Spiller::Type::kWindow ||
+        type_ == Spiller::Type::kTopNRowNumber) {
       // We spill 'data' in one partition in type of kOrderBy, otherwise in 4
       // partitions.
       spiller_ = std::make_unique<Spiller>(
@@ -562,7 +566,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
         type_ == Spiller::Type::kOrderByOutput) {
       spiller_ = std::make_unique<Spiller>(
           type_, rowContainer_.get(), rowType_, &spillConfig, &spillStats_);
-    } else if (type_ == Spiller::Type::kRowNumber) {
+    } else if (
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kMarkDistinct) {
       spiller_ = std::make_unique<Spiller>(
           type_,
           rowContainer_.get(),
@@ -744,7 +750,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kHashJoinProbe ||
-        type_ == Spiller::Type::kRowNumber);
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kMarkDistinct);
 
     const int numSpillPartitions = type_ != Spiller::Type::kHashJoinProbe
         ? numPartitions_
@@ -841,7 +848,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       ASSERT_GT(stats.spilledPartitions, 0);
       ASSERT_EQ(stats.spillSortTimeUs, 0);
       if (type_ == Spiller::Type::kHashJoinBuild ||
-          type_ == Spiller::Type::kRowNumber) {
+          type_ == Spiller::Type::kRowNumber ||
+          type_ == Spiller::Type::kMarkDistinct) {
         ASSERT_GT(stats.spillFillTimeUs, 0);
       } else {
         ASSERT_EQ(stats.spillFillTimeUs, 0);
@@ -895,6 +903,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kMarkDistinct ||
         type_ == Spiller::Type::kHashJoinProbe);
 
     SpillPartitionSet spillPartitionSet;
@@ -967,6 +976,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kMarkDistinct ||
         type_ == Spiller::Type::kHashJoinProbe);
 
     if (numPartitions_ > 0) {
@@ -1120,7 +1130,9 @@ TEST_P(AllTypes, nonSortedSpillFunctions) {
   if (type_ == Spiller::Type::kOrderByInput ||
       type_ == Spiller::Type::kOrderByOutput ||
       type_ == Spiller::Type::kAggregateInput ||
-      type_ == Spiller::Type::kAggregateOutput) {
+      type_ == Spiller::Type::kAggregateOutput ||
+      type_ == Spiller::Type::kWindow ||
+      type_ == Spiller::Type::kTopNRowNumber) {
     setupSpillData(numKeys_, 5'000, 1, nullptr, {});
     sortSpillData();
     setupSpiller(100'000, 0, false, maxSpillRunRows_);
@@ -1166,6 +1178,7 @@ class NoHashJoin : public SpillerTest,
             {Spiller::Type::kHashJoinProbe,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kMarkDistinct,
              Spiller::Type::kOrderByOutput}}
         .getTestParams();
   }
@@ -1226,7 +1239,9 @@ class HashJoinBuildOnly : public SpillerTest,
              Spiller::Type::kAggregateOutput,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kOrderByInput,
-             Spiller::Type::kOrderByOutput}}
+             Spiller::Type::kOrderByOutput,
+             Spiller::Type::kWindow,
+             Spiller::Type::kTopNRowNumber}}
         .getTestParams();
   }
 };
@@ -1317,9 +1332,12 @@ class AggregationOutputOnly : public SpillerTest,
             {Spiller::Type::kAggregateInput,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kMarkDistinct,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kOrderByInput,
-             Spiller::Type::kOrderByOutput}}
+             Spiller::Type::kOrderByOutput,
+             Spiller::Type::kWindow,
+             Spiller::Type::kTopNRowNumber}}
         .getTestParams();
   }
 };
@@ -1418,7 +1436,10 @@ class OrderByOutputOnly : public SpillerTest,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kRowNumber,
-             Spiller::Type::kOrderByInput}}
+             Spiller::Type::kMarkDistinct,
+             Spiller::Type::kOrderByInput,
+             Spiller::Type::kWindow,
+             Spiller::Type::kTopNRowNumber}}
         .getTestParams();
   }
 };
@@ -1558,7 +1579,9 @@ TEST_P(MaxSpillRunTest, basic) {
       ASSERT_EQ(spillPartitionSet.size(), 1);
     } else if (
         type_ == Spiller::Type::kAggregateInput ||
-        type_ == Spiller::Type::kOrderByInput) {
+        type_ == Spiller::Type::kOrderByInput ||
+        type_ == Spiller::Type::kWindow ||
+        type_ == Spiller::Type::kTopNRowNumber) {
       // Need sort.
       ASSERT_EQ(numFiles, testData.expectedNumFiles);
       ASSERT_EQ(spillPartitionSet.size(), 1);
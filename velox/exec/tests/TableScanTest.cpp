@@ -1389,6 +1389,28 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, preloadBytesLimit) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 100);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+    const auto path = filePaths[i]->getPath();
+    splits.push_back(makeHiveConnectorSplit(path, 0, fs::file_size(path)));
+    ASSERT_EQ(fs::file_size(path), splits.back()->byteSize());
+  }
+  createDuckDbTable(vectors);
+
+  // A limit of 1 byte lets one split preload at a time.
+  auto task = AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+                  .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "4")
+                  .config(core::QueryConfig::kMaxSplitPreloadBytes, "1")
+                  .splits(splits)
+                  .assertResults("SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GE(stats.at("preloadedSplits").sum, 1);
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -1614,6 +1636,101 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, rowLimit) {
+  const auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+
+  // Runs 'scan' followed by a limit of 10 rows after an offset of 5 and
+  // returns the stats of the scan.
+  auto runWithLimit = [&](PlanBuilder&& scan) {
+    core::PlanNodeId scanNodeId;
+    auto plan =
+        scan.capturePlanNodeId(scanNodeId).limit(5, 10, false).planNode();
+    std::shared_ptr<Task> task;
+    auto result = AssertQueryBuilder(plan)
+                      .splits(makeHiveConnectorSplits(filePaths))
+                      .copyResults(pool(), task);
+    EXPECT_EQ(result->size(), 10);
+    return toPlanStats(task->taskStats()).at(scanNodeId);
+  };
+
+  // The scan is read in one batch of the 15 rows the limit needs.
+  auto scanStats = runWithLimit(PlanBuilder(pool_.get()).tableScan(rowType_));
+  EXPECT_EQ(scanStats.outputRows, 15);
+  EXPECT_EQ(scanStats.numSplits, 1);
+
+  // With a filter, the scan stops once 15 rows pass.
+  scanStats = runWithLimit(
+      PlanBuilder(pool_.get()).tableScan(rowType_, {}, "c0 % 2 = 0"));
+  EXPECT_GE(scanStats.outputRows, 15);
+  EXPECT_LT(scanStats.outputRows, 1'000);
+  EXPECT_EQ(scanStats.numSplits, 1);
+}
+
+TEST_F(TableScanTest, aggregationFromStatistics) {
+  const auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Runs a global aggregation over a scan with 'filter' and returns the
+  // number of splits answered from the file statistics.
+  auto runAggregation =
+      [&](const std::vector<std::shared_ptr<connector::ConnectorSplit>>& splits,
+          const std::string& filter,
+          bool enabled) {
+        core::PlanNodeId scanNodeId;
+        auto plan = PlanBuilder(pool_.get())
+                        .tableScan(rowType_, {}, filter)
+                        .capturePlanNodeId(scanNodeId)
+                        .partialAggregation(
+                            {},
+                            {"count()",
+                             "count(c5)",
+                             "min(c0)",
+                             "max(c1)",
+                             "min(c2)",
+                             "max(c6)"})
+                        .finalAggregation()
+                        .planNode();
+        auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                        .config(
+                            QueryConfig::kTableScanAggregationFromStatistics,
+                            enabled)
+                        .splits(splits)
+                        .assertResults(fmt::format(
+                            "SELECT count(*), count(c5), min(c0), max(c1), "
+                            "min(c2), max(c6) FROM tmp {}",
+                            filter.empty() ? "" : "WHERE " + filter));
+        const auto& customStats =
+            toPlanStats(task->taskStats()).at(scanNodeId).customStats;
+        auto it = customStats.find("statisticsAggregatedSplits");
+        return it == customStats.end() ? 0 : it->second.sum;
+      };
+
+  const auto splits = makeHiveConnectorSplits(filePaths);
+  EXPECT_EQ(runAggregation(splits, "", false), 0);
+  EXPECT_EQ(runAggregation(splits, "", true), 3);
+
+  // The statistics do not account for a filter on a data column.
+  EXPECT_EQ(runAggregation(splits, "c0 % 2 = 0", true), 0);
+
+  // A split of part of a file is read.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> partialSplits;
+  for (const auto& filePath : filePaths) {
+    for (auto& split : makeHiveConnectorSplits(
+             filePath->getPath(), 2, dwio::common::FileFormat::DWRF)) {
+      partialSplits.push_back(std::move(split));
+    }
+  }
+  EXPECT_EQ(runAggregation(partialSplits, "", true), 0);
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   auto split = HiveConnectorSplitBuilder("/path/to/nowhere.orc").build();
   auto assertMissingFile = [&](bool ignoreMissingFiles) {
@@ -1834,6 +1951,33 @@ TEST_F(TableScanTest, statsBasedSkippingDouble) {
   EXPECT_EQ(3, getSkippedStridesStat(task));
 }
 
+TEST_F(TableScanTest, statsBasedSkippingStripes) {
+  // One stripe per vector, so that the file statistics cover all the values
+  // and only the stripe row indexes can skip stripes.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        10'000, [&](auto row) { return i * 10'000 + row; })}));
+  }
+  auto writeConfig = std::make_shared<dwrf::Config>();
+  writeConfig->set<uint64_t>(
+      dwrf::Config::STRIPE_SIZE, vectors[0]->size() * sizeof(int64_t));
+  auto filePaths = makeFilePaths(1);
+  writeToFile(filePaths[0]->getPath(), vectors, writeConfig);
+  createDuckDbTable(vectors);
+
+  auto task = assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(ROW({"c0"}, {BIGINT()}), {"c0 between 55000 and 55010"})
+          .planNode(),
+      filePaths,
+      "SELECT c0 FROM tmp WHERE c0 between 55000 and 55010");
+  EXPECT_EQ(0, getSkippedSplitsStat(task));
+  const auto skippedStripes = getTableScanRuntimeStats(task)["skippedStripes"];
+  EXPECT_GT(skippedStripes.sum, 0);
+  EXPECT_LE(skippedStripes.sum, getSkippedStridesStat(task));
+}
+
 TEST_F(TableScanTest, statsBasedSkippingFloat) {
   auto filePaths = makeFilePaths(1);
   auto size = 31'234;
@@ -2857,6 +3001,102 @@ TEST_F(TableScanTest, mapIsNullFilter) {
       "SELECT * FROM tmp WHERE c0 is null");
 }
 
+TEST_F(TableScanTest, mapSubscriptFilter) {
+  constexpr vector_size_t kSize = 1'000;
+  // Every 7th map is null. The others have key 'b' and, if the row is not a
+  // multiple of 3, key 'a' with value row % 10, which is null if the row is a
+  // multiple of 11.
+  auto valueOfA = [](vector_size_t row) -> std::optional<std::string> {
+    if (row % 7 == 0 || row % 3 == 0 || row % 11 == 0) {
+      return std::nullopt;
+    }
+    return std::to_string(row % 10);
+  };
+  std::vector<vector_size_t> offsets;
+  std::vector<vector_size_t> nulls;
+  std::vector<std::string> keys;
+  std::vector<std::optional<std::string>> values;
+  for (vector_size_t row = 0; row < kSize; ++row) {
+    offsets.push_back(keys.size());
+    if (row % 7 == 0) {
+      nulls.push_back(row);
+      continue;
+    }
+    keys.push_back("b");
+    values.push_back(fmt::format("b{}", row));
+    if (row % 3 != 0) {
+      keys.push_back("a");
+      values.push_back(valueOfA(row));
+    }
+  }
+  auto c0 = makeMapVector(
+      offsets,
+      makeFlatVector<std::string>(keys),
+      makeNullableFlatVector<std::string>(values),
+      nulls);
+  auto c1 = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto data = makeRowVector({"c0", "c1"}, {c0, c1});
+  auto rowType = asRowType(data->type());
+
+  auto flatMapConfig = std::make_shared<dwrf::Config>();
+  flatMapConfig->set(dwrf::Config::FLATTEN_MAP, true);
+  flatMapConfig->set<const std::vector<uint32_t>>(
+      dwrf::Config::MAP_FLAT_COLS, {0});
+  auto filePath = TempFilePath::create();
+  auto flatMapFilePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {data});
+  writeToFile(flatMapFilePath->getPath(), {data}, flatMapConfig);
+
+  auto test = [&](std::unique_ptr<common::Filter> filter,
+                  const RowTypePtr& outputType,
+                  std::function<bool(std::optional<std::string>)> passes) {
+    std::vector<vector_size_t> passingRows;
+    for (vector_size_t row = 0; row < kSize; ++row) {
+      if (passes(valueOfA(row))) {
+        passingRows.push_back(row);
+      }
+    }
+    auto indices = makeIndices(passingRows);
+    std::vector<VectorPtr> expectedColumns;
+    for (auto& name : outputType->names()) {
+      expectedColumns.push_back(wrapInDictionary(
+          indices, passingRows.size(), data->childAt(name)));
+    }
+    auto expected = makeRowVector(outputType->names(), expectedColumns);
+
+    SubfieldFilters filters;
+    filters[common::Subfield("c0[\"a\"]")] = std::move(filter);
+    auto tableHandle = makeTableHandle(
+        std::move(filters), nullptr, "hive_table", rowType);
+    ColumnHandleMap assignments;
+    for (auto& name : outputType->names()) {
+      assignments[name] = regularColumn(name, outputType->findChild(name));
+    }
+    auto plan = PlanBuilder()
+                    .startTableScan()
+                    .outputType(outputType)
+                    .tableHandle(tableHandle)
+                    .assignments(assignments)
+                    .endTableScan()
+                    .planNode();
+    for (auto& path : {filePath, flatMapFilePath}) {
+      SCOPED_TRACE(path == filePath ? "map" : "flat map");
+      AssertQueryBuilder(plan)
+          .split(makeHiveConnectorSplit(path->getPath()))
+          .assertResults(expected);
+    }
+  };
+
+  auto inSet = [](std::optional<std::string> value) {
+    return value.has_value() && (*value == "1" || *value == "2");
+  };
+  test(in({"1", "2"}), rowType, inSet);
+  test(in({"1", "2"}), ROW({"c1"}, {BIGINT()}), inSet);
+  test(isNull(), rowType, [](std::optional<std::string> value) {
+    return !value.has_value();
+  });
+}
+
 TEST_F(TableScanTest, remainingFilter) {
   auto rowType = ROW(
       {"c0", "c1", "c2", "c3"}, {INTEGER(), INTEGER(), DOUBLE(), BOOLEAN()});
@@ -3475,6 +3715,69 @@ TEST_F(TableScanTest, parallelPrepare) {
       .copyResults(pool_.get());
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // Each file has smaller c0 and c1 and larger c3 than the previous one, so
+  // that the top rows come from the first file and the later files fail the
+  // pushed down range on their stats.
+  constexpr int32_t kNumFiles = 5;
+  constexpr int32_t kNumRows = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             kNumRows,
+             [&](auto row) { return (kNumFiles - i) * kNumRows + row; },
+             [](auto row) { return row % 17 == 0; }),
+         makeFlatVector<Timestamp>(
+             kNumRows,
+             [&](auto row) {
+               return Timestamp((kNumFiles - i) * kNumRows + row, 0);
+             }),
+         makeFlatVector<int32_t>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<double>(
+             kNumRows, [&](auto row) { return i * kNumRows + row; })}));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  const auto rowType = asRowType(vectors[0]->type());
+  for (const auto maxSplitPreload : {0, 2}) {
+    for (const auto& key : {"c0 DESC NULLS LAST", "c1 DESC", "c3"}) {
+      SCOPED_TRACE(fmt::format("{} preload {}", key, maxSplitPreload));
+      core::PlanNodeId scanNodeId;
+      auto plan = PlanBuilder()
+                      .tableScan(rowType)
+                      .capturePlanNodeId(scanNodeId)
+                      .topN({key}, 10, true)
+                      .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(
+                  core::QueryConfig::kTopNDynamicFilterPushdownEnabled, true)
+              .config(
+                  core::QueryConfig::kMaxSplitPreloadPerDriver,
+                  maxSplitPreload)
+              .splits(makeHiveConnectorSplits(filePaths))
+              .assertResults(
+                  fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 10", key));
+      const auto planStats = toPlanStats(task->taskStats());
+      const auto& scanStats = planStats.at(scanNodeId);
+      ASSERT_LT(0, scanStats.customStats.at("dynamicFiltersAccepted").sum);
+      // A preloaded split gets the filters that came after its preload
+      // started when it replaces the current split, so its rows are dropped
+      // even if its file statistics were checked before the filter existed.
+      ASSERT_LT(scanStats.outputRows, kNumFiles * kNumRows);
+      if (maxSplitPreload == 0) {
+        ASSERT_LT(0, scanStats.customStats.at("skippedSplits").sum);
+      } else {
+        ASSERT_LE(1, scanStats.customStats.at("preloadedSplits").sum);
+      }
+    }
+  }
+}
+
 TEST_F(TableScanTest, dictionaryMemo) {
   constexpr int kSize = 100;
   const char* baseStrings[] = {
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -51,12 +52,28 @@ class TestTaskListener : public exec::TaskListener {
     events_.push_back({taskUuid, state, error, stats});
   }
 
+  void onPipelineFinished(
+      const std::string& /*taskUuid*/,
+      const std::string& /*taskId*/,
+      const exec::PipelineBoundaryStats& stats) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    pipelineEvents_.push_back(stats);
+  }
+
   std::vector<TaskCompletedEvent>& events() {
     return events_;
   }
 
+  std::vector<exec::PipelineBoundaryStats> pipelineEvents() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return pipelineEvents_;
+  }
+
  private:
   std::vector<TaskCompletedEvent> events_;
+  // Pipelines may finish on different threads.
+  std::mutex mutex_;
+  std::vector<exec::PipelineBoundaryStats> pipelineEvents_;
 };
 
 class TaskListenerTest : public OperatorTestBase {};
@@ -147,3 +164,47 @@ TEST_F(TaskListenerTest, multipleListeners) {
   ASSERT_TRUE(exec::unregisterTaskListener(listener1));
   ASSERT_TRUE(exec::unregisterTaskListener(listener2));
 }
+
+TEST_F(TaskListenerTest, pipelineFinished) {
+  auto probe = makeRowVector(
+      {"t0"}, {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  auto build = makeRowVector(
+      {"u0"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; })});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"t0", "u0"})
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  auto listener = std::make_shared<TestTaskListener>();
+  ASSERT_TRUE(exec::registerTaskListener(listener));
+
+  auto keys = makeFlatVector<int64_t>(1'000, [](auto row) { return row / 10; });
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kPipelineNdvSketchEnabled, "true")
+      .assertResults(makeRowVector({keys, keys}));
+
+  std::optional<exec::PipelineBoundaryStats> buildStats;
+  for (const auto& stats : listener->pipelineEvents()) {
+    if (stats.planNodeId == joinNodeId && stats.numRows == 1'000) {
+      buildStats = stats;
+    }
+  }
+  ASSERT_TRUE(buildStats.has_value());
+  ASSERT_GT(buildStats->numBytes, 0);
+  ASSERT_EQ(1, buildStats->numDistinct.count("u0"));
+  ASSERT_NEAR(100, buildStats->numDistinct.at("u0"), 10);
+
+  ASSERT_TRUE(exec::unregisterTaskListener(listener));
+}
@@ -16,6 +16,7 @@
 
 #include "velox/exec/Task.h"
 #include "folly/experimental/EventCount.h"
+#include "folly/json.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/MemoryArbitrator.h"
@@ -548,6 +549,89 @@ TEST_F(TaskTest, toJson) {
   ASSERT_NO_THROW(task->toShortJson());
 }
 
+TEST_F(TaskTest, progress) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  std::vector<std::shared_ptr<TempFilePath>> files;
+  for (auto i = 0; i < 2; ++i) {
+    files.push_back(TempFilePath::create());
+    writeToFile(files.back()->getPath(), {data});
+  }
+
+  core::PlanNodeId scanId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(data->type()))
+                  .capturePlanNodeId(scanId)
+                  .filter("c0 < 100")
+                  .project({"c0 + 5"})
+                  .planFragment();
+
+  {
+    auto task = Task::create(
+        "task-1",
+        plan,
+        0,
+        core::QueryCtx::create(driverExecutor_.get()),
+        Task::ExecutionMode::kParallel);
+    auto progress = task->progress();
+    ASSERT_EQ(progress.taskId, "task-1");
+    ASSERT_EQ(progress.state, TaskState::kRunning);
+    ASSERT_EQ(progress.numTotalSplits, 0);
+    ASSERT_EQ(progress.finishedSplitsPct(), 0);
+    ASSERT_TRUE(progress.pipelines.empty());
+    ASSERT_EQ(progress.nodes.size(), 3);
+    ASSERT_EQ(progress.nodes[0].planNodeId, plan.planNode->id());
+    ASSERT_EQ(progress.nodes[2].planNodeId, scanId);
+
+    task->addSplit(
+        scanId, exec::Split(makeHiveConnectorSplit(files[0]->getPath())));
+    progress = task->progress();
+    ASSERT_EQ(progress.numTotalSplits, 1);
+    ASSERT_EQ(progress.numQueuedSplits, 1);
+    ASSERT_EQ(progress.numRunningSplits, 0);
+
+    const auto json = progress.toJson();
+    for (const auto* key :
+         {"taskId",
+          "state",
+          "numTotalSplits",
+          "numQueuedSplits",
+          "numRunningSplits",
+          "numFinishedSplits",
+          "finishedSplitsPct",
+          "memoryBytes",
+          "spilledBytes",
+          "pipelines",
+          "nodes"}) {
+      ASSERT_EQ(json.count(key), 1) << key;
+    }
+    ASSERT_EQ(json["nodes"].size(), 3);
+    ASSERT_EQ(json["nodes"][2]["planNodeId"], scanId);
+    task->requestCancel();
+  }
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .splits(scanId, makeHiveConnectorSplits(files))
+      .copyResults(pool(), task);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  const auto progress = task->progress();
+  ASSERT_EQ(progress.state, TaskState::kFinished);
+  ASSERT_EQ(progress.numTotalSplits, 2);
+  ASSERT_EQ(progress.numQueuedSplits, 0);
+  ASSERT_EQ(progress.numRunningSplits, 0);
+  ASSERT_EQ(progress.numFinishedSplits, 2);
+  ASSERT_EQ(progress.finishedSplitsPct(), 100);
+  ASSERT_EQ(progress.pipelines.size(), 1);
+  const auto& pipeline = progress.pipelines[0];
+  ASSERT_EQ(pipeline.inputRows, 2'000);
+  ASSERT_EQ(pipeline.outputRows, 200);
+  ASSERT_EQ(pipeline.numFinishedDrivers, pipeline.numTotalDrivers);
+  ASSERT_EQ(progress.spilledBytes, 0);
+}
+
 TEST_F(TaskTest, wrongPlanNodeForSplit) {
   auto connectorSplit = std::make_shared<connector::hive::HiveConnectorSplit>(
       "test",
@@ -1545,6 +1629,86 @@ DEBUG_ONLY_TEST_F(TaskTest, driverCounters) {
   ASSERT_EQ(driverCounts.numBlockedDrivers.size(), 0);
 }
 
+TEST_F(TaskTest, exportAndInjectDynamicFilters) {
+  auto probe = makeRowVector(
+      {"p0"}, {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto build = makeRowVector({"b0"}, {makeFlatVector<int64_t>({10, 20, 30})});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {probe});
+
+  // The probe side of the join is a values node that can't accept dynamic
+  // filters, so the filters are only produced for export.
+  core::PlanNodeId joinNodeId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto joinPlan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({probe})
+          .hashJoin(
+              {"p0"},
+              {"b0"},
+              PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+              "",
+              {"p0"})
+          .capturePlanNodeId(joinNodeId)
+          .planNode();
+  for (bool exportFilters : {false, true}) {
+    SCOPED_TRACE(fmt::format("exportFilters: {}", exportFilters));
+    std::shared_ptr<Task> joinTask;
+    AssertQueryBuilder(joinPlan)
+        .config(
+            core::QueryConfig::kHashProbeExportDynamicFilters,
+            exportFilters ? "true" : "false")
+        .copyResults(pool(), joinTask);
+    ASSERT_EQ(
+        joinTask->exportedDynamicFilters(joinNodeId).size(),
+        exportFilters ? 1 : 0);
+  }
+
+  std::shared_ptr<Task> joinTask;
+  AssertQueryBuilder(joinPlan)
+      .config(core::QueryConfig::kHashProbeExportDynamicFilters, "true")
+      .copyResults(pool(), joinTask);
+  const auto filters = joinTask->exportedDynamicFilters(joinNodeId);
+  ASSERT_EQ(filters.count("p0"), 1);
+
+  // Forward the filters to a scan of the probe side table in another task.
+  core::PlanNodeId scanNodeId;
+  auto scanPlan = PlanBuilder()
+                      .tableScan(asRowType(probe->type()))
+                      .capturePlanNodeId(scanNodeId)
+                      .planFragment();
+  auto task = Task::create(
+      "dynamic.filters.task.0",
+      scanPlan,
+      0,
+      core::QueryCtx::create(),
+      Task::ExecutionMode::kSerial);
+  VELOX_ASSERT_THROW(
+      task->addDynamicFilters("unknown", joinNodeId, filters),
+      "Plan node ID unknown doesn't refer to such plan node");
+  task->addDynamicFilters(scanNodeId, joinNodeId, filters);
+  task->addSplit(
+      scanNodeId, exec::Split(makeHiveConnectorSplit(filePath->getPath())));
+  task->noMoreSplits(scanNodeId);
+
+  std::vector<RowVectorPtr> results;
+  while (auto result = task->next()) {
+    for (auto& child : result->children()) {
+      child->loadedVector();
+    }
+    results.push_back(result);
+  }
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  assertEqualResults(
+      {makeRowVector({"p0"}, {makeFlatVector<int64_t>({10, 20, 30})})},
+      results);
+
+  const auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(scanNodeId).dynamicFilterStats.producerNodeIds,
+      std::unordered_set<core::PlanNodeId>{joinNodeId});
+}
+
 TEST_F(TaskTest, driverCreationMemoryAllocationCheck) {
   exec::Operator::registerOperator(std::make_unique<TestBadMemoryTranslator>());
   auto data = makeRowVector({
@@ -1616,6 +1780,43 @@ TEST_F(TaskTest, spillDirectoryLifecycleManagement) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(TaskTest, spillConfigTemplate) {
+  auto queryCtx = core::QueryCtx::create();
+  queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kSpillEnabled, "true"},
+       {core::QueryConfig::kMaxSpillLevel, "2"}});
+  auto plan = PlanBuilder()
+                  .values({makeRowVector({makeFlatVector<int64_t>({1, 2})})})
+                  .planNode();
+  auto task = Task::create(
+      "spill.config.task",
+      core::PlanFragment{plan},
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kSerial);
+  auto rootTempDir = exec::test::TempDirectoryPath::create();
+  const auto spillDirectory = rootTempDir->getPath() + "/spillConfigTemplate";
+  task->setSpillDirectory(spillDirectory, false);
+
+  DriverCtx firstCtx(task, 1, 2, kUngroupedGroupId, 1);
+  DriverCtx secondCtx(task, 3, 4, kUngroupedGroupId, 3);
+  auto first = firstCtx.makeSpillConfig(5);
+  auto second = secondCtx.makeSpillConfig(6);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ("2_1_5", first->fileNamePrefix);
+  EXPECT_EQ("4_3_6", second->fileNamePrefix);
+  EXPECT_EQ(2, first->maxSpillLevel);
+  EXPECT_EQ(2, second->maxSpillLevel);
+  EXPECT_TRUE(task->spillConfigTemplate().fileNamePrefix.empty());
+
+  // The directory is created on the first use.
+  auto fs = filesystems::getFileSystem(spillDirectory, nullptr);
+  EXPECT_FALSE(fs->exists(spillDirectory));
+  EXPECT_EQ(spillDirectory, first->getSpillDirPathCb());
+  EXPECT_TRUE(fs->exists(spillDirectory));
+}
+
 TEST_F(TaskTest, spillDirNotCreated) {
   // Verify that no spill directory is created if spilling is not engaged.
   const std::vector<RowVectorPtr> probeVectors = {makeRowVector(
@@ -2094,4 +2295,169 @@ DEBUG_ONLY_TEST_F(TaskTest, taskReclaimFailure) {
               "SELECT c0, c1, array_agg(c2) FROM tmp GROUP BY c0, c1"),
       spillTableError);
 }
+
+TEST_F(TaskTest, addDrivers) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  std::vector<std::shared_ptr<TempFilePath>> files;
+  for (auto i = 0; i < 4; ++i) {
+    files.push_back(TempFilePath::create());
+    writeToFile(files.back()->getPath(), {data});
+  }
+
+  core::PlanNodeId scanId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localPartition(
+                      {},
+                      {PlanBuilder(planNodeIdGenerator)
+                           .tableScan(asRowType(data->type()))
+                           .capturePlanNodeId(scanId)
+                           .project({"c0 + 1 AS c0"})
+                           .planNode()})
+                  .singleAggregation({}, {"count(1)", "sum(c0)"})
+                  .planNode();
+
+  CursorParameters params;
+  params.planNode = plan;
+  params.queryCtx = core::QueryCtx::create(driverExecutor_.get());
+  params.maxDrivers = 1;
+  auto cursor = TaskCursor::create(params);
+  auto task = cursor->task();
+  cursor->start();
+  ASSERT_EQ(2, task->numTotalDrivers());
+
+  task->addSplit(
+      scanId, exec::Split(makeHiveConnectorSplit(files[0]->getPath())));
+
+  // Only the scan pipeline can grow. The aggregation pipeline has no scan.
+  uint32_t numAdded = 0;
+  for (auto pipelineId = 0; pipelineId < 3; ++pipelineId) {
+    numAdded += task->addDrivers(pipelineId, 2);
+  }
+  ASSERT_EQ(2, numAdded);
+  ASSERT_EQ(4, task->numTotalDrivers());
+
+  for (auto i = 1; i < files.size(); ++i) {
+    task->addSplit(
+        scanId, exec::Split(makeHiveConnectorSplit(files[i]->getPath())));
+  }
+  task->noMoreSplits(scanId);
+
+  std::vector<RowVectorPtr> results;
+  while (cursor->moveNext()) {
+    results.push_back(cursor->current());
+  }
+  assertEqualResults(
+      {makeRowVector({
+          makeFlatVector<int64_t>(std::vector<int64_t>{4'000}),
+          makeFlatVector<int64_t>(std::vector<int64_t>{4 * 500'500}),
+      })},
+      results);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  // No drivers are added once the splits are done.
+  for (auto pipelineId = 0; pipelineId < 3; ++pipelineId) {
+    ASSERT_EQ(0, task->addDrivers(pipelineId, 2));
+  }
+}
+
+TEST_F(TaskTest, driverTrace) {
+  DriverTrace trace(0, 0, {"Values.0"}, 3);
+  for (auto i = 0; i < 5; ++i) {
+    trace.record(
+        0, kOpMethodGetOutput, i * 10, i * 10 + 5, BlockingReason::kNotBlocked);
+  }
+  auto events = trace.events();
+  ASSERT_EQ(3, events.size());
+  ASSERT_EQ(2, trace.numDropped());
+  for (auto i = 0; i < events.size(); ++i) {
+    ASSERT_EQ((i + 2) * 10, events[i].startUs);
+    ASSERT_EQ(5, events[i].endUs - events[i].startUs);
+  }
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .filter("c0 % 2 = 0")
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kDriverTraceCapacity, "16")
+      .copyResults(pool(), task);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  auto json = folly::parseJson(task->toChromeTrace());
+  const auto& traceEvents = json["traceEvents"];
+  ASSERT_GT(traceEvents.size(), 0);
+  ASSERT_LE(traceEvents.size(), 16);
+  bool hasGetOutput = false;
+  for (const auto& event : traceEvents) {
+    ASSERT_EQ("X", event["ph"].asString());
+    ASSERT_GE(event["dur"].asInt(), 0);
+    hasGetOutput |= event["cat"].asString() == kOpMethodGetOutput;
+  }
+  ASSERT_TRUE(hasGetOutput);
+
+  // No events without the config.
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(0, folly::parseJson(task->toChromeTrace())["traceEvents"].size());
+}
+
+TEST_F(TaskTest, hashBuildAdmission) {
+  auto probe = makeRowVector(
+      {"t0"}, {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  auto build = [&](const std::string& name) {
+    return makeRowVector(
+        {name}, {makeFlatVector<int64_t>(50, [](auto row) { return row; })});
+  };
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({probe})
+          .hashJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator).values({build("u0")}).planNode(),
+              "",
+              {"t0"})
+          .hashJoin(
+              {"t0"},
+              {"v0"},
+              PlanBuilder(planNodeIdGenerator).values({build("v0")}).planNode(),
+              "",
+              {"t0", "v0"})
+          .planNode();
+  auto keys = makeFlatVector<int64_t>(50, [](auto row) { return row; });
+  auto expected = makeRowVector({keys, keys});
+
+  // The second build starts after the first one finishes.
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kHashBuildAdmissionMemoryPct, "50")
+                  .maxDrivers(2)
+                  .assertResults(expected);
+  ASSERT_EQ(1, task->taskStats().numDeferredPipelineStarts);
+
+  task = AssertQueryBuilder(plan).maxDrivers(2).assertResults(expected);
+  ASSERT_EQ(0, task->taskStats().numDeferredPipelineStarts);
+
+  // With join spilling, the first build waits for its probe, which waits for
+  // the second build. No build is deferred.
+  auto spillDirectory = TempDirectoryPath::create();
+  task = AssertQueryBuilder(plan)
+             .config(core::QueryConfig::kHashBuildAdmissionMemoryPct, "50")
+             .config(core::QueryConfig::kSpillEnabled, "true")
+             .config(core::QueryConfig::kJoinSpillEnabled, "true")
+             .spillDirectory(spillDirectory->getPath())
+             .maxDrivers(2)
+             .assertResults(expected);
+  ASSERT_EQ(0, task->taskStats().numDeferredPipelineStarts);
+}
 } // namespace facebook::velox::exec::test
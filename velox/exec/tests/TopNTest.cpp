@@ -234,6 +234,40 @@ TEST_F(TopNTest, multiBatch) {
   testSingleKey(vectors, "c2", 2'500);
 }
 
+TEST_F(TopNTest, thresholdFilter) {
+  // Once TopN has 'limit' rows, the input rows whose first key goes after the
+  // first key of the Nth row are dropped before the row comparison. Covers the
+  // supported key types, flat and dictionary encoded keys and ties on the
+  // first key.
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    const auto offset = (i % 2 == 0 ? 1 : -1) * i * batchSize;
+    VectorPtr c0 = makeFlatVector<int16_t>(
+        batchSize,
+        [&](auto row) { return (offset + row) % 300; },
+        nullEvery(7));
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return offset + row; });
+    VectorPtr c2 = makeFlatVector<float>(
+        batchSize, [&](auto row) { return (offset + row) * 0.5; });
+    auto c3 = makeFlatVector<Timestamp>(
+        batchSize, [&](auto row) { return Timestamp(offset + row, row); });
+    if (i % 2 == 1) {
+      auto indices = makeIndicesInReverse(batchSize);
+      c0 = wrapInDictionary(indices, c0);
+      c2 = wrapInDictionary(indices, c2);
+    }
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testTwoKeys(vectors, "c0", "c1", 100);
+  testSingleKey(vectors, "c1", 100);
+  testSingleKey(vectors, "c2", 100);
+  testSingleKey(vectors, "c3", 100);
+}
+
 TEST_F(TopNTest, empty) {
   vector_size_t batchSize = 1'000;
   std::vector<RowVectorPtr> vectors;
@@ -252,3 +252,36 @@ TEST_F(TreeOfLosersTest, randomWithDuplicates) {
     }
   }
 }
+
+TEST_F(TreeOfLosersTest, runnerUp) {
+  constexpr int32_t kNumStreams = 13;
+  constexpr int32_t kNumValues = 100'000;
+  // Consecutive values go to the same stream in blocks of random size, so
+  // that the streams have runs of various length.
+  std::vector<std::vector<uint32_t>> streams(kNumStreams);
+  for (auto i = kNumValues - 1; i >= 0;) {
+    auto& stream = streams[folly::Random::rand32(kNumStreams, rng_)];
+    const int32_t blockSize = 1 + folly::Random::rand32(50, rng_);
+    for (auto j = 0; j < blockSize && i >= 0; ++j, --i) {
+      stream.push_back(i);
+    }
+  }
+  std::vector<std::unique_ptr<TestingStream>> mergeStreams;
+  for (auto& stream : streams) {
+    mergeStreams.push_back(std::make_unique<TestingStream>(std::move(stream)));
+  }
+  TreeOfLosers<TestingStream> merge(std::move(mergeStreams));
+  ASSERT_TRUE(merge.runnerUp() == nullptr);
+  uint32_t expected = 0;
+  while (auto* stream = merge.next()) {
+    auto* limit = merge.runnerUp();
+    ASSERT_NE(limit, stream);
+    // Takes the values of 'stream' up to the first value of 'limit'.
+    do {
+      ASSERT_EQ(stream->current()->value(), expected++);
+      stream->pop();
+    } while (stream->hasData() &&
+             (limit == nullptr || !(*limit < *stream)));
+  }
+  ASSERT_EQ(expected, kNumValues);
+}
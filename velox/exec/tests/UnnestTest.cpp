@@ -424,7 +424,7 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output splits every few input rows across two batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +432,11 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits each input row and unnests 2 elements at a
+  // time.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +444,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(15'000, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +459,47 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, splitLargeArray) {
+  // One row with 10K elements of ARRAY(ROW(BIGINT, VARCHAR)) between two small
+  // rows.
+  std::vector<vector_size_t> sizes = {3, 10'000, 0, 5};
+  const vector_size_t numElements = 10'008;
+  auto elements = makeRowVector({
+      makeFlatVector<int64_t>(numElements, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          numElements, [](auto row) { return fmt::format("e{}", row); }),
+  });
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>({0, 1, 2, 3}),
+      makeArrayVector({0, 3, 10'003, 10'003}, elements),
+  });
+
+  std::vector<int32_t> rows;
+  std::vector<int64_t> ordinals;
+  for (auto row = 0; row < sizes.size(); ++row) {
+    for (auto i = 0; i < sizes[row]; ++i) {
+      rows.push_back(row);
+      ordinals.push_back(i + 1);
+    }
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(rows),
+      elements,
+      makeFlatVector<int64_t>(ordinals),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+                  .assertResults({expected});
+  auto stats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(numElements, stats.at(unnestId).outputRows);
+  ASSERT_EQ(11, stats.at(unnestId).outputVectors);
+}
@@ -1008,6 +1008,58 @@ TEST_F(VectorHasherTest, simdRange) {
   }
 }
 
+TEST_F(VectorHasherTest, simdRangeMultiKey) {
+  // Tests that computeValueIds() packs several range mapped keys into one
+  // normalized key when the later keys have a multiplier > 1.
+  constexpr int32_t kNumRows = 1001;
+  using exec::VectorHasher;
+
+  auto smallValues =
+      makeFlatVector<int16_t>(kNumRows, [](auto i) { return i % 17; });
+  auto intValues =
+      makeFlatVector<int32_t>(kNumRows, [](auto i) { return 100 + i % 23; });
+  auto int64Values =
+      makeFlatVector<int64_t>(kNumRows, [](auto i) { return -5 + i % 31; });
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(VectorHasher::create(SMALLINT(), 0));
+  hashers.push_back(VectorHasher::create(INTEGER(), 1));
+  hashers.push_back(VectorHasher::create(BIGINT(), 2));
+  std::vector<VectorPtr> vectors = {smallValues, intValues, int64Values};
+
+  SelectivityVector rows(kNumRows);
+  raw_vector<uint64_t> result(kNumRows);
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->decode(*vectors[i], rows);
+    hashers[i]->computeValueIds(rows, result);
+  }
+  auto multiplier1 = hashers[0]->enableValueRange(1, 0);
+  auto multiplier2 = hashers[1]->enableValueRange(multiplier1, 0);
+  auto multiplier3 = hashers[2]->enableValueRange(multiplier2, 0);
+  EXPECT_EQ(18 * 24 * 32, multiplier3);
+
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->decode(*vectors[i], rows);
+    ASSERT_TRUE(hashers[i]->computeValueIds(rows, result));
+  }
+  for (auto i = 0; i < kNumRows; ++i) {
+    EXPECT_EQ(
+        smallValues->valueAt(i) + 1 +
+            (intValues->valueAt(i) - 100 + 1) * multiplier1 +
+            (int64Values->valueAt(i) + 5 + 1) * multiplier2,
+        result[i]);
+  }
+
+  // A value out of range in a later key fails the mapping.
+  int64Values->set(kNumRows - 1, 1000);
+  hashers[0]->decode(*vectors[0], rows);
+  ASSERT_TRUE(hashers[0]->computeValueIds(rows, result));
+  hashers[1]->decode(*vectors[1], rows);
+  ASSERT_TRUE(hashers[1]->computeValueIds(rows, result));
+  hashers[2]->decode(*vectors[2], rows);
+  EXPECT_FALSE(hashers[2]->computeValueIds(rows, result));
+}
+
 TEST_F(VectorHasherTest, typeMismatch) {
   auto hasher = VectorHasher::create(BIGINT(), 0);
 
@@ -15,6 +15,7 @@
  */
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -23,6 +24,7 @@
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
 using namespace facebook::velox::exec::test;
+using namespace facebook::velox::common::testutil;
 
 namespace facebook::velox::exec {
 
@@ -79,6 +81,201 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+DEBUG_ONLY_TEST_F(WindowTest, reclaimDuringOutputProcessing) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 11; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  std::atomic_bool noMoreInput{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::noMoreInput",
+      std::function<void(Operator*)>(([&](Operator* op) {
+        if (op->operatorType() == "Window") {
+          noMoreInput = true;
+        }
+      })));
+
+  // Spill in the middle of the output of a partition.
+  std::atomic_int numOutputs{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::getOutput",
+      std::function<void(Operator*)>(([&](Operator* op) {
+        if (op->operatorType() != "Window" || !noMoreInput) {
+          return;
+        }
+        if (++numOutputs != 3) {
+          return;
+        }
+        memory::testingRunArbitration(op->pool());
+      })));
+
+  // 'sum' reads rows of the whole partition, including the rows output before
+  // spilling.
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s rows between "
+      "unbounded preceding and unbounded following)"};
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto spillDirectory = TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "10")
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kWindowSpillEnabled, "true")
+          .spillDirectory(spillDirectory->getPath())
+          .maxDrivers(1)
+          .assertResults(fmt::format(
+              "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(windowId);
+  ASSERT_GE(numOutputs, 3);
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.spilledFiles, 0);
+}
+
+TEST_F(WindowTest, segmentTree) {
+  const vector_size_t size = 5'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 101; }, nullEvery(7)),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 3; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  std::vector<std::string> functions;
+  for (const auto& frame :
+       {"rows between 1000 preceding and current row",
+        "rows between 100 preceding and 500 following",
+        "rows between current row and 300 following"}) {
+    for (const auto& aggregate :
+         {"sum(d)", "count(d)", "count(*)", "avg(d)", "min(d)", "max(d)"}) {
+      functions.push_back(fmt::format(
+          "{} over (partition by p order by s {})", aggregate, frame));
+    }
+  }
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .planNode();
+
+  // 0 computes each frame from its rows and 1 always uses the segment tree.
+  for (const auto& minFrameSize : {"0", "1", "64"}) {
+    SCOPED_TRACE(minFrameSize);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kWindowSegmentTreeMinFrameSize, minFrameSize)
+        .assertResults(fmt::format(
+            "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+  }
+}
+
+TEST_F(WindowTest, parallelApply) {
+  const vector_size_t size = 2'000;
+  auto data = makeRowVector(
+      {"d", "p", "s", "v"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 7; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+          // String payload for functions that allocate out of line.
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) { return fmt::format("payload string {}", row); }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by d)",
+      "sum(d) over (partition by p order by s rows between "
+      "10 preceding and current row)",
+      "min(v) over (partition by p order by s rows between "
+      "current row and 5 following)",
+      "max(v) over (partition by p)"};
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kWindowParallelApplyMinRows, "1")
+      .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+      .assertResults(fmt::format(
+          "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+}
+
+TEST_F(WindowTest, rowsStreaming) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload. Same for the peers, so that the results do not depend
+          // on the order of the peers.
+          makeFlatVector<int64_t>(
+              size,
+              [](auto row) { return row / 7 % 13; },
+              [](auto row) { return row / 7 % 5 == 0; }),
+          // Partition key with a large and a small partition.
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return row < 9'000 ? 0 : 1; }),
+          // Sorting key with peers across output blocks.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 7; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by s)",
+      "dense_rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s rows between "
+      "unbounded preceding and current row)",
+      "count(d) over (partition by p order by s rows between "
+      "20 preceding and current row)",
+      "max(d) over (partition by p order by s rows between "
+      "5 preceding and 2 preceding)"};
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .orderBy({"p", "s"}, false)
+                  .streamingWindow(functions)
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+      .assertResults(fmt::format(
+          "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+namespace {
+
+TEST(WorkStealingExecutorTest, runsAll) {
+  std::atomic<int32_t> count{0};
+  {
+    WorkStealingExecutor executor(4);
+    ASSERT_EQ(-1, executor.currentThreadIndex());
+    for (auto i = 0; i < 1'000; ++i) {
+      executor.add([&]() {
+        ++count;
+        // Tasks added from a thread of the executor.
+        executor.add([&]() { ++count; });
+      });
+    }
+    // The destructor runs the queued tasks.
+  }
+  ASSERT_EQ(2'000, count);
+}
+
+TEST(WorkStealingExecutorTest, priority) {
+  std::vector<int32_t> order;
+  folly::Baton<> started;
+  folly::Baton<> release;
+  {
+    WorkStealingExecutor executor(1);
+    executor.add([&]() {
+      started.post();
+      release.wait();
+    });
+    started.wait();
+    for (auto i = 0; i < 3; ++i) {
+      executor.add([&, i]() { order.push_back(i); });
+    }
+    executor.addWithPriority(
+        [&]() { order.push_back(100); }, folly::Executor::HI_PRI);
+    release.post();
+  }
+  ASSERT_EQ((std::vector<int32_t>{100, 0, 1, 2}), order);
+}
+
+TEST(WorkStealingExecutorTest, priorityLevels) {
+  std::vector<int32_t> order;
+  folly::Baton<> started;
+  folly::Baton<> release;
+  {
+    WorkStealingExecutor executor(1, 4);
+    ASSERT_EQ(4, executor.getNumPriorities());
+    executor.add([&]() {
+      started.post();
+      release.wait();
+    });
+    started.wait();
+    // 0 and below map to levels 1, 2 and 3. Everything below -1 goes to the
+    // lowest level.
+    for (int8_t priority : {-5, -1, -2, 0, folly::Executor::HI_PRI}) {
+      executor.addWithPriority(
+          [&, priority]() { order.push_back(priority); }, priority);
+    }
+    release.post();
+  }
+  ASSERT_EQ(
+      (std::vector<int32_t>{folly::Executor::HI_PRI, 0, -1, -5, -2}), order);
+}
+
+TEST(WorkStealingExecutorTest, steal) {
+  WorkStealingExecutor executor(2);
+  folly::Baton<> started;
+  folly::Baton<> release;
+  int32_t busyIndex = -1;
+  executor.add([&]() {
+    busyIndex = executor.currentThreadIndex();
+    started.post();
+    release.wait();
+  });
+  started.wait();
+
+  // The task added to the busy thread is taken by the other thread.
+  folly::Baton<> done;
+  int32_t threadIndex = -1;
+  const auto numSteals = executor.numSteals();
+  executor.add(
+      [&]() {
+        threadIndex = executor.currentThreadIndex();
+        done.post();
+      },
+      folly::Executor::MID_PRI,
+      busyIndex);
+  ASSERT_TRUE(done.try_wait_for(std::chrono::seconds(10)));
+  ASSERT_EQ(1 - busyIndex, threadIndex);
+  ASSERT_EQ(numSteals + 1, executor.numSteals());
+  release.post();
+}
+
+} // namespace
@@ -1177,6 +1177,32 @@ PlanBuilder& PlanBuilder::partitionedOutput(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::partitionedOutputWithSkew(
+    const std::vector<std::string>& keys,
+    int numPartitions,
+    core::PartitionedOutputNode::SkewHandling skewHandling,
+    int skewFanout,
+    const std::vector<std::string>& outputLayout) {
+  VELOX_CHECK_NOT_NULL(
+      planNode_, "PartitionedOutput cannot be the source node");
+  auto keyExprs = exprs(keys, planNode_->outputType());
+  auto outputType = outputLayout.empty()
+      ? planNode_->outputType()
+      : extract(planNode_->outputType(), outputLayout);
+  planNode_ = std::make_shared<core::PartitionedOutputNode>(
+      nextPlanNodeId(),
+      core::PartitionedOutputNode::Kind::kPartitioned,
+      keyExprs,
+      numPartitions,
+      false,
+      createPartitionFunctionSpec(planNode_->outputType(), keyExprs, pool_),
+      outputType,
+      planNode_,
+      skewHandling,
+      skewFanout);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::partitionedOutputBroadcast(
     const std::vector<std::string>& outputLayout) {
   VELOX_CHECK_NOT_NULL(
@@ -1381,7 +1407,8 @@ PlanBuilder& PlanBuilder::mergeJoin(
     const core::PlanNodePtr& build,
     const std::string& filter,
     const std::vector<std::string>& outputLayout,
-    core::JoinType joinType) {
+    core::JoinType joinType,
+    std::optional<core::MergeJoinNode::Band> band) {
   VELOX_CHECK_NOT_NULL(planNode_, "MergeJoin cannot be the source node");
   VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
 
@@ -1404,7 +1431,8 @@ PlanBuilder& PlanBuilder::mergeJoin(
       std::move(filterExpr),
       std::move(planNode_),
       build,
-      outputType);
+      outputType,
+      band);
   return *this;
 }
 
@@ -759,6 +759,20 @@ class PlanBuilder {
       core::PartitionFunctionSpecPtr partitionFunctionSpec,
       const std::vector<std::string>& outputLayout = {});
 
+  /// Adds a PartitionedOutputNode to hash-partition the input on the specified
+  /// keys with handling of skewed keys.
+  ///
+  /// @param skewHandling kSpread to spread the rows of hot keys over
+  /// 'skewFanout' partitions, kReplicate to send each row to 'skewFanout'
+  /// partitions. The probe and build sides of a join with skewed keys use
+  /// kSpread and kReplicate with the same 'skewFanout'.
+  PlanBuilder& partitionedOutputWithSkew(
+      const std::vector<std::string>& keys,
+      int numPartitions,
+      core::PartitionedOutputNode::SkewHandling skewHandling,
+      int skewFanout,
+      const std::vector<std::string>& outputLayout = {});
+
   /// Adds a PartitionedOutputNode to broadcast the input data.
   ///
   /// @param outputLayout Optional output layout in case it is different then
@@ -841,14 +855,17 @@ class PlanBuilder {
   /// sorted in ascending order on the join keys. If that's not the case, the
   /// query may produce incorrect results.
   ///
-  /// See hashJoin method for the description of the parameters.
+  /// See hashJoin method for the description of the parameters. If 'band' is
+  /// set, the last pair of keys is matched on a range. See
+  /// core::MergeJoinNode.
   PlanBuilder& mergeJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
       const core::PlanNodePtr& build,
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
-      core::JoinType joinType = core::JoinType::kInner);
+      core::JoinType joinType = core::JoinType::kInner,
+      std::optional<core::MergeJoinNode::Band> band = std::nullopt);
 
   /// Add a NestedLoopJoinNode to join two inputs using filter as join
   /// condition to perform equal/non-equal join. Only supports inner/outer
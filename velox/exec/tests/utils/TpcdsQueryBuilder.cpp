@@ -0,0 +1,908 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+#include <fstream>
+
+namespace facebook::velox::exec::test {
+
+namespace {
+// Aggregates of the store sales columns in Q7 and Q27.
+const std::vector<std::string> kStoreSalesAverages = {
+    "avg(ss_quantity) as agg1",
+    "avg(ss_list_price) as agg2",
+    "avg(ss_coupon_amt) as agg3",
+    "avg(ss_sales_price) as agg4"};
+
+const std::vector<std::string> kDemographicsFilters = {
+    "cd_gender = 'M'",
+    "cd_marital_status = 'S'",
+    "cd_education_status = 'College'"};
+} // namespace
+
+const std::unordered_map<std::string, std::vector<std::string>>
+    TpcdsQueryBuilder::kTables_ = {
+        {TpcdsQueryBuilder::kDateDim,
+         {"d_date_sk",
+          "d_date_id",
+          "d_date",
+          "d_month_seq",
+          "d_week_seq",
+          "d_quarter_seq",
+          "d_year",
+          "d_dow",
+          "d_moy",
+          "d_dom",
+          "d_qoy",
+          "d_fy_year",
+          "d_fy_quarter_seq",
+          "d_fy_week_seq",
+          "d_day_name",
+          "d_quarter_name",
+          "d_holiday",
+          "d_weekend",
+          "d_following_holiday",
+          "d_first_dom",
+          "d_last_dom",
+          "d_same_day_ly",
+          "d_same_day_lq",
+          "d_current_day",
+          "d_current_week",
+          "d_current_month",
+          "d_current_quarter",
+          "d_current_year"}},
+        {TpcdsQueryBuilder::kItem,
+         {"i_item_sk",
+          "i_item_id",
+          "i_rec_start_date",
+          "i_rec_end_date",
+          "i_item_desc",
+          "i_current_price",
+          "i_wholesale_cost",
+          "i_brand_id",
+          "i_brand",
+          "i_class_id",
+          "i_class",
+          "i_category_id",
+          "i_category",
+          "i_manufact_id",
+          "i_manufact",
+          "i_size",
+          "i_formulation",
+          "i_color",
+          "i_units",
+          "i_container",
+          "i_manager_id",
+          "i_product_name"}},
+        {TpcdsQueryBuilder::kStore,
+         {"s_store_sk",
+          "s_store_id",
+          "s_rec_start_date",
+          "s_rec_end_date",
+          "s_closed_date_sk",
+          "s_store_name",
+          "s_number_employees",
+          "s_floor_space",
+          "s_hours",
+          "s_manager",
+          "s_market_id",
+          "s_geography_class",
+          "s_market_desc",
+          "s_market_manager",
+          "s_division_id",
+          "s_division_name",
+          "s_company_id",
+          "s_company_name",
+          "s_street_number",
+          "s_street_name",
+          "s_street_type",
+          "s_suite_number",
+          "s_city",
+          "s_county",
+          "s_state",
+          "s_zip",
+          "s_country",
+          "s_gmt_offset",
+          "s_tax_precentage"}},
+        {TpcdsQueryBuilder::kPromotion,
+         {"p_promo_sk",
+          "p_promo_id",
+          "p_start_date_sk",
+          "p_end_date_sk",
+          "p_item_sk",
+          "p_cost",
+          "p_response_target",
+          "p_promo_name",
+          "p_channel_dmail",
+          "p_channel_email",
+          "p_channel_catalog",
+          "p_channel_tv",
+          "p_channel_radio",
+          "p_channel_press",
+          "p_channel_event",
+          "p_channel_demo",
+          "p_channel_details",
+          "p_purpose",
+          "p_discount_active"}},
+        {TpcdsQueryBuilder::kCustomerDemographics,
+         {"cd_demo_sk",
+          "cd_gender",
+          "cd_marital_status",
+          "cd_education_status",
+          "cd_purchase_estimate",
+          "cd_credit_rating",
+          "cd_dep_count",
+          "cd_dep_employed_count",
+          "cd_dep_college_count"}},
+        {TpcdsQueryBuilder::kStoreSales,
+         {"ss_sold_date_sk",
+          "ss_sold_time_sk",
+          "ss_item_sk",
+          "ss_customer_sk",
+          "ss_cdemo_sk",
+          "ss_hdemo_sk",
+          "ss_addr_sk",
+          "ss_store_sk",
+          "ss_promo_sk",
+          "ss_ticket_number",
+          "ss_quantity",
+          "ss_wholesale_cost",
+          "ss_list_price",
+          "ss_sales_price",
+          "ss_ext_discount_amt",
+          "ss_ext_sales_price",
+          "ss_ext_wholesale_cost",
+          "ss_ext_list_price",
+          "ss_ext_tax",
+          "ss_coupon_amt",
+          "ss_net_paid",
+          "ss_net_paid_inc_tax",
+          "ss_net_profit"}},
+        {TpcdsQueryBuilder::kWebSales,
+         {"ws_sold_date_sk",
+          "ws_sold_time_sk",
+          "ws_ship_date_sk",
+          "ws_item_sk",
+          "ws_bill_customer_sk",
+          "ws_bill_cdemo_sk",
+          "ws_bill_hdemo_sk",
+          "ws_bill_addr_sk",
+          "ws_ship_customer_sk",
+          "ws_ship_cdemo_sk",
+          "ws_ship_hdemo_sk",
+          "ws_ship_addr_sk",
+          "ws_web_page_sk",
+          "ws_web_site_sk",
+          "ws_ship_mode_sk",
+          "ws_warehouse_sk",
+          "ws_promo_sk",
+          "ws_order_number",
+          "ws_quantity",
+          "ws_wholesale_cost",
+          "ws_list_price",
+          "ws_sales_price",
+          "ws_ext_discount_amt",
+          "ws_ext_sales_price",
+          "ws_ext_wholesale_cost",
+          "ws_ext_list_price",
+          "ws_ext_tax",
+          "ws_coupon_amt",
+          "ws_ext_ship_cost",
+          "ws_net_paid",
+          "ws_net_paid_inc_tax",
+          "ws_net_paid_inc_ship",
+          "ws_net_paid_inc_ship_tax",
+          "ws_net_profit"}},
+        {TpcdsQueryBuilder::kInventory,
+         {"inv_date_sk",
+          "inv_item_sk",
+          "inv_warehouse_sk",
+          "inv_quantity_on_hand"}}};
+
+void TpcdsQueryBuilder::readFileSchema(
+    const std::string& tableName,
+    const std::string& filePath,
+    const std::vector<std::string>& columns) {
+  dwio::common::ReaderOptions readerOptions{pool_.get()};
+  readerOptions.setFileFormat(format_);
+  std::shared_ptr<ReadFile> readFile =
+      filesystems::getFileSystem(filePath, nullptr)->openFileForRead(filePath);
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.getMemoryPool());
+  auto reader = dwio::common::getReaderFactory(readerOptions.getFileFormat())
+                    ->createReader(std::move(input), readerOptions);
+  const auto& fileType = reader->rowType();
+  // There can be extra columns in the file towards the end.
+  VELOX_CHECK_GE(fileType->size(), columns.size());
+  auto& metadata = tableMetadata_[tableName];
+  for (auto i = 0; i < columns.size(); ++i) {
+    metadata.fileColumnNames[columns[i]] = fileType->nameOf(i);
+  }
+  auto types = fileType->children();
+  types.resize(columns.size());
+  metadata.type = ROW(std::vector<std::string>(columns), std::move(types));
+}
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  for (const auto& [tableName, columns] : kTables_) {
+    const fs::path tablePath{dataPath + "/" + tableName};
+    std::error_code error;
+    bool anyFound = false;
+    for (auto const& dirEntry : fs::directory_iterator{
+             tablePath, std::filesystem::directory_options(), error}) {
+      if (!dirEntry.is_regular_file()) {
+        continue;
+      }
+      // Ignore hidden files.
+      if (dirEntry.path().filename().c_str()[0] == '.') {
+        continue;
+      }
+      if (tableMetadata_[tableName].dataFiles.empty()) {
+        anyFound = true;
+        readFileSchema(tableName, dirEntry.path().string(), columns);
+      }
+      tableMetadata_[tableName].dataFiles.push_back(dirEntry.path());
+    }
+    if (!anyFound && error) {
+      std::ifstream file(tablePath);
+      std::string line;
+      while (std::getline(file, line)) {
+        if (tableMetadata_[tableName].dataFiles.empty()) {
+          readFileSchema(tableName, line, columns);
+        }
+        tableMetadata_[tableName].dataFiles.push_back(line);
+      }
+    }
+  }
+}
+
+// static
+const std::vector<int32_t>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int32_t> kQueryIds = {3, 7, 12, 22, 27, 36, 89, 98};
+  return kQueryIds;
+}
+
+TpchPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 12:
+      return getQ12Plan();
+    case 22:
+      return getQ22Plan();
+    case 27:
+      return getQ27Plan();
+    case 36:
+      return getQ36Plan();
+    case 89:
+      return getQ89Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+PlanBuilder TpcdsQueryBuilder::scan(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    TpchPlan& plan,
+    const std::string& tableName,
+    const std::vector<std::string>& columns,
+    const std::vector<std::string>& subfieldFilters,
+    const std::string& remainingFilter) const {
+  const auto& metadata = tableMetadata_.at(tableName);
+  auto columnSelector =
+      std::make_shared<dwio::common::ColumnSelector>(metadata.type, columns);
+  core::PlanNodeId scanNodeId;
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder
+      .tableScan(
+          tableName,
+          columnSelector->buildSelectedReordered(),
+          metadata.fileColumnNames,
+          subfieldFilters,
+          remainingFilter)
+      .capturePlanNodeId(scanNodeId);
+  plan.dataFiles[scanNodeId] = metadata.dataFiles;
+  return builder;
+}
+
+std::string TpcdsQueryBuilder::dateBetween(
+    const std::string& tableName,
+    const std::string& column,
+    const std::string& lower,
+    const std::string& upper) const {
+  // DWRF does not support the DATE type and stores dates as VARCHAR.
+  const auto suffix =
+      tableMetadata_.at(tableName).type->findChild(column)->isVarchar()
+      ? ""
+      : "::DATE";
+  return fmt::format(
+      "{} between {}{} and {}{}", column, lower, suffix, upper, suffix);
+}
+
+TpchPlan TpcdsQueryBuilder::getQ3Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto items = scan(planNodeIdGenerator,
+                    context,
+                    kItem,
+                    {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+                    {"i_manufact_id = 128"})
+                   .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_year", "d_moy"},
+                    {"d_moy = 11"})
+                   .planNode();
+
+  context.plan =
+      scan(planNodeIdGenerator,
+           context,
+           kStoreSales,
+           {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) as sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "sum_agg DESC", "i_brand_id"}, 100, false)
+          .project(
+              {"d_year",
+               "i_brand_id as brand_id",
+               "i_brand as brand",
+               "sum_agg"})
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ7Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto demographics = scan(planNodeIdGenerator,
+                           context,
+                           kCustomerDemographics,
+                           {"cd_demo_sk",
+                            "cd_gender",
+                            "cd_marital_status",
+                            "cd_education_status"},
+                           kDemographicsFilters)
+                          .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_year"},
+                    {"d_year = 2000"})
+                   .planNode();
+  auto promotions =
+      scan(planNodeIdGenerator,
+           context,
+           kPromotion,
+           {"p_promo_sk", "p_channel_email", "p_channel_event"},
+           {},
+           "p_channel_email = 'N' or p_channel_event = 'N'")
+          .planNode();
+  auto items =
+      scan(planNodeIdGenerator, context, kItem, {"i_item_sk", "i_item_id"})
+          .planNode();
+
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+
+  context.plan = scan(planNodeIdGenerator,
+                      context,
+                      kStoreSales,
+                      withKeys(
+                          {"ss_sold_date_sk",
+                           "ss_item_sk",
+                           "ss_cdemo_sk",
+                           "ss_promo_sk"}))
+                     .hashJoin(
+                         {"ss_cdemo_sk"},
+                         {"cd_demo_sk"},
+                         demographics,
+                         "",
+                         withKeys(
+                             {"ss_sold_date_sk", "ss_item_sk", "ss_promo_sk"}))
+                     .hashJoin(
+                         {"ss_sold_date_sk"},
+                         {"d_date_sk"},
+                         dates,
+                         "",
+                         withKeys({"ss_item_sk", "ss_promo_sk"}))
+                     .hashJoin(
+                         {"ss_promo_sk"},
+                         {"p_promo_sk"},
+                         promotions,
+                         "",
+                         withKeys({"ss_item_sk"}))
+                     .hashJoin(
+                         {"ss_item_sk"},
+                         {"i_item_sk"},
+                         items,
+                         "",
+                         withKeys({"i_item_id"}))
+                     .partialAggregation({"i_item_id"}, kStoreSalesAverages)
+                     .localPartition(std::vector<std::string>{})
+                     .finalAggregation()
+                     .topN({"i_item_id"}, 100, false)
+                     .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getRevenueRatioPlan(
+    const std::string& salesTable,
+    const std::string& columnPrefix,
+    std::optional<int32_t> limit) const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto soldDate = columnPrefix + "sold_date_sk";
+  const auto itemKey = columnPrefix + "item_sk";
+  const auto salesPrice = columnPrefix + "ext_sales_price";
+  const std::vector<std::string> itemColumns = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+
+  auto items = scan(planNodeIdGenerator,
+                    context,
+                    kItem,
+                    {"i_item_sk",
+                     "i_item_id",
+                     "i_item_desc",
+                     "i_category",
+                     "i_class",
+                     "i_current_price"},
+                    {"i_category in ('Sports', 'Books', 'Home')"})
+                   .planNode();
+  // d_date between '1999-02-22' and '1999-02-22' + interval '30' day.
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_date"},
+                    {dateBetween(
+                        kDateDim, "d_date", "'1999-02-22'", "'1999-03-24'")})
+                   .planNode();
+
+  auto joinOutput = itemColumns;
+  joinOutput.push_back(soldDate);
+  joinOutput.push_back(salesPrice);
+  auto aggregationInput = itemColumns;
+  aggregationInput.push_back(salesPrice);
+
+  const std::vector<std::string> sortingKeys = {
+      "i_category", "i_class", "i_item_id", "i_item_desc", "revenueratio"};
+  auto plan =
+      scan(planNodeIdGenerator,
+           context,
+           salesTable,
+           {soldDate, itemKey, salesPrice})
+          .hashJoin({itemKey}, {"i_item_sk"}, items, "", joinOutput)
+          .hashJoin({soldDate}, {"d_date_sk"}, dates, "", aggregationInput)
+          .partialAggregation(
+              itemColumns,
+              {fmt::format("sum({}) as itemrevenue", salesPrice)})
+          .localPartition({"i_class"})
+          .finalAggregation()
+          .appendColumns({"cast(itemrevenue as double) as revenue"})
+          .window({"sum(revenue) over (partition by i_class) as class_revenue"})
+          .project(
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "itemrevenue",
+               "revenue * 100.0 / class_revenue as revenueratio"})
+          .localPartition(std::vector<std::string>{});
+  if (limit.has_value()) {
+    plan.topN(sortingKeys, limit.value(), false);
+  } else {
+    plan.orderBy(sortingKeys, false);
+  }
+  context.plan = plan.planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ12Plan() const {
+  return getRevenueRatioPlan(kWebSales, "ws_", 100);
+}
+
+TpchPlan TpcdsQueryBuilder::getQ22Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_month_seq"},
+                    {"d_month_seq between 1200 and 1211"})
+                   .planNode();
+  auto items = scan(planNodeIdGenerator,
+                    context,
+                    kItem,
+                    {"i_item_sk",
+                     "i_product_name",
+                     "i_brand",
+                     "i_class",
+                     "i_category"})
+                   .planNode();
+
+  const std::vector<std::string> keys = {
+      "i_product_name", "i_brand", "i_class", "i_category"};
+  auto groupingKeys = keys;
+  groupingKeys.push_back("group_id");
+
+  context.plan =
+      scan(planNodeIdGenerator,
+           context,
+           kInventory,
+           {"inv_date_sk", "inv_item_sk", "inv_quantity_on_hand"})
+          .hashJoin(
+              {"inv_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"inv_item_sk", "inv_quantity_on_hand"})
+          .hashJoin(
+              {"inv_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"inv_quantity_on_hand",
+               "i_product_name",
+               "i_brand",
+               "i_class",
+               "i_category"})
+          // rollup(i_product_name, i_brand, i_class, i_category).
+          .groupId(
+              keys,
+              {keys,
+               {"i_product_name", "i_brand", "i_class"},
+               {"i_product_name", "i_brand"},
+               {"i_product_name"},
+               {}},
+              {"inv_quantity_on_hand"})
+          .partialAggregation(
+              groupingKeys, {"avg(inv_quantity_on_hand) as qoh"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(
+              {"qoh", "i_product_name", "i_brand", "i_class", "i_category"},
+              100,
+              false)
+          .project(
+              {"i_product_name", "i_brand", "i_class", "i_category", "qoh"})
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ27Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto demographics = scan(planNodeIdGenerator,
+                           context,
+                           kCustomerDemographics,
+                           {"cd_demo_sk",
+                            "cd_gender",
+                            "cd_marital_status",
+                            "cd_education_status"},
+                           kDemographicsFilters)
+                          .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_year"},
+                    {"d_year = 2002"})
+                   .planNode();
+  auto stores = scan(planNodeIdGenerator,
+                     context,
+                     kStore,
+                     {"s_store_sk", "s_state"},
+                     {"s_state = 'TN'"})
+                    .planNode();
+  auto items =
+      scan(planNodeIdGenerator, context, kItem, {"i_item_sk", "i_item_id"})
+          .planNode();
+
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+
+  context.plan = scan(planNodeIdGenerator,
+                      context,
+                      kStoreSales,
+                      withKeys(
+                          {"ss_sold_date_sk",
+                           "ss_item_sk",
+                           "ss_store_sk",
+                           "ss_cdemo_sk"}))
+                     .hashJoin(
+                         {"ss_cdemo_sk"},
+                         {"cd_demo_sk"},
+                         demographics,
+                         "",
+                         withKeys(
+                             {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}))
+                     .hashJoin(
+                         {"ss_sold_date_sk"},
+                         {"d_date_sk"},
+                         dates,
+                         "",
+                         withKeys({"ss_item_sk", "ss_store_sk"}))
+                     .hashJoin(
+                         {"ss_store_sk"},
+                         {"s_store_sk"},
+                         stores,
+                         "",
+                         withKeys({"ss_item_sk", "s_state"}))
+                     .hashJoin(
+                         {"ss_item_sk"},
+                         {"i_item_sk"},
+                         items,
+                         "",
+                         withKeys({"i_item_id", "s_state"}))
+                     // rollup(i_item_id, s_state).
+                     .groupId(
+                         {"i_item_id", "s_state"},
+                         {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+                         measures)
+                     .partialAggregation(
+                         {"i_item_id", "s_state", "group_id"},
+                         kStoreSalesAverages)
+                     .localPartition(std::vector<std::string>{})
+                     .finalAggregation()
+                     .topN({"i_item_id", "s_state"}, 100, false)
+                     .project(
+                         {"i_item_id",
+                          "s_state",
+                          "if(group_id = 0, 0, 1) as g_state",
+                          "agg1",
+                          "agg2",
+                          "agg3",
+                          "agg4"})
+                     .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ36Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_year"},
+                    {"d_year = 2001"})
+                   .planNode();
+  auto items =
+      scan(planNodeIdGenerator,
+           context,
+           kItem,
+           {"i_item_sk", "i_category", "i_class"})
+          .planNode();
+  auto stores = scan(planNodeIdGenerator,
+                     context,
+                     kStore,
+                     {"s_store_sk", "s_state"},
+                     {"s_state = 'TN'"})
+                    .planNode();
+
+  // For rollup(i_category, i_class), grouping(i_category) + grouping(i_class)
+  // is the group id and grouping(i_class) is 0 only in the first set.
+  context.plan =
+      scan(planNodeIdGenerator,
+           context,
+           kStoreSales,
+           {"ss_sold_date_sk",
+            "ss_item_sk",
+            "ss_store_sk",
+            "ss_ext_sales_price",
+            "ss_net_profit"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price",
+               "ss_net_profit"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price", "ss_net_profit"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_category", "i_class", "ss_ext_sales_price", "ss_net_profit"})
+          .groupId(
+              {"i_category", "i_class"},
+              {{"i_category", "i_class"}, {"i_category"}, {}},
+              {"ss_ext_sales_price", "ss_net_profit"})
+          .partialAggregation(
+              {"i_category", "i_class", "group_id"},
+              {"sum(ss_net_profit) as net_profit",
+               "sum(ss_ext_sales_price) as ext_sales_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"cast(net_profit as double) / cast(ext_sales_price as double) "
+               "as gross_margin",
+               "i_category",
+               "i_class",
+               "group_id as lochierarchy",
+               "if(group_id = 0, i_category, cast(null as varchar)) "
+               "as parent_category"})
+          .window(
+              {"rank() over (partition by lochierarchy, parent_category "
+               "order by gross_margin) as rank_within_parent"})
+          .topN(
+              {"lochierarchy DESC", "parent_category", "rank_within_parent"},
+              100,
+              false)
+          .project(
+              {"gross_margin",
+               "i_category",
+               "i_class",
+               "lochierarchy",
+               "rank_within_parent"})
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ89Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto items = scan(planNodeIdGenerator,
+                    context,
+                    kItem,
+                    {"i_item_sk", "i_category", "i_class", "i_brand"},
+                    {},
+                    "(i_category in ('Books', 'Electronics', 'Sports') "
+                    "and i_class in ('computers', 'stereo', 'football')) "
+                    "or (i_category in ('Men', 'Jewelry', 'Women') "
+                    "and i_class in ('shirts', 'birdal', 'dresses'))")
+                   .planNode();
+  auto dates = scan(planNodeIdGenerator,
+                    context,
+                    kDateDim,
+                    {"d_date_sk", "d_year", "d_moy"},
+                    {"d_year = 1999"})
+                   .planNode();
+  auto stores =
+      scan(planNodeIdGenerator,
+           context,
+           kStore,
+           {"s_store_sk", "s_store_name", "s_company_name"})
+          .planNode();
+
+  const std::vector<std::string> keys = {
+      "i_category",
+      "i_class",
+      "i_brand",
+      "s_store_name",
+      "s_company_name",
+      "d_moy"};
+  auto withSales = [&](std::vector<std::string> columns) {
+    columns.push_back("ss_sales_price");
+    return columns;
+  };
+
+  context.plan =
+      scan(planNodeIdGenerator,
+           context,
+           kStoreSales,
+           withSales({"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              withSales(
+                  {"ss_sold_date_sk",
+                   "ss_store_sk",
+                   "i_category",
+                   "i_class",
+                   "i_brand"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withSales(
+                  {"ss_store_sk", "i_category", "i_class", "i_brand", "d_moy"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withSales(keys))
+          .partialAggregation(keys, {"sum(ss_sales_price) as sum_sales"})
+          .localPartition(
+              {"i_category", "i_brand", "s_store_name", "s_company_name"})
+          .finalAggregation()
+          .project(
+              {"i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy",
+               "cast(sum_sales as double) as sum_sales"})
+          .window(
+              {"avg(sum_sales) over (partition by i_category, i_brand, "
+               "s_store_name, s_company_name) as avg_monthly_sales"})
+          .filter(
+              "avg_monthly_sales <> 0 and "
+              "abs(sum_sales - avg_monthly_sales) / avg_monthly_sales > 0.1")
+          .appendColumns({"sum_sales - avg_monthly_sales as sales_diff"})
+          .localPartition(std::vector<std::string>{})
+          .topN({"sales_diff", "s_store_name"}, 100, false)
+          .project(
+              {"i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy",
+               "sum_sales",
+               "avg_monthly_sales"})
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ98Plan() const {
+  return getRevenueRatioPlan(kStoreSales, "ss_", std::nullopt);
+}
+
+} // namespace facebook::velox::exec::test
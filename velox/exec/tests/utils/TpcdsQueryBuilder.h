@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Builds plans for a subset of the TPC-DS queries using TPC-DS data files
+/// located in the specified directory. The data layout and the mapping of
+/// the file columns to the standard column names are the same as for
+/// TpchQueryBuilder: one sub-directory or file list per table name, with the
+/// columns in the order of the TPC-DS standard.
+///
+/// The queries are picked for the operators the TPC-H queries do not cover:
+/// window functions (12, 36, 89, 98), grouping sets (22, 27, 36) and star
+/// joins of a fact table with several dimensions (3, 7, 27).
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(dwio::common::FileFormat format)
+      : format_(format) {}
+
+  /// Read each data file, initialize row types, and determine data paths for
+  /// each table.
+  /// @param dataPath path to the data files
+  void initialize(const std::string& dataPath);
+
+  /// Get the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number
+  TpchPlan getQueryPlan(int queryId) const;
+
+  /// Returns the numbers of the queries supported by getQueryPlan().
+  static const std::vector<int32_t>& getQueryIds();
+
+ private:
+  void readFileSchema(
+      const std::string& tableName,
+      const std::string& filePath,
+      const std::vector<std::string>& columns);
+
+  // Returns a builder with a scan of 'columns' of 'tableName' and records the
+  // data files of the scan in 'plan'.
+  PlanBuilder scan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      TpchPlan& plan,
+      const std::string& tableName,
+      const std::vector<std::string>& columns,
+      const std::vector<std::string>& subfieldFilters = {},
+      const std::string& remainingFilter = "") const;
+
+  // Returns a filter on the date column 'column' of 'tableName' for the
+  // dates between 'lower' and 'upper', both given as quoted strings.
+  std::string dateBetween(
+      const std::string& tableName,
+      const std::string& column,
+      const std::string& lower,
+      const std::string& upper) const;
+
+  TpchPlan getQ3Plan() const;
+  TpchPlan getQ7Plan() const;
+  TpchPlan getQ12Plan() const;
+  TpchPlan getQ22Plan() const;
+  TpchPlan getQ27Plan() const;
+  TpchPlan getQ36Plan() const;
+  TpchPlan getQ89Plan() const;
+  TpchPlan getQ98Plan() const;
+
+  // Q12 and Q98 differ only in the sales channel.
+  TpchPlan getRevenueRatioPlan(
+      const std::string& salesTable,
+      const std::string& columnPrefix,
+      std::optional<int32_t> limit) const;
+
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata_;
+  const dwio::common::FileFormat format_;
+  static const std::unordered_map<std::string, std::vector<std::string>>
+      kTables_;
+
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kPromotion = "promotion";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kWebSales = "web_sales";
+  static constexpr const char* kInventory = "inventory";
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
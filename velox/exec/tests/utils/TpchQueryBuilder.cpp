@@ -17,7 +17,9 @@
 
 #include "velox/common/base/Fs.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
 #include "velox/dwio/common/ReaderFactory.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/tpch/gen/TpchGen.h"
 
 #include <fstream>
@@ -2076,4 +2078,32 @@ const std::unordered_map<std::string, std::vector<std::string>>
             "partsupp",
             tpch::getTableSchema(tpch::Table::TBL_PARTSUPP)->names())};
 
+void writeTpchTables(
+    const std::string& dataPath,
+    dwio::common::FileFormat format,
+    double scaleFactor,
+    int32_t numSplits,
+    int32_t numDrivers) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  for (const auto& table : tpch::tables) {
+    auto columnNames = tpch::getTableSchema(table)->names();
+    auto plan =
+        PlanBuilder()
+            .tpchTableScan(table, std::move(columnNames), scaleFactor)
+            .tableWrite(
+                fmt::format("{}/{}", dataPath, tpch::toTableName(table)),
+                format)
+            .planNode();
+    std::vector<Split> splits;
+    for (auto i = 0; i < numSplits; ++i) {
+      splits.emplace_back(std::make_shared<connector::tpch::TpchConnectorSplit>(
+          "test-tpch", numSplits, i));
+    }
+    AssertQueryBuilder(plan)
+        .maxDrivers(numDrivers)
+        .splits(std::move(splits))
+        .copyResults(pool.get());
+  }
+}
+
 } // namespace facebook::velox::exec::test
@@ -146,4 +146,18 @@ class TpchQueryBuilder {
       memory::memoryManager()->addLeafPool();
 };
 
+/// Writes the TPC-H tables at 'scaleFactor' to 'dataPath' in 'format', with
+/// the layout expected by TpchQueryBuilder::initialize(). Dbgen can start at
+/// any row, so each table is generated as 'numSplits' TPC-H connector splits
+/// by 'numDrivers' drivers in parallel. Each driver writes its own files. The
+/// rows go straight from the generator to the writer without being copied.
+/// Requires the TPC-H connector 'test-tpch' and the Hive connector
+/// 'test-hive' to be registered.
+void writeTpchTables(
+    const std::string& dataPath,
+    dwio::common::FileFormat format,
+    double scaleFactor,
+    int32_t numSplits,
+    int32_t numDrivers);
+
 } // namespace facebook::velox::exec::test
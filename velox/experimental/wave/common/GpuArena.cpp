@@ -277,8 +277,90 @@ GpuArena::Buffers::Buffers() {
   }
 }
 
-GpuArena::GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator)
-    : singleArenaCapacity_(singleArenaCapacity), allocator_(allocator) {
+GpuMemoryPool::GpuMemoryPool(
+    std::string name,
+    int64_t capacity,
+    std::shared_ptr<GpuMemoryPool> parent)
+    : name_(std::move(name)), capacity_(capacity), parent_(std::move(parent)) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+GpuMemoryPool::~GpuMemoryPool() {
+  VELOX_DCHECK_EQ(
+      reservedBytes_.load(),
+      0,
+      "Device memory pool {} has reservations",
+      name_);
+}
+
+std::shared_ptr<GpuMemoryPool> GpuMemoryPool::getOrAddChild(
+    const std::string& name,
+    int64_t capacity) {
+  std::lock_guard<std::mutex> l(childMutex_);
+  auto& child = children_[name];
+  if (auto existing = child.lock()) {
+    return existing;
+  }
+  // Drops the entries of the children that are gone.
+  for (auto it = children_.begin(); it != children_.end();) {
+    if (it->second.expired() && it->first != name) {
+      it = children_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto result =
+      std::make_shared<GpuMemoryPool>(name, capacity, shared_from_this());
+  children_[name] = result;
+  return result;
+}
+
+bool GpuMemoryPool::reserveLocal(int64_t bytes) {
+  auto reserved = reservedBytes_.load();
+  do {
+    if (reserved > capacity_ - bytes) {
+      return false;
+    }
+  } while (!reservedBytes_.compare_exchange_weak(reserved, reserved + bytes));
+  return true;
+}
+
+bool GpuMemoryPool::maybeReserve(int64_t bytes) {
+  VELOX_CHECK_GE(bytes, 0);
+  if (!reserveLocal(bytes)) {
+    return false;
+  }
+  if (parent_ && !parent_->maybeReserve(bytes)) {
+    reservedBytes_ -= bytes;
+    return false;
+  }
+  return true;
+}
+
+void GpuMemoryPool::release(int64_t bytes) {
+  VELOX_CHECK_LE(bytes, reservedBytes_.load());
+  reservedBytes_ -= bytes;
+  if (parent_) {
+    parent_->release(bytes);
+  }
+}
+
+std::string GpuMemoryPool::toString() const {
+  return fmt::format(
+      "GpuMemoryPool {} reserved {} capacity {}",
+      name_,
+      succinctBytes(reservedBytes_),
+      capacity_ == kMaxCapacity ? "unlimited" : succinctBytes(capacity_));
+}
+
+GpuArena::GpuArena(
+    uint64_t singleArenaCapacity,
+    GpuAllocator* allocator,
+    std::shared_ptr<GpuMemoryPool> pool)
+    : singleArenaCapacity_(singleArenaCapacity),
+      allocator_(allocator),
+      pool_(std::move(pool)) {
+  reserveSlab(singleArenaCapacity);
   auto arena = std::make_shared<GpuSlab>(
       allocator_->allocate(singleArenaCapacity),
       singleArenaCapacity,
@@ -287,6 +369,27 @@ GpuArena::GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator)
   currentArena_ = arena;
 }
 
+GpuArena::~GpuArena() {
+  if (pool_) {
+    for (auto& [address, slab] : arenas_) {
+      pool_->release(slab->byteSize());
+    }
+  }
+}
+
+void GpuArena::reserveSlab(uint64_t bytes) {
+  if (pool_ && !pool_->maybeReserve(bytes)) {
+    _VELOX_THROW(
+        VeloxRuntimeError,
+        error_source::kErrorSourceRuntime.c_str(),
+        error_code::kMemCapExceeded.c_str(),
+        /* isRetriable */ true,
+        "Exceeded device memory capacity allocating a slab of {}: {}",
+        succinctBytes(bytes),
+        pool_->toString());
+  }
+}
+
 WaveBufferPtr GpuArena::getBuffer(void* ptr, size_t size) {
   auto result = firstFreeBuffer_;
   if (!result) {
@@ -329,6 +432,7 @@ WaveBufferPtr GpuArena::allocateBytes(uint64_t bytes) {
   // it ever fails again then it means requested bytes is larger than a single
   // GpuSlab's capacity. No further attempts will happen.
   auto arenaBytes = std::max<uint64_t>(singleArenaCapacity_, bytes);
+  reserveSlab(arenaBytes);
   auto newArena = std::make_shared<GpuSlab>(
       allocator_->allocate(arenaBytes), arenaBytes, allocator_);
   arenas_.emplace(reinterpret_cast<uint64_t>(newArena->address()), newArena);
@@ -356,6 +460,9 @@ void GpuArena::free(Buffer* buffer) {
   }
   iter->second->free(buffer->ptr_, buffer->size_);
   if (iter->second->empty() && iter->second != currentArena_) {
+    if (pool_) {
+      pool_->release(iter->second->byteSize());
+    }
     arenas_.erase(iter);
   }
   buffer->ptr_ = firstFreeBuffer_;
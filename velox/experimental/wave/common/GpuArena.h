@@ -18,10 +18,12 @@
 
 #include <atomic>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "velox/experimental/wave/common/Buffer.h"
@@ -29,6 +31,69 @@
 
 namespace facebook::velox::wave {
 
+/// Accounts for the device memory reserved by GpuArenas, mirroring the tree
+/// of memory::MemoryPool on host. The root has the device memory that Wave
+/// may use. Each query has a child with its own capacity, from which the
+/// GpuArenas of the query reserve their slabs. A reservation counts against
+/// the pool and all its ancestors, so that one query fails with a capacity
+/// error instead of running the device out of memory for all queries. Pools
+/// are owned by shared_ptrs and a child keeps its parent alive. Thread safe.
+class GpuMemoryPool : public std::enable_shared_from_this<GpuMemoryPool> {
+ public:
+  static constexpr int64_t kMaxCapacity = std::numeric_limits<int64_t>::max();
+
+  GpuMemoryPool(
+      std::string name,
+      int64_t capacity,
+      std::shared_ptr<GpuMemoryPool> parent = nullptr);
+
+  ~GpuMemoryPool();
+
+  /// Returns the child named 'name', adding it with 'capacity' if it does not
+  /// exist. The child is dropped when the last reference to it goes away.
+  std::shared_ptr<GpuMemoryPool> getOrAddChild(
+      const std::string& name,
+      int64_t capacity);
+
+  /// Reserves 'bytes' in 'this' and its ancestors. Returns false and reserves
+  /// nothing if this would take any of them over its capacity.
+  bool maybeReserve(int64_t bytes);
+
+  /// Releases 'bytes' reserved with maybeReserve().
+  void release(int64_t bytes);
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  int64_t capacity() const {
+    return capacity_;
+  }
+
+  int64_t reservedBytes() const {
+    return reservedBytes_;
+  }
+
+  GpuMemoryPool* parent() const {
+    return parent_.get();
+  }
+
+  std::string toString() const;
+
+ private:
+  // Reserves 'bytes' in 'this' only. Returns false if over capacity.
+  bool reserveLocal(int64_t bytes);
+
+  const std::string name_;
+  const int64_t capacity_;
+  const std::shared_ptr<GpuMemoryPool> parent_;
+  std::atomic<int64_t> reservedBytes_{0};
+
+  // Serializes access to 'children_'.
+  std::mutex childMutex_;
+  std::unordered_map<std::string, std::weak_ptr<GpuMemoryPool>> children_;
+};
+
 /// A contiguous range slab of device or universal memory for
 /// backing small allocations. The caller is responsible for
 /// serializing access across threads.
@@ -119,7 +184,16 @@ class GpuSlab {
 /// fragmentation happens.
 class GpuArena {
  public:
-  GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator);
+  /// Makes an arena that allocates slabs of 'singleArenaCapacity' bytes from
+  /// 'allocator'. If 'pool' is set, the slabs are reserved from it and the
+  /// allocations that need a new slab over the capacity of 'pool' throw a
+  /// capacity exceeded error.
+  GpuArena(
+      uint64_t singleArenaCapacity,
+      GpuAllocator* allocator,
+      std::shared_ptr<GpuMemoryPool> pool = nullptr);
+
+  ~GpuArena();
 
   WaveBufferPtr allocateBytes(uint64_t bytes);
 
@@ -141,6 +215,10 @@ class GpuArena {
     return arenas_;
   }
 
+  GpuMemoryPool* pool() const {
+    return pool_.get();
+  }
+
  private:
   // A preallocated array of Buffer handles for memory of 'this'.
   struct Buffers {
@@ -152,6 +230,9 @@ class GpuArena {
   // 'ptr' and 'size'.
   WaveBufferPtr getBuffer(void* ptr, size_t size);
 
+  // Reserves 'bytes' for a new slab from 'pool_'. Throws if over capacity.
+  void reserveSlab(uint64_t bytes);
+
   // Serializes all activity in 'this'.
   std::mutex mutex_;
 
@@ -167,6 +248,9 @@ class GpuArena {
 
   GpuAllocator* const allocator_;
 
+  // Pool for the slabs. nullptr if not accounted.
+  const std::shared_ptr<GpuMemoryPool> pool_;
+
   // A sorted list of GpuSlab by its initial address
   std::map<uint64_t, std::shared_ptr<GpuSlab>> arenas_;
 
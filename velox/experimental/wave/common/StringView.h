@@ -27,6 +27,10 @@ namespace facebook::velox::wave {
 
 class StringView {
  public:
+  static constexpr int kSizeBits = 16;
+  static constexpr uint64_t kMaxSize = (1ull << kSizeBits) - 1;
+  static constexpr int kInlineSize = 8 - kSizeBits / 8;
+
   __device__ __host__ void init(const char* data, int32_t len) {
     data_ = len;
     if (len == 0) {
@@ -69,6 +73,94 @@ class StringView {
     return !(*this == other);
   }
 
+  /// Returns < 0, 0 or > 0 if 'this' collates before, equal to or after
+  /// 'other'. Compares bytes as unsigned, which orders UTF-8 by code point.
+  __device__ __host__ int32_t compare(StringView other) const {
+    auto len = size();
+    auto otherLen = other.size();
+    auto* chars = reinterpret_cast<const uint8_t*>(data());
+    auto* otherChars = reinterpret_cast<const uint8_t*>(other.data());
+    auto common = len < otherLen ? len : otherLen;
+    for (auto i = 0; i < common; ++i) {
+      if (chars[i] != otherChars[i]) {
+        return chars[i] < otherChars[i] ? -1 : 1;
+      }
+    }
+    return static_cast<int32_t>(len) - otherLen;
+  }
+
+  __device__ __host__ bool operator<(StringView other) const {
+    return compare(other) < 0;
+  }
+
+  __device__ __host__ bool operator<=(StringView other) const {
+    return compare(other) <= 0;
+  }
+
+  __device__ __host__ bool operator>(StringView other) const {
+    return compare(other) > 0;
+  }
+
+  __device__ __host__ bool operator>=(StringView other) const {
+    return compare(other) >= 0;
+  }
+
+  __device__ __host__ bool startsWith(StringView prefix) const {
+    auto len = prefix.size();
+    return len <= size() && memcmp(data(), prefix.data(), len) == 0;
+  }
+
+  __device__ __host__ bool endsWith(StringView suffix) const {
+    auto len = suffix.size();
+    return len <= size() &&
+        memcmp(data() + size() - len, suffix.data(), len) == 0;
+  }
+
+  /// Returns true if 'pattern' occurs in 'this'. The strings in filters are
+  /// short, so a direct search is cheaper than preprocessing the pattern.
+  __device__ __host__ bool contains(StringView pattern) const {
+    int32_t len = pattern.size();
+    int32_t last = static_cast<int32_t>(size()) - len;
+    auto* chars = data();
+    auto* patternChars = pattern.data();
+    for (auto i = 0; i <= last; ++i) {
+      if (memcmp(chars + i, patternChars, len) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Returns the number of UTF-8 code points.
+  __device__ __host__ int32_t length() const {
+    auto* chars = data();
+    int32_t count = 0;
+    for (auto i = 0; i < size(); ++i) {
+      count += !isContinuation(chars[i]);
+    }
+    return count;
+  }
+
+  /// Returns 'length' code points starting at the 1-based code point
+  /// 'start', with the semantics of Presto substr(). A negative 'start'
+  /// counts from the end. The result refers to the bytes of 'this' unless it
+  /// is short enough to be inlined.
+  __device__ __host__ StringView substr(int64_t start, int64_t length) const {
+    StringView result;
+    result.data_ = 0;
+    int64_t numChars = this->length();
+    if (start < 0) {
+      start += numChars + 1;
+    }
+    if (start <= 0 || start > numChars || length <= 0) {
+      return result;
+    }
+    auto end = length >= numChars - start + 1 ? numChars : start - 1 + length;
+    auto begin = charOffset(start - 1);
+    result.init(data() + begin, charOffset(end) - begin);
+    return result;
+  }
+
   __device__ StringView cas(StringView compare, StringView val);
 
   operator std::string_view() const {
@@ -76,14 +168,27 @@ class StringView {
   }
 
  private:
+  __device__ __host__ static bool isContinuation(char c) {
+    return (c & 0xc0) == 0x80;
+  }
+
+  // Returns the byte offset of the code point at 0-based 'index' or size()
+  // if there are at most 'index' code points.
+  __device__ __host__ int32_t charOffset(int64_t index) const {
+    auto* chars = data();
+    int32_t offset = 0;
+    for (; offset < size(); ++offset) {
+      if (!isContinuation(chars[offset]) && index-- == 0) {
+        break;
+      }
+    }
+    return offset;
+  }
+
   __device__ __host__ char* inlineData() {
     return reinterpret_cast<char*>(&data_) + kSizeBits / 8;
   }
 
-  static constexpr int kSizeBits = 16;
-  static constexpr uint64_t kMaxSize = (1ull << kSizeBits) - 1;
-  static constexpr int kInlineSize = 8 - kSizeBits / 8;
-
   unsigned long long data_;
 };
 
@@ -307,6 +307,7 @@ class MockGroupByOps {
       row->key = reinterpret_cast<int64_t**>(probe->keys)[0][i];
       row->flags = 0;
       row->count = 0;
+      row->next = nullptr;
       new (&row->concatenation) ArrayAgg64();
     }
     return row;
@@ -376,6 +377,70 @@ class MockGroupByOps {
   }
 };
 
+/// Mock Ops for building a join table with duplicate keys. The row in the
+/// table is a header for a distinct key. Its 'next' is a list of a row per
+/// build side row with 'count' set to the build side row number. The header
+/// 'count' is the number of rows in the list.
+class MockJoinBuildOps : public MockGroupByOps {
+ public:
+  ProbeState __device__ update(
+      GpuHashTable* table,
+      GpuBucket* bucket,
+      TestingRow* row,
+      int32_t i,
+      HashProbe* probe) {
+    int32_t part = table->partitionIdx(bucket - table->buckets);
+    auto* entry = table->allocators[part].allocateRow<TestingRow>();
+    if (!entry) {
+      return ProbeState::kNeedSpace;
+    }
+    entry->key = row->key;
+    entry->count = i;
+    entry->flags = 0;
+    new (&entry->concatenation) ArrayAgg64();
+    // Pushes 'entry' to the front of the list. The list is read only after
+    // the build.
+    entry->next = reinterpret_cast<TestingRow*>(atomicExch(
+        reinterpret_cast<unsigned long long*>(&row->next),
+        reinterpret_cast<unsigned long long>(entry)));
+    atomicAdd(reinterpret_cast<unsigned long long*>(&row->count), 1ULL);
+    return ProbeState::kDone;
+  }
+};
+
+/// Mock Ops for probing a table made with MockJoinBuildOps. Sets
+/// 'probe->hits' to the header row of the probe key or nullptr if the key is
+/// not in the table. The matching build side rows are in the list of the
+/// header.
+class MockJoinProbeOps {
+ public:
+  int32_t __device__ blockBase(HashProbe* probe) {
+    return probe->numRowsPerThread * blockDim.x * blockIdx.x;
+  }
+
+  int32_t __device__ numRowsInBlock(HashProbe* probe) {
+    return probe->numRows[blockIdx.x];
+  }
+
+  uint64_t __device__ hash(int32_t i, HashProbe* probe) {
+    auto key = reinterpret_cast<int64_t**>(probe->keys)[0];
+    return hashMix(1, key[i]);
+  }
+
+  bool __device__
+  compare(GpuHashTable* table, TestingRow* row, int32_t i, HashProbe* probe) {
+    return row->key == reinterpret_cast<int64_t**>(probe->keys)[0][i];
+  }
+
+  void __device__ hit(int32_t i, HashProbe* probe, TestingRow* row) {
+    probe->hits[i] = row;
+  }
+
+  void __device__ miss(int32_t i, HashProbe* probe) {
+    probe->hits[i] = nullptr;
+  }
+};
+
 void __global__ __launch_bounds__(1024) hashTestKernel(
     GpuHashTable* table,
     HashProbe* probe,
@@ -385,9 +450,14 @@ void __global__ __launch_bounds__(1024) hashTestKernel(
       table->updatingProbe<TestingRow>(probe, MockGroupByOps());
       break;
     }
-    case BlockTestStream::HashCase::kBuild:
-    case BlockTestStream::HashCase::kProbe:
-      *(long*)0 = 0; // Unimplemented.
+    case BlockTestStream::HashCase::kBuild: {
+      table->updatingProbe<TestingRow>(probe, MockJoinBuildOps());
+      break;
+    }
+    case BlockTestStream::HashCase::kProbe: {
+      table->readOnlyProbe<TestingRow>(probe, MockJoinProbeOps());
+      break;
+    }
   }
   __syncthreads();
 }
@@ -398,7 +468,7 @@ void BlockTestStream::hashTest(
     HashCase mode) {
   constexpr int32_t kBlockSize = 256;
   int32_t shared = 0;
-  if (mode == HashCase::kGroup) {
+  if (mode == HashCase::kGroup || mode == HashCase::kBuild) {
     shared = GpuHashTable::updatingProbeSharedSize();
   }
   hashTestKernel<<<run.numBlocks, run.blockSize, shared, stream_->stream>>>(
@@ -18,6 +18,7 @@
 #include <folly/Random.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::wave;
@@ -156,6 +157,55 @@ TEST_F(GpuArenaTest, buffers) {
   EXPECT_EQ(1, arena->slabs().size());
 }
 
+TEST_F(GpuArenaTest, memoryPool) {
+  auto root = std::make_shared<GpuMemoryPool>("device", 5 << 20);
+  auto query1 = root->getOrAddChild("query1", 3 << 20);
+  auto query2 = root->getOrAddChild("query2", GpuMemoryPool::kMaxCapacity);
+  EXPECT_EQ(query1, root->getOrAddChild("query1", 3 << 20));
+  EXPECT_EQ(root.get(), query1->parent());
+
+  auto arena1 = std::make_unique<GpuArena>(1 << 20, allocator_.get(), query1);
+  auto arena2 = std::make_unique<GpuArena>(1 << 20, allocator_.get(), query2);
+  EXPECT_EQ(1 << 20, query1->reservedBytes());
+  EXPECT_EQ(2 << 20, root->reservedBytes());
+
+  // 'query1' is limited by its own capacity.
+  std::vector<WaveBufferPtr> buffers;
+  for (auto i = 0; i < 3; ++i) {
+    buffers.push_back(arena1->allocate<char>(1 << 20));
+  }
+  EXPECT_EQ(3 << 20, query1->reservedBytes());
+  VELOX_ASSERT_THROW(
+      arena1->allocate<char>(1 << 20),
+      "Exceeded device memory capacity allocating a slab of 1.00MB");
+
+  // 'query2' is limited by the capacity of the device.
+  for (auto i = 0; i < 2; ++i) {
+    buffers.push_back(arena2->allocate<char>(1 << 20));
+  }
+  EXPECT_EQ(2 << 20, query2->reservedBytes());
+  EXPECT_EQ(5 << 20, root->reservedBytes());
+  VELOX_ASSERT_THROW(
+      arena2->allocate<char>(1 << 20),
+      "Exceeded device memory capacity allocating a slab of 1.00MB");
+
+  // Freeing the buffers releases their slabs but the current one.
+  buffers.clear();
+  EXPECT_EQ(1 << 20, query1->reservedBytes());
+  EXPECT_EQ(1 << 20, query2->reservedBytes());
+  arena1.reset();
+  arena2.reset();
+  EXPECT_EQ(0, query1->reservedBytes());
+  EXPECT_EQ(0, root->reservedBytes());
+
+  // A pool without capacity for the first slab fails the arena.
+  auto small = root->getOrAddChild("small", 1 << 19);
+  VELOX_ASSERT_THROW(
+      std::make_unique<GpuArena>(1 << 20, allocator_.get(), small),
+      "Exceeded device memory capacity");
+  EXPECT_EQ(0, root->reservedBytes());
+}
+
 TEST_F(GpuArenaTest, views) {
   auto arena = std::make_unique<GpuArena>(1 << 20, allocator_.get());
   WaveBufferPtr buffer = arena->allocate<char>(1024);
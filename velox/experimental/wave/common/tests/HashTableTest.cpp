@@ -22,7 +22,9 @@
 #include "velox/experimental/wave/common/tests/CpuTable.h"
 #include "velox/experimental/wave/common/tests/HashTestUtil.h"
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 
 namespace facebook::velox::wave {
 
@@ -279,6 +281,117 @@ class HashTableTest : public testing::Test {
     EXPECT_EQ(reference.size, numChecked);
   }
 
+  // Builds a join table with duplicate keys from 'numRows' rows with
+  // 'numDistinct' keys and probes it with the same keys, half of them moved
+  // out of the key range.
+  void joinTestCase(int32_t numDistinct, int32_t numRows, HashRun& run) {
+    run.numRows = numRows;
+    run.numDistinct = numDistinct;
+    if (!run.numSlots) {
+      run.numSlots = 2 * bits::nextPowerOfTwo(numDistinct);
+    }
+    run.numColumns = 1;
+    run.numRowsPerThread = 32;
+
+    initializeHashTestInput(run, arena_.get());
+    fillHashTestInput(
+        run.numRows,
+        run.numDistinct,
+        bits::nextPowerOfTwo(run.numDistinct),
+        1,
+        run.numColumns,
+        reinterpret_cast<int64_t**>(run.probe->keys));
+    auto* keys = reinterpret_cast<int64_t**>(run.probe->keys)[0];
+    std::unordered_map<int64_t, int64_t> buildCounts;
+    for (auto i = 0; i < run.numRows; ++i) {
+      ++buildCounts[keys[i]];
+    }
+
+    WaveBufferPtr gpuTableBuffer;
+    GpuHashTableBase* gpuTable;
+    // A header row per distinct key and a row per build side row.
+    setupGpuTable(
+        run.numSlots,
+        run.numRows + run.numDistinct,
+        sizeof(TestingRow),
+        arena_.get(),
+        gpuTable,
+        gpuTableBuffer);
+    prefetch(*streams_[0], run.gpuData);
+    prefetch(*streams_[0], gpuTableBuffer);
+    streams_[0]->wait();
+    uint64_t micros = 0;
+    {
+      MicrosecondTimer t(&micros);
+      streams_[0]->hashTest(gpuTable, run, BlockTestStream::HashCase::kBuild);
+      streams_[0]->wait();
+    }
+    run.addScore("gpuBuild", micros);
+    checkJoinBuild(buildCounts, run.numRows, gpuTable);
+
+    for (auto i = 1; i < run.numRows; i += 2) {
+      keys[i] += run.numDistinct;
+    }
+    auto hitsBuffer = arena_->allocate<void*>(run.numRows);
+    run.probe->hits = hitsBuffer->as<void*>();
+    run.probe->maxHits = run.numRows;
+    prefetch(*streams_[0], run.gpuData);
+    prefetch(*streams_[0], hitsBuffer);
+    streams_[0]->wait();
+    micros = 0;
+    {
+      MicrosecondTimer t(&micros);
+      streams_[0]->hashTest(gpuTable, run, BlockTestStream::HashCase::kProbe);
+      streams_[0]->wait();
+    }
+    run.addScore("gpuProbe", micros);
+
+    auto* hits = reinterpret_cast<TestingRow**>(run.probe->hits);
+    for (auto i = 0; i < run.numRows; ++i) {
+      if (i % 2) {
+        ASSERT_TRUE(hits[i] == nullptr) << " at " << i;
+        continue;
+      }
+      ASSERT_TRUE(hits[i] != nullptr) << " at " << i;
+      EXPECT_EQ(keys[i], hits[i]->key);
+      EXPECT_EQ(buildCounts[keys[i]], hits[i]->count);
+    }
+    std::cout << run.toString() << std::endl;
+  }
+
+  // Checks that each distinct key has a header row in 'table' with a list
+  // of its build side rows, and that each build side row is in one list.
+  void checkJoinBuild(
+      std::unordered_map<int64_t, int64_t>& buildCounts,
+      int32_t numRows,
+      GpuHashTableBase* table) {
+    std::vector<bool> seen(numRows);
+    int32_t numHeaders = 0;
+    for (auto i = 0; i <= table->sizeMask; ++i) {
+      for (auto j = 0; j < 4; ++j) {
+        auto* header = reinterpret_cast<GpuBucketMembers*>(table->buckets)[i]
+                           .testingLoad<TestingRow>(j);
+        if (header == nullptr) {
+          continue;
+        }
+        ++numHeaders;
+        EXPECT_EQ(buildCounts[header->key], header->count);
+        int64_t numEntries = 0;
+        for (auto* entry = header->next; entry != nullptr;
+             entry = entry->next) {
+          EXPECT_EQ(header->key, entry->key);
+          ASSERT_LT(entry->count, numRows);
+          EXPECT_FALSE(seen[entry->count]) << " at " << entry->count;
+          seen[entry->count] = true;
+          ++numEntries;
+        }
+        EXPECT_EQ(header->count, numEntries);
+      }
+    }
+    EXPECT_EQ(buildCounts.size(), numHeaders);
+    EXPECT_EQ(numRows, std::count(seen.begin(), seen.end(), true));
+  }
+
   Device* device_;
   GpuAllocator* allocator_;
   std::unique_ptr<GpuArena> arena_;
@@ -383,4 +496,17 @@ TEST_F(HashTableTest, groupBy) {
   }
 }
 
+TEST_F(HashTableTest, join) {
+  {
+    HashRun run;
+    run.testCase = HashTestCase::kJoin1;
+    joinTestCase(1000, 200000, run);
+  }
+  {
+    HashRun run;
+    run.testCase = HashTestCase::kJoin1;
+    joinTestCase(1000000, 2000000, run);
+  }
+}
+
 } // namespace facebook::velox::wave
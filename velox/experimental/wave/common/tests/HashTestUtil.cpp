@@ -180,6 +180,7 @@ std::string HashRun::toString() const {
   std::stringstream out;
   std::string opLabel = testCase == HashTestCase::kUpdateSum1 ? "update sum1"
       : testCase == HashTestCase::kGroupSum1                  ? "groupSum1"
+      : testCase == HashTestCase::kJoin1                      ? "join1"
                                              : "update array_agg1";
   out << "===" << label << ":" << opLabel << " distinct=" << numDistinct
       << " rows=" << numRows << " (" << numBlocks << "x" << blockSize << "x"
@@ -30,7 +30,9 @@ enum class HashTestCase {
   // group by with bigint sum.
   kGroupSum1,
   // array_agg of bigint. Update only, no hash table.
-  kUpdateArrayAgg1
+  kUpdateArrayAgg1,
+  // Join build with duplicate bigint keys and probe.
+  kJoin1
 };
 
 /// Describes a hashtable benchmark case.
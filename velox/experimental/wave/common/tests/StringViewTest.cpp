@@ -65,5 +65,57 @@ TEST(StringViewTest, nonInlined) {
   ASSERT_NE(sv, sv2);
 }
 
+StringView makeView(const char* data) {
+  StringView sv;
+  sv.init(data, strlen(data));
+  return sv;
+}
+
+TEST(StringViewTest, compare) {
+  ASSERT_EQ(makeView("foobarquux").compare(makeView("foobarquux")), 0);
+  ASSERT_LT(makeView("foo"), makeView("foobarquux"));
+  ASSERT_LT(makeView("foobarquux"), makeView("foobazquux"));
+  ASSERT_GT(makeView("fop"), makeView("foobarquux"));
+  ASSERT_LE(makeView(""), makeView("a"));
+  ASSERT_GE(makeView("b"), makeView("a"));
+  // Bytes compare unsigned, so non-ASCII orders after ASCII.
+  ASSERT_GT(makeView("\xc3\xa9"), makeView("z"));
+}
+
+TEST(StringViewTest, match) {
+  auto sv = makeView("foobarquux");
+  ASSERT_TRUE(sv.startsWith(makeView("foo")));
+  ASSERT_TRUE(sv.startsWith(makeView("foobarquux")));
+  ASSERT_TRUE(sv.startsWith(makeView("")));
+  ASSERT_FALSE(sv.startsWith(makeView("bar")));
+  ASSERT_FALSE(makeView("foo").startsWith(sv));
+  ASSERT_TRUE(sv.endsWith(makeView("quux")));
+  ASSERT_FALSE(sv.endsWith(makeView("foo")));
+  ASSERT_TRUE(sv.contains(makeView("barq")));
+  ASSERT_TRUE(sv.contains(makeView("quux")));
+  ASSERT_TRUE(sv.contains(makeView("")));
+  ASSERT_FALSE(sv.contains(makeView("baz")));
+  ASSERT_FALSE(makeView("bar").contains(sv));
+}
+
+TEST(StringViewTest, substr) {
+  auto sv = makeView("foobarquux");
+  ASSERT_EQ(sv.length(), 10);
+  ASSERT_EQ(sv.substr(1, 3), makeView("foo"));
+  ASSERT_EQ(sv.substr(4, 100), makeView("barquux"));
+  ASSERT_EQ(sv.substr(-4, 2), makeView("qu"));
+  ASSERT_EQ(sv.substr(0, 2), StringView{});
+  ASSERT_EQ(sv.substr(11, 2), StringView{});
+  ASSERT_EQ(sv.substr(2, 0), StringView{});
+  // Results that do not fit inline refer to the original bytes.
+  ASSERT_EQ(sv.substr(2, 8).data(), sv.data() + 1);
+
+  // 'aé€b' has 4 code points in 7 bytes.
+  auto utf8 = makeView("a\xc3\xa9\xe2\x82\xac" "b");
+  ASSERT_EQ(utf8.length(), 4);
+  ASSERT_EQ(utf8.substr(2, 2), makeView("\xc3\xa9\xe2\x82\xac"));
+  ASSERT_EQ(utf8.substr(-1, 1), makeView("b"));
+}
+
 } // namespace
 } // namespace facebook::velox::wave
@@ -55,9 +55,21 @@ enum class DecodeStep {
   kFlatMap,
   kFlatMapNode,
   kRowCountNoFilter,
+  kRleBitpack,
+  kDeltaBinaryPacked,
   kUnsupported,
 };
 
+/// Location of a miniblock of DELTA_BINARY_PACKED data.
+struct DeltaMiniblock {
+  // Start of the bit packed deltas.
+  const uint8_t* data;
+  // Minimum delta of the block, added to each bit packed delta.
+  int64_t minDelta;
+  // Bit width of the bit packed deltas.
+  int32_t bitWidth;
+};
+
 /// Describes a decoding loop's input and result disposition.
 struct GpuDecode {
   // The operation to perform. Decides which branch of the union to use.
@@ -198,6 +210,40 @@ struct GpuDecode {
     BlockStatus* status;
   };
 
+  /// Parquet RLE/bit-packed hybrid encoding, used for repetition and
+  /// definition levels and for dictionary indices.
+  struct RleBitpack {
+    // Type of the alphabet and result.
+    WaveTypeKind dataType;
+    // Runs of the encoding, without the length prefix used for levels.
+    const uint8_t* input;
+    // Byte size of the input data.
+    int size;
+    // Bit width of each value.
+    int bitWidth;
+    // Number of values to decode.
+    int numValues;
+    // If not null, the decoded values are indices into this alphabet.
+    const void* alphabet;
+    // Starting address of the result.
+    void* result;
+  };
+
+  /// Parquet DELTA_BINARY_PACKED encoding of INT32 or INT64 values.
+  struct DeltaBinaryPacked {
+    // Type of the result.
+    WaveTypeKind resultType;
+    // Start of the encoded data, beginning with the header.
+    const uint8_t* input;
+    // Number of values to decode, at most the count in the header.
+    int numValues;
+    // Temporary storage for the location, bit width and min delta of each
+    // miniblock. Should be allocated at least "numValues / 32 + 1" large.
+    DeltaMiniblock* miniblocks;
+    // Starting address of the result.
+    void* result;
+  };
+
   union {
     Trivial trivial;
     MainlyConstant mainlyConstant;
@@ -208,6 +254,8 @@ struct GpuDecode {
     Rle rle;
     MakeScatterIndices makeScatterIndices;
     RowCountNoFilter rowCountNoFilter;
+    RleBitpack rleBitpack;
+    DeltaBinaryPacked deltaBinaryPacked;
   } data;
 
   /// Returns the amount f shared memory for standard size thread block for
@@ -525,6 +525,241 @@ __device__ void setRowCountNoFilter(GpuDecode::RowCountNoFilter& op) {
   }
 }
 
+// Returns the 'bitWidth' bits at 'bitOffset' of the little endian bit packed
+// 'data'. Reads only the bytes that contain the bits.
+__device__ inline uint64_t
+unpackBits(const uint8_t* data, int64_t bitOffset, int32_t bitWidth) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  auto* bytes = data + (bitOffset >> 3);
+  const int32_t shift = bitOffset & 7;
+  uint64_t value = bytes[0] >> shift;
+  for (int32_t numBits = 8 - shift, i = 1; numBits < bitWidth;
+       numBits += 8, ++i) {
+    value |= static_cast<uint64_t>(bytes[i]) << numBits;
+  }
+  return bitWidth == 64 ? value : value & ((1UL << bitWidth) - 1);
+}
+
+// A run of Parquet RLE/bit-packed hybrid data.
+struct RleBitpackRun {
+  // First and end (exclusive) value of the run.
+  int32_t begin;
+  int32_t end;
+  // Byte offset of the first bit packed value in the input.
+  int32_t offset;
+  bool isRle;
+  // Value repeated over the run if 'isRle'.
+  uint32_t value;
+};
+
+// Returns the index of the run in 'runs' that contains value 'i'.
+__device__ inline int32_t
+findRun(const RleBitpackRun* runs, int32_t numRuns, int32_t i) {
+  int32_t lo = 0, hi = numRuns;
+  while (lo < hi) {
+    int32_t mid = (lo + hi) / 2;
+    if (runs[mid].end <= i) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Thread 0 reads the headers of up to kBlockSize runs to shared memory, then
+// all threads expand the runs, so that the serial part is one header read
+// per run.
+template <int kBlockSize, typename T>
+__device__ void decodeRleBitpack(GpuDecode::RleBitpack& op) {
+  extern __shared__ char smem[];
+  auto* runs = reinterpret_cast<RleBitpackRun*>(smem);
+  __shared__ int32_t numRuns;
+  __shared__ int32_t batchBegin;
+  __shared__ int32_t batchEnd;
+  __shared__ int32_t inputPos;
+  const auto* input = op.input;
+  const auto bitWidth = op.bitWidth;
+  const auto* alphabet = reinterpret_cast<const T*>(op.alphabet);
+  auto* result = reinterpret_cast<T*>(op.result);
+  if (threadIdx.x == 0) {
+    batchEnd = 0;
+    inputPos = 0;
+  }
+  __syncthreads();
+  for (;;) {
+    if (threadIdx.x == 0) {
+      const int32_t valueBytes = (bitWidth + 7) / 8;
+      int32_t end = batchEnd;
+      int32_t pos = inputPos;
+      int32_t n = 0;
+      batchBegin = end;
+      for (; n < kBlockSize && end < op.numValues && pos < op.size; ++n) {
+        const auto* header = reinterpret_cast<const char*>(input + pos);
+        const auto value = readVarint32(&header);
+        pos = reinterpret_cast<const uint8_t*>(header) - input;
+        auto& run = runs[n];
+        int32_t count;
+        if (value & 1) {
+          count = (value >> 1) * 8;
+          run.isRle = false;
+          run.offset = pos;
+          pos += (value >> 1) * bitWidth;
+        } else {
+          count = value >> 1;
+          run.isRle = true;
+          run.value = 0;
+          for (auto i = 0; i < valueBytes; ++i) {
+            run.value |= static_cast<uint32_t>(input[pos + i]) << (8 * i);
+          }
+          pos += valueBytes;
+        }
+        run.begin = end;
+        end = min(end + count, op.numValues);
+        run.end = end;
+      }
+      numRuns = n;
+      batchEnd = end;
+      inputPos = pos;
+    }
+    __syncthreads();
+    if (numRuns == 0) {
+      break;
+    }
+    for (auto i = batchBegin + threadIdx.x; i < batchEnd; i += blockDim.x) {
+      const auto& run = runs[findRun(runs, numRuns, i)];
+      const uint64_t index = run.isRle
+          ? run.value
+          : unpackBits(
+                input + run.offset,
+                static_cast<int64_t>(i - run.begin) * bitWidth,
+                bitWidth);
+      result[i] = alphabet ? alphabet[index] : static_cast<T>(index);
+    }
+    __syncthreads();
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeRleBitpack(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpack;
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpack<kBlockSize, uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpack<kBlockSize, uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpack<kBlockSize, uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeRleBitpack<kBlockSize, uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for RleBitpack\n");
+        assert(false);
+      }
+  }
+}
+
+__device__ inline uint64_t readUnsignedVarint(const uint8_t** pos) {
+  return readVarint64(reinterpret_cast<const char**>(pos));
+}
+
+__device__ inline int64_t readZigzagVarint(const uint8_t** pos) {
+  const auto value = readUnsignedVarint(pos);
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Thread 0 reads the block headers and notes the location of each miniblock,
+// then the deltas are unpacked in parallel and added up by a block wide scan.
+template <int kBlockSize, typename T>
+__device__ void decodeDeltaBinaryPacked(GpuDecode::DeltaBinaryPacked& op) {
+  using BlockScan = cub::BlockScan<uint64_t, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(smem);
+  __shared__ int32_t valuesPerMiniblock;
+  __shared__ int32_t numValues;
+  __shared__ uint64_t firstValue;
+  auto* miniblocks = op.miniblocks;
+  if (threadIdx.x == 0) {
+    const auto* pos = op.input;
+    const auto valuesPerBlock = readUnsignedVarint(&pos);
+    const auto miniblocksPerBlock = readUnsignedVarint(&pos);
+    const auto totalCount = readUnsignedVarint(&pos);
+    firstValue = readZigzagVarint(&pos);
+    valuesPerMiniblock = valuesPerBlock / miniblocksPerBlock;
+    numValues = min(static_cast<uint64_t>(op.numValues), totalCount);
+    const int32_t numDeltas = max(numValues - 1, 0);
+    const int32_t numMiniblocks =
+        (numDeltas + valuesPerMiniblock - 1) / valuesPerMiniblock;
+    for (auto i = 0; i < numMiniblocks; i += miniblocksPerBlock) {
+      const auto minDelta = readZigzagVarint(&pos);
+      const auto* bitWidths = pos;
+      pos += miniblocksPerBlock;
+      for (auto j = 0; j < miniblocksPerBlock && i + j < numMiniblocks; ++j) {
+        auto& miniblock = miniblocks[i + j];
+        miniblock.data = pos;
+        miniblock.minDelta = minDelta;
+        miniblock.bitWidth = bitWidths[j];
+        pos += valuesPerMiniblock / 8 * bitWidths[j];
+      }
+    }
+  }
+  __syncthreads();
+  auto* result = reinterpret_cast<T*>(op.result);
+  // Value 'i' is the first value plus the deltas before 'i'. The wrap around
+  // of the unsigned sum is the same as the one of the encoder.
+  uint64_t carry = 0;
+  for (auto base = 0; base < numValues; base += kBlockSize) {
+    const auto i = base + threadIdx.x;
+    uint64_t delta = 0;
+    if (i == 0) {
+      delta = firstValue;
+    } else if (i < numValues) {
+      const auto& miniblock = miniblocks[(i - 1) / valuesPerMiniblock];
+      delta = miniblock.minDelta +
+          unpackBits(
+                  miniblock.data,
+                  static_cast<int64_t>((i - 1) % valuesPerMiniblock) *
+                      miniblock.bitWidth,
+                  miniblock.bitWidth);
+    }
+    uint64_t value;
+    uint64_t subtotal;
+    BlockScan(*scanStorage).InclusiveSum(delta, value, subtotal);
+    __syncthreads();
+    if (i < numValues) {
+      result[i] = static_cast<T>(carry + value);
+    }
+    carry += subtotal;
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeDeltaBinaryPacked(GpuDecode& plan) {
+  auto& op = plan.data.deltaBinaryPacked;
+  switch (op.resultType) {
+    case WaveTypeKind::INTEGER:
+      decodeDeltaBinaryPacked<kBlockSize, uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+      decodeDeltaBinaryPacked<kBlockSize, uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported result type for DeltaBinaryPacked\n");
+        assert(false);
+      }
+  }
+}
+
 template <int32_t kBlockSize>
 __device__ void decodeSwitch(GpuDecode& op) {
   switch (op.step) {
@@ -555,6 +790,12 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRowCountNoFilter:
       detail::setRowCountNoFilter<kBlockSize>(op.data.rowCountNoFilter);
       break;
+    case DecodeStep::kRleBitpack:
+      detail::decodeRleBitpack<kBlockSize>(op);
+      break;
+    case DecodeStep::kDeltaBinaryPacked:
+      detail::decodeDeltaBinaryPacked<kBlockSize>(op);
+      break;
     default:
       if (threadIdx.x == 0) {
         printf("ERROR: Unsupported DecodeStep (with shared memory)\n");
@@ -571,6 +812,7 @@ template <int32_t kBlockSize>
 int32_t sharedMemorySizeForDecode(DecodeStep step) {
   using Reduce32 = cub::BlockReduce<int32_t, kBlockSize>;
   using BlockScan32 = cub::BlockScan<int32_t, kBlockSize>;
+  using BlockScan64 = cub::BlockScan<uint64_t, kBlockSize>;
   switch (step) {
     case DecodeStep::kTrivial:
     case DecodeStep::kDictionaryOnBitpack:
@@ -588,6 +830,10 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
       return sizeof(typename BlockScan32::TempStorage);
+    case DecodeStep::kRleBitpack:
+      return kBlockSize * sizeof(RleBitpackRun);
+    case DecodeStep::kDeltaBinaryPacked:
+      return sizeof(typename BlockScan64::TempStorage);
     default:
       assert(false); // Undefined.
       return 0;
@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <limits>
 #include "velox/experimental/gpu/Common.h"
 #include "velox/experimental/wave/dwio/decode/GpuDecoder.cuh"
 
@@ -128,6 +129,112 @@ void makeBitpackDict(
       reinterpret_cast<T*>(memory), dictBytes + bitBytes + scatterBytes);
 }
 
+void appendVarint(uint64_t value, std::vector<uint8_t>& out) {
+  char buffer[10];
+  char* pos = buffer;
+  writeVarint(value, &pos);
+  out.insert(out.end(), buffer, pos);
+}
+
+// Sets the 'bitWidth' bits at 'bitOffset' of 'bits' to 'value'.
+void packBits(
+    uint64_t value,
+    int32_t bitWidth,
+    int64_t bitOffset,
+    std::vector<uint8_t>& bits) {
+  for (auto i = 0; i < bitWidth; ++i) {
+    if (value & (1UL << i)) {
+      setBit(bits.data(), bitOffset + i);
+    }
+  }
+}
+
+// Makes Parquet RLE/bit-packed hybrid runs of at least 'numValues'
+// values of 'bitWidth' bits. The runs alternate between repeated values and
+// bit packed groups of 8.
+void makeRleBitpack(
+    int32_t numValues,
+    int32_t bitWidth,
+    std::vector<uint32_t>& expected,
+    std::vector<uint8_t>& encoded) {
+  uint64_t seed = 0xafbe1647deba879LU;
+  auto next = [&]() {
+    seed = (seed * 0x5def1) ^ (seed >> 21);
+    return seed;
+  };
+  const uint32_t mask = (1U << bitWidth) - 1;
+  for (bool repeated = true; expected.size() < numValues;
+       repeated = !repeated) {
+    if (repeated) {
+      const int32_t count = 1 + next() % 100;
+      const uint32_t value = next() & mask;
+      appendVarint(count << 1, encoded);
+      for (auto i = 0; i < bitWidth; i += 8) {
+        encoded.push_back(value >> i);
+      }
+      expected.insert(expected.end(), count, value);
+    } else {
+      const int32_t numGroups = 1 + next() % 4;
+      appendVarint((numGroups << 1) | 1, encoded);
+      std::vector<uint8_t> bits(numGroups * bitWidth);
+      for (auto i = 0; i < numGroups * 8; ++i) {
+        expected.push_back(next() & mask);
+        packBits(expected.back(), bitWidth, i * bitWidth, bits);
+      }
+      encoded.insert(encoded.end(), bits.begin(), bits.end());
+    }
+  }
+}
+
+// Encodes 'values' as Parquet DELTA_BINARY_PACKED with blocks of 128 values
+// and 4 miniblocks per block.
+void makeDeltaBinaryPacked(
+    const std::vector<int64_t>& values,
+    std::vector<uint8_t>& encoded) {
+  constexpr int32_t kValuesPerBlock = 128;
+  constexpr int32_t kMiniblocksPerBlock = 4;
+  constexpr int32_t kValuesPerMiniblock = kValuesPerBlock / kMiniblocksPerBlock;
+  auto zigzag = [](int64_t n) {
+    return (static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63);
+  };
+  appendVarint(kValuesPerBlock, encoded);
+  appendVarint(kMiniblocksPerBlock, encoded);
+  appendVarint(values.size(), encoded);
+  appendVarint(zigzag(values[0]), encoded);
+  for (auto base = 1; base < values.size(); base += kValuesPerBlock) {
+    const int32_t numDeltas =
+        std::min<int32_t>(kValuesPerBlock, values.size() - base);
+    int64_t minDelta = std::numeric_limits<int64_t>::max();
+    for (auto i = base; i < base + numDeltas; ++i) {
+      minDelta = std::min(minDelta, values[i] - values[i - 1]);
+    }
+    appendVarint(zigzag(minDelta), encoded);
+    const auto bitWidths = encoded.size();
+    encoded.resize(bitWidths + kMiniblocksPerBlock);
+    for (auto i = 0; i * kValuesPerMiniblock < numDeltas; ++i) {
+      const auto first = base + i * kValuesPerMiniblock;
+      const auto end =
+          std::min<int64_t>(first + kValuesPerMiniblock, base + numDeltas);
+      uint64_t maxDelta = 0;
+      for (auto j = first; j < end; ++j) {
+        maxDelta = std::max<uint64_t>(
+            maxDelta, values[j] - values[j - 1] - minDelta);
+      }
+      const int32_t bitWidth = maxDelta ? 64 - __builtin_clzll(maxDelta) : 0;
+      encoded[bitWidths + i] = bitWidth;
+      std::vector<uint8_t> bits(kValuesPerMiniblock / 8 * bitWidth);
+      for (auto j = first; j < end; ++j) {
+        packBits(
+            values[j] - values[j - 1] - minDelta,
+            bitWidth,
+            (j - first) * bitWidth,
+            bits);
+      }
+      encoded.insert(encoded.end(), bits.begin(), bits.end());
+    }
+  }
+}
+
 class GpuDecoderTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -553,6 +660,90 @@ class GpuDecoderTest : public ::testing::Test {
  private:
   cudaEvent_t startEvent_;
   cudaEvent_t stopEvent_;
+
+  template <typename T, int kBlockSize>
+  void testRleBitpack(
+      int32_t numValues,
+      int32_t bitWidth,
+      bool useDictionary,
+      int numBlocks) {
+    std::vector<uint32_t> expected;
+    std::vector<uint8_t> encoded;
+    makeRleBitpack(numValues, bitWidth, expected, encoded);
+    auto input = allocate<uint8_t>(encoded.size());
+    std::copy(encoded.begin(), encoded.end(), input.get());
+    auto dict = allocate<T>(1 << bitWidth);
+    for (auto i = 0; i < 1 << bitWidth; ++i) {
+      dict[i] = 3 * i + 1;
+    }
+    auto result = allocate<T>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (int i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kRleBitpack;
+      auto& op = ops[i].data.rleBitpack;
+      op.dataType = WaveTypeTrait<T>::typeKind;
+      op.input = input.get();
+      op.size = encoded.size();
+      op.bitWidth = bitWidth;
+      op.numValues = numValues;
+      op.alphabet = useDictionary ? dict.get() : nullptr;
+      op.result = result.get() + i * numValues;
+    }
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        numValues * numBlocks * sizeof(T),
+        3);
+    for (int i = 0; i < numBlocks; ++i) {
+      auto* values = result.get() + i * numValues;
+      for (int j = 0; j < numValues; ++j) {
+        ASSERT_EQ(
+            values[j],
+            useDictionary ? dict[expected[j]] : static_cast<T>(expected[j]))
+            << j;
+      }
+    }
+  }
+
+  template <typename T, int kBlockSize>
+  void testDeltaBinaryPacked(int32_t numValues, int numBlocks) {
+    std::vector<int64_t> expected(numValues);
+    fillRandom(expected.data(), numValues);
+    // Mostly small deltas with a few large ones.
+    for (auto i = 1; i < numValues; ++i) {
+      const int64_t delta = expected[i] % (i % 1000 == 0 ? 1'000'000 : 100);
+      expected[i] = static_cast<T>(expected[i - 1] + delta);
+    }
+    expected[0] = static_cast<T>(expected[0]);
+    std::vector<uint8_t> encoded;
+    makeDeltaBinaryPacked(expected, encoded);
+    auto input = allocate<uint8_t>(encoded.size());
+    std::copy(encoded.begin(), encoded.end(), input.get());
+    const int32_t numMiniblocks = numValues / 32 + 1;
+    auto miniblocks = allocate<DeltaMiniblock>(numMiniblocks * numBlocks);
+    auto result = allocate<T>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (int i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kDeltaBinaryPacked;
+      auto& op = ops[i].data.deltaBinaryPacked;
+      op.resultType = WaveTypeTrait<T>::typeKind;
+      op.input = input.get();
+      op.numValues = numValues;
+      op.miniblocks = miniblocks.get() + i * numMiniblocks;
+      op.result = result.get() + i * numValues;
+    }
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        numValues * numBlocks * sizeof(T),
+        3);
+    for (int i = 0; i < numBlocks; ++i) {
+      auto* values = result.get() + i * numValues;
+      for (int j = 0; j < numValues; ++j) {
+        ASSERT_EQ(values[j], static_cast<T>(expected[j])) << j;
+      }
+    }
+  }
 };
 
 TEST_F(GpuDecoderTest, trivial) {
@@ -592,6 +783,18 @@ TEST_F(GpuDecoderTest, makeScatterIndices) {
   testMakeScatterIndices<256>(40013, 1024);
 }
 
+TEST_F(GpuDecoderTest, rleBitpack) {
+  testRleBitpack<int32_t, 256>(100'003, 1, false, 64);
+  testRleBitpack<int32_t, 256>(100'003, 7, false, 64);
+  testRleBitpack<int64_t, 256>(100'003, 11, true, 64);
+}
+
+TEST_F(GpuDecoderTest, deltaBinaryPacked) {
+  testDeltaBinaryPacked<int32_t, 256>(100'003, 64);
+  testDeltaBinaryPacked<int64_t, 256>(100'003, 64);
+  testDeltaBinaryPacked<int64_t, 256>(1, 1);
+}
+
 TEST_F(GpuDecoderTest, streamApi) {
   //  One call with few blocks, another with many, to cover inlined and out of
   //  line params.
@@ -19,6 +19,7 @@
 #include <gflags/gflags.h>
 #include "velox/experimental/wave/common/Block.cuh"
 #include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/StringView.h"
 #include "velox/experimental/wave/exec/WaveCore.cuh"
 
 DEFINE_bool(kernel_gdb, false, "Run kernels sequentially for debugging");
@@ -30,7 +31,7 @@ __device__ inline T opFunc_kPlus(T left, T right) {
   return left + right;
 }
 
-template <typename T, typename OpFunc>
+template <typename T, typename U = T, typename OpFunc>
 __device__ inline void binaryOpKernel(
     OpFunc func,
     IBinary& instr,
@@ -42,7 +43,7 @@ __device__ inline void binaryOpKernel(
     return;
   }
   T left;
-  T right;
+  U right;
   if (operandOrNull(operands, instr.left, blockBase, shared, left) &&
       operandOrNull(operands, instr.right, blockBase, shared, right)) {
     flatResult<decltype(func(left, right))>(
@@ -52,6 +53,26 @@ __device__ inline void binaryOpKernel(
   }
 }
 
+template <typename T, typename OpFunc>
+__device__ inline void unaryOpKernel(
+    OpFunc func,
+    IUnary& instr,
+    Operand** operands,
+    int32_t blockBase,
+    char* shared,
+    BlockStatus* status) {
+  if (threadIdx.x >= status->numRows) {
+    return;
+  }
+  T input;
+  if (operandOrNull(operands, instr.input, blockBase, shared, input)) {
+    flatResult<decltype(func(input))>(
+        operands, instr.result, blockBase, shared) = func(input);
+  } else {
+    resultNull(operands, instr.result, blockBase, shared);
+  }
+}
+
 __device__ void filterKernel(
     const IFilter& filter,
     Operand** operands,
@@ -135,6 +156,17 @@ __device__ void wrapKernel(
         status);                                             \
     break;
 
+#define STRING_COMPARE(opCode, OP)                           \
+  case OP_MIX(opCode, WaveTypeKind::VARCHAR):                \
+    binaryOpKernel<StringView>(                              \
+        [](auto left, auto right) { return left OP right; }, \
+        instruction->_.binary,                               \
+        operands,                                            \
+        blockBase,                                           \
+        shared,                                              \
+        status);                                             \
+    break;
+
 __global__ void waveBaseKernel(
     int32_t* baseIndices,
     int32_t* programIndices,
@@ -169,7 +201,66 @@ __global__ void waveBaseKernel(
         break;
 
         BINARY_TYPES(OpCode::kPlus, +);
+        BINARY_TYPES(OpCode::kEquals, ==);
         BINARY_TYPES(OpCode::kLT, <);
+        BINARY_TYPES(OpCode::kLTE, <=);
+        BINARY_TYPES(OpCode::kGT, >);
+        BINARY_TYPES(OpCode::kGTE, >=);
+        BINARY_TYPES(OpCode::kNE, !=);
+        STRING_COMPARE(OpCode::kEquals, ==);
+        STRING_COMPARE(OpCode::kLT, <);
+        STRING_COMPARE(OpCode::kLTE, <=);
+        STRING_COMPARE(OpCode::kGT, >);
+        STRING_COMPARE(OpCode::kGTE, >=);
+        STRING_COMPARE(OpCode::kNE, !=);
+
+      case OpCode::kStartsWith:
+        binaryOpKernel<StringView>(
+            [](auto string, auto prefix) { return string.startsWith(prefix); },
+            instruction->_.binary,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      case OpCode::kEndsWith:
+        binaryOpKernel<StringView>(
+            [](auto string, auto suffix) { return string.endsWith(suffix); },
+            instruction->_.binary,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      case OpCode::kContains:
+        binaryOpKernel<StringView>(
+            [](auto string, auto pattern) { return string.contains(pattern); },
+            instruction->_.binary,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      case OpCode::kLength:
+        unaryOpKernel<StringView>(
+            [](auto string) { return static_cast<int64_t>(string.length()); },
+            instruction->_.unary,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
+      case OpCode::kSubstr:
+        binaryOpKernel<StringView, int64_t>(
+            [](auto string, auto start) {
+              return string.substr(start, INT64_MAX);
+            },
+            instruction->_.binary,
+            operands,
+            blockBase,
+            shared,
+            status);
+        break;
     }
     ++instruction;
   }
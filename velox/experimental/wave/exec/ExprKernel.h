@@ -40,6 +40,13 @@ enum class OpCode {
   kLiteral,
   kNegate,
   kReturn,
+  // String functions. The operands are VARCHAR except for the start of
+  // kSubstr, which is BIGINT.
+  kStartsWith,
+  kEndsWith,
+  kContains,
+  kLength,
+  kSubstr,
 
   // From here, only OpCodes that have variants for scalar types.
   kPlus,
@@ -94,6 +101,14 @@ struct INegate {
   OperandIndex result;
   OperandIndex predicate;
 };
+
+struct IUnary {
+  OperandIndex input;
+  OperandIndex result;
+  // If set, apply operation to lanes where there is a non-zero byte in this.
+  OperandIndex predicate{kEmpty};
+};
+
 struct IReturn {};
 
 struct Instruction {
@@ -104,6 +119,7 @@ struct Instruction {
     IWrap wrap;
     ILiteral literal;
     INegate negate;
+    IUnary unary;
   } _;
 };
 
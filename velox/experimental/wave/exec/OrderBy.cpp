@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/OrderBy.h"
+
+#include "velox/experimental/wave/common/StringView.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+// Returns the bytes per value of 'type' in a WaveVector or 0 if rows of
+// 'type' cannot be gathered.
+int32_t valueWidth(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::HUGEINT:
+      return type->cppSizeInBytes();
+    case TypeKind::VARCHAR:
+      return sizeof(StringView);
+    default:
+      return 0;
+  }
+}
+} // namespace
+
+OrderBy::OrderBy(
+    CompileState& state,
+    const core::PlanNode& node,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const std::vector<core::SortOrder>& orders,
+    std::optional<int32_t> limit)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      limit_(limit) {
+  auto& inputType = node.sources()[0]->outputType();
+  VELOX_CHECK(*inputType == *outputType_);
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    VELOX_CHECK_NE(valueWidth(outputType_->childAt(i)), 0);
+  }
+  auto* encodings = arena_->allocate<SortKeyEncoding>(keys.size(), encodings_);
+  int32_t keyBytes = 0;
+  for (auto i = 0; i < keys.size(); ++i) {
+    auto channel = exec::exprToChannel(keys[i].get(), inputType);
+    VELOX_CHECK_NE(channel, kConstantChannel);
+    keyChannels_.push_back(channel);
+    auto kind = static_cast<WaveTypeKind>(inputType->childAt(channel)->kind());
+    VELOX_CHECK_GT(sortKeySize(kind), 0);
+    encodings[i] = {kind, orders[i].isAscending(), orders[i].isNullsFirst()};
+    keyBytes += sortKeySize(kind);
+  }
+  numWords_ = bits::roundUp(keyBytes, sizeof(uint64_t)) / sizeof(uint64_t);
+}
+
+// static
+bool OrderBy::isSupportedKey(const TypePtr& type) {
+  return sortKeySize(static_cast<WaveTypeKind>(type->kind())) > 0;
+}
+
+// static
+bool OrderBy::isSupportedColumn(const TypePtr& type) {
+  return valueWidth(type) > 0;
+}
+
+void OrderBy::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  }
+}
+
+int32_t OrderBy::canAdvance(WaveStream& /*stream*/) {
+  if (!noMoreInput_ || finished_) {
+    return 0;
+  }
+  if (numOutputRows() == 0) {
+    finished_ = true;
+  }
+  return numOutputRows();
+}
+
+void OrderBy::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(noMoreInput_);
+  const int32_t numRows = numInputRows_;
+  const int32_t numOutput = numOutputRows();
+  const int32_t numBatches = inputs_.size();
+  const int32_t numColumns = outputType_->size();
+  const int32_t numKeys = keyChannels_.size();
+  auto exec = std::make_unique<Executable>();
+  auto& memory = exec->deviceData;
+  // The batches of column 'i' are at 'columns' + i * 'numBatches' and the
+  // keys of batch 'j' at 'keys' + j * 'numKeys'.
+  auto* firstRows =
+      arena_->allocate<int32_t>(numBatches + 1, memory.emplace_back());
+  auto* columns = arena_->allocate<Operand>(
+      numBatches * numColumns, memory.emplace_back());
+  auto* keys =
+      arena_->allocate<Operand>(numBatches * numKeys, memory.emplace_back());
+  std::vector<bool> nullable(numColumns);
+  firstRows[0] = 0;
+  for (auto batch = 0; batch < numBatches; ++batch) {
+    auto& input = *inputs_[batch];
+    firstRows[batch + 1] = firstRows[batch] + input.size();
+    for (auto i = 0; i < numColumns; ++i) {
+      input.childAt(i).toOperand(&columns[i * numBatches + batch]);
+      nullable[i] = nullable[i] || input.childAt(i).mayHaveNulls();
+    }
+    for (auto i = 0; i < numKeys; ++i) {
+      keys[batch * numKeys + i] = columns[keyChannels_[i] * numBatches + batch];
+    }
+  }
+  auto* words = arena_->allocate<uint64_t>(
+      static_cast<int64_t>(numWords_) * numRows, memory.emplace_back());
+  auto* rows = arena_->allocate<int32_t>(numRows, memory.emplace_back());
+  auto* rowTemp = arena_->allocate<int32_t>(numRows, memory.emplace_back());
+  auto* keyTemp =
+      arena_->allocate<uint64_t>(2 * numRows, memory.emplace_back());
+  auto tempBytes = sortTempBytes(numRows);
+  auto* temp =
+      memory.emplace_back(arena_->allocateBytes(std::max<size_t>(tempBytes, 1)))
+          ->as<char>();
+
+  auto numBlocks = bits::roundUp(maxRows, kBlockSize) / kBlockSize;
+  auto* rowStatus =
+      arena_->allocate<BlockStatus>(numBlocks, memory.emplace_back());
+  bzero(rowStatus, numBlocks * sizeof(BlockStatus));
+  for (auto i = 0; i < numBlocks; ++i) {
+    rowStatus[i].numRows =
+        i == numBlocks - 1 ? maxRows - kBlockSize * i : kBlockSize;
+  }
+  exec->operands = arena_->allocate<Operand>(numColumns, memory.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto column = WaveVector::create(outputType_->childAt(i), *arena_);
+    column->resize(numOutput, nullable[i]);
+    column->toOperand(&exec->operands[i]);
+    exec->output.push_back(std::move(column));
+  }
+  auto* results = exec->operands;
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto* encodings = encodings_->as<SortKeyEncoding>();
+        for (auto batch = 0; batch < numBatches; ++batch) {
+          encodeSortKeys(
+              *stream,
+              numKeys,
+              encodings,
+              keys + batch * numKeys,
+              inputs_[batch]->size(),
+              firstRows[batch],
+              words,
+              numRows);
+        }
+        if (useBlockTopN()) {
+          selectBlockTopN(
+              *stream, words, numRows, limit_.value(), keyTemp, rowTemp);
+          sortPairs(
+              *stream,
+              keyTemp,
+              rowTemp,
+              numTopNCandidates(numRows, limit_.value()),
+              keyTemp + numRows,
+              rows,
+              temp,
+              tempBytes);
+        } else {
+          sortRows(
+              *stream,
+              words,
+              numWords_,
+              numRows,
+              rows,
+              rowTemp,
+              keyTemp,
+              temp,
+              tempBytes);
+        }
+        for (auto i = 0; i < numColumns; ++i) {
+          gatherRows(
+              *stream,
+              columns + i * numBatches,
+              firstRows,
+              numBatches,
+              rows,
+              numOutput,
+              valueWidth(outputType_->childAt(i)),
+              &results[i]);
+        }
+        auto control = std::make_unique<LaunchControl>(id_, maxRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  // The output may refer to the string buffers of 'inputs_', so these are
+  // kept until 'this' is destroyed.
+  finished_ = true;
+}
+
+} // namespace facebook::velox::wave
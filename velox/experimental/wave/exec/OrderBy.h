@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/SortKernels.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Sorts all input on device. Implements OrderBy and, if 'limit' is given,
+/// TopN. Input batches are kept on device as they arrive. After the last
+/// input the keys are normalized and the rows are radix sorted, then the
+/// columns are gathered in sort order into one batch of output. A TopN with
+/// a single word key and a limit of at most kBlockSize first selects the
+/// top rows of each thread block and sorts only these.
+class OrderBy : public WaveOperator {
+ public:
+  OrderBy(
+      CompileState& state,
+      const core::PlanNode& node,
+      const std::vector<core::FieldAccessTypedExprPtr>& keys,
+      const std::vector<core::SortOrder>& orders,
+      std::optional<int32_t> limit);
+
+  /// True if 'type' can be a sort key.
+  static bool isSupportedKey(const TypePtr& type);
+
+  /// True if columns of 'type' can be sorted.
+  static bool isSupportedColumn(const TypePtr& type);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    numInputRows_ += input->size();
+    inputs_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return numOutputRows();
+  }
+
+  std::string toString() const override {
+    return limit_.has_value() ? fmt::format("TopN {}", limit_.value())
+                              : "OrderBy";
+  }
+
+ private:
+  int32_t numOutputRows() const {
+    return limit_.has_value() ? std::min<int64_t>(limit_.value(), numInputRows_)
+                              : numInputRows_;
+  }
+
+  // True if the TopN can select the top rows of each thread block first.
+  bool useBlockTopN() const {
+    return limit_.has_value() && limit_.value() <= kBlockSize &&
+        numWords_ == 1;
+  }
+
+  GpuArena* arena_;
+  const std::optional<int32_t> limit_;
+  std::vector<int32_t> keyChannels_;
+  // Device side SortKeyEncoding for each of 'keyChannels_'.
+  WaveBufferPtr encodings_;
+  // Number of 64 bit words in the normalized key.
+  int32_t numWords_;
+
+  std::vector<WaveVectorPtr> inputs_;
+  int64_t numInputRows_{0};
+  bool noMoreInput_{false};
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/SortKernels.h"
+
+#include <cub/cub.cuh> // @manual
+#include <fmt/format.h>
+#include "velox/experimental/wave/common/Block.cuh"
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Exception.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+// Appends bytes to a normalized key, most significant byte of each word
+// first, and stores each word to its column when complete.
+class KeyWriter {
+ public:
+  __device__ KeyWriter(uint64_t* out, int32_t stride)
+      : out_(out), stride_(stride) {}
+
+  __device__ void append(uint8_t byte) {
+    word_ |= static_cast<uint64_t>(byte) << (56 - 8 * (numBytes_ & 7));
+    if ((++numBytes_ & 7) == 0) {
+      *out_ = word_;
+      out_ += stride_;
+      word_ = 0;
+    }
+  }
+
+  // Appends the 'numBytes' low bytes of 'value' in big endian order,
+  // inverted if 'invert'.
+  __device__ void
+  appendBigEndian(uint64_t value, int32_t numBytes, bool invert) {
+    if (invert) {
+      value = ~value;
+    }
+    for (auto i = numBytes - 1; i >= 0; --i) {
+      append(value >> (8 * i));
+    }
+  }
+
+  __device__ void finish() {
+    if (numBytes_ & 7) {
+      *out_ = word_;
+    }
+  }
+
+ private:
+  uint64_t* out_;
+  const int32_t stride_;
+  uint64_t word_{0};
+  int32_t numBytes_{0};
+};
+
+// Same as in PrefixSortEncoder: the order of the encodings as unsigned is
+// -Infinity, negatives, 0, positives, Infinity, NaN.
+template <typename T, typename U>
+__device__ U encodeFloatingPoint(T value) {
+  constexpr U kSign = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+  if (value == 0) {
+    return kSign;
+  }
+  if (isnan(value)) {
+    return ~static_cast<U>(0);
+  }
+  if (isinf(value)) {
+    return value > 0 ? ~static_cast<U>(0) - 1 : 0;
+  }
+  auto encoded = *reinterpret_cast<U*>(&value);
+  return (encoded & kSign) == 0 ? encoded | kSign : ~encoded;
+}
+
+__device__ void encodeKey(
+    const SortKeyEncoding& encoding,
+    const Operand& key,
+    int32_t row,
+    KeyWriter& writer) {
+  auto index = row & key.indexMask;
+  auto isNull = key.nulls && key.nulls[index] == kNull;
+  writer.append(isNull != encoding.nullsFirst);
+  bool invert = !encoding.ascending;
+  switch (encoding.kind) {
+    case WaveTypeKind::INTEGER: {
+      auto value = isNull ? 0
+                          : static_cast<uint32_t>(
+                                reinterpret_cast<int32_t*>(key.base)[index]) ^
+              (1u << 31);
+      writer.appendBigEndian(value, 4, invert && !isNull);
+      break;
+    }
+    case WaveTypeKind::BIGINT: {
+      auto value = isNull ? 0
+                          : static_cast<uint64_t>(
+                                reinterpret_cast<int64_t*>(key.base)[index]) ^
+              (1ull << 63);
+      writer.appendBigEndian(value, 8, invert && !isNull);
+      break;
+    }
+    case WaveTypeKind::REAL: {
+      auto value = isNull ? 0
+                          : encodeFloatingPoint<float, uint32_t>(
+                                reinterpret_cast<float*>(key.base)[index]);
+      writer.appendBigEndian(value, 4, invert && !isNull);
+      break;
+    }
+    case WaveTypeKind::DOUBLE: {
+      auto value = isNull ? 0
+                          : encodeFloatingPoint<double, uint64_t>(
+                                reinterpret_cast<double*>(key.base)[index]);
+      writer.appendBigEndian(value, 8, invert && !isNull);
+      break;
+    }
+    default:
+      assert(false);
+  }
+}
+
+__global__ void encodeSortKeysKernel(
+    int32_t numKeys,
+    const SortKeyEncoding* encodings,
+    const Operand* keys,
+    int32_t numRows,
+    int32_t firstRow,
+    uint64_t* words,
+    int32_t stride) {
+  auto row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row >= numRows) {
+    return;
+  }
+  KeyWriter writer(words + firstRow + row, stride);
+  for (auto i = 0; i < numKeys; ++i) {
+    encodeKey(encodings[i], keys[i], row, writer);
+  }
+  writer.finish();
+}
+
+__global__ void iotaKernel(int32_t* rows, int32_t numRows) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    rows[i] = i;
+  }
+}
+
+__global__ void gatherKeysKernel(
+    const uint64_t* words,
+    const int32_t* rows,
+    int32_t numRows,
+    uint64_t* keys) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    keys[i] = words[rows[i]];
+  }
+}
+
+__global__ void blockTopNKernel(
+    const uint64_t* keys,
+    int32_t numRows,
+    int32_t limit,
+    uint64_t* candidateKeys,
+    int32_t* candidateRows) {
+  using Sort = RadixSort<kBlockSize, 1, uint64_t, int32_t>;
+  __shared__ typename Sort::TempStorage temp;
+  __shared__ uint64_t sortedKeys[kBlockSize];
+  __shared__ int32_t sortedRows[kBlockSize];
+  int32_t base = blockIdx.x * kBlockSize;
+  // The padding of the last block sorts after its rows since the sort is
+  // stable.
+  blockSort<kBlockSize, 1, uint64_t, int32_t>(
+      [&](int32_t i) { return base + i < numRows ? keys[base + i] : ~0ull; },
+      [&](int32_t i) { return base + i; },
+      sortedKeys,
+      sortedRows,
+      reinterpret_cast<char*>(&temp));
+  if (threadIdx.x < limit && base + threadIdx.x < numRows) {
+    candidateKeys[blockIdx.x * limit + threadIdx.x] = sortedKeys[threadIdx.x];
+    candidateRows[blockIdx.x * limit + threadIdx.x] = sortedRows[threadIdx.x];
+  }
+}
+
+template <typename T>
+__global__ void gatherRowsKernel(
+    const Operand* batches,
+    const int32_t* firstRows,
+    int32_t numBatches,
+    const int32_t* rows,
+    int32_t numRows,
+    Operand* result) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= numRows) {
+    return;
+  }
+  auto row = rows[i];
+  // The last batch that starts at or before 'row'.
+  int32_t batch = 0;
+  for (auto last = numBatches - 1; batch < last;) {
+    auto middle = (batch + last + 1) / 2;
+    if (firstRows[middle] <= row) {
+      batch = middle;
+    } else {
+      last = middle - 1;
+    }
+  }
+  auto& source = batches[batch];
+  auto index = (row - firstRows[batch]) & source.indexMask;
+  reinterpret_cast<T*>(result->base)[i] =
+      reinterpret_cast<const T*>(source.base)[index];
+  if (result->nulls) {
+    result->nulls[i] = source.nulls ? source.nulls[index] : kNotNull;
+  }
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+} // namespace
+
+int32_t sortKeySize(WaveTypeKind kind) {
+  switch (kind) {
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      return 5;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      return 9;
+    default:
+      return 0;
+  }
+}
+
+void encodeSortKeys(
+    Stream& stream,
+    int32_t numKeys,
+    const SortKeyEncoding* encodings,
+    const Operand* keys,
+    int32_t numRows,
+    int32_t firstRow,
+    uint64_t* words,
+    int32_t stride) {
+  if (numRows == 0) {
+    return;
+  }
+  encodeSortKeysKernel<<<
+      numBlocks(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(
+      numKeys, encodings, keys, numRows, firstRow, words, stride);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+size_t sortTempBytes(int32_t numRows) {
+  cub::DoubleBuffer<uint64_t> keys(nullptr, nullptr);
+  cub::DoubleBuffer<int32_t> rows(nullptr, nullptr);
+  size_t doubleBufferBytes = 0;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      nullptr, doubleBufferBytes, keys, rows, numRows));
+  // Without DoubleBuffer the alternate buffers come from the temp memory.
+  size_t bytes = 0;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      nullptr,
+      bytes,
+      static_cast<const uint64_t*>(nullptr),
+      static_cast<uint64_t*>(nullptr),
+      static_cast<const int32_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      numRows));
+  return std::max(bytes, doubleBufferBytes);
+}
+
+void sortRows(
+    Stream& stream,
+    uint64_t* words,
+    int32_t numWords,
+    int32_t numRows,
+    int32_t* rows,
+    int32_t* rowTemp,
+    uint64_t* keyTemp,
+    void* temp,
+    size_t tempBytes) {
+  if (numRows == 0) {
+    return;
+  }
+  auto cudaStream = stream.stream()->stream;
+  iotaKernel<<<numBlocks(numRows), kBlockSize, 0, cudaStream>>>(
+      rows, numRows);
+  cub::DoubleBuffer<int32_t> order(rows, rowTemp);
+  // Least significant word first. Each pass is stable, so the order of the
+  // previous passes is kept between rows with equal words.
+  for (auto word = numWords - 1; word >= 0; --word) {
+    auto* input = words + static_cast<int64_t>(word) * numRows;
+    if (word < numWords - 1) {
+      gatherKeysKernel<<<numBlocks(numRows), kBlockSize, 0, cudaStream>>>(
+          input, order.Current(), numRows, keyTemp);
+      input = keyTemp;
+    }
+    cub::DoubleBuffer<uint64_t> keys(input, keyTemp + numRows);
+    CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+        temp,
+        tempBytes,
+        keys,
+        order,
+        numRows,
+        0,
+        sizeof(uint64_t) * 8,
+        cudaStream));
+  }
+  if (order.Current() != rows) {
+    CUDA_CHECK(cudaMemcpyAsync(
+        rows,
+        order.Current(),
+        numRows * sizeof(int32_t),
+        cudaMemcpyDeviceToDevice,
+        cudaStream));
+  }
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void sortPairs(
+    Stream& stream,
+    const uint64_t* keys,
+    const int32_t* rows,
+    int32_t numRows,
+    uint64_t* keysOut,
+    int32_t* rowsOut,
+    void* temp,
+    size_t tempBytes) {
+  if (numRows == 0) {
+    return;
+  }
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      temp,
+      tempBytes,
+      keys,
+      keysOut,
+      rows,
+      rowsOut,
+      numRows,
+      0,
+      sizeof(uint64_t) * 8,
+      stream.stream()->stream));
+}
+
+void selectBlockTopN(
+    Stream& stream,
+    const uint64_t* keys,
+    int32_t numRows,
+    int32_t limit,
+    uint64_t* candidateKeys,
+    int32_t* candidateRows) {
+  if (limit > kBlockSize) {
+    waveError(fmt::format("Block TopN limit {} > {}", limit, kBlockSize));
+  }
+  if (numRows == 0) {
+    return;
+  }
+  blockTopNKernel<<<
+      numBlocks(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(
+      keys, numRows, limit, candidateKeys, candidateRows);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void gatherRows(
+    Stream& stream,
+    const Operand* batches,
+    const int32_t* firstRows,
+    int32_t numBatches,
+    const int32_t* rows,
+    int32_t numRows,
+    int32_t width,
+    Operand* result) {
+  if (numRows == 0) {
+    return;
+  }
+  auto cudaStream = stream.stream()->stream;
+  auto blocks = numBlocks(numRows);
+  switch (width) {
+    case 1:
+      gatherRowsKernel<uint8_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+          batches, firstRows, numBatches, rows, numRows, result);
+      break;
+    case 2:
+      gatherRowsKernel<uint16_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+          batches, firstRows, numBatches, rows, numRows, result);
+      break;
+    case 4:
+      gatherRowsKernel<uint32_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+          batches, firstRows, numBatches, rows, numRows, result);
+      break;
+    case 8:
+      gatherRowsKernel<uint64_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+          batches, firstRows, numBatches, rows, numRows, result);
+      break;
+    case 16:
+      gatherRowsKernel<__int128_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+          batches, firstRows, numBatches, rows, numRows, result);
+      break;
+    default:
+      waveError(fmt::format("Gather of {} byte values", width));
+  }
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
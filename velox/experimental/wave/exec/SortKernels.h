@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+/// Kernels for sorting rows on device. Sort keys are normalized into a
+/// byte string per row with the layout of PrefixSortEncoder, i.e. a null
+/// byte followed by the big endian value, bits inverted for descending
+/// order. The byte strings are kept as columns of 64 bit words, most
+/// significant first, so that the rows are ordered by an LSD radix sort
+/// over the words.
+namespace facebook::velox::wave {
+
+struct SortKeyEncoding {
+  WaveTypeKind kind;
+  bool ascending;
+  bool nullsFirst;
+};
+
+/// Returns the bytes in the normalized key of 'kind', including the null
+/// byte, or 0 if 'kind' cannot be a Wave sort key.
+int32_t sortKeySize(WaveTypeKind kind);
+
+/// Writes the normalized keys of 'numRows' rows of a batch to
+/// 'words'. 'keys' has the 'numKeys' key columns of the batch and
+/// 'encodings' how each is encoded. Word 'i' of row 'j' of the batch
+/// is at 'words'['i' * 'stride' + 'firstRow' + 'j']. 'encodings' and 'keys'
+/// must be device accessible.
+void encodeSortKeys(
+    Stream& stream,
+    int32_t numKeys,
+    const SortKeyEncoding* encodings,
+    const Operand* keys,
+    int32_t numRows,
+    int32_t firstRow,
+    uint64_t* words,
+    int32_t stride);
+
+/// Returns the bytes of temporary device memory needed by sortRows() and
+/// sortPairs() for 'numRows' rows.
+size_t sortTempBytes(int32_t numRows);
+
+/// Sets 'rows' to the row numbers of 'numRows' rows ordered by their
+/// 'numWords' word normalized keys in 'words' as written by
+/// encodeSortKeys() with 'stride' == 'numRows'. 'words' is clobbered.
+/// 'rowTemp' has space for 'numRows' and 'keyTemp' for 2 * 'numRows'
+/// elements. 'temp' has 'tempBytes' bytes as given by sortTempBytes().
+void sortRows(
+    Stream& stream,
+    uint64_t* words,
+    int32_t numWords,
+    int32_t numRows,
+    int32_t* rows,
+    int32_t* rowTemp,
+    uint64_t* keyTemp,
+    void* temp,
+    size_t tempBytes);
+
+/// Sorts 'rows' by 'keys'. The results are in 'keysOut' and 'rowsOut'. The
+/// sort is stable.
+void sortPairs(
+    Stream& stream,
+    const uint64_t* keys,
+    const int32_t* rows,
+    int32_t numRows,
+    uint64_t* keysOut,
+    int32_t* rowsOut,
+    void* temp,
+    size_t tempBytes);
+
+/// Selects the first 'limit' rows of each kBlockSize rows of 'numRows' by the
+/// single word normalized keys in 'keys'. 'limit' must be <= kBlockSize. The
+/// keys and row numbers of the top rows of block 'i' are at 'i' * 'limit'
+/// in 'candidateKeys' and 'candidateRows'. Since only the last block can
+/// have less than kBlockSize rows, the candidates are contiguous and their
+/// count is returned by numTopNCandidates().
+void selectBlockTopN(
+    Stream& stream,
+    const uint64_t* keys,
+    int32_t numRows,
+    int32_t limit,
+    uint64_t* candidateKeys,
+    int32_t* candidateRows);
+
+inline int32_t numTopNCandidates(int32_t numRows, int32_t limit) {
+  auto numFull = numRows / kBlockSize;
+  auto last = numRows % kBlockSize;
+  return numFull * limit + (last < limit ? last : limit);
+}
+
+/// Copies the values at rows 'rows[0..numRows)' of a column to
+/// 'result'. The column is the concatenation of the flat
+/// 'batches', where batch 'i' starts at row 'firstRows[i]'. 'width' is
+/// the byte width of a value. 'batches', 'firstRows' and 'result' must be
+/// device accessible. 'result' has nulls if any of 'batches' has nulls.
+void gatherRows(
+    Stream& stream,
+    const Operand* batches,
+    const int32_t* firstRows,
+    int32_t numBatches,
+    const int32_t* rows,
+    int32_t numRows,
+    int32_t width,
+    Operand* result);
+
+} // namespace facebook::velox::wave
@@ -16,7 +16,9 @@
 
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/exec/Task.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/OrderBy.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -25,6 +27,16 @@
 #include "velox/expression/FieldReference.h"
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
+DEFINE_int64(
+    velox_wave_device_memory_capacity,
+    0,
+    "Device memory for the GPU memory of all Wave queries in the process. 0 "
+    "means not accounted");
+DEFINE_int64(
+    velox_wave_query_device_memory_capacity,
+    0,
+    "Device memory for the GPU memory of one Wave query. 0 means the whole "
+    "velox_wave_device_memory_capacity");
 
 namespace facebook::velox::wave {
 
@@ -125,12 +137,80 @@ std::optional<OpCode> binaryOpCode(const Expr& expr) {
   if (name == "plus") {
     return OpCode::kPlus;
   }
+  if (name == "eq") {
+    return OpCode::kEquals;
+  }
+  if (name == "neq") {
+    return OpCode::kNE;
+  }
   if (name == "lt") {
     return OpCode::kLT;
   }
+  if (name == "lte") {
+    return OpCode::kLTE;
+  }
+  if (name == "gt") {
+    return OpCode::kGT;
+  }
+  if (name == "gte") {
+    return OpCode::kGTE;
+  }
+  if (name == "starts_with") {
+    return OpCode::kStartsWith;
+  }
+  if (name == "ends_with") {
+    return OpCode::kEndsWith;
+  }
+  if (name == "substr" && expr.inputs().size() == 2) {
+    return OpCode::kSubstr;
+  }
+  return std::nullopt;
+}
+
+std::optional<OpCode> unaryOpCode(const Expr& expr) {
+  if (expr.name() == "length" &&
+      expr.inputs()[0]->type()->kind() == TypeKind::VARCHAR) {
+    return OpCode::kLength;
+  }
   return std::nullopt;
 }
 
+/// Returns the string function for a 'like' whose pattern is a constant with
+/// no wildcards other than a leading and a trailing '%'. Sets 'literal' to
+/// the pattern without the '%'s.
+std::optional<OpCode> likeOpCode(const Expr& expr, std::string& literal) {
+  if (expr.name() != "like" || expr.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto* constant =
+      dynamic_cast<const exec::ConstantExpr*>(expr.inputs()[1].get());
+  if (!constant || constant->value()->isNullAt(0)) {
+    return std::nullopt;
+  }
+  auto pattern =
+      constant->value()->as<SimpleVector<velox::StringView>>()->valueAt(0);
+  std::string_view view(pattern.data(), pattern.size());
+  bool leading = !view.empty() && view.front() == '%';
+  if (leading) {
+    view.remove_prefix(1);
+  }
+  bool trailing = !view.empty() && view.back() == '%';
+  if (trailing) {
+    view.remove_suffix(1);
+  }
+  if (view.find_first_of("%_") != std::string_view::npos) {
+    return std::nullopt;
+  }
+  literal = std::string(view);
+  if (leading && trailing) {
+    return OpCode::kContains;
+  }
+  if (leading) {
+    return OpCode::kEndsWith;
+  }
+  return trailing ? OpCode::kStartsWith : OpCode::kEquals;
+}
+
 Program* CompileState::newProgram() {
   auto program = std::make_shared<Program>();
   allPrograms_.push_back(program);
@@ -236,13 +316,30 @@ AbstractOperand* CompileState::addExpr(const Expr& expr) {
   } else if (dynamic_cast<const exec::SpecialForm*>(&expr)) {
     VELOX_UNSUPPORTED("No special forms: {}", expr.toString(1));
   }
-  auto opCode = binaryOpCode(expr);
+  if (auto unary = unaryOpCode(expr)) {
+    return addUnary(unary.value(), expr);
+  }
+  std::string likeLiteral;
+  AbstractOperand* rightOp = nullptr;
+  auto opCode = likeOpCode(expr, likeLiteral);
+  if (opCode.has_value()) {
+    // The pattern becomes a literal argument of a string function.
+    auto& pattern = static_cast<const exec::ConstantExpr&>(*expr.inputs()[1]);
+    rightOp = newOperand(VARCHAR(), pattern.toString());
+    rightOp->constant = BaseVector::createConstant(
+        VARCHAR(), variant(likeLiteral), 1, pattern.value()->pool());
+    rightOp->notNull = true;
+  } else {
+    opCode = binaryOpCode(expr);
+  }
   if (!opCode.has_value()) {
     VELOX_UNSUPPORTED("Expr not supported: {}", expr.toString());
   }
   auto result = newOperand(expr.type(), "r");
   auto leftOp = addExpr(*expr.inputs()[0]);
-  auto rightOp = addExpr(*expr.inputs()[1]);
+  if (!rightOp) {
+    rightOp = addExpr(*expr.inputs()[1]);
+  }
   auto instruction =
       std::make_unique<AbstractBinary>(opCode.value(), leftOp, rightOp, result);
   setConditionalNullable(*instruction);
@@ -260,6 +357,22 @@ AbstractOperand* CompileState::addExpr(const Expr& expr) {
   return result;
 }
 
+AbstractOperand* CompileState::addUnary(OpCode opCode, const Expr& expr) {
+  auto result = newOperand(expr.type(), "r");
+  auto input = addExpr(*expr.inputs()[0]);
+  auto instruction = std::make_unique<AbstractUnary>(opCode, input, result);
+  if (maybeNotNull(input)) {
+    result->conditionalNonNull = true;
+    addNullableIf(input, result->nullableIf);
+  }
+  std::vector<Program*> sources;
+  if (auto program = definedIn_[input]) {
+    sources.push_back(program);
+  }
+  addInstruction(std::move(instruction), result, sources);
+  return result;
+}
+
 std::vector<AbstractOperand*> CompileState::addExprSet(
     const exec::ExprSet& exprSet,
     int32_t begin,
@@ -371,13 +484,43 @@ void CompileState::addFilterProject(
   }
 }
 
+namespace {
+// Returns the root of the device memory pools of Wave queries or nullptr if
+// device memory is not accounted.
+const std::shared_ptr<GpuMemoryPool>& deviceMemoryRoot() {
+  static const std::shared_ptr<GpuMemoryPool> root =
+      FLAGS_velox_wave_device_memory_capacity > 0
+      ? std::make_shared<GpuMemoryPool>(
+            "wave.device", FLAGS_velox_wave_device_memory_capacity)
+      : nullptr;
+  return root;
+}
+} // namespace
+
 bool CompileState::reserveMemory() {
   if (arena_) {
     return true;
   }
   auto* allocator = getAllocator(getDevice());
-  arena_ =
-      std::make_unique<GpuArena>(FLAGS_velox_wave_arena_unit_size, allocator);
+  std::shared_ptr<GpuMemoryPool> pool;
+  if (const auto& root = deviceMemoryRoot()) {
+    pool = root->getOrAddChild(
+        driver_.task()->queryCtx()->queryId(),
+        FLAGS_velox_wave_query_device_memory_capacity > 0
+            ? FLAGS_velox_wave_query_device_memory_capacity
+            : GpuMemoryPool::kMaxCapacity);
+  }
+  try {
+    arena_ = std::make_unique<GpuArena>(
+        FLAGS_velox_wave_arena_unit_size, allocator, std::move(pool));
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kMemCapExceeded) {
+      throw;
+    }
+    // The operators stay on CPU if the device is full.
+    VLOG(1) << "Not using Wave: " << e.message();
+    return false;
+  }
   return true;
 }
 
@@ -423,6 +566,37 @@ bool CompileState::addOperator(
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "OrderBy" || name == "TopN") {
+    auto& node = *driverFactory_.planNodes[nodeIndex];
+    std::vector<core::FieldAccessTypedExprPtr> keys;
+    std::vector<core::SortOrder> orders;
+    std::optional<int32_t> limit;
+    if (auto* orderBy = dynamic_cast<const core::OrderByNode*>(&node)) {
+      keys = orderBy->sortingKeys();
+      orders = orderBy->sortingOrders();
+    } else {
+      auto* topN = dynamic_cast<const core::TopNNode*>(&node);
+      VELOX_CHECK_NOT_NULL(topN);
+      keys = topN->sortingKeys();
+      orders = topN->sortingOrders();
+      limit = topN->count();
+    }
+    for (auto& key : keys) {
+      if (!OrderBy::isSupportedKey(key->type())) {
+        return false;
+      }
+    }
+    for (auto& type : node.outputType()->children()) {
+      if (!OrderBy::isSupportedColumn(type)) {
+        return false;
+      }
+    }
+    if (!reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(
+        std::make_unique<OrderBy>(*this, node, keys, orders, limit));
+    outputType = node.outputType();
   } else if (name == "TableScan") {
     if (!reserveMemory()) {
       return false;
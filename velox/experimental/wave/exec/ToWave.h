@@ -105,6 +105,9 @@ class CompileState {
 
   void setConditionalNullable(AbstractBinary& binary);
 
+  // Adds the instruction for the one argument function 'expr'.
+  AbstractOperand* addUnary(OpCode opCode, const exec::Expr& expr);
+
   void addNullableIf(
       const AbstractOperand* op,
       std::vector<OperandId>& nullableIf);
@@ -15,6 +15,8 @@
  */
 
 #include "velox/experimental/wave/exec/Vectors.h"
+#include "velox/experimental/wave/common/StringView.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::wave {
 
@@ -67,6 +69,52 @@ void ensureVectors(
   }
 }
 
+namespace {
+// Writes the device StringViews for 'source' to the values of 'target'. The
+// bytes of the strings that are not inlined are packed into one buffer from
+// 'arena'. The arena memory is accessible from host, so this needs no
+// Transfer.
+void stringsToDevice(
+    const FlatVector<velox::StringView>& source,
+    WaveVector& target,
+    GpuArena& arena) {
+  auto* rawStrings = source.rawValues();
+  int64_t numBytes = 0;
+  for (auto i = 0; i < source.size(); ++i) {
+    if (source.isNullAt(i) || rawStrings[i].size() <= StringView::kInlineSize) {
+      continue;
+    }
+    VELOX_CHECK_LE(
+        rawStrings[i].size(),
+        StringView::kMaxSize,
+        "String too long for Wave");
+    numBytes += rawStrings[i].size();
+  }
+  WaveBufferPtr buffer;
+  char* fill = nullptr;
+  if (numBytes > 0) {
+    buffer = arena.allocateBytes(numBytes);
+    fill = buffer->as<char>();
+  }
+  auto* strings = target.values<StringView>();
+  for (auto i = 0; i < source.size(); ++i) {
+    if (source.isNullAt(i)) {
+      strings[i].init(nullptr, 0);
+      continue;
+    }
+    auto size = rawStrings[i].size();
+    if (size <= StringView::kInlineSize) {
+      strings[i].init(rawStrings[i].data(), size);
+    } else {
+      memcpy(fill, rawStrings[i].data(), size);
+      strings[i].init(fill, size);
+      fill += size;
+    }
+  }
+  target.setStringBuffer(std::move(buffer));
+}
+} // namespace
+
 void transferVector(
     const BaseVector* source,
     int32_t index,
@@ -92,6 +140,12 @@ void transferVector(
       transfers.emplace_back(
           rawValues, waveVectors[index]->values<char>(), bytes);
       totalBytes += bytes;
+    } else if (source->typeKind() == TypeKind::VARCHAR) {
+      VELOX_CHECK_EQ(source->encoding(), VectorEncoding::Simple::FLAT);
+      stringsToDevice(
+          *source->asUnchecked<FlatVector<velox::StringView>>(),
+          *waveVectors[index],
+          arena);
     } else {
       auto bytes = source->size() * source->type()->cppSizeInBytes();
       transfers.emplace_back(
@@ -15,6 +15,7 @@
  */
 
 #include "velox/experimental/wave/exec/Wave.h"
+#include "velox/experimental/wave/common/StringView.h"
 #include "velox/experimental/wave/exec/Vectors.h"
 
 namespace facebook::velox::wave {
@@ -38,6 +39,39 @@ void WaveStats::add(const WaveStats& other) {
   hostOnlyTime += other.hostOnlyTime;
   hostParallelTime += other.hostParallelTime;
   waitTime += other.waitTime;
+  bytesStaged += other.bytesStaged;
+  stagingWaitTime += other.stagingWaitTime;
+  numOverlappedWaves += other.numOverlappedWaves;
+}
+
+StagingRing::StagingRing(GpuArena& hostArena, int64_t bufferSize)
+    : bufferSize_(bufferSize) {
+  VELOX_CHECK_GT(bufferSize_, 0);
+  buffers_.resize(kNumBuffers);
+  for (auto& buffer : buffers_) {
+    buffer.data = hostArena.allocate<char>(bufferSize_);
+    buffer.event = std::make_unique<Event>();
+  }
+}
+
+char* StagingRing::acquire(WaveStats& stats) {
+  auto& buffer = buffers_[next_];
+  if (buffer.pending) {
+    if (!buffer.event->query()) {
+      const auto start = WaveTime::now();
+      buffer.event->wait();
+      stats.stagingWaitTime += WaveTime::now() - start;
+    }
+    buffer.pending = false;
+  }
+  return buffer.data->as<char>();
+}
+
+void StagingRing::release(Stream& stream) {
+  auto& buffer = buffers_[next_];
+  buffer.event->record(stream);
+  buffer.pending = true;
+  next_ = (next_ + 1) % buffers_.size();
 }
 
 const SubfieldMap*& threadSubfieldMap() {
@@ -277,14 +311,38 @@ void Executable::startTransfer(
   exe->deviceData.push_back(waveStream.arena().allocate<char>(info.totalBytes));
   auto start = exe->deviceData[0]->as<char>();
   exe->operands = waveStream.fillOperands(*exe, start, info)[0];
-  copyData(exe->transfers);
+  // Transfers that fit a staging buffer are copied to pinned memory and from
+  // there to device on the launch stream, so that the host is free to prepare
+  // the next batch while the copy runs.
+  auto* staging = waveStream.staging();
+  int64_t stagedBytes = 0;
+  for (auto& transfer : exe->transfers) {
+    stagedBytes += bits::roundUp(transfer.size, 8);
+  }
+  const bool staged = staging && stagedBytes <= staging->bufferSize();
+  if (!staged) {
+    copyData(exe->transfers);
+  }
   auto* device = waveStream.device();
   waveStream.installExecutables(
       folly::Range(&exe, 1),
       [&](Stream* stream, folly::Range<Executable**> executables) {
-        for (auto& transfer : executables[0]->transfers) {
-          stream->prefetch(device, transfer.to, transfer.size);
-          waveStream.stats().bytesToDevice += transfer.size;
+        auto& stats = waveStream.stats();
+        if (staged) {
+          auto* buffer = staging->acquire(stats);
+          for (auto& transfer : executables[0]->transfers) {
+            ::memcpy(buffer, transfer.from, transfer.size);
+            stream->hostToDeviceAsync(transfer.to, buffer, transfer.size);
+            buffer += bits::roundUp(transfer.size, 8);
+            stats.bytesToDevice += transfer.size;
+            stats.bytesStaged += transfer.size;
+          }
+          staging->release(*stream);
+        } else {
+          for (auto& transfer : executables[0]->transfers) {
+            stream->prefetch(device, transfer.to, transfer.size);
+            stats.bytesToDevice += transfer.size;
+          }
         }
         waveStream.markLaunch(*stream, *executables[0]);
       });
@@ -731,7 +789,16 @@ void Program::prepareForDevice(GpuArena& arena) {
         break;
       }
       case OpCode::kPlus:
-      case OpCode::kLT: {
+      case OpCode::kEquals:
+      case OpCode::kLT:
+      case OpCode::kLTE:
+      case OpCode::kGT:
+      case OpCode::kGTE:
+      case OpCode::kNE:
+      case OpCode::kStartsWith:
+      case OpCode::kEndsWith:
+      case OpCode::kContains:
+      case OpCode::kSubstr: {
         auto& bin = instruction->as<AbstractBinary>();
         markInput(bin.left);
         markInput(bin.right);
@@ -739,7 +806,8 @@ void Program::prepareForDevice(GpuArena& arena) {
         markInput(bin.predicate);
         break;
       }
-      case OpCode::kNegate: {
+      case OpCode::kNegate:
+      case OpCode::kLength: {
         auto& un = instruction->as<AbstractUnary>();
         markInput(un.input);
         markResult(un.result);
@@ -772,7 +840,12 @@ void Program::prepareForDevice(GpuArena& arena) {
   for (auto& instruction : instructions_) {
     switch (instruction->opCode) {
       case OpCode::kPlus:
-      case OpCode::kLT: {
+      case OpCode::kEquals:
+      case OpCode::kLT:
+      case OpCode::kLTE:
+      case OpCode::kGT:
+      case OpCode::kGTE:
+      case OpCode::kNE: {
         IN_HEAD(
             AbstractBinary,
             IBinary,
@@ -786,6 +859,24 @@ void Program::prepareForDevice(GpuArena& arena) {
         IN_OPERAND(predicate);
         break;
       }
+      case OpCode::kStartsWith:
+      case OpCode::kEndsWith:
+      case OpCode::kContains:
+      case OpCode::kSubstr: {
+        IN_HEAD(AbstractBinary, IBinary, instruction->opCode);
+        IN_OPERAND(left);
+        IN_OPERAND(right);
+        IN_OPERAND(result);
+        IN_OPERAND(predicate);
+        break;
+      }
+      case OpCode::kLength: {
+        IN_HEAD(AbstractUnary, IUnary, OpCode::kLength);
+        IN_OPERAND(input);
+        IN_OPERAND(result);
+        IN_OPERAND(predicate);
+        break;
+      }
       case OpCode::kFilter: {
         IN_HEAD(AbstractFilter, IFilter, OpCode::kFilter);
         IN_OPERAND(flags);
@@ -832,6 +923,15 @@ void Program::literalToOperand(AbstractOperand* abstractOp, Operand& op) {
         reinterpret_cast<uint8_t*>(deviceLiterals_ + abstractOp->literalOffset);
   } else {
     op.base = deviceLiterals_ + abstractOp->literalOffset;
+    if (abstractOp->type->kind() == TypeKind::VARCHAR) {
+      // A string that is not inlined has its bytes after the StringView. The
+      // address is known only now that the literals are on the device.
+      auto* string = reinterpret_cast<StringView*>(op.base);
+      if (!string->isInline()) {
+        string->init(
+            reinterpret_cast<const char*>(string + 1), string->size());
+      }
+    }
   }
 }
 
@@ -919,20 +1019,18 @@ int32_t Program::addLiteralTyped(AbstractOperand* op) {
     return op->literalOffset = addLiteral<char>(&zero, 1);
   }
   T value = op->constant->as<SimpleVector<T>>()->valueAt(0);
-  if constexpr (std::is_same_v<T, StringView>) {
-    int64_t inlined = 0;
-    StringView* stringView = reinterpret_cast<StringView*>(&value);
-    if (stringView->size() <= 6) {
-      int64_t inlined = static_cast<int64_t>(stringView->size()) << 48;
-      memcpy(
-          reinterpret_cast<char*>(&inlined) + 2,
-          stringView->data(),
-          stringView->size());
-      op->literalOffset = addLiteral(&inlined, 1);
+  if constexpr (std::is_same_v<T, velox::StringView>) {
+    // The device has the 8 byte StringView. A string that does not fit
+    // inline gets its bytes right after the StringView and its address
+    // is set in literalToOperand().
+    StringView string;
+    if (value.size() <= StringView::kInlineSize) {
+      string.init(value.data(), value.size());
+      op->literalOffset = addLiteral(&string, 1);
     } else {
-      int64_t zero = 0;
-      op->literalOffset = addLiteral(&zero, 1);
-      addLiteral(stringView->data(), stringView->size());
+      string.init(nullptr, value.size());
+      op->literalOffset = addLiteral(&string, 1);
+      addLiteral(value.data(), value.size());
     }
   } else {
     op->literalOffset = addLiteral(&value, 1);
@@ -39,7 +39,7 @@ struct WaveTime {
   }
 
   WaveTime operator-(const WaveTime right) const {
-    return {right.micros - micros, right.clocks - clocks};
+    return {micros - right.micros, clocks - right.clocks};
   }
 
   WaveTime operator+(const WaveTime right) const {
@@ -98,6 +98,17 @@ struct WaveStats {
   /// Time a host thread waits for device.
   WaveTime waitTime;
 
+  /// Bytes of 'bytesToDevice' copied through pinned staging buffers.
+  int64_t bytesStaged{0};
+
+  /// Time a host thread waits for a staging buffer to be free.
+  WaveTime stagingWaitTime;
+
+  /// Number of WaveStreams started while another WaveStream of the same
+  /// driver was pending on device, so that their transfers and kernels
+  /// overlap.
+  int64_t numOverlappedWaves{0};
+
   void add(const WaveStats& other);
 };
 
@@ -173,6 +184,46 @@ struct Transfer {
   size_t size;
 };
 
+/// Ring of pinned host buffers for staging host to device copies. A batch
+/// copies its pageable host data to the next buffer and enqueues the copy to
+/// device on its launch stream. The buffer is reused after the copy is done,
+/// so that the copy of batch N + 1 runs while batch N computes and the result
+/// of batch N - 1 returns to host. Owned by WaveDriver and used from its
+/// thread only.
+class StagingRing {
+ public:
+  static constexpr int32_t kNumBuffers = 3;
+
+  /// Allocates 'kNumBuffers' buffers of 'bufferSize' bytes from 'hostArena',
+  /// which must have a pinned host memory allocator.
+  StagingRing(GpuArena& hostArena, int64_t bufferSize);
+
+  int64_t bufferSize() const {
+    return bufferSize_;
+  }
+
+  /// Returns the next buffer. If its copies from the previous use are not
+  /// done, waits for them and adds the time to 'stats'.
+  char* acquire(WaveStats& stats);
+
+  /// Marks the end of the copies from the buffer of the last acquire(), which
+  /// are enqueued on 'stream'.
+  void release(Stream& stream);
+
+ private:
+  struct Buffer {
+    WaveBufferPtr data;
+    std::unique_ptr<Event> event;
+    // True if 'event' is recorded after copies from 'data'.
+    bool pending{false};
+  };
+
+  const int64_t bufferSize_;
+  std::vector<Buffer> buffers_;
+  // Index of the buffer for the next acquire().
+  int32_t next_{0};
+};
+
 std::string definesToString(const DefinesMap* map);
 
 class WaveStream;
@@ -624,6 +675,16 @@ class WaveStream {
     return stats_;
   }
 
+  /// Sets the staging buffers for host to device transfers. If not set,
+  /// transfers are copied to unified memory and prefetched.
+  void setStaging(StagingRing* staging) {
+    staging_ = staging;
+  }
+
+  StagingRing* staging() const {
+    return staging_;
+  }
+
  private:
   // true if 'op' is nullable in the context of 'this'.
   bool isNullable(const AbstractOperand& op) const;
@@ -643,6 +704,7 @@ class WaveStream {
 
   GpuArena& arena_;
   GpuArena& hostArena_;
+  StagingRing* staging_{nullptr};
   const std::vector<std::unique_ptr<AbstractOperand>>* const operands_;
   // True at '[i]' if in this stream 'operands_[i]' should have null flags.
   std::vector<bool> operandNullable_;
@@ -15,9 +15,18 @@
  */
 
 #include "velox/experimental/wave/exec/WaveDriver.h"
+
+#include <gflags/gflags.h>
+
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int64(
+    velox_wave_staging_buffer_size,
+    16 << 20,
+    "Size of each pinned host buffer for staging input batches to device. 0 "
+    "copies the batches to unified memory instead");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -44,6 +53,10 @@ WaveDriver::WaveDriver(
   auto returnBatchSize = 10000 * outputType_->size() * 10;
   hostArena_ = std::make_unique<GpuArena>(
       returnBatchSize * 10, getHostAllocator(getDevice()));
+  if (FLAGS_velox_wave_staging_buffer_size > 0) {
+    staging_ = std::make_unique<StagingRing>(
+        *hostArena_, FLAGS_velox_wave_staging_buffer_size);
+  }
   pipelines_.emplace_back();
   for (auto& op : waveOperators) {
     op->setDriver(this);
@@ -160,6 +173,12 @@ void WaveDriver::startMore() {
     auto stream =
         std::make_unique<WaveStream>(*arena_, *hostArena_, &operands());
     stream->setState(WaveStream::State::kHost);
+    stream->setStaging(staging_.get());
+    if (std::any_of(pipelines_.begin(), pipelines_.end(), [](auto& pipeline) {
+          return !pipeline.streams.empty();
+        })) {
+      ++stream->stats().numOverlappedWaves;
+    }
 
     if (auto rows = ops[0]->canAdvance(*stream)) {
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
@@ -247,6 +266,17 @@ void WaveDriver::updateStats() {
       "wave.waitTime",
       RuntimeCounter(
           waveStats_.waitTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.bytesStaged",
+      RuntimeCounter(waveStats_.bytesStaged, RuntimeCounter::Unit::kBytes));
+  lockedStats->addRuntimeStat(
+      "wave.stagingWaitTime",
+      RuntimeCounter(
+          waveStats_.stagingWaitTime.micros * 1000,
+          RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.numOverlappedWaves",
+      RuntimeCounter(waveStats_.numOverlappedWaves));
 }
 
 } // namespace facebook::velox::wave
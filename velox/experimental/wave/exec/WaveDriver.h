@@ -110,6 +110,9 @@ class WaveDriver : public exec::SourceOperator {
   std::unique_ptr<GpuArena> arena_;
   std::unique_ptr<GpuArena> deviceArena_;
   std::unique_ptr<GpuArena> hostArena_;
+  // Pinned buffers for transfers of input batches to device. nullptr if
+  // staging is disabled.
+  std::unique_ptr<StagingRing> staging_;
 
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   exec::BlockingReason blockingReason_;
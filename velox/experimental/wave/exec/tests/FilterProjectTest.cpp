@@ -117,6 +117,30 @@ TEST_F(FilterProjectTest, project) {
   assertProject(vectors);
 }
 
+TEST_F(FilterProjectTest, stagedTransfer) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0", "c1", "c0 + c1"})
+                  .planNode();
+  auto task = assertQuery(plan, "SELECT c0, c1, c0 + c1 FROM tmp");
+  int64_t bytesStaged = 0;
+  for (auto& stats : task->taskStats().pipelineStats[0].operatorStats) {
+    auto it = stats.runtimeStats.find("wave.bytesStaged");
+    if (it != stats.runtimeStats.end()) {
+      bytesStaged += it->second.sum;
+    }
+  }
+  EXPECT_LT(0, bytesStaged);
+}
+
 TEST_F(FilterProjectTest, filterProject) {
   std::vector<RowVectorPtr> vectors;
   for (int32_t i = 0; i < 1; ++i) {
@@ -132,3 +156,20 @@ TEST_F(FilterProjectTest, filterProject) {
       std::vector<std::string>{"c0", "c1", "c1 + c0 as s", "c2", "c3"},
       vectors);
 }
+
+TEST_F(FilterProjectTest, stringFilter) {
+  auto stringType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 2; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(stringType, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  assertFilterProject("c1 like 'a%'", {"c0"}, vectors);
+  assertFilterProject("c1 like '%b%'", {"c0"}, vectors);
+  assertFilterProject("c1 > 'm'", {"c0"}, vectors);
+  assertFilterProject("length(c1) < 20", {"c0", "length(c1)"}, vectors);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class OrderByTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+
+  // Makes batches of rows with unique c0 and c1, so that the order is fully
+  // determined by either. c2 repeats and has nulls.
+  std::vector<RowVectorPtr> makeVectors(int32_t numBatches, int32_t size) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto batch = 0; batch < numBatches; ++batch) {
+      auto base = batch * size;
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              size, [&](auto row) { return (base + row) * 7919 % 100'003; }),
+          makeFlatVector<double>(
+              size,
+              [&](auto row) { return ((base + row) * 31 % 1'009) - 500.5; }),
+          makeFlatVector<int32_t>(
+              size,
+              [&](auto row) { return (base + row) % 17 - 8; },
+              [&](auto row) { return (base + row) % 11 == 0; }),
+      }));
+    }
+    return vectors;
+  }
+};
+
+TEST_F(OrderByTest, singleKey) {
+  auto vectors = makeVectors(3, 1'000);
+  createDuckDbTable(vectors);
+  auto plan =
+      PlanBuilder().values(vectors).orderBy({"c0 DESC"}, false).planNode();
+  assertQueryOrdered(plan, "SELECT * FROM tmp ORDER BY c0 DESC", {0});
+
+  plan = PlanBuilder().values(vectors).orderBy({"c1"}, false).planNode();
+  assertQueryOrdered(plan, "SELECT * FROM tmp ORDER BY c1", {1});
+}
+
+TEST_F(OrderByTest, multipleKeys) {
+  auto vectors = makeVectors(2, 1'000);
+  createDuckDbTable(vectors);
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .orderBy({"c2 NULLS FIRST", "c0 DESC"}, false)
+                  .planNode();
+  assertQueryOrdered(
+      plan,
+      "SELECT * FROM tmp ORDER BY c2 NULLS FIRST, c0 DESC",
+      {2, 0});
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .orderBy({"c2 DESC NULLS LAST", "c1"}, false)
+             .planNode();
+  assertQueryOrdered(
+      plan, "SELECT * FROM tmp ORDER BY c2 DESC NULLS LAST, c1", {2, 1});
+}
+
+TEST_F(OrderByTest, topN) {
+  auto vectors = makeVectors(4, 1'000);
+  createDuckDbTable(vectors);
+  // Selects the top rows of each thread block first.
+  auto plan =
+      PlanBuilder().values(vectors).topN({"c0"}, 100, false).planNode();
+  assertQueryOrdered(plan, "SELECT * FROM tmp ORDER BY c0 LIMIT 100", {0});
+
+  // Over kBlockSize rows and a 2 word key sort all rows.
+  plan = PlanBuilder().values(vectors).topN({"c0 DESC"}, 300, false).planNode();
+  assertQueryOrdered(
+      plan, "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 300", {0});
+  plan = PlanBuilder()
+             .values(vectors)
+             .topN({"c2", "c0"}, 50, false)
+             .planNode();
+  assertQueryOrdered(
+      plan, "SELECT * FROM tmp ORDER BY c2, c0 LIMIT 50", {2, 0});
+
+  // More than the input.
+  plan = PlanBuilder().values(vectors).topN({"c1"}, 10'000, false).planNode();
+  assertQueryOrdered(plan, "SELECT * FROM tmp ORDER BY c1", {1});
+}
+
+} // namespace
+} // namespace facebook::velox::wave
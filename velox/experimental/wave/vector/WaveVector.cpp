@@ -107,6 +107,27 @@ class NoReleaser {
   void release() const {};
 };
 
+// Makes a Velox string vector from the device StringViews in 'values'. The
+// strings are copied since their bytes may be in any device buffer.
+VectorPtr toVeloxStrings(
+    vector_size_t size,
+    velox::memory::MemoryPool* pool,
+    const TypePtr& type,
+    const WaveBufferPtr& values,
+    const uint8_t* nulls) {
+  auto result = BaseVector::create<FlatVector<velox::StringView>>(
+      type, size, pool);
+  auto* strings = values->as<StringView>();
+  for (auto i = 0; i < size; ++i) {
+    if (nulls && nulls[i] == kNull) {
+      result->setNull(i, true);
+    } else {
+      result->set(i, velox::StringView(strings[i].data(), strings[i].size()));
+    }
+  }
+  return result;
+}
+
 template <TypeKind kind>
 static VectorPtr toVeloxTyped(
     vector_size_t size,
@@ -115,6 +136,9 @@ static VectorPtr toVeloxTyped(
     const WaveBufferPtr& values,
     const uint8_t* nulls) {
   using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR) {
+    return toVeloxStrings(size, pool, type, values, nulls);
+  }
 
   BufferPtr nullsView;
   if (nulls) {
@@ -112,6 +112,12 @@ class WaveVector {
     return nulls_;
   }
 
+  /// Sets the buffer with the bytes of the strings that are not inlined in
+  /// the StringViews of 'this'. The buffer is kept live as long as 'this'.
+  void setStringBuffer(WaveBufferPtr buffer) {
+    stringBuffer_ = std::move(buffer);
+  }
+
   /// Returns a Velox vector giving a view on device side data. The device
   /// buffers stay live while referenced by Velox. If there is a selection,
   /// numBlocks is the number of kBlockSize blocks the vector was allocated for,
@@ -151,6 +157,9 @@ class WaveVector {
   // Nulls, points to the tail of 'values'. nullptr if no nulls.
   uint8_t* nulls_{nullptr};
 
+  // String bytes referenced from 'values_' for VARCHAR.
+  WaveBufferPtr stringBuffer_;
+
   // If dictionary or if wrapped in a selection, vector of indices into
   // 'values'.
   WaveBufferPtr indices_;
@@ -22,6 +22,7 @@
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/StringWriter.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/FastStringConversions.h"
 #include "velox/type/Type.h"
 #include "velox/vector/SelectivityVector.h"
 
@@ -52,6 +53,28 @@ inline std::exception_ptr makeBadCastException(
       false));
 }
 
+/// Parses the 'rows' of 'input' for which 'parse' succeeds into 'result' and
+/// removes them from 'unparsedRows'. 'parse' does not throw, so the rows in
+/// the plain form of the target type are cast without the try blocks and
+/// the general conversion of the per-row kernel.
+template <typename T, typename TParse>
+void castPlainStrings(
+    const SelectivityVector& rows,
+    const SimpleVector<StringView>& input,
+    FlatVector<T>& result,
+    SelectivityVector& unparsedRows,
+    TParse parse) {
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto value = input.valueAt(row);
+    T output;
+    if (parse(value.data(), value.size(), output)) {
+      result.set(row, output);
+      unparsedRows.setValid(row, false);
+    }
+  });
+  unparsedRows.updateBounds();
+}
+
 /// @brief Convert the unscaled value of a decimal to varchar and write to raw
 /// string buffer from start position.
 /// @tparam T The type of input value.
@@ -702,30 +725,59 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
-  if (!hooks_->truncate()) {
-    if (!hooks_->legacy()) {
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::DefaultCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
-      });
+  auto castRows = [&](const SelectivityVector& kernelRows) {
+    if (!hooks_->truncate()) {
+      if (!hooks_->legacy()) {
+        applyToSelectedNoThrowLocal(context, kernelRows, result, [&](int row) {
+          applyCastKernel<ToKind, FromKind, util::DefaultCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        });
+      } else {
+        applyToSelectedNoThrowLocal(context, kernelRows, result, [&](int row) {
+          applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        });
+      }
     } else {
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
-      });
+      if (!hooks_->legacy()) {
+        applyToSelectedNoThrowLocal(context, kernelRows, result, [&](int row) {
+          applyCastKernel<ToKind, FromKind, util::TruncateCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        });
+      } else {
+        applyToSelectedNoThrowLocal(context, kernelRows, result, [&](int row) {
+          applyCastKernel<ToKind, FromKind, util::TruncateLegacyCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        });
+      }
     }
-  } else {
-    if (!hooks_->legacy()) {
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::TruncateCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
-      });
-    } else {
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::TruncateLegacyCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
-      });
+  };
+
+  // Strings in the plain form of the target type cast to the same value with
+  // all policies. The kernel gets the remaining rows, including the errors.
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+       ToKind == TypeKind::DOUBLE)) {
+    LocalSelectivityVector unparsedRows(context, rows);
+    castPlainStrings<To>(
+        rows,
+        *inputSimpleVector,
+        *resultFlatVector,
+        *unparsedRows,
+        [](const char* data, size_t size, To& output) {
+          if constexpr (ToKind == TypeKind::DOUBLE) {
+            return util::fast::tryParseDouble(data, size, output);
+          } else {
+            return util::fast::tryParseInteger(data, size, output);
+          }
+        });
+    if (unparsedRows->hasSelections()) {
+      castRows(*unparsedRows);
     }
+  } else {
+    castRows(rows);
   }
 }
 
@@ -216,18 +216,26 @@ VectorPtr CastExpr::castToDate(
   switch (fromType->kind()) {
     case TypeKind::VARCHAR: {
       auto* inputVector = input.as<SimpleVector<StringView>>();
-      applyToSelectedNoThrowLocal(context, rows, castResult, [&](int row) {
-        try {
-          resultFlatVector->set(
-              row, hooks_->castStringToDate(inputVector->valueAt(row)));
-        } catch (const VeloxUserError& ue) {
-          VELOX_USER_FAIL(
-              makeErrorMessage(input, row, DATE()) + " " + ue.message());
-        } catch (const std::exception& e) {
-          VELOX_USER_FAIL(
-              makeErrorMessage(input, row, DATE()) + " " + e.what());
-        }
-      });
+      LocalSelectivityVector unparsedRows(context, rows);
+      castPlainStrings(
+          rows,
+          *inputVector,
+          *resultFlatVector,
+          *unparsedRows,
+          util::fast::tryParseDate);
+      applyToSelectedNoThrowLocal(
+          context, *unparsedRows, castResult, [&](int row) {
+            try {
+              resultFlatVector->set(
+                  row, hooks_->castStringToDate(inputVector->valueAt(row)));
+            } catch (const VeloxUserError& ue) {
+              VELOX_USER_FAIL(
+                  makeErrorMessage(input, row, DATE()) + " " + ue.message());
+            } catch (const std::exception& e) {
+              VELOX_USER_FAIL(
+                  makeErrorMessage(input, row, DATE()) + " " + e.what());
+            }
+          });
 
       return castResult;
     }
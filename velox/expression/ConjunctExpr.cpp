@@ -200,6 +200,12 @@ void ConjunctExpr::maybeReorderInputs() {
               selectivity_[right].timeToDropValue();
         });
   }
+  if (++numBatchesSinceDecay_ >= kDecayInterval) {
+    for (auto& selectivity : selectivity_) {
+      selectivity.decay();
+    }
+    numBatchesSinceDecay_ = 0;
+  }
 }
 
 namespace {
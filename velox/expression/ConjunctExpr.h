@@ -74,6 +74,9 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Sorts the inputs by increasing time to drop a row if they are out of
+  // order. Ages the history every 'kDecayInterval' batches so that the order
+  // follows changes in the data.
   void maybeReorderInputs();
 
   void updateResult(
@@ -94,10 +97,15 @@ class ConjunctExpr : public SpecialForm {
   // temp space for nulls and values of inputs
   BufferPtr tempValues_;
   BufferPtr tempNulls_;
+  // Number of batches between halving the history in 'selectivity_'.
+  static constexpr int32_t kDecayInterval = 64;
+
   bool reorderEnabledChecked_ = false;
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // Number of batches since the history was last halved.
+  int32_t numBatchesSinceDecay_{0};
 
   friend class ConjunctCallToSpecialForm;
 };
@@ -312,6 +312,20 @@ class EvalCtx {
     return execCtx_->vectorPool();
   }
 
+  /// Returns uninitialized space for 'size' values of 'T' that stays valid
+  /// until the outermost ExprSet::eval() returns. Use for per-batch scratch
+  /// that is not referenced by any result vector. See
+  /// core::ExecCtx::allocateScratch().
+  template <typename T>
+  T* allocateScratch(vector_size_t size) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    if (size == 0) {
+      return nullptr;
+    }
+    return reinterpret_cast<T*>(
+        execCtx_->allocateScratch(sizeof(T) * size, alignof(T)));
+  }
+
   VectorPtr getVector(const TypePtr& type, vector_size_t size) {
     return execCtx_->getVector(type, size);
   }
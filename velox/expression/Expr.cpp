@@ -1085,6 +1085,7 @@ void Expr::evalEncodings(
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
         if (newRows) {
+          ++stats_.numPeeledVectors;
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity
           // vector if all selected values we are waiting for are nulls. So,
@@ -1092,6 +1093,10 @@ void Expr::evalEncodings(
           if (newRows->hasSelections()) {
             if (peelEncodingsResult.mayCache) {
               evalWithMemo(*newRows, context, peeledResult);
+            } else if (
+                context.cacheEnabled() &&
+                context.wrapEncoding() == VectorEncoding::Simple::CONSTANT) {
+              evalWithConstantMemo(*newRows, context, peeledResult);
             } else {
               evalWithNulls(*newRows, context, peeledResult);
             }
@@ -1280,6 +1285,47 @@ void Expr::evalWithMemo(
   context.releaseVector(base);
 }
 
+void Expr::evalWithConstantMemo(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  const auto row = rows.begin();
+  if (constantMemoResult_ != nullptr) {
+    bool sameInputs = true;
+    for (auto i = 0; i < distinctFields_.size(); ++i) {
+      const auto& field = context.getField(distinctFields_[i]->index(context));
+      if (!field->equalValueAt(constantMemoInputs_[i].get(), row, 0)) {
+        sameInputs = false;
+        break;
+      }
+    }
+    if (sameInputs) {
+      result = BaseVector::wrapInConstant(rows.end(), 0, constantMemoResult_);
+      return;
+    }
+    constantMemoInputs_.clear();
+    constantMemoResult_ = nullptr;
+  }
+
+  evalWithNulls(rows, context, result);
+
+  // Errors are not remembered, the next batch reports them again.
+  auto* errors = context.errors();
+  if (result == nullptr ||
+      (errors && row < errors->size() && !errors->isNullAt(row))) {
+    return;
+  }
+  for (auto* field : distinctFields_) {
+    const auto& input = context.getField(field->index(context));
+    if (!input->type()->isComparable()) {
+      constantMemoInputs_.clear();
+      return;
+    }
+    constantMemoInputs_.push_back(BaseVector::wrapInConstant(1, row, input));
+  }
+  constantMemoResult_ = BaseVector::wrapInConstant(1, row, result);
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1478,6 +1524,7 @@ bool Expr::applyFunctionWithPeeling(
   if (!peeledEncoding) {
     return false;
   }
+  ++stats_.numPeeledVectors;
   inputValues_ = std::move(peeledVectors);
   peeledVectors.clear();
 
@@ -1515,6 +1562,8 @@ void Expr::applyFunction(
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
   auto timer = cpuWallTimer();
+  const uint64_t startBytes =
+      profile_ ? context.pool()->stats().cumulativeBytes : 0;
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
   auto isAscii = type()->isVarchar()
@@ -1522,7 +1571,9 @@ void Expr::applyFunction(
       : std::nullopt;
 
   try {
-    vectorFunction_->apply(rows, inputValues_, type(), context, result);
+    if (!applyFunctionWithResultCache(rows, context, result)) {
+      vectorFunction_->apply(rows, inputValues_, type(), context, result);
+    }
   } catch (const VeloxException&) {
     throw;
   } catch (const std::exception& e) {
@@ -1554,6 +1605,133 @@ void Expr::applyFunction(
     result->asUnchecked<SimpleVector<StringView>>()->setIsAscii(
         isAscii.value(), rows);
   }
+
+  if (profile_) {
+    addProfileStats(rows, context, inputValues_, result, startBytes);
+  }
+}
+
+void Expr::addProfileStats(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    const std::vector<VectorPtr>& inputs,
+    const VectorPtr& result,
+    uint64_t startBytes) {
+  for (const auto& input : inputs) {
+    switch (input->encoding()) {
+      case VectorEncoding::Simple::FLAT:
+        ++stats_.numFlatInputs;
+        break;
+      case VectorEncoding::Simple::CONSTANT:
+        ++stats_.numConstantInputs;
+        break;
+      case VectorEncoding::Simple::DICTIONARY:
+        ++stats_.numDictionaryInputs;
+        break;
+      default:
+        ++stats_.numOtherInputs;
+        break;
+    }
+  }
+  if (result != nullptr) {
+    if (result->mayHaveNulls()) {
+      rows.applyToSelected([&](auto row) {
+        if (!result->isNullAt(row)) {
+          ++stats_.numOutputRows;
+        }
+      });
+    } else {
+      stats_.numOutputRows += rows.countSelected();
+    }
+  }
+  stats_.allocatedBytes +=
+      context.pool()->stats().cumulativeBytes - startBytes;
+}
+
+int32_t Expr::resultCacheKeyIndex(const EvalCtx& context) const {
+  if (!vectorFunctionMetadata_.expensive || !deterministic_ ||
+      !vectorFunctionMetadata_.defaultNullBehavior) {
+    return -1;
+  }
+  if (!context.execCtx()
+           ->queryCtx()
+           ->queryConfig()
+           .exprResultCacheEnabled()) {
+    return -1;
+  }
+  int32_t keyIndex = -1;
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    if (inputIsConstant_[i]) {
+      continue;
+    }
+    if (keyIndex >= 0) {
+      // The key would have to combine the values of several inputs.
+      return -1;
+    }
+    keyIndex = i;
+  }
+  if (keyIndex < 0 ||
+      !ExprResultCache::supportsTypes(inputs_[keyIndex]->type(), type())) {
+    return -1;
+  }
+  return keyIndex;
+}
+
+bool Expr::applyFunctionWithResultCache(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (!resultCacheChecked_) {
+    resultCacheKeyIndex_ = resultCacheKeyIndex(context);
+    resultCacheChecked_ = true;
+  }
+  if (resultCacheKeyIndex_ < 0) {
+    return false;
+  }
+  if (!resultCache_) {
+    resultCache_ = std::make_unique<ExprResultCache>(type(), context.pool());
+  }
+
+  LocalDecodedVector keysHolder(
+      context, *inputValues_[resultCacheKeyIndex_], rows);
+  auto* keys = keysHolder.get();
+  LocalSelectivityVector missesHolder(context, rows.end());
+  auto* misses = missesHolder.get();
+  misses->clearAll();
+  std::vector<BaseVector::CopyRange> hits;
+  resultCache_->lookup(rows, *keys, hits, *misses);
+  stats_.numResultCacheLookups += rows.countSelected();
+  stats_.numResultCacheHits += hits.size();
+
+  VectorPtr missResults;
+  if (misses->hasSelections()) {
+    vectorFunction_->apply(*misses, inputValues_, type(), context, missResults);
+    if (missResults) {
+      resultCache_->insert(*misses, *keys, *missResults, context.errors());
+    }
+  }
+
+  if (hits.empty()) {
+    if (missResults) {
+      context.moveOrCopyResult(missResults, rows, result);
+    }
+  } else {
+    auto localResult = BaseVector::create(type(), rows.end(), context.pool());
+    localResult->copyRanges(resultCache_->results(), hits);
+    if (missResults) {
+      localResult->copy(missResults.get(), *misses, nullptr);
+    } else if (misses->hasSelections()) {
+      localResult->addNulls(*misses);
+    }
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  if (resultCache_->ineffective()) {
+    // Too few repeated values to pay for the lookups.
+    resultCache_.reset();
+    resultCacheKeyIndex_ = -1;
+  }
+  return true;
 }
 
 void Expr::evalSpecialFormWithStats(
@@ -1563,8 +1741,14 @@ void Expr::evalSpecialFormWithStats(
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
   auto timer = cpuWallTimer();
+  const uint64_t startBytes =
+      profile_ ? context.pool()->stats().cumulativeBytes : 0;
 
   evalSpecialForm(rows, context, result);
+
+  if (profile_) {
+    addProfileStats(rows, context, {}, result, startBytes);
+  }
 }
 
 namespace {
@@ -1591,7 +1775,17 @@ void printExprTree(
   if (withStats) {
     out << " [cpu time: " << succinctNanos(stats.timing.cpuNanos)
         << ", rows: " << stats.numProcessedRows
-        << ", batches: " << stats.numProcessedVectors << "]";
+        << ", batches: " << stats.numProcessedVectors;
+    if (stats.numResultCacheLookups > 0) {
+      out << ", result cache hits: " << stats.numResultCacheHits << "/"
+          << stats.numResultCacheLookups;
+    }
+    if (stats.numLambdaRows > 0) {
+      out << ", lambda cpu time: "
+          << succinctNanos(stats.lambdaTiming.cpuNanos)
+          << ", lambda rows: " << stats.numLambdaRows;
+    }
+    out << "]";
   }
   out << " -> " << expr.type()->toString() << " [#" << id << "]" << std::endl;
 
@@ -1757,6 +1951,20 @@ ExprSet::ExprSet(
     bool enableConstantFolding)
     : execCtx_(execCtx) {
   exprs_ = compileExpressions(sources, execCtx, this, enableConstantFolding);
+  if (execCtx->queryCtx()->queryConfig().exprProfileEnabled()) {
+    std::unordered_set<Expr*> seen;
+    std::function<void(Expr*)> enableProfile = [&](Expr* expr) {
+      if (seen.insert(expr).second) {
+        expr->enableProfile();
+        for (const auto& input : expr->inputs()) {
+          enableProfile(input.get());
+        }
+      }
+    };
+    for (const auto& expr : exprs_) {
+      enableProfile(expr.get());
+    }
+  }
   std::vector<FieldReference*> allDistinctFields;
   for (auto& expr : exprs_) {
     Expr::mergeFields(
@@ -1792,6 +2000,29 @@ std::string makeUuid() {
 }
 } // namespace
 
+ExprProfile Expr::profile(std::unordered_set<const Expr*>& seen) const {
+  ExprProfile profile{toString(false), type_->toString(), {}, {}};
+  if (!seen.insert(this).second) {
+    return profile;
+  }
+  profile.stats = stats_;
+  profile.inputs.reserve(inputs_.size());
+  for (const auto& input : inputs_) {
+    profile.inputs.push_back(input->profile(seen));
+  }
+  return profile;
+}
+
+std::vector<ExprProfile> ExprSet::profile() const {
+  std::unordered_set<const Expr*> seen;
+  std::vector<ExprProfile> profiles;
+  profiles.reserve(exprs_.size());
+  for (const auto& expr : exprs_) {
+    profiles.push_back(expr->profile(seen));
+  }
+  return profiles;
+}
+
 std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   std::unordered_map<std::string, exec::ExprStats> stats;
   std::unordered_set<const exec::Expr*> uniqueExprs;
@@ -1888,6 +2119,22 @@ void printInputAndExprs(
     LOG(ERROR) << "Error serializing SQL expression: " << e.what();
   }
 }
+
+// Brackets one ExprSet evaluation so that the scratch memory of 'execCtx' is
+// released when the outermost evaluation returns or throws.
+class ScopedEval {
+ public:
+  explicit ScopedEval(core::ExecCtx* execCtx) : execCtx_(execCtx) {
+    execCtx_->enterEval();
+  }
+
+  ~ScopedEval() {
+    execCtx_->leaveEval();
+  }
+
+ private:
+  core::ExecCtx* const execCtx_;
+};
 } // namespace
 
 void ExprSet::eval(
@@ -1897,6 +2144,7 @@ void ExprSet::eval(
     const SelectivityVector& rows,
     EvalCtx& context,
     std::vector<VectorPtr>& result) {
+  ScopedEval scopedEval(context.execCtx());
   result.resize(exprs_.size());
   if (initialize) {
     clearSharedSubexprs();
@@ -1958,6 +2206,7 @@ void ExprSetSimplified::eval(
     const SelectivityVector& rows,
     EvalCtx& context,
     std::vector<VectorPtr>& result) {
+  ScopedEval scopedEval(context.execCtx());
   result.resize(exprs_.size());
   if (initialize) {
     clearSharedSubexprs();
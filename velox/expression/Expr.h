@@ -25,6 +25,8 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/ExprResultCache.h"
+#include "velox/expression/ExprStats.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Subfield.h"
 #include "velox/vector/SimpleVector.h"
@@ -48,32 +50,6 @@ class ExprSet;
 class FieldReference;
 class VectorFunction;
 
-struct ExprStats {
-  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
-  CpuWallTiming timing;
-
-  /// Number of processed rows.
-  uint64_t numProcessedRows{0};
-
-  /// Number of processed vectors / batches. Allows to compute average batch
-  /// size.
-  uint64_t numProcessedVectors{0};
-
-  void add(const ExprStats& other) {
-    timing.add(other.timing);
-    numProcessedRows += other.numProcessedRows;
-    numProcessedVectors += other.numProcessedVectors;
-  }
-
-  std::string toString() const {
-    return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
-        timing.toString(),
-        numProcessedRows,
-        numProcessedVectors);
-  }
-};
-
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -257,6 +233,8 @@ class Expr {
     baseOfDictionaryRawPtr_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
+    constantMemoInputs_.clear();
+    constantMemoResult_ = nullptr;
   }
 
   const TypePtr& type() const {
@@ -359,6 +337,17 @@ class Expr {
     return stats_;
   }
 
+  /// Enables the collection of the per-node counters in ExprStats that are
+  /// maintained only if QueryConfig.exprProfileEnabled() is 'true'. Also
+  /// enables CPU time tracking.
+  void enableProfile() {
+    profile_ = true;
+  }
+
+  /// Returns the statistics of 'this' and its inputs as a tree. Reports each
+  /// common sub-expression in 'seen' only once.
+  ExprProfile profile(std::unordered_set<const Expr*>& seen) const;
+
   void addNulls(
       const SelectivityVector& rows,
       const uint64_t* rawNulls,
@@ -428,6 +417,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Evaluates 'this' over peeled constant inputs. 'rows' is the single row
+  // of the peeled inputs. Returns the result of the previous call if the
+  // inputs have the same values, e.g. partition keys of the same split.
+  void evalWithConstantMemo(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -459,6 +456,19 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Calls the function of 'this' only on the rows of 'inputValues_' whose
+  // value of the non-constant argument is not in 'resultCache_' and takes the
+  // other results from the cache. Returns false if the results of 'this' are
+  // not cached.
+  bool applyFunctionWithResultCache(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Returns the index of the input whose values key 'resultCache_' or -1 if
+  // results of 'this' can't be cached.
+  int32_t resultCacheKeyIndex(const EvalCtx& context) const;
+
   // Returns true if values in 'distinctFields_' have nulls that are
   // worth skipping. If so, the rows in 'rows' with at least one sure
   // null are deselected in 'nullHolder->get()'.
@@ -547,10 +557,20 @@ class Expr {
   /// Returns an instance of CpuWallTimer if cpu usage tracking is enabled. Null
   /// otherwise.
   std::unique_ptr<CpuWallTimer> cpuWallTimer() {
-    return trackCpuUsage_ ? std::make_unique<CpuWallTimer>(stats_.timing)
-                          : nullptr;
+    return trackCpuUsage_ || profile_
+        ? std::make_unique<CpuWallTimer>(stats_.timing)
+        : nullptr;
   }
 
+  // Updates the profile counters in 'stats_' for evaluating 'rows' into
+  // 'result' with 'inputs' from memory pool bytes 'startBytes'.
+  void addProfileStats(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      const std::vector<VectorPtr>& inputs,
+      const VectorPtr& result,
+      uint64_t startBytes);
+
   // Should be called only after computeMetadata() has been called on 'inputs_'.
   // Computes distinctFields for this expression. Also updates any multiply
   // referenced fields.
@@ -638,9 +658,25 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Values of the constant inputs, 1:1 to 'distinctFields_', for which
+  // 'constantMemoResult_' was computed. Single row constant vectors.
+  std::vector<VectorPtr> constantMemoInputs_;
+  VectorPtr constantMemoResult_;
+
+  // Results of the function of 'this' by the value of the input at
+  // 'resultCacheKeyIndex_'. Created on first use.
+  std::unique_ptr<ExprResultCache> resultCache_;
+  // True once it is known whether results of 'this' are cached.
+  bool resultCacheChecked_{false};
+  // Index of the non-constant input or -1 if results are not cached.
+  int32_t resultCacheKeyIndex_{-1};
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
+  // True if per-node profile counters are collected into 'stats_'.
+  bool profile_{false};
+
   // If true computeMetaData returns, otherwise meta data is computed and the
   // flag is set to true.
   bool metaDataComputed_ = false;
@@ -737,6 +773,10 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns per-node evaluation statistics, one tree per expression. See
+  /// QueryConfig::kExprProfileEnabled.
+  std::vector<ExprProfile> profile() const;
+
  protected:
   void clearSharedSubexprs();
 
@@ -538,6 +538,138 @@ ExprPtr compileExpression(
       enableConstantFolding);
 }
 
+/// Returns the call to the parse function of 'call' if 'call' is a member of
+/// a shared parse family, nullptr otherwise.
+TypedExprPtr sharedParseOf(const core::CallTypedExpr& call) {
+  auto it = sharedParseFunctions().find(call.name());
+  if (it == sharedParseFunctions().end() ||
+      call.inputs().size() < it->second.numParseArgs) {
+    return nullptr;
+  }
+  const auto& function = it->second;
+  std::vector<TypedExprPtr> parseInputs(
+      call.inputs().begin(), call.inputs().begin() + function.numParseArgs);
+  return std::make_shared<core::CallTypedExpr>(
+      function.parseType, std::move(parseInputs), function.parseFunction);
+}
+
+using SharedParseMap = folly::F14FastMap<
+    const ITypedExpr*,
+    std::unordered_set<std::string>,
+    ITypedExprHasher,
+    ITypedExprComparer>;
+
+/// Adds the names of the shared parse family members called in 'expr' to
+/// 'calls', keyed on their parse calls. 'parses' keeps the keys alive. Does
+/// not look into lambdas since common subexpressions are not shared across
+/// scopes.
+void collectSharedParses(
+    const TypedExprPtr& expr,
+    SharedParseMap& calls,
+    std::vector<TypedExprPtr>& parses) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return;
+  }
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    if (auto parse = sharedParseOf(*call)) {
+      auto it = calls.find(parse.get());
+      if (it == calls.end()) {
+        parses.push_back(parse);
+        it = calls.emplace(parse.get(), std::unordered_set<std::string>{})
+                 .first;
+      }
+      it->second.insert(call->name());
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectSharedParses(input, calls, parses);
+  }
+}
+
+/// Returns 'expr' with the calls whose parse is shared by two or more
+/// different functions replaced by their projections of the parse. Rebuilds
+/// only function calls, casts and dereferences, other expressions are kept as
+/// is.
+TypedExprPtr rewriteSharedParses(
+    const TypedExprPtr& expr,
+    const SharedParseMap& calls) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  auto* dereference =
+      dynamic_cast<const core::DereferenceTypedExpr*>(expr.get());
+  if (!call && !cast && !dereference) {
+    return expr;
+  }
+
+  bool changed = false;
+  std::vector<TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(rewriteSharedParses(input, calls));
+    changed |= inputs.back() != input;
+  }
+
+  if (call) {
+    auto rewritten = changed
+        ? std::make_shared<core::CallTypedExpr>(
+              call->type(), std::move(inputs), call->name())
+        : std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+    if (auto parse = sharedParseOf(*rewritten)) {
+      auto it = calls.find(parse.get());
+      if (it != calls.end() && it->second.size() > 1) {
+        const auto& function = sharedParseFunctions().at(call->name());
+        if (auto projection = function.project(parse, *rewritten)) {
+          VELOX_CHECK(
+              projection->type()->equivalent(*call->type()),
+              "Shared parse projection of {} has type {}, expected {}",
+              call->name(),
+              projection->type()->toString(),
+              call->type()->toString());
+          return projection;
+        }
+      }
+    }
+    return rewritten;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (cast) {
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), inputs, cast->nullOnFailure());
+  }
+  return std::make_shared<core::DereferenceTypedExpr>(
+      dereference->type(), inputs[0], dereference->index());
+}
+
+/// Rewrites the members of shared parse families in 'sources' that share
+/// their parse with a different member to projections of the parse. See
+/// SharedParseFunction.
+std::vector<TypedExprPtr> rewriteSharedParses(
+    const std::vector<TypedExprPtr>& sources) {
+  if (sharedParseFunctions().empty()) {
+    return sources;
+  }
+  SharedParseMap calls;
+  std::vector<TypedExprPtr> parses;
+  for (const auto& source : sources) {
+    collectSharedParses(source, calls, parses);
+  }
+  bool anyShared = false;
+  for (const auto& [parse, names] : calls) {
+    anyShared |= names.size() > 1;
+  }
+  if (!anyShared) {
+    return sources;
+  }
+  std::vector<TypedExprPtr> rewritten;
+  rewritten.reserve(sources.size());
+  for (const auto& source : sources) {
+    rewritten.push_back(rewriteSharedParses(source, calls));
+  }
+  return rewritten;
+}
+
 /// Walk expression tree and collect names of functions used in CallTypedExpr
 /// into provided 'names' set.
 void collectCallNames(
@@ -577,13 +709,17 @@ std::unordered_set<std::string> collectFlatteningCandidates(
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
-    const std::vector<TypedExprPtr>& sources,
+    const std::vector<TypedExprPtr>& originalSources,
     core::ExecCtx* execCtx,
     ExprSet* exprSet,
     bool enableConstantFolding) {
   Scope scope({}, nullptr, exprSet);
   std::vector<std::shared_ptr<Expr>> exprs;
-  exprs.reserve(sources.size());
+  exprs.reserve(originalSources.size());
+
+  // The rewritten trees must outlive compilation since 'scope' refers to
+  // them by raw pointer.
+  const auto sources = rewriteSharedParses(originalSources);
 
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
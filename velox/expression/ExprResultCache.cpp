@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprResultCache.h"
+
+namespace facebook::velox::exec {
+namespace {
+constexpr vector_size_t kInitialCapacity = 1'024;
+
+uint64_t outOfLineBytes(StringView value) {
+  return value.isInline() ? 0 : value.size();
+}
+} // namespace
+
+// static
+bool ExprResultCache::supportsTypes(
+    const TypePtr& keyType,
+    const TypePtr& resultType) {
+  return (keyType->kind() == TypeKind::VARCHAR ||
+          keyType->kind() == TypeKind::VARBINARY) &&
+      resultType->isPrimitiveType();
+}
+
+ExprResultCache::ExprResultCache(TypePtr resultType, memory::MemoryPool* pool)
+    : resultType_(std::move(resultType)), pool_(pool) {}
+
+void ExprResultCache::lookup(
+    const SelectivityVector& rows,
+    const DecodedVector& keys,
+    std::vector<BaseVector::CopyRange>& hits,
+    SelectivityVector& misses) {
+  rows.applyToSelected([&](vector_size_t row) {
+    auto it = map_.find(keys.valueAt<StringView>(row));
+    if (it == map_.end()) {
+      misses.setValid(row, true);
+    } else {
+      hits.push_back({it->second, row, 1});
+    }
+  });
+  misses.updateBounds();
+  numLookups_ += rows.countSelected();
+  numHits_ += hits.size();
+}
+
+void ExprResultCache::insert(
+    const SelectivityVector& rows,
+    const DecodedVector& keys,
+    const BaseVector& results,
+    const ErrorVector* errors) {
+  DecodedVector decodedResults(results, rows);
+  const bool isString = resultType_->isVarchar() || resultType_->isVarbinary();
+  rows.testSelected([&](vector_size_t row) {
+    if (size_ >= kMaxEntries || numBytes_ >= kMaxBytes) {
+      return false;
+    }
+    if (errors && row < errors->size() && !errors->isNullAt(row)) {
+      return true;
+    }
+    const auto key = keys.valueAt<StringView>(row);
+    if (key.size() > kMaxKeyBytes || map_.count(key) > 0) {
+      return true;
+    }
+    ensureCapacity();
+    const auto slot = size_++;
+    keys_->set(slot, key);
+    numBytes_ += outOfLineBytes(key);
+    map_.emplace(keys_->valueAt(slot), slot);
+    if (decodedResults.isNullAt(row)) {
+      results_->setNull(slot, true);
+    } else if (isString) {
+      const auto value = decodedResults.valueAt<StringView>(row);
+      // Copies the string so that the cache does not hold on to the buffers
+      // of the input batch.
+      results_->asUnchecked<FlatVector<StringView>>()->set(slot, value);
+      numBytes_ += outOfLineBytes(value);
+    } else {
+      results_->copy(&results, slot, row, 1);
+    }
+    return true;
+  });
+}
+
+void ExprResultCache::ensureCapacity() {
+  if (!keys_) {
+    keys_ = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kInitialCapacity, pool_);
+    results_ = BaseVector::create(resultType_, kInitialCapacity, pool_);
+    return;
+  }
+  if (size_ < keys_->size()) {
+    return;
+  }
+  const auto capacity = std::min(2 * keys_->size(), kMaxEntries);
+  keys_->resize(capacity);
+  results_->resize(capacity);
+}
+
+} // namespace facebook::velox::exec
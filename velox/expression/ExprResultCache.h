@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+/// Bounded map from the value of the single non-constant string argument of a
+/// deterministic function call to the result of the call. Lets Expr skip
+/// calling an expensive function on values it has already seen in previous
+/// batches, e.g. repeated URLs or JSON documents that are not dictionary
+/// encoded. Results of rows that had an error are not cached. Keys longer
+/// than 'kMaxKeyBytes' are not cached. Nothing is added once the cache holds
+/// 'kMaxEntries' entries or 'kMaxBytes' bytes of strings.
+class ExprResultCache {
+ public:
+  static constexpr vector_size_t kMaxEntries = 10'000;
+  static constexpr int32_t kMaxKeyBytes = 1'024;
+  static constexpr uint64_t kMaxBytes = 4 << 20;
+
+  /// Number of lookups after which the cache is dropped if fewer than
+  /// 'kMinHitPct' percent of them were hits.
+  static constexpr uint64_t kMinLookups = 10'000;
+  static constexpr uint64_t kMinHitPct = 20;
+
+  /// Returns true if results of type 'resultType' for keys of type 'keyType'
+  /// can be cached.
+  static bool supportsTypes(const TypePtr& keyType, const TypePtr& resultType);
+
+  /// Allocates the cached keys and results from 'pool'.
+  ExprResultCache(TypePtr resultType, memory::MemoryPool* pool);
+
+  /// Looks up the values of 'keys' at 'rows'. Appends a range of 1 from the
+  /// cached result to the row to 'hits' for each hit and sets the row in
+  /// 'misses' otherwise. 'misses' must be sized to at least 'rows.end()' and
+  /// have no rows selected.
+  void lookup(
+      const SelectivityVector& rows,
+      const DecodedVector& keys,
+      std::vector<BaseVector::CopyRange>& hits,
+      SelectivityVector& misses);
+
+  /// Adds the results in 'results' for the values of 'keys' at 'rows'. Skips
+  /// the rows that have an error in 'errors' if 'errors' is not nullptr.
+  void insert(
+      const SelectivityVector& rows,
+      const DecodedVector& keys,
+      const BaseVector& results,
+      const ErrorVector* errors);
+
+  /// The cached results. The ranges from lookup() refer to this.
+  const BaseVector* results() const {
+    return results_.get();
+  }
+
+  /// Returns true if the cache has seen enough lookups with too few hits to
+  /// be worth keeping.
+  bool ineffective() const {
+    return numLookups_ >= kMinLookups &&
+        numHits_ * 100 < numLookups_ * kMinHitPct;
+  }
+
+  uint64_t numLookups() const {
+    return numLookups_;
+  }
+
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+  vector_size_t size() const {
+    return size_;
+  }
+
+ private:
+  // Makes room for at least 'size_' + 1 entries.
+  void ensureCapacity();
+
+  const TypePtr resultType_;
+  memory::MemoryPool* const pool_;
+
+  // Copies of the keys. The StringViews in 'map_' point to these.
+  FlatVectorPtr<StringView> keys_;
+  // The result for the key at the same position in 'keys_'.
+  VectorPtr results_;
+  // Number of entries in 'keys_' and 'results_'.
+  vector_size_t size_{0};
+  // Bytes of non-inlined strings in 'keys_' and 'results_'.
+  uint64_t numBytes_{0};
+  folly::F14FastMap<StringView, vector_size_t> map_;
+
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprStats.h"
+
+#include <sstream>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::exec {
+
+void ExprProfile::add(const ExprProfile& other) {
+  VELOX_CHECK_EQ(name, other.name);
+  VELOX_CHECK_EQ(inputs.size(), other.inputs.size());
+  stats.add(other.stats);
+  for (auto i = 0; i < inputs.size(); ++i) {
+    inputs[i].add(other.inputs[i]);
+  }
+}
+
+std::string ExprProfile::toString(const std::string& indent) const {
+  std::stringstream out;
+  out << indent << name << " [cpu time: "
+      << succinctNanos(stats.timing.cpuNanos)
+      << ", rows: " << stats.numProcessedRows
+      << ", output rows: " << stats.numOutputRows
+      << ", batches: " << stats.numProcessedVectors
+      << ", peeled: " << stats.numPeeledVectors
+      << ", inputs flat/constant/dictionary/other: " << stats.numFlatInputs
+      << "/" << stats.numConstantInputs << "/" << stats.numDictionaryInputs
+      << "/" << stats.numOtherInputs
+      << ", allocated: " << succinctBytes(stats.allocatedBytes);
+  if (stats.numLambdaRows > 0) {
+    out << ", lambda cpu time: " << succinctNanos(stats.lambdaTiming.cpuNanos)
+        << ", lambda rows: " << stats.numLambdaRows;
+  }
+  out << "] -> " << type << std::endl;
+  const auto newIndent = indent + "   ";
+  for (const auto& input : inputs) {
+    out << input.toString(newIndent);
+  }
+  return out.str();
+}
+
+void addExprProfiles(
+    std::vector<ExprProfile>& profiles,
+    const std::vector<ExprProfile>& other) {
+  if (profiles.empty()) {
+    profiles = other;
+    return;
+  }
+  VELOX_CHECK_EQ(profiles.size(), other.size());
+  for (auto i = 0; i < profiles.size(); ++i) {
+    profiles[i].add(other[i]);
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "velox/common/time/CpuWallTimer.h"
+
+namespace facebook::velox::exec {
+
+struct ExprStats {
+  /// Requires QueryConfig.exprTrackCpuUsage() or
+  /// QueryConfig.exprProfileEnabled() to be 'true'.
+  CpuWallTiming timing;
+
+  /// Number of processed rows.
+  uint64_t numProcessedRows{0};
+
+  /// Number of processed vectors / batches. Allows to compute average batch
+  /// size.
+  uint64_t numProcessedVectors{0};
+
+  /// Number of rows looked up in and found in the result cache. See
+  /// QueryConfig::kExprResultCacheEnabled.
+  uint64_t numResultCacheLookups{0};
+  uint64_t numResultCacheHits{0};
+
+  /// The counters below are maintained only if
+  /// QueryConfig.exprProfileEnabled() is 'true'.
+
+  /// Number of non-null result rows.
+  uint64_t numOutputRows{0};
+
+  /// Number of input vectors by encoding as seen by the function, i.e. after
+  /// peeling.
+  uint64_t numFlatInputs{0};
+  uint64_t numConstantInputs{0};
+  uint64_t numDictionaryInputs{0};
+  uint64_t numOtherInputs{0};
+
+  /// Number of batches evaluated on peeled inputs.
+  uint64_t numPeeledVectors{0};
+
+  /// Bytes allocated from the memory pool during evaluation. For special
+  /// forms this includes the evaluation of the inputs.
+  uint64_t allocatedBytes{0};
+
+  /// Set only for lambda expressions. The time of evaluating the body of the
+  /// lambda and the number of rows it is evaluated on, e.g. the elements of
+  /// the arrays for transform(). The time is also included in the 'timing' of
+  /// the function that applies the lambda. The timing requires the same
+  /// configs as 'timing'.
+  CpuWallTiming lambdaTiming;
+  uint64_t numLambdaRows{0};
+
+  void add(const ExprStats& other) {
+    timing.add(other.timing);
+    numProcessedRows += other.numProcessedRows;
+    numProcessedVectors += other.numProcessedVectors;
+    numResultCacheLookups += other.numResultCacheLookups;
+    numResultCacheHits += other.numResultCacheHits;
+    numOutputRows += other.numOutputRows;
+    numFlatInputs += other.numFlatInputs;
+    numConstantInputs += other.numConstantInputs;
+    numDictionaryInputs += other.numDictionaryInputs;
+    numOtherInputs += other.numOtherInputs;
+    numPeeledVectors += other.numPeeledVectors;
+    allocatedBytes += other.allocatedBytes;
+    lambdaTiming.add(other.lambdaTiming);
+    numLambdaRows += other.numLambdaRows;
+  }
+
+  std::string toString() const {
+    return fmt::format(
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numResultCacheLookups: {}, numResultCacheHits: {}, "
+        "lambdaTiming: {}, numLambdaRows: {}",
+        timing.toString(),
+        numProcessedRows,
+        numProcessedVectors,
+        numResultCacheLookups,
+        numResultCacheHits,
+        lambdaTiming.toString(),
+        numLambdaRows);
+  }
+};
+
+/// Per-node statistics of one expression tree. Produced by
+/// ExprSet::profile() when QueryConfig.exprProfileEnabled() is 'true'. A
+/// common sub-expression has its statistics and inputs reported only at its
+/// first occurrence.
+struct ExprProfile {
+  std::string name;
+  std::string type;
+  ExprStats stats;
+  std::vector<ExprProfile> inputs;
+
+  /// Adds the statistics of 'other', which must be a profile of the same
+  /// expression tree, e.g. produced by a different driver.
+  void add(const ExprProfile& other);
+
+  /// Returns one line per node, indented by depth.
+  std::string toString(const std::string& indent = "") const;
+};
+
+/// Adds 'other' to 'profiles'. Copies 'other' if 'profiles' is empty.
+void addExprProfiles(
+    std::vector<ExprProfile>& profiles,
+    const std::vector<ExprProfile>& other);
+
+} // namespace facebook::velox::exec
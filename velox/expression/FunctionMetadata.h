@@ -40,6 +40,11 @@ struct VectorFunctionMetadata {
   /// In this case, 'rows' in VectorFunction::apply will point only to positions
   /// for which all arguments are not null.
   bool defaultNullBehavior{true};
+
+  /// True if the function is costly enough per row that caching its results
+  /// across batches pays off, e.g. regular expression matching or JSON
+  /// parsing. See QueryConfig::kExprResultCacheEnabled.
+  bool expensive{false};
 };
 
 class VectorFunctionMetadataBuilder {
@@ -59,6 +64,11 @@ class VectorFunctionMetadataBuilder {
     return *this;
   }
 
+  VectorFunctionMetadataBuilder& expensive(bool expensive) {
+    metadata_.expensive = expensive;
+    return *this;
+  }
+
   const VectorFunctionMetadata& build() const {
     return metadata_;
   }
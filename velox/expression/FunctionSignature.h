@@ -39,6 +39,7 @@ enum class ParameterType : int8_t { kTypeParameter, kIntegerParameter };
 /// Canonical names for functions that have special treatments in pushdowns.
 enum class FunctionCanonicalName {
   kUnknown,
+  kBetween,
   kLt,
   kNot,
   kRand,
@@ -26,18 +26,24 @@ namespace {
 // Represents an interpreted lambda expression. 'signature' describes
 // the parameters passed by the caller. 'capture' is a row with a
 // leading nullptr for each element in 'signature' followed by the
-// vectors for the captures from the lambda's definition scope.
+// vectors for the captures from the lambda's definition scope. The
+// evaluations of 'body' are recorded in 'stats' of the LambdaExpr, with
+// timing if 'trackCpuUsage' is true.
 class ExprCallable : public Callable {
  public:
   ExprCallable(
       RowTypePtr signature,
       RowVectorPtr capture,
       std::shared_ptr<Expr> body,
-      std::vector<std::shared_ptr<Expr>> sharedExprsToReset)
+      std::vector<std::shared_ptr<Expr>> sharedExprsToReset,
+      ExprStats* stats,
+      bool trackCpuUsage)
       : signature_(std::move(signature)),
         capture_(std::move(capture)),
         body_(std::move(body)),
-        sharedExprsToReset_(std::move(sharedExprsToReset)) {}
+        sharedExprsToReset_(std::move(sharedExprsToReset)),
+        stats_(stats),
+        trackCpuUsage_(trackCpuUsage) {}
 
   bool hasCapture() const override {
     return capture_->childrenSize() > signature_->size();
@@ -56,7 +62,7 @@ class ExprCallable : public Callable {
     ScopedVarSetter throwOnError(
         lambdaCtx.mutableThrowOnError(), context->throwOnError());
     resetSharedExprs();
-    body_->eval(rows, lambdaCtx, *result);
+    evalBody(rows, lambdaCtx, *result);
     transformErrorVector(lambdaCtx, context, rows, elementToTopLevelRows);
   }
 
@@ -72,11 +78,22 @@ class ExprCallable : public Callable {
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(lambdaCtx.mutableThrowOnError(), false);
     resetSharedExprs();
-    body_->eval(rows, lambdaCtx, *result);
+    evalBody(rows, lambdaCtx, *result);
     lambdaCtx.swapErrors(elementErrors);
   }
 
  private:
+  void evalBody(
+      const SelectivityVector& rows,
+      EvalCtx& lambdaCtx,
+      VectorPtr& result) {
+    stats_->numLambdaRows += rows.countSelected();
+    auto timer = trackCpuUsage_
+        ? std::make_unique<CpuWallTimer>(stats_->lambdaTiming)
+        : nullptr;
+    body_->eval(rows, lambdaCtx, result);
+  }
+
   void resetSharedExprs() {
     for (auto& expr : sharedExprsToReset_) {
       expr->reset();
@@ -142,6 +159,8 @@ class ExprCallable : public Callable {
   // List of Shared Exprs that are decendants of 'body_' for which reset() needs
   // to be called before calling `body_->eval()`.
   std::vector<std::shared_ptr<Expr>> sharedExprsToReset_;
+  ExprStats* const stats_;
+  const bool trackCpuUsage_;
 };
 
 void extractSharedExpressions(
@@ -253,7 +272,12 @@ void LambdaExpr::evalSpecialForm(
       values,
       0);
   auto callable = std::make_shared<ExprCallable>(
-      signature_, capture, body_, sharedExprsToReset_);
+      signature_,
+      capture,
+      body_,
+      sharedExprsToReset_,
+      &stats_,
+      trackCpuUsage_ || profile_);
   std::shared_ptr<FunctionVector> functions;
   if (!result) {
     functions = std::make_shared<FunctionVector>(context.pool(), type_);
@@ -16,6 +16,8 @@
 
 #include "velox/expression/SimpleFunctionRegistry.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::exec {
 namespace {
 
@@ -40,6 +42,9 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
     bool overwrite) {
   const auto sanitizedName = sanitizeName(name);
   return registeredFunctions_.withWLock([&](auto& map) {
+    // A new signature may match calls that resolved to another or to no
+    // function before.
+    resolutions_.wlock()->clear();
     SignatureMap& signatureMap = map[sanitizedName];
     auto& functions = signatureMap[*metadata->signature()];
 
@@ -107,7 +112,8 @@ SimpleFunctionRegistry::getFunctionSignaturesAndMetadata(
         VectorFunctionMetadata metadata{
             false,
             functions[0]->getMetadata().isDeterministic(),
-            functions[0]->getMetadata().defaultNullBehavior()};
+            functions[0]->getMetadata().defaultNullBehavior(),
+            functions[0]->getMetadata().isExpensive()};
         result.emplace_back(
             std::pair<VectorFunctionMetadata, const FunctionSignature*>{
                 metadata, &signature});
@@ -144,13 +150,45 @@ bool physicalTypeMatches(const TypePtr& type, const TypePtr& physicalType) {
 
 } // namespace
 
+bool SimpleFunctionRegistry::ResolutionKey::operator==(
+    const ResolutionKey& other) const {
+  if (name != other.name || argTypes.size() != other.argTypes.size()) {
+    return false;
+  }
+  for (auto i = 0; i < argTypes.size(); ++i) {
+    if (*argTypes[i] != *other.argTypes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t SimpleFunctionRegistry::ResolutionKeyHasher::operator()(
+    const ResolutionKey& key) const {
+  auto hash = std::hash<std::string>()(key.name);
+  for (const auto& type : key.argTypes) {
+    hash = bits::hashMix(hash, type->hashKind());
+  }
+  return hash;
+}
+
 std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
 SimpleFunctionRegistry::resolveFunction(
     const std::string& name,
     const std::vector<TypePtr>& argTypes) const {
+  ResolutionKey key{name, argTypes};
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
+    {
+      auto resolutions = resolutions_.rlock();
+      auto it = resolutions->find(key);
+      if (it != resolutions->end()) {
+        selectedCandidate = it->second.entry;
+        selectedCandidateType = it->second.type;
+        return;
+      }
+    }
     if (const auto* signatureMap = getSignatureMap(name, map)) {
       for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
         SignatureBinder binder(candidateSignature, argTypes);
@@ -190,6 +228,13 @@ SimpleFunctionRegistry::resolveFunction(
         }
       }
     }
+
+    auto resolutions = resolutions_.wlock();
+    if (resolutions->size() >= kMaxResolutions) {
+      resolutions->clear();
+    }
+    resolutions->emplace(
+        std::move(key), Resolution{selectedCandidate, selectedCandidateType});
   });
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
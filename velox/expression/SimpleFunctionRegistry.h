@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/core/SimpleFunctionMetadata.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
@@ -104,7 +106,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutions_.wlock()->clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -136,7 +141,8 @@ class SimpleFunctionRegistry {
       return VectorFunctionMetadata{
           false,
           functionEntry_.getMetadata().isDeterministic(),
-          functionEntry_.getMetadata().defaultNullBehavior()};
+          functionEntry_.getMetadata().defaultNullBehavior(),
+          functionEntry_.getMetadata().isExpensive()};
     }
 
    private:
@@ -144,11 +150,44 @@ class SimpleFunctionRegistry {
     const TypePtr type_;
   };
 
+  /// Returns the implementation for 'name' with arguments of 'argTypes' and
+  /// its return type, or std::nullopt if none matches. The results, including
+  /// the misses, are cached until the next registration, so that compiling
+  /// the same expressions for each driver and task binds the signatures once.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
+  /// Returns the number of cached results of resolveFunction().
+  size_t numCachedResolutions() const {
+    return resolutions_.rlock()->size();
+  }
+
  private:
+  // Upper bound on the entries of 'resolutions_'. The cache is cleared when
+  // full.
+  static constexpr size_t kMaxResolutions = 10'000;
+
+  struct ResolutionKey {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const ResolutionKey& other) const;
+  };
+
+  struct ResolutionKeyHasher {
+    size_t operator()(const ResolutionKey& key) const;
+  };
+
+  struct Resolution {
+    // nullptr if no function matches.
+    const FunctionEntry* entry;
+    TypePtr type;
+  };
+
+  using ResolutionMap =
+      folly::F14FastMap<ResolutionKey, Resolution, ResolutionKeyHasher>;
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -167,6 +206,11 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Results of resolveFunction() by name and argument types. Filled and
+  // cleared only while holding the lock of 'registeredFunctions_', so that no
+  // entry outlives the FunctionEntry it points to.
+  mutable folly::Synchronized<ResolutionMap> resolutions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
@@ -197,4 +197,18 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::unordered_map<std::string, SharedParseFunction>& sharedParseFunctions() {
+  static std::unordered_map<std::string, SharedParseFunction> functions;
+  return functions;
+}
+
+void registerSharedParseFunction(
+    const std::string& name,
+    SharedParseFunction function) {
+  VELOX_CHECK_GT(function.numParseArgs, 0);
+  VELOX_CHECK_NOT_NULL(function.parseType);
+  VELOX_CHECK(function.project != nullptr);
+  sharedParseFunctions()[name] = std::move(function);
+}
+
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
@@ -285,6 +286,42 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// Describes a function whose cost is dominated by a parse of its leading
+/// arguments that other functions of the same family repeat, e.g. all
+/// url_extract_xxx functions match the same URL regex. When an ExprSet calls
+/// two or more different members of a family with the same parse arguments,
+/// each call is rewritten to a projection of a call to 'parseFunction'. The
+/// parse then becomes a common subexpression and runs once per row for all
+/// members.
+struct SharedParseFunction {
+  /// Name of the function that returns the full parse result.
+  std::string parseFunction;
+
+  /// Return type of 'parseFunction'.
+  TypePtr parseType;
+
+  /// Number of leading arguments of the call that are the parse input.
+  size_t numParseArgs{1};
+
+  /// Returns the expression that computes 'call' from 'parsed', the call to
+  /// 'parseFunction' over the parse input of 'call'. Returns nullptr if
+  /// 'call' cannot be computed from the parse, e.g. for unsupported types.
+  std::function<core::TypedExprPtr(
+      const core::TypedExprPtr& parsed,
+      const core::CallTypedExpr& call)>
+      project;
+};
+
+/// Returns the shared parse functions keyed on function name.
+std::unordered_map<std::string, SharedParseFunction>& sharedParseFunctions();
+
+/// Registers 'function' as a member of the shared parse family of
+/// 'function.parseFunction'. Not thread-safe. Meant to be called together
+/// with function registration.
+void registerSharedParseFunction(
+    const std::string& name,
+    SharedParseFunction function);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
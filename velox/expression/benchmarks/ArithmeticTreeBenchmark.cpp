@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Measures the cost of evaluating a tree of arithmetic functions over double
+// columns node by node, where each node writes an intermediate vector,
+// against a single hand fused loop over the rows that computes the same
+// values. The difference is the upper bound of what fusing such subtrees into
+// one loop can save.
+
+using namespace facebook::velox;
+
+namespace {
+constexpr vector_size_t kSize = 10'000;
+constexpr const char* kExpression =
+    "c0 * c1 + c2 * c3 - c0 / (c1 + 1.0) + c2 * c2 * 0.5";
+
+class ArithmeticTreeBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  ArithmeticTreeBenchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerAllScalarFunctions();
+
+    std::vector<VectorPtr> children;
+    for (auto i = 0; i < 4; ++i) {
+      children.push_back(vectorMaker_.flatVector<double>(
+          kSize, [i](auto row) { return row * 0.1 + i; }));
+    }
+    data_ = vectorMaker_.rowVector(children);
+  }
+
+  size_t runInterpreted() {
+    folly::BenchmarkSuspender suspender;
+    auto exprSet = compileExpression(kExpression, data_->type());
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      count += evaluate(exprSet, data_)->size();
+    }
+    return count;
+  }
+
+  size_t runFused() {
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      auto* c0 = data_->childAt(0)->asFlatVector<double>()->rawValues();
+      auto* c1 = data_->childAt(1)->asFlatVector<double>()->rawValues();
+      auto* c2 = data_->childAt(2)->asFlatVector<double>()->rawValues();
+      auto* c3 = data_->childAt(3)->asFlatVector<double>()->rawValues();
+      auto result = BaseVector::create<FlatVector<double>>(
+          DOUBLE(), kSize, pool());
+      auto* rawResult = result->mutableRawValues();
+      for (auto row = 0; row < kSize; ++row) {
+        rawResult[row] = c0[row] * c1[row] + c2[row] * c3[row] -
+            c0[row] / (c1[row] + 1.0) + c2[row] * c2[row] * 0.5;
+      }
+      folly::doNotOptimizeAway(rawResult[kSize - 1]);
+      count += result->size();
+    }
+    return count;
+  }
+
+ private:
+  RowVectorPtr data_;
+};
+
+std::unique_ptr<ArithmeticTreeBenchmark> benchmark;
+
+BENCHMARK_MULTI(interpreted) {
+  return benchmark->runInterpreted();
+}
+
+BENCHMARK_MULTI_RELATIVE(fused) {
+  return benchmark->runFused();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<ArithmeticTreeBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
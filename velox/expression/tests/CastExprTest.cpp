@@ -1133,6 +1133,37 @@ TEST_F(CastExprTest, errorHandling) {
       "Non-whitespace character found after end of conversion");
 }
 
+TEST_F(CastExprTest, plainAndGeneralStrings) {
+  // Plain strings are parsed without the general conversion. Check that
+  // they mix with strings in other forms and with errors.
+  testTryCast<std::string, int64_t>(
+      "bigint",
+      {"12345678901",
+       "0012",
+       "+7",
+       "-42",
+       "abc",
+       "9223372036854775807",
+       std::nullopt},
+      {12345678901,
+       12,
+       7,
+       -42,
+       std::nullopt,
+       9223372036854775807,
+       std::nullopt});
+  testTryCast<std::string, double>(
+      "double",
+      {"1.25", "1e3", "-0.5", "x", ".5", "123456789.123456789"},
+      {1.25, 1000, -0.5, std::nullopt, 0.5, 123456789.123456789});
+  testTryCast<std::string, int32_t>(
+      "date",
+      {"2020-01-01", "2020-1-2", "2021-02-29", "1970-01-01"},
+      {18262, 18263, std::nullopt, 0},
+      VARCHAR(),
+      DATE());
+}
+
 constexpr vector_size_t kVectorSize = 1'000;
 
 TEST_F(CastExprTest, mapCast) {
@@ -225,3 +225,53 @@ TEST_F(EvalCtxTest, localSingleRow) {
     }
   }
 }
+
+TEST_F(EvalCtxTest, scratchArena) {
+  EvalCtx context(&execCtx_);
+  ASSERT_EQ(context.allocateScratch<int32_t>(0), nullptr);
+
+  execCtx_.enterEval();
+  auto* first = context.allocateScratch<int64_t>(100);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % alignof(int64_t), 0);
+  // A nested evaluation does not release the scratch of the outer one.
+  execCtx_.enterEval();
+  auto* second = context.allocateScratch<int64_t>(100);
+  ASSERT_NE(first, second);
+  execCtx_.leaveEval();
+  first[99] = 1;
+  execCtx_.leaveEval();
+
+  // The arena is rewound and the memory is reused without allocating.
+  const auto reservedBytes = execCtx_.scratchReservedBytes();
+  ASSERT_GT(reservedBytes, 0);
+  execCtx_.enterEval();
+  ASSERT_EQ(context.allocateScratch<int64_t>(100), first);
+  ASSERT_EQ(execCtx_.scratchReservedBytes(), reservedBytes);
+  execCtx_.leaveEval();
+
+  // Scratch that spills over several runs is coalesced into a single run
+  // that fits the next evaluation of the same size.
+  constexpr int32_t kSize = 40 << 10;
+  auto allocateRuns = [&]() {
+    execCtx_.enterEval();
+    for (auto i = 0; i < 3; ++i) {
+      context.allocateScratch<char>(kSize);
+    }
+    execCtx_.leaveEval();
+  };
+  allocateRuns();
+  const auto coalescedBytes = execCtx_.scratchReservedBytes();
+  ASSERT_GE(coalescedBytes, 3 * kSize);
+  const auto usedBytes = pool_->currentBytes();
+  allocateRuns();
+  ASSERT_EQ(execCtx_.scratchReservedBytes(), coalescedBytes);
+  ASSERT_EQ(pool_->currentBytes(), usedBytes);
+
+  // Large scratch is not retained across evaluations.
+  execCtx_.enterEval();
+  context.allocateScratch<char>(1 << 20);
+  execCtx_.leaveEval();
+  ASSERT_EQ(execCtx_.scratchReservedBytes(), 0);
+
+  VELOX_ASSERT_THROW(execCtx_.leaveEval(), "(0 vs. 0)");
+}
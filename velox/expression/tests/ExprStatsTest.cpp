@@ -345,6 +345,42 @@ TEST_F(ExprStatsTest, specialForms) {
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
 
+TEST_F(ExprStatsTest, lambda) {
+  std::vector<Event> events;
+  auto listener = std::make_shared<TestListener>(events);
+  ASSERT_TRUE(exec::registerExprSetListener(listener));
+
+  // 1'024 arrays of 0 to 9 elements.
+  auto data = makeRowVector({
+      makeArrayVector<int64_t>(
+          1'024,
+          [](auto row) { return row % 10; },
+          [](auto row, auto index) { return row + index; }),
+      makeFlatVector<int64_t>(1'024, [](auto row) { return row; }),
+  });
+  const auto numElements =
+      data->childAt(0)->as<ArrayVector>()->elements()->size();
+
+  // The lambda body is evaluated once over all elements.
+  evaluate("transform(c0, x -> x + c1)", data);
+  ASSERT_EQ(1, events.size());
+  auto stats = events.back().stats;
+  ASSERT_EQ(1024, stats.at("lambda").numProcessedRows);
+  ASSERT_EQ(numElements, stats.at("lambda").numLambdaRows);
+  ASSERT_EQ(1, stats.at("lambda").lambdaTiming.count);
+
+  // reduce() evaluates its input lambda once per position with the arrays
+  // that have an element at that position, then the output lambda once.
+  events.clear();
+  evaluate("reduce(c0, 0::bigint, (s, x) -> s + x, s -> s * 2)", data);
+  ASSERT_EQ(1, events.size());
+  stats = events.back().stats;
+  ASSERT_EQ(numElements + 1'024, stats.at("lambda").numLambdaRows);
+  ASSERT_EQ(9 + 1, stats.at("lambda").lambdaTiming.count);
+
+  ASSERT_TRUE(exec::unregisterExprSetListener(listener));
+}
+
 TEST_F(ExprStatsTest, errorLog) {
   // Register a listener to log exceptions.
   std::vector<Event> events;
@@ -423,3 +459,63 @@ TEST_F(ExprStatsTest, complexConstants) {
 
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
+
+TEST_F(ExprStatsTest, profile) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprProfileEnabled, "true"},
+  });
+
+  vector_size_t size = 1'024;
+  auto indices = makeIndices(size, [](auto row) { return row / 5; });
+  auto data = makeRowVector({
+      wrapInDictionary(
+          indices,
+          size,
+          makeFlatVector<int32_t>(size, [](auto row) { return row; })),
+      wrapInDictionary(
+          indices,
+          size,
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 7; })),
+  });
+
+  auto exprSet =
+      compileExpressions({"c0 + c1", "c0 * c1"}, asRowType(data->type()));
+  evaluate(*exprSet, data);
+
+  auto profiles = exprSet->profile();
+  ASSERT_EQ(2, profiles.size());
+
+  const auto& plus = profiles[0];
+  ASSERT_EQ("plus", plus.name);
+  ASSERT_EQ("INTEGER", plus.type);
+  ASSERT_EQ(205, plus.stats.numProcessedRows);
+  ASSERT_EQ(205, plus.stats.numOutputRows);
+  ASSERT_EQ(1, plus.stats.numProcessedVectors);
+  ASSERT_EQ(1, plus.stats.numPeeledVectors);
+  ASSERT_EQ(2, plus.stats.numFlatInputs);
+  ASSERT_EQ(0, plus.stats.numDictionaryInputs);
+  ASSERT_EQ(2, plus.inputs.size());
+  ASSERT_EQ("c0", plus.inputs[0].name);
+
+  // 'c0' and 'c1' are shared with the first expression and reported once.
+  const auto& multiply = profiles[1];
+  ASSERT_EQ(205, multiply.stats.numProcessedRows);
+  ASSERT_EQ(2, multiply.inputs.size());
+  ASSERT_EQ(0, multiply.inputs[0].stats.numProcessedRows);
+  ASSERT_EQ(0, multiply.inputs[1].stats.numProcessedRows);
+
+  // Profiles from different drivers add up.
+  auto total = profiles;
+  exec::addExprProfiles(total, profiles);
+  ASSERT_EQ(410, total[0].stats.numProcessedRows);
+  ASSERT_EQ(2, total[0].stats.numPeeledVectors);
+
+  ASSERT_THAT(
+      plus.toString(),
+      ::testing::MatchesRegex(
+          "plus .cpu time: .+, rows: 205, output rows: 205, batches: 1, "
+          "peeled: 1, inputs flat/constant/dictionary/other: 2/0/0/0, "
+          "allocated: .+. -> INTEGER\n"
+          "   c0 .+\n"
+          "   c1 .+\n"));
+}
@@ -474,6 +474,41 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderAfterSelectivityChange) {
+  constexpr int32_t kBatchSize = 100;
+  // ConjunctExpr halves its history every 64 batches.
+  constexpr int32_t kDecayInterval = 64;
+
+  auto makeData = [&](int64_t c0, int64_t c1) {
+    return makeRowVector(
+        {makeFlatVector<int64_t>(kBatchSize, [&](auto /*row*/) { return c0; }),
+         makeFlatVector<int64_t>(
+             kBatchSize, [&](auto /*row*/) { return c1; })});
+  };
+  // 'c0 = 0' drops all rows at first, then 'c1 = 0' does.
+  auto before = makeData(1, 0);
+  auto after = makeData(0, 1);
+  auto exprSet =
+      compileExpression("c0 = 0 and c1 = 0", asRowType(before->type()));
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+
+  auto expected = makeFlatVector<bool>(kBatchSize, [](auto) { return false; });
+  for (auto i = 0; i < kDecayInterval; ++i) {
+    assertEqualVectors(expected, evaluate(exprSet.get(), before));
+  }
+  for (auto i = 0; i < 20 * kDecayInterval; ++i) {
+    assertEqualVectors(expected, evaluate(exprSet.get(), after));
+  }
+
+  // 'c1 = 0' is first and the old history has aged out.
+  const auto& first = condition->selectivityAt(0);
+  EXPECT_GT(first.numIn(), 0);
+  EXPECT_EQ(first.numOut(), 0);
+  EXPECT_LE(first.numIn(), 2 * kDecayInterval * kBatchSize);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -1064,6 +1099,155 @@ TEST_P(ParameterizedExprTest, csePartialEvaluation) {
   EXPECT_EQ(4, stats.at("add_suffix").numProcessedRows);
 }
 
+namespace {
+// Returns the length of a string. Counts the rows it is called on.
+class CountingLengthFunction : public exec::VectorFunction {
+ public:
+  explicit CountingLengthFunction(std::shared_ptr<int64_t> numRows)
+      : numRows_(std::move(numRows)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* strings = decodedArgs.at(0);
+    context.ensureWritable(rows, outputType, result);
+    auto* rawResult = result->asFlatVector<int64_t>()->mutableRawValues();
+    rows.applyToSelected([&](auto row) {
+      rawResult[row] = strings->valueAt<StringView>(row).size();
+    });
+    *numRows_ += rows.countSelected();
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // varchar -> bigint
+    return {exec::FunctionSignatureBuilder()
+                .returnType("bigint")
+                .argumentType("varchar")
+                .build()};
+  }
+
+ private:
+  const std::shared_ptr<int64_t> numRows_;
+};
+} // namespace
+
+TEST_F(ExprTest, resultCache) {
+  auto numRows = std::make_shared<int64_t>(0);
+  exec::registerVectorFunction(
+      "counting_length",
+      CountingLengthFunction::signatures(),
+      std::make_unique<CountingLengthFunction>(numRows),
+      exec::VectorFunctionMetadataBuilder().expensive(true).build());
+  std::unordered_map<std::string, std::string> configData(
+      {{core::QueryConfig::kExprResultCacheEnabled, "true"}});
+  queryCtx_ =
+      core::QueryCtx::create(nullptr, core::QueryConfig(std::move(configData)));
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+
+  constexpr vector_size_t kSize = 1'000;
+  auto makeStrings = [&](int32_t numDistinct, int32_t offset) {
+    return makeRowVector({makeFlatVector<std::string>(kSize, [&](auto row) {
+      return fmt::format("a long enough value {}", offset + row % numDistinct);
+    })});
+  };
+  auto makeExpected = [&](const RowVectorPtr& data) {
+    auto* strings = data->childAt(0)->asFlatVector<StringView>();
+    return makeFlatVector<int64_t>(
+        kSize, [&](auto row) { return strings->valueAt(row).size(); });
+  };
+
+  // Repeated values are computed once per expression across batches.
+  auto data = makeStrings(50, 0);
+  auto exprSet =
+      compileExpression("counting_length(c0)", asRowType(data->type()));
+  auto [result, stats] = evaluateWithStats(exprSet.get(), data);
+  assertEqualVectors(makeExpected(data), result);
+  EXPECT_EQ(kSize, *numRows);
+
+  data = makeStrings(100, 0);
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), data);
+  assertEqualVectors(makeExpected(data), result);
+  EXPECT_EQ(kSize + kSize / 2, *numRows);
+  EXPECT_EQ(2 * kSize, stats.at("counting_length").numResultCacheLookups);
+  EXPECT_EQ(kSize / 2, stats.at("counting_length").numResultCacheHits);
+
+  // The cache is dropped after enough lookups with a low hit rate.
+  *numRows = 0;
+  exprSet = compileExpression("counting_length(c0)", asRowType(data->type()));
+  const auto numBatches = exec::ExprResultCache::kMinLookups / kSize;
+  for (auto i = 0; i < numBatches + 2; ++i) {
+    data = makeStrings(kSize, i * kSize);
+    std::tie(result, stats) = evaluateWithStats(exprSet.get(), data);
+    assertEqualVectors(makeExpected(data), result);
+  }
+  EXPECT_EQ((numBatches + 2) * kSize, *numRows);
+  EXPECT_EQ(
+      numBatches * kSize, stats.at("counting_length").numResultCacheLookups);
+  EXPECT_EQ(0, stats.at("counting_length").numResultCacheHits);
+
+  // Not cached unless enabled.
+  queryCtx_ = core::QueryCtx::create();
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+  exprSet = compileExpression("counting_length(c0)", asRowType(data->type()));
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), data);
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), data);
+  assertEqualVectors(makeExpected(data), result);
+  EXPECT_EQ(0, stats.at("counting_length").numResultCacheLookups);
+}
+
+// Subexpressions over constant inputs, e.g. partition keys, are evaluated once
+// for each distinct set of constant values across batches.
+TEST_F(ExprTest, constantInputMemo) {
+  auto numRows = std::make_shared<int64_t>(0);
+  exec::registerVectorFunction(
+      "counting_length",
+      CountingLengthFunction::signatures(),
+      std::make_unique<CountingLengthFunction>(numRows));
+
+  // Smaller batches of flat and constant inputs without nulls take the flat
+  // no nulls fast path, which does not peel constants.
+  constexpr vector_size_t kSize = 1'000;
+  auto makeData = [&](const std::string& key) {
+    return makeRowVector(
+        {makeConstant(StringView(key), kSize),
+         makeFlatVector<int64_t>(kSize, folly::identity)});
+  };
+  auto makeExpected = [&](const std::string& key) {
+    return makeFlatVector<int64_t>(
+        kSize, [&](auto row) { return row + key.size(); });
+  };
+
+  auto data = makeData("2024-01-01");
+  auto exprSet = compileExpression(
+      "counting_length(c0) + c1", asRowType(data->type()));
+  assertEqualVectors(makeExpected("2024-01-01"), evaluate(exprSet.get(), data));
+  EXPECT_EQ(1, *numRows);
+
+  data = makeData("2024-01-01");
+  assertEqualVectors(makeExpected("2024-01-01"), evaluate(exprSet.get(), data));
+  EXPECT_EQ(1, *numRows);
+
+  data = makeData("2024-1-2");
+  assertEqualVectors(makeExpected("2024-1-2"), evaluate(exprSet.get(), data));
+  EXPECT_EQ(2, *numRows);
+
+  // Not remembered if caching is disabled.
+  std::unordered_map<std::string, std::string> configData(
+      {{core::QueryConfig::kEnableExpressionEvaluationCache, "false"}});
+  queryCtx_ =
+      core::QueryCtx::create(nullptr, core::QueryConfig(std::move(configData)));
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+  exprSet = compileExpression(
+      "counting_length(c0) + c1", asRowType(data->type()));
+  evaluate(exprSet.get(), data);
+  evaluate(exprSet.get(), data);
+  EXPECT_EQ(4, *numRows);
+}
+
 TEST_P(ParameterizedExprTest, csePartialEvaluationWithEncodings) {
   auto data = makeRowVector(
       {wrapInDictionary(
@@ -137,6 +137,45 @@ TEST_F(SimpleFunctionTest, nameOrAliasRegistration) {
   EXPECT_NO_THROW(registerNoThrow2());
 }
 
+template <typename T>
+struct IsIntegerFunction {
+  template <typename TInput>
+  void call(bool& out, const TInput&) {
+    out = true;
+  }
+};
+
+TEST_F(SimpleFunctionTest, resolutionCache) {
+  const auto& registry = exec::simpleFunctions();
+  registerFunction<IsIntegerFunction, bool, int64_t>({"cached_is_integer"});
+
+  auto resolved = registry.resolveFunction("cached_is_integer", {BIGINT()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(BOOLEAN()->toString(), resolved->type()->toString());
+  const auto numCached = registry.numCachedResolutions();
+  EXPECT_GE(numCached, 1);
+
+  // Repeated lookups are served from the cache.
+  resolved = registry.resolveFunction("cached_is_integer", {BIGINT()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(numCached, registry.numCachedResolutions());
+
+  // Misses are cached too.
+  EXPECT_FALSE(
+      registry.resolveFunction("cached_is_integer", {INTEGER()}).has_value());
+  EXPECT_EQ(numCached + 1, registry.numCachedResolutions());
+
+  // A registration clears the cache so that the new signature is found.
+  registerFunction<IsIntegerFunction, bool, int32_t>({"cached_is_integer"});
+  EXPECT_EQ(0, registry.numCachedResolutions());
+  resolved = registry.resolveFunction("cached_is_integer", {INTEGER()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(BOOLEAN()->toString(), resolved->type()->toString());
+
+  EXPECT_EQ(true, evaluateOnce<bool, int32_t>("cached_is_integer(c0)", 1));
+  EXPECT_EQ(true, evaluateOnce<bool, int64_t>("cached_is_integer(c0)", 1));
+}
+
 // Some input data.
 static std::vector<std::vector<int64_t>> arrayData = {
     {0, 1, 2, 4},
@@ -91,6 +91,11 @@ DEFINE_bool(
     false,
     "If true, 'MemoryPool' will be running in debug mode to track the allocation and free call sites to detect the source of memory leak for testing purpose");
 
+DEFINE_bool(
+    velox_memory_pool_track_allocation_sites,
+    false,
+    "If true, 'MemoryPool' attributes its memory usage to the allocation sites set by 'ScopedMemoryAllocationSite' such as row container and hash table");
+
 // TODO: deprecate this after solves all the use cases that can cause
 // significant performance regression by memory usage tracking.
 DEFINE_bool(
@@ -105,3 +110,30 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    0,
+    "If greater than 0 and Velox is built with VELOX_ENABLE_IO_URING, local "
+    "file async reads and SSD cache reads and writes go through an io_uring "
+    "instance with this queue depth");
+
+DEFINE_bool(
+    velox_spill_read_mmap,
+    false,
+    "If true, local spill files are read through a memory mapping instead of "
+    "into read buffers");
+
+DEFINE_int32(
+    velox_iceberg_delete_positions_cache_entries,
+    0,
+    "Number of (delete file, base file) pairs whose Iceberg positional "
+    "deletes are kept in memory, so that the splits of a base file read each "
+    "delete file once. 0 disables the cache");
+
+DEFINE_int32(
+    velox_hedged_read_budget_pct,
+    5,
+    "Maximum percentage of the object store reads that may be hedged with a "
+    "duplicate request, so that hedging cannot amplify the load of a slow "
+    "store");
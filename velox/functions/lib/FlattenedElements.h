@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::functions {
+
+/// Helpers for array and map functions that work on the flattened elements
+/// vector instead of looping over the elements of each row. A first pass
+/// evaluates a predicate over all elements referenced by the selected rows
+/// and produces a bit mask over the elements, using SIMD for fixed width
+/// types. A second pass reduces the mask over the [offset, offset + size)
+/// range of each row (segmented reduction) with word at a time bit
+/// operations, e.g. bits::findFirstBit() or bits::isAllSet().
+
+/// Invokes 'func(begin, end)' for the runs of elements referenced by the
+/// non-null 'rows' of 'decoded', a decoded ArrayVector or MapVector given by
+/// TVector. The ranges of consecutive rows that are adjacent or overlap are
+/// merged, so that the elements of a flat vector make a single run.
+template <typename TVector, typename TFunc>
+void forEachElementRun(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    TFunc&& func) {
+  const auto* base = decoded.base()->template as<TVector>();
+  const auto* rawOffsets = base->rawOffsets();
+  const auto* rawSizes = base->rawSizes();
+  const auto* indices = decoded.indices();
+
+  vector_size_t begin = 0;
+  vector_size_t end = 0;
+  rows.applyToSelected([&](auto row) {
+    if (decoded.isNullAt(row)) {
+      return;
+    }
+    const auto offset = rawOffsets[indices[row]];
+    const auto size = rawSizes[indices[row]];
+    if (size == 0) {
+      return;
+    }
+    if (offset >= begin && offset <= end) {
+      end = std::max(end, offset + size);
+      return;
+    }
+    if (begin < end) {
+      func(begin, end);
+    }
+    begin = offset;
+    end = offset + size;
+  });
+  if (begin < end) {
+    func(begin, end);
+  }
+}
+
+/// Sets the bits of 'result' in [begin, end) to 'values[i] == value'. Other
+/// bits are not changed. Compares 64 values at a time with SIMD for numeric
+/// types of up to 8 bytes.
+template <typename T>
+void setEqualBits(
+    const T* values,
+    const T& value,
+    vector_size_t begin,
+    vector_size_t end,
+    uint64_t* result) {
+  auto i = begin;
+  if constexpr (
+      std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+      sizeof(T) <= sizeof(int64_t)) {
+    using Batch = xsimd::batch<T>;
+    const vector_size_t firstWord = bits::roundUp(begin, 64);
+    const auto lastWord = end & ~63;
+    if (firstWord < lastWord) {
+      for (; i < firstWord; ++i) {
+        bits::setBit(result, i, values[i] == value);
+      }
+      const auto search = Batch::broadcast(value);
+      for (; i < lastWord; i += 64) {
+        uint64_t word = 0;
+        for (auto j = 0; j < 64; j += Batch::size) {
+          const auto mask = simd::toBitMask(
+              Batch::load_unaligned(values + i + j) == search);
+          word |= static_cast<uint64_t>(static_cast<uint32_t>(mask)) << j;
+        }
+        result[i / 64] = word;
+      }
+    }
+  }
+  for (; i < end; ++i) {
+    bits::setBit(result, i, values[i] == value);
+  }
+}
+
+/// Sets the bits of 'result' for the elements referenced by 'rows' of
+/// 'decodedVector' to 'rawElements[i] == value'. Null elements given by
+/// 'rawElementNulls' are not equal. 'rawElementNulls' may be nullptr.
+template <typename TVector, typename T>
+void setEqualElementBits(
+    const SelectivityVector& rows,
+    const DecodedVector& decodedVector,
+    const T* rawElements,
+    const uint64_t* rawElementNulls,
+    const T& value,
+    uint64_t* result) {
+  forEachElementRun<TVector>(rows, decodedVector, [&](auto begin, auto end) {
+    setEqualBits(rawElements, value, begin, end, result);
+    if (rawElementNulls) {
+      bits::andBits(result, result, rawElementNulls, begin, end);
+    }
+  });
+}
+
+/// Returns the sum of the non-null 'values' in [begin, end). 'nulls' may be
+/// nullptr. The addition is not checked for overflow so that the loop
+/// vectorizes for integers. Floating point values are added in order.
+template <typename TOutput, typename TInput>
+TOutput sumRange(
+    const TInput* values,
+    const uint64_t* nulls,
+    vector_size_t begin,
+    vector_size_t end) {
+  TOutput sum = 0;
+  if (nulls == nullptr) {
+    for (auto i = begin; i < end; ++i) {
+      sum += values[i];
+    }
+  } else {
+    for (auto i = begin; i < end; ++i) {
+      sum += bits::isBitNull(nulls, i) ? 0 : values[i];
+    }
+  }
+  return sum;
+}
+
+} // namespace facebook::velox::functions
@@ -93,12 +93,13 @@ void mergeOverlap(
   uint32_t a = startA;
   uint32_t b = startB;
   uint32_t c = startC;
+  // The outcome of the comparison is data dependent and mispredicts half of
+  // the time, so the indices are advanced without branching on it.
   while (a < limA && b < limB) {
-    if (compare(buf[a], buf[b])) {
-      buf[c++] = buf[a++];
-    } else {
-      buf[c++] = buf[b++];
-    }
+    const bool takeA = compare(buf[a], buf[b]);
+    buf[c++] = takeA ? buf[a] : buf[b];
+    a += takeA;
+    b += !takeA;
   }
   while (a < limA) {
     buf[c++] = buf[a++];
@@ -293,6 +294,50 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  size_t i = 0;
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+    i = 1;
+  }
+  for (; i < values.size(); ++i) {
+    minValue_ = std::min(minValue_, values[i], C());
+    maxValue_ = std::max(maxValue_, values[i], C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  // Set before copying since a compaction of level zero in between must sort
+  // it.
+  isLevelZeroSorted_ = false;
+  for (i = 0; i < values.size();) {
+    const auto numLeft = values.size() - i;
+    if (items_.size() < k_ && numLevels() == 1) {
+      const auto count = std::min<size_t>(k_ - items_.size(), numLeft);
+      items_.insert(
+          items_.end(), values.begin() + i, values.begin() + i + count);
+      levels_[1] += count;
+      i += count;
+    } else if (levels_[0] > 0) {
+      // Level zero is unsorted, so the order of the values in the free space
+      // below it does not matter.
+      const auto count = std::min<size_t>(levels_[0], numLeft);
+      levels_[0] -= count;
+      std::copy(
+          values.begin() + i,
+          values.begin() + i + count,
+          items_.begin() + levels_[0]);
+      i += count;
+    } else {
+      items_[insertPosition()] = values[i++];
+    }
+  }
+  n_ += values.size();
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -645,6 +690,16 @@ void KllSketch<T, A, C>::mergeViews(const folly::Range<const View*>& others) {
         }
       }
       int outIndex = worklevels[lvl];
+      if (pq.size() == 2) {
+        // Merging a single other sketch is the common case. A two way merge is
+        // much cheaper than going through the heap.
+        auto [s1, t1] = pq.top();
+        pq.pop();
+        auto [s2, t2] = pq.top();
+        pq.pop();
+        outIndex = std::merge(s1, t1, s2, t2, workbuf.data() + outIndex, C()) -
+            workbuf.data();
+      }
       while (!pq.empty()) {
         auto [s, t] = pq.top();
         pq.pop();
@@ -752,7 +807,7 @@ template <typename T, typename A, typename C>
 size_t KllSketch<T, A, C>::serializedByteSize() const {
   size_t ans = sizeof detail::kVersion + sizeof k_ + sizeof n_;
   ans += sizeof minValue_ + sizeof maxValue_;
-  ans += sizeof(size_t) + sizeof(T) * items_.size();
+  ans += sizeof(size_t) + sizeof(T) * getNumRetained();
   ans += sizeof(size_t) + sizeof(uint32_t) * levels_.size();
   return ans;
 }
@@ -765,8 +820,17 @@ void KllSketch<T, A, C>::serialize(char* out) const {
   detail::write(n_, out, i);
   detail::write(minValue_, out, i);
   detail::write(maxValue_, out, i);
-  detail::writeVector(items_, out, i);
-  detail::writeVector(levels_, out, i);
+  // The free space below level zero is not written and the levels are
+  // rebased to start at 0.
+  const auto offset = levels_[0];
+  detail::write(size_t(getNumRetained()), out, i);
+  const auto bytes = sizeof(T) * getNumRetained();
+  memcpy(out + i, items_.data() + offset, bytes);
+  i += bytes;
+  detail::write(levels_.size(), out, i);
+  for (auto level : levels_) {
+    detail::write(level - offset, out, i);
+  }
   VELOX_DCHECK_EQ(i, serializedByteSize());
 }
 
@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add 'values' to the sketch. Same as calling insert() for each value, but
+  /// updates the min and max in one loop and copies runs of values into the
+  /// free space of level zero.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
 #include <re2/re2.h>
@@ -640,9 +641,33 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::findSubstring(
+             input.data(),
+             input.size(),
+             fixedPattern.data(),
+             fixedPattern.size()) != std::string_view::npos;
+}
+
+// Match 'input' with '%{c0}%{c1}%...%'. Finds each literal after the end of
+// the previous one. Taking the first occurrence of each leaves the most room
+// for the literals after it, so no backtracking is needed.
+bool matchSubstringsPattern(
+    const StringView& input,
+    const PatternMetadata& patternMetadata) {
+  const auto* fixedPattern = patternMetadata.fixedPattern().data();
+  size_t cursor = 0;
+  for (const auto& subPattern : patternMetadata.subPatterns()) {
+    const auto position = simd::findSubstring(
+        input.data() + cursor,
+        input.size() - cursor,
+        fixedPattern + subPattern.start,
+        subPattern.length);
+    if (position == std::string_view::npos) {
+      return false;
+    }
+    cursor += position + subPattern.length;
+  }
+  return true;
 }
 
 // Return true if the input VARCHAR argument is all-ASCII for the specified
@@ -700,6 +725,8 @@ class OptimizedLike final : public exec::VectorFunction {
               .first;
         case PatternKind::kSubstring:
           return matchSubstringPattern(input, patternMetadata.fixedPattern());
+        case PatternKind::kSubstrings:
+          return matchSubstringsPattern(input, patternMetadata);
       }
     } else {
       switch (P) {
@@ -734,6 +761,8 @@ class OptimizedLike final : public exec::VectorFunction {
               input, patternMetadata, input.size() - 1);
         case PatternKind::kSubstring:
           return matchSubstringPattern(input, patternMetadata.fixedPattern());
+        case PatternKind::kSubstrings:
+          return matchSubstringsPattern(input, patternMetadata);
       }
     }
   }
@@ -907,6 +936,9 @@ class LikeGeneric final : public exec::VectorFunction {
           case PatternKind::kSubstring:
             return OptimizedLike<PatternKind::kSubstring>::match<
                 /*isAscii*/ true>(input, patternMetadata);
+          case PatternKind::kSubstrings:
+            return OptimizedLike<PatternKind::kSubstrings>::match<
+                /*isAscii*/ true>(input, patternMetadata);
           default:
             return applyWithRegex(input, pattern, escapeChar);
         }
@@ -930,6 +962,9 @@ class LikeGeneric final : public exec::VectorFunction {
           case PatternKind::kSubstring:
             return OptimizedLike<PatternKind::kSubstring>::match<
                 /*isAscii*/ false>(input, patternMetadata);
+          case PatternKind::kSubstrings:
+            return OptimizedLike<PatternKind::kSubstrings>::match<
+                /*isAscii*/ false>(input, patternMetadata);
           default:
             return applyWithRegex(input, pattern, escapeChar);
         }
@@ -1379,6 +1414,17 @@ PatternMetadata PatternMetadata::substring(const std::string& fixedPattern) {
   return {PatternKind::kSubstring, fixedPattern.length(), fixedPattern, {}};
 }
 
+PatternMetadata PatternMetadata::substrings(
+    std::string fixedPattern,
+    std::vector<SubPatternMetadata> subPatterns) {
+  const auto length = fixedPattern.length();
+  return {
+      PatternKind::kSubstrings,
+      length,
+      std::move(fixedPattern),
+      std::move(subPatterns)};
+}
+
 PatternMetadata::PatternMetadata(
     PatternKind patternKind,
     size_t length,
@@ -1515,6 +1561,13 @@ bool isOptimizedLikeCandidate(
     return true;
   }
 
+  // '%{c0}%{c1}%...%' is a number of substring searches.
+  if (stats[kSingleCharWildcard].count == 0 &&
+      firstPatternKind == SubPatternKind::kAnyCharsWildcard &&
+      lastPatternKind == SubPatternKind::kAnyCharsWildcard) {
+    return true;
+  }
+
   // More than 2 '%' , no fast path for it.
   if (stats[kAnyCharsWildcard].count > 2) {
     return false;
@@ -1679,6 +1732,25 @@ PatternMetadata determinePatternKind(
         }
       }
 
+      // Several literal sub-patterns between any-wildcard sub-patterns.
+      if (stats[kSingleCharWildcard].count == 0 &&
+          stats[kLiteralString].count > 1 &&
+          firstSubPatternKind == SubPatternKind::kAnyCharsWildcard &&
+          lastSubPatternKind == SubPatternKind::kAnyCharsWildcard) {
+        std::string fixedPattern;
+        std::vector<SubPatternMetadata> subPatterns;
+        for (auto i = 0; i < numSubPatterns; i++) {
+          if (subPatternKinds[i] == SubPatternKind::kLiteralString) {
+            const auto [start, length] = subPatternRanges[i];
+            subPatterns.push_back(
+                {SubPatternKind::kLiteralString, fixedPattern.size(), length});
+            fixedPattern.append(unescapedPattern.substr(start, length));
+          }
+        }
+        return PatternMetadata::substrings(
+            std::move(fixedPattern), std::move(subPatterns));
+      }
+
       // No any-wildcard sub-pattern.
       if (stats[kAnyCharsWildcard].count == 0 &&
           stats[kSingleCharWildcard].count > 0) {
@@ -1820,6 +1892,9 @@ std::shared_ptr<exec::VectorFunction> makeLike(
     case PatternKind::kSubstring:
       return std::make_shared<OptimizedLike<PatternKind::kSubstring>>(
           patternMetadata);
+    case PatternKind::kSubstrings:
+      return std::make_shared<OptimizedLike<PatternKind::kSubstrings>>(
+          patternMetadata);
     default:
       return std::make_shared<LikeWithRe2>(pattern, escapeChar);
   }
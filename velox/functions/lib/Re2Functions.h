@@ -50,6 +50,9 @@ enum class PatternKind {
   kRelaxedSuffix,
   /// Patterns matching '%{c0}%', such as '%foo%%', '%%%hello%'.
   kSubstring,
+  /// Patterns matching '%{c0}%{c1}%...%' with two or more literals and no
+  /// '_', such as '%foo%bar%'.
+  kSubstrings,
   /// Patterns which do not fit any of the above types, such as 'hello_world',
   /// '_presto%'.
   kGeneric,
@@ -101,6 +104,10 @@ class PatternMetadata {
 
   static PatternMetadata substring(const std::string& fixedPattern);
 
+  static PatternMetadata substrings(
+      std::string fixedPattern,
+      std::vector<SubPatternMetadata> subPatterns);
+
   PatternKind patternKind() const {
     return patternKind_;
   }
@@ -127,8 +134,8 @@ class PatternMetadata {
   PatternKind patternKind_;
 
   /// Contains the length of the unescaped fixed pattern for patterns of kind
-  /// k[Relaxed]Fixed, k[Relaxed]Prefix, k[Relaxed]Suffix and
-  /// k[Relaxed]Substring. Contains the count of wildcard character '_' for
+  /// k[Relaxed]Fixed, k[Relaxed]Prefix, k[Relaxed]Suffix, kSubstring and
+  /// kSubstrings. Contains the count of wildcard character '_' for
   /// patterns of kind kExactlyN and kAtLeastN. Contains 0 otherwise.
   size_t length_;
 
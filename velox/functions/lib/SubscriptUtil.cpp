@@ -15,6 +15,7 @@
  */
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -43,6 +44,138 @@ struct SimpleType<TypeKind::VARCHAR> {
   using type = Varchar;
 };
 
+// Keys of 'kind' that subscripts with a constant key on this thread have
+// looked up. Kept in the function state of the ExecCtx, so that the index of
+// a batch covers the keys of all subscripts seen in earlier batches. String
+// keys are copied, so that they do not depend on the expressions.
+template <TypeKind kind>
+struct KnownMapKeys {
+  using TKey = typename TypeTraits<kind>::NativeType;
+
+  static inline const char kTag{};
+
+  // Returns the id of 'key'. Registers 'key' if it is new.
+  int32_t idOf(const TKey& key) {
+    auto it = ids.find(key);
+    if (it != ids.end()) {
+      return it->second;
+    }
+    const int32_t id = ids.size();
+    if constexpr (std::is_same_v<TKey, StringView>) {
+      const auto& copy = strings.emplace_back(key.data(), key.size());
+      ids.emplace(StringView(copy.data(), copy.size()), id);
+    } else {
+      ids.emplace(key, id);
+    }
+    return id;
+  }
+
+  folly::F14FastMap<TKey, int32_t> ids;
+  std::deque<std::string> strings;
+};
+
+// The offsets of the known keys in all maps of one base MapVector. Built
+// with one pass over the map keys by the first subscript into the map in a
+// batch, then shared by the other subscripts with constant keys, so that
+// these do not each scan every map for their key.
+struct MapKeyIndex {
+  // Keeps the base map alive, so that its address identifies it for the
+  // rest of the batch.
+  VectorPtr map;
+  // Number of known keys when the index was built. Keys with larger ids
+  // are not in the index.
+  int32_t numKeys;
+  vector_size_t numMaps;
+  // Offset of the key with id 'id' in map 'mapIndex' at [id * numMaps +
+  // mapIndex], or -1 if the map does not have the key.
+  std::vector<vector_size_t> offsets;
+};
+
+// MapKeyIndexes of the base maps of 'kind' in the current batch.
+template <TypeKind kind>
+struct BatchMapKeyIndexes {
+  static inline const char kTag{};
+
+  folly::F14FastMap<const BaseVector*, std::unique_ptr<MapKeyIndex>> indexes;
+};
+
+template <TypeKind kind>
+std::unique_ptr<MapKeyIndex> makeMapKeyIndex(
+    const VectorPtr& map,
+    const MapVector& baseMap,
+    DecodedVector& decodedMapKeys,
+    const KnownMapKeys<kind>& knownKeys) {
+  using TKey = typename TypeTraits<kind>::NativeType;
+
+  auto index = std::make_unique<MapKeyIndex>();
+  index->map = map;
+  index->numKeys = knownKeys.ids.size();
+  index->numMaps = baseMap.size();
+  index->offsets.resize(index->numKeys * index->numMaps, -1);
+
+  auto rawSizes = baseMap.rawSizes();
+  auto rawOffsets = baseMap.rawOffsets();
+  for (vector_size_t mapIndex = 0; mapIndex < index->numMaps; ++mapIndex) {
+    if (baseMap.isNullAt(mapIndex)) {
+      continue;
+    }
+    const auto offsetStart = rawOffsets[mapIndex];
+    const auto offsetEnd = offsetStart + rawSizes[mapIndex];
+    for (auto offset = offsetStart; offset < offsetEnd; ++offset) {
+      auto it = knownKeys.ids.find(decodedMapKeys.valueAt<TKey>(offset));
+      if (it != knownKeys.ids.end()) {
+        auto& keyOffset =
+            index->offsets[it->second * index->numMaps + mapIndex];
+        if (keyOffset < 0) {
+          keyOffset = offset;
+        }
+      }
+    }
+  }
+  return index;
+}
+
+// Returns the MapKeyIndex of 'baseMap' for the current batch and the id of
+// 'key'. Returns a nullptr index if there is none. Registers 'key' for the
+// indexes of later batches. The index is built when at least two keys are
+// known, since scanning the maps is cheaper for a single key.
+template <TypeKind kind>
+std::pair<const MapKeyIndex*, int32_t> findMapKeyIndex(
+    exec::EvalCtx& context,
+    const VectorPtr& map,
+    const MapVector& baseMap,
+    DecodedVector& decodedMapKeys,
+    const typename TypeTraits<kind>::NativeType& key) {
+  auto* execCtx = context.execCtx();
+  auto* batchState =
+      execCtx->batchFunctionState(&BatchMapKeyIndexes<kind>::kTag);
+  if (batchState == nullptr) {
+    return {nullptr, -1};
+  }
+
+  auto& knownKeysState = execCtx->functionState(&KnownMapKeys<kind>::kTag);
+  if (!knownKeysState) {
+    knownKeysState = std::make_shared<KnownMapKeys<kind>>();
+  }
+  auto* knownKeys = static_cast<KnownMapKeys<kind>*>(knownKeysState.get());
+  const auto keyId = knownKeys->idOf(key);
+
+  if (!*batchState) {
+    *batchState = std::make_shared<BatchMapKeyIndexes<kind>>();
+  }
+  auto& indexes =
+      static_cast<BatchMapKeyIndexes<kind>*>(batchState->get())->indexes;
+  auto& index = indexes[&baseMap];
+  if (!index) {
+    if (knownKeys->ids.size() < 2) {
+      indexes.erase(&baseMap);
+      return {nullptr, keyId};
+    }
+    index = makeMapKeyIndex<kind>(map, baseMap, decodedMapKeys, *knownKeys);
+  }
+  return {index.get(), keyId};
+}
+
 /// Decode arguments and transform result into a dictionaryVector where the
 /// dictionary maintains a mapping from a given row to the index of the input
 /// map value vector. This allows us to ensure that element_at is zero-copy.
@@ -95,6 +228,28 @@ VectorPtr applyMapTyped(
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
+  // Constant keys into a map that is not cached across batches use the
+  // MapKeyIndex shared by the subscripts into the map in this batch.
+  // Floating point keys are excluded since hashing does not agree with ==
+  // for NaN and -0.0.
+  const MapKeyIndex* keyIndex = nullptr;
+  int32_t keyId = -1;
+  if constexpr (
+      !std::is_floating_point_v<TKey> && !std::is_same_v<TKey, bool>) {
+    if (!triggerCaching && decodedIndices->isConstantMapping() &&
+        !decodedIndices->isNullAt(0)) {
+      std::tie(keyIndex, keyId) = findMapKeyIndex<kind>(
+          context,
+          mapArg,
+          *baseMap,
+          *decodedMapKeys,
+          decodedIndices->valueAt<TKey>(0));
+      if (keyIndex != nullptr && keyId >= keyIndex->numKeys) {
+        keyIndex = nullptr;
+      }
+    }
+  }
+
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
     size_t mapIndex = mapIndices[row];
@@ -103,7 +258,14 @@ VectorPtr applyMapTyped(
     size_t offsetEnd = offsetStart + size;
     bool found = false;
 
-    if (triggerCaching && size >= kMinCachedMapSize) {
+    if (keyIndex != nullptr) {
+      const auto offset =
+          keyIndex->offsets[keyId * keyIndex->numMaps + mapIndex];
+      if (offset >= 0) {
+        rawIndices[row] = offset;
+        found = true;
+      }
+    } else if (triggerCaching && size >= kMinCachedMapSize) {
       VELOX_DCHECK_NOT_NULL(typedLookupTable);
 
       // Create map for mapIndex if not created.
@@ -128,11 +128,26 @@ class SimpleNumericAggregate : public exec::Aggregate {
             groups[i], TData(decoded.valueAt<TValue>(i)), updateSingleValue);
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+      // Consecutive rows often belong to the same group, e.g. when the input
+      // is clustered on the grouping keys. Reduces each run of rows of the
+      // same group into a local and stores the run's result once. The values
+      // are applied in the same order as row by row.
       auto data = decoded.data<TValue>();
+      char* runGroup = nullptr;
+      TData runValue{};
       rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<tableHasNulls, TData>(
-            groups[i], TData(data[i]), updateSingleValue);
+        if (groups[i] != runGroup) {
+          if (runGroup != nullptr) {
+            storeValue<tableHasNulls>(runGroup, runValue);
+          }
+          runGroup = groups[i];
+          runValue = *exec::Aggregate::value<TData>(runGroup);
+        }
+        updateSingleValue(runValue, TData(data[i]));
       });
+      if (runGroup != nullptr) {
+        storeValue<tableHasNulls>(runGroup, runValue);
+      }
     } else {
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<tableHasNulls, TData>(
@@ -179,11 +194,23 @@ class SimpleNumericAggregate : public exec::Aggregate {
             group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+      // Reduces into a local, which the compiler keeps in a register and can
+      // vectorize over a contiguous range of values, and stores the result
+      // once. The values are applied in the same order as row by row.
       auto data = decoded.data<TValue>();
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(data[i]), updateSingleValue);
-      });
+      auto result = *exec::Aggregate::value<TData>(group);
+      if (rows.isAllSelected()) {
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          updateSingleValue(result, TData(data[i]));
+        }
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          updateSingleValue(result, TData(data[i]));
+        });
+      }
+      if (rows.hasSelections()) {
+        storeValue<true>(group, result);
+      }
     } else {
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<true, TData>(
@@ -239,6 +266,14 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
     updateValue(*exec::Aggregate::value<TDataType>(group), value);
   }
+
+  template <bool tableHasNulls, typename TDataType>
+  inline void storeValue(char* group, TDataType value) {
+    if constexpr (tableHasNulls) {
+      exec::Aggregate::clearNull(group);
+    }
+    *exec::Aggregate::value<TDataType>(group) = value;
+  }
 };
 
 } // namespace facebook::velox::functions::aggregate
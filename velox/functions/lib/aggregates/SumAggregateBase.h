@@ -39,6 +39,10 @@ class SumAggregateBase
     return sizeof(TAccumulator);
   }
 
+  bool supportsRelocation() const override {
+    return true;
+  }
+
   int32_t accumulatorAlignmentSize() const override {
     return 1;
   }
@@ -83,6 +87,13 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if constexpr (
+        std::is_integral_v<TInput> && !std::is_same_v<TInput, bool> &&
+        std::is_same_v<TAccumulator, int64_t> && sizeof(TInput) <= 4) {
+      if (sumNarrowFlat(group, rows, args[0])) {
+        return;
+      }
+    }
     BaseAggregate::template updateOneGroup<TAccumulator>(
         group,
         rows,
@@ -148,6 +159,36 @@ class SumAggregateBase
   }
 
  private:
+  // Sums a flat vector without nulls of integers of at most 32 bits into
+  // 'group'. The values of one batch cannot overflow a 64 bit sum, so they are
+  // added without overflow checks, which the compiler vectorizes, and the sum
+  // is added to the accumulator with a single check. Returns false if 'arg'
+  // is not flat or has nulls.
+  bool sumNarrowFlat(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg) {
+    if (arg->encoding() != VectorEncoding::Simple::FLAT ||
+        arg->mayHaveNulls()) {
+      return false;
+    }
+    const auto* data = arg->asUnchecked<FlatVector<TInput>>()->rawValues();
+    int64_t sum = 0;
+    if (rows.isAllSelected()) {
+      for (auto i = rows.begin(); i < rows.end(); ++i) {
+        sum += data[i];
+      }
+    } else {
+      rows.applyToSelected([&](vector_size_t i) { sum += data[i]; });
+    }
+    if (rows.hasSelections()) {
+      exec::Aggregate::clearNull(group);
+      auto& result = *exec::Aggregate::value<TAccumulator>(group);
+      updateSingleValue<TAccumulator>(result, TAccumulator(sum));
+    }
+    return true;
+  }
+
   /// Update functions that check for overflows for integer types.
   /// For floating points, an overflow results in +/- infinity which is a
   /// valid output.
@@ -88,17 +88,44 @@ void ValueList::appendValue(
   }
 }
 
+void ValueList::relocate(const HashStringAllocator::Relocation& relocation) {
+  if (nullsBegin_ != nullptr) {
+    nullsBegin_ = relocation.relocate(nullsBegin_);
+  }
+  if (dataBegin_ != nullptr) {
+    dataBegin_ = relocation.relocate(dataBegin_);
+  }
+  nullsCurrent_ = relocation.relocate(nullsCurrent_);
+  dataCurrent_ = relocation.relocate(dataCurrent_);
+}
+
 void ValueList::appendRange(
     const VectorPtr& vector,
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
-  for (auto index = offset; index < offset + size; ++index) {
-    if (vector->isNullAt(index)) {
-      appendNull(allocator);
-    } else {
-      appendNonNull(*vector, index, allocator);
+  static const exec::ContainerRowSerdeOptions options{};
+  const auto end = offset + size;
+  for (auto index = offset; index < end;) {
+    prepareAppend(allocator);
+    // The values up to the end of the current word of null flags are written
+    // with a single write to 'data'.
+    const auto batchEnd =
+        std::min<vector_size_t>(end, index + 64 - size_ % 64);
+    ByteOutputStream stream(allocator);
+    allocator->extendWrite(dataCurrent_, stream);
+    const auto initialSize = stream.size();
+    for (; index < batchEnd; ++index) {
+      if (vector->isNullAt(index)) {
+        lastNulls_ |= 1UL << (size_ % 64);
+      } else {
+        exec::ContainerRowSerde::serialize(*vector, index, stream, options);
+      }
+      ++size_;
     }
+    bytes_ += stream.size() - initialSize;
+    dataCurrent_ =
+        allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024)).second;
   }
 }
 
@@ -109,20 +136,76 @@ ValueListReader::ValueListReader(ValueList& values)
       dataStream_{HashStringAllocator::prepareRead(values.dataBegin())},
       nullsStream_{HashStringAllocator::prepareRead(values.nullsBegin())} {}
 
-bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
+void ValueListReader::loadNulls() {
   if (pos_ == lastNullsStart_) {
     nulls_ = lastNulls_;
   } else if (pos_ % 64 == 0) {
     nulls_ = nullsStream_.read<uint64_t>();
   }
+}
 
+void ValueListReader::readOne(BaseVector& output, vector_size_t outputIndex) {
   if (nulls_ & (1UL << (pos_ % 64))) {
     output.setNull(outputIndex, true);
   } else {
     exec::ContainerRowSerde::deserialize(dataStream_, outputIndex, &output);
   }
-
   pos_++;
+}
+
+bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
+  loadNulls();
+  readOne(output, outputIndex);
   return pos_ < size_;
 }
+
+template <TypeKind Kind>
+void ValueListReader::nextFixedWidth(
+    BaseVector& output,
+    vector_size_t outputIndex,
+    vector_size_t numValues) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (
+      TypeTraits<Kind>::isFixedWidth && Kind != TypeKind::BOOLEAN &&
+      Kind != TypeKind::UNKNOWN) {
+    // ContainerRowSerde writes fixed-width values as their native bytes.
+    auto* rawValues = output.asUnchecked<FlatVector<T>>()->mutableRawValues();
+    for (vector_size_t i = 0; i < numValues;) {
+      loadNulls();
+      const auto bit = pos_ % 64;
+      const auto count = std::min<vector_size_t>(numValues - i, 64 - bit);
+      const uint64_t mask = count == 64 ? ~0UL : bits::lowMask(count) << bit;
+      if ((nulls_ & mask) == 0) {
+        dataStream_.readBytes(rawValues + outputIndex + i, count * sizeof(T));
+        output.clearNulls(outputIndex + i, outputIndex + i + count);
+        pos_ += count;
+        i += count;
+      } else {
+        for (auto end = i + count; i < end; ++i) {
+          readOne(output, outputIndex + i);
+        }
+      }
+    }
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
+void ValueListReader::next(
+    BaseVector& output,
+    vector_size_t outputIndex,
+    vector_size_t numValues) {
+  VELOX_DCHECK_LE(pos_ + numValues, size_);
+  const auto kind = output.typeKind();
+  if (output.encoding() == VectorEncoding::Simple::FLAT &&
+      output.type()->isPrimitiveType() && output.type()->isFixedWidth() &&
+      kind != TypeKind::BOOLEAN && kind != TypeKind::UNKNOWN) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        nextFixedWidth, kind, output, outputIndex, numValues);
+    return;
+  }
+  for (auto i = 0; i < numValues; ++i) {
+    next(output, outputIndex + i);
+  }
+}
 } // namespace facebook::velox::aggregate
@@ -78,6 +78,10 @@ class ValueList {
     }
   }
 
+  // Updates the pointers into the allocator after
+  // HashStringAllocator::compact().
+  void relocate(const HashStringAllocator::Relocation& relocation);
+
  private:
   // An array_agg or related begins with an allocation of 5 words and
   // 4 bytes for header. This is compact for small arrays (up to 5
@@ -123,7 +127,28 @@ class ValueListReader {
 
   bool next(BaseVector& output, vector_size_t outputIndex);
 
+  /// Reads the next 'numValues' values into consecutive positions of 'output'
+  /// starting at 'outputIndex'. Runs of non-null fixed-width values are
+  /// copied into a flat 'output' with one memcpy per word of null flags.
+  void next(
+      BaseVector& output,
+      vector_size_t outputIndex,
+      vector_size_t numValues);
+
  private:
+  // Loads the null flags for the value at 'pos_' if it starts a new word.
+  void loadNulls();
+
+  // Reads the value at 'pos_' into 'output' at 'outputIndex'. The null flags
+  // for it must be loaded.
+  void readOne(BaseVector& output, vector_size_t outputIndex);
+
+  template <TypeKind Kind>
+  void nextFixedWidth(
+      BaseVector& output,
+      vector_size_t outputIndex,
+      vector_size_t numValues);
+
   const vector_size_t size_;
   const vector_size_t lastNullsStart_;
   const uint64_t lastNulls_;
@@ -148,9 +173,7 @@ void copyValueListToArrayWriter(
   writer.reserve(size);
 
   ValueListReader reader(elements);
-  for (vector_size_t i = 0; i < size; ++i) {
-    reader.next(*writer.elementsVector(), writer.valuesOffset() + i);
-  }
+  reader.next(*writer.elementsVector(), writer.valuesOffset(), size);
   writer.resize(size);
 }
 
@@ -45,6 +45,25 @@ class ValueListTest : public functions::test::FunctionBaseTest {
     return result;
   }
 
+  // Reads 'values' with ValueListReader::next() for ranges of varying sizes.
+  VectorPtr readRanges(
+      aggregate::ValueList& values,
+      const TypePtr& type,
+      vector_size_t size) {
+    aggregate::ValueListReader reader(values);
+    auto result = BaseVector::create(type, size, pool());
+    for (auto i = 0; i < size; i++) {
+      result->setNull(i, true);
+    }
+
+    for (vector_size_t i = 0, count = 1; i < size;
+         i += count, count = count * 5 % 199) {
+      count = std::min(count, size - i);
+      reader.next(*result, i, count);
+    }
+    return result;
+  }
+
   void testRoundTrip(const VectorPtr& data) {
     auto size = data->size();
 
@@ -60,6 +79,7 @@ class ValueListTest : public functions::test::FunctionBaseTest {
       auto result = read(values, data->type(), size);
 
       assertEqualVectors(data, result);
+      assertEqualVectors(data, readRanges(values, data->type(), size));
     }
 
     // Use ValueList::appendRange.
@@ -71,6 +91,7 @@ class ValueListTest : public functions::test::FunctionBaseTest {
       auto result = read(values, data->type(), size);
 
       assertEqualVectors(data, result);
+      assertEqualVectors(data, readRanges(values, data->type(), size));
     }
   }
 
@@ -141,3 +162,45 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, relocate) {
+  constexpr int32_t kNumLists = 100;
+  constexpr int32_t kSize = 100'000;
+  auto data = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row; }, test::VectorMaker::nullEvery(13));
+  DecodedVector decoded(*data);
+
+  // Interleaves the appends so that the lists are spread over the slabs.
+  std::vector<aggregate::ValueList> lists(kNumLists);
+  for (auto i = 0; i < kSize; ++i) {
+    lists[i % kNumLists].appendValue(decoded, i, allocator());
+  }
+  for (auto i = 0; i < kNumLists; i += 2) {
+    lists[i].free(allocator());
+  }
+
+  const auto freedBytes = allocator()->compact(
+      [&](const HashStringAllocator::Relocation& relocation) {
+        for (auto i = 1; i < kNumLists; i += 2) {
+          lists[i].relocate(relocation);
+        }
+      });
+  ASSERT_GT(freedBytes, 0);
+  allocator()->checkConsistency();
+
+  // The relocated lists can be read and appended to.
+  for (auto i = 0; i < kSize; ++i) {
+    if (i % kNumLists % 2 == 1) {
+      lists[i % kNumLists].appendValue(decoded, i, allocator());
+    }
+  }
+  for (auto i = 1; i < kNumLists; i += 2) {
+    const vector_size_t size = 2 * kSize / kNumLists;
+    auto expected = BaseVector::create(BIGINT(), size, pool());
+    for (auto j = 0; j < size; ++j) {
+      expected->copy(data.get(), j, i + j % (size / 2) * kNumLists, 1);
+    }
+    ASSERT_EQ(size, lists[i].size());
+    assertEqualVectors(expected, read(lists[i], BIGINT(), size));
+  }
+}
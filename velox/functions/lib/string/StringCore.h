@@ -48,12 +48,24 @@ namespace stringCore {
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
-    if (str[i] & 0x80) {
+  // The bytes are OR'ed together in blocks the compiler can vectorize and the
+  // high bit is checked once per block.
+  constexpr size_t kBlockSize = 64;
+  size_t i = 0;
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+    uint8_t bits = 0;
+    VECTORIZE_LOOP_IF_POSSIBLE for (auto j = 0; j < kBlockSize; ++j) {
+      bits |= static_cast<uint8_t>(str[i + j]);
+    }
+    if (bits & 0x80) {
       return false;
     }
   }
-  return true;
+  uint8_t bits = 0;
+  for (; i < length; ++i) {
+    bits |= static_cast<uint8_t>(str[i]);
+  }
+  return (bits & 0x80) == 0;
 }
 
 /// Perform reverse for ascii string input
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/FlattenedElements.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+class FlattenedElementsTest : public testing::Test,
+                              public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  template <typename T>
+  void testSetEqualBits(const std::vector<T>& values, T value) {
+    const vector_size_t size = values.size();
+    std::vector<uint64_t> result(bits::nwords(size));
+    const std::vector<std::pair<vector_size_t, vector_size_t>> ranges = {
+        {0, size}, {3, size}, {0, size - 5}, {61, 130}, {70, 75}};
+    for (const auto& [begin, end] : ranges) {
+      std::fill(result.begin(), result.end(), ~0ULL);
+      setEqualBits(values.data(), value, begin, end, result.data());
+      for (auto i = 0; i < size; ++i) {
+        const bool expected = i < begin || i >= end || values[i] == value;
+        ASSERT_EQ(expected, bits::isBitSet(result.data(), i))
+            << "at " << i << " of [" << begin << ", " << end << ")";
+      }
+    }
+  }
+};
+
+TEST_F(FlattenedElementsTest, setEqualBits) {
+  std::vector<int8_t> tinyints(200);
+  std::vector<int64_t> bigints(200);
+  std::vector<double> doubles(200);
+  std::vector<StringView> strings(200);
+  for (auto i = 0; i < 200; ++i) {
+    tinyints[i] = i % 7;
+    bigints[i] = i % 5;
+    doubles[i] = i % 3 == 0 ? std::nan("") : i % 11;
+    strings[i] = i % 13 == 0 ? "a" : "b";
+  }
+  testSetEqualBits<int8_t>(tinyints, 3);
+  testSetEqualBits<int64_t>(bigints, 4);
+  testSetEqualBits<double>(doubles, 2);
+  testSetEqualBits<double>(doubles, std::nan(""));
+  testSetEqualBits<StringView>(strings, "a");
+}
+
+TEST_F(FlattenedElementsTest, forEachElementRun) {
+  // Rows 0-2 are adjacent, row 3 is null, row 4 is empty, row 5 overlaps row
+  // 2 and row 6 starts a new run.
+  auto array = makeArrayVector(
+      {0, 2, 5, 9, 9, 9, 20, 25},
+      makeFlatVector<int32_t>(30, [](auto row) { return row; }),
+      {3});
+  array->setOffsetAndSize(5, 6, 4);
+
+  auto runs = [&](const SelectivityVector& rows) {
+    DecodedVector decoded(*array, rows);
+    std::vector<std::pair<vector_size_t, vector_size_t>> result;
+    forEachElementRun<ArrayVector>(rows, decoded, [&](auto begin, auto end) {
+      result.emplace_back(begin, end);
+    });
+    return result;
+  };
+
+  using Runs = std::vector<std::pair<vector_size_t, vector_size_t>>;
+  SelectivityVector rows(array->size());
+  EXPECT_EQ((Runs{{0, 10}, {20, 30}}), runs(rows));
+
+  rows.setValid(1, false);
+  rows.setValid(7, false);
+  rows.updateBounds();
+  EXPECT_EQ((Runs{{0, 2}, {5, 10}, {20, 25}}), runs(rows));
+}
+
+TEST_F(FlattenedElementsTest, sumRange) {
+  std::vector<int32_t> values(100);
+  std::iota(values.begin(), values.end(), 0);
+  auto nulls = allocateNulls(100, pool());
+  auto* rawNulls = nulls->asMutable<uint64_t>();
+  for (auto i = 0; i < 100; i += 2) {
+    bits::setNull(rawNulls, i);
+  }
+
+  EXPECT_EQ(4950, (sumRange<int64_t>(values.data(), nullptr, 0, 100)));
+  EXPECT_EQ(35, (sumRange<int64_t>(values.data(), nullptr, 5, 10)));
+  EXPECT_EQ(2500, (sumRange<int64_t>(values.data(), rawNulls, 0, 100)));
+  EXPECT_EQ(0, (sumRange<int64_t>(values.data(), rawNulls, 10, 10)));
+}
+
+} // namespace
+} // namespace facebook::velox::functions
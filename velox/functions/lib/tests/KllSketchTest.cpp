@@ -129,6 +129,28 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, bulkInsert) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  std::vector<double> values(N);
+  insertRandomData(0, N, kll, values.data());
+  // Insert in batches of varying sizes so that the batches cross the end of
+  // the initial phase and the compactions of level zero.
+  KllSketch<double> kll2(kDefaultK, {}, 0);
+  for (int i = 0, batch = 1; i < N; i += batch, batch = batch * 3 % 1000) {
+    kll2.insert(folly::Range(
+        values.data() + i, values.data() + std::min(N, i + batch)));
+  }
+  kll2.insert(folly::Range<const double*>());
+  EXPECT_EQ(kll2.totalCount(), N);
+  EXPECT_EQ(kll2.getNumRetained(), kll.getNumRetained());
+  auto q = linspace(M);
+  EXPECT_EQ(
+      kll2.estimateQuantiles(folly::Range(q.begin(), q.end())),
+      kll.estimateQuantiles(folly::Range(q.begin(), q.end())));
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
@@ -287,6 +309,24 @@ TEST_F(KllSketchTest, deserializeSmall) {
   EXPECT_EQ(v, v2);
 }
 
+TEST_F(KllSketchTest, serializeNotCompacted) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  insertRandomData(0, N, kll, nullptr);
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  auto kll2 = KllSketch<double>::deserialize(data.data());
+  // The free space below level zero is not serialized, so the levels of the
+  // deserialized sketch start at 0.
+  EXPECT_EQ(kll2.toView().levels[0], 0);
+  EXPECT_EQ(kll2.totalCount(), N);
+  auto q = linspace(M);
+  EXPECT_EQ(
+      kll2.estimateQuantiles(folly::Range(q.begin(), q.end())),
+      kll.estimateQuantiles(folly::Range(q.begin(), q.end())));
+}
+
 TEST_F(KllSketchTest, compact) {
   constexpr int N = 1e5;
   KllSketch<double> kll(kFromEpsilon(0.001));
@@ -545,6 +545,11 @@ TEST_F(Re2FunctionsTest, likeDeterminePatternKind) {
   testPatternString(
       "%helloPrestoWorld%%%", PatternKind::kSubstring, "helloPrestoWorld");
 
+  testPatternString("%foo%bar%", PatternKind::kSubstrings, "foobar");
+  testPatternString("%%a%%b%c%%", PatternKind::kSubstrings, "abc");
+  testPatternString(
+      "%hello%%%presto\n%", PatternKind::kSubstrings, "hellopresto\n");
+
   testPattern("_b%%__", PatternKind::kGeneric, 0);
   testPattern("%_%p", PatternKind::kGeneric, 0);
   testPattern("aBcD%%e%", PatternKind::kGeneric, 0);
@@ -918,6 +923,35 @@ TEST_F(Re2FunctionsTest, likeSubstringPattern) {
       true);
 }
 
+TEST_F(Re2FunctionsTest, likeSubstringsPattern) {
+  testLike("abcde", "%a%c%e%", true);
+  testLike("abcde", "%%ab%%de%%", true);
+  testLike("abcde", "%abc%cde%", false);
+  testLike("abcde", "%c%a%", false);
+  testLike("abab", "%ab%ab%", true);
+  testLike("aba", "%ab%ab%", false);
+  testLike("", "%a%b%", false);
+  testLike("xaxbxaxc", "%a%b%a%c%", true);
+  testLike("xaxbxaxc", "%a%b%c%a%", false);
+  testLike("你好, 世界", "%你%世界%", true);
+  testLike("世界, 你好", "%你%世界%", false);
+
+  // Test literal '_' & '%' in pattern.
+  testLike("a_b%c", R"(%\_%\%%)", '\', true);
+  testLike("a%b_c", R"(%\_%\%%)", '\', false);
+
+  // Long inputs take the SIMD path of the substring search.
+  std::string input = generateString(kLikePatternCharacterSet, 60);
+  testLike(
+      input,
+      "%" + input.substr(10, 20) + "%" + input.substr(40, 15) + "%",
+      true);
+  testLike(
+      input,
+      "%" + input.substr(40, 15) + "%" + input.substr(10, 20) + "%",
+      false);
+}
+
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
   // Test null pattern.
   ASSERT_TRUE(
@@ -109,7 +109,10 @@ void registerRankInternal(
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<RankFunction<TRank, TResult>>(resultType);
-      });
+      },
+      // percent_rank uses the number of rows in the partition.
+      {.supportsRowsStreaming = TRank != RankType::kPercentRank,
+       .ignoresFrame = true});
 }
 
 void registerRankBigint(const std::string& name) {
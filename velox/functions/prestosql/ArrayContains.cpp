@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/FlattenedElements.h"
 #include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::functions {
@@ -25,7 +26,7 @@ void applyTyped(
     DecodedVector& arrayDecoded,
     DecodedVector& elementsDecoded,
     DecodedVector& searchDecoded,
-    exec::EvalCtx& /*context*/,
+    exec::EvalCtx& context,
     FlatVector<bool>& flatResult,
     bool /*throwOnNestedNull*/) {
   using T = typename TypeTraits<kind>::NativeType;
@@ -38,22 +39,33 @@ void applyTyped(
   constexpr bool isBoolType = std::is_same_v<bool, T>;
 
   if (!isBoolType && elementsDecoded.isIdentityMapping() &&
-      !elementsDecoded.mayHaveNulls() && searchDecoded.isConstantMapping()) {
+      searchDecoded.isConstantMapping()) {
+    // Compare all referenced elements with 'search' in one pass, then look
+    // for a match or a null in the range of each row.
     auto rawElements = elementsDecoded.data<T>();
+    auto rawElementNulls =
+        elementsDecoded.mayHaveNulls() ? elementsDecoded.nulls() : nullptr;
     auto search = searchDecoded.valueAt<T>(0);
 
+    auto matches =
+        AlignedBuffer::allocate<bool>(elementsDecoded.size(), context.pool());
+    auto rawMatches = matches->asMutable<uint64_t>();
+    setEqualElementBits<ArrayVector>(
+        rows, arrayDecoded, rawElements, rawElementNulls, search, rawMatches);
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
 
-      for (auto i = 0; i < size; i++) {
-        if (rawElements[offset + i] == search) {
-          flatResult.set(row, true);
-          return;
-        }
+      if (bits::findFirstBit(rawMatches, offset, offset + size) >= 0) {
+        flatResult.set(row, true);
+      } else if (
+          rawElementNulls &&
+          !bits::isAllSet(rawElementNulls, offset, offset + size)) {
+        flatResult.setNull(row, true);
+      } else {
+        flatResult.set(row, false);
       }
-
-      flatResult.set(row, false);
     });
   } else {
     rows.applyToSelected([&](auto row) {
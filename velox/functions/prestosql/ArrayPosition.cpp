@@ -17,6 +17,7 @@
 
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/FlattenedElements.h"
 #include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::functions {
@@ -31,7 +32,8 @@ void applyTypedFirstMatch(
     DecodedVector& arrayDecoded,
     const DecodedVector& elementsDecoded,
     const DecodedVector& searchDecoded,
-    FlatVector<int64_t>& flatResult) {
+    FlatVector<int64_t>& flatResult,
+    memory::MemoryPool* pool) {
   using T = typename TypeTraits<kind>::NativeType;
 
   auto baseArray = arrayDecoded.base()->as<ArrayVector>();
@@ -39,8 +41,10 @@ void applyTypedFirstMatch(
   auto rawOffsets = baseArray->rawOffsets();
   auto indices = arrayDecoded.indices();
 
-  if (elementsDecoded.isIdentityMapping() && !elementsDecoded.mayHaveNulls() &&
-      searchDecoded.isConstantMapping()) {
+  // Null elements are handled by the fast path for types other than boolean.
+  if (elementsDecoded.isIdentityMapping() &&
+      searchDecoded.isConstantMapping() &&
+      (!std::is_same_v<bool, T> || !elementsDecoded.mayHaveNulls())) {
     // Fast path for array vector of boolean.
     if constexpr (std::is_same_v<bool, T>) {
       auto rawElements = elementsDecoded.data<uint64_t>();
@@ -65,25 +69,25 @@ void applyTypedFirstMatch(
       return;
     }
 
-    // Fast path for array vector of types other than boolean.
+    // Fast path for array vector of types other than boolean. Compare all
+    // referenced elements with 'search' in one pass, then find the first
+    // match in the range of each row.
     auto rawElements = elementsDecoded.data<T>();
+    auto rawElementNulls = elementsDecoded.base()->rawNulls();
 
     auto search = searchDecoded.valueAt<T>(0);
 
+    auto matches = AlignedBuffer::allocate<bool>(elementsDecoded.size(), pool);
+    auto rawMatches = matches->asMutable<uint64_t>();
+    setEqualElementBits<ArrayVector>(
+        rows, arrayDecoded, rawElements, rawElementNulls, search, rawMatches);
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
 
-      int i;
-      for (i = 0; i < size; i++) {
-        if (rawElements[offset + i] == search) {
-          flatResult.set(row, i + 1);
-          break;
-        }
-      }
-      if (i == size) {
-        flatResult.set(row, 0);
-      }
+      const auto first = bits::findFirstBit(rawMatches, offset, offset + size);
+      flatResult.set(row, first < 0 ? 0 : first - offset + 1);
     });
     return;
   }
@@ -119,7 +123,8 @@ void applyTypedFirstMatch(
     DecodedVector& arrayDecoded,
     DecodedVector& elementsDecoded,
     DecodedVector& searchDecoded,
-    FlatVector<int64_t>& flatResult) {
+    FlatVector<int64_t>& flatResult,
+    memory::MemoryPool* /*pool*/) {
   auto baseArray = arrayDecoded.base()->as<ArrayVector>();
   auto rawSizes = baseArray->rawSizes();
   auto rawOffsets = baseArray->rawOffsets();
@@ -381,7 +386,8 @@ class ArrayPositionFunction : public exec::VectorFunction {
           *decodedArgs.at(0),
           *elementsHolder.get(),
           *decodedArgs.at(1),
-          *flatResult);
+          *flatResult,
+          context.pool());
     } else {
       const auto& instanceVector = args[2];
       VELOX_CHECK(instanceVector->type()->isBigint());
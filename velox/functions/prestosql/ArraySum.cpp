@@ -21,6 +21,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/CheckedArithmetic.h"
+#include "velox/functions/lib/FlattenedElements.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 
 namespace facebook::velox::functions {
@@ -87,6 +88,22 @@ class ArraySumFunction : public exec::VectorFunction {
       const uint64_t* rawNulls,
       const TInput* rawElements,
       FlatVector<TOutput>* resultValues) const {
+    if constexpr (!std::is_same_v<TInput, int64_t>) {
+      // The sum of up to 2^31 values of 32 bits or less does not overflow a
+      // BIGINT and floating point sums are not checked, so each row is a plain
+      // reduction over its range of the elements.
+      context.applyToSelectedNoThrow(rows, [&](auto row) {
+        const auto offset = arrayVector->offsetAt(row);
+        resultValues->set(
+            row,
+            sumRange<TOutput>(
+                rawElements,
+                mayHaveNulls ? rawNulls : nullptr,
+                offset,
+                offset + arrayVector->sizeAt(row)));
+      });
+      return;
+    }
     applyCore<mayHaveNulls>(
         rows,
         context,
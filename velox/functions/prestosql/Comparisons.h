@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/base/CompareFlags.h"
+#include "velox/expression/FunctionSignature.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 
@@ -190,6 +191,8 @@ struct NeqFunctionTimestampWithTimezone
 
 template <typename TExec>
 struct BetweenFunction {
+  static constexpr auto canonical_name = exec::FunctionCanonicalName::kBetween;
+
   template <typename T>
   FOLLY_ALWAYS_INLINE void
   call(bool& result, const T& value, const T& low, const T& high) {
@@ -24,6 +24,14 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Returns true if the sum or difference of two decimals of at most
+// 'aDigits' and 'bDigits' digits is in the range of DECIMAL(38). The result
+// has at most max(aDigits, bDigits) + 1 digits. This is also the precision of
+// the result type, so the result fits a short decimal result as well.
+inline bool cannotOverflow(int32_t aDigits, int32_t bDigits) {
+  return std::max(aDigits, bDigits) + 1 <= LongDecimalType::kMaxPrecision;
+}
+
 template <typename TExec>
 struct DecimalPlusFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
@@ -36,10 +44,14 @@ struct DecimalPlusFunction {
       B* /*b*/) {
     auto aType = inputTypes[0];
     auto bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
+    const auto [aPrecision, aScale] = getDecimalPrecisionScale(*aType);
+    const auto [bPrecision, bScale] = getDecimalPrecisionScale(*bType);
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    aMultiplier_ = DecimalUtil::kPowersOfTen[aRescale_];
+    bMultiplier_ = DecimalUtil::kPowersOfTen[bRescale_];
+    noOverflow_ =
+        cannotOverflow(aPrecision + aRescale_, bPrecision + bRescale_);
   }
 
   template <typename R, typename A, typename B>
@@ -50,12 +62,14 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
+    if (noOverflow_) {
+      out = R(int128_t(a) * aMultiplier_ + int128_t(b) * bMultiplier_);
+      return;
+    }
     int128_t aRescaled;
     int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    if (__builtin_mul_overflow(a, aMultiplier_, &aRescaled) ||
+        __builtin_mul_overflow(b, bMultiplier_, &bRescaled)) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
     }
     out = checkedPlus<R>(R(aRescaled), R(bRescaled));
@@ -71,6 +85,11 @@ struct DecimalPlusFunction {
 
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
+  // True if the rescaled inputs and the result are known to fit from the
+  // input precisions, in which case no per row checks are needed.
+  bool noOverflow_;
 };
 
 template <typename TExec>
@@ -85,10 +104,14 @@ struct DecimalMinusFunction {
       B* /*b*/) {
     const auto& aType = inputTypes[0];
     const auto& bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
+    const auto [aPrecision, aScale] = getDecimalPrecisionScale(*aType);
+    const auto [bPrecision, bScale] = getDecimalPrecisionScale(*bType);
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    aMultiplier_ = DecimalUtil::kPowersOfTen[aRescale_];
+    bMultiplier_ = DecimalUtil::kPowersOfTen[bRescale_];
+    noOverflow_ =
+        cannotOverflow(aPrecision + aRescale_, bPrecision + bRescale_);
   }
 
   template <typename R, typename A, typename B>
@@ -99,12 +122,14 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
+    if (noOverflow_) {
+      out = R(int128_t(a) * aMultiplier_ - int128_t(b) * bMultiplier_);
+      return;
+    }
     int128_t aRescaled;
     int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    if (__builtin_mul_overflow(a, aMultiplier_, &aRescaled) ||
+        __builtin_mul_overflow(b, bMultiplier_, &bRescaled)) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
     }
     out = checkedMinus<R>(R(aRescaled), R(bRescaled));
@@ -120,17 +145,41 @@ struct DecimalMinusFunction {
 
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
+  // True if the rescaled inputs and the result are known to fit from the
+  // input precisions, in which case no per row checks are needed.
+  bool noOverflow_;
 };
 
 template <typename TExec>
 struct DecimalMultiplyFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
 
+  template <typename A, typename B>
+  void initialize(
+      const std::vector<TypePtr>& inputTypes,
+      const core::QueryConfig& /*config*/,
+      A* /*a*/,
+      B* /*b*/) {
+    const auto aPrecision = getDecimalPrecisionScale(*inputTypes[0]).first;
+    const auto bPrecision = getDecimalPrecisionScale(*inputTypes[1]).first;
+    // The product has at most aPrecision + bPrecision digits.
+    noOverflow_ = aPrecision + bPrecision <= LongDecimalType::kMaxPrecision;
+  }
+
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+    if (noOverflow_) {
+      out = R(a) * R(b);
+      return;
+    }
+    out = checkedMultiply<R>(R(a), R(b));
     DecimalUtil::valueInRange(out);
   }
+
+ private:
+  bool noOverflow_;
 };
 
 template <typename TExec>
@@ -79,8 +79,8 @@ class FindFirstFunctionBase : public exec::VectorFunction {
     if (startIndex != nullptr) {
       startIndexProcessor.process(
           startIndex, rows, rawNulls, rawOffsets, rawSizes, context);
-      rawOffsets = startIndexProcessor.adjustedOffsets->as<vector_size_t>();
-      rawSizes = startIndexProcessor.adjustedSizes->as<vector_size_t>();
+      rawOffsets = startIndexProcessor.adjustedOffsets;
+      rawSizes = startIndexProcessor.adjustedSizes;
     }
 
     // Loop over lambda functions and apply these to elements of the base array,
@@ -134,9 +134,11 @@ class FindFirstFunctionBase : public exec::VectorFunction {
   // new offset and size are 12 and 18. Given the same array and start index
   // -5, the new offset and size are 25, -16. The negative size will be used
   // later to loop over array in reverse.
+  // The adjusted offsets and sizes are only read by doApply(), so they are
+  // allocated from the per-evaluation scratch arena.
   struct StartIndexProcessor {
-    BufferPtr adjustedOffsets;
-    BufferPtr adjustedSizes;
+    vector_size_t* adjustedOffsets{nullptr};
+    vector_size_t* adjustedSizes{nullptr};
 
     void process(
         const VectorPtr& startIndex,
@@ -149,38 +151,35 @@ class FindFirstFunctionBase : public exec::VectorFunction {
 
       exec::LocalDecodedVector startIndexDecoder(context, *startIndex, rows);
 
-      adjustedOffsets = allocateIndices(rows.end(), context.pool());
-      auto* rawAdjustedOffsets = adjustedOffsets->asMutable<vector_size_t>();
-
-      adjustedSizes = allocateIndices(rows.end(), context.pool());
-      auto* rawAdjustedSizes = adjustedSizes->asMutable<vector_size_t>();
+      adjustedOffsets = context.allocateScratch<vector_size_t>(rows.end());
+      adjustedSizes = context.allocateScratch<vector_size_t>(rows.end());
 
       rows.applyToSelected([&](auto row) {
         if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
-          rawAdjustedOffsets[row] = 0;
-          rawAdjustedSizes[row] = 0;
+          adjustedOffsets[row] = 0;
+          adjustedSizes[row] = 0;
         } else if (startIndexDecoder->isNullAt(row)) {
-          rawAdjustedOffsets[row] = 0;
-          rawAdjustedSizes[row] = 0;
+          adjustedOffsets[row] = 0;
+          adjustedSizes[row] = 0;
         } else {
           const auto offset = rawOffsets[row];
           const auto size = rawSizes[row];
           const auto start = startIndexDecoder->valueAt<int64_t>(row);
           if (start > size || start < -size) {
-            rawAdjustedOffsets[row] = 0;
-            rawAdjustedSizes[row] = 0;
+            adjustedOffsets[row] = 0;
+            adjustedSizes[row] = 0;
           } else if (start == 0) {
-            rawAdjustedOffsets[row] = 0;
-            rawAdjustedSizes[row] = 0;
+            adjustedOffsets[row] = 0;
+            adjustedSizes[row] = 0;
 
             recordInvalidStartIndex(row, context);
           } else if (start > 0) {
-            rawAdjustedOffsets[row] = offset + (start - 1);
-            rawAdjustedSizes[row] = size - (start - 1);
+            adjustedOffsets[row] = offset + (start - 1);
+            adjustedSizes[row] = size - (start - 1);
           } else {
             // start is negative.
-            rawAdjustedOffsets[row] = offset + size + start;
-            rawAdjustedSizes[row] = -(size + start + 1);
+            adjustedOffsets[row] = offset + size + start;
+            adjustedSizes[row] = -(size + start + 1);
           }
         }
       });
@@ -48,33 +48,35 @@ void checkArraySizes(
 }
 
 /// Populates indices of the n-th elements of the arrays.
-/// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
+/// Deselects 'row' in 'arrayRows' if corresponding array has no n-th element,
+/// so that 'arrayRows' shrinks as 'n' grows and each step only visits the
+/// arrays that still have elements. 'arrayRows' must be a subset of the rows
+/// of the previous step.
 /// Sets elementIndices[row] to the index of the n-th element in the 'elements'
-/// vector.
+/// vector. The indices of deselected rows are left as is, they remain valid
+/// indices into 'elements'.
 /// Returns true if at least one array has n-th element.
 bool toNthElementRows(
     const ArrayVectorPtr& arrayVector,
-    const SelectivityVector& rows,
     vector_size_t n,
     SelectivityVector& arrayRows,
     BufferPtr& elementIndices) {
   auto* rawSizes = arrayVector->rawSizes();
   auto* rawOffsets = arrayVector->rawOffsets();
-  auto* rawNulls = arrayVector->rawNulls();
 
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  arrayRows.clearAll();
-  memset(rawElementIndices, 0, elementIndices->size());
-
-  rows.applyToSelected([&](auto row) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
-      if (n < rawSizes[row]) {
-        arrayRows.setValid(row, true);
-        rawElementIndices[row] = rawOffsets[row] + n;
-      }
-    }
-  });
+  // Clearing the bit of the current row does not disturb forEachSetBit,
+  // which has already loaded the word.
+  auto* rawArrayRows = arrayRows.asMutableRange().bits();
+  bits::forEachSetBit(
+      rawArrayRows, arrayRows.begin(), arrayRows.end(), [&](auto row) {
+        if (n < rawSizes[row]) {
+          rawElementIndices[row] = rawOffsets[row] + n;
+        } else {
+          bits::clearBit(rawArrayRows, row);
+        }
+      });
   arrayRows.updateBounds();
 
   return arrayRows.hasSelections();
@@ -164,10 +166,19 @@ class ReduceFunction : public exec::VectorFunction {
     // Then, apply input function to second elements of all arrays.
     // And so on until all elements of all arrays have been processed.
     // At each step the number of arrays being processed will get smaller as
-    // some arrays will run out of elements.
+    // some arrays will run out of elements. Rows that fail are dropped too,
+    // so that they are not evaluated for the rest of their elements.
     while (auto entry = inputFuncIt.next()) {
       VectorPtr state = initialState;
 
+      arrayRows.clearAll();
+      entry.rows->applyToSelected([&](auto row) {
+        if (rawSizes[row] > 0) {
+          arrayRows.setValid(row, true);
+        }
+      });
+      arrayRows.updateBounds();
+
       vector_size_t n = 0;
       while (true) {
         // 'state' might use the 'elementIndices', in that case we need to
@@ -180,8 +191,7 @@ class ReduceFunction : public exec::VectorFunction {
         // false otherwise.
         // Set elementIndices[row] to the index of the n-th element in the
         // array's elements vector.
-        if (!toNthElementRows(
-                flatArray, *entry.rows, n, arrayRows, elementIndices)) {
+        if (!toNthElementRows(flatArray, n, arrayRows, elementIndices)) {
           break; // Ran out of elements in all arrays.
         }
 
@@ -204,6 +214,7 @@ class ReduceFunction : public exec::VectorFunction {
             nullptr,
             &partialResult);
         state = partialResult;
+        context.deselectErrors(arrayRows);
         n++;
       }
     }
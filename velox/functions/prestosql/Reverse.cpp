@@ -41,10 +41,32 @@ class ReverseFunction : public exec::VectorFunction {
         const SelectivityVector& rows,
         const FlatVector<StringView>* input,
         FlatVector<StringView>* result) {
-      rows.applyToSelected([&](int row) {
-        auto proxy = exec::StringWriter<>(result, row);
-        stringImpl::reverse<isAscii>(proxy, input->valueAt(row).getString());
-        proxy.finalize();
+      // A reversed string has the size of the input, so all the results that
+      // are not inlined are written into one buffer of the exact size.
+      size_t totalSize = 0;
+      rows.applyToSelected([&](auto row) {
+        const auto size = input->valueAt(row).size();
+        if (!StringView::isInline(size)) {
+          totalSize += size;
+        }
+      });
+      char* buffer = totalSize > 0
+          ? result->getRawStringBufferWithSpace(totalSize, true)
+          : nullptr;
+      rows.applyToSelected([&](auto row) {
+        const auto value = input->valueAt(row);
+        const auto size = value.size();
+        char inlined[StringView::kInlineSize];
+        char* output = StringView::isInline(size) ? inlined : buffer;
+        if constexpr (isAscii) {
+          stringCore::reverseAscii(output, value.data(), size);
+        } else {
+          stringCore::reverseUnicode(output, value.data(), size);
+        }
+        result->setNoCopy(row, StringView(output, size));
+        if (output == buffer) {
+          buffer += size;
+        }
       });
     }
   };
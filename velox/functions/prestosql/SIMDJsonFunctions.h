@@ -171,6 +171,23 @@ template <typename T>
 struct SIMDJsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Parsing the document dominates, so results are worth caching.
+  static constexpr bool is_expensive = true;
+
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      try {
+        constantExtractor_ = SIMDJsonExtractor::compile(*jsonPath);
+      } catch (const VeloxUserError&) {
+        // Leave an invalid path to be reported for each row as before.
+      }
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
@@ -179,6 +196,10 @@ struct SIMDJsonExtractScalarFunction {
   }
 
  private:
+  // Set if the path is constant. Saves trimming and hashing the path to find
+  // the cached extractor for each row.
+  std::unique_ptr<SIMDJsonExtractor> constantExtractor_;
+
   FOLLY_ALWAYS_INLINE bool callImpl(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
@@ -218,7 +239,9 @@ struct SIMDJsonExtractScalarFunction {
       return simdjson::SUCCESS;
     };
 
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+    auto& extractor = constantExtractor_
+        ? *constantExtractor_
+        : SIMDJsonExtractor::getInstance(jsonPath);
     SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
 
     if (resultStr.has_value()) {
@@ -299,6 +299,9 @@ struct UrlExtractHostFunction {
   // ASCII input always produces ASCII result.
   static constexpr bool is_default_ascii_behavior = true;
 
+  // Validating and parsing the URL dominates, so results are worth caching.
+  static constexpr bool is_expensive = true;
+
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
@@ -456,6 +459,75 @@ struct UrlExtractParameterFunction {
   }
 };
 
+/// The parse shared by url_extract_protocol, host, port, query and fragment.
+/// Returns a row of these in this order with the values the respective
+/// functions return. The row is null if 'url' is not a valid URI. Called
+/// instead of the individual functions when an expression extracts more than
+/// one of them from the same URL. See exec::SharedParseFunction.
+template <typename T>
+struct UrlParseFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr int32_t kProtocol = 0;
+  static constexpr int32_t kHost = 1;
+  static constexpr int32_t kPort = 2;
+  static constexpr int32_t kQuery = 3;
+  static constexpr int32_t kFragment = 4;
+
+  FOLLY_ALWAYS_INLINE bool call(
+      out_type<Row<Varchar, Varchar, int64_t, Varchar, Varchar>>& result,
+      const arg_type<Varchar>& url) {
+    if (!detail::isValidURI(url)) {
+      return false;
+    }
+
+    boost::cmatch match;
+    const bool matched = detail::parse(url.data(), url.size(), match);
+    auto group = [&](int idx) -> std::optional<StringView> {
+      if (matched && match[idx].matched) {
+        return detail::submatch(match, idx);
+      }
+      return std::nullopt;
+    };
+    auto setOrEmpty = [](auto& writer, const std::optional<StringView>& value) {
+      if (value.has_value()) {
+        writer.copy_from(value.value());
+      } else {
+        writer.setEmpty();
+      }
+    };
+
+    setOrEmpty(
+        result.template get_writer_at<kProtocol>(), group(detail::kScheme));
+    setOrEmpty(result.template get_writer_at<kQuery>(), group(detail::kQuery));
+    setOrEmpty(
+        result.template get_writer_at<kFragment>(), group(detail::kFragment));
+
+    std::optional<StringView> host;
+    std::optional<int64_t> port;
+    if (auto authAndPath = group(detail::kAuthority)) {
+      boost::cmatch authorityMatch;
+      host = matchAuthorityAndPath(
+          authAndPath.value(), authorityMatch, detail::kHost);
+      auto portText = matchAuthorityAndPath(
+          authAndPath.value(), authorityMatch, detail::kPort);
+      if (portText.has_value() && !portText.value().empty()) {
+        try {
+          port = to<int64_t>(portText.value());
+        } catch (folly::ConversionError const&) {
+        }
+      }
+    }
+    setOrEmpty(result.template get_writer_at<kHost>(), host);
+    if (port.has_value()) {
+      result.template get_writer_at<kPort>() = port.value();
+    } else {
+      result.template set_null_at<kPort>();
+    }
+    return true;
+  }
+};
+
 template <typename T>
 struct UrlEncodeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
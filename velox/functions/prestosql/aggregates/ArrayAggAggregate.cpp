@@ -42,6 +42,20 @@ class ArrayAggAggregate : public exec::Aggregate {
     return true;
   }
 
+  bool supportsRelocation() const override {
+    return true;
+  }
+
+  void relocate(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocation& relocation) override {
+    for (auto* group : groups) {
+      if (isInitialized(group)) {
+        value<ArrayAccumulator>(group)->elements.relocate(relocation);
+      }
+    }
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -109,9 +123,7 @@ class ArrayAggAggregate : public exec::Aggregate {
         clearNull(rawNulls, i);
 
         ValueListReader reader(values);
-        for (auto index = 0; index < arraySize; ++index) {
-          reader.next(*elements, offset + index);
-        }
+        reader.next(*elements, offset, arraySize);
         vector->setOffsetAndSize(i, offset, arraySize);
         offset += arraySize;
       } else {
@@ -174,6 +186,12 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     decodedElements_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
+    if (rows.isAllSelected() &&
+        (!ignoreNulls_ || !decodedElements_.mayHaveNulls())) {
+      values.appendRange(
+          BaseVector::loadedVectorShared(args[0]), 0, rows.end(), allocator_);
+      return;
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
         return;
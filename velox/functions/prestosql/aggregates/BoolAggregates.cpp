@@ -37,6 +37,10 @@ class BoolAndOrAggregate : public SimpleNumericAggregate<bool, bool, bool> {
     return sizeof(bool);
   }
 
+  bool supportsRelocation() const override {
+    return true;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     auto* vector = (*result)->as<FlatVector<bool>>();
@@ -43,6 +43,10 @@ class MinMaxAggregate : public SimpleNumericAggregate<T, T, T> {
     return sizeof(T);
   }
 
+  bool supportsRelocation() const override {
+    return true;
+  }
+
   int32_t accumulatorAlignmentSize() const override {
     return 1;
   }
@@ -75,6 +75,33 @@ TEST_F(SumTest, sumTinyint) {
       "SELECT sum(c1) FROM tmp WHERE c0 % 2 = 0");
 }
 
+TEST_F(SumTest, runsOfGroupsAndFlatInput) {
+  // Flat inputs with and without nulls, with runs of rows of the same group.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row / 97; }),
+      makeFlatVector<int32_t>(
+          10'000, [](auto row) { return row * 13 - 50'000; }),
+      makeFlatVector<int16_t>(
+          10'000, [](auto row) { return row % 1'000; }, nullEvery(11)),
+      makeFlatVector<int8_t>(10'000, [](auto row) { return row % 100; }),
+  });
+  createDuckDbTable({data});
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)", "min(c1)", "max(c1)", "sum(c2)", "max(c2)", "sum(c3)"};
+  testAggregations(
+      {data},
+      {"c0"},
+      aggregates,
+      "SELECT c0, sum(c1), min(c1), max(c1), sum(c2), max(c2), sum(c3) "
+      "FROM tmp GROUP BY 1");
+  testAggregations(
+      {data},
+      {},
+      aggregates,
+      "SELECT sum(c1), min(c1), max(c1), sum(c2), max(c2), sum(c3) FROM tmp");
+}
+
 TEST_F(SumTest, sumFloat) {
   auto data = makeRowVector({makeFlatVector<float>({2.00, 1.00})});
   createDuckDbTable({data});
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook::velox;
+
+// Compares decimal arithmetic against the same arithmetic over doubles. The
+// short and medium precisions take the path without per row overflow
+// checks. DECIMAL(38, 10) inputs need the checks.
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerArithmeticFunctions();
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "decimal_arithmetic",
+          ROW({"short_a",
+               "short_b",
+               "medium_a",
+               "medium_b",
+               "long_a",
+               "long_b",
+               "double_a",
+               "double_b"},
+              {DECIMAL(12, 2),
+               DECIMAL(15, 4),
+               DECIMAL(30, 10),
+               DECIMAL(30, 10),
+               DECIMAL(38, 10),
+               DECIMAL(38, 10),
+               DOUBLE(),
+               DOUBLE()}))
+      .withFuzzerOptions({.vectorSize = 1000, .nullRatio = 0})
+      .addExpression("double_plus", "double_a + double_b")
+      .addExpression("short_plus", "short_a + short_b")
+      .addExpression("medium_plus", "medium_a + medium_b")
+      .addExpression("long_plus", "long_a + long_b")
+      .addExpression("double_multiply", "double_a * double_b")
+      .addExpression("short_multiply", "short_a * short_b")
+      .addExpression("medium_multiply", "short_a * medium_b")
+      .addExpression(
+          "double_charge", "double_a * (1.0 - double_b) * (1.0 + double_b)")
+      .addExpression(
+          "short_charge",
+          "short_a * (cast(1 as decimal(12, 2)) - short_b) * "
+          "(cast(1 as decimal(12, 2)) + short_b)")
+      .withIterations(100)
+      .disableTesting();
+
+  benchmarkBuilder.registerBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "folly/Range.h"
@@ -57,6 +58,11 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new extractor for 'path' that is owned by the caller. Used by
+  /// functions with a constant path to tokenize it once per expression
+  /// instead of looking it up in the cache for each row.
+  static std::unique_ptr<SIMDJsonExtractor> compile(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -150,8 +156,9 @@ simdjson::error_code simdJsonExtract(
     const velox::StringView& json,
     SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  SIMDJSON_ASSIGN_OR_RAISE(
+      auto jsonDoc,
+      simdjsonParse(reusablePaddedJson(json.data(), json.size())));
 
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
@@ -16,6 +16,8 @@
 
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 
+#include <cstring>
+
 #include "velox/common/base/VeloxException.h"
 
 namespace facebook::velox {
@@ -34,4 +36,18 @@ simdjson::simdjson_result<simdjson::ondemand::document> simdjsonParse(
   return parser.iterate(json);
 }
 
+simdjson::padded_string_view reusablePaddedJson(
+    const char* data,
+    size_t size) {
+  thread_local std::string buffer;
+  const auto capacity = size + simdjson::SIMDJSON_PADDING;
+  if (buffer.size() < capacity) {
+    buffer.resize(capacity);
+  }
+  if (size > 0) {
+    std::memcpy(buffer.data(), data, size);
+  }
+  return simdjson::padded_string_view(buffer.data(), size, buffer.size());
+}
+
 } // namespace facebook::velox
@@ -47,4 +47,10 @@ void simdjsonErrorsToExceptions(
 simdjson::simdjson_result<simdjson::ondemand::document> simdjsonParse(
     const simdjson::padded_string_view& json);
 
+/// Copies 'size' bytes at 'data' into a thread local buffer followed by the
+/// padding simdjson requires and returns a view of the copy. The buffer only
+/// grows, so parsing a batch of values does not allocate for each value. The
+/// view is valid until the next call on the same thread.
+simdjson::padded_string_view reusablePaddedJson(const char* data, size_t size);
+
 } // namespace facebook::velox
@@ -112,7 +112,10 @@ void registerStringFunctions(const std::string& prefix) {
 
   // Regex functions
   exec::registerStatefulVectorFunction(
-      prefix + "regexp_extract", re2ExtractSignatures(), makeRegexExtract);
+      prefix + "regexp_extract",
+      re2ExtractSignatures(),
+      makeRegexExtract,
+      exec::VectorFunctionMetadataBuilder().expensive(true).build());
   exec::registerStatefulVectorFunction(
       prefix + "regexp_extract_all",
       re2ExtractAllSignatures(),
@@ -14,11 +14,30 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/StringFunctions.h"
 #include "velox/functions/prestosql/URLFunctions.h"
 
 namespace facebook::velox::functions {
+namespace {
+const char* const kUrlParse = "$internal$url_parse";
+
+// Lets 'name' be computed as field 'index' of $internal$url_parse.
+void registerUrlParseProjection(const std::string& name, uint32_t index) {
+  exec::registerSharedParseFunction(
+      name,
+      {kUrlParse,
+       ROW({VARCHAR(), VARCHAR(), BIGINT(), VARCHAR(), VARCHAR()}),
+       1,
+       [index](
+           const core::TypedExprPtr& parsed,
+           const core::CallTypedExpr& call) -> core::TypedExprPtr {
+         return std::make_shared<core::DereferenceTypedExpr>(
+             call.type(), parsed, index);
+       }});
+}
+} // namespace
 
 void registerURLFunctions(const std::string& prefix) {
   registerFunction<UrlExtractHostFunction, Varchar, Varchar>(
@@ -39,5 +58,16 @@ void registerURLFunctions(const std::string& prefix) {
       {prefix + "url_encode"});
   registerFunction<UrlDecodeFunction, Varchar, Varchar>(
       {prefix + "url_decode"});
+
+  registerFunction<
+      UrlParseFunction,
+      Row<Varchar, Varchar, int64_t, Varchar, Varchar>,
+      Varchar>({kUrlParse});
+  using Parse = UrlParseFunction<exec::VectorExec>;
+  registerUrlParseProjection(prefix + "url_extract_protocol", Parse::kProtocol);
+  registerUrlParseProjection(prefix + "url_extract_host", Parse::kHost);
+  registerUrlParseProjection(prefix + "url_extract_port", Parse::kPort);
+  registerUrlParseProjection(prefix + "url_extract_query", Parse::kQuery);
+  registerUrlParseProjection(prefix + "url_extract_fragment", Parse::kFragment);
 }
 } // namespace facebook::velox::functions
@@ -105,6 +105,39 @@ TEST_F(ArrayContainsTest, integerWithNulls) {
        std::nullopt});
 }
 
+TEST_F(ArrayContainsTest, longArrays) {
+  // Arrays of 0 to 199 elements that span several words of the match mask.
+  // Every 50th element is null.
+  auto arrayVector = makeArrayVector<int8_t>(
+      200,
+      [](auto row) { return row; },
+      [](auto index) { return index % 100; },
+      nullptr,
+      [](auto index) { return index % 50 == 49; });
+
+  auto expected = [&](int8_t search) {
+    std::vector<std::optional<bool>> result;
+    for (auto row = 0; row < arrayVector->size(); ++row) {
+      std::optional<bool> contains = false;
+      const auto offset = arrayVector->offsetAt(row);
+      for (auto i = 0; i < arrayVector->sizeAt(row); ++i) {
+        if ((offset + i) % 50 == 49) {
+          contains = std::nullopt;
+        } else if ((offset + i) % 100 == search) {
+          contains = true;
+          break;
+        }
+      }
+      result.push_back(contains);
+    }
+    return result;
+  };
+
+  for (int8_t search : {0, 7, 63, 99, 120}) {
+    testContains(arrayVector, search, expected(search));
+  }
+}
+
 TEST_F(ArrayContainsTest, varcharNoNulls) {
   auto arrayVector = makeArrayVector<StringView>({
       {"red"_sv, "blue"_sv},
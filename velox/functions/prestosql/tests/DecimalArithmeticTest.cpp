@@ -301,6 +301,47 @@ TEST_F(DecimalArithmeticTest, multiply) {
       "");
 }
 
+// Inputs whose precisions rule out overflow skip the overflow checks. The
+// results at the limits of these precisions must still be exact.
+TEST_F(DecimalArithmeticTest, precisionLimits) {
+  const int128_t max37 = DecimalUtil::kPowersOfTen[37] - 1;
+  auto longFlat = makeFlatVector<int128_t>({max37, -max37, 1}, DECIMAL(37, 0));
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>({2 * max37, -2 * max37, 2}, DECIMAL(38, 0)),
+      "c0 + c1",
+      {longFlat, longFlat});
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>({2 * max37, -2 * max37, 2}, DECIMAL(38, 0)),
+      "c0 - c1",
+      {longFlat,
+       makeFlatVector<int128_t>({-max37, max37, -1}, DECIMAL(37, 0))});
+
+  // Rescaling by 10 of DECIMAL(36, 0) makes 37 digits of DECIMAL(38, 1).
+  const int128_t max36 = DecimalUtil::kPowersOfTen[36] - 1;
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {max36 * 10 + 9, -max36 * 10 - 9}, DECIMAL(38, 1)),
+      "c0 + c1",
+      {makeFlatVector<int128_t>({max36, -max36}, DECIMAL(36, 0)),
+       makeFlatVector<int64_t>({9, -9}, DECIMAL(2, 1))});
+
+  const int64_t max18 = DecimalUtil::kPowersOfTen[18] - 1;
+  auto shortFlat = makeFlatVector<int64_t>({max18, -max18}, DECIMAL(18, 0));
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {int128_t(max18) * max18, -int128_t(max18) * max18},
+          DECIMAL(36, 0)),
+      "c0 * c1",
+      {shortFlat, makeFlatVector<int64_t>({max18, max18}, DECIMAL(18, 0))});
+
+  const int64_t max9 = DecimalUtil::kPowersOfTen[9] - 1;
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({max9 * max9, -max9 * max9}, DECIMAL(18, 0)),
+      "c0 * c1",
+      {makeFlatVector<int64_t>({max9, -max9}, DECIMAL(9, 0)),
+       makeFlatVector<int64_t>({max9, max9}, DECIMAL(9, 0))});
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivTest) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Divide short and short, returning long.
@@ -943,6 +943,48 @@ TEST_F(ElementAtTest, errorStatesArray) {
       [](auto row) { return row == 40; });
 }
 
+TEST_F(ElementAtTest, manyConstantKeys) {
+  // Row 'row' of batch 'batch' maps keys 0 ... (row + batch) % 7 to key * 10 +
+  // row.
+  auto numKeys = [](auto batch, auto row) { return 1 + (row + batch) % 7; };
+  auto makeMap = [&](int32_t batch) {
+    std::vector<std::vector<std::pair<int64_t, std::optional<int64_t>>>> maps(
+        kVectorSize);
+    for (auto row = 0; row < kVectorSize; ++row) {
+      for (auto key = 0; key < numKeys(batch, row); ++key) {
+        maps[row].push_back({key, key * 10 + row});
+      }
+    }
+    return makeMapVector<int64_t, int64_t>(maps);
+  };
+
+  // The subscripts into the same map share one index of the keys from the
+  // second subscript on. The later batches index all keys up front.
+  const std::vector<int64_t> keys = {1, 3, 5, 100, 0};
+  const std::string expression =
+      "row_constructor(c0[1], element_at(c0, 3), c0[5], element_at(c0, 100), "
+      "c0[0])";
+  for (auto batch = 0; batch < 3; ++batch) {
+    auto map = makeMap(batch);
+    auto indices = makeIndicesInReverse(kVectorSize);
+    auto input = batch < 2 ? map : wrapInDictionary(indices, map);
+    auto result = evaluate<RowVector>(expression, makeRowVector({input}));
+    for (auto i = 0; i < keys.size(); ++i) {
+      auto expected = makeFlatVector<int64_t>(
+          kVectorSize,
+          [&](auto row) {
+            auto mapRow = batch < 2 ? row : kVectorSize - 1 - row;
+            return keys[i] * 10 + mapRow;
+          },
+          [&](auto row) {
+            auto mapRow = batch < 2 ? row : kVectorSize - 1 - row;
+            return keys[i] >= numKeys(batch, mapRow);
+          });
+      test::assertEqualVectors(expected, result->childAt(i));
+    }
+  }
+}
+
 TEST_F(ElementAtTest, testCachingOptimzation) {
   std::vector<std::vector<std::pair<int64_t, std::optional<int64_t>>>>
       inputMapVectorData;
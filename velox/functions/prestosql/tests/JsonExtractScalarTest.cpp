@@ -211,6 +211,46 @@ TEST_F(JsonExtractScalarTest, overflow) {
       "184467440737095516151844674407370955161518446744073709551615");
 }
 
+// A constant path is tokenized once for the expression. The documents of a
+// batch are parsed one after another from a shared padded buffer, so a long
+// document must not leave bytes behind for the shorter ones that follow.
+TEST_F(JsonExtractScalarTest, constantPath) {
+  const std::string longValue(1'000, 'x');
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {fmt::format(R"({{"k1":"{}","k2":1}})", longValue),
+       R"({"k1":"short"})",
+       std::nullopt,
+       R"({"k1":true})",
+       R"({"k2":2})",
+       R"({"k1":)"},
+      JSON())});
+
+  auto result = evaluate("json_extract_scalar(c0, '$.k1')", data);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {longValue,
+           "short",
+           std::nullopt,
+           "true",
+           std::nullopt,
+           std::nullopt}),
+      result);
+
+  result = evaluate("json_extract_scalar(c0, ' $.k2 ')", data);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"1",
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           "2",
+           std::nullopt}),
+      result);
+
+  VELOX_ASSERT_THROW(
+      evaluate("json_extract_scalar(c0, '$.k1.')", data), "Invalid JSON path");
+}
+
 // TODO: When there is a wildcard in the json path, Presto's behavior is to
 // always extract an array of selected items, and hence json_extract_scalar()
 // always return NULL in this situation. But some internal customers are
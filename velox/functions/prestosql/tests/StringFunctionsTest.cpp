@@ -1436,6 +1436,43 @@ TEST_F(StringFunctionsTest, varbinaryReverse) {
   test::assertEqualVectors(expected, result);
 }
 
+TEST_F(StringFunctionsTest, reverseVector) {
+  // Inlined and not inlined strings, with and without non-ASCII characters.
+  std::vector<std::pair<std::string, std::string>> prefixes = {
+      {"ab", "ba"}, {"\u4FE1b", "b\u4FE1"}};
+  for (const auto& [prefix, reversedPrefix] : prefixes) {
+    SCOPED_TRACE(prefix);
+    std::vector<std::optional<std::string>> values;
+    std::vector<std::optional<std::string>> expected;
+    for (auto i = 0; i < 100; ++i) {
+      if (i % 11 == 0) {
+        values.push_back(std::nullopt);
+        expected.push_back(std::nullopt);
+        continue;
+      }
+      auto suffix = std::string(i % 23, 'x') + std::to_string(i);
+      values.push_back(prefix + suffix);
+      std::reverse(suffix.begin(), suffix.end());
+      expected.push_back(suffix + reversedPrefix);
+    }
+    auto input = makeRowVector({makeNullableFlatVector(values)});
+    auto result = evaluate("reverse(c0)", input);
+    test::assertEqualVectors(makeNullableFlatVector(expected), result);
+  }
+}
+
+TEST_F(StringFunctionsTest, isAscii) {
+  for (auto size : {0, 1, 63, 64, 65, 200}) {
+    std::string value(size, 'a');
+    EXPECT_TRUE(functions::stringCore::isAscii(value.data(), value.size()));
+    for (auto i = 0; i < size; ++i) {
+      value[i] = '\x80';
+      EXPECT_FALSE(functions::stringCore::isAscii(value.data(), value.size()));
+      value[i] = 'a';
+    }
+  }
+}
+
 TEST_F(StringFunctionsTest, toUtf8) {
   const auto toUtf8 = [&](std::optional<std::string> value) {
     return evaluateOnce<std::string>("to_utf8(c0)", value);
@@ -124,6 +124,51 @@ TEST_F(URLFunctionsTest, validateURL) {
       std::nullopt);
 }
 
+// Extracting more than one part of the same URL parses it once and gives the
+// same results as extracting each part by itself.
+TEST_F(URLFunctionsTest, sharedParse) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {"http://example.com:8080/path1/p.php?k1=v1&k2=v2#Ref1",
+       "https://user:pw@[::1]:99999999999999999999/x",
+       "foo",
+       "mailto:a@b.com",
+       "http://example.com/p.php?",
+       "http://example.com/p.php%z",
+       "http:// example.com",
+       std::nullopt})});
+
+  const std::vector<std::string> parts = {
+      "url_extract_protocol(c0)",
+      "url_extract_host(c0)",
+      "url_extract_port(c0)",
+      "url_extract_query(c0)",
+      "url_extract_fragment(c0)",
+  };
+  auto exprSet = compileExpressions(parts, asRowType(data->type()));
+  ASSERT_EQ(exprSet->exprs().size(), parts.size());
+  for (const auto& expr : exprSet->exprs()) {
+    ASSERT_EQ(expr->inputs().size(), 1);
+    ASSERT_EQ(expr->inputs()[0]->name(), "$internal$url_parse");
+    ASSERT_EQ(
+        expr->inputs()[0].get(), exprSet->exprs()[0]->inputs()[0].get());
+  }
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(parts.size());
+  exprSet->eval(rows, context, results);
+  for (auto i = 0; i < parts.size(); ++i) {
+    SCOPED_TRACE(parts[i]);
+    velox::test::assertEqualVectors(evaluate(parts[i], data), results[i]);
+  }
+
+  // A single part is computed by its own function.
+  exprSet = compileExpressions(
+      {"url_extract_host(c0)", "url_extract_host(c0)"},
+      asRowType(data->type()));
+  ASSERT_EQ(exprSet->exprs()[0]->name(), "url_extract_host");
+}
+
 TEST_F(URLFunctionsTest, extractPath) {
   const auto extractPath = [&](const std::optional<std::string>& url) {
     return evaluateOnce<std::string>("url_extract_path(c0)", url);
@@ -16,11 +16,17 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
+#include <unistd.h>
+#include <atomic>
+#include <deque>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/remote/client/ThriftClient.h"
 #include "velox/functions/remote/if/GetSerde.h"
+#include "velox/functions/remote/if/SharedMemory.h"
 #include "velox/functions/remote/if/gen-cpp2/RemoteFunctionServiceAsyncClient.h"
 #include "velox/type/fbhive/HiveTypeSerializer.h"
 #include "velox/vector/VectorStream.h"
@@ -43,7 +49,26 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRequestBytes_(metadata.maxRequestBytes),
+        maxInflightRequests_(metadata.maxInflightRequests),
+        sharedMemorySlotBytes_(metadata.sharedMemorySlotBytes) {
+    VELOX_CHECK_GE(maxRequestBytes_, 0);
+    VELOX_CHECK_GT(metadata.maxInflightRequests, 0);
+    if (!metadata.sharedMemoryDirectory.empty()) {
+      VELOX_CHECK_GT(sharedMemorySlotBytes_, 0);
+      static std::atomic<int64_t> fileCounter{0};
+      sharedMemory_ = SharedMemoryFile::create(
+          fmt::format(
+              "{}/velox-remote-function-{}-{}",
+              metadata.sharedMemoryDirectory,
+              getpid(),
+              fileCounter++),
+          sharedMemorySlotBytes_ * maxInflightRequests_);
+      for (int32_t slot = maxInflightRequests_ - 1; slot >= 0; --slot) {
+        freeSlots_.push_back(slot);
+      }
+    }
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -86,7 +111,6 @@ class RemoteFunction : public exec::VectorFunction {
         std::move(args));
 
     // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,38 +120,165 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
     requestInputs->pageFormat_ref() = serdeFormat_;
 
-    // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+    const vector_size_t numRows = rows.end();
+    const auto rowsPerRequest = computeRowsPerRequest(*remoteRowVector);
+    if (rowsPerRequest >= numRows) {
+      const auto slot = acquireSlot();
+      SCOPE_EXIT {
+        releaseSlot(slot);
+      };
+      requestInputs->rowCount_ref() = numRows;
+      // TODO: serialize only active rows.
+      setInput(
+          rowVectorToIOBuf(
+              remoteRowVector, numRows, *context.pool(), serde_.get()),
+          slot,
+          *requestInputs);
 
-    try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
-    } catch (const std::exception& e) {
-      VELOX_FAIL(
-          "Error while executing remote function '{}' at '{}': {}",
-          functionName_,
-          location_.describe(),
-          e.what());
+      remote::RemoteFunctionResponse remoteResponse;
+      try {
+        thriftClient_->sync_invokeFunction(remoteResponse, request);
+      } catch (const std::exception& e) {
+        throwRemoteError(e.what());
+      }
+      result = toResult(remoteResponse, outputType, *context.pool());
+      return;
+    }
+
+    // Sends the row ranges as a window of up to 'maxInflightRequests_'
+    // asynchronous requests. The responses are copied into 'result' in the
+    // order of the ranges, while the event base keeps the later requests
+    // going.
+    BaseVector::ensureWritable(
+        SelectivityVector(numRows), outputType, context.pool(), result);
+    struct Inflight {
+      vector_size_t offset;
+      int32_t slot;
+      folly::SemiFuture<remote::RemoteFunctionResponse> response;
+    };
+    std::deque<Inflight> inflight;
+    // Lets the requests in flight finish before unwinding.
+    auto drain = folly::makeGuard([&]() {
+      for (auto& pending : inflight) {
+        std::move(pending.response).via(&eventBase_).getTryVia(&eventBase_);
+        releaseSlot(pending.slot);
+      }
+    });
+    vector_size_t nextRow = 0;
+    while (nextRow < numRows || !inflight.empty()) {
+      while (nextRow < numRows && inflight.size() < maxInflightRequests_) {
+        const auto size = std::min(rowsPerRequest, numRows - nextRow);
+        auto slice = std::static_pointer_cast<RowVector>(
+            remoteRowVector->slice(nextRow, size));
+        const auto slot = acquireSlot();
+        requestInputs->rowCount_ref() = size;
+        setInput(
+            rowVectorToIOBuf(slice, size, *context.pool(), serde_.get()),
+            slot,
+            *requestInputs);
+        inflight.push_back(
+            {nextRow, slot, thriftClient_->semifuture_invokeFunction(request)});
+        nextRow += size;
+      }
+
+      auto pending = std::move(inflight.front());
+      inflight.pop_front();
+      SCOPE_EXIT {
+        releaseSlot(pending.slot);
+      };
+      auto response = std::move(pending.response)
+                          .via(&eventBase_)
+                          .getTryVia(&eventBase_);
+      if (response.hasException()) {
+        throwRemoteError(response.exception().what().toStdString());
+      }
+      auto rangeResult = toResult(*response, outputType, *context.pool());
+      result->copy(rangeResult.get(), pending.offset, 0, rangeResult->size());
     }
+  }
 
+  // Returns a free shared memory slot or -1 if there is none.
+  int32_t acquireSlot() const {
+    if (freeSlots_.empty()) {
+      return -1;
+    }
+    const auto slot = freeSlots_.back();
+    freeSlots_.pop_back();
+    return slot;
+  }
+
+  void releaseSlot(int32_t slot) const {
+    if (slot >= 0) {
+      freeSlots_.push_back(slot);
+    }
+  }
+
+  // Sets 'payload' as the input of a request, in shared memory slot 'slot'
+  // if it is not -1 and the payload fits.
+  void setInput(
+      folly::IOBuf payload,
+      int32_t slot,
+      remote::RemoteFunctionPage& inputs) const {
+    setPagePayload(
+        std::move(payload),
+        slot >= 0 ? sharedMemory_.get() : nullptr,
+        slot * sharedMemorySlotBytes_,
+        sharedMemorySlotBytes_,
+        inputs);
+  }
+
+  // Returns the number of rows to send in one request so that a request
+  // carries about 'maxRequestBytes_' of input.
+  vector_size_t computeRowsPerRequest(const RowVector& input) const {
+    if (maxRequestBytes_ == 0 || input.size() == 0) {
+      return input.size();
+    }
+    const uint64_t numBytes = input.estimateFlatSize();
+    const uint64_t numRequests =
+        (numBytes + maxRequestBytes_ - 1) / maxRequestBytes_;
+    if (numRequests <= 1) {
+      return input.size();
+    }
+    return (input.size() + numRequests - 1) / numRequests;
+  }
+
+  VectorPtr toResult(
+      const remote::RemoteFunctionResponse& response,
+      const TypePtr& outputType,
+      memory::MemoryPool& pool) const {
     auto outputRowVector = IOBufToRowVector(
-        remoteResponse.get_result().get_payload(),
+        getPagePayload(response.get_result(), sharedMemory_.get()),
         ROW({outputType}),
-        *context.pool(),
+        pool,
         serde_.get());
-    result = outputRowVector->childAt(0);
+    return outputRowVector->childAt(0);
+  }
+
+  [[noreturn]] void throwRemoteError(const std::string& message) const {
+    VELOX_FAIL(
+        "Error while executing remote function '{}' at '{}': {}",
+        functionName_,
+        location_.describe(),
+        message);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Mutable since waiting for asynchronous responses runs its loop.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const int64_t maxRequestBytes_;
+  const size_t maxInflightRequests_;
+  const int64_t sharedMemorySlotBytes_;
+  // Pages are exchanged through 'sharedMemory_' if set. It has one slot of
+  // 'sharedMemorySlotBytes_' per request in flight.
+  std::unique_ptr<SharedMemoryFile> sharedMemory_;
+  mutable std::vector<int32_t> freeSlots_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
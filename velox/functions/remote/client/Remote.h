@@ -30,6 +30,25 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Target size in bytes of the input of one request. Batches estimated to
+  /// be larger are split into row ranges that are sent as separate requests,
+  /// up to 'maxInflightRequests' at a time, so that the round trips overlap.
+  /// 0 sends each batch as one request.
+  int64_t maxRequestBytes{0};
+
+  /// Maximum number of requests of one batch in flight at the same time.
+  int32_t maxInflightRequests{8};
+
+  /// Directory, e.g. /dev/shm, in which to create a file to exchange the
+  /// pages with a server on the same host through shared memory. The socket
+  /// then only carries the location of the pages. Empty sends the pages over
+  /// the socket.
+  std::string sharedMemoryDirectory;
+
+  /// Bytes of shared memory per request in flight. A page that does not fit
+  /// is sent over the socket.
+  int64_t sharedMemorySlotBytes{8 << 20};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
@@ -62,6 +62,21 @@ class RemoteFunctionTest
                                .build()};
     registerRemoteFunction("remote_plus", plusSignatures, metadata);
 
+    // Splits batches into requests of about 1KB of input.
+    RemoteVectorFunctionMetadata pipelinedMetadata = metadata;
+    pipelinedMetadata.maxRequestBytes = 1024;
+    pipelinedMetadata.maxInflightRequests = 3;
+    registerRemoteFunction(
+        "remote_plus_pipelined", plusSignatures, pipelinedMetadata);
+
+    // Exchanges the pages through shared memory. The slots are too small for
+    // pages of more than about 100 rows, which then go over the socket.
+    RemoteVectorFunctionMetadata sharedMemoryMetadata = pipelinedMetadata;
+    sharedMemoryMetadata.sharedMemoryDirectory = "/tmp";
+    sharedMemoryMetadata.sharedMemorySlotBytes = 1024;
+    registerRemoteFunction(
+        "remote_plus_shared_memory", plusSignatures, sharedMemoryMetadata);
+
     RemoteVectorFunctionMetadata wrongMetadata = metadata;
     wrongMetadata.location = folly::SocketAddress(); // empty address.
     registerRemoteFunction("remote_wrong_port", plusSignatures, wrongMetadata);
@@ -84,6 +99,10 @@ class RemoteFunctionTest
     // needed for tests since the thrift service runs in the same process.
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
         {remotePrefix_ + ".remote_plus"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_pipelined"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_shared_memory"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {remotePrefix_ + ".remote_divide"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
@@ -140,6 +159,31 @@ TEST_P(RemoteFunctionTest, simple) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, pipelined) {
+  // 10'000 bigints are split into about 80 requests.
+  auto inputVector = makeFlatVector<int64_t>(
+      10'000, [](auto row) { return row; }, nullEvery(7));
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_pipelined(c0, c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>(
+      10'000, [](auto row) { return row * 2; }, nullEvery(7));
+  assertEqualVectors(expected, results);
+}
+
+TEST_P(RemoteFunctionTest, sharedMemory) {
+  for (auto size : {5, 10'000}) {
+    auto inputVector = makeFlatVector<int64_t>(
+        size, [](auto row) { return row; }, nullEvery(5));
+    auto results = evaluate<SimpleVector<int64_t>>(
+        "remote_plus_shared_memory(c0, c0)", makeRowVector({inputVector}));
+
+    auto expected = makeFlatVector<int64_t>(
+        size, [](auto row) { return row * 2; }, nullEvery(5));
+    assertEqualVectors(expected, results);
+  }
+}
+
 TEST_P(RemoteFunctionTest, string) {
   auto inputVector =
       makeFlatVector<StringView>({"hello", "my", "remote", "world"});
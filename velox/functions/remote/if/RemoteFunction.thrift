@@ -41,6 +41,23 @@ struct RemoteFunctionHandle {
   3: list<string> argumentTypes;
 }
 
+/// A range of a memory mapped file shared by a client and a server on the
+/// same host.
+struct SharedMemoryRange {
+  /// The path of the file.
+  1: string path;
+
+  /// The position of the range in the file.
+  2: i64 offset;
+
+  /// The number of bytes of the page.
+  3: i64 size;
+
+  /// The number of bytes at 'offset' that the server may overwrite with the
+  /// result page.
+  4: i64 capacity;
+}
+
 /// A page of data to be sent to, or got as a return from a remote function
 /// execution.
 struct RemoteFunctionPage {
@@ -52,6 +69,9 @@ struct RemoteFunctionPage {
 
   /// The number of logical rows in this page.
   3: i64 rowCount;
+
+  /// If set, the data is in shared memory instead of 'payload'.
+  4: optional SharedMemoryRange sharedMemory;
 }
 
 /// The parameters passed to the remote thrift call.
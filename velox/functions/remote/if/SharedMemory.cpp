@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/remote/if/SharedMemory.h"
+
+#include <fcntl.h>
+#include <folly/String.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+char* mapFile(int32_t fd, int64_t size, const std::string& path) {
+  auto* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  VELOX_CHECK(
+      data != MAP_FAILED,
+      "Cannot map shared memory file {}: {}",
+      path,
+      folly::errnoStr(errno));
+  return static_cast<char*>(data);
+}
+
+} // namespace
+
+// static
+std::unique_ptr<SharedMemoryFile> SharedMemoryFile::create(
+    const std::string& path,
+    int64_t size) {
+  VELOX_CHECK_GT(size, 0);
+  const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  VELOX_CHECK_GE(
+      fd,
+      0,
+      "Cannot create shared memory file {}: {}",
+      path,
+      folly::errnoStr(errno));
+  if (::ftruncate(fd, size) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    ::unlink(path.c_str());
+    VELOX_FAIL(
+        "Cannot size shared memory file {}: {}", path, folly::errnoStr(error));
+  }
+  char* data;
+  try {
+    data = mapFile(fd, size, path);
+  } catch (const std::exception&) {
+    ::unlink(path.c_str());
+    throw;
+  }
+  return std::unique_ptr<SharedMemoryFile>(
+      new SharedMemoryFile(path, data, size, true));
+}
+
+// static
+std::unique_ptr<SharedMemoryFile> SharedMemoryFile::open(
+    const std::string& path) {
+  const auto fd = ::open(path.c_str(), O_RDWR);
+  VELOX_CHECK_GE(
+      fd,
+      0,
+      "Cannot open shared memory file {}: {}",
+      path,
+      folly::errnoStr(errno));
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    VELOX_FAIL("Cannot map empty or unreadable shared memory file {}", path);
+  }
+  auto* data = mapFile(fd, info.st_size, path);
+  return std::unique_ptr<SharedMemoryFile>(
+      new SharedMemoryFile(path, data, info.st_size, false));
+}
+
+SharedMemoryFile::~SharedMemoryFile() {
+  ::munmap(data_, size_);
+  if (owner_) {
+    ::unlink(path_.c_str());
+  }
+}
+
+void setPagePayload(
+    folly::IOBuf payload,
+    SharedMemoryFile* file,
+    int64_t offset,
+    int64_t capacity,
+    remote::RemoteFunctionPage& page) {
+  const int64_t size = payload.computeChainDataLength();
+  if (file == nullptr || size > capacity) {
+    page.payload_ref() = std::move(payload);
+    page.sharedMemory_ref().reset();
+    return;
+  }
+  VELOX_CHECK_LE(offset + capacity, file->size());
+  auto* target = file->data() + offset;
+  for (const auto& range : payload) {
+    ::memcpy(target, range.data(), range.size());
+    target += range.size();
+  }
+  remote::SharedMemoryRange sharedMemory;
+  sharedMemory.path_ref() = file->path();
+  sharedMemory.offset_ref() = offset;
+  sharedMemory.size_ref() = size;
+  sharedMemory.capacity_ref() = capacity;
+  page.payload_ref() = folly::IOBuf();
+  page.sharedMemory_ref() = std::move(sharedMemory);
+}
+
+folly::IOBuf getPagePayload(
+    const remote::RemoteFunctionPage& page,
+    const SharedMemoryFile* file) {
+  if (!page.sharedMemory_ref().has_value()) {
+    return page.get_payload();
+  }
+  const auto& sharedMemory = page.sharedMemory_ref().value();
+  VELOX_CHECK_NOT_NULL(file);
+  VELOX_CHECK_EQ(sharedMemory.get_path(), file->path());
+  VELOX_CHECK(
+      sharedMemory.get_offset() >= 0 && sharedMemory.get_size() >= 0 &&
+          sharedMemory.get_offset() + sharedMemory.get_size() <= file->size(),
+      "Shared memory range out of bounds of {}",
+      file->path());
+  return folly::IOBuf(
+      folly::IOBuf::WRAP_BUFFER,
+      file->data() + sharedMemory.get_offset(),
+      sharedMemory.get_size());
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/io/IOBuf.h>
+#include <memory>
+#include <string>
+
+#include "velox/functions/remote/if/gen-cpp2/RemoteFunction_types.h"
+
+namespace facebook::velox::functions {
+
+/// A file mapped into memory, through which a remote function client and a
+/// server on the same host exchange pages without sending them over the
+/// socket. The client creates the file, e.g. under /dev/shm, and divides it
+/// into one slot per request in flight. A request names its slot in
+/// RemoteFunctionPage::sharedMemory and the server writes the result page
+/// into the same slot.
+class SharedMemoryFile {
+ public:
+  /// Creates the file 'path' of 'size' bytes and maps it. The file is removed
+  /// when the returned object is destroyed.
+  static std::unique_ptr<SharedMemoryFile> create(
+      const std::string& path,
+      int64_t size);
+
+  /// Maps the existing file 'path'.
+  static std::unique_ptr<SharedMemoryFile> open(const std::string& path);
+
+  ~SharedMemoryFile();
+
+  const std::string& path() const {
+    return path_;
+  }
+
+  char* data() const {
+    return data_;
+  }
+
+  int64_t size() const {
+    return size_;
+  }
+
+ private:
+  SharedMemoryFile(std::string path, char* data, int64_t size, bool owner)
+      : path_(std::move(path)), data_(data), size_(size), owner_(owner) {}
+
+  const std::string path_;
+  char* const data_;
+  const int64_t size_;
+  // True if the file is removed on destruction.
+  const bool owner_;
+};
+
+/// Sets the payload of 'page' to 'payload'. If 'file' is not nullptr and the
+/// payload fits in 'capacity' bytes, copies it to 'offset' of 'file' instead
+/// and refers to it from 'page'.
+void setPagePayload(
+    folly::IOBuf payload,
+    SharedMemoryFile* file,
+    int64_t offset,
+    int64_t capacity,
+    remote::RemoteFunctionPage& page);
+
+/// Returns the payload of 'page'. A payload in shared memory is wrapped
+/// without copying, 'file' must then be the file named by the page. The
+/// result is only valid until the range is overwritten.
+folly::IOBuf getPagePayload(
+    const remote::RemoteFunctionPage& page,
+    const SharedMemoryFile* file);
+
+} // namespace facebook::velox::functions
@@ -15,6 +15,7 @@
  */
 
 #include "velox/functions/remote/server/RemoteFunctionService.h"
+#include <unistd.h>
 #include "velox/expression/Expr.h"
 #include "velox/functions/remote/if/GetSerde.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
@@ -23,6 +24,10 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Number of mapped shared memory files above which the mappings of removed
+// files are dropped.
+constexpr size_t kMaxSharedMemoryFiles = 64;
+
 std::string getFunctionName(
     const std::string& prefix,
     const std::string& functionName) {
@@ -66,6 +71,29 @@ std::vector<core::TypedExprPtr> getExpressions(
       returnType, std::move(inputs), functionName)};
 }
 
+std::shared_ptr<SharedMemoryFile>
+RemoteFunctionServiceHandler::sharedMemoryFile(const std::string& path) {
+  std::lock_guard<std::mutex> l(sharedMemoryMutex_);
+  auto it = sharedMemoryFiles_.find(path);
+  if (it != sharedMemoryFiles_.end()) {
+    return it->second;
+  }
+  if (sharedMemoryFiles_.size() >= kMaxSharedMemoryFiles) {
+    // A client removes its file when it is done with it.
+    for (auto entry = sharedMemoryFiles_.begin();
+         entry != sharedMemoryFiles_.end();) {
+      if (::access(entry->first.c_str(), F_OK) != 0) {
+        entry = sharedMemoryFiles_.erase(entry);
+      } else {
+        ++entry;
+      }
+    }
+  }
+  std::shared_ptr<SharedMemoryFile> file = SharedMemoryFile::open(path);
+  sharedMemoryFiles_[path] = file;
+  return file;
+}
+
 void RemoteFunctionServiceHandler::invokeFunction(
     remote::RemoteFunctionResponse& response,
     std::unique_ptr<remote::RemoteFunctionRequest> request) {
@@ -86,8 +114,23 @@ void RemoteFunctionServiceHandler::invokeFunction(
   auto serdeFormat = inputs.get_pageFormat();
   auto serde = getSerde(serdeFormat);
 
-  auto inputVector =
-      IOBufToRowVector(inputs.get_payload(), inputType, *pool_, serde.get());
+  // Reads the input from and writes the result to the shared memory of the
+  // client if the request comes with it.
+  std::shared_ptr<SharedMemoryFile> sharedMemory;
+  int64_t sharedMemoryOffset = 0;
+  int64_t sharedMemoryCapacity = 0;
+  if (inputs.sharedMemory_ref().has_value()) {
+    const auto& range = inputs.sharedMemory_ref().value();
+    sharedMemory = sharedMemoryFile(range.get_path());
+    sharedMemoryOffset = range.get_offset();
+    sharedMemoryCapacity = range.get_capacity();
+  }
+
+  auto inputVector = IOBufToRowVector(
+      getPagePayload(inputs, sharedMemory.get()),
+      inputType,
+      *pool_,
+      serde.get());
 
   // Execute the expression.
   const vector_size_t numRows = inputVector->size();
@@ -114,8 +157,12 @@ void RemoteFunctionServiceHandler::invokeFunction(
   auto result = response.result_ref();
   result->rowCount_ref() = outputRowVector->size();
   result->pageFormat_ref() = serdeFormat;
-  result->payload_ref() =
-      rowVectorToIOBuf(outputRowVector, rows.end(), *pool_, serde.get());
+  setPagePayload(
+      rowVectorToIOBuf(outputRowVector, rows.end(), *pool_, serde.get()),
+      sharedMemory.get(),
+      sharedMemoryOffset,
+      sharedMemoryCapacity,
+      *result);
 }
 
 } // namespace facebook::velox::functions
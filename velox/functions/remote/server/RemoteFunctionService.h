@@ -17,7 +17,9 @@
 #pragma once
 
 #include <thrift/lib/cpp2/server/ThriftServer.h>
+#include <mutex>
 #include "velox/common/memory/Memory.h"
+#include "velox/functions/remote/if/SharedMemory.h"
 #include "velox/functions/remote/if/gen-cpp2/RemoteFunctionService.h"
 
 namespace facebook::velox::functions {
@@ -35,9 +37,17 @@ class RemoteFunctionServiceHandler
       std::unique_ptr<remote::RemoteFunctionRequest> request) override;
 
  private:
+  // Returns the mapping of the shared memory file 'path' of a client.
+  std::shared_ptr<SharedMemoryFile> sharedMemoryFile(const std::string& path);
+
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
   const std::string functionPrefix_;
+
+  std::mutex sharedMemoryMutex_;
+  // Mappings of the shared memory files of the clients, by path.
+  std::unordered_map<std::string, std::shared_ptr<SharedMemoryFile>>
+      sharedMemoryFiles_;
 };
 
 } // namespace facebook::velox::functions
@@ -15,9 +15,12 @@
  */
 #include "velox/functions/sparksql/Hash.h"
 
+#include <type_traits>
+
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/vector/FlatVector.h"
 
@@ -26,63 +29,6 @@ namespace {
 
 const int32_t kDefaultSeed = 42;
 
-// ReturnType can be either int32_t or int64_t
-// HashClass contains the function like hashInt32
-template <typename ReturnType, typename HashClass, typename SeedType>
-void applyWithType(
-    const SelectivityVector& rows,
-    std::vector<VectorPtr>& args, // Not using const ref so we can reuse args
-    std::optional<SeedType> seed,
-    exec::EvalCtx& context,
-    VectorPtr& resultRef) {
-  HashClass hash;
-  size_t hashIdx = seed ? 1 : 0;
-  SeedType hashSeed = seed ? *seed : kDefaultSeed;
-
-  auto& result = *resultRef->as<FlatVector<ReturnType>>();
-  rows.applyToSelected([&](int row) { result.set(row, hashSeed); });
-
-  exec::LocalSelectivityVector selectedMinusNulls(context);
-
-  exec::DecodedArgs decodedArgs(rows, args, context);
-  for (auto i = hashIdx; i < args.size(); i++) {
-    auto decoded = decodedArgs.at(i);
-    const SelectivityVector* selected = &rows;
-    if (args[i]->mayHaveNulls()) {
-      *selectedMinusNulls.get(rows.end()) = rows;
-      selectedMinusNulls->deselectNulls(
-          decoded->nulls(&rows), rows.begin(), rows.end());
-      selected = selectedMinusNulls.get();
-    }
-    switch (args[i]->type()->kind()) {
-// Derived from InterpretedHashFunction.hash:
-// https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
-#define CASE(typeEnum, hashFn, inputType)                                      \
-  case TypeKind::typeEnum:                                                     \
-    selected->applyToSelected([&](int row) {                                   \
-      result.set(                                                              \
-          row, hashFn(decoded->valueAt<inputType>(row), result.valueAt(row))); \
-    });                                                                        \
-    break;
-      CASE(BOOLEAN, hash.hashInt32, bool);
-      CASE(TINYINT, hash.hashInt32, int8_t);
-      CASE(SMALLINT, hash.hashInt32, int16_t);
-      CASE(INTEGER, hash.hashInt32, int32_t);
-      CASE(BIGINT, hash.hashInt64, int64_t);
-      CASE(VARCHAR, hash.hashBytes, StringView);
-      CASE(VARBINARY, hash.hashBytes, StringView);
-      CASE(REAL, hash.hashFloat, float);
-      CASE(DOUBLE, hash.hashDouble, double);
-      CASE(HUGEINT, hash.hashLongDecimal, int128_t);
-      CASE(TIMESTAMP, hash.hashTimestamp, Timestamp);
-#undef CASE
-      default:
-        VELOX_NYI(
-            "Unsupported type for HASH(): {}", args[i]->type()->toString());
-    }
-  }
-}
-
 // Derived from src/main/java/org/apache/spark/unsafe/hash/Murmur3_x86_32.java.
 //
 // Spark's Murmur3 seems slightly different from the original from Austin
@@ -93,12 +39,22 @@ void applyWithType(
 // Signed integer types have been remapped to unsigned types (as in the
 // original) to avoid undefined signed integer overflow and sign extension.
 
+//
+// The mixing steps are templates so that the same code hashes one value or
+// an xsimd::batch of values.
 class Murmur3Hash final {
  public:
+  using HashType = uint32_t;
+
   uint32_t hashInt32(int32_t input, uint32_t seed) {
-    uint32_t k1 = mixK1(input);
-    uint32_t h1 = mixH1(seed, k1);
-    return fmix(h1, 4);
+    return hashInt32s<uint32_t>(input, seed);
+  }
+
+  // Hashes each lane of 'input' with the seed in the same lane of 'seed'. T
+  // is uint32_t or xsimd::batch<uint32_t>.
+  template <typename T>
+  static T hashInt32s(T input, T seed) {
+    return fmix(mixH1(seed, mixK1(input)), 4);
   }
 
   uint32_t hashInt64(uint64_t input, uint32_t seed) {
@@ -136,7 +92,7 @@ class Murmur3Hash final {
       h1 = mixH1(h1, mixK1(*reinterpret_cast<const uint32_t*>(i)));
     }
     for (; i != end; ++i) {
-      h1 = mixH1(h1, mixK1(*i));
+      h1 = mixH1<uint32_t>(h1, mixK1<uint32_t>(*i));
     }
     return fmix(h1, input.size());
   }
@@ -152,52 +108,45 @@ class Murmur3Hash final {
   }
 
  private:
-  uint32_t mixK1(uint32_t k1) {
-    k1 *= 0xcc9e2d51;
-    k1 = bits::rotateLeft(k1, 15);
-    k1 *= 0x1b873593;
+  template <typename T>
+  static T rotateLeft(T x, int32_t n) {
+    return (x << n) | (x >> (32 - n));
+  }
+
+  template <typename T>
+  static T mixK1(T k1) {
+    k1 *= T(0xcc9e2d51);
+    k1 = rotateLeft(k1, 15);
+    k1 *= T(0x1b873593);
     return k1;
   }
 
-  uint32_t mixH1(uint32_t h1, uint32_t k1) {
+  template <typename T>
+  static T mixH1(T h1, T k1) {
     h1 ^= k1;
-    h1 = bits::rotateLeft(h1, 13);
-    h1 = h1 * 5 + 0xe6546b64;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * T(5) + T(0xe6546b64);
     return h1;
   }
 
   // Finalization mix - force all bits of a hash block to avalanche
-  uint32_t fmix(uint32_t h1, uint32_t length) {
-    h1 ^= length;
+  template <typename T>
+  static T fmix(T h1, uint32_t length) {
+    h1 ^= T(length);
     h1 ^= h1 >> 16;
-    h1 *= 0x85ebca6b;
+    h1 *= T(0x85ebca6b);
     h1 ^= h1 >> 13;
-    h1 *= 0xc2b2ae35;
+    h1 *= T(0xc2b2ae35);
     h1 ^= h1 >> 16;
     return h1;
   }
 };
 
-class Murmur3HashFunction final : public exec::VectorFunction {
+class XxHash64 final {
  public:
-  Murmur3HashFunction() = default;
-  explicit Murmur3HashFunction(int32_t seed) : seed_(seed) {}
-
-  void apply(
-      const SelectivityVector& rows,
-      std::vector<VectorPtr>& args, // Not using const ref so we can reuse args
-      const TypePtr& /* outputType */,
-      exec::EvalCtx& context,
-      VectorPtr& resultRef) const final {
-    context.ensureWritable(rows, INTEGER(), resultRef);
-    applyWithType<int32_t, Murmur3Hash>(rows, args, seed_, context, resultRef);
-  }
+  using HashType = uint64_t;
 
  private:
-  const std::optional<int32_t> seed_;
-};
-
-class XxHash64 final {
   const uint64_t PRIME64_1 = 0x9E3779B185EBCA87L;
   const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FL;
   const uint64_t PRIME64_3 = 0x165667B19E3779F9L;
@@ -341,6 +290,222 @@ class XxHash64 final {
   }
 };
 
+// Hashes 'input' with 'seed' using the function of 'hash' for T.
+template <typename HashClass, typename T>
+typename HashClass::HashType
+hashValue(HashClass& hash, T input, typename HashClass::HashType seed) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return hash.hashInt64(input, seed);
+  } else if constexpr (std::is_same_v<T, float>) {
+    return hash.hashFloat(input, seed);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return hash.hashDouble(input, seed);
+  } else if constexpr (std::is_same_v<T, StringView>) {
+    return hash.hashBytes(input, seed);
+  } else if constexpr (std::is_same_v<T, int128_t>) {
+    return hash.hashLongDecimal(input, seed);
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    return hash.hashTimestamp(input, seed);
+  } else {
+    // Boolean and integers up to 32 bits.
+    return hash.hashInt32(input, seed);
+  }
+}
+
+// Hashes 'size' consecutive 'values' into 'hashes', which hold the seeds.
+// Specialized below for the types that have a SIMD kernel.
+template <typename HashClass, typename T>
+void hashRange(
+    HashClass& hash,
+    const T* values,
+    int32_t size,
+    typename HashClass::HashType* hashes) {
+  for (auto i = 0; i < size; ++i) {
+    hashes[i] = hashValue(hash, values[i], hashes[i]);
+  }
+}
+
+template <>
+void hashRange<Murmur3Hash, int32_t>(
+    Murmur3Hash& hash,
+    const int32_t* values,
+    int32_t size,
+    uint32_t* hashes) {
+  using Batch = xsimd::batch<uint32_t>;
+  int32_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    const auto input =
+        Batch::load_unaligned(reinterpret_cast<const uint32_t*>(values + i));
+    Murmur3Hash::hashInt32s(input, Batch::load_unaligned(hashes + i))
+        .store_unaligned(hashes + i);
+  }
+  for (; i < size; ++i) {
+    hashes[i] = hash.hashInt32(values[i], hashes[i]);
+  }
+}
+
+template <>
+void hashRange<Murmur3Hash, float>(
+    Murmur3Hash& hash,
+    const float* values,
+    int32_t size,
+    uint32_t* hashes) {
+  using Batch = xsimd::batch<uint32_t>;
+  // -0f hashes like +0f.
+  const Batch negativeZero(0x80000000);
+  int32_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    auto input =
+        Batch::load_unaligned(reinterpret_cast<const uint32_t*>(values + i));
+    input = xsimd::select(input == negativeZero, Batch(0), input);
+    Murmur3Hash::hashInt32s(input, Batch::load_unaligned(hashes + i))
+        .store_unaligned(hashes + i);
+  }
+  for (; i < size; ++i) {
+    hashes[i] = hash.hashFloat(values[i], hashes[i]);
+  }
+}
+
+// Hashes the values of 'decoded' in 'rows' into 'hashes', using the hash of
+// each row so far as the seed. 'rows' must not contain null rows.
+template <typename HashClass, typename T>
+void hashValues(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    typename HashClass::HashType* hashes) {
+  HashClass hash;
+  if constexpr (std::is_same_v<T, bool>) {
+    // Flat booleans are bits, not addressable values.
+    rows.applyToSelected([&](auto row) {
+      hashes[row] = hashValue(hash, decoded.valueAt<bool>(row), hashes[row]);
+    });
+  } else if (decoded.isConstantMapping()) {
+    const auto value = decoded.valueAt<T>(rows.begin());
+    rows.applyToSelected(
+        [&](auto row) { hashes[row] = hashValue(hash, value, hashes[row]); });
+  } else if (decoded.isIdentityMapping()) {
+    const auto* values = decoded.data<T>();
+    if (rows.isAllSelected()) {
+      hashRange(
+          hash,
+          values + rows.begin(),
+          rows.end() - rows.begin(),
+          hashes + rows.begin());
+    } else {
+      rows.applyToSelected([&](auto row) {
+        hashes[row] = hashValue(hash, values[row], hashes[row]);
+      });
+    }
+  } else {
+    const auto* values = decoded.data<T>();
+    const auto* indices = decoded.indices();
+    rows.applyToSelected([&](auto row) {
+      hashes[row] = hashValue(hash, values[indices[row]], hashes[row]);
+    });
+  }
+}
+
+// Hashes one column into 'hashes' as described at hashValues(). Derived
+// from InterpretedHashFunction.hash:
+// https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
+template <typename HashClass>
+void hashColumn(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    typename HashClass::HashType* hashes) {
+  switch (type->kind()) {
+#define CASE(typeEnum, inputType)                            \
+  case TypeKind::typeEnum:                                   \
+    hashValues<HashClass, inputType>(rows, decoded, hashes); \
+    break;
+    CASE(BOOLEAN, bool);
+    CASE(TINYINT, int8_t);
+    CASE(SMALLINT, int16_t);
+    CASE(INTEGER, int32_t);
+    CASE(BIGINT, int64_t);
+    CASE(VARCHAR, StringView);
+    CASE(VARBINARY, StringView);
+    CASE(REAL, float);
+    CASE(DOUBLE, double);
+    CASE(HUGEINT, int128_t);
+    CASE(TIMESTAMP, Timestamp);
+#undef CASE
+    default:
+      VELOX_NYI("Unsupported type for HASH(): {}", type->toString());
+  }
+}
+
+// Hashes the non-null rows of 'decoded' in 'rows' into 'hashes'. Uses
+// 'scratch' for the rows without nulls.
+template <typename HashClass>
+void hashNonNullRows(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    SelectivityVector& scratch,
+    typename HashClass::HashType* hashes) {
+  const SelectivityVector* selected = &rows;
+  if (decoded.mayHaveNulls()) {
+    scratch = rows;
+    scratch.deselectNulls(decoded.nulls(&rows), rows.begin(), rows.end());
+    selected = &scratch;
+  }
+  hashColumn<HashClass>(*selected, decoded, type, hashes);
+}
+
+// ReturnType can be either int32_t or int64_t. Hashes the arguments one
+// column at a time, chaining the hash of each row as the seed of the next
+// column.
+template <typename ReturnType, typename HashClass, typename SeedType>
+void applyWithType(
+    const SelectivityVector& rows,
+    std::vector<VectorPtr>& args, // Not using const ref so we can reuse args
+    std::optional<SeedType> seed,
+    exec::EvalCtx& context,
+    VectorPtr& resultRef) {
+  using HashType = typename HashClass::HashType;
+  static_assert(sizeof(HashType) == sizeof(ReturnType));
+  size_t hashIdx = seed ? 1 : 0;
+  SeedType hashSeed = seed ? *seed : kDefaultSeed;
+
+  auto& result = *resultRef->as<FlatVector<ReturnType>>();
+  result.clearNulls(rows);
+  auto* hashes = reinterpret_cast<HashType*>(result.mutableRawValues());
+  rows.applyToSelected([&](int row) { hashes[row] = hashSeed; });
+
+  exec::LocalSelectivityVector selectedMinusNulls(context, rows.end());
+
+  exec::DecodedArgs decodedArgs(rows, args, context);
+  for (auto i = hashIdx; i < args.size(); i++) {
+    hashNonNullRows<HashClass>(
+        rows,
+        *decodedArgs.at(i),
+        args[i]->type(),
+        *selectedMinusNulls.get(),
+        hashes);
+  }
+}
+
+class Murmur3HashFunction final : public exec::VectorFunction {
+ public:
+  Murmur3HashFunction() = default;
+  explicit Murmur3HashFunction(int32_t seed) : seed_(seed) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args, // Not using const ref so we can reuse args
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    context.ensureWritable(rows, INTEGER(), resultRef);
+    applyWithType<int32_t, Murmur3Hash>(rows, args, seed_, context, resultRef);
+  }
+
+ private:
+  const std::optional<int32_t> seed_;
+};
+
 class XxHash64Function final : public exec::VectorFunction {
  public:
   XxHash64Function() = default;
@@ -463,6 +628,26 @@ std::shared_ptr<exec::VectorFunction> makeXxHash64WithSeed(
   return std::make_shared<XxHash64Function>(seed);
 }
 
+void murmur3HashColumn(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    int32_t* hashes) {
+  SelectivityVector scratch;
+  hashNonNullRows<Murmur3Hash>(
+      rows, decoded, type, scratch, reinterpret_cast<uint32_t*>(hashes));
+}
+
+void xxhash64Column(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    int64_t* hashes) {
+  SelectivityVector scratch;
+  hashNonNullRows<XxHash64>(
+      rows, decoded, type, scratch, reinterpret_cast<uint64_t*>(hashes));
+}
+
 exec::VectorFunctionMetadata hashMetadata() {
   return exec::VectorFunctionMetadataBuilder()
       .defaultNullBehavior(false)
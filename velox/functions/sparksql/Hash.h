@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::functions::sparksql {
 
@@ -78,4 +79,23 @@ std::shared_ptr<exec::VectorFunction> makeXxHash64WithSeed(
 
 exec::VectorFunctionMetadata hashMetadata();
 
+/// Columnar kernels behind hash() and xxhash64() for callers that hash whole
+/// batches outside of expression evaluation, e.g. shuffle partitioning and
+/// bucketing. Hashes the values of 'decoded' of type 'type' in 'rows' into
+/// 'hashes', using the current value of each row as the seed. Null rows keep
+/// their seed. Initializing 'hashes' to the seed and hashing the columns in
+/// order gives the results of hash(c0, c1, ...) and xxhash64(c0, c1, ...).
+/// 'hashes' is indexed by row. Supports the same types as the functions.
+void murmur3HashColumn(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    int32_t* hashes);
+
+void xxhash64Column(
+    const SelectivityVector& rows,
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    int64_t* hashes);
+
 } // namespace facebook::velox::functions::sparksql
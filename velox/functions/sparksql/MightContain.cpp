@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class MightContainFunction final : public exec::VectorFunction {
+ public:
+  explicit MightContainFunction(std::optional<StringView> serialized) {
+    if (serialized.has_value()) {
+      bloomFilter_.merge(serialized->data());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& result) const final {
+    context.ensureWritable(rows, BOOLEAN(), result);
+    auto* flatResult = result->asFlatVector<bool>();
+    flatResult->clearNulls(rows);
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected([&](auto row) { flatResult->set(row, false); });
+      return;
+    }
+
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    const auto* values = decodedArgs.at(1);
+    auto hashesBuffer = AlignedBuffer::allocate<uint64_t>(
+        rows.end(), context.pool());
+    auto* hashes = hashesBuffer->asMutable<uint64_t>();
+    rows.applyToSelected([&](auto row) {
+      hashes[row] = folly::hasher<int64_t>()(values->valueAt<int64_t>(row));
+    });
+
+    auto* rawResult = flatResult->mutableRawValues<uint64_t>();
+    if (rows.isAllSelected() && rows.begin() == 0) {
+      bloomFilter_.mayContain(hashes, rows.end(), rawResult);
+      return;
+    }
+    // Probes the hashes of the selected rows packed together and scatters
+    // the results.
+    vector_size_t numHashes = 0;
+    rows.applyToSelected([&](auto row) { hashes[numHashes++] = hashes[row]; });
+    auto hits = AlignedBuffer::allocate<bool>(numHashes, context.pool());
+    auto* rawHits = hits->asMutable<uint64_t>();
+    bloomFilter_.mayContain(hashes, numHashes, rawHits);
+    vector_size_t i = 0;
+    rows.applyToSelected([&](auto row) {
+      bits::setBit(rawResult, row, bits::isBitSet(rawHits, i++));
+    });
+  }
+
+ private:
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  const auto& constantFilter = inputArgs[0].constantValue;
+  std::optional<StringView> serialized;
+  if (constantFilter != nullptr && !constantFilter->isNullAt(0)) {
+    serialized = constantFilter->as<ConstantVector<StringView>>()->valueAt(0);
+  }
+  return std::make_shared<MightContainFunction>(serialized);
+}
+
+} // namespace facebook::velox::functions::sparksql
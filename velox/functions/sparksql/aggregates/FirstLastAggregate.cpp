@@ -433,6 +433,7 @@ class LastAggregate : public FirstLastAggregateBase<numeric, TData> {
 template <template <bool B1, typename T, bool B2> class TClass, bool ignoreNull>
 AggregateRegistrationResult registerFirstLast(
     const std::string& name,
+    const AggregateFunctionMetadata& metadata,
     bool withCompanionFunctions,
     bool overwrite) {
   std::vector<std::shared_ptr<AggregateFunctionSignature>> signatures = {
@@ -505,6 +506,7 @@ AggregateRegistrationResult registerFirstLast(
                 inputType->toString());
         }
       },
+      metadata,
       withCompanionFunctions,
       overwrite);
 }
@@ -513,14 +515,19 @@ void registerFirstLastAggregates(
     const std::string& prefix,
     bool withCompanionFunctions,
     bool overwrite) {
+  // first() takes the first input even if null, so it only needs the first of
+  // the inputs sorted by ORDER BY keys.
   registerFirstLast<FirstAggregate, false>(
-      prefix + "first", withCompanionFunctions, overwrite);
+      prefix + "first",
+      {.orderSensitive = true, .sortedInputLimit = 1},
+      withCompanionFunctions,
+      overwrite);
   registerFirstLast<FirstAggregate, true>(
-      prefix + "first_ignore_null", withCompanionFunctions, overwrite);
+      prefix + "first_ignore_null", {}, withCompanionFunctions, overwrite);
   registerFirstLast<LastAggregate, false>(
-      prefix + "last", withCompanionFunctions, overwrite);
+      prefix + "last", {}, withCompanionFunctions, overwrite);
   registerFirstLast<LastAggregate, true>(
-      prefix + "last_ignore_null", withCompanionFunctions, overwrite);
+      prefix + "last_ignore_null", {}, withCompanionFunctions, overwrite);
 }
 
 } // namespace facebook::velox::functions::aggregate::sparksql
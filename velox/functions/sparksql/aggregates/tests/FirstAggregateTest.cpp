@@ -544,5 +544,41 @@ TEST_F(FirstAggregateTest, spillingAndSorting) {
   exec::test::assertEqualResults({expected}, {results});
 }
 
+TEST_F(FirstAggregateTest, sortedManyRowsPerGroup) {
+  // Only the first row of each group in sort order is kept while the input is
+  // added. Makes each group see many rows in a random order, with ties and
+  // nulls in the sorting key.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row % 11; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(
+          10'000,
+          [](auto row) { return (row * 7'919) % 1'013; },
+          nullEvery(17)),
+  });
+
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 4))
+                  .singleAggregation(
+                      {"c0"}, {"spark_first(c1 ORDER BY c2 DESC, c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT c0, first(c1 ORDER BY c2 DESC NULLS LAST, c1) "
+          "FROM tmp GROUP BY c0");
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  exec::TestScopedSpillInjection scopedSpillInjection(100);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kSpillEnabled, "true")
+      .config(core::QueryConfig::kAggregationSpillEnabled, "true")
+      .spillDirectory(spillDirectory->getPath())
+      .assertResults(
+          "SELECT c0, first(c1 ORDER BY c2 DESC NULLS LAST, c1) "
+          "FROM tmp GROUP BY c0");
+}
+
 } // namespace
 } // namespace facebook::velox::functions::aggregate::sparksql::test
@@ -84,6 +84,32 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, batch) {
+  constexpr int32_t kSize = 1'000;
+  auto serialized = getSerializedBloomFilter(kSize);
+  BloomFilter bloomFilter;
+  bloomFilter.merge(serialized.data());
+  auto hashedMayContain = [&](int64_t value) {
+    return bloomFilter.mayContain(folly::hasher<int64_t>()(value));
+  };
+
+  // Values in and out of the filter, with and without nulls.
+  auto values = makeFlatVector<int64_t>(
+      2 * kSize, [](auto row) { return row % 2 == 0 ? row / 2 : row * 7919; });
+  auto expected = makeFlatVector<bool>(2 * kSize, [&](auto row) {
+    return hashedMayContain(values->valueAt(row));
+  });
+  testMightContain(serialized, values, expected);
+
+  values = makeFlatVector<int64_t>(
+      2 * kSize, [](auto row) { return row; }, nullEvery(3));
+  expected = makeFlatVector<bool>(
+      2 * kSize,
+      [&](auto row) { return hashedMayContain(row); },
+      nullEvery(3));
+  testMightContain(serialized, values, expected);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/functions/sparksql/Hash.h"
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 
 #include <stdint.h>
@@ -177,5 +178,47 @@ TEST_F(XxHash64Test, hashSeedVarcharArgs) {
   EXPECT_EQ(xxhash64WithSeed(0L, "", "hello"), 1992633642622160295);
 }
 
+TEST_F(XxHash64Test, columns) {
+  const vector_size_t size = 1'003;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row * 7919 - 5000; }),
+      makeFlatVector<float>(
+          size,
+          [](auto row) { return row % 5 == 0 ? -0.0f : row * 0.5f; },
+          nullEvery(11)),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 104729; }, nullEvery(13)),
+      makeFlatVector<std::string>(
+          size, [](auto row) { return std::string(row % 40, 'a' + row % 26); }),
+      makeConstant<int32_t>(17, size),
+  });
+  const std::string expression = "xxhash64(c0, c1, c2, c3, c4)";
+  auto result = evaluate(expression, data);
+
+  // The flat columns are hashed a range at a time, the dictionaries and
+  // single rows a row at a time.
+  auto identity = makeIndices(size, [](auto row) { return row; });
+  std::vector<VectorPtr> wrapped;
+  for (const auto& child : data->children()) {
+    wrapped.push_back(wrapInDictionary(identity, child));
+  }
+  assertEqualVectors(result, evaluate(expression, makeRowVector(wrapped)));
+  for (auto row = 0; row < size; row += 97) {
+    auto single = std::dynamic_pointer_cast<RowVector>(data->slice(row, 1));
+    EXPECT_EQ(
+        result->as<SimpleVector<int64_t>>()->valueAt(row),
+        evaluate(expression, single)->as<SimpleVector<int64_t>>()->valueAt(0));
+  }
+
+  // The column kernel gives the same hashes outside of evaluation.
+  SelectivityVector rows(size);
+  std::vector<int64_t> hashes(size, 42);
+  for (const auto& child : data->children()) {
+    DecodedVector decoded(*child, rows);
+    xxhash64Column(rows, decoded, child->type(), hashes.data());
+  }
+  assertEqualVectors(result, makeFlatVector<int64_t>(hashes));
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
@@ -477,6 +477,137 @@ int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
   };
 }
 
+void CompactRow::childIndices(
+    folly::Range<const vector_size_t*> rows,
+    std::vector<vector_size_t>& indices) const {
+  indices.resize(rows.size());
+  if (decoded_.isIdentityMapping()) {
+    std::copy(rows.begin(), rows.end(), indices.begin());
+    return;
+  }
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+}
+
+void CompactRow::serializedRowSizes(
+    folly::Range<const vector_size_t*> rows,
+    vector_size_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + rows.size(), fixedSize);
+
+  std::vector<vector_size_t> indices;
+  childIndices(rows, indices);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (auto j = 0; j < rows.size(); ++j) {
+      const auto index = indices[j];
+      if (mayHaveNulls && child.isNullAt(index)) {
+        continue;
+      }
+      if (isString) {
+        sizes[j] +=
+            kSizeBytes + child.decoded_.valueAt<StringView>(index).size();
+      } else {
+        sizes[j] += child.variableWidthRowSize(index);
+      }
+    }
+  }
+}
+
+namespace {
+
+// Writes one fixed-width value for each row. Row 'i' takes its value from
+// 'indices[i]' in 'decoded' and writes it at 'buffer + valueOffsets[i]'.
+// Null values set bit 'field' in the null flags at 'buffer + offsets[i]'.
+// Advances 'valueOffsets' by the size of the value for all rows.
+template <TypeKind Kind>
+void serializeFixedWidthColumn(
+    const DecodedVector& decoded,
+    const std::vector<vector_size_t>& indices,
+    int32_t field,
+    const size_t* offsets,
+    std::vector<size_t>& valueOffsets,
+    char* buffer) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  constexpr int32_t kValueBytes =
+      std::is_same_v<T, Timestamp> ? sizeof(int64_t) : sizeof(T);
+
+  const bool mayHaveNulls = decoded.mayHaveNulls();
+  for (auto i = 0; i < indices.size(); ++i) {
+    const auto index = indices[i];
+    if (mayHaveNulls && decoded.isNullAt(index)) {
+      bits::setBit(reinterpret_cast<uint8_t*>(buffer + offsets[i]), field);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      const auto micros = decoded.valueAt<Timestamp>(index).toMicros();
+      memcpy(buffer + valueOffsets[i], &micros, sizeof(int64_t));
+    } else {
+      const T value = decoded.valueAt<T>(index);
+      memcpy(buffer + valueOffsets[i], &value, sizeof(T));
+    }
+    valueOffsets[i] += kValueBytes;
+  }
+}
+} // namespace
+
+void CompactRow::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* offsets,
+    char* buffer) {
+  const auto numRows = rows.size();
+  std::vector<size_t> valueOffsets(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    valueOffsets[i] = offsets[i] + rowNullBytes_;
+  }
+
+  std::vector<vector_size_t> indices;
+  childIndices(rows, indices);
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (child.typeKind_ == TypeKind::UNKNOWN) {
+      for (auto j = 0; j < numRows; ++j) {
+        bits::setBit(reinterpret_cast<uint8_t*>(buffer + offsets[j]), i);
+      }
+      continue;
+    }
+
+    if (childIsFixedWidth_[i]) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          serializeFixedWidthColumn,
+          child.typeKind_,
+          child.decoded_,
+          indices,
+          i,
+          offsets,
+          valueOffsets,
+          buffer);
+      continue;
+    }
+
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto j = 0; j < numRows; ++j) {
+      const auto index = indices[j];
+      if (mayHaveNulls && child.isNullAt(index)) {
+        bits::setBit(reinterpret_cast<uint8_t*>(buffer + offsets[j]), i);
+        continue;
+      }
+      valueOffsets[j] +=
+          child.serializeVariableWidth(index, buffer + valueOffsets[j]);
+    }
+  }
+}
+
 namespace {
 
 // Reads single fixed-width value from buffer into flatVector[index].
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/row/UnsafeRowDeserializers.h"
 
 namespace facebook::velox::row {
 
@@ -408,4 +409,238 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) {
 
   return variableWidthOffset;
 }
+
+void UnsafeRowFast::childIndices(
+    folly::Range<const vector_size_t*> rows,
+    std::vector<vector_size_t>& indices) const {
+  indices.resize(rows.size());
+  if (decoded_.isIdentityMapping()) {
+    std::copy(rows.begin(), rows.end(), indices.begin());
+    return;
+  }
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+}
+
+void UnsafeRowFast::serializedRowSizes(
+    folly::Range<const vector_size_t*> rows,
+    vector_size_t* sizes) {
+  const int32_t fixedSize = rowNullBytes_ + children_.size() * kFieldWidth;
+  std::fill(sizes, sizes + rows.size(), fixedSize);
+
+  std::vector<vector_size_t> indices;
+  childIndices(rows, indices);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (auto j = 0; j < rows.size(); ++j) {
+      const auto index = indices[j];
+      if (mayHaveNulls && child.isNullAt(index)) {
+        continue;
+      }
+      if (isString) {
+        sizes[j] +=
+            alignBytes(child.decoded_.valueAt<StringView>(index).size());
+      } else {
+        sizes[j] += alignBytes(child.variableWidthRowSize(index));
+      }
+    }
+  }
+}
+
+namespace {
+
+// Writes one fixed-width value for each row. Row 'i' takes its value from
+// 'indices[i]' in 'decoded' and writes it into the slot starting at
+// 'buffer + offsets[i] + slotOffset'. Null values set bit 'field' in the null
+// flags at 'buffer + offsets[i]'.
+template <TypeKind Kind>
+void serializeFixedWidthColumn(
+    const DecodedVector& decoded,
+    const std::vector<vector_size_t>& indices,
+    int32_t field,
+    size_t slotOffset,
+    const size_t* offsets,
+    char* buffer) {
+  using T = typename TypeTraits<Kind>::NativeType;
+
+  const bool mayHaveNulls = decoded.mayHaveNulls();
+  for (auto i = 0; i < indices.size(); ++i) {
+    const auto index = indices[i];
+    char* row = buffer + offsets[i];
+    if (mayHaveNulls && decoded.isNullAt(index)) {
+      bits::setBit(row, field, true);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      *reinterpret_cast<int64_t*>(row + slotOffset) =
+          decoded.valueAt<Timestamp>(index).toMicros();
+    } else {
+      const T value = decoded.valueAt<T>(index);
+      memcpy(row + slotOffset, &value, sizeof(T));
+    }
+  }
+}
+
+// Reads one fixed-width value from the slot of 'field' in each row.
+template <TypeKind Kind>
+VectorPtr deserializeFixedWidthColumn(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    int32_t field,
+    size_t slotOffset,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+
+  const auto numRows = data.size();
+  auto flatVector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
+  for (auto i = 0; i < numRows; ++i) {
+    const char* row = data[i].data();
+    if (bits::isBitSet(reinterpret_cast<const uint8_t*>(row), field)) {
+      flatVector->setNull(i, true);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      int64_t micros;
+      memcpy(&micros, row + slotOffset, sizeof(int64_t));
+      flatVector->set(i, Timestamp::fromMicros(micros));
+    } else {
+      T value;
+      memcpy(&value, row + slotOffset, sizeof(T));
+      flatVector->set(i, value);
+    }
+  }
+  return flatVector;
+}
+
+// Returns the variable-width value whose size and offset are stored in the
+// slot at 'slotOffset' in 'row'.
+std::string_view variableWidthValue(std::string_view row, size_t slotOffset) {
+  uint64_t sizeAndOffset;
+  memcpy(&sizeAndOffset, row.data() + slotOffset, sizeof(uint64_t));
+  const uint32_t offset = sizeAndOffset >> 32;
+  const uint32_t size = sizeAndOffset;
+  VELOX_CHECK_LE(offset + size, row.size());
+  return std::string_view(row.data() + offset, size);
+}
+
+VectorPtr deserializeStringColumn(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    int32_t field,
+    size_t slotOffset,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  auto flatVector =
+      BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
+  for (auto i = 0; i < numRows; ++i) {
+    if (bits::isBitSet(
+            reinterpret_cast<const uint8_t*>(data[i].data()), field)) {
+      flatVector->setNull(i, true);
+      continue;
+    }
+    const auto value = variableWidthValue(data[i], slotOffset);
+    flatVector->set(i, StringView(value.data(), value.size()));
+  }
+  return flatVector;
+}
+} // namespace
+
+void UnsafeRowFast::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* offsets,
+    char* buffer) {
+  const auto numRows = rows.size();
+  std::vector<int64_t> variableWidthOffsets(
+      numRows, rowNullBytes_ + kFieldWidth * children_.size());
+
+  std::vector<vector_size_t> indices;
+  childIndices(rows, indices);
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    const size_t slotOffset = rowNullBytes_ + i * kFieldWidth;
+    if (child.typeKind_ == TypeKind::UNKNOWN) {
+      for (auto j = 0; j < numRows; ++j) {
+        bits::setBit(buffer + offsets[j], i, true);
+      }
+      continue;
+    }
+
+    if (childIsFixedWidth_[i]) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          serializeFixedWidthColumn,
+          child.typeKind_,
+          child.decoded_,
+          indices,
+          i,
+          slotOffset,
+          offsets,
+          buffer);
+      continue;
+    }
+
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto j = 0; j < numRows; ++j) {
+      const auto index = indices[j];
+      char* row = buffer + offsets[j];
+      if (mayHaveNulls && child.isNullAt(index)) {
+        bits::setBit(row, i, true);
+        continue;
+      }
+      auto& variableWidthOffset = variableWidthOffsets[j];
+      auto size =
+          child.serializeVariableWidth(index, row + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | size;
+      *reinterpret_cast<uint64_t*>(row + slotOffset) = sizeAndOffset;
+
+      variableWidthOffset += alignBytes(size);
+    }
+  }
+}
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  const auto numRows = data.size();
+  const auto numFields = rowType->size();
+  const size_t nullBytes = alignBits(numFields);
+
+  std::vector<VectorPtr> children(numFields);
+  for (auto i = 0; i < numFields; ++i) {
+    const auto& type = rowType->childAt(i);
+    const size_t slotOffset = nullBytes + i * kFieldWidth;
+    if (type->isUnKnown()) {
+      children[i] = BaseVector::createNullConstant(type, numRows, pool);
+    } else if (isFixedWidth(type)) {
+      children[i] = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          deserializeFixedWidthColumn,
+          type->kind(),
+          type,
+          data,
+          i,
+          slotOffset,
+          pool);
+    } else if (type->isVarchar() || type->isVarbinary()) {
+      children[i] = deserializeStringColumn(type, data, i, slotOffset, pool);
+    } else {
+      // Complex types and long decimals.
+      std::vector<std::optional<std::string_view>> values(numRows);
+      for (auto j = 0; j < numRows; ++j) {
+        if (!bits::isBitSet(
+                reinterpret_cast<const uint8_t*>(data[j].data()), i)) {
+          values[j] = variableWidthValue(data[j], slotOffset);
+        }
+      }
+      children[i] = UnsafeRowDeserializer::deserialize(values, type, pool);
+    }
+  }
+
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, numRows, std::move(children));
+}
 } // namespace facebook::velox::row
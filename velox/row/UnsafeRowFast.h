@@ -36,6 +36,28 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Stores the serialized sizes of 'rows' in 'sizes'. Processes one column
+  /// at a time, which is faster than calling 'rowSize' for each row.
+  void serializedRowSizes(
+      folly::Range<const vector_size_t*> rows,
+      vector_size_t* sizes);
+
+  /// Serializes 'rows' one column at a time. Row 'rows[i]' is written at
+  /// 'buffer + offsets[i]' and produces the same bytes as 'serialize' of that
+  /// row. 'buffer' must have sufficient capacity and set to all zeros.
+  void serialize(
+      folly::Range<const vector_size_t*> rows,
+      const size_t* offsets,
+      char* buffer);
+
+  /// Deserializes multiple rows into a RowVector of specified type. The type
+  /// must match the contents of the serialized rows. Decodes one column at a
+  /// time.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -98,6 +120,11 @@ class UnsafeRowFast {
   /// Returns serialized size of struct value.
   int32_t rowRowSize(vector_size_t index);
 
+  /// Returns the indices of 'rows' in the children of this struct.
+  void childIndices(
+      folly::Range<const vector_size_t*> rows,
+      std::vector<vector_size_t>& indices) const;
+
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
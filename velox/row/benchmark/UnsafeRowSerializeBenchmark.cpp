@@ -15,6 +15,7 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include <numeric>
 
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/ContainerRowSerde.h"
@@ -53,6 +54,27 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    auto serialized = serializeBatch(fast, data->size());
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
+  void deserializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    UnsafeRowFast fast(data);
+    auto serialized = serializeBatch(fast, data->size());
+    suspender.dismiss();
+
+    auto copy = UnsafeRowFast::deserialize(serialized, rowType, pool());
+    VELOX_CHECK_EQ(copy->size(), data->size());
+  }
+
   void serializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -78,6 +100,16 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    auto serialized = serializeBatch(compact, data->size());
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
   void serializeContainer(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -184,6 +216,38 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Serializes all rows one column at a time using the batch API of
+  // UnsafeRowFast or CompactRow.
+  template <typename TRow>
+  std::vector<std::string_view> serializeBatch(
+      TRow& row,
+      vector_size_t numRows) {
+    std::vector<vector_size_t> rows(numRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), numRows);
+
+    std::vector<vector_size_t> rowSizes(numRows);
+    row.serializedRowSizes(rowRange, rowSizes.data());
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+
+    buffer_ = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto rawBuffer = buffer_->asMutable<char>();
+    row.serialize(rowRange, offsets.data(), rawBuffer);
+
+    std::vector<std::string_view> serialized;
+    serialized.reserve(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      serialized.push_back(
+          std::string_view(rawBuffer + offsets[i], rowSizes[i]));
+    }
+    return serialized;
+  }
+
   HashStringAllocator::Position serialize(
       const RowVectorPtr& data,
       HashStringAllocator& allocator) {
@@ -203,37 +267,55 @@ class SerializeBenchmark {
 
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
+
+  // Holds the rows serialized by 'serializeBatch'.
+  BufferPtr buffer_;
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)        \
+  BENCHMARK(unsafe_serialize_##name) {         \
+    SerializeBenchmark benchmark;              \
+    benchmark.serializeUnsafe(rowType);        \
+  }                                            \
+                                               \
+  BENCHMARK(unsafe_batch_serialize_##name) {   \
+    SerializeBenchmark benchmark;              \
+    benchmark.serializeUnsafeBatch(rowType);   \
+  }                                            \
+                                               \
+  BENCHMARK(compact_serialize_##name) {        \
+    SerializeBenchmark benchmark;              \
+    benchmark.serializeCompact(rowType);       \
+  }                                            \
+                                               \
+  BENCHMARK(compact_batch_serialize_##name) {  \
+    SerializeBenchmark benchmark;              \
+    benchmark.serializeCompactBatch(rowType);  \
+  }                                            \
+                                               \
+  BENCHMARK(container_serialize_##name) {      \
+    SerializeBenchmark benchmark;              \
+    benchmark.serializeContainer(rowType);     \
+  }                                            \
+                                               \
+  BENCHMARK(unsafe_deserialize_##name) {       \
+    SerializeBenchmark benchmark;              \
+    benchmark.deserializeUnsafe(rowType);      \
+  }                                            \
+                                               \
+  BENCHMARK(unsafe_batch_deserialize_##name) { \
+    SerializeBenchmark benchmark;              \
+    benchmark.deserializeUnsafeBatch(rowType); \
+  }                                            \
+                                               \
+  BENCHMARK(compact_deserialize_##name) {      \
+    SerializeBenchmark benchmark;              \
+    benchmark.deserializeCompact(rowType);     \
+  }                                            \
+                                               \
+  BENCHMARK(container_deserialize_##name) {    \
+    SerializeBenchmark benchmark;              \
+    benchmark.deserializeContainer(rowType);   \
   }
 
 SERDE_BENCHMARKS(
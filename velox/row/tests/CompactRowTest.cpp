@@ -78,6 +78,32 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
+
+    // Serialize every other row in reverse order one column at a time and
+    // verify that the bytes match per-row serialization.
+    std::vector<vector_size_t> rows;
+    for (auto i = numRows - 1; i >= 0; i -= 2) {
+      rows.push_back(i);
+    }
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), rows.size());
+    std::vector<vector_size_t> rowSizes(rows.size());
+    row.serializedRowSizes(rowRange, rowSizes.data());
+    std::vector<size_t> offsets(rows.size());
+    size_t batchSize = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      ASSERT_EQ(rowSizes[i], serialized[rows[i]].size());
+      offsets[i] = batchSize;
+      batchSize += rowSizes[i];
+    }
+
+    auto batchBuffer = AlignedBuffer::allocate<char>(batchSize, pool(), 0);
+    row.serialize(rowRange, offsets.data(), batchBuffer->asMutable<char>());
+    for (auto i = 0; i < rows.size(); ++i) {
+      ASSERT_EQ(
+          std::string_view(batchBuffer->as<char>() + offsets[i], rowSizes[i]),
+          serialized[rows[i]])
+          << "Row " << rows[i];
+    }
   }
 };
 
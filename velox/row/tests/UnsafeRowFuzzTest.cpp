@@ -15,6 +15,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <numeric>
 
 #include <folly/Random.h>
 #include <folly/init/Init.h>
@@ -85,6 +86,15 @@ class UnsafeRowFuzzTests : public ::testing::Test {
           UnsafeRowDeserializer::deserialize(serialized, rowType, pool_.get());
 
       assertEqualVectors(inputVector, outputVector);
+
+      // Deserialize one column at a time.
+      std::vector<std::string_view> rows;
+      for (const auto& row : serialized) {
+        rows.push_back(row.value());
+      }
+      assertEqualVectors(
+          inputVector,
+          UnsafeRowFast::deserialize(rows, rowType, pool_.get()));
     }
   }
 
@@ -179,5 +189,57 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, batch) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      UNKNOWN(),
+      DECIMAL(20, 2),
+      DECIMAL(12, 4),
+      TIMESTAMP(),
+      DATE(),
+      ARRAY(VARCHAR()),
+      MAP(BIGINT(), ARRAY(TIMESTAMP())),
+      ROW({BOOLEAN(), ROW({INTEGER(), TIMESTAMP()}), VARCHAR()}),
+  });
+
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    std::vector<vector_size_t> rows(data->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), rows.size());
+
+    UnsafeRowFast fast(data);
+    std::vector<vector_size_t> rowSizes(rows.size());
+    fast.serializedRowSizes(rowRange, rowSizes.data());
+
+    // Write each row to its own buffer.
+    std::vector<size_t> offsets(rows.size());
+    for (auto i = 0; i < rows.size(); ++i) {
+      VELOX_CHECK_LE(rowSizes[i], kBufferSize);
+      EXPECT_EQ(rowSizes[i], fast.rowSize(i));
+      offsets[i] = buffers_[i] - buffers_[0];
+    }
+    fast.serialize(rowRange, offsets.data(), buffers_[0]);
+
+    std::vector<std::optional<std::string_view>> serialized;
+    serialized.reserve(data->size());
+    for (auto i = 0; i < rows.size(); ++i) {
+      std::string expected(rowSizes[i], '\0');
+      EXPECT_EQ(rowSizes[i], fast.serialize(i, expected.data()));
+      EXPECT_EQ(expected, std::string_view(buffers_[i], rowSizes[i]))
+          << i << ", " << data->toString(i);
+      serialized.push_back(std::string_view(buffers_[i], rowSizes[i]));
+    }
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -0,0 +1,895 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ColumnarSerializer.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::serializer {
+
+namespace {
+
+constexpr int32_t kAlignment = ColumnarVectorSerde::kBufferAlignment;
+
+// Buffers referencing the received IOBuf directly must be at least this
+// aligned in memory.
+constexpr uintptr_t kZeroCopyAlignment = 16;
+
+PrestoVectorSerde& prestoSerde() {
+  static PrestoVectorSerde serde;
+  return serde;
+}
+
+// Writes a page to 'out'. Only counts the bytes when 'out' is null. Offsets
+// are relative to the start of the page.
+class PageWriter {
+ public:
+  explicit PageWriter(OutputStream* out) : out_(out) {}
+
+  template <typename T>
+  void write(T value) {
+    writeBytes(&value, sizeof(T));
+  }
+
+  void writeBytes(const void* data, int64_t size) {
+    if (out_ != nullptr && size > 0) {
+      out_->write(reinterpret_cast<const char*>(data), size);
+    }
+    offset_ += size;
+  }
+
+  // Writes the length of a buffer of 'size' bytes and pads to the alignment.
+  // The caller writes the 'size' bytes of the buffer next.
+  void beginBuffer(int64_t size) {
+    static const char kPadding[kAlignment]{};
+    write<int64_t>(size);
+    if (size > 0) {
+      writeBytes(kPadding, bits::roundUp(offset_, kAlignment) - offset_);
+    }
+  }
+
+  void writeBuffer(const void* data, int64_t size) {
+    beginBuffer(size);
+    writeBytes(data, size);
+  }
+
+  void writeBuffer(const BufferPtr& buffer, int64_t size) {
+    if (buffer == nullptr) {
+      beginBuffer(0);
+      return;
+    }
+    VELOX_CHECK_GE(buffer->size(), size);
+    writeBuffer(buffer->as<char>(), size);
+  }
+
+  int64_t offset() const {
+    return offset_;
+  }
+
+ private:
+  OutputStream* const out_;
+  int64_t offset_{0};
+};
+
+void writeVector(
+    const VectorPtr& vector,
+    vector_size_t size,
+    PageWriter& out,
+    memory::MemoryPool* pool);
+
+void writeNulls(const BaseVector& vector, vector_size_t size, PageWriter& out) {
+  if (vector.rawNulls() == nullptr) {
+    out.beginBuffer(0);
+    return;
+  }
+  out.writeBuffer(vector.rawNulls(), bits::nbytes(size));
+}
+
+template <TypeKind kind>
+void writeFlat(const BaseVector& vector, vector_size_t size, PageWriter& out) {
+  using T = typename TypeTraits<kind>::NativeType;
+  writeNulls(vector, size, out);
+  out.writeBuffer(vector.values(), BaseVector::byteSize<T>(size));
+}
+
+template <>
+void writeFlat<TypeKind::VARCHAR>(
+    const BaseVector& vector,
+    vector_size_t size,
+    PageWriter& out) {
+  writeNulls(vector, size, out);
+  const auto* rawValues = vector.asFlatVector<StringView>()->rawValues();
+  std::vector<int32_t> lengths(size);
+  int64_t dataSize = 0;
+  for (auto i = 0; i < size; ++i) {
+    if (!vector.isNullAt(i)) {
+      lengths[i] = rawValues[i].size();
+      dataSize += lengths[i];
+    }
+  }
+  out.writeBuffer(lengths.data(), size * sizeof(int32_t));
+  out.beginBuffer(dataSize);
+  for (auto i = 0; i < size; ++i) {
+    out.writeBytes(rawValues[i].data(), lengths[i]);
+  }
+}
+
+template <>
+void writeFlat<TypeKind::VARBINARY>(
+    const BaseVector& vector,
+    vector_size_t size,
+    PageWriter& out) {
+  writeFlat<TypeKind::VARCHAR>(vector, size, out);
+}
+
+template <>
+void writeFlat<TypeKind::UNKNOWN>(
+    const BaseVector& /*vector*/,
+    vector_size_t /*size*/,
+    PageWriter& /*out*/) {}
+
+template <>
+void writeFlat<TypeKind::OPAQUE>(
+    const BaseVector& /*vector*/,
+    vector_size_t /*size*/,
+    PageWriter& /*out*/) {
+  VELOX_UNSUPPORTED("Columnar serialization of OPAQUE type is not supported");
+}
+
+void writeEncoded(
+    const VectorPtr& vector,
+    vector_size_t size,
+    PageWriter& out,
+    memory::MemoryPool* pool) {
+  out.write<int8_t>(static_cast<int8_t>(vector->encoding()));
+  out.write<int32_t>(size);
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          writeFlat, vector->typeKind(), *vector, size, out);
+      break;
+    case VectorEncoding::Simple::ROW: {
+      const auto* row = vector->asUnchecked<RowVector>();
+      writeNulls(*row, size, out);
+      out.write<int32_t>(row->childrenSize());
+      for (const auto& child : row->children()) {
+        writeVector(child, size, out, pool);
+      }
+      break;
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      const auto* array = vector->asUnchecked<ArrayVector>();
+      writeNulls(*array, size, out);
+      out.writeBuffer(array->offsets(), size * sizeof(vector_size_t));
+      out.writeBuffer(array->sizes(), size * sizeof(vector_size_t));
+      const auto& elements = array->elements();
+      writeVector(elements, elements->size(), out, pool);
+      break;
+    }
+    case VectorEncoding::Simple::MAP: {
+      const auto* map = vector->asUnchecked<MapVector>();
+      writeNulls(*map, size, out);
+      out.writeBuffer(map->offsets(), size * sizeof(vector_size_t));
+      out.writeBuffer(map->sizes(), size * sizeof(vector_size_t));
+      const auto& keys = map->mapKeys();
+      writeVector(keys, keys->size(), out, pool);
+      const auto& values = map->mapValues();
+      writeVector(values, values->size(), out, pool);
+      break;
+    }
+    case VectorEncoding::Simple::CONSTANT: {
+      auto value = BaseVector::create(vector->type(), 1, pool);
+      value->copy(vector.get(), 0, 0, 1);
+      writeVector(value, 1, out, pool);
+      break;
+    }
+    case VectorEncoding::Simple::DICTIONARY: {
+      writeNulls(*vector, size, out);
+      out.writeBuffer(vector->wrapInfo(), size * sizeof(vector_size_t));
+      const auto& base = vector->valueVector();
+      writeVector(base, base->size(), out, pool);
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE(
+          "Unexpected encoding {}", mapSimpleToName(vector->encoding()));
+  }
+}
+
+// Writes the first 'size' rows of 'vector'. Keeps flat, complex, constant and
+// dictionary encodings and flattens the rest.
+void writeVector(
+    const VectorPtr& vector,
+    vector_size_t size,
+    PageWriter& out,
+    memory::MemoryPool* pool) {
+  const auto& loaded = BaseVector::loadedVectorShared(vector);
+  if (size == 0) {
+    writeEncoded(BaseVector::create(loaded->type(), 0, pool), 0, out, pool);
+    return;
+  }
+  switch (loaded->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+    case VectorEncoding::Simple::ROW:
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+    case VectorEncoding::Simple::CONSTANT:
+    case VectorEncoding::Simple::DICTIONARY:
+      writeEncoded(loaded, size, out, pool);
+      break;
+    default: {
+      auto flat = BaseVector::create(loaded->type(), size, pool);
+      flat->copy(loaded.get(), 0, 0, size);
+      writeEncoded(flat, size, out, pool);
+    }
+  }
+}
+
+// Reads a page written by PageWriter. Offsets are relative to the start of
+// the page.
+class PageReader {
+ public:
+  explicit PageReader(memory::MemoryPool* pool) : pool_(pool) {}
+
+  virtual ~PageReader() = default;
+
+  template <typename T>
+  T read() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  // Returns the next buffer or nullptr if the buffer is empty.
+  BufferPtr readBuffer() {
+    const auto size = read<int64_t>();
+    VELOX_CHECK_GE(size, 0, "Corrupt columnar page: negative buffer size");
+    if (size == 0) {
+      return nullptr;
+    }
+    skip(bits::roundUp(offset_, kAlignment) - offset_);
+    return nextBuffer(size);
+  }
+
+  memory::MemoryPool* pool() const {
+    return pool_;
+  }
+
+ protected:
+  virtual void readBytes(void* data, int64_t size) = 0;
+
+  virtual void skip(int64_t size) = 0;
+
+  virtual BufferPtr nextBuffer(int64_t size) = 0;
+
+  memory::MemoryPool* const pool_;
+  int64_t offset_{0};
+};
+
+class StreamPageReader : public PageReader {
+ public:
+  StreamPageReader(ByteInputStream* source, memory::MemoryPool* pool)
+      : PageReader(pool), source_(source) {}
+
+ protected:
+  void readBytes(void* data, int64_t size) override {
+    auto* bytes = reinterpret_cast<uint8_t*>(data);
+    while (size > 0) {
+      const auto chunk =
+          std::min<int64_t>(size, std::numeric_limits<int32_t>::max());
+      source_->readBytes(bytes, chunk);
+      bytes += chunk;
+      size -= chunk;
+      offset_ += chunk;
+    }
+  }
+
+  void skip(int64_t size) override {
+    char padding[kAlignment];
+    VELOX_DCHECK_LE(size, kAlignment);
+    readBytes(padding, size);
+  }
+
+  BufferPtr nextBuffer(int64_t size) override {
+    auto buffer = AlignedBuffer::allocate<char>(size, pool_);
+    readBytes(buffer->asMutable<char>(), size);
+    return buffer;
+  }
+
+ private:
+  ByteInputStream* const source_;
+};
+
+// Keeps the IOBuf alive while vectors reference its memory.
+class IOBufReleaser {
+ public:
+  explicit IOBufReleaser(std::shared_ptr<const folly::IOBuf> iobuf)
+      : iobuf_(std::move(iobuf)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<const folly::IOBuf> iobuf_;
+};
+
+class IOBufPageReader : public PageReader {
+ public:
+  IOBufPageReader(
+      std::shared_ptr<const folly::IOBuf> iobuf,
+      memory::MemoryPool* pool)
+      : PageReader(pool), iobuf_(std::move(iobuf)) {
+    VELOX_CHECK(!iobuf_->isChained());
+    zeroCopy_ =
+        reinterpret_cast<uintptr_t>(iobuf_->data()) % kZeroCopyAlignment == 0;
+  }
+
+ protected:
+  void readBytes(void* data, int64_t size) override {
+    checkBounds(size);
+    std::memcpy(data, iobuf_->data() + offset_, size);
+    offset_ += size;
+  }
+
+  void skip(int64_t size) override {
+    checkBounds(size);
+    offset_ += size;
+  }
+
+  BufferPtr nextBuffer(int64_t size) override {
+    checkBounds(size);
+    const auto* data = iobuf_->data() + offset_;
+    offset_ += size;
+    if (zeroCopy_) {
+      return BufferView<IOBufReleaser>::create(
+          data, size, IOBufReleaser(iobuf_));
+    }
+    auto buffer = AlignedBuffer::allocate<char>(size, pool_);
+    std::memcpy(buffer->asMutable<char>(), data, size);
+    return buffer;
+  }
+
+ private:
+  void checkBounds(int64_t size) const {
+    VELOX_CHECK_LE(
+        offset_ + size,
+        iobuf_->length(),
+        "Corrupt columnar page: read past the end of the page");
+  }
+
+  const std::shared_ptr<const folly::IOBuf> iobuf_;
+  bool zeroCopy_;
+};
+
+VectorPtr readVector(PageReader& in, const TypePtr& type);
+
+void checkBufferSize(const BufferPtr& buffer, int64_t size) {
+  VELOX_CHECK(
+      (buffer == nullptr && size == 0) ||
+          (buffer != nullptr && buffer->size() >= size),
+      "Corrupt columnar page: buffer too small");
+}
+
+BufferPtr readNulls(PageReader& in, vector_size_t size) {
+  auto nulls = in.readBuffer();
+  if (nulls != nullptr) {
+    checkBufferSize(nulls, bits::nbytes(size));
+  }
+  return nulls;
+}
+
+// Reads the offsets or sizes of an array or map vector.
+BufferPtr readSizes(PageReader& in, vector_size_t size) {
+  auto buffer = in.readBuffer();
+  checkBufferSize(buffer, size * sizeof(vector_size_t));
+  return buffer != nullptr ? buffer : allocateIndices(0, in.pool());
+}
+
+template <TypeKind kind>
+VectorPtr readFlat(
+    PageReader& in,
+    const TypePtr& type,
+    vector_size_t size) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto nulls = readNulls(in, size);
+  auto values = in.readBuffer();
+  if (values != nullptr) {
+    checkBufferSize(values, BaseVector::byteSize<T>(size));
+  }
+  return std::make_shared<FlatVector<T>>(
+      in.pool(),
+      type,
+      std::move(nulls),
+      size,
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+template <>
+VectorPtr readFlat<TypeKind::VARCHAR>(
+    PageReader& in,
+    const TypePtr& type,
+    vector_size_t size) {
+  auto nulls = readNulls(in, size);
+  auto lengths = in.readBuffer();
+  checkBufferSize(lengths, size * sizeof(int32_t));
+  auto data = in.readBuffer();
+  const auto dataSize = data != nullptr ? data->size() : 0;
+
+  auto values = AlignedBuffer::allocate<StringView>(size, in.pool());
+  auto* rawValues = values->asMutable<StringView>();
+  const auto* rawLengths = lengths->as<int32_t>();
+  const char* rawData = data != nullptr ? data->as<char>() : nullptr;
+  uint64_t offset = 0;
+  for (auto i = 0; i < size; ++i) {
+    VELOX_CHECK_LE(
+        offset + rawLengths[i],
+        dataSize,
+        "Corrupt columnar page: string data too small");
+    rawValues[i] = StringView(rawData + offset, rawLengths[i]);
+    offset += rawLengths[i];
+  }
+
+  std::vector<BufferPtr> stringBuffers;
+  if (data != nullptr) {
+    stringBuffers.push_back(std::move(data));
+  }
+  return std::make_shared<FlatVector<StringView>>(
+      in.pool(),
+      type,
+      std::move(nulls),
+      size,
+      std::move(values),
+      std::move(stringBuffers));
+}
+
+template <>
+VectorPtr readFlat<TypeKind::VARBINARY>(
+    PageReader& in,
+    const TypePtr& type,
+    vector_size_t size) {
+  return readFlat<TypeKind::VARCHAR>(in, type, size);
+}
+
+template <>
+VectorPtr readFlat<TypeKind::UNKNOWN>(
+    PageReader& in,
+    const TypePtr& type,
+    vector_size_t size) {
+  return BaseVector::createNullConstant(type, size, in.pool());
+}
+
+template <>
+VectorPtr readFlat<TypeKind::OPAQUE>(
+    PageReader& /*in*/,
+    const TypePtr& /*type*/,
+    vector_size_t /*size*/) {
+  VELOX_UNSUPPORTED("Columnar serialization of OPAQUE type is not supported");
+}
+
+VectorPtr readVector(PageReader& in, const TypePtr& type) {
+  const auto encoding = static_cast<VectorEncoding::Simple>(in.read<int8_t>());
+  const auto size = in.read<int32_t>();
+  VELOX_CHECK_GE(size, 0, "Corrupt columnar page: negative vector size");
+  switch (encoding) {
+    case VectorEncoding::Simple::FLAT: {
+      VELOX_CHECK(type->isPrimitiveType() || type->isUnKnown());
+      if (size == 0 && !type->isUnKnown()) {
+        VELOX_CHECK_NULL(in.readBuffer());
+        VELOX_CHECK_NULL(in.readBuffer());
+        if (type->isVarchar() || type->isVarbinary()) {
+          VELOX_CHECK_NULL(in.readBuffer());
+        }
+        return BaseVector::create(type, 0, in.pool());
+      }
+      return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          readFlat, type->kind(), in, type, size);
+    }
+    case VectorEncoding::Simple::ROW: {
+      VELOX_CHECK(type->isRow());
+      auto nulls = readNulls(in, size);
+      const auto numChildren = in.read<int32_t>();
+      VELOX_CHECK_EQ(numChildren, type->size());
+      std::vector<VectorPtr> children(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        children[i] = readVector(in, type->childAt(i));
+      }
+      return std::make_shared<RowVector>(
+          in.pool(), type, std::move(nulls), size, std::move(children));
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      VELOX_CHECK(type->isArray());
+      auto nulls = readNulls(in, size);
+      auto offsets = readSizes(in, size);
+      auto sizes = readSizes(in, size);
+      auto elements = readVector(in, type->childAt(0));
+      return std::make_shared<ArrayVector>(
+          in.pool(),
+          type,
+          std::move(nulls),
+          size,
+          std::move(offsets),
+          std::move(sizes),
+          std::move(elements));
+    }
+    case VectorEncoding::Simple::MAP: {
+      VELOX_CHECK(type->isMap());
+      auto nulls = readNulls(in, size);
+      auto offsets = readSizes(in, size);
+      auto sizes = readSizes(in, size);
+      auto keys = readVector(in, type->childAt(0));
+      auto values = readVector(in, type->childAt(1));
+      return std::make_shared<MapVector>(
+          in.pool(),
+          type,
+          std::move(nulls),
+          size,
+          std::move(offsets),
+          std::move(sizes),
+          std::move(keys),
+          std::move(values));
+    }
+    case VectorEncoding::Simple::CONSTANT: {
+      auto value = readVector(in, type);
+      VELOX_CHECK_EQ(value->size(), 1);
+      return BaseVector::wrapInConstant(size, 0, std::move(value));
+    }
+    case VectorEncoding::Simple::DICTIONARY: {
+      auto nulls = readNulls(in, size);
+      auto indices = in.readBuffer();
+      checkBufferSize(indices, size * sizeof(vector_size_t));
+      auto base = readVector(in, type);
+      const auto* rawNulls =
+          nulls != nullptr ? nulls->as<uint64_t>() : nullptr;
+      const auto* rawIndices = indices->as<vector_size_t>();
+      for (auto i = 0; i < size; ++i) {
+        if (rawNulls != nullptr && bits::isBitNull(rawNulls, i)) {
+          continue;
+        }
+        VELOX_CHECK(
+            rawIndices[i] >= 0 && rawIndices[i] < base->size(),
+            "Corrupt columnar page: dictionary index out of range");
+      }
+      return BaseVector::wrapInDictionary(
+          std::move(nulls), std::move(indices), size, std::move(base));
+    }
+    default:
+      VELOX_FAIL(
+          "Corrupt columnar page: unexpected encoding {}",
+          static_cast<int32_t>(encoding));
+  }
+}
+
+void readPage(PageReader& in, const RowTypePtr& type, RowVectorPtr* result) {
+  const auto magic = in.read<int32_t>();
+  VELOX_CHECK_EQ(
+      magic, ColumnarVectorSerde::kMagic, "Not a columnar serialized page");
+  const auto numRows = in.read<int32_t>();
+  const auto numColumns = in.read<int32_t>();
+  if (numRows == 0) {
+    VELOX_CHECK_EQ(numColumns, 0);
+    *result = BaseVector::create<RowVector>(type, 0, in.pool());
+    return;
+  }
+  VELOX_CHECK_EQ(numColumns, type->size());
+  std::vector<VectorPtr> children(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    children[i] = readVector(in, type->childAt(i));
+    VELOX_CHECK_EQ(children[i]->size(), numRows);
+  }
+  *result = std::make_shared<RowVector>(
+      in.pool(), type, nullptr, numRows, std::move(children));
+}
+
+// Accumulates the rows of a page. A top level column stays constant while
+// the appended vectors have the same constant value and stays a dictionary
+// while the appended vectors wrap the same dictionary values. Other columns
+// are copied into a flat vector.
+class ColumnarVectorSerializer : public IterativeVectorSerializer {
+ public:
+  ColumnarVectorSerializer(RowTypePtr type, memory::MemoryPool* pool)
+      : type_(std::move(type)), pool_(pool), columns_(type_->size()) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& scratch) override {
+    std::vector<vector_size_t> rows;
+    for (const auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i) {
+        rows.push_back(range.begin + i);
+      }
+    }
+    append(
+        vector,
+        folly::Range<const vector_size_t*>(rows.data(), rows.size()),
+        scratch);
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& /*scratch*/) override {
+    if (rows.empty()) {
+      return;
+    }
+    for (auto i = 0; i < columns_.size(); ++i) {
+      const auto& child = BaseVector::loadedVectorShared(vector->childAt(i));
+      appendColumn(columns_[i], child, rows);
+    }
+    numRows_ += rows.size();
+    page_.clear();
+  }
+
+  bool supportsAppendRows() const override {
+    return true;
+  }
+
+  size_t maxSerializedSize() const override {
+    PageWriter out(nullptr);
+    writePage(out);
+    return out.offset();
+  }
+
+  void flush(OutputStream* stream) override {
+    PageWriter out(stream);
+    writePage(out);
+  }
+
+  void clear() override {
+    for (auto& column : columns_) {
+      column = {};
+    }
+    page_.clear();
+    numRows_ = 0;
+  }
+
+ private:
+  struct PageColumn {
+    // CONSTANT, DICTIONARY or FLAT.
+    VectorEncoding::Simple encoding{VectorEncoding::Simple::FLAT};
+
+    // The constant vector, the dictionary values or the flat rows.
+    VectorPtr vector;
+
+    // Indices into the dictionary values.
+    std::vector<vector_size_t> indices;
+  };
+
+  static bool canAppendToDictionary(
+      const PageColumn& column,
+      const VectorPtr& vector) {
+    return vector->encoding() == VectorEncoding::Simple::DICTIONARY &&
+        vector->rawNulls() == nullptr &&
+        vector->valueVector() == column.vector;
+  }
+
+  static void appendIndices(
+      PageColumn& column,
+      const VectorPtr& vector,
+      folly::Range<const vector_size_t*> rows) {
+    const auto* indices = vector->wrapInfo()->as<vector_size_t>();
+    for (auto row : rows) {
+      column.indices.push_back(indices[row]);
+    }
+  }
+
+  void appendColumn(
+      PageColumn& column,
+      const VectorPtr& vector,
+      folly::Range<const vector_size_t*> rows) {
+    if (numRows_ == 0) {
+      column.indices.clear();
+      if (vector->encoding() == VectorEncoding::Simple::CONSTANT) {
+        column.encoding = VectorEncoding::Simple::CONSTANT;
+        column.vector = vector;
+        return;
+      }
+      if (vector->encoding() == VectorEncoding::Simple::DICTIONARY &&
+          vector->rawNulls() == nullptr) {
+        column.encoding = VectorEncoding::Simple::DICTIONARY;
+        column.vector = vector->valueVector();
+        appendIndices(column, vector, rows);
+        return;
+      }
+      column.encoding = VectorEncoding::Simple::FLAT;
+      column.vector = BaseVector::create(vector->type(), 0, pool_);
+      appendFlat(column, vector, rows);
+      return;
+    }
+
+    switch (column.encoding) {
+      case VectorEncoding::Simple::CONSTANT:
+        if (vector->encoding() == VectorEncoding::Simple::CONSTANT &&
+            (vector == column.vector ||
+             vector->equalValueAt(column.vector.get(), 0, 0))) {
+          return;
+        }
+        break;
+      case VectorEncoding::Simple::DICTIONARY:
+        if (canAppendToDictionary(column, vector)) {
+          appendIndices(column, vector, rows);
+          return;
+        }
+        break;
+      default:
+        appendFlat(column, vector, rows);
+        return;
+    }
+
+    // The new rows do not share the encoding of the column. Flatten the rows
+    // appended so far.
+    auto encoded = pageVector(column, false);
+    auto flat = BaseVector::create(vector->type(), numRows_, pool_);
+    flat->copy(encoded.get(), 0, 0, numRows_);
+    column.encoding = VectorEncoding::Simple::FLAT;
+    column.vector = std::move(flat);
+    column.indices.clear();
+    appendFlat(column, vector, rows);
+  }
+
+  static void appendFlat(
+      PageColumn& column,
+      const VectorPtr& vector,
+      folly::Range<const vector_size_t*> rows) {
+    auto& flat = column.vector;
+    const auto offset = flat->size();
+    flat->resize(offset + rows.size());
+    std::vector<BaseVector::CopyRange> ranges;
+    for (auto i = 0; i < rows.size(); ++i) {
+      if (!ranges.empty() &&
+          ranges.back().sourceIndex + ranges.back().count == rows[i]) {
+        ++ranges.back().count;
+      } else {
+        ranges.push_back({rows[i], offset + i, 1});
+      }
+    }
+    flat->copyRanges(vector.get(), ranges);
+  }
+
+  // Returns the rows of 'column' as a vector of 'numRows_' rows. Drops the
+  // dictionary values that are not referenced if 'compact' is true and less
+  // than half of them are used.
+  VectorPtr pageVector(const PageColumn& column, bool compact) const {
+    switch (column.encoding) {
+      case VectorEncoding::Simple::CONSTANT:
+        return BaseVector::wrapInConstant(numRows_, 0, column.vector);
+      case VectorEncoding::Simple::DICTIONARY: {
+        auto base = column.vector;
+        std::vector<vector_size_t> newIndices;
+        const auto* indices = column.indices.data();
+        if (compact) {
+          newIndices = column.indices;
+          if (compactDictionary(base, newIndices)) {
+            indices = newIndices.data();
+          }
+        }
+        auto buffer = allocateIndices(numRows_, pool_);
+        std::memcpy(
+            buffer->asMutable<vector_size_t>(),
+            indices,
+            numRows_ * sizeof(vector_size_t));
+        return BaseVector::wrapInDictionary(
+            nullptr, std::move(buffer), numRows_, std::move(base));
+      }
+      default:
+        return column.vector;
+    }
+  }
+
+  bool compactDictionary(
+      VectorPtr& base,
+      std::vector<vector_size_t>& indices) const {
+    std::vector<vector_size_t> newIndex(base->size(), -1);
+    std::vector<BaseVector::CopyRange> ranges;
+    for (auto index : indices) {
+      if (newIndex[index] < 0) {
+        newIndex[index] = ranges.size();
+        ranges.push_back({index, newIndex[index], 1});
+      }
+    }
+    if (ranges.size() * 2 > base->size()) {
+      return false;
+    }
+    auto compacted = BaseVector::create(base->type(), ranges.size(), pool_);
+    compacted->copyRanges(base.get(), ranges);
+    base = std::move(compacted);
+    for (auto& index : indices) {
+      index = newIndex[index];
+    }
+    return true;
+  }
+
+  void writePage(PageWriter& out) const {
+    if (numRows_ > 0 && page_.empty()) {
+      for (const auto& column : columns_) {
+        page_.push_back(pageVector(column, true));
+      }
+    }
+    out.write<int32_t>(ColumnarVectorSerde::kMagic);
+    out.write<int32_t>(numRows_);
+    out.write<int32_t>(page_.size());
+    for (const auto& vector : page_) {
+      writeVector(vector, numRows_, out, pool_);
+    }
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  std::vector<PageColumn> columns_;
+  vector_size_t numRows_{0};
+
+  // The columns of the page as written. Built on first use after 'append'.
+  mutable std::vector<VectorPtr> page_;
+};
+
+} // namespace
+
+void ColumnarVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    folly::Range<const vector_size_t*> rows,
+    vector_size_t** sizes,
+    Scratch& scratch) {
+  prestoSerde().estimateSerializedSize(vector, rows, sizes, scratch);
+}
+
+void ColumnarVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    Scratch& scratch) {
+  prestoSerde().estimateSerializedSize(vector, ranges, sizes, scratch);
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+ColumnarVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t /* numRows */,
+    StreamArena* streamArena,
+    const Options* /* options */) {
+  return std::make_unique<ColumnarVectorSerializer>(
+      std::move(type), streamArena->pool());
+}
+
+void ColumnarVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* /* options */) {
+  StreamPageReader in(source, pool);
+  readPage(in, type, result);
+}
+
+void ColumnarVectorSerde::deserializeIOBuf(
+    std::shared_ptr<const folly::IOBuf> source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* /* options */) {
+  if (source->isChained()) {
+    source = source->cloneCoalesced();
+  }
+  IOBufPageReader in(std::move(source), pool);
+  readPage(in, type, result);
+}
+
+// static
+void ColumnarVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ColumnarVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Columnar wire format for exchanges between Velox workers. Each page holds
+/// the buffers of the columns as they are laid out in memory: nulls, values,
+/// offsets and sizes, dictionary indices and constant values. Every buffer
+/// starts at a 64 byte boundary relative to the start of the page, so that a
+/// page received as a single contiguous IOBuf can be turned back into vectors
+/// that reference the IOBuf memory directly, without copying.
+///
+/// Dictionary and constant encodings of the top level columns are kept while
+/// the vectors appended to the same page share the dictionary or the constant
+/// value. Other encodings are flattened.
+///
+/// Page layout:
+///   magic (int32) | numRows (int32) | numColumns (int32) | columns
+/// Column layout:
+///   encoding (int8) | size (int32) | encoding specific buffers and children
+/// Buffer layout:
+///   length (int64) | padding to a 64 byte boundary | bytes
+class ColumnarVectorSerde : public VectorSerde {
+ public:
+  /// Marks the start of a page. Has the high bit set so that it can't be
+  /// mistaken for the row count at the start of a Presto page.
+  static constexpr int32_t kMagic = static_cast<int32_t>(0xC01A0001);
+
+  /// Alignment of all buffers relative to the start of the page.
+  static constexpr int32_t kBufferAlignment = 64;
+
+  ColumnarVectorSerde() = default;
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      folly::Range<const vector_size_t*> rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  bool supportsZeroCopyDeserialize() const override {
+    return true;
+  }
+
+  /// Deserializes a single page. The buffers of 'result' point into 'source'
+  /// when 'source' is contiguous and suitably aligned and keep it alive.
+  void deserializeIOBuf(
+      std::shared_ptr<const folly::IOBuf> source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
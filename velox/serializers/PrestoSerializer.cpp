@@ -15,6 +15,7 @@
  */
 #include "velox/serializers/PrestoSerializer.h"
 
+#include <numeric>
 #include <optional>
 
 #include <folly/lang/Bits.h>
@@ -183,6 +184,18 @@ PrestoVectorSerde::PrestoOptions toPrestoOptions(
   return *prestoOptions;
 }
 
+std::unique_ptr<folly::io::Codec> makeCodec(
+    const PrestoVectorSerde::PrestoOptions& opts) {
+  if (opts.compressionDictionary != nullptr) {
+    VELOX_CHECK_EQ(
+        opts.compressionKind,
+        common::CompressionKind_ZSTD,
+        "A compression dictionary requires ZSTD compression");
+    return opts.compressionDictionary->makeCodec();
+  }
+  return common::compressionKindToCodec(opts.compressionKind);
+}
+
 FOLLY_ALWAYS_INLINE bool needCompression(const folly::io::Codec& codec) {
   return codec.type() != folly::io::CodecType::NO_COMPRESSION;
 }
@@ -3742,7 +3755,7 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
  public:
   PrestoBatchVectorSerializer(memory::MemoryPool* pool, const SerdeOpts& opts)
       : pool_(pool),
-        codec_(common::compressionKindToCodec(opts.compressionKind)),
+        codec_(makeCodec(opts)),
         opts_(opts) {}
 
   void serialize(
@@ -3926,7 +3939,7 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const SerdeOpts& opts)
       : opts_(opts),
         streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(opts.compressionKind)) {
+        codec_(makeCodec(opts)) {
     const auto types = rowType->children();
     const auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -3945,6 +3958,18 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (opts_.preserveEncodings) {
+      ScratchPtr<vector_size_t, 64> rowsHolder(scratch);
+      auto* rows = rowsHolder.get(numNewRows);
+      vector_size_t numRows = 0;
+      for (const auto& range : ranges) {
+        std::iota(rows + numRows, rows + numRows + range.size, range.begin);
+        numRows += range.size;
+      }
+      appendPreservingEncodings(
+          vector, folly::Range<const vector_size_t*>(rows, numRows), scratch);
+      return;
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
       serializeColumn(vector->childAt(i), ranges, streams_[i].get(), scratch);
@@ -3959,6 +3984,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (opts_.preserveEncodings) {
+      appendPreservingEncodings(vector, rows, scratch);
+      return;
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
       serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
@@ -4054,6 +4083,143 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     int64_t compressionSkippedBytes{0};
   };
 
+  // A top level column serialized as a Presto DICTIONARY or RLE block.
+  struct EncodedColumn {
+    // The dictionary or constant vector. Null if the column is serialized
+    // flat.
+    VectorPtr vector;
+
+    // For a dictionary, maps an index into the dictionary values to the
+    // index of the value in the serialized dictionary or -1 if not yet
+    // serialized.
+    std::vector<vector_size_t> indexMap;
+
+    // Number of values serialized into the dictionary or RLE block.
+    vector_size_t numValues{0};
+  };
+
+  void appendPreservingEncodings(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& scratch) {
+    if (numRows_ == 0) {
+      initializeEncodedStreams(vector, rows.size());
+    } else {
+      for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+        const auto& encoded = encodedColumns_[i];
+        VELOX_CHECK(
+            encoded.vector == nullptr ||
+                BaseVector::loadedVectorShared(vector->childAt(i)) ==
+                    encoded.vector,
+            "Vectors appended to the same page must share dictionary and "
+            "constant columns when preserving encodings");
+      }
+    }
+    numRows_ += rows.size();
+    for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+      auto& encoded = encodedColumns_[i];
+      if (encoded.vector == nullptr) {
+        serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
+        continue;
+      }
+      if (streams_[i]->isConstantStream()) {
+        serializeConstantColumn(encoded, rows, streams_[i].get(), scratch);
+      } else {
+        serializeDictionaryColumn(encoded, rows, streams_[i].get(), scratch);
+      }
+    }
+  }
+
+  // Sets up the streams for a new page from the encodings of the columns of
+  // its first vector.
+  void initializeEncodedStreams(const RowVectorPtr& vector, int32_t numRows) {
+    encodedColumns_.resize(streams_.size());
+    for (int32_t i = 0; i < streams_.size(); ++i) {
+      auto& encoded = encodedColumns_[i];
+      encoded = EncodedColumn{};
+      const auto& column = BaseVector::loadedVectorShared(vector->childAt(i));
+      std::optional<VectorEncoding::Simple> encoding;
+      if (column->encoding() == VectorEncoding::Simple::CONSTANT &&
+          column->valueVector() == nullptr) {
+        encoding = VectorEncoding::Simple::CONSTANT;
+      } else if (
+          column->encoding() == VectorEncoding::Simple::DICTIONARY &&
+          column->rawNulls() == nullptr) {
+        encoding = VectorEncoding::Simple::DICTIONARY;
+      }
+      auto& stream = streams_[i];
+      if (encoding.has_value() || stream->isConstantStream() ||
+          stream->isDictionaryStream()) {
+        stream = std::make_unique<VectorStream>(
+            column->type(),
+            encoding,
+            std::nullopt,
+            streamArena_,
+            numRows,
+            opts_);
+      }
+      if (stream->isConstantStream() || stream->isDictionaryStream()) {
+        encoded.vector = column;
+      }
+    }
+  }
+
+  // Appends 'rows' to the RLE block of a constant column. The value is
+  // serialized once per page.
+  static void serializeConstantColumn(
+      EncodedColumn& encoded,
+      const folly::Range<const vector_size_t*>& rows,
+      VectorStream* stream,
+      Scratch& scratch) {
+    stream->appendNonNull(rows.size());
+    if (encoded.numValues == 0) {
+      const vector_size_t valueRow = 0;
+      serializeColumn(
+          encoded.vector,
+          folly::Range<const vector_size_t*>(&valueRow, 1),
+          stream->childAt(0),
+          scratch);
+      encoded.numValues = 1;
+    }
+  }
+
+  // Appends 'rows' to the DICTIONARY block of a dictionary column. Only the
+  // dictionary values referenced by the page are serialized, each once.
+  static void serializeDictionaryColumn(
+      EncodedColumn& encoded,
+      const folly::Range<const vector_size_t*>& rows,
+      VectorStream* stream,
+      Scratch& scratch) {
+    const auto& values = encoded.vector->valueVector();
+    const auto* indices = encoded.vector->wrapInfo()->as<vector_size_t>();
+    if (encoded.indexMap.empty()) {
+      encoded.indexMap.resize(values->size(), -1);
+    }
+
+    ScratchPtr<vector_size_t, 64> newValuesHolder(scratch);
+    auto* newValues = newValuesHolder.get(rows.size());
+    int32_t numNewValues = 0;
+    for (auto row : rows) {
+      auto& mappedIndex = encoded.indexMap[indices[row]];
+      if (mappedIndex < 0) {
+        mappedIndex = encoded.numValues++;
+        newValues[numNewValues++] = indices[row];
+      }
+    }
+    if (numNewValues > 0) {
+      serializeColumn(
+          values,
+          folly::Range<const vector_size_t*>(newValues, numNewValues),
+          stream->childAt(0),
+          scratch);
+    }
+
+    stream->appendNonNull(rows.size());
+    for (auto row : rows) {
+      stream->appendOne<int32_t>(encoded.indexMap[indices[row]]);
+    }
+  }
+
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
@@ -4061,6 +4227,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 
+  // Top level columns serialized with their encoding in the current page if
+  // 'opts_.preserveEncodings' is set. Parallel to 'streams_'.
+  std::vector<EncodedColumn> encodedColumns_;
+
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
   CompressionStats stats_;
@@ -4178,8 +4348,7 @@ void PrestoVectorSerde::deserialize(
     vector_size_t resultOffset,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
-  const auto codec =
-      common::compressionKindToCodec(prestoOptions.compressionKind);
+  const auto codec = makeCodec(prestoOptions);
   auto const header = PrestoHeader::read(source);
 
   int64_t actualCheckSum = 0;
@@ -19,6 +19,7 @@
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::serializer::presto {
@@ -72,6 +73,19 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// If true, the iterative serializer keeps the dictionary and constant
+    /// encodings of top level columns as Presto DICTIONARY and RLE blocks
+    /// instead of flattening them. The encodings are taken from the first
+    /// vector appended after creation or clear(), so there is one dictionary
+    /// per page. All vectors appended to the same page must then share these
+    /// dictionary and constant columns. The deserializer reads the blocks back
+    /// into DictionaryVector and ConstantVector.
+    bool preserveEncodings{false};
+
+    /// If set, pages are compressed with this dictionary. Requires
+    /// 'compressionKind' ZSTD. The reader must use the same dictionary.
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary;
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
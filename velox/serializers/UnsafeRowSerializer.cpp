@@ -15,7 +15,6 @@
  */
 #include "velox/serializers/UnsafeRowSerializer.h"
 #include <folly/lang/Bits.h>
-#include "velox/row/UnsafeRowDeserializers.h"
 #include "velox/row/UnsafeRowFast.h"
 
 namespace facebook::velox::serializer::spark {
@@ -40,41 +39,45 @@ class UnsafeRowVectorSerializer : public IterativeVectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
       Scratch& /*scratch*/) override {
-    size_t totalSize = 0;
+    std::vector<vector_size_t> rows;
+    for (const auto& range : ranges) {
+      for (auto i = range.begin; i < range.begin + range.size; ++i) {
+        rows.push_back(i);
+      }
+    }
+    if (rows.empty()) {
+      return;
+    }
+
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), rows.size());
     row::UnsafeRowFast unsafeRow(vector);
+    std::vector<vector_size_t> rowSizes(rows.size());
     if (auto fixedRowSize =
             row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
-
+      std::fill(rowSizes.begin(), rowSizes.end(), fixedRowSize.value());
     } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += unsafeRow.rowSize(i) + sizeof(TRowSize);
-        }
-      }
+      unsafeRow.serializedRowSizes(rowRange, rowSizes.data());
     }
 
-    if (totalSize == 0) {
-      return;
+    // Each row is preceded by its size.
+    std::vector<size_t> offsets(rows.size());
+    size_t totalSize = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      offsets[i] = totalSize + sizeof(TRowSize);
+      totalSize += sizeof(TRowSize) + rowSizes[i];
     }
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size =
-            unsafeRow.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    // Write row data one column at a time.
+    unsafeRow.serialize(rowRange, offsets.data(), rawBuffer);
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write raw sizes. Needs to be in big endian order.
+    for (auto i = 0; i < rows.size(); ++i) {
+      *(TRowSize*)(rawBuffer + offsets[i] - sizeof(TRowSize)) =
+          folly::Endian::big(static_cast<TRowSize>(rowSizes[i]));
     }
   }
 
@@ -137,7 +140,7 @@ void UnsafeRowVectorSerde::deserialize(
     RowTypePtr type,
     RowVectorPtr* result,
     const Options* /* options */) {
-  std::vector<std::optional<std::string_view>> serializedRows;
+  std::vector<std::string_view> serializedRows;
   std::vector<std::string> concatenatedRows;
 
   while (!source->atEnd()) {
@@ -162,9 +165,7 @@ void UnsafeRowVectorSerde::deserialize(
     return;
   }
 
-  *result = std::dynamic_pointer_cast<RowVector>(
-      velox::row::UnsafeRowDeserializer::deserialize(
-          serializedRows, type, pool));
+  *result = velox::row::UnsafeRowFast::deserialize(serializedRows, type, pool);
 }
 
 // static
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ColumnarSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ColumnarSerializerTest : public ::testing::Test,
+                               public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    serde_ = std::make_unique<ColumnarVectorSerde>();
+  }
+
+  // Serializes all rows of 'vectors' into a single page.
+  std::shared_ptr<const folly::IOBuf> serialize(
+      const std::vector<RowVectorPtr>& vectors) {
+    auto rowType = asRowType(vectors[0]->type());
+    auto arena = std::make_unique<StreamArena>(pool());
+    auto serializer =
+        serde_->createIterativeSerializer(rowType, 0, arena.get(), nullptr);
+    Scratch scratch;
+    for (const auto& vector : vectors) {
+      IndexRange range{0, vector->size()};
+      serializer->append(vector, folly::Range(&range, 1), scratch);
+    }
+    const auto size = serializer->maxSerializedSize();
+    IOBufOutputStream out(*pool(), nullptr, size);
+    serializer->flush(&out);
+    EXPECT_EQ(size, out.tellp());
+    return out.getIOBuf();
+  }
+
+  RowVectorPtr deserializeStream(
+      const RowTypePtr& rowType,
+      const folly::IOBuf& iobuf) {
+    // Split the page into small ranges to exercise reads across ranges.
+    auto coalesced = iobuf.cloneCoalescedAsValue();
+    std::vector<ByteRange> ranges;
+    for (size_t offset = 0; offset < coalesced.length(); offset += 32) {
+      ranges.push_back(
+          {const_cast<uint8_t*>(coalesced.data()) + offset,
+           static_cast<int32_t>(
+               std::min<size_t>(32, coalesced.length() - offset)),
+           0});
+    }
+    ByteInputStream stream(std::move(ranges));
+    RowVectorPtr result;
+    serde_->deserialize(&stream, pool(), rowType, &result, nullptr);
+    EXPECT_TRUE(stream.atEnd());
+    return result;
+  }
+
+  RowVectorPtr deserializeIOBuf(
+      const RowTypePtr& rowType,
+      std::shared_ptr<const folly::IOBuf> iobuf) {
+    RowVectorPtr result;
+    serde_->deserializeIOBuf(
+        std::move(iobuf), pool(), rowType, &result, nullptr);
+    return result;
+  }
+
+  void testRoundTrip(const std::vector<RowVectorPtr>& vectors) {
+    auto rowType = asRowType(vectors[0]->type());
+    auto expected = BaseVector::create<RowVector>(rowType, 0, pool());
+    for (const auto& vector : vectors) {
+      expected->append(vector.get());
+    }
+    auto iobuf = serialize(vectors);
+    test::assertEqualVectors(expected, deserializeStream(rowType, *iobuf));
+    test::assertEqualVectors(expected, deserializeIOBuf(rowType, iobuf));
+  }
+
+  std::unique_ptr<VectorSerde> serde_;
+};
+
+TEST_F(ColumnarSerializerTest, fuzz) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      HUGEINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      TIMESTAMP(),
+      ROW({VARCHAR(), INTEGER()}),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), ARRAY(INTEGER())),
+  });
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.stringLength = 20;
+  opts.containerLength = 10;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "Seed: " << seed;
+  SCOPED_TRACE(fmt::format("seed: {}", seed));
+  VectorFuzzer fuzzer(opts, pool(), seed);
+
+  for (auto i = 0; i < 10; ++i) {
+    testRoundTrip({fuzzer.fuzzRow(rowType), fuzzer.fuzzRow(rowType)});
+  }
+}
+
+TEST_F(ColumnarSerializerTest, emptyPage) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto arena = std::make_unique<StreamArena>(pool());
+  auto serializer =
+      serde_->createIterativeSerializer(rowType, 0, arena.get(), nullptr);
+  IOBufOutputStream out(*pool());
+  serializer->flush(&out);
+  auto result = deserializeIOBuf(rowType, out.getIOBuf());
+  ASSERT_EQ(result->size(), 0);
+}
+
+TEST_F(ColumnarSerializerTest, preserveEncodings) {
+  auto dictionaryValues = makeFlatVector<std::string>(
+      {"apple", "banana", "cherry", "a somewhat longer string value"});
+  auto makeBatch = [&](const std::vector<vector_size_t>& indices) {
+    return makeRowVector({
+        BaseVector::wrapInDictionary(
+            nullptr, makeIndices(indices), indices.size(), dictionaryValues),
+        makeConstant<int64_t>(7, indices.size()),
+        makeFlatVector<int32_t>(
+            indices.size(), [](auto row) { return row; }),
+    });
+  };
+  std::vector<RowVectorPtr> batches = {
+      makeBatch({0, 1, 2, 3, 3}), makeBatch({3, 2, 1})};
+  testRoundTrip(batches);
+
+  auto rowType = asRowType(batches[0]->type());
+  auto result = deserializeIOBuf(rowType, serialize(batches));
+  ASSERT_EQ(result->size(), 8);
+  ASSERT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(0)->valueVector()->size(), 4);
+  ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+
+  // Unreferenced dictionary values are dropped.
+  result = deserializeIOBuf(rowType, serialize({makeBatch({2, 2, 2})}));
+  ASSERT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(0)->valueVector()->size(), 1);
+  test::assertEqualVectors(
+      makeFlatVector<std::string>({"cherry", "cherry", "cherry"}),
+      result->childAt(0));
+}
+
+TEST_F(ColumnarSerializerTest, flattenMismatchedEncodings) {
+  auto first = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices({1, 0}),
+          2,
+          makeFlatVector<int64_t>({10, 20})),
+      makeConstant<int64_t>(1, 2),
+  });
+  auto second = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices({0, 1}),
+          2,
+          makeFlatVector<int64_t>({30, 40})),
+      makeConstant<int64_t>(2, 2),
+  });
+  testRoundTrip({first, second});
+
+  auto result =
+      deserializeIOBuf(asRowType(first->type()), serialize({first, second}));
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+  test::assertEqualVectors(
+      makeRowVector({
+          makeFlatVector<int64_t>({20, 10, 30, 40}),
+          makeFlatVector<int64_t>({1, 1, 2, 2}),
+      }),
+      result);
+}
+
+TEST_F(ColumnarSerializerTest, zeroCopy) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return std::string(row % 30, 'x'); }),
+  });
+  // Data is only referenced in place if the page is contiguous.
+  std::shared_ptr<const folly::IOBuf> iobuf =
+      serialize({data})->cloneCoalesced();
+  const auto* begin = iobuf->data();
+  const auto* end = begin + iobuf->length();
+  auto inPage = [&](const void* address) {
+    return address >= begin && address < end;
+  };
+
+  auto result = deserializeIOBuf(asRowType(data->type()), iobuf);
+  test::assertEqualVectors(data, result);
+
+  const auto& bigints = result->childAt(0)->values();
+  ASSERT_TRUE(bigints->isView());
+  ASSERT_TRUE(inPage(bigints->as<char>()));
+  ASSERT_EQ(
+      (bigints->as<char>() - reinterpret_cast<const char*>(begin)) %
+          ColumnarVectorSerde::kBufferAlignment,
+      0);
+
+  auto* strings = result->childAt(1)->asFlatVector<StringView>();
+  ASSERT_EQ(strings->stringBuffers().size(), 1);
+  ASSERT_TRUE(inPage(strings->stringBuffers()[0]->as<char>()));
+
+  // The vectors keep the page alive.
+  iobuf.reset();
+  data.reset();
+  ASSERT_EQ(result->childAt(0)->asFlatVector<int64_t>()->valueAt(999), 999);
+}
+
+TEST_F(ColumnarSerializerTest, corruptPage) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto iobuf = serialize({data});
+  auto truncated = folly::IOBuf::copyBuffer(iobuf->data(), iobuf->length() - 8);
+  VELOX_ASSERT_THROW(
+      deserializeIOBuf(asRowType(data->type()), std::move(truncated)),
+      "Corrupt columnar page");
+
+  auto presto = folly::IOBuf::copyBuffer(std::string(64, '\0'));
+  VELOX_ASSERT_THROW(
+      deserializeIOBuf(asRowType(data->type()), std::move(presto)),
+      "Not a columnar serialized page");
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
@@ -1137,6 +1137,88 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   ASSERT_EQ(deserialized->childAt(9)->encoding(), VectorEncoding::Simple::FLAT);
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  const vector_size_t size = 100;
+  auto base = makeFlatVector<std::string>(
+      {"apple", "banana", "cherry", "durian", "elderberry"});
+  auto rowVector = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(size, [](auto row) { return row % 3; }),
+          size,
+          base),
+      makeConstant<int64_t>(7, size),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+  const auto rowType = asRowType(rowVector->type());
+
+  auto options = getParamSerdeOptions(nullptr);
+  options.preserveEncodings = true;
+  StreamArena arena(pool_.get());
+  auto serializer =
+      serde_->createIterativeSerializer(rowType, size, &arena, &options);
+
+  // Append the even rows of the first half and then the second half.
+  std::vector<vector_size_t> rows;
+  for (auto row = 0; row < size / 2; row += 2) {
+    rows.push_back(row);
+  }
+  Scratch scratch;
+  serializer->append(
+      rowVector, folly::Range(rows.data(), rows.size()), scratch);
+  IndexRange range{size / 2, size / 2};
+  serializer->append(rowVector, folly::Range(&range, 1), scratch);
+  for (auto row = size / 2; row < size; ++row) {
+    rows.push_back(row);
+  }
+
+  // Columns of another vector can't be added to the page.
+  auto otherVector = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(size, [](auto row) { return row % 2; }),
+          size,
+          base),
+      makeConstant<int64_t>(7, size),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+  VELOX_ASSERT_THROW(
+      serializer->append(otherVector, folly::Range(&range, 1), scratch),
+      "Vectors appended to the same page must share dictionary and "
+      "constant columns");
+
+  std::ostringstream out;
+  facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+  OStreamOutputStream output(&out, &listener);
+  serializer->flush(&output);
+
+  auto deserialized = deserialize(rowType, out.str(), nullptr);
+  assertEqualVectors(
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(rows.size(), [&](auto row) { return rows[row]; }),
+          rows.size(),
+          rowVector),
+      deserialized);
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  // Only the referenced dictionary values are serialized.
+  ASSERT_EQ(deserialized->childAt(0)->valueVector()->size(), 3);
+  ASSERT_EQ(
+      deserialized->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(deserialized->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+
+  // A new page takes the encodings of its first vector.
+  serializer->clear();
+  serializer->append(otherVector, folly::Range(&range, 1), scratch);
+  std::ostringstream otherOut;
+  OStreamOutputStream otherOutput(&otherOut, &listener);
+  serializer->flush(&otherOutput);
+  deserialized = deserialize(rowType, otherOut.str(), nullptr);
+  assertEqualVectors(otherVector->slice(size / 2, size / 2), deserialized);
+  ASSERT_EQ(deserialized->childAt(0)->valueVector()->size(), 2);
+}
+
 TEST_P(PrestoSerializerTest, emptyVectorBatchVectorSerializer) {
   // Serialize an empty RowVector.
   auto rowVector = makeEmptyTestVector();
@@ -15,6 +15,10 @@
  */
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 #include "velox/substrait/TypeUtils.h"
 #include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
@@ -555,6 +559,25 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::Plan& substraitPlan) {
+  if (planCache_ == nullptr) {
+    return convertPlan(substraitPlan);
+  }
+  const auto key = SubstraitPlanCache::makeKey(substraitPlan);
+  if (auto entry = planCache_->find(key)) {
+    functionMap_ = entry->functionMap;
+    splitInfoMap_ = entry->splitInfos;
+    return entry->plan;
+  }
+  auto plan = convertPlan(substraitPlan);
+  planCache_->insert(
+      key,
+      std::make_shared<SubstraitPlanCache::Entry>(
+          SubstraitPlanCache::Entry{plan, functionMap_, splitInfoMap_}));
+  return plan;
+}
+
+core::PlanNodePtr SubstraitVeloxPlanConverter::convertPlan(
+    const ::substrait::Plan& substraitPlan) {
   VELOX_CHECK(
       checkTypeExtension(substraitPlan),
       "The type extension only have unknown type.")
@@ -787,4 +810,36 @@ const std::string& SubstraitVeloxPlanConverter::findFunction(
   return substraitParser_->findFunctionSpec(functionMap_, id);
 }
 
+// static
+std::string SubstraitPlanCache::makeKey(
+    const ::substrait::Plan& substraitPlan) {
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream stream(&key);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    // Orders the map fields so that equal plans have equal keys.
+    output.SetSerializationDeterministic(true);
+    VELOX_CHECK(substraitPlan.SerializeToCodedStream(&output));
+  }
+  return key;
+}
+
+std::shared_ptr<const SubstraitPlanCache::Entry> SubstraitPlanCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.get(key).value_or(nullptr);
+}
+
+void SubstraitPlanCache::insert(
+    const std::string& key,
+    std::shared_ptr<const Entry> entry) {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.add(key, std::move(entry));
+}
+
+SimpleLRUCacheStats SubstraitPlanCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.getStats();
+}
+
 } // namespace facebook::velox::substrait
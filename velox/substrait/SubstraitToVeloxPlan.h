@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/core/PlanNode.h"
@@ -24,11 +27,17 @@
 
 namespace facebook::velox::substrait {
 
+class SubstraitPlanCache;
+
 /// This class is used to convert the Substrait plan into Velox plan.
 class SubstraitVeloxPlanConverter {
  public:
-  explicit SubstraitVeloxPlanConverter(memory::MemoryPool* pool)
-      : pool_(pool) {}
+  /// If 'planCache' is not null, toVeloxPlan(const ::substrait::Plan&) looks
+  /// up the plan in 'planCache' and adds the converted plan to it on a miss.
+  explicit SubstraitVeloxPlanConverter(
+      memory::MemoryPool* pool,
+      SubstraitPlanCache* planCache = nullptr)
+      : pool_(pool), planCache_(planCache) {}
   struct SplitInfo {
     /// The Partition index.
     u_int32_t partitionIndex;
@@ -119,6 +128,9 @@ class SubstraitVeloxPlanConverter {
       const core::PlanNodePtr& noEmitNode);
 
  private:
+  /// Converts 'substraitPlan' without looking at 'planCache_'.
+  core::PlanNodePtr convertPlan(const ::substrait::Plan& substraitPlan);
+
   /// Returns unique ID to use for plan node. Produces sequential numbers
   /// starting from zero.
   std::string nextPlanNodeId();
@@ -171,6 +183,9 @@ class SubstraitVeloxPlanConverter {
   /// Memory pool.
   memory::MemoryPool* pool_;
 
+  /// Cache of converted plans. Not owned. May be null.
+  SubstraitPlanCache* const planCache_;
+
   /// Helper function to convert the input of Substrait Rel to Velox Node.
   template <typename T>
   core::PlanNodePtr convertSingleInput(T rel) {
@@ -179,4 +194,38 @@ class SubstraitVeloxPlanConverter {
   }
 };
 
+/// Cache of converted plans shared between SubstraitVeloxPlanConverters,
+/// keyed by the deterministic serialization of the Substrait plan. A
+/// repeated plan, e.g. a dashboard query, then skips the conversion and gets
+/// the same immutable Velox plan. The plans hold vectors allocated from the
+/// pool of the converter that made them, so that pool must outlive the cache.
+/// Thread safe.
+class SubstraitPlanCache {
+ public:
+  struct Entry {
+    core::PlanNodePtr plan;
+    std::unordered_map<uint64_t, std::string> functionMap;
+    std::unordered_map<
+        core::PlanNodeId,
+        std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+        splitInfos;
+  };
+
+  explicit SubstraitPlanCache(size_t maxEntries) : cache_(maxEntries) {}
+
+  /// Returns the key of 'substraitPlan'.
+  static std::string makeKey(const ::substrait::Plan& substraitPlan);
+
+  /// Returns the entry for 'key' or nullptr if not found.
+  std::shared_ptr<const Entry> find(const std::string& key);
+
+  void insert(const std::string& key, std::shared_ptr<const Entry> entry);
+
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const Entry>> cache_;
+};
+
 } // namespace facebook::velox::substrait
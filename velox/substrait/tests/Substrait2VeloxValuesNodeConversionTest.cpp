@@ -60,3 +60,30 @@ TEST_F(Substrait2VeloxValuesNodeConversionTest, valuesNode) {
   createDuckDbTable({expectedData});
   assertQuery(veloxPlan, "SELECT * FROM tmp");
 }
+
+TEST_F(Substrait2VeloxValuesNodeConversionTest, planCache) {
+  auto planPath = getDataFilePath(
+      "velox/substrait/tests", "data/substrait_virtualTable.json");
+  ::substrait::Plan substraitPlan;
+  JsonToProtoConverter::readFromFile(planPath, substraitPlan);
+
+  SubstraitPlanCache planCache(10);
+  auto veloxPlan = SubstraitVeloxPlanConverter(pool_.get(), &planCache)
+                       .toVeloxPlan(substraitPlan);
+  EXPECT_EQ(0, planCache.stats().numHits);
+  EXPECT_EQ(1, planCache.stats().curSize);
+
+  // The same plan converted by another converter is the cached one.
+  SubstraitVeloxPlanConverter converter(pool_.get(), &planCache);
+  EXPECT_EQ(veloxPlan, converter.toVeloxPlan(substraitPlan));
+  EXPECT_EQ(1, planCache.stats().numHits);
+
+  // A different plan is converted.
+  auto* function =
+      substraitPlan.add_extensions()->mutable_extension_function();
+  function->set_function_anchor(1'000);
+  function->set_name("unused:i64");
+  auto otherPlan = converter.toVeloxPlan(substraitPlan);
+  EXPECT_NE(veloxPlan, otherPlan);
+  EXPECT_EQ(2, planCache.stats().curSize);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <folly/Portability.h>
+
+#include "velox/type/TimestampConversion.h"
+
+/// Parsers for the plain forms of numbers and dates that make up most of the
+/// strings cast in practice. They do not throw and do not allocate. They
+/// return false for anything outside of the plain form, including valid
+/// input in other forms, e.g. with leading spaces or in exponent notation.
+/// The caller then falls back to the general conversion in Conversions.h,
+/// which also produces the error for invalid input. For input they accept,
+/// the results are the same as the results of the general conversion.
+namespace facebook::velox::util::fast {
+
+namespace detail {
+// Returns the 8 bytes at 'data' with the first byte in the low byte.
+inline uint64_t load8(const char* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  if constexpr (!folly::kIsLittleEndian) {
+    word = __builtin_bswap64(word);
+  }
+  return word;
+}
+
+// Returns true if the 8 bytes of 'word' are all ASCII digits.
+inline bool isEightDigits(uint64_t word) {
+  // Each byte must be 0x30-0x39: the high nibble is 3 and adding 6 does not
+  // carry out of the low nibble.
+  return (word & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL &&
+      ((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ==
+      0x3030303030303030ULL;
+}
+
+// Returns the value of the 8 digits in 'word', the first digit in the low
+// byte. Combines adjacent digits, then pairs, then quads with multiplies.
+inline uint32_t parseEightDigits(uint64_t word) {
+  word -= 0x3030303030303030ULL;
+  word = (word * 10) + (word >> 8);
+  word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+          (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+      32;
+  return static_cast<uint32_t>(word);
+}
+
+// Parses the digits in [data, end) into 'value'. Returns false if there are
+// non-digits. The caller makes sure that the value does not overflow.
+inline bool parseDigits(const char* data, const char* end, uint64_t& value) {
+  for (; end - data >= 8; data += 8) {
+    const auto word = load8(data);
+    if (!isEightDigits(word)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(word);
+  }
+  for (; data < end; ++data) {
+    const uint8_t digit = *data - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  return true;
+}
+
+// Powers of 10 that are exact in a double, up to the 15 digits of the plain
+// form of a double.
+constexpr double kPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13,
+    1e14, 1e15};
+} // namespace detail
+
+/// Parses [-]d+ with at most 18 digits into 'result'. Returns false if the
+/// string has another form or the value does not fit in 'T'.
+template <typename T>
+bool tryParseInteger(const char* data, size_t size, T& result) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  const bool negative = size > 0 && data[0] == '-';
+  const auto numDigits = size - negative;
+  // 18 digits are less than 10^18, which leaves room for the sign in int64_t.
+  if (numDigits == 0 || numDigits > 18) {
+    return false;
+  }
+  uint64_t value = 0;
+  if (!detail::parseDigits(data + negative, data + size, value)) {
+    return false;
+  }
+  const auto signedValue =
+      negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+  if (signedValue < std::numeric_limits<T>::min() ||
+      signedValue > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  result = static_cast<T>(signedValue);
+  return true;
+}
+
+/// Parses [-]d+[.d+] with at most 15 digits into 'result'. The digits are a
+/// mantissa and the digits after the point a power of 10 that are both exact
+/// in a double, so one correctly rounded division gives the correctly
+/// rounded result.
+inline bool tryParseDouble(const char* data, size_t size, double& result) {
+  const bool negative = size > 0 && data[0] == '-';
+  const char* begin = data + negative;
+  const char* end = data + size;
+  const char* point = static_cast<const char*>(memchr(begin, '.', end - begin));
+  const char* integerEnd = point ? point : end;
+  const char* fraction = point ? point + 1 : end;
+  const auto numFractionDigits = end - fraction;
+  // Leading zeros are counted as digits. They are rare and only make the
+  // general conversion parse the string.
+  if (integerEnd == begin || (point && numFractionDigits == 0) ||
+      (integerEnd - begin) + numFractionDigits > 15) {
+    return false;
+  }
+  uint64_t mantissa = 0;
+  if (!detail::parseDigits(begin, integerEnd, mantissa) ||
+      !detail::parseDigits(fraction, end, mantissa)) {
+    return false;
+  }
+  const auto value = static_cast<double>(mantissa) /
+      detail::kPowersOf10[numFractionDigits];
+  result = negative ? -value : value;
+  return true;
+}
+
+/// Parses YYYY-MM-DD into the number of days since the epoch in 'result'.
+/// Returns false if the string has another form or is not a valid date.
+inline bool tryParseDate(const char* data, size_t size, int32_t& result) {
+  if (size != 10 || data[4] != '-' || data[7] != '-') {
+    return false;
+  }
+  // Parse the 8 digits without the separators as the number YYYYMMDD.
+  char digits[8];
+  memcpy(digits, data, 4);
+  memcpy(digits + 4, data + 5, 2);
+  memcpy(digits + 6, data + 8, 2);
+  const auto word = detail::load8(digits);
+  if (!detail::isEightDigits(word)) {
+    return false;
+  }
+  const int32_t yearMonthDay = detail::parseEightDigits(word);
+  const int32_t year = yearMonthDay / 10'000;
+  const int32_t month = yearMonthDay / 100 % 100;
+  const int32_t day = yearMonthDay % 100;
+  int64_t daysSinceEpoch;
+  if (!isValidDate(year, month, day) ||
+      !daysSinceEpochFromDate(year, month, day, daysSinceEpoch).ok()) {
+    return false;
+  }
+  result = static_cast<int32_t>(daysSinceEpoch);
+  return true;
+}
+
+} // namespace facebook::velox::util::fast
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -188,6 +194,8 @@ void Filter::registerSerDe() {
   registry.Register(
       "NegatedBigintValuesUsingBitmask",
       NegatedBigintValuesUsingBitmask::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
   registry.Register("FloatRange", AbstractRange::create);
@@ -435,6 +443,46 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = encoding::Base64::encode(bits);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto bits = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloomFilter->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  std::string otherBits(size, '\0');
+  otherBloomFilter->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase("NegatedBigintValuesUsingHashTable");
   obj["nonNegated"] = nonNegated_->serialize();
@@ -807,6 +855,35 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_LE(min, max, "min must be no greater than max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return !(min > max_ || max < min_);
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -1302,6 +1379,180 @@ bool BytesValues::testBytesRange(
   return true;
 }
 
+namespace {
+// Offsets in int64 words of the sizes and prefixes of consecutive
+// StringViews.
+alignas(64) constexpr int32_t kSizeAndPrefixIndices[] = {
+    0, 2, 4, 6, 8, 10, 12, 14};
+
+// Returns the first 8 bytes of 'value', which are the size in the low half and
+// the first 4 bytes of the string in the high half. The bytes past the end of
+// strings shorter than 4 are zero.
+int64_t sizeAndPrefix(const StringView& value) {
+  int64_t word;
+  memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+// Returns the first 4 bytes of 'value', zero padded, as a big endian number,
+// which orders like the byte strings.
+int64_t prefixOrder(std::string_view value) {
+  int64_t order = 0;
+  for (size_t i = 0; i < StringView::kPrefixSize; ++i) {
+    order = (order << 8) |
+        (i < value.size() ? static_cast<uint8_t>(value[i]) : 0);
+  }
+  return order;
+}
+
+// Same as above for a batch of sizes and prefixes, see sizeAndPrefix().
+xsimd::batch<int64_t> prefixOrder(xsimd::batch<int64_t> sizeAndPrefixes) {
+  const auto byteMask = xsimd::broadcast<int64_t>(0xff);
+  return (((sizeAndPrefixes >> 32) & byteMask) << 24) |
+      (((sizeAndPrefixes >> 40) & byteMask) << 16) |
+      (((sizeAndPrefixes >> 48) & byteMask) << 8) |
+      ((sizeAndPrefixes >> 56) & byteMask);
+}
+
+// Tests 'values' with 'filter' a SIMD batch at a time. 'decide' takes the
+// sizes and prefixes of a batch and sets the bit masks of the lanes that pass
+// and of the lanes that the sizes and prefixes do not decide. Only these and
+// the values after the last full batch are tested with testBytes().
+template <typename Decide>
+void testStringViewsBySizeAndPrefix(
+    const Filter& filter,
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed,
+    Decide decide) {
+  constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
+  static_assert(kWidth <= std::size(kSizeAndPrefixIndices));
+  const auto* words = reinterpret_cast<const int64_t*>(values);
+  int32_t i = 0;
+  for (; i + kWidth <= numValues; i += kWidth) {
+    const auto sizeAndPrefixes =
+        simd::gather<int64_t, int32_t>(words + 2 * i, kSizeAndPrefixIndices);
+    uint64_t passMask = 0;
+    uint64_t undecidedMask = 0;
+    decide(sizeAndPrefixes, passMask, undecidedMask);
+    for (auto j = 0; j < kWidth; ++j) {
+      const auto& value = values[i + j];
+      bits::setBit(
+          passed,
+          i + j,
+          (undecidedMask & (1 << j))
+              ? filter.testBytes(value.data(), value.size())
+              : (passMask & (1 << j)) != 0);
+    }
+  }
+  for (; i < numValues; ++i) {
+    bits::setBit(
+        passed, i, filter.testBytes(values[i].data(), values[i].size()));
+  }
+}
+} // namespace
+
+void BytesRange::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  if (singleValue_) {
+    // A value with the size and prefix of 'lower_' is equal if it is not
+    // longer than the prefix.
+    const auto expected =
+        xsimd::broadcast<int64_t>(sizeAndPrefix(StringView(lower_)));
+    const bool prefixOnly = lower_.size() <= StringView::kPrefixSize;
+    testStringViewsBySizeAndPrefix(
+        *this,
+        values,
+        numValues,
+        passed,
+        [&](auto sizeAndPrefixes, auto& passMask, auto& undecidedMask) {
+          const auto matches = simd::toBitMask(sizeAndPrefixes == expected);
+          if (prefixOnly) {
+            passMask = matches;
+          } else {
+            undecidedMask = matches;
+          }
+        });
+    return;
+  }
+
+  // A value whose prefix orders strictly between the prefixes of the bounds
+  // is strictly between the bounds and one that orders before the lower or
+  // after the upper is outside. Equal prefixes need the full compare.
+  constexpr int64_t kBelowAll = -1;
+  constexpr int64_t kAboveAll = int64_t(1) << 32;
+  const auto lower = xsimd::broadcast<int64_t>(
+      lowerUnbounded_ ? kBelowAll : prefixOrder(lower_));
+  const auto upper = xsimd::broadcast<int64_t>(
+      upperUnbounded_ ? kAboveAll : prefixOrder(upper_));
+  const auto allLanes = bits::lowMask(xsimd::batch<int64_t>::size);
+  testStringViewsBySizeAndPrefix(
+      *this,
+      values,
+      numValues,
+      passed,
+      [&](auto sizeAndPrefixes, auto& passMask, auto& undecidedMask) {
+        const auto prefixes = prefixOrder(sizeAndPrefixes);
+        passMask = simd::toBitMask((prefixes > lower) & (prefixes < upper));
+        const auto failMask =
+            simd::toBitMask((prefixes < lower) | (prefixes > upper));
+        undecidedMask = allLanes & ~(passMask | failMask);
+      });
+}
+
+void BytesValues::initializeSizeAndPrefixes() {
+  sizeAndPrefixes_.clear();
+  for (const auto& value : values_) {
+    sizeAndPrefixes_.push_back(sizeAndPrefix(StringView(value)));
+  }
+  std::sort(sizeAndPrefixes_.begin(), sizeAndPrefixes_.end());
+  sizeAndPrefixes_.erase(
+      std::unique(sizeAndPrefixes_.begin(), sizeAndPrefixes_.end()),
+      sizeAndPrefixes_.end());
+}
+
+void BytesValues::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
+  const auto sizeMask = xsimd::broadcast<int64_t>(0xffffffff);
+  const auto maxPrefixOnlySize =
+      xsimd::broadcast<int64_t>(StringView::kPrefixSize);
+  testStringViewsBySizeAndPrefix(
+      *this,
+      values,
+      numValues,
+      passed,
+      [&](auto sizeAndPrefixes, auto& passMask, auto& undecidedMask) {
+        uint64_t matches = 0;
+        if (sizeAndPrefixes_.size() <= kMaxSimdSizeAndPrefixes) {
+          for (auto expected : sizeAndPrefixes_) {
+            matches |= simd::toBitMask(
+                sizeAndPrefixes == xsimd::broadcast<int64_t>(expected));
+          }
+        } else {
+          alignas(64) int64_t lanes[kWidth];
+          sizeAndPrefixes.store_aligned(lanes);
+          for (auto j = 0; j < kWidth; ++j) {
+            if (std::binary_search(
+                    sizeAndPrefixes_.begin(),
+                    sizeAndPrefixes_.end(),
+                    lanes[j])) {
+              matches |= 1 << j;
+            }
+          }
+        }
+        // A match not longer than the prefix is equal to a value in the list.
+        const auto prefixOnly = simd::toBitMask(
+            (sizeAndPrefixes & sizeMask) <= maxPrefixOnlySize);
+        passMask = matches & prefixOnly;
+        undecidedMask = matches & ~prefixOnly;
+      });
+}
+
 bool NegatedBytesRange::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1840,6 +2091,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -1970,6 +2222,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     }
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable:
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
@@ -2051,7 +2304,8 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     }
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kNegatedBigintValuesUsingBitmask:
-    case FilterKind::kNegatedBigintValuesUsingHashTable: {
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return mergeWith(min_, max_, other);
     }
     default:
@@ -2144,7 +2398,8 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     }
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kNegatedBigintValuesUsingBitmask:
-    case FilterKind::kNegatedBigintValuesUsingHashTable: {
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return mergeWith(min_, max_, other);
     }
     default:
@@ -2167,6 +2422,40 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+      if (max < min) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+      return other->mergeWith(this);
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->clone(nullAllowed_ && other->testNull());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2198,7 +2487,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
           values(), otherNegated->values(), bothNullAllowed);
     }
     case FilterKind::kNegatedBigintRange:
-    case FilterKind::kNegatedBigintValuesUsingBitmask: {
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     default:
@@ -2227,7 +2517,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
-    case FilterKind::kBigintMultiRange: {
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2267,7 +2558,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
-    case FilterKind::kBigintValuesUsingHashTable: {
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kBigintMultiRange: {
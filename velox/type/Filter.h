@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -223,6 +226,19 @@ class Filter : public velox::ISerializable {
         lengths, [this](int32_t x) { return testLength(x); });
   }
 
+  // Tests 'numValues' strings at a time. Sets the bits of 'passed' for the
+  // values that pass and clears the bits of the others. String filters
+  // compare the sizes and prefixes inlined in the StringViews a SIMD batch at
+  // a time and call testBytes() only for the values these do not decide.
+  virtual void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const {
+    for (auto i = 0; i < numValues; ++i) {
+      bits::setBit(passed, i, testBytes(values[i].data(), values[i].size()));
+    }
+  }
+
   // Returns true if at least one value in the specified range can pass the
   // filter. The range is defined as all values between min and max inclusive
   // plus null if hasNull is true.
@@ -1090,6 +1106,86 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types with too many values for the hash
+/// table or bitmask filters, e.g. the keys of a large hash join build side.
+/// Implemented as a range check followed by a lookup in a blocked bloom filter
+/// which touches a single 64-bit word per value. The filter is approximate: it
+/// passes all the values it was built from plus a small fraction of false
+/// positives. Hence it is only suitable where the passing rows are checked
+/// again, as for the dynamic filters pushed down from a hash join.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter of the hashes of the values that pass the
+  /// filter. The hashes are computed by hashValue().
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash of 'value' to insert into the bloom filter.
+  static uint64_t hashValue(int64_t value) {
+    return folly::hash::twang_mix64(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hashValue(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  /// Merges with the filters which can't be combined with a bloom filter, such
+  /// as multi-ranges and negated values, keep the other filter alone. The
+  /// result then passes more values than the conjunction, which is allowed as
+  /// this filter is approximate anyway.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1648,6 +1744,11 @@ class BytesRange final : public AbstractRange {
     return lengths == xsimd::broadcast<int32_t>(lower_.size());
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool isSingleValue() const {
     return singleValue_;
   }
@@ -1731,6 +1832,14 @@ class NegatedBytesRange final : public Filter {
     return !nonNegated_->testBytes(value, length);
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final {
+    nonNegated_->testStringViews(values, numValues, passed);
+    bits::negate(reinterpret_cast<char*>(passed), numValues);
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1871,6 +1980,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    initializeSizeAndPrefixes();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1878,7 +1988,8 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        sizeAndPrefixes_(other.sizeAndPrefixes_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1899,9 +2010,14 @@ class BytesValues final : public Filter {
 
   bool testBytes(const char* value, int32_t length) const final {
     return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+        values_.contains(std::string_view(value, length));
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1916,10 +2032,19 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Up to this many distinct sizes and prefixes are compared with each SIMD
+  // batch of values, more are looked up one value at a time.
+  static constexpr int32_t kMaxSimdSizeAndPrefixes = 8;
+
+  void initializeSizeAndPrefixes();
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // The distinct sizes and prefixes of 'values_' as in the first 8 bytes of
+  // StringView, sorted.
+  std::vector<int64_t> sizeAndPrefixes_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -2006,6 +2131,14 @@ class NegatedBytesValues final : public Filter {
     return !nonNegated_->testBytes(value, length);
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final {
+    nonNegated_->testStringViews(values, numValues, passed);
+    bits::negate(reinterpret_cast<char*>(passed), numValues);
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
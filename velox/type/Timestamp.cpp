@@ -153,24 +153,11 @@ const date::time_zone& Timestamp::defaultTimezone() {
 namespace {
 
 constexpr int kTmYearBase = 1900;
-constexpr int64_t kLeapYearOffset = 4000000000ll;
 
 inline bool isLeap(int64_t y) {
   return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
 }
 
-inline int64_t leapThroughEndOf(int64_t y) {
-  // Add a large offset to make the calculation for negative years correct.
-  y += kLeapYearOffset;
-  VELOX_DCHECK_GE(y, 0);
-  return y / 4 - y / 100 + y / 400;
-}
-
-const int monthLengths[][12] = {
-    {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
-    {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
-};
-
 // clang-format off
 const char intToStr[][3] = {
     "00", "01", "02", "03", "04", "05", "06", "07", "08", "09",
@@ -207,29 +194,32 @@ bool Timestamp::epochToUtc(int64_t epoch, std::tm& tm) {
   if (tm.tm_wday < 0) {
     tm.tm_wday += 7;
   }
-  int64_t y = 1970;
-  if (y + days / kDaysPerYear <= -kLeapYearOffset + 10) {
-    return false;
-  }
-  bool leapYear;
-  while (days < 0 || days >= kDaysPerYear + (leapYear = isLeap(y))) {
-    auto newy = y + days / kDaysPerYear - (days < 0);
-    days -= (newy - y) * kDaysPerYear + leapThroughEndOf(newy - 1) -
-        leapThroughEndOf(y - 1);
-    y = newy;
-  }
-  y -= kTmYearBase;
+  // Civil date from days since epoch in constant time, see
+  // http://howardhinnant.github.io/date_algorithms.html#civil_from_days. The
+  // years are counted from March 1st so that the leap day is the last day of
+  // the year.
+  constexpr int64_t kDaysPerEra = 146'097;
+  const int64_t z = days + 719'468;
+  const int64_t era = (z >= 0 ? z : z - kDaysPerEra + 1) / kDaysPerEra;
+  // Day and year of the era, in [0, 146096] and [0, 399].
+  const int64_t doe = z - era * kDaysPerEra;
+  const int64_t yoe =
+      (doe - doe / 1460 + doe / 36'524 - doe / (kDaysPerEra - 1)) /
+      kDaysPerYear;
+  // Day of the year from March 1st and month from March, in [0, 365] and [0,
+  // 11].
+  const int64_t doy = doe - (kDaysPerYear * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  const bool janOrFeb = mp >= 10;
+  const int64_t y = yoe + era * 400 + janOrFeb - kTmYearBase;
   if (y > std::numeric_limits<decltype(tm.tm_year)>::max() ||
       y < std::numeric_limits<decltype(tm.tm_year)>::min()) {
     return false;
   }
   tm.tm_year = y;
-  tm.tm_yday = days;
-  auto* ip = monthLengths[leapYear];
-  for (tm.tm_mon = 0; days >= ip[tm.tm_mon]; ++tm.tm_mon) {
-    days = days - ip[tm.tm_mon];
-  }
-  tm.tm_mday = days + 1;
+  tm.tm_mon = janOrFeb ? mp - 10 : mp + 2;
+  tm.tm_mday = doy - (153 * mp + 2) / 5 + 1;
+  tm.tm_yday = janOrFeb ? doy - 306 : doy + 59 + isLeap(y + kTmYearBase);
   tm.tm_isdst = 0;
   return true;
 }
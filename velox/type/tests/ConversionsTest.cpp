@@ -18,6 +18,7 @@
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/type/CppToType.h"
+#include "velox/type/FastStringConversions.h"
 
 using namespace facebook::velox;
 
@@ -1047,5 +1048,114 @@ TEST_F(ConversionsTest, toTimestamp) {
         {123456.78}, {}, false, false, /*expectError*/ true);
   }
 }
+
+TEST_F(ConversionsTest, fastStringConversions) {
+  // Checks that the fast parser accepts exactly the strings in 'plain' and
+  // gives the same results as the general conversion for them.
+  auto testConversions = [](const std::vector<std::string>& plain,
+                            const std::vector<std::string>& other,
+                            auto parse,
+                            auto convert) {
+    for (const auto& input : plain) {
+      decltype(convert(input)) result;
+      ASSERT_TRUE(parse(input.data(), input.size(), result)) << input;
+      EXPECT_EQ(convert(input), result) << input;
+    }
+    for (const auto& input : other) {
+      decltype(convert(input)) result;
+      EXPECT_FALSE(parse(input.data(), input.size(), result)) << input;
+    }
+  };
+
+  const std::vector<std::string> integers = {
+      "0",
+      "-0",
+      "7",
+      "007",
+      "-12",
+      "1234567",
+      "12345678",
+      "123456789",
+      "-9876543210",
+      "123456789012345678",
+      "-123456789012345678"};
+  const std::vector<std::string> otherIntegers = {
+      "",
+      "-",
+      "+1",
+      " 1",
+      "1 ",
+      "1.5",
+      "12345678a",
+      "1234567/",
+      "1234567890123456789",
+      "9223372036854775807"};
+  testConversions(
+      integers,
+      otherIntegers,
+      fast::tryParseInteger<int64_t>,
+      [](const std::string& input) {
+        return Converter<TypeKind::BIGINT>::cast(input);
+      });
+  testConversions(
+      integers,
+      otherIntegers,
+      fast::tryParseInteger<int64_t>,
+      [](const std::string& input) {
+        return Converter<TypeKind::BIGINT, void, TruncateCastPolicy>::cast(
+            input);
+      });
+  testConversions(
+      {"127", "-128", "0"},
+      {"128", "-129", "1000"},
+      fast::tryParseInteger<int8_t>,
+      [](const std::string& input) {
+        return Converter<TypeKind::TINYINT>::cast(input);
+      });
+
+  testConversions(
+      {"0",
+       "-0",
+       "0.1",
+       "1.5",
+       "-2.25",
+       "3.14159265358979",
+       "123456789012345",
+       "0.00000000000001",
+       "99999999.9999999"},
+      {"",
+       ".5",
+       "1.",
+       "-",
+       "1e5",
+       "1.5 ",
+       "NaN",
+       "Infinity",
+       "1.2.3",
+       "1234567890123456",
+       "0.1234567890123456"},
+      fast::tryParseDouble,
+      [](const std::string& input) {
+        return Converter<TypeKind::DOUBLE>::cast(input);
+      });
+
+  testConversions(
+      {"1970-01-01", "2020-02-29", "1812-04-15", "0001-01-01", "9999-12-31"},
+      {"",
+       "1970-1-01",
+       "+1970-01-01",
+       "1970-01-01 ",
+       "1970/01/01",
+       "19a0-01-01",
+       "2021-02-29",
+       "2020-13-01",
+       "2020-00-10",
+       "2020-01-32"},
+      fast::tryParseDate,
+      [](const std::string& input) {
+        return castFromDateString(
+            input.data(), input.size(), ParseMode::kStandardCast);
+      });
+}
 } // namespace
 } // namespace facebook::velox::util
@@ -104,6 +104,14 @@ TEST_F(FilterSerDeTest, valuesFilters) {
       testSerde(BytesValues(strValues, nullAllowed));
       testSerde(NegatedBytesValues(strValues, nullAllowed));
 
+      auto bloomFilter = std::make_shared<BloomFilter<>>();
+      bloomFilter->reset(values.size());
+      for (auto value : values) {
+        bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(value));
+      }
+      testSerde(
+          BigintValuesUsingBloomFilter(lower, upper, bloomFilter, nullAllowed));
+
       testSerde(HugeintValuesUsingHashTable(
           lowerHugeint, upperHugeint, valuesHugeint, nullAllowed));
     }
@@ -454,6 +454,40 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  constexpr int64_t kNumValues = 10'000;
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(kNumValues);
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(i * 7));
+  }
+  BigintValuesUsingBloomFilter filter(
+      0, (kNumValues - 1) * 7, bloomFilter, false);
+
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    ASSERT_TRUE(filter.testInt64(i * 7));
+  }
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_FALSE(filter.testInt64(-7));
+  EXPECT_FALSE(filter.testInt64(kNumValues * 7));
+  EXPECT_FALSE(filter.testInt64(INT64_MAX));
+
+  // The false positive rate is ~2% with 2 bytes per value.
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    numFalsePositives += filter.testInt64(i * 7 + 1);
+  }
+  EXPECT_LT(numFalsePositives, kNumValues / 20);
+
+  EXPECT_TRUE(filter.testInt64Range(5, 50, false));
+  EXPECT_TRUE(filter.testInt64Range(14, 14, false));
+  EXPECT_FALSE(filter.testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter.testInt64Range(kNumValues * 7, kNumValues * 8, false));
+
+  EXPECT_TRUE(filter.clone(true)->testNull());
+  EXPECT_TRUE(filter.clone()->testingEquals(filter));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -1013,6 +1047,73 @@ TEST(FilterTest, negatedBytesValues) {
   EXPECT_FALSE(filter_no_nulls->testNull());
 }
 
+TEST(FilterTest, testStringViews) {
+  // Strings around the prefix and inline sizes, with bytes that are zero or
+  // have the high bit set, so that the prefix compares need to be exact.
+  std::vector<std::string> strings = {
+      "",
+      "a",
+      "ab",
+      std::string("ab\0", 3),
+      "abc",
+      "abcd",
+      "abcde",
+      "abcdefghijkl",
+      "abcdefghijklm",
+      "abd",
+      "b",
+      "\xff",
+      "\xff\xfe\xfd\xfc\xfb",
+      "integra.",
+      "natura",
+      "natural",
+      "renovitur",
+      "renovitur and more than inline",
+      "zz"};
+  std::vector<StringView> values;
+  for (auto i = 0; i < 5; ++i) {
+    for (const auto& string : strings) {
+      values.emplace_back(string);
+    }
+  }
+
+  auto check = [&](const Filter& filter) {
+    for (auto numValues = 0; numValues <= values.size(); ++numValues) {
+      std::vector<uint64_t> passed(bits::nwords(numValues), ~0ULL);
+      filter.testStringViews(values.data(), numValues, passed.data());
+      for (auto i = 0; i < numValues; ++i) {
+        EXPECT_EQ(
+            filter.testBytes(values[i].data(), values[i].size()),
+            bits::isBitSet(passed.data(), i))
+            << filter.toString() << ": " << values[i];
+      }
+    }
+  };
+
+  check(*equal("abcd"));
+  check(*equal("abcde"));
+  check(*equal(""));
+  check(*between("abcd", "abcd"));
+  check(*between("abcdefghijkl", "abcdefghijkl"));
+  check(*between("ab", "abcdefghijkl"));
+  check(*betweenExclusive("ab", "natura"));
+  check(*lessThan("abd"));
+  check(*lessThanOrEqual("ab"));
+  check(*greaterThan("abc"));
+  check(*greaterThanOrEqual("\xff"));
+  check(*notBetween("abc", "natural"));
+  check(*in({"abcd", "zz", "renovitur"}));
+  check(*notIn({"ab", "natural", "renovitur and more than inline"}));
+
+  // More values than are compared in SIMD.
+  std::vector<std::string> inList;
+  for (auto i = 0; i < strings.size(); i += 2) {
+    inList.push_back(strings[i]);
+  }
+  check(*in(inList));
+  check(*notIn(inList));
+}
+
 TEST(FilterTest, multiRange) {
   auto filter = orFilter(between("abc", "abc"), greaterThanOrEqual("dragon"));
 
@@ -1410,6 +1511,50 @@ TEST(FilterTest, mergeWithBigint) {
   }
 }
 
+TEST(FilterTest, mergeWithBigintBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(i));
+  }
+  BigintValuesUsingBloomFilter filter(0, 99, bloomFilter, true);
+
+  // The range is narrowed and the bloom filter is kept.
+  auto range = between(10, 200);
+  auto merged = range->mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  auto* mergedBloomFilter =
+      static_cast<const BigintValuesUsingBloomFilter*>(merged.get());
+  EXPECT_EQ(mergedBloomFilter->min(), 10);
+  EXPECT_EQ(mergedBloomFilter->max(), 99);
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_TRUE(merged->testInt64(10));
+  EXPECT_FALSE(merged->testInt64(9));
+  EXPECT_TRUE(merged->testingEquals(*filter.mergeWith(range.get())));
+
+  EXPECT_EQ(
+      between(100, 200)->mergeWith(&filter)->kind(), FilterKind::kAlwaysFalse);
+
+  // Value lists keep the values that pass the bloom filter.
+  auto values = createBigintValues({1, 50, 1000, 2000}, false);
+  merged = values->mergeWith(&filter);
+  EXPECT_TRUE(merged->testInt64(1));
+  EXPECT_TRUE(merged->testInt64(50));
+  EXPECT_FALSE(merged->testInt64(1000));
+  EXPECT_FALSE(merged->testInt64(2000));
+  EXPECT_TRUE(merged->testingEquals(*filter.mergeWith(values.get())));
+
+  // Filters that can't be combined with a bloom filter are kept as is.
+  auto notInFilter = notIn(std::vector<int64_t>{1, 2});
+  merged = notInFilter->mergeWith(&filter);
+  EXPECT_TRUE(merged->testingEquals(*notInFilter));
+  EXPECT_TRUE(merged->testInt64(1000));
+
+  merged = isNotNull()->mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_FALSE(merged->testNull());
+}
+
 TEST(FilterTest, mergeWithDouble) {
   std::vector<std::unique_ptr<Filter>> filters;
   addUntypedFilters(filters);
@@ -385,6 +385,37 @@ TEST(TimestampTest, randomEpochToUtc) {
   }
 }
 
+TEST(TimestampTest, epochToUtcCivilRange) {
+  // Years from about -1200 to 5100, where the result is representable and
+  // the calendar arithmetic matters.
+  std::default_random_engine gen(42);
+  std::uniform_int_distribution<time_t> dist(
+      -100'000'000'000, 100'000'000'000);
+  std::tm actual{};
+  std::tm expected{};
+  for (int i = 0; i < 100'000; ++i) {
+    auto epoch = dist(gen);
+    SCOPED_TRACE(fmt::format("epoch={}", epoch));
+    ASSERT_NE(gmtime_r(&epoch, &expected), nullptr);
+    ASSERT_TRUE(Timestamp::epochToUtc(epoch, actual));
+    checkTm(actual, expected);
+  }
+  // Around the ends of the months of leap and non-leap years.
+  for (auto year : {1900, 1969, 1970, 2000, 2023, 2024}) {
+    std::tm start{};
+    start.tm_year = year - 1900;
+    start.tm_mday = 1;
+    const time_t first = timegm(&start);
+    for (int day = -2; day < 368; ++day) {
+      const time_t epoch = first + day * 86'400 + 86'399;
+      SCOPED_TRACE(fmt::format("epoch={}", epoch));
+      ASSERT_NE(gmtime_r(&epoch, &expected), nullptr);
+      ASSERT_TRUE(Timestamp::epochToUtc(epoch, actual));
+      checkTm(actual, expected);
+    }
+  }
+}
+
 void testTmToString(
     const std::string& format,
     const TimestampToStringOptions::Mode mode) {
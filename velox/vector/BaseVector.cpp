@@ -721,6 +721,17 @@ void BaseVector::copy(
     rows.applyToSelected([&](vector_size_t row) {
       const auto sourceRow = toSourceRow[row];
       VELOX_DCHECK_GT(source->size(), sourceRow);
+      // Consecutive rows from consecutive source rows, as when merging or
+      // concatenating batches, go in one range so that complex types copy
+      // their children once per range instead of once per row.
+      if (!ranges.empty()) {
+        auto& last = ranges.back();
+        if (last.targetIndex + last.count == row &&
+            last.sourceIndex + last.count == sourceRow) {
+          ++last.count;
+          return;
+        }
+      }
       ranges.push_back({sourceRow, row, 1});
     });
   }
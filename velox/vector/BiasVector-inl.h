@@ -111,6 +111,30 @@ const T BiasVector<T>::valueAtFast(vector_size_t idx) const {
   }
 }
 
+template <typename T>
+void BiasVector<T>::copyValuesTo(vector_size_t size, T* values) const {
+  VELOX_DCHECK_LE(size, BaseVector::length_);
+  // One loop per delta width so that the widening add vectorizes.
+  auto debias = [&](auto* deltas) {
+    for (auto i = 0; i < size; ++i) {
+      values[i] = bias_ + deltas[i];
+    }
+  };
+  switch (valueType_) {
+    case TypeKind::INTEGER:
+      debias(reinterpret_cast<const int32_t*>(rawValues_));
+      break;
+    case TypeKind::SMALLINT:
+      debias(reinterpret_cast<const int16_t*>(rawValues_));
+      break;
+    case TypeKind::TINYINT:
+      debias(reinterpret_cast<const int8_t*>(rawValues_));
+      break;
+    default:
+      VELOX_UNSUPPORTED("Invalid type");
+  }
+}
+
 template <typename T>
 xsimd::batch<T> BiasVector<T>::loadSIMDValueBufferAt(size_t index) const {
   if constexpr (std::is_same_v<T, int64_t>) {
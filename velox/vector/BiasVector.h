@@ -123,6 +123,10 @@ class BiasVector : public SimpleVector<T> {
     return valueAtFast(idx);
   }
 
+  /// Writes the first 'size' values with the bias added to 'values'. Null
+  /// positions get unspecified values.
+  void copyValuesTo(vector_size_t size, T* values) const;
+
   /**
    * Loads a SIMD vector of data at the virtual byteOffset given
    * Note this method is implemented on each vector type, but is intentionally
@@ -17,6 +17,7 @@
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/BiasVector.h"
 #include "velox/vector/LazyVector.h"
 
 namespace facebook::velox {
@@ -308,11 +309,48 @@ void DecodedVector::setBaseData(
       setBaseDataForConstant(vector, rows);
       break;
     }
+    case VectorEncoding::Simple::BIASED: {
+      setBaseDataForBias(vector, rows);
+      break;
+    }
     default:
       VELOX_UNREACHABLE();
   }
 }
 
+namespace {
+template <typename T>
+const void* debias(const BaseVector& vector, std::vector<uint64_t>& values) {
+  // A dictionary over 'vector' may refer to any of its positions, so all of
+  // them are widened, not only 'rows'.
+  const auto size = vector.size();
+  values.resize(bits::roundUp(size * sizeof(T), sizeof(uint64_t)) / 8);
+  vector.asUnchecked<BiasVector<T>>()->copyValuesTo(
+      size, reinterpret_cast<T*>(values.data()));
+  return values.data();
+}
+} // namespace
+
+void DecodedVector::setBaseDataForBias(
+    const BaseVector& vector,
+    const SelectivityVector* rows) {
+  switch (vector.typeKind()) {
+    case TypeKind::BIGINT:
+      data_ = debias<int64_t>(vector, copiedValues_);
+      break;
+    case TypeKind::INTEGER:
+      data_ = debias<int32_t>(vector, copiedValues_);
+      break;
+    case TypeKind::SMALLINT:
+      data_ = debias<int16_t>(vector, copiedValues_);
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported type for BiasVector: {}", vector.type()->toString());
+  }
+  setFlatNulls(vector, rows);
+}
+
 void DecodedVector::setBaseDataForConstant(
     const BaseVector& vector,
     const SelectivityVector* rows) {
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/type/HugeInt.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/SelectivityVector.h"
@@ -182,6 +183,21 @@ class DecodedVector {
     return reinterpret_cast<const T*>(data_)[index(idx)];
   }
 
+  /// Writes valueAt(row) to 'values[row]' for the rows selected in 'rows'.
+  /// 'values' must have space for rows.end() elements. Values of null rows
+  /// are unspecified and values of unselected rows may be overwritten. 'T' is
+  /// a fixed width type other than bool and int128_t. The nulls are given by
+  /// nulls(&rows).
+  ///
+  /// Gathering once into a flat buffer pays off when the values are read
+  /// more than once or by a loop that only vectorizes over contiguous data.
+  /// A dictionary with all rows selected and 4 or 8 byte values is read with
+  /// SIMD gathers, which load a full batch of values per instruction. A
+  /// sparse selection costs one indirect load per selected row, the same as
+  /// valueAt().
+  template <typename T>
+  void gatherValues(const SelectivityVector& rows, T* values) const;
+
   /// If false, there are no nulls. Otherwise, there is a possibility that there
   /// are some nulls, but no certainty.
   bool mayHaveNulls() const {
@@ -349,6 +365,12 @@ class DecodedVector {
       const BaseVector& vector,
       const SelectivityVector* rows);
 
+  // Points 'data_' to the values of the BiasVector 'vector' with the bias
+  // added, so that valueAt() and data() work as for a flat vector.
+  void setBaseDataForBias(
+      const BaseVector& vector,
+      const SelectivityVector* rows);
+
   void reset(vector_size_t size);
 
   // If `rows` is null applies the `func` to all rows in [0, size_)
@@ -425,10 +447,57 @@ class DecodedVector {
   // dictionary and base values.
   std::vector<uint64_t> copiedNulls_;
 
+  // Used as backing for 'data_' when the base vector is a BiasVector.
+  std::vector<uint64_t> copiedValues_;
+
   // Used as 'nulls_' for a null constant vector.
   static uint64_t constantNullMask_;
 };
 
+template <typename T>
+void DecodedVector::gatherValues(const SelectivityVector& rows, T* values)
+    const {
+  static_assert(
+      !std::is_same_v<T, bool> && !std::is_same_v<T, int128_t>,
+      "gatherValues() needs byte aligned values");
+  // All null flat and constant vectors may have no values.
+  if (!rows.hasSelections() || data_ == nullptr) {
+    return;
+  }
+  const auto* data = reinterpret_cast<const T*>(data_);
+  const auto begin = rows.begin();
+  const auto end = rows.end();
+  if (isConstantMapping_) {
+    std::fill(values + begin, values + end, data[constantIndex_]);
+    return;
+  }
+  if (isIdentityMapping_) {
+    if (rows.isAllSelected()) {
+      std::copy(data + begin, data + end, values + begin);
+    } else {
+      rows.applyToSelected([&](auto row) { values[row] = data[row]; });
+    }
+    return;
+  }
+  VELOX_DCHECK(indices_);
+  if constexpr (
+      std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+    if (rows.isAllSelected()) {
+      constexpr int32_t kBatch = xsimd::batch<T>::size;
+      auto i = begin;
+      for (; i + kBatch <= end; i += kBatch) {
+        simd::gather<T, vector_size_t>(data, indices_ + i)
+            .store_unaligned(values + i);
+      }
+      for (; i < end; ++i) {
+        values[i] = data[indices_[i]];
+      }
+      return;
+    }
+  }
+  rows.applyToSelected([&](auto row) { values[row] = data[indices_[row]]; });
+}
+
 template <>
 inline bool DecodedVector::valueAt(vector_size_t idx) const {
   return bits::isBitSet(reinterpret_cast<const uint64_t*>(data_), index(idx));
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -47,12 +48,41 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexType(const Type& type) {
+  return type.kind() == TypeKind::ARRAY || type.kind() == TypeKind::MAP ||
+      type.kind() == TypeKind::ROW;
+}
 } // namespace
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool create) {
+  for (auto i = 0; i < numComplexTypes_; ++i) {
+    auto& entry = complexVectors_[i];
+    if (entry.type == type || *entry.type == *type) {
+      return &entry.vectors;
+    }
+  }
+  if (!create || numComplexTypes_ == kNumComplexTypes) {
+    return nullptr;
+  }
+  auto& entry = complexVectors_[numComplexTypes_++];
+  entry.type = type;
+  return &entry.vectors;
+}
+
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_);
+    }
+    if (isComplexType(*type)) {
+      if (auto* typePool = complexTypePool(type, false)) {
+        return typePool->pop(type, size, *pool_);
+      }
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -66,10 +96,15 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+  if (!isComplexType(*vector->type()) ||
+      vector->retainedSize() > kMaxRecycleComplexBytes) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto* typePool = complexTypePool(vector->type(), true);
+  return typePool != nullptr && typePool->maybePushBack(vector);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -87,9 +122,22 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  if (!vector->isWritable()) {
     return false;
   }
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (!vector->values()) {
+        return false;
+      }
+      break;
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+    case VectorEncoding::Simple::ROW:
+      break;
+    default:
+      return false;
+  }
   if (size >= kNumPerType) {
     return false;
   }
@@ -123,6 +171,15 @@ VectorPtr VectorPool::TypePool::pop(
     if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
+    if (result->encoding() == VectorEncoding::Simple::ROW) {
+      // prepareForReuse() leaves the children of a row empty and resize()
+      // only grows them when the row grows.
+      for (auto& child : result->asUnchecked<RowVector>()->children()) {
+        if (child) {
+          child->resize(vectorSize);
+        }
+      }
+    }
     return result;
   }
   return BaseVector::create(type, vectorSize, &pool);
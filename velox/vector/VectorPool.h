@@ -23,10 +23,13 @@ namespace facebook::velox {
 /// A thread-level cache of pre-allocated flat vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
 /// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// Singleton built-in types are supported. Arrays, maps and rows are also
+/// supported for up to 'kNumComplexTypes' distinct types. They are recyclable
+/// if they and their children are writable, and they keep their offsets,
+/// sizes and child buffers for reuse. Decimal types, fixed-size array type and
+/// custom types are not supported. Calling 'get' for an unsupported type
+/// already returns a newly allocated vector. Calling 'release' for an
+/// unsupported type is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
@@ -47,6 +50,11 @@ class VectorPool {
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  /// Max number of distinct complex types to keep vectors of.
+  static constexpr int32_t kNumComplexTypes = 8;
+  /// Max retained bytes for a complex vector to be recyclable. The children
+  /// keep their buffers, so size alone does not bound the memory held.
+  static constexpr uint64_t kMaxRecycleComplexBytes = 1 << 20;
 
   struct TypePool {
     int32_t size{0};
@@ -60,6 +68,15 @@ class VectorPool {
         memory::MemoryPool& pool);
   };
 
+  struct ComplexTypePool {
+    TypePtr type;
+    TypePool vectors;
+  };
+
+  // Returns the cache for the complex 'type' or nullptr if there is none. If
+  // 'create' is true, makes one if there is space.
+  TypePool* complexTypePool(const TypePtr& type, bool create);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +84,11 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated array, map and row vectors. The first
+  /// 'numComplexTypes_' are in use.
+  std::array<ComplexTypePool, kNumComplexTypes> complexVectors_;
+  int32_t numComplexTypes_{0};
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -195,6 +195,21 @@ void VectorStreamGroup::estimateSerializedSize(
   getVectorSerde()->estimateSerializedSize(vector, rows, sizes, scratch);
 }
 
+void VectorSerde::deserializeIOBuf(
+    std::shared_ptr<const folly::IOBuf> source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* options) {
+  std::vector<ByteRange> ranges;
+  for (const auto& range : *source) {
+    ranges.emplace_back(ByteRange{
+        const_cast<uint8_t*>(range.data()), (int32_t)range.size(), 0});
+  }
+  ByteInputStream stream(std::move(ranges));
+  deserialize(&stream, pool, std::move(type), result, options);
+}
+
 // static
 void VectorStreamGroup::read(
     ByteInputStream* source,
@@ -233,6 +233,22 @@ class VectorSerde {
     }
     VELOX_UNSUPPORTED();
   }
+
+  /// Returns true if 'deserializeIOBuf' can return vectors whose buffers
+  /// reference the memory of the source IOBuf instead of copies of it.
+  virtual bool supportsZeroCopyDeserialize() const {
+    return false;
+  }
+
+  /// Deserializes the data in 'source' into 'result'. Serdes that support
+  /// zero-copy deserialization may return vectors that keep 'source' alive.
+  /// The default implementation reads 'source' through a ByteInputStream.
+  virtual void deserializeIOBuf(
+      std::shared_ptr<const folly::IOBuf> source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options = nullptr);
 };
 
 /// Register/deregister the "default" vector serde.
@@ -313,6 +329,11 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// Returns the maximum serialized size of the data appended so far.
+  size_t maxSerializedSize() const {
+    return serializer_->maxSerializedSize();
+  }
+
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
@@ -31,17 +31,22 @@ namespace facebook::velox {
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). String views add one buffer per variadic data
+// buffer and one for their sizes.
 static constexpr size_t kMaxBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Makes room for 'numBuffers' buffers. Invalidates the result of
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +63,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +94,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -249,9 +254,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -548,6 +553,85 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Arrow's binary view layout. The inline form is the same as that of Velox
+// StringView: the size followed by up to 12 bytes of data.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
+// Creates a FlatVector of StringView from the Arrow string view layout. The
+// views are rewritten to point to the data buffers, which are wrapped without
+// copying.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* views =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  const auto* sizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  const auto* dataBuffers =
+      reinterpret_cast<const char* const*>(arrowArray.buffers + 2);
+
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  std::vector<bool> isReferenced(numDataBuffers);
+  for (size_t i = 0; i < length; ++i) {
+    if (nulls && bits::isBitNull(nulls->as<uint64_t>(), i)) {
+      rawStringViews[i] = StringView();
+      continue;
+    }
+    const auto& view = views[i];
+    if (StringView::isInline(view.size)) {
+      memcpy(&rawStringViews[i], &view, sizeof(StringView));
+      continue;
+    }
+    VELOX_USER_CHECK(
+        view.bufferIndex >= 0 && view.bufferIndex < numDataBuffers,
+        "Invalid string view buffer index: {}",
+        view.bufferIndex);
+    VELOX_USER_CHECK_LE(
+        view.offset + static_cast<int64_t>(view.size),
+        sizes[view.bufferIndex],
+        "String view out of bounds of its data buffer.");
+    rawStringViews[i] =
+        StringView(dataBuffers[view.bufferIndex] + view.offset, view.size);
+    isReferenced[view.bufferIndex] = true;
+  }
+
+  std::vector<BufferPtr> stringViewBuffers;
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    if (isReferenced[i]) {
+      stringViewBuffers.emplace_back(
+          wrapInBufferView(dataBuffers[i], sizes[i]));
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +748,119 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings in the Arrow string view layout. The string buffers of
+// 'vec' become the variadic data buffers, so that only the 16 byte views are
+// written. Strings outside of the string buffers are copied to an extra data
+// buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto* rawValues = vec.rawValues();
+  bool allInline = true;
+  size_t numCopiedBytes = 0;
+  // The string buffers of 'vec' ordered by address.
+  std::vector<BufferPtr> stringBuffers;
+  for (const auto& buffer : vec.stringBuffers()) {
+    if (buffer->size() > 0) {
+      stringBuffers.push_back(buffer);
+    }
+  }
+  std::sort(
+      stringBuffers.begin(),
+      stringBuffers.end(),
+      [](const BufferPtr& left, const BufferPtr& right) {
+        return left->as<char>() < right->as<char>();
+      });
+  // Returns the index in 'stringBuffers' of the buffer containing 'value' or
+  // -1.
+  auto findBuffer = [&](const StringView& value) -> int32_t {
+    auto it = std::upper_bound(
+        stringBuffers.begin(),
+        stringBuffers.end(),
+        value.data(),
+        [](const char* data, const BufferPtr& buffer) {
+          return data < buffer->as<char>();
+        });
+    if (it == stringBuffers.begin()) {
+      return -1;
+    }
+    --it;
+    if (value.data() + value.size() > (*it)->as<char>() + (*it)->size()) {
+      return -1;
+    }
+    return it - stringBuffers.begin();
+  };
+  rows.apply([&](vector_size_t i) {
+    if (rawValues[i].isInline()) {
+      return;
+    }
+    allInline = false;
+    if (!vec.isNullAt(i) && findBuffer(rawValues[i]) < 0) {
+      numCopiedBytes += rawValues[i].size();
+    }
+  });
+
+  const size_t numDataBuffers =
+      stringBuffers.size() + (numCopiedBytes > 0 ? 1 : 0);
+  out.n_buffers = 3 + numDataBuffers;
+  holder.resizeBuffers(out.n_buffers);
+  out.buffers = holder.getArrowBuffers();
+
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+    rawSizes[i] = stringBuffers[i]->size();
+    VELOX_CHECK_LE(rawSizes[i], std::numeric_limits<int32_t>::max());
+  }
+  char* rawCopied = nullptr;
+  if (numCopiedBytes > 0) {
+    VELOX_CHECK_LE(numCopiedBytes, std::numeric_limits<int32_t>::max());
+    holder.setBuffer(
+        2 + stringBuffers.size(),
+        AlignedBuffer::allocate<char>(numCopiedBytes, pool));
+    rawCopied = holder.getBufferAs<char>(2 + stringBuffers.size());
+    rawSizes[stringBuffers.size()] = numCopiedBytes;
+  }
+  holder.setBuffer(out.n_buffers - 1, sizes);
+
+  if (allInline && !rows.changed()) {
+    // The views are the same in both layouts.
+    holder.setBuffer(1, vec.values());
+    return;
+  }
+
+  holder.setBuffer(1, AlignedBuffer::allocate<StringView>(out.length, pool));
+  auto* rawViews = holder.getBufferAs<ArrowStringView>(1);
+  int32_t copiedOffset = 0;
+  vector_size_t row = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[row++];
+    if (vec.isNullAt(i)) {
+      memset(&view, 0, sizeof(view));
+      return;
+    }
+    const auto& value = rawValues[i];
+    memcpy(&view, &value, sizeof(view));
+    if (value.isInline()) {
+      return;
+    }
+    const auto index = findBuffer(value);
+    if (index >= 0) {
+      view.bufferIndex = index;
+      view.offset = value.data() - stringBuffers[index]->as<char>();
+    } else {
+      view.bufferIndex = stringBuffers.size();
+      view.offset = copiedOffset;
+      memcpy(rawCopied + copiedOffset, value.data(), value.size());
+      copiedOffset += value.size();
+    }
+  });
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +885,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -833,21 +1043,30 @@ void flattenAndExport(
   DecodedVector decoded(vec, allRows);
   auto flatVector = BaseVector::create<FlatVector<NativeType>>(
       vec.type(), decoded.size(), pool);
+  // Strings are referenced in the string buffers of 'vec', not copied.
+  auto setValue = [&](vector_size_t row) {
+    if constexpr (std::is_same_v<NativeType, StringView>) {
+      flatVector->setNoCopy(row, decoded.valueAt<NativeType>(row));
+    } else {
+      flatVector->set(row, decoded.valueAt<NativeType>(row));
+    }
+  };
+  if constexpr (std::is_same_v<NativeType, StringView>) {
+    flatVector->acquireSharedStringBuffers(&vec);
+  }
 
   if (decoded.mayHaveNulls()) {
     allRows.applyToSelected([&](vector_size_t row) {
       if (decoded.isNullAt(row)) {
         flatVector->setNull(row, true);
       } else {
-        flatVector->set(row, decoded.valueAt<NativeType>(row));
+        setValue(row);
       }
     });
     exportValidityBitmap(*flatVector, rows, options, out, pool, holder);
     exportFlat(*flatVector, rows, options, out, pool, holder);
   } else {
-    allRows.applyToSelected([&](vector_size_t row) {
-      flatVector->set(row, decoded.valueAt<NativeType>(row));
-    });
+    allRows.applyToSelected([&](vector_size_t row) { setValue(row); });
     exportFlat(*flatVector, rows, options, out, pool, holder);
   }
 }
@@ -1082,6 +1301,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1713,6 +1942,10 @@ VectorPtr importFromArrowImpl(
 
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
+    if (arrowSchema.format[0] == 'v') {
+      return createStringViewFlatVector(
+          pool, type, nulls, arrowArray, wrapInBufferView);
+    }
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
@@ -35,6 +35,10 @@ enum class TimestampUnit : uint8_t {
 struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
+  // Exports VARCHAR and VARBINARY in the Arrow string view layout ("vu" and
+  // "vz"), which references the string buffers of the vector instead of
+  // copying the strings.
+  bool exportToStringView{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
 };
 
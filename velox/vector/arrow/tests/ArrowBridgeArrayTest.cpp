@@ -1310,6 +1310,59 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
         });
   }
 
+  // Exports strings as string views and imports them back. The string
+  // buffers are shared, not copied.
+  void testImportStringView() {
+    auto vector = vectorMaker_.flatVectorNullable<std::string>({
+        "inline",
+        "larger string which should not be inlined...",
+        std::nullopt,
+        "",
+        "another string that is not stored inline",
+        std::nullopt,
+    });
+    const auto& stringBuffers = vector->stringBuffers();
+    ASSERT_EQ(stringBuffers.size(), 1);
+
+    ArrowOptions options;
+    options.exportToStringView = true;
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    velox::exportToArrow(vector, arrowSchema, options);
+    velox::exportToArrow(vector, arrowArray, pool_.get(), options);
+    EXPECT_STREQ(arrowSchema.format, "vu");
+    // Nulls, views, one data buffer and the data buffer sizes.
+    ASSERT_EQ(arrowArray.n_buffers, 4);
+    EXPECT_EQ(arrowArray.buffers[2], stringBuffers[0]->as<void>());
+
+    auto imported = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    test::assertEqualVectors(vector, imported);
+    const auto& importedBuffers =
+        imported->asFlatVector<StringView>()->stringBuffers();
+    ASSERT_EQ(importedBuffers.size(), 1);
+    EXPECT_EQ(importedBuffers[0]->as<void>(), stringBuffers[0]->as<void>());
+    if (isViewer()) {
+      arrowArray.release(&arrowArray);
+      arrowSchema.release(&arrowSchema);
+    }
+
+    // A dictionary reorders the rows, so the views are rewritten while the
+    // data buffer is still shared.
+    auto dictionary = BaseVector::wrapInDictionary(
+        nullptr, makeBuffer<vector_size_t>({4, 1, 0}), 3, vector);
+    options.flattenDictionary = true;
+    velox::exportToArrow(dictionary, arrowSchema, options);
+    velox::exportToArrow(dictionary, arrowArray, pool_.get(), options);
+    ASSERT_EQ(arrowArray.n_buffers, 4);
+    EXPECT_EQ(arrowArray.buffers[2], stringBuffers[0]->as<void>());
+    imported = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    test::assertEqualVectors(dictionary, imported);
+    if (isViewer()) {
+      arrowArray.release(&arrowArray);
+      arrowSchema.release(&arrowSchema);
+    }
+  }
+
  private:
   // Creates short decimals from int128 and asserts the content of actual vector
   // with the expected values.
@@ -1752,6 +1805,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1805,6 +1862,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
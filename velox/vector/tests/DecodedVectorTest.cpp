@@ -23,6 +23,7 @@
 
 #include "velox/type/Variant.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/BiasVector.h"
 #include "velox/vector/SelectivityVector.h"
 #include "velox/vector/TypeAliases.h"
 #include "velox/vector/tests/VectorTestUtils.h"
@@ -1218,6 +1219,85 @@ TEST_F(DecodedVectorTest, flatNulls) {
   }
 }
 
+TEST_F(DecodedVectorTest, biased) {
+  constexpr vector_size_t kSize = 1000;
+  constexpr int64_t kBias = 1'000'000'000'000;
+  auto deltas = AlignedBuffer::allocate<int16_t>(kSize, pool());
+  auto* rawDeltas = deltas->asMutable<int16_t>();
+  BufferPtr nulls = allocateNulls(kSize, pool());
+  auto* rawNulls = nulls->asMutable<uint64_t>();
+  for (auto i = 0; i < kSize; ++i) {
+    rawDeltas[i] = i * 7 - 3'000;
+    bits::setNull(rawNulls, i, i % 11 == 0);
+  }
+  auto biased = std::make_shared<BiasVector<int64_t>>(
+      pool(), nulls, kSize, TypeKind::SMALLINT, deltas, kBias);
+
+  auto check = [&](DecodedVector& d, auto expectedIndex) {
+    for (auto i = 0; i < kSize; ++i) {
+      const auto index = expectedIndex(i);
+      ASSERT_EQ(d.isNullAt(i), index % 11 == 0) << i;
+      if (!d.isNullAt(i)) {
+        ASSERT_EQ(d.valueAt<int64_t>(i), kBias + index * 7 - 3'000) << i;
+      }
+    }
+  };
+
+  {
+    DecodedVector d(*biased);
+    ASSERT_TRUE(d.isIdentityMapping());
+    check(d, [](auto row) { return row; });
+  }
+
+  auto reversed = wrapInDictionary(makeIndicesInReverse(kSize), kSize, biased);
+  {
+    SelectivityVector rows(kSize);
+    DecodedVector d(*reversed, rows);
+    check(d, [](auto row) { return kSize - 1 - row; });
+  }
+}
+
+TEST_F(DecodedVectorTest, gatherValues) {
+  constexpr vector_size_t kSize = 1'003;
+  auto check = [&](const VectorPtr& vector) {
+    SCOPED_TRACE(vector->toString());
+    SelectivityVector allRows(kSize);
+    SelectivityVector someRows(kSize);
+    someRows.setValidRange(0, 11, false);
+    for (auto i = 0; i < kSize; i += 3) {
+      someRows.setValid(i, false);
+    }
+    someRows.updateBounds();
+    for (const auto* rows : {&allRows, &someRows}) {
+      DecodedVector decoded(*vector, *rows);
+      std::vector<int64_t> values(kSize, -1);
+      decoded.gatherValues(*rows, values.data());
+      for (auto i = 0; i < kSize; ++i) {
+        if (!rows->isValid(i)) {
+          continue;
+        }
+        if (!decoded.isNullAt(i)) {
+          ASSERT_EQ(values[i], decoded.valueAt<int64_t>(i)) << i;
+        }
+      }
+    }
+  };
+
+  auto flat = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 3; }, nullEvery(13));
+  check(flat);
+  check(makeConstant<int64_t>(17, kSize));
+  check(makeNullConstant(TypeKind::BIGINT, kSize));
+  check(wrapInDictionary(makeIndicesInReverse(kSize), kSize, flat));
+  auto indices = makeIndices(kSize, [](auto row) { return row * 7 % kSize; });
+  check(wrapInDictionary(
+      indices,
+      kSize,
+      wrapInDictionary(makeIndicesInReverse(kSize), kSize, flat)));
+  check(BaseVector::wrapInDictionary(
+      makeNulls(kSize, nullEvery(5)), indices, kSize, flat));
+}
+
 TEST_F(DecodedVectorTest, dictionaryOverFlatNulls) {
   SelectivityVector rows(100);
   DecodedVector d;
@@ -16,6 +16,7 @@
 #include "velox/vector/VectorPool.h"
 #include <gtest/gtest.h>
 #include "velox/functions/prestosql/types/JsonType.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 namespace facebook::velox::test {
@@ -136,6 +137,55 @@ TEST_F(VectorPoolTest, vectorRecycler) {
   }
 }
 
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  const std::vector<std::function<TypePtr()>> makeTypes = {
+      []() { return ARRAY(BIGINT()); },
+      []() { return MAP(VARCHAR(), ARRAY(INTEGER())); },
+      []() { return ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())}); }};
+  VectorFuzzer fuzzer({.vectorSize = 100, .nullRatio = 0.1}, pool());
+  for (const auto& makeType : makeTypes) {
+    const auto type = makeType();
+    SCOPED_TRACE(type->toString());
+    auto vector = vectorPool.get(type, 100);
+    vector->copy(fuzzer.fuzzFlat(type).get(), 0, 0, 100);
+    auto* vectorPtr = vector.get();
+    ASSERT_TRUE(vectorPool.release(vector));
+    ASSERT_EQ(vector, nullptr);
+
+    // An equal type that is a different instance finds the same vectors.
+    auto recycled = vectorPool.get(makeType(), 200);
+    ASSERT_EQ(recycled.get(), vectorPtr);
+    ASSERT_EQ(recycled->size(), 200);
+    for (auto i = 0; i < recycled->size(); ++i) {
+      ASSERT_FALSE(recycled->isNullAt(i));
+    }
+    if (type->kind() == TypeKind::ROW) {
+      for (const auto& child : recycled->as<RowVector>()->children()) {
+        ASSERT_EQ(child->size(), 200);
+      }
+    } else {
+      for (auto i = 0; i < recycled->size(); ++i) {
+        ASSERT_EQ(recycled->as<ArrayVectorBase>()->sizeAt(i), 0);
+      }
+    }
+
+    // A vector with a shared child is not recyclable.
+    auto copy = BaseVector::copy(*recycled);
+    VectorPtr child;
+    if (type->kind() == TypeKind::ROW) {
+      child = copy->as<RowVector>()->childAt(0);
+    } else if (type->kind() == TypeKind::ARRAY) {
+      child = copy->as<ArrayVector>()->elements();
+    } else {
+      child = copy->as<MapVector>()->mapKeys();
+    }
+    ASSERT_FALSE(vectorPool.release(copy));
+    ASSERT_NE(copy, nullptr);
+  }
+}
+
 TEST_F(VectorPoolTest, customTypes) {
   VectorPool vectorPool(pool());
 
@@ -1788,6 +1788,50 @@ TEST_F(VectorTest, copyNoRows) {
   }
 }
 
+TEST_F(VectorTest, copyWithSourceRowRuns) {
+  constexpr vector_size_t kSize = 100;
+  auto source = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          kSize,
+          [](auto row) { return row % 5; },
+          [](auto row) { return row; },
+          nullEvery(7)),
+      makeMapVector<int32_t, int64_t>(
+          kSize,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row; },
+          [](auto row) { return row * 2; }),
+  });
+  // Runs of consecutive source rows broken by backward jumps, unselected
+  // rows and a repeated source row.
+  std::vector<vector_size_t> toSourceRow(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    toSourceRow[i] = (i / 10 * 37 + i % 10) % kSize;
+  }
+  toSourceRow[41] = toSourceRow[40];
+  SelectivityVector rows(kSize);
+  for (auto i = 0; i < kSize; i += 13) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+
+  for (const auto& [columnSource, name] :
+       std::vector<std::pair<VectorPtr, std::string>>{
+           {source, "row"},
+           {source->childAt(1), "array"},
+           {source->childAt(2), "map"}}) {
+    SCOPED_TRACE(name);
+    auto target = BaseVector::create(columnSource->type(), kSize, pool());
+    target->copy(columnSource.get(), rows, toSourceRow.data());
+    rows.applyToSelected([&](auto row) {
+      ASSERT_TRUE(
+          target->equalValueAt(columnSource.get(), row, toSourceRow[row]))
+          << row;
+    });
+  }
+}
+
 TEST_F(VectorTest, copyAscii) {
   std::vector<std::string> stringData = {"a", "b", "c"};
   auto source = makeFlatVector(stringData);